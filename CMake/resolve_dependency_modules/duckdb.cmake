@@ -39,6 +39,11 @@ set(BUILD_UNITTESTS OFF)
 set(ENABLE_SANITIZER OFF)
 set(ENABLE_UBSAN OFF)
 set(BUILD_SHELL OFF)
+# The TPC-DS benchmark generates its data with the dsdgen function of the
+# tpcds extension.
+if(${VELOX_ENABLE_BENCHMARKS})
+  set(BUILD_TPCDS_EXTENSION ON)
+endif()
 set(EXPORT_DLL_SYMBOLS OFF)
 set(PREVIOUS_BUILD_TYPE ${CMAKE_BUILD_TYPE})
 set(CMAKE_BUILD_TYPE Release)
@@ -24,20 +24,29 @@ namespace facebook::velox::py {
 namespace py = pybind11;
 
 void addConversionBindings(py::module& m, bool asModuleLocalDefinitions) {
-  m.def("export_to_arrow", [](VectorPtr& inputVector) {
-    auto arrowArray = std::make_unique<ArrowArray>();
-    auto pool_ = PyVeloxContext::getSingletonInstance().pool();
-    facebook::velox::exportToArrow(inputVector, *arrowArray, pool_);
+  // With 'string_view', strings are exported as Arrow string views, which
+  // reference the Velox string buffers instead of copying the strings.
+  m.def(
+      "export_to_arrow",
+      [](VectorPtr& inputVector, bool stringView) {
+        ArrowOptions options;
+        options.exportToStringView = stringView;
+        auto arrowArray = std::make_unique<ArrowArray>();
+        auto pool_ = PyVeloxContext::getSingletonInstance().pool();
+        facebook::velox::exportToArrow(
+            inputVector, *arrowArray, pool_, options);
 
-    auto arrowSchema = std::make_unique<ArrowSchema>();
-    facebook::velox::exportToArrow(inputVector, *arrowSchema);
+        auto arrowSchema = std::make_unique<ArrowSchema>();
+        facebook::velox::exportToArrow(inputVector, *arrowSchema, options);
 
-    py::module arrow_module = py::module::import("pyarrow");
-    py::object array_class = arrow_module.attr("Array");
-    return array_class.attr("_import_from_c")(
-        reinterpret_cast<uintptr_t>(arrowArray.get()),
-        reinterpret_cast<uintptr_t>(arrowSchema.get()));
-  });
+        py::module arrow_module = py::module::import("pyarrow");
+        py::object array_class = arrow_module.attr("Array");
+        return array_class.attr("_import_from_c")(
+            reinterpret_cast<uintptr_t>(arrowArray.get()),
+            reinterpret_cast<uintptr_t>(arrowSchema.get()));
+      },
+      py::arg("vector"),
+      py::arg("string_view") = false);
 
   m.def("import_from_arrow", [](py::object inputArrowArray) {
     auto arrowArray = std::make_unique<ArrowArray>();
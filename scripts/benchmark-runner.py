@@ -18,6 +18,8 @@ import json
 import os
 import pathlib
 import re
+import shutil
+import statistics
 import subprocess
 import sys
 import tempfile
@@ -257,14 +259,19 @@ def compare(args):
     return 0
 
 
-def _find_binaries(binary_path: pathlib.Path):
+def _find_binaries(binary_path: pathlib.Path, recursive=False):
     print(f"Looking for binaries at '{binary_path}'")
 
-    # Must run `make benchmarks-basic-build` before this
+    # Must run `make benchmarks-basic-build` before this. When searching a
+    # whole build tree only executables with 'benchmark' in their name are
+    # picked, so that unit tests and tools are left out.
+    files = binary_path.rglob("*") if recursive else binary_path.glob("*")
     binaries = [
         path
-        for path in binary_path.glob("*")
-        if os.access(path, os.X_OK) and path.is_file()
+        for path in files
+        if os.access(path, os.X_OK)
+        and path.is_file()
+        and (not recursive or "benchmark" in path.name)
     ]
     if not binaries:
         raise ValueError(f"No binaries found at path '{binary_path.resolve()}'")
@@ -285,6 +292,32 @@ def _normalize_path(binary_path: str) -> pathlib.Path:
     return path
 
 
+def _parse_cpu_list(cpu_list):
+    """Parses a list of cpus like '0-3,8' into a set of cpu ids."""
+    cpus = set()
+    for item in cpu_list.split(","):
+        if "-" in item:
+            first, last = item.split("-")
+            cpus.update(range(int(first), int(last) + 1))
+        else:
+            cpus.add(int(item))
+    return cpus
+
+
+def _median_results(runs):
+    """
+    Merges the folly json dumps of several repetitions of one binary into one
+    dump with the median time of each benchmark.
+    """
+    merged = []
+    for rows in zip(*runs):
+        row = list(rows[0])
+        if row[1] != "-":
+            row[2] = statistics.median(r[2] for r in rows)
+        merged.append(row)
+    return merged
+
+
 def run_all_benchmarks(
     output_dir,
     binary_path=None,
@@ -293,46 +326,128 @@ def run_all_benchmarks(
     bm_max_secs=None,
     bm_max_trials=None,
     bm_estimate_time=False,
+    search_build_tree=None,
+    repetitions=1,
+    cpus=None,
+    summary=None,
 ):
-    if binary_path:
-        binary_path = _normalize_path(binary_path)
-    else:
-        binary_path = _default_binary_path()
+    binaries = []
+    if search_build_tree:
+        binaries += _find_binaries(_normalize_path(search_build_tree), True)
+    for path in binary_path or []:
+        binaries += _find_binaries(_normalize_path(path))
+    if not binaries:
+        binaries = _find_binaries(_default_binary_path())
 
-    binaries = _find_binaries(binary_path)
     output_dir_path = pathlib.Path(output_dir)
     output_dir_path.mkdir(parents=True, exist_ok=True)
 
+    # Pins the benchmark processes, and so all their threads, to 'cpus'.
+    preexec_fn = (lambda: os.sched_setaffinity(0, cpus)) if cpus else None
+
     for binary_path in binaries:
         if binary_filter and not re.search(binary_filter, binary_path.name):
             continue
 
         out_path = output_dir_path / f"{binary_path.name}.json"
         print(f"Executing and dumping results for '{binary_path}' to '{out_path}':")
-        run_command = [
-            binary_path,
-            "--bm_json_verbose",
-            out_path,
-        ]
+        runs = []
+        # Repetitions are dumped to a separate directory so that 'compare'
+        # only sees the merged results in 'output_dir'.
+        run_dir = tempfile.mkdtemp() if repetitions > 1 else None
+        for repetition in range(repetitions):
+            run_path = (
+                pathlib.Path(run_dir) / f"{repetition}.json" if run_dir else out_path
+            )
+            _run_benchmark(
+                binary_path,
+                run_path,
+                bm_filter,
+                bm_max_secs,
+                bm_max_trials,
+                bm_estimate_time,
+                preexec_fn,
+            )
+            with open(run_path) as f:
+                runs.append(json.load(f))
+        if run_dir:
+            with open(out_path, "w") as f:
+                json.dump(_median_results(runs), f, indent=2)
+            shutil.rmtree(run_dir)
+
+        if summary is not None:
+            for rows in zip(*runs):
+                if rows[0][1] == "-":
+                    continue
+                handle = "{}/{}".format(
+                    binary_path.name, rows[0][1].lstrip("%")
+                )
+                summary[handle] = _stats([r[2] for r in rows])
+
+
+def _stats(times):
+    mean = statistics.mean(times)
+    stddev = statistics.stdev(times) if len(times) > 1 else 0.0
+    return {
+        "runs": times,
+        "mean": mean,
+        "median": statistics.median(times),
+        "min": min(times),
+        "max": max(times),
+        "stddev": stddev,
+        # Coefficient of variation, i.e. the noise relative to the mean.
+        "cv": stddev / mean if mean else 0.0,
+    }
+
+
+def _run_benchmark(
+    binary_path,
+    out_path,
+    bm_filter,
+    bm_max_secs,
+    bm_max_trials,
+    bm_estimate_time,
+    preexec_fn,
+):
+    run_command = [
+        binary_path,
+        "--bm_json_verbose",
+        out_path,
+    ]
 
-        if bm_max_secs:
-            run_command.extend(["--bm_max_secs", str(bm_max_secs)])
+    if bm_max_secs:
+        run_command.extend(["--bm_max_secs", str(bm_max_secs)])
 
-        if bm_max_trials:
-            run_command.extend(["--bm_max_trials", str(bm_max_trials)])
+    if bm_max_trials:
+        run_command.extend(["--bm_max_trials", str(bm_max_trials)])
 
-        if bm_filter:
-            run_command.extend(["--bm_regex", bm_filter])
+    if bm_filter:
+        run_command.extend(["--bm_regex", bm_filter])
 
-        if bm_estimate_time:
-            run_command.append("--bm_estimate_time")
+    if bm_estimate_time:
+        run_command.append("--bm_estimate_time")
 
-        try:
-            print(run_command)
-            subprocess.run(run_command, check=True)
-        except subprocess.CalledProcessError as e:
-            print(e.stderr.decode("utf-8"))
-            raise e
+    try:
+        print(run_command)
+        subprocess.run(run_command, check=True, preexec_fn=preexec_fn)
+    except subprocess.CalledProcessError as e:
+        print(e.stderr.decode("utf-8") if e.stderr else e)
+        raise e
+
+
+def write_summary(path, summary, repetitions, cpus):
+    with open(path, "w") as f:
+        json.dump(
+            {
+                "repetitions": repetitions,
+                "cpus": sorted(cpus) if cpus else None,
+                "benchmarks": summary,
+            },
+            f,
+            indent=2,
+            sort_keys=True,
+        )
+    print(f"Wrote summary of {len(summary)} benchmarks to '{path}'")
 
 
 def upload_results(args):
@@ -400,6 +515,8 @@ def upload_results(args):
 
 def run(args):
     output_dir = args.output_path or tempfile.mkdtemp()
+    cpus = _parse_cpu_list(args.cpu_list) if args.cpu_list else None
+    summary = {} if args.summary_output else None
     kwargs = {
         "output_dir": output_dir,
         "binary_path": args.binary_path,
@@ -408,6 +525,10 @@ def run(args):
         "bm_max_secs": args.bm_max_secs,
         "bm_max_trials": args.bm_max_trials,
         "bm_estimate_time": args.bm_estimate_time,
+        "search_build_tree": args.search_build_tree,
+        "repetitions": args.repetitions,
+        "cpus": cpus,
+        "summary": summary,
     }
 
     # In case we only want to rerun failed benchmarks from rerun_json_input.
@@ -430,6 +551,69 @@ def run(args):
     else:
         run_all_benchmarks(**kwargs)
 
+    if args.summary_output:
+        write_summary(args.summary_output, summary, args.repetitions, cpus)
+
+
+def check(args):
+    """
+    Compares a summary written by 'run --summary_output' against a stored
+    baseline summary. A benchmark regresses when its median got slower by more
+    than the threshold and by more than 'noise_factor' times the variation
+    seen across repetitions, so that noisy benchmarks do not fail spuriously.
+    """
+    with open(args.baseline) as f:
+        baseline = json.load(f)["benchmarks"]
+    with open(args.contender) as f:
+        contender = json.load(f)["benchmarks"]
+
+    regressions = []
+    improvements = []
+    for handle, stats in sorted(contender.items()):
+        if handle not in baseline:
+            print("    {}: {}".format(color_yellow("? New"), handle))
+            continue
+        base = baseline[handle]
+        if base["median"] == 0:
+            continue
+        # Positive means the contender is slower.
+        delta = stats["median"] / base["median"] - 1
+        noise = args.noise_factor * max(base["cv"], stats["cv"])
+        limit = max(args.threshold, noise)
+        if delta > limit:
+            status = color_red("✗ Fail")
+            regressions.append((handle, delta))
+        elif -delta > limit:
+            status = color_green("🗲 Pass")
+            improvements.append((handle, delta))
+        else:
+            status = color_green("✓ Pass")
+        print(
+            "    {}: {} ({} vs {}, ±{:.2f}%) {:+.2f}%".format(
+                status,
+                handle,
+                fmt_runtime(base["median"]),
+                fmt_runtime(stats["median"]),
+                limit * 100,
+                delta * 100,
+            )
+        )
+    for handle in sorted(set(baseline) - set(contender)):
+        print("    {}: {}".format(color_yellow("? Missing"), handle))
+
+    print(
+        "Summary: {} compared, {} faster, {} slower".format(
+            len(set(baseline) & set(contender)),
+            len(improvements),
+            len(regressions),
+        )
+    )
+    for handle, delta in regressions:
+        print(color_red("    {} ({:+.2f}%)".format(handle, delta * 100)))
+    if regressions and not args.do_not_fail:
+        return 1
+    return 0
+
 
 def parse_args():
     parser = argparse.ArgumentParser(description="Velox Benchmark Runner Utility.")
@@ -443,8 +627,34 @@ def parse_args():
     parser_run.add_argument(
         "--binary_path",
         default=None,
-        help="Directory where benchmark binaries are stored. "
-        "Defaults to release build directory.",
+        action="append",
+        help="Directory where benchmark binaries are stored. May be given "
+        "several times. Defaults to release build directory.",
+    )
+    parser_run.add_argument(
+        "--search_build_tree",
+        default=None,
+        help="Build directory searched recursively for binaries with "
+        "'benchmark' in their name, e.g. _build/release/velox.",
+    )
+    parser_run.add_argument(
+        "--repetitions",
+        default=1,
+        type=int,
+        help="How many times to run each binary. The median time of each "
+        "benchmark is dumped to the output path.",
+    )
+    parser_run.add_argument(
+        "--cpu_list",
+        default=None,
+        help="Cpus to pin the benchmark processes to, e.g. '2-5,8'.",
+    )
+    parser_run.add_argument(
+        "--summary_output",
+        default=None,
+        help="File where the runs, mean, median, min, max, stddev and "
+        "coefficient of variation of each benchmark are written as json. "
+        "The file can be stored as a baseline for the 'check' subcommand.",
     )
     parser_run.add_argument(
         "--output_path",
@@ -535,6 +745,43 @@ def parse_args():
         help="Do not return failure code if comparisons fail.",
     )
 
+    # Arguments for the "check" subparser.
+    parser_check = subparsers.add_parser(
+        "check", help="Check a run summary against a baseline summary."
+    )
+    parser_check.set_defaults(func=check)
+    parser_check.add_argument(
+        "--baseline",
+        required=True,
+        help="Baseline summary written by 'run --summary_output'.",
+    )
+    parser_check.add_argument(
+        "--contender",
+        required=True,
+        help="Contender summary written by 'run --summary_output'.",
+    )
+    parser_check.add_argument(
+        "-t",
+        "--threshold",
+        type=float,
+        default=0.05,
+        help="Slowdowns larger than this fraction of the baseline median are "
+        "reported as failures. Default 0.05 (5%%).",
+    )
+    parser_check.add_argument(
+        "--noise_factor",
+        type=float,
+        default=2.0,
+        help="Slowdowns within this many coefficients of variation of either "
+        "summary are reported as noise. Default 2.",
+    )
+    parser_check.add_argument(
+        "--do_not_fail",
+        default=False,
+        action="store_true",
+        help="Do not return failure code if checks fail.",
+    )
+
     parser_upload = subparsers.add_parser(
         "upload",
         help="Upload benchmark results to conbench. Requires the `benchadapt` package "
@@ -33,6 +33,14 @@ int main(int argc, char** argv) {
   auto invalidInput = vectorMaker.flatVector<facebook::velox::StringView>({""});
   auto validInput = vectorMaker.flatVector<facebook::velox::StringView>({""});
   auto nanInput = vectorMaker.flatVector<facebook::velox::StringView>({""});
+  auto bigintStringInput =
+      vectorMaker.flatVector<std::string>(vectorSize, [&](auto j) {
+        return std::to_string(-1'234'567'890'123LL * (j + 1));
+      });
+  auto doubleStringInput =
+      vectorMaker.flatVector<std::string>(vectorSize, [&](auto j) {
+        return fmt::format("{}.{:03}", j * 12'345, j % 1000);
+      });
   auto decimalInput = vectorMaker.flatVector<int64_t>(
       vectorSize, [&](auto j) { return 12345 * j; }, nullptr, DECIMAL(9, 2));
   auto shortDecimalInput = vectorMaker.flatVector<int64_t>(
@@ -77,6 +85,8 @@ int main(int argc, char** argv) {
               {"valid",
                "empty",
                "nan",
+               "bigint_string",
+               "double_string",
                "decimal",
                "short_decimal",
                "long_decimal",
@@ -88,6 +98,8 @@ int main(int argc, char** argv) {
               {validInput,
                invalidInput,
                nanInput,
+               bigintStringInput,
+               doubleStringInput,
                decimalInput,
                shortDecimalInput,
                longDecimalInput,
@@ -104,6 +116,12 @@ int main(int argc, char** argv) {
       .addExpression("try_cast_valid", "try_cast (valid as int)")
       .addExpression("tryexpr_cast_valid", "try (cast (valid as int))")
       .addExpression("cast_valid", "cast(valid as int)")
+      .addExpression("cast_bigint_string", "cast(bigint_string as bigint)")
+      .addExpression("cast_double_string", "cast(double_string as double)")
+      .addExpression("cast_real_string", "cast(double_string as real)")
+      .addExpression("try_cast_invalid_nan_double", "try_cast (nan as double)")
+      .addExpression(
+          "tryexpr_cast_invalid_nan_double", "try (cast (nan as double))")
       .addExpression(
           "cast_decimal_to_inline_string", "cast (decimal as varchar)")
       .addExpression("cast_short_decimal", "cast (short_decimal as varchar)")
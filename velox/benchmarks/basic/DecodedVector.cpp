@@ -48,6 +48,15 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
     for (size_t i = 0; i < 5; ++i) {
       dictionaryNestedVector_ = fuzzer.fuzzDictionary(dictionaryNestedVector_);
     }
+
+    // Generate dictionary over dictionary over flat vectors, as produced by
+    // joins, without and with nulls at each level.
+    dictionary2NestedVector_ = fuzzer.fuzzDictionary(
+        fuzzer.fuzzDictionary(fuzzer.fuzzFlat(BIGINT())));
+    opts.nullRatio = 0.1;
+    fuzzer.setOptions(opts);
+    dictionary2NestedNullsVector_ = fuzzer.fuzzDictionary(
+        fuzzer.fuzzDictionary(fuzzer.fuzzFlat(BIGINT())));
   }
 
   // Runs a fast path over a flat vector (no decoding).
@@ -118,6 +127,16 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
     DecodedVector decodedVector(*dictionaryNestedVector_, rows_);
   }
 
+  // Measure time to decode a dictionary over a dictionary over a flat vector.
+  void decodeDictionary2Nested() {
+    DecodedVector decodedVector(*dictionary2NestedVector_, rows_);
+  }
+
+  // Same as above with nulls in the flat vector and in both dictionaries.
+  void decodeDictionary2NestedNulls() {
+    DecodedVector decodedVector(*dictionary2NestedNullsVector_, rows_);
+  }
+
  private:
   void decodedRun(const DecodedVector& decodedVector) {
     size_t sum = 0;
@@ -133,6 +152,8 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
   VectorPtr constantVector_;
   VectorPtr dictionaryVector_;
   VectorPtr dictionaryNestedVector_;
+  VectorPtr dictionary2NestedVector_;
+  VectorPtr dictionary2NestedNullsVector_;
 
   SelectivityVector rows_;
 };
@@ -185,6 +206,14 @@ BENCHMARK(decodeDictionary5Nested) {
   run([&] { benchmark->decodeDictionary5Nested(); });
 }
 
+BENCHMARK(decodeDictionary2Nested) {
+  run([&] { benchmark->decodeDictionary2Nested(); });
+}
+
+BENCHMARK(decodeDictionary2NestedNulls) {
+  run([&] { benchmark->decodeDictionary2NestedNulls(); });
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -17,6 +17,7 @@
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
 #include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
+#include "velox/external/date/date.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 
 using namespace facebook;
@@ -42,6 +43,45 @@ int main(int argc, char** argv) {
       .addExpression("", "format_datetime(c0, 'yyyy-MM-dd HH:mm:ss.SSS')")
       .disableTesting();
 
+  // Timestamps in years 2000 to 2031 that are formatted and parsed with the
+  // fixed layout fast paths.
+  auto timestamps = vectorMaker.flatVector<Timestamp>(
+      options.vectorSize, [](auto row) {
+        return Timestamp(
+            946'684'800 + row * 987'654, (row % 1'000) * 1'000'000);
+      });
+  auto dates = vectorMaker.flatVector<std::string>(
+      options.vectorSize, [&](auto row) {
+        return date::format("%F", timestamps->valueAt(row).toTimePoint());
+      });
+  auto dateTimes = vectorMaker.flatVector<std::string>(
+      options.vectorSize, [&](auto row) {
+        return date::format(
+            "%F %T",
+            date::floor<std::chrono::seconds>(
+                timestamps->valueAt(row).toTimePoint()));
+      });
+
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "Benchmark fixed layouts",
+          vectorMaker.rowVector({timestamps, dates, dateTimes}))
+      .addExpressions({
+          {"format_datetime_date", "format_datetime(c0, 'yyyy-MM-dd')"},
+          {"format_datetime_datetime",
+           "format_datetime(c0, 'yyyy-MM-dd HH:mm:ss')"},
+          {"format_datetime_iso",
+           "format_datetime(c0, 'yyyy-MM-dd''T''HH:mm:ss.SSS')"},
+          {"format_datetime_general", "format_datetime(c0, 'yyyy/MM/dd')"},
+          {"date_format_date", "date_format(c0, '%Y-%m-%d')"},
+          {"date_format_datetime", "date_format(c0, '%Y-%m-%d %H:%i:%s')"},
+          {"date_parse_date", "date_parse(c1, '%Y-%m-%d')"},
+          {"date_parse_datetime", "date_parse(c2, '%Y-%m-%d %H:%i:%s')"},
+          {"parse_datetime_datetime",
+           "parse_datetime(c2, 'yyyy-MM-dd HH:mm:ss')"},
+      })
+      .disableTesting();
+
   benchmarkBuilder.registerBenchmarks();
   folly::runBenchmarks();
   return 0;
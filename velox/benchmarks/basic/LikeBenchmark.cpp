@@ -18,6 +18,7 @@
 #include <folly/init/Init.h>
 
 #include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/functions/lib/Re2Functions.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 
@@ -28,6 +29,33 @@ using namespace facebook::velox::functions::test;
 using namespace facebook::velox::memory;
 using namespace facebook::velox;
 
+namespace {
+// Strings of the substring set. Compares the search of LIKE '%a_b_c%' and
+// strpos with std::string_view::find.
+std::vector<std::string> substringStrings;
+const std::string kSubstring = "a_b_c";
+} // namespace
+
+BENCHMARK(stdFind) {
+  int32_t count = 0;
+  for (const auto& string : substringStrings) {
+    count += std::string_view(string).find(kSubstring) != std::string::npos;
+  }
+  folly::doNotOptimizeAway(count);
+}
+
+BENCHMARK_RELATIVE(simdStrstr) {
+  int32_t count = 0;
+  for (const auto& string : substringStrings) {
+    count += simd::simdStrstr(
+                 string.data(),
+                 string.size(),
+                 kSubstring.data(),
+                 kSubstring.size()) != std::string::npos;
+  }
+  folly::doNotOptimizeAway(count);
+}
+
 int main(int argc, char** argv) {
   folly::Init init(&argc, &argv);
   memory::MemoryManager::initialize({});
@@ -73,6 +101,9 @@ int main(int argc, char** argv) {
   };
 
   auto substringInput = makeInput(vectorSize, true, true);
+  for (auto i = 0; i < substringInput->size(); ++i) {
+    substringStrings.push_back(std::string(substringInput->valueAt(i)));
+  }
   auto prefixInput = makeInput(vectorSize, false, true);
   auto prefixUnicodeInput = makeInput(vectorSize, false, true, "你_好_啊");
   auto suffixInput = makeInput(vectorSize, true, false);
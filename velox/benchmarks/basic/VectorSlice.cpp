@@ -48,6 +48,9 @@ struct BenchmarkData {
     arrayVector = fuzzer.fuzzFlat(ARRAY(BIGINT()));
     mapVector = fuzzer.fuzzFlat(MAP(BIGINT(), BIGINT()));
     rowVector = fuzzer.fuzzFlat(ROW({BIGINT(), BIGINT(), BIGINT()}));
+    stringVector = fuzzer.fuzzFlat(VARCHAR());
+    nestedVector = fuzzer.fuzzFlat(
+        ROW({ARRAY(VARCHAR()), MAP(BIGINT(), ARRAY(BIGINT())), VARCHAR()}));
   }
 
   ~BenchmarkData() {
@@ -55,12 +58,20 @@ struct BenchmarkData {
     arrayVector.reset();
     mapVector.reset();
     rowVector.reset();
+    stringVector.reset();
+    nestedVector.reset();
   }
 
   VectorPtr flatVector;
   VectorPtr arrayVector;
   VectorPtr mapVector;
   VectorPtr rowVector;
+  VectorPtr stringVector;
+  VectorPtr nestedVector;
+
+  // Pool of the copies that do not share the string buffers of the source.
+  std::shared_ptr<memory::MemoryPool> copyPool{
+      memory::memoryManager()->addLeafPool("BenchmarkCopy")};
 
  private:
   std::shared_ptr<memory::MemoryPool> pool_;
@@ -90,21 +101,50 @@ int runCopy(const BaseVector& vec) {
   return count;
 }
 
-#define DEFINE_BENCHMARKS(name)                    \
-  BENCHMARK_MULTI(name##Slice) {                   \
-    return runSlice(*data->name##Vector, 0);       \
-  }                                                \
-  BENCHMARK_RELATIVE_MULTI(name##SliceUnaligned) { \
-    return runSlice(*data->name##Vector, 1);       \
-  }                                                \
-  BENCHMARK_RELATIVE_MULTI(name##Copy) {           \
-    return runCopy(*data->name##Vector);           \
+// Copies every other row of the slices, like the gathers of join and sort
+// outputs. The copies use 'pool', so that they share the string buffers of
+// 'vec' only if 'pool' is its pool.
+int runGather(const BaseVector& vec, memory::MemoryPool* pool) {
+  std::vector<BaseVector::CopyRange> ranges;
+  for (vector_size_t i = 0; i < FLAGS_slice_size / 2; ++i) {
+    ranges.push_back({2 * i, i, 1});
+  }
+  int count = 0;
+  for (int i = 0; i + FLAGS_slice_size < vec.size(); i += FLAGS_slice_size) {
+    auto copy = BaseVector::create(vec.type(), ranges.size(), pool);
+    copy->copyRanges(&vec, ranges);
+    folly::doNotOptimizeAway(copy);
+    ++count;
+    for (auto& range : ranges) {
+      range.sourceIndex += FLAGS_slice_size;
+    }
+  }
+  return count;
+}
+
+#define DEFINE_BENCHMARKS(name)                                        \
+  BENCHMARK_MULTI(name##Slice) {                                       \
+    return runSlice(*data->name##Vector, 0);                           \
+  }                                                                    \
+  BENCHMARK_RELATIVE_MULTI(name##SliceUnaligned) {                     \
+    return runSlice(*data->name##Vector, 1);                           \
+  }                                                                    \
+  BENCHMARK_RELATIVE_MULTI(name##Copy) {                               \
+    return runCopy(*data->name##Vector);                               \
+  }                                                                    \
+  BENCHMARK_RELATIVE_MULTI(name##Gather) {                             \
+    return runGather(*data->name##Vector, data->name##Vector->pool()); \
+  }                                                                    \
+  BENCHMARK_RELATIVE_MULTI(name##GatherToOtherPool) {                  \
+    return runGather(*data->name##Vector, data->copyPool.get());       \
   }
 
 DEFINE_BENCHMARKS(flat)
 DEFINE_BENCHMARKS(array)
 DEFINE_BENCHMARKS(map)
 DEFINE_BENCHMARKS(row)
+DEFINE_BENCHMARKS(string)
+DEFINE_BENCHMARKS(nested)
 
 } // namespace
 } // namespace facebook::velox
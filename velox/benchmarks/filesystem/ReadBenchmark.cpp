@@ -30,7 +30,17 @@ DEFINE_int64(
     "of --path. 0 means use the whole file");
 DEFINE_int32(num_threads, 16, "Test paralelism");
 DEFINE_int32(seed, 0, "Random seed, 0 means no seed");
-DEFINE_bool(odirect, false, "Use O_DIRECT");
+DEFINE_bool(
+    odirect,
+    false,
+    "Read local files with O_DIRECT. Same as 'direct' in "
+    "--file_create_config");
+DEFINE_string(
+    file_create_config,
+    "",
+    "FileOptions::kFileCreateConfig of the opened file. For local files, a "
+    "comma separated list of 'io_uring' and 'direct' to compare io_uring "
+    "and O_DIRECT reads with the default pread");
 
 DEFINE_int32(
     bytes,
@@ -86,38 +96,30 @@ std::shared_ptr<Config> readConfig(const std::string& filePath) {
 // Initialize a LocalReadFile instance for the specified 'path'.
 void ReadBenchmark::initialize() {
   executor_ = std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_num_threads);
+  filesystems::registerLocalFileSystem();
+  filesystems::registerS3FileSystem();
+  filesystems::registerGCSFileSystem();
+  filesystems::registerHdfsFileSystem();
+  filesystems::abfs::registerAbfsFileSystem();
+  std::shared_ptr<Config> config;
+  if (!FLAGS_config.empty()) {
+    config = readConfig(FLAGS_config);
+  }
+  auto fileCreateConfig = FLAGS_file_create_config;
   if (FLAGS_odirect) {
-    int32_t o_direct =
-#ifdef linux
-        O_DIRECT;
-#else
-        0;
-#endif
-    fd_ = open(
-        FLAGS_path.c_str(),
-        O_CREAT | O_RDWR | (FLAGS_odirect ? o_direct : 0),
-        S_IRUSR | S_IWUSR);
-    if (fd_ < 0) {
-      LOG(ERROR) << "Could not open " << FLAGS_path;
-      exit(1);
-    }
-    readFile_ = std::make_unique<LocalReadFile>(fd_);
-  } else {
-    filesystems::registerLocalFileSystem();
-    filesystems::registerS3FileSystem();
-    filesystems::registerGCSFileSystem();
-    filesystems::registerHdfsFileSystem();
-    filesystems::abfs::registerAbfsFileSystem();
-    std::shared_ptr<Config> config;
-    if (!FLAGS_config.empty()) {
-      config = readConfig(FLAGS_config);
-    }
-    auto fs = filesystems::getFileSystem(FLAGS_path, config);
-    readFile_ = fs->openFileForRead(FLAGS_path);
-    fileSize_ = readFile_->size();
-    if (FLAGS_file_size_gb) {
-      fileSize_ = std::min<uint64_t>(FLAGS_file_size_gb << 30, fileSize_);
-    }
+    fileCreateConfig += ",direct";
+  }
+  auto fs = filesystems::getFileSystem(FLAGS_path, config);
+  readFile_ = fs->openFileForRead(
+      FLAGS_path,
+      filesystems::FileOptions{
+          {{filesystems::FileOptions::kFileCreateConfig.toString(),
+            fileCreateConfig}},
+          nullptr,
+          std::nullopt});
+  fileSize_ = readFile_->size();
+  if (FLAGS_file_size_gb) {
+    fileSize_ = std::min<uint64_t>(FLAGS_file_size_gb << 30, fileSize_);
   }
 
   if (fileSize_ <= FLAGS_measurement_size) {
@@ -145,5 +147,9 @@ void ReadBenchmark::run() {
   modes(16 * 1024, 10000, 10);
   modes(1000000, 0, 8);
   modes(1000000, 100000, 8);
+  // Large coalesced reads like the ones of DirectBufferedInput. These show
+  // the effect of splitting reads into parts, e.g. with
+  // hive.s3.read-part-size in --config for an s3:// --path.
+  modes(8 << 20, 0, 4);
 }
 } // namespace facebook::velox
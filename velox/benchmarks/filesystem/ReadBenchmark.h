@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <deque>
 #include <iostream>
 
 #include <fcntl.h>
@@ -47,7 +48,7 @@ DECLARE_string(config);
 
 namespace facebook::velox {
 
-enum class Mode { Pread = 0, Preadv = 1, Multiple = 2 };
+enum class Mode { Pread = 0, Preadv = 1, Multiple = 2, PreadvAsync = 3 };
 
 // Struct to read data into. If we read contiguous and then copy to
 // non-contiguous buffers, we read to 'buffer' and copy to
@@ -106,6 +107,8 @@ class ReadBenchmark {
     clearCache();
     std::vector<folly::Promise<bool>> promises;
     std::vector<folly::SemiFuture<bool>> futures;
+    // Destination buffers of parallel preadvAsync reads.
+    std::deque<std::string> asyncBuffers;
     uint64_t usec = 0;
     std::string label;
     {
@@ -191,6 +194,33 @@ class ReadBenchmark {
 
             break;
           }
+          case Mode::PreadvAsync: {
+            // Issues the reads without an executor thread per read. With
+            // 'parallel', all reads are in flight at the same time, each into
+            // its own buffer.
+            label = "1 preadvAsync";
+            std::string* buffer = &globalScratch.buffer;
+            if (parallel) {
+              asyncBuffers.emplace_back(rangeSize, 0);
+              buffer = &asyncBuffers.back();
+            }
+            std::vector<folly::Range<char*>> ranges;
+            for (auto start = 0; start < rangeSize; start += size + gap) {
+              ranges.push_back(
+                  folly::Range<char*>(buffer->data() + start, size));
+              if (gap && start + gap < rangeSize) {
+                ranges.push_back(folly::Range<char*>(nullptr, gap));
+              }
+            }
+            auto future = readFile_->preadvAsync(offset, ranges);
+            if (parallel) {
+              futures.back() = std::move(future).deferValue(
+                  [](uint64_t /*unused*/) { return true; });
+            } else {
+              std::move(future).get();
+            }
+            break;
+          }
           case Mode::Multiple: {
             label = "multiple pread";
             if (parallel) {
@@ -253,6 +283,10 @@ class ReadBenchmark {
     randomReads(size, gap, count, repeats, Mode::Pread, true);
     randomReads(size, gap, count, repeats, Mode::Preadv, true);
     randomReads(size, gap, count, repeats, Mode::Multiple, true);
+    if (readFile_->hasPreadvAsync()) {
+      randomReads(size, gap, count, repeats, Mode::PreadvAsync, false);
+      randomReads(size, gap, count, repeats, Mode::PreadvAsync, true);
+    }
   }
 
   void run();
@@ -262,7 +296,6 @@ class ReadBenchmark {
   static constexpr int32_t kWrite = -10000;
   // 0 means no op, kWrite means being written, other numbers are reader counts.
   std::string writeBatch_;
-  int32_t fd_;
   std::unique_ptr<folly::IOThreadPoolExecutor> executor_;
   std::unique_ptr<ReadFile> readFile_;
   folly::Random::DefaultGenerator rng_;
@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/compression/Compression.h"
+#include "velox/common/file/File.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/common/time/Timer.h"
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/common/ReaderFactory.h"
+#include "velox/dwio/common/Writer.h"
+#include "velox/dwio/common/tests/utils/DataSetBuilder.h"
+#include "velox/dwio/common/tests/utils/FilterGenerator.h"
+#include "velox/dwio/dwrf/reader/DwrfReader.h"
+#include "velox/dwio/dwrf/writer/Writer.h"
+#include "velox/dwio/parquet/RegisterParquetReader.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+
+#include <folly/String.h>
+#include <folly/init/Init.h>
+
+#include <iostream>
+
+DEFINE_string(formats, "dwrf,parquet", "Comma separated file formats");
+DEFINE_string(
+    encodings,
+    "dictionary,plain,delta",
+    "Comma separated encodings. 'plain' is direct encoding in DWRF. 'delta' "
+    "is DELTA_BINARY_PACKED and only applies to Parquet integers");
+DEFINE_string(
+    compressions,
+    "none,zlib,snappy,zstd",
+    "Comma separated compression kinds. Kinds a writer does not support are "
+    "skipped");
+DEFINE_string(
+    null_pcts,
+    "0,20,80",
+    "Comma separated percentages of null values");
+DEFINE_string(
+    selectivity_pcts,
+    "100,50,10,1",
+    "Comma separated percentages of rows passing a range filter on the "
+    "column. 100 reads without a filter");
+DEFINE_string(
+    types,
+    "bigint,integer,double,varchar",
+    "Comma separated column types out of bigint, integer, smallint, double, "
+    "real and varchar");
+DEFINE_int32(
+    cardinality,
+    1'000,
+    "Number of distinct values of the column, so that dictionaries pay off. "
+    "0 means random values");
+DEFINE_int32(num_batches, 20, "Number of batches written to each file");
+DEFINE_int32(batch_rows, 50'000, "Rows in each batch written");
+DEFINE_int32(read_batch_rows, 10'000, "Rows asked from each RowReader::next");
+DEFINE_int32(iterations, 3, "Reads of each file. The fastest is reported");
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+
+// Writes single column files for each combination of format, encoding,
+// compression, null ratio and type to memory and reads them with filters of
+// several selectivities through the ScanSpec and RowReader path that
+// TableScan uses. Prints the rows and bytes read per second for each
+// combination.
+namespace {
+
+std::vector<std::string> splitList(const std::string& list) {
+  std::vector<std::string> items;
+  folly::split(',', list, items, true);
+  return items;
+}
+
+std::vector<int32_t> splitIntList(const std::string& list) {
+  std::vector<int32_t> values;
+  for (const auto& item : splitList(list)) {
+    values.push_back(std::stoi(item));
+  }
+  return values;
+}
+
+TypePtr typeFromName(const std::string& name) {
+  static const std::unordered_map<std::string, TypePtr> kTypes = {
+      {"bigint", BIGINT()},
+      {"integer", INTEGER()},
+      {"smallint", SMALLINT()},
+      {"double", DOUBLE()},
+      {"real", REAL()},
+      {"varchar", VARCHAR()}};
+  auto it = kTypes.find(name);
+  VELOX_USER_CHECK(it != kTypes.end(), "Unsupported type {}", name);
+  return it->second;
+}
+
+FileFormat formatFromName(const std::string& name) {
+  if (name == "dwrf") {
+    return FileFormat::DWRF;
+  }
+  VELOX_USER_CHECK_EQ(name, "parquet", "Unsupported file format");
+  return FileFormat::PARQUET;
+}
+
+common::FilterKind filterKind(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return common::FilterKind::kBigintRange;
+    case TypeKind::REAL:
+      return common::FilterKind::kFloatRange;
+    case TypeKind::DOUBLE:
+      return common::FilterKind::kDoubleRange;
+    case TypeKind::VARCHAR:
+      return common::FilterKind::kBytesRange;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+class ReaderMatrixBenchmark {
+ public:
+  ReaderMatrixBenchmark()
+      : rootPool_(memory::memoryManager()->addRootPool("readerMatrix")),
+        leafPool_(rootPool_->addLeafChild("readerMatrix")) {}
+
+  void run() {
+    printRow(
+        "format",
+        "encoding",
+        "codec",
+        "type",
+        "null%",
+        "sel%",
+        "file",
+        "rows/s",
+        "bytes/s",
+        "passed");
+    for (const auto& typeName : splitList(FLAGS_types)) {
+      const auto rowType = ROW({"c0"}, {typeFromName(typeName)});
+      for (auto nullPct : splitIntList(FLAGS_null_pcts)) {
+        const auto batches = makeData(rowType, nullPct);
+        const auto filters = makeFilters(rowType, *batches);
+        for (const auto& formatName : splitList(FLAGS_formats)) {
+          const auto format = formatFromName(formatName);
+          for (const auto& encoding : splitList(FLAGS_encodings)) {
+            for (const auto& codec : splitList(FLAGS_compressions)) {
+              const auto compression = common::stringToCompressionKind(codec);
+              if (!write(format, encoding, compression, rowType, *batches)) {
+                continue;
+              }
+              for (const auto& [selectivityPct, filter] : filters) {
+                uint64_t passed = 0;
+                const auto micros = std::max<uint64_t>(
+                    read(format, rowType, *filter, passed), 1);
+                const uint64_t numRows =
+                    (uint64_t)FLAGS_num_batches * FLAGS_batch_rows;
+                printRow(
+                    formatName,
+                    encoding,
+                    codec,
+                    typeName,
+                    nullPct,
+                    selectivityPct,
+                    succinctBytes(fileData_.size()),
+                    numRows * 1'000'000 / micros,
+                    succinctBytes(fileData_.size() * 1'000'000 / micros),
+                    passed);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+ private:
+  template <typename... Args>
+  static void printRow(const Args&... args) {
+    std::cout << fmt::format(
+                     "{:<8} {:<10} {:<7} {:<8} {:>5} {:>5} {:>10} {:>12} "
+                     "{:>10} {:>10}",
+                     args...)
+              << std::endl;
+  }
+
+  std::unique_ptr<std::vector<RowVectorPtr>> makeData(
+      const RowTypePtr& rowType,
+      int32_t nullPct) {
+    facebook::velox::test::DataSetBuilder builder(*leafPool_, 0);
+    builder.makeDataset(rowType, FLAGS_num_batches, FLAGS_batch_rows)
+        .withNullsForField(common::Subfield("c0"), nullPct);
+    if (FLAGS_cardinality > 0) {
+      const common::Subfield field("c0");
+      switch (rowType->childAt(0)->kind()) {
+        case TypeKind::SMALLINT:
+          builder.withIntDistributionForField<int16_t>(
+              field, 0, FLAGS_cardinality, 0, 0, 0, 0, true);
+          break;
+        case TypeKind::INTEGER:
+          builder.withIntDistributionForField<int32_t>(
+              field, 0, FLAGS_cardinality, 0, 0, 0, 0, true);
+          break;
+        case TypeKind::BIGINT:
+          builder.withIntDistributionForField<int64_t>(
+              field, 0, FLAGS_cardinality, 0, 0, 0, 0, true);
+          break;
+        case TypeKind::REAL:
+          builder.withQuantizedFloatForField<float>(
+              field, FLAGS_cardinality, true);
+          break;
+        case TypeKind::DOUBLE:
+          builder.withQuantizedFloatForField<double>(
+              field, FLAGS_cardinality, true);
+          break;
+        case TypeKind::VARCHAR:
+          builder.withStringDistributionForField(
+              field, FLAGS_cardinality, true, false);
+          break;
+        default:
+          VELOX_UNREACHABLE();
+      }
+    }
+    return builder.build();
+  }
+
+  // Returns the filters for each of --selectivity_pcts. 100 has no filter.
+  std::vector<std::pair<int32_t, std::unique_ptr<SubfieldFilters>>>
+  makeFilters(RowTypePtr rowType, const std::vector<RowVectorPtr>& batches) {
+    std::vector<std::pair<int32_t, std::unique_ptr<SubfieldFilters>>> filters;
+    for (auto selectivityPct : splitIntList(FLAGS_selectivity_pcts)) {
+      auto subfieldFilters = std::make_unique<SubfieldFilters>();
+      if (selectivityPct < 100) {
+        FilterGenerator generator(rowType, 0);
+        std::vector<uint64_t> hitRows;
+        *subfieldFilters = generator.makeSubfieldFilters(
+            {FilterSpec(
+                "c0",
+                0,
+                selectivityPct,
+                filterKind(rowType->childAt(0)),
+                false,
+                false)},
+            batches,
+            nullptr,
+            hitRows);
+      }
+      filters.emplace_back(selectivityPct, std::move(subfieldFilters));
+    }
+    return filters;
+  }
+
+  // Writes 'batches' to 'fileData_'. Returns false if the writer of 'format'
+  // has no 'encoding' or 'compression' for the type of 'rowType'.
+  bool write(
+      FileFormat format,
+      const std::string& encoding,
+      common::CompressionKind compression,
+      const RowTypePtr& rowType,
+      const std::vector<RowVectorPtr>& batches) {
+    auto sink = std::make_unique<MemorySink>(
+        64 << 20, FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    std::unique_ptr<Writer> writer;
+    if (format == FileFormat::DWRF) {
+      if (encoding == "delta" ||
+          (compression != common::CompressionKind_NONE &&
+           compression != common::CompressionKind_ZLIB &&
+           compression != common::CompressionKind_ZSTD)) {
+        return false;
+      }
+      auto config = std::make_shared<dwrf::Config>();
+      config->set(dwrf::Config::COMPRESSION, compression);
+      // A threshold of 0 makes the writer abandon dictionaries right away.
+      const float dictionaryThreshold = encoding == "dictionary" ? 1.0 : 0.0;
+      config->set(
+          dwrf::Config::DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD,
+          dictionaryThreshold);
+      config->set(
+          dwrf::Config::DICTIONARY_STRING_KEY_SIZE_THRESHOLD,
+          dictionaryThreshold);
+      dwrf::WriterOptions options;
+      options.config = config;
+      options.schema = rowType;
+      options.memoryPool = rootPool_.get();
+      writer = std::make_unique<dwrf::Writer>(std::move(sink), options);
+    } else {
+      const auto kind = rowType->childAt(0)->kind();
+      const bool isInteger = kind == TypeKind::SMALLINT ||
+          kind == TypeKind::INTEGER || kind == TypeKind::BIGINT;
+      if ((encoding == "delta" && !isInteger) ||
+          !parquet::Writer::isCodecAvailable(compression)) {
+        return false;
+      }
+      parquet::WriterOptions options;
+      options.compression = compression;
+      options.enableDictionary = encoding == "dictionary";
+      if (encoding == "delta") {
+        options.encoding = arrow::Encoding::DELTA_BINARY_PACKED;
+      }
+      options.memoryPool = rootPool_.get();
+      writer = std::make_unique<parquet::Writer>(
+          std::move(sink), options, rowType);
+    }
+    for (const auto& batch : batches) {
+      writer->write(batch);
+    }
+    writer->close();
+    // The writer owns the sink, so it is kept until the next write.
+    writer_ = std::move(writer);
+    fileData_ = std::string_view(sinkPtr->data(), sinkPtr->size());
+    return true;
+  }
+
+  // Reads the file in 'fileData_' --iterations times and returns the fastest
+  // time in microseconds. Sets 'passed' to the number of non-null values
+  // read.
+  uint64_t read(
+      FileFormat format,
+      RowTypePtr rowType,
+      const SubfieldFilters& filters,
+      uint64_t& passed) {
+    uint64_t bestMicros = std::numeric_limits<uint64_t>::max();
+    for (auto iteration = 0; iteration < FLAGS_iterations; ++iteration) {
+      uint64_t micros = 0;
+      passed = 0;
+      // A ScanSpec keeps state across reads, e.g. the order of filters.
+      auto scanSpec = FilterGenerator(rowType, 0).makeScanSpec(filters);
+      VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+      {
+        MicrosecondTimer timer(&micros);
+        ReaderOptions readerOptions{leafPool_.get()};
+        readerOptions.setFileFormat(format);
+        auto input = std::make_unique<BufferedInput>(
+            std::make_shared<InMemoryReadFile>(fileData_),
+            readerOptions.getMemoryPool());
+        auto reader = getReaderFactory(format)->createReader(
+            std::move(input), readerOptions);
+        RowReaderOptions rowReaderOptions;
+        rowReaderOptions.select(
+            std::make_shared<ColumnSelector>(rowType, rowType->names()));
+        rowReaderOptions.setScanSpec(scanSpec);
+        auto rowReader = reader->createRowReader(rowReaderOptions);
+        while (rowReader->next(FLAGS_read_batch_rows, result)) {
+          auto* column =
+              result->asUnchecked<RowVector>()->childAt(0)->loadedVector();
+          for (auto row = 0; row < column->size(); ++row) {
+            passed += !column->isNullAt(row);
+          }
+        }
+      }
+      bestMicros = std::min(bestMicros, micros);
+    }
+    return bestMicros;
+  }
+
+  const std::shared_ptr<memory::MemoryPool> rootPool_;
+  const std::shared_ptr<memory::MemoryPool> leafPool_;
+  std::unique_ptr<Writer> writer_;
+  std::string_view fileData_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  dwrf::registerDwrfReaderFactory();
+  parquet::registerParquetReaderFactory();
+  ReaderMatrixBenchmark().run();
+  return 0;
+}
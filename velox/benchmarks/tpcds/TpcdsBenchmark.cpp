@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/benchmarks/tpcds/TpcdsBenchmark.h"
+
+#include <folly/Benchmark.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <gflags/gflags.h>
+
+#include "velox/benchmarks/tpcds/TpcdsQueryBuilder.h"
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/connectors/hive/HiveConnector.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/Split.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+#include "velox/parse/TypeResolver.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+static bool notEmpty(const char* /*flagName*/, const std::string& value) {
+  return !value.empty();
+}
+} // namespace
+
+DEFINE_string(
+    data_path,
+    "",
+    "Root path of TPC-DS data in Parquet format with a directory per table, "
+    "e.g. /data/tpcds10/store_sales. The queries use store_sales, date_dim, "
+    "item, store, customer_demographics and promotion.");
+DEFINE_double(
+    generate_data_sf,
+    0,
+    "If > 0, generates the tables at this scale factor with DuckDB's dsdgen "
+    "and writes them under --data_path before running the queries");
+DEFINE_int32(
+    run_query_verbose,
+    -1,
+    "Run a given query and print execution statistics");
+DEFINE_bool(
+    include_custom_stats,
+    false,
+    "Include custom statistics along with execution statistics");
+DEFINE_bool(include_results, false, "Include results in the output");
+DEFINE_int32(num_drivers, 4, "Number of drivers");
+DEFINE_int32(num_splits_per_file, 10, "Number of splits per file");
+DEFINE_int32(num_repeats, 1, "Number of times to run each query");
+DEFINE_int32(num_io_threads, 8, "Threads for speculative IO");
+
+DEFINE_validator(data_path, &notEmpty);
+
+namespace {
+std::shared_ptr<TpcdsQueryBuilder> queryBuilder;
+
+class TpcdsBenchmark {
+ public:
+  void initialize() {
+    memory::MemoryManager::testingSetInstance({});
+    functions::prestosql::registerAllScalarFunctions();
+    aggregate::prestosql::registerAllAggregateFunctions();
+    window::prestosql::registerAllWindowFunctions();
+    parse::registerTypeResolver();
+    filesystems::registerLocalFileSystem();
+
+    ioExecutor_ =
+        std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_num_io_threads);
+    auto hiveConnector =
+        connector::getConnectorFactory(
+            connector::hive::HiveConnectorFactory::kHiveConnectorName)
+            ->newConnector(
+                kHiveConnectorId,
+                std::make_shared<core::MemConfig>(),
+                ioExecutor_.get());
+    connector::registerConnector(hiveConnector);
+  }
+
+  /// Runs 'plan' --num_repeats times and returns the cursor and results of the
+  /// last run.
+  std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> run(
+      const TpchPlan& plan) {
+    std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> result;
+    for (auto repeat = 0; repeat < FLAGS_num_repeats; ++repeat) {
+      CursorParameters params;
+      params.maxDrivers = FLAGS_num_drivers;
+      params.planNode = plan.plan;
+      bool noMoreSplits = false;
+      auto addSplits = [&](Task* task) {
+        if (noMoreSplits) {
+          return;
+        }
+        for (const auto& [planNodeId, paths] : plan.dataFiles) {
+          for (const auto& path : paths) {
+            for (const auto& split :
+                 HiveConnectorTestBase::makeHiveConnectorSplits(
+                     path, FLAGS_num_splits_per_file, plan.dataFileFormat)) {
+              task->addSplit(planNodeId, Split(split));
+            }
+          }
+          task->noMoreSplits(planNodeId);
+        }
+        noMoreSplits = true;
+      };
+      result = readCursor(params, addSplits);
+      VELOX_CHECK(waitForTaskCompletion(result.first->task().get()));
+    }
+    return result;
+  }
+
+  /// Runs the folly benchmarks or, with --run_query_verbose, one query and
+  /// prints its results and per operator statistics to 'out'.
+  void runMain(std::ostream& out) {
+    if (FLAGS_run_query_verbose == -1) {
+      folly::runBenchmarks();
+      return;
+    }
+    const auto plan = queryBuilder->getQueryPlan(FLAGS_run_query_verbose);
+    auto [cursor, results] = run(plan);
+    if (FLAGS_include_results) {
+      out << "Results:" << std::endl;
+      for (const auto& vector : results) {
+        for (vector_size_t i = 0; i < vector->size(); ++i) {
+          out << vector->toString(i) << std::endl;
+        }
+      }
+      out << std::endl;
+    }
+    const auto stats = cursor->task()->taskStats();
+    out << fmt::format(
+               "Execution time: {}",
+               succinctMillis(
+                   stats.executionEndTimeMs - stats.executionStartTimeMs))
+        << std::endl;
+    out << printPlanWithStats(*plan.plan, stats, FLAGS_include_custom_stats)
+        << std::endl;
+  }
+
+ private:
+  std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
+};
+
+TpcdsBenchmark benchmark;
+
+BENCHMARK(q3) {
+  benchmark.run(queryBuilder->getQueryPlan(3));
+}
+
+BENCHMARK(q7) {
+  benchmark.run(queryBuilder->getQueryPlan(7));
+}
+
+BENCHMARK(q27) {
+  benchmark.run(queryBuilder->getQueryPlan(27));
+}
+
+BENCHMARK(q43) {
+  benchmark.run(queryBuilder->getQueryPlan(43));
+}
+
+BENCHMARK(q98) {
+  benchmark.run(queryBuilder->getQueryPlan(98));
+}
+} // namespace
+
+int tpcdsBenchmarkMain() {
+  benchmark.initialize();
+  if (FLAGS_generate_data_sf > 0) {
+    auto pool = memory::memoryManager()->addLeafPool();
+    TpcdsQueryBuilder::generateData(
+        FLAGS_generate_data_sf, FLAGS_data_path, pool.get());
+  }
+  queryBuilder = std::make_shared<TpcdsQueryBuilder>();
+  queryBuilder->initialize(FLAGS_data_path);
+  benchmark.runMain(std::cout);
+  queryBuilder.reset();
+  return 0;
+}
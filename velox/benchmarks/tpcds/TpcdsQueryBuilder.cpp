@@ -0,0 +1,661 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/benchmarks/tpcds/TpcdsQueryBuilder.h"
+
+#include <duckdb.hpp> // @manual
+
+#include "velox/common/base/Fs.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/duckdb/conversion/DuckConversion.h"
+#include "velox/dwio/common/ReaderFactory.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+
+namespace facebook::velox::exec::test {
+
+namespace {
+// Number of rows written by one table write.
+constexpr int64_t kRowsPerWrite = 1'000'000;
+
+RowTypePtr readFileSchema(
+    const std::string& filePath,
+    memory::MemoryPool* pool) {
+  dwio::common::ReaderOptions readerOptions{pool};
+  readerOptions.setFileFormat(dwio::common::FileFormat::PARQUET);
+  std::shared_ptr<ReadFile> readFile =
+      filesystems::getFileSystem(filePath, nullptr)->openFileForRead(filePath);
+  auto input = std::make_unique<dwio::common::BufferedInput>(
+      readFile, readerOptions.getMemoryPool());
+  auto reader = dwio::common::getReaderFactory(readerOptions.getFileFormat())
+                    ->createReader(std::move(input), readerOptions);
+  return reader->rowType();
+}
+
+std::vector<std::string> mergeColumnNames(
+    std::vector<std::string> first,
+    const std::vector<std::string>& second) {
+  first.insert(first.end(), second.begin(), second.end());
+  return first;
+}
+
+RowTypePtr toRowType(const ::duckdb::MaterializedQueryResult& result) {
+  std::vector<TypePtr> types;
+  for (const auto& type : result.types) {
+    auto veloxType = duckdb::toVeloxType(type);
+    types.push_back(veloxType->isDecimal() ? DOUBLE() : veloxType);
+  }
+  return ROW(std::vector<std::string>(result.names), std::move(types));
+}
+
+VectorPtr toVector(
+    const ::duckdb::DataChunk& chunk,
+    int32_t column,
+    const TypePtr& type,
+    memory::MemoryPool* pool) {
+  const vector_size_t size = chunk.size();
+  auto vector = BaseVector::create(type, size, pool);
+  for (vector_size_t row = 0; row < size; ++row) {
+    const auto value = chunk.GetValue(column, row);
+    if (value.IsNull()) {
+      vector->setNull(row, true);
+      continue;
+    }
+    switch (type->kind()) {
+      case TypeKind::INTEGER:
+        vector->asFlatVector<int32_t>()->set(
+            row,
+            type->isDate()
+                ? ::duckdb::Date::EpochDays(value.GetValue<::duckdb::date_t>())
+                : value.GetValue<int32_t>());
+        break;
+      case TypeKind::BIGINT:
+        vector->asFlatVector<int64_t>()->set(row, value.GetValue<int64_t>());
+        break;
+      case TypeKind::DOUBLE:
+        // Decimals are converted to double.
+        vector->asFlatVector<double>()->set(row, value.GetValue<double>());
+        break;
+      case TypeKind::VARCHAR:
+        vector->asFlatVector<StringView>()->set(
+            row, StringView(::duckdb::StringValue::Get(value)));
+        break;
+      default:
+        VELOX_UNSUPPORTED(
+            "Type of TPC-DS column is not supported: {}", type->toString());
+    }
+  }
+  return vector;
+}
+
+RowVectorPtr toRowVector(
+    const ::duckdb::DataChunk& chunk,
+    const RowTypePtr& rowType,
+    memory::MemoryPool* pool) {
+  std::vector<VectorPtr> children;
+  for (auto i = 0; i < rowType->size(); ++i) {
+    children.push_back(toVector(chunk, i, rowType->childAt(i), pool));
+  }
+  return std::make_shared<RowVector>(
+      pool, rowType, nullptr, chunk.size(), std::move(children));
+}
+
+void writeParquet(
+    const std::vector<RowVectorPtr>& data,
+    const std::string& directory,
+    memory::MemoryPool* pool) {
+  auto plan = PlanBuilder()
+                  .values(data)
+                  .tableWrite(directory, dwio::common::FileFormat::PARQUET)
+                  .planNode();
+  AssertQueryBuilder(plan).copyResults(pool);
+}
+} // namespace
+
+void TpcdsQueryBuilder::initialize(const std::string& dataPath) {
+  for (const auto& tableName : getTableNames()) {
+    auto& metadata = tableMetadata_[tableName];
+    for (const auto& dirEntry :
+         fs::directory_iterator{fs::path(dataPath) / tableName}) {
+      // Ignore hidden files.
+      if (!dirEntry.is_regular_file() ||
+          dirEntry.path().filename().c_str()[0] == '.') {
+        continue;
+      }
+      if (metadata.dataFiles.empty()) {
+        metadata.type = readFileSchema(dirEntry.path().string(), pool_.get());
+      }
+      metadata.dataFiles.push_back(dirEntry.path());
+    }
+    VELOX_CHECK(
+        !metadata.dataFiles.empty(), "No data files for table {}", tableName);
+  }
+}
+
+TpchPlan TpcdsQueryBuilder::getQueryPlan(int queryId) const {
+  switch (queryId) {
+    case 3:
+      return getQ3Plan();
+    case 7:
+      return getQ7Plan();
+    case 27:
+      return getQ27Plan();
+    case 43:
+      return getQ43Plan();
+    case 98:
+      return getQ98Plan();
+    default:
+      VELOX_NYI("TPC-DS query {} is not supported yet", queryId);
+  }
+}
+
+// static
+const std::vector<int>& TpcdsQueryBuilder::getQueryIds() {
+  static const std::vector<int> kQueryIds = {3, 7, 27, 43, 98};
+  return kQueryIds;
+}
+
+// static
+const std::vector<std::string>& TpcdsQueryBuilder::getTableNames() {
+  static const std::vector<std::string> kTableNames = {
+      kStoreSales,
+      kDateDim,
+      kItem,
+      kStore,
+      kCustomerDemographics,
+      kPromotion};
+  return kTableNames;
+}
+
+// static
+void TpcdsQueryBuilder::generateData(
+    double scaleFactor,
+    const std::string& dataPath,
+    memory::MemoryPool* pool) {
+  DuckDbQueryRunner duckDb;
+  duckDb.execute("LOAD tpcds");
+  duckDb.execute(fmt::format("CALL dsdgen(sf={})", scaleFactor));
+  for (const auto& tableName : getTableNames()) {
+    const auto directory = fmt::format("{}/{}", dataPath, tableName);
+    auto result = duckDb.execute(fmt::format("SELECT * FROM {}", tableName));
+    const auto rowType = toRowType(*result);
+    std::vector<RowVectorPtr> data;
+    int64_t numRows = 0;
+    for (;;) {
+      auto chunk = result->Fetch();
+      if (!chunk || chunk->size() == 0) {
+        break;
+      }
+      data.push_back(toRowVector(*chunk, rowType, pool));
+      numRows += chunk->size();
+      if (numRows >= kRowsPerWrite) {
+        writeParquet(data, directory, pool);
+        data.clear();
+        numRows = 0;
+      }
+    }
+    if (!data.empty()) {
+      writeParquet(data, directory, pool);
+    }
+    LOG(INFO) << "Wrote TPC-DS table " << tableName << " to " << directory;
+  }
+}
+
+PlanBuilder TpcdsQueryBuilder::scan(
+    const std::shared_ptr<core::PlanNodeIdGenerator>& planNodeIdGenerator,
+    const std::string& tableName,
+    const std::vector<std::string>& columns,
+    const std::vector<std::string>& filters,
+    core::PlanNodeId& planNodeId,
+    const std::string& remainingFilter) const {
+  auto columnSelector = std::make_shared<dwio::common::ColumnSelector>(
+      tableMetadata_.at(tableName).type, columns);
+  PlanBuilder builder(planNodeIdGenerator, pool_.get());
+  builder
+      .tableScan(
+          tableName,
+          columnSelector->buildSelectedReordered(),
+          {},
+          filters,
+          remainingFilter)
+      .capturePlanNodeId(planNodeId);
+  return builder;
+}
+
+TpchPlan TpcdsQueryBuilder::makePlan(
+    core::PlanNodePtr plan,
+    const std::vector<std::pair<core::PlanNodeId, std::string>>& scans)
+    const {
+  TpchPlan context;
+  context.plan = std::move(plan);
+  for (const auto& [planNodeId, tableName] : scans) {
+    context.dataFiles[planNodeId] = tableMetadata_.at(tableName).dataFiles;
+  }
+  context.dataFileFormat = dwio::common::FileFormat::PARQUET;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getQ3Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId storeSalesPlanNodeId;
+  core::PlanNodeId dateDimPlanNodeId;
+  core::PlanNodeId itemPlanNodeId;
+
+  auto items = scan(planNodeIdGenerator,
+                    kItem,
+                    {"i_item_sk", "i_brand_id", "i_brand", "i_manufact_id"},
+                    {"i_manufact_id = 128"},
+                    itemPlanNodeId)
+                   .planNode();
+  auto dates = scan(planNodeIdGenerator,
+                    kDateDim,
+                    {"d_date_sk", "d_year", "d_moy"},
+                    {"d_moy = 11"},
+                    dateDimPlanNodeId)
+                   .planNode();
+
+  auto plan =
+      scan(planNodeIdGenerator,
+           kStoreSales,
+           {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"},
+           {},
+           storeSalesPlanNodeId)
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"ss_sold_date_sk",
+               "ss_ext_sales_price",
+               "i_brand_id",
+               "i_brand"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"d_year", "i_brand_id", "i_brand", "ss_ext_sales_price"})
+          .partialAggregation(
+              {"d_year", "i_brand", "i_brand_id"},
+              {"sum(ss_ext_sales_price) AS sum_agg"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN({"d_year", "sum_agg DESC", "i_brand_id"}, 100, false)
+          .project(
+              {"d_year",
+               "i_brand_id AS brand_id",
+               "i_brand AS brand",
+               "sum_agg"})
+          .planNode();
+
+  return makePlan(
+      std::move(plan),
+      {{storeSalesPlanNodeId, kStoreSales},
+       {dateDimPlanNodeId, kDateDim},
+       {itemPlanNodeId, kItem}});
+}
+
+TpchPlan TpcdsQueryBuilder::getQ7Plan() const {
+  const std::vector<std::string> measures = {
+      "ss_quantity", "ss_list_price", "ss_coupon_amt", "ss_sales_price"};
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId storeSalesPlanNodeId;
+  core::PlanNodeId demographicsPlanNodeId;
+  core::PlanNodeId dateDimPlanNodeId;
+  core::PlanNodeId promotionPlanNodeId;
+  core::PlanNodeId itemPlanNodeId;
+
+  auto demographics =
+      scan(planNodeIdGenerator,
+           kCustomerDemographics,
+           {"cd_demo_sk",
+            "cd_gender",
+            "cd_marital_status",
+            "cd_education_status"},
+           {"cd_gender = 'M'",
+            "cd_marital_status = 'S'",
+            "cd_education_status = 'College'"},
+           demographicsPlanNodeId)
+          .planNode();
+  auto dates = scan(planNodeIdGenerator,
+                    kDateDim,
+                    {"d_date_sk", "d_year"},
+                    {"d_year = 2000"},
+                    dateDimPlanNodeId)
+                   .planNode();
+  auto promotions =
+      scan(planNodeIdGenerator,
+           kPromotion,
+           {"p_promo_sk", "p_channel_email", "p_channel_event"},
+           {},
+           promotionPlanNodeId,
+           "p_channel_email = 'N' OR p_channel_event = 'N'")
+          .planNode();
+  auto items = scan(planNodeIdGenerator,
+                    kItem,
+                    {"i_item_sk", "i_item_id"},
+                    {},
+                    itemPlanNodeId)
+                   .planNode();
+
+  auto plan =
+      scan(planNodeIdGenerator,
+           kStoreSales,
+           mergeColumnNames(
+               {"ss_sold_date_sk", "ss_item_sk", "ss_cdemo_sk", "ss_promo_sk"},
+               measures),
+           {},
+           storeSalesPlanNodeId)
+          .hashJoin(
+              {"ss_cdemo_sk"},
+              {"cd_demo_sk"},
+              demographics,
+              "",
+              mergeColumnNames(
+                  {"ss_sold_date_sk", "ss_item_sk", "ss_promo_sk"}, measures))
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              mergeColumnNames({"ss_item_sk", "ss_promo_sk"}, measures))
+          .hashJoin(
+              {"ss_promo_sk"},
+              {"p_promo_sk"},
+              promotions,
+              "",
+              mergeColumnNames({"ss_item_sk"}, measures))
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              mergeColumnNames({"i_item_id"}, measures))
+          .partialAggregation(
+              {"i_item_id"},
+              {"avg(ss_quantity) AS agg1",
+               "avg(ss_list_price) AS agg2",
+               "avg(ss_coupon_amt) AS agg3",
+               "avg(ss_sales_price) AS agg4"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN({"i_item_id"}, 100, false)
+          .planNode();
+
+  return makePlan(
+      std::move(plan),
+      {{storeSalesPlanNodeId, kStoreSales},
+       {demographicsPlanNodeId, kCustomerDemographics},
+       {dateDimPlanNodeId, kDateDim},
+       {promotionPlanNodeId, kPromotion},
+       {itemPlanNodeId, kItem}});
+}
+
+TpchPlan TpcdsQueryBuilder::getQ27Plan() const {
+  const std::vector<std::string> measures = {
+      "ss_quantity", "ss_list_price", "ss_coupon_amt", "ss_sales_price"};
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId storeSalesPlanNodeId;
+  core::PlanNodeId demographicsPlanNodeId;
+  core::PlanNodeId dateDimPlanNodeId;
+  core::PlanNodeId storePlanNodeId;
+  core::PlanNodeId itemPlanNodeId;
+
+  auto demographics =
+      scan(planNodeIdGenerator,
+           kCustomerDemographics,
+           {"cd_demo_sk",
+            "cd_gender",
+            "cd_marital_status",
+            "cd_education_status"},
+           {"cd_gender = 'M'",
+            "cd_marital_status = 'S'",
+            "cd_education_status = 'College'"},
+           demographicsPlanNodeId)
+          .planNode();
+  auto dates = scan(planNodeIdGenerator,
+                    kDateDim,
+                    {"d_date_sk", "d_year"},
+                    {"d_year = 2002"},
+                    dateDimPlanNodeId)
+                   .planNode();
+  // The s_state IN list of the query has only 'TN'.
+  auto stores = scan(planNodeIdGenerator,
+                     kStore,
+                     {"s_store_sk", "s_state"},
+                     {"s_state = 'TN'"},
+                     storePlanNodeId)
+                    .planNode();
+  auto items = scan(planNodeIdGenerator,
+                    kItem,
+                    {"i_item_sk", "i_item_id"},
+                    {},
+                    itemPlanNodeId)
+                   .planNode();
+
+  // GROUP BY ROLLUP (i_item_id, s_state) is an aggregation over the grouping
+  // sets (i_item_id, s_state), (i_item_id) and ().
+  auto plan =
+      scan(planNodeIdGenerator,
+           kStoreSales,
+           mergeColumnNames(
+               {"ss_sold_date_sk", "ss_item_sk", "ss_cdemo_sk", "ss_store_sk"},
+               measures),
+           {},
+           storeSalesPlanNodeId)
+          .hashJoin(
+              {"ss_cdemo_sk"},
+              {"cd_demo_sk"},
+              demographics,
+              "",
+              mergeColumnNames(
+                  {"ss_sold_date_sk", "ss_item_sk", "ss_store_sk"}, measures))
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              mergeColumnNames({"ss_item_sk", "ss_store_sk"}, measures))
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              mergeColumnNames({"ss_item_sk", "s_state"}, measures))
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              mergeColumnNames({"i_item_id", "s_state"}, measures))
+          .groupId(
+              {"i_item_id", "s_state"},
+              {{"i_item_id", "s_state"}, {"i_item_id"}, {}},
+              measures)
+          .partialAggregation(
+              {"i_item_id", "s_state", "group_id"},
+              {"avg(ss_quantity) AS agg1",
+               "avg(ss_list_price) AS agg2",
+               "avg(ss_coupon_amt) AS agg3",
+               "avg(ss_sales_price) AS agg4"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN({"i_item_id", "s_state"}, 100, false)
+          .project(
+              {"i_item_id",
+               "s_state",
+               "if(group_id = 0, 0, 1) AS g_state",
+               "agg1",
+               "agg2",
+               "agg3",
+               "agg4"})
+          .planNode();
+
+  return makePlan(
+      std::move(plan),
+      {{storeSalesPlanNodeId, kStoreSales},
+       {demographicsPlanNodeId, kCustomerDemographics},
+       {dateDimPlanNodeId, kDateDim},
+       {storePlanNodeId, kStore},
+       {itemPlanNodeId, kItem}});
+}
+
+TpchPlan TpcdsQueryBuilder::getQ43Plan() const {
+  // Day names and the prefixes of the columns of their sums.
+  static const std::vector<std::pair<std::string, std::string>> kDays = {
+      {"Sunday", "sun"},
+      {"Monday", "mon"},
+      {"Tuesday", "tue"},
+      {"Wednesday", "wed"},
+      {"Thursday", "thu"},
+      {"Friday", "fri"},
+      {"Saturday", "sat"}};
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId storeSalesPlanNodeId;
+  core::PlanNodeId dateDimPlanNodeId;
+  core::PlanNodeId storePlanNodeId;
+
+  auto dates = scan(planNodeIdGenerator,
+                    kDateDim,
+                    {"d_date_sk", "d_year", "d_day_name"},
+                    {"d_year = 2000"},
+                    dateDimPlanNodeId)
+                   .planNode();
+  auto stores =
+      scan(planNodeIdGenerator,
+           kStore,
+           {"s_store_sk", "s_store_id", "s_store_name", "s_gmt_offset"},
+           {},
+           storePlanNodeId,
+           "s_gmt_offset = -5.0")
+          .planNode();
+
+  std::vector<std::string> projections = {"s_store_name", "s_store_id"};
+  std::vector<std::string> aggregates;
+  std::vector<std::string> sortingKeys = {"s_store_name", "s_store_id"};
+  for (const auto& [day, name] : kDays) {
+    projections.push_back(fmt::format(
+        "CASE WHEN d_day_name = '{}' THEN ss_sales_price END AS {}_price",
+        day,
+        name));
+    aggregates.push_back(fmt::format("sum({}_price) AS {}_sales", name, name));
+    sortingKeys.push_back(fmt::format("{}_sales", name));
+  }
+
+  auto plan =
+      scan(planNodeIdGenerator,
+           kStoreSales,
+           {"ss_sold_date_sk", "ss_store_sk", "ss_sales_price"},
+           {},
+           storeSalesPlanNodeId)
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_store_sk", "ss_sales_price", "d_day_name"})
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              {"s_store_name", "s_store_id", "ss_sales_price", "d_day_name"})
+          .project(projections)
+          .partialAggregation({"s_store_name", "s_store_id"}, aggregates)
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN(sortingKeys, 100, false)
+          .planNode();
+
+  return makePlan(
+      std::move(plan),
+      {{storeSalesPlanNodeId, kStoreSales},
+       {dateDimPlanNodeId, kDateDim},
+       {storePlanNodeId, kStore}});
+}
+
+TpchPlan TpcdsQueryBuilder::getQ98Plan() const {
+  const std::vector<std::string> itemColumns = {
+      "i_item_id", "i_item_desc", "i_category", "i_class", "i_current_price"};
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId storeSalesPlanNodeId;
+  core::PlanNodeId dateDimPlanNodeId;
+  core::PlanNodeId itemPlanNodeId;
+
+  auto items = scan(planNodeIdGenerator,
+                    kItem,
+                    mergeColumnNames({"i_item_sk"}, itemColumns),
+                    {"i_category IN ('Sports', 'Books', 'Home')"},
+                    itemPlanNodeId)
+                   .planNode();
+  // d_date between '1999-02-22' and 30 days later.
+  auto dates =
+      scan(planNodeIdGenerator,
+           kDateDim,
+           {"d_date_sk", "d_date"},
+           {"d_date BETWEEN '1999-02-22'::DATE AND '1999-03-24'::DATE"},
+           dateDimPlanNodeId)
+          .planNode();
+
+  auto plan =
+      scan(planNodeIdGenerator,
+           kStoreSales,
+           {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"},
+           {},
+           storeSalesPlanNodeId)
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_item_sk", "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              mergeColumnNames(itemColumns, {"ss_ext_sales_price"}))
+          .partialAggregation(
+              itemColumns, {"sum(ss_ext_sales_price) AS itemrevenue"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .window(
+              {"sum(itemrevenue) OVER (PARTITION BY i_class) AS classrevenue"})
+          .project(mergeColumnNames(
+              itemColumns,
+              {"itemrevenue",
+               "itemrevenue * 100.0 / classrevenue AS revenueratio"}))
+          .orderBy(
+              {"i_category",
+               "i_class",
+               "i_item_id",
+               "i_item_desc",
+               "revenueratio"},
+              false)
+          .planNode();
+
+  return makePlan(
+      std::move(plan),
+      {{storeSalesPlanNodeId, kStoreSales},
+       {dateDimPlanNodeId, kDateDim},
+       {itemPlanNodeId, kItem}});
+}
+
+} // namespace facebook::velox::exec::test
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/Options.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TpchQueryBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+/// Builds plans for a subset of the TPC-DS queries. The data is in Parquet
+/// files in a directory with a sub-directory per table, as written by
+/// generateData(). The column names in the files are the standard TPC-DS
+/// names, e.g. ss_sold_date_sk. The queries cover joins of the fact table with
+/// several dimensions (q3, q7), ROLLUP (q27), conditional aggregation (q43)
+/// and a window function over an aggregation (q98).
+class TpcdsQueryBuilder {
+ public:
+  /// Reads the schema of the first data file of each table and lists the data
+  /// files of each table under 'dataPath'.
+  void initialize(const std::string& dataPath);
+
+  /// Returns the plan for TPC-DS query 'queryId'. The plan and its data files
+  /// are returned in a TpchPlan, which is not specific to TPC-H.
+  TpchPlan getQueryPlan(int queryId) const;
+
+  /// Returns the numbers of the queries for which there is a plan.
+  static const std::vector<int>& getQueryIds();
+
+  /// Returns the names of the tables scanned by the queries.
+  static const std::vector<std::string>& getTableNames();
+
+  /// Generates the tables in getTableNames() at 'scaleFactor' with the dsdgen
+  /// function of DuckDB and writes them as Parquet files under 'dataPath'.
+  /// Decimal columns are written as DOUBLE, like the prices in the TPC-H
+  /// data.
+  static void generateData(
+      double scaleFactor,
+      const std::string& dataPath,
+      memory::MemoryPool* pool);
+
+ private:
+  TpchPlan getQ3Plan() const;
+  TpchPlan getQ7Plan() const;
+  TpchPlan getQ27Plan() const;
+  TpchPlan getQ43Plan() const;
+  TpchPlan getQ98Plan() const;
+
+  // Returns a plan builder that scans 'columns' of 'tableName' with
+  // 'filters' and 'remainingFilter' and sets 'planNodeId' to the id of the
+  // scan.
+  PlanBuilder scan(
+      const std::shared_ptr<core::PlanNodeIdGenerator>& planNodeIdGenerator,
+      const std::string& tableName,
+      const std::vector<std::string>& columns,
+      const std::vector<std::string>& filters,
+      core::PlanNodeId& planNodeId,
+      const std::string& remainingFilter = "") const;
+
+  // Returns a plan with 'plan' and the data files of the scans in 'scans',
+  // which maps plan node ids to table names.
+  TpchPlan makePlan(
+      core::PlanNodePtr plan,
+      const std::vector<std::pair<core::PlanNodeId, std::string>>& scans)
+      const;
+
+  std::unordered_map<std::string, TpchTableMetadata> tableMetadata_;
+  std::shared_ptr<memory::MemoryPool> pool_ =
+      memory::memoryManager()->addLeafPool();
+
+  static constexpr const char* kStoreSales = "store_sales";
+  static constexpr const char* kDateDim = "date_dim";
+  static constexpr const char* kItem = "item";
+  static constexpr const char* kStore = "store";
+  static constexpr const char* kCustomerDemographics = "customer_demographics";
+  static constexpr const char* kPromotion = "promotion";
+};
+
+} // namespace facebook::velox::exec::test
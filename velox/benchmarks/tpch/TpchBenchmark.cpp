@@ -19,15 +19,19 @@
 #include <sys/time.h>
 
 #include <folly/Benchmark.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <gflags/gflags.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <fstream>
+#include <thread>
 
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/memory/MmapAllocator.h"
+#include "velox/common/memory/SharedArbitrator.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/dwio/common/Options.h"
@@ -116,6 +120,11 @@ DEFINE_bool(
     include_custom_stats,
     false,
     "Include custom statistics along with execution statistics");
+DEFINE_bool(
+    include_batch_histograms,
+    false,
+    "Include the batch size and latency histograms of the operators along "
+    "with execution statistics");
 DEFINE_bool(include_results, false, "Include results in the output");
 DEFINE_int32(num_drivers, 4, "Number of drivers");
 DEFINE_string(data_format, "parquet", "Data format");
@@ -184,6 +193,39 @@ DEFINE_int32(
 
 DEFINE_int32(split_preload_per_driver, 2, "Prefetch split metadata");
 
+DEFINE_int32(
+    num_query_streams,
+    0,
+    "If > 0, runs the queries in --concurrent_queries in this many "
+    "concurrent streams and reports the QPS and the latency percentiles of "
+    "each query. Each stream starts at a different query and runs the list "
+    "--num_repeats times");
+DEFINE_string(
+    concurrent_queries,
+    "1,3,5,6,7,8,9,10,12,13,14,15,16,17,18,19,20,21,22",
+    "Comma separated query numbers for --num_query_streams");
+DEFINE_int32(
+    num_executor_threads,
+    0,
+    "Threads of the executor shared by the queries of --num_query_streams. 0 "
+    "means the number of cores");
+DEFINE_string(
+    query_configs,
+    "",
+    "QueryConfig options for each query as key=value pairs separated by ';', "
+    "e.g. 'spill_enabled=true;max_spill_level=2'. Can be swept with "
+    "--test_flags_file");
+DEFINE_int32(
+    query_memory_gb,
+    0,
+    "If non-0, the queries share this many GB of memory through the shared "
+    "memory arbitrator");
+DEFINE_string(
+    task_stats_dir,
+    "",
+    "If non-empty, writes the TaskStats of each query run as JSON to a file "
+    "in this directory");
+
 struct RunStats {
   std::map<std::string, std::string> flags;
   int64_t micros{0};
@@ -210,6 +252,35 @@ struct RunStats {
   }
 };
 
+// Latencies of the runs of one query in --num_query_streams mode.
+struct QueryLatencies {
+  std::vector<uint64_t> micros;
+
+  // Returns the latency at 'percentile' of the sorted 'micros'.
+  uint64_t percentile(int32_t percentile) const {
+    VELOX_CHECK(!micros.empty());
+    return micros[std::min<size_t>(
+        micros.size() - 1, micros.size() * percentile / 100)];
+  }
+};
+
+std::unordered_map<std::string, std::string> parseQueryConfigs(
+    const std::string& configs) {
+  std::unordered_map<std::string, std::string> result;
+  std::vector<std::string> pairs;
+  folly::split(';', configs, pairs, true);
+  for (const auto& pair : pairs) {
+    std::string key;
+    std::string value;
+    VELOX_USER_CHECK(
+        folly::split('=', pair, key, value),
+        "Bad --query_configs entry: {}",
+        pair);
+    result[key] = value;
+  }
+  return result;
+}
+
 struct ParameterDim {
   std::string flag;
   std::vector<std::string> values;
@@ -220,8 +291,13 @@ std::shared_ptr<TpchQueryBuilder> queryBuilder;
 class TpchBenchmark {
  public:
   void initialize() {
+    memory::MemoryManagerOptions options;
+    if (FLAGS_query_memory_gb) {
+      memory::SharedArbitrator::registerFactory();
+      options.arbitratorKind = "SHARED";
+      options.arbitratorCapacity = FLAGS_query_memory_gb * (1LL << 30);
+    }
     if (FLAGS_cache_gb) {
-      memory::MemoryManagerOptions options;
       int64_t memoryBytes = FLAGS_cache_gb * (1LL << 30);
       options.useMmapAllocator = true;
       options.allocatorCapacity = memoryBytes;
@@ -245,7 +321,7 @@ class TpchBenchmark {
           memory::memoryManager()->allocator(), std::move(ssdCache));
       cache::AsyncDataCache::setInstance(cache_.get());
     } else {
-      memory::MemoryManager::testingSetInstance({});
+      memory::MemoryManager::testingSetInstance(options);
     }
     functions::prestosql::registerAllScalarFunctions();
     aggregate::prestosql::registerAllAggregateFunctions();
@@ -277,14 +353,31 @@ class TpchBenchmark {
     cache_->shutdown();
   }
 
+  /// Runs 'tpchPlan' --num_repeats times and returns the cursor and results of
+  /// the last run. The queries run on 'executor' if given, else on an
+  /// executor of their own.
   std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> run(
-      const TpchPlan& tpchPlan) {
+      const TpchPlan& tpchPlan,
+      folly::Executor* executor = nullptr,
+      int32_t numRepeats = FLAGS_num_repeats) {
     int32_t repeat = 0;
     try {
       for (;;) {
+        static std::atomic<int64_t> queryCounter{0};
         CursorParameters params;
         params.maxDrivers = FLAGS_num_drivers;
         params.planNode = tpchPlan.plan;
+        if (executor) {
+          params.queryCtx = std::make_shared<core::QueryCtx>(
+              executor,
+              core::QueryConfig({}),
+              std::unordered_map<std::string, std::shared_ptr<Config>>{},
+              cache::AsyncDataCache::getInstance(),
+              nullptr,
+              nullptr,
+              fmt::format("TpchBenchmark_{}", ++queryCounter));
+        }
+        params.queryConfigs = parseQueryConfigs(FLAGS_query_configs);
         params.queryConfigs[core::QueryConfig::kMaxSplitPreloadPerDriver] =
             std::to_string(FLAGS_split_preload_per_driver);
         const int numSplitsPerFile = FLAGS_num_splits_per_file;
@@ -308,7 +401,7 @@ class TpchBenchmark {
         };
         auto result = readCursor(params, addSplits);
         ensureTaskCompletion(result.first->task().get());
-        if (++repeat >= FLAGS_num_repeats) {
+        if (++repeat >= numRepeats) {
           return result;
         }
       }
@@ -318,20 +411,154 @@ class TpchBenchmark {
     }
   }
 
+  // Writes the stats of 'task' to a file named after 'name' in
+  // --task_stats_dir.
+  void writeTaskStats(
+      const std::string& name,
+      const exec::Task& task,
+      uint64_t micros) {
+    if (FLAGS_task_stats_dir.empty()) {
+      return;
+    }
+    const auto stats = task.taskStats();
+    folly::dynamic json = folly::dynamic::object;
+    json["name"] = name;
+    json["taskId"] = task.taskId();
+    json["wallMicros"] = micros;
+    json["executionMillis"] =
+        stats.executionEndTimeMs - stats.executionStartTimeMs;
+    json["numTotalSplits"] = stats.numTotalSplits;
+    json["numFinishedSplits"] = stats.numFinishedSplits;
+    json["numTotalDrivers"] = stats.numTotalDrivers;
+    json["queryConfigs"] = FLAGS_query_configs;
+    json["operators"] = toPlanStatsJson(stats);
+    auto path = fmt::format("{}/{}.json", FLAGS_task_stats_dir, name);
+    std::ofstream file(path);
+    file << folly::toPrettyJson(json) << std::endl;
+    if (!file.good()) {
+      LOG(ERROR) << "Failed to write " << path;
+    }
+  }
+
+  // Runs --concurrent_queries in --num_query_streams concurrent streams on a
+  // shared executor and prints the QPS and per query latencies to 'out'.
+  void runConcurrent(std::ostream& out) {
+    std::vector<int32_t> queries;
+    folly::split(',', FLAGS_concurrent_queries, queries, true);
+    VELOX_USER_CHECK(!queries.empty(), "No --concurrent_queries");
+    std::vector<TpchPlan> plans;
+    for (auto query : queries) {
+      plans.push_back(queryBuilder->getQueryPlan(query));
+    }
+    auto numThreads = FLAGS_num_executor_threads > 0
+        ? FLAGS_num_executor_threads
+        : std::thread::hardware_concurrency();
+    auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(numThreads);
+    const auto arbitratorStart = memory::memoryManager()->arbitrator()->stats();
+
+    std::mutex mutex;
+    std::unordered_map<int32_t, QueryLatencies> latencies;
+    std::atomic<int32_t> numFailed{0};
+    uint64_t wallMicros = 0;
+    {
+      MicrosecondTimer timer(&wallMicros);
+      std::vector<std::thread> streams;
+      for (auto stream = 0; stream < FLAGS_num_query_streams; ++stream) {
+        streams.emplace_back([&, stream]() {
+          for (auto repeat = 0; repeat < FLAGS_num_repeats; ++repeat) {
+            for (auto i = 0; i < plans.size(); ++i) {
+              auto index = (i + stream) % plans.size();
+              uint64_t micros = 0;
+              std::unique_ptr<TaskCursor> cursor;
+              {
+                MicrosecondTimer queryTimer(&micros);
+                cursor = run(plans[index], executor.get(), 1).first;
+              }
+              if (!cursor) {
+                ++numFailed;
+                continue;
+              }
+              writeTaskStats(
+                  fmt::format(
+                      "q{}_stream{}_run{}", queries[index], stream, repeat),
+                  *cursor->task(),
+                  micros);
+              std::lock_guard<std::mutex> l(mutex);
+              latencies[queries[index]].micros.push_back(micros);
+            }
+          }
+        });
+      }
+      for (auto& stream : streams) {
+        stream.join();
+      }
+    }
+
+    int64_t numQueries = 0;
+    for (auto& [query, queryLatencies] : latencies) {
+      numQueries += queryLatencies.micros.size();
+    }
+    out << fmt::format(
+               "{} streams, {} threads: {} queries in {}, {:.2f} QPS, {} "
+               "failed",
+               FLAGS_num_query_streams,
+               numThreads,
+               numQueries,
+               succinctMicros(wallMicros),
+               numQueries / (wallMicros / 1000000.0),
+               numFailed.load())
+        << std::endl;
+    for (auto query : queries) {
+      auto it = latencies.find(query);
+      if (it == latencies.end()) {
+        continue;
+      }
+      auto& queryLatencies = it->second;
+      std::sort(queryLatencies.micros.begin(), queryLatencies.micros.end());
+      out << fmt::format(
+                 "q{}: {} runs, p50 {} p90 {} p99 {} max {}",
+                 query,
+                 queryLatencies.micros.size(),
+                 succinctMicros(queryLatencies.percentile(50)),
+                 succinctMicros(queryLatencies.percentile(90)),
+                 succinctMicros(queryLatencies.percentile(99)),
+                 succinctMicros(queryLatencies.micros.back()))
+          << std::endl;
+    }
+    const auto arbitratorStats =
+        memory::memoryManager()->arbitrator()->stats() - arbitratorStart;
+    out << "Memory arbitration: " << arbitratorStats.toString() << std::endl;
+  }
+
   void runMain(std::ostream& out, RunStats& runStats) {
-    if (FLAGS_run_query_verbose == -1 && FLAGS_io_meter_column_pct == 0) {
+    if (FLAGS_num_query_streams > 0) {
+      runConcurrent(out);
+    } else if (
+        FLAGS_run_query_verbose == -1 && FLAGS_io_meter_column_pct == 0) {
       folly::runBenchmarks();
     } else {
       const auto queryPlan = FLAGS_io_meter_column_pct > 0
           ? queryBuilder->getIoMeterPlan(FLAGS_io_meter_column_pct)
           : queryBuilder->getQueryPlan(FLAGS_run_query_verbose);
-      auto [cursor, actualResults] = run(queryPlan);
+      uint64_t micros = 0;
+      std::unique_ptr<TaskCursor> cursor;
+      std::vector<RowVectorPtr> actualResults;
+      {
+        MicrosecondTimer timer(&micros);
+        std::tie(cursor, actualResults) = run(queryPlan);
+      }
       if (!cursor) {
         LOG(ERROR) << "Query terminated with error. Exiting";
         exit(1);
       }
       auto task = cursor->task();
       ensureTaskCompletion(task.get());
+      writeTaskStats(
+          FLAGS_io_meter_column_pct > 0
+              ? fmt::format("io_meter_{}", FLAGS_io_meter_column_pct)
+              : fmt::format("q{}", FLAGS_run_query_verbose),
+          *task,
+          micros);
       if (FLAGS_include_results) {
         printResults(actualResults, out);
         out << std::endl;
@@ -356,7 +583,10 @@ class TpchBenchmark {
                  stats.numFinishedSplits)
           << std::endl;
       out << printPlanWithStats(
-                 *queryPlan.plan, stats, FLAGS_include_custom_stats)
+                 *queryPlan.plan,
+                 stats,
+                 FLAGS_include_custom_stats,
+                 FLAGS_include_batch_histograms)
           << std::endl;
     }
   }
@@ -30,6 +30,54 @@ void BigintIdMap::makeTable(int64_t capacity) {
   maxEntries_ = capacity_ - capacity_ / 4;
 }
 
+void BigintIdMap::makeIds(
+    const int64_t* values,
+    int32_t numValues,
+    int32_t* ids) {
+  constexpr int32_t kBatchSize = xsimd::batch<int64_t>::size;
+  int64_t batchIds[kBatchSize];
+  int32_t i = 0;
+  for (; i + kBatchSize <= numValues; i += kBatchSize) {
+    makeIds(xsimd::batch<int64_t>::load_unaligned(values + i))
+        .store_unaligned(batchIds);
+    for (auto j = 0; j < kBatchSize; ++j) {
+      ids[i + j] = batchIds[j];
+    }
+  }
+  if (i == numValues) {
+    return;
+  }
+  const auto numLeft = numValues - i;
+  int64_t tail[kBatchSize] = {};
+  memcpy(tail, values + i, numLeft * sizeof(int64_t));
+  makeIds(xsimd::batch<int64_t>::load_unaligned(tail), bits::lowMask(numLeft))
+      .store_unaligned(batchIds);
+  for (auto j = 0; j < numLeft; ++j) {
+    ids[i + j] = batchIds[j];
+  }
+}
+
+void BigintIdMap::findIds(
+    const int64_t* values,
+    int32_t numValues,
+    int64_t* ids) {
+  constexpr int32_t kBatchSize = xsimd::batch<int64_t>::size;
+  int32_t i = 0;
+  for (; i + kBatchSize <= numValues; i += kBatchSize) {
+    findIds(xsimd::batch<int64_t>::load_unaligned(values + i))
+        .store_unaligned(ids + i);
+  }
+  if (i == numValues) {
+    return;
+  }
+  const auto numLeft = numValues - i;
+  int64_t tail[kBatchSize] = {};
+  memcpy(tail, values + i, numLeft * sizeof(int64_t));
+  findIds(xsimd::batch<int64_t>::load_unaligned(tail), bits::lowMask(numLeft))
+      .store_unaligned(tail);
+  memcpy(ids + i, tail, numLeft * sizeof(int64_t));
+}
+
 void BigintIdMap::resize(int64_t newCapacity) {
   VELOX_CHECK_LE(newCapacity, kMaxCapacity);
 
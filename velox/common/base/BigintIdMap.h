@@ -217,6 +217,15 @@ class BigintIdMap {
     return xsimd::load_unaligned(reinterpret_cast<int64_t*>(&resultVector));
   }
 
+  /// Assigns ids to 'numValues' values in 'values' as makeIds() above and
+  /// writes them to 'ids'. The values are hashed and probed a batch at a time,
+  /// the last partial batch is probed with a mask.
+  void makeIds(const int64_t* values, int32_t numValues, int32_t* ids);
+
+  /// Writes the ids of 'numValues' values in 'values' to 'ids' as findIds()
+  /// above. Values without an id get kNotFound.
+  void findIds(const int64_t* values, int32_t numValues, int64_t* ids);
+
  private:
   using A = xsimd::default_arch;
 
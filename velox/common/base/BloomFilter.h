@@ -16,12 +16,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/IOUtils.h"
+#include "velox/common/base/SimdUtil.h"
 
 namespace facebook::velox {
 // BloomFilter filter with groups of 64 bits, of which 4 are set. The hash
@@ -61,6 +63,41 @@ class BloomFilter {
     return test(bits_.data(), bits_.size(), value);
   }
 
+  // Batch version of mayContain() over 'numValues' hashed values. Sets bit i
+  // of 'result' to mayContain(values[i]) and clears the other bits of the
+  // last word. The masks and word indices are computed a SIMD batch at a
+  // time and the words are gathered.
+  void mayContain(const uint64_t* values, int32_t numValues, uint64_t* result)
+      const {
+    using Batch = xsimd::batch<uint64_t>;
+    constexpr int32_t kWidth = Batch::size;
+    std::fill(result, result + bits::nwords(numValues), 0);
+    const Batch one(1);
+    const Batch lowBits(63);
+    const Batch indexMask(bits_.size() - 1);
+    alignas(xsimd::default_arch::alignment()) int64_t indices[kWidth];
+    int32_t i = 0;
+    for (; i + kWidth <= numValues; i += kWidth) {
+      const auto hashCode = Batch::load_unaligned(values + i);
+      const auto mask = (one << (hashCode & lowBits)) |
+          (one << ((hashCode >> 6) & lowBits)) |
+          (one << ((hashCode >> 12) & lowBits)) |
+          (one << ((hashCode >> 18) & lowBits));
+      ((hashCode >> 24) & indexMask)
+          .store_aligned(reinterpret_cast<uint64_t*>(indices));
+      const auto words = xsimd::bitwise_cast<uint64_t>(simd::gather(
+          reinterpret_cast<const int64_t*>(bits_.data()), indices));
+      // kWidth divides 64, so a batch never straddles two words.
+      const auto hits = simd::toBitMask((words & mask) == mask);
+      result[i / 64] |= static_cast<uint64_t>(hits) << (i % 64);
+    }
+    for (; i < numValues; ++i) {
+      if (test(bits_.data(), bits_.size(), values[i])) {
+        bits::setBit(result, i);
+      }
+    }
+  }
+
   void merge(const char* serialized) {
     common::InputByteStream stream(serialized);
     auto version = stream.read<int8_t>();
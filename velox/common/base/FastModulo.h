@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox {
+
+/// Computes the remainder of 64 bit values divided by a divisor fixed at
+/// construction with multiplications instead of a division, which is several
+/// times slower. The result is exactly 'value % divisor'. See Lemire, Kaser
+/// and Kurz, "Faster Remainder by Direct Computation".
+class FastModulo {
+ public:
+  explicit FastModulo(uint64_t divisor)
+      : divisor_(divisor), multiplier_(computeMultiplier(divisor)) {}
+
+  uint64_t divisor() const {
+    return divisor_;
+  }
+
+  uint64_t operator()(uint64_t value) const {
+    // The low 128 bits of 'multiplier_' * 'value' are the fraction of 'value'
+    // / 'divisor_'. The remainder is the high 64 bits of the fraction times
+    // 'divisor_'.
+    const __uint128_t fraction = multiplier_ * value;
+    const __uint128_t low = (fraction & ~uint64_t(0)) * divisor_;
+    const __uint128_t high = (fraction >> 64) * divisor_;
+    return (high + (low >> 64)) >> 64;
+  }
+
+ private:
+  static __uint128_t computeMultiplier(uint64_t divisor) {
+    VELOX_CHECK_GT(divisor, 0);
+    // ceil(2^128 / 'divisor'). Wraps to 0 for a divisor of 1, which gives the
+    // right remainder of 0.
+    return ~__uint128_t(0) / divisor + 1;
+  }
+
+  const uint64_t divisor_;
+  const __uint128_t multiplier_;
+};
+
+} // namespace facebook::velox
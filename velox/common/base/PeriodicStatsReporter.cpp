@@ -40,11 +40,27 @@ void PeriodicStatsReporter::start() {
       "report_arbitrator_stats",
       [this]() { reportArbitratorStats(); },
       options_.arbitratorStatsIntervalMs);
+  if (ThreadLocalStats::enabled()) {
+    addTask(
+        "flush_thread_local_stats",
+        [this]() { flushThreadLocalStats(); },
+        options_.threadLocalStatsIntervalMs);
+  }
 }
 
 void PeriodicStatsReporter::stop() {
   LOG(INFO) << "Stopping PeriodicStatsReporter";
   scheduler_.stop();
+  if (ThreadLocalStats::enabled()) {
+    flushThreadLocalStats();
+  }
+}
+
+void PeriodicStatsReporter::flushThreadLocalStats() {
+  auto reporter = folly::Singleton<BaseStatsReporter>::try_get_fast();
+  if (reporter != nullptr) {
+    ThreadLocalStats::flush(*reporter);
+  }
 }
 
 void PeriodicStatsReporter::reportArbitratorStats() {
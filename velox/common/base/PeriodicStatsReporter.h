@@ -41,9 +41,15 @@ class PeriodicStatsReporter {
 
     uint64_t arbitratorStatsIntervalMs{60'000};
 
+    /// Interval of handing values aggregated by ThreadLocalStats to the
+    /// reporter. Only used if ThreadLocalStats is enabled.
+    uint64_t threadLocalStatsIntervalMs{1'000};
+
     std::string toString() const {
       return fmt::format(
-          "arbitratorStatsIntervalMs:{}", arbitratorStatsIntervalMs);
+          "arbitratorStatsIntervalMs:{}, threadLocalStatsIntervalMs:{}",
+          arbitratorStatsIntervalMs,
+          threadLocalStatsIntervalMs);
     }
   };
 
@@ -78,6 +84,8 @@ class PeriodicStatsReporter {
 
   void reportArbitratorStats();
 
+  void flushThreadLocalStats();
+
   const velox::memory::MemoryArbitrator* const arbitrator_{nullptr};
   const Options options_;
 
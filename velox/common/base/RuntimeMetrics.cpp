@@ -67,6 +67,54 @@ void RuntimeMetric::printMetric(std::stringstream& stream) const {
   }
 }
 
+void RuntimeHistogram::merge(const RuntimeHistogram& other) {
+  VELOX_CHECK_EQ(unit, other.unit);
+  for (auto i = 0; i < kNumBuckets; ++i) {
+    counts[i] += other.counts[i];
+  }
+}
+
+bool RuntimeHistogram::empty() const {
+  for (auto count : counts) {
+    if (count != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string RuntimeHistogram::toString() const {
+  auto print = [&](uint64_t value) {
+    switch (unit) {
+      case RuntimeCounter::Unit::kNanos:
+        return succinctNanos(value);
+      case RuntimeCounter::Unit::kBytes:
+        return succinctBytes(value);
+      case RuntimeCounter::Unit::kNone:
+      default:
+        return std::to_string(value);
+    }
+  };
+  std::string result;
+  for (auto i = 0; i < kNumBuckets; ++i) {
+    if (counts[i] == 0) {
+      continue;
+    }
+    if (!result.empty()) {
+      result += ", ";
+    }
+    if (i == 0) {
+      result += fmt::format("[0]: {}", counts[i]);
+    } else if (i == kNumBuckets - 1) {
+      result += fmt::format("[{}, inf): {}", print(1ULL << (i - 1)), counts[i]);
+    } else {
+      result += fmt::format(
+          "[{}, {}): {}", print(1ULL << (i - 1)), print(1ULL << i), counts[i]);
+    }
+  }
+  return result;
+}
+
 // Thread local runtime stat writers.
 static thread_local BaseRuntimeStatWriter* localRuntimeStatWriter;
 
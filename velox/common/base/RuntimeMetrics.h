@@ -18,6 +18,8 @@
 
 #include <fmt/format.h>
 #include <folly/CppAttributes.h>
+#include <algorithm>
+#include <array>
 #include <limits>
 #include <sstream>
 
@@ -65,6 +67,43 @@ struct RuntimeMetric {
   }
 };
 
+/// Counts of values in power of 2 buckets. Bucket 0 counts values <= 0 and
+/// bucket i > 0 counts values in [2^(i-1), 2^i). The last bucket also counts
+/// larger values. Cheap enough to update once per batch.
+struct RuntimeHistogram {
+  static constexpr int32_t kNumBuckets = 40;
+
+  RuntimeCounter::Unit unit;
+  std::array<int64_t, kNumBuckets> counts{};
+
+  explicit RuntimeHistogram(
+      RuntimeCounter::Unit _unit = RuntimeCounter::Unit::kNone)
+      : unit(_unit) {}
+
+  void addValue(int64_t value) {
+    ++counts[bucket(value)];
+  }
+
+  static int32_t bucket(int64_t value) {
+    if (value <= 0) {
+      return 0;
+    }
+    return std::min<int32_t>(
+        kNumBuckets - 1, 64 - __builtin_clzll(static_cast<uint64_t>(value)));
+  }
+
+  void merge(const RuntimeHistogram& other);
+
+  void clear() {
+    counts.fill(0);
+  }
+
+  bool empty() const;
+
+  /// Returns the non-empty buckets, e.g. '[1, 2): 3, [512, 1024): 10'.
+  std::string toString() const;
+};
+
 /// Simple interface to implement writing of runtime stats to Velox Operator
 /// stats.
 /// Inherit a concrete class from this to implement your writing.
@@ -1436,4 +1436,47 @@ inline bool memEqualUnsafe(const void* x, const void* y, int32_t size) {
   return true;
 }
 
+template <typename A>
+size_t simdStrstr(
+    const char* data,
+    size_t size,
+    const char* needle,
+    size_t needleSize,
+    const A&) {
+  if (needleSize == 0) {
+    return 0;
+  }
+  if (needleSize > size) {
+    return std::string_view::npos;
+  }
+  if (needleSize == 1) {
+    auto* found = ::memchr(data, needle[0], size);
+    return found == nullptr ? std::string_view::npos
+                            : static_cast<const char*>(found) - data;
+  }
+  using Batch = xsimd::batch<uint8_t, A>;
+  constexpr size_t kBatch = Batch::size;
+  const auto first = Batch::broadcast(needle[0]);
+  const auto last = Batch::broadcast(needle[needleSize - 1]);
+  const auto* bytes = reinterpret_cast<const uint8_t*>(data);
+  size_t offset = 0;
+  // The loads of the last bytes end at 'offset + needleSize - 1 + kBatch'.
+  for (; offset + needleSize - 1 + kBatch <= size; offset += kBatch) {
+    const auto firstMatches = Batch::load_unaligned(bytes + offset) == first;
+    const auto lastMatches =
+        Batch::load_unaligned(bytes + offset + needleSize - 1) == last;
+    uint32_t candidates = toBitMask(firstMatches & lastMatches);
+    while (candidates) {
+      const auto candidate = offset + __builtin_ctz(candidates);
+      if (::memcmp(data + candidate + 1, needle + 1, needleSize - 2) == 0) {
+        return candidate;
+      }
+      candidates &= candidates - 1;
+    }
+  }
+  const auto found = std::string_view(data + offset, size - offset)
+                         .find(std::string_view(needle, needleSize));
+  return found == std::string_view::npos ? found : offset + found;
+}
+
 } // namespace facebook::velox::simd
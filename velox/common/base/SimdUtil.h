@@ -17,6 +17,8 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <string_view>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 
@@ -497,6 +499,19 @@ xsimd::batch<T, A> reinterpretBatch(xsimd::batch<U, A>, const A& = {});
 template <typename A = xsimd::default_arch>
 inline bool memEqualUnsafe(const void* x, const void* y, int32_t size);
 
+/// Returns the offset of the first occurrence of 'needle' of 'needleSize'
+/// bytes in 'data' of 'size' bytes, or std::string_view::npos. Compares the
+/// first and last bytes of 'needle' with a batch of positions at a time and
+/// compares the remaining bytes only at positions where both match. Does not
+/// read past the end of 'data' or 'needle'.
+template <typename A = xsimd::default_arch>
+size_t simdStrstr(
+    const char* data,
+    size_t size,
+    const char* needle,
+    size_t needleSize,
+    const A& = {});
+
 } // namespace facebook::velox::simd
 
 #include "velox/common/base/SimdUtil-inl.h"
@@ -33,7 +33,12 @@ SpillConfig::SpillConfig(
     uint64_t _maxSpillRunRows,
     uint64_t _writerFlushThresholdSize,
     const std::string& _compressionKind,
-    const std::string& _fileCreateConfig)
+    const std::string& _fileCreateConfig,
+    uint32_t _maxMergeFanIn,
+    uint64_t _writeBehindBytes,
+    uint64_t _readAheadBytes,
+    bool _columnarFormat,
+    uint64_t _zstdDictionarySize)
     : getSpillDirPathCb(std::move(_getSpillDirPathCb)),
       updateAndCheckSpillLimitCb(std::move(_updateAndCheckSpillLimitCb)),
       fileNamePrefix(std::move(_fileNamePrefix)),
@@ -50,11 +55,18 @@ SpillConfig::SpillConfig(
       maxSpillRunRows(_maxSpillRunRows),
       writerFlushThresholdSize(_writerFlushThresholdSize),
       compressionKind(common::stringToCompressionKind(_compressionKind)),
-      fileCreateConfig(_fileCreateConfig) {
+      fileCreateConfig(_fileCreateConfig),
+      maxMergeFanIn(_maxMergeFanIn),
+      writeBehindBytes(_writeBehindBytes),
+      readAheadBytes(_readAheadBytes),
+      columnarFormat(_columnarFormat),
+      zstdDictionarySize(_zstdDictionarySize) {
   VELOX_USER_CHECK_GE(
       spillableReservationGrowthPct,
       minSpillableReservationPct,
       "Spillable memory reservation growth pct should not be lower than minimum available pct");
+  VELOX_USER_CHECK_NE(
+      maxMergeFanIn, 1, "Spill merge fan-in must be zero or at least two");
 }
 
 int32_t SpillConfig::spillLevel(uint8_t startBitOffset) const {
@@ -42,6 +42,27 @@ using GetSpillDirectoryPathCB = std::function<std::string_view()>;
 /// bytes exceed the set limit.
 using UpdateAndCheckSpillLimitCB = std::function<void(uint64_t)>;
 
+/// The spill tiers to place spill files on in order of preference, e.g. local
+/// NVMe first and then a remote object store. Tier 0 has the spill directory.
+/// A spill file goes to the first tier with room and continues in a new file
+/// on a later tier once its tier is full.
+struct SpillTiers {
+  /// The number of tiers. Zero if there are no spill tiers, in which case the
+  /// spill files go to the spill directory without space accounting.
+  int32_t numTiers{0};
+
+  /// Returns the spill directory on 'tier', creating it if needed.
+  std::function<std::string_view(int32_t tier)> getDirectoryPathCb;
+
+  /// Reserves 'bytes' of spill space on 'tier'. Returns false without
+  /// reserving if 'tier' does not have room.
+  std::function<bool(int32_t tier, uint64_t bytes)> reserveCb;
+
+  bool empty() const {
+    return numTiers == 0;
+  }
+};
+
 /// Specifies the config for spilling.
 struct SpillConfig {
   SpillConfig() = default;
@@ -60,7 +81,12 @@ struct SpillConfig {
       uint64_t _maxSpillRunRows,
       uint64_t _writerFlushThresholdSize,
       const std::string& _compressionKind,
-      const std::string& _fileCreateConfig = {});
+      const std::string& _fileCreateConfig = {},
+      uint32_t _maxMergeFanIn = 0,
+      uint64_t _writeBehindBytes = 0,
+      uint64_t _readAheadBytes = 0,
+      bool _columnarFormat = false,
+      uint64_t _zstdDictionarySize = 0);
 
   /// Returns the spilling level with given 'startBitOffset' and
   /// 'numPartitionBits'.
@@ -132,5 +158,34 @@ struct SpillConfig {
 
   /// Custom options passed to velox::FileSystem to create spill WriteFile.
   std::string fileCreateConfig;
+
+  /// The max number of sorted spill files to merge at once. If a spill
+  /// partition has more files, groups of files are first merged into larger
+  /// intermediate files in as many passes as needed. If it is zero, then all
+  /// the files are merged at once.
+  uint32_t maxMergeFanIn{0};
+
+  /// The max bytes of serialized spill data pending write on 'executor' while
+  /// the spilling thread serializes the next data. If it is zero or
+  /// 'executor' is nullptr, then the spill data is written synchronously.
+  uint64_t writeBehindBytes{0};
+
+  /// The max bytes of read-ahead buffers of the spill files read at once by a
+  /// sorted merge. The read-ahead runs on 'executor'. If it is zero or
+  /// 'executor' is nullptr, then there is no read-ahead.
+  uint64_t readAheadBytes{0};
+
+  /// If true, the spill files are written with ColumnarSpillSerializer
+  /// instead of the Presto serialization format.
+  bool columnarFormat{false};
+
+  /// If not zero and 'compressionKind' is zstd, the spill files not in the
+  /// columnar format are compressed with a zstd dictionary of up to this many
+  /// bytes trained on the first spilled data of each writer.
+  uint64_t zstdDictionarySize{0};
+
+  /// The spill tiers of the spill files. If empty, then the spill files go to
+  /// the spill directory.
+  SpillTiers tiers;
 };
 } // namespace facebook::velox::common
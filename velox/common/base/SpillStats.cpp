@@ -52,7 +52,13 @@ SpillStats::SpillStats(
     uint64_t _spillReadBytes,
     uint64_t _spillReads,
     uint64_t _spillReadTimeUs,
-    uint64_t _spillDeserializationTimeUs)
+    uint64_t _spillDeserializationTimeUs,
+    uint64_t _spillMergePasses,
+    uint64_t _spillMergeBytes,
+    uint64_t _spillWriteWaitTimeUs,
+    uint64_t _spillReadAheadTimeUs,
+    uint64_t _spillReadAheadWaitTimeUs,
+    uint64_t _spilledFallbackBytes)
     : spillRuns(_spillRuns),
       spilledInputBytes(_spilledInputBytes),
       spilledBytes(_spilledBytes),
@@ -69,7 +75,13 @@ SpillStats::SpillStats(
       spillReadBytes(_spillReadBytes),
       spillReads(_spillReads),
       spillReadTimeUs(_spillReadTimeUs),
-      spillDeserializationTimeUs(_spillDeserializationTimeUs) {}
+      spillDeserializationTimeUs(_spillDeserializationTimeUs),
+      spillMergePasses(_spillMergePasses),
+      spillMergeBytes(_spillMergeBytes),
+      spillWriteWaitTimeUs(_spillWriteWaitTimeUs),
+      spillReadAheadTimeUs(_spillReadAheadTimeUs),
+      spillReadAheadWaitTimeUs(_spillReadAheadWaitTimeUs),
+      spilledFallbackBytes(_spilledFallbackBytes) {}
 
 SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillRuns += other.spillRuns;
@@ -89,6 +101,12 @@ SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillReads += other.spillReads;
   spillReadTimeUs += other.spillReadTimeUs;
   spillDeserializationTimeUs += other.spillDeserializationTimeUs;
+  spillMergePasses += other.spillMergePasses;
+  spillMergeBytes += other.spillMergeBytes;
+  spillWriteWaitTimeUs += other.spillWriteWaitTimeUs;
+  spillReadAheadTimeUs += other.spillReadAheadTimeUs;
+  spillReadAheadWaitTimeUs += other.spillReadAheadWaitTimeUs;
+  spilledFallbackBytes += other.spilledFallbackBytes;
   return *this;
 }
 
@@ -114,6 +132,16 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
   result.spillReadTimeUs = spillReadTimeUs - other.spillReadTimeUs;
   result.spillDeserializationTimeUs =
       spillDeserializationTimeUs - other.spillDeserializationTimeUs;
+  result.spillMergePasses = spillMergePasses - other.spillMergePasses;
+  result.spillMergeBytes = spillMergeBytes - other.spillMergeBytes;
+  result.spillWriteWaitTimeUs =
+      spillWriteWaitTimeUs - other.spillWriteWaitTimeUs;
+  result.spillReadAheadTimeUs =
+      spillReadAheadTimeUs - other.spillReadAheadTimeUs;
+  result.spillReadAheadWaitTimeUs =
+      spillReadAheadWaitTimeUs - other.spillReadAheadWaitTimeUs;
+  result.spilledFallbackBytes =
+      spilledFallbackBytes - other.spilledFallbackBytes;
   return result;
 }
 
@@ -146,6 +174,12 @@ bool SpillStats::operator<(const SpillStats& other) const {
   UPDATE_COUNTER(spillReads);
   UPDATE_COUNTER(spillReadTimeUs);
   UPDATE_COUNTER(spillDeserializationTimeUs);
+  UPDATE_COUNTER(spillMergePasses);
+  UPDATE_COUNTER(spillMergeBytes);
+  UPDATE_COUNTER(spillWriteWaitTimeUs);
+  UPDATE_COUNTER(spillReadAheadTimeUs);
+  UPDATE_COUNTER(spillReadAheadWaitTimeUs);
+  UPDATE_COUNTER(spilledFallbackBytes);
 #undef UPDATE_COUNTER
   VELOX_CHECK(
       !((gtCount > 0) && (ltCount > 0)),
@@ -185,7 +219,13 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillReadBytes,
              spillReads,
              spillReadTimeUs,
-             spillDeserializationTimeUs) ==
+             spillDeserializationTimeUs,
+             spillMergePasses,
+             spillMergeBytes,
+             spillWriteWaitTimeUs,
+             spillReadAheadTimeUs,
+             spillReadAheadWaitTimeUs,
+             spilledFallbackBytes) ==
       std::tie(
              other.spillRuns,
              other.spilledInputBytes,
@@ -203,7 +243,13 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillReadBytes,
              spillReads,
              spillReadTimeUs,
-             spillDeserializationTimeUs);
+             spillDeserializationTimeUs,
+             other.spillMergePasses,
+             other.spillMergeBytes,
+             other.spillWriteWaitTimeUs,
+             other.spillReadAheadTimeUs,
+             other.spillReadAheadWaitTimeUs,
+             other.spilledFallbackBytes);
 }
 
 void SpillStats::reset() {
@@ -224,6 +270,12 @@ void SpillStats::reset() {
   spillReads = 0;
   spillReadTimeUs = 0;
   spillDeserializationTimeUs = 0;
+  spillMergePasses = 0;
+  spillMergeBytes = 0;
+  spillWriteWaitTimeUs = 0;
+  spillReadAheadTimeUs = 0;
+  spillReadAheadWaitTimeUs = 0;
+  spilledFallbackBytes = 0;
 }
 
 std::string SpillStats::toString() const {
@@ -233,7 +285,9 @@ std::string SpillStats::toString() const {
       "spillSortTime[{}] spillSerializationTime[{}] spillWrites[{}] "
       "spillFlushTime[{}] spillWriteTime[{}] maxSpillExceededLimitCount[{}] "
       "spillReadBytes[{}] spillReads[{}] spillReadTime[{}] "
-      "spillReadDeserializationTime[{}]",
+      "spillReadDeserializationTime[{}] spillMergePasses[{}] "
+      "spillMergeBytes[{}] spillWriteWaitTime[{}] spillReadAheadTime[{}] "
+      "spillReadAheadWaitTime[{}] spilledFallbackBytes[{}]",
       spillRuns,
       succinctBytes(spilledInputBytes),
       succinctBytes(spilledBytes),
@@ -250,7 +304,13 @@ std::string SpillStats::toString() const {
       succinctBytes(spillReadBytes),
       spillReads,
       succinctMicros(spillReadTimeUs),
-      succinctMicros(spillDeserializationTimeUs));
+      succinctMicros(spillDeserializationTimeUs),
+      spillMergePasses,
+      succinctBytes(spillMergeBytes),
+      succinctMicros(spillWriteWaitTimeUs),
+      succinctMicros(spillReadAheadTimeUs),
+      succinctMicros(spillReadAheadWaitTimeUs),
+      succinctBytes(spilledFallbackBytes));
 }
 
 void updateGlobalSpillRunStats(uint64_t numRuns) {
@@ -328,6 +388,12 @@ void updateGlobalSpillDeserializationTimeUs(uint64_t timeUs) {
   localSpillStats().wlock()->spillDeserializationTimeUs += timeUs;
 }
 
+void updateGlobalSpillMergeStats(uint64_t mergePasses, uint64_t mergeBytes) {
+  auto statsLocked = localSpillStats().wlock();
+  statsLocked->spillMergePasses += mergePasses;
+  statsLocked->spillMergeBytes += mergeBytes;
+}
+
 SpillStats globalSpillStats() {
   SpillStats gSpillStats;
   for (auto& spillStats : allSpillStats()) {
@@ -64,6 +64,26 @@ struct SpillStats {
   uint64_t spillReadTimeUs{0};
   /// The time spent on deserializing rows read from spilled files.
   uint64_t spillDeserializationTimeUs{0};
+  /// The number of passes that merge groups of sorted spill files into larger
+  /// intermediate files before the final merge.
+  uint64_t spillMergePasses{0};
+  /// The number of bytes written to the intermediate files of the merge
+  /// passes.
+  uint64_t spillMergeBytes{0};
+  /// The time the spilling thread waited for spill data pending write on the
+  /// spill executor. With write-behind, 'spillWriteTimeUs' is spent on the
+  /// spill executor and only this time is on the spilling thread.
+  uint64_t spillWriteWaitTimeUs{0};
+  /// The time spent on the spill executor to read spill data ahead of its
+  /// use. This is also included in 'spillReadTimeUs'.
+  uint64_t spillReadAheadTimeUs{0};
+  /// The time the reading thread waited for the read-ahead of spill data. The
+  /// read-ahead overlaps with the processing of the prior data by
+  /// 1 - spillReadAheadWaitTimeUs / spillReadAheadTimeUs.
+  uint64_t spillReadAheadWaitTimeUs{0};
+  /// The bytes of spill data placed on the spill tiers after the first one
+  /// because the earlier tiers were full.
+  uint64_t spilledFallbackBytes{0};
 
   SpillStats(
       uint64_t _spillRuns,
@@ -82,7 +102,13 @@ struct SpillStats {
       uint64_t _spillReadBytes,
       uint64_t _spillReads,
       uint64_t _spillReadTimeUs,
-      uint64_t _spillDeserializationTimeUs);
+      uint64_t _spillDeserializationTimeUs,
+      uint64_t _spillMergePasses = 0,
+      uint64_t _spillMergeBytes = 0,
+      uint64_t _spillWriteWaitTimeUs = 0,
+      uint64_t _spillReadAheadTimeUs = 0,
+      uint64_t _spillReadAheadWaitTimeUs = 0,
+      uint64_t _spilledFallbackBytes = 0);
 
   SpillStats() = default;
 
@@ -158,6 +184,9 @@ void updateGlobalMaxSpillLevelExceededCount(
 /// Increments the spill read deserialization time.
 void updateGlobalSpillDeserializationTimeUs(uint64_t timeUs);
 
+/// Updates the stats of the intermediate merge passes over sorted spill files.
+void updateGlobalSpillMergeStats(uint64_t mergePasses, uint64_t mergeBytes);
+
 /// Gets the cumulative global spill stats.
 SpillStats globalSpillStats();
 } // namespace facebook::velox::common
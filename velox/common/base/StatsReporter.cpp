@@ -16,8 +16,268 @@
 
 #include "velox/common/base/StatsReporter.h"
 
+#include <folly/container/F14Map.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <optional>
+
 namespace facebook::velox {
 
 bool BaseStatsReporter::registered = false;
 
+bool ThreadLocalStats::enabled_ = false;
+
+void BaseStatsReporter::addMetricValues(
+    folly::StringPiece key,
+    size_t sum,
+    size_t count) const {
+  if (count == 0) {
+    return;
+  }
+  // Keeps both the sum and the average of the values.
+  const auto value = sum / count;
+  addMetricValue(key, sum - value * (count - 1));
+  for (size_t i = 1; i < count; ++i) {
+    addMetricValue(key, value);
+  }
+}
+
+void BaseStatsReporter::addHistogramMetricValues(
+    folly::StringPiece key,
+    size_t value,
+    size_t count) const {
+  for (size_t i = 0; i < count; ++i) {
+    addHistogramMetricValue(key, value);
+  }
+}
+
+namespace {
+struct HistogramBuckets {
+  int64_t bucketWidth;
+  int64_t min;
+  int64_t max;
+
+  // Bucket 0 is for values below 'min' and the last bucket for values at or
+  // above 'max'.
+  size_t numBuckets() const {
+    return (max - min) / bucketWidth + 2;
+  }
+
+  size_t bucket(size_t value) const {
+    const auto signedValue = static_cast<int64_t>(value);
+    if (signedValue < min) {
+      return 0;
+    }
+    if (signedValue >= max) {
+      return numBuckets() - 1;
+    }
+    return 1 + (signedValue - min) / bucketWidth;
+  }
+
+  size_t lowerEnd(size_t bucket) const {
+    if (bucket == 0) {
+      return std::max<int64_t>(min, 0);
+    }
+    if (bucket == numBuckets() - 1) {
+      return max;
+    }
+    return min + (bucket - 1) * bucketWidth;
+  }
+};
+
+// Adds 'value' to a counter that only the calling thread writes. Relaxed
+// loads and stores compile to plain moves but let the flushing thread read
+// the counter.
+inline void increment(std::atomic<uint64_t>& counter, uint64_t value) {
+  counter.store(
+      counter.load(std::memory_order_relaxed) + value,
+      std::memory_order_relaxed);
+}
+
+// Values of one metric recorded by one thread. The flushing thread reports
+// the difference to the values it reported before.
+struct LocalMetric {
+  std::atomic<uint64_t> sum{0};
+  std::atomic<uint64_t> count{0};
+  uint64_t reportedSum{0};
+  uint64_t reportedCount{0};
+};
+
+struct LocalHistogram {
+  explicit LocalHistogram(const HistogramBuckets& _buckets)
+      : buckets(_buckets),
+        counts(_buckets.numBuckets()),
+        reportedCounts(_buckets.numBuckets(), 0) {}
+
+  const HistogramBuckets buckets;
+  std::vector<std::atomic<uint64_t>> counts;
+  std::vector<uint64_t> reportedCounts;
+};
+
+struct ThreadMetrics {
+  // Held by the owning thread when adding a metric and by the flushing
+  // thread. Lookups by the owning thread do not need it.
+  std::mutex mutex;
+  folly::F14FastMap<std::string, std::unique_ptr<LocalMetric>> metrics;
+  folly::F14FastMap<std::string, std::unique_ptr<LocalHistogram>> histograms;
+  // Set when the owning thread exits.
+  std::atomic<bool> exited{false};
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadMetrics>> threads;
+  folly::F14FastMap<std::string, HistogramBuckets> histograms;
+  // Serializes flushes.
+  std::mutex flushMutex;
+};
+
+// Not destroyed, threads may exit after static destruction.
+Registry& registry() {
+  static auto* registry = new Registry();
+  return *registry;
+}
+
+struct ThreadMetricsHolder {
+  ThreadMetricsHolder() : metrics(std::make_shared<ThreadMetrics>()) {
+    auto& instance = registry();
+    std::lock_guard<std::mutex> l(instance.mutex);
+    instance.threads.push_back(metrics);
+  }
+
+  ~ThreadMetricsHolder() {
+    metrics->exited = true;
+  }
+
+  const std::shared_ptr<ThreadMetrics> metrics;
+};
+
+ThreadMetrics& threadMetrics() {
+  thread_local ThreadMetricsHolder holder;
+  return *holder.metrics;
+}
+} // namespace
+
+// static
+void ThreadLocalStats::registerHistogram(
+    folly::StringPiece key,
+    int64_t bucketWidth,
+    int64_t min,
+    int64_t max) {
+  if (bucketWidth <= 0 || max < min) {
+    return;
+  }
+  auto& instance = registry();
+  std::lock_guard<std::mutex> l(instance.mutex);
+  instance.histograms.insert_or_assign(
+      key.str(), HistogramBuckets{bucketWidth, min, max});
+}
+
+// static
+void ThreadLocalStats::addMetricValue(folly::StringPiece key, size_t value) {
+  auto& thread = threadMetrics();
+  auto it = thread.metrics.find(key);
+  if (FOLLY_UNLIKELY(it == thread.metrics.end())) {
+    std::lock_guard<std::mutex> l(thread.mutex);
+    it = thread.metrics.emplace(key.str(), std::make_unique<LocalMetric>())
+             .first;
+  }
+  auto& metric = *it->second;
+  increment(metric.sum, value);
+  increment(metric.count, 1);
+}
+
+// static
+void ThreadLocalStats::addHistogramMetricValue(
+    folly::StringPiece key,
+    size_t value) {
+  auto& thread = threadMetrics();
+  auto it = thread.histograms.find(key);
+  if (FOLLY_UNLIKELY(it == thread.histograms.end())) {
+    std::optional<HistogramBuckets> buckets;
+    {
+      auto& instance = registry();
+      std::lock_guard<std::mutex> l(instance.mutex);
+      auto bucketsIt = instance.histograms.find(key);
+      if (bucketsIt != instance.histograms.end()) {
+        buckets = bucketsIt->second;
+      }
+    }
+    if (!buckets.has_value()) {
+      auto reporter = folly::Singleton<BaseStatsReporter>::try_get_fast();
+      if (reporter != nullptr) {
+        reporter->addHistogramMetricValue(key, value);
+      }
+      return;
+    }
+    std::lock_guard<std::mutex> l(thread.mutex);
+    it = thread.histograms
+             .emplace(key.str(), std::make_unique<LocalHistogram>(*buckets))
+             .first;
+  }
+  auto& histogram = *it->second;
+  increment(histogram.counts[histogram.buckets.bucket(value)], 1);
+}
+
+// static
+void ThreadLocalStats::flush(const BaseStatsReporter& reporter) {
+  auto& instance = registry();
+  std::lock_guard<std::mutex> flushLock(instance.flushMutex);
+  std::vector<std::shared_ptr<ThreadMetrics>> threads;
+  {
+    std::lock_guard<std::mutex> l(instance.mutex);
+    threads = instance.threads;
+  }
+  std::vector<ThreadMetrics*> exited;
+  for (auto& thread : threads) {
+    // The values of an exited thread are final. They are reported once more
+    // before the thread is dropped.
+    if (thread->exited.load(std::memory_order_acquire)) {
+      exited.push_back(thread.get());
+    }
+    std::lock_guard<std::mutex> l(thread->mutex);
+    for (auto& [key, metric] : thread->metrics) {
+      const auto count = metric->count.load(std::memory_order_relaxed);
+      if (count == metric->reportedCount) {
+        continue;
+      }
+      const auto sum = metric->sum.load(std::memory_order_relaxed);
+      reporter.addMetricValues(
+          key, sum - metric->reportedSum, count - metric->reportedCount);
+      metric->reportedSum = sum;
+      metric->reportedCount = count;
+    }
+    for (auto& [key, histogram] : thread->histograms) {
+      for (size_t i = 0; i < histogram->counts.size(); ++i) {
+        const auto count =
+            histogram->counts[i].load(std::memory_order_relaxed);
+        if (count == histogram->reportedCounts[i]) {
+          continue;
+        }
+        reporter.addHistogramMetricValues(
+            key,
+            histogram->buckets.lowerEnd(i),
+            count - histogram->reportedCounts[i]);
+        histogram->reportedCounts[i] = count;
+      }
+    }
+  }
+  if (exited.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(instance.mutex);
+  auto& registered = instance.threads;
+  registered.erase(
+      std::remove_if(
+          registered.begin(),
+          registered.end(),
+          [&](const auto& thread) {
+            return std::find(exited.begin(), exited.end(), thread.get()) !=
+                exited.end();
+          }),
+      registered.end());
 }
+
+} // namespace facebook::velox
@@ -116,9 +116,61 @@ class BaseStatsReporter {
   virtual void addHistogramMetricValue(folly::StringPiece key, size_t value)
       const = 0;
 
+  /// Adds 'count' values whose sum is 'sum' to the stat. Used to hand over
+  /// values aggregated by ThreadLocalStats. Implementations should add them
+  /// in one step. The default adds them one at a time.
+  virtual void addMetricValues(folly::StringPiece key, size_t sum, size_t count)
+      const;
+
+  /// Adds 'value' 'count' times to the histogram. Used to hand over values
+  /// aggregated by ThreadLocalStats. The default adds them one at a time.
+  virtual void addHistogramMetricValues(
+      folly::StringPiece key,
+      size_t value,
+      size_t count) const;
+
   static bool registered;
 };
 
+/// Aggregates recorded metric values per thread so that recording does not
+/// call into the reporter, which may take a lock. When enabled, the record
+/// macros add to counters of the calling thread. The counters are only
+/// written by their thread and need no atomic read-modify-write. flush()
+/// hands the values added since the previous flush to the reporter.
+/// PeriodicStatsReporter calls flush() periodically when enabled.
+///
+/// Histogram values are counted in the buckets given to
+/// DEFINE_HISTOGRAM_METRIC and are reported as the lower end of their bucket.
+/// Values of histograms that were not defined are not aggregated.
+class ThreadLocalStats {
+ public:
+  static bool enabled() {
+    return enabled_;
+  }
+
+  /// Enables or disables aggregation. Set before recording values.
+  static void setEnabled(bool enabled) {
+    enabled_ = enabled;
+  }
+
+  static void registerHistogram(
+      folly::StringPiece key,
+      int64_t bucketWidth,
+      int64_t min,
+      int64_t max);
+
+  static void addMetricValue(folly::StringPiece key, size_t value = 1);
+
+  static void addHistogramMetricValue(folly::StringPiece key, size_t value);
+
+  /// Adds the values recorded by all threads since the previous call to
+  /// 'reporter'.
+  static void flush(const BaseStatsReporter& reporter);
+
+ private:
+  static bool enabled_;
+};
+
 // This is a dummy reporter that does nothing
 class DummyStatsReporter : public BaseStatsReporter {
  public:
@@ -173,20 +225,27 @@ class DummyStatsReporter : public BaseStatsReporter {
     }                                                          \
   }
 
-#define RECORD_METRIC_VALUE(key, ...)                          \
-  {                                                            \
-    if (::facebook::velox::BaseStatsReporter::registered) {    \
-      auto reporter = folly::Singleton<                        \
-          facebook::velox::BaseStatsReporter>::try_get_fast(); \
-      if (FOLLY_LIKELY(reporter != nullptr)) {                 \
-        reporter->addMetricValue((key), ##__VA_ARGS__);        \
-      }                                                        \
-    }                                                          \
+#define RECORD_METRIC_VALUE(key, ...)                            \
+  {                                                              \
+    if (::facebook::velox::BaseStatsReporter::registered) {      \
+      if (::facebook::velox::ThreadLocalStats::enabled()) {      \
+        ::facebook::velox::ThreadLocalStats::addMetricValue(     \
+            (key), ##__VA_ARGS__);                               \
+      } else {                                                   \
+        auto reporter = folly::Singleton<                        \
+            facebook::velox::BaseStatsReporter>::try_get_fast(); \
+        if (FOLLY_LIKELY(reporter != nullptr)) {                 \
+          reporter->addMetricValue((key), ##__VA_ARGS__);        \
+        }                                                        \
+      }                                                          \
+    }                                                            \
   }
 
 #define DEFINE_HISTOGRAM_METRIC(key, bucket, min, max, ...)    \
   {                                                            \
     if (::facebook::velox::BaseStatsReporter::registered) {    \
+      ::facebook::velox::ThreadLocalStats::registerHistogram(  \
+          (key), (bucket), (min), (max));                      \
       auto reporter = folly::Singleton<                        \
           facebook::velox::BaseStatsReporter>::try_get_fast(); \
       if (FOLLY_LIKELY(reporter != nullptr)) {                 \
@@ -200,14 +259,19 @@ class DummyStatsReporter : public BaseStatsReporter {
     }                                                          \
   }
 
-#define RECORD_HISTOGRAM_METRIC_VALUE(key, ...)                  \
-  {                                                              \
-    if (::facebook::velox::BaseStatsReporter::registered) {      \
-      auto reporter = folly::Singleton<                          \
-          facebook::velox::BaseStatsReporter>::try_get_fast();   \
-      if (FOLLY_LIKELY(reporter != nullptr)) {                   \
-        reporter->addHistogramMetricValue((key), ##__VA_ARGS__); \
-      }                                                          \
-    }                                                            \
+#define RECORD_HISTOGRAM_METRIC_VALUE(key, ...)                       \
+  {                                                                   \
+    if (::facebook::velox::BaseStatsReporter::registered) {           \
+      if (::facebook::velox::ThreadLocalStats::enabled()) {           \
+        ::facebook::velox::ThreadLocalStats::addHistogramMetricValue( \
+            (key), ##__VA_ARGS__);                                    \
+      } else {                                                        \
+        auto reporter = folly::Singleton<                             \
+            facebook::velox::BaseStatsReporter>::try_get_fast();      \
+        if (FOLLY_LIKELY(reporter != nullptr)) {                      \
+          reporter->addHistogramMetricValue((key), ##__VA_ARGS__);    \
+        }                                                             \
+      }                                                               \
+    }                                                                 \
   }
 } // namespace facebook::velox
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/container/F14Map.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/base/BigintIdMap.h"
+#include "velox/common/memory/Memory.h"
+
+DEFINE_int32(num_values, 10'000, "Number of values per iteration");
+
+namespace facebook::velox {
+namespace {
+
+class BigintIdMapBenchmark {
+ public:
+  BigintIdMapBenchmark() {
+    memory::MemoryManager::initialize({});
+    pool_ = memory::memoryManager()->addLeafPool("BigintIdMapBenchmark");
+  }
+
+  // Returns 'FLAGS_num_values' values with 'numDistinct' distinct values.
+  std::vector<int64_t> makeValues(int32_t numDistinct) {
+    std::vector<int64_t> values(FLAGS_num_values);
+    for (auto i = 0; i < values.size(); ++i) {
+      values[i] = (i % numDistinct) * 0xfeedda7a58ff1e00;
+    }
+    return values;
+  }
+
+  void makeIds(int32_t numDistinct, uint32_t iterations) {
+    std::vector<int64_t> values;
+    std::vector<int32_t> ids;
+    BENCHMARK_SUSPEND {
+      values = makeValues(numDistinct);
+      ids.resize(values.size());
+    }
+    for (auto i = 0; i < iterations; ++i) {
+      BigintIdMap map(1'024, *pool_);
+      map.makeIds(values.data(), values.size(), ids.data());
+      folly::doNotOptimizeAway(ids);
+    }
+  }
+
+  void findIds(int32_t numDistinct, uint32_t iterations) {
+    std::vector<int64_t> values;
+    std::vector<int32_t> ids;
+    std::vector<int64_t> found;
+    std::unique_ptr<BigintIdMap> map;
+    BENCHMARK_SUSPEND {
+      values = makeValues(numDistinct);
+      ids.resize(values.size());
+      found.resize(values.size());
+      map = std::make_unique<BigintIdMap>(1'024, *pool_);
+      map->makeIds(values.data(), values.size(), ids.data());
+    }
+    for (auto i = 0; i < iterations; ++i) {
+      map->findIds(values.data(), values.size(), found.data());
+      folly::doNotOptimizeAway(found);
+    }
+  }
+
+  // Assigns the ids with a F14FastMap one value at a time for comparison.
+  void f14Ids(int32_t numDistinct, uint32_t iterations) {
+    std::vector<int64_t> values;
+    std::vector<int32_t> ids;
+    BENCHMARK_SUSPEND {
+      values = makeValues(numDistinct);
+      ids.resize(values.size());
+    }
+    for (auto i = 0; i < iterations; ++i) {
+      folly::F14FastMap<int64_t, int32_t> map(1'024);
+      for (auto j = 0; j < values.size(); ++j) {
+        ids[j] = map.emplace(values[j], map.size() + 1).first->second;
+      }
+      folly::doNotOptimizeAway(ids);
+    }
+  }
+
+ private:
+  std::shared_ptr<memory::MemoryPool> pool_;
+};
+
+std::unique_ptr<BigintIdMapBenchmark> benchmark;
+
+BENCHMARK(f14Ids100, n) {
+  benchmark->f14Ids(100, n);
+}
+
+BENCHMARK_RELATIVE(makeIds100, n) {
+  benchmark->makeIds(100, n);
+}
+
+BENCHMARK_RELATIVE(findIds100, n) {
+  benchmark->findIds(100, n);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(f14Ids10K, n) {
+  benchmark->f14Ids(10'000, n);
+}
+
+BENCHMARK_RELATIVE(makeIds10K, n) {
+  benchmark->makeIds(10'000, n);
+}
+
+BENCHMARK_RELATIVE(findIds10K, n) {
+  benchmark->findIds(10'000, n);
+}
+
+} // namespace
+} // namespace facebook::velox
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  facebook::velox::benchmark =
+      std::make_unique<facebook::velox::BigintIdMapBenchmark>();
+  folly::runBenchmarks();
+  facebook::velox::benchmark.reset();
+  return 0;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/FastModulo.h"
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+
+#include "velox/common/base/tests/GTestUtils.h"
+
+namespace facebook::velox {
+namespace {
+
+TEST(FastModuloTest, basic) {
+  std::mt19937_64 rng(1);
+  const std::vector<uint64_t> divisors = {
+      1,
+      2,
+      3,
+      7,
+      64,
+      1'000,
+      4'095,
+      4'096,
+      std::numeric_limits<int32_t>::max(),
+      std::numeric_limits<uint32_t>::max(),
+      (1ULL << 32) + 1,
+      std::numeric_limits<uint64_t>::max() - 1,
+      std::numeric_limits<uint64_t>::max()};
+  for (auto divisor : divisors) {
+    FastModulo modulo(divisor);
+    ASSERT_EQ(modulo.divisor(), divisor);
+    for (uint64_t value :
+         {uint64_t(0),
+          uint64_t(1),
+          divisor - 1,
+          divisor,
+          divisor + 1,
+          std::numeric_limits<uint64_t>::max()}) {
+      ASSERT_EQ(modulo(value), value % divisor)
+          << value << " % " << divisor;
+    }
+    for (auto i = 0; i < 10'000; ++i) {
+      const auto value = rng();
+      ASSERT_EQ(modulo(value), value % divisor)
+          << value << " % " << divisor;
+    }
+  }
+  VELOX_ASSERT_THROW(FastModulo(0), "");
+}
+
+} // namespace
+} // namespace facebook::velox
@@ -300,3 +300,41 @@ TEST_F(IdMapTest, collisions) {
     }
   }
 }
+
+TEST_F(IdMapTest, arrays) {
+  constexpr int64_t kNotFound = BigintIdMap::kNotFound;
+  BigintIdMap map(8, *pool_);
+  F14IdMap reference(32);
+  // Sizes that are not a multiple of the batch size probe a partial batch.
+  std::vector<int64_t> data;
+  for (auto i = 0; i < 1'001; ++i) {
+    data.push_back((i % 300) * 0xfeedda7a58ff1e00);
+  }
+  std::vector<int32_t> ids(data.size());
+  map.makeIds(data.data(), data.size(), ids.data());
+  for (auto i = 0; i < data.size(); ++i) {
+    if (i % kBatchSize == 0) {
+      // Zero is given its id before the other values of its batch.
+      for (auto j = i; j < std::min<int32_t>(i + kBatchSize, data.size());
+           ++j) {
+        if (data[j] == 0) {
+          reference.id(0);
+        }
+      }
+    }
+    ASSERT_EQ(reference.id(data[i]), ids[i]) << i;
+  }
+
+  std::vector<int64_t> found(data.size() + 3);
+  std::vector<int64_t> probe = data;
+  probe.push_back(1);
+  probe.push_back(2);
+  probe.push_back(3);
+  map.findIds(probe.data(), probe.size(), found.data());
+  for (auto i = 0; i < data.size(); ++i) {
+    ASSERT_EQ(ids[i], found[i]) << i;
+  }
+  for (auto i = data.size(); i < probe.size(); ++i) {
+    ASSERT_EQ(kNotFound, found[i]);
+  }
+}
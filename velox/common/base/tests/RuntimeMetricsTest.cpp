@@ -16,6 +16,7 @@
 
 #include "velox/common/base/RuntimeMetrics.h"
 #include <gtest/gtest.h>
+#include "velox/common/base/tests/GTestUtils.h"
 
 namespace facebook::velox {
 
@@ -73,4 +74,41 @@ TEST_F(RuntimeMetricsTest, basic) {
   testMetric(rm3, 0, 0, 0, 0);
 };
 
+TEST_F(RuntimeMetricsTest, histogram) {
+  ASSERT_EQ(RuntimeHistogram::bucket(-1), 0);
+  ASSERT_EQ(RuntimeHistogram::bucket(0), 0);
+  ASSERT_EQ(RuntimeHistogram::bucket(1), 1);
+  ASSERT_EQ(RuntimeHistogram::bucket(2), 2);
+  ASSERT_EQ(RuntimeHistogram::bucket(3), 2);
+  ASSERT_EQ(RuntimeHistogram::bucket(1024), 11);
+  ASSERT_EQ(
+      RuntimeHistogram::bucket(std::numeric_limits<int64_t>::max()),
+      RuntimeHistogram::kNumBuckets - 1);
+
+  RuntimeHistogram rows;
+  ASSERT_TRUE(rows.empty());
+  ASSERT_EQ(rows.toString(), "");
+  rows.addValue(3);
+  rows.addValue(2);
+  rows.addValue(1000);
+  ASSERT_FALSE(rows.empty());
+  ASSERT_EQ(rows.toString(), "[2, 4): 2, [512, 1024): 1");
+
+  RuntimeHistogram other;
+  other.addValue(0);
+  other.addValue(1LL << 50);
+  rows.merge(other);
+  ASSERT_EQ(
+      rows.toString(),
+      "[0]: 1, [2, 4): 2, [512, 1024): 1, [274877906944, inf): 1");
+
+  RuntimeHistogram nanos(RuntimeCounter::Unit::kNanos);
+  nanos.addValue(1'500);
+  ASSERT_EQ(nanos.toString(), "[1.02us, 2.05us): 1");
+  VELOX_ASSERT_THROW(rows.merge(nanos), "");
+
+  rows.clear();
+  ASSERT_TRUE(rows.empty());
+}
+
 } // namespace facebook::velox
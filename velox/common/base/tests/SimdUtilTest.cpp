@@ -453,6 +453,41 @@ TEST_F(SimdUtilTest, memEqualUnsafe) {
   EXPECT_FALSE(simd::memEqualUnsafe(&data.x[1], &data.y[1], 67));
 }
 
+TEST_F(SimdUtilTest, simdStrstr) {
+  auto test = [](const std::string& data, const std::string& needle) {
+    // Copies to exact size buffers so that reads past the end are detected by
+    // ASAN.
+    auto dataCopy = std::make_unique<char[]>(data.size());
+    auto needleCopy = std::make_unique<char[]>(needle.size());
+    ::memcpy(dataCopy.get(), data.data(), data.size());
+    ::memcpy(needleCopy.get(), needle.data(), needle.size());
+    EXPECT_EQ(
+        simd::simdStrstr(
+            dataCopy.get(), data.size(), needleCopy.get(), needle.size()),
+        std::string_view(data).find(needle))
+        << data << " " << needle;
+  };
+
+  folly::Random::DefaultGenerator rng(1);
+  for (auto size = 0; size < 100; ++size) {
+    // Few distinct characters give many candidates that fail the comparison.
+    std::string data(size, 'a');
+    for (auto& c : data) {
+      c = 'a' + folly::Random::rand32(3, rng);
+    }
+    for (auto needleSize = 0; needleSize < 10 && needleSize <= size + 1;
+         ++needleSize) {
+      test(data, std::string(needleSize, 'a'));
+      test(data, std::string(needleSize, 'd'));
+      for (auto i = 0; i + needleSize <= size; i += 7) {
+        test(data, data.substr(i, needleSize));
+      }
+    }
+  }
+  test("xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxabcd", "abcd");
+  test("abcd", "abcde");
+}
+
 TEST_F(SimdUtilTest, memcpyTime) {
   constexpr int64_t kMaxMove = 128;
   constexpr int64_t kSize = (128 << 20) + kMaxMove;
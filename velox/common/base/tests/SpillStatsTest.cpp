@@ -41,6 +41,12 @@ TEST(SpillStatsTest, spillStats) {
   stats1.spillReads = 10;
   stats1.spillReadTimeUs = 100;
   stats1.spillDeserializationTimeUs = 100;
+  stats1.spillMergePasses = 1;
+  stats1.spillMergeBytes = 1024;
+  stats1.spillWriteWaitTimeUs = 10;
+  stats1.spillReadAheadTimeUs = 10;
+  stats1.spillReadAheadWaitTimeUs = 5;
+  stats1.spilledFallbackBytes = 1024;
   ASSERT_FALSE(stats1.empty());
   SpillStats stats2;
   stats2.spillRuns = 100;
@@ -60,6 +66,12 @@ TEST(SpillStatsTest, spillStats) {
   stats2.spillReads = 10;
   stats2.spillReadTimeUs = 100;
   stats2.spillDeserializationTimeUs = 100;
+  stats2.spillMergePasses = 2;
+  stats2.spillMergeBytes = 2048;
+  stats2.spillWriteWaitTimeUs = 20;
+  stats2.spillReadAheadTimeUs = 20;
+  stats2.spillReadAheadWaitTimeUs = 10;
+  stats2.spilledFallbackBytes = 2048;
   ASSERT_TRUE(stats1 < stats2);
   ASSERT_TRUE(stats1 <= stats2);
   ASSERT_FALSE(stats1 > stats2);
@@ -90,6 +102,12 @@ TEST(SpillStatsTest, spillStats) {
   ASSERT_EQ(delta.spillReads, 0);
   ASSERT_EQ(delta.spillReadTimeUs, 0);
   ASSERT_EQ(delta.spillDeserializationTimeUs, 0);
+  ASSERT_EQ(delta.spillMergePasses, 1);
+  ASSERT_EQ(delta.spillMergeBytes, 1024);
+  ASSERT_EQ(delta.spillWriteWaitTimeUs, 10);
+  ASSERT_EQ(delta.spillReadAheadTimeUs, 10);
+  ASSERT_EQ(delta.spillReadAheadWaitTimeUs, 5);
+  ASSERT_EQ(delta.spilledFallbackBytes, 1024);
   delta = stats1 - stats2;
   ASSERT_EQ(delta.spilledInputBytes, 0);
   ASSERT_EQ(delta.spilledBytes, 0);
@@ -107,6 +125,12 @@ TEST(SpillStatsTest, spillStats) {
   ASSERT_EQ(delta.spillReads, 0);
   ASSERT_EQ(delta.spillReadTimeUs, 0);
   ASSERT_EQ(delta.spillDeserializationTimeUs, 0);
+  ASSERT_EQ(delta.spillMergePasses, -1);
+  ASSERT_EQ(delta.spillMergeBytes, -1024);
+  ASSERT_EQ(delta.spillWriteWaitTimeUs, -10);
+  ASSERT_EQ(delta.spillReadAheadTimeUs, -10);
+  ASSERT_EQ(delta.spillReadAheadWaitTimeUs, -5);
+  ASSERT_EQ(delta.spilledFallbackBytes, -1024);
   stats1.spilledInputBytes = 2060;
   stats1.spilledBytes = 1030;
   stats1.spillReadBytes = 4096;
@@ -127,7 +151,10 @@ TEST(SpillStatsTest, spillStats) {
       "spillSerializationTime[1.03ms] spillWrites[1028] spillFlushTime[1.03ms] "
       "spillWriteTime[1.03ms] maxSpillExceededLimitCount[4] "
       "spillReadBytes[2.00KB] spillReads[10] spillReadTime[100us] "
-      "spillReadDeserializationTime[100us]");
+      "spillReadDeserializationTime[100us] spillMergePasses[2] "
+      "spillMergeBytes[2.00KB] spillWriteWaitTime[20us] "
+      "spillReadAheadTime[20us] spillReadAheadWaitTime[10us] "
+      "spilledFallbackBytes[2.00KB]");
   ASSERT_EQ(
       fmt::format("{}", stats2),
       "spillRuns[100] spilledInputBytes[2.00KB] spilledBytes[1.00KB] "
@@ -137,5 +164,8 @@ TEST(SpillStatsTest, spillStats) {
       "spillFlushTime[1.03ms] spillWriteTime[1.03ms] "
       "maxSpillExceededLimitCount[4] "
       "spillReadBytes[2.00KB] spillReads[10] spillReadTime[100us] "
-      "spillReadDeserializationTime[100us]");
+      "spillReadDeserializationTime[100us] spillMergePasses[2] "
+      "spillMergeBytes[2.00KB] spillWriteWaitTime[20us] "
+      "spillReadAheadTime[20us] spillReadAheadWaitTime[10us] "
+      "spilledFallbackBytes[2.00KB]");
 }
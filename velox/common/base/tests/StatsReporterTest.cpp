@@ -15,10 +15,12 @@
  */
 
 #include "velox/common/base/StatsReporter.h"
+#include <folly/ScopeGuard.h>
 #include <folly/Singleton.h>
 #include <folly/init/Init.h>
 #include <gtest/gtest.h>
 #include <cstdint>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include "velox/common/base/Counters.h"
@@ -138,6 +140,50 @@ TEST_F(StatsReporterTest, trivialReporter) {
   EXPECT_EQ(100, reporter_->counterMap["key4"]);
 };
 
+TEST_F(StatsReporterTest, threadLocalStats) {
+  DEFINE_METRIC("localKey1", StatType::SUM);
+  DEFINE_HISTOGRAM_METRIC("localKey2", 10, 0, 100, 50, 99);
+  ThreadLocalStats::setEnabled(true);
+  SCOPE_EXIT {
+    ThreadLocalStats::setEnabled(false);
+  };
+
+  constexpr int32_t kNumThreads = 4;
+  constexpr int32_t kNumValues = 1'000;
+  constexpr size_t kTotal = kNumThreads * kNumValues * 2;
+  std::vector<std::thread> threads;
+  for (int32_t i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([]() {
+      for (int32_t j = 0; j < kNumValues; ++j) {
+        RECORD_METRIC_VALUE("localKey1", 2);
+        RECORD_HISTOGRAM_METRIC_VALUE("localKey2", j % 57);
+      }
+    });
+  }
+  // Values are not handed to the reporter until flushed.
+  RECORD_METRIC_VALUE("localKey1");
+  EXPECT_EQ(0, reporter_->counterMap.count("localKey1"));
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ThreadLocalStats::flush(*reporter_);
+  EXPECT_EQ(kTotal + 1, reporter_->counterMap["localKey1"]);
+  // Histogram values are reported as the lower end of their bucket.
+  EXPECT_EQ(50, reporter_->counterMap["localKey2"]);
+
+  // Only values added after the previous flush are reported.
+  RECORD_METRIC_VALUE("localKey1", 5);
+  ThreadLocalStats::flush(*reporter_);
+  EXPECT_EQ(kTotal + 6, reporter_->counterMap["localKey1"]);
+  ThreadLocalStats::flush(*reporter_);
+  EXPECT_EQ(kTotal + 6, reporter_->counterMap["localKey1"]);
+
+  // Histograms that are not defined are not aggregated.
+  RECORD_HISTOGRAM_METRIC_VALUE("localKey3", 7);
+  EXPECT_EQ(7, reporter_->counterMap["localKey3"]);
+}
+
 class PeriodicStatsReportDaemonTest : public StatsReporterTest {};
 
 class TestStatsReportMemoryArbitrator : public memory::MemoryArbitrator {
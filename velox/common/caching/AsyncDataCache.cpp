@@ -29,6 +29,21 @@ namespace facebook::velox::cache {
 using memory::MachinePageCount;
 using memory::MemoryAllocator;
 
+namespace {
+// Returns the prefix of the StatsReporter keys of the cache group 'name'.
+std::string cacheGroupMetricPrefix(const std::string& name) {
+  return fmt::format("velox.cache_group.{}.", name.empty() ? "default" : name);
+}
+
+void defineCacheGroupMetrics(const std::string& name) {
+  const auto prefix = cacheGroupMetricPrefix(name);
+  DEFINE_METRIC(prefix + "hit_count", StatType::SUM);
+  DEFINE_METRIC(prefix + "new_count", StatType::SUM);
+  DEFINE_METRIC(prefix + "evict_count", StatType::SUM);
+  DEFINE_METRIC(prefix + "bytes", StatType::AVG);
+}
+} // namespace
+
 AsyncDataCacheEntry::AsyncDataCacheEntry(CacheShard* shard) : shard_(shard) {
   accessStats_.reset();
 }
@@ -92,6 +107,10 @@ void AsyncDataCacheEntry::addReference() {
 
 memory::MachinePageCount AsyncDataCacheEntry::setPrefetch(bool flag) {
   isPrefetch_ = flag;
+  if (flag && !admitted_) {
+    // Keeps a prefetched entry that was not admitted until its first use.
+    accessStats_.reset();
+  }
   const auto numPages = memory::AllocationTraits::numPages(size_);
   return shard_->cache()->incrementPrefetchPages(flag ? numPages : -numPages);
 }
@@ -139,6 +158,38 @@ std::string AsyncDataCacheEntry::toString() const {
       numPins_);
 }
 
+std::string cacheAdmissionPolicyName(CacheAdmissionPolicy policy) {
+  switch (policy) {
+    case CacheAdmissionPolicy::kAdmitAll:
+      return "ADMIT_ALL";
+    case CacheAdmissionPolicy::kTinyLfu:
+      return "TINY_LFU";
+    default:
+      return fmt::format("UNKNOWN: {}", static_cast<int>(policy));
+  }
+}
+
+CacheShard::CacheShard(
+    AsyncDataCache* cache,
+    CacheAdmissionPolicy admissionPolicy)
+    : cache_(cache) {
+  if (admissionPolicy == CacheAdmissionPolicy::kTinyLfu) {
+    frequencySketch_ = std::make_unique<FrequencySketch>(kFrequencySketchWidth);
+  }
+}
+
+bool CacheShard::admitNew(RawFileCacheKey key) {
+  // All new entries are retained until the cache is first full.
+  if (frequencySketch_ != nullptr && evictionThreshold_ != kNoThreshold &&
+      frequencySketch_->estimate(std::hash<RawFileCacheKey>()(key)) <
+          kMinAdmitFrequency) {
+    ++numAdmitReject_;
+    return false;
+  }
+  ++numAdmit_;
+  return true;
+}
+
 std::unique_ptr<AsyncDataCacheEntry> CacheShard::getFreeEntry() {
   std::unique_ptr<AsyncDataCacheEntry> newEntry;
   if (freeEntries_.empty()) {
@@ -153,11 +204,18 @@ std::unique_ptr<AsyncDataCacheEntry> CacheShard::getFreeEntry() {
 CachePin CacheShard::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
-    folly::SemiFuture<bool>* wait) {
+    folly::SemiFuture<bool>* wait,
+    int32_t cacheGroup) {
+  VELOX_DCHECK_GE(cacheGroup, 0);
+  VELOX_DCHECK_LT(cacheGroup, kMaxCacheGroups);
   AsyncDataCacheEntry* entryToInit = nullptr;
+  bool admitted = true;
   {
     std::lock_guard<std::mutex> l(mutex_);
     ++eventCounter_;
+    if (frequencySketch_ != nullptr) {
+      frequencySketch_->increment(std::hash<RawFileCacheKey>()(key));
+    }
     auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
       auto* found = it->second;
@@ -175,8 +233,13 @@ CachePin CacheShard::findOrCreate(
         if (found->isPrefetch()) {
           found->isFirstUse_ = true;
           found->setPrefetch(false);
+          if (!found->admitted_) {
+            // The first use of a prefetched entry is not a reuse.
+            found->makeEvictable();
+          }
         } else {
           ++numHit_;
+          ++groupNumHit_[cacheGroup];
           hitBytes_ += found->size();
         }
         ++found->numPins_;
@@ -211,12 +274,25 @@ CachePin CacheShard::findOrCreate(
       entries_[index] = std::move(newEntry);
     }
     ++numNew_;
+    ++groupNumNew_[cacheGroup];
+    // A group over its quota may use free memory but its new entries are the
+    // first to go.
+    admitted = admitNew(key) && !overQuotaLocked(cacheGroup);
+    entryToInit->admitted_ = admitted;
     // Inside the shard mutex.
     VELOX_CHECK_EQ(entryToInit->size_, 0);
     entryToInit->size_ = size;
+    entryToInit->cacheGroup_ = cacheGroup;
+    groupBytes_[cacheGroup] += size;
     entryToInit->isFirstUse_ = true;
   }
-  return initEntry(key, entryToInit);
+  auto pin = initEntry(key, entryToInit);
+  if (!admitted) {
+    // The entry is loaded for the caller but is the first to go once unpinned
+    // unless it is hit before.
+    entryToInit->makeEvictable();
+  }
+  return pin;
 }
 
 bool CacheShard::exists(RawFileCacheKey key) const {
@@ -333,9 +409,15 @@ void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
   }
   entry->tinyData_.clear();
   entry->tinyData_.shrink_to_fit();
+  groupBytes_[entry->cacheGroup_] -= entry->size_;
   entry->size_ = 0;
 }
 
+bool CacheShard::overQuotaLocked(int32_t cacheGroup) const {
+  const auto quota = cache_->cacheGroupShardQuota(cacheGroup);
+  return quota > 0 && groupBytes_[cacheGroup] > quota;
+}
+
 uint64_t CacheShard::evict(
     uint64_t bytesToFree,
     bool evictAllUnpinned,
@@ -386,6 +468,7 @@ uint64_t CacheShard::evict(
       int32_t score = 0;
       if (candidate->numPins_ == 0 &&
           (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
+           overQuotaLocked(candidate->cacheGroup_) ||
            (score = candidate->score(now)) >= evictionThreshold_)) {
         if (skipSsdSaveable && candidate->ssdSaveable() && !evictAllUnpinned) {
           ++evictSaveableSkipped;
@@ -405,7 +488,9 @@ uint64_t CacheShard::evict(
         tinyEvicted += candidate->tinyData_.size();
         candidate->tinyData_.clear();
         candidate->tinyData_.shrink_to_fit();
+        groupBytes_[candidate->cacheGroup_] -= candidate->size_;
         candidate->size_ = 0;
+        ++groupNumEvict_[candidate->cacheGroup_];
 
         removeEntryLocked(candidate);
         emptySlots_.push_back(entryIndex);
@@ -514,9 +599,31 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numWaitExclusive += numWaitExclusive_;
   stats.numAgedOut += numAgedOut_;
   stats.sumEvictScore += sumEvictScore_;
+  stats.numAdmit += numAdmit_;
+  stats.numAdmitReject += numAdmitReject_;
   stats.allocClocks += allocClocks_;
 }
 
+void CacheShard::updateGroupStats(std::vector<CacheGroupStats>& stats) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto i = 0; i < stats.size(); ++i) {
+    stats[i].bytes += groupBytes_[i];
+    stats[i].numHit += groupNumHit_[i];
+    stats[i].numNew += groupNumNew_[i];
+    stats[i].numEvict += groupNumEvict_[i];
+  }
+}
+
+void CacheShard::addResidency(CacheResidencyBuilder& builder) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (const auto& [key, entry] : entryMap_) {
+    // Exclusive entries are still being loaded and may never complete.
+    if (!entry->isExclusive()) {
+      builder.add(key.fileNum, key.offset, entry->size(), false);
+    }
+  }
+}
+
 void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
   std::lock_guard<std::mutex> l(mutex_);
   // Do not add more than 70% of entries to a write batch.If SSD save
@@ -590,11 +697,16 @@ bool CacheShard::removeFileEntries(
 
 AsyncDataCache::AsyncDataCache(
     memory::MemoryAllocator* allocator,
-    std::unique_ptr<SsdCache> ssdCache)
-    : allocator_(allocator), ssdCache_(std::move(ssdCache)), cachedPages_(0) {
+    std::unique_ptr<SsdCache> ssdCache,
+    CacheAdmissionPolicy admissionPolicy)
+    : allocator_(allocator),
+      ssdCache_(std::move(ssdCache)),
+      admissionPolicy_(admissionPolicy),
+      cachedPages_(0) {
   for (auto i = 0; i < kNumShards; ++i) {
-    shards_.push_back(std::make_unique<CacheShard>(this));
+    shards_.push_back(std::make_unique<CacheShard>(this, admissionPolicy_));
   }
+  defineCacheGroupMetrics(cacheGroupNames_[kDefaultCacheGroup]);
 }
 
 AsyncDataCache::~AsyncDataCache() {}
@@ -602,8 +714,10 @@ AsyncDataCache::~AsyncDataCache() {}
 // static
 std::shared_ptr<AsyncDataCache> AsyncDataCache::create(
     memory::MemoryAllocator* allocator,
-    std::unique_ptr<SsdCache> ssdCache) {
-  auto cache = std::make_shared<AsyncDataCache>(allocator, std::move(ssdCache));
+    std::unique_ptr<SsdCache> ssdCache,
+    CacheAdmissionPolicy admissionPolicy) {
+  auto cache = std::make_shared<AsyncDataCache>(
+      allocator, std::move(ssdCache), admissionPolicy);
   allocator->registerCache(cache);
   return cache;
 }
@@ -638,9 +752,71 @@ void CacheShard::shutdown() {
 CachePin AsyncDataCache::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
-    folly::SemiFuture<bool>* wait) {
+    folly::SemiFuture<bool>* wait,
+    int32_t cacheGroup) {
   const int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
-  return shards_[shard]->findOrCreate(key, size, wait);
+  return shards_[shard]->findOrCreate(key, size, wait, cacheGroup);
+}
+
+int32_t AsyncDataCache::cacheGroupId(const std::string& name) {
+  if (name.empty()) {
+    return kDefaultCacheGroup;
+  }
+  std::lock_guard<std::mutex> l(cacheGroupMutex_);
+  for (auto i = 0; i < cacheGroupNames_.size(); ++i) {
+    if (cacheGroupNames_[i] == name) {
+      return i;
+    }
+  }
+  VELOX_CHECK_LT(
+      static_cast<int32_t>(cacheGroupNames_.size()),
+      kMaxCacheGroups,
+      "Too many cache groups, cannot add {}",
+      name);
+  cacheGroupNames_.push_back(name);
+  defineCacheGroupMetrics(name);
+  return cacheGroupNames_.size() - 1;
+}
+
+void AsyncDataCache::setCacheGroupQuota(
+    const std::string& name,
+    uint64_t quotaBytes) {
+  groupQuotas_[cacheGroupId(name)] = quotaBytes;
+}
+
+std::vector<CacheGroupStats> AsyncDataCache::cacheGroupStats() const {
+  std::vector<CacheGroupStats> stats;
+  {
+    std::lock_guard<std::mutex> l(cacheGroupMutex_);
+    stats.resize(cacheGroupNames_.size());
+    for (auto i = 0; i < stats.size(); ++i) {
+      stats[i].name = cacheGroupNames_[i];
+      stats[i].quotaBytes = groupQuotas_[i];
+    }
+  }
+  for (const auto& shard : shards_) {
+    shard->updateGroupStats(stats);
+  }
+  return stats;
+}
+
+void AsyncDataCache::reportCacheGroupStats() {
+  const auto stats = cacheGroupStats();
+  std::lock_guard<std::mutex> l(cacheGroupMutex_);
+  reportedGroupStats_.resize(stats.size());
+  for (auto i = 0; i < stats.size(); ++i) {
+    const auto& current = stats[i];
+    auto& previous = reportedGroupStats_[i];
+    const auto prefix = cacheGroupMetricPrefix(current.name);
+    RECORD_METRIC_VALUE(
+        prefix + "hit_count", current.numHit - previous.numHit);
+    RECORD_METRIC_VALUE(
+        prefix + "new_count", current.numNew - previous.numNew);
+    RECORD_METRIC_VALUE(
+        prefix + "evict_count", current.numEvict - previous.numEvict);
+    RECORD_METRIC_VALUE(prefix + "bytes", std::max<int64_t>(0, current.bytes));
+    previous = current;
+  }
 }
 
 bool AsyncDataCache::exists(RawFileCacheKey key) const {
@@ -843,6 +1019,84 @@ void AsyncDataCache::saveToSsd() {
   ssdCache_->write(std::move(pins));
 }
 
+CacheResidencySummary AsyncDataCache::residencySummary() const {
+  CacheResidencyBuilder builder;
+  for (const auto& shard : shards_) {
+    shard->addResidency(builder);
+  }
+  if (ssdCache_ != nullptr) {
+    for (auto i = 0; i < ssdCache_->numShards(); ++i) {
+      ssdCache_->shard(i).addResidency(builder);
+    }
+  }
+  return builder.build();
+}
+
+uint64_t AsyncDataCache::warmUpFromSsd(uint64_t maxBytes) {
+  if (ssdCache_ == nullptr) {
+    return 0;
+  }
+  // Loads in batches so that a batch is coalesced on SSD without holding
+  // exclusive pins on too much memory.
+  constexpr uint64_t kBatchBytes = 16 << 20;
+  uint64_t bytesLoaded = 0;
+  const auto numShards = ssdCache_->numShards();
+  for (auto shard = 0; shard < numShards; ++shard) {
+    auto& file = ssdCache_->shard(shard);
+    std::vector<SsdPin> ssdPins;
+    std::vector<CachePin> pins;
+    uint64_t batchBytes = 0;
+    const auto loadBatch = [&]() {
+      if (pins.empty()) {
+        return;
+      }
+      try {
+        file.load(ssdPins, pins);
+        for (auto& pin : pins) {
+          pin.checkedEntry()->setExclusiveToShared();
+        }
+        bytesLoaded += batchBytes;
+      } catch (const std::exception& e) {
+        // The exclusive pins of the failed batch are dropped with their
+        // entries.
+        VELOX_CACHE_LOG(WARNING)
+            << "Failed SSD cache warm-up from " << file.fileName() << ": "
+            << e.what();
+      }
+      pins.clear();
+      ssdPins.clear();
+      batchBytes = 0;
+    };
+
+    for (const auto& [key, size] : file.hottestEntries(maxBytes / numShards)) {
+      const RawFileCacheKey rawKey{key.fileNum.id(), key.offset};
+      auto ssdPin = file.find(rawKey);
+      if (ssdPin.empty()) {
+        continue;
+      }
+      CachePin pin;
+      try {
+        pin = findOrCreate(rawKey, size, nullptr);
+      } catch (const std::exception&) {
+        // No memory for more entries.
+        break;
+      }
+      if (pin.empty() || !pin.checkedEntry()->isExclusive()) {
+        continue;
+      }
+      pin.checkedEntry()->setPrefetch(true);
+      pins.push_back(std::move(pin));
+      ssdPins.push_back(std::move(ssdPin));
+      batchBytes += size;
+      if (batchBytes >= kBatchBytes) {
+        loadBatch();
+      }
+    }
+    loadBatch();
+  }
+  return bytesLoaded;
+}
+
 bool AsyncDataCache::removeFileEntries(
     const folly::F14FastSet<uint64_t>& filesToRemove,
     folly::F14FastSet<uint64_t>& filesRetained) {
@@ -866,6 +1120,7 @@ bool AsyncDataCache::removeFileEntries(
 
 CacheStats AsyncDataCache::refreshStats() const {
   CacheStats stats;
+  stats.admissionPolicy = admissionPolicy_;
   for (auto& shard : shards_) {
     shard->updateStats(stats);
   }
@@ -919,7 +1174,16 @@ std::string CacheStats::toString() const {
       << "Cache access miss: " << numNew << " hit: " << numHit
       << " hit bytes: " << succinctBytes(hitBytes) << " eviction: " << numEvict
       << " eviction checks: " << numEvictChecks << " aged out: " << numAgedOut
-      << "\n"
+      << "\n";
+  if (admissionPolicy != CacheAdmissionPolicy::kAdmitAll) {
+    // Admission policy stats.
+    out << "Admission policy: " << cacheAdmissionPolicyName(admissionPolicy)
+        << " admitted: " << numAdmit << " rejected: " << numAdmitReject
+        << " hit rate: "
+        << (numHit + numNew == 0 ? 0 : 100 * numHit / (numHit + numNew))
+        << "%\n";
+  }
+  out
       // Cache prefetch stats.
       << "Prefetch entries: " << numPrefetch
       << " bytes: " << succinctBytes(prefetchBytes)
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <array>
 #include <deque>
 
 #include <fmt/format.h>
@@ -27,7 +28,9 @@
 #include "velox/common/base/CoalesceIo.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
+#include "velox/common/caching/CacheResidency.h"
 #include "velox/common/caching/FileGroupStats.h"
+#include "velox/common/caching/FrequencySketch.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
 #include "velox/common/file/File.h"
@@ -301,6 +304,11 @@ class AsyncDataCacheEntry {
   // evicted before they are hit.
   bool isPrefetch_{false};
 
+  // False if the admission policy did not retain 'this' when it was created.
+  // Such an entry stays immediately evictable until it is hit. Set inside the
+  // shard mutex.
+  bool admitted_{true};
+
   // Sets after first use of a prefetched entry. Cleared by
   // getAndClearFirstUseFlag(). Does not require synchronization since used for
   // statistics only.
@@ -309,6 +317,9 @@ class AsyncDataCacheEntry {
   // Group id. Used for deciding if 'this' should be written to SSD.
   uint64_t groupId_{0};
 
+  // Cache group whose quota 'this' counts against. Set inside the shard mutex.
+  int32_t cacheGroup_{0};
+
   // Tracking id. Used for deciding if this should be written to SSD.
   TrackingId trackingId_;
 
@@ -471,6 +482,43 @@ class CoalescedLoad {
   std::vector<int32_t> sizes_;
 };
 
+/// Decides which new entries are retained in cache.
+enum class CacheAdmissionPolicy {
+  /// All new entries are retained and compete for space by their access
+  /// recency and count.
+  kAdmitAll,
+  /// Keeps a TinyLFU frequency sketch of the accessed keys, including ones no
+  /// longer cached. Once the cache is full, a new entry whose key has not
+  /// been accessed before in the sketch window is made evictable as soon as
+  /// it is unpinned, so that one-off scans do not flush frequently reused
+  /// data. The entry is retained normally if it is hit before it is evicted.
+  kTinyLfu,
+};
+
+std::string cacheAdmissionPolicyName(CacheAdmissionPolicy policy);
+
+/// Maximum number of cache groups, including the default group.
+constexpr int32_t kMaxCacheGroups = 32;
+
+/// Cache group of entries created without a group, e.g. by readers that do
+/// not set io::ReaderOptions::cacheGroup(). It has no quota.
+constexpr int32_t kDefaultCacheGroup = 0;
+
+/// Memory usage and access counts of one cache group. See
+/// AsyncDataCache::cacheGroupId().
+struct CacheGroupStats {
+  std::string name;
+  /// Memory quota in bytes or 0 for none.
+  uint64_t quotaBytes{0};
+  /// Bytes in the entries of the group.
+  int64_t bytes{0};
+  /// Number of hits and new entries for readers of the group.
+  int64_t numHit{0};
+  int64_t numNew{0};
+  /// Number of entries of the group removed to make space.
+  int64_t numEvict{0};
+};
+
 // Struct for CacheShard stats. Stats from all shards are added into
 // this struct to provide a snapshot of state.
 struct CacheStats {
@@ -518,6 +566,14 @@ struct CacheStats {
   // lifetime for entries in cache.
   int64_t sumEvictScore{0};
 
+  // The admission policy of the cache.
+  CacheAdmissionPolicy admissionPolicy{CacheAdmissionPolicy::kAdmitAll};
+  // Number of new entries retained by the admission policy.
+  int64_t numAdmit{0};
+  // Number of new entries that the admission policy made immediately
+  // evictable.
+  int64_t numAdmitReject{0};
+
   // Total size of shared/exclusive pinned entries.
   int64_t sharedPinnedBytes{0};
   int64_t exclusivePinnedBytes{0};
@@ -533,13 +589,14 @@ struct CacheStats {
 /// and other housekeeping.
 class CacheShard {
  public:
-  explicit CacheShard(AsyncDataCache* cache) : cache_(cache) {}
+  CacheShard(AsyncDataCache* cache, CacheAdmissionPolicy admissionPolicy);
 
   /// See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
       RawFileCacheKey key,
       uint64_t size,
-      folly::SemiFuture<bool>* readyFuture);
+      folly::SemiFuture<bool>* readyFuture,
+      int32_t cacheGroup = kDefaultCacheGroup);
 
   /// Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
@@ -578,6 +635,10 @@ class CacheShard {
   // Adds the stats of 'this' to 'stats'.
   void updateStats(CacheStats& stats);
 
+  // Adds the per cache group stats of 'this' to 'stats', which has an element
+  // for each group.
+  void updateGroupStats(std::vector<CacheGroupStats>& stats) const;
+
   // Appends a batch of non-saved SSD savable entries in 'this' to
   // 'pins'. This may have to be called several times since this keeps
   // limits on the batch to write at one time. The savable entries
@@ -585,6 +646,9 @@ class CacheShard {
   // calling this a second time.
   void appendSsdSaveable(std::vector<CachePin>& pins);
 
+  /// Adds the ranges of the loaded entries in 'this' to 'builder'.
+  void addResidency(CacheResidencyBuilder& builder) const;
+
   /// Remove cache entries from this shard for files in the fileNum set
   /// 'filesToRemove'. If successful, return true, and 'filesRetained' contains
   /// entries that should not be removed, ex., in exclusive mode or in shared
@@ -600,11 +664,25 @@ class CacheShard {
  private:
   static constexpr uint32_t kMaxFreeEntries = 1 << 10;
   static constexpr int32_t kNoThreshold = std::numeric_limits<int32_t>::max();
+  // Counters per row of 'frequencySketch_'.
+  static constexpr int32_t kFrequencySketchWidth = 1 << 14;
+  // Minimum estimated access frequency, including the current access, for a
+  // new entry to be retained by CacheAdmissionPolicy::kTinyLfu once the cache
+  // is full. Keys seen for the first time are not retained.
+  static constexpr int32_t kMinAdmitFrequency = 2;
 
   void calibrateThreshold();
 
+  // Returns true if a new entry for 'key' should be retained by the admission
+  // policy. Counts the decision in 'numAdmit_' or 'numAdmitReject_'.
+  bool admitNew(RawFileCacheKey key);
+
   void removeEntryLocked(AsyncDataCacheEntry* entry);
 
+  // Returns true if the entries of 'cacheGroup' take more than the share of
+  // its quota in 'this'. 'mutex_' must be held.
+  bool overQuotaLocked(int32_t cacheGroup) const;
+
   // Returns an unused entry if found.
   //
   // TODO: consider to pass a size hint so as to select the a free entry which
@@ -635,6 +713,18 @@ class CacheShard {
   uint32_t eventCounter_{0};
   // Maximum retainable entry score(). Anything above this is evictable.
   int32_t evictionThreshold_{kNoThreshold};
+  // Access frequencies of keys for CacheAdmissionPolicy::kTinyLfu. nullptr for
+  // other policies.
+  std::unique_ptr<FrequencySketch> frequencySketch_;
+  // Cumulative count of new entries retained or made immediately evictable by
+  // the admission policy.
+  uint64_t numAdmit_{0};
+  uint64_t numAdmitReject_{0};
+  // Per cache group bytes in entries, hits, new entries and evictions.
+  std::array<int64_t, kMaxCacheGroups> groupBytes_{};
+  std::array<uint64_t, kMaxCacheGroups> groupNumHit_{};
+  std::array<uint64_t, kMaxCacheGroups> groupNumNew_{};
+  std::array<uint64_t, kMaxCacheGroups> groupNumEvict_{};
   // Cumulative count of cache hits.
   uint64_t numHit_{0};
   // Sum of bytes in cache hits.
@@ -662,13 +752,19 @@ class AsyncDataCache : public memory::Cache {
  public:
   AsyncDataCache(
       memory::MemoryAllocator* allocator,
-      std::unique_ptr<SsdCache> ssdCache = nullptr);
+      std::unique_ptr<SsdCache> ssdCache = nullptr,
+      CacheAdmissionPolicy admissionPolicy = CacheAdmissionPolicy::kAdmitAll);
 
   ~AsyncDataCache() override;
 
   static std::shared_ptr<AsyncDataCache> create(
       memory::MemoryAllocator* allocator,
-      std::unique_ptr<SsdCache> ssdCache = nullptr);
+      std::unique_ptr<SsdCache> ssdCache = nullptr,
+      CacheAdmissionPolicy admissionPolicy = CacheAdmissionPolicy::kAdmitAll);
+
+  CacheAdmissionPolicy admissionPolicy() const {
+    return admissionPolicy_;
+  }
 
   static AsyncDataCache* getInstance();
 
@@ -706,10 +802,15 @@ class AsyncDataCache : public memory::Cache {
   /// the future is realized, the caller may retry findOrCreate().
   /// runtime error with code kNoCacheSpace if there is no space to create the
   /// new entry after evicting any unpinned content.
+  ///
+  /// The new entry counts against the quota of 'cacheGroup'. If the group is
+  /// over its quota, the entry is loaded for the caller but is immediately
+  /// evictable once unpinned.
   CachePin findOrCreate(
       RawFileCacheKey key,
       uint64_t size,
-      folly::SemiFuture<bool>* waitFuture = nullptr);
+      folly::SemiFuture<bool>* waitFuture = nullptr,
+      int32_t cacheGroup = kDefaultCacheGroup);
 
   /// Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
@@ -761,14 +862,15 @@ class AsyncDataCache : public memory::Cache {
   // loaded pins. Calls processPin for each exclusive
   // pin. processPin must move its argument if it wants to use it
   // afterwards. sizeFunc(i) returns the size of the ith item in
-  // 'keys'.
+  // 'keys'. New entries count against 'cacheGroup'.
   template <typename SizeFunc, typename ProcessPin>
   void makePins(
       const std::vector<RawFileCacheKey>& keys,
       SizeFunc sizeFunc,
-      ProcessPin processPin) {
+      ProcessPin processPin,
+      int32_t cacheGroup = kDefaultCacheGroup) {
     for (auto i = 0; i < keys.size(); ++i) {
-      auto pin = findOrCreate(keys[i], sizeFunc(i), nullptr);
+      auto pin = findOrCreate(keys[i], sizeFunc(i), nullptr, cacheGroup);
       if (pin.empty() || pin.checkedEntry()->isShared()) {
         continue;
       }
@@ -782,6 +884,22 @@ class AsyncDataCache : public memory::Cache {
   // Saves all entries with 'ssdSaveable_' to 'ssdCache_'.
   void saveToSsd();
 
+  /// Loads the entries of the hottest regions of 'ssdCache_' into memory, up
+  /// to 'maxBytes' divided evenly between the SSD shards. The regions are
+  /// ranked by the access scores that are restored with the SSD checkpoint, so
+  /// this warms up memory after a restart. This is meant to run in the
+  /// background, e.g. on an executor, after startup. The entries are loaded as
+  /// prefetched. Stops early if the memory cache is full. Returns the number of
+  /// bytes loaded.
+  uint64_t warmUpFromSsd(uint64_t maxBytes);
+
+  /// Returns a summary of the file regions cached in memory and on SSD for
+  /// placing splits on the workers that have their data cached. Each shard is
+  /// locked only while its entries are added, so this can be called
+  /// periodically while the cache is in use. The summary is rebuilt from
+  /// scratch each time since a Bloom filter can not forget evicted regions.
+  CacheResidencySummary residencySummary() const;
+
   tsan_atomic<int32_t>& numSkippedSaves() {
     return numSkippedSaves_;
   }
@@ -794,6 +912,32 @@ class AsyncDataCache : public memory::Cache {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
+  /// Returns the id of the cache group 'name' for findOrCreate(), adding the
+  /// group if new. Cache groups let tenants share the cache with a memory
+  /// quota each. The empty name is kDefaultCacheGroup. Throws if there would
+  /// be more than kMaxCacheGroups groups.
+  int32_t cacheGroupId(const std::string& name);
+
+  /// Sets the memory quota of the cache group 'name' to 'quotaBytes', 0 for
+  /// none. A group may use free memory beyond its quota, but when space is
+  /// needed, the unpinned entries of groups over their quota are evicted
+  /// first, and new entries of a group over its quota are the first to go.
+  void setCacheGroupQuota(const std::string& name, uint64_t quotaBytes);
+
+  /// Returns the share of the quota of 'cacheGroup' in each shard or 0 if the
+  /// group has no quota.
+  uint64_t cacheGroupShardQuota(int32_t cacheGroup) const {
+    return groupQuotas_[cacheGroup] / kNumShards;
+  }
+
+  /// Returns the stats of each cache group, the default group first.
+  std::vector<CacheGroupStats> cacheGroupStats() const;
+
+  /// Reports the memory usage of each cache group and its hits, new entries
+  /// and evictions since the previous call through StatsReporter. Meant to be
+  /// called periodically.
+  void reportCacheGroupStats();
+
  private:
   static constexpr int32_t kNumShards = 4; // Must be power of 2.
   static constexpr int32_t kShardMask = kNumShards - 1;
@@ -810,6 +954,7 @@ class AsyncDataCache : public memory::Cache {
 
   memory::MemoryAllocator* const allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
+  const CacheAdmissionPolicy admissionPolicy_;
   std::vector<std::unique_ptr<CacheShard>> shards_;
   std::atomic<int32_t> shardCounter_{0};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
@@ -830,6 +975,14 @@ class AsyncDataCache : public memory::Cache {
   CacheStats stats_;
 
   std::function<void(const AsyncDataCacheEntry&)> verifyHook_;
+
+  mutable std::mutex cacheGroupMutex_;
+  // Cache group names by id. The default group has the empty name.
+  std::vector<std::string> cacheGroupNames_{""};
+  std::array<std::atomic<uint64_t>, kMaxCacheGroups> groupQuotas_{};
+  // Stats as of the last reportCacheGroupStats().
+  std::vector<CacheGroupStats> reportedGroupStats_;
+
   // Count of skipped saves to 'ssdCache_' due to 'ssdCache_' being
   // busy with write.
   tsan_atomic<int32_t> numSkippedSaves_{0};
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheResidency.h"
+
+#include <fmt/format.h>
+#include <folly/container/F14Map.h>
+#include <folly/hash/SpookyHashV2.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/caching/FileIds.h"
+
+namespace facebook::velox::cache {
+
+namespace {
+// Size of the fixed fields before the serialized Bloom filter.
+constexpr size_t kHeaderSize = sizeof(int8_t) + sizeof(int64_t) +
+    sizeof(uint64_t) + sizeof(uint64_t);
+} // namespace
+
+// static
+uint64_t CacheResidencySummary::regionHash(
+    std::string_view fileName,
+    uint64_t region) {
+  return bits::hashMix(
+      folly::hash::SpookyHashV2::Hash64(fileName.data(), fileName.size(), 0),
+      region);
+}
+
+bool CacheResidencySummary::mayContain(
+    std::string_view fileName,
+    uint64_t offset) const {
+  return filter_.isSet() &&
+      filter_.mayContain(regionHash(fileName, offset / kRegionSize));
+}
+
+uint64_t CacheResidencySummary::cachedBytes(
+    std::string_view fileName,
+    uint64_t offset,
+    uint64_t length) const {
+  if (!filter_.isSet() || length == 0) {
+    return 0;
+  }
+  const auto end = offset + length;
+  uint64_t bytes = 0;
+  for (auto region = offset / kRegionSize; region * kRegionSize < end;
+       ++region) {
+    if (filter_.mayContain(regionHash(fileName, region))) {
+      const auto regionBegin = std::max(offset, region * kRegionSize);
+      const auto regionEnd = std::min(end, (region + 1) * kRegionSize);
+      bytes += regionEnd - regionBegin;
+    }
+  }
+  return bytes;
+}
+
+std::string CacheResidencySummary::serialize() const {
+  std::string serialized;
+  serialized.resize(kHeaderSize + filter_.serializedSize());
+  common::OutputByteStream stream(serialized.data());
+  stream.appendOne(kVersion);
+  stream.appendOne(numRegions_);
+  stream.appendOne(memoryBytes_);
+  stream.appendOne(ssdBytes_);
+  filter_.serialize(serialized.data() + stream.offset());
+  return serialized;
+}
+
+// static
+CacheResidencySummary CacheResidencySummary::deserialize(
+    std::string_view serialized) {
+  VELOX_CHECK_GT(
+      serialized.size(), kHeaderSize, "Truncated cache residency summary");
+  common::InputByteStream stream(serialized.data());
+  const auto version = stream.read<int8_t>();
+  VELOX_CHECK_EQ(
+      version, kVersion, "Unsupported cache residency summary version");
+  CacheResidencySummary summary;
+  summary.numRegions_ = stream.read<int64_t>();
+  summary.memoryBytes_ = stream.read<uint64_t>();
+  summary.ssdBytes_ = stream.read<uint64_t>();
+  summary.filter_.merge(serialized.data() + stream.offset());
+  return summary;
+}
+
+std::string CacheResidencySummary::toString() const {
+  return fmt::format(
+      "Cache residency: {} regions, {} in memory, {} on SSD, filter {}",
+      numRegions_,
+      succinctBytes(memoryBytes_),
+      succinctBytes(ssdBytes_),
+      succinctBytes(filter_.serializedSize()));
+}
+
+void CacheResidencyBuilder::add(
+    uint64_t fileNum,
+    uint64_t offset,
+    uint64_t size,
+    bool ssd) {
+  const auto lastRegion =
+      (offset + std::max<uint64_t>(size, 1) - 1) /
+      CacheResidencySummary::kRegionSize;
+  for (auto region = offset / CacheResidencySummary::kRegionSize;
+       region <= lastRegion;
+       ++region) {
+    regions_.emplace(fileNum, region);
+  }
+  (ssd ? ssdBytes_ : memoryBytes_) += size;
+}
+
+CacheResidencySummary CacheResidencyBuilder::build() const {
+  CacheResidencySummary summary;
+  summary.memoryBytes_ = memoryBytes_;
+  summary.ssdBytes_ = ssdBytes_;
+  summary.filter_.reset(std::max<int32_t>(
+      1,
+      std::min<uint64_t>(
+          regions_.size(), std::numeric_limits<int32_t>::max() / 2)));
+  folly::F14FastMap<uint64_t, std::string> fileNames;
+  for (const auto& [fileNum, region] : regions_) {
+    auto it = fileNames.find(fileNum);
+    if (it == fileNames.end()) {
+      it = fileNames.emplace(fileNum, fileIds().string(fileNum)).first;
+    }
+    if (it->second.empty()) {
+      continue;
+    }
+    summary.filter_.insert(
+        CacheResidencySummary::regionHash(it->second, region));
+    ++summary.numRegions_;
+  }
+  return summary;
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Set.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "velox/common/base/BloomFilter.h"
+
+namespace facebook::velox::cache {
+
+/// A compact, serializable summary of which file regions a worker has in its
+/// memory and SSD caches. A scheduler can ask a summary per worker how many
+/// bytes of a split are likely cached and route the split to the worker with
+/// the most. Regions are kRegionSize aligned ranges of a file. Membership is
+/// kept in a Bloom filter over the file name and region, so a summary has ~2%
+/// false positives and no false negatives at the time it was made. Files are
+/// identified by name since file ids are specific to a process.
+class CacheResidencySummary {
+ public:
+  static constexpr uint64_t kRegionSize = 8 << 20;
+
+  CacheResidencySummary() = default;
+
+  /// Returns the hash under which region 'region' of 'fileName' is recorded.
+  /// The hash is the same in all processes.
+  static uint64_t regionHash(std::string_view fileName, uint64_t region);
+
+  /// Returns true if the region containing 'offset' of 'fileName' may be
+  /// cached.
+  bool mayContain(std::string_view fileName, uint64_t offset) const;
+
+  /// Returns the number of bytes of the range of 'length' bytes at 'offset'
+  /// in 'fileName' that fall in possibly cached regions.
+  uint64_t cachedBytes(
+      std::string_view fileName,
+      uint64_t offset,
+      uint64_t length) const;
+
+  /// Number of distinct regions with cached data.
+  int64_t numRegions() const {
+    return numRegions_;
+  }
+
+  /// Bytes of cached entries in memory and on SSD.
+  uint64_t memoryBytes() const {
+    return memoryBytes_;
+  }
+
+  uint64_t ssdBytes() const {
+    return ssdBytes_;
+  }
+
+  std::string serialize() const;
+
+  static CacheResidencySummary deserialize(std::string_view serialized);
+
+  std::string toString() const;
+
+ private:
+  friend class CacheResidencyBuilder;
+
+  static constexpr int8_t kVersion = 1;
+
+  BloomFilter<> filter_;
+  int64_t numRegions_{0};
+  uint64_t memoryBytes_{0};
+  uint64_t ssdBytes_{0};
+};
+
+/// Collects the cached ranges of the memory and SSD cache shards into a
+/// CacheResidencySummary. See AsyncDataCache::residencySummary().
+class CacheResidencyBuilder {
+ public:
+  /// Records 'size' bytes at 'offset' in the file with id 'fileNum' as cached
+  /// in memory or, if 'ssd' is true, on SSD.
+  void add(uint64_t fileNum, uint64_t offset, uint64_t size, bool ssd);
+
+  /// Returns the summary of the ranges added so far. The file names are looked
+  /// up in fileIds(). Ranges of files that no longer have a name are dropped.
+  CacheResidencySummary build() const;
+
+ private:
+  // Distinct pairs of file id and region.
+  folly::F14FastSet<std::pair<uint64_t, uint64_t>> regions_;
+  uint64_t memoryBytes_{0};
+  uint64_t ssdBytes_{0};
+};
+
+} // namespace facebook::velox::cache
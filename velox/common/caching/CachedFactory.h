@@ -34,6 +34,8 @@
 #include <glog/logging.h>
 #include "folly/container/F14Set.h"
 
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
 #include "velox/common/caching/SimpleLRUCache.h"
 #include "velox/common/process/TraceContext.h"
 
@@ -42,9 +44,15 @@ namespace facebook::velox {
 // CachedFactory provides a thread-safe way of backing a keyed generator
 // (e.g. the key is filename, and the value is the file data) by a cache.
 //
-// Generator should take a single Key argument and return a Value;
-// The Value should be either a value type or should manage its own lifecycle
-// (shared_ptr). If it is not thread-safe it must do its own internal locking.
+// Generator should take a Key argument, optionally followed by the extra
+// arguments passed to generate(), and return a Value; The Value should be
+// either a value type or should manage its own lifecycle (shared_ptr). If it
+// is not thread-safe it must do its own internal locking.
+//
+// The cache may be split into shards by the hash of the key. Each shard has
+// its own locks, so that lookups of keys in different shards do not contend.
+// Concurrent generates of the same key wait for the first one to finish
+// instead of running the generator again.
 template <typename Key, typename Value, typename Generator>
 class CachedFactory {
  public:
@@ -57,15 +65,35 @@ class CachedFactory {
   CachedFactory(
       std::unique_ptr<SimpleLRUCache<Key, Value>> cache,
       std::unique_ptr<Generator> generator)
-      : cache_(std::move(cache)), generator_(std::move(generator)) {}
+      : generator_(std::move(generator)) {
+    shards_.push_back(std::make_unique<Shard>());
+    shards_.back()->cache = std::move(cache);
+  }
+
+  // Makes a cache of 'maxCacheSize' entries split into 'numShards' shards.
+  // 0 'maxCacheSize' means no limit.
+  CachedFactory(
+      int32_t numShards,
+      size_t maxCacheSize,
+      std::unique_ptr<Generator> generator)
+      : generator_(std::move(generator)) {
+    VELOX_CHECK_GT(numShards, 0);
+    const auto shardSize = bits::roundUp(maxCacheSize, numShards) / numShards;
+    for (auto i = 0; i < numShards; ++i) {
+      shards_.push_back(std::make_unique<Shard>());
+      shards_.back()->cache =
+          std::make_unique<SimpleLRUCache<Key, Value>>(shardSize);
+    }
+  }
 
   // Returns the generator's output on the given key. If the output is
   // in the cache, returns immediately. Otherwise, blocks until the output
-  // is ready.
+  // is ready. 'args' are passed to the generator after 'key' if it runs.
   // The function returns a pair. The boolean in the pair indicates whether a
   // cache hit or miss. The Value is the generator output for the key if cache
   // miss, or Value in the cache if cache hit.
-  std::pair<bool, Value> generate(const Key& key);
+  template <typename... Args>
+  std::pair<bool, Value> generate(const Key& key, const Args&... args);
 
   // Advanced function taking in a group of keys. Separates those keys into
   // one's present in the cache (returning CachedPtrs for them) and those not
@@ -77,40 +105,40 @@ class CachedFactory {
 
   // Total size of elements cached (NOT the maximum size/limit).
   int64_t currentSize() const {
-    if (cache_) {
-      return cache_->currentSize();
-    } else {
-      return 0;
+    int64_t size = 0;
+    for (const auto& shard : shards_) {
+      if (shard->cache) {
+        size += shard->cache->currentSize();
+      }
     }
+    return size;
   }
 
   // The maximum size of the underlying cache.
   int64_t maxSize() const {
-    if (cache_) {
-      return cache_->maxSize();
-    } else {
-      return 0;
+    int64_t size = 0;
+    for (const auto& shard : shards_) {
+      if (shard->cache) {
+        size += shard->cache->maxSize();
+      }
     }
+    return size;
+  }
+
+  int32_t numShards() const {
+    return shards_.size();
   }
 
   SimpleLRUCacheStats cacheStats() {
-    if (cache_) {
-      std::lock_guard l(cacheMu_);
-      return cache_->getStats();
-    } else {
-      return {0, 0, 0, 0};
-    }
+    return sumStats([](auto& cache) { return cache.getStats(); });
   }
 
   // Clear the cache and return the current cache status
   SimpleLRUCacheStats clearCache() {
-    if (cache_) {
-      std::lock_guard l(cacheMu_);
-      cache_->clear();
-      return cache_->getStats();
-    } else {
-      return {0, 0, 0, 0};
-    }
+    return sumStats([](auto& cache) {
+      cache.clear();
+      return cache.getStats();
+    });
   }
 
   // Move allowed, copy disallowed.
@@ -120,13 +148,46 @@ class CachedFactory {
   CachedFactory& operator=(const CachedFactory&) = delete;
 
  private:
-  std::unique_ptr<SimpleLRUCache<Key, Value>> cache_;
-  std::unique_ptr<Generator> generator_;
-  folly::F14FastSet<Key> pending_;
+  struct Shard {
+    std::unique_ptr<SimpleLRUCache<Key, Value>> cache;
+    // Keys being generated.
+    folly::F14FastSet<Key> pending;
+
+    std::mutex cacheMu;
+    std::mutex pendingMu;
+    std::condition_variable pendingCv;
+  };
+
+  Shard& shardFor(const Key& key) {
+    if (shards_.size() == 1) {
+      return *shards_[0];
+    }
+    return *shards_[std::hash<Key>{}(key) % shards_.size()];
+  }
+
+  // Returns the sum of 'getStats' over the caches of all shards.
+  template <typename GetStats>
+  SimpleLRUCacheStats sumStats(GetStats getStats) {
+    size_t maxSize = 0;
+    size_t curSize = 0;
+    size_t numHits = 0;
+    size_t numLookups = 0;
+    for (auto& shard : shards_) {
+      if (!shard->cache) {
+        continue;
+      }
+      std::lock_guard l(shard->cacheMu);
+      const auto stats = getStats(*shard->cache);
+      maxSize += stats.maxSize;
+      curSize += stats.curSize;
+      numHits += stats.numHits;
+      numLookups += stats.numLookups;
+    }
+    return {maxSize, curSize, numHits, numLookups};
+  }
 
-  std::mutex cacheMu_;
-  std::mutex pendingMu_;
-  std::condition_variable pendingCv_;
+  std::unique_ptr<Generator> generator_;
+  std::vector<std::unique_ptr<Shard>> shards_;
 };
 
 //
@@ -134,61 +195,65 @@ class CachedFactory {
 //
 
 template <typename Key, typename Value, typename Generator>
+template <typename... Args>
 std::pair<bool, Value> CachedFactory<Key, Value, Generator>::generate(
-    const Key& key) {
+    const Key& key,
+    const Args&... args) {
   process::TraceContext trace("CachedFactory::generate");
-  if (!cache_) {
-    return std::make_pair(false, (*generator_)(key));
+  auto& shard = shardFor(key);
+  if (!shard.cache) {
+    return std::make_pair(false, (*generator_)(key, args...));
   }
 
-  std::unique_lock<std::mutex> pending_lock(pendingMu_);
+  std::unique_lock<std::mutex> pending_lock(shard.pendingMu);
   {
-    std::lock_guard<std::mutex> cache_lock(cacheMu_);
-    auto value = cache_->get(key);
+    std::lock_guard<std::mutex> cache_lock(shard.cacheMu);
+    auto value = shard.cache->get(key);
     if (value) {
       return std::make_pair(true, value.value());
     }
   }
 
-  if (pending_.contains(key)) {
-    pendingCv_.wait(pending_lock, [&]() { return !pending_.contains(key); });
+  if (shard.pending.contains(key)) {
+    shard.pendingCv.wait(
+        pending_lock, [&]() { return !shard.pending.contains(key); });
     // Will normally hit the cache now.
     {
-      std::lock_guard<std::mutex> cache_lock(cacheMu_);
-      auto value = cache_->get(key);
+      std::lock_guard<std::mutex> cache_lock(shard.cacheMu);
+      auto value = shard.cache->get(key);
       if (value) {
         return std::make_pair(true, value.value());
       }
     }
     pending_lock.unlock();
-    return generate(key); // Regenerate in the edge case.
+    return generate(key, args...); // Regenerate in the edge case.
   } else {
-    pending_.insert(key);
+    shard.pending.insert(key);
     pending_lock.unlock();
     Value generatedValue;
     // TODO: consider using folly/ScopeGuard here.
     try {
-      generatedValue = (*generator_)(key);
+      generatedValue = (*generator_)(key, args...);
     } catch (const std::exception&) {
       {
-        std::lock_guard<std::mutex> pending_lock_2(pendingMu_);
-        pending_.erase(key);
+        std::lock_guard<std::mutex> pending_lock_2(shard.pendingMu);
+        shard.pending.erase(key);
       }
-      pendingCv_.notify_all();
+      shard.pendingCv.notify_all();
       throw;
     }
-    cacheMu_.lock();
-    cache_->add(key, generatedValue);
-    cacheMu_.unlock();
+    shard.cacheMu.lock();
+    shard.cache->add(key, generatedValue);
+    shard.cacheMu.unlock();
 
     // TODO: this code is exception unsafe and can leave pending_ in an
     // inconsistent state. Eventually this code should move to
     // folly:synchronized and rewritten with better primitives.
     {
-      std::lock_guard<std::mutex> pending_lock_2(pendingMu_);
-      pending_.erase(key);
+      std::lock_guard<std::mutex> pending_lock_2(shard.pendingMu);
+      shard.pending.erase(key);
     }
-    pendingCv_.notify_all();
+    shard.pendingCv.notify_all();
     return std::make_pair(false, generatedValue);
   }
 }
@@ -198,18 +263,17 @@ void CachedFactory<Key, Value, Generator>::retrieveCached(
     const std::vector<Key>& keys,
     std::vector<std::pair<Key, Value>>* cached,
     std::vector<Key>* missing) {
-  if (cache_) {
-    std::lock_guard<std::mutex> cache_lock(cacheMu_);
-    for (const Key& key : keys) {
-      auto value = cache_->get(key);
-      if (value) {
-        cached->emplace_back(key, value.value());
-      } else {
-        missing->push_back(key);
-      }
+  for (const Key& key : keys) {
+    auto& shard = shardFor(key);
+    if (!shard.cache) {
+      missing->push_back(key);
+      continue;
     }
-  } else {
-    for (const Key& key : keys) {
+    std::lock_guard<std::mutex> cache_lock(shard.cacheMu);
+    auto value = shard.cache->get(key);
+    if (value) {
+      cached->emplace_back(key, value.value());
+    } else {
       missing->push_back(key);
     }
   }
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::cache {
+
+/// Count-min sketch of access frequencies for TinyLFU cache admission. Keeps
+/// kDepth rows of saturating 4-bit counters. An access increments one counter
+/// per row and the estimated frequency is the minimum of these. All counters
+/// are halved after 10 increments per counter of a row so that the sketch
+/// tracks the recent frequencies. Not thread-safe.
+class FrequencySketch {
+ public:
+  /// 'width' is the number of counters per row and is rounded up to a power
+  /// of 2. It should be in the order of the number of cached entries.
+  explicit FrequencySketch(int32_t width);
+
+  /// Records an access to the key with 'hash'.
+  void increment(uint64_t hash);
+
+  /// Returns the estimated number of recent accesses to the key with 'hash'.
+  int32_t estimate(uint64_t hash) const;
+
+  /// Returns the number of times the counters have been halved.
+  uint64_t numResets() const {
+    return numResets_;
+  }
+
+  static constexpr int32_t kDepth = 4;
+  static constexpr int32_t kMaxCount = 15;
+
+ private:
+  int32_t index(uint64_t hash, int32_t row) const;
+
+  void halve();
+
+  const uint64_t mask_;
+  // Number of increments after which the counters are halved.
+  const uint64_t sampleSize_;
+  // 'kDepth' rows of 'mask_ + 1' counters.
+  std::vector<uint8_t> counters_;
+  uint64_t numIncrements_{0};
+  uint64_t numResets_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -181,6 +181,12 @@ std::string SsdCache::toString() const {
       << (data.bytesRead >> 20) << "MB Size " << (capacity >> 30)
       << "GB Occupied " << (data.bytesCached >> 30) << "GB";
   out << (data.entriesCached >> 10) << "K entries.";
+  if (data.entriesCompressed > 0) {
+    out << " Compressed " << (data.entriesCompressed >> 10)
+        << "K entries. Effective size " << (data.effectiveBytesCached >> 30)
+        << "GB Physical writes " << (data.physicalBytesWritten >> 20)
+        << "MB reads " << (data.physicalBytesRead >> 20) << "MB";
+  }
   out << "\nGroupStats: " << groupStats_->toString(capacity);
   return out.str();
 }
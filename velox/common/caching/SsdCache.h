@@ -55,6 +55,15 @@ class SsdCache {
   /// e.g. FileCacheKey.
   SsdFile& file(uint64_t fileId);
 
+  int32_t numShards() const {
+    return numShards_;
+  }
+
+  /// Returns the shard at 'index', which is less than numShards().
+  SsdFile& shard(int32_t index) {
+    return *files_[index];
+  }
+
   /// Returns the maximum capacity, rounded up from the capacity passed to the
   /// constructor.
   uint64_t maxBytes() const {
@@ -17,8 +17,10 @@
 #include "velox/common/caching/SsdFile.h"
 
 #include <folly/Executor.h>
+#include <folly/io/Cursor.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/BitUtil.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
@@ -36,6 +38,23 @@
 
 DEFINE_bool(ssd_odirect, true, "Use O_DIRECT for SSD cache IO");
 DEFINE_bool(ssd_verify_write, false, "Read back data after writing to SSD");
+DEFINE_bool(
+    ssd_io_uring,
+    false,
+    "Batch SSD cache reads and writes through io_uring if available");
+DEFINE_int32(
+    ssd_io_uring_queue_depth,
+    64,
+    "Max number of in-flight io_uring operations per thread");
+DEFINE_string(
+    ssd_compression,
+    "none",
+    "Compression of SSD cache entries: none, lz4 or zstd");
+DEFINE_int32(
+    ssd_compression_max_pct,
+    90,
+    "Writes an SSD cache entry compressed only if it then takes at most this "
+    "percentage of its uncompressed size");
 
 namespace facebook::velox::cache {
 
@@ -89,6 +108,42 @@ int32_t numIoVectorsFromEntry(AsyncDataCacheEntry& entry) {
   }
   return entry.data().numRuns();
 }
+
+// Returns a codec for 'compression' owned by the calling thread. Codecs keep
+// state between calls and are not thread safe.
+folly::io::Codec& threadCodec(common::CompressionKind compression) {
+  thread_local folly::F14FastMap<int32_t, std::unique_ptr<folly::io::Codec>>
+      codecs;
+  auto& codec = codecs[compression];
+  if (codec == nullptr) {
+    codec = common::compressionKindToCodec(compression);
+  }
+  return *codec;
+}
+
+// Returns the uncompressed data of an entry of 'size' bytes from the 'ssdSize'
+// bytes of 'data' written by SsdFile::compressEntry(). These start with the
+// compressed size.
+std::unique_ptr<folly::IOBuf> decompressEntry(
+    common::CompressionKind compression,
+    const char* data,
+    uint32_t ssdSize,
+    uint64_t size) {
+  uint32_t compressedSize;
+  ::memcpy(&compressedSize, data, sizeof(compressedSize));
+  VELOX_CHECK_LE(
+      compressedSize + sizeof(compressedSize),
+      ssdSize,
+      "IOERR: Corrupt compressed SSD cache entry");
+  const auto input = folly::IOBuf::wrapBufferAsValue(
+      data + sizeof(compressedSize), compressedSize);
+  auto output = threadCodec(compression).uncompress(&input, size);
+  VELOX_CHECK_EQ(
+      output->computeChainDataLength(),
+      size,
+      "IOERR: Compressed SSD cache entry has the wrong size");
+  return output;
+}
 } // namespace
 
 SsdPin::SsdPin(SsdFile& file, SsdRun run) : file_(&file), run_(run) {
@@ -136,10 +191,18 @@ SsdFile::SsdFile(
     : fileName_(filename),
       maxRegions_(maxRegions),
       disableFileCow_(disableFileCow),
+      useIoUring_(FLAGS_ssd_io_uring),
+      compression_(common::stringToCompressionKind(FLAGS_ssd_compression)),
       shardId_(shardId),
       checkpointIntervalBytes_(checkpointIntervalBytes),
       executor_(executor) {
   process::TraceContext trace("SsdFile::SsdFile");
+  VELOX_CHECK(
+      compression_ == common::CompressionKind_NONE ||
+          compression_ == common::CompressionKind_LZ4 ||
+          compression_ == common::CompressionKind_ZSTD,
+      "Unsupported SSD cache compression: {}",
+      FLAGS_ssd_compression);
   int32_t oDirect = 0;
 #ifdef linux
   oDirect = FLAGS_ssd_odirect ? O_DIRECT : 0;
@@ -176,6 +239,7 @@ SsdFile::SsdFile(
   tracker_.resize(maxRegions_);
   regionSizes_.resize(maxRegions_);
   erasedRegionSizes_.resize(maxRegions_);
+  regionEffectiveSizes_.resize(maxRegions_);
   regionPins_.resize(maxRegions_);
   if (checkpointIntervalBytes_) {
     initializeCheckpoint();
@@ -234,40 +298,108 @@ CoalesceIoStats SsdFile::load(
     return CoalesceIoStats();
   }
   int payloadTotal = 0;
+  // Indices of the compressed entries. These are read separately from the
+  // others and decompressed into their pins.
+  std::vector<int32_t> compressedIndices;
   for (auto i = 0; i < pins.size(); ++i) {
-    const auto runSize = ssdPins[i].run().size();
+    const auto& run = ssdPins[i].run();
+    const auto runSize = run.size();
     auto* entry = pins[i].checkedEntry();
-    if (FOLLY_UNLIKELY(runSize < entry->size())) {
-      ++stats_.readSsdErrors;
-      VELOX_FAIL(
-          "IOERR: SSD cache cache entry {} short than requested range {}",
-          succinctBytes(runSize),
-          succinctBytes(entry->size()));
-    }
-    payloadTotal += entry->size();
-    regionRead(regionIndex(ssdPins[i].run().offset()), runSize);
+    if (run.compression() != common::CompressionKind_NONE) {
+      compressedIndices.push_back(i);
+    } else {
+      if (FOLLY_UNLIKELY(runSize < entry->size())) {
+        ++stats_.readSsdErrors;
+        VELOX_FAIL(
+            "IOERR: SSD cache cache entry {} short than requested range {}",
+            succinctBytes(runSize),
+            succinctBytes(entry->size()));
+      }
+      payloadTotal += entry->size();
+    }
+    regionRead(regionIndex(run.offset()), runSize);
     ++stats_.entriesRead;
     stats_.bytesRead += entry->size();
+    stats_.physicalBytesRead += runSize;
   }
 
+  // The pins and SSD offsets of the uncompressed entries.
+  std::vector<CachePin> uncompressedPins;
+  std::vector<uint64_t> offsets;
+  offsets.reserve(pins.size() - compressedIndices.size());
+  if (!compressedIndices.empty()) {
+    uncompressedPins.reserve(offsets.capacity());
+  }
+  for (auto i = 0, next = 0; i < pins.size(); ++i) {
+    if (next < compressedIndices.size() && compressedIndices[next] == i) {
+      ++next;
+      continue;
+    }
+    offsets.push_back(ssdPins[i].run().offset());
+    if (!compressedIndices.empty()) {
+      uncompressedPins.push_back(pins[i]);
+    }
+  }
+  const auto& pinsToRead = compressedIndices.empty() ? pins : uncompressedPins;
+
   // Do coalesced IO for the pins. For short payloads, the break-even between
   // discrete pread calls and a single preadv that discards gaps is ~25K per
   // gap. For longer payloads this is ~50-100K.
-  auto stats = readPins(
-      pins,
-      payloadTotal / pins.size() < 10000 ? 25000 : 50000,
-      // Max ranges in one preadv call. Longest gap + longest cache entry are
-      // under 12 ranges. If a system has a limit of 1K ranges, coalesce limit
-      // of 1000 is safe.
-      900,
-      [&](int32_t index) { return ssdPins[index].run().offset(); },
-      [&](const std::vector<CachePin>& /*pins*/,
-          int32_t /*begin*/,
-          int32_t /*end*/,
-          uint64_t offset,
-          const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
-      });
+  std::vector<SsdIoUring::Read> reads;
+  CoalesceIoStats stats;
+  if (!pinsToRead.empty()) {
+    stats = readPins(
+        pinsToRead,
+        payloadTotal / pinsToRead.size() < 10000 ? 25000 : 50000,
+        // Max ranges in one preadv call. Longest gap + longest cache entry are
+        // under 12 ranges. If a system has a limit of 1K ranges, coalesce
+        // limit of 1000 is safe.
+        900,
+        [&](int32_t index) { return offsets[index]; },
+        [&](const std::vector<CachePin>& /*pins*/,
+            int32_t /*begin*/,
+            int32_t /*end*/,
+            uint64_t offset,
+            const std::vector<folly::Range<char*>>& buffers) {
+          reads.push_back({offset, buffers});
+        });
+  }
+
+  // The compressed entries are read into one aligned buffer in the same batch
+  // and then decompressed into their pins.
+  std::unique_ptr<char, decltype(&::free)> compressedBuffer(nullptr, ::free);
+  if (!compressedIndices.empty()) {
+    uint64_t compressedBytes = 0;
+    for (const auto index : compressedIndices) {
+      compressedBytes += ssdPins[index].run().size();
+    }
+    compressedBuffer.reset(static_cast<char*>(
+        ::aligned_alloc(kCompressedAlignment, compressedBytes)));
+    VELOX_CHECK_NOT_NULL(compressedBuffer);
+    auto* data = compressedBuffer.get();
+    for (const auto index : compressedIndices) {
+      const auto& run = ssdPins[index].run();
+      reads.push_back({run.offset(), {folly::Range<char*>(data, run.size())}});
+      data += run.size();
+    }
+  }
+  read(reads);
+
+  auto* data = compressedBuffer.get();
+  for (const auto index : compressedIndices) {
+    const auto& run = ssdPins[index].run();
+    auto* entry = pins[index].checkedEntry();
+    const auto uncompressed =
+        decompressEntry(run.compression(), data, run.size(), entry->size());
+    // Scatters the uncompressed data into the allocation of the entry.
+    std::vector<iovec> iovecs;
+    addEntryToIovecs(*entry, iovecs);
+    folly::io::Cursor cursor(uncompressed.get());
+    for (const auto& iov : iovecs) {
+      cursor.pull(iov.iov_base, iov.iov_len);
+    }
+    data += run.size();
+  }
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
@@ -282,8 +414,20 @@ void SsdFile::read(
   readFile_->preadv(offset, buffers);
 }
 
+void SsdFile::read(const std::vector<SsdIoUring::Read>& reads) {
+  if (useIoUring_) {
+    process::TraceContext trace("SsdFile::readIoUring");
+    if (SsdIoUring::read(fd_, reads)) {
+      return;
+    }
+  }
+  for (const auto& read : reads) {
+    this->read(read.offset, read.buffers);
+  }
+}
+
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
-    const std::vector<CachePin>& pins,
+    const std::vector<int32_t>& sizes,
     int32_t begin) {
   int32_t next = begin;
   std::lock_guard<std::shared_mutex> l(mutex_);
@@ -298,13 +442,12 @@ std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     const auto offset = regionSizes_[region];
     auto available = kRegionSize - offset;
     int64_t toWrite = 0;
-    for (; next < pins.size(); ++next) {
-      auto* entry = pins[next].checkedEntry();
-      if (entry->size() > available) {
+    for (; next < sizes.size(); ++next) {
+      if (sizes[next] > available) {
         break;
       }
-      available -= entry->size();
-      toWrite += entry->size();
+      available -= sizes[next];
+      toWrite += sizes[next];
     }
     if (toWrite > 0) {
       // At least some pins got space from this region. If the region is full
@@ -329,6 +472,7 @@ bool SsdFile::growOrEvictLocked() {
       writableRegions_.push_back(numRegions_);
       regionSizes_[numRegions_] = 0;
       erasedRegionSizes_[numRegions_] = 0;
+      regionEffectiveSizes_[numRegions_] = 0;
       ++numRegions_;
       return true;
     }
@@ -371,6 +515,7 @@ void SsdFile::clearRegionEntriesLocked(const std::vector<int32_t>& regions) {
     tracker_.regionCleared(region);
     regionSizes_[region] = 0;
     erasedRegionSizes_[region] = 0;
+    regionEffectiveSizes_[region] = 0;
   }
 }
 
@@ -384,9 +529,22 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     VELOX_CHECK_NULL(entry->ssdFile());
   }
 
+  // The sizes of the entries on SSD and the data of the entries that are
+  // written compressed.
+  std::vector<int32_t> ssdSizes(pins.size());
+  std::vector<std::unique_ptr<folly::IOBuf>> compressed(pins.size());
+  for (auto i = 0; i < pins.size(); ++i) {
+    auto* entry = pins[i].checkedEntry();
+    if (compression_ != common::CompressionKind_NONE) {
+      compressed[i] = compressEntry(*entry);
+    }
+    ssdSizes[i] =
+        compressed[i] != nullptr ? compressed[i]->length() : entry->size();
+  }
+
   int32_t writeIndex = 0;
   while (writeIndex < pins.size()) {
-    const auto space = getSpace(pins, writeIndex);
+    const auto space = getSpace(ssdSizes, writeIndex);
     if (!space.has_value()) {
       // No space can be reclaimed. The pins are freed when the caller is freed.
       return;
@@ -397,18 +555,16 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     uint64_t writeOffset = offset;
     int32_t writeLength = 0;
     std::vector<iovec> writeIovecs;
+    std::vector<SsdIoUring::Write> writes;
     for (auto i = writeIndex; i < pins.size(); ++i) {
       auto* entry = pins[i].checkedEntry();
-      const auto entrySize = entry->size();
-      const auto numIovecs = numIoVectorsFromEntry(*entry);
+      const auto entrySize = ssdSizes[i];
+      const auto numIovecs =
+          compressed[i] != nullptr ? 1 : numIoVectorsFromEntry(*entry);
       VELOX_CHECK_LE(numIovecs, IOV_MAX);
       if (writeIovecs.size() + numIovecs > IOV_MAX) {
-        // Writes out the accumulated iovecs if it exceeds IOV_MAX limit.
-        if (!write(writeOffset, writeLength, writeIovecs)) {
-          // If write fails, we return without adding the pins to the cache. The
-          // entries are unchanged.
-          return;
-        }
+        // Starts a new write if the accumulated iovecs exceed IOV_MAX limit.
+        writes.push_back({writeOffset, writeLength, std::move(writeIovecs)});
         writeIovecs.clear();
         writeOffset += writeLength;
         writeLength = 0;
@@ -416,19 +572,26 @@ void SsdFile::write(std::vector<CachePin>& pins) {
       if (writeLength + entrySize > available) {
         break;
       }
-      addEntryToIovecs(*entry, writeIovecs);
+      if (compressed[i] != nullptr) {
+        writeIovecs.push_back(
+            {compressed[i]->writableData(), compressed[i]->length()});
+      } else {
+        addEntryToIovecs(*entry, writeIovecs);
+      }
       writeLength += entrySize;
       ++numWrittenEntries;
     }
     if (writeLength > 0) {
       VELOX_CHECK(!writeIovecs.empty());
-      if (!write(writeOffset, writeLength, writeIovecs)) {
-        return;
-      }
-      writeIovecs.clear();
+      writes.push_back({writeOffset, writeLength, std::move(writeIovecs)});
       writeOffset += writeLength;
       writeLength = 0;
     }
+    if (!write(writes)) {
+      // If write fails, we return without adding the pins to the cache. The
+      // entries are unchanged.
+      return;
+    }
     VELOX_CHECK_GE(fileSize_, writeOffset);
 
     {
@@ -436,16 +599,26 @@ void SsdFile::write(std::vector<CachePin>& pins) {
       for (auto i = writeIndex; i < writeIndex + numWrittenEntries; ++i) {
         auto* entry = pins[i].checkedEntry();
         entry->setSsdFile(this, offset);
-        const auto size = entry->size();
+        const auto size = ssdSizes[i];
+        const SsdRun run(
+            offset,
+            size,
+            compressed[i] != nullptr ? compression_
+                                     : common::CompressionKind_NONE);
         FileCacheKey key = {
             entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
-        entries_[std::move(key)] = SsdRun(offset, size);
+        entries_[std::move(key)] = run;
         if (FLAGS_ssd_verify_write) {
-          verifyWrite(*entry, SsdRun(offset, size));
+          verifyWrite(*entry, run);
         }
+        regionEffectiveSizes_[regionIndex(offset)] += entry->size();
         offset += size;
         ++stats_.entriesWritten;
-        stats_.bytesWritten += size;
+        stats_.bytesWritten += entry->size();
+        stats_.physicalBytesWritten += size;
+        if (compressed[i] != nullptr) {
+          ++stats_.entriesCompressed;
+        }
         bytesAfterCheckpoint_ += size;
       }
     }
@@ -475,8 +648,30 @@ bool SsdFile::write(
   return false;
 }
 
+bool SsdFile::write(const std::vector<SsdIoUring::Write>& writes) {
+  int32_t error = 0;
+  if (useIoUring_ && SsdIoUring::write(fd_, writes, error)) {
+    if (error == 0) {
+      return true;
+    }
+    VELOX_SSD_CACHE_LOG(ERROR)
+        << "Failed to write to SSD with io_uring, file name: " << fileName_
+        << ", fd: " << fd_ << ", writes: " << writes.size()
+        << ", error code: " << error
+        << ", error string: " << folly::errnoStr(error);
+    ++stats_.writeSsdErrors;
+    return false;
+  }
+  for (const auto& write : writes) {
+    if (!this->write(write.offset, write.length, write.iovecs)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 namespace {
-int32_t indexOfFirstMismatch(char* x, char* y, int n) {
+int32_t indexOfFirstMismatch(const char* x, const char* y, int n) {
   for (auto i = 0; i < n; ++i) {
     if (x[i] != y[i]) {
       return i;
@@ -486,13 +681,65 @@ int32_t indexOfFirstMismatch(char* x, char* y, int n) {
 }
 } // namespace
 
+std::unique_ptr<folly::IOBuf> SsdFile::compressEntry(
+    AsyncDataCacheEntry& entry) {
+  std::vector<iovec> iovecs;
+  addEntryToIovecs(entry, iovecs);
+  std::unique_ptr<folly::IOBuf> input;
+  for (const auto& iov : iovecs) {
+    auto buffer = folly::IOBuf::wrapBuffer(iov.iov_base, iov.iov_len);
+    if (input == nullptr) {
+      input = std::move(buffer);
+    } else {
+      input->prependChain(std::move(buffer));
+    }
+  }
+  const auto output = threadCodec(compression_).compress(input.get());
+  const uint32_t compressedSize = output->computeChainDataLength();
+  const auto ssdSize = bits::roundUp(
+      sizeof(compressedSize) + compressedSize, kCompressedAlignment);
+  if (ssdSize * 100 > entry.size() * FLAGS_ssd_compression_max_pct) {
+    return nullptr;
+  }
+  // The buffer is aligned for O_DIRECT. The padding is zeroed so that no
+  // uninitialized memory is written to SSD.
+  auto* data =
+      static_cast<char*>(::aligned_alloc(kCompressedAlignment, ssdSize));
+  VELOX_CHECK_NOT_NULL(data);
+  auto result = folly::IOBuf::takeOwnership(
+      data, ssdSize, [](void* buffer, void* /*userData*/) { ::free(buffer); });
+  ::memcpy(data, &compressedSize, sizeof(compressedSize));
+  folly::io::Cursor(output.get())
+      .pull(data + sizeof(compressedSize), compressedSize);
+  ::memset(
+      data + sizeof(compressedSize) + compressedSize,
+      0,
+      ssdSize - sizeof(compressedSize) - compressedSize);
+  return result;
+}
+
 void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   process::TraceContext trace("SsdFile::verifyWrite");
-  auto testData = std::make_unique<char[]>(entry.size());
-  const auto rc = ::pread(fd_, testData.get(), entry.size(), ssdRun.offset());
-  VELOX_CHECK_EQ(rc, entry.size());
+  std::unique_ptr<char, decltype(&::free)> readData(
+      static_cast<char*>(::aligned_alloc(
+          kCompressedAlignment,
+          bits::roundUp(ssdRun.size(), kCompressedAlignment))),
+      ::free);
+  const auto rc = ::pread(fd_, readData.get(), ssdRun.size(), ssdRun.offset());
+  VELOX_CHECK_EQ(rc, ssdRun.size());
+  // The uncompressed data of a compressed entry.
+  std::unique_ptr<folly::IOBuf> uncompressed;
+  const char* testData = readData.get();
+  if (ssdRun.compression() != common::CompressionKind_NONE) {
+    uncompressed = decompressEntry(
+        ssdRun.compression(), readData.get(), ssdRun.size(), entry.size());
+    uncompressed->coalesce();
+    testData = reinterpret_cast<const char*>(uncompressed->data());
+  } else {
+    VELOX_CHECK_EQ(ssdRun.size(), entry.size());
+  }
   if (entry.tinyData() != nullptr) {
-    if (::memcmp(testData.get(), entry.tinyData(), entry.size()) != 0) {
+    if (::memcmp(testData, entry.tinyData(), entry.size()) != 0) {
       VELOX_FAIL("bad read back");
     }
   } else {
@@ -503,7 +750,7 @@ void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
       const auto run = data.runAt(i);
       const auto compareSize = std::min<int64_t>(bytesLeft, run.numBytes());
       auto badIndex = indexOfFirstMismatch(
-          run.data<char>(), testData.get() + offset, compareSize);
+          run.data<char>(), testData + offset, compareSize);
       if (badIndex != -1) {
         VELOX_FAIL("Bad read back");
       }
@@ -516,20 +763,74 @@ void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   }
 }
 
+std::vector<std::pair<FileCacheKey, int32_t>> SsdFile::hottestEntries(
+    uint64_t maxBytes) const {
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  // The uncompressed entries of each region.
+  std::vector<std::vector<std::pair<SsdRun, const FileCacheKey*>>>
+      regionEntries(numRegions_);
+  for (const auto& [key, run] : entries_) {
+    const auto region = regionIndex(run.offset());
+    if (run.compression() == common::CompressionKind_NONE &&
+        region < numRegions_) {
+      regionEntries[region].emplace_back(run, &key);
+    }
+  }
+  const auto scores = tracker_.copyScores();
+  std::vector<int32_t> regions(numRegions_);
+  std::iota(regions.begin(), regions.end(), 0);
+  std::stable_sort(regions.begin(), regions.end(), [&](auto left, auto right) {
+    return scores[left] > scores[right];
+  });
+
+  std::vector<std::pair<FileCacheKey, int32_t>> hottest;
+  uint64_t bytes = 0;
+  for (const auto region : regions) {
+    auto& entries = regionEntries[region];
+    std::sort(entries.begin(), entries.end(), [](auto& left, auto& right) {
+      return left.first.offset() < right.first.offset();
+    });
+    for (const auto& [run, key] : entries) {
+      if (bytes + run.size() > maxBytes) {
+        return hottest;
+      }
+      hottest.emplace_back(*key, run.size());
+      bytes += run.size();
+    }
+  }
+  return hottest;
+}
+
+void SsdFile::addResidency(CacheResidencyBuilder& builder) const {
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  for (const auto& [key, run] : entries_) {
+    builder.add(key.fileNum.id(), key.offset, run.size(), true);
+  }
+}
+
 void SsdFile::updateStats(SsdCacheStats& stats) const {
   // Lock only in tsan build. Incrementing the counters has no synchronized
   // semantics.
   std::shared_lock<std::shared_mutex> l(mutex_);
   stats.entriesWritten += stats_.entriesWritten;
   stats.bytesWritten += stats_.bytesWritten;
+  stats.physicalBytesWritten += stats_.physicalBytesWritten;
+  stats.entriesCompressed += stats_.entriesCompressed;
   stats.checkpointsWritten += stats_.checkpointsWritten;
   stats.entriesRead += stats_.entriesRead;
   stats.bytesRead += stats_.bytesRead;
+  stats.physicalBytesRead += stats_.physicalBytesRead;
   stats.checkpointsRead += stats_.checkpointsRead;
   stats.entriesCached += entries_.size();
   stats.regionsCached += numRegions_;
   for (auto i = 0; i < numRegions_; i++) {
-    stats.bytesCached += (regionSizes_[i] - erasedRegionSizes_[i]);
+    const uint64_t liveBytes = regionSizes_[i] - erasedRegionSizes_[i];
+    stats.bytesCached += liveBytes;
+    // Assumes the erased entries compressed like the region on average.
+    if (regionSizes_[i] > 0) {
+      stats.effectiveBytesCached +=
+          liveBytes * regionEffectiveSizes_[i] / regionSizes_[i];
+    }
   }
   stats.entriesAgedOut += stats_.entriesAgedOut;
   stats.regionsAgedOut += stats_.regionsAgedOut;
@@ -554,6 +855,7 @@ void SsdFile::clear() {
   entries_.clear();
   std::fill(regionSizes_.begin(), regionSizes_.end(), 0);
   std::fill(erasedRegionSizes_.begin(), erasedRegionSizes_.end(), 0);
+  std::fill(regionEffectiveSizes_.begin(), regionEffectiveSizes_.end(), 0);
   writableRegions_.resize(numRegions_);
   std::iota(writableRegions_.begin(), writableRegions_.end(), 0);
 }
@@ -18,27 +18,40 @@
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFileTracker.h"
+#include "velox/common/caching/SsdIoUring.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
 
+#include <folly/io/IOBuf.h>
 #include <gflags/gflags.h>
 
 DECLARE_bool(ssd_odirect);
 DECLARE_bool(ssd_verify_write);
+DECLARE_bool(ssd_io_uring);
+DECLARE_int32(ssd_io_uring_queue_depth);
+DECLARE_string(ssd_compression);
+DECLARE_int32(ssd_compression_max_pct);
 
 namespace facebook::velox::cache {
 
 // A 64 bit word describing a SSD cache entry in an SsdFile. The low
-// 23 bits are the size, for a maximum entry size of 8MB. The high
-// bits are the offset.
+// 23 bits are the size, for a maximum entry size of 8MB. The next 2
+// bits are the compression of the entry. The high bits are the offset.
 class SsdRun {
  public:
   static constexpr int32_t kSizeBits = 23;
+  static constexpr int32_t kCompressionBits = 2;
 
   SsdRun() : bits_(0) {}
 
-  SsdRun(uint64_t offset, uint32_t size)
-      : bits_((offset << kSizeBits) | ((size - 1))) {
-    VELOX_CHECK_LT(offset, 1L << (64 - kSizeBits));
+  SsdRun(
+      uint64_t offset,
+      uint32_t size,
+      common::CompressionKind compression = common::CompressionKind_NONE)
+      : bits_(
+            (offset << (kSizeBits + kCompressionBits)) |
+            (compressionCode(compression) << kSizeBits) | ((size - 1))) {
+    VELOX_CHECK_LT(offset, 1L << (64 - kSizeBits - kCompressionBits));
     VELOX_CHECK_LT(size - 1, 1 << kSizeBits);
   }
 
@@ -55,19 +68,47 @@ class SsdRun {
   }
 
   uint64_t offset() const {
-    return (bits_ >> kSizeBits);
+    return (bits_ >> (kSizeBits + kCompressionBits));
   }
 
+  // Returns the bytes taken on SSD. This is less than the entry size if the
+  // entry is compressed.
   uint32_t size() const {
     return (bits_ & ((1 << kSizeBits) - 1)) + 1;
   }
 
+  common::CompressionKind compression() const {
+    switch ((bits_ >> kSizeBits) & ((1 << kCompressionBits) - 1)) {
+      case 1:
+        return common::CompressionKind_LZ4;
+      case 2:
+        return common::CompressionKind_ZSTD;
+      default:
+        return common::CompressionKind_NONE;
+    }
+  }
+
   // Returns raw bits for serialization.
   uint64_t bits() const {
     return bits_;
   }
 
  private:
+  static uint64_t compressionCode(common::CompressionKind compression) {
+    switch (compression) {
+      case common::CompressionKind_NONE:
+        return 0;
+      case common::CompressionKind_LZ4:
+        return 1;
+      case common::CompressionKind_ZSTD:
+        return 2;
+      default:
+        VELOX_UNSUPPORTED(
+            "Unsupported SSD cache compression: {}",
+            common::compressionKindToString(compression));
+    }
+  }
+
   uint64_t bits_;
 };
 
@@ -129,13 +170,17 @@ struct SsdCacheStats {
   void operator=(const SsdCacheStats& other) {
     entriesWritten = tsanAtomicValue(other.entriesWritten);
     bytesWritten = tsanAtomicValue(other.bytesWritten);
+    physicalBytesWritten = tsanAtomicValue(other.physicalBytesWritten);
+    entriesCompressed = tsanAtomicValue(other.entriesCompressed);
     checkpointsWritten = tsanAtomicValue(other.checkpointsWritten);
     entriesRead = tsanAtomicValue(other.entriesRead);
     bytesRead = tsanAtomicValue(other.bytesRead);
+    physicalBytesRead = tsanAtomicValue(other.physicalBytesRead);
     checkpointsRead = tsanAtomicValue(other.checkpointsRead);
     entriesCached = tsanAtomicValue(other.entriesCached);
     regionsCached = tsanAtomicValue(other.regionsCached);
     bytesCached = tsanAtomicValue(other.bytesCached);
+    effectiveBytesCached = tsanAtomicValue(other.effectiveBytesCached);
     entriesAgedOut = tsanAtomicValue(other.entriesAgedOut);
     regionsAgedOut = tsanAtomicValue(other.regionsAgedOut);
     regionsEvicted = tsanAtomicValue(other.regionsEvicted);
@@ -153,14 +198,25 @@ struct SsdCacheStats {
   }
 
   tsan_atomic<uint64_t> entriesWritten{0};
+  // Uncompressed size of the entries written.
   tsan_atomic<uint64_t> bytesWritten{0};
+  // Bytes written to SSD, i.e. after compression.
+  tsan_atomic<uint64_t> physicalBytesWritten{0};
+  // Number of entries written compressed.
+  tsan_atomic<uint64_t> entriesCompressed{0};
   tsan_atomic<uint64_t> checkpointsWritten{0};
   tsan_atomic<uint64_t> entriesRead{0};
+  // Uncompressed size of the entries read.
   tsan_atomic<uint64_t> bytesRead{0};
+  // Bytes read from SSD, i.e. before decompression.
+  tsan_atomic<uint64_t> physicalBytesRead{0};
   tsan_atomic<uint64_t> checkpointsRead{0};
   tsan_atomic<uint64_t> entriesCached{0};
   tsan_atomic<uint64_t> regionsCached{0};
+  // Bytes taken on SSD by the cached entries.
   tsan_atomic<uint64_t> bytesCached{0};
+  // Estimated uncompressed size of the cached entries.
+  tsan_atomic<uint64_t> effectiveBytesCached{0};
   tsan_atomic<uint64_t> entriesAgedOut{0};
   tsan_atomic<uint64_t> regionsAgedOut{0};
   tsan_atomic<uint64_t> regionsEvicted{0};
@@ -251,6 +307,19 @@ class SsdFile {
   // Adds 'stats_' to 'stats'.
   void updateStats(SsdCacheStats& stats) const;
 
+  /// Returns the keys and sizes of the entries in the regions with the highest
+  /// access scores, up to 'maxBytes' in total. The hottest region comes first
+  /// and the entries of a region are in file order. The scores survive restart
+  /// with the checkpoint, so this tells what to warm up the memory cache with.
+  /// Compressed entries are skipped since their size in memory is not known
+  /// before reading them.
+  std::vector<std::pair<FileCacheKey, int32_t>> hottestEntries(
+      uint64_t maxBytes) const;
+
+  /// Adds the ranges of the entries in 'this' to 'builder'. A compressed entry
+  /// is recorded with its size on SSD, which covers at least its first region.
+  void addResidency(CacheResidencyBuilder& builder) const;
+
   // Resets this' to a post-construction empty state. See SsdCache::clear().
   void clear();
 
@@ -282,7 +351,7 @@ class SsdFile {
  private:
   // 4 first bytes of a checkpoint file. Allows distinguishing between format
   // versions.
-  static constexpr const char* kCheckpointMagic = "CPT1";
+  static constexpr const char* kCheckpointMagic = "CPT2";
   // Magic number separating file names from cache entry data in checkpoint
   // file.
   static constexpr int64_t kCheckpointMapMarker = 0xfffffffffffffffe;
@@ -291,6 +360,10 @@ class SsdFile {
 
   static constexpr int kMaxErasedSizePct = 50;
 
+  // Compressed entries take a multiple of this many bytes on SSD so that
+  // their offsets and sizes stay aligned for O_DIRECT.
+  static constexpr int32_t kCompressedAlignment = 4096;
+
   // Increments the pin count of the region of 'offset'. Caller must hold
   // 'mutex_'.
   void pinRegionLocked(uint64_t offset) {
@@ -298,13 +371,19 @@ class SsdFile {
   }
 
   // Returns [offset, size] of contiguous space for storing data of a number of
-  // contiguous 'pins' starting with the pin at index 'begin'.  Returns nullopt
-  // if there is no space. The space does not necessarily cover all the pins, so
-  // multiple calls starting at the first unwritten pin may be needed.
+  // contiguous entries of 'sizes' bytes starting with the entry at index
+  // 'begin'.  Returns nullopt if there is no space. The space does not
+  // necessarily cover all the entries, so multiple calls starting at the first
+  // unwritten entry may be needed.
   std::optional<std::pair<uint64_t, int32_t>> getSpace(
-      const std::vector<CachePin>& pins,
+      const std::vector<int32_t>& sizes,
       int32_t begin);
 
+  // Returns 'entry' compressed with 'compression_' and padded to a multiple of
+  // kCompressedAlignment bytes, or nullptr if that does not take at most
+  // 'ssd_compression_max_pct' percent of the entry size.
+  std::unique_ptr<folly::IOBuf> compressEntry(AsyncDataCacheEntry& entry);
+
   // Removes all 'entries_' that reference data in regions described by
   // 'regionIndices'.
   void clearRegionEntriesLocked(const std::vector<int32_t>& regions);
@@ -316,6 +395,10 @@ class SsdFile {
   // Reads the backing file with ReadFile::preadv().
   void read(uint64_t offset, const std::vector<folly::Range<char*>>& buffers);
 
+  // Reads 'reads' in one io_uring batch if 'useIoUring_' and io_uring is
+  // available on the calling thread, otherwise with read() one by one.
+  void read(const std::vector<SsdIoUring::Read>& reads);
+
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
@@ -344,6 +427,11 @@ class SsdFile {
   bool
   write(uint64_t offset, uint64_t length, const std::vector<iovec>& iovecs);
 
+  // Writes 'writes' in one io_uring batch if 'useIoUring_' and io_uring is
+  // available on the calling thread, otherwise with write() one by one.
+  // Returns true if all writes succeed.
+  bool write(const std::vector<SsdIoUring::Write>& writes);
+
   // Synchronously logs that 'regions' are no longer valid in a possibly xisting
   // checkpoint.
   void logEviction(const std::vector<int32_t>& regions);
@@ -360,6 +448,14 @@ class SsdFile {
   // True if copy on write should be disabled.
   const bool disableFileCow_;
 
+  // True if reads and writes of cache entries are batched through io_uring.
+  // Set from 'ssd_io_uring' at construction.
+  const bool useIoUring_;
+
+  // Compression for new entries, set from 'ssd_compression' at construction.
+  // Entries that do not compress well are written uncompressed.
+  const common::CompressionKind compression_;
+
   // Serializes access to all private data members.
   mutable std::shared_mutex mutex_;
 
@@ -381,6 +477,10 @@ class SsdFile {
 
   std::vector<uint32_t> erasedRegionSizes_;
 
+  // Uncompressed size of the entries written to each region. Used for
+  // estimating the uncompressed size of the cached entries.
+  std::vector<uint64_t> regionEffectiveSizes_;
+
   // Indices of regions available for writing new entries.
   std::vector<int32_t> writableRegions_;
 
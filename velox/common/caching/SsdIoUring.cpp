@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/SsdIoUring.h"
+
+#include <folly/String.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/file/IoUring.h"
+
+#include <climits>
+#include <memory>
+
+DECLARE_int32(ssd_io_uring_queue_depth);
+
+namespace facebook::velox::cache {
+
+#ifdef VELOX_ENABLE_IO_URING
+namespace {
+
+// One readv or writev submitted to a ring.
+struct IoOp {
+  uint64_t offset;
+  uint64_t length;
+  std::vector<iovec> iovecs;
+};
+
+// An io_uring owned by one thread.
+class ThreadRing {
+ public:
+  explicit ThreadRing(int32_t queueDepth)
+      : ring_(IoUring::create(queueDepth, "[SSD] ")),
+        usable_(ring_ != nullptr) {}
+
+  bool usable() const {
+    return usable_;
+  }
+
+  // Runs 'ops' on 'fd' in batches of at most the queue depth of the ring.
+  // Returns 0 on success or a negative errno of the first failed op, -EIO for
+  // a short transfer.
+  int32_t run(int32_t fd, bool isWrite, const std::vector<IoOp>& ops) {
+    const auto queueDepth = ring_->queueDepth();
+    int32_t error = 0;
+    for (size_t begin = 0; begin < ops.size(); begin += queueDepth) {
+      const auto end = std::min<size_t>(ops.size(), begin + queueDepth);
+      for (auto i = begin; i < end; ++i) {
+        const auto& op = ops[i];
+        VELOX_CHECK(ring_->prepare(
+            isWrite,
+            fd,
+            op.iovecs.data(),
+            op.iovecs.size(),
+            op.offset,
+            const_cast<IoOp*>(&op)));
+      }
+
+      const int32_t numOps = end - begin;
+      int32_t numSubmitted = 0;
+      while (numSubmitted < numOps) {
+        const auto rc = ring_->submit();
+        if (rc <= 0) {
+          // The unsubmitted entries stay queued in the ring, so the ring can
+          // not be reused. Reaps what was submitted and retires the ring.
+          usable_ = false;
+          reap(numSubmitted, error);
+          return rc < 0 ? rc : -EIO;
+        }
+        numSubmitted += rc;
+      }
+      reap(numOps, error);
+      if (!usable_) {
+        return error;
+      }
+    }
+    return error;
+  }
+
+ private:
+  // Waits for 'numOps' completions and sets 'error' from the first failure.
+  // Retires the ring if waiting fails.
+  void reap(int32_t numOps, int32_t& error) {
+    for (auto i = 0; i < numOps; ++i) {
+      void* data;
+      int32_t result;
+      const auto rc = ring_->wait(data, result);
+      if (rc < 0) {
+        LOG(ERROR) << "[SSD] io_uring_wait_cqe failed: "
+                   << folly::errnoStr(-rc);
+        usable_ = false;
+        if (error == 0) {
+          error = rc;
+        }
+        return;
+      }
+      const auto* op = static_cast<const IoOp*>(data);
+      if (error == 0) {
+        if (result < 0) {
+          error = result;
+        } else if (static_cast<uint64_t>(result) != op->length) {
+          error = -EIO;
+        }
+      }
+    }
+  }
+
+  const std::unique_ptr<IoUring> ring_;
+  bool usable_;
+};
+
+// Returns the ring of the calling thread or nullptr if io_uring can not be
+// used.
+ThreadRing* threadRing() {
+  thread_local std::unique_ptr<ThreadRing> ring;
+  if (ring == nullptr) {
+    ring = std::make_unique<ThreadRing>(FLAGS_ssd_io_uring_queue_depth);
+  }
+  return ring->usable() ? ring.get() : nullptr;
+}
+} // namespace
+
+// static
+bool SsdIoUring::available() {
+  return threadRing() != nullptr;
+}
+
+// static
+bool SsdIoUring::read(int32_t fd, const std::vector<Read>& reads) {
+  auto* ring = threadRing();
+  if (ring == nullptr) {
+    return false;
+  }
+  // Splits each read into readv ops at the gaps and at IOV_MAX buffers.
+  std::vector<IoOp> ops;
+  for (const auto& read : reads) {
+    auto offset = read.offset;
+    IoOp op{offset, 0, {}};
+    for (const auto& buffer : read.buffers) {
+      if (buffer.data() == nullptr || op.iovecs.size() == IOV_MAX) {
+        if (!op.iovecs.empty()) {
+          ops.push_back(std::move(op));
+        }
+        op = IoOp{offset, 0, {}};
+      }
+      if (buffer.data() != nullptr) {
+        op.iovecs.push_back({buffer.data(), buffer.size()});
+        op.length += buffer.size();
+      } else {
+        op.offset += buffer.size();
+      }
+      offset += buffer.size();
+    }
+    if (!op.iovecs.empty()) {
+      ops.push_back(std::move(op));
+    }
+  }
+  const auto rc = ring->run(fd, false, ops);
+  VELOX_CHECK_EQ(
+      rc, 0, "IOERR: io_uring read from SSD failed: {}", folly::errnoStr(-rc));
+  return true;
+}
+
+// static
+bool SsdIoUring::write(
+    int32_t fd,
+    const std::vector<Write>& writes,
+    int32_t& error) {
+  auto* ring = threadRing();
+  if (ring == nullptr) {
+    return false;
+  }
+  std::vector<IoOp> ops;
+  ops.reserve(writes.size());
+  for (const auto& write : writes) {
+    VELOX_CHECK_LE(write.iovecs.size(), IOV_MAX);
+    ops.push_back({write.offset, write.length, write.iovecs});
+  }
+  error = -ring->run(fd, true, ops);
+  return true;
+}
+
+#else
+
+// static
+bool SsdIoUring::available() {
+  return false;
+}
+
+// static
+bool SsdIoUring::read(int32_t /*fd*/, const std::vector<Read>& /*reads*/) {
+  return false;
+}
+
+// static
+bool SsdIoUring::write(
+    int32_t /*fd*/,
+    const std::vector<Write>& /*writes*/,
+    int32_t& /*error*/) {
+  return false;
+}
+
+#endif // VELOX_ENABLE_IO_URING
+} // namespace facebook::velox::cache
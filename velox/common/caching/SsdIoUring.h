@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/portability/SysUio.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::cache {
+
+/// Batched SSD cache file IO through io_uring. Each thread submits to its own
+/// lazily created ring, so concurrent callers do not contend and a batch of
+/// reads or writes costs one system call instead of one per range. Usable
+/// only if built with VELOX_ENABLE_IO_URING and supported by the kernel.
+/// Callers fall back to pread/pwrite when a call returns false.
+class SsdIoUring {
+ public:
+  /// A read of consecutive 'buffers' starting at 'offset'. A buffer with
+  /// nullptr data is a gap whose bytes are skipped, as in ReadFile::preadv().
+  struct Read {
+    uint64_t offset;
+    std::vector<folly::Range<char*>> buffers;
+  };
+
+  /// A write of 'length' bytes from 'iovecs' at 'offset'.
+  struct Write {
+    uint64_t offset;
+    uint64_t length;
+    std::vector<iovec> iovecs;
+  };
+
+  /// Returns true if io_uring can be used on the calling thread.
+  static bool available();
+
+  /// Reads 'reads' from 'fd' in batches of up to 'ssd_io_uring_queue_depth'
+  /// operations. Returns false without doing any IO if io_uring is not
+  /// available on the calling thread. Throws if a read fails or is short.
+  static bool read(int32_t fd, const std::vector<Read>& reads);
+
+  /// Writes 'writes' to 'fd' like read(). Returns false without doing any IO
+  /// if io_uring is not available on the calling thread. Otherwise sets
+  /// 'error' to 0 if all writes succeed or to the errno of the first failed
+  /// write, EIO for a short write, and returns true.
+  static bool
+  write(int32_t fd, const std::vector<Write>& writes, int32_t& error);
+};
+
+} // namespace facebook::velox::cache
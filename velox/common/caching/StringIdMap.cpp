@@ -18,8 +18,33 @@
 
 namespace facebook::velox {
 
+namespace {
+// Increments 'count' unless it is 0. Returns true if incremented.
+bool incrementIfInUse(std::atomic<uint32_t>& count) {
+  auto value = count.load();
+  while (value > 0) {
+    if (count.compare_exchange_weak(value, value + 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Decrements 'count' unless this would make it 0. Returns true if
+// decremented.
+bool decrementIfNotLast(std::atomic<uint32_t>& count) {
+  auto value = count.load();
+  while (value > 1) {
+    if (count.compare_exchange_weak(value, value - 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
 uint64_t StringIdMap::id(std::string_view string) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::shared_lock<folly::SharedMutex> l(mutex_);
   auto it = stringToId_.find(string);
   if (it != stringToId_.end()) {
     return it->second;
@@ -28,11 +53,18 @@ uint64_t StringIdMap::id(std::string_view string) {
 }
 
 void StringIdMap::release(uint64_t id) {
-  std::lock_guard<std::mutex> l(mutex_);
+  {
+    std::shared_lock<folly::SharedMutex> l(mutex_);
+    auto it = idToString_.find(id);
+    if (it == idToString_.end() || decrementIfNotLast(it->second.numInUse)) {
+      return;
+    }
+  }
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   auto it = idToString_.find(id);
   if (it != idToString_.end()) {
     VELOX_CHECK_LT(
-        0, it->second.numInUse, "Extra release of id in StringIdMap");
+        0, it->second.numInUse.load(), "Extra release of id in StringIdMap");
     if (--it->second.numInUse == 0) {
       pinnedSize_ -= it->second.string.size();
       auto strIter = stringToId_.find(it->second.string);
@@ -44,7 +76,7 @@ void StringIdMap::release(uint64_t id) {
 }
 
 void StringIdMap::addReference(uint64_t id) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::shared_lock<folly::SharedMutex> l(mutex_);
   auto it = idToString_.find(id);
   VELOX_CHECK(
       it != idToString_.end(),
@@ -55,7 +87,18 @@ void StringIdMap::addReference(uint64_t id) {
 }
 
 uint64_t StringIdMap::makeId(std::string_view string) {
-  std::lock_guard<std::mutex> l(mutex_);
+  {
+    std::shared_lock<folly::SharedMutex> l(mutex_);
+    auto it = stringToId_.find(string);
+    if (it != stringToId_.end()) {
+      auto entry = idToString_.find(it->second);
+      VELOX_CHECK(entry != idToString_.end());
+      if (incrementIfInUse(entry->second.numInUse)) {
+        return it->second;
+      }
+    }
+  }
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   auto it = stringToId_.find(string);
   if (it != stringToId_.end()) {
     auto entry = idToString_.find(it->second);
@@ -66,22 +109,22 @@ uint64_t StringIdMap::makeId(std::string_view string) {
 
     return it->second;
   }
-  Entry entry;
-  entry.string = string;
   // Check that we do not use an id twice. In practice this never
   // happens because the int64 counter would have to wrap around for
   // this. Even if this happened, the time spent in the loop would
   // have a low cap since the number of mappings would in practice
   // be in the 100K range.
+  uint64_t id;
   do {
-    entry.id = ++lastId_;
-  } while (idToString_.find(entry.id) != idToString_.end());
+    id = ++lastId_;
+  } while (idToString_.find(id) != idToString_.end());
+  auto& entry = idToString_[id];
+  entry.string = string;
+  entry.id = id;
   entry.numInUse = 1;
   pinnedSize_ += entry.string.size();
-  auto id = entry.id;
-  idToString_[id] = std::move(entry);
   stringToId_[string] = id;
-  return lastId_;
+  return id;
 }
 
 } // namespace facebook::velox
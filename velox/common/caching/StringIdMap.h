@@ -16,14 +16,23 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 #include <string_view>
 
+#include <folly/SharedMutex.h>
 #include <folly/container/F14Map.h>
 
 #include "velox/common/base/Exceptions.h"
 
 namespace facebook::velox {
 
+/// Assigns ids to strings, e.g. file names, and keeps use counts of the ids.
+/// Looking up a known string or id and adding or releasing a reference that
+/// is not the last one take a shared lock, so that concurrent readers do not
+/// serialize. Assigning a new id and releasing the last reference take an
+/// exclusive lock.
 class StringIdMap {
  public:
   static constexpr uint64_t kNoId = ~0UL;
@@ -58,7 +67,7 @@ class StringIdMap {
   // Returns a copy of the string associated with id or empty string if id has
   // no string.
   std::string string(uint64_t id) {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::shared_lock<folly::SharedMutex> l(mutex_);
     auto it = idToString_.find(id);
     return it == idToString_.end() ? "" : it->second.string;
   }
@@ -67,12 +76,14 @@ class StringIdMap {
   struct Entry {
     std::string string;
     uint64_t id;
-    uint32_t numInUse{};
+    // Changed under a shared lock as long as it does not go from or to 0.
+    std::atomic<uint32_t> numInUse{};
   };
 
-  std::mutex mutex_;
+  folly::SharedMutex mutex_;
   folly::F14FastMap<std::string, uint64_t> stringToId_;
-  folly::F14FastMap<uint64_t, Entry> idToString_;
+  // Node map so that the atomic use counts do not move on rehash.
+  folly::F14NodeMap<uint64_t, Entry> idToString_;
   uint64_t lastId_{};
   uint64_t pinnedSize_{};
 };
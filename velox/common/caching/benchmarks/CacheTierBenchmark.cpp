@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/caching/SsdCache.h"
+#include "velox/common/memory/MemoryAllocator.h"
+#include "velox/common/memory/MemoryManager.h"
+
+#include <folly/Random.h>
+#include <folly/String.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/executors/QueuedImmediateExecutor.h>
+#include <folly/init/Init.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+DEFINE_string(
+    trace_path,
+    "",
+    "File with a recorded access trace, one 'path,offset,size' line per "
+    "access. If empty, a synthetic trace is generated");
+DEFINE_int32(num_files, 100, "Number of files in the synthetic trace");
+DEFINE_int32(file_mb, 256, "Size of each file in the synthetic trace in MB");
+DEFINE_int32(entry_kb, 64, "Size of each access in the synthetic trace in KB");
+DEFINE_int64(num_accesses, 2'000'000, "Number of synthetic accesses");
+DEFINE_double(
+    skew,
+    3,
+    "Skew of the synthetic accesses. Each access is to region n * u^skew of "
+    "n regions for a uniform u in [0, 1), so 1 is uniform and larger values "
+    "make the low regions hotter");
+DEFINE_int32(num_threads, 16, "Number of threads replaying the trace");
+DEFINE_int32(memory_mb, 4096, "Capacity of the memory cache in MB");
+DEFINE_string(
+    ssd_path,
+    "",
+    "Directory for the SSD cache. If set, the trace is replayed without SSD "
+    "and then once for each of --ssd_shards");
+DEFINE_int32(ssd_gb, 16, "Capacity of the SSD cache in GB");
+DEFINE_string(
+    ssd_shards,
+    "1,4,16",
+    "Comma separated numbers of SSD cache shard files to try");
+DEFINE_int32(
+    ssd_checkpoint_mb,
+    0,
+    "Checkpoint the SSD cache every so many MB written. 0 means no "
+    "checkpoints");
+DEFINE_int32(ssd_write_threads, 8, "Threads writing to the SSD cache");
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+// Replays a trace of (file, offset, size) accesses against AsyncDataCache on
+// several threads, with and without SsdCache. An access that is not in memory
+// is loaded from SSD if it is there and filled in place otherwise, which
+// stands for a read from storage. Reports the hit rates, the latency of
+// lookups that hit memory and of inserts of new entries, which includes
+// making space, and the bytes written to SSD relative to the bytes read from
+// storage.
+namespace {
+
+struct Access {
+  uint64_t fileNum;
+  uint64_t offset;
+  int32_t size;
+};
+
+struct Trace {
+  // Keeps the file ids of 'accesses' alive.
+  std::vector<StringIdLease> files;
+  std::vector<Access> accesses;
+};
+
+struct Result {
+  uint64_t numMemoryHits{0};
+  uint64_t numSsdHits{0};
+  uint64_t numMisses{0};
+  uint64_t numWaits{0};
+  uint64_t numNoSpace{0};
+  uint64_t storageBytes{0};
+  std::vector<uint64_t> lookupNanos;
+  std::vector<uint64_t> insertNanos;
+};
+
+uint64_t nanosSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+Trace readTrace() {
+  Trace trace;
+  std::unordered_map<std::string, uint64_t> fileNums;
+  std::ifstream in(FLAGS_trace_path);
+  VELOX_CHECK(in.good(), "Cannot open {}", FLAGS_trace_path);
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    std::vector<std::string> fields;
+    folly::split(',', line, fields);
+    VELOX_CHECK_EQ(fields.size(), 3, "Bad trace line: {}", line);
+    auto it = fileNums.find(fields[0]);
+    if (it == fileNums.end()) {
+      trace.files.emplace_back(fileIds(), fields[0]);
+      it = fileNums.emplace(fields[0], trace.files.back().id()).first;
+    }
+    trace.accesses.push_back(
+        {it->second, std::stoull(fields[1]), std::stoi(fields[2])});
+  }
+  return trace;
+}
+
+Trace makeTrace() {
+  Trace trace;
+  for (auto i = 0; i < FLAGS_num_files; ++i) {
+    trace.files.emplace_back(
+        fileIds(), fmt::format("cache_tier_benchmark_{}", i));
+  }
+  const uint64_t entryBytes = FLAGS_entry_kb << 10;
+  const uint64_t regionsPerFile = (uint64_t{FLAGS_file_mb} << 20) / entryBytes;
+  const uint64_t numRegions = regionsPerFile * FLAGS_num_files;
+  folly::Random::DefaultGenerator rng(1);
+  trace.accesses.reserve(FLAGS_num_accesses);
+  for (auto i = 0; i < FLAGS_num_accesses; ++i) {
+    const auto region = std::min<uint64_t>(
+        numRegions - 1,
+        numRegions * std::pow(folly::Random::randDouble01(rng), FLAGS_skew));
+    // Spreads the hot regions over the files.
+    trace.accesses.push_back(
+        {trace.files[region % FLAGS_num_files].id(),
+         region / FLAGS_num_files * entryBytes,
+         static_cast<int32_t>(entryBytes)});
+  }
+  return trace;
+}
+
+// Stands for a read from storage.
+void fill(AsyncDataCacheEntry& entry) {
+  if (entry.tinyData() != nullptr) {
+    memset(entry.tinyData(), 'x', entry.size());
+    return;
+  }
+  auto& data = entry.data();
+  for (auto i = 0; i < data.numRuns(); ++i) {
+    auto run = data.runAt(i);
+    memset(run.data<char>(), 'x', run.numBytes());
+  }
+}
+
+void replay(
+    AsyncDataCache& cache,
+    const std::vector<Access>& accesses,
+    int32_t threadIndex,
+    Result& result) {
+  for (size_t i = threadIndex; i < accesses.size(); i += FLAGS_num_threads) {
+    const auto& access = accesses[i];
+    const RawFileCacheKey key{access.fileNum, access.offset};
+    for (;;) {
+      folly::SemiFuture<bool> wait(false);
+      const auto start = std::chrono::steady_clock::now();
+      CachePin pin;
+      try {
+        pin = cache.findOrCreate(key, access.size, &wait);
+      } catch (const VeloxException&) {
+        ++result.numNoSpace;
+        break;
+      }
+      if (pin.empty()) {
+        // Another thread is loading the entry.
+        ++result.numWaits;
+        std::move(wait)
+            .via(&folly::QueuedImmediateExecutor::instance())
+            .wait();
+        continue;
+      }
+      auto* entry = pin.checkedEntry();
+      if (entry->isShared()) {
+        result.lookupNanos.push_back(nanosSince(start));
+        ++result.numMemoryHits;
+        break;
+      }
+      auto* ssdCache = cache.ssdCache();
+      auto ssdPin = ssdCache != nullptr ? ssdCache->file(key.fileNum).find(key)
+                                        : SsdPin();
+      if (!ssdPin.empty()) {
+        std::vector<SsdPin> ssdPins;
+        ssdPins.push_back(std::move(ssdPin));
+        std::vector<CachePin> pins;
+        pins.push_back(std::move(pin));
+        ssdCache->file(key.fileNum).load(ssdPins, pins);
+        pins[0].checkedEntry()->setExclusiveToShared();
+        ++result.numSsdHits;
+      } else {
+        fill(*entry);
+        entry->setExclusiveToShared();
+        result.storageBytes += access.size;
+        ++result.numMisses;
+      }
+      result.insertNanos.push_back(nanosSince(start));
+      break;
+    }
+  }
+}
+
+void run(const Trace& trace, int32_t numSsdShards) {
+  memory::MemoryManagerOptions options;
+  options.useMmapAllocator = true;
+  options.allocatorCapacity = uint64_t{FLAGS_memory_mb} << 20;
+  options.arbitratorCapacity = options.allocatorCapacity;
+  options.arbitratorReservedCapacity = 0;
+  memory::MemoryManager manager(options);
+
+  std::unique_ptr<folly::IOThreadPoolExecutor> ssdExecutor;
+  std::unique_ptr<SsdCache> ssdCache;
+  const auto ssdDirectory =
+      fmt::format("{}/cache_tier_benchmark", FLAGS_ssd_path);
+  if (numSsdShards > 0) {
+    ssdExecutor =
+        std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_ssd_write_threads);
+    ssdCache = std::make_unique<SsdCache>(
+        fmt::format("{}/cache", ssdDirectory),
+        uint64_t{FLAGS_ssd_gb} << 30,
+        numSsdShards,
+        ssdExecutor.get(),
+        uint64_t{FLAGS_ssd_checkpoint_mb} << 20);
+  }
+  auto cache = AsyncDataCache::create(manager.allocator(), std::move(ssdCache));
+
+  std::vector<Result> results(FLAGS_num_threads);
+  std::vector<std::thread> threads;
+  const auto start = std::chrono::steady_clock::now();
+  for (auto i = 0; i < FLAGS_num_threads; ++i) {
+    threads.emplace_back(
+        [&, i]() { replay(*cache, trace.accesses, i, results[i]); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto elapsedNanos = nanosSince(start);
+  if (cache->ssdCache() != nullptr) {
+    while (cache->ssdCache()->writeInProgress()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100)); // NOLINT
+    }
+  }
+
+  Result total;
+  for (auto& result : results) {
+    total.numMemoryHits += result.numMemoryHits;
+    total.numSsdHits += result.numSsdHits;
+    total.numMisses += result.numMisses;
+    total.numWaits += result.numWaits;
+    total.numNoSpace += result.numNoSpace;
+    total.storageBytes += result.storageBytes;
+    total.lookupNanos.insert(
+        total.lookupNanos.end(),
+        result.lookupNanos.begin(),
+        result.lookupNanos.end());
+    total.insertNanos.insert(
+        total.insertNanos.end(),
+        result.insertNanos.begin(),
+        result.insertNanos.end());
+  }
+  auto percentile = [](std::vector<uint64_t>& nanos, int32_t pct) {
+    if (nanos.empty()) {
+      return uint64_t{0};
+    }
+    const auto index = (nanos.size() - 1) * pct / 100;
+    std::nth_element(nanos.begin(), nanos.begin() + index, nanos.end());
+    return nanos[index];
+  };
+  const auto numAccesses = std::max<uint64_t>(1, trace.accesses.size());
+  const auto pct = [&](uint64_t count) { return 100.0 * count / numAccesses; };
+  const auto stats = cache->refreshStats();
+  std::cout << fmt::format(
+                   "{} threads: {} accesses: {} in {}ms: memory hits {:.1f}% "
+                   "ssd hits {:.1f}% misses {:.1f}% waits {} no space {} "
+                   "evictions {} lookup p50 {}ns p99 {}ns insert p50 {}ns "
+                   "p99 {}ns",
+                   numSsdShards == 0
+                       ? std::string("memory")
+                       : fmt::format("ssd shards: {}", numSsdShards),
+                   FLAGS_num_threads,
+                   trace.accesses.size(),
+                   elapsedNanos / 1'000'000,
+                   pct(total.numMemoryHits),
+                   pct(total.numSsdHits),
+                   pct(total.numMisses),
+                   total.numWaits,
+                   total.numNoSpace,
+                   stats.numEvict,
+                   percentile(total.lookupNanos, 50),
+                   percentile(total.lookupNanos, 99),
+                   percentile(total.insertNanos, 50),
+                   percentile(total.insertNanos, 99))
+            << std::endl;
+  if (stats.ssdStats != nullptr) {
+    // Write amplification is the bytes written to SSD over the bytes read
+    // from storage, which is what a write-through cache would write.
+    const auto& ssdStats = *stats.ssdStats;
+    std::cout << fmt::format(
+                     "  ssd written {} physical {} for {} from storage "
+                     "({:.2f}x), regions evicted {} checkpoints {}",
+                     succinctBytes(ssdStats.bytesWritten),
+                     succinctBytes(ssdStats.physicalBytesWritten),
+                     succinctBytes(total.storageBytes),
+                     static_cast<double>(ssdStats.physicalBytesWritten) /
+                         std::max<uint64_t>(1, total.storageBytes),
+                     ssdStats.regionsEvicted,
+                     ssdStats.checkpointsWritten)
+              << std::endl;
+  }
+  cache->shutdown();
+  cache.reset();
+  if (numSsdShards > 0) {
+    std::filesystem::remove_all(ssdDirectory);
+  }
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  const auto trace = FLAGS_trace_path.empty() ? makeTrace() : readTrace();
+  run(trace, 0);
+  if (!FLAGS_ssd_path.empty()) {
+    std::vector<std::string> shards;
+    folly::split(',', FLAGS_ssd_shards, shards);
+    for (const auto& numShards : shards) {
+      run(trace, std::stoi(numShards));
+    }
+  }
+  return 0;
+}
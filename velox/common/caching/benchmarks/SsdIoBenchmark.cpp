@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/SsdFile.h"
+#include "velox/common/caching/SsdIoUring.h"
+#include "velox/common/time/Timer.h"
+
+#include <fcntl.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+DEFINE_string(path, "/tmp", "Directory for the SSD shard files");
+DEFINE_int32(num_shards, 4, "Number of shard files");
+DEFINE_int32(shard_mb, 256, "Size of each shard file in MB");
+DEFINE_int32(block_kb, 8, "Size of each read in KB");
+DEFINE_int32(num_threads, 8, "Number of reader threads");
+DEFINE_int32(batch_size, 32, "Number of reads submitted together");
+DEFINE_int32(seconds, 5, "Seconds to run each IO mode");
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+// Measures random read IOPS and batch latency over several SSD cache shard
+// files, issuing each batch either as one pread() per block or as one io_uring
+// submission. Each reader thread picks a random shard per batch, like
+// concurrent loads from a sharded SsdCache.
+namespace {
+
+struct Result {
+  uint64_t numReads{0};
+  std::vector<uint64_t> batchMicros;
+};
+
+std::vector<int32_t> makeShards() {
+  int32_t oDirect = 0;
+#ifdef linux
+  oDirect = FLAGS_ssd_odirect ? O_DIRECT : 0;
+#endif // linux
+  constexpr int32_t kChunk = 1 << 20;
+  void* data;
+  VELOX_CHECK_EQ(posix_memalign(&data, 4096, kChunk), 0);
+  memset(data, 'x', kChunk);
+  std::vector<int32_t> fds;
+  for (auto shard = 0; shard < FLAGS_num_shards; ++shard) {
+    const auto name = fmt::format("{}/ssd_io_benchmark{}", FLAGS_path, shard);
+    const auto fd =
+        open(name.c_str(), O_CREAT | O_RDWR | oDirect, S_IRUSR | S_IWUSR);
+    VELOX_CHECK_GE(fd, 0, "Cannot open {}: {}", name, folly::errnoStr(errno));
+    for (auto i = 0; i < FLAGS_shard_mb; ++i) {
+      const auto rc =
+          pwrite(fd, data, kChunk, static_cast<uint64_t>(i) * kChunk);
+      VELOX_CHECK_EQ(rc, kChunk, "pwrite failed: {}", folly::errnoStr(errno));
+    }
+    fds.push_back(fd);
+  }
+  free(data);
+  return fds;
+}
+
+Result
+readThread(const std::vector<int32_t>& fds, bool ioUring, uint64_t endMicros) {
+  const uint64_t blockSize = FLAGS_block_kb << 10;
+  const uint64_t numBlocks = (static_cast<uint64_t>(FLAGS_shard_mb) << 20) /
+      blockSize;
+  void* data;
+  VELOX_CHECK_EQ(
+      posix_memalign(&data, 4096, blockSize * FLAGS_batch_size), 0);
+  char* buffer = reinterpret_cast<char*>(data);
+  folly::Random::DefaultGenerator rng(std::hash<std::thread::id>()(
+      std::this_thread::get_id()));
+  Result result;
+  std::vector<SsdIoUring::Read> reads(FLAGS_batch_size);
+  while (getCurrentTimeMicro() < endMicros) {
+    const auto fd = fds[folly::Random::rand32(fds.size(), rng)];
+    for (auto i = 0; i < FLAGS_batch_size; ++i) {
+      reads[i].offset = folly::Random::rand64(numBlocks, rng) * blockSize;
+      reads[i].buffers = {
+          folly::Range<char*>(buffer + i * blockSize, blockSize)};
+    }
+    const auto startMicros = getCurrentTimeMicro();
+    if (!ioUring || !SsdIoUring::read(fd, reads)) {
+      for (const auto& read : reads) {
+        const uint64_t rc =
+            pread(fd, read.buffers[0].data(), blockSize, read.offset);
+        VELOX_CHECK_EQ(
+            rc, blockSize, "pread failed: {}", folly::errnoStr(errno));
+      }
+    }
+    result.batchMicros.push_back(getCurrentTimeMicro() - startMicros);
+    result.numReads += FLAGS_batch_size;
+  }
+  free(data);
+  return result;
+}
+
+void run(const std::vector<int32_t>& fds, bool ioUring) {
+  std::vector<Result> results(FLAGS_num_threads);
+  std::vector<std::thread> threads;
+  const auto startMicros = getCurrentTimeMicro();
+  const auto endMicros = startMicros + FLAGS_seconds * 1'000'000UL;
+  for (auto i = 0; i < FLAGS_num_threads; ++i) {
+    threads.emplace_back([&, i]() {
+      results[i] = readThread(fds, ioUring, endMicros);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto elapsedMicros = getCurrentTimeMicro() - startMicros;
+
+  uint64_t numReads = 0;
+  std::vector<uint64_t> batchMicros;
+  for (auto& result : results) {
+    numReads += result.numReads;
+    batchMicros.insert(
+        batchMicros.end(),
+        result.batchMicros.begin(),
+        result.batchMicros.end());
+  }
+  std::sort(batchMicros.begin(), batchMicros.end());
+  auto percentile = [&](int32_t pct) -> uint64_t {
+    return batchMicros.empty()
+        ? 0
+        : batchMicros[(batchMicros.size() - 1) * pct / 100];
+  };
+  std::cout << fmt::format(
+                   "{:<8} shards: {} threads: {} batch: {} IOPS: {} batch "
+                   "latency p50: {}us p99: {}us",
+                   ioUring ? "io_uring" : "pread",
+                   fds.size(),
+                   FLAGS_num_threads,
+                   FLAGS_batch_size,
+                   numReads * 1'000'000 / std::max<uint64_t>(1, elapsedMicros),
+                   percentile(50),
+                   percentile(99))
+            << std::endl;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  FLAGS_ssd_io_uring_queue_depth =
+      std::max(FLAGS_ssd_io_uring_queue_depth, FLAGS_batch_size);
+  auto fds = makeShards();
+  run(fds, false);
+  if (SsdIoUring::available()) {
+    run(fds, true);
+  } else {
+    std::cout << "io_uring is not available" << std::endl;
+  }
+  for (auto shard = 0; shard < fds.size(); ++shard) {
+    close(fds[shard]);
+    unlink(fmt::format("{}/ssd_io_benchmark{}", FLAGS_path, shard).c_str());
+  }
+  return 0;
+}
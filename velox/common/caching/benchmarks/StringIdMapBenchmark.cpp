@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <thread>
+
+#include "velox/common/caching/StringIdMap.h"
+
+DEFINE_int32(num_threads, 8, "Number of threads looking up ids");
+DEFINE_int32(num_strings, 1'000, "Number of distinct strings");
+
+namespace facebook::velox {
+namespace {
+
+std::vector<std::string> makeNames() {
+  std::vector<std::string> names;
+  for (auto i = 0; i < FLAGS_num_strings; ++i) {
+    names.push_back(fmt::format("hdfs://warehouse/table/partition/file_{}", i));
+  }
+  return names;
+}
+
+// Makes and drops leases on known strings from 'FLAGS_num_threads' threads,
+// as a split does for the id of its file.
+void leases(uint32_t iterations) {
+  StringIdMap map;
+  std::vector<std::string> names;
+  std::vector<StringIdLease> pinned;
+  BENCHMARK_SUSPEND {
+    names = makeNames();
+    for (const auto& name : names) {
+      pinned.emplace_back(map, name);
+    }
+  }
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < FLAGS_num_threads; ++i) {
+    threads.emplace_back([&, i]() {
+      for (auto j = 0; j < iterations; ++j) {
+        StringIdLease lease(map, names[(i + j) % names.size()]);
+        folly::doNotOptimizeAway(lease.id());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// Looks up the ids of known strings from 'FLAGS_num_threads' threads.
+void lookups(uint32_t iterations) {
+  StringIdMap map;
+  std::vector<std::string> names;
+  std::vector<StringIdLease> pinned;
+  BENCHMARK_SUSPEND {
+    names = makeNames();
+    for (const auto& name : names) {
+      pinned.emplace_back(map, name);
+    }
+  }
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < FLAGS_num_threads; ++i) {
+    threads.emplace_back([&, i]() {
+      for (auto j = 0; j < iterations; ++j) {
+        folly::doNotOptimizeAway(map.id(names[(i + j) % names.size()]));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+BENCHMARK(stringIdLeases, n) {
+  leases(n);
+}
+
+BENCHMARK(stringIdLookups, n) {
+  lookups(n);
+}
+
+} // namespace
+} // namespace facebook::velox
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  folly::runBenchmarks();
+  return 0;
+}
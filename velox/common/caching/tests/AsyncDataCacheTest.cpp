@@ -89,7 +89,10 @@ class AsyncDataCacheTest : public testing::Test {
     }
   }
 
-  void initializeCache(uint64_t maxBytes, int64_t ssdBytes = 0) {
+  void initializeCache(
+      uint64_t maxBytes,
+      int64_t ssdBytes = 0,
+      CacheAdmissionPolicy admissionPolicy = CacheAdmissionPolicy::kAdmitAll) {
     if (cache_ != nullptr) {
       cache_->shutdown();
     }
@@ -121,7 +124,8 @@ class AsyncDataCacheTest : public testing::Test {
     options.trackDefaultUsage = true;
     manager_ = std::make_unique<memory::MemoryManager>(options);
     allocator_ = static_cast<memory::MmapAllocator*>(manager_->allocator());
-    cache_ = AsyncDataCache::create(allocator_, std::move(ssdCache));
+    cache_ = AsyncDataCache::create(
+        allocator_, std::move(ssdCache), admissionPolicy);
     if (filenames_.empty()) {
       for (auto i = 0; i < kNumFiles; ++i) {
         auto name = fmt::format("testing_file_{}", i);
@@ -831,6 +835,108 @@ TEST_F(AsyncDataCacheTest, DISABLED_ssd) {
   ASSERT_EQ(ssdStatsFromCP.readCheckpointErrors, 1);
 }
 
+TEST_F(AsyncDataCacheTest, warmUpFromSsd) {
+  constexpr uint64_t kRamBytes = 64 << 20;
+  constexpr uint64_t kSsdBytes = 256UL << 20;
+  constexpr int32_t kNumEntries = 64;
+  constexpr int32_t kEntrySize = 64 << 10;
+  initializeCache(kRamBytes, kSsdBytes);
+  ASSERT_EQ(cache_->warmUpFromSsd(kRamBytes), 0);
+  {
+    std::vector<CachePin> pins;
+    for (auto i = 0; i < kNumEntries; ++i) {
+      pins.push_back(newEntry(i * kEntrySize, kEntrySize));
+      auto* entry = pins.back().checkedEntry();
+      initializeContents(
+          entry->key().fileNum.id() + entry->offset(), entry->data());
+      entry->setExclusiveToShared();
+    }
+  }
+  ASSERT_TRUE(cache_->ssdCache()->startWrite());
+  cache_->saveToSsd();
+  waitForSsdWriteToFinish(cache_->ssdCache());
+  // Shuts down with a checkpoint and restarts from it with empty memory.
+  cache_->ssdCache()->shutdown();
+  initializeCache(kRamBytes, kSsdBytes);
+  ASSERT_EQ(cache_->refreshStats().numEntries, 0);
+  ASSERT_EQ(cache_->ssdCache()->stats().entriesCached, kNumEntries);
+
+  // A limit smaller than the total loads part of the entries.
+  const auto numShards = cache_->ssdCache()->numShards();
+  ASSERT_EQ(
+      cache_->warmUpFromSsd(numShards * kEntrySize * kNumEntries / 4),
+      kEntrySize * kNumEntries / 4);
+  ASSERT_EQ(cache_->refreshStats().numEntries, kNumEntries / 4);
+  ASSERT_EQ(
+      cache_->warmUpFromSsd(numShards * kEntrySize * kNumEntries),
+      kEntrySize * kNumEntries * 3 / 4);
+  auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numEntries, kNumEntries);
+  ASSERT_EQ(stats.numExclusive, 0);
+  ASSERT_EQ(stats.ssdStats->entriesRead, kNumEntries);
+  // Everything is in memory.
+  ASSERT_EQ(cache_->warmUpFromSsd(numShards * kEntrySize * kNumEntries), 0);
+
+  for (auto i = 0; i < kNumEntries; ++i) {
+    auto pin = cache_->findOrCreate(
+        RawFileCacheKey{filenames_[0].id(), (uint64_t)i * kEntrySize},
+        kEntrySize,
+        nullptr);
+    ASSERT_TRUE(pin.checkedEntry()->isShared());
+    checkContents(*pin.checkedEntry());
+  }
+}
+
+TEST_F(AsyncDataCacheTest, residencySummary) {
+  constexpr uint64_t kRamBytes = 64 << 20;
+  constexpr uint64_t kSsdBytes = 256UL << 20;
+  constexpr uint64_t kRegionSize = CacheResidencySummary::kRegionSize;
+  constexpr int32_t kEntrySize = 64 << 10;
+  initializeCache(kRamBytes, kSsdBytes);
+  const auto fileName = fileIds().string(filenames_[0].id());
+  auto summary = cache_->residencySummary();
+  ASSERT_EQ(summary.numRegions(), 0);
+  ASSERT_FALSE(summary.mayContain(fileName, 0));
+
+  // One entry in each of the first 4 regions.
+  {
+    std::vector<CachePin> pins;
+    for (auto i = 0; i < 4; ++i) {
+      pins.push_back(newEntry(i * kRegionSize, kEntrySize));
+      auto* entry = pins.back().checkedEntry();
+      initializeContents(
+          entry->key().fileNum.id() + entry->offset(), entry->data());
+      // An entry that is still being loaded does not count.
+      ASSERT_EQ(cache_->residencySummary().numRegions(), i);
+      entry->setExclusiveToShared();
+    }
+  }
+  summary = cache_->residencySummary();
+  ASSERT_EQ(summary.numRegions(), 4);
+  ASSERT_EQ(summary.memoryBytes(), 4 * kEntrySize);
+  ASSERT_EQ(summary.ssdBytes(), 0);
+  for (auto i = 0; i < 4; ++i) {
+    ASSERT_TRUE(summary.mayContain(fileName, i * kRegionSize));
+  }
+  ASSERT_EQ(summary.cachedBytes(fileName, 0, 4 * kRegionSize), 4 * kRegionSize);
+
+  // After saving to SSD and restarting, the regions are found on SSD.
+  ASSERT_TRUE(cache_->ssdCache()->startWrite());
+  cache_->saveToSsd();
+  waitForSsdWriteToFinish(cache_->ssdCache());
+  ASSERT_EQ(cache_->residencySummary().ssdBytes(), 4 * kEntrySize);
+  cache_->ssdCache()->shutdown();
+  initializeCache(kRamBytes, kSsdBytes);
+  summary = CacheResidencySummary::deserialize(
+      cache_->residencySummary().serialize());
+  ASSERT_EQ(summary.numRegions(), 4);
+  ASSERT_EQ(summary.memoryBytes(), 0);
+  ASSERT_EQ(summary.ssdBytes(), 4 * kEntrySize);
+  for (auto i = 0; i < 4; ++i) {
+    ASSERT_TRUE(summary.mayContain(fileName, i * kRegionSize));
+  }
+}
+
 TEST_F(AsyncDataCacheTest, invalidSsdPath) {
   auto testPath = "hdfs:/test/prefix_";
   uint64_t ssdBytes = 256UL << 20;
@@ -912,6 +1018,124 @@ TEST_F(AsyncDataCacheTest, cacheStats) {
   ASSERT_EQ(cache_->toString(false), expectedShortCacheOutput);
 }
 
+TEST_F(AsyncDataCacheTest, tinyLfuAdmission) {
+  constexpr uint64_t kRamBytes = 16 << 20;
+  constexpr int32_t kEntryBytes = 64 << 10;
+  constexpr int32_t kNumHot = 20;
+  constexpr int32_t kNumScan = 1'000;
+  initializeCache(kRamBytes, 0, CacheAdmissionPolicy::kTinyLfu);
+  const auto hotFile = filenames_[0].id();
+  const auto scanFile = filenames_[1].id();
+  auto load = [&](uint64_t fileNum, uint64_t offset) {
+    auto pin =
+        cache_->findOrCreate(RawFileCacheKey{fileNum, offset}, kEntryBytes);
+    ASSERT_FALSE(pin.empty());
+    if (pin.entry()->isExclusive()) {
+      pin.entry()->setExclusiveToShared();
+    }
+  };
+  auto scan = [&](int32_t begin, int32_t end) {
+    for (auto i = begin; i < end; ++i) {
+      load(scanFile, i * kEntryBytes);
+    }
+  };
+
+  // Fills the cache so that the admission policy applies to the next entries.
+  scan(0, kRamBytes / kEntryBytes * 2);
+  auto stats = cache_->refreshStats();
+  ASSERT_LT(0, stats.numEvict);
+  ASSERT_EQ(stats.numNew, stats.numAdmit + stats.numAdmitReject);
+  // Ages the entries of the first scan.
+  std::this_thread::sleep_for(std::chrono::milliseconds(100)); // NOLINT
+
+  // The first load of a hot entry is not admitted. The entry is admitted when
+  // it is hit or loaded again.
+  for (auto round = 0; round < 10; ++round) {
+    for (auto i = 0; i < kNumHot; ++i) {
+      load(hotFile, i * kEntryBytes);
+    }
+  }
+  const auto numRejectBeforeScan = cache_->refreshStats().numAdmitReject;
+  // A one-off scan of 4x the cache size does not flush the hot entries.
+  scan(kRamBytes / kEntryBytes * 2, kRamBytes / kEntryBytes * 2 + kNumScan);
+  for (auto i = 0; i < kNumHot; ++i) {
+    ASSERT_TRUE(cache_->exists(RawFileCacheKey{hotFile, i * kEntryBytes}));
+  }
+
+  stats = cache_->refreshStats();
+  ASSERT_EQ(CacheAdmissionPolicy::kTinyLfu, stats.admissionPolicy);
+  ASSERT_EQ(stats.numAdmitReject - numRejectBeforeScan, kNumScan);
+  ASSERT_EQ(stats.numNew, stats.numAdmit + stats.numAdmitReject);
+  ASSERT_GE(stats.numHit, kNumHot * 8);
+  ASSERT_NE(
+      stats.toString().find(fmt::format(
+          "Admission policy: TINY_LFU admitted: {} rejected: {} hit rate: ",
+          stats.numAdmit,
+          stats.numAdmitReject)),
+      std::string::npos);
+
+  // A scanned entry that is read again is admitted.
+  load(scanFile, 0);
+  ASSERT_EQ(cache_->refreshStats().numAdmitReject, stats.numAdmitReject);
+}
+
+TEST_F(AsyncDataCacheTest, cacheGroups) {
+  constexpr uint64_t kRamBytes = 16 << 20;
+  constexpr int32_t kEntryBytes = 64 << 10;
+  constexpr uint64_t kQuota = 4 << 20;
+  initializeCache(kRamBytes);
+  ASSERT_EQ(cache_->cacheGroupId(""), kDefaultCacheGroup);
+  const auto limited = cache_->cacheGroupId("limited");
+  const auto unlimited = cache_->cacheGroupId("unlimited");
+  ASSERT_EQ(cache_->cacheGroupId("limited"), limited);
+  ASSERT_NE(limited, unlimited);
+  cache_->setCacheGroupQuota("limited", kQuota);
+  ASSERT_EQ(cache_->cacheGroupShardQuota(limited), kQuota / 4);
+  ASSERT_EQ(cache_->cacheGroupShardQuota(unlimited), 0);
+
+  auto load = [&](uint64_t fileNum, uint64_t offset, int32_t group) {
+    auto pin = cache_->findOrCreate(
+        RawFileCacheKey{fileNum, offset}, kEntryBytes, nullptr, group);
+    ASSERT_FALSE(pin.empty());
+    if (pin.entry()->isExclusive()) {
+      pin.entry()->setExclusiveToShared();
+    }
+  };
+
+  // A group may go over its quota while there is free memory.
+  const auto limitedFile = filenames_[0].id();
+  const auto unlimitedFile = filenames_[1].id();
+  for (auto i = 0; i < 2 * kQuota / kEntryBytes; ++i) {
+    load(limitedFile, i * kEntryBytes, limited);
+  }
+  auto stats = cache_->cacheGroupStats();
+  ASSERT_EQ(stats.size(), 3);
+  ASSERT_EQ(stats[limited].name, "limited");
+  ASSERT_EQ(stats[limited].quotaBytes, kQuota);
+  ASSERT_EQ(stats[limited].bytes, 2 * kQuota);
+  ASSERT_EQ(stats[limited].numNew, 2 * kQuota / kEntryBytes);
+  ASSERT_EQ(stats[limited].numEvict, 0);
+  load(limitedFile, 0, limited);
+  ASSERT_EQ(cache_->cacheGroupStats()[limited].numHit, 1);
+
+  // When space is needed, the group over its quota is evicted first.
+  for (auto i = 0; i < 2 * kRamBytes / kEntryBytes; ++i) {
+    load(unlimitedFile, i * kEntryBytes, unlimited);
+  }
+  stats = cache_->cacheGroupStats();
+  ASSERT_LE(stats[limited].bytes, kQuota);
+  ASSERT_GT(stats[limited].numEvict, 0);
+  ASSERT_EQ(stats[unlimited].numNew, 2 * kRamBytes / kEntryBytes);
+  ASSERT_EQ(stats[kDefaultCacheGroup].numNew, 0);
+  cache_->reportCacheGroupStats();
+
+  for (int32_t i = stats.size(); i < kMaxCacheGroups; ++i) {
+    cache_->cacheGroupId(fmt::format("group{}", i));
+  }
+  VELOX_ASSERT_THROW(
+      cache_->cacheGroupId("oneTooMany"), "Too many cache groups");
+}
+
 TEST_F(AsyncDataCacheTest, shrinkCache) {
   constexpr uint64_t kRamBytes = 128UL << 20;
   constexpr uint64_t kSsdBytes = 512UL << 20;
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheResidency.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/caching/FileIds.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+namespace {
+constexpr uint64_t kRegionSize = CacheResidencySummary::kRegionSize;
+} // namespace
+
+TEST(CacheResidencyTest, empty) {
+  CacheResidencySummary summary;
+  ASSERT_FALSE(summary.mayContain("file", 0));
+  ASSERT_EQ(summary.cachedBytes("file", 0, kRegionSize), 0);
+
+  auto built = CacheResidencyBuilder().build();
+  ASSERT_EQ(built.numRegions(), 0);
+  ASSERT_FALSE(built.mayContain("file", 0));
+}
+
+TEST(CacheResidencyTest, build) {
+  const std::string cachedName = "residency_test_cached";
+  StringIdLease cached(fileIds(), cachedName);
+  CacheResidencyBuilder builder;
+  // An entry in region 0, one spanning regions 2 and 3 and one on SSD in
+  // region 10.
+  builder.add(cached.id(), 100, 1'000, false);
+  builder.add(cached.id(), 2 * kRegionSize + 10, kRegionSize, false);
+  builder.add(cached.id(), 10 * kRegionSize, 4'096, true);
+  // An entry of the same region is counted once.
+  builder.add(cached.id(), 10 * kRegionSize + 4'096, 4'096, true);
+  auto summary = builder.build();
+  ASSERT_EQ(summary.numRegions(), 4);
+  ASSERT_EQ(summary.memoryBytes(), 1'000 + kRegionSize);
+  ASSERT_EQ(summary.ssdBytes(), 2 * 4'096);
+
+  for (auto region : {0, 2, 3, 10}) {
+    ASSERT_TRUE(summary.mayContain(cachedName, region * kRegionSize));
+  }
+  int32_t numFalsePositives = 0;
+  for (auto region = 11; region < 1'000; ++region) {
+    numFalsePositives += summary.mayContain(cachedName, region * kRegionSize);
+    numFalsePositives +=
+        summary.mayContain("residency_test_other", region * kRegionSize);
+  }
+  ASSERT_LT(numFalsePositives, 100);
+
+  // Half of region 2 and all of region 3 are counted.
+  ASSERT_EQ(
+      summary.cachedBytes(
+          cachedName, 2 * kRegionSize + kRegionSize / 2, kRegionSize * 2),
+      kRegionSize + kRegionSize / 2);
+  ASSERT_EQ(summary.cachedBytes(cachedName, 100, 0), 0);
+}
+
+TEST(CacheResidencyTest, serialize) {
+  const std::string fileName = "residency_test_serialize";
+  StringIdLease file(fileIds(), fileName);
+  CacheResidencyBuilder builder;
+  for (auto region = 0; region < 100; region += 2) {
+    builder.add(file.id(), region * kRegionSize, 1'000, region % 4 == 0);
+  }
+  const auto summary = builder.build();
+  const auto serialized = summary.serialize();
+  const auto copy = CacheResidencySummary::deserialize(serialized);
+  ASSERT_EQ(copy.numRegions(), 50);
+  ASSERT_EQ(copy.memoryBytes(), summary.memoryBytes());
+  ASSERT_EQ(copy.ssdBytes(), summary.ssdBytes());
+  for (auto region = 0; region < 200; ++region) {
+    ASSERT_EQ(
+        copy.mayContain(fileName, region * kRegionSize),
+        summary.mayContain(fileName, region * kRegionSize));
+  }
+  ASSERT_EQ(copy.toString(), summary.toString());
+
+  VELOX_ASSERT_THROW(
+      CacheResidencySummary::deserialize(serialized.substr(0, 10)),
+      "Truncated cache residency summary");
+  auto badVersion = serialized;
+  badVersion[0] = 2;
+  VELOX_ASSERT_THROW(
+      CacheResidencySummary::deserialize(badVersion),
+      "Unsupported cache residency summary version");
+}
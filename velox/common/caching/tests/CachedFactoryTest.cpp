@@ -16,6 +16,9 @@
 
 #include "velox/common/caching/CachedFactory.h"
 
+#include <chrono>
+#include <thread>
+
 #include "folly/executors/EDFThreadPoolExecutor.h"
 #include "folly/executors/thread_factory/NamedThreadFactory.h"
 #include "folly/synchronization/Latch.h"
@@ -261,3 +264,52 @@ TEST(CachedFactoryTest, disableCache) {
     EXPECT_EQ(missing[i], i);
   }
 }
+
+namespace {
+// Multiplies the key by a factor passed to generate().
+struct MultiplierGenerator {
+  int operator()(const int& value, int factor) {
+    // Makes concurrent requests for the same key overlap.
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ++generated_;
+    return value * factor;
+  }
+  std::atomic<int> generated_ = 0;
+};
+} // namespace
+
+TEST(CachedFactoryTest, shards) {
+  auto generator = std::make_unique<MultiplierGenerator>();
+  auto* generated = &generator->generated_;
+  CachedFactory<int, int, MultiplierGenerator> factory(
+      8, 1000, std::move(generator));
+  EXPECT_EQ(factory.numShards(), 8);
+  EXPECT_EQ(factory.maxSize(), 1000);
+  folly::EDFThreadPoolExecutor pool(
+      100, std::make_shared<folly::NamedThreadFactory>("test_pool"));
+  const int numValues = 50;
+  const int requestsPerValue = 10;
+  folly::Latch latch(numValues * requestsPerValue);
+  for (int i = 0; i < requestsPerValue; i++) {
+    for (int j = 0; j < numValues; j++) {
+      pool.add([&, j]() {
+        auto value = factory.generate(j, 3);
+        EXPECT_EQ(getCachedValue(value), 3 * j);
+        latch.count_down();
+      });
+    }
+  }
+  latch.wait();
+  // Concurrent requests for a key wait for the first one.
+  EXPECT_EQ(*generated, numValues);
+  EXPECT_EQ(factory.currentSize(), numValues);
+
+  std::vector<std::pair<int, int>> cached;
+  std::vector<int> missing;
+  factory.retrieveCached({1, 2, numValues + 1}, &cached, &missing);
+  ASSERT_EQ(cached.size(), 2);
+  ASSERT_EQ(missing, std::vector<int>{numValues + 1});
+
+  factory.clearCache();
+  EXPECT_EQ(factory.currentSize(), 0);
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::cache;
+
+TEST(FrequencySketchTest, estimate) {
+  FrequencySketch sketch(1'000);
+  for (uint64_t hash = 0; hash < 100; ++hash) {
+    ASSERT_EQ(0, sketch.estimate(hash));
+    for (uint64_t i = 0; i < hash % 10; ++i) {
+      sketch.increment(hash);
+    }
+  }
+  for (uint64_t hash = 0; hash < 100; ++hash) {
+    // A count-min sketch never underestimates.
+    ASSERT_LE(hash % 10, sketch.estimate(hash));
+  }
+
+  for (auto i = 0; i < 100; ++i) {
+    sketch.increment(1'000);
+  }
+  ASSERT_EQ(FrequencySketch::kMaxCount, sketch.estimate(1'000));
+  ASSERT_EQ(0, sketch.numResets());
+}
+
+TEST(FrequencySketchTest, reset) {
+  // 1024 counters per row, halved after 10240 increments.
+  FrequencySketch sketch(1'000);
+  for (auto i = 0; i < FrequencySketch::kMaxCount; ++i) {
+    sketch.increment(1);
+  }
+  ASSERT_EQ(FrequencySketch::kMaxCount, sketch.estimate(1));
+  uint64_t hash = 2;
+  while (sketch.numResets() == 0) {
+    sketch.increment(hash++);
+  }
+  ASSERT_EQ(FrequencySketch::kMaxCount / 2, sketch.estimate(1));
+}
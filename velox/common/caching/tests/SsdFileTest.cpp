@@ -14,11 +14,14 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
+#include <folly/Random.h>
+#include <folly/compression/Compression.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -314,6 +317,119 @@ TEST_F(SsdFileTest, writeAndRead) {
   }
 }
 
+TEST_F(SsdFileTest, ioUring) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_ssd_io_uring = true;
+  // A small queue depth splits the writes and reads into several batches. The
+  // ring of a thread is made on first use.
+  FLAGS_ssd_io_uring_queue_depth = 4;
+  if (!SsdIoUring::available()) {
+    GTEST_SKIP() << "io_uring is not available";
+  }
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  initializeCache(128 * kMB, kSsdSize);
+  FLAGS_ssd_verify_write = true;
+  for (auto startOffset = 0; startOffset <= kSsdSize - SsdFile::kRegionSize;
+       startOffset += SsdFile::kRegionSize) {
+    auto pins =
+        makePins(fileName_.id(), startOffset, 4096, 2048 * 1025, 62 * kMB);
+    ssdFile_->write(pins);
+    for (auto& pin : pins) {
+      EXPECT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+    }
+    readAndCheckPins(pins);
+  }
+
+  // More pins than fit in one writev, so that a batch has several writes.
+  for (int numPins : {1, IOV_MAX + 1, 3 * IOV_MAX}) {
+    SCOPED_TRACE(fmt::format("numPins: {}", numPins));
+    auto pins = makePins(fileName_.id(), 0, 4096, 4096, 4096 * numPins);
+    ssdFile_->write(pins);
+    readAndCheckPins(pins);
+  }
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  ASSERT_EQ(stats.writeSsdErrors, 0);
+  ASSERT_EQ(stats.readSsdErrors, 0);
+}
+
+TEST_F(SsdFileTest, compression) {
+  if (!folly::io::hasCodec(folly::io::CodecType::ZSTD)) {
+    GTEST_SKIP() << "zstd is not available";
+  }
+  gflags::FlagSaver flagSaver;
+  FLAGS_ssd_compression = "zstd";
+  FLAGS_ssd_verify_write = true;
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  initializeCache(128 * kMB, kSsdSize);
+
+  auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 16 * kMB);
+  ssdFile_->write(pins);
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  ASSERT_EQ(stats.entriesWritten, pins.size());
+  ASSERT_GT(stats.entriesCompressed, 0);
+  ASSERT_LT(stats.physicalBytesWritten, stats.bytesWritten);
+  ASSERT_EQ(stats.bytesCached, stats.physicalBytesWritten);
+  ASSERT_GT(stats.effectiveBytesCached, stats.bytesCached);
+
+  // Clears the memory of the entries so that the contents are checked after
+  // decompression from SSD.
+  for (auto& pin : pins) {
+    const auto& data = pin.entry()->data();
+    for (auto i = 0; i < data.numRuns(); ++i) {
+      ::memset(data.runAt(i).data(), 0, data.runAt(i).numBytes());
+    }
+  }
+  readAndCheckPins(pins);
+  stats = SsdCacheStats();
+  ssdFile_->updateStats(stats);
+  ASSERT_EQ(stats.bytesRead, stats.bytesWritten);
+  ASSERT_EQ(stats.physicalBytesRead, stats.physicalBytesWritten);
+
+  // An entry that does not compress is written as is.
+  const uint64_t kOffset = 1L << 30;
+  auto random = cache_->findOrCreate(
+      RawFileCacheKey{fileName_.id(), kOffset}, 64 << 10, nullptr);
+  ASSERT_TRUE(random.entry()->isExclusive());
+  folly::Random::DefaultGenerator rng(1);
+  const auto& data = random.entry()->data();
+  for (auto i = 0; i < data.numRuns(); ++i) {
+    auto* words = data.runAt(i).data<uint64_t>();
+    for (auto j = 0; j < data.runAt(i).numBytes() / sizeof(uint64_t); ++j) {
+      words[j] = folly::Random::rand64(rng);
+    }
+  }
+  std::vector<CachePin> randomPins{random};
+  ssdFile_->write(randomPins);
+  const auto run =
+      ssdFile_->find(RawFileCacheKey{fileName_.id(), kOffset}).run();
+  ASSERT_EQ(run.compression(), common::CompressionKind_NONE);
+  ASSERT_EQ(run.size(), 64 << 10);
+  const auto entriesCompressed = stats.entriesCompressed;
+  stats = SsdCacheStats();
+  ssdFile_->updateStats(stats);
+  ASSERT_EQ(stats.entriesCompressed, entriesCompressed);
+}
+
+TEST_F(SsdFileTest, ssdRun) {
+  const SsdRun run(SsdFile::kRegionSize * 3 + 100, 12345);
+  ASSERT_EQ(run.offset(), SsdFile::kRegionSize * 3 + 100);
+  ASSERT_EQ(run.size(), 12345);
+  ASSERT_EQ(run.compression(), common::CompressionKind_NONE);
+  for (const auto compression :
+       {common::CompressionKind_LZ4, common::CompressionKind_ZSTD}) {
+    const SsdRun compressed(1L << 38, 1 << SsdRun::kSizeBits, compression);
+    ASSERT_EQ(compressed.offset(), 1L << 38);
+    ASSERT_EQ(compressed.size(), 1 << SsdRun::kSizeBits);
+    ASSERT_EQ(compressed.compression(), compression);
+    ASSERT_EQ(SsdRun(compressed.bits()).compression(), compression);
+  }
+  VELOX_ASSERT_THROW(
+      SsdRun(0, 100, common::CompressionKind_SNAPPY),
+      "Unsupported SSD cache compression: snappy");
+}
+
 #ifdef VELOX_SSD_FILE_TEST_SET_NO_COW_FLAG
 TEST_F(SsdFileTest, disabledCow) {
   LOG(ERROR) << "here";
@@ -16,6 +16,8 @@
 
 #include "velox/common/caching/StringIdMap.h"
 
+#include <thread>
+
 #include "gtest/gtest.h"
 
 using namespace facebook::velox;
@@ -53,3 +55,40 @@ TEST(StringIdMapTest, rehash) {
     EXPECT_EQ(ids[i].id(), StringIdLease(map, name).id());
   }
 }
+
+TEST(StringIdMapTest, concurrent) {
+  constexpr int32_t kNumStrings = 100;
+  constexpr int32_t kNumThreads = 8;
+  StringIdMap map;
+  std::vector<std::string> names;
+  std::vector<StringIdLease> leases;
+  for (auto i = 0; i < kNumStrings; ++i) {
+    names.push_back(fmt::format("filename_{}", i));
+    leases.emplace_back(map, names.back());
+  }
+  const auto pinnedSize = map.pinnedSize();
+
+  // Threads make and release leases on known and new strings while the ids of
+  // the known strings stay the same.
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      for (auto j = 0; j < 10'000; ++j) {
+        const auto index = (i + j) % kNumStrings;
+        StringIdLease lease(map, names[index]);
+        EXPECT_EQ(leases[index].id(), lease.id());
+        StringIdLease copy(lease);
+        EXPECT_EQ(leases[index].id(), map.id(names[index]));
+        StringIdLease other(map, fmt::format("thread_{}_{}", i, j % 10));
+        EXPECT_TRUE(other.hasValue());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(pinnedSize, map.pinnedSize());
+  for (auto i = 0; i < kNumStrings; ++i) {
+    EXPECT_EQ(names[i], map.string(leases[i].id()));
+  }
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/compression/HardwareDecompressor.h"
+
+#include <folly/Synchronized.h>
+
+namespace facebook::velox::common {
+
+namespace {
+folly::Synchronized<std::shared_ptr<HardwareDecompressor>>&
+registeredDecompressor() {
+  static folly::Synchronized<std::shared_ptr<HardwareDecompressor>> instance;
+  return instance;
+}
+} // namespace
+
+std::shared_ptr<HardwareDecompressor> hardwareDecompressor() {
+  return *registeredDecompressor().rlock();
+}
+
+void setHardwareDecompressor(
+    std::shared_ptr<HardwareDecompressor> decompressor) {
+  *registeredDecompressor().wlock() = std::move(decompressor);
+}
+
+} // namespace facebook::velox::common
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/futures/Future.h>
+
+#include "velox/common/compression/Compression.h"
+
+namespace facebook::velox::common {
+
+/// Decompresses blocks on an accelerator, e.g. Intel IAA through QPL for
+/// deflate or QAT for zstd and lz4. Velox does not depend on the accelerator
+/// libraries. An implementation is registered with setHardwareDecompressor()
+/// by the process that embeds Velox. The DWRF and Parquet readers then offload
+/// the blocks they can and decompress in software when the accelerator fails.
+class HardwareDecompressor {
+ public:
+  virtual ~HardwareDecompressor() = default;
+
+  /// Returns true if blocks of 'kind' can be offloaded. 'windowBits' are the
+  /// zlib window bits for ZLIB and GZIP, negative for raw deflate, and 0 for
+  /// other kinds.
+  virtual bool supports(CompressionKind kind, int32_t windowBits) const = 0;
+
+  /// Submits the decompression of 'input' into 'output'. The result is the
+  /// decompressed size. 'input' and 'output' must stay valid until the
+  /// future is complete. The future has an error if the accelerator can not
+  /// decompress the block, e.g. if its queue is full or the block is corrupt.
+  virtual folly::SemiFuture<uint64_t> decompress(
+      CompressionKind kind,
+      int32_t windowBits,
+      folly::StringPiece input,
+      folly::MutableStringPiece output) = 0;
+};
+
+/// Returns the registered decompressor, nullptr if none.
+std::shared_ptr<HardwareDecompressor> hardwareDecompressor();
+
+/// Registers 'decompressor' for the readers. nullptr unregisters.
+void setHardwareDecompressor(
+    std::shared_ptr<HardwareDecompressor> decompressor);
+
+} // namespace facebook::velox::common
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/compression/ZstdDictionary.h"
+
+#include <zdict.h>
+#include <zstd.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::common {
+
+class ZstdDictionaryCodec : public folly::io::Codec {
+ public:
+  explicit ZstdDictionaryCodec(std::shared_ptr<const ZstdDictionary> dictionary)
+      : Codec(folly::io::CodecType::ZSTD, folly::none, "zstd_dict", false),
+        dictionary_(std::move(dictionary)),
+        compressContext_(ZSTD_createCCtx()),
+        decompressContext_(ZSTD_createDCtx()) {
+    VELOX_CHECK_NOT_NULL(compressContext_);
+    VELOX_CHECK_NOT_NULL(decompressContext_);
+  }
+
+  ~ZstdDictionaryCodec() override {
+    ZSTD_freeCCtx(compressContext_);
+    ZSTD_freeDCtx(decompressContext_);
+  }
+
+ private:
+  uint64_t doMaxCompressedLength(uint64_t uncompressedLength) const override {
+    return ZSTD_compressBound(uncompressedLength);
+  }
+
+  std::unique_ptr<folly::IOBuf> doCompress(const folly::IOBuf* data) override {
+    const auto input = data->cloneCoalescedAsValue();
+    auto output = folly::IOBuf::create(ZSTD_compressBound(input.length()));
+    const auto size = ZSTD_compress_usingCDict(
+        compressContext_,
+        output->writableData(),
+        output->capacity(),
+        input.data(),
+        input.length(),
+        dictionary_->compressDictionary_);
+    VELOX_CHECK(
+        !ZSTD_isError(size),
+        "ZSTD compression failed: {}",
+        ZSTD_getErrorName(size));
+    output->append(size);
+    return output;
+  }
+
+  std::unique_ptr<folly::IOBuf> doUncompress(
+      const folly::IOBuf* data,
+      folly::Optional<uint64_t> uncompressedLength) override {
+    const auto input = data->cloneCoalescedAsValue();
+    uint64_t size = uncompressedLength.has_value()
+        ? uncompressedLength.value()
+        : ZSTD_getFrameContentSize(input.data(), input.length());
+    VELOX_CHECK(
+        size != ZSTD_CONTENTSIZE_UNKNOWN && size != ZSTD_CONTENTSIZE_ERROR,
+        "ZSTD frame without content size");
+    auto output = folly::IOBuf::create(size);
+    const auto result = ZSTD_decompress_usingDDict(
+        decompressContext_,
+        output->writableData(),
+        size,
+        input.data(),
+        input.length(),
+        dictionary_->decompressDictionary_);
+    VELOX_CHECK(
+        !ZSTD_isError(result),
+        "ZSTD decompression failed: {}",
+        ZSTD_getErrorName(result));
+    VELOX_CHECK_EQ(result, size, "ZSTD decompressed size mismatch");
+    output->append(result);
+    return output;
+  }
+
+  const std::shared_ptr<const ZstdDictionary> dictionary_;
+  ZSTD_CCtx* const compressContext_;
+  ZSTD_DCtx* const decompressContext_;
+};
+
+ZstdDictionary::ZstdDictionary(std::string data, int32_t level)
+    : data_(std::move(data)),
+      compressDictionary_(ZSTD_createCDict(data_.data(), data_.size(), level)),
+      decompressDictionary_(ZSTD_createDDict(data_.data(), data_.size())) {
+  VELOX_CHECK_NOT_NULL(compressDictionary_);
+  VELOX_CHECK_NOT_NULL(decompressDictionary_);
+}
+
+ZstdDictionary::~ZstdDictionary() {
+  ZSTD_freeCDict(compressDictionary_);
+  ZSTD_freeDDict(decompressDictionary_);
+}
+
+// static
+std::shared_ptr<const ZstdDictionary> ZstdDictionary::train(
+    const std::vector<std::string_view>& samples,
+    size_t maxSize,
+    int32_t level) {
+  std::string buffer;
+  std::vector<size_t> sampleSizes;
+  sampleSizes.reserve(samples.size());
+  for (const auto& sample : samples) {
+    buffer.append(sample);
+    sampleSizes.push_back(sample.size());
+  }
+  std::string data(maxSize, '\0');
+  const auto size = ZDICT_trainFromBuffer(
+      data.data(),
+      data.size(),
+      buffer.data(),
+      sampleSizes.data(),
+      sampleSizes.size());
+  if (ZDICT_isError(size)) {
+    return nullptr;
+  }
+  data.resize(size);
+  return std::make_shared<ZstdDictionary>(std::move(data), level);
+}
+
+std::unique_ptr<folly::io::Codec> ZstdDictionary::makeCodec() const {
+  return std::make_unique<ZstdDictionaryCodec>(shared_from_this());
+}
+
+} // namespace facebook::velox::common
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/compression/Compression.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+typedef struct ZSTD_CDict_s ZSTD_CDict;
+typedef struct ZSTD_DDict_s ZSTD_DDict;
+
+namespace facebook::velox::common {
+
+/// A trained ZSTD dictionary. Small pages compress much better with a
+/// dictionary trained from samples of similar data, because each page on its
+/// own is too short for the compressor to learn its repetitions. The
+/// dictionary is not stored in the compressed data, so the reader must have
+/// the same dictionary, e.g. for data that is written and read by the same
+/// process like spill files. Thread-safe.
+class ZstdDictionary : public std::enable_shared_from_this<ZstdDictionary> {
+ public:
+  /// Makes a dictionary from 'data', which is a dictionary from train() or a
+  /// raw content dictionary. Compresses with 'level'. Must be owned by a
+  /// shared_ptr.
+  ZstdDictionary(std::string data, int32_t level);
+
+  ~ZstdDictionary();
+
+  /// Trains a dictionary of at most 'maxSize' bytes from 'samples'. Returns
+  /// nullptr if there are too few samples to train on.
+  static std::shared_ptr<const ZstdDictionary> train(
+      const std::vector<std::string_view>& samples,
+      size_t maxSize,
+      int32_t level);
+
+  const std::string& data() const {
+    return data_;
+  }
+
+  /// Returns a ZSTD codec that compresses and uncompresses with 'this'. The
+  /// codec keeps 'this' alive.
+  std::unique_ptr<folly::io::Codec> makeCodec() const;
+
+ private:
+  const std::string data_;
+  ZSTD_CDict* const compressDictionary_;
+  ZSTD_DDict* const decompressDictionary_;
+
+  friend class ZstdDictionaryCodec;
+};
+
+} // namespace facebook::velox::common
@@ -19,6 +19,7 @@
 #include "velox/common/base/VeloxException.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/common/compression/ZstdDictionary.h"
 
 namespace facebook::velox::common {
 
@@ -59,4 +60,38 @@ TEST_F(CompressionTest, stringToCompressionKind) {
   VELOX_ASSERT_THROW(
       stringToCompressionKind("bz2"), "Not support compression kind bz2");
 }
+
+TEST_F(CompressionTest, zstdDictionary) {
+  std::vector<std::string> rows;
+  for (auto i = 0; i < 1'000; ++i) {
+    rows.push_back(fmt::format(
+        "{{\"id\": {}, \"name\": \"customer#{}\", \"nation\": {}}}",
+        i,
+        i * 7,
+        i % 25));
+  }
+  std::vector<std::string_view> samples(rows.begin(), rows.end());
+  ASSERT_EQ(ZstdDictionary::train({samples[0]}, 1 << 10, 1), nullptr);
+  auto dictionary = ZstdDictionary::train(samples, 1 << 10, 1);
+  ASSERT_NE(dictionary, nullptr);
+  ASSERT_LE(dictionary->data().size(), 1 << 10);
+
+  auto codec = dictionary->makeCodec();
+  ASSERT_EQ(codec->type(), folly::io::CodecType::ZSTD);
+  auto plainCodec = compressionKindToCodec(CompressionKind_ZSTD);
+  const auto& row = rows[17];
+  const auto input = folly::IOBuf::wrapBuffer(row.data(), row.size());
+  auto compressed = codec->compress(input.get());
+  auto plainCompressed = plainCodec->compress(input.get());
+  ASSERT_LT(
+      compressed->computeChainDataLength(),
+      plainCompressed->computeChainDataLength());
+  auto uncompressed = codec->uncompress(compressed.get(), row.size());
+  ASSERT_EQ(uncompressed->moveToFbString().toStdString(), row);
+
+  // The codec keeps the dictionary alive.
+  dictionary.reset();
+  uncompressed = codec->uncompress(compressed.get());
+  ASSERT_EQ(uncompressed->moveToFbString().toStdString(), row);
+}
 } // namespace facebook::velox::common
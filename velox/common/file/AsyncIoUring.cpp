@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/AsyncIoUring.h"
+
+#include <folly/String.h>
+#include <glog/logging.h>
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/file/IoUring.h"
+
+#include <climits>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+namespace facebook::velox {
+
+#ifdef VELOX_ENABLE_IO_URING
+namespace {
+
+struct ReadRequest {
+  std::vector<iovec> iovecs;
+  folly::Promise<uint64_t> promise;
+};
+
+folly::exception_wrapper makeIoError(const std::string& message) {
+  try {
+    VELOX_FAIL("{}", message);
+  } catch (const std::exception&) {
+    return folly::exception_wrapper(std::current_exception());
+  }
+}
+
+class AsyncIoUringImpl : public AsyncIoUring {
+ public:
+  explicit AsyncIoUringImpl(std::unique_ptr<IoUring> ring)
+      : ring_(std::move(ring)) {}
+
+  // Returns nullptr if io_uring is not available. The returned ring is never
+  // destroyed since its reaper thread runs for the life of the process.
+  static AsyncIoUringImpl* create() {
+    auto ring = IoUring::create(kQueueDepth);
+    if (ring == nullptr) {
+      return nullptr;
+    }
+    auto* impl = new AsyncIoUringImpl(std::move(ring));
+    std::thread([impl]() { impl->reap(); }).detach();
+    return impl;
+  }
+
+  folly::SemiFuture<uint64_t>
+  readv(int32_t fd, uint64_t offset, std::vector<iovec> iovecs) override {
+    VELOX_CHECK_LE(iovecs.size(), IOV_MAX);
+    auto request = std::make_unique<ReadRequest>();
+    request->iovecs = std::move(iovecs);
+    auto future = request->promise.getSemiFuture();
+
+    std::unique_lock<std::mutex> l(mutex_);
+    capacity_.wait(
+        l, [&]() { return !error_.empty() || numInFlight_ < kQueueDepth; });
+    VELOX_CHECK(error_.empty(), "{}", error_);
+    VELOX_CHECK(ring_->prepare(
+        false,
+        fd,
+        request->iovecs.data(),
+        request->iovecs.size(),
+        offset,
+        request.get()));
+    // The entry is reaped even if its submission fails, see below.
+    ++numInFlight_;
+    const auto rc = ring_->submit();
+    if (rc <= 0) {
+      // The entry stays queued in the ring. Makes it a no-op so that its
+      // later submission does not refer to 'request'.
+      ring_->cancelLastPrepared();
+      VELOX_FAIL("io_uring_submit failed: {}", rc);
+    }
+    inFlight_.insert(request.get());
+    request.release();
+    return future;
+  }
+
+ private:
+  // Completes the reads until waiting for a completion fails.
+  void reap() {
+    for (;;) {
+      void* data;
+      int32_t result;
+      const auto rc = ring_->wait(data, result);
+      if (rc < 0) {
+        failInFlight(rc);
+        return;
+      }
+      std::unique_ptr<ReadRequest> request(static_cast<ReadRequest*>(data));
+      {
+        std::lock_guard<std::mutex> l(mutex_);
+        --numInFlight_;
+        inFlight_.erase(request.get());
+      }
+      capacity_.notify_one();
+      if (request == nullptr) {
+        continue;
+      }
+      if (result < 0) {
+        request->promise.setException(makeIoError(fmt::format(
+            "io_uring read failed: {}", folly::errnoStr(-result))));
+        continue;
+      }
+      request->promise.setValue(result);
+    }
+  }
+
+  // Fails the reads in flight and all later reads after waiting for a
+  // completion failed with 'rc'. Throwing on the reaper thread would
+  // terminate the process.
+  void failInFlight(int32_t rc) {
+    const auto error =
+        fmt::format("io_uring_wait_cqe failed: {}", folly::errnoStr(-rc));
+    LOG(ERROR) << error;
+    std::unordered_set<ReadRequest*> inFlight;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      error_ = error;
+      inFlight.swap(inFlight_);
+    }
+    capacity_.notify_all();
+    for (auto* request : inFlight) {
+      std::unique_ptr<ReadRequest> owned(request);
+      owned->promise.setException(makeIoError(error));
+    }
+  }
+
+  const std::unique_ptr<IoUring> ring_;
+  // Serializes submissions. Completions are reaped concurrently by the
+  // reaper thread.
+  std::mutex mutex_;
+  std::condition_variable capacity_;
+  int32_t numInFlight_{0};
+  // The submitted reads that are not completed.
+  std::unordered_set<ReadRequest*> inFlight_;
+  // Set if the ring failed. No more reads are submitted then.
+  std::string error_;
+};
+} // namespace
+
+// static
+AsyncIoUring* AsyncIoUring::instance() {
+  static AsyncIoUring* ring = AsyncIoUringImpl::create();
+  return ring;
+}
+
+#else
+
+// static
+AsyncIoUring* AsyncIoUring::instance() {
+  return nullptr;
+}
+
+#endif // VELOX_ENABLE_IO_URING
+} // namespace facebook::velox
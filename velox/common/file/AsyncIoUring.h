@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/futures/Future.h>
+#include <folly/portability/SysUio.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox {
+
+/// A process-wide io_uring that runs asynchronous reads of local files. Reads
+/// are submitted on the calling thread and completed on a thread that reaps
+/// the completions, so that no thread is blocked per read in flight. Usable
+/// only if built with VELOX_ENABLE_IO_URING and supported by the kernel.
+class AsyncIoUring {
+ public:
+  /// Maximum number of reads in flight. readv() blocks while this many are
+  /// in flight.
+  static constexpr int32_t kQueueDepth = 256;
+
+  virtual ~AsyncIoUring() = default;
+
+  /// Returns the process-wide ring or nullptr if io_uring can not be used.
+  static AsyncIoUring* instance();
+
+  /// Reads into 'iovecs' from 'fd' at 'offset'. The memory 'iovecs' point to
+  /// must stay valid until the result is set. The result is the number of
+  /// bytes read, which is less than the size of 'iovecs' at the end of the
+  /// file. There are at most IOV_MAX 'iovecs'. If waiting for completions
+  /// fails, the reads in flight get the error and later reads throw.
+  virtual folly::SemiFuture<uint64_t>
+  readv(int32_t fd, uint64_t offset, std::vector<iovec> iovecs) = 0;
+};
+
+} // namespace facebook::velox
@@ -16,17 +16,88 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/base/Fs.h"
+#include "velox/common/file/AsyncIoUring.h"
 
 #include <fmt/format.h>
+#include <folly/String.h>
 #include <glog/logging.h>
 #include <memory>
 #include <stdexcept>
 
 #include <fcntl.h>
 #include <folly/portability/SysUio.h>
+#include <unistd.h>
 
 namespace facebook::velox {
 
+namespace {
+#ifdef O_DIRECT
+constexpr int32_t kODirect = O_DIRECT;
+#else
+constexpr int32_t kODirect = 0;
+#endif
+
+// Maximum size of the aligned buffer of a synchronous direct read.
+constexpr uint64_t kMaxDirectReadSize = 8 << 20;
+
+// Size of the scratch buffer the gaps of coalesced reads are read into.
+constexpr uint64_t kDroppedBytesSize = 16 * 1024;
+
+using DirectBuffer = std::unique_ptr<char, decltype(&::free)>;
+
+uint64_t alignDown(uint64_t value) {
+  return value & ~(LocalFileOptions::kDirectIoAlignment - 1);
+}
+
+uint64_t alignUp(uint64_t value) {
+  return alignDown(value + LocalFileOptions::kDirectIoAlignment - 1);
+}
+
+DirectBuffer allocateDirectBuffer(uint64_t size) {
+  void* data{nullptr};
+  VELOX_CHECK_EQ(
+      posix_memalign(&data, LocalFileOptions::kDirectIoAlignment, size),
+      0,
+      "Failed to allocate {} bytes for direct IO",
+      size);
+  return DirectBuffer(static_cast<char*>(data), &::free);
+}
+
+// Copies the 'dataSize' bytes of 'data' that start at file offset
+// 'dataOffset' into the parts of 'buffers' they overlap. 'buffers' start at
+// file offset 'offset'. Gaps with nullptr data are skipped.
+void copyToBuffers(
+    const char* data,
+    uint64_t dataOffset,
+    uint64_t dataSize,
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) {
+  const auto dataEnd = dataOffset + dataSize;
+  for (const auto& range : buffers) {
+    if (offset >= dataEnd) {
+      break;
+    }
+    const auto begin = std::max(offset, dataOffset);
+    const auto end = std::min<uint64_t>(offset + range.size(), dataEnd);
+    if (range.data() != nullptr && begin < end) {
+      ::memcpy(
+          range.data() + (begin - offset),
+          data + (begin - dataOffset),
+          end - begin);
+    }
+    offset += range.size();
+  }
+}
+
+uint64_t totalSize(const std::vector<folly::Range<char*>>& buffers) {
+  uint64_t size = 0;
+  for (const auto& range : buffers) {
+    size += range.size();
+  }
+  return size;
+}
+} // namespace
+
 #define RETURN_IF_ERROR(func, result) \
   result = func;                      \
   if (result < 0) {                   \
@@ -101,8 +172,29 @@ uint64_t InMemoryWriteFile::size() const {
   return file_->size();
 }
 
-LocalReadFile::LocalReadFile(std::string_view path) : path_(path) {
-  fd_ = open(path_.c_str(), O_RDONLY);
+// static
+LocalFileOptions LocalFileOptions::parse(std::string_view fileCreateConfig) {
+  LocalFileOptions options;
+  std::vector<folly::StringPiece> tokens;
+  folly::split(',', folly::StringPiece(fileCreateConfig), tokens);
+  for (auto token : tokens) {
+    token = folly::trimWhitespace(token);
+    if (token == "io_uring") {
+      options.ioUring = true;
+    } else if (token == "direct") {
+      options.directIo = true;
+    }
+  }
+  return options;
+}
+
+LocalReadFile::LocalReadFile(std::string_view path, LocalFileOptions options)
+    : path_(path), options_(options) {
+  fd_ = open(path_.c_str(), O_RDONLY | (options_.directIo ? kODirect : 0));
+  if (fd_ < 0 && options_.directIo && errno == EINVAL) {
+    // The file system does not support O_DIRECT. Reads stay aligned.
+    fd_ = open(path_.c_str(), O_RDONLY);
+  }
   if (fd_ < 0) {
     if (errno == ENOENT) {
       VELOX_FILE_NOT_FOUND_ERROR("No such file or directory: {}", path);
@@ -123,6 +215,9 @@ LocalReadFile::LocalReadFile(std::string_view path) : path_(path) {
       path,
       folly::errnoStr(errno));
   size_ = rc;
+  if (options_.ioUring) {
+    ioUring_ = AsyncIoUring::instance();
+  }
 }
 
 LocalReadFile::LocalReadFile(int32_t fd) : fd_(fd) {}
@@ -138,6 +233,17 @@ LocalReadFile::~LocalReadFile() {
 void LocalReadFile::preadInternal(uint64_t offset, uint64_t length, char* pos)
     const {
   bytesRead_ += length;
+  if (options_.directIo) {
+    const auto bytesRead =
+        preadvDirect(offset, {folly::Range<char*>(pos, length)});
+    VELOX_CHECK_EQ(
+        bytesRead,
+        length,
+        "fread failure in LocalReadFile::PReadInternal, {} vs {}.",
+        bytesRead,
+        length);
+    return;
+  }
   auto bytesRead = ::pread(fd_, pos, length, offset);
   VELOX_CHECK_EQ(
       bytesRead,
@@ -156,9 +262,12 @@ LocalReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
 uint64_t LocalReadFile::preadv(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) const {
+  if (options_.directIo) {
+    return preadvDirect(offset, buffers);
+  }
   // Dropped bytes sized so that a typical dropped range of 50K is not
   // too many iovecs.
-  static thread_local std::vector<char> droppedBytes(16 * 1024);
+  static thread_local std::vector<char> droppedBytes(kDroppedBytesSize);
   uint64_t totalBytesRead = 0;
   std::vector<struct iovec> iovecs;
   iovecs.reserve(buffers.size());
@@ -209,6 +318,84 @@ uint64_t LocalReadFile::preadv(
   return totalBytesRead;
 }
 
+uint64_t LocalReadFile::preadvDirect(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  const uint64_t end =
+      std::min<uint64_t>(offset + totalSize(buffers), size_);
+  if (offset >= end) {
+    return 0;
+  }
+  const auto alignedEnd = alignUp(end);
+  auto buffer = allocateDirectBuffer(
+      std::min(kMaxDirectReadSize, alignedEnd - alignDown(offset)));
+  for (auto readOffset = alignDown(offset); readOffset < end;) {
+    const auto readSize = std::min(kMaxDirectReadSize, alignedEnd - readOffset);
+    const auto bytesRead = ::pread(fd_, buffer.get(), readSize, readOffset);
+    VELOX_CHECK_GT(
+        bytesRead,
+        0,
+        "pread failure in LocalReadFile::preadvDirect, {} {}.",
+        path_,
+        folly::errnoStr(errno));
+    copyToBuffers(buffer.get(), readOffset, bytesRead, offset, buffers);
+    readOffset += bytesRead;
+  }
+  return end - offset;
+}
+
+folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  if (ioUring_ == nullptr) {
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+  try {
+    if (offset >= static_cast<uint64_t>(size_)) {
+      return folly::SemiFuture<uint64_t>(0);
+    }
+    const auto length = std::min<uint64_t>(totalSize(buffers), size_ - offset);
+    if (options_.directIo) {
+      const auto alignedOffset = alignDown(offset);
+      const auto alignedSize = alignUp(offset + length) - alignedOffset;
+      std::shared_ptr<char> buffer = allocateDirectBuffer(alignedSize);
+      return ioUring_->readv(fd_, alignedOffset, {{buffer.get(), alignedSize}})
+          .deferValue([buffer, buffers, offset, alignedOffset, length](
+                          uint64_t bytesRead) {
+            copyToBuffers(
+                buffer.get(), alignedOffset, bytesRead, offset, buffers);
+            const auto skipped = offset - alignedOffset;
+            return bytesRead > skipped ? std::min(length, bytesRead - skipped)
+                                       : uint64_t{0};
+          });
+    }
+    // The gaps of coalesced reads go to a scratch buffer that lives until
+    // the read completes.
+    auto droppedBytes = std::make_shared<std::vector<char>>(kDroppedBytesSize);
+    std::vector<iovec> iovecs;
+    iovecs.reserve(buffers.size());
+    for (const auto& range : buffers) {
+      if (range.data() != nullptr) {
+        iovecs.push_back({range.data(), range.size()});
+        continue;
+      }
+      for (auto skipSize = range.size(); skipSize > 0;) {
+        const auto bytes = std::min<size_t>(droppedBytes->size(), skipSize);
+        iovecs.push_back({droppedBytes->data(), bytes});
+        skipSize -= bytes;
+      }
+    }
+    if (iovecs.size() > IOV_MAX) {
+      return ReadFile::preadvAsync(offset, buffers);
+    }
+    return ioUring_->readv(fd_, offset, std::move(iovecs))
+        .deferValue([droppedBytes](uint64_t bytesRead) { return bytesRead; });
+  } catch (const std::exception&) {
+    return folly::makeSemiFuture<uint64_t>(
+        folly::exception_wrapper(std::current_exception()));
+  }
+}
+
 uint64_t LocalReadFile::size() const {
   return size_;
 }
@@ -221,6 +408,159 @@ uint64_t LocalReadFile::memoryUsage() const {
   return sizeof(FILE);
 }
 
+LocalDirectWriteFile::LocalDirectWriteFile(
+    std::string_view path,
+    bool shouldCreateParentDirectories,
+    bool shouldThrowOnFileAlreadyExists)
+    : path_(path) {
+  auto dir = fs::path(path_).parent_path();
+  if (shouldCreateParentDirectories && !fs::exists(dir)) {
+    VELOX_CHECK(
+        common::generateFileDirectory(dir.c_str()),
+        "Failed to generate file directory");
+  }
+  const int32_t flags =
+      O_RDWR | O_CREAT | (shouldThrowOnFileAlreadyExists ? O_EXCL : 0);
+  const mode_t mode = S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH;
+  fd_ = open(path_.c_str(), flags | kODirect, mode);
+  if (fd_ < 0 && errno == EINVAL) {
+    // The file system does not support O_DIRECT. Writes stay aligned.
+    fd_ = open(path_.c_str(), flags, mode);
+  }
+  VELOX_CHECK(
+      fd_ >= 0 || errno != EEXIST,
+      "Failure in LocalDirectWriteFile: path '{}' already exists.",
+      path);
+  VELOX_CHECK_GE(
+      fd_,
+      0,
+      "open failure in LocalDirectWriteFile constructor, {} {}.",
+      path,
+      folly::errnoStr(errno));
+  buffer_ = allocateDirectBuffer(kBufferSize);
+  // Appends to an existing file. Its partial last block is buffered to be
+  // written again with the appended data.
+  const off_t fileSize = lseek(fd_, 0, SEEK_END);
+  VELOX_CHECK_GE(
+      fileSize,
+      0,
+      "lseek failure in LocalDirectWriteFile constructor, {} {}.",
+      path,
+      folly::errnoStr(errno));
+  size_ = fileSize;
+  bufferOffset_ = alignDown(size_);
+  bufferedBytes_ = size_ - bufferOffset_;
+  if (bufferedBytes_ > 0) {
+    const auto bytesRead = ::pread(
+        fd_,
+        buffer_.get(),
+        LocalFileOptions::kDirectIoAlignment,
+        bufferOffset_);
+    VELOX_CHECK_EQ(
+        bytesRead,
+        static_cast<ssize_t>(bufferedBytes_),
+        "pread failure in LocalDirectWriteFile constructor, {} {}.",
+        path,
+        folly::errnoStr(errno));
+  }
+}
+
+LocalDirectWriteFile::~LocalDirectWriteFile() {
+  try {
+    close();
+  } catch (const std::exception& ex) {
+    // We cannot throw an exception from the destructor. Warn instead.
+    LOG(WARNING) << "close failure in LocalDirectWriteFile destructor: "
+                 << ex.what();
+  }
+}
+
+void LocalDirectWriteFile::append(std::string_view data) {
+  VELOX_CHECK(!closed_, "file is closed");
+  while (!data.empty()) {
+    const auto bytes =
+        std::min<uint64_t>(data.size(), kBufferSize - bufferedBytes_);
+    ::memcpy(buffer_.get() + bufferedBytes_, data.data(), bytes);
+    bufferedBytes_ += bytes;
+    size_ += bytes;
+    data.remove_prefix(bytes);
+    if (bufferedBytes_ == kBufferSize) {
+      writeBuffer(kBufferSize);
+      bufferOffset_ += kBufferSize;
+      bufferedBytes_ = 0;
+    }
+  }
+}
+
+void LocalDirectWriteFile::append(std::unique_ptr<folly::IOBuf> data) {
+  for (auto rangeIter = data->begin(); rangeIter != data->end(); ++rangeIter) {
+    append(std::string_view(
+        reinterpret_cast<const char*>(rangeIter->data()), rangeIter->size()));
+  }
+}
+
+void LocalDirectWriteFile::writeBuffer(uint64_t length) {
+  uint64_t bytesWritten = 0;
+  while (bytesWritten < length) {
+    const auto rc = ::pwrite(
+        fd_,
+        buffer_.get() + bytesWritten,
+        length - bytesWritten,
+        bufferOffset_ + bytesWritten);
+    VELOX_CHECK_GT(
+        rc,
+        0,
+        "pwrite failure in LocalDirectWriteFile, {} {}.",
+        path_,
+        folly::errnoStr(errno));
+    bytesWritten += rc;
+  }
+}
+
+void LocalDirectWriteFile::flushBuffer() {
+  if (bufferedBytes_ == 0) {
+    return;
+  }
+  const auto paddedBytes = alignUp(bufferedBytes_);
+  ::memset(buffer_.get() + bufferedBytes_, 0, paddedBytes - bufferedBytes_);
+  writeBuffer(paddedBytes);
+  if (paddedBytes > bufferedBytes_) {
+    VELOX_CHECK_EQ(
+        ftruncate(fd_, size_),
+        0,
+        "ftruncate failure in LocalDirectWriteFile, {} {}.",
+        path_,
+        folly::errnoStr(errno));
+  }
+  const auto fullBytes = alignDown(bufferedBytes_);
+  if (fullBytes > 0) {
+    ::memmove(
+        buffer_.get(), buffer_.get() + fullBytes, bufferedBytes_ - fullBytes);
+    bufferOffset_ += fullBytes;
+    bufferedBytes_ -= fullBytes;
+  }
+}
+
+void LocalDirectWriteFile::flush() {
+  VELOX_CHECK(!closed_, "file is closed");
+  flushBuffer();
+}
+
+void LocalDirectWriteFile::close() {
+  if (closed_) {
+    return;
+  }
+  flushBuffer();
+  const auto ret = ::close(fd_);
+  VELOX_CHECK_EQ(
+      ret,
+      0,
+      "close failure in LocalDirectWriteFile::close: {}.",
+      folly::errnoStr(errno));
+  buffer_.reset();
+  closed_ = true;
+}
+
 LocalWriteFile::LocalWriteFile(
     std::string_view path,
     bool shouldCreateParentDirectories,
@@ -29,7 +29,10 @@
 #include <atomic>
 #include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <functional>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -130,6 +133,15 @@ class ReadFile {
   //
   virtual uint64_t getNaturalReadSize() const = 0;
 
+  // Returns the number of bytes of the 'length' bytes at 'offset' that are
+  // stored on this host, or std::nullopt if the file does not know where its
+  // data is stored.
+  virtual std::optional<uint64_t> localBytes(
+      uint64_t /*offset*/,
+      uint64_t /*length*/) const {
+    return std::nullopt;
+  }
+
  protected:
   mutable std::atomic<uint64_t> bytesRead_ = 0;
 };
@@ -225,12 +237,38 @@ class InMemoryWriteFile final : public WriteFile {
   std::string* file_;
 };
 
+class AsyncIoUring;
+
+/// IO options of local files. The local file system parses them from the
+/// FileOptions::kFileCreateConfig of openFileForRead() and
+/// openFileForWrite(), e.g. from the spill file create config. The config is
+/// a comma separated list of tokens. Unknown tokens are ignored.
+struct LocalFileOptions {
+  /// Offsets, lengths and buffers of direct IO are multiples of this.
+  static constexpr uint64_t kDirectIoAlignment = 4096;
+
+  /// 'io_uring': preadvAsync() of LocalReadFile is served natively through
+  /// io_uring. Ignored if Velox is built without VELOX_ENABLE_IO_URING or
+  /// the kernel does not support io_uring.
+  bool ioUring{false};
+
+  /// 'direct': files are opened with O_DIRECT and read and written in
+  /// aligned blocks, bypassing the page cache. Files of a file system that
+  /// does not support O_DIRECT are read and written in aligned blocks
+  /// through the page cache.
+  bool directIo{false};
+
+  static LocalFileOptions parse(std::string_view fileCreateConfig);
+};
+
 /// Current implementation for the local version is quite simple (e.g. no
 /// internal arenaing), as local disk writes are expected to be cheap. Local
 /// files match against any filepath starting with '/'.
 class LocalReadFile final : public ReadFile {
  public:
-  explicit LocalReadFile(std::string_view path);
+  explicit LocalReadFile(
+      std::string_view path,
+      LocalFileOptions options = {});
 
   /// TODO: deprecate this after creating local file all through velox fs
   /// interface.
@@ -247,6 +285,14 @@ class LocalReadFile final : public ReadFile {
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const final;
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final {
+    return ioUring_ != nullptr;
+  }
+
   uint64_t memoryUsage() const final;
 
   bool shouldCoalesce() const final {
@@ -264,12 +310,78 @@ class LocalReadFile final : public ReadFile {
     return 10 << 20;
   }
 
+  /// Returns the file descriptor, e.g. for mapping the file into memory.
+  int32_t fd() const {
+    return fd_;
+  }
+
+  /// True if reads bypass the page cache.
+  bool directIo() const {
+    return options_.directIo;
+  }
+
  private:
   void preadInternal(uint64_t offset, uint64_t length, char* pos) const;
 
+  // Reads 'buffers' starting at 'offset' in aligned blocks for direct IO.
+  // Returns the number of bytes read, which is less than the size of
+  // 'buffers' only at the end of the file.
+  uint64_t preadvDirect(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const;
+
   std::string path_;
   int32_t fd_;
   long size_;
+  LocalFileOptions options_;
+  // Ring for preadvAsync() or nullptr if preadvAsync() is synchronous.
+  AsyncIoUring* ioUring_{nullptr};
+};
+
+/// Writes a local file with O_DIRECT. Appended data is collected in an
+/// aligned buffer that is written in whole blocks when full. flush() and
+/// close() write the partial last block padded to the alignment and truncate
+/// the file to its size. The partial block stays buffered and is written
+/// again with the next block.
+class LocalDirectWriteFile final : public WriteFile {
+ public:
+  /// Same as LocalWriteFile. Appends to an existing file if
+  /// 'shouldThrowOnFileAlreadyExists' is false.
+  explicit LocalDirectWriteFile(
+      std::string_view path,
+      bool shouldCreateParentDirectories = false,
+      bool shouldThrowOnFileAlreadyExists = true);
+  ~LocalDirectWriteFile();
+
+  void append(std::string_view data) final;
+  void append(std::unique_ptr<folly::IOBuf> data) final;
+  void flush() final;
+  void close() final;
+
+  uint64_t size() const final {
+    return size_;
+  }
+
+ private:
+  static constexpr uint64_t kBufferSize = 1 << 20;
+
+  // Writes 'length' bytes of 'buffer_', a multiple of the alignment, at
+  // 'bufferOffset_'.
+  void writeBuffer(uint64_t length);
+
+  // Writes the buffered data and moves the partial last block to the start
+  // of 'buffer_'.
+  void flushBuffer();
+
+  const std::string path_;
+  int32_t fd_{-1};
+  std::unique_ptr<char, decltype(&::free)> buffer_{nullptr, &::free};
+  // File offset of the start of 'buffer_'. A multiple of the alignment.
+  uint64_t bufferOffset_{0};
+  // Number of bytes of data in 'buffer_'.
+  uint64_t bufferedBytes_{0};
+  uint64_t size_{0};
+  bool closed_{false};
 };
 
 class LocalWriteFile final : public WriteFile {
@@ -77,6 +77,14 @@ class LocalFileSystem : public FileSystem {
     return "Local FS";
   }
 
+  static LocalFileOptions localFileOptions(const FileOptions& options) {
+    auto it = options.values.find(FileOptions::kFileCreateConfig.toString());
+    if (it == options.values.end()) {
+      return {};
+    }
+    return LocalFileOptions::parse(it->second);
+  }
+
   inline std::string_view extractPath(std::string_view path) {
     if (path.find(kFileScheme) == 0) {
       return path.substr(kFileScheme.length());
@@ -86,13 +94,17 @@ class LocalFileSystem : public FileSystem {
 
   std::unique_ptr<ReadFile> openFileForRead(
       std::string_view path,
-      const FileOptions& /*unused*/) override {
-    return std::make_unique<LocalReadFile>(extractPath(path));
+      const FileOptions& options) override {
+    return std::make_unique<LocalReadFile>(
+        extractPath(path), localFileOptions(options));
   }
 
   std::unique_ptr<WriteFile> openFileForWrite(
       std::string_view path,
-      const FileOptions& /*unused*/) override {
+      const FileOptions& options) override {
+    if (localFileOptions(options).directIo) {
+      return std::make_unique<LocalDirectWriteFile>(extractPath(path));
+    }
     return std::make_unique<LocalWriteFile>(extractPath(path));
   }
 
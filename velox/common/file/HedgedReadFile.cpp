@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/HedgedReadFile.h"
+
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox {
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// State shared between a hedged read and its requests. The requests may
+// outlive the read, so the state is reference counted.
+struct HedgedReadState {
+  std::mutex mutex;
+  std::condition_variable cv;
+  // Buffers of the first request and of the hedge.
+  std::array<std::string, 2> buffers;
+  int32_t numStarted{1};
+  int32_t numDone{0};
+  // Index of the request that serves the read or -1.
+  int32_t winner{-1};
+  std::exception_ptr error;
+};
+
+void startRequest(
+    const std::shared_ptr<ReadFile>& file,
+    const std::shared_ptr<HedgedReadPolicy>& policy,
+    const std::shared_ptr<HedgedReadState>& state,
+    int32_t index,
+    uint64_t offset,
+    uint64_t length) {
+  policy->executor()->add(
+      [file, policy, state, index, offset, length, start = Clock::now()]() {
+        std::exception_ptr error;
+        try {
+          file->pread(offset, length, state->buffers[index].data());
+        } catch (const std::exception&) {
+          error = std::current_exception();
+        }
+        const auto latency = std::chrono::duration_cast<
+            std::chrono::microseconds>(Clock::now() - start);
+        bool won = false;
+        {
+          std::lock_guard<std::mutex> l(state->mutex);
+          ++state->numDone;
+          if (error == nullptr && state->winner < 0) {
+            state->winner = index;
+            won = true;
+          } else if (error != nullptr && state->error == nullptr) {
+            state->error = error;
+          }
+        }
+        state->cv.notify_all();
+        // The latency of the first request is recorded even if the hedge
+        // won so that the estimate reflects the latency of storage.
+        if (index == 0 && error == nullptr) {
+          policy->recordLatency(length, latency);
+        }
+        if (index == 1) {
+          policy->finishHedge(won);
+        }
+      });
+}
+} // namespace
+
+HedgedReadPolicy::HedgedReadPolicy(const Options& options)
+    : options_(options),
+      executor_(std::make_unique<folly::IOThreadPoolExecutor>(
+          options.numThreads,
+          std::make_shared<folly::NamedThreadFactory>("HedgedRead"))) {
+  VELOX_CHECK_GT(options_.latencyPercentile, 0);
+  VELOX_CHECK_LE(options_.latencyPercentile, 100);
+  VELOX_CHECK_GT(options_.numThreads, 0);
+}
+
+// static
+int32_t HedgedReadPolicy::sizeClass(uint64_t length) {
+  const int32_t bits = 64 - __builtin_clzll(length | 1);
+  return std::clamp(bits - kMinSizeClassBits, 0, kNumSizeClasses - 1);
+}
+
+std::optional<std::chrono::microseconds> HedgedReadPolicy::hedgeDelay(
+    uint64_t length) const {
+  const auto delayUs = sizeClasses_[sizeClass(length)].delayUs.load(
+      std::memory_order_relaxed);
+  if (delayUs < 0) {
+    return std::nullopt;
+  }
+  return std::chrono::microseconds(delayUs);
+}
+
+void HedgedReadPolicy::recordLatency(
+    uint64_t length,
+    std::chrono::microseconds latency) {
+  auto& sizeClass = sizeClasses_[this->sizeClass(length)];
+  std::lock_guard<std::mutex> l(sizeClass.mutex);
+  sizeClass.samplesUs[sizeClass.nextSample] = std::min<int64_t>(
+      latency.count(), std::numeric_limits<uint32_t>::max());
+  sizeClass.nextSample = (sizeClass.nextSample + 1) % kNumSamples;
+  sizeClass.numSamples = std::min(sizeClass.numSamples + 1, kNumSamples);
+  if (sizeClass.numSamples < kMinSamples ||
+      sizeClass.nextSample % kRecomputeInterval != 0) {
+    return;
+  }
+  std::array<uint32_t, kNumSamples> samples;
+  std::copy(
+      sizeClass.samplesUs.begin(),
+      sizeClass.samplesUs.begin() + sizeClass.numSamples,
+      samples.begin());
+  const auto nth = std::min<int32_t>(
+      sizeClass.numSamples - 1,
+      sizeClass.numSamples * options_.latencyPercentile / 100);
+  std::nth_element(
+      samples.begin(),
+      samples.begin() + nth,
+      samples.begin() + sizeClass.numSamples);
+  sizeClass.delayUs =
+      std::max<int64_t>(samples[nth], options_.minDelay.count());
+}
+
+bool HedgedReadPolicy::tryStartHedge() {
+  if (numInFlightHedges_.fetch_add(1) >= options_.maxInFlightHedges) {
+    --numInFlightHedges_;
+    ++numHedgesSkipped_;
+    return false;
+  }
+  ++numHedges_;
+  return true;
+}
+
+void HedgedReadPolicy::finishHedge(bool won) {
+  if (won) {
+    ++numHedgeWins_;
+  }
+  --numInFlightHedges_;
+}
+
+HedgedReadPolicy::Stats HedgedReadPolicy::stats() const {
+  Stats stats;
+  stats.numHedges = numHedges_;
+  stats.numHedgeWins = numHedgeWins_;
+  stats.numHedgesSkipped = numHedgesSkipped_;
+  return stats;
+}
+
+HedgedReadFile::HedgedReadFile(
+    std::shared_ptr<ReadFile> file,
+    std::shared_ptr<HedgedReadPolicy> policy)
+    : file_(std::move(file)), policy_(std::move(policy)) {
+  VELOX_CHECK_NOT_NULL(file_);
+  VELOX_CHECK_NOT_NULL(policy_);
+}
+
+std::string_view HedgedReadFile::pread(
+    uint64_t offset,
+    uint64_t length,
+    void* buf,
+    HedgeOutcome* outcome) const {
+  if (!policy_->hedgeDelay(length).has_value()) {
+    const auto start = Clock::now();
+    auto data = file_->pread(offset, length, buf);
+    policy_->recordLatency(
+        length,
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - start));
+    return data;
+  }
+  readHedged(offset, length, static_cast<char*>(buf), outcome);
+  return {static_cast<char*>(buf), length};
+}
+
+uint64_t HedgedReadFile::preadv(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    HedgeOutcome* outcome) const {
+  const auto fileSize = size();
+  if (offset >= fileSize) {
+    return 0;
+  }
+  uint64_t length = 0;
+  for (const auto& range : buffers) {
+    length += range.size();
+  }
+  length = std::min(length, fileSize - offset);
+  if (!policy_->hedgeDelay(length).has_value()) {
+    const auto start = Clock::now();
+    const auto numRead = file_->preadv(offset, buffers);
+    policy_->recordLatency(
+        length,
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - start));
+    return numRead;
+  }
+  std::string data(length, '\0');
+  readHedged(offset, length, data.data(), outcome);
+  uint64_t numRead = 0;
+  for (const auto& range : buffers) {
+    const auto copySize = std::min<uint64_t>(range.size(), length - numRead);
+    // NOTE: skip the gap in case of coalesce io.
+    if (range.data() != nullptr) {
+      ::memcpy(range.data(), data.data() + numRead, copySize);
+    }
+    numRead += copySize;
+  }
+  return numRead;
+}
+
+void HedgedReadFile::readHedged(
+    uint64_t offset,
+    uint64_t length,
+    char* buf,
+    HedgeOutcome* outcome) const {
+  const auto delay = policy_->hedgeDelay(length);
+  VELOX_CHECK(delay.has_value());
+  auto state = std::make_shared<HedgedReadState>();
+  state->buffers[0].resize(length);
+  startRequest(file_, policy_, state, 0, offset, length);
+
+  std::unique_lock<std::mutex> l(state->mutex);
+  const bool done = state->cv.wait_for(
+      l, delay.value(), [&]() { return state->numDone > 0; });
+  if (!done && policy_->tryStartHedge()) {
+    state->buffers[1].resize(length);
+    state->numStarted = 2;
+    startRequest(file_, policy_, state, 1, offset, length);
+    if (outcome != nullptr) {
+      outcome->hedged = true;
+    }
+  }
+  state->cv.wait(l, [&]() {
+    return state->winner >= 0 || state->numDone == state->numStarted;
+  });
+  if (state->winner < 0) {
+    std::rethrow_exception(state->error);
+  }
+  // The request that lost may still be writing to its own buffer.
+  ::memcpy(buf, state->buffers[state->winner].data(), length);
+  if (outcome != nullptr) {
+    outcome->hedgeWon = state->winner == 1;
+  }
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/executors/IOThreadPoolExecutor.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include "velox/common/file/File.h"
+
+namespace facebook::velox {
+
+/// Decides when reads of the files of one file system are hedged and bounds
+/// the number of hedges in flight. A read is hedged, i.e. a duplicate request
+/// is issued, if it has not completed within a percentile of the recent
+/// latencies of reads of similar size. Whichever request completes first
+/// serves the read. This cuts the tail latency on object stores where an
+/// occasional request is much slower than the rest. One policy is shared by
+/// all HedgedReadFiles of a file system.
+class HedgedReadPolicy {
+ public:
+  struct Options {
+    /// Percentile of recent latencies after which a read is hedged.
+    int32_t latencyPercentile{95};
+    /// Lower bound of the delay before a read is hedged.
+    std::chrono::microseconds minDelay{std::chrono::milliseconds(10)};
+    /// Maximum number of hedges in flight for the file system.
+    int32_t maxInFlightHedges{16};
+    /// Number of threads that run the reads of the file system.
+    int32_t numThreads{32};
+  };
+
+  struct Stats {
+    uint64_t numHedges{0};
+    uint64_t numHedgeWins{0};
+    /// Reads that were due for a hedge but found 'maxInFlightHedges' hedges
+    /// in flight.
+    uint64_t numHedgesSkipped{0};
+  };
+
+  explicit HedgedReadPolicy(const Options& options);
+
+  /// Returns the delay after which a read of 'length' bytes is hedged or
+  /// std::nullopt if there are not enough latency samples for reads of this
+  /// size yet.
+  std::optional<std::chrono::microseconds> hedgeDelay(uint64_t length) const;
+
+  /// Records the latency of a read of 'length' bytes that was not hedged or
+  /// was served by its first request.
+  void recordLatency(uint64_t length, std::chrono::microseconds latency);
+
+  /// Returns true and counts a hedge in flight if fewer than
+  /// 'maxInFlightHedges' are in flight. finishHedge() must be called for
+  /// each hedge started.
+  bool tryStartHedge();
+
+  /// Ends a hedge started by tryStartHedge(). 'won' is true if the hedge
+  /// completed before the first request.
+  void finishHedge(bool won);
+
+  folly::Executor* executor() const {
+    return executor_.get();
+  }
+
+  const Options& options() const {
+    return options_;
+  }
+
+  Stats stats() const;
+
+ private:
+  // Size classes are powers of two, starting with reads under 128KB.
+  static constexpr int32_t kNumSizeClasses = 12;
+  static constexpr int32_t kMinSizeClassBits = 17;
+  // Latencies are kept for the last 'kNumSamples' reads of each size class.
+  static constexpr int32_t kNumSamples = 256;
+  // Reads are not hedged before a size class has 'kMinSamples' samples.
+  static constexpr int32_t kMinSamples = 32;
+  // The percentile is recomputed every 'kRecomputeInterval' samples.
+  static constexpr int32_t kRecomputeInterval = 16;
+
+  struct SizeClass {
+    std::mutex mutex;
+    std::array<uint32_t, kNumSamples> samplesUs;
+    int32_t numSamples{0};
+    int32_t nextSample{0};
+    // Hedge delay in microseconds or -1 if not known yet.
+    std::atomic<int64_t> delayUs{-1};
+  };
+
+  static int32_t sizeClass(uint64_t length);
+
+  const Options options_;
+  const std::unique_ptr<folly::IOThreadPoolExecutor> executor_;
+  std::array<SizeClass, kNumSizeClasses> sizeClasses_;
+  std::atomic<int32_t> numInFlightHedges_{0};
+  std::atomic<uint64_t> numHedges_{0};
+  std::atomic<uint64_t> numHedgeWins_{0};
+  std::atomic<uint64_t> numHedgesSkipped_{0};
+};
+
+/// Outcome of a read of a HedgedReadFile.
+struct HedgeOutcome {
+  /// True if a duplicate request was issued.
+  bool hedged{false};
+  /// True if the duplicate request served the read.
+  bool hedgeWon{false};
+};
+
+/// ReadFile that hedges the reads of the ReadFile it wraps according to a
+/// HedgedReadPolicy. A read that is not hedged is served on the calling
+/// thread until the policy has latency samples for its size. Once it does,
+/// reads run on the executor of the policy into a private buffer and are
+/// copied to the caller's buffer once the first request completes.
+/// preadvAsync() is passed through without hedging.
+class HedgedReadFile : public ReadFile {
+ public:
+  HedgedReadFile(
+      std::shared_ptr<ReadFile> file,
+      std::shared_ptr<HedgedReadPolicy> policy);
+
+  using ReadFile::pread;
+  using ReadFile::preadv;
+
+  std::string_view pread(uint64_t offset, uint64_t length, void* buf)
+      const override {
+    return pread(offset, length, buf, nullptr);
+  }
+
+  /// Like pread() and sets 'outcome' if not nullptr.
+  std::string_view pread(
+      uint64_t offset,
+      uint64_t length,
+      void* buf,
+      HedgeOutcome* outcome) const;
+
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    return preadv(offset, buffers, nullptr);
+  }
+
+  /// Like preadv() and sets 'outcome' if not nullptr. The buffers are read
+  /// as one hedged read of their total size.
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      HedgeOutcome* outcome) const;
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    return file_->preadvAsync(offset, buffers);
+  }
+
+  bool hasPreadvAsync() const override {
+    return file_->hasPreadvAsync();
+  }
+
+  uint64_t size() const override {
+    return file_->size();
+  }
+
+  uint64_t memoryUsage() const override {
+    return file_->memoryUsage();
+  }
+
+  bool shouldCoalesce() const override {
+    return file_->shouldCoalesce();
+  }
+
+  /// Counts the bytes of both the first requests and the hedges.
+  uint64_t bytesRead() const override {
+    return file_->bytesRead();
+  }
+
+  void resetBytesRead() override {
+    file_->resetBytesRead();
+  }
+
+  std::string getName() const override {
+    return file_->getName();
+  }
+
+  uint64_t getNaturalReadSize() const override {
+    return file_->getNaturalReadSize();
+  }
+
+  std::optional<uint64_t> localBytes(uint64_t offset, uint64_t length)
+      const override {
+    return file_->localBytes(offset, length);
+  }
+
+  const std::shared_ptr<ReadFile>& file() const {
+    return file_;
+  }
+
+  const std::shared_ptr<HedgedReadPolicy>& policy() const {
+    return policy_;
+  }
+
+ private:
+  // Reads 'length' bytes at 'offset' into 'buf', hedging if the policy has
+  // a delay for reads of 'length' bytes.
+  void readHedged(
+      uint64_t offset,
+      uint64_t length,
+      char* buf,
+      HedgeOutcome* outcome) const;
+
+  const std::shared_ptr<ReadFile> file_;
+  const std::shared_ptr<HedgedReadPolicy> policy_;
+};
+
+} // namespace facebook::velox
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUring.h"
+
+#include <folly/String.h>
+#include <glog/logging.h>
+#include "velox/common/base/Exceptions.h"
+
+#ifdef VELOX_ENABLE_IO_URING
+#include <liburing.h>
+#endif // VELOX_ENABLE_IO_URING
+
+namespace facebook::velox {
+
+#ifdef VELOX_ENABLE_IO_URING
+
+// static
+std::unique_ptr<IoUring> IoUring::create(
+    int32_t queueDepth,
+    std::string_view logPrefix) {
+  VELOX_CHECK_GT(queueDepth, 0);
+  auto ring = std::make_unique<io_uring>();
+  const auto rc = io_uring_queue_init(queueDepth, ring.get(), 0);
+  if (rc < 0) {
+    LOG(WARNING) << logPrefix
+                 << "io_uring is not available: " << folly::errnoStr(-rc);
+    return nullptr;
+  }
+  return std::unique_ptr<IoUring>(new IoUring(queueDepth, ring.release()));
+}
+
+IoUring::IoUring(int32_t queueDepth, io_uring* ring)
+    : queueDepth_(queueDepth), ring_(ring) {}
+
+IoUring::~IoUring() {
+  io_uring_queue_exit(ring_);
+  delete ring_;
+}
+
+bool IoUring::prepare(
+    bool isWrite,
+    int32_t fd,
+    const iovec* iovecs,
+    int32_t numIovecs,
+    uint64_t offset,
+    void* data) {
+  auto* sqe = io_uring_get_sqe(ring_);
+  if (sqe == nullptr) {
+    return false;
+  }
+  if (isWrite) {
+    io_uring_prep_writev(sqe, fd, iovecs, numIovecs, offset);
+  } else {
+    io_uring_prep_readv(sqe, fd, iovecs, numIovecs, offset);
+  }
+  io_uring_sqe_set_data(sqe, data);
+  lastPrepared_ = sqe;
+  return true;
+}
+
+void IoUring::cancelLastPrepared() {
+  VELOX_CHECK_NOT_NULL(lastPrepared_);
+  io_uring_prep_nop(lastPrepared_);
+  io_uring_sqe_set_data(lastPrepared_, nullptr);
+}
+
+int32_t IoUring::submit() {
+  for (;;) {
+    const auto rc = io_uring_submit(ring_);
+    if (rc == -EINTR || rc == -EAGAIN) {
+      continue;
+    }
+    return rc;
+  }
+}
+
+int32_t IoUring::wait(void*& data, int32_t& result) {
+  io_uring_cqe* cqe;
+  int32_t rc;
+  do {
+    rc = io_uring_wait_cqe(ring_, &cqe);
+  } while (rc == -EINTR);
+  if (rc < 0) {
+    return rc;
+  }
+  data = io_uring_cqe_get_data(cqe);
+  result = cqe->res;
+  io_uring_cqe_seen(ring_, cqe);
+  return 0;
+}
+
+#else
+
+// static
+std::unique_ptr<IoUring> IoUring::create(
+    int32_t /*queueDepth*/,
+    std::string_view /*logPrefix*/) {
+  return nullptr;
+}
+
+IoUring::IoUring(int32_t queueDepth, io_uring* ring)
+    : queueDepth_(queueDepth), ring_(ring) {}
+
+IoUring::~IoUring() = default;
+
+bool IoUring::prepare(
+    bool /*isWrite*/,
+    int32_t /*fd*/,
+    const iovec* /*iovecs*/,
+    int32_t /*numIovecs*/,
+    uint64_t /*offset*/,
+    void* /*data*/) {
+  VELOX_UNREACHABLE();
+}
+
+void IoUring::cancelLastPrepared() {
+  VELOX_UNREACHABLE();
+}
+
+int32_t IoUring::submit() {
+  VELOX_UNREACHABLE();
+}
+
+int32_t IoUring::wait(void*& /*data*/, int32_t& /*result*/) {
+  VELOX_UNREACHABLE();
+}
+
+#endif // VELOX_ENABLE_IO_URING
+} // namespace facebook::velox
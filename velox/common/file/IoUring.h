@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/portability/SysUio.h>
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+struct io_uring;
+struct io_uring_sqe;
+
+namespace facebook::velox {
+
+/// An io_uring for reads and writes of files, used by the asynchronous local
+/// file reads and by the SSD cache. Errors are returned as negative errno
+/// values instead of thrown, so that a thread reaping the completions of other
+/// threads can fail their requests. Submissions must be serialized by the
+/// caller. Completions may be waited for by one thread concurrently with the
+/// submissions. Usable only if built with VELOX_ENABLE_IO_URING and supported
+/// by the kernel.
+class IoUring {
+ public:
+  /// Returns a ring with 'queueDepth' submission entries, or nullptr if
+  /// io_uring is not available. 'logPrefix' prefixes the warning logged then.
+  static std::unique_ptr<IoUring> create(
+      int32_t queueDepth,
+      std::string_view logPrefix = "");
+
+  ~IoUring();
+
+  int32_t queueDepth() const {
+    return queueDepth_;
+  }
+
+  /// Queues a readv, or a writev if 'isWrite', of 'numIovecs' 'iovecs' on 'fd'
+  /// at 'offset'. 'data' comes back with the completion. The memory of
+  /// 'iovecs' must stay valid until the entry is submitted. Returns false if
+  /// the submission queue is full.
+  bool prepare(
+      bool isWrite,
+      int32_t fd,
+      const iovec* iovecs,
+      int32_t numIovecs,
+      uint64_t offset,
+      void* data);
+
+  /// Turns the last entry queued by prepare() into a no-op with nullptr data,
+  /// so that its later submission does not refer to a request the caller gave
+  /// up on.
+  void cancelLastPrepared();
+
+  /// Submits the queued entries. Retries on EINTR and EAGAIN. Returns the
+  /// number of entries submitted. Returns 0 or a negative errno if none was
+  /// submitted, in which case the entries stay queued.
+  int32_t submit();
+
+  /// Waits for the next completion. Retries on EINTR. Returns 0 and sets
+  /// 'data' to the data of the completed entry and 'result' to its result,
+  /// i.e. the number of bytes transferred or a negative errno. Returns a
+  /// negative errno if the wait fails.
+  int32_t wait(void*& data, int32_t& result);
+
+ private:
+  // Takes ownership of 'ring'.
+  IoUring(int32_t queueDepth, io_uring* ring);
+
+  const int32_t queueDepth_;
+  io_uring* const ring_;
+  io_uring_sqe* lastPrepared_{nullptr};
+};
+
+} // namespace facebook::velox
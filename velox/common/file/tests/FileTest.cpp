@@ -17,8 +17,10 @@
 #include <fcntl.h>
 
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/AsyncIoUring.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUring.h"
 #include "velox/common/file/tests/FaultyFileSystem.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
@@ -160,6 +162,118 @@ TEST_P(LocalFileTest, writeAndRead) {
   }
 }
 
+TEST(LocalFileOptions, parse) {
+  auto options = LocalFileOptions::parse("");
+  ASSERT_FALSE(options.ioUring);
+  ASSERT_FALSE(options.directIo);
+  options = LocalFileOptions::parse("io_uring");
+  ASSERT_TRUE(options.ioUring);
+  ASSERT_FALSE(options.directIo);
+  options = LocalFileOptions::parse(" direct , other,io_uring");
+  ASSERT_TRUE(options.ioUring);
+  ASSERT_TRUE(options.directIo);
+}
+
+TEST(IoUring, writeAndRead) {
+  auto ring = IoUring::create(4);
+  if (ring == nullptr) {
+    GTEST_SKIP() << "io_uring is not available";
+  }
+  ASSERT_EQ(ring->queueDepth(), 4);
+  auto tempFile = exec::test::TempFilePath::create();
+  const auto fd = ::open(tempFile->getPath().c_str(), O_RDWR);
+  ASSERT_GE(fd, 0);
+
+  char hello[] = "hello";
+  char world[] = "world";
+  std::vector<iovec> writeIovecs = {{hello, 5}, {world, 5}};
+  int32_t tag = 1;
+  ASSERT_TRUE(ring->prepare(true, fd, writeIovecs.data(), 2, 0, &tag));
+  ASSERT_EQ(ring->submit(), 1);
+  void* data;
+  int32_t result;
+  ASSERT_EQ(ring->wait(data, result), 0);
+  ASSERT_EQ(data, &tag);
+  ASSERT_EQ(result, 10);
+
+  // A read past the end of the file is short.
+  char buffer[12];
+  iovec readIovec = {buffer, sizeof(buffer)};
+  ASSERT_TRUE(ring->prepare(false, fd, &readIovec, 1, 0, &tag));
+  ASSERT_EQ(ring->submit(), 1);
+  ASSERT_EQ(ring->wait(data, result), 0);
+  ASSERT_EQ(result, 10);
+  ASSERT_EQ(std::string_view(buffer, 10), "helloworld");
+  ::close(fd);
+
+  // A failed read completes with a negative errno instead of throwing.
+  ASSERT_TRUE(ring->prepare(false, fd, &readIovec, 1, 0, &tag));
+  ASSERT_EQ(ring->submit(), 1);
+  ASSERT_EQ(ring->wait(data, result), 0);
+  ASSERT_EQ(result, -EBADF);
+
+  // A cancelled entry completes as a no-op without data.
+  ASSERT_TRUE(ring->prepare(false, fd, &readIovec, 1, 0, &tag));
+  ring->cancelLastPrepared();
+  ASSERT_EQ(ring->submit(), 1);
+  ASSERT_EQ(ring->wait(data, result), 0);
+  ASSERT_EQ(data, nullptr);
+  ASSERT_EQ(result, 0);
+}
+
+TEST_P(LocalFileTest, fileCreateConfig) {
+  for (const auto* config : {"direct", "io_uring", "io_uring,direct"}) {
+    SCOPED_TRACE(config);
+    const filesystems::FileOptions options{
+        {{filesystems::FileOptions::kFileCreateConfig.toString(), config}},
+        nullptr,
+        std::nullopt};
+    auto tempFile = exec::test::TempFilePath::create(useFaultyFs_);
+    const auto& filename = tempFile->getPath();
+    auto fs = filesystems::getFileSystem(filename, {});
+    fs->remove(filename);
+    {
+      auto writeFile = fs->openFileForWrite(filename, options);
+      writeFile->append("aaaaa");
+      // A flushed partial block is readable and written again with the
+      // next data.
+      writeFile->flush();
+      ASSERT_EQ(fs->openFileForRead(filename)->pread(0, 5), "aaaaa");
+      writeFile->append("bbbbb");
+      writeFile->append(std::string(kOneMB, 'c'));
+      writeFile->append("ddddd");
+      writeFile->close();
+      ASSERT_EQ(writeFile->size(), 15 + kOneMB);
+    }
+    auto readFile = fs->openFileForRead(filename, options);
+    readData(readFile.get());
+
+    const bool ioUring = LocalFileOptions::parse(config).ioUring;
+    if (!useFaultyFs_) {
+      ASSERT_EQ(
+          readFile->hasPreadvAsync(),
+          ioUring && AsyncIoUring::instance() != nullptr);
+    }
+    char head[12];
+    char tail[7];
+    std::vector<folly::Range<char*>> buffers = {
+        folly::Range<char*>(head, sizeof(head)),
+        folly::Range<char*>(
+            nullptr, (char*)(uint64_t)(kOneMB - sizeof(head) + 8)),
+        folly::Range<char*>(tail, sizeof(tail))};
+    ASSERT_EQ(readFile->preadvAsync(0, buffers).get(), 15 + kOneMB);
+    ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
+    ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+    // A read past the end of the file is short.
+    char past[10];
+    ASSERT_EQ(
+        readFile->preadvAsync(kOneMB + 10, {folly::Range<char*>(past, 10)})
+            .get(),
+        5);
+    ASSERT_EQ(std::string_view(past, 5), "ddddd");
+  }
+}
+
 TEST_P(LocalFileTest, viaRegistry) {
   auto tempFile = exec::test::TempFilePath::create(useFaultyFs_);
   const auto& filename = tempFile->getPath();
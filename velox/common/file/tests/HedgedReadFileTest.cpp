@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/HedgedReadFile.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/tests/FaultyFile.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace facebook::velox;
+using namespace facebook::velox::tests::utils;
+
+namespace {
+
+constexpr uint64_t kReadSize = 1'000;
+
+class HedgedReadFileTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    data_.resize(100'000);
+    for (size_t i = 0; i < data_.size(); ++i) {
+      data_[i] = 'a' + i % 26;
+    }
+    HedgedReadPolicy::Options options;
+    options.minDelay = std::chrono::milliseconds(1);
+    options.maxInFlightHedges = 1;
+    options.numThreads = 4;
+    policy_ = std::make_shared<HedgedReadPolicy>(options);
+    file_ = std::make_shared<HedgedReadFile>(
+        std::make_shared<FaultyReadFile>(
+            "test",
+            std::make_shared<InMemoryReadFile>(data_),
+            [&](FaultFileOperation* /*op*/) {
+              if (numFailures_ > 0 && numFailures_-- > 0) {
+                VELOX_FAIL("Injected read error");
+              }
+              if (slowNext_.exchange(false) || slowAll_) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(200));
+              }
+            }),
+        policy_);
+  }
+
+  // Reads enough to give the policy a hedge delay for 'kReadSize' reads.
+  void warmUp() {
+    char buf[kReadSize];
+    for (auto i = 0; i < 64; ++i) {
+      HedgeOutcome outcome;
+      file_->pread(i * kReadSize, kReadSize, buf, &outcome);
+      ASSERT_FALSE(outcome.hedged);
+    }
+    ASSERT_TRUE(policy_->hedgeDelay(kReadSize).has_value());
+    ASSERT_GE(
+        policy_->hedgeDelay(kReadSize).value(), std::chrono::milliseconds(1));
+  }
+
+  std::string data_;
+  std::atomic<int32_t> numFailures_{0};
+  std::atomic<bool> slowNext_{false};
+  std::atomic<bool> slowAll_{false};
+  std::shared_ptr<HedgedReadPolicy> policy_;
+  std::shared_ptr<HedgedReadFile> file_;
+};
+
+TEST_F(HedgedReadFileTest, noHedgeWithoutSamples) {
+  ASSERT_FALSE(policy_->hedgeDelay(kReadSize).has_value());
+  slowNext_ = true;
+  HedgeOutcome outcome;
+  char buf[kReadSize];
+  file_->pread(0, kReadSize, buf, &outcome);
+  ASSERT_FALSE(outcome.hedged);
+  ASSERT_EQ(std::string_view(buf, kReadSize), data_.substr(0, kReadSize));
+  ASSERT_EQ(policy_->stats().numHedges, 0);
+  // Reads of another size class have their own samples.
+  warmUp();
+  ASSERT_FALSE(policy_->hedgeDelay(1 << 20).has_value());
+}
+
+TEST_F(HedgedReadFileTest, hedgeWins) {
+  warmUp();
+  slowNext_ = true;
+  HedgeOutcome outcome;
+  char buf[kReadSize];
+  file_->pread(1'000, kReadSize, buf, &outcome);
+  ASSERT_TRUE(outcome.hedged);
+  ASSERT_TRUE(outcome.hedgeWon);
+  ASSERT_EQ(std::string_view(buf, kReadSize), data_.substr(1'000, kReadSize));
+  ASSERT_EQ(policy_->stats().numHedges, 1);
+}
+
+TEST_F(HedgedReadFileTest, preadv) {
+  warmUp();
+  slowNext_ = true;
+  std::string first(300, '\0');
+  std::string second(400, '\0');
+  // The middle range is a gap of a coalesced read.
+  std::vector<folly::Range<char*>> buffers{
+      {first.data(), first.size()},
+      {nullptr, 300},
+      {second.data(), second.size()}};
+  HedgeOutcome outcome;
+  ASSERT_EQ(file_->preadv(5'000, buffers, &outcome), kReadSize);
+  ASSERT_TRUE(outcome.hedged);
+  ASSERT_EQ(first, data_.substr(5'000, 300));
+  ASSERT_EQ(second, data_.substr(5'600, 400));
+}
+
+TEST_F(HedgedReadFileTest, maxInFlightHedges) {
+  warmUp();
+  slowAll_ = true;
+  std::array<HedgeOutcome, 2> outcomes;
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < 2; ++i) {
+    threads.emplace_back([&, i]() {
+      char buf[kReadSize];
+      file_->pread(i * kReadSize, kReadSize, buf, &outcomes[i]);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  slowAll_ = false;
+  ASSERT_NE(outcomes[0].hedged, outcomes[1].hedged);
+  const auto stats = policy_->stats();
+  ASSERT_EQ(stats.numHedges, 1);
+  ASSERT_EQ(stats.numHedgesSkipped, 1);
+}
+
+TEST_F(HedgedReadFileTest, error) {
+  warmUp();
+  // Fails both the first request and a hedge, if any.
+  numFailures_ = 2;
+  char buf[kReadSize];
+  VELOX_ASSERT_THROW(
+      file_->pread(0, kReadSize, buf, nullptr), "Injected read error");
+  numFailures_ = 0;
+  // The file is readable after the error.
+  file_->pread(0, kReadSize, buf, nullptr);
+  ASSERT_EQ(std::string_view(buf, kReadSize), data_.substr(0, kReadSize));
+}
+
+} // namespace
@@ -15,6 +15,7 @@
  */
 #include "velox/common/hyperloglog/DenseHll.h"
 
+#include <algorithm>
 #include <exception>
 #include <sstream>
 #include "velox/common/base/IOUtils.h"
@@ -143,6 +144,27 @@ void DenseHll::insertHash(uint64_t hash) {
   insert(index, value);
 }
 
+void DenseHll::insertHashes(const uint64_t* hashes, int32_t numHashes) {
+  constexpr int32_t kBlockSize = 64;
+  uint32_t indices[kBlockSize];
+  int8_t values[kBlockSize];
+  for (int32_t start = 0; start < numHashes; start += kBlockSize) {
+    const auto size = std::min(kBlockSize, numHashes - start);
+    // No dependencies between iterations, so that the compiler can vectorize
+    // the loop.
+    for (auto i = 0; i < size; ++i) {
+      indices[i] = computeIndex(hashes[start + i], indexBitLength_);
+      values[i] = numberOfLeadingZeros(hashes[start + i], indexBitLength_) + 1;
+    }
+    for (auto i = 0; i < size; ++i) {
+      // All buckets are at least at the baseline.
+      if (values[i] > baseline_) {
+        insert(indices[i], values[i]);
+      }
+    }
+  }
+}
+
 void DenseHll::insert(int32_t index, int8_t value) {
   auto delta = value - baseline_;
   auto oldDelta = getDelta(index);
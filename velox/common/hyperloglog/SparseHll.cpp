@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/common/hyperloglog/SparseHll.h"
+
+#include <algorithm>
+
 #include "velox/common/base/IOUtils.h"
 #include "velox/common/hyperloglog/HllUtils.h"
 
@@ -88,6 +91,54 @@ bool SparseHll::insertHash(uint64_t hash) {
   return overLimit();
 }
 
+int32_t SparseHll::insertHashes(const uint64_t* hashes, int32_t numHashes) {
+  // Batches smaller than this are inserted one by one.
+  constexpr int32_t kMinBatchSize = 8;
+
+  std::vector<uint32_t> batch;
+  int32_t numInserted = 0;
+  while (numInserted < numHashes) {
+    // A batch adds at most one entry per hash. Limit it to the entries left
+    // before the soft limit, so that no hash is inserted after reaching it.
+    const int32_t numLeft = softNumEntriesLimit_ > entries_.size()
+        ? softNumEntriesLimit_ - entries_.size()
+        : 0;
+    const auto batchSize = std::min(numHashes - numInserted, numLeft);
+    if (batchSize < kMinBatchSize) {
+      if (insertHash(hashes[numInserted++])) {
+        break;
+      }
+      continue;
+    }
+
+    batch.resize(batchSize);
+    for (auto i = 0; i < batchSize; ++i) {
+      const auto hash = hashes[numInserted + i];
+      batch[i] = encode(
+          computeIndex(hash, kIndexBitLength),
+          numberOfLeadingZeros(hash, kIndexBitLength));
+    }
+    numInserted += batchSize;
+
+    // Sorting the entries orders them by bucket, then by value. Keeps the
+    // last, i.e. the largest, entry of each bucket.
+    std::sort(batch.begin(), batch.end());
+    int32_t numUnique = 0;
+    for (auto i = 0; i < batchSize; ++i) {
+      if (i + 1 < batchSize &&
+          decodeIndex(batch[i]) == decodeIndex(batch[i + 1])) {
+        continue;
+      }
+      batch[numUnique++] = batch[i];
+    }
+    mergeWith(numUnique, batch.data());
+    if (overLimit()) {
+      break;
+    }
+  }
+  return numInserted;
+}
+
 int64_t SparseHll::cardinality() const {
   // Estimate the cardinality using linear counting over the theoretical
   // 2^kIndexBitLength buckets available due to the fact that we're
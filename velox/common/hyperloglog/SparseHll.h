@@ -40,6 +40,14 @@ class SparseHll {
   /// Returns true if soft memory limit has been reached. False, otherwise.
   bool insertHash(uint64_t hash);
 
+  /// Inserts 'hashes' until the soft memory limit is reached. Returns the
+  /// number of hashes inserted, which is less than 'numHashes' only if
+  /// overLimit() is true. The caller is expected to insert the rest into a
+  /// DenseHll. Sorts the entries of a batch of hashes and merges them with the
+  /// existing ones instead of inserting them one by one. The result is the
+  /// same as calling insertHash for each hash until it returns true.
+  int32_t insertHashes(const uint64_t* hashes, int32_t numHashes);
+
   int64_t cardinality() const;
 
   /// Returns cardinality estimate from the specified serialized digest.
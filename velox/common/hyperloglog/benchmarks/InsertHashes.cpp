@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include "velox/common/hyperloglog/DenseHll.h"
+#include "velox/common/hyperloglog/SparseHll.h"
+#include "velox/common/memory/HashStringAllocator.h"
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+using namespace facebook::velox;
+
+namespace {
+
+template <typename T>
+uint64_t hashOne(T value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// A benchmark for inserting hashes into DenseHll and SparseHll one at a time
+// vs. in batches of 10K, the size of a typical input vector of approx_distinct.
+class InsertHashesBenchmark {
+ public:
+  explicit InsertHashesBenchmark(memory::MemoryPool* pool) : pool_(pool) {
+    for (int32_t i = 0; i < 1'000'000; ++i) {
+      denseHashes_.push_back(hashOne(i));
+    }
+    // Stays below the soft limit of the sparse layout for 16 hash bits.
+    for (int32_t i = 0; i < 1'000'000; ++i) {
+      sparseHashes_.push_back(hashOne(i % 5'000));
+    }
+  }
+
+  void dense(int hashBits, bool batch) {
+    folly::BenchmarkSuspender suspender;
+    HashStringAllocator allocator(pool_);
+    common::hll::DenseHll hll(hashBits, &allocator);
+    suspender.dismiss();
+
+    if (batch) {
+      for (auto i = 0; i < denseHashes_.size(); i += kBatchSize) {
+        hll.insertHashes(denseHashes_.data() + i, kBatchSize);
+      }
+    } else {
+      for (auto hash : denseHashes_) {
+        hll.insertHash(hash);
+      }
+    }
+    folly::doNotOptimizeAway(hll.cardinality());
+  }
+
+  void sparse(bool batch) {
+    folly::BenchmarkSuspender suspender;
+    HashStringAllocator allocator(pool_);
+    common::hll::SparseHll hll(&allocator);
+    hll.setSoftMemoryLimit(common::hll::DenseHll::estimateInMemorySize(16));
+    suspender.dismiss();
+
+    if (batch) {
+      for (auto i = 0; i < sparseHashes_.size(); i += kBatchSize) {
+        hll.insertHashes(sparseHashes_.data() + i, kBatchSize);
+      }
+    } else {
+      for (auto hash : sparseHashes_) {
+        hll.insertHash(hash);
+      }
+    }
+    folly::doNotOptimizeAway(hll.cardinality());
+  }
+
+ private:
+  static constexpr int32_t kBatchSize = 10'000;
+
+  memory::MemoryPool* pool_;
+  std::vector<uint64_t> denseHashes_;
+  std::vector<uint64_t> sparseHashes_;
+};
+
+} // namespace
+
+std::unique_ptr<InsertHashesBenchmark> benchmark;
+
+BENCHMARK(denseInsertHash11) {
+  benchmark->dense(11, false);
+}
+
+BENCHMARK_RELATIVE(denseInsertHashes11) {
+  benchmark->dense(11, true);
+}
+
+BENCHMARK(denseInsertHash16) {
+  benchmark->dense(16, false);
+}
+
+BENCHMARK_RELATIVE(denseInsertHashes16) {
+  benchmark->dense(16, true);
+}
+
+BENCHMARK(sparseInsertHash) {
+  benchmark->sparse(false);
+}
+
+BENCHMARK_RELATIVE(sparseInsertHashes) {
+  benchmark->sparse(true);
+}
+
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+
+  memory::MemoryManager::initialize({});
+  auto rootPool = memory::memoryManager()->addRootPool();
+  auto pool = rootPool->addLeafChild("bm");
+  benchmark = std::make_unique<InsertHashesBenchmark>(pool.get());
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -170,6 +170,28 @@ std::vector<T> sequence(T start, T end) {
 }
 } // namespace
 
+TEST_P(DenseHllTest, insertHashes) {
+  int8_t indexBitLength = GetParam();
+
+  // Repeating values hit buckets that are already at their max. The odd
+  // number of hashes leaves a partial last block.
+  std::vector<uint64_t> hashes;
+  for (int i = 0; i < 100'003; i++) {
+    hashes.push_back(hashOne(i % 30'000));
+  }
+
+  DenseHll expected{indexBitLength, &allocator_};
+  for (auto hash : hashes) {
+    expected.insertHash(hash);
+  }
+
+  DenseHll denseHll{indexBitLength, &allocator_};
+  denseHll.insertHashes(hashes.data(), 17);
+  denseHll.insertHashes(hashes.data() + 17, hashes.size() - 17);
+  ASSERT_EQ(serialize(denseHll), serialize(expected));
+  ASSERT_EQ(denseHll.cardinality(), expected.cardinality());
+}
+
 TEST_P(DenseHllTest, canDeserialize) {
   // These are not valid HLL but all pass canDeserialize version only check.
   std::vector<folly::StringPiece> invalidStrings{
@@ -173,6 +173,43 @@ TEST_F(SparseHllTest, mergeWith) {
   testMergeWith({}, sequence(100, 300));
 }
 
+TEST_F(SparseHllTest, insertHashes) {
+  std::vector<uint64_t> hashes;
+  for (int i = 0; i < 1'000; i++) {
+    hashes.push_back(hashOne(i % 300));
+  }
+
+  SparseHll expected{&allocator_};
+  for (auto hash : hashes) {
+    expected.insertHash(hash);
+  }
+
+  SparseHll sparseHll{&allocator_};
+  sparseHll.setSoftMemoryLimit(1'000'000);
+  // Inserting the first hashes twice does not change the result.
+  ASSERT_EQ(3, sparseHll.insertHashes(hashes.data(), 3));
+  ASSERT_EQ(3, sparseHll.insertHashes(hashes.data(), 3));
+  ASSERT_EQ(997, sparseHll.insertHashes(hashes.data() + 3, 997));
+  sparseHll.verify();
+  ASSERT_FALSE(sparseHll.overLimit());
+  ASSERT_EQ(serialize(11, sparseHll), serialize(11, expected));
+
+  // Stops at the same hash as insertHash when reaching the soft limit of 100
+  // entries.
+  SparseHll limited{&allocator_};
+  limited.setSoftMemoryLimit(100 * 4);
+  int32_t expectedNumInserted = 0;
+  SparseHll expectedLimited{&allocator_};
+  expectedLimited.setSoftMemoryLimit(100 * 4);
+  while (!expectedLimited.insertHash(hashes[expectedNumInserted++])) {
+  }
+  ASSERT_EQ(
+      expectedNumInserted, limited.insertHashes(hashes.data(), hashes.size()));
+  limited.verify();
+  ASSERT_TRUE(limited.overLimit());
+  ASSERT_EQ(serialize(11, limited), serialize(11, expectedLimited));
+}
+
 class SparseHllToDenseTest : public ::testing::TestWithParam<int8_t> {
  protected:
   static void SetUpTestCase() {
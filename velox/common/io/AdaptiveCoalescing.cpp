@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/AdaptiveCoalescing.h"
+
+#include <algorithm>
+
+namespace facebook::velox::io {
+
+// static
+AdaptiveCoalescing& AdaptiveCoalescing::instance() {
+  static AdaptiveCoalescing instance;
+  return instance;
+}
+
+// static
+std::string AdaptiveCoalescing::storageName(std::string_view path) {
+  const auto end = path.find("://");
+  if (end == std::string_view::npos || end == 0) {
+    return "local";
+  }
+  return std::string(path.substr(0, end));
+}
+
+void AdaptiveCoalescing::recordRead(
+    const std::string& storage,
+    uint64_t bytes,
+    uint64_t usecs) {
+  const double x = bytes;
+  const double y = usecs;
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& model = models_[storage];
+  ++model.numReads;
+  model.weight = model.weight * kDecay + 1;
+  model.sumBytes = model.sumBytes * kDecay + x;
+  model.sumUsecs = model.sumUsecs * kDecay + y;
+  model.sumBytesSquared = model.sumBytesSquared * kDecay + x * x;
+  model.sumBytesUsecs = model.sumBytesUsecs * kDecay + x * y;
+}
+
+AdaptiveCoalescing::Parameters AdaptiveCoalescing::parameters(
+    const std::string& storage,
+    const Parameters& defaults) const {
+  Stats stats;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = models_.find(storage);
+    if (it == models_.end()) {
+      return defaults;
+    }
+    fit(it->second, defaults, stats);
+  }
+  if (!stats.learned) {
+    return defaults;
+  }
+  return {stats.maxCoalesceDistance, stats.maxCoalesceBytes};
+}
+
+std::vector<AdaptiveCoalescing::Stats> AdaptiveCoalescing::stats(
+    const Parameters& defaults) const {
+  std::vector<Stats> result;
+  std::lock_guard<std::mutex> l(mutex_);
+  for (const auto& [storage, model] : models_) {
+    auto& stats = result.emplace_back();
+    stats.storage = storage;
+    fit(model, defaults, stats);
+  }
+  std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+    return a.storage < b.storage;
+  });
+  return result;
+}
+
+void AdaptiveCoalescing::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  models_.clear();
+}
+
+// static
+void AdaptiveCoalescing::fit(
+    const Model& model,
+    const Parameters& defaults,
+    Stats& stats) {
+  stats.numReads = model.numReads;
+  stats.learned = false;
+  stats.maxCoalesceDistance = defaults.maxCoalesceDistance;
+  stats.maxCoalesceBytes = defaults.maxCoalesceBytes;
+  if (model.numReads < kMinReads) {
+    return;
+  }
+  const double variance =
+      model.weight * model.sumBytesSquared - model.sumBytes * model.sumBytes;
+  // Reads of about the same size do not tell latency and bandwidth apart.
+  if (variance <= 1e-6 * model.weight * model.sumBytesSquared) {
+    return;
+  }
+  const double usecsPerByte =
+      (model.weight * model.sumBytesUsecs - model.sumBytes * model.sumUsecs) /
+      variance;
+  if (usecsPerByte <= 0) {
+    return;
+  }
+  stats.learned = true;
+  stats.bytesPerUs = 1 / usecsPerByte;
+  stats.latencyUs = std::max<double>(
+      0, (model.sumUsecs - usecsPerByte * model.sumBytes) / model.weight);
+  const double breakEven = stats.latencyUs * stats.bytesPerUs;
+  stats.maxCoalesceDistance =
+      std::min<double>(breakEven, kMaxCoalesceDistance);
+  const auto minBytes =
+      std::min<int64_t>(kMinCoalesceBytes, defaults.maxCoalesceBytes);
+  stats.maxCoalesceBytes = std::clamp<int64_t>(
+      std::min<double>(
+          breakEven * kLatencyFraction, defaults.maxCoalesceBytes),
+      minBytes,
+      defaults.maxCoalesceBytes);
+}
+
+} // namespace facebook::velox::io
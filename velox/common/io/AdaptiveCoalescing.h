@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <folly/container/F14Map.h>
+
+namespace facebook::velox::io {
+
+/// Learns the fixed cost per request and the transfer rate of each storage
+/// system from timed reads and derives how far apart two ranges can be and
+/// still be read in one request, and how large one request may get.
+///
+/// A read of 'bytes' is modeled as taking 'latency + bytes / bandwidth'.
+/// Reading the gap between two ranges costs 'gap / bandwidth', while reading
+/// them separately costs another 'latency', so gaps below 'latency *
+/// bandwidth' are worth coalescing. On local NVMe this is a few KB and on an
+/// object store in another region it is many MB. A request is made large
+/// enough that the fixed cost is a small part of its time.
+class AdaptiveCoalescing {
+ public:
+  struct Parameters {
+    int32_t maxCoalesceDistance;
+    int64_t maxCoalesceBytes;
+  };
+
+  struct Stats {
+    std::string storage;
+    uint64_t numReads{0};
+    /// Learned fixed cost of a request in microseconds.
+    double latencyUs{0};
+    /// Learned transfer rate in bytes per microsecond.
+    double bytesPerUs{0};
+    /// False until there are enough reads of different sizes to fit the
+    /// model.
+    bool learned{false};
+    int32_t maxCoalesceDistance{0};
+    int64_t maxCoalesceBytes{0};
+  };
+
+  /// Number of reads of a storage system before its parameters are learned.
+  static constexpr int32_t kMinReads = 32;
+
+  /// Weight of the past reads relative to a new one. Adapts to a change of
+  /// the load of the storage within a few hundred reads.
+  static constexpr double kDecay = 0.99;
+
+  /// The fixed cost of a request is at most this fraction of its time.
+  static constexpr int32_t kLatencyFraction = 8;
+
+  static constexpr int32_t kMaxCoalesceDistance = 16 << 20;
+  static constexpr int64_t kMinCoalesceBytes = 1 << 20;
+
+  /// Returns the process-wide instance.
+  static AdaptiveCoalescing& instance();
+
+  /// Returns the name of the storage system of the file at 'path', i.e. the
+  /// scheme of the path or 'local' for paths without a scheme.
+  static std::string storageName(std::string_view path);
+
+  /// Adds a read of 'bytes' from 'storage' that took 'usecs'.
+  void recordRead(const std::string& storage, uint64_t bytes, uint64_t usecs);
+
+  /// Returns the parameters for 'storage'. Returns 'defaults' until the
+  /// parameters are learned. The learned maxCoalesceBytes is at most the
+  /// one in 'defaults'.
+  Parameters parameters(const std::string& storage, const Parameters& defaults)
+      const;
+
+  /// Returns the learned model of each storage system seen so far.
+  /// 'defaults' caps the reported maxCoalesceBytes like in parameters().
+  std::vector<Stats> stats(const Parameters& defaults) const;
+
+  /// Forgets all reads. Used in tests.
+  void clear();
+
+ private:
+  // Exponentially decayed sums for a least squares fit of usecs as a linear
+  // function of bytes.
+  struct Model {
+    uint64_t numReads{0};
+    double weight{0};
+    double sumBytes{0};
+    double sumUsecs{0};
+    double sumBytesSquared{0};
+    double sumBytesUsecs{0};
+  };
+
+  // Fills the learned fields of 'stats' from 'model'.
+  static void fit(const Model& model, const Parameters& defaults, Stats& stats);
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, Model> models_;
+};
+
+} // namespace facebook::velox::io
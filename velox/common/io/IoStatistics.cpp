@@ -46,6 +46,26 @@ uint64_t IoStatistics::totalScanTime() const {
   return totalScanTime_.load(std::memory_order_relaxed);
 }
 
+uint64_t IoStatistics::numHedgedReads() const {
+  return numHedgedReads_.load(std::memory_order_relaxed);
+}
+
+uint64_t IoStatistics::numHedgeWins() const {
+  return numHedgeWins_.load(std::memory_order_relaxed);
+}
+
+uint64_t IoStatistics::localBytesRead() const {
+  return localBytesRead_.load(std::memory_order_relaxed);
+}
+
+uint64_t IoStatistics::remoteBytesRead() const {
+  return remoteBytesRead_.load(std::memory_order_relaxed);
+}
+
+uint64_t IoStatistics::offloadedDecompressionBytes() const {
+  return offloadedDecompressionBytes_.load(std::memory_order_relaxed);
+}
+
 uint64_t IoStatistics::incRawBytesRead(int64_t v) {
   return rawBytesRead_.fetch_add(v, std::memory_order_relaxed);
 }
@@ -70,6 +90,26 @@ uint64_t IoStatistics::incTotalScanTime(int64_t v) {
   return totalScanTime_.fetch_add(v, std::memory_order_relaxed);
 }
 
+uint64_t IoStatistics::incNumHedgedReads(int64_t v) {
+  return numHedgedReads_.fetch_add(v, std::memory_order_relaxed);
+}
+
+uint64_t IoStatistics::incNumHedgeWins(int64_t v) {
+  return numHedgeWins_.fetch_add(v, std::memory_order_relaxed);
+}
+
+uint64_t IoStatistics::incLocalBytesRead(int64_t v) {
+  return localBytesRead_.fetch_add(v, std::memory_order_relaxed);
+}
+
+uint64_t IoStatistics::incRemoteBytesRead(int64_t v) {
+  return remoteBytesRead_.fetch_add(v, std::memory_order_relaxed);
+}
+
+uint64_t IoStatistics::incOffloadedDecompressionBytes(int64_t v) {
+  return offloadedDecompressionBytes_.fetch_add(v, std::memory_order_relaxed);
+}
+
 void IoStatistics::incOperationCounters(
     const std::string& operation,
     const uint64_t resourceThrottleCount,
@@ -98,6 +138,11 @@ void IoStatistics::merge(const IoStatistics& other) {
   rawBytesRead_ += other.rawBytesRead_;
   rawBytesWritten_ += other.rawBytesWritten_;
   totalScanTime_ += other.totalScanTime_;
+  numHedgedReads_ += other.numHedgedReads_;
+  numHedgeWins_ += other.numHedgeWins_;
+  localBytesRead_ += other.localBytesRead_;
+  remoteBytesRead_ += other.remoteBytesRead_;
+  offloadedDecompressionBytes_ += other.offloadedDecompressionBytes_;
 
   rawOverreadBytes_ += other.rawOverreadBytes_;
   prefetch_.merge(other.prefetch_);
@@ -105,6 +150,8 @@ void IoStatistics::merge(const IoStatistics& other) {
   ramHit_.merge(other.ramHit_);
   ssdRead_.merge(other.ssdRead_);
   queryThreadIoLatency_.merge(other.queryThreadIoLatency_);
+  coalesceDistance_.merge(other.coalesceDistance_);
+  coalesceBytes_.merge(other.coalesceBytes_);
   std::lock_guard<std::mutex> l(operationStatsMutex_);
   for (auto& item : other.operationStats_) {
     operationStats_[item.first].merge(item.second);
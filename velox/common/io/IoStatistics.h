@@ -94,6 +94,11 @@ class IoStatistics {
   uint64_t inputBatchSize() const;
   uint64_t outputBatchSize() const;
   uint64_t totalScanTime() const;
+  uint64_t numHedgedReads() const;
+  uint64_t numHedgeWins() const;
+  uint64_t localBytesRead() const;
+  uint64_t remoteBytesRead() const;
+  uint64_t offloadedDecompressionBytes() const;
 
   uint64_t incRawBytesRead(int64_t);
   uint64_t incRawOverreadBytes(int64_t);
@@ -101,6 +106,11 @@ class IoStatistics {
   uint64_t incInputBatchSize(int64_t);
   uint64_t incOutputBatchSize(int64_t);
   uint64_t incTotalScanTime(int64_t);
+  uint64_t incNumHedgedReads(int64_t);
+  uint64_t incNumHedgeWins(int64_t);
+  uint64_t incLocalBytesRead(int64_t);
+  uint64_t incRemoteBytesRead(int64_t);
+  uint64_t incOffloadedDecompressionBytes(int64_t);
 
   IoCounter& prefetch() {
     return prefetch_;
@@ -122,6 +132,14 @@ class IoStatistics {
     return queryThreadIoLatency_;
   }
 
+  IoCounter& coalesceDistance() {
+    return coalesceDistance_;
+  }
+
+  IoCounter& coalesceBytes() {
+    return coalesceBytes_;
+  }
+
   void incOperationCounters(
       const std::string& operation,
       const uint64_t resourceThrottleCount,
@@ -144,6 +162,18 @@ class IoStatistics {
   std::atomic<uint64_t> outputBatchSize_{0};
   std::atomic<uint64_t> rawOverreadBytes_{0};
   std::atomic<uint64_t> totalScanTime_{0};
+  // Reads for which a duplicate request was issued because the first did not
+  // complete in time and the number of those served by the duplicate.
+  std::atomic<uint64_t> numHedgedReads_{0};
+  std::atomic<uint64_t> numHedgeWins_{0};
+  // Bytes read from files that know where their data is stored, split by
+  // whether a replica of the data is on this host, e.g. HDFS short-circuit
+  // reads.
+  std::atomic<uint64_t> localBytesRead_{0};
+  std::atomic<uint64_t> remoteBytesRead_{0};
+  // Compressed bytes decompressed by a HardwareDecompressor instead of in
+  // software.
+  std::atomic<uint64_t> offloadedDecompressionBytes_{0};
 
   // Planned read from storage or SSD.
   IoCounter prefetch_;
@@ -162,6 +192,11 @@ class IoStatistics {
   // issued IO or for an in-progress read-ahead to finish.
   IoCounter queryThreadIoLatency_;
 
+  // Learned coalescing distance and maximum coalesced read size, once for
+  // each batch of loads planned with adaptive coalescing.
+  IoCounter coalesceDistance_;
+  IoCounter coalesceBytes_;
+
   std::unordered_map<std::string, OperationCounters> operationStats_;
   mutable std::mutex operationStatsMutex_;
 };
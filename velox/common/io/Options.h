@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "velox/common/memory/Memory.h"
 
 namespace facebook::velox::io {
@@ -65,6 +67,10 @@ class ReaderOptions {
   int32_t maxCoalesceDistance_{kDefaultCoalesceDistance};
   int64_t maxCoalesceBytes_{kDefaultCoalesceBytes};
   int32_t prefetchRowGroups_{kDefaultPrefetchRowGroups};
+  bool adaptivePrefetchRowGroups_{false};
+  bool adaptiveCoalescing_{false};
+  bool mmapLocalFiles_{false};
+  std::string cacheGroup_;
 
  public:
   static constexpr int32_t kDefaultLoadQuantum = 8 << 20; // 8MB
@@ -84,7 +90,11 @@ class ReaderOptions {
     maxCoalesceDistance_ = other.maxCoalesceDistance_;
     maxCoalesceBytes_ = other.maxCoalesceBytes_;
     prefetchRowGroups_ = other.prefetchRowGroups_;
+    adaptivePrefetchRowGroups_ = other.adaptivePrefetchRowGroups_;
+    adaptiveCoalescing_ = other.adaptiveCoalescing_;
+    mmapLocalFiles_ = other.mmapLocalFiles_;
     loadQuantum_ = other.loadQuantum_;
+    cacheGroup_ = other.cacheGroup_;
     return *this;
   }
 
@@ -146,6 +156,46 @@ class ReaderOptions {
     return *this;
   }
 
+  /**
+   * Modify whether the number of row groups or stripes to prefetch adapts to
+   * the time it takes to load and to read them and to the available memory.
+   * The number set by setPrefetchRowGroups() is then the maximum.
+   */
+  ReaderOptions& setAdaptivePrefetchRowGroups(bool adaptive) {
+    adaptivePrefetchRowGroups_ = adaptive;
+    return *this;
+  }
+
+  /**
+   * Modify whether the coalescing distance and the maximum size of a
+   * coalesced read adapt to the latency and throughput measured for the
+   * storage system of the file. The values set by setMaxCoalesceDistance()
+   * and setMaxCoalesceBytes() are then used until enough reads are measured
+   * and the maximum size is an upper bound.
+   */
+  ReaderOptions& setAdaptiveCoalescing(bool adaptive) {
+    adaptiveCoalescing_ = adaptive;
+    return *this;
+  }
+
+  /**
+   * Modify whether local files are read through a memory mapping instead of
+   * being copied into buffers or cache entries.
+   */
+  ReaderOptions& setMmapLocalFiles(bool mmap) {
+    mmapLocalFiles_ = mmap;
+    return *this;
+  }
+
+  /**
+   * Modify the cache group whose quota the cached data of the file counts
+   * against. Empty for the default group.
+   */
+  ReaderOptions& setCacheGroup(std::string cacheGroup) {
+    cacheGroup_ = std::move(cacheGroup);
+    return *this;
+  }
+
   /**
    * Get the memory allocator.
    */
@@ -176,5 +226,21 @@ class ReaderOptions {
   int64_t prefetchRowGroups() const {
     return prefetchRowGroups_;
   }
+
+  bool adaptivePrefetchRowGroups() const {
+    return adaptivePrefetchRowGroups_;
+  }
+
+  bool adaptiveCoalescing() const {
+    return adaptiveCoalescing_;
+  }
+
+  bool mmapLocalFiles() const {
+    return mmapLocalFiles_;
+  }
+
+  const std::string& cacheGroup() const {
+    return cacheGroup_;
+  }
 };
 } // namespace facebook::velox::io
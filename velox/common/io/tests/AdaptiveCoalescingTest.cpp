@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/AdaptiveCoalescing.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::io;
+
+namespace {
+
+class AdaptiveCoalescingTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    AdaptiveCoalescing::instance().clear();
+  }
+
+  // Records reads of sizes from 64KB to 8MB from a storage with
+  // 'latencyUs' fixed cost and 'bytesPerUs' transfer rate.
+  void
+  recordReads(const std::string& storage, double latencyUs, double bytesPerUs) {
+    for (auto i = 0; i < 100; ++i) {
+      const uint64_t bytes = (64 << 10) << (i % 8);
+      AdaptiveCoalescing::instance().recordRead(
+          storage, bytes, latencyUs + bytes / bytesPerUs);
+    }
+  }
+
+  const AdaptiveCoalescing::Parameters defaults_{512 << 10, 128 << 20};
+};
+
+TEST_F(AdaptiveCoalescingTest, storageName) {
+  EXPECT_EQ(AdaptiveCoalescing::storageName("s3://bucket/a"), "s3");
+  EXPECT_EQ(AdaptiveCoalescing::storageName("hdfs://host/a"), "hdfs");
+  EXPECT_EQ(AdaptiveCoalescing::storageName("/tmp/a"), "local");
+  EXPECT_EQ(AdaptiveCoalescing::storageName("file:/tmp/a"), "local");
+}
+
+TEST_F(AdaptiveCoalescingTest, defaultsUntilLearned) {
+  auto& coalescing = AdaptiveCoalescing::instance();
+  auto parameters = coalescing.parameters("s3", defaults_);
+  EXPECT_EQ(parameters.maxCoalesceDistance, defaults_.maxCoalesceDistance);
+  EXPECT_EQ(parameters.maxCoalesceBytes, defaults_.maxCoalesceBytes);
+
+  // Reads of one size do not separate the latency from the transfer time.
+  for (auto i = 0; i < 100; ++i) {
+    coalescing.recordRead("s3", 1 << 20, 10'000);
+  }
+  parameters = coalescing.parameters("s3", defaults_);
+  EXPECT_EQ(parameters.maxCoalesceDistance, defaults_.maxCoalesceDistance);
+  auto stats = coalescing.stats(defaults_);
+  ASSERT_EQ(stats.size(), 1);
+  EXPECT_EQ(stats[0].storage, "s3");
+  EXPECT_EQ(stats[0].numReads, 100);
+  EXPECT_FALSE(stats[0].learned);
+}
+
+TEST_F(AdaptiveCoalescingTest, learn) {
+  auto& coalescing = AdaptiveCoalescing::instance();
+  // NVMe: 80us per request, 2GB/s.
+  recordReads("local", 80, 2'000);
+  // Remote object store: 30ms per request, 100MB/s.
+  recordReads("s3", 30'000, 100);
+
+  auto stats = coalescing.stats(defaults_);
+  ASSERT_EQ(stats.size(), 2);
+  EXPECT_EQ(stats[0].storage, "local");
+  EXPECT_TRUE(stats[0].learned);
+  EXPECT_NEAR(stats[0].latencyUs, 80, 1);
+  EXPECT_NEAR(stats[0].bytesPerUs, 2'000, 1);
+  EXPECT_EQ(stats[1].storage, "s3");
+  EXPECT_NEAR(stats[1].latencyUs, 30'000, 1);
+  EXPECT_NEAR(stats[1].bytesPerUs, 100, 0.1);
+
+  auto local = coalescing.parameters("local", defaults_);
+  EXPECT_NEAR(local.maxCoalesceDistance, 160'000, 1'000);
+  EXPECT_NEAR(local.maxCoalesceBytes, 1'280'000, 20'000);
+  auto s3 = coalescing.parameters("s3", defaults_);
+  EXPECT_NEAR(s3.maxCoalesceDistance, 3'000'000, 10'000);
+  EXPECT_NEAR(s3.maxCoalesceBytes, 24'000'000, 100'000);
+
+  // A slower storage is capped by the defaults.
+  recordReads("gs", 200'000, 100);
+  auto gs = coalescing.parameters("gs", defaults_);
+  EXPECT_EQ(gs.maxCoalesceDistance, AdaptiveCoalescing::kMaxCoalesceDistance);
+  EXPECT_EQ(gs.maxCoalesceBytes, defaults_.maxCoalesceBytes);
+}
+
+TEST_F(AdaptiveCoalescingTest, adapt) {
+  auto& coalescing = AdaptiveCoalescing::instance();
+  recordReads("s3", 30'000, 100);
+  const auto before = coalescing.parameters("s3", defaults_);
+  // The latency drops. The old reads are forgotten.
+  for (auto i = 0; i < 10; ++i) {
+    recordReads("s3", 3'000, 100);
+  }
+  const auto after = coalescing.parameters("s3", defaults_);
+  EXPECT_LT(after.maxCoalesceDistance, before.maxCoalesceDistance / 5);
+}
+
+} // namespace
@@ -16,6 +16,8 @@
 
 #include "velox/common/memory/ByteStream.h"
 
+#include <limits>
+
 namespace facebook::velox {
 
 std::string ByteRange::toString() const {
@@ -306,7 +308,7 @@ void ByteOutputStream::flush(OutputStream* out) {
     if (isBits_ && isReverseBitOrder_ && !isReversed_) {
       bits::reverseBits(ranges_[i].buffer, bytes);
     }
-    out->write(reinterpret_cast<char*>(ranges_[i].buffer), bytes);
+    out->writeArenaBytes(reinterpret_cast<char*>(ranges_[i].buffer), bytes);
   }
   if (isBits_ && isReverseBitOrder_) {
     isReversed_ = true;
@@ -427,33 +429,121 @@ void freeFunc(void* /*data*/, void* userData) {
 }
 } // namespace
 
+void IOBufOutputStream::writeArenaBytes(
+    const char* s,
+    std::streamsize count) {
+  if (!referenceArenaBytes_ || count < kMinReferencedBytes) {
+    write(s, count);
+    return;
+  }
+  const int64_t ownOffset = out_->tellp();
+  VELOX_CHECK(
+      references_.empty() || references_.back().ownOffset <= ownOffset,
+      "Referenced bytes must be written in order");
+  references_.push_back({ownOffset, s, count});
+  if (listener_) {
+    listener_->onWrite(s, count);
+  }
+}
+
+int64_t IOBufOutputStream::referencedBytesBefore(int64_t ownOffset) const {
+  int64_t bytes = 0;
+  for (const auto& reference : references_) {
+    if (reference.ownOffset > ownOffset) {
+      break;
+    }
+    bytes += reference.size;
+  }
+  return bytes;
+}
+
 std::unique_ptr<folly::IOBuf> IOBufOutputStream::getIOBuf(
-    const std::function<void()>& releaseFn) {
-  // Make an IOBuf for each range. The IOBufs keep shared ownership of
-  // 'arena_'.
+    const std::function<void()>& releaseFn,
+    std::shared_ptr<StreamArena> referencedArena) {
+  VELOX_CHECK(
+      references_.empty() || referencedArena != nullptr,
+      "The arena of referenced bytes is required");
   std::unique_ptr<folly::IOBuf> iobuf;
-  auto& ranges = out_->ranges();
-  for (auto& range : ranges) {
-    auto numValues =
-        &range == &ranges.back() ? out_->lastRangeEnd() : range.size;
-    auto userData = newFreeData(arena_, releaseFn);
-    auto newBuf = folly::IOBuf::takeOwnership(
-        reinterpret_cast<char*>(range.buffer), numValues, freeFunc, userData);
+  auto append = [&](std::unique_ptr<folly::IOBuf> newBuf) {
     if (iobuf) {
       iobuf->prev()->appendChain(std::move(newBuf));
     } else {
       iobuf = std::move(newBuf);
     }
-  }
+  };
+  // Make an IOBuf for each range. The IOBufs keep shared ownership of
+  // 'arena_'.
+  auto& ranges = out_->ranges();
+  if (references_.empty()) {
+    for (auto& range : ranges) {
+      auto numValues =
+          &range == &ranges.back() ? out_->lastRangeEnd() : range.size;
+      append(folly::IOBuf::takeOwnership(
+          reinterpret_cast<char*>(range.buffer),
+          numValues,
+          freeFunc,
+          newFreeData(arena_, releaseFn)));
+    }
+    return iobuf;
+  }
+
+  // Appends the bytes of 'out_' in [begin, end), splitting them at the
+  // references.
+  size_t rangeIndex = 0;
+  int64_t rangeStart = 0;
+  auto appendOwn = [&](int64_t begin, int64_t end) {
+    while (begin < end && rangeIndex < ranges.size()) {
+      const auto& range = ranges[rangeIndex];
+      const int64_t rangeSize =
+          &range == &ranges.back() ? out_->lastRangeEnd() : range.size;
+      const int64_t rangeEnd = rangeStart + rangeSize;
+      if (begin >= rangeEnd) {
+        rangeStart = rangeEnd;
+        ++rangeIndex;
+        continue;
+      }
+      const int64_t pieceEnd = std::min(end, rangeEnd);
+      append(folly::IOBuf::takeOwnership(
+          reinterpret_cast<char*>(range.buffer) + (begin - rangeStart),
+          pieceEnd - begin,
+          freeFunc,
+          newFreeData(arena_, releaseFn)));
+      begin = pieceEnd;
+    }
+  };
+  int64_t ownOffset = 0;
+  for (const auto& reference : references_) {
+    appendOwn(ownOffset, reference.ownOffset);
+    ownOffset = reference.ownOffset;
+    append(folly::IOBuf::takeOwnership(
+        const_cast<char*>(reference.data),
+        reference.size,
+        freeFunc,
+        newFreeData(referencedArena, releaseFn)));
+  }
+  appendOwn(ownOffset, std::numeric_limits<int64_t>::max());
   return iobuf;
 }
 
 std::streampos IOBufOutputStream::tellp() const {
-  return out_->tellp();
+  const int64_t ownOffset = out_->tellp();
+  return ownOffset + referencedBytesBefore(ownOffset);
 }
 
 void IOBufOutputStream::seekp(std::streampos pos) {
-  out_->seekp(pos);
+  int64_t referencedBytes = 0;
+  for (const auto& reference : references_) {
+    const int64_t start = reference.ownOffset + referencedBytes;
+    if (pos < start) {
+      break;
+    }
+    VELOX_CHECK_GE(
+        static_cast<int64_t>(pos),
+        start + reference.size,
+        "Cannot seek into referenced bytes");
+    referencedBytes += reference.size;
+  }
+  out_->seekp(static_cast<int64_t>(pos) - referencedBytes);
 }
 
 } // namespace facebook::velox
@@ -53,6 +53,13 @@ class OutputStream {
 
   virtual void write(const char* s, std::streamsize count) = 0;
 
+  /// Writes 'count' bytes at 's' that were allocated from a StreamArena and
+  /// stay valid while the arena memory is alive. Streams that produce IOBufs
+  /// may reference the bytes instead of copying them. The default copies.
+  virtual void writeArenaBytes(const char* s, std::streamsize count) {
+    write(s, count);
+  }
+
   virtual std::streampos tellp() const = 0;
 
   virtual void seekp(std::streampos pos) = 0;
@@ -475,6 +482,9 @@ class IOBufOutputStream : public OutputStream {
     out_->startWrite(initialSize);
   }
 
+  /// writeArenaBytes() of fewer bytes are copied.
+  static constexpr int64_t kMinReferencedBytes = 1024;
+
   void write(const char* s, std::streamsize count) override {
     out_->appendStringView(std::string_view(s, count));
     if (listener_) {
@@ -482,17 +492,45 @@ class IOBufOutputStream : public OutputStream {
     }
   }
 
+  /// Copies the bytes unless setReferenceArenaBytes() was called. Then the
+  /// IOBufs from getIOBuf() reference them. seekp() may not move into these
+  /// bytes.
+  void writeArenaBytes(const char* s, std::streamsize count) override;
+
+  /// Makes writeArenaBytes() reference the bytes instead of copying them. The
+  /// caller must pass the arena that holds them to getIOBuf(), typically
+  /// after StreamArena::detach().
+  void setReferenceArenaBytes() {
+    referenceArenaBytes_ = true;
+  }
+
   std::streampos tellp() const override;
 
   void seekp(std::streampos pos) override;
 
   /// 'releaseFn' is executed on iobuf destruction if not null.
+  /// 'referencedArena' holds the bytes of writeArenaBytes() that were not
+  /// copied. The IOBufs keep shared ownership of it.
   std::unique_ptr<folly::IOBuf> getIOBuf(
-      const std::function<void()>& releaseFn = nullptr);
+      const std::function<void()>& releaseFn = nullptr,
+      std::shared_ptr<StreamArena> referencedArena = nullptr);
 
  private:
+  // Bytes of writeArenaBytes() that are placed before the byte at
+  // 'ownOffset' in 'out_'.
+  struct Reference {
+    int64_t ownOffset;
+    const char* data;
+    int64_t size;
+  };
+
+  // Returns the size of 'references_' at or before 'ownOffset' in 'out_'.
+  int64_t referencedBytesBefore(int64_t ownOffset) const;
+
   std::shared_ptr<StreamArena> arena_;
   std::unique_ptr<ByteOutputStream> out_;
+  bool referenceArenaBytes_{false};
+  std::vector<Reference> references_;
 };
 
 } // namespace facebook::velox
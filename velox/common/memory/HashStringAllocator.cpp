@@ -145,6 +145,26 @@ ByteInputStream HashStringAllocator::prepareRead(
   return ByteInputStream(std::move(ranges));
 }
 
+std::pair<HashStringAllocator::Position, HashStringAllocator::Position>
+HashStringAllocator::relocate(
+    const Header* header,
+    int64_t size,
+    int32_t numReserveBytes) {
+  ByteOutputStream stream(this);
+  newWrite(
+      stream,
+      std::clamp<int64_t>(size + numReserveBytes, kMinContiguous, kMaxAlloc));
+  auto input = prepareRead(header, size);
+  for (auto remaining = size; remaining > 0;) {
+    const auto view = input.nextView(std::min<int64_t>(
+        remaining, std::numeric_limits<int32_t>::max()));
+    VELOX_CHECK(!view.empty(), "Relocated allocation is shorter than {}", size);
+    stream.appendStringView(view);
+    remaining -= view.size();
+  }
+  return finishWrite(stream, numReserveBytes);
+}
+
 HashStringAllocator::Position HashStringAllocator::newWrite(
     ByteOutputStream& stream,
     int32_t preferredSize) {
@@ -286,6 +286,14 @@ class HashStringAllocator : public StreamArena {
   /// Allocates a new range of at least 'bytes' size.
   void newContiguousRange(int32_t bytes, ByteRange* range);
 
+  /// Copies the first 'size' payload bytes of the possibly multipart
+  /// allocation starting at 'header' to a new allocation of 'this'. 'header'
+  /// may belong to another HashStringAllocator and is not freed. Leaves up to
+  /// 'numReserveBytes' after the copy like finishWrite() and returns the
+  /// positions at the start of the copy and immediately after it.
+  std::pair<Position, Position>
+  relocate(const Header* header, int64_t size, int32_t numReserveBytes);
+
   void newTinyRange(int32_t bytes, ByteRange* lastRange, ByteRange* range)
       override {
     newRange(bytes, lastRange, range);
@@ -321,6 +329,13 @@ class HashStringAllocator : public StreamArena {
     return cumulativeBytes_;
   }
 
+  /// Returns the fraction of the slab memory of 'this' that is on the free
+  /// lists. Memory allocated directly from pool() is not counted.
+  double fragmentationRatio() const {
+    const auto slabBytes = pool_.allocatedBytes();
+    return slabBytes == 0 ? 0 : static_cast<double>(freeBytes_) / slabBytes;
+  }
+
   /// Checks the free space accounting and consistency of Headers. Throws when
   /// detects corruption. Returns the number of allocated payload bytes,
   /// excluding headers, continue links and other overhead.
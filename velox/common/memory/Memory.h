@@ -81,6 +81,11 @@ struct MemoryManagerOptions {
   /// Terminates the process and generates a core file on an allocation failure
   bool coreOnAllocationFailureEnabled{false};
 
+  /// The max unused memory reservation in bytes each leaf memory pool keeps
+  /// to batch its reservation updates up the pool tree. See
+  /// MemoryPool::Options::reservationSlack.
+  uint64_t memoryPoolReservationSlack{0};
+
   /// ================== 'MemoryAllocator' settings ==================
   /// Specifies the max memory allocation capacity in bytes enforced by
   /// MemoryAllocator, default unlimited.
@@ -105,6 +110,12 @@ struct MemoryManagerOptions {
   /// NOTE: this only applies for MmapAllocator.
   int32_t mmapArenaCapacityRatio{10};
 
+  /// If true, the large size classes of the allocator are advised to be backed
+  /// by transparent huge pages.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  bool useMmapHugePages{false};
+
   /// If not zero, reserve 'smallAllocationReservePct'% of space from
   /// 'allocatorCapacity' for ad hoc small allocations. And those allocations
   /// are delegated to std::malloc. If 'maxMallocBytes' is 0, this value will be
@@ -311,6 +322,7 @@ class MemoryManager {
   const bool checkUsageLeak_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const uint64_t poolReservationSlack_;
   // The destruction callback set for the allocated root memory pools which are
   // tracked by 'pools_'. It is invoked on the root pool destruction and removes
   // the pool from 'pools_'.
@@ -357,6 +357,7 @@ Stats Stats::operator-(const Stats& other) const {
     result.sizes[i] = sizes[i] - other.sizes[i];
   }
   result.numAdvise = numAdvise - other.numAdvise;
+  result.numHugePages = numHugePages;
   return result;
 }
 
@@ -371,11 +372,12 @@ std::string Stats::toString() const {
     totalAllocations += sizes[i].numAllocations;
   }
   out << fmt::format(
-      "Alloc: {}MB {} Gigaclocks {} Allocations, {}MB advised\n",
+      "Alloc: {}MB {} Gigaclocks {} Allocations, {}MB advised, {} huge pages\n",
       totalBytes >> 20,
       totalClocks >> 30,
       numAdvise >> 8,
-      totalAllocations);
+      totalAllocations,
+      numHugePages);
 
   // Sort the size classes by decreasing clocks.
   std::vector<int32_t> indices(sizes.size());
@@ -137,6 +137,11 @@ struct Stats {
 
   /// Cumulative count of pages advised away, if the allocator exposes this.
   int64_t numAdvise{0};
+
+  /// Number of 2MB huge pages worth of memory that the allocator has advised
+  /// to be backed by transparent huge pages, if the allocator exposes this.
+  /// This is an upper bound as the kernel may back fewer pages.
+  int64_t numHugePages{0};
 };
 
 class MemoryAllocator;
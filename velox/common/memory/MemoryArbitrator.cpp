@@ -16,6 +16,7 @@
 
 #include "velox/common/memory/MemoryArbitrator.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "velox/common/base/Counters.h"
@@ -141,6 +142,32 @@ class NoopArbitrator : public MemoryArbitrator {
 thread_local MemoryArbitrationContext* arbitrationCtx{nullptr};
 } // namespace
 
+std::string arbitrationPriorityName(ArbitrationPriority priority) {
+  switch (priority) {
+    case ArbitrationPriority::kBatch:
+      return "BATCH";
+    case ArbitrationPriority::kDefault:
+      return "DEFAULT";
+    case ArbitrationPriority::kInteractive:
+      return "INTERACTIVE";
+    default:
+      return fmt::format("UNKNOWN: {}", static_cast<int32_t>(priority));
+  }
+}
+
+ArbitrationPriority arbitrationPriorityFromName(const std::string& name) {
+  std::string upperName = name;
+  std::transform(
+      upperName.begin(), upperName.end(), upperName.begin(), ::toupper);
+  for (int32_t i = 0; i < kNumArbitrationPriorities; ++i) {
+    const auto priority = static_cast<ArbitrationPriority>(i);
+    if (arbitrationPriorityName(priority) == upperName) {
+      return priority;
+    }
+  }
+  VELOX_USER_FAIL("Unknown arbitration priority class: {}", name);
+}
+
 std::unique_ptr<MemoryArbitrator> MemoryArbitrator::create(
     const Config& config) {
   if (config.kind.empty()) {
@@ -30,6 +30,26 @@ class MemoryPool;
 
 using MemoryArbitrationStateCheckCB = std::function<void(MemoryPool&)>;
 
+/// The priority classes of the queries sharing the memory of a node. The
+/// shared memory arbitrator spills and aborts the queries of lower classes
+/// before the queries of higher classes, and a query doesn't spill the queries
+/// of higher classes to grow unless it is below its guaranteed capacity. E.g.
+/// a batch backfill fails or spills itself instead of making an interactive
+/// dashboard query spill.
+enum class ArbitrationPriority : int32_t {
+  kBatch = 0,
+  kDefault = 1,
+  kInteractive = 2,
+};
+
+constexpr int32_t kNumArbitrationPriorities = 3;
+
+std::string arbitrationPriorityName(ArbitrationPriority priority);
+
+/// Returns the priority class with name 'name', e.g. 'BATCH', ignoring the
+/// case. Throws if 'name' is not a priority class.
+ArbitrationPriority arbitrationPriorityFromName(const std::string& name);
+
 /// The memory arbitrator interface. There is one memory arbitrator object per
 /// memory manager which is responsible for arbitrating memory usage among the
 /// query memory pools for query memory isolation. When a memory pool exceeds
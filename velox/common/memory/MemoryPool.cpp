@@ -222,7 +222,8 @@ MemoryPool::MemoryPool(
       trackUsage_(options.trackUsage),
       threadSafe_(options.threadSafe),
       debugEnabled_(options.debugEnabled),
-      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled) {
+      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      reservationSlack_(options.reservationSlack) {
   VELOX_CHECK(!isRoot() || !isLeaf());
   VELOX_CHECK_GT(
       maxCapacity_, 0, "Memory pool {} max capacity can't be zero", name_);
@@ -701,7 +702,8 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .debugEnabled = debugEnabled_,
-          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_});
+          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_,
+          .reservationSlack = static_cast<uint64_t>(reservationSlack_)});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -877,18 +879,19 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
     int64_t newQuantized;
     if (FOLLY_UNLIKELY(releaseOnly)) {
       VELOX_DCHECK_EQ(size, 0);
-      if (minReservationBytes_ == 0) {
+      if (minReservationBytes_ == 0 && reservationSlack_ == 0) {
         return;
       }
       newQuantized = quantizedSize(usedReservationBytes_);
       minReservationBytes_ = 0;
+      freeable = reservationBytes_ - newQuantized;
     } else {
       usedReservationBytes_ -= size;
       const int64_t newCap =
           std::max(minReservationBytes_, usedReservationBytes_);
       newQuantized = quantizedSize(newCap);
+      freeable = freeableReservationLocked(newQuantized);
     }
-    freeable = reservationBytes_ - newQuantized;
     if (freeable > 0) {
       reservationBytes_ = newQuantized;
     }
@@ -156,6 +156,17 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// Terminates the process and generates a core file on an allocation
     /// failure
     bool coreOnAllocationFailureEnabled{false};
+
+    /// The max unused memory reservation in bytes a leaf memory pool keeps
+    /// after frees while it is in use. The leaf pool then returns freed
+    /// reservation up the pool tree in bulk once it has more unused
+    /// reservation than this, instead of on each free that crosses a quantized
+    /// reservation size. This cuts the propagation of the reservation updates
+    /// through the ancestor pools with many drivers allocating and freeing
+    /// small buffers. The reserved bytes of the ancestors exceed the actual
+    /// usage by at most this much per leaf pool. It is inherited by the child
+    /// pools. 0 disables.
+    uint64_t reservationSlack{0};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -492,6 +503,28 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     return parent_ == nullptr;
   }
 
+  /// Sets the priority class of the query of this root memory pool and the
+  /// capacity guaranteed to the query. The memory arbitrator doesn't shrink
+  /// or spill the pool below 'guaranteedCapacity' but might still abort it
+  /// to free up memory.
+  void setArbitrationPriority(
+      ArbitrationPriority priority,
+      uint64_t guaranteedCapacity = 0) {
+    VELOX_CHECK(isRoot(), "Only root memory pools have a priority class");
+    arbitrationPriority_ = priority;
+    guaranteedCapacity_ = guaranteedCapacity;
+  }
+
+  /// Returns the priority class of the query of this root memory pool.
+  ArbitrationPriority arbitrationPriority() const {
+    return arbitrationPriority_;
+  }
+
+  /// Returns the capacity guaranteed to the query of this root memory pool.
+  uint64_t guaranteedCapacity() const {
+    return guaranteedCapacity_;
+  }
+
   /// Returns the next higher quantized size for the internal memory reservation
   /// propagation. Small sizes are at MB granularity, larger ones at coarser
   /// granularity.
@@ -533,6 +566,7 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const int64_t reservationSlack_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
   /// not.
@@ -543,6 +577,12 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// Saves the aborted error exception which is only set if 'aborted_' is true.
   std::exception_ptr abortError_{nullptr};
 
+  /// The priority class and guaranteed capacity for memory arbitration. Only
+  /// set for a root memory pool.
+  std::atomic<ArbitrationPriority> arbitrationPriority_{
+      ArbitrationPriority::kDefault};
+  std::atomic<uint64_t> guaranteedCapacity_{0};
+
   mutable folly::SharedMutex poolMutex_;
   std::unordered_map<std::string, std::weak_ptr<MemoryPool>> children_;
 
@@ -871,21 +911,23 @@ class MemoryPoolImpl : public MemoryPool {
     VELOX_DCHECK_NOT_NULL(parent_);
 
     int64_t newQuantized;
+    int64_t freeable;
     if (FOLLY_UNLIKELY(releaseOnly)) {
       VELOX_DCHECK_EQ(size, 0);
-      if (minReservationBytes_ == 0) {
+      if (minReservationBytes_ == 0 && reservationSlack_ == 0) {
         return;
       }
       newQuantized = quantizedSize(usedReservationBytes_);
       minReservationBytes_ = 0;
+      freeable = reservationBytes_ - newQuantized;
     } else {
       usedReservationBytes_ -= size;
       const int64_t newCap =
           std::max(minReservationBytes_, usedReservationBytes_);
       newQuantized = quantizedSize(newCap);
+      freeable = freeableReservationLocked(newQuantized);
     }
 
-    const int64_t freeable = reservationBytes_ - newQuantized;
     if (FOLLY_UNLIKELY(freeable > 0)) {
       reservationBytes_ = newQuantized;
       sanityCheckLocked();
@@ -893,6 +935,19 @@ class MemoryPoolImpl : public MemoryPool {
     }
   }
 
+  // Returns the unused reservation to release for a leaf pool to shrink its
+  // reservation to 'newQuantized' after a free. Returns 0 to keep the unused
+  // reservation if it is within 'reservationSlack_' and the pool is still in
+  // use.
+  FOLLY_ALWAYS_INLINE int64_t
+  freeableReservationLocked(int64_t newQuantized) const {
+    const int64_t freeable = reservationBytes_ - newQuantized;
+    if (freeable <= reservationSlack_ && usedReservationBytes_ > 0) {
+      return 0;
+    }
+    return freeable;
+  }
+
   // Decrements the reservation in 'this' and parents.
   void decrementReservation(uint64_t size) noexcept;
 
@@ -23,10 +23,13 @@
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/memory/Memory.h"
 
+DECLARE_bool(velox_memory_use_hugepages);
+
 namespace facebook::velox::memory {
 MmapAllocator::MmapAllocator(const Options& options)
     : kind_(MemoryAllocator::Kind::kMmap),
       useMmapArena_(options.useMmapArena),
+      useHugePages_(options.useHugePages),
       maxMallocBytes_(options.maxMallocBytes),
       mallocReservedBytes_(
           maxMallocBytes_ == 0
@@ -36,7 +39,10 @@ MmapAllocator::MmapAllocator(const Options& options)
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
           64 * sizeClassSizes_.back())) {
   for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+    sizeClasses_.push_back(std::make_unique<SizeClass>(
+        capacity_ / size,
+        size,
+        useHugePages_ && size >= kMinHugePageClassPages));
   }
 
   if (useMmapArena_) {
@@ -508,7 +514,10 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    bool useHugePages)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
@@ -537,6 +546,27 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+#ifdef linux
+  if (useHugePages) {
+    if (::madvise(address_, byteSize_, MADV_HUGEPAGE) == 0) {
+      hugePages_ = true;
+    } else {
+      VELOX_MEM_LOG(WARNING)
+          << "madvise hugepage failed for sizeClass " << unitSize_
+          << ", falling back to regular pages, errno="
+          << folly::errnoStr(errno);
+    }
+  }
+#endif
+}
+
+MachinePageCount MmapAllocator::SizeClass::numMappedPages() const {
+  ClassPageCount numMapped = 0;
+  std::lock_guard<std::mutex> l(mutex_);
+  for (int i = 0; i < pageBitmapSize_; ++i) {
+    numMapped += __builtin_popcountll(pageMapped_[i]);
+  }
+  return numMapped * unitSize_;
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
@@ -950,6 +980,20 @@ bool MmapAllocator::checkConsistency() const {
   return numErrors == 0;
 }
 
+Stats MmapAllocator::stats() const {
+  auto stats = stats_;
+  stats.numAdvise = numAdvisedPages_;
+  MachinePageCount hugePageBacked =
+      FLAGS_velox_memory_use_hugepages ? numExternalMapped_.load() : 0;
+  for (const auto& sizeClass : sizeClasses_) {
+    if (sizeClass->hugePages()) {
+      hugePageBacked += sizeClass->numMappedPages();
+    }
+  }
+  stats.numHugePages = hugePageBacked / AllocationTraits::numPagesInHugePage();
+  return stats;
+}
+
 bool MmapAllocator::useMalloc(uint64_t bytes) {
   return (maxMallocBytes_ != 0) && (bytes <= maxMallocBytes_);
 }
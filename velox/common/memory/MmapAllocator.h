@@ -78,8 +78,22 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// If true, advises the kernel to back the address ranges of the size
+    /// classes of at least 'kMinHugePageClassPages' machine pages with
+    /// transparent huge pages. Falls back to regular pages if transparent huge
+    /// pages are not available.
+    bool useHugePages = false;
   };
 
+  /// The smallest size class that is backed by huge pages if
+  /// Options::useHugePages is set. Every size class unit, at most 256 pages
+  /// (1MB), is smaller than a 2MB huge page, so advising away a free unit of
+  /// any class splits the huge page that holds it. Only the largest class is
+  /// backed by huge pages: its units are half a huge page, so it splits the
+  /// fewest huge pages per byte advised away.
+  static constexpr MachinePageCount kMinHugePageClassPages = 256;
+
   explicit MmapAllocator(const Options& options);
 
   ~MmapAllocator();
@@ -151,11 +165,7 @@ class MmapAllocator : public MemoryAllocator {
     return numMallocBytes_.readFull();
   }
 
-  Stats stats() const override {
-    auto stats = stats_;
-    stats.numAdvise = numAdvisedPages_;
-    return stats;
-  }
+  Stats stats() const override;
 
   std::string toString() const override;
 
@@ -166,7 +176,7 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    SizeClass(size_t capacity, MachinePageCount unitSize, bool useHugePages);
 
     ~SizeClass();
 
@@ -174,6 +184,15 @@ class MmapAllocator : public MemoryAllocator {
       return unitSize_;
     }
 
+    // True if the address range of 'this' is advised to be backed by huge
+    // pages.
+    bool hugePages() const {
+      return hugePages_;
+    }
+
+    // Returns the number of machine pages of 'this' that are backed by memory.
+    MachinePageCount numMappedPages() const;
+
     // Allocates 'numPages' from 'this' and appends these to *out.
     // '*numUnmapped' is incremented by the number of pages that are not backed
     // by memory.
@@ -284,6 +303,9 @@ class MmapAllocator : public MemoryAllocator {
     // Start of address range.
     uint8_t* address_;
 
+    // True if the kernel accepted the huge page advice for the address range.
+    bool hugePages_{false};
+
     // Index of last modified word in 'pageAllocated_'. Sweeps over
     // the bitmaps when looking for free pages.
     int32_t clockHand_ = 0;
@@ -377,6 +399,9 @@ class MmapAllocator : public MemoryAllocator {
   // issued for each such allocation.
   const bool useMmapArena_;
 
+  // If true, the large size classes are advised to be backed by huge pages.
+  const bool useHugePages_;
+
   // Serializes moving capacity between size classes
   std::mutex sizeClassBalanceMutex_;
 
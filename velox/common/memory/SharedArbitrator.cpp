@@ -64,6 +64,9 @@ std::string memoryPoolAbortMessage(
   return out.str();
 }
 
+// The sort functions below order the candidates of lower priority classes
+// first so that the arbitrator reclaims from the less important queries
+// first.
 void sortCandidatesByReclaimableFreeCapacity(
     std::vector<SharedArbitrator::Candidate>& candidates) {
   std::sort(
@@ -71,6 +74,9 @@ void sortCandidatesByReclaimableFreeCapacity(
       candidates.end(),
       [&](const SharedArbitrator::Candidate& lhs,
           const SharedArbitrator::Candidate& rhs) {
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
         return lhs.freeBytes > rhs.freeBytes;
       });
 
@@ -86,6 +92,9 @@ void sortCandidatesByReclaimableUsedCapacity(
       candidates.end(),
       [](const SharedArbitrator::Candidate& lhs,
          const SharedArbitrator::Candidate& rhs) {
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
         return lhs.reclaimableBytes > rhs.reclaimableBytes;
       });
 
@@ -101,28 +110,42 @@ void sortCandidatesByUsage(
       candidates.end(),
       [](const SharedArbitrator::Candidate& lhs,
          const SharedArbitrator::Candidate& rhs) {
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
         return lhs.currentBytes > rhs.currentBytes;
       });
 }
 
-// Finds the candidate with the largest capacity. For 'requestor', the
-// capacity for comparison including its current capacity and the capacity to
-// grow.
+// Finds the candidate with the largest capacity among the candidates of the
+// lowest priority class. For 'requestor', the capacity for comparison
+// including its current capacity and the capacity to grow.
 const SharedArbitrator::Candidate& findCandidateWithLargestCapacity(
     MemoryPool* requestor,
     uint64_t targetBytes,
     const std::vector<SharedArbitrator::Candidate>& candidates) {
   VELOX_CHECK(!candidates.empty());
+  const auto lowestPriority =
+      std::min_element(
+          candidates.begin(),
+          candidates.end(),
+          [](const auto& lhs, const auto& rhs) {
+            return lhs.priority < rhs.priority;
+          })
+          ->priority;
   int32_t candidateIdx{-1};
   int64_t maxCapacity{-1};
   for (int32_t i = 0; i < candidates.size(); ++i) {
+    if (candidates[i].priority != lowestPriority) {
+      continue;
+    }
     const bool isCandidate = candidates[i].pool == requestor;
     // For capacity comparison, the requestor's capacity should include both its
     // current capacity and the capacity growth.
     const int64_t capacity =
         candidates[i].pool->capacity() + (isCandidate ? targetBytes : 0);
-    if (i == 0) {
-      candidateIdx = 0;
+    if (candidateIdx == -1) {
+      candidateIdx = i;
       maxCapacity = capacity;
       continue;
     }
@@ -154,8 +177,9 @@ SharedArbitrator::SharedArbitrator(const MemoryArbitrator::Config& config)
 
 std::string SharedArbitrator::Candidate::toString() const {
   return fmt::format(
-      "CANDIDATE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}]]",
+      "CANDIDATE[{}] PRIORITY[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}]]",
       pool->root()->name(),
+      arbitrationPriorityName(priority),
       succinctBytes(reclaimableBytes),
       succinctBytes(freeBytes));
 }
@@ -186,13 +210,16 @@ std::vector<SharedArbitrator::Candidate> SharedArbitrator::getCandidateStats(
         {freeCapacityOnly ? 0 : reclaimableUsedCapacity(*pool),
          reclaimableFreeCapacity(*pool),
          pool->currentBytes(),
+         pool->arbitrationPriority(),
          pool.get()});
   }
   return candidates;
 }
 
 int64_t SharedArbitrator::maxReclaimableCapacity(const MemoryPool& pool) const {
-  return std::max<int64_t>(0, pool.capacity() - memoryPoolReservedCapacity_);
+  const int64_t minCapacity = std::max<uint64_t>(
+      memoryPoolReservedCapacity_, pool.root()->guaranteedCapacity());
+  return std::max<int64_t>(0, pool.capacity() - minCapacity);
 }
 
 int64_t SharedArbitrator::reclaimableFreeCapacity(
@@ -367,6 +394,7 @@ bool SharedArbitrator::growCapacity(
     candidates = getCandidateStats(candidatePools);
     if (arbitrateMemory(requestor, candidates, targetBytes)) {
       ++numSucceeded_;
+      ++priorityStats(*requestor).numGrows;
       return true;
     }
     if (numRetries > 0) {
@@ -428,9 +456,12 @@ bool SharedArbitrator::handleOOM(
         << " is selected as victim memory pool so fail the memory arbitration";
     return false;
   }
-  VELOX_MEM_LOG(WARNING) << "Aborting victim memory pool " << victim->name()
-                         << " to free up memory for requestor "
-                         << requestor->name();
+  VELOX_MEM_LOG(WARNING)
+      << "Aborting victim memory pool " << victim->name() << " of priority "
+      << arbitrationPriorityName(victim->arbitrationPriority())
+      << " to free up memory for requestor " << requestor->name()
+      << " of priority "
+      << arbitrationPriorityName(requestor->arbitrationPriority());
   try {
     if (victim == requestor) {
       VELOX_MEM_POOL_CAP_EXCEEDED(
@@ -528,14 +559,11 @@ uint64_t SharedArbitrator::reclaimFreeMemoryFromCandidates(
   uint64_t freedBytes{0};
   for (const auto& candidate : candidates) {
     VELOX_CHECK_LT(freedBytes, targetBytes);
-    if (candidate.freeBytes == 0) {
-      break;
+    if (candidate.freeBytes <= 0) {
+      continue;
     }
     const int64_t bytesToShrink =
         std::min<int64_t>(targetBytes - freedBytes, candidate.freeBytes);
-    if (bytesToShrink <= 0) {
-      break;
-    }
     freedBytes += candidate.pool->shrink(bytesToShrink);
     if (freedBytes >= targetBytes) {
       break;
@@ -553,10 +581,19 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidatesBySpill(
   // Sort candidate memory pools based on their reclaimable used capacity.
   sortCandidatesByReclaimableUsedCapacity(candidates);
 
+  // A requestor below its guaranteed capacity may spill any query. Otherwise
+  // it only spills the queries of its own or lower priority classes.
+  const bool belowGuaranteedCapacity = requestor != nullptr &&
+      requestor->capacity() < requestor->guaranteedCapacity();
   uint64_t freedBytes{0};
   for (const auto& candidate : candidates) {
     VELOX_CHECK_LT(freedBytes, targetBytes);
     if (candidate.reclaimableBytes == 0) {
+      continue;
+    }
+    if (requestor != nullptr && !belowGuaranteedCapacity &&
+        candidate.priority > requestor->arbitrationPriority()) {
+      // The candidates are sorted by priority class.
       break;
     }
     freedBytes += reclaim(candidate.pool, targetBytes - freedBytes, false);
@@ -577,7 +614,7 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidatesByAbort(
   for (const auto& candidate : candidates) {
     VELOX_CHECK_LT(freedBytes, targetBytes);
     if (candidate.pool->capacity() == 0) {
-      break;
+      continue;
     }
     try {
       VELOX_MEM_POOL_ABORTED(fmt::format(
@@ -641,7 +678,13 @@ uint64_t SharedArbitrator::reclaim(
   numShrunkBytes_ += reclaimedFreeBytes;
   reclaimTimeUs_ += reclaimDurationUs;
   numNonReclaimableAttempts_ += reclaimerStats.numNonReclaimableAttempts;
+  auto& classStats = priorityStats(*pool->root());
+  ++classStats.numReclaims;
+  classStats.numReclaimedBytes += reclaimedBytes;
   VELOX_MEM_LOG(INFO) << "Reclaimed from memory pool " << pool->name()
+                      << " of priority "
+                      << arbitrationPriorityName(
+                             pool->root()->arbitrationPriority())
                       << " with target of " << succinctBytes(targetBytes)
                       << ", actually reclaimed "
                       << succinctBytes(reclaimedFreeBytes)
@@ -657,6 +700,7 @@ void SharedArbitrator::abort(
     const std::exception_ptr& error) {
   RECORD_METRIC_VALUE(kMetricArbitratorAbortedCount);
   ++numAborted_;
+  ++priorityStats(*pool->root()).numAborted;
   try {
     pool->abort(error);
   } catch (const std::exception& e) {
@@ -727,13 +771,25 @@ std::string SharedArbitrator::toString() const {
 }
 
 std::string SharedArbitrator::toStringLocked() const {
+  std::stringstream priorityOut;
+  for (int32_t i = 0; i < kNumArbitrationPriorities; ++i) {
+    const auto& stats = priorityStats_[i];
+    priorityOut << fmt::format(
+        " {}[GROWS[{}] RECLAIMS[{}] RECLAIMED[{}] ABORTED[{}]]",
+        arbitrationPriorityName(static_cast<ArbitrationPriority>(i)),
+        stats.numGrows,
+        stats.numReclaims,
+        succinctBytes(stats.numReclaimedBytes),
+        stats.numAborted);
+  }
   return fmt::format(
-      "ARBITRATOR[{} CAPACITY[{}] RUNNING[{}] QUEUING[{}] {}]",
+      "ARBITRATOR[{} CAPACITY[{}] RUNNING[{}] QUEUING[{}] {} PRIORITIES[{}]]",
       kind_,
       succinctBytes(capacity_),
       running_ ? "true" : "false",
       waitPromises_.size(),
-      statsLocked().toString());
+      statsLocked().toString(),
+      priorityOut.str().substr(1));
 }
 
 SharedArbitrator::ScopedArbitration::ScopedArbitration(
@@ -31,6 +31,13 @@ namespace facebook::velox::memory {
 /// aborting a query. For Prestissimo-on-Spark, we can configure it to
 /// reclaim from a running query through techniques such as disk-spilling,
 /// partial aggregation or persistent shuffle data flushes.
+///
+/// The arbitrator takes the priority class of each query into account (see
+/// ArbitrationPriority). It reclaims from the queries of the lowest class
+/// first, never spills the queries of a higher class than the requestor unless
+/// the requestor is below its guaranteed capacity, and aborts the largest
+/// query of the lowest class on out of memory. It never shrinks or spills a
+/// query below its guaranteed capacity.
 class SharedArbitrator : public memory::MemoryArbitrator {
  public:
   explicit SharedArbitrator(const Config& config);
@@ -67,6 +74,7 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     int64_t reclaimableBytes{0};
     int64_t freeBytes{0};
     int64_t currentBytes{0};
+    ArbitrationPriority priority{ArbitrationPriority::kDefault};
     MemoryPool* pool;
 
     std::string toString() const;
@@ -153,10 +161,12 @@ class SharedArbitrator : public memory::MemoryArbitrator {
       std::vector<Candidate>& candidates,
       uint64_t targetBytes);
 
-  // Invoked to reclaim used memory capacity from 'candidates' by spilling.
+  // Invoked to reclaim used memory capacity from 'candidates' by spilling. The
+  // candidates of a higher priority class than 'requestor' are skipped unless
+  // 'requestor' is below its guaranteed capacity.
   //
   // NOTE: the function might sort 'candidates' based on each candidate's
-  // reclaimable memory internally.
+  // priority class and reclaimable memory internally.
   uint64_t reclaimUsedMemoryFromCandidatesBySpill(
       MemoryPool* requestor,
       std::vector<Candidate>& candidates,
@@ -187,10 +197,11 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   void abort(MemoryPool* pool, const std::exception_ptr& error);
 
   // Invoked to handle the memory arbitration failure to abort the memory pool
-  // with the largest capacity to free up memory. The function returns true on
-  // success and false if the requestor itself has been selected as the victim.
-  // We don't abort the requestor itself but just fails the arbitration to let
-  // the user decide to either proceed with the query or fail it.
+  // with the largest capacity of the lowest priority class to free up memory.
+  // The function returns true on success and false if the requestor itself has
+  // been selected as the victim. We don't abort the requestor itself but just
+  // fails the arbitration to let the user decide to either proceed with the
+  // query or fail it.
   bool handleOOM(
       MemoryPool* requestor,
       uint64_t targetBytes,
@@ -224,7 +235,8 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   void incrementLocalArbitrationCount();
 
   // Returns the max reclaimable capacity from 'pool' which includes both used
-  // and free capacities.
+  // and free capacities. The capacity reserved by 'memoryPoolReservedCapacity_'
+  // or guaranteed to the pool's query is not reclaimable.
   int64_t maxReclaimableCapacity(const MemoryPool& pool) const;
 
   // Returns the free memory capacity that can be reclaimed from 'pool' by
@@ -261,5 +273,18 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   tsan_atomic<uint64_t> numNonReclaimableAttempts_{0};
   tsan_atomic<uint64_t> numReserves_{0};
   tsan_atomic<uint64_t> numReleases_{0};
+
+  // The arbitration decisions per priority class of the affected queries.
+  struct PriorityStats {
+    tsan_atomic<uint64_t> numGrows{0};
+    tsan_atomic<uint64_t> numReclaims{0};
+    tsan_atomic<uint64_t> numReclaimedBytes{0};
+    tsan_atomic<uint64_t> numAborted{0};
+  };
+  std::array<PriorityStats, kNumArbitrationPriorities> priorityStats_;
+
+  PriorityStats& priorityStats(const MemoryPool& pool) {
+    return priorityStats_[static_cast<int32_t>(pool.arbitrationPriority())];
+  }
 };
 } // namespace facebook::velox::memory
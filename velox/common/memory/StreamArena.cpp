@@ -76,6 +76,25 @@ void StreamArena::newTinyRange(
   range->buffer = reinterpret_cast<uint8_t*>(tinyRanges_.back().data());
   range->size = bytes;
 }
+std::shared_ptr<StreamArena> StreamArena::detach() {
+  auto detached = std::make_shared<StreamArena>(pool_);
+  detached->allocations_ = std::move(allocations_);
+  allocations_.clear();
+  if (allocation_.numRuns() > 0) {
+    detached->allocations_.push_back(
+        std::make_unique<memory::Allocation>(std::move(allocation_)));
+  }
+  detached->largeAllocations_ = std::move(largeAllocations_);
+  largeAllocations_.clear();
+  detached->tinyRanges_ = std::move(tinyRanges_);
+  tinyRanges_.clear();
+  detached->size_ = size_;
+  currentRun_ = 0;
+  currentOffset_ = 0;
+  size_ = 0;
+  return detached;
+}
+
 void StreamArena::clear() {
   allocations_.clear();
   pool_->freeNonContiguous(allocation_);
@@ -66,6 +66,12 @@ class StreamArena {
   /// serilizers.
   virtual void clear();
 
+  /// Moves the memory held by 'this' to the returned arena and restores
+  /// 'this' to post-construction state. Ranges handed out before stay valid
+  /// while the returned arena is alive. Used to reference serialized bytes
+  /// from IOBufs without copying them.
+  std::shared_ptr<StreamArena> detach();
+
  private:
   memory::MemoryPool* const pool_;
   const memory::MachinePageCount allocationQuantum_{2};
@@ -395,3 +395,52 @@ TEST_F(ByteStreamTest, reuse) {
     EXPECT_EQ(sizeof(bytes), stream.size());
   }
 }
+
+TEST_F(ByteStreamTest, referenceArenaBytes) {
+  auto arena = newArena();
+  ByteOutputStream source(arena.get());
+  source.startWrite(1000);
+  std::string data(100'000, '\0');
+  for (auto i = 0; i < data.size(); ++i) {
+    data[i] = i % 251;
+  }
+  source.appendStringView(data);
+
+  std::stringstream referenceSStream;
+  OStreamOutputStream reference(&referenceSStream);
+  auto out = std::make_unique<IOBufOutputStream>(*pool_, nullptr, 100);
+  out->setReferenceArenaBytes();
+  std::vector<OutputStream*> streams = {out.get(), &reference};
+  for (auto* stream : streams) {
+    stream->write("header", 6);
+    source.flush(stream);
+    stream->write("trailer", 7);
+    // Patches the header like serializers do with sizes and checksums.
+    const auto end = stream->tellp();
+    stream->seekp(2);
+    stream->write("AD", 2);
+    stream->seekp(end);
+  }
+  EXPECT_EQ(reference.tellp(), out->tellp());
+  EXPECT_THROW(out->seekp(50'000), VeloxRuntimeError);
+  EXPECT_THROW(out->getIOBuf(), VeloxRuntimeError);
+
+  auto referencedArena = arena->detach();
+  EXPECT_EQ(0, arena->size());
+  arena->clear();
+  auto iobuf = out->getIOBuf(nullptr, std::move(referencedArena));
+  // The referenced ranges are chained, not copied.
+  EXPECT_LT(2, iobuf->countChainElements());
+  auto clone = iobuf->clone();
+  auto bytes = clone->coalesce();
+  EXPECT_EQ(
+      referenceSStream.str(),
+      std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+
+  // 'iobuf' keeps the memory of 'out' and of the detached arena alive.
+  out = nullptr;
+  arena = nullptr;
+  EXPECT_LT(0, mmapAllocator_->numAllocated());
+  iobuf = nullptr;
+  EXPECT_EQ(0, mmapAllocator_->numAllocated());
+}
@@ -240,6 +240,56 @@ TEST_F(HashStringAllocatorTest, finishWrite) {
   }
 }
 
+TEST_F(HashStringAllocatorTest, relocate) {
+  // Writes a multipart value by appending to it a piece at a time.
+  ByteOutputStream stream(allocator_.get());
+  const auto start = allocator_->newWrite(stream, 64);
+  auto current = allocator_->finishWrite(stream, 0).second;
+  std::string reference;
+  for (auto i = 0; i < 100; ++i) {
+    // Interleaves with other allocations so that the value is not contiguous.
+    allocate(100);
+    const auto piece = randomString(1 + rand32() % 200);
+    allocator_->extendWrite(current, stream);
+    stream.appendStringView(piece);
+    current = allocator_->finishWrite(stream, 0).second;
+    reference += piece;
+  }
+  ASSERT_EQ(HSA::offset(start.header, current), reference.size());
+  ASSERT_TRUE(start.header->isContinued());
+
+  auto target = std::make_unique<HashStringAllocator>(pool_.get());
+  const auto [copyStart, copyEnd] =
+      target->relocate(start.header, reference.size(), 8);
+  ASSERT_EQ(HSA::offset(copyStart.header, copyEnd), reference.size());
+  ASSERT_GE(HSA::available(copyEnd), 8);
+  allocator_.reset();
+
+  auto input = HSA::prepareRead(copyStart.header, reference.size());
+  std::string copy(reference.size(), 0);
+  input.readBytes(copy.data(), copy.size());
+  ASSERT_EQ(copy, reference);
+  target->checkConsistency();
+}
+
+TEST_F(HashStringAllocatorTest, fragmentationRatio) {
+  ASSERT_EQ(allocator_->fragmentationRatio(), 0);
+  std::vector<HSA::Header*> headers;
+  for (auto i = 0; i < 10'000; ++i) {
+    headers.push_back(allocate(100));
+  }
+  const auto ratio = allocator_->fragmentationRatio();
+  for (auto i = 0; i < headers.size(); i += 2) {
+    allocator_->free(headers[i]);
+  }
+  ASSERT_GT(allocator_->fragmentationRatio(), ratio + 0.3);
+  ASSERT_LT(allocator_->fragmentationRatio(), 1);
+  for (auto i = 1; i < headers.size(); i += 2) {
+    allocator_->free(headers[i]);
+  }
+  ASSERT_TRUE(allocator_->isEmpty());
+}
+
 TEST_F(HashStringAllocatorTest, multipart) {
   constexpr int32_t kNumSamples = 10'000;
   std::vector<Multipart> data(kNumSamples);
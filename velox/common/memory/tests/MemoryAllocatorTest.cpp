@@ -475,6 +475,35 @@ TEST_P(MemoryAllocatorTest, mmapAllocatorInit) {
   }
 }
 
+TEST_P(MemoryAllocatorTest, mmapAllocatorHugePages) {
+  if (!useMmap_) {
+    return;
+  }
+  // 8 runs of the largest size class, i.e. 4 huge pages.
+  const MachinePageCount numPages = 8 * 256;
+  for (const bool useHugePages : {false, true}) {
+    SCOPED_TRACE(fmt::format("useHugePages {}", useHugePages));
+    MmapAllocator::Options options;
+    options.capacity = kCapacityBytes;
+    options.useHugePages = useHugePages;
+    auto mmapAllocator = std::make_shared<MmapAllocator>(options);
+    ASSERT_EQ(mmapAllocator->stats().numHugePages, 0);
+
+    Allocation allocation;
+    ASSERT_TRUE(mmapAllocator->allocateNonContiguous(numPages, allocation));
+    ASSERT_EQ(allocation.numPages(), numPages);
+    const auto numHugePages = mmapAllocator->stats().numHugePages;
+    if (useHugePages) {
+      // Falls back to regular pages if the kernel rejects the advice.
+      ASSERT_TRUE(numHugePages == 0 || numHugePages == 4) << numHugePages;
+    } else {
+      ASSERT_EQ(numHugePages, 0);
+    }
+    ASSERT_TRUE(mmapAllocator->checkConsistency());
+    mmapAllocator->freeNonContiguous(allocation);
+  }
+}
+
 TEST_P(MemoryAllocatorTest, allocationPool) {
   const size_t kNumLargeAllocPages = instance_->largestSizeClass() * 2;
   const size_t kLarge = kNumLargeAllocPages * AllocationTraits::kPageSize;
@@ -238,6 +238,55 @@ BENCHMARK(FlatSticks, iters) {
   });
 }
 
+namespace {
+// Runs 'numThreads' leaf pools of one root pool in parallel. Each leaf pool
+// allocates and frees a small buffer right at its quantized reservation size
+// so that each allocation reserves from the ancestor pools and each free
+// releases back to them unless the leaf pools keep 'reservationSlack'.
+void allocateAtReservationBoundary(
+    size_t iters,
+    size_t numThreads,
+    uint64_t reservationSlack) {
+  folly::BenchmarkSuspender suspender;
+  MemoryManager manager{{.memoryPoolReservationSlack = reservationSlack}};
+  auto root = manager.addRootPool("query_fragment");
+  std::vector<std::shared_ptr<MemoryPool>> leaves;
+  for (size_t i = 0; i < numThreads; ++i) {
+    leaves.push_back(root->addLeafChild("leaf_" + folly::to<std::string>(i)));
+  }
+  constexpr int64_t kBaseBytes = (1 << 20) - kMemoryFootprintIncrement;
+  folly::CPUThreadPoolExecutor threadPool(numThreads);
+  suspender.dismiss();
+  for (auto& leaf : leaves) {
+    threadPool.add([&, pool = leaf.get()]() {
+      void* base = pool->allocate(kBaseBytes);
+      for (size_t i = 0; i < iters; ++i) {
+        void* p = pool->allocate(2 * kMemoryFootprintIncrement);
+        pool->free(p, 2 * kMemoryFootprintIncrement);
+      }
+      pool->free(base, kBaseBytes);
+    });
+  }
+  threadPool.join();
+}
+} // namespace
+
+BENCHMARK(ReservationBoundary64Threads, iters) {
+  allocateAtReservationBoundary(iters, 64, 0);
+}
+
+BENCHMARK_RELATIVE(ReservationBoundary64ThreadsWithSlack, iters) {
+  allocateAtReservationBoundary(iters, 64, 8 << 20);
+}
+
+BENCHMARK(ReservationBoundary256Threads, iters) {
+  allocateAtReservationBoundary(iters, 256, 0);
+}
+
+BENCHMARK_RELATIVE(ReservationBoundary256ThreadsWithSlack, iters) {
+  allocateAtReservationBoundary(iters, 256, 8 << 20);
+}
+
 int main(int argc, char* argv[]) {
   folly::Init init{&argc, &argv};
   folly::runBenchmarks();
@@ -835,6 +835,54 @@ TEST_P(MemoryPoolTest, childUsageTest) {
   }
 }
 
+TEST_P(MemoryPoolTest, reservationSlack) {
+  for (const int64_t slack : {0L, 8 * MB}) {
+    SCOPED_TRACE(fmt::format("slack {}", succinctBytes(slack)));
+    setupMemory(
+        {.memoryPoolReservationSlack = static_cast<uint64_t>(slack),
+         .allocatorCapacity = kDefaultCapacity,
+         .arbitratorCapacity = kDefaultCapacity,
+         .arbitratorReservedCapacity = 1LL << 30});
+    auto root = getMemoryManager()->addRootPool("reservationSlack");
+    auto leaf = root->addLeafChild("leaf", isLeafThreadSafe_);
+
+    void* base = leaf->allocate(MB / 2);
+    ASSERT_EQ(root->currentBytes(), MB);
+
+    // A free that crosses the quantized reservation size keeps the unused
+    // reservation within the slack.
+    void* buffer = leaf->allocate(MB);
+    ASSERT_EQ(root->currentBytes(), 2 * MB);
+    leaf->free(buffer, MB);
+    ASSERT_EQ(leaf->currentBytes(), MB / 2);
+    ASSERT_EQ(root->currentBytes(), slack == 0 ? MB : 2 * MB);
+
+    // Allocating again reuses the kept reservation.
+    buffer = leaf->allocate(MB);
+    ASSERT_EQ(root->currentBytes(), 2 * MB);
+    leaf->free(buffer, MB);
+
+    // A larger free than the slack releases all the unused reservation.
+    buffer = leaf->allocate(20 * MB);
+    ASSERT_EQ(root->currentBytes(), 24 * MB);
+    leaf->free(buffer, 20 * MB);
+    ASSERT_EQ(root->currentBytes(), MB);
+
+    // An explicit release drops the slack.
+    buffer = leaf->allocate(MB);
+    leaf->free(buffer, MB);
+    leaf->release();
+    ASSERT_EQ(root->currentBytes(), MB);
+
+    // An unused pool keeps no reservation.
+    buffer = leaf->allocate(MB);
+    leaf->free(buffer, MB);
+    leaf->free(base, MB / 2);
+    ASSERT_EQ(leaf->currentBytes(), 0);
+    ASSERT_EQ(root->currentBytes(), 0);
+  }
+}
+
 TEST_P(MemoryPoolTest, getPreferredSize) {
   MemoryManager& manager = *getMemoryManager();
   auto& pool = dynamic_cast<MemoryPoolImpl&>(manager.testingDefaultRoot());
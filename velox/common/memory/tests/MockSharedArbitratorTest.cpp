@@ -1704,6 +1704,56 @@ DEBUG_ONLY_TEST_F(MockSharedArbitrationTest, orderedArbitration) {
   }
 }
 
+TEST_F(MockSharedArbitrationTest, arbitrationPriority) {
+  ASSERT_EQ(
+      arbitrationPriorityFromName("interactive"),
+      ArbitrationPriority::kInteractive);
+  ASSERT_EQ(arbitrationPriorityName(ArbitrationPriority::kBatch), "BATCH");
+  VELOX_ASSERT_THROW(
+      arbitrationPriorityFromName("urgent"),
+      "Unknown arbitration priority class: urgent");
+
+  for (const bool guaranteed : {false, true}) {
+    SCOPED_TRACE(fmt::format("guaranteed {}", guaranteed));
+    const uint64_t memoryCapacity = 128 * MB;
+    setupMemory(memoryCapacity, 0, 0, 0);
+    auto interactiveTask = addTask();
+    interactiveTask->pool()->setArbitrationPriority(
+        ArbitrationPriority::kInteractive);
+    auto* interactiveOp = addMemoryOp(interactiveTask);
+    auto batchTask = addTask();
+    batchTask->pool()->setArbitrationPriority(ArbitrationPriority::kBatch);
+    auto* batchOp = addMemoryOp(batchTask);
+
+    interactiveOp->allocate(memoryCapacity / 2);
+    batchOp->allocate(memoryCapacity / 2);
+
+    // The batch query spills itself instead of the interactive query.
+    batchOp->allocate(kMemoryPoolTransferCapacity);
+    ASSERT_EQ(batchOp->reclaimer()->stats().numReclaims, 1);
+    ASSERT_EQ(interactiveOp->reclaimer()->stats().numReclaims, 0);
+
+    if (guaranteed) {
+      batchTask->pool()->setArbitrationPriority(
+          ArbitrationPriority::kBatch, batchTask->pool()->capacity());
+    }
+
+    // The interactive query spills the batch query unless that would take
+    // the capacity guaranteed to the batch query. Then it spills itself.
+    interactiveOp->allocate(memoryCapacity / 2);
+    ASSERT_EQ(batchOp->reclaimer()->stats().numReclaims, guaranteed ? 1 : 2);
+    ASSERT_EQ(
+        interactiveOp->reclaimer()->stats().numReclaims, guaranteed ? 1 : 0);
+    ASSERT_EQ(batchTask->error(), nullptr);
+    ASSERT_EQ(interactiveTask->error(), nullptr);
+    ASSERT_NE(
+        arbitrator_->toString().find(
+            "INTERACTIVE[GROWS[2] RECLAIMS[" +
+            std::to_string(guaranteed ? 1 : 0) + "]"),
+        std::string::npos);
+  }
+}
+
 TEST_F(MockSharedArbitrationTest, poolCapacityTransferWithFreeCapacity) {
   const uint64_t memCapacity = 512 * MB;
   const uint64_t minPoolCapacity = 32 * MB;
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/QueryProfiler.h"
+
+#include <fmt/format.h>
+#include <folly/experimental/symbolizer/StackTrace.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/process/StackTrace.h"
+
+namespace facebook::velox::process {
+
+namespace {
+// The profiler that samples the thread and the label of its samples. Set
+// before the timer of the thread is armed, so that the signal handler does not
+// initialize thread locals.
+thread_local QueryProfiler* sampledProfiler{nullptr};
+thread_local int32_t sampleLabel{-1};
+
+// The innermost frames of a sample are the signal handler and the signal
+// trampoline.
+constexpr int32_t kSkipFrames = 3;
+} // namespace
+
+QueryProfiler::QueryProfiler(int32_t intervalMicros, int32_t maxSamples)
+    : intervalMicros_(intervalMicros),
+      maxSamples_(maxSamples),
+      samples_(std::make_unique<Sample[]>(maxSamples)) {
+  VELOX_CHECK_GT(intervalMicros_, 0);
+  VELOX_CHECK_GT(maxSamples_, 0);
+  static std::once_flag installed;
+  std::call_once(installed, []() {
+    // The first unwind may allocate, which a signal handler must not.
+    uintptr_t frames[kMaxFrames];
+    folly::symbolizer::getStackTraceSafe(frames, kMaxFrames);
+    struct sigaction action {};
+    action.sa_handler = &QueryProfiler::handleSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    VELOX_CHECK_EQ(sigaction(SIGPROF, &action, nullptr), 0);
+  });
+}
+
+QueryProfiler::Sampling::Sampling(QueryProfiler* profiler) {
+#ifdef __linux__
+  if (profiler == nullptr || sampledProfiler != nullptr) {
+    return;
+  }
+  struct sigevent event {};
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = SIGPROF;
+  event._sigev_un._tid = syscall(SYS_gettid);
+  timer_t timer;
+  if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &timer) != 0) {
+    return;
+  }
+  sampleLabel = -1;
+  sampledProfiler = profiler;
+  struct itimerspec spec {};
+  spec.it_interval.tv_sec = profiler->intervalMicros_ / 1'000'000;
+  spec.it_interval.tv_nsec = profiler->intervalMicros_ % 1'000'000 * 1'000;
+  spec.it_value = spec.it_interval;
+  timer_settime(timer, 0, &spec, nullptr);
+  static_assert(sizeof(timer_t) <= sizeof(timer_));
+  timer_ = reinterpret_cast<void*>(timer);
+  profiler_ = profiler;
+#else
+  (void)profiler;
+#endif
+}
+
+QueryProfiler::Sampling::~Sampling() {
+#ifdef __linux__
+  if (profiler_ == nullptr) {
+    return;
+  }
+  timer_delete(reinterpret_cast<timer_t>(timer_));
+  // A signal that is still pending finds no profiler.
+  sampledProfiler = nullptr;
+  sampleLabel = -1;
+#endif
+}
+
+int32_t QueryProfiler::addLabel(const std::string& label) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto [it, inserted] = labelIds_.emplace(label, labels_.size());
+  if (inserted) {
+    labels_.push_back(label);
+  }
+  return it->second;
+}
+
+// static
+void QueryProfiler::setLabel(int32_t label) {
+  sampleLabel = label;
+}
+
+// static
+void QueryProfiler::handleSignal(int /*signal*/) {
+  const auto savedErrno = errno;
+  if (auto* profiler = sampledProfiler) {
+    profiler->recordSample();
+  }
+  errno = savedErrno;
+}
+
+void QueryProfiler::recordSample() {
+  const auto index = numSamples_.fetch_add(1, std::memory_order_relaxed);
+  if (index >= maxSamples_) {
+    return;
+  }
+  auto& sample = samples_[index];
+  sample.label = sampleLabel;
+  const auto numFrames =
+      folly::symbolizer::getStackTraceSafe(sample.frames, kMaxFrames);
+  sample.numFrames = std::max<int32_t>(numFrames, 0);
+  sample.complete.store(true, std::memory_order_release);
+}
+
+std::string QueryProfiler::foldedStacks() const {
+  const auto numSamples = std::min<uint64_t>(numSamples_, maxSamples_);
+  std::unordered_map<uintptr_t, std::string> symbols;
+  std::unordered_map<std::string, int64_t> counts;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    for (auto i = 0; i < numSamples; ++i) {
+      const auto& sample = samples_[i];
+      if (!sample.complete.load(std::memory_order_acquire)) {
+        continue;
+      }
+      std::string stack = sample.label >= 0 && sample.label < labels_.size()
+          ? labels_[sample.label]
+          : "(none)";
+      for (auto j = sample.numFrames - 1; j >= kSkipFrames; --j) {
+        const auto frame = sample.frames[j];
+        auto& symbol = symbols[frame];
+        if (symbol.empty()) {
+          symbol = StackTrace::translateFrame(reinterpret_cast<void*>(frame));
+          if (symbol.empty()) {
+            symbol = fmt::format("{:#x}", frame);
+          }
+        }
+        stack += ';';
+        stack += symbol;
+      }
+      ++counts[stack];
+    }
+  }
+
+  std::vector<std::pair<std::string, int64_t>> stacks(
+      counts.begin(), counts.end());
+  std::sort(stacks.begin(), stacks.end(), [](const auto& a, const auto& b) {
+    return a.second != b.second ? a.second > b.second : a.first < b.first;
+  });
+  std::string result;
+  for (const auto& [stack, count] : stacks) {
+    result += fmt::format("{} {}\n", stack, count);
+  }
+  return result;
+}
+
+} // namespace facebook::velox::process
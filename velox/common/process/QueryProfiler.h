@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace facebook::velox::process {
+
+/// Samples the stacks of the threads that work for one query. A thread is
+/// sampled while it is in a QueryProfiler::Sampling section: a timer on the
+/// CPU time of the thread sends it SIGPROF every 'intervalMicros' and the
+/// signal handler records the stack and the current label of the thread, e.g.
+/// the operator it runs. Other threads and other queries are not sampled, so
+/// the profile of a query stays apart on a busy process. Only available on
+/// Linux. Elsewhere no samples are taken.
+class QueryProfiler {
+ public:
+  /// Keeps at most 'maxSamples' samples.
+  QueryProfiler(int32_t intervalMicros, int32_t maxSamples);
+
+  /// Samples the calling thread for 'profiler' while alive. A no-op if
+  /// 'profiler' is nullptr or the thread is already sampled. 'profiler' must
+  /// outlive this.
+  class Sampling {
+   public:
+    explicit Sampling(QueryProfiler* profiler);
+
+    ~Sampling();
+
+   private:
+    QueryProfiler* profiler_{nullptr};
+    void* timer_{nullptr};
+  };
+
+  /// Returns the id of 'label' for setLabel(). Returns the same id for the
+  /// same label.
+  int32_t addLabel(const std::string& label);
+
+  /// Sets the label of the next samples of the calling thread. -1 means no
+  /// label.
+  static void setLabel(int32_t label);
+
+  /// Returns the number of samples taken, including the ones that did not
+  /// fit.
+  uint64_t numSamples() const {
+    return numSamples_;
+  }
+
+  /// Returns the samples as folded stacks, one line per distinct label and
+  /// stack, e.g. 'label;main;run;addInput 12', with the label as the outermost
+  /// frame so that flame graphs group the samples by label. Lines are sorted
+  /// by decreasing count. Samples that are being taken are left out.
+  std::string foldedStacks() const;
+
+  static constexpr int32_t kMaxFrames = 64;
+
+ private:
+  struct Sample {
+    // Set after the other fields.
+    std::atomic<bool> complete{false};
+    int32_t label;
+    int32_t numFrames;
+    uintptr_t frames[kMaxFrames];
+  };
+
+  static void handleSignal(int signal);
+
+  // Called from the signal handler of a sampled thread.
+  void recordSample();
+
+  const int32_t intervalMicros_;
+  const int32_t maxSamples_;
+  const std::unique_ptr<Sample[]> samples_;
+  std::atomic<uint64_t> numSamples_{0};
+
+  // Serializes access to the labels.
+  mutable std::mutex mutex_;
+  std::vector<std::string> labels_;
+  std::unordered_map<std::string, int32_t> labelIds_;
+};
+
+} // namespace facebook::velox::process
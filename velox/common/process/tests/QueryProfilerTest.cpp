@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/QueryProfiler.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+namespace facebook::velox::process {
+namespace {
+
+// Keeps the CPU busy for 'millis' of wall time.
+int64_t spin(int32_t millis) {
+  const auto end =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(millis);
+  int64_t sum = 0;
+  while (std::chrono::steady_clock::now() < end) {
+    for (auto i = 0; i < 1'000; ++i) {
+      sum += i * i;
+    }
+  }
+  return sum;
+}
+
+TEST(QueryProfilerTest, labels) {
+  QueryProfiler profiler(1'000, 1'000);
+  const auto label = profiler.addLabel("0.FilterProject");
+  ASSERT_EQ(profiler.addLabel("0.FilterProject"), label);
+  ASSERT_NE(profiler.addLabel("1.HashBuild"), label);
+
+  // Not sampled outside of a Sampling section.
+  spin(20);
+  ASSERT_EQ(profiler.numSamples(), 0);
+  ASSERT_TRUE(profiler.foldedStacks().empty());
+
+#ifdef __linux__
+  {
+    QueryProfiler::Sampling sampling(&profiler);
+    // A nested section does not add a timer.
+    QueryProfiler::Sampling nested(&profiler);
+    QueryProfiler::setLabel(label);
+    spin(200);
+    QueryProfiler::setLabel(-1);
+  }
+  const auto numSamples = profiler.numSamples();
+  ASSERT_GT(numSamples, 0);
+  spin(20);
+  ASSERT_EQ(profiler.numSamples(), numSamples);
+
+  const auto stacks = profiler.foldedStacks();
+  ASSERT_EQ(stacks.rfind("0.FilterProject;", 0), 0) << stacks;
+  int64_t total = 0;
+  size_t start = 0;
+  while (start < stacks.size()) {
+    const auto end = stacks.find('\n', start);
+    const auto space = stacks.rfind(' ', end);
+    total += std::stoll(stacks.substr(space + 1, end - space - 1));
+    start = end + 1;
+  }
+  ASSERT_EQ(total, std::min<uint64_t>(numSamples, 1'000));
+#endif
+}
+
+TEST(QueryProfilerTest, maxSamples) {
+  QueryProfiler profiler(100, 10);
+  {
+    QueryProfiler::Sampling sampling(&profiler);
+    QueryProfiler::Sampling none(nullptr);
+    spin(100);
+  }
+#ifdef __linux__
+  ASSERT_GT(profiler.numSamples(), 10);
+  ASSERT_EQ(profiler.foldedStacks().rfind("(none);", 0), 0);
+#endif
+}
+
+} // namespace
+} // namespace facebook::velox::process
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/serialization/BinarySerde.h"
+
+#include <cstring>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/encode/Coding.h"
+
+namespace facebook::velox {
+
+namespace {
+// Leading byte of the format. Changes when the encoding changes.
+constexpr uint8_t kFormatVersion = 1;
+
+// Strings up to this size are numbered and written once.
+constexpr size_t kMaxReferencedSize = 64;
+
+enum class Tag : uint8_t {
+  kNull = 0,
+  kFalse = 1,
+  kTrue = 2,
+  kInt = 3,
+  kDouble = 4,
+  kString = 5,
+  kStringReference = 6,
+  kArray = 7,
+  kObject = 8,
+};
+
+class BinaryWriter {
+ public:
+  explicit BinaryWriter(std::string& out) : out_(out) {}
+
+  void write(const folly::dynamic& value) {
+    switch (value.type()) {
+      case folly::dynamic::NULLT:
+        writeTag(Tag::kNull);
+        break;
+      case folly::dynamic::BOOL:
+        writeTag(value.getBool() ? Tag::kTrue : Tag::kFalse);
+        break;
+      case folly::dynamic::INT64:
+        writeTag(Tag::kInt);
+        writeVarint(ZigZag::encode(value.getInt()));
+        break;
+      case folly::dynamic::DOUBLE: {
+        writeTag(Tag::kDouble);
+        const double number = value.getDouble();
+        out_.append(reinterpret_cast<const char*>(&number), sizeof(number));
+        break;
+      }
+      case folly::dynamic::STRING:
+        writeString(value.getString());
+        break;
+      case folly::dynamic::ARRAY:
+        writeTag(Tag::kArray);
+        writeVarint(value.size());
+        for (const auto& element : value) {
+          write(element);
+        }
+        break;
+      case folly::dynamic::OBJECT:
+        writeTag(Tag::kObject);
+        writeVarint(value.size());
+        for (const auto& [key, element] : value.items()) {
+          write(key);
+          write(element);
+        }
+        break;
+      default:
+        VELOX_UNSUPPORTED(
+            "Unsupported folly::dynamic type: {}", value.typeName());
+    }
+  }
+
+ private:
+  void writeTag(Tag tag) {
+    out_.push_back(static_cast<char>(tag));
+  }
+
+  void writeVarint(uint64_t value) {
+    char buffer[Varint::kMaxSize64];
+    char* end = buffer;
+    Varint::encode(value, &end);
+    out_.append(buffer, end - buffer);
+  }
+
+  void writeString(std::string_view value) {
+    if (value.size() <= kMaxReferencedSize) {
+      // The views point into the value being written, which outlives 'this'.
+      auto [it, inserted] = stringIds_.emplace(value, stringIds_.size());
+      if (!inserted) {
+        writeTag(Tag::kStringReference);
+        writeVarint(it->second);
+        return;
+      }
+    }
+    writeTag(Tag::kString);
+    writeVarint(value.size());
+    out_.append(value);
+  }
+
+  std::string& out_;
+  folly::F14FastMap<std::string_view, uint64_t> stringIds_;
+};
+
+class BinaryReader {
+ public:
+  explicit BinaryReader(std::string_view data) : data_(data) {}
+
+  folly::dynamic read() {
+    const auto tag = readByte();
+    switch (static_cast<Tag>(tag)) {
+      case Tag::kNull:
+        return nullptr;
+      case Tag::kFalse:
+        return false;
+      case Tag::kTrue:
+        return true;
+      case Tag::kInt:
+        return ZigZag::decode(readVarint());
+      case Tag::kDouble: {
+        double number;
+        ::memcpy(&number, readBytes(sizeof(number)).data(), sizeof(number));
+        return number;
+      }
+      case Tag::kString: {
+        const auto size = readVarint();
+        const auto value = readBytes(size);
+        if (size <= kMaxReferencedSize) {
+          strings_.push_back(value);
+        }
+        return std::string(value);
+      }
+      case Tag::kStringReference: {
+        const auto id = readVarint();
+        VELOX_USER_CHECK_LT(
+            id, strings_.size(), "Invalid string reference in binary plan");
+        return std::string(strings_[id]);
+      }
+      case Tag::kArray: {
+        // Each element takes at least one byte.
+        const auto size = readSize(1);
+        auto array = folly::dynamic::array();
+        array.reserve(size);
+        for (uint64_t i = 0; i < size; ++i) {
+          array.push_back(read());
+        }
+        return array;
+      }
+      case Tag::kObject: {
+        const auto size = readSize(2);
+        auto object = folly::dynamic::object();
+        object.reserve(size);
+        for (uint64_t i = 0; i < size; ++i) {
+          auto key = read();
+          object.insert(std::move(key), read());
+        }
+        return object;
+      }
+      default:
+        VELOX_USER_FAIL("Invalid tag in binary plan: {}", tag);
+    }
+  }
+
+  bool atEnd() const {
+    return position_ == data_.size();
+  }
+
+  uint8_t readByte() {
+    VELOX_USER_CHECK_LT(position_, data_.size(), "Truncated binary plan");
+    return data_[position_++];
+  }
+
+ private:
+  std::string_view readBytes(uint64_t size) {
+    VELOX_USER_CHECK_LE(
+        size, data_.size() - position_, "Truncated binary plan");
+    const auto bytes = data_.substr(position_, size);
+    position_ += size;
+    return bytes;
+  }
+
+  uint64_t readVarint() {
+    uint64_t value = 0;
+    for (auto shift = 0; shift < 64; shift += 7) {
+      const uint8_t byte = readByte();
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    VELOX_USER_FAIL("Invalid varint in binary plan");
+  }
+
+  // Reads the number of elements of a container whose elements take at least
+  // 'minElementSize' bytes each, so that corrupt sizes do not make huge
+  // allocations.
+  uint64_t readSize(uint64_t minElementSize) {
+    const auto size = readVarint();
+    VELOX_USER_CHECK_LE(
+        size,
+        (data_.size() - position_) / minElementSize,
+        "Truncated binary plan");
+    return size;
+  }
+
+  const std::string_view data_;
+  size_t position_{0};
+  std::vector<std::string_view> strings_;
+};
+} // namespace
+
+std::string serializeBinary(const folly::dynamic& value) {
+  std::string out;
+  out.push_back(static_cast<char>(kFormatVersion));
+  BinaryWriter(out).write(value);
+  return out;
+}
+
+folly::dynamic deserializeBinary(std::string_view data) {
+  BinaryReader reader(data);
+  const auto version = reader.readByte();
+  VELOX_USER_CHECK_EQ(
+      version, kFormatVersion, "Unsupported binary plan format version");
+  auto value = reader.read();
+  VELOX_USER_CHECK(reader.atEnd(), "Trailing bytes after binary plan");
+  return value;
+}
+
+} // namespace facebook::velox
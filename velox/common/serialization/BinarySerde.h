@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <folly/dynamic.h>
+
+namespace facebook::velox {
+
+/// Compact binary alternative to folly::toJson() and folly::parseJson() for
+/// the folly::dynamic that ISerializable::serialize() produces. Plan
+/// fragments, typed expressions, types and filters can be shipped in this
+/// format and rebuilt with ISerializable::deserialize() without printing and
+/// parsing JSON text.
+///
+/// Each value is a one byte tag followed by its payload. Integers are zigzag
+/// varints, doubles are 8 little endian bytes, strings, arrays and objects
+/// start with a varint size. Short strings, e.g. object keys, function names
+/// and types, are numbered in the order of their first occurrence and repeated
+/// occurrences are written as a varint reference to that number.
+std::string serializeBinary(const folly::dynamic& value);
+
+/// Returns the value in 'data' written by serializeBinary(). Throws a user
+/// error if 'data' is not a complete value in this format.
+folly::dynamic deserializeBinary(std::string_view data);
+
+} // namespace facebook::velox
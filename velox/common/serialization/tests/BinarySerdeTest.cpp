@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/serialization/BinarySerde.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "folly/Random.h"
+#include "folly/json.h"
+#include "velox/common/base/tests/GTestUtils.h"
+
+using namespace ::facebook::velox;
+
+namespace {
+
+class BinarySerdeTest : public testing::Test {
+ protected:
+  void testRoundTrip(const folly::dynamic& value) {
+    const auto serialized = serializeBinary(value);
+    ASSERT_EQ(deserializeBinary(serialized), value) << folly::toJson(value);
+  }
+
+  // Returns a random value with nested containers up to 'depth' levels deep.
+  // Strings come from a small set so that many of them are references.
+  folly::dynamic randomValue(int32_t depth) {
+    const auto kind = folly::Random::rand32(depth > 0 ? 8 : 6, rng_);
+    switch (kind) {
+      case 0:
+        return nullptr;
+      case 1:
+        return folly::Random::oneIn(2, rng_);
+      case 2: {
+        // Covers small and large magnitudes of both signs.
+        const int64_t value = folly::Random::rand64(rng_) >>
+            (1 + folly::Random::rand32(63, rng_));
+        return folly::Random::oneIn(2, rng_) ? value : -value;
+      }
+      case 3:
+        return folly::Random::randDouble(-1e10, 1e10, rng_);
+      case 4:
+        return randomString();
+      case 5:
+        return folly::Random::oneIn(2, rng_) ? folly::dynamic::array()
+                                             : folly::dynamic::object();
+      case 6: {
+        auto array = folly::dynamic::array();
+        const int32_t size = folly::Random::rand32(10, rng_);
+        for (auto i = 0; i < size; ++i) {
+          array.push_back(randomValue(depth - 1));
+        }
+        return array;
+      }
+      default: {
+        auto object = folly::dynamic::object();
+        const int32_t size = folly::Random::rand32(10, rng_);
+        for (auto i = 0; i < size; ++i) {
+          object[randomString()] = randomValue(depth - 1);
+        }
+        return object;
+      }
+    }
+  }
+
+  std::string randomString() {
+    const auto size = folly::Random::oneIn(10, rng_)
+        ? folly::Random::rand32(200, rng_)
+        : folly::Random::rand32(4, rng_);
+    std::string value(size, '\0');
+    for (auto& c : value) {
+      c = folly::Random::rand32(256, rng_);
+    }
+    return value;
+  }
+
+  std::mt19937 rng_{1};
+};
+
+TEST_F(BinarySerdeTest, scalars) {
+  testRoundTrip(nullptr);
+  testRoundTrip(true);
+  testRoundTrip(false);
+  for (int64_t value :
+       {int64_t{0},
+        int64_t{-1},
+        int64_t{127},
+        int64_t{128},
+        std::numeric_limits<int64_t>::min(),
+        std::numeric_limits<int64_t>::max()}) {
+    testRoundTrip(value);
+  }
+  testRoundTrip(0.5);
+  testRoundTrip(std::numeric_limits<double>::infinity());
+  testRoundTrip("");
+  testRoundTrip(std::string(1'000, 'x'));
+  testRoundTrip(std::string("a\0b", 3));
+
+  // Integers are zigzag varints.
+  ASSERT_EQ(serializeBinary(1).size(), 3);
+  ASSERT_EQ(serializeBinary(-64).size(), 3);
+}
+
+TEST_F(BinarySerdeTest, stringReferences) {
+  folly::dynamic array = folly::dynamic::array();
+  for (auto i = 0; i < 100; ++i) {
+    array.push_back(
+        folly::dynamic::object("name", "CallTypedExpr")("type", "BIGINT"));
+  }
+  testRoundTrip(array);
+  // Repeated keys and values are written once. The rest are one byte tags and
+  // one byte references.
+  ASSERT_LT(serializeBinary(array).size(), 100 * 10 + 50);
+  ASSERT_LT(serializeBinary(array).size(), folly::toJson(array).size() / 3);
+}
+
+TEST_F(BinarySerdeTest, fuzzRoundTrip) {
+  for (auto i = 0; i < 1'000; ++i) {
+    SCOPED_TRACE(fmt::format("Iteration {}", i));
+    testRoundTrip(randomValue(4));
+  }
+}
+
+TEST_F(BinarySerdeTest, fuzzCorrupt) {
+  for (auto i = 0; i < 200; ++i) {
+    SCOPED_TRACE(fmt::format("Iteration {}", i));
+    auto serialized = serializeBinary(randomValue(3));
+
+    // Truncated input is a user error.
+    const auto size = folly::Random::rand32(serialized.size(), rng_);
+    VELOX_ASSERT_THROW(deserializeBinary(serialized.substr(0, size)), "");
+
+    // Changed bytes either decode to some value or are a user error.
+    for (auto j = 0; j < 4; ++j) {
+      serialized[1 + folly::Random::rand32(serialized.size() - 1, rng_)] =
+          folly::Random::rand32(256, rng_);
+    }
+    try {
+      deserializeBinary(serialized);
+    } catch (const VeloxUserError&) {
+    }
+  }
+
+  VELOX_ASSERT_THROW(deserializeBinary(""), "Truncated binary plan");
+  VELOX_ASSERT_THROW(
+      deserializeBinary(std::string_view("\x02\x00", 2)),
+      "Unsupported binary plan format version");
+  VELOX_ASSERT_THROW(
+      deserializeBinary(std::string_view("\x01\x00\x00", 3)),
+      "Trailing bytes after binary plan");
+}
+
+} // namespace
@@ -60,6 +60,14 @@ struct ConnectorSplit {
   virtual std::string toString() const {
     return fmt::format("[split: {}]", connectorId);
   }
+
+  /// Returns a string that identifies the data of this split, or std::nullopt
+  /// if the split can not be identified, e.g. because its data may change.
+  /// Splits with equal keys produce the same rows for the same scan. Used by
+  /// the split result cache.
+  virtual std::optional<std::string> cacheKey() const {
+    return std::nullopt;
+  }
 };
 
 class ColumnHandle : public ISerializable {
@@ -161,6 +169,15 @@ class DataSink {
   /// Returns the stats of this data sink.
   virtual Stats stats() const = 0;
 
+  /// Called after all data has been added and before close() to start the
+  /// work of closing that does not need the caller's thread, e.g. flushing
+  /// and uploading the written files. Returns true if close() can be called.
+  /// Otherwise returns false and sets 'future'. The caller waits for 'future'
+  /// and calls finish() again. The default does all the work in close().
+  virtual bool finish(ContinueFuture& /*future*/) {
+    return true;
+  }
+
   /// Called once after all data has been added via possibly multiple calls to
   /// appendData(). The function returns the metadata of written data in string
   /// form. We don't expect any appendData() calls on a closed data sink object.
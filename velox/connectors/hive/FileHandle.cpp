@@ -18,9 +18,14 @@
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/HedgedReadFile.h"
 #include "velox/common/time/Timer.h"
+#include "velox/connectors/hive/HiveConfig.h"
+
+#include <folly/container/F14Map.h>
 
 #include <atomic>
+#include <mutex>
 
 namespace facebook::velox {
 
@@ -31,10 +36,38 @@ std::string groupName(const std::string& filename) {
   return slash ? std::string(filename.data(), slash - filename.data())
                : filename;
 }
+
+bool isLocalFile(const std::string& filename) {
+  return filename.find("/") == 0 || filename.find("file:") == 0;
+}
+
+// Returns the policy shared by the hedged reads of the files of 'fileSystem'.
+// The first configuration that asks for hedging a file system decides its
+// options.
+std::shared_ptr<HedgedReadPolicy> hedgedReadPolicy(
+    const std::string& fileSystem,
+    const connector::hive::HiveConfig& config) {
+  static std::mutex mutex;
+  static folly::F14FastMap<std::string, std::shared_ptr<HedgedReadPolicy>>
+      policies;
+  std::lock_guard<std::mutex> l(mutex);
+  auto& policy = policies[fileSystem];
+  if (policy == nullptr) {
+    HedgedReadPolicy::Options options;
+    options.maxInFlightHedges = config.hedgedReadMaxInFlight();
+    options.latencyPercentile = config.hedgedReadLatencyPercentile();
+    options.minDelay =
+        std::chrono::milliseconds(config.hedgedReadMinDelayMs());
+    options.numThreads = config.hedgedReadThreads();
+    policy = std::make_shared<HedgedReadPolicy>(options);
+  }
+  return policy;
+}
 } // namespace
 
 std::shared_ptr<FileHandle> FileHandleGenerator::operator()(
-    const std::string& filename) {
+    const std::string& filename,
+    const FileProperties* properties) {
   // We have seen cases where drivers are stuck when creating file handles.
   // Adding a trace here to spot this more easily in future.
   process::TraceContext trace("FileHandleGenerator::operator()");
@@ -43,8 +76,21 @@ std::shared_ptr<FileHandle> FileHandleGenerator::operator()(
   {
     MicrosecondTimer timer(&elapsedTimeUs);
     fileHandle = std::make_shared<FileHandle>();
-    fileHandle->file = filesystems::getFileSystem(filename, properties_)
-                           ->openFileForRead(filename);
+    auto fileSystem = filesystems::getFileSystem(filename, properties_);
+    FileOptions options;
+    if (properties != nullptr) {
+      options.fileSize = properties->fileSize;
+      fileHandle->modificationTime = properties->modificationTime;
+    }
+    fileHandle->file = fileSystem->openFileForRead(filename, options);
+    if (properties_ != nullptr && !isLocalFile(filename)) {
+      const connector::hive::HiveConfig hiveConfig(properties_);
+      if (hiveConfig.hedgedReadMaxInFlight() > 0) {
+        fileHandle->file = std::make_shared<HedgedReadFile>(
+            std::move(fileHandle->file),
+            hedgedReadPolicy(fileSystem->name(), hiveConfig));
+      }
+    }
     fileHandle->uuid = StringIdLease(fileIds(), filename);
     fileHandle->groupId = StringIdLease(fileIds(), groupName(filename));
     VLOG(1) << "Generating file handle for: " << filename
@@ -33,6 +33,13 @@ namespace facebook::velox {
 
 class Config;
 
+// Properties of a file that are known before opening it, e.g. from the split.
+// They save the metadata calls of the file system when opening the file.
+struct FileProperties {
+  std::optional<int64_t> fileSize;
+  std::optional<int64_t> modificationTime;
+};
+
 // See the file comment.
 struct FileHandle {
   std::shared_ptr<ReadFile> file;
@@ -47,6 +54,10 @@ struct FileHandle {
   // example to decide placing on SSD.
   StringIdLease groupId;
 
+  // Modification time of 'file' in the unit of the split's
+  // $file_modified_time, if known when the file was opened.
+  std::optional<int64_t> modificationTime;
+
   // We'll want to have a hash map here to record the identifier->byte range
   // mappings. Different formats may have different identifiers, so we may need
   // a union of maps. For example in orc you need 3 integers (I think, to be
@@ -62,7 +73,10 @@ class FileHandleGenerator {
   FileHandleGenerator() {}
   FileHandleGenerator(std::shared_ptr<const Config> properties)
       : properties_(std::move(properties)) {}
-  std::shared_ptr<FileHandle> operator()(const std::string& filename);
+  // 'properties' may be nullptr if nothing is known about the file.
+  std::shared_ptr<FileHandle> operator()(
+      const std::string& filename,
+      const FileProperties* properties = nullptr);
 
  private:
   const std::shared_ptr<const Config> properties_;
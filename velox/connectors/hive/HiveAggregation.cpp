@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/HiveAggregation.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "velox/connectors/hive/SplitReader.h"
+#include "velox/dwio/common/Statistics.h"
+
+namespace facebook::velox::connector::hive {
+
+namespace {
+
+bool isMinMaxTypeSupported(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// The file statistics have the exact minimum and maximum of integers only.
+// The bounds of strings may be truncated and floating point bounds do not
+// tell about NaNs.
+bool isMinMaxFromStatisticsSupported(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return !type.isDecimal();
+    default:
+      return false;
+  }
+}
+
+template <typename T>
+bool lessThan(const T& left, const T& right) {
+  if constexpr (std::is_floating_point_v<T>) {
+    // NaN is greater than all other values, like in min and max.
+    if (std::isnan(left)) {
+      return false;
+    }
+    if (std::isnan(right)) {
+      return true;
+    }
+  }
+  return left < right;
+}
+
+template <TypeKind kind>
+void updateMinMax(
+    const DecodedVector& decoded,
+    vector_size_t size,
+    bool isMin,
+    variant& value) {
+  using T = typename TypeTraits<kind>::NativeType;
+  using Stored = typename detail::VariantTypeTraits<kind>::stored_type;
+  std::optional<T> result;
+  if (!value.isNull()) {
+    result = T(value.value<kind>());
+  }
+  bool changed = false;
+  for (vector_size_t row = 0; row < size; ++row) {
+    if (decoded.isNullAt(row)) {
+      continue;
+    }
+    const auto current = decoded.valueAt<T>(row);
+    if (!result.has_value() ||
+        (isMin ? lessThan(current, result.value())
+               : lessThan(result.value(), current))) {
+      result = current;
+      changed = true;
+    }
+  }
+  if (changed) {
+    value = variant::create<kind>(Stored(result.value()));
+  }
+}
+
+} // namespace
+
+HiveAggregation::HiveAggregation(
+    const std::vector<HiveAggregate>& aggregates,
+    const RowTypePtr& outputType,
+    const RowTypePtr& inputType,
+    std::vector<std::string> fileColumnNames,
+    memory::MemoryPool* pool)
+    : outputType_(outputType),
+      fileColumnNames_(std::move(fileColumnNames)),
+      pool_(pool),
+      emptyOutput_(RowVector::createEmpty(outputType_, pool_)) {
+  VELOX_USER_CHECK_EQ(
+      outputType_->size(),
+      aggregates.size(),
+      "Table scan with aggregates must have one output column per aggregate");
+  VELOX_CHECK_EQ(fileColumnNames_.size(), inputType->size());
+  for (auto i = 0; i < aggregates.size(); ++i) {
+    const auto& aggregate = aggregates[i];
+    Accumulator accumulator;
+    accumulator.kind = aggregate.kind;
+    if (aggregate.column.empty()) {
+      VELOX_USER_CHECK(
+          aggregate.kind == HiveAggregate::Kind::kCount,
+          "Aggregate must have an input column: {}",
+          aggregate.toString());
+      accumulator.type = BIGINT();
+    } else {
+      accumulator.channel = inputType->getChildIdx(aggregate.column);
+      accumulator.type = inputType->childAt(accumulator.channel.value());
+      if (aggregate.kind == HiveAggregate::Kind::kCount) {
+        accumulator.type = BIGINT();
+      } else {
+        VELOX_USER_CHECK(
+            isMinMaxTypeSupported(*accumulator.type),
+            "Aggregate of type {} is not supported: {}",
+            accumulator.type->toString(),
+            aggregate.toString());
+      }
+    }
+    VELOX_USER_CHECK(
+        outputType_->childAt(i)->equivalent(*accumulator.type),
+        "Output column {} of type {} does not match aggregate {} of type {}",
+        outputType_->nameOf(i),
+        outputType_->childAt(i)->toString(),
+        aggregate.toString(),
+        accumulator.type->toString());
+    accumulator.value = variant::null(accumulator.type->kind());
+    accumulators_.push_back(std::move(accumulator));
+  }
+}
+
+// static
+RowTypePtr HiveAggregation::inputType(
+    const std::vector<HiveAggregate>& aggregates,
+    const std::function<TypePtr(const std::string&)>& columnType) {
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (const auto& aggregate : aggregates) {
+    if (aggregate.column.empty() ||
+        std::find(names.begin(), names.end(), aggregate.column) !=
+            names.end()) {
+      continue;
+    }
+    names.push_back(aggregate.column);
+    types.push_back(columnType(aggregate.column));
+  }
+  return ROW(std::move(names), std::move(types));
+}
+
+std::optional<variant> HiveAggregation::valueFromStatistics(
+    const Accumulator& accumulator,
+    const SplitReader& splitReader) const {
+  if (!accumulator.channel.has_value()) {
+    const auto numRows = splitReader.numFileRows();
+    if (!numRows.has_value()) {
+      return std::nullopt;
+    }
+    return variant(static_cast<int64_t>(numRows.value()));
+  }
+  const auto& name = fileColumnNames_[accumulator.channel.value()];
+  if (name.empty()) {
+    return std::nullopt;
+  }
+  const auto stats = splitReader.fileColumnStatistics(name);
+  if (stats == nullptr || !stats->getNumberOfValues().has_value()) {
+    return std::nullopt;
+  }
+  const auto numValues = stats->getNumberOfValues().value();
+  if (accumulator.kind == HiveAggregate::Kind::kCount) {
+    return variant(static_cast<int64_t>(numValues));
+  }
+  if (!isMinMaxFromStatisticsSupported(*accumulator.type)) {
+    return std::nullopt;
+  }
+  if (numValues == 0) {
+    return variant::null(accumulator.type->kind());
+  }
+  const auto* integerStats =
+      dynamic_cast<const dwio::common::IntegerColumnStatistics*>(stats.get());
+  if (integerStats == nullptr) {
+    return std::nullopt;
+  }
+  const auto bound = accumulator.kind == HiveAggregate::Kind::kMin
+      ? integerStats->getMinimum()
+      : integerStats->getMaximum();
+  if (!bound.has_value()) {
+    return std::nullopt;
+  }
+  switch (accumulator.type->kind()) {
+    case TypeKind::TINYINT:
+      return variant(static_cast<int8_t>(bound.value()));
+    case TypeKind::SMALLINT:
+      return variant(static_cast<int16_t>(bound.value()));
+    case TypeKind::INTEGER:
+      return variant(static_cast<int32_t>(bound.value()));
+    default:
+      return variant(bound.value());
+  }
+}
+
+bool HiveAggregation::addStatistics(const SplitReader& splitReader) {
+  if (!splitReader.statisticsCoverSplit()) {
+    return false;
+  }
+  std::vector<variant> values;
+  values.reserve(accumulators_.size());
+  for (const auto& accumulator : accumulators_) {
+    auto value = valueFromStatistics(accumulator, splitReader);
+    if (!value.has_value()) {
+      return false;
+    }
+    values.push_back(std::move(value.value()));
+  }
+  for (auto i = 0; i < accumulators_.size(); ++i) {
+    auto& accumulator = accumulators_[i];
+    if (accumulator.kind == HiveAggregate::Kind::kCount) {
+      accumulator.count += values[i].value<int64_t>();
+    } else if (!values[i].isNull()) {
+      // There is no value before since each split is finished on its own.
+      VELOX_CHECK(accumulator.value.isNull());
+      accumulator.value = std::move(values[i]);
+    }
+  }
+  return true;
+}
+
+void HiveAggregation::addInput(const RowVector& input) {
+  const auto size = input.size();
+  for (auto& accumulator : accumulators_) {
+    if (!accumulator.channel.has_value()) {
+      accumulator.count += size;
+      continue;
+    }
+    decoded_.decode(*input.childAt(accumulator.channel.value()));
+    if (accumulator.kind == HiveAggregate::Kind::kCount) {
+      if (!decoded_.mayHaveNulls()) {
+        accumulator.count += size;
+        continue;
+      }
+      for (vector_size_t row = 0; row < size; ++row) {
+        accumulator.count += !decoded_.isNullAt(row);
+      }
+      continue;
+    }
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        updateMinMax,
+        accumulator.type->kind(),
+        decoded_,
+        size,
+        accumulator.kind == HiveAggregate::Kind::kMin,
+        accumulator.value);
+  }
+}
+
+RowVectorPtr HiveAggregation::finish() {
+  std::vector<VectorPtr> columns;
+  columns.reserve(accumulators_.size());
+  for (auto& accumulator : accumulators_) {
+    if (accumulator.kind == HiveAggregate::Kind::kCount) {
+      columns.push_back(BaseVector::createConstant(
+          accumulator.type, variant(accumulator.count), 1, pool_));
+      accumulator.count = 0;
+    } else {
+      columns.push_back(BaseVector::createConstant(
+          accumulator.type, accumulator.value, 1, pool_));
+      accumulator.value = variant::null(accumulator.type->kind());
+    }
+  }
+  return std::make_shared<RowVector>(
+      pool_, outputType_, nullptr, 1, std::move(columns));
+}
+
+} // namespace facebook::velox::connector::hive
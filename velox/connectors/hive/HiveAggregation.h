@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+
+#include "velox/connectors/hive/TableHandle.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::connector::hive {
+
+class SplitReader;
+
+/// Computes the HiveAggregates of a table scan over the rows of a split, from
+/// the statistics of the file or from the rows read.
+class HiveAggregation {
+ public:
+  /// 'outputType' has one column per aggregate. 'inputType' has the columns
+  /// of the aggregates, named like in the column handles. 'fileColumnNames'
+  /// has the column names in the file for the columns of 'inputType', or an
+  /// empty name for a column that is not read from the file, e.g. a partition
+  /// key.
+  HiveAggregation(
+      const std::vector<HiveAggregate>& aggregates,
+      const RowTypePtr& outputType,
+      const RowTypePtr& inputType,
+      std::vector<std::string> fileColumnNames,
+      memory::MemoryPool* pool);
+
+  /// Returns the names and the types of the distinct columns of 'aggregates'.
+  /// 'columnType' returns the type of a column handle.
+  static RowTypePtr inputType(
+      const std::vector<HiveAggregate>& aggregates,
+      const std::function<TypePtr(const std::string&)>& columnType);
+
+  /// Adds the aggregates over the rows of the split of 'splitReader' from the
+  /// statistics of the file. Returns false and adds nothing if the statistics
+  /// do not give the exact result of all aggregates.
+  bool addStatistics(const SplitReader& splitReader);
+
+  /// Adds 'input', which has the rows of 'inputType'.
+  void addInput(const RowVector& input);
+
+  /// Returns the aggregates over the rows added since the last call and
+  /// resets them.
+  RowVectorPtr finish();
+
+  const RowVectorPtr& emptyOutput() const {
+    return emptyOutput_;
+  }
+
+ private:
+  struct Accumulator {
+    HiveAggregate::Kind kind;
+    // Channel of the input in 'inputType', std::nullopt for count(*).
+    std::optional<column_index_t> channel;
+    TypePtr type;
+    int64_t count{0};
+    // The minimum or maximum, null if there are no non-null values.
+    variant value;
+  };
+
+  // Returns the value of 'accumulator' over the file of 'splitReader' from the
+  // statistics, or std::nullopt if the statistics do not have it exactly.
+  std::optional<variant> valueFromStatistics(
+      const Accumulator& accumulator,
+      const SplitReader& splitReader) const;
+
+  const RowTypePtr outputType_;
+  const std::vector<std::string> fileColumnNames_;
+  memory::MemoryPool* const pool_;
+  const RowVectorPtr emptyOutput_;
+  std::vector<Accumulator> accumulators_;
+  DecodedVector decoded_;
+};
+
+} // namespace facebook::velox::connector::hive
@@ -65,6 +65,11 @@ uint32_t HiveConfig::maxPartitionsPerWriters(const Config* session) const {
       config_->get<uint32_t>(kMaxPartitionsPerWriters, 100));
 }
 
+uint32_t HiveConfig::maxOpenWriters(const Config* session) const {
+  return session->get<uint32_t>(
+      kMaxOpenWritersSession, config_->get<uint32_t>(kMaxOpenWriters, 0));
+}
+
 bool HiveConfig::immutablePartitions() const {
   return config_->get<bool>(kImmutablePartitions, false);
 }
@@ -120,6 +125,20 @@ std::optional<uint32_t> HiveConfig::s3MaxConnections() const {
       config_->get<uint32_t>(kS3MaxConnections));
 }
 
+uint64_t HiveConfig::s3ReadPartSize() const {
+  return toCapacity(
+      config_->get<std::string>(kS3ReadPartSize, "8MB"),
+      core::CapacityUnit::BYTE);
+}
+
+uint32_t HiveConfig::s3ReadThreads() const {
+  return config_->get<uint32_t>(kS3ReadThreads, 16);
+}
+
+int32_t HiveConfig::s3UploadMaxInFlightParts() const {
+  return config_->get<int32_t>(kS3UploadMaxInFlightParts, 4);
+}
+
 std::string HiveConfig::gcsEndpoint() const {
   return config_->get<std::string>(kGCSEndpoint, std::string(""));
 }
@@ -132,6 +151,26 @@ std::string HiveConfig::gcsCredentials() const {
   return config_->get<std::string>(kGCSCredentials, std::string(""));
 }
 
+uint32_t HiveConfig::gcsReadThreads() const {
+  return config_->get<uint32_t>(kGCSReadThreads, 16);
+}
+
+uint32_t HiveConfig::abfsReadThreads() const {
+  return config_->get<uint32_t>(kAbfsReadThreads, 16);
+}
+
+bool HiveConfig::hdfsShortCircuitRead() const {
+  return config_->get<bool>(kHdfsShortCircuitRead, false);
+}
+
+std::string HiveConfig::hdfsDomainSocketPath() const {
+  return config_->get<std::string>(kHdfsDomainSocketPath, std::string(""));
+}
+
+uint32_t HiveConfig::hdfsShortCircuitStreamsCacheSize() const {
+  return config_->get<uint32_t>(kHdfsShortCircuitStreamsCacheSize, 256);
+}
+
 bool HiveConfig::isOrcUseColumnNames(const Config* session) const {
   return session->get<bool>(
       kOrcUseColumnNamesSession, config_->get<bool>(kOrcUseColumnNames, false));
@@ -163,6 +202,18 @@ int32_t HiveConfig::prefetchRowGroups() const {
   return config_->get<int32_t>(kPrefetchRowGroups, 1);
 }
 
+bool HiveConfig::adaptivePrefetchRowGroups() const {
+  return config_->get<bool>(kAdaptivePrefetchRowGroups, false);
+}
+
+bool HiveConfig::adaptiveCoalescing() const {
+  return config_->get<bool>(kAdaptiveCoalescing, false);
+}
+
+bool HiveConfig::mmapLocalFiles() const {
+  return config_->get<bool>(kMmapLocalFiles, false);
+}
+
 int32_t HiveConfig::loadQuantum() const {
   return config_->get<int32_t>(kLoadQuantum, 8 << 20);
 }
@@ -175,6 +226,10 @@ bool HiveConfig::isFileHandleCacheEnabled() const {
   return config_->get<bool>(kEnableFileHandleCache, true);
 }
 
+int32_t HiveConfig::numFileHandleCacheShards() const {
+  return config_->get<int32_t>(kNumFileHandleCacheShards, 16);
+}
+
 uint64_t HiveConfig::orcWriterMaxStripeSize(const Config* session) const {
   return toCapacity(
       session->get<std::string>(
@@ -191,6 +246,12 @@ uint64_t HiveConfig::orcWriterMaxDictionaryMemory(const Config* session) const {
       core::CapacityUnit::BYTE);
 }
 
+bool HiveConfig::orcWriterAsyncUpload(const Config* session) const {
+  return session->get<bool>(
+      kOrcWriterAsyncUploadSession,
+      config_->get<bool>(kOrcWriterAsyncUpload, false));
+}
+
 std::string HiveConfig::writeFileCreateConfig() const {
   return config_->get<std::string>(kWriteFileCreateConfig, "");
 }
@@ -209,6 +270,13 @@ uint64_t HiveConfig::sortWriterMaxOutputBytes(const Config* session) const {
       core::CapacityUnit::BYTE);
 }
 
+uint32_t HiveConfig::sortWriterNormalizedKeyMaxBytes(
+    const Config* session) const {
+  return session->get<uint32_t>(
+      kSortWriterNormalizedKeyMaxBytesSession,
+      config_->get<uint32_t>(kSortWriterNormalizedKeyMaxBytes, 128));
+}
+
 uint64_t HiveConfig::footerEstimatedSize() const {
   return config_->get<uint64_t>(kFooterEstimatedSize, 1UL << 20);
 }
@@ -232,4 +300,31 @@ uint8_t HiveConfig::parquetWriteTimestampUnit(const Config* session) const {
   return unit;
 }
 
+std::string HiveConfig::cacheGroup(const Config* session) const {
+  return session->get<std::string>(
+      kCacheGroupSession, config_->get<std::string>(kCacheGroup, ""));
+}
+
+int32_t HiveConfig::hedgedReadMaxInFlight() const {
+  return config_->get<int32_t>(kHedgedReadMaxInFlight, 0);
+}
+
+int32_t HiveConfig::hedgedReadLatencyPercentile() const {
+  return config_->get<int32_t>(kHedgedReadLatencyPercentile, 95);
+}
+
+int32_t HiveConfig::hedgedReadMinDelayMs() const {
+  return config_->get<int32_t>(kHedgedReadMinDelayMs, 10);
+}
+
+int32_t HiveConfig::hedgedReadThreads() const {
+  return config_->get<int32_t>(kHedgedReadThreads, 32);
+}
+
+int32_t HiveConfig::decodingParallelismFactor(const Config* session) const {
+  return session->get<int32_t>(
+      kDecodingParallelismFactorSession,
+      config_->get<int32_t>(kDecodingParallelismFactor, 0));
+}
+
 } // namespace facebook::velox::connector::hive
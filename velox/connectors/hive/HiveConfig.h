@@ -51,6 +51,13 @@ class HiveConfig {
   static constexpr const char* kMaxPartitionsPerWritersSession =
       "max_partitions_per_writers";
 
+  /// Maximum number of file writers a single table writer instance keeps open
+  /// at a time. When a new writer would exceed the limit, the least recently
+  /// written writer closes its file and continues in a new file if it gets
+  /// more rows. 0 means no limit besides the partition limit.
+  static constexpr const char* kMaxOpenWriters = "max-open-writers";
+  static constexpr const char* kMaxOpenWritersSession = "max_open_writers";
+
   /// Whether new data can be inserted into an unpartition table.
   /// Velox currently does not support appending data to existing partitions.
   static constexpr const char* kImmutablePartitions =
@@ -97,6 +104,19 @@ class HiveConfig {
   /// Maximum concurrent TCP connections for a single http client.
   static constexpr const char* kS3MaxConnections = "hive.s3.max-connections";
 
+  /// Reads from S3 larger than this are split into concurrent ranged GETs of
+  /// this size. 0 reads each range with a single GET.
+  static constexpr const char* kS3ReadPartSize = "hive.s3.read-part-size";
+
+  /// Number of threads of the S3 client for running concurrent part GETs,
+  /// asynchronous reads and part uploads.
+  static constexpr const char* kS3ReadThreads = "hive.s3.read-threads";
+
+  /// Maximum number of parts of a file being written to S3 that are uploaded
+  /// at the same time. Each takes a 10MB buffer.
+  static constexpr const char* kS3UploadMaxInFlightParts =
+      "hive.s3.upload-max-in-flight-parts";
+
   /// The GCS storage endpoint server.
   static constexpr const char* kGCSEndpoint = "hive.gcs.endpoint";
 
@@ -106,6 +126,30 @@ class HiveConfig {
   /// The GCS service account configuration as json string
   static constexpr const char* kGCSCredentials = "hive.gcs.credentials";
 
+  /// Number of threads of the GCS file system that serve asynchronous reads.
+  /// 0 makes preadvAsync() synchronous.
+  static constexpr const char* kGCSReadThreads = "hive.gcs.read-threads";
+
+  /// Number of threads of the ABFS file system that serve asynchronous reads.
+  /// 0 makes preadvAsync() synchronous.
+  static constexpr const char* kAbfsReadThreads = "hive.abfs.read-threads";
+
+  /// Reads HDFS blocks that have a replica on this host directly from the
+  /// local disk through a domain socket shared with the datanode instead of
+  /// through the datanode protocol. Requires kHdfsDomainSocketPath.
+  static constexpr const char* kHdfsShortCircuitRead =
+      "hive.hdfs.short-circuit-read";
+
+  /// Path of the domain socket of the local datanode for short-circuit
+  /// reads.
+  static constexpr const char* kHdfsDomainSocketPath =
+      "hive.hdfs.domain-socket-path";
+
+  /// Maximum number of open local block readers kept per HDFS client for
+  /// short-circuit reads.
+  static constexpr const char* kHdfsShortCircuitStreamsCacheSize =
+      "hive.hdfs.short-circuit-streams-cache-size";
+
   /// Maps table field names to file field names using names, not indices.
   // TODO: remove hive_orc_use_column_names since it doesn't exist in presto,
   // right now this is only used for testing.
@@ -135,6 +179,21 @@ class HiveConfig {
   /// The number of prefetch rowgroups
   static constexpr const char* kPrefetchRowGroups = "prefetch-rowgroups";
 
+  /// Whether the number of row groups or stripes to prefetch adapts to how
+  /// long they take to load and to read and to the available memory, up to
+  /// kPrefetchRowGroups.
+  static constexpr const char* kAdaptivePrefetchRowGroups =
+      "adaptive-prefetch-rowgroups";
+
+  /// Whether the max coalesce distance and bytes adapt to the latency and
+  /// throughput measured for each file system, starting from and capped by
+  /// kMaxCoalescedDistanceBytes and kMaxCoalescedBytes.
+  static constexpr const char* kAdaptiveCoalescing = "adaptive-coalescing";
+
+  /// Whether files of the local file system are read through a memory
+  /// mapping, so that decoders read the page cache without a copy.
+  static constexpr const char* kMmapLocalFiles = "mmap-local-files";
+
   /// The total size in bytes for a direct coalesce request.
   static constexpr const char* kLoadQuantum = "load-quantum";
 
@@ -145,6 +204,11 @@ class HiveConfig {
   static constexpr const char* kEnableFileHandleCache =
       "file-handle-cache-enabled";
 
+  /// Number of shards of the file handle cache. Each shard has its own locks,
+  /// so that opens of files in different shards do not contend.
+  static constexpr const char* kNumFileHandleCacheShards =
+      "file-handle-cache-shards";
+
   /// The size in bytes to be fetched with Meta data together, used when the
   /// data after meta data will be used later. Optimization to decrease small IO
   /// request
@@ -166,6 +230,13 @@ class HiveConfig {
   static constexpr const char* kOrcWriterMaxDictionaryMemorySession =
       "orc_optimized_writer_max_dictionary_memory";
 
+  /// If true, the orc writer writes a flushed stripe to the file on the
+  /// connector's executor while it encodes the next stripe.
+  static constexpr const char* kOrcWriterAsyncUpload =
+      "hive.orc.writer.async-upload";
+  static constexpr const char* kOrcWriterAsyncUploadSession =
+      "orc_optimized_writer_async_upload";
+
   /// Config used to create write files. This config is provided to underlying
   /// file system through hive connector and data sink. The config is free form.
   /// The form should be defined by the underlying file system.
@@ -184,6 +255,13 @@ class HiveConfig {
   static constexpr const char* kSortWriterMaxOutputBytesSession =
       "sort_writer_max_output_bytes";
 
+  /// Maximum number of bytes of the normalized sort keys of a row that the
+  /// sort writer sorts with PrefixSort. 0 disables PrefixSort.
+  static constexpr const char* kSortWriterNormalizedKeyMaxBytes =
+      "sort-writer-normalized-key-max-bytes";
+  static constexpr const char* kSortWriterNormalizedKeyMaxBytesSession =
+      "sort_writer_normalized_key_max_bytes";
+
   static constexpr const char* kS3UseProxyFromEnv =
       "hive.s3.use-proxy-from-env";
 
@@ -193,11 +271,44 @@ class HiveConfig {
   static constexpr const char* kParquetWriteTimestampUnitSession =
       "hive.parquet.writer.timestamp_unit";
 
+  /// AsyncDataCache group whose memory quota the cached file data of the scan
+  /// counts against. Empty for the default group.
+  static constexpr const char* kCacheGroup = "cache-group";
+  static constexpr const char* kCacheGroupSession = "cache_group";
+
+  /// Maximum number of hedged reads in flight per remote file system. A read
+  /// is hedged by issuing a duplicate request when it has not completed
+  /// within a percentile of the recent latencies of reads of similar size.
+  /// 0 disables hedging.
+  static constexpr const char* kHedgedReadMaxInFlight =
+      "hedged-read-max-in-flight";
+
+  /// Percentile of recent read latencies after which a read is hedged.
+  static constexpr const char* kHedgedReadLatencyPercentile =
+      "hedged-read-latency-percentile";
+
+  /// Minimum delay before a read is hedged.
+  static constexpr const char* kHedgedReadMinDelayMs =
+      "hedged-read-min-delay-ms";
+
+  /// Number of threads per remote file system that run hedged reads.
+  static constexpr const char* kHedgedReadThreads = "hedged-read-threads";
+
+  /// Maximum number of threads that decode the projected columns without
+  /// filters of a split, using the connector's executor. 0 or 1 decodes them
+  /// on the driver thread as LazyVectors.
+  static constexpr const char* kDecodingParallelismFactor =
+      "decoding-parallelism-factor";
+  static constexpr const char* kDecodingParallelismFactorSession =
+      "decoding_parallelism_factor";
+
   InsertExistingPartitionsBehavior insertExistingPartitionsBehavior(
       const Config* session) const;
 
   uint32_t maxPartitionsPerWriters(const Config* session) const;
 
+  uint32_t maxOpenWriters(const Config* session) const;
+
   bool immutablePartitions() const;
 
   bool s3UseVirtualAddressing() const;
@@ -224,12 +335,28 @@ class HiveConfig {
 
   std::optional<uint32_t> s3MaxConnections() const;
 
+  uint64_t s3ReadPartSize() const;
+
+  uint32_t s3ReadThreads() const;
+
+  int32_t s3UploadMaxInFlightParts() const;
+
   std::string gcsEndpoint() const;
 
   std::string gcsScheme() const;
 
   std::string gcsCredentials() const;
 
+  uint32_t gcsReadThreads() const;
+
+  uint32_t abfsReadThreads() const;
+
+  bool hdfsShortCircuitRead() const;
+
+  std::string hdfsDomainSocketPath() const;
+
+  uint32_t hdfsShortCircuitStreamsCacheSize() const;
+
   bool isOrcUseColumnNames(const Config* session) const;
 
   bool isFileColumnNamesReadAsLowerCase(const Config* session) const;
@@ -244,24 +371,36 @@ class HiveConfig {
 
   int32_t prefetchRowGroups() const;
 
+  bool adaptivePrefetchRowGroups() const;
+
+  bool adaptiveCoalescing() const;
+
+  bool mmapLocalFiles() const;
+
   int32_t loadQuantum() const;
 
   int32_t numCacheFileHandles() const;
 
   bool isFileHandleCacheEnabled() const;
 
+  int32_t numFileHandleCacheShards() const;
+
   uint64_t fileWriterFlushThresholdBytes() const;
 
   uint64_t orcWriterMaxStripeSize(const Config* session) const;
 
   uint64_t orcWriterMaxDictionaryMemory(const Config* session) const;
 
+  bool orcWriterAsyncUpload(const Config* session) const;
+
   std::string writeFileCreateConfig() const;
 
   uint32_t sortWriterMaxOutputRows(const Config* session) const;
 
   uint64_t sortWriterMaxOutputBytes(const Config* session) const;
 
+  uint32_t sortWriterNormalizedKeyMaxBytes(const Config* session) const;
+
   uint64_t footerEstimatedSize() const;
 
   uint64_t filePreloadThreshold() const;
@@ -272,6 +411,18 @@ class HiveConfig {
   /// through Arrow bridge. 0: second, 3: milli, 6: micro, 9: nano.
   uint8_t parquetWriteTimestampUnit(const Config* session) const;
 
+  std::string cacheGroup(const Config* session) const;
+
+  int32_t hedgedReadMaxInFlight() const;
+
+  int32_t hedgedReadLatencyPercentile() const;
+
+  int32_t hedgedReadMinDelayMs() const;
+
+  int32_t hedgedReadThreads() const;
+
+  int32_t decodingParallelismFactor(const Config* session) const;
+
   HiveConfig(std::shared_ptr<const Config> config) {
     VELOX_CHECK_NOT_NULL(
         config, "Config is null for HiveConfig initialization");
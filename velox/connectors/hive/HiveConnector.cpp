@@ -59,11 +59,12 @@ HiveConnector::HiveConnector(
       hiveConfig_(std::make_shared<HiveConfig>(config)),
       fileHandleFactory_(
           hiveConfig_->isFileHandleCacheEnabled()
-              ? std::make_unique<
-                    SimpleLRUCache<std::string, std::shared_ptr<FileHandle>>>(
-                    hiveConfig_->numCacheFileHandles())
-              : nullptr,
-          std::make_unique<FileHandleGenerator>(config)),
+              ? FileHandleFactory(
+                    hiveConfig_->numFileHandleCacheShards(),
+                    hiveConfig_->numCacheFileHandles(),
+                    std::make_unique<FileHandleGenerator>(config))
+              : FileHandleFactory(
+                    nullptr, std::make_unique<FileHandleGenerator>(config))),
       executor_(executor) {
   if (hiveConfig_->isFileHandleCacheEnabled()) {
     LOG(INFO) << "Hive connector " << connectorId()
@@ -106,7 +107,8 @@ std::unique_ptr<DataSink> HiveConnector::createDataSink(
       hiveInsertHandle,
       connectorQueryCtx,
       commitStrategy,
-      hiveConfig_);
+      hiveConfig_,
+      executor_);
 }
 
 std::unique_ptr<core::PartitionFunction> HivePartitionFunctionSpec::create(
@@ -15,10 +15,12 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <optional>
 #include <unordered_map>
 #include "velox/connectors/Connector.h"
 #include "velox/dwio/common/Options.h"
+#include "velox/dwio/common/Statistics.h"
 
 namespace facebook::velox::connector::hive {
 
@@ -43,6 +45,19 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
   /// associated with the HiveSplit.
   std::unordered_map<std::string, std::string> infoColumns;
 
+  /// Statistics of the columns of the file that are known without opening it,
+  /// e.g. from the manifest of a table format. Keyed by column name. The
+  /// statistics are in terms of the table type of the column. A split whose
+  /// statistics show that no row passes the filters of the scan is skipped
+  /// before its file is opened.
+  std::unordered_map<
+      std::string,
+      std::shared_ptr<dwio::common::ColumnStatistics>>
+      columnStatistics;
+
+  /// Number of rows in the file if known without opening it.
+  std::optional<uint64_t> numRows;
+
   HiveConnectorSplit(
       const std::string& connectorId,
       const std::string& _filePath,
@@ -81,10 +96,58 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
     return fmt::format("Hive: {} {} - {}", filePath, start, length);
   }
 
+  /// The key identifies the file by its path and modification time, so
+  /// splits without a $file_modified_time info column are not keyed.
+  std::optional<std::string> cacheKey() const override {
+    auto modifiedTime = infoColumns.find("$file_modified_time");
+    if (modifiedTime == infoColumns.end()) {
+      return std::nullopt;
+    }
+    auto key = fmt::format(
+        "{}\n{}\n{}\n{}\n{}\n{}\n",
+        filePath,
+        modifiedTime->second,
+        dwio::common::toString(fileFormat),
+        start,
+        length,
+        tableBucketNumber.has_value() ? std::to_string(*tableBucketNumber)
+                                      : "");
+    appendSorted(partitionKeys, key);
+    appendSorted(infoColumns, key);
+    appendSorted(serdeParameters, key);
+    appendSorted(customSplitInfo, key);
+    if (extraFileInfo != nullptr) {
+      key += *extraFileInfo;
+    }
+    return key;
+  }
+
   std::string getFileName() const {
     auto i = filePath.rfind('/');
     return i == std::string::npos ? filePath : filePath.substr(i + 1);
   }
+
+ private:
+  template <typename T>
+  static void appendSorted(
+      const std::unordered_map<std::string, T>& map,
+      std::string& key) {
+    // Null values are appended without '='.
+    std::vector<std::pair<std::string_view, std::optional<std::string_view>>>
+        entries;
+    for (const auto& [name, value] : map) {
+      entries.emplace_back(name, value);
+    }
+    std::sort(entries.begin(), entries.end());
+    for (const auto& [name, value] : entries) {
+      key += name;
+      if (value.has_value()) {
+        key += '=';
+        key += *value;
+      }
+      key += '\n';
+    }
+  }
 };
 
 } // namespace facebook::velox::connector::hive
@@ -23,6 +23,7 @@
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
 #include "velox/dwio/common/DirectBufferedInput.h"
+#include "velox/dwio/common/MmapBufferedInput.h"
 #include "velox/dwio/common/Reader.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
@@ -514,6 +515,11 @@ void configureReaderOptions(
   readerOptions.setFooterEstimatedSize(hiveConfig->footerEstimatedSize());
   readerOptions.setFilePreloadThreshold(hiveConfig->filePreloadThreshold());
   readerOptions.setPrefetchRowGroups(hiveConfig->prefetchRowGroups());
+  readerOptions.setAdaptivePrefetchRowGroups(
+      hiveConfig->adaptivePrefetchRowGroups());
+  readerOptions.setAdaptiveCoalescing(hiveConfig->adaptiveCoalescing());
+  readerOptions.setMmapLocalFiles(hiveConfig->mmapLocalFiles());
+  readerOptions.setCacheGroup(hiveConfig->cacheGroup(sessionProperties));
 
   if (readerOptions.getFileFormat() != dwio::common::FileFormat::UNKNOWN) {
     VELOX_CHECK(
@@ -653,12 +659,69 @@ bool testFilters(
   return true;
 }
 
+bool testSplitStatistics(
+    const common::ScanSpec* scanSpec,
+    const HiveConnectorSplit& split,
+    const RowTypePtr& dataColumns,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle) {
+  if (split.numRows.has_value() && split.numRows.value() == 0) {
+    return false;
+  }
+  if (split.columnStatistics.empty() && split.partitionKeys.empty()) {
+    return true;
+  }
+  // The number of non-null values in the statistics tells that there are no
+  // nulls only if the number of rows is known.
+  const auto totalRows =
+      split.numRows.value_or(std::numeric_limits<uint64_t>::max());
+  for (const auto& child : scanSpec->children()) {
+    auto* filter = child->filter();
+    if (!filter || !filter->isDeterministic()) {
+      continue;
+    }
+    const auto& name = child->fieldName();
+    auto keyIt = split.partitionKeys.find(name);
+    if (keyIt != split.partitionKeys.end()) {
+      auto handleIt = partitionKeysHandle.find(name);
+      if (keyIt->second.has_value() && handleIt != partitionKeysHandle.end() &&
+          !applyPartitionFilter(
+              handleIt->second->dataType()->kind(),
+              keyIt->second.value(),
+              filter)) {
+        return false;
+      }
+      continue;
+    }
+    auto statsIt = split.columnStatistics.find(name);
+    if (statsIt == split.columnStatistics.end() || !statsIt->second ||
+        !dataColumns || !dataColumns->containsChild(name)) {
+      continue;
+    }
+    if (!testFilter(
+            filter,
+            statsIt->second.get(),
+            totalRows,
+            dataColumns->findChild(name))) {
+      VLOG(1) << "Skipping " << split.filePath
+              << " based on split statistics and filter for column " << name;
+      return false;
+    }
+  }
+  return true;
+}
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
     const ConnectorQueryCtx* connectorQueryCtx,
     std::shared_ptr<io::IoStatistics> ioStats,
     folly::Executor* executor) {
+  if (readerOpts.mmapLocalFiles() &&
+      dwio::common::MmapBufferedInput::canMap(*fileHandle.file)) {
+    return std::make_unique<dwio::common::MmapBufferedInput>(
+        fileHandle.file, readerOpts.getMemoryPool(), ioStats);
+  }
   if (connectorQueryCtx->cache()) {
     return std::make_unique<dwio::common::CachedBufferedInput>(
         fileHandle.file,
@@ -775,6 +838,16 @@ core::TypedExprPtr extractFiltersFromRemainingFilter(
       filters.insert_or_assign(std::move(subfield), std::move(filter));
       return nullptr;
     }
+    // A filter implied by 'expr' skips data but 'expr' is still evaluated.
+    if (auto filter = exec::leafCallToImpliedSubfieldFilter(
+            *call, subfield, evaluator, negated)) {
+      if (auto it = filters.find(subfield); it != filters.end()) {
+        oldFilter = it->second.get();
+        filter = filter->mergeWith(oldFilter);
+      }
+      filters.insert_or_assign(std::move(subfield), std::move(filter));
+      return expr;
+    }
   } catch (const VeloxException&) {
     LOG(WARNING) << "Unexpected failure when extracting filter for: "
                  << expr->toString();
@@ -91,6 +91,18 @@ bool testFilters(
     const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
         partitionKeysHandle);
 
+/// Returns false if the partition key values and the statistics that come
+/// with 'split' show that no row of it passes the filters in 'scanSpec'. Does
+/// no IO, so that the split can be skipped before its file is opened.
+/// 'dataColumns' has the table types of the columns in
+/// 'split.columnStatistics' and may be null.
+bool testSplitStatistics(
+    const common::ScanSpec* scanSpec,
+    const HiveConnectorSplit& split,
+    const RowTypePtr& dataColumns,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle);
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
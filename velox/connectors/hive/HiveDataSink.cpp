@@ -345,7 +345,8 @@ HiveDataSink::HiveDataSink(
     std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
     const ConnectorQueryCtx* connectorQueryCtx,
     CommitStrategy commitStrategy,
-    const std::shared_ptr<const HiveConfig>& hiveConfig)
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    folly::Executor* executor)
     : inputType_(std::move(inputType)),
       insertTableHandle_(std::move(insertTableHandle)),
       connectorQueryCtx_(connectorQueryCtx),
@@ -353,6 +354,8 @@ HiveDataSink::HiveDataSink(
       hiveConfig_(hiveConfig),
       maxOpenWriters_(hiveConfig_->maxPartitionsPerWriters(
           connectorQueryCtx->sessionProperties())),
+      openWriterLimit_(
+          hiveConfig_->maxOpenWriters(connectorQueryCtx->sessionProperties())),
       partitionChannels_(getPartitionChannels(insertTableHandle_)),
       partitionIdGenerator_(
           !partitionChannels_.empty()
@@ -377,7 +380,8 @@ HiveDataSink::HiveDataSink(
                        : nullptr),
       writerFactory_(dwio::common::getWriterFactory(
           insertTableHandle_->tableStorageFormat())),
-      spillConfig_(connectorQueryCtx->spillConfig()) {
+      spillConfig_(connectorQueryCtx->spillConfig()),
+      executor_(executor) {
   VELOX_USER_CHECK(
       !isBucketed() || isPartitioned(), "A bucket table must be partitioned");
   if (isBucketed()) {
@@ -422,6 +426,8 @@ bool HiveDataSink::canReclaim() const {
 
 void HiveDataSink::appendData(RowVectorPtr input) {
   checkRunning();
+  VELOX_CHECK_NULL(asyncClose_, "Hive data sink is finishing");
+  ++numInputs_;
 
   // Write to unpartitioned table.
   if (!isPartitioned()) {
@@ -448,6 +454,14 @@ void HiveDataSink::appendData(RowVectorPtr input) {
 
   splitInputRowsAndEnsureWriters();
 
+  // Marks the writers of this input first so that opening a file for one of
+  // them does not close another one.
+  for (auto index = 0; index < writers_.size(); ++index) {
+    if (partitionSizes_[index] != 0) {
+      writerInfo_[index]->lastInput = numInputs_;
+    }
+  }
+
   for (auto index = 0; index < writers_.size(); ++index) {
     const vector_size_t partitionSize = partitionSizes_[index];
     if (partitionSize == 0) {
@@ -462,6 +476,9 @@ void HiveDataSink::appendData(RowVectorPtr input) {
 }
 
 void HiveDataSink::write(size_t index, RowVectorPtr input) {
+  writerInfo_[index]->lastInput = numInputs_;
+  ensureWriterOpen(index);
+
   WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
   auto dataInput = makeDataInput(dataChannels_, input);
 
@@ -469,6 +486,66 @@ void HiveDataSink::write(size_t index, RowVectorPtr input) {
   writerInfo_[index]->numWrittenRows += dataInput->size();
 }
 
+void HiveDataSink::ensureWriterOpen(uint32_t index) {
+  if (writers_[index] != nullptr) {
+    return;
+  }
+  if (canCloseWritersEarly() && numOpenWriters_ >= openWriterLimit_) {
+    std::optional<uint32_t> oldest;
+    for (uint32_t i = 0; i < writers_.size(); ++i) {
+      if (writers_[i] != nullptr &&
+          (!oldest.has_value() ||
+           writerInfo_[i]->lastInput < writerInfo_[*oldest]->lastInput)) {
+        oldest = i;
+      }
+    }
+    VELOX_CHECK(oldest.has_value());
+    closeWriterEarly(*oldest);
+  }
+
+  auto& info = writerInfo_[index];
+  if (!info->closedFiles.empty()) {
+    info->writerParameters =
+        getWriterParameters(info->writerParameters.partitionName(), {});
+  }
+  writers_[index] = createWriter(index);
+  ++numOpenWriters_;
+}
+
+void HiveDataSink::closeWriterEarly(uint32_t index) {
+  VELOX_CHECK(canCloseWritersEarly());
+  VELOX_CHECK_NOT_NULL(writers_[index]);
+  {
+    WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
+    writers_[index]->close();
+  }
+  auto& info = writerInfo_[index];
+  const uint64_t fileSize =
+      ioStats_[index]->rawBytesWritten() - info->closedFileBytes;
+  info->closedFiles.push_back({info->writerParameters, fileSize});
+  info->closedFileBytes += fileSize;
+  writers_[index].reset();
+  --numOpenWriters_;
+  addThreadLocalRuntimeStat(kEarlyClosedWriters, RuntimeCounter(1));
+}
+
+bool HiveDataSink::maybeCloseIdleWriter(const HiveWriterInfo* writerInfo) {
+  if (state_ != State::kRunning || !canCloseWritersEarly()) {
+    return false;
+  }
+  for (uint32_t i = 0; i < writerInfo_.size(); ++i) {
+    if (writerInfo_[i].get() != writerInfo) {
+      continue;
+    }
+    if (writers_[i] == nullptr || writerInfo->lastInput == numInputs_) {
+      return false;
+    }
+    closeWriterEarly(i);
+    return true;
+  }
+  VELOX_UNREACHABLE("Writer {} not found", writerInfo->writerPool->name());
+}
+
 std::string HiveDataSink::stateString(State state) {
   switch (state) {
     case State::kRunning:
@@ -506,10 +583,11 @@ DataSink::Stats HiveDataSink::stats() const {
     return stats;
   }
 
-  stats.numWrittenFiles = writers_.size();
+  stats.numWrittenFiles = numOpenWriters_;
   for (int i = 0; i < writerInfo_.size(); ++i) {
     const auto& info = writerInfo_.at(i);
     VELOX_CHECK_NOT_NULL(info);
+    stats.numWrittenFiles += info->closedFiles.size();
     const auto spillStats = info->spillStats->rlock();
     if (!spillStats->empty()) {
       stats.spillStats += *spillStats;
@@ -572,6 +650,20 @@ std::vector<std::string> HiveDataSink::close() {
   for (int i = 0; i < writerInfo_.size(); ++i) {
     const auto& info = writerInfo_.at(i);
     VELOX_CHECK_NOT_NULL(info);
+    auto fileWriteInfos = folly::dynamic::array();
+    for (const auto& file : info->closedFiles) {
+      fileWriteInfos.push_back(folly::dynamic::object(
+          "writeFileName", file.writerParameters.writeFileName())(
+          "targetFileName", file.writerParameters.targetFileName())(
+          "fileSize", file.fileSize));
+    }
+    if (writers_.at(i) != nullptr) {
+      fileWriteInfos.push_back(folly::dynamic::object(
+          "writeFileName", info->writerParameters.writeFileName())(
+          "targetFileName", info->writerParameters.targetFileName())(
+          "fileSize",
+          ioStats_.at(i)->rawBytesWritten() - info->closedFileBytes));
+    }
     // clang-format off
       auto partitionUpdateJson = folly::toJson(
        folly::dynamic::object
@@ -581,11 +673,7 @@ std::vector<std::string> HiveDataSink::close() {
               info->writerParameters.updateMode()))
           ("writePath", info->writerParameters.writeDirectory())
           ("targetPath", info->writerParameters.targetDirectory())
-          ("fileWriteInfos", folly::dynamic::array(
-            folly::dynamic::object
-              ("writeFileName", info->writerParameters.writeFileName())
-              ("targetFileName", info->writerParameters.targetFileName())
-              ("fileSize", ioStats_.at(i)->rawBytesWritten())))
+          ("fileWriteInfos", std::move(fileWriteInfos))
           ("rowCount", info->numWrittenRows)
          // TODO(gaoge): track and send the fields when inMemoryDataSizeInBytes
          // and containsNumberedFileNames are needed at coordinator when file_renaming_enabled are turned on.
@@ -598,6 +686,48 @@ std::vector<std::string> HiveDataSink::close() {
   return partitionUpdates;
 }
 
+bool HiveDataSink::finish(ContinueFuture& future) {
+  checkRunning();
+  if (asyncClose_ != nullptr) {
+    if (!asyncClose_->promise.isFulfilled()) {
+      future = asyncClose_->promise.getSemiFuture();
+      return false;
+    }
+    for (const auto& error : asyncClose_->errors) {
+      if (error != nullptr) {
+        std::rethrow_exception(error);
+      }
+    }
+    return true;
+  }
+
+  if (executor_ == nullptr || numOpenWriters_ == 0) {
+    return true;
+  }
+
+  asyncClose_ = std::make_shared<AsyncClose>();
+  asyncClose_->errors.resize(writers_.size());
+  asyncClose_->numPending = numOpenWriters_;
+  future = asyncClose_->promise.getSemiFuture();
+  for (uint32_t i = 0; i < writers_.size(); ++i) {
+    if (writers_[i] == nullptr) {
+      continue;
+    }
+    executor_->add([this, i, asyncClose = asyncClose_]() {
+      try {
+        WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
+        writers_[i]->close();
+      } catch (...) {
+        asyncClose->errors[i] = std::current_exception();
+      }
+      if (--asyncClose->numPending == 0) {
+        asyncClose->promise.setValue();
+      }
+    });
+  }
+  return false;
+}
+
 void HiveDataSink::abort() {
   checkRunning();
   state_ = State::kAborted;
@@ -610,13 +740,26 @@ void HiveDataSink::closeInternal() {
   TestValue::adjust(
       "facebook::velox::connector::hive::HiveDataSink::closeInternal", this);
 
+  if (asyncClose_ != nullptr) {
+    // The writers have been closed by finish(). Wait for them if the data sink
+    // is aborted before finish() is done.
+    asyncClose_->promise.getSemiFuture().wait();
+    return;
+  }
+
   if (state_ == State::kClosed) {
     for (int i = 0; i < writers_.size(); ++i) {
+      if (writers_[i] == nullptr) {
+        continue;
+      }
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->close();
     }
   } else {
     for (int i = 0; i < writers_.size(); ++i) {
+      if (writers_[i] == nullptr) {
+        continue;
+      }
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->abort();
     }
@@ -644,11 +787,7 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
         partitionIdGenerator_->partitionName(id.partitionId.value());
   }
 
-  // Without explicitly setting flush policy, the default memory based flush
-  // policy is used.
   auto writerParameters = getWriterParameters(partitionName, id.bucketId);
-  const auto writePath = fs::path(writerParameters.writeDirectory()) /
-      writerParameters.writeFileName();
   auto writerPool = createWriterPool(id);
   auto sinkPool = createSinkPool(writerPool);
   std::shared_ptr<memory::MemoryPool> sortPool{nullptr};
@@ -663,67 +802,89 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   ioStats_.emplace_back(std::make_shared<io::IoStatistics>());
   setMemoryReclaimers(writerInfo_.back().get(), ioStats_.back().get());
 
+  writers_.emplace_back(nullptr);
+  // Extends the buffer used for partition rows calculations.
+  partitionSizes_.emplace_back(0);
+  partitionRows_.emplace_back(nullptr);
+  rawPartitionRows_.emplace_back(nullptr);
+
+  writerIndexMap_.emplace(id, writers_.size() - 1);
+  return writerIndexMap_[id];
+}
+
+std::unique_ptr<dwio::common::Writer> HiveDataSink::createWriter(
+    uint32_t index) {
+  const auto& info = writerInfo_[index];
+  const auto writePath = fs::path(info->writerParameters.writeDirectory()) /
+      info->writerParameters.writeFileName();
+
+  // Without explicitly setting flush policy, the default memory based flush
+  // policy is used.
   dwio::common::WriterOptions options;
   const auto* connectorSessionProperties =
       connectorQueryCtx_->sessionProperties();
   options.schema = getNonPartitionTypes(dataChannels_, inputType_);
 
-  options.memoryPool = writerInfo_.back()->writerPool.get();
+  options.memoryPool = info->writerPool.get();
   options.compressionKind = insertTableHandle_->compressionKind();
   if (canReclaim()) {
     options.spillConfig = spillConfig_;
   }
-  options.nonReclaimableSection =
-      writerInfo_.back()->nonReclaimableSectionHolder.get();
+  options.nonReclaimableSection = info->nonReclaimableSectionHolder.get();
   options.maxStripeSize = std::optional(
       hiveConfig_->orcWriterMaxStripeSize(connectorSessionProperties));
   options.maxDictionaryMemory = std::optional(
       hiveConfig_->orcWriterMaxDictionaryMemory(connectorSessionProperties));
   options.parquetWriteTimestampUnit =
       hiveConfig_->parquetWriteTimestampUnit(connectorSessionProperties);
+  if (hiveConfig_->orcWriterAsyncUpload(connectorSessionProperties)) {
+    options.uploadExecutor = executor_;
+  }
   options.serdeParameters = std::map<std::string, std::string>(
       insertTableHandle_->serdeParameters().begin(),
       insertTableHandle_->serdeParameters().end());
 
   // Prevents the memory allocation during the writer creation.
-  WRITER_NON_RECLAIMABLE_SECTION_GUARD(writerInfo_.size() - 1);
+  WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
   auto writer = writerFactory_->createWriter(
       dwio::common::FileSink::create(
           writePath,
           {.bufferWrite = false,
            .connectorProperties = hiveConfig_->config(),
            .fileCreateConfig = hiveConfig_->writeFileCreateConfig(),
-           .pool = writerInfo_.back()->sinkPool.get(),
+           .pool = info->sinkPool.get(),
            .metricLogger = dwio::common::MetricsLog::voidLog(),
-           .stats = ioStats_.back().get()}),
+           .stats = ioStats_[index].get()}),
       options);
-  writer = maybeCreateBucketSortWriter(std::move(writer));
-  writers_.emplace_back(std::move(writer));
-  // Extends the buffer used for partition rows calculations.
-  partitionSizes_.emplace_back(0);
-  partitionRows_.emplace_back(nullptr);
-  rawPartitionRows_.emplace_back(nullptr);
-
-  writerIndexMap_.emplace(id, writers_.size() - 1);
-  return writerIndexMap_[id];
+  return maybeCreateBucketSortWriter(index, std::move(writer));
 }
 
 std::unique_ptr<facebook::velox::dwio::common::Writer>
 HiveDataSink::maybeCreateBucketSortWriter(
+    uint32_t index,
     std::unique_ptr<facebook::velox::dwio::common::Writer> writer) {
   if (!sortWrite()) {
     return writer;
   }
-  auto* sortPool = writerInfo_.back()->sortPool.get();
+  auto* sortPool = writerInfo_[index]->sortPool.get();
   VELOX_CHECK_NOT_NULL(sortPool);
+  std::optional<exec::PrefixSortConfig> prefixSortConfig;
+  const auto normalizedKeyMaxBytes =
+      hiveConfig_->sortWriterNormalizedKeyMaxBytes(
+          connectorQueryCtx_->sessionProperties());
+  if (normalizedKeyMaxBytes > 0) {
+    prefixSortConfig.emplace(normalizedKeyMaxBytes);
+  }
   auto sortBuffer = std::make_unique<exec::SortBuffer>(
       getNonPartitionTypes(dataChannels_, inputType_),
       sortColumnIndices_,
       sortCompareFlags_,
       sortPool,
-      writerInfo_.back()->nonReclaimableSectionHolder.get(),
+      writerInfo_[index]->nonReclaimableSectionHolder.get(),
       spillConfig_,
-      writerInfo_.back()->spillStats.get());
+      writerInfo_[index]->spillStats.get(),
+      /*columnarPayloadMinWidth=*/0,
+      prefixSortConfig);
   return std::make_unique<dwio::common::SortingWriter>(
       std::move(writer),
       std::move(sortBuffer),
@@ -972,6 +1133,10 @@ uint64_t HiveDataSink::WriterReclaimer::reclaim(
     return 0;
   }
 
+  if (dataSink_->maybeCloseIdleWriter(writerInfo_)) {
+    return pool->shrink(targetBytes);
+  }
+
   const uint64_t memoryUsageBeforeReclaim = pool->currentBytes();
   const std::string memoryUsageTreeBeforeReclaim = pool->treeMemoryUsage();
   const auto writtenBytesBeforeReclaim = ioStats_->rawBytesWritten();
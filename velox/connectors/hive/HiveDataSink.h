@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/futures/SharedPromise.h>
+
 #include "velox/common/compression/Compression.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/HiveConfig.h"
@@ -339,15 +341,21 @@ class HiveWriterParameters {
   }
 
  private:
-  const UpdateMode updateMode_;
-  const std::optional<std::string> partitionName_;
-  const std::string targetFileName_;
-  const std::string targetDirectory_;
-  const std::string writeFileName_;
-  const std::string writeDirectory_;
+  UpdateMode updateMode_;
+  std::optional<std::string> partitionName_;
+  std::string targetFileName_;
+  std::string targetDirectory_;
+  std::string writeFileName_;
+  std::string writeDirectory_;
 };
 
 struct HiveWriterInfo {
+  /// A file that the writer closed before the data sink was closed.
+  struct ClosedFile {
+    HiveWriterParameters writerParameters;
+    uint64_t fileSize;
+  };
+
   HiveWriterInfo(
       HiveWriterParameters parameters,
       std::shared_ptr<memory::MemoryPool> _writerPool,
@@ -360,7 +368,9 @@ struct HiveWriterInfo {
         sinkPool(std::move(_sinkPool)),
         sortPool(std::move(_sortPool)) {}
 
-  const HiveWriterParameters writerParameters;
+  /// Parameters of the file being written. A writer that continues after
+  /// closing its file early writes to a file with new names.
+  HiveWriterParameters writerParameters;
   const std::unique_ptr<tsan_atomic<bool>> nonReclaimableSectionHolder;
   /// Collects the spill stats from sort writer if the spilling has been
   /// triggered.
@@ -369,6 +379,12 @@ struct HiveWriterInfo {
   const std::shared_ptr<memory::MemoryPool> sinkPool;
   const std::shared_ptr<memory::MemoryPool> sortPool;
   int64_t numWrittenRows = 0;
+  /// Sequence number of the last input with rows for this writer.
+  uint64_t lastInput = 0;
+  /// The files closed early, in the order they were written.
+  std::vector<ClosedFile> closedFiles;
+  /// Total size of 'closedFiles'.
+  uint64_t closedFileBytes = 0;
 };
 
 /// Identifies a hive writer.
@@ -413,13 +429,15 @@ class HiveDataSink : public DataSink {
  public:
   /// The list of runtime stats reported by hive data sink
   static constexpr const char* kEarlyFlushedRawBytes = "earlyFlushedRawBytes";
+  static constexpr const char* kEarlyClosedWriters = "earlyClosedWriters";
 
   HiveDataSink(
       RowTypePtr inputType,
       std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
       const ConnectorQueryCtx* connectorQueryCtx,
       CommitStrategy commitStrategy,
-      const std::shared_ptr<const HiveConfig>& hiveConfig);
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      folly::Executor* executor = nullptr);
 
   static uint32_t maxBucketCount() {
     static const uint32_t kMaxBucketCount = 100'000;
@@ -430,6 +448,11 @@ class HiveDataSink : public DataSink {
 
   Stats stats() const override;
 
+  /// Closes the open file writers in parallel on the connector executor, if
+  /// there is one, so that the uploads and file closes of all writers overlap
+  /// instead of running one after the other in close().
+  bool finish(ContinueFuture& future) override;
+
   std::vector<std::string> close() override;
 
   void abort() override;
@@ -522,11 +545,38 @@ class HiveDataSink : public DataSink {
   uint32_t ensureWriter(const HiveWriterId& id);
 
   // Appends a new writer for the given 'id'. The function returns the index of
-  // the newly created writer in 'writers_'.
+  // the newly created writer in 'writers_'. The file of the writer is opened
+  // by its first write.
   uint32_t appendWriter(const HiveWriterId& id);
 
+  // Returns true if writers may close their files before the data sink is
+  // closed to stay within 'openWriterLimit_'. Bucketed tables have exactly
+  // one file per bucket, so their writers are only closed with the data sink.
+  bool canCloseWritersEarly() const {
+    return openWriterLimit_ != 0 && !isBucketed();
+  }
+
+  // Opens a file for the writer at 'index' if it has none. If there are
+  // 'openWriterLimit_' open writers, first closes the one whose last input is
+  // the oldest.
+  void ensureWriterOpen(uint32_t index);
+
+  // Creates the file writer for the current parameters of 'writerInfo_[index]'.
+  std::unique_ptr<dwio::common::Writer> createWriter(uint32_t index);
+
+  // Closes the file of the writer at 'index'. The writer opens a new file of
+  // the same partition if it gets more rows.
+  void closeWriterEarly(uint32_t index);
+
+  // Closes the file of the writer of 'writerInfo' if it has one and got no
+  // rows from the latest input. Returns true if closed. Invoked by memory
+  // reclaim, where closing an idle writer frees all its memory while flushing
+  // would leave its buffers in place.
+  bool maybeCloseIdleWriter(const HiveWriterInfo* writerInfo);
+
   std::unique_ptr<facebook::velox::dwio::common::Writer>
   maybeCreateBucketSortWriter(
+      uint32_t index,
       std::unique_ptr<facebook::velox::dwio::common::Writer> writer);
 
   HiveWriterParameters getWriterParameters(
@@ -554,12 +604,23 @@ class HiveDataSink : public DataSink {
 
   void closeInternal();
 
+  // Tracks the file writers closed by finish() on 'executor_'.
+  struct AsyncClose {
+    std::atomic<uint32_t> numPending{0};
+    // Fulfilled when all the writers are closed.
+    folly::SharedPromise<folly::Unit> promise;
+    // The errors of closing the writers, indexed like 'writers_'.
+    std::vector<std::exception_ptr> errors;
+  };
+
   const RowTypePtr inputType_;
   const std::shared_ptr<const HiveInsertTableHandle> insertTableHandle_;
   const ConnectorQueryCtx* const connectorQueryCtx_;
   const CommitStrategy commitStrategy_;
   const std::shared_ptr<const HiveConfig> hiveConfig_;
   const uint32_t maxOpenWriters_;
+  // Maximum number of writers with an open file. 0 if there is no limit.
+  const uint32_t openWriterLimit_;
   const std::vector<column_index_t> partitionChannels_;
   const std::unique_ptr<PartitionIdGenerator> partitionIdGenerator_;
   // Indices of dataChannel are stored in ascending order
@@ -568,12 +629,18 @@ class HiveDataSink : public DataSink {
   const std::unique_ptr<core::PartitionFunction> bucketFunction_;
   const std::shared_ptr<dwio::common::WriterFactory> writerFactory_;
   const common::SpillConfig* const spillConfig_;
+  // Executor of the connector. Runs background writes of the file writers.
+  folly::Executor* const executor_;
 
   std::vector<column_index_t> sortColumnIndices_;
   std::vector<CompareFlags> sortCompareFlags_;
 
   State state_{State::kRunning};
 
+  // Set when finish() starts closing the writers on 'executor_'. Shared with
+  // the close tasks.
+  std::shared_ptr<AsyncClose> asyncClose_;
+
   tsan_atomic<bool> nonReclaimableSection_{false};
 
   // The map from writer id to the writer index in 'writers_' and 'writerInfo_'.
@@ -586,6 +653,11 @@ class HiveDataSink : public DataSink {
   std::vector<std::unique_ptr<dwio::common::Writer>> writers_;
   // IO statistics collected for each writer.
   std::vector<std::shared_ptr<io::IoStatistics>> ioStats_;
+  // Number of non-null entries in 'writers_'. The entry of a writer is null
+  // before its first write and after it is closed early.
+  uint32_t numOpenWriters_{0};
+  // Number of inputs received so far.
+  uint64_t numInputs_{0};
 
   // Below are structures updated when processing current input. partitionIds_
   // are indexed by the row of input_. partitionRows_, rawPartitionRows_ and
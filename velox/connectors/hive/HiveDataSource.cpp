@@ -29,6 +29,33 @@ namespace facebook::velox::connector::hive {
 class HiveTableHandle;
 class HiveColumnHandle;
 
+namespace {
+// Returns the columns read for the aggregates of 'tableHandle', or
+// 'outputType' if it has no aggregates.
+RowTypePtr columnsToRead(
+    const RowTypePtr& outputType,
+    const std::shared_ptr<connector::ConnectorTableHandle>& tableHandle,
+    const std::unordered_map<
+        std::string,
+        std::shared_ptr<connector::ColumnHandle>>& columnHandles) {
+  auto* hiveTableHandle =
+      dynamic_cast<const HiveTableHandle*>(tableHandle.get());
+  if (hiveTableHandle == nullptr || hiveTableHandle->aggregates().empty()) {
+    return outputType;
+  }
+  return HiveAggregation::inputType(
+      hiveTableHandle->aggregates(), [&](const std::string& name) {
+        auto it = columnHandles.find(name);
+        VELOX_CHECK(
+            it != columnHandles.end(),
+            "ColumnHandle is missing for aggregate input column: {}",
+            name);
+        return static_cast<const HiveColumnHandle*>(it->second.get())
+            ->dataType();
+      });
+}
+} // namespace
+
 HiveDataSource::HiveDataSource(
     const RowTypePtr& outputType,
     const std::shared_ptr<connector::ConnectorTableHandle>& tableHandle,
@@ -44,7 +71,7 @@ HiveDataSource::HiveDataSource(
       executor_(executor),
       connectorQueryCtx_(connectorQueryCtx),
       hiveConfig_(hiveConfig),
-      outputType_(outputType),
+      outputType_(columnsToRead(outputType, tableHandle, columnHandles)),
       expressionEvaluator_(connectorQueryCtx->expressionEvaluator()) {
   // Column handled keyed on the column alias, the name used in the query.
   for (const auto& [canonicalizedName, columnHandle] : columnHandles) {
@@ -159,6 +186,24 @@ HiveDataSource::HiveDataSource(
         *scanSpec_, *remainingFilter, expressionEvaluator_);
   }
 
+  if (!hiveTableHandle_->aggregates().empty()) {
+    std::vector<std::string> fileColumnNames;
+    for (const auto& name : outputType_->names()) {
+      auto* handle =
+          static_cast<const HiveColumnHandle*>(columnHandles.at(name).get());
+      fileColumnNames.push_back(
+          handle->columnType() == HiveColumnHandle::ColumnType::kRegular
+              ? handle->name()
+              : "");
+    }
+    aggregation_ = std::make_unique<HiveAggregation>(
+        hiveTableHandle_->aggregates(),
+        outputType,
+        outputType_,
+        std::move(fileColumnNames),
+        pool_);
+  }
+
   ioStats_ = std::make_shared<io::IoStatistics>();
 }
 
@@ -194,11 +239,44 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   // so we initialize it beforehand.
   splitReader_->configureReaderOptions(randomSkip_);
   splitReader_->prepareSplit(metadataFilter_, runtimeStats_);
+  statisticsChecked_ = false;
 }
 
 std::optional<RowVectorPtr> HiveDataSource::next(
     uint64_t size,
     velox::ContinueFuture& /*future*/) {
+  if (aggregation_ != nullptr) {
+    return nextAggregates(size);
+  }
+  return nextRows(size);
+}
+
+std::optional<RowVectorPtr> HiveDataSource::nextAggregates(uint64_t size) {
+  if (aggregatesReturned_) {
+    aggregatesReturned_ = false;
+    return nullptr;
+  }
+  VELOX_CHECK(split_ != nullptr, "No split to process. Call addSplit first.");
+  if (!statisticsChecked_) {
+    statisticsChecked_ = true;
+    if (remainingFilterExprSet_ == nullptr && !scanSpec_->hasFilter() &&
+        aggregation_->addStatistics(*splitReader_)) {
+      ++numSplitsAggregatedFromStatistics_;
+      resetSplit();
+      aggregatesReturned_ = true;
+      return aggregation_->finish();
+    }
+  }
+  auto input = nextRows(size);
+  if (input.value() != nullptr) {
+    aggregation_->addInput(*input.value());
+    return aggregation_->emptyOutput();
+  }
+  aggregatesReturned_ = true;
+  return aggregation_->finish();
+}
+
+std::optional<RowVectorPtr> HiveDataSource::nextRows(uint64_t size) {
   VELOX_CHECK(split_ != nullptr, "No split to process. Call addSplit first.");
   VELOX_CHECK_NOT_NULL(splitReader_, "No split reader present");
 
@@ -277,6 +355,7 @@ void HiveDataSource::addDynamicFilter(
   fieldSpec.addFilter(*filter);
   scanSpec_->resetCachedValues(true);
   if (splitReader_) {
+    splitReader_->onDynamicFilter(fieldSpec, *filter);
     splitReader_->resetFilterCaches();
   }
 }
@@ -318,6 +397,46 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
             ioStats_->rawOverreadBytes(), RuntimeCounter::Unit::kBytes)},
        {"queryThreadIoLatency",
         RuntimeCounter(ioStats_->queryThreadIoLatency().count())}});
+  if (hiveConfig_->hedgedReadMaxInFlight() > 0) {
+    res.insert(
+        {{"numHedgedReads", RuntimeCounter(ioStats_->numHedgedReads())},
+         {"numHedgeWins", RuntimeCounter(ioStats_->numHedgeWins())}});
+  }
+  if (ioStats_->localBytesRead() > 0) {
+    res.insert(
+        {"shortCircuitLocalBytes",
+         RuntimeCounter(
+             ioStats_->localBytesRead(), RuntimeCounter::Unit::kBytes)});
+  }
+  if (ioStats_->remoteBytesRead() > 0) {
+    res.insert(
+        {"remoteBytesRead",
+         RuntimeCounter(
+             ioStats_->remoteBytesRead(), RuntimeCounter::Unit::kBytes)});
+  }
+  if (const auto count = ioStats_->coalesceDistance().count(); count > 0) {
+    res.insert(
+        {{"coalesceDistance",
+          RuntimeCounter(
+              ioStats_->coalesceDistance().sum() / count,
+              RuntimeCounter::Unit::kBytes)},
+         {"coalesceBytes",
+          RuntimeCounter(
+              ioStats_->coalesceBytes().sum() / count,
+              RuntimeCounter::Unit::kBytes)}});
+  }
+  if (ioStats_->offloadedDecompressionBytes() > 0) {
+    res.insert(
+        {"offloadedDecompressionBytes",
+         RuntimeCounter(
+             ioStats_->offloadedDecompressionBytes(),
+             RuntimeCounter::Unit::kBytes)});
+  }
+  if (aggregation_ != nullptr) {
+    res.insert(
+        {"numSplitsAggregatedFromStatistics",
+         RuntimeCounter(numSplitsAggregatedFromStatistics_)});
+  }
   return res;
 }
 
@@ -333,6 +452,7 @@ void HiveDataSource::setFromDataSource(
   scanSpec_ = std::move(source->scanSpec_);
   splitReader_ = std::move(source->splitReader_);
   splitReader_->setConnectorQueryCtx(connectorQueryCtx_);
+  statisticsChecked_ = false;
   // New io will be accounted on the stats of 'source'. Add the existing
   // balance to that.
   source->ioStats_->merge(*ioStats_);
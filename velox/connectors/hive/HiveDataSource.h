@@ -19,6 +19,7 @@
 #include "velox/common/io/IoStatistics.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveAggregation.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/SplitReader.h"
 #include "velox/connectors/hive/TableHandle.h"
@@ -127,6 +128,14 @@ class HiveDataSource : public DataSource {
   // filterEvalCtx_.selectedIndices and selectedBits are not updated.
   vector_size_t evaluateRemainingFilter(RowVectorPtr& rowVector);
 
+  // Returns the next batch of rows of the split.
+  std::optional<RowVectorPtr> nextRows(uint64_t size);
+
+  // Aggregates the rows of the split. Returns the aggregates after the last
+  // batch of the split, or from the file statistics instead of reading the
+  // rows if they have the exact results.
+  std::optional<RowVectorPtr> nextAggregates(uint64_t size);
+
   // Clear split_ after split has been fully processed.  Keep readers around to
   // hold adaptation.
   void resetSplit();
@@ -138,7 +147,9 @@ class HiveDataSource : public DataSource {
     return emptyOutput_;
   }
 
-  // The row type for the data source output, not including filter-only columns
+  // The row type for the data source output, not including filter-only
+  // columns. These are the input columns of the aggregates if the table handle
+  // has aggregates.
   const RowTypePtr outputType_;
   core::ExpressionEvaluator* const expressionEvaluator_;
 
@@ -158,6 +169,15 @@ class HiveDataSource : public DataSource {
   exec::FilterEvalCtx filterEvalCtx_;
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
 
+  // Set if the table handle has aggregates.
+  std::unique_ptr<HiveAggregation> aggregation_;
+  // True if the file statistics were checked for the aggregates of the split.
+  bool statisticsChecked_{false};
+  // True if the aggregates of the split were returned by the last call to
+  // next().
+  bool aggregatesReturned_{false};
+  uint64_t numSplitsAggregatedFromStatistics_{0};
+
   // Remembers the WaveDataSource. Successive calls to toWaveDataSource() will
   // return the same.
   std::shared_ptr<wave::WaveDataSource> waveDataSource_;
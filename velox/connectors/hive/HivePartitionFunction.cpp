@@ -462,6 +462,7 @@ HivePartitionFunction::HivePartitionFunction(
     std::vector<column_index_t> keyChannels,
     const std::vector<VectorPtr>& constValues)
     : numBuckets_{numBuckets},
+      bucketModulo_(numBuckets),
       bucketToPartition_{bucketToPartition},
       keyChannels_{std::move(keyChannels)} {
   precomputedHashes_.resize(keyChannels_.size());
@@ -502,12 +503,11 @@ std::optional<uint32_t> HivePartitionFunction::partition(
     // NOTE: if bucket to partition mapping is empty, then we do
     // identical mapping.
     for (auto i = 0; i < numRows; ++i) {
-      partitions[i] = (hashes[i] & kInt32Max) % numBuckets_;
+      partitions[i] = bucketModulo_(hashes[i] & kInt32Max);
     }
   } else {
     for (auto i = 0; i < numRows; ++i) {
-      partitions[i] =
-          bucketToPartition_[((hashes[i] & kInt32Max) % numBuckets_)];
+      partitions[i] = bucketToPartition_[bucketModulo_(hashes[i] & kInt32Max)];
     }
   }
 
@@ -141,6 +141,10 @@ void SplitReader::configureReaderOptions(
 void SplitReader::prepareSplit(
     std::shared_ptr<common::MetadataFilter> metadataFilter,
     dwio::common::RuntimeStatistics& runtimeStats) {
+  if (checkIfSplitIsPruned(runtimeStats)) {
+    return;
+  }
+
   createReader();
 
   if (checkIfSplitIsEmpty(runtimeStats)) {
@@ -194,6 +198,32 @@ bool SplitReader::allPrefetchIssued() const {
   return baseRowReader_ && baseRowReader_->allPrefetchIssued();
 }
 
+bool SplitReader::statisticsCoverSplit() const {
+  return !emptySplit_ && baseReader_ != nullptr && hiveSplit_->start == 0 &&
+      hiveSplit_->length >= fileSize_ &&
+      baseReaderOpts_.randomSkip() == nullptr;
+}
+
+std::optional<uint64_t> SplitReader::numFileRows() const {
+  if (baseReader_ == nullptr) {
+    return std::nullopt;
+  }
+  return baseReader_->numberOfRows();
+}
+
+std::unique_ptr<dwio::common::ColumnStatistics>
+SplitReader::fileColumnStatistics(const std::string& name) const {
+  if (baseReader_ == nullptr) {
+    return nullptr;
+  }
+  const auto index = baseReader_->rowType()->getChildIdxIfExists(name);
+  if (!index.has_value()) {
+    return nullptr;
+  }
+  return baseReader_->columnStatistics(
+      baseReader_->typeWithId()->childAt(index.value())->id());
+}
+
 void SplitReader::setConnectorQueryCtx(
     const ConnectorQueryCtx* connectorQueryCtx) {
   connectorQueryCtx_ = connectorQueryCtx;
@@ -220,9 +250,28 @@ void SplitReader::createReader() {
   VELOX_CHECK_NE(
       baseReaderOpts_.getFileFormat(), dwio::common::FileFormat::UNKNOWN);
 
+  // The size and modification time in the split save the file system from
+  // looking them up when opening the file.
+  auto infoColumn = [&](const char* name) -> std::optional<int64_t> {
+    auto it = hiveSplit_->infoColumns.find(name);
+    if (it == hiveSplit_->infoColumns.end()) {
+      return std::nullopt;
+    }
+    auto value = folly::tryTo<int64_t>(it->second);
+    if (value.hasError()) {
+      return std::nullopt;
+    }
+    return value.value();
+  };
+  FileProperties fileProperties;
+  fileProperties.fileSize = infoColumn("$file_size");
+  fileProperties.modificationTime = infoColumn("$file_modified_time");
+
   std::shared_ptr<FileHandle> fileHandle;
   try {
-    fileHandle = fileHandleFactory_->generate(hiveSplit_->filePath).second;
+    fileHandle =
+        fileHandleFactory_->generate(hiveSplit_->filePath, &fileProperties)
+            .second;
   } catch (const VeloxRuntimeError& e) {
     if (e.errorCode() == error_code::kFileNotFound &&
         hiveConfig_->ignoreMissingFiles(
@@ -241,6 +290,7 @@ void SplitReader::createReader() {
   if (auto* cacheTTLController = cache::CacheTTLController::getInstance()) {
     cacheTTLController->addOpenFileInfo(fileHandle->uuid.id());
   }
+  fileSize_ = fileHandle->file->size();
   auto baseFileInput = createBufferedInput(
       *fileHandle, baseReaderOpts_, connectorQueryCtx_, ioStats_, executor_);
 
@@ -248,6 +298,21 @@ void SplitReader::createReader() {
                     ->createReader(std::move(baseFileInput), baseReaderOpts_);
 }
 
+bool SplitReader::checkIfSplitIsPruned(
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  if (testSplitStatistics(
+          scanSpec_.get(),
+          *hiveSplit_,
+          baseReaderOpts_.getFileSchema(),
+          *partitionKeys_)) {
+    return false;
+  }
+  ++runtimeStats.skippedSplits;
+  runtimeStats.skippedSplitBytes += hiveSplit_->length;
+  emptySplit_ = true;
+  return true;
+}
+
 bool SplitReader::checkIfSplitIsEmpty(
     dwio::common::RuntimeStatistics& runtimeStats) {
   // emptySplit_ may already be set if the data file is not found. In this case
@@ -289,6 +354,17 @@ void SplitReader::createRowReader(
       metadataFilter,
       ROW(std::vector<std::string>(fileType->names()), std::move(columnTypes)),
       hiveSplit_);
+  const auto decodingParallelismFactor =
+      hiveConfig_->decodingParallelismFactor(
+          connectorQueryCtx_->sessionProperties());
+  if (decodingParallelismFactor > 1 && executor_ != nullptr) {
+    // The executor belongs to the connector, which outlives the reader.
+    baseRowReaderOpts_.setDecodingExecutor(
+        std::shared_ptr<folly::Executor>(
+            std::shared_ptr<folly::Executor>(), executor_));
+    baseRowReaderOpts_.setDecodingParallelismFactor(
+        decodingParallelismFactor);
+  }
   // NOTE: we firstly reset the finished 'baseRowReader_' of previous split
   // before setting up for the next one to avoid doubling the peak memory usage.
   baseRowReader_.reset();
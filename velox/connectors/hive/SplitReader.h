@@ -36,6 +36,7 @@ class ConnectorQueryCtx;
 } // namespace facebook::velox::connector
 
 namespace facebook::velox::dwio::common {
+class ColumnStatistics;
 class Reader;
 class RowReader;
 struct RuntimeStatistics;
@@ -97,6 +98,13 @@ class SplitReader {
 
   void resetFilterCaches();
 
+  /// Called after 'filter' is pushed down at run time into 'fieldSpec', a
+  /// child of the scan spec. Lets table formats that change the filters of the
+  /// scan spec per split keep the dynamic filters when the split is done.
+  virtual void onDynamicFilter(
+      common::ScanSpec& /*fieldSpec*/,
+      const common::Filter& /*filter*/) {}
+
   bool emptySplit() const;
 
   void resetSplit();
@@ -107,6 +115,20 @@ class SplitReader {
 
   bool allPrefetchIssued() const;
 
+  /// Returns true if the statistics of the base file describe exactly the rows
+  /// of the split, i.e. the split covers the whole file and no rows of the file
+  /// are skipped or deleted by the split reader. Filters are not considered.
+  /// Called after prepareSplit.
+  virtual bool statisticsCoverSplit() const;
+
+  /// Returns the number of rows in the base file, if known.
+  std::optional<uint64_t> numFileRows() const;
+
+  /// Returns the statistics of the top-level column 'name' of the base file, or
+  /// nullptr if the file does not have the column or has no statistics for it.
+  std::unique_ptr<dwio::common::ColumnStatistics> fileColumnStatistics(
+      const std::string& name) const;
+
   void setConnectorQueryCtx(const ConnectorQueryCtx* connectorQueryCtx);
 
   std::string toString() const;
@@ -116,6 +138,12 @@ class SplitReader {
   /// read the data file's metadata and schema
   void createReader();
 
+  /// Check if the filters can be shown to filter out all rows of hiveSplit_
+  /// by its partition key values and the statistics that come with it. If so,
+  /// marks the split as empty. This needs no IO and is called before
+  /// baseReader_ is created.
+  bool checkIfSplitIsPruned(dwio::common::RuntimeStatistics& runtimeStats);
+
   /// Check if the hiveSplit_ is empty. The split is considered empty when
   ///   1) The data file is missing but the user chooses to ignore it
   ///   2) The file does not contain any rows
@@ -159,6 +187,8 @@ class SplitReader {
   dwio::common::ReaderOptions baseReaderOpts_;
   dwio::common::RowReaderOptions baseRowReaderOpts_;
   bool emptySplit_;
+  // Size of the base file in bytes.
+  uint64_t fileSize_{0};
 };
 
 } // namespace facebook::velox::connector::hive
@@ -37,8 +37,36 @@ std::unordered_map<V, K> invertMap(const std::unordered_map<K, V>& mapping) {
   return inverted;
 }
 
+std::unordered_map<HiveAggregate::Kind, std::string> aggregateKindNames() {
+  return {
+      {HiveAggregate::Kind::kCount, "count"},
+      {HiveAggregate::Kind::kMin, "min"},
+      {HiveAggregate::Kind::kMax, "max"},
+  };
+}
+
 } // namespace
 
+std::string HiveAggregate::toString() const {
+  static const auto kindNames = aggregateKindNames();
+  return fmt::format(
+      "{}({})", kindNames.at(kind), column.empty() ? "*" : column);
+}
+
+folly::dynamic HiveAggregate::serialize() const {
+  static const auto kindNames = aggregateKindNames();
+  folly::dynamic obj = folly::dynamic::object;
+  obj["kind"] = kindNames.at(kind);
+  obj["column"] = column;
+  return obj;
+}
+
+// static
+HiveAggregate HiveAggregate::create(const folly::dynamic& obj) {
+  static const auto nameKinds = invertMap(aggregateKindNames());
+  return {nameKinds.at(obj["kind"].asString()), obj["column"].asString()};
+}
+
 std::string HiveColumnHandle::columnTypeName(
     HiveColumnHandle::ColumnType type) {
   static const auto ctNames = columnTypeNames();
@@ -109,14 +137,16 @@ HiveTableHandle::HiveTableHandle(
     SubfieldFilters subfieldFilters,
     const core::TypedExprPtr& remainingFilter,
     const RowTypePtr& dataColumns,
-    const std::unordered_map<std::string, std::string>& tableParameters)
+    const std::unordered_map<std::string, std::string>& tableParameters,
+    std::vector<HiveAggregate> aggregates)
     : ConnectorTableHandle(std::move(connectorId)),
       tableName_(tableName),
       filterPushdownEnabled_(filterPushdownEnabled),
       subfieldFilters_(std::move(subfieldFilters)),
       remainingFilter_(remainingFilter),
       dataColumns_(dataColumns),
-      tableParameters_(tableParameters) {}
+      tableParameters_(tableParameters),
+      aggregates_(std::move(aggregates)) {}
 
 std::string HiveTableHandle::toString() const {
   std::stringstream out;
@@ -144,6 +174,16 @@ std::string HiveTableHandle::toString() const {
   if (dataColumns_) {
     out << ", data columns: " << dataColumns_->toString();
   }
+  if (!aggregates_.empty()) {
+    out << ", aggregates: [";
+    for (auto i = 0; i < aggregates_.size(); ++i) {
+      if (i > 0) {
+        out << ", ";
+      }
+      out << aggregates_[i].toString();
+    }
+    out << "]";
+  }
   return out.str();
 }
 
@@ -167,6 +207,13 @@ folly::dynamic HiveTableHandle::serialize() const {
   if (dataColumns_) {
     obj["dataColumns"] = dataColumns_->serialize();
   }
+  if (!aggregates_.empty()) {
+    folly::dynamic aggregates = folly::dynamic::array;
+    for (const auto& aggregate : aggregates_) {
+      aggregates.push_back(aggregate.serialize());
+    }
+    obj["aggregates"] = aggregates;
+  }
 
   return obj;
 }
@@ -199,13 +246,22 @@ ConnectorTableHandlePtr HiveTableHandle::create(
     dataColumns = ISerializable::deserialize<RowType>(it->second, context);
   }
 
+  std::vector<HiveAggregate> aggregates;
+  if (auto it = obj.find("aggregates"); it != obj.items().end()) {
+    for (const auto& aggregate : it->second) {
+      aggregates.push_back(HiveAggregate::create(aggregate));
+    }
+  }
+
   return std::make_shared<const HiveTableHandle>(
       connectorId,
       tableName,
       filterPushdownEnabled,
       std::move(subfieldFilters),
       remainingFilter,
-      dataColumns);
+      dataColumns,
+      std::unordered_map<std::string, std::string>{},
+      std::move(aggregates));
 }
 
 void HiveTableHandle::registerSerDe() {
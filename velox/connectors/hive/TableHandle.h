@@ -112,8 +112,32 @@ class HiveColumnHandle : public ColumnHandle {
   const std::vector<common::Subfield> requiredSubfields_;
 };
 
+/// Aggregate that a HiveDataSource computes over the rows of each split in
+/// place of returning the rows. The data source returns one row of partial
+/// results per split, with a BIGINT for a count and a value of the input type
+/// for a minimum or maximum. A final aggregation combines the counts with sum
+/// and the minimums and maximums with min and max.
+struct HiveAggregate {
+  enum class Kind { kCount, kMin, kMax };
+
+  Kind kind;
+
+  /// Name of the input column in the column handles of the table scan. Empty
+  /// for count(*).
+  std::string column;
+
+  std::string toString() const;
+
+  folly::dynamic serialize() const;
+
+  static HiveAggregate create(const folly::dynamic& obj);
+};
+
 class HiveTableHandle : public ConnectorTableHandle {
  public:
+  /// If 'aggregates' is not empty the output of the table scan has one column
+  /// per aggregate and the column handles have the columns of the
+  /// aggregates. The aggregates are over the rows that pass the filters.
   HiveTableHandle(
       std::string connectorId,
       const std::string& tableName,
@@ -121,7 +145,8 @@ class HiveTableHandle : public ConnectorTableHandle {
       SubfieldFilters subfieldFilters,
       const core::TypedExprPtr& remainingFilter,
       const RowTypePtr& dataColumns = nullptr,
-      const std::unordered_map<std::string, std::string>& tableParameters = {});
+      const std::unordered_map<std::string, std::string>& tableParameters = {},
+      std::vector<HiveAggregate> aggregates = {});
 
   const std::string& tableName() const {
     return tableName_;
@@ -148,6 +173,10 @@ class HiveTableHandle : public ConnectorTableHandle {
     return tableParameters_;
   }
 
+  const std::vector<HiveAggregate>& aggregates() const {
+    return aggregates_;
+  }
+
   std::string toString() const override;
 
   folly::dynamic serialize() const override;
@@ -165,6 +194,7 @@ class HiveTableHandle : public ConnectorTableHandle {
   const core::TypedExprPtr remainingFilter_;
   const RowTypePtr dataColumns_;
   const std::unordered_map<std::string, std::string> tableParameters_;
+  const std::vector<HiveAggregate> aggregates_;
 };
 
 } // namespace facebook::velox::connector::hive
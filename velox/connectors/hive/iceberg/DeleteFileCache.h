@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <folly/hash/Hash.h>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// A process-wide, memory-bounded cache of the contents of Iceberg delete
+/// files, so that the splits of a table, often read by different drivers or
+/// queries, read each delete file once. 'T' is the in-memory form of the
+/// deletes and has a retainedBytes() method. Entries are keyed by the delete
+/// file path and its size and record count, which tell a rewritten delete
+/// file from its earlier version, and by the base file path for deletes that
+/// apply to one base file. Least recently used entries are evicted when the
+/// total size exceeds the capacity.
+template <typename T>
+class DeleteFileCache {
+ public:
+  struct Key {
+    std::string deleteFilePath;
+    uint64_t deleteFileSize;
+    uint64_t recordCount;
+    // Empty if the deletes apply to all base files.
+    std::string baseFilePath;
+
+    bool operator==(const Key& other) const {
+      return deleteFilePath == other.deleteFilePath &&
+          deleteFileSize == other.deleteFileSize &&
+          recordCount == other.recordCount &&
+          baseFilePath == other.baseFilePath;
+    }
+  };
+
+  struct Stats {
+    int64_t numEntries{0};
+    uint64_t bytes{0};
+    uint64_t numLookups{0};
+    uint64_t numHits{0};
+    uint64_t numEvictions{0};
+  };
+
+  /// Constructs a cache holding up to 'capacity' bytes of deletes.
+  explicit DeleteFileCache(uint64_t capacity) : capacity_(capacity) {}
+
+  /// Returns the process-wide cache or nullptr if deletes are not cached.
+  static DeleteFileCache* getInstance() {
+    return instance();
+  }
+
+  /// Sets the process-wide cache. The caller keeps ownership. nullptr turns
+  /// off caching.
+  static void setInstance(DeleteFileCache* cache) {
+    instance() = cache;
+  }
+
+  /// Returns the deletes for 'key' or nullptr if not cached.
+  std::shared_ptr<const T> get(const Key& key) {
+    std::lock_guard<std::mutex> l(mutex_);
+    ++numLookups_;
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      return nullptr;
+    }
+    ++numHits_;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->value;
+  }
+
+  /// Adds 'value' for 'key'. Replaces an existing entry for the same key.
+  /// Values larger than a quarter of the capacity are not added.
+  void put(const Key& key, std::shared_ptr<const T> value) {
+    VELOX_CHECK_NOT_NULL(value);
+    const uint64_t bytes = value->retainedBytes();
+    if (bytes > capacity_ / 4) {
+      return;
+    }
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      removeLocked(it->second);
+    }
+    while (!lru_.empty() && bytes_ + bytes > capacity_) {
+      removeLocked(std::prev(lru_.end()));
+      ++numEvictions_;
+    }
+    lru_.push_front(CachedEntry{key, std::move(value), bytes});
+    entries_.emplace(key, lru_.begin());
+    bytes_ += bytes;
+  }
+
+  uint64_t capacity() const {
+    return capacity_;
+  }
+
+  /// Drops all entries. Entries in use by readers stay valid.
+  void clear() {
+    std::lock_guard<std::mutex> l(mutex_);
+    entries_.clear();
+    lru_.clear();
+    bytes_ = 0;
+  }
+
+  Stats stats() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    Stats stats;
+    stats.numEntries = entries_.size();
+    stats.bytes = bytes_;
+    stats.numLookups = numLookups_;
+    stats.numHits = numHits_;
+    stats.numEvictions = numEvictions_;
+    return stats;
+  }
+
+ private:
+  struct KeyHasher {
+    size_t operator()(const Key& key) const {
+      return folly::hash::hash_combine(
+          key.deleteFilePath,
+          key.deleteFileSize,
+          key.recordCount,
+          key.baseFilePath);
+    }
+  };
+
+  struct CachedEntry {
+    Key key;
+    std::shared_ptr<const T> value;
+    uint64_t bytes;
+  };
+
+  using EntryList = std::list<CachedEntry>;
+
+  static DeleteFileCache*& instance() {
+    static DeleteFileCache* cache{nullptr};
+    return cache;
+  }
+
+  // Removes 'it' from 'entries_' and 'lru_'. 'mutex_' must be held.
+  void removeLocked(typename EntryList::iterator it) {
+    bytes_ -= it->bytes;
+    entries_.erase(it->key);
+    lru_.erase(it);
+  }
+
+  const uint64_t capacity_;
+
+  mutable std::mutex mutex_;
+  // Entries from most to least recently used.
+  EntryList lru_;
+  folly::F14FastMap<Key, typename EntryList::iterator, KeyHasher> entries_;
+  uint64_t bytes_{0};
+  uint64_t numLookups_{0};
+  uint64_t numHits_{0};
+  uint64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/DeletePositions.h"
+
+#include <algorithm>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+DeletePositions::DeletePositions(std::vector<int64_t> positions) {
+  std::sort(positions.begin(), positions.end());
+  positions.erase(
+      std::unique(positions.begin(), positions.end()), positions.end());
+  size_ = positions.size();
+  auto it = positions.begin();
+  while (it != positions.end()) {
+    VELOX_CHECK_GE(*it, 0, "Negative delete position");
+    const auto key = *it >> kChunkBits;
+    const auto chunkEnd = std::lower_bound(
+        it, positions.end(), static_cast<int64_t>(key + 1) << kChunkBits);
+    Chunk chunk;
+    chunk.key = key;
+    if (chunkEnd - it <= kMaxArraySize) {
+      chunk.array.reserve(chunkEnd - it);
+      for (; it != chunkEnd; ++it) {
+        chunk.array.push_back(*it & (kChunkSize - 1));
+      }
+    } else {
+      chunk.bitmap.resize(bits::nwords(kChunkSize));
+      for (; it != chunkEnd; ++it) {
+        bits::setBit(chunk.bitmap.data(), *it & (kChunkSize - 1));
+      }
+    }
+    chunks_.push_back(std::move(chunk));
+  }
+}
+
+void DeletePositions::apply(
+    int64_t begin,
+    int32_t numRows,
+    uint64_t* deleted) const {
+  const auto end = begin + numRows;
+  auto it = std::lower_bound(
+      chunks_.begin(),
+      chunks_.end(),
+      begin >> kChunkBits,
+      [](const Chunk& chunk, int64_t key) { return chunk.key < key; });
+  for (; it != chunks_.end() && (it->key << kChunkBits) < end; ++it) {
+    if (it->bitmap.empty()) {
+      applyArray(*it, begin, end, deleted);
+    } else {
+      applyBitmap(*it, begin, end, deleted);
+    }
+  }
+}
+
+// static
+void DeletePositions::applyArray(
+    const Chunk& chunk,
+    int64_t begin,
+    int64_t end,
+    uint64_t* deleted) {
+  const auto chunkBegin = chunk.key << kChunkBits;
+  auto it = chunk.array.begin();
+  if (begin > chunkBegin) {
+    it = std::lower_bound(it, chunk.array.end(), begin - chunkBegin);
+  }
+  for (; it != chunk.array.end() && chunkBegin + *it < end; ++it) {
+    bits::setBit(deleted, chunkBegin + *it - begin);
+  }
+}
+
+// static
+void DeletePositions::applyBitmap(
+    const Chunk& chunk,
+    int64_t begin,
+    int64_t end,
+    uint64_t* deleted) {
+  const auto chunkBegin = chunk.key << kChunkBits;
+  // Bits [firstBit, endBit) of the chunk are in [begin, end).
+  const auto firstBit = std::max<int64_t>(begin - chunkBegin, 0);
+  const auto endBit = std::min<int64_t>(end - chunkBegin, kChunkSize);
+  const auto* words = chunk.bitmap.data();
+  for (auto i = firstBit / 64; i * 64 < endBit; ++i) {
+    auto word = words[i];
+    if (i == firstBit / 64) {
+      word &= ~bits::lowMask(firstBit % 64);
+    }
+    if ((i + 1) * 64 > endBit) {
+      word &= bits::lowMask(endBit % 64);
+    }
+    if (word == 0) {
+      continue;
+    }
+    // Bit 0 of 'word' is row 'row' of 'deleted'. 'row' is negative in the
+    // first word if it starts before 'begin', where the bits before 'begin'
+    // are cleared.
+    auto row = chunkBegin + i * 64 - begin;
+    if (row < 0) {
+      word >>= -row;
+      row = 0;
+    }
+    const auto shift = row % 64;
+    deleted[row / 64] |= word << shift;
+    if (shift != 0 && (word >> (64 - shift)) != 0) {
+      deleted[row / 64 + 1] |= word >> (64 - shift);
+    }
+  }
+}
+
+uint64_t DeletePositions::retainedBytes() const {
+  uint64_t bytes = sizeof(*this) + chunks_.capacity() * sizeof(Chunk);
+  for (const auto& chunk : chunks_) {
+    bytes += chunk.array.capacity() * sizeof(uint16_t) +
+        chunk.bitmap.capacity() * sizeof(uint64_t);
+  }
+  return bytes;
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "velox/connectors/hive/iceberg/DeleteFileCache.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// The deleted row positions of one base file from one positional delete file,
+/// compressed like a roaring bitmap. The positions are split into chunks of
+/// 2^16 rows by their high bits. A chunk with few positions keeps the low 16
+/// bits of each in a sorted array. A chunk with more keeps a bitmap, which
+/// takes no more memory than the array would.
+class DeletePositions {
+ public:
+  /// Makes the set of 'positions', which may be in any order and repeat.
+  explicit DeletePositions(std::vector<int64_t> positions);
+
+  /// Sets bit 'i' of 'deleted' if position 'begin' + i is in the set, for i
+  /// in [0, numRows). Leaves the other bits of 'deleted' unchanged.
+  void apply(int64_t begin, int32_t numRows, uint64_t* deleted) const;
+
+  /// Number of distinct positions.
+  uint64_t size() const {
+    return size_;
+  }
+
+  /// Bytes of memory held.
+  uint64_t retainedBytes() const;
+
+ private:
+  static constexpr int32_t kChunkBits = 16;
+  static constexpr int64_t kChunkSize = 1 << kChunkBits;
+  // Chunks with more positions use a bitmap.
+  static constexpr int32_t kMaxArraySize = kChunkSize / 16;
+
+  struct Chunk {
+    // High bits of the positions.
+    int64_t key;
+    // Low bits of the positions, ascending. Empty if 'bitmap' is used.
+    std::vector<uint16_t> array;
+    // kChunkSize bits or empty.
+    std::vector<uint64_t> bitmap;
+  };
+
+  static void applyArray(
+      const Chunk& chunk,
+      int64_t begin,
+      int64_t end,
+      uint64_t* deleted);
+
+  static void applyBitmap(
+      const Chunk& chunk,
+      int64_t begin,
+      int64_t end,
+      uint64_t* deleted);
+
+  // Ascending by key.
+  std::vector<Chunk> chunks_;
+  uint64_t size_{0};
+};
+
+/// Caches the DeletePositions of a positional delete file for a base file.
+using DeletePositionsCache = DeleteFileCache<DeletePositions>;
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
+
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+namespace {
+// Number of delete keys read at a time.
+constexpr uint64_t kReadBatchSize = 10'000;
+} // namespace
+
+EqualityDeleteFileReader::EqualityDeleteFileReader(
+    const IcebergDeleteFile& deleteFile,
+    RowTypePtr keyType,
+    FileHandleFactory* fileHandleFactory,
+    const ConnectorQueryCtx* connectorQueryCtx,
+    folly::Executor* executor,
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    const std::shared_ptr<io::IoStatistics>& ioStats,
+    const std::string& connectorId)
+    : deleteFile_(deleteFile),
+      keyType_(std::move(keyType)),
+      pool_(connectorQueryCtx->memoryPool()) {
+  VELOX_CHECK(deleteFile_.content == FileContent::kEqualityDeletes);
+
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  for (auto i = 0; i < keyType_->size(); ++i) {
+    scanSpec->addField(keyType_->nameOf(i), i);
+  }
+
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
+      connectorId,
+      deleteFile_.filePath,
+      deleteFile_.fileFormat,
+      0,
+      deleteFile_.fileSizeInBytes);
+
+  dwio::common::ReaderOptions deleteReaderOpts(pool_);
+  configureReaderOptions(
+      deleteReaderOpts,
+      hiveConfig,
+      connectorQueryCtx->sessionProperties(),
+      keyType_,
+      deleteSplit);
+
+  auto deleteFileHandle =
+      fileHandleFactory->generate(deleteFile_.filePath).second;
+  auto deleteFileInput = createBufferedInput(
+      *deleteFileHandle,
+      deleteReaderOpts,
+      connectorQueryCtx,
+      ioStats,
+      executor);
+
+  auto deleteReader =
+      dwio::common::getReaderFactory(deleteReaderOpts.getFileFormat())
+          ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+
+  dwio::common::RowReaderOptions deleteRowReaderOpts;
+  configureRowReaderOptions(
+      deleteRowReaderOpts, {}, scanSpec, nullptr, keyType_, deleteSplit);
+  deleteRowReader_ = deleteReader->createRowReader(deleteRowReaderOpts);
+}
+
+std::shared_ptr<EqualityDeletes> EqualityDeleteFileReader::readDeletes() {
+  auto deletes = std::make_shared<EqualityDeletes>(keyType_);
+  VectorPtr output = BaseVector::create(keyType_, 0, pool_);
+  while (deleteRowReader_->next(kReadBatchSize, output) > 0) {
+    if (output->size() > 0) {
+      deletes->addKeys(*output->as<RowVector>());
+    }
+  }
+  deletes->finish();
+  deleteRowReader_.reset();
+  return deletes;
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <memory>
+
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/iceberg/EqualityDeletes.h"
+#include "velox/dwio/common/Reader.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+struct IcebergDeleteFile;
+
+/// Reads the equality columns of an equality delete file.
+class EqualityDeleteFileReader {
+ public:
+  /// 'keyType' has the names and types of the equality columns in the table.
+  EqualityDeleteFileReader(
+      const IcebergDeleteFile& deleteFile,
+      RowTypePtr keyType,
+      FileHandleFactory* fileHandleFactory,
+      const ConnectorQueryCtx* connectorQueryCtx,
+      folly::Executor* executor,
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      const std::shared_ptr<io::IoStatistics>& ioStats,
+      const std::string& connectorId);
+
+  /// Reads the keys of the deleted rows.
+  std::shared_ptr<EqualityDeletes> readDeletes();
+
+ private:
+  const IcebergDeleteFile& deleteFile_;
+  const RowTypePtr keyType_;
+  memory::MemoryPool* const pool_;
+
+  std::unique_ptr<dwio::common::RowReader> deleteRowReader_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
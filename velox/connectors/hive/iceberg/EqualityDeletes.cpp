@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeletes.h"
+
+#include <algorithm>
+
+namespace facebook::velox::connector::hive::iceberg {
+
+namespace {
+// Approximate bytes used per key by the filter or the hash set on top of the
+// key.
+constexpr uint64_t kBytesPerKey = 32;
+
+template <TypeKind kind>
+void appendValue(
+    const DecodedVector& decoded,
+    vector_size_t row,
+    std::string& key) {
+  using T = typename TypeTraits<kind>::NativeType;
+  const auto value = decoded.valueAt<T>(row);
+  if constexpr (std::is_same_v<T, StringView>) {
+    const uint32_t size = value.size();
+    key.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    key.append(value.data(), size);
+  } else {
+    key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+}
+
+int64_t integerValueAt(
+    const DecodedVector& decoded,
+    TypeKind kind,
+    vector_size_t row) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return decoded.valueAt<int8_t>(row);
+    case TypeKind::SMALLINT:
+      return decoded.valueAt<int16_t>(row);
+    case TypeKind::INTEGER:
+      return decoded.valueAt<int32_t>(row);
+    case TypeKind::BIGINT:
+      return decoded.valueAt<int64_t>(row);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+} // namespace
+
+EqualityDeletes::EqualityDeletes(RowTypePtr keyType)
+    : keyType_(std::move(keyType)) {
+  VELOX_CHECK_GT(keyType_->size(), 0, "Equality deletes need a key column");
+  for (const auto& type : keyType_->children()) {
+    if (!type->isPrimitiveType()) {
+      VELOX_NYI(
+          "Equality delete column of type {} is not supported",
+          type->toString());
+    }
+  }
+}
+
+bool EqualityDeletes::useFilter() const {
+  if (keyType_->size() != 1) {
+    return false;
+  }
+  const auto& type = keyType_->childAt(0);
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      // Filters on decimals test the unscaled values, which the filters of
+      // the query do not do.
+      return !type->isDecimal();
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void EqualityDeletes::addKeys(const RowVector& keys) {
+  VELOX_CHECK(keys.type()->equivalent(*keyType_));
+  const auto numRows = keys.size();
+  std::vector<DecodedVector> decoded(keyType_->size());
+  for (auto i = 0; i < keyType_->size(); ++i) {
+    decoded[i].decode(*keys.childAt(i));
+  }
+  numKeys_ += numRows;
+
+  if (!useFilter()) {
+    std::string key;
+    for (vector_size_t row = 0; row < numRows; ++row) {
+      key.clear();
+      appendKey(decoded, row, key);
+      if (keys_.insert(key).second) {
+        retainedBytes_ += key.size() + kBytesPerKey;
+      }
+    }
+    return;
+  }
+
+  const auto kind = keyType_->childAt(0)->kind();
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    if (decoded[0].isNullAt(row)) {
+      hasNull_ = true;
+    } else if (kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY) {
+      const auto value = decoded[0].valueAt<StringView>(row);
+      strings_.emplace_back(value.data(), value.size());
+      retainedBytes_ += strings_.back().size() + kBytesPerKey;
+    } else {
+      longs_.push_back(integerValueAt(decoded[0], kind, row));
+      retainedBytes_ += sizeof(int64_t) + kBytesPerKey;
+    }
+  }
+}
+
+void EqualityDeletes::finish() {
+  if (!useFilter() || empty()) {
+    return;
+  }
+  // Null keys delete the rows with nulls.
+  const bool nullAllowed = !hasNull_;
+  const auto kind = keyType_->childAt(0)->kind();
+  if (kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY) {
+    std::sort(strings_.begin(), strings_.end());
+    strings_.erase(
+        std::unique(strings_.begin(), strings_.end()), strings_.end());
+    if (strings_.empty()) {
+      filter_ = std::make_unique<common::IsNotNull>();
+    } else {
+      filter_ =
+          std::make_unique<common::NegatedBytesValues>(strings_, nullAllowed);
+    }
+  } else {
+    // The filters expect distinct values.
+    std::sort(longs_.begin(), longs_.end());
+    longs_.erase(std::unique(longs_.begin(), longs_.end()), longs_.end());
+    filter_ = common::createNegatedBigintValues(longs_, nullAllowed);
+  }
+  strings_ = {};
+  longs_ = {};
+}
+
+bool EqualityDeletes::contains(
+    const std::vector<DecodedVector>& keys,
+    vector_size_t row,
+    std::string& buffer) const {
+  VELOX_DCHECK(filter_ == nullptr);
+  buffer.clear();
+  appendKey(keys, row, buffer);
+  return keys_.count(buffer) > 0;
+}
+
+// static
+void EqualityDeletes::appendKey(
+    const std::vector<DecodedVector>& keys,
+    vector_size_t row,
+    std::string& key) {
+  for (const auto& decoded : keys) {
+    if (decoded.isNullAt(row)) {
+      key.push_back(0);
+      continue;
+    }
+    key.push_back(1);
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        appendValue, decoded.base()->typeKind(), decoded, row, key);
+  }
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
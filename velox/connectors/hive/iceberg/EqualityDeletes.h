@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Set.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "velox/connectors/hive/iceberg/DeleteFileCache.h"
+#include "velox/type/Filter.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// The keys of the rows deleted by an equality delete file. A row of a base
+/// file is deleted if its values of the equality columns equal the values of
+/// some row of the delete file, where null equals null. Keys of one integer
+/// or string column become a negated values filter, which the readers push
+/// down like the filters of the query. Other keys are kept in a hash set and
+/// probed with the rows read.
+class EqualityDeletes {
+ public:
+  /// 'keyType' has the equality columns, which must be of primitive types.
+  explicit EqualityDeletes(RowTypePtr keyType);
+
+  /// Adds the rows of 'keys', which is of 'keyType'.
+  void addKeys(const RowVector& keys);
+
+  /// Makes the filter or the hash set after all keys are added.
+  void finish();
+
+  const RowTypePtr& keyType() const {
+    return keyType_;
+  }
+
+  /// True if no keys were added.
+  bool empty() const {
+    return numKeys_ == 0;
+  }
+
+  /// Returns the filter that rejects the deleted values of a single key
+  /// column, or nullptr if the keys are probed with contains().
+  const common::Filter* filter() const {
+    return filter_.get();
+  }
+
+  /// Returns true if row 'row' of 'keys' is deleted. 'keys' are the decoded
+  /// columns of 'keyType'. 'buffer' is scratch for the encoded key.
+  bool contains(
+      const std::vector<DecodedVector>& keys,
+      vector_size_t row,
+      std::string& buffer) const;
+
+  /// Approximate bytes of memory held.
+  uint64_t retainedBytes() const {
+    return retainedBytes_;
+  }
+
+ private:
+  // True if the keys of 'keyType_' can be a filter.
+  bool useFilter() const;
+
+  // Appends the encoding of the key of row 'row' of 'keys' to 'key'. Equal
+  // keys have equal encodings.
+  static void appendKey(
+      const std::vector<DecodedVector>& keys,
+      vector_size_t row,
+      std::string& key);
+
+  const RowTypePtr keyType_;
+  uint64_t numKeys_{0};
+  uint64_t retainedBytes_{0};
+
+  // Values of a single key column before finish() makes 'filter_'.
+  std::vector<int64_t> longs_;
+  std::vector<std::string> strings_;
+  bool hasNull_{false};
+  std::unique_ptr<common::Filter> filter_;
+
+  // Encoded keys if not using 'filter_'.
+  folly::F14FastSet<std::string> keys_;
+};
+
+/// Caches the EqualityDeletes of an equality delete file.
+using EqualityDeletesCache = DeleteFileCache<EqualityDeletes>;
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -25,6 +25,9 @@ struct IcebergDeleteFile;
 
 struct HiveIcebergSplit : public connector::hive::HiveConnectorSplit {
   std::vector<IcebergDeleteFile> deleteFiles;
+  // The names of the top level columns of the table by their Iceberg field
+  // ids. Resolves the equality field ids of the equality delete files.
+  std::unordered_map<int32_t, std::string> columnNamesByFieldId;
 
   HiveIcebergSplit(
       const std::string& connectorId,
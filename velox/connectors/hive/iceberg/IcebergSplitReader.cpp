@@ -16,6 +16,7 @@
 
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
 #include "velox/dwio/common/BufferUtil.h"
@@ -53,8 +54,20 @@ IcebergSplitReader::IcebergSplitReader(
 void IcebergSplitReader::prepareSplit(
     std::shared_ptr<common::MetadataFilter> metadataFilter,
     dwio::common::RuntimeStatistics& runtimeStats) {
+  if (checkIfSplitIsPruned(runtimeStats)) {
+    return;
+  }
+
   createReader();
 
+  std::shared_ptr<const HiveIcebergSplit> icebergSplit =
+      std::dynamic_pointer_cast<const HiveIcebergSplit>(hiveSplit_);
+  // The filters made from equality deletes may skip the whole split, so they
+  // are added before testing the filters.
+  if (!emptySplit_) {
+    prepareEqualityDeletes(*icebergSplit);
+  }
+
   if (checkIfSplitIsEmpty(runtimeStats)) {
     VELOX_CHECK(emptySplit_);
     return;
@@ -62,64 +75,301 @@ void IcebergSplitReader::prepareSplit(
 
   createRowReader(metadataFilter);
 
-  std::shared_ptr<const HiveIcebergSplit> icebergSplit =
-      std::dynamic_pointer_cast<const HiveIcebergSplit>(hiveSplit_);
   baseReadOffset_ = 0;
   splitOffset_ = baseRowReader_->nextRowNumber();
-  positionalDeleteFileReaders_.clear();
+  deletePositions_.clear();
 
   const auto& deleteFiles = icebergSplit->deleteFiles;
   for (const auto& deleteFile : deleteFiles) {
     if (deleteFile.content == FileContent::kPositionalDeletes) {
       if (deleteFile.recordCount > 0) {
-        positionalDeleteFileReaders_.push_back(
-            std::make_unique<PositionalDeleteFileReader>(
-                deleteFile,
-                hiveSplit_->filePath,
-                fileHandleFactory_,
-                connectorQueryCtx_,
-                executor_,
-                hiveConfig_,
-                ioStats_,
-                runtimeStats,
-                splitOffset_,
-                hiveSplit_->connectorId));
+        auto positions = loadDeletePositions(deleteFile, runtimeStats);
+        if (positions->size() > 0) {
+          deletePositions_.push_back(std::move(positions));
+        }
       }
-    } else {
+    } else if (deleteFile.content != FileContent::kEqualityDeletes) {
       VELOX_NYI();
     }
   }
 }
 
+IcebergSplitReader::~IcebergSplitReader() {
+  // The scan spec is used by the next splits, which may have other deletes.
+  for (auto& [spec, filter] : replacedFilters_) {
+    spec->setFilter(std::move(filter));
+  }
+  for (auto* spec : equalityOnlyColumns_) {
+    spec->setProjectOut(false);
+    spec->setChannel(common::ScanSpec::kNoChannel);
+  }
+  if (!replacedFilters_.empty() || !equalityOnlyColumns_.empty()) {
+    scanSpec_->resetCachedValues(true);
+  }
+}
+
+bool IcebergSplitReader::statisticsCoverSplit() const {
+  return deletePositions_.empty() && equalityDeletes_.empty() &&
+      replacedFilters_.empty() && SplitReader::statisticsCoverSplit();
+}
+
+void IcebergSplitReader::onDynamicFilter(
+    common::ScanSpec& fieldSpec,
+    const common::Filter& filter) {
+  // Only the filters made from the deletes are dropped when the split is done.
+  for (auto& [spec, replaced] : replacedFilters_) {
+    if (spec == &fieldSpec) {
+      replaced = replaced ? replaced->mergeWith(&filter) : filter.clone();
+      return;
+    }
+  }
+}
+
+void IcebergSplitReader::prepareEqualityDeletes(const HiveIcebergSplit& split) {
+  equalityDeletes_.clear();
+  for (const auto& deleteFile : split.deleteFiles) {
+    if (deleteFile.content != FileContent::kEqualityDeletes ||
+        deleteFile.recordCount == 0) {
+      continue;
+    }
+    auto deletes = loadEqualityDeletes(split, deleteFile);
+    if (deletes->empty()) {
+      continue;
+    }
+    const auto& keyType = deletes->keyType();
+    if (auto* filter = deletes->filter()) {
+      auto* spec =
+          scanSpec_->getOrCreateChild(common::Subfield(keyType->nameOf(0)));
+      auto it = std::find_if(
+          replacedFilters_.begin(),
+          replacedFilters_.end(),
+          [&](const auto& replaced) { return replaced.first == spec; });
+      if (it == replacedFilters_.end()) {
+        replacedFilters_.emplace_back(
+            spec, spec->filter() ? spec->filter()->clone() : nullptr);
+      }
+      spec->addFilter(*filter);
+      continue;
+    }
+    std::vector<column_index_t> channels;
+    for (auto i = 0; i < keyType->size(); ++i) {
+      channels.push_back(
+          equalityChannel(keyType->nameOf(i), keyType->childAt(i)));
+    }
+    equalityDeletes_.push_back({std::move(deletes), std::move(channels)});
+  }
+  if (!replacedFilters_.empty() || !equalityOnlyColumns_.empty()) {
+    scanSpec_->resetCachedValues(true);
+  }
+}
+
+column_index_t IcebergSplitReader::equalityChannel(
+    const std::string& name,
+    const TypePtr& type) {
+  if (auto channel = readerOutputType_->getChildIdxIfExists(name)) {
+    return *channel;
+  }
+  if (readType_ == nullptr) {
+    readType_ = readerOutputType_;
+  } else if (auto channel = readType_->getChildIdxIfExists(name)) {
+    return *channel;
+  }
+  const column_index_t channel = readType_->size();
+  auto* spec = scanSpec_->getOrCreateChild(common::Subfield(name));
+  VELOX_CHECK(!spec->projectOut());
+  spec->setProjectOut(true);
+  spec->setChannel(channel);
+  equalityOnlyColumns_.push_back(spec);
+  auto names = readType_->names();
+  auto types = readType_->children();
+  names.push_back(name);
+  types.push_back(type);
+  readType_ = ROW(std::move(names), std::move(types));
+  return channel;
+}
+
+RowTypePtr IcebergSplitReader::equalityKeyType(
+    const HiveIcebergSplit& split,
+    const IcebergDeleteFile& deleteFile) const {
+  const auto& tableSchema = baseReaderOpts_.getFileSchema()
+      ? baseReaderOpts_.getFileSchema()
+      : baseReader_->rowType();
+  VELOX_USER_CHECK(
+      !deleteFile.equalityFieldIds.empty(),
+      "Equality delete file has no equality field ids: {}",
+      deleteFile.filePath);
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (auto id : deleteFile.equalityFieldIds) {
+    auto it = split.columnNamesByFieldId.find(id);
+    VELOX_USER_CHECK(
+        it != split.columnNamesByFieldId.end(),
+        "No column name for equality field id {} of delete file {}",
+        id,
+        deleteFile.filePath);
+    auto type = tableSchema->findChild(it->second);
+    VELOX_USER_CHECK_NOT_NULL(
+        type,
+        "Equality field id {} names column {} that is not in the table",
+        id,
+        it->second);
+    names.push_back(it->second);
+    types.push_back(std::move(type));
+  }
+  return ROW(std::move(names), std::move(types));
+}
+
+std::shared_ptr<const EqualityDeletes> IcebergSplitReader::loadEqualityDeletes(
+    const HiveIcebergSplit& split,
+    const IcebergDeleteFile& deleteFile) {
+  auto* cache = EqualityDeletesCache::getInstance();
+  // Equality deletes apply to all base files.
+  EqualityDeletesCache::Key key{
+      deleteFile.filePath,
+      deleteFile.fileSizeInBytes,
+      deleteFile.recordCount,
+      ""};
+  if (cache != nullptr) {
+    if (auto deletes = cache->get(key)) {
+      return deletes;
+    }
+  }
+  EqualityDeleteFileReader reader(
+      deleteFile,
+      equalityKeyType(split, deleteFile),
+      fileHandleFactory_,
+      connectorQueryCtx_,
+      executor_,
+      hiveConfig_,
+      ioStats_,
+      hiveSplit_->connectorId);
+  std::shared_ptr<const EqualityDeletes> deletes = reader.readDeletes();
+  if (cache != nullptr) {
+    cache->put(key, deletes);
+  }
+  return deletes;
+}
+
+void IcebergSplitReader::removeEqualityDeletes(VectorPtr& output) {
+  auto* rowVector = output->asUnchecked<RowVector>();
+  const auto numRows = rowVector->size();
+  SelectivityVector passed(numRows);
+  std::string buffer;
+  for (const auto& [deletes, channels] : equalityDeletes_) {
+    std::vector<DecodedVector> keys(channels.size());
+    for (auto i = 0; i < channels.size(); ++i) {
+      keys[i].decode(*rowVector->childAt(channels[i]));
+    }
+    for (vector_size_t row = 0; row < numRows; ++row) {
+      if (passed.isValid(row) && deletes->contains(keys, row, buffer)) {
+        passed.setValid(row, false);
+      }
+    }
+    passed.updateBounds();
+  }
+  const auto numPassed = passed.countSelected();
+  if (numPassed == numRows) {
+    return;
+  }
+
+  auto indices = allocateIndices(numPassed, pool_);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numIndices = 0;
+  passed.applyToSelected(
+      [&](vector_size_t row) { rawIndices[numIndices++] = row; });
+  std::vector<VectorPtr> children;
+  children.reserve(rowVector->childrenSize());
+  for (auto& child : rowVector->children()) {
+    children.push_back(BaseVector::wrapInDictionary(
+        nullptr, indices, numPassed, BaseVector::loadedVectorShared(child)));
+  }
+  output = std::make_shared<RowVector>(
+      pool_, rowVector->type(), nullptr, numPassed, std::move(children));
+}
+
+std::shared_ptr<const DeletePositions> IcebergSplitReader::loadDeletePositions(
+    const IcebergDeleteFile& deleteFile,
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  auto* cache = DeletePositionsCache::getInstance();
+  DeletePositionsCache::Key key{
+      deleteFile.filePath,
+      deleteFile.fileSizeInBytes,
+      deleteFile.recordCount,
+      hiveSplit_->filePath};
+  if (cache != nullptr) {
+    if (auto positions = cache->get(key)) {
+      return positions;
+    }
+  }
+  PositionalDeleteFileReader reader(
+      deleteFile,
+      hiveSplit_->filePath,
+      fileHandleFactory_,
+      connectorQueryCtx_,
+      executor_,
+      hiveConfig_,
+      ioStats_,
+      runtimeStats,
+      hiveSplit_->connectorId);
+  auto positions =
+      std::make_shared<const DeletePositions>(reader.readPositions());
+  if (cache != nullptr) {
+    cache->put(key, positions);
+  }
+  return positions;
+}
+
 uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
   Mutation mutation;
   mutation.randomSkip = baseReaderOpts_.randomSkip().get();
   mutation.deletedRows = nullptr;
 
-  if (!positionalDeleteFileReaders_.empty()) {
-    auto numBytes = bits::nbytes(size);
+  if (!deletePositions_.empty()) {
+    // DeletePositions::apply() sets the bits a word at a time.
+    auto numBytes = bits::nwords(size) * sizeof(uint64_t);
     dwio::common::ensureCapacity<int8_t>(
         deleteBitmap_, numBytes, connectorQueryCtx_->memoryPool());
     std::memset((void*)deleteBitmap_->as<int8_t>(), 0L, numBytes);
 
-    for (auto iter = positionalDeleteFileReaders_.begin();
-         iter != positionalDeleteFileReaders_.end();) {
-      (*iter)->readDeletePositions(
-          baseReadOffset_, size, deleteBitmap_->asMutable<int8_t>());
-      if ((*iter)->endOfFile()) {
-        iter = positionalDeleteFileReaders_.erase(iter);
-      } else {
-        ++iter;
-      }
+    for (const auto& positions : deletePositions_) {
+      positions->apply(
+          splitOffset_ + baseReadOffset_,
+          size,
+          deleteBitmap_->asMutable<uint64_t>());
     }
 
     deleteBitmap_->setSize(numBytes);
     mutation.deletedRows = deleteBitmap_->as<uint64_t>();
   }
 
-  auto rowsScanned = baseRowReader_->next(size, output, &mutation);
-  baseReadOffset_ += rowsScanned;
+  if (equalityOnlyColumns_.empty()) {
+    auto rowsScanned = baseRowReader_->next(size, output, &mutation);
+    baseReadOffset_ += rowsScanned;
+    if (!equalityDeletes_.empty() && output->size() > 0) {
+      removeEqualityDeletes(output);
+    }
+    return rowsScanned;
+  }
 
+  if (!readOutput_) {
+    readOutput_ = BaseVector::create(readType_, 0, pool_);
+  }
+  auto rowsScanned = baseRowReader_->next(size, readOutput_, &mutation);
+  baseReadOffset_ += rowsScanned;
+  if (readOutput_->size() > 0) {
+    removeEqualityDeletes(readOutput_);
+  }
+  // Drops the equality columns that the query does not read.
+  auto* rowVector = readOutput_->asUnchecked<RowVector>();
+  std::vector<VectorPtr> children(
+      rowVector->children().begin(),
+      rowVector->children().begin() + readerOutputType_->size());
+  output = std::make_shared<RowVector>(
+      pool_,
+      readerOutputType_,
+      nullptr,
+      rowVector->size(),
+      std::move(children));
   return rowsScanned;
 }
 
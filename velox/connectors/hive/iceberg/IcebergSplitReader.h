@@ -18,10 +18,13 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/SplitReader.h"
+#include "velox/connectors/hive/iceberg/DeletePositions.h"
+#include "velox/connectors/hive/iceberg/EqualityDeletes.h"
 #include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
 
+struct HiveIcebergSplit;
 struct IcebergDeleteFile;
 
 class IcebergSplitReader : public SplitReader {
@@ -39,7 +42,7 @@ class IcebergSplitReader : public SplitReader {
       folly::Executor* executor,
       const std::shared_ptr<common::ScanSpec>& scanSpec);
 
-  ~IcebergSplitReader() override = default;
+  ~IcebergSplitReader() override;
 
   void prepareSplit(
       std::shared_ptr<common::MetadataFilter> metadataFilter,
@@ -47,6 +50,12 @@ class IcebergSplitReader : public SplitReader {
 
   uint64_t next(uint64_t size, VectorPtr& output) override;
 
+  bool statisticsCoverSplit() const override;
+
+  void onDynamicFilter(
+      common::ScanSpec& fieldSpec,
+      const common::Filter& filter) override;
+
  private:
   // The read offset to the beginning of the split in number of rows for the
   // current batch for the base data file
@@ -55,8 +64,66 @@ class IcebergSplitReader : public SplitReader {
   // The file position for the first row in the split
   uint64_t splitOffset_;
 
-  std::list<std::unique_ptr<PositionalDeleteFileReader>>
-      positionalDeleteFileReaders_;
+  // Reads the positions deleted from the base file by 'deleteFile', or gets
+  // them from the DeletePositionsCache if one is set.
+  std::shared_ptr<const DeletePositions> loadDeletePositions(
+      const IcebergDeleteFile& deleteFile,
+      dwio::common::RuntimeStatistics& runtimeStats);
+
+  // The positions deleted by each positional delete file of the split.
+  std::vector<std::shared_ptr<const DeletePositions>> deletePositions_;
+
+  // Loads the equality deletes of the split. Pushes the ones that are
+  // filters down into 'scanSpec_' and keeps the others in
+  // 'equalityDeletes_'.
+  void prepareEqualityDeletes(const HiveIcebergSplit& split);
+
+  // Returns the channel of the equality column 'name' in the rows read. Adds
+  // the column to 'scanSpec_' after the output columns if the query does not
+  // read it.
+  column_index_t equalityChannel(const std::string& name, const TypePtr& type);
+
+  // Returns the names and types of the equality columns of 'deleteFile', a
+  // delete file of 'split'.
+  RowTypePtr equalityKeyType(
+      const HiveIcebergSplit& split,
+      const IcebergDeleteFile& deleteFile) const;
+
+  // Reads the keys deleted by 'deleteFile', or gets them from the
+  // EqualityDeletesCache if one is set.
+  std::shared_ptr<const EqualityDeletes> loadEqualityDeletes(
+      const HiveIcebergSplit& split,
+      const IcebergDeleteFile& deleteFile);
+
+  // Removes the rows of 'output' that are deleted by 'equalityDeletes_'.
+  void removeEqualityDeletes(VectorPtr& output);
+
+  struct EqualityDeletesToProbe {
+    std::shared_ptr<const EqualityDeletes> deletes;
+    // The channels of the equality columns in the rows read.
+    std::vector<column_index_t> channels;
+  };
+
+  // Equality deletes whose keys are probed with the rows read.
+  std::vector<EqualityDeletesToProbe> equalityDeletes_;
+
+  // The filters of 'scanSpec_' before adding the equality deletes, restored
+  // when the split is done. The dynamic filters added during the split are
+  // merged into these, so that they apply to the next splits.
+  std::vector<std::pair<common::ScanSpec*, std::unique_ptr<common::Filter>>>
+      replacedFilters_;
+
+  // The children of 'scanSpec_' for the equality columns that the query does
+  // not read. These are read after the output columns and dropped after
+  // removing the deleted rows.
+  std::vector<common::ScanSpec*> equalityOnlyColumns_;
+
+  // The type of the rows read if 'equalityOnlyColumns_' is not empty.
+  RowTypePtr readType_;
+
+  // The rows read if 'equalityOnlyColumns_' is not empty.
+  VectorPtr readOutput_;
+
   BufferPtr deleteBitmap_;
 };
 } // namespace facebook::velox::connector::hive::iceberg
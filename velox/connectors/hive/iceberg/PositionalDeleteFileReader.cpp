@@ -24,6 +24,11 @@
 
 namespace facebook::velox::connector::hive::iceberg {
 
+namespace {
+// Number of delete positions read at a time.
+constexpr uint64_t kReadBatchSize = 10'000;
+} // namespace
+
 PositionalDeleteFileReader::PositionalDeleteFileReader(
     const IcebergDeleteFile& deleteFile,
     const std::string& baseFilePath,
@@ -33,7 +38,6 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
     const std::shared_ptr<const HiveConfig>& hiveConfig,
     const std::shared_ptr<io::IoStatistics>& ioStats,
     dwio::common::RuntimeStatistics& runtimeStats,
-    uint64_t splitOffset,
     const std::string& connectorId)
     : deleteFile_(deleteFile),
       baseFilePath_(baseFilePath),
@@ -44,12 +48,8 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
       pool_(connectorQueryCtx->memoryPool()),
       filePathColumn_(IcebergMetadataColumn::icebergDeleteFilePathColumn()),
       posColumn_(IcebergMetadataColumn::icebergDeletePosColumn()),
-      splitOffset_(splitOffset),
       deleteSplit_(nullptr),
-      deleteRowReader_(nullptr),
-      deletePositionsOutput_(nullptr),
-      deletePositionsOffset_(0),
-      endOfFile_(false) {
+      deleteRowReader_(nullptr) {
   VELOX_CHECK(deleteFile_.content == FileContent::kPositionalDeletes);
 
   if (deleteFile_.recordCount == 0) {
@@ -134,109 +134,35 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
   deleteRowReader_ = deleteReader->createRowReader(deleteRowReaderOpts);
 }
 
-void PositionalDeleteFileReader::readDeletePositions(
-    uint64_t baseReadOffset,
-    uint64_t size,
-    int8_t* deleteBitmap) {
-  // We are going to read to the row number up to the end of the batch. For the
-  // same base file, the deleted rows are in ascending order in the same delete
-  // file
-  int64_t rowNumberUpperBound = splitOffset_ + baseReadOffset + size;
-
-  // Finish unused delete positions from last batch
-  if (deletePositionsOutput_ &&
-      deletePositionsOffset_ < deletePositionsOutput_->size()) {
-    updateDeleteBitmap(
-        std::dynamic_pointer_cast<RowVector>(deletePositionsOutput_)
-            ->childAt(0),
-        baseReadOffset,
-        rowNumberUpperBound,
-        deleteBitmap);
-
-    if (readFinishedForBatch(rowNumberUpperBound)) {
-      return;
-    }
-  }
-
+std::vector<int64_t> PositionalDeleteFileReader::readPositions() {
+  std::vector<int64_t> positions;
   if (!deleteRowReader_ || !deleteSplit_) {
-    return;
+    return positions;
   }
 
-  // Read the new delete positions for this batch into deletePositionsOutput_
-  // and update the delete bitmap
-
-  auto outputType = posColumn_->type;
-
   RowTypePtr outputRowType = ROW({posColumn_->name}, {posColumn_->type});
-  if (!deletePositionsOutput_) {
-    deletePositionsOutput_ = BaseVector::create(outputRowType, 0, pool_);
-  }
-
-  while (!readFinishedForBatch(rowNumberUpperBound)) {
-    auto rowsScanned = deleteRowReader_->next(size, deletePositionsOutput_);
-    if (rowsScanned > 0) {
-      VELOX_CHECK(
-          !deletePositionsOutput_->mayHaveNulls(),
-          "Iceberg delete file pos column cannot have nulls");
-
-      auto numDeletedRows = deletePositionsOutput_->size();
-      if (numDeletedRows > 0) {
-        deletePositionsOutput_->loadedVector();
-        deletePositionsOffset_ = 0;
-
-        updateDeleteBitmap(
-            std::dynamic_pointer_cast<RowVector>(deletePositionsOutput_)
-                ->childAt(0),
-            baseReadOffset,
-            rowNumberUpperBound,
-            deleteBitmap);
-      }
-    } else {
-      // Reaching the end of the file
-      endOfFile_ = true;
-      deleteSplit_.reset();
-      return;
+  VectorPtr output = BaseVector::create(outputRowType, 0, pool_);
+  positions.reserve(deleteFile_.recordCount);
+  while (deleteRowReader_->next(kReadBatchSize, output) > 0) {
+    const auto numDeletedRows = output->size();
+    if (numDeletedRows == 0) {
+      continue;
     }
+    auto* positionsVector = std::dynamic_pointer_cast<RowVector>(output)
+                                ->childAt(0)
+                                ->loadedVector()
+                                ->as<FlatVector<int64_t>>();
+    VELOX_CHECK_NOT_NULL(positionsVector);
+    VELOX_CHECK(
+        !positionsVector->mayHaveNulls(),
+        "Iceberg delete file pos column cannot have nulls");
+    const auto* rawPositions = positionsVector->rawValues();
+    positions.insert(
+        positions.end(), rawPositions, rawPositions + numDeletedRows);
   }
-}
-
-bool PositionalDeleteFileReader::endOfFile() {
-  return endOfFile_;
-}
-
-void PositionalDeleteFileReader::updateDeleteBitmap(
-    VectorPtr deletePositionsVector,
-    uint64_t baseReadOffset,
-    int64_t rowNumberUpperBound,
-    int8_t* deleteBitmap) {
-  // Convert the positions in file into positions relative to the start of the
-  // split.
-  const int64_t* deletePositions =
-      deletePositionsVector->as<FlatVector<int64_t>>()->rawValues();
-  int64_t offset = baseReadOffset + splitOffset_;
-  while (deletePositionsOffset_ < deletePositionsVector->size() &&
-         deletePositions[deletePositionsOffset_] < rowNumberUpperBound) {
-    bits::setBit(
-        deleteBitmap, deletePositions[deletePositionsOffset_] - offset);
-    deletePositionsOffset_++;
-  }
-}
-
-bool PositionalDeleteFileReader::readFinishedForBatch(
-    int64_t rowNumberUpperBound) {
-  VELOX_CHECK_NOT_NULL(deletePositionsOutput_);
-
-  auto deletePositionsVector =
-      std::dynamic_pointer_cast<RowVector>(deletePositionsOutput_)->childAt(0);
-  const int64_t* deletePositions =
-      deletePositionsVector->as<FlatVector<int64_t>>()->rawValues();
-
-  if (deletePositionsOutput_->size() != 0 &&
-      deletePositionsOffset_ < deletePositionsVector->size() &&
-      deletePositions[deletePositionsOffset_] >= rowNumberUpperBound) {
-    return true;
-  }
-  return false;
+  deleteSplit_.reset();
+  deleteRowReader_.reset();
+  return positions;
 }
 
 } // namespace facebook::velox::connector::hive::iceberg
@@ -44,25 +44,13 @@ class PositionalDeleteFileReader {
       const std::shared_ptr<const HiveConfig>& hiveConfig,
       const std::shared_ptr<io::IoStatistics>& ioStats,
       dwio::common::RuntimeStatistics& runtimeStats,
-      uint64_t splitOffset,
       const std::string& connectorId);
 
-  void readDeletePositions(
-      uint64_t baseReadOffset,
-      uint64_t size,
-      int8_t* deleteBitmap);
-
-  bool endOfFile();
+  /// Reads the positions deleted from the base file. Returns an empty vector
+  /// if the delete file has no positions for the base file.
+  std::vector<int64_t> readPositions();
 
  private:
-  void updateDeleteBitmap(
-      VectorPtr deletePositionsVector,
-      uint64_t baseReadOffset,
-      int64_t rowNumberUpperBound,
-      int8_t* deleteBitmap);
-
-  bool readFinishedForBatch(int64_t rowNumberUpperBound);
-
   const IcebergDeleteFile& deleteFile_;
   const std::string& baseFilePath_;
   FileHandleFactory* const fileHandleFactory_;
@@ -73,13 +61,9 @@ class PositionalDeleteFileReader {
 
   std::shared_ptr<IcebergMetadataColumn> filePathColumn_;
   std::shared_ptr<IcebergMetadataColumn> posColumn_;
-  uint64_t splitOffset_;
 
   std::shared_ptr<HiveConnectorSplit> deleteSplit_;
   std::unique_ptr<dwio::common::RowReader> deleteRowReader_;
-  VectorPtr deletePositionsOutput_;
-  uint64_t deletePositionsOffset_;
-  bool endOfFile_;
 };
 
 } // namespace facebook::velox::connector::hive::iceberg
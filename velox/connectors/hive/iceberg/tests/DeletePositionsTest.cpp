@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/DeletePositions.h"
+
+#include <fmt/format.h>
+#include <folly/Random.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+namespace {
+
+// Checks that apply() over [begin, begin + numRows) sets the bits of the
+// positions in 'expected' and leaves the other bits as they were.
+void checkApply(
+    const DeletePositions& positions,
+    const std::set<int64_t>& expected,
+    int64_t begin,
+    int32_t numRows) {
+  // One extra word to check that apply() does not write past 'numRows'.
+  std::vector<uint64_t> deleted(bits::nwords(numRows) + 1, 0);
+  positions.apply(begin, numRows, deleted.data());
+  for (auto i = 0; i < numRows; ++i) {
+    ASSERT_EQ(bits::isBitSet(deleted.data(), i), expected.count(begin + i) > 0)
+        << "begin " << begin << " row " << i;
+  }
+  const int32_t numBits = deleted.size() * 64;
+  for (auto i = numRows; i < numBits; ++i) {
+    ASSERT_FALSE(bits::isBitSet(deleted.data(), i));
+  }
+
+  // Bits already set stay set.
+  std::fill(deleted.begin(), deleted.end(), ~0ULL);
+  positions.apply(begin, numRows, deleted.data());
+  ASSERT_TRUE(bits::isAllSet(deleted.data(), 0, numBits));
+}
+
+void checkAllRanges(const std::vector<int64_t>& input, int64_t maxPosition) {
+  DeletePositions positions(input);
+  std::set<int64_t> expected(input.begin(), input.end());
+  ASSERT_EQ(positions.size(), expected.size());
+  std::mt19937 gen{1};
+  for (auto i = 0; i < 100; ++i) {
+    const int64_t begin = folly::Random::rand64(0, maxPosition, gen);
+    const int32_t numRows = folly::Random::rand32(1, 20'000, gen);
+    checkApply(positions, expected, begin, numRows);
+  }
+  // Batches that start and end on chunk and word boundaries.
+  checkApply(positions, expected, 0, 1 << 16);
+  checkApply(positions, expected, 1 << 16, 1 << 16);
+  checkApply(positions, expected, 64, 128);
+  checkApply(positions, expected, 63, 2);
+}
+
+TEST(DeletePositionsTest, sparse) {
+  std::vector<int64_t> input;
+  std::mt19937 gen{0};
+  for (auto i = 0; i < 1'000; ++i) {
+    input.push_back(folly::Random::rand64(0, 300'000, gen));
+  }
+  checkAllRanges(input, 300'000);
+}
+
+TEST(DeletePositionsTest, dense) {
+  // Most chunks have too many positions for an array.
+  std::vector<int64_t> input;
+  std::mt19937 gen{0};
+  for (int64_t i = 0; i < 300'000; ++i) {
+    if (folly::Random::oneIn(3, gen) || (i >= 70'000 && i < 70'100)) {
+      input.push_back(i);
+    }
+  }
+  checkAllRanges(input, 300'000);
+
+  // The bitmap of a chunk takes no more memory than an array would.
+  DeletePositions positions(input);
+  ASSERT_LT(positions.retainedBytes(), input.size() * sizeof(uint16_t) * 2);
+}
+
+TEST(DeletePositionsTest, unorderedAndRepeated) {
+  DeletePositions positions({5, 3, 1 << 20, 3, 0, 5, 70'000});
+  ASSERT_EQ(positions.size(), 5);
+  checkApply(positions, {0, 3, 5, 70'000, 1 << 20}, 0, 100'000);
+  checkApply(positions, {0, 3, 5, 70'000, 1 << 20}, (1 << 20) - 10, 20);
+
+  DeletePositions empty({});
+  ASSERT_EQ(empty.size(), 0);
+  checkApply(empty, {}, 0, 1'000);
+}
+
+std::shared_ptr<const DeletePositions> makePositions(int32_t numPositions) {
+  std::vector<int64_t> input(numPositions);
+  for (auto i = 0; i < numPositions; ++i) {
+    input[i] = i * 1'000;
+  }
+  return std::make_shared<const DeletePositions>(std::move(input));
+}
+
+DeletePositionsCache::Key makeKey(int32_t i) {
+  return {fmt::format("delete{}.parquet", i), 1'000, 10, "base.parquet"};
+}
+
+TEST(DeletePositionsCacheTest, basic) {
+  const auto bytes = makePositions(100)->retainedBytes();
+  DeletePositionsCache cache(bytes * 8);
+
+  ASSERT_EQ(cache.get(makeKey(0)), nullptr);
+  auto positions = makePositions(100);
+  cache.put(makeKey(0), positions);
+  ASSERT_EQ(cache.get(makeKey(0)), positions);
+
+  // Another version of the delete file or another base file is a miss.
+  auto key = makeKey(0);
+  key.deleteFileSize = 2'000;
+  ASSERT_EQ(cache.get(key), nullptr);
+  key = makeKey(0);
+  key.baseFilePath = "other.parquet";
+  ASSERT_EQ(cache.get(key), nullptr);
+
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.numEntries, 1);
+  ASSERT_EQ(stats.bytes, bytes);
+  ASSERT_EQ(stats.numLookups, 4);
+  ASSERT_EQ(stats.numHits, 1);
+
+  // Positions over a quarter of the capacity are not cached.
+  cache.put(makeKey(1), makePositions(10'000));
+  ASSERT_EQ(cache.get(makeKey(1)), nullptr);
+
+  cache.clear();
+  ASSERT_EQ(cache.get(makeKey(0)), nullptr);
+  ASSERT_EQ(cache.stats().numEntries, 0);
+  ASSERT_EQ(cache.stats().bytes, 0);
+  // Positions got before clear() stay valid.
+  ASSERT_EQ(positions->size(), 100);
+}
+
+TEST(DeletePositionsCacheTest, evict) {
+  const auto bytes = makePositions(100)->retainedBytes();
+  DeletePositionsCache cache(bytes * 4);
+  for (auto i = 0; i < 4; ++i) {
+    cache.put(makeKey(i), makePositions(100));
+  }
+  ASSERT_EQ(cache.stats().numEntries, 4);
+
+  // Makes 0 the most recently used, so that 1 is evicted first.
+  ASSERT_NE(cache.get(makeKey(0)), nullptr);
+  cache.put(makeKey(4), makePositions(100));
+  ASSERT_EQ(cache.get(makeKey(1)), nullptr);
+  ASSERT_NE(cache.get(makeKey(0)), nullptr);
+  ASSERT_NE(cache.get(makeKey(4)), nullptr);
+
+  // Replacing an entry does not evict others.
+  cache.put(makeKey(4), makePositions(100));
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.numEntries, 4);
+  ASSERT_EQ(stats.bytes, bytes * 4);
+  ASSERT_EQ(stats.numEvictions, 1);
+}
+
+} // namespace
+} // namespace facebook::velox::connector::hive::iceberg
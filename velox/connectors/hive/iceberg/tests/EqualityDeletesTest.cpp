@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeletes.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+#include "gtest/gtest.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+namespace {
+
+class EqualityDeletesTest : public ::testing::Test,
+                            public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  std::shared_ptr<EqualityDeletes> makeDeletes(const RowVectorPtr& keys) {
+    auto deletes = std::make_shared<EqualityDeletes>(
+        std::dynamic_pointer_cast<const RowType>(keys->type()));
+    deletes->addKeys(*keys);
+    deletes->finish();
+    return deletes;
+  }
+
+  // Returns the rows of 'probe' that are deleted by 'deletes'.
+  std::vector<vector_size_t> deletedRows(
+      const EqualityDeletes& deletes,
+      const RowVectorPtr& probe) {
+    std::vector<DecodedVector> keys(probe->childrenSize());
+    for (auto i = 0; i < keys.size(); ++i) {
+      keys[i].decode(*probe->childAt(i));
+    }
+    std::vector<vector_size_t> rows;
+    std::string buffer;
+    for (vector_size_t row = 0; row < probe->size(); ++row) {
+      if (deletes.contains(keys, row, buffer)) {
+        rows.push_back(row);
+      }
+    }
+    return rows;
+  }
+};
+
+TEST_F(EqualityDeletesTest, bigintFilter) {
+  auto deletes = makeDeletes(
+      makeRowVector({"c0"}, {makeFlatVector<int64_t>({9, 1, 5, 5, 3})}));
+  ASSERT_FALSE(deletes->empty());
+  auto* filter = deletes->filter();
+  ASSERT_NE(filter, nullptr);
+  for (int64_t value : {1, 3, 5, 9}) {
+    ASSERT_FALSE(filter->testInt64(value));
+  }
+  for (int64_t value : {0, 2, 4, 10}) {
+    ASSERT_TRUE(filter->testInt64(value));
+  }
+  ASSERT_TRUE(filter->testNull());
+
+  // A null key deletes the nulls.
+  deletes = makeDeletes(makeRowVector(
+      {"c0"}, {makeNullableFlatVector<int32_t>({1, std::nullopt})}));
+  ASSERT_FALSE(deletes->filter()->testInt64(1));
+  ASSERT_TRUE(deletes->filter()->testInt64(2));
+  ASSERT_FALSE(deletes->filter()->testNull());
+}
+
+TEST_F(EqualityDeletesTest, stringFilter) {
+  auto deletes = makeDeletes(
+      makeRowVector({"c0"}, {makeFlatVector<StringView>({"b", "a", "b"})}));
+  auto* filter = deletes->filter();
+  ASSERT_NE(filter, nullptr);
+  ASSERT_EQ(filter->kind(), common::FilterKind::kNegatedBytesValues);
+  ASSERT_FALSE(filter->testBytes("a", 1));
+  ASSERT_FALSE(filter->testBytes("b", 1));
+  ASSERT_TRUE(filter->testBytes("c", 1));
+  ASSERT_TRUE(filter->testNull());
+
+  deletes = makeDeletes(makeRowVector(
+      {"c0"}, {makeNullableFlatVector<StringView>({std::nullopt})}));
+  ASSERT_EQ(deletes->filter()->kind(), common::FilterKind::kIsNotNull);
+}
+
+TEST_F(EqualityDeletesTest, multipleColumns) {
+  auto deletes = makeDeletes(makeRowVector(
+      {"c0", "c1"},
+      {makeNullableFlatVector<int64_t>({1, 2, std::nullopt}),
+       makeNullableFlatVector<StringView>({"a", std::nullopt, "c"})}));
+  ASSERT_EQ(deletes->filter(), nullptr);
+  ASSERT_GT(deletes->retainedBytes(), 0);
+
+  auto probe = makeRowVector(
+      {"c0", "c1"},
+      {makeNullableFlatVector<int64_t>({1, 1, 2, 2, std::nullopt, 3}),
+       makeNullableFlatVector<StringView>(
+           {"a", "b", std::nullopt, "a", "c", "c"})});
+  ASSERT_EQ(
+      deletedRows(*deletes, probe), (std::vector<vector_size_t>{0, 2, 4}));
+
+  // Encoded keys.
+  auto indices = makeIndicesInReverse(probe->size());
+  auto dictionary = makeRowVector(
+      {"c0", "c1"},
+      {wrapInDictionary(indices, probe->childAt(0)),
+       wrapInDictionary(indices, probe->childAt(1))});
+  ASSERT_EQ(
+      deletedRows(*deletes, dictionary),
+      (std::vector<vector_size_t>{1, 3, 5}));
+}
+
+TEST_F(EqualityDeletesTest, otherTypes) {
+  // Filters do not apply to unscaled decimals or doubles.
+  auto deletes = makeDeletes(makeRowVector(
+      {"c0"}, {makeFlatVector<int64_t>({100, 250}, DECIMAL(10, 2))}));
+  ASSERT_EQ(deletes->filter(), nullptr);
+  ASSERT_EQ(
+      deletedRows(
+          *deletes,
+          makeRowVector(
+              {"c0"},
+              {makeFlatVector<int64_t>({250, 300, 100}, DECIMAL(10, 2))})),
+      (std::vector<vector_size_t>{0, 2}));
+
+  deletes = makeDeletes(
+      makeRowVector({"c0"}, {makeFlatVector<double>({1.5, -2.0})}));
+  ASSERT_EQ(deletes->filter(), nullptr);
+  ASSERT_EQ(
+      deletedRows(
+          *deletes,
+          makeRowVector({"c0"}, {makeFlatVector<double>({-2.0, 1.0, 1.5})})),
+      (std::vector<vector_size_t>{0, 2}));
+
+  VELOX_ASSERT_THROW(
+      EqualityDeletes(ROW({"c0"}, {ARRAY(BIGINT())})),
+      "Equality delete column of type ARRAY<BIGINT> is not supported");
+}
+
+TEST_F(EqualityDeletesTest, empty) {
+  auto deletes = makeDeletes(
+      makeRowVector({"c0"}, {makeFlatVector<int64_t>(std::vector<int64_t>{})}));
+  ASSERT_TRUE(deletes->empty());
+  ASSERT_EQ(deletes->filter(), nullptr);
+}
+
+} // namespace
+} // namespace facebook::velox::connector::hive::iceberg
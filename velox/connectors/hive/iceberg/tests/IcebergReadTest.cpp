@@ -14,15 +14,19 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/iceberg/DeletePositions.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
+#include "velox/core/Config.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
+#include <folly/ScopeGuard.h>
 #include <folly/Singleton.h>
 
 using namespace facebook::velox::exec::test;
@@ -58,6 +62,14 @@ class HiveIcebergTest : public HiveConnectorTestBase {
         deleteRowsVec, duckdbSql, true, splitCount, numPrefetchSplits);
   }
 
+  // Runs the query twice on the same splits, so that the second run may get
+  // the delete positions from the DeletePositionsCache.
+  void assertPositionalDeletesTwice(
+      const std::vector<std::vector<int64_t>>& deleteRowsVec) {
+    assertPositionalDeletesInternal(
+        deleteRowsVec, getQuery(deleteRowsVec), true, 1, 0, 2);
+  }
+
   std::vector<int64_t> makeRandomDeleteRows(int32_t maxRowNumber) {
     std::mt19937 gen{0};
     std::vector<int64_t> deleteRows;
@@ -92,6 +104,86 @@ class HiveIcebergTest : public HiveConnectorTestBase {
         makeNotInList(deleteRowsVec) + ")";
   }
 
+  // Writes the equality delete file of 'keys', which are the values of the
+  // columns of 'equalityRowType_' with 'fieldIds'.
+  IcebergDeleteFile writeEqualityDeleteFile(
+      const RowVectorPtr& keys,
+      const std::vector<int32_t>& fieldIds) {
+    auto deleteFilePath = TempFilePath::create();
+    writeToFile(deleteFilePath->getPath(), keys);
+    const auto path = deleteFilePath->getPath();
+    deleteFilePaths_.push_back(deleteFilePath);
+    return IcebergDeleteFile(
+        FileContent::kEqualityDeletes,
+        path,
+        fileFomat_,
+        keys->size(),
+        testing::internal::GetFileSize(std::fopen(path.c_str(), "r")),
+        fieldIds);
+  }
+
+  // Returns the rows of the data files of 'equalityRowType_', which are the
+  // rows of the DuckDB table 'tmp' of assertEqualityDeletes().
+  RowVectorPtr makeEqualityData() {
+    return makeRowVector(
+        {"c0", "c1"},
+        {makeFlatVector<int64_t>(rowCount, [](auto row) { return row; }),
+         makeFlatVector<StringView>(rowCount, [](auto row) {
+           return StringView::makeInline(fmt::format("s{}", row % 10));
+         })});
+  }
+
+  // Reads the columns 'outputType' of a data file of 'equalityRowType_' with
+  // 'deleteFiles' for each split. The data files have the same rows, which
+  // are the rows of the DuckDB table 'tmp'.
+  void assertEqualityDeletes(
+      const std::vector<std::vector<IcebergDeleteFile>>& deleteFiles,
+      const std::string& duckdbSql,
+      const RowTypePtr& outputType = nullptr) {
+    auto data = makeEqualityData();
+    std::vector<std::shared_ptr<TempFilePath>> dataFilePaths;
+    std::vector<std::shared_ptr<ConnectorSplit>> splits;
+    for (const auto& splitDeleteFiles : deleteFiles) {
+      dataFilePaths.push_back(TempFilePath::create());
+      writeToFile(dataFilePaths.back()->getPath(), data);
+      splits.push_back(
+          makeIcebergSplit(dataFilePaths.back()->getPath(), splitDeleteFiles));
+    }
+    createDuckDbTable({data});
+    HiveConnectorTestBase::assertQuery(
+        PlanBuilder(pool_.get())
+            .tableScan(outputType ? outputType : equalityRowType_)
+            .planNode(),
+        splits,
+        duckdbSql);
+  }
+
+  std::shared_ptr<ConnectorSplit> makeIcebergSplit(
+      const std::string& dataFilePath,
+      const std::vector<IcebergDeleteFile>& deleteFiles = {}) {
+    std::unordered_map<std::string, std::optional<std::string>> partitionKeys;
+    std::unordered_map<std::string, std::string> customSplitInfo;
+    customSplitInfo["table_format"] = "hive-iceberg";
+
+    auto file = filesystems::getFileSystem(dataFilePath, nullptr)
+                    ->openFileForRead(dataFilePath);
+    const int64_t fileSize = file->size();
+
+    auto split = std::make_shared<HiveIcebergSplit>(
+        kHiveConnectorId,
+        dataFilePath,
+        fileFomat_,
+        0,
+        fileSize,
+        partitionKeys,
+        std::nullopt,
+        customSplitInfo,
+        nullptr,
+        deleteFiles);
+    split->columnNamesByFieldId = {{1, "c0"}, {2, "c1"}};
+    return split;
+  }
+
   const static int rowCount = 20000;
 
  private:
@@ -100,7 +192,8 @@ class HiveIcebergTest : public HiveConnectorTestBase {
       std::string duckdbSql,
       bool multipleBaseFiles,
       int32_t splitCount,
-      int32_t numPrefetchSplits) {
+      int32_t numPrefetchSplits,
+      int32_t numQueries = 1) {
     auto dataFilePaths = writeDataFile(splitCount, rowCount);
     std::vector<std::shared_ptr<ConnectorSplit>> splits;
     // Keep the reference to the deleteFilePath, otherwise the corresponding
@@ -136,8 +229,11 @@ class HiveIcebergTest : public HiveConnectorTestBase {
     }
 
     auto plan = tableScanNode();
-    auto task = HiveConnectorTestBase::assertQuery(
-        plan, splits, duckdbSql, numPrefetchSplits);
+    std::shared_ptr<Task> task;
+    for (auto i = 0; i < numQueries; ++i) {
+      task = HiveConnectorTestBase::assertQuery(
+          plan, splits, duckdbSql, numPrefetchSplits);
+    }
 
     auto planStats = toPlanStats(task->taskStats());
     auto scanNodeId = plan->id();
@@ -146,30 +242,6 @@ class HiveIcebergTest : public HiveConnectorTestBase {
     ASSERT_TRUE(it->second.peakMemoryBytes > 0);
   }
 
-  std::shared_ptr<ConnectorSplit> makeIcebergSplit(
-      const std::string& dataFilePath,
-      const std::vector<IcebergDeleteFile>& deleteFiles = {}) {
-    std::unordered_map<std::string, std::optional<std::string>> partitionKeys;
-    std::unordered_map<std::string, std::string> customSplitInfo;
-    customSplitInfo["table_format"] = "hive-iceberg";
-
-    auto file = filesystems::getFileSystem(dataFilePath, nullptr)
-                    ->openFileForRead(dataFilePath);
-    const int64_t fileSize = file->size();
-
-    return std::make_shared<HiveIcebergSplit>(
-        kHiveConnectorId,
-        dataFilePath,
-        fileFomat_,
-        0,
-        fileSize,
-        partitionKeys,
-        std::nullopt,
-        customSplitInfo,
-        nullptr,
-        deleteFiles);
-  }
-
   std::vector<RowVectorPtr> makeVectors(int32_t count, int32_t rowsPerVector) {
     std::vector<RowVectorPtr> vectors;
     for (int i = 0; i < count; i++) {
@@ -281,6 +353,8 @@ class HiveIcebergTest : public HiveConnectorTestBase {
 
   dwio::common::FileFormat fileFomat_{dwio::common::FileFormat::DWRF};
   RowTypePtr rowType_{ROW({"c0"}, {BIGINT()})};
+  RowTypePtr equalityRowType_{ROW({"c0", "c1"}, {BIGINT(), VARCHAR()})};
+  std::vector<std::shared_ptr<TempFilePath>> deleteFilePaths_;
   std::shared_ptr<IcebergMetadataColumn> pathColumn_ =
       IcebergMetadataColumn::icebergDeleteFilePathColumn();
   std::shared_ptr<IcebergMetadataColumn> posColumn_ =
@@ -347,4 +421,222 @@ TEST_F(HiveIcebergTest, positionalDeletesMultipleSplits) {
       deletedRows, getQuery(deletedRows), splitCount, numPrefetchSplits);
 }
 
+TEST_F(HiveIcebergTest, equalityDeletesSingleColumn) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  // Pushed down as a negated filter on c0.
+  auto bigintDeletes = writeEqualityDeleteFile(
+      makeRowVector(
+          {"c0"}, {makeFlatVector<int64_t>({0, 5, 9999, 19999, 30000})}),
+      {1});
+  assertEqualityDeletes(
+      {{bigintDeletes}},
+      "SELECT * FROM tmp WHERE c0 NOT IN (0, 5, 9999, 19999, 30000)");
+
+  // Negated filter on c1.
+  auto varcharDeletes = writeEqualityDeleteFile(
+      makeRowVector({"c1"}, {makeFlatVector<StringView>({"s1", "s3", "x"})}),
+      {2});
+  assertEqualityDeletes(
+      {{varcharDeletes}}, "SELECT * FROM tmp WHERE c1 NOT IN ('s1', 's3')");
+
+  // The filters of delete files on the same column are merged.
+  auto otherBigintDeletes = writeEqualityDeleteFile(
+      makeRowVector({"c0"}, {makeFlatVector<int64_t>({5, 6, 7})}), {1});
+  assertEqualityDeletes(
+      {{bigintDeletes, otherBigintDeletes, varcharDeletes}},
+      "SELECT * FROM tmp WHERE c0 NOT IN (0, 5, 6, 7, 9999, 19999) "
+      "AND c1 NOT IN ('s1', 's3')");
+
+  // The filters apply to the splits with the delete files only.
+  assertEqualityDeletes(
+      {{bigintDeletes}, {}, {varcharDeletes}},
+      "SELECT * FROM tmp WHERE c0 NOT IN (0, 5, 9999, 19999) "
+      "UNION ALL SELECT * FROM tmp "
+      "UNION ALL SELECT * FROM tmp WHERE c1 NOT IN ('s1', 's3')");
+}
+
+TEST_F(HiveIcebergTest, equalityDeletesMultipleColumns) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  // Rows 1 and 3 match both columns. Row 2 does not.
+  auto deletes = writeEqualityDeleteFile(
+      makeRowVector(
+          {"c0", "c1"},
+          {makeFlatVector<int64_t>({1, 2, 3}),
+           makeFlatVector<StringView>({"s1", "s3", "s3"})}),
+      {1, 2});
+  assertEqualityDeletes(
+      {{deletes}}, "SELECT * FROM tmp WHERE c0 NOT IN (1, 3)");
+
+  auto bigintDeletes = writeEqualityDeleteFile(
+      makeRowVector({"c0"}, {makeFlatVector<int64_t>({10, 11})}), {1});
+  assertEqualityDeletes(
+      {{deletes, bigintDeletes}, {}},
+      "SELECT * FROM tmp WHERE c0 NOT IN (1, 3, 10, 11) "
+      "UNION ALL SELECT * FROM tmp");
+}
+
+TEST_F(HiveIcebergTest, cachedEqualityDeletes) {
+  folly::SingletonVault::singleton()->registrationComplete();
+  EqualityDeletesCache cache(1 << 20);
+  EqualityDeletesCache::setInstance(&cache);
+  SCOPE_EXIT {
+    EqualityDeletesCache::setInstance(nullptr);
+  };
+
+  // The splits share the keys read for the first one.
+  auto deletes = writeEqualityDeleteFile(
+      makeRowVector(
+          {"c0", "c1"},
+          {makeFlatVector<int64_t>({1, 2}),
+           makeFlatVector<StringView>({"s1", "s2"})}),
+      {1, 2});
+  auto bigintDeletes = writeEqualityDeleteFile(
+      makeRowVector({"c0"}, {makeFlatVector<int64_t>({10, 11})}), {1});
+  assertEqualityDeletes(
+      {{deletes, bigintDeletes},
+       {deletes, bigintDeletes},
+       {deletes, bigintDeletes}},
+      "SELECT * FROM tmp WHERE c0 NOT IN (1, 2, 10, 11) "
+      "UNION ALL SELECT * FROM tmp WHERE c0 NOT IN (1, 2, 10, 11) "
+      "UNION ALL SELECT * FROM tmp WHERE c0 NOT IN (1, 2, 10, 11)");
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.numEntries, 2);
+  ASSERT_EQ(stats.numLookups, 6);
+  ASSERT_EQ(stats.numHits, 4);
+}
+
+TEST_F(HiveIcebergTest, equalityDeletesOnColumnsNotRead) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  // c0 is read for the deletes only.
+  auto deletes = writeEqualityDeleteFile(
+      makeRowVector(
+          {"c0", "c1"},
+          {makeFlatVector<int64_t>({1, 2, 3}),
+           makeFlatVector<StringView>({"s1", "s3", "s3"})}),
+      {1, 2});
+  auto varcharDeletes = writeEqualityDeleteFile(
+      makeRowVector({"c1"}, {makeFlatVector<StringView>({"s5"})}), {2});
+  assertEqualityDeletes(
+      {{deletes}, {deletes, varcharDeletes}, {}},
+      "SELECT c1 FROM tmp WHERE c0 NOT IN (1, 3) "
+      "UNION ALL SELECT c1 FROM tmp WHERE c0 NOT IN (1, 3) AND c1 <> 's5' "
+      "UNION ALL SELECT c1 FROM tmp",
+      ROW({"c1"}, {VARCHAR()}));
+}
+
+TEST_F(HiveIcebergTest, equalityDeletesUnknownFieldId) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  auto deletes = writeEqualityDeleteFile(
+      makeRowVector({"c2"}, {makeFlatVector<int64_t>({1})}), {3});
+  VELOX_ASSERT_THROW(
+      assertEqualityDeletes({{deletes}}, "SELECT * FROM tmp"),
+      "No column name for equality field id 3");
+}
+
+// A dynamic filter pushed down while reading a split with equality deletes
+// keeps applying to the next splits after the delete filter is dropped.
+TEST_F(HiveIcebergTest, equalityDeletesWithDynamicFilter) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  auto data = makeEqualityData();
+  auto dataFilePath = TempFilePath::create();
+  writeToFile(dataFilePath->getPath(), data);
+  auto deletes = writeEqualityDeleteFile(
+      makeRowVector({"c0"}, {makeFlatVector<int64_t>({1, 2, 3})}), {1});
+
+  auto connectorPool = rootPool_->addAggregateChild("connector");
+  auto sessionProperties = std::make_shared<core::MemConfig>();
+  connector::ConnectorQueryCtx connectorQueryCtx(
+      pool_.get(),
+      connectorPool.get(),
+      sessionProperties.get(),
+      nullptr,
+      nullptr,
+      nullptr,
+      "query.HiveIcebergTest",
+      "task.HiveIcebergTest",
+      "planNodeId.HiveIcebergTest",
+      0);
+  auto dataSource = connector::getConnector(kHiveConnectorId)
+                        ->createDataSource(
+                            equalityRowType_,
+                            makeTableHandle(),
+                            allRegularColumns(equalityRowType_),
+                            &connectorQueryCtx);
+
+  // Returns the values of c0 in the next 'numBatches' batches of the split.
+  auto readC0 = [&](int32_t numBatches) {
+    std::vector<int64_t> values;
+    ContinueFuture future;
+    for (auto i = 0; i < numBatches; ++i) {
+      auto result = dataSource->next(1'000, future);
+      VELOX_CHECK(result.has_value());
+      if (result.value() == nullptr) {
+        break;
+      }
+      auto c0 = BaseVector::loadedVectorShared(result.value()->childAt(0));
+      DecodedVector decoded(*c0);
+      for (auto row = 0; row < c0->size(); ++row) {
+        values.push_back(decoded.valueAt<int64_t>(row));
+      }
+    }
+    return values;
+  };
+  auto contains = [](const std::vector<int64_t>& values, int64_t value) {
+    return std::find(values.begin(), values.end(), value) != values.end();
+  };
+
+  dataSource->addSplit(makeIcebergSplit(dataFilePath->getPath(), {deletes}));
+  auto values = readC0(1);
+  ASSERT_FALSE(values.empty());
+  ASSERT_FALSE(contains(values, 1));
+
+  dataSource->addDynamicFilter(
+      0, std::make_shared<common::BigintRange>(0, 14'999, false));
+  values = readC0(std::numeric_limits<int32_t>::max());
+  ASSERT_FALSE(values.empty());
+  for (auto value : values) {
+    ASSERT_LT(value, 15'000);
+  }
+
+  // The next split has no deletes but keeps the dynamic filter.
+  dataSource->addSplit(makeIcebergSplit(dataFilePath->getPath()));
+  values = readC0(std::numeric_limits<int32_t>::max());
+  ASSERT_EQ(values.size(), 15'000);
+  ASSERT_TRUE(contains(values, 1));
+  for (auto value : values) {
+    ASSERT_LT(value, 15'000);
+  }
+}
+
+TEST_F(HiveIcebergTest, cachedPositionalDeletes) {
+  folly::SingletonVault::singleton()->registrationComplete();
+  DeletePositionsCache cache(1 << 20);
+  DeletePositionsCache::setInstance(&cache);
+  SCOPE_EXIT {
+    DeletePositionsCache::setInstance(nullptr);
+  };
+
+  // Each of the 3 delete files is read by the first query only.
+  assertPositionalDeletesTwice(
+      {{0, 9999}, {10000}, makeRandomDeleteRows(rowCount)});
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.numEntries, 3);
+  ASSERT_EQ(stats.numLookups, 6);
+  ASSERT_EQ(stats.numHits, 3);
+  ASSERT_EQ(stats.numEvictions, 0);
+  ASSERT_GT(stats.bytes, 0);
+
+  // A cache too small for the positions does not change the results.
+  DeletePositionsCache tinyCache(100);
+  DeletePositionsCache::setInstance(&tinyCache);
+  assertPositionalDeletesTwice({makeRandomDeleteRows(rowCount)});
+  ASSERT_EQ(tinyCache.stats().numEntries, 0);
+  ASSERT_EQ(tinyCache.stats().numHits, 0);
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
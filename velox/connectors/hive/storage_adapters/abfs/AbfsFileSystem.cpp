@@ -169,7 +169,9 @@ class AbfsReadFile::Impl {
 
 AbfsReadFile::AbfsReadFile(
     const std::string& path,
-    const std::string& connectStr) {
+    const std::string& connectStr,
+    std::shared_ptr<folly::Executor> executor)
+    : executor_(std::move(executor)) {
   impl_ = std::make_shared<Impl>(path, connectStr);
 }
 
@@ -198,6 +200,27 @@ void AbfsReadFile::preadv(
   return impl_->preadv(regions, iobufs);
 }
 
+folly::SemiFuture<uint64_t> AbfsReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  if (executor_ == nullptr) {
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+  // The blob client of the Azure SDK has no asynchronous download. The read
+  // runs on 'executor_', so that the caller's IO threads are not blocked for
+  // the duration of the request. 'impl_' is kept alive by the read.
+  return folly::via(
+             executor_.get(),
+             [impl = impl_, offset, buffers]() {
+               return impl->preadv(offset, buffers);
+             })
+      .semi();
+}
+
+bool AbfsReadFile::hasPreadvAsync() const {
+  return executor_ != nullptr;
+}
+
 uint64_t AbfsReadFile::size() const {
   return impl_->size();
 }
@@ -222,6 +245,12 @@ class AbfsFileSystem::Impl {
  public:
   explicit Impl(const Config* config) : abfsConfig_(config) {
     LOG(INFO) << "Init Azure Blob file system";
+    const auto numThreads = HiveConfig(std::make_shared<core::MemConfig>(
+                                           config->values()))
+                                .abfsReadThreads();
+    if (numThreads > 0) {
+      ioExecutor_ = std::make_shared<folly::IOThreadPoolExecutor>(numThreads);
+    }
   }
 
   ~Impl() {
@@ -233,8 +262,13 @@ class AbfsFileSystem::Impl {
     return abfsConfig_.connectionString(path);
   }
 
+  const std::shared_ptr<folly::Executor>& ioExecutor() const {
+    return ioExecutor_;
+  }
+
  private:
   const AbfsConfig abfsConfig_;
+  // Serves the asynchronous reads of the files of 'this'.
   std::shared_ptr<folly::Executor> ioExecutor_;
 };
 
@@ -251,7 +285,9 @@ std::unique_ptr<ReadFile> AbfsFileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& options) {
   auto abfsfile = std::make_unique<AbfsReadFile>(
-      std::string(path), impl_->connectionString(std::string(path)));
+      std::string(path),
+      impl_->connectionString(std::string(path)),
+      impl_->ioExecutor());
   abfsfile->initialize(options);
   return abfsfile;
 }
@@ -22,7 +22,12 @@
 namespace facebook::velox::filesystems::abfs {
 class AbfsReadFile final : public ReadFile {
  public:
-  explicit AbfsReadFile(const std::string& path, const std::string& connectStr);
+  /// Asynchronous reads run on 'executor'. If 'executor' is nullptr,
+  /// preadvAsync() is synchronous.
+  explicit AbfsReadFile(
+      const std::string& path,
+      const std::string& connectStr,
+      std::shared_ptr<folly::Executor> executor = nullptr);
 
   void initialize(const FileOptions& options);
 
@@ -39,6 +44,12 @@ class AbfsReadFile final : public ReadFile {
       folly::Range<const common::Region*> regions,
       folly::Range<folly::IOBuf*> iobufs) const final;
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final;
+
   uint64_t size() const final;
 
   uint64_t memoryUsage() const final;
@@ -52,5 +63,6 @@ class AbfsReadFile final : public ReadFile {
  protected:
   class Impl;
   std::shared_ptr<Impl> impl_;
+  const std::shared_ptr<folly::Executor> executor_;
 };
 } // namespace facebook::velox::filesystems::abfs
@@ -152,6 +152,13 @@ void readData(ReadFile* readFile) {
   ASSERT_EQ(std::string_view(buff1, sizeof(buff1)), "aaaaabbbbb");
   ASSERT_EQ(std::string_view(buff2, sizeof(buff2)), "cccccddddd");
 
+  if (readFile->hasPreadvAsync()) {
+    std::fill(buff2, buff2 + sizeof(buff2), 0);
+    ASSERT_EQ(
+        readFile->preadvAsync(0, buffers).get(), 10 + kOneMB - 5 + 10);
+    ASSERT_EQ(std::string_view(buff2, sizeof(buff2)), "cccccddddd");
+  }
+
   std::vector<folly::IOBuf> iobufs(2);
   std::vector<Region> regions = {{0, 10}, {10, 5}};
   readFile->preadv(
@@ -174,6 +181,7 @@ TEST_F(AbfsFileSystemTest, readFile) {
         azuriteServer->connectionStr()}});
   AbfsFileSystem abfs{hiveConfig};
   auto readFile = abfs.openFileForRead(fullFilePath);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
   readData(readFile.get());
 }
 
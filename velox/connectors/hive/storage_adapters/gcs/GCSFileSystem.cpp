@@ -22,6 +22,8 @@
 #include "velox/core/Config.h"
 
 #include <fmt/format.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
 #include <memory>
 #include <stdexcept>
@@ -64,8 +66,11 @@ inline void checkGCSStatus(
 
 class GCSReadFile final : public ReadFile {
  public:
-  GCSReadFile(const std::string& path, std::shared_ptr<gcs::Client> client)
-      : client_(std::move(client)) {
+  GCSReadFile(
+      const std::string& path,
+      std::shared_ptr<gcs::Client> client,
+      std::shared_ptr<folly::Executor> executor)
+      : client_(std::move(client)), executor_(std::move(executor)) {
     // assumption it's a proper path
     setBucketAndKeyFromGCSPath(path, bucket_, key_);
   }
@@ -132,6 +137,25 @@ class GCSReadFile final : public ReadFile {
     return length;
   }
 
+  // The REST client of the GCS SDK has no asynchronous reads. The read runs
+  // on 'executor_', so that the caller's IO threads are not blocked for the
+  // duration of the request.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    if (executor_ == nullptr) {
+      return ReadFile::preadvAsync(offset, buffers);
+    }
+    return folly::via(
+               executor_.get(),
+               [this, offset, buffers]() { return preadv(offset, buffers); })
+        .semi();
+  }
+
+  bool hasPreadvAsync() const override {
+    return executor_ != nullptr;
+  }
+
   uint64_t size() const override {
     return length_;
   }
@@ -174,6 +198,8 @@ class GCSReadFile final : public ReadFile {
   }
 
   std::shared_ptr<gcs::Client> client_;
+  // Runs preadvAsync() or nullptr if preadvAsync() is synchronous.
+  const std::shared_ptr<folly::Executor> executor_;
   std::string bucket_;
   std::string key_;
   std::atomic<int64_t> length_ = -1;
@@ -259,7 +285,12 @@ class GCSFileSystem::Impl {
  public:
   Impl(const Config* config)
       : hiveConfig_(std::make_shared<HiveConfig>(
-            std::make_shared<core::MemConfig>(config->values()))) {}
+            std::make_shared<core::MemConfig>(config->values()))) {
+    if (hiveConfig_->gcsReadThreads() > 0) {
+      readExecutor_ = std::make_shared<folly::IOThreadPoolExecutor>(
+          hiveConfig_->gcsReadThreads());
+    }
+  }
 
   ~Impl() = default;
 
@@ -295,9 +326,15 @@ class GCSFileSystem::Impl {
     return client_;
   }
 
+  const std::shared_ptr<folly::Executor>& readExecutor() const {
+    return readExecutor_;
+  }
+
  private:
   const std::shared_ptr<HiveConfig> hiveConfig_;
   std::shared_ptr<gcs::Client> client_;
+  // Serves the asynchronous reads of the files of 'this'.
+  std::shared_ptr<folly::Executor> readExecutor_;
 };
 
 GCSFileSystem::GCSFileSystem(std::shared_ptr<const Config> config)
@@ -313,7 +350,8 @@ std::unique_ptr<ReadFile> GCSFileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& options) {
   const auto gcspath = gcsPath(path);
-  auto gcsfile = std::make_unique<GCSReadFile>(gcspath, impl_->getClient());
+  auto gcsfile = std::make_unique<GCSReadFile>(
+      gcspath, impl_->getClient(), impl_->readExecutor());
   gcsfile->initialize(options);
   return gcsfile;
 }
@@ -209,6 +209,12 @@ TEST_F(GCSFileSystemTest, readFile) {
   ASSERT_EQ(std::string_view(buff1, sizeof(buff1)), kLoremIpsum.substr(0, 10));
   ASSERT_EQ(std::string_view(buff2, sizeof(buff2)), kLoremIpsum.substr(30, 20));
   ASSERT_EQ(std::string_view(buff3, sizeof(buff3)), kLoremIpsum.substr(80, 30));
+
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  std::fill(buff3, buff3 + sizeof(buff3), 0);
+  ASSERT_EQ(
+      readFile->preadvAsync(0, buffers).get(), 10 + 20 + 20 + 30 + 30);
+  ASSERT_EQ(std::string_view(buff3, sizeof(buff3)), kLoremIpsum.substr(80, 30));
 }
 
 TEST_F(GCSFileSystemTest, writeAndReadFile) {
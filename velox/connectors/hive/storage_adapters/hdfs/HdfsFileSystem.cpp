@@ -16,20 +16,27 @@
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
 #include <hdfs/hdfs.h>
 #include <mutex>
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsReadFile.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsWriteFile.h"
 #include "velox/core/Config.h"
 
 namespace facebook::velox::filesystems {
+using connector::hive::HiveConfig;
+
 std::string_view HdfsFileSystem::kScheme("hdfs://");
 
 class HdfsFileSystem::Impl {
  public:
-  // Keep config here for possible use in the future.
   explicit Impl(const Config* config, const HdfsServiceEndpoint& endpoint) {
     auto builder = hdfsNewBuilder();
     hdfsBuilderSetNameNode(builder, endpoint.host.c_str());
     hdfsBuilderSetNameNodePort(builder, atoi(endpoint.port.data()));
+    if (config != nullptr) {
+      setShortCircuitRead(
+          builder,
+          HiveConfig(std::make_shared<core::MemConfig>(config->values())));
+    }
     hdfsClient_ = hdfsBuilderConnect(builder);
     hdfsFreeBuilder(builder);
     VELOX_CHECK_NOT_NULL(
@@ -53,6 +60,31 @@ class HdfsFileSystem::Impl {
   }
 
  private:
+  // Makes libhdfs3 read blocks with a replica on this host from the local
+  // disk through the domain socket of the datanode.
+  static void setShortCircuitRead(
+      hdfsBuilder* builder,
+      const HiveConfig& hiveConfig) {
+    if (!hiveConfig.hdfsShortCircuitRead()) {
+      hdfsBuilderConfSetStr(builder, "dfs.client.read.shortcircuit", "false");
+      return;
+    }
+    const auto socketPath = hiveConfig.hdfsDomainSocketPath();
+    VELOX_USER_CHECK(
+        !socketPath.empty(),
+        "{} must be set for HDFS short-circuit reads",
+        HiveConfig::kHdfsDomainSocketPath);
+    const auto cacheSize =
+        std::to_string(hiveConfig.hdfsShortCircuitStreamsCacheSize());
+    hdfsBuilderConfSetStr(builder, "dfs.client.read.shortcircuit", "true");
+    hdfsBuilderConfSetStr(
+        builder, "dfs.domain.socket.path", socketPath.c_str());
+    hdfsBuilderConfSetStr(
+        builder,
+        "dfs.client.read.shortcircuit.streams.cache.size",
+        cacheSize.c_str());
+  }
+
   hdfsFS hdfsClient_;
 };
 
@@ -17,9 +17,28 @@
 #include "HdfsReadFile.h"
 #include <folly/synchronization/CallOnce.h>
 #include <hdfs/hdfs.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <climits>
 
 namespace facebook::velox {
 
+namespace {
+// Returns the host name of this host as used for HDFS block locations.
+const std::string& localHostName() {
+  static const std::string hostName = []() {
+    char name[HOST_NAME_MAX + 1] = {};
+    if (gethostname(name, sizeof(name)) != 0) {
+      LOG(WARNING) << "Unable to get the host name, errno: " << errno;
+      return std::string();
+    }
+    return std::string(name);
+  }();
+  return hostName;
+}
+} // namespace
+
 HdfsReadFile::HdfsReadFile(hdfsFS hdfs, const std::string_view path)
     : hdfsClient_(hdfs), filePath_(path) {
   fileInfo_ = hdfsGetPathInfo(hdfsClient_, filePath_.data());
@@ -77,6 +96,63 @@ uint64_t HdfsReadFile::memoryUsage() const {
   return fileInfo_->mBlockSize;
 }
 
+std::optional<uint64_t> HdfsReadFile::localBytes(
+    uint64_t offset,
+    uint64_t length) const {
+  folly::call_once(blocksOnce_, [&]() { loadBlocks(); });
+  if (blocks_.empty()) {
+    return std::nullopt;
+  }
+  const auto end = offset + length;
+  // First block that ends after 'offset'.
+  auto it = std::upper_bound(
+      blocks_.begin(), blocks_.end(), offset, [](uint64_t o, const Block& b) {
+        return o < b.offset + b.length;
+      });
+  uint64_t local = 0;
+  for (; it != blocks_.end() && it->offset < end; ++it) {
+    if (it->local) {
+      local += std::min(end, it->offset + it->length) -
+          std::max(offset, it->offset);
+    }
+  }
+  return local;
+}
+
+void HdfsReadFile::loadBlocks() const {
+  const auto& hostName = localHostName();
+  if (hostName.empty() || size() == 0) {
+    return;
+  }
+  int numBlocks = 0;
+  auto* locations = hdfsGetFileBlockLocations(
+      hdfsClient_, filePath_.c_str(), 0, size(), &numBlocks);
+  if (locations == nullptr) {
+    LOG(WARNING) << "Unable to get block locations of " << filePath_
+                 << ", got error: " << hdfsGetLastError();
+    return;
+  }
+  blocks_.reserve(numBlocks);
+  for (auto i = 0; i < numBlocks; ++i) {
+    const auto& location = locations[i];
+    bool local = false;
+    for (auto j = 0; j < location.numOfNodes; ++j) {
+      if (hostName == location.hosts[j]) {
+        local = true;
+        break;
+      }
+    }
+    blocks_.push_back(
+        {static_cast<uint64_t>(location.offset),
+         static_cast<uint64_t>(location.length),
+         local});
+  }
+  hdfsFreeFileBlockLocations(locations, numBlocks);
+  std::sort(blocks_.begin(), blocks_.end(), [](const auto& a, const auto& b) {
+    return a.offset < b.offset;
+  });
+}
+
 bool HdfsReadFile::shouldCoalesce() const {
   return false;
 }
@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 
+#include <folly/synchronization/CallOnce.h>
 #include <hdfs/hdfs.h>
+#include <vector>
 #include "velox/common/file/File.h"
 
 namespace facebook::velox {
@@ -82,14 +84,34 @@ class HdfsReadFile final : public ReadFile {
     return 72 << 20;
   }
 
+  /// Returns the bytes in the range that are in blocks with a replica on
+  /// this host. These are read from the local disk if short-circuit reads
+  /// are enabled.
+  std::optional<uint64_t> localBytes(uint64_t offset, uint64_t length)
+      const final;
+
  private:
+  struct Block {
+    uint64_t offset;
+    uint64_t length;
+    // True if a replica of the block is on this host.
+    bool local;
+  };
+
   void preadInternal(uint64_t offset, uint64_t length, char* pos) const;
   void checkFileReadParameters(uint64_t offset, uint64_t length) const;
 
+  // Fetches 'blocks_' from the namenode on first use.
+  void loadBlocks() const;
+
   hdfsFS hdfsClient_;
   hdfsFileInfo* fileInfo_;
   std::string filePath_;
   folly::ThreadLocal<HdfsFile> file_;
+  mutable folly::once_flag blocksOnce_;
+  // Blocks of the file in offset order. Empty if the locations could not be
+  // fetched.
+  mutable std::vector<Block> blocks_;
 };
 
 } // namespace facebook::velox
@@ -22,6 +22,8 @@
 #include "HdfsMiniCluster.h"
 #include "gtest/gtest.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsReadFile.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/RegisterHdfsFileSystem.h"
 #include "velox/core/QueryConfig.h"
@@ -177,6 +179,35 @@ TEST_F(HdfsFileSystemTest, read) {
   readData(&readFile);
 }
 
+TEST_F(HdfsFileSystemTest, localBytes) {
+  struct hdfsBuilder* builder = hdfsNewBuilder();
+  hdfsBuilderSetNameNode(builder, localhost.c_str());
+  hdfsBuilderSetNameNodePort(builder, 7878);
+  auto hdfs = hdfsBuilderConnect(builder);
+  HdfsReadFile readFile(hdfs, destinationPath);
+  const auto size = readFile.size();
+  const auto all = readFile.localBytes(0, size);
+  ASSERT_TRUE(all.has_value());
+  ASSERT_LE(all.value(), size);
+  // The local bytes of a range are the sum of those of its parts.
+  const auto first = readFile.localBytes(0, size / 2);
+  const auto second = readFile.localBytes(size / 2, size - size / 2);
+  ASSERT_EQ(first.value() + second.value(), all.value());
+  ASSERT_EQ(readFile.localBytes(size, 0).value(), 0);
+}
+
+TEST_F(HdfsFileSystemTest, shortCircuitReadWithoutSocketPath) {
+  auto config = configurationValues;
+  config[connector::hive::HiveConfig::kHdfsShortCircuitRead] = "true";
+  auto memConfig = std::make_shared<const core::MemConfig>(config);
+  VELOX_ASSERT_THROW(
+      filesystems::HdfsFileSystem(
+          memConfig,
+          filesystems::HdfsFileSystem::getServiceEndpoint(
+              fullDestinationPath, memConfig.get())),
+      "hive.hdfs.domain-socket-path must be set for HDFS short-circuit reads");
+}
+
 TEST_F(HdfsFileSystemTest, viaFileSystem) {
   auto memConfig = std::make_shared<const core::MemConfig>(configurationValues);
   auto hdfsFileSystem =
@@ -42,15 +42,18 @@ namespace facebook::velox::filesystems {
 /// https://docs.aws.amazon.com/AmazonS3/latest/userguide/mpuoverview.html
 /// https://github.com/apache/arrow/blob/main/cpp/src/arrow/filesystem/s3fs.cc
 /// S3WriteFile is not thread-safe.
-/// UploadPart is currently synchronous during append and flush.
-/// TODO: Evaluate and add option for asynchronous part uploads.
+/// Parts are uploaded asynchronously on the executor of the S3 client. At most
+/// 'maxInFlightParts' parts are in flight per file. Once that many are in
+/// flight, append() waits for one of them to finish. close() waits for all of
+/// them.
 /// TODO: Implement retry on failure.
 class S3WriteFile : public WriteFile {
  public:
   S3WriteFile(
       const std::string& path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      int32_t maxInFlightParts = 1);
 
   /// Appends data to the end of the file.
   /// Uploads a part on reaching part size limit.
@@ -65,7 +68,7 @@ class S3WriteFile : public WriteFile {
   /// Current file size, i.e. the sum of all previous Appends.
   uint64_t size() const override;
 
-  /// Return the number of parts uploaded so far.
+  /// Return the number of parts uploaded or in flight so far.
   int numPartsUploaded() const;
 
  protected:
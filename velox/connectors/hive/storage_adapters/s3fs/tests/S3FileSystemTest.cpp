@@ -60,6 +60,36 @@ TEST_F(S3FileSystemTest, writeAndRead) {
   readData(readFile.get());
 }
 
+TEST_F(S3FileSystemTest, readParts) {
+  const char* bucketName = "data2";
+  const char* file = "parts.txt";
+  const std::string filename = localPath(bucketName) + "/" + file;
+  const std::string s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  // The 1MB reads are split into 11 concurrent GETs.
+  auto hiveConfig =
+      minioServer_->hiveConfig({{"hive.s3.read-part-size", "100kB"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  auto readFile = s3fs.openFileForRead(s3File);
+  readData(readFile.get());
+
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  std::string head(12, 0);
+  std::string tail(kOneMB, 0);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head.data(), head.size()),
+      folly::Range<char*>(nullptr, (char*)(uint64_t)3),
+      folly::Range<char*>(tail.data(), tail.size())};
+  ASSERT_EQ(readFile->preadvAsync(0, buffers).get(), 15 + kOneMB);
+  ASSERT_EQ(head, "aaaaabbbbbcc");
+  ASSERT_EQ(tail, std::string(kOneMB - 5, 'c') + "ddddd");
+  ASSERT_EQ(readFile->preadvAsync(0, {}).get(), 0);
+}
+
 TEST_F(S3FileSystemTest, invalidCredentialsConfig) {
   {
     const std::unordered_map<std::string, std::string> config(
@@ -254,6 +284,40 @@ TEST_F(S3FileSystemTest, writeFileAndRead) {
   ASSERT_EQ(readFile->pread(contentSize * 250'000, contentSize), dataContent);
 }
 
+TEST_F(S3FileSystemTest, writeInFlightParts) {
+  const auto bucketName = "writeparts";
+  const auto s3File = s3URI(bucketName, "parts.txt");
+  addBucket(bucketName);
+  constexpr int64_t kPartSize = 10 << 20;
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.upload-max-in-flight-parts", "2"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  auto pool = memory::memoryManager()->addLeafPool("S3FileSystemTest");
+  {
+    auto writeFile =
+        s3fs.openFileForWrite(s3File, {{}, pool.get(), std::nullopt});
+    auto s3WriteFile =
+        dynamic_cast<filesystems::S3WriteFile*>(writeFile.get());
+    // Parts are completed in any order but must be assembled in order.
+    for (auto c : {'a', 'b', 'c', 'd'}) {
+      writeFile->append(std::string(kPartSize, c));
+    }
+    writeFile->append("e");
+    ASSERT_EQ(s3WriteFile->numPartsUploaded(), 4);
+    writeFile->close();
+    ASSERT_EQ(s3WriteFile->numPartsUploaded(), 5);
+  }
+  ASSERT_EQ(pool->usedBytes(), 0);
+
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_EQ(readFile->size(), 4 * kPartSize + 1);
+  for (auto i = 0; i < 4; ++i) {
+    ASSERT_EQ(
+        readFile->pread(i * kPartSize + kPartSize - 1, 2),
+        fmt::format("{}{}", char('a' + i), char('b' + i)));
+  }
+}
+
 TEST_F(S3FileSystemTest, invalidConnectionSettings) {
   auto hiveConfig =
       minioServer_->hiveConfig({{"hive.s3.connect-timeout", "400"}});
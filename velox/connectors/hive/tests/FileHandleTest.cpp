@@ -48,3 +48,32 @@ TEST(FileHandleTest, localFile) {
   // Clean up
   remove(filename.c_str());
 }
+
+TEST(FileHandleTest, shardedCacheWithProperties) {
+  filesystems::registerLocalFileSystem();
+
+  auto tempFile = exec::test::TempFilePath::create();
+  const auto& filename = tempFile->getPath();
+  remove(filename.c_str());
+
+  {
+    LocalWriteFile writeFile(filename);
+    writeFile.append("foo");
+  }
+
+  FileHandleFactory factory(4, 1000, std::make_unique<FileHandleGenerator>());
+  ASSERT_EQ(factory.numShards(), 4);
+  FileProperties properties{3, 1234};
+  auto fileHandle = factory.generate(filename, &properties);
+  ASSERT_FALSE(fileHandle.first);
+  ASSERT_EQ(fileHandle.second->file->size(), 3);
+  ASSERT_EQ(fileHandle.second->modificationTime, 1234);
+
+  // A cached handle keeps the properties it was opened with.
+  auto cachedHandle = factory.generate(filename);
+  ASSERT_TRUE(cachedHandle.first);
+  ASSERT_EQ(cachedHandle.second.get(), fileHandle.second.get());
+  ASSERT_EQ(cachedHandle.second->modificationTime, 1234);
+
+  remove(filename.c_str());
+}
@@ -30,6 +30,7 @@ TEST(HiveConfigTest, defaultConfig) {
       facebook::velox::connector::hive::HiveConfig::
           InsertExistingPartitionsBehavior::kError);
   ASSERT_EQ(hiveConfig->maxPartitionsPerWriters(emptySession.get()), 100);
+  ASSERT_EQ(hiveConfig->maxOpenWriters(emptySession.get()), 0);
   ASSERT_EQ(hiveConfig->immutablePartitions(), false);
   ASSERT_EQ(hiveConfig->s3UseVirtualAddressing(), true);
   ASSERT_EQ(hiveConfig->s3GetLogLevel(), "FATAL");
@@ -49,6 +50,9 @@ TEST(HiveConfigTest, defaultConfig) {
 
   ASSERT_EQ(hiveConfig->maxCoalescedBytes(), 128 << 20);
   ASSERT_EQ(hiveConfig->maxCoalescedDistanceBytes(), 512 << 10);
+  ASSERT_EQ(hiveConfig->adaptivePrefetchRowGroups(), false);
+  ASSERT_EQ(hiveConfig->adaptiveCoalescing(), false);
+  ASSERT_EQ(hiveConfig->mmapLocalFiles(), false);
   ASSERT_EQ(hiveConfig->numCacheFileHandles(), 20'000);
   ASSERT_EQ(hiveConfig->isFileHandleCacheEnabled(), true);
   ASSERT_EQ(
@@ -57,16 +61,21 @@ TEST(HiveConfigTest, defaultConfig) {
   ASSERT_EQ(
       hiveConfig->orcWriterMaxDictionaryMemory(emptySession.get()),
       16L * 1024L * 1024L);
+  ASSERT_EQ(hiveConfig->orcWriterAsyncUpload(emptySession.get()), false);
   ASSERT_EQ(hiveConfig->sortWriterMaxOutputRows(emptySession.get()), 1024);
   ASSERT_EQ(
       hiveConfig->sortWriterMaxOutputBytes(emptySession.get()), 10UL << 20);
+  ASSERT_EQ(
+      hiveConfig->sortWriterNormalizedKeyMaxBytes(emptySession.get()), 128);
   ASSERT_EQ(hiveConfig->isPartitionPathAsLowerCase(emptySession.get()), true);
+  ASSERT_EQ(hiveConfig->decodingParallelismFactor(emptySession.get()), 0);
 }
 
 TEST(HiveConfigTest, overrideConfig) {
   const std::unordered_map<std::string, std::string> configFromFile = {
       {HiveConfig::kInsertExistingPartitionsBehavior, "OVERWRITE"},
       {HiveConfig::kMaxPartitionsPerWriters, "120"},
+      {HiveConfig::kMaxOpenWriters, "30"},
       {HiveConfig::kImmutablePartitions, "true"},
       {HiveConfig::kS3PathStyleAccess, "true"},
       {HiveConfig::kS3LogLevel, "Warning"},
@@ -84,12 +93,15 @@ TEST(HiveConfigTest, overrideConfig) {
       {HiveConfig::kFileColumnNamesReadAsLowerCase, "true"},
       {HiveConfig::kMaxCoalescedBytes, "100"},
       {HiveConfig::kMaxCoalescedDistanceBytes, "100"},
+      {HiveConfig::kAdaptivePrefetchRowGroups, "true"},
       {HiveConfig::kNumCacheFileHandles, "100"},
       {HiveConfig::kEnableFileHandleCache, "false"},
       {HiveConfig::kOrcWriterMaxStripeSize, "100MB"},
       {HiveConfig::kOrcWriterMaxDictionaryMemory, "100MB"},
+      {HiveConfig::kOrcWriterAsyncUpload, "true"},
       {HiveConfig::kSortWriterMaxOutputRows, "100"},
-      {HiveConfig::kSortWriterMaxOutputBytes, "100MB"}};
+      {HiveConfig::kSortWriterMaxOutputBytes, "100MB"},
+      {HiveConfig::kSortWriterNormalizedKeyMaxBytes, "64"}};
   HiveConfig* hiveConfig =
       new HiveConfig(std::make_shared<MemConfig>(configFromFile));
   auto emptySession = std::make_unique<MemConfig>();
@@ -98,6 +110,7 @@ TEST(HiveConfigTest, overrideConfig) {
       facebook::velox::connector::hive::HiveConfig::
           InsertExistingPartitionsBehavior::kOverwrite);
   ASSERT_EQ(hiveConfig->maxPartitionsPerWriters(emptySession.get()), 120);
+  ASSERT_EQ(hiveConfig->maxOpenWriters(emptySession.get()), 30);
   ASSERT_EQ(hiveConfig->immutablePartitions(), true);
   ASSERT_EQ(hiveConfig->s3UseVirtualAddressing(), false);
   ASSERT_EQ(hiveConfig->s3GetLogLevel(), "Warning");
@@ -116,6 +129,7 @@ TEST(HiveConfigTest, overrideConfig) {
       hiveConfig->isFileColumnNamesReadAsLowerCase(emptySession.get()), true);
   ASSERT_EQ(hiveConfig->maxCoalescedBytes(), 100);
   ASSERT_EQ(hiveConfig->maxCoalescedDistanceBytes(), 100);
+  ASSERT_EQ(hiveConfig->adaptivePrefetchRowGroups(), true);
   ASSERT_EQ(hiveConfig->numCacheFileHandles(), 100);
   ASSERT_EQ(hiveConfig->isFileHandleCacheEnabled(), false);
   ASSERT_EQ(
@@ -124,9 +138,12 @@ TEST(HiveConfigTest, overrideConfig) {
   ASSERT_EQ(
       hiveConfig->orcWriterMaxDictionaryMemory(emptySession.get()),
       100L * 1024L * 1024L);
+  ASSERT_EQ(hiveConfig->orcWriterAsyncUpload(emptySession.get()), true);
   ASSERT_EQ(hiveConfig->sortWriterMaxOutputRows(emptySession.get()), 100);
   ASSERT_EQ(
       hiveConfig->sortWriterMaxOutputBytes(emptySession.get()), 100UL << 20);
+  ASSERT_EQ(
+      hiveConfig->sortWriterNormalizedKeyMaxBytes(emptySession.get()), 64);
 }
 
 TEST(HiveConfigTest, overrideSession) {
@@ -135,18 +152,23 @@ TEST(HiveConfigTest, overrideSession) {
       {HiveConfig::kInsertExistingPartitionsBehaviorSession, "OVERWRITE"},
       {HiveConfig::kOrcUseColumnNamesSession, "true"},
       {HiveConfig::kFileColumnNamesReadAsLowerCaseSession, "true"},
+      {HiveConfig::kMaxOpenWritersSession, "12"},
       {HiveConfig::kOrcWriterMaxStripeSizeSession, "22MB"},
       {HiveConfig::kOrcWriterMaxDictionaryMemorySession, "22MB"},
+      {HiveConfig::kOrcWriterAsyncUploadSession, "true"},
       {HiveConfig::kSortWriterMaxOutputRowsSession, "20"},
       {HiveConfig::kSortWriterMaxOutputBytesSession, "20MB"},
+      {HiveConfig::kSortWriterNormalizedKeyMaxBytesSession, "0"},
       {HiveConfig::kPartitionPathAsLowerCaseSession, "false"},
-      {HiveConfig::kIgnoreMissingFilesSession, "true"}};
+      {HiveConfig::kIgnoreMissingFilesSession, "true"},
+      {HiveConfig::kDecodingParallelismFactorSession, "4"}};
   const auto session = std::make_unique<MemConfig>(sessionOverride);
   ASSERT_EQ(
       hiveConfig->insertExistingPartitionsBehavior(session.get()),
       facebook::velox::connector::hive::HiveConfig::
           InsertExistingPartitionsBehavior::kOverwrite);
   ASSERT_EQ(hiveConfig->maxPartitionsPerWriters(session.get()), 100);
+  ASSERT_EQ(hiveConfig->maxOpenWriters(session.get()), 12);
   ASSERT_EQ(hiveConfig->immutablePartitions(), false);
   ASSERT_EQ(hiveConfig->s3UseVirtualAddressing(), true);
   ASSERT_EQ(hiveConfig->s3GetLogLevel(), "FATAL");
@@ -165,6 +187,7 @@ TEST(HiveConfigTest, overrideSession) {
 
   ASSERT_EQ(hiveConfig->maxCoalescedBytes(), 128 << 20);
   ASSERT_EQ(hiveConfig->maxCoalescedDistanceBytes(), 512 << 10);
+  ASSERT_EQ(hiveConfig->adaptivePrefetchRowGroups(), false);
   ASSERT_EQ(hiveConfig->numCacheFileHandles(), 20'000);
   ASSERT_EQ(hiveConfig->isFileHandleCacheEnabled(), true);
   ASSERT_EQ(
@@ -172,8 +195,11 @@ TEST(HiveConfigTest, overrideSession) {
   ASSERT_EQ(
       hiveConfig->orcWriterMaxDictionaryMemory(session.get()),
       22L * 1024L * 1024L);
+  ASSERT_EQ(hiveConfig->orcWriterAsyncUpload(session.get()), true);
   ASSERT_EQ(hiveConfig->sortWriterMaxOutputRows(session.get()), 20);
+  ASSERT_EQ(hiveConfig->decodingParallelismFactor(session.get()), 4);
   ASSERT_EQ(hiveConfig->sortWriterMaxOutputBytes(session.get()), 20UL << 20);
+  ASSERT_EQ(hiveConfig->sortWriterNormalizedKeyMaxBytes(session.get()), 0);
   ASSERT_EQ(hiveConfig->isPartitionPathAsLowerCase(session.get()), false);
   ASSERT_EQ(hiveConfig->ignoreMissingFiles(session.get()), true);
 }
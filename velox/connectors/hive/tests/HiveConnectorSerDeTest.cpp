@@ -86,6 +86,31 @@ TEST_F(HiveConnectorSerDeTest, hiveTableHandle) {
   testSerde(*tableHandle);
 }
 
+TEST_F(HiveConnectorSerDeTest, hiveTableHandleWithAggregates) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  HiveTableHandle tableHandle(
+      exec::test::kHiveConnectorId,
+      "hive_table",
+      true,
+      {},
+      parseExpr("c0 > 10", rowType),
+      nullptr,
+      {},
+      {{HiveAggregate::Kind::kCount, ""},
+       {HiveAggregate::Kind::kMin, "c0"},
+       {HiveAggregate::Kind::kMax, "c1"}});
+  ASSERT_NE(
+      tableHandle.toString().find("aggregates: [count(*), min(c0), max(c1)]"),
+      std::string::npos);
+  testSerde(tableHandle);
+
+  auto clone =
+      ISerializable::deserialize<HiveTableHandle>(tableHandle.serialize());
+  ASSERT_EQ(clone->aggregates().size(), 3);
+  ASSERT_EQ(clone->aggregates()[1].kind, HiveAggregate::Kind::kMin);
+  ASSERT_EQ(clone->aggregates()[1].column, "c0");
+}
+
 TEST_F(HiveConnectorSerDeTest, hiveColumnHandle) {
   auto columnType = ROW(
       {{"c0c0", BIGINT()},
@@ -406,6 +406,41 @@ TEST_F(HiveConnectorTest, makeScanSpec_duplicateSubfields) {
   ASSERT_EQ(c1->children().size(), 2);
 }
 
+TEST_F(HiveConnectorTest, makeScanSpec_filterOnMapSubscript) {
+  auto rowType =
+      ROW({{"c0", MAP(BIGINT(), BIGINT())}, {"c1", MAP(VARCHAR(), BIGINT())}});
+  SubfieldFilters filters;
+  filters.emplace(Subfield("c0[10]"), exec::equal(42));
+  filters.emplace(Subfield("c1[\"foo\"]"), exec::isNotNull());
+  auto scanSpec = makeScanSpec(
+      rowType,
+      groupSubfields(makeSubfields({"c0[20]", "c1[\"bar\"]"})),
+      filters,
+      rowType,
+      {},
+      {},
+      pool_.get());
+  auto* c0 = scanSpec->childByName("c0");
+  ASSERT_TRUE(c0->hasFilter());
+  // The filtered keys are read.
+  auto* keysFilter = c0->childByName(ScanSpec::kMapKeysFieldName)->filter();
+  ASSERT_TRUE(applyFilter(*keysFilter, 10));
+  ASSERT_TRUE(applyFilter(*keysFilter, 20));
+  ASSERT_FALSE(applyFilter(*keysFilter, 15));
+  auto* c0Key = c0->childByName("[10]");
+  ASSERT_TRUE(c0Key);
+  ASSERT_EQ(c0Key->mapKey(), "10");
+  ASSERT_TRUE(c0Key->filter());
+  ASSERT_TRUE(c0->childByName(ScanSpec::kMapKeysFieldName)->mapKey() ==
+              std::nullopt);
+  auto* c1 = scanSpec->childByName("c1");
+  ASSERT_TRUE(c1->hasFilter());
+  auto* c1Key = c1->childByName("[\"foo\"]");
+  ASSERT_TRUE(c1Key);
+  ASSERT_EQ(c1Key->mapKey(), "foo");
+  ASSERT_EQ(c1Key->filter()->kind(), FilterKind::kIsNotNull);
+}
+
 // For TEXTFILE, partition key is not included in data columns.
 TEST_F(HiveConnectorTest, makeScanSpec_filterPartitionKey) {
   auto rowType = ROW({{"c0", BIGINT()}});
@@ -475,6 +510,44 @@ TEST_F(HiveConnectorTest, extractFiltersFromRemainingFilter) {
       remaining->toString(), "not(lt(ROW[\"c2\"],cast 0 as DECIMAL(20, 0)))");
 }
 
+TEST_F(HiveConnectorTest, extractDisjunctionsFromRemainingFilter) {
+  core::QueryCtx queryCtx;
+  exec::SimpleExpressionEvaluator evaluator(&queryCtx, pool_.get());
+  auto rowType = ROW({"c0", "c1", "c2"}, {BIGINT(), BOOLEAN(), BIGINT()});
+
+  auto expr = parseExpr("c0 in (1, 5, 7) or c0 > 100", rowType);
+  SubfieldFilters filters;
+  double sampleRate = 1;
+  auto remaining = extractFiltersFromRemainingFilter(
+      expr, &evaluator, false, filters, sampleRate);
+  ASSERT_FALSE(remaining);
+  ASSERT_EQ(filters.size(), 1);
+  auto& bigintFilter = filters.at(Subfield("c0"));
+  ASSERT_EQ(bigintFilter->kind(), FilterKind::kBigintMultiRange);
+  ASSERT_TRUE(bigintFilter->testInt64(5));
+  ASSERT_FALSE(bigintFilter->testInt64(6));
+  ASSERT_TRUE(bigintFilter->testInt64(101));
+
+  expr = parseExpr("c1 = true or c1 = false", rowType);
+  filters.clear();
+  remaining = extractFiltersFromRemainingFilter(
+      expr, &evaluator, false, filters, sampleRate);
+  ASSERT_FALSE(remaining);
+  ASSERT_EQ(filters.size(), 1);
+  auto& boolFilter = filters.at(Subfield("c1"));
+  ASSERT_EQ(boolFilter->kind(), FilterKind::kIsNotNull);
+  ASSERT_FALSE(boolFilter->testNull());
+
+  // Disjunctions that no filter evaluates stay in the remaining filter.
+  expr = parseExpr("c2 not in (1, 5) or c2 > 100", rowType);
+  filters.clear();
+  remaining = extractFiltersFromRemainingFilter(
+      expr, &evaluator, false, filters, sampleRate);
+  ASSERT_TRUE(remaining);
+  ASSERT_EQ(*remaining, *expr);
+  ASSERT_TRUE(filters.empty());
+}
+
 TEST_F(HiveConnectorTest, prestoTableSampling) {
   core::QueryCtx queryCtx;
   exec::SimpleExpressionEvaluator evaluator(&queryCtx, pool_.get());
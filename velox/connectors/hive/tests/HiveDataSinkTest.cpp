@@ -17,7 +17,9 @@
 #include <gtest/gtest.h>
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <re2/re2.h>
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -150,7 +152,8 @@ class HiveDataSinkTest : public exec::test::HiveConnectorTestBase {
       dwio::common::FileFormat fileFormat = dwio::common::FileFormat::DWRF,
       const std::vector<std::string>& partitionedBy = {},
       const std::shared_ptr<connector::hive::HiveBucketProperty>&
-          bucketProperty = nullptr) {
+          bucketProperty = nullptr,
+      folly::Executor* executor = nullptr) {
     return std::make_shared<HiveDataSink>(
         rowType,
         createHiveInsertTableHandle(
@@ -161,7 +164,8 @@ class HiveDataSinkTest : public exec::test::HiveConnectorTestBase {
             bucketProperty),
         connectorQueryCtx_.get(),
         CommitStrategy::kNoCommit,
-        connectorConfig_);
+        connectorConfig_,
+        executor);
   }
 
   std::vector<std::string> listFiles(const std::string& dirPath) {
@@ -485,7 +489,10 @@ TEST_F(HiveDataSinkTest, basic) {
       "spillFillTimeUs[0us] spillSortTime[0us] spillSerializationTime[0us] "
       "spillWrites[0] spillFlushTime[0us] spillWriteTime[0us] "
       "maxSpillExceededLimitCount[0] spillReadBytes[0B] spillReads[0] "
-      "spillReadTime[0us] spillReadDeserializationTime[0us]");
+      "spillReadTime[0us] spillReadDeserializationTime[0us] "
+      "spillMergePasses[0] spillMergeBytes[0B] spillWriteWaitTime[0us] "
+      "spillReadAheadTime[0us] spillReadAheadWaitTime[0us] "
+      "spilledFallbackBytes[0B]");
 
   const int numBatches = 10;
   const auto vectors = createVectors(500, numBatches);
@@ -540,6 +547,68 @@ TEST_F(HiveDataSinkTest, close) {
   }
 }
 
+TEST_F(HiveDataSinkTest, finish) {
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  const auto vectors = createVectors(500, 10);
+  createDuckDbTable(vectors);
+
+  {
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = createDataSink(
+        rowType_,
+        outputDirectory->getPath(),
+        dwio::common::FileFormat::DWRF,
+        {},
+        nullptr,
+        executor.get());
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    // The writers are closed on the executor.
+    ContinueFuture future = ContinueFuture::makeEmpty();
+    ASSERT_FALSE(dataSink->finish(future));
+    VELOX_ASSERT_THROW(
+        dataSink->appendData(vectors[0]), "Hive data sink is finishing");
+    future.wait();
+    ASSERT_TRUE(dataSink->finish(future));
+    const auto partitions = dataSink->close();
+    ASSERT_EQ(partitions.size(), 1);
+    ASSERT_GT(dataSink->stats().numWrittenBytes, 0);
+    verifyWrittenData(outputDirectory->getPath());
+  }
+
+  {
+    // Without an executor, the writers are closed by close().
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = createDataSink(rowType_, outputDirectory->getPath());
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    ContinueFuture future = ContinueFuture::makeEmpty();
+    ASSERT_TRUE(dataSink->finish(future));
+    ASSERT_FALSE(future.valid());
+    ASSERT_EQ(dataSink->close().size(), 1);
+    verifyWrittenData(outputDirectory->getPath());
+  }
+
+  {
+    // Abort waits for the writers being closed on the executor.
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = createDataSink(
+        rowType_,
+        outputDirectory->getPath(),
+        dwio::common::FileFormat::DWRF,
+        {},
+        nullptr,
+        executor.get());
+    dataSink->appendData(vectors[0]);
+    ContinueFuture future = ContinueFuture::makeEmpty();
+    ASSERT_FALSE(dataSink->finish(future));
+    dataSink->abort();
+    ASSERT_TRUE(future.isReady());
+  }
+}
+
 TEST_F(HiveDataSinkTest, abort) {
   for (bool empty : {true, false}) {
     SCOPED_TRACE(fmt::format("Data sink is empty: {}", empty));
@@ -568,6 +637,74 @@ TEST_F(HiveDataSinkTest, abort) {
   }
 }
 
+TEST_F(HiveDataSinkTest, maxOpenWriters) {
+  const auto rowType = ROW({"c0", "p"}, {BIGINT(), INTEGER()});
+  const int32_t numPartitions = 4;
+  const int32_t numBatches = 8;
+  const int32_t batchSize = 100;
+  // Each batch goes to a single partition, so that a limit of 2 open writers
+  // closes a writer for every batch after the first two.
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < numBatches; ++i) {
+    vectors.push_back(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int64_t>(
+             batchSize, [&](auto row) { return i * batchSize + row; }),
+         makeConstant(i % numPartitions, batchSize)}));
+  }
+  createDuckDbTable(vectors);
+
+  for (uint32_t maxOpenWriters : {0, 2}) {
+    SCOPED_TRACE(fmt::format("maxOpenWriters: {}", maxOpenWriters));
+    connectorSessionProperties_ = std::make_shared<core::MemConfig>(
+        std::unordered_map<std::string, std::string>{
+            {HiveConfig::kMaxOpenWritersSession,
+             std::to_string(maxOpenWriters)}});
+    setupMemoryPools();
+
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = createDataSink(
+        rowType,
+        outputDirectory->getPath(),
+        dwio::common::FileFormat::DWRF,
+        {"p"});
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    const auto partitions = dataSink->close();
+    const int32_t numFiles = maxOpenWriters == 0 ? numPartitions : numBatches;
+    ASSERT_EQ(dataSink->stats().numWrittenFiles, numFiles);
+    ASSERT_EQ(partitions.size(), numPartitions);
+    for (const auto& partition : partitions) {
+      const auto obj = folly::parseJson(partition);
+      ASSERT_EQ(
+          obj["rowCount"].asInt(), numBatches / numPartitions * batchSize);
+      const auto& fileWriteInfos = obj["fileWriteInfos"];
+      ASSERT_EQ(fileWriteInfos.size(), numFiles / numPartitions);
+      int64_t fileSizes{0};
+      std::unordered_set<std::string> fileNames;
+      for (const auto& fileWriteInfo : fileWriteInfos) {
+        ASSERT_GT(fileWriteInfo["fileSize"].asInt(), 0);
+        fileSizes += fileWriteInfo["fileSize"].asInt();
+        fileNames.insert(fileWriteInfo["writeFileName"].asString());
+      }
+      ASSERT_EQ(fileNames.size(), fileWriteInfos.size());
+      ASSERT_EQ(fileSizes, obj["onDiskDataSizeInBytes"].asInt());
+    }
+
+    const auto filePaths = listFiles(outputDirectory->getPath());
+    ASSERT_EQ(filePaths.size(), numFiles);
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+    for (const auto& filePath : filePaths) {
+      splits.push_back(makeHiveConnectorSplit(filePath));
+    }
+    HiveConnectorTestBase::assertQuery(
+        PlanBuilder().tableScan(ROW({"c0"}, {BIGINT()})).planNode(),
+        splits,
+        "SELECT c0 FROM tmp");
+  }
+}
+
 TEST_F(HiveDataSinkTest, memoryReclaim) {
   const int numBatches = 200;
   auto vectors = createVectors(500, 200);
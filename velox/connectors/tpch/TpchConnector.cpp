@@ -28,24 +28,33 @@ RowVectorPtr getTpchData(
     size_t maxRows,
     size_t offset,
     double scaleFactor,
+    const std::vector<column_index_t>& columns,
     memory::MemoryPool* pool) {
   switch (table) {
     case Table::TBL_PART:
-      return velox::tpch::genTpchPart(pool, maxRows, offset, scaleFactor);
+      return velox::tpch::genTpchPart(
+          pool, maxRows, offset, scaleFactor, columns);
     case Table::TBL_SUPPLIER:
-      return velox::tpch::genTpchSupplier(pool, maxRows, offset, scaleFactor);
+      return velox::tpch::genTpchSupplier(
+          pool, maxRows, offset, scaleFactor, columns);
     case Table::TBL_PARTSUPP:
-      return velox::tpch::genTpchPartSupp(pool, maxRows, offset, scaleFactor);
+      return velox::tpch::genTpchPartSupp(
+          pool, maxRows, offset, scaleFactor, columns);
     case Table::TBL_CUSTOMER:
-      return velox::tpch::genTpchCustomer(pool, maxRows, offset, scaleFactor);
+      return velox::tpch::genTpchCustomer(
+          pool, maxRows, offset, scaleFactor, columns);
     case Table::TBL_ORDERS:
-      return velox::tpch::genTpchOrders(pool, maxRows, offset, scaleFactor);
+      return velox::tpch::genTpchOrders(
+          pool, maxRows, offset, scaleFactor, columns);
     case Table::TBL_LINEITEM:
-      return velox::tpch::genTpchLineItem(pool, maxRows, offset, scaleFactor);
+      return velox::tpch::genTpchLineItem(
+          pool, maxRows, offset, scaleFactor, columns);
     case Table::TBL_NATION:
-      return velox::tpch::genTpchNation(pool, maxRows, offset, scaleFactor);
+      return velox::tpch::genTpchNation(
+          pool, maxRows, offset, scaleFactor, columns);
     case Table::TBL_REGION:
-      return velox::tpch::genTpchRegion(pool, maxRows, offset, scaleFactor);
+      return velox::tpch::genTpchRegion(
+          pool, maxRows, offset, scaleFactor, columns);
   }
   return nullptr;
 }
@@ -103,14 +112,21 @@ TpchDataSource::TpchDataSource(
     outputColumnMappings_.emplace_back(*idx);
   }
   outputType_ = outputType;
+  // With no output columns, e.g. for count(*), only one column is generated to
+  // count the rows.
+  generatedColumns_ = outputColumnMappings_.empty()
+      ? std::vector<column_index_t>{0}
+      : outputColumnMappings_;
 }
 
 RowVectorPtr TpchDataSource::projectOutputColumns(RowVectorPtr inputVector) {
+  // 'inputVector' has the columns in 'generatedColumns_', so the output columns
+  // are its first ones.
   std::vector<VectorPtr> children;
   children.reserve(outputColumnMappings_.size());
 
-  for (const auto channel : outputColumnMappings_) {
-    children.emplace_back(inputVector->childAt(channel));
+  for (auto i = 0; i < outputColumnMappings_.size(); ++i) {
+    children.emplace_back(inputVector->childAt(i));
   }
 
   return std::make_shared<RowVector>(
@@ -143,8 +159,13 @@ std::optional<RowVectorPtr> TpchDataSource::next(
       currentSplit_, "No split to process. Call addSplit() first.");
 
   size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
-  auto outputVector =
-      getTpchData(tpchTable_, maxRows, splitOffset_, scaleFactor_, pool_);
+  auto outputVector = getTpchData(
+      tpchTable_,
+      maxRows,
+      splitOffset_,
+      scaleFactor_,
+      generatedColumns_,
+      pool_);
 
   // If the split is exhausted.
   if (!outputVector || outputVector->size() == 0) {
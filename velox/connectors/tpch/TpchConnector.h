@@ -113,6 +113,10 @@ class TpchDataSource : public DataSource {
   // dbgen generated datasets.
   std::vector<column_index_t> outputColumnMappings_;
 
+  // Columns of the dbgen generated datasets that are copied into vectors.
+  // Same as 'outputColumnMappings_' unless there are no output columns.
+  std::vector<column_index_t> generatedColumns_;
+
   std::shared_ptr<TpchConnectorSplit> currentSplit_;
 
   // First (splitOffset_) and last (splitEnd_) row number that should be
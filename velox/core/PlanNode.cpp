@@ -1057,11 +1057,15 @@ void HashJoinNode::addDetails(std::stringstream& stream) const {
   if (nullAware_) {
     stream << ", null aware";
   }
+  if (sharedBuildTable_) {
+    stream << ", shared build table";
+  }
 }
 
 folly::dynamic HashJoinNode::serialize() const {
   auto obj = serializeBase();
   obj["nullAware"] = nullAware_;
+  obj["sharedBuildTable"] = sharedBuildTable_;
   return obj;
 }
 
@@ -1081,6 +1085,10 @@ PlanNodePtr HashJoinNode::create(const folly::dynamic& obj, void* context) {
 
   auto outputType = deserializeRowType(obj["outputType"]);
 
+  const bool sharedBuildTable = obj.count("sharedBuildTable")
+      ? obj["sharedBuildTable"].asBool()
+      : false;
+
   return std::make_shared<HashJoinNode>(
       deserializePlanNodeId(obj),
       joinTypeFromName(obj["joinType"].asString()),
@@ -1090,7 +1098,8 @@ PlanNodePtr HashJoinNode::create(const folly::dynamic& obj, void* context) {
       filter,
       sources[0],
       sources[1],
-      outputType);
+      outputType,
+      sharedBuildTable);
 }
 
 folly::dynamic MergeJoinNode::serialize() const {
@@ -1575,7 +1575,8 @@ class HashJoinNode : public AbstractJoinNode {
       TypedExprPtr filter,
       PlanNodePtr left,
       PlanNodePtr right,
-      RowTypePtr outputType)
+      RowTypePtr outputType,
+      bool sharedBuildTable = false)
       : AbstractJoinNode(
             id,
             joinType,
@@ -1585,7 +1586,14 @@ class HashJoinNode : public AbstractJoinNode {
             std::move(left),
             std::move(right),
             std::move(outputType)),
-        nullAware_{nullAware} {
+        nullAware_{nullAware},
+        sharedBuildTable_{sharedBuildTable} {
+    if (sharedBuildTable) {
+      VELOX_USER_CHECK(
+          isSharedBuildTableSupported(joinType),
+          "Shared build table is not supported for {} join",
+          joinTypeName(joinType));
+    }
     if (nullAware) {
       VELOX_USER_CHECK(
           isNullAwareSupported(joinType),
@@ -1610,14 +1618,31 @@ class HashJoinNode : public AbstractJoinNode {
     // filter set. It requires to cross join the null-key probe rows with all
     // the build-side rows for filter evaluation which is not supported under
     // spilling.
+    // NOTE: a shared build table is probed by the tasks of the query that do
+    // not own it, so it can't be spilled.
     return !(isAntiJoin() && nullAware_ && filter() != nullptr) &&
-        queryConfig.joinSpillEnabled();
+        !sharedBuildTable_ && queryConfig.joinSpillEnabled();
   }
 
   bool isNullAware() const {
     return nullAware_;
   }
 
+  /// If true, the build side is broadcast to all the tasks of the query and
+  /// the tasks running on the same node share one hash table, built by the
+  /// first of them. The other tasks discard their build side input. Only
+  /// supported for the join types that do not update the hash table while
+  /// probing.
+  bool sharedBuildTable() const {
+    return sharedBuildTable_;
+  }
+
+  static bool isSharedBuildTableSupported(JoinType joinType) {
+    return joinType == JoinType::kInner || joinType == JoinType::kLeft ||
+        joinType == JoinType::kLeftSemiFilter ||
+        joinType == JoinType::kLeftSemiProject || joinType == JoinType::kAnti;
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -1626,6 +1651,7 @@ class HashJoinNode : public AbstractJoinNode {
   void addDetails(std::stringstream& stream) const override;
 
   const bool nullAware_;
+  const bool sharedBuildTable_;
 };
 
 /// Represents inner/outer/semi/anti merge joins. Translates to an
@@ -2278,6 +2304,10 @@ class MarkDistinctNode : public PlanNode {
     return "MarkDistinct";
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.markDistinctSpillEnabled();
+  }
+
   const std::string& markerName() const {
     return markerName_;
   }
@@ -73,6 +73,31 @@ class QueryConfig {
   static constexpr const char* kQueryMaxMemoryPerNode =
       "query_max_memory_per_node";
 
+  /// The priority class of the query for memory arbitration: 'BATCH',
+  /// 'DEFAULT' or 'INTERACTIVE'. The arbitrator spills and aborts the queries
+  /// of lower classes first and a query doesn't spill the queries of higher
+  /// classes to grow unless it is below its guaranteed memory.
+  static constexpr const char* kQueryPriority = "query_priority";
+
+  /// The memory capacity guaranteed to the query on a single host. The memory
+  /// arbitrator doesn't shrink or spill the query below this capacity.
+  static constexpr const char* kQueryGuaranteedMemoryPerNode =
+      "query_guaranteed_memory_per_node";
+
+  /// If true, operators that know their memory needs ahead of the next input
+  /// grow their reservation on the spill executor while the driver is blocked
+  /// with BlockingReason::kWaitForMemory, instead of running the memory
+  /// arbitration on the driver thread. Requires a spill executor.
+  static constexpr const char* kAsyncMemoryReservationEnabled =
+      "async_memory_reservation_enabled";
+
+  /// If > 0, each operator samples the used and reserved bytes of its memory
+  /// pool and its spilled bytes at most once per this many milliseconds. The
+  /// samples are reported in OperatorStats::memoryTimeline. 0 disables the
+  /// sampling.
+  static constexpr const char* kOperatorMemoryTimelineIntervalMs =
+      "operator_memory_timeline_interval_ms";
+
   /// User provided session timezone. Stores a string with the actual timezone
   /// name, e.g: "America/Los_Angeles".
   static constexpr const char* kSessionTimezone = "session_timezone";
@@ -95,6 +120,12 @@ class QueryConfig {
   static constexpr const char* kExprEvalSimplified =
       "expression.eval_simplified";
 
+  /// Whether to evaluate trees of floating point arithmetic and comparisons in
+  /// one pass over blocks of rows instead of one vector per call. False by
+  /// default.
+  static constexpr const char* kExprFusionEnabled =
+      "expression.fusion_enabled";
+
   /// Whether to track CPU usage for individual expressions (supported by call
   /// and cast expressions). False by default. Can be expensive when processing
   /// small batches, e.g. < 10K rows.
@@ -120,6 +151,13 @@ class QueryConfig {
   static constexpr const char* kMaxLocalExchangeBufferSize =
       "max_local_exchange_buffer_size";
 
+  /// Operators that keep their input vectors, i.e. local exchange and the
+  /// build side of nested loop joins, copy the strings of an input vector to
+  /// tight buffers if the strings take less than this ratio of the string
+  /// buffers held by the vector. 0 disables the copy.
+  static constexpr const char* kRetainedStringBufferMinLiveRatio =
+      "retained_string_buffer_min_live_ratio";
+
   /// Maximum size in bytes to accumulate in ExchangeQueue. Enforced
   /// approximately, not strictly.
   static constexpr const char* kMaxExchangeBufferSize =
@@ -133,6 +171,15 @@ class QueryConfig {
   static constexpr const char* kMaxPartialAggregationMemory =
       "max_partial_aggregation_memory";
 
+  /// If true, partial aggregation checks whether each input batch is
+  /// clustered on the grouping keys, i.e. the rows of each group are
+  /// consecutive and only the group of the first row was seen before. While
+  /// all the input since the last flush is clustered, the groups are flushed
+  /// once there are enough of them for an output batch, as the groups other
+  /// than the last one will not see more input.
+  static constexpr const char* kPartialAggregationClusteredFlushEnabled =
+      "partial_aggregation_clustered_flush_enabled";
+
   static constexpr const char* kMaxExtendedPartialAggregationMemory =
       "max_extended_partial_aggregation_memory";
 
@@ -142,6 +189,63 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// Number of input rows after which partial aggregation estimates the number
+  /// of distinct grouping keys with a HyperLogLog sketch of the key hashes and
+  /// abandons if the estimate equals or exceeds
+  /// 'kAbandonPartialAggregationMinPct' of the input rows. Unlike the check
+  /// after 'kAbandonPartialAggregationMinRows', the estimate covers the input
+  /// across the partial aggregation flushes. 0 disables the sketch.
+  static constexpr const char* kAbandonPartialAggregationSketchRows =
+      "abandon_partial_aggregation_sketch_rows";
+
+  /// Percentage of the variable width memory of a hash aggregation that may be
+  /// on the free lists before the aggregation copies the live variable width
+  /// data of its groups to a new arena and frees the fragmented one. Only
+  /// applies if all the aggregate functions support relocation. 0 disables
+  /// the compaction.
+  static constexpr const char* kAggregationCompactionFragmentationPct =
+      "aggregation_compaction_fragmentation_pct";
+
+  /// If true, an aggregation of raw input over a GroupId node first
+  /// aggregates the input once on all the grouping keys, then expands the
+  /// partial results to the grouping sets and merges them per grouping set.
+  /// This hashes each distinct combination of keys once per grouping set
+  /// instead of each input row. Only applies to aggregations without masks,
+  /// sorting keys or distinct.
+  static constexpr const char* kGroupingSetsRollupEnabled =
+      "grouping_sets_rollup_enabled";
+
+  /// If true, a single aggregation whose aggregates are all distinct over the
+  /// same columns first removes duplicate rows with a hash aggregation on the
+  /// grouping keys and these columns, then aggregates without distinct. Unlike
+  /// the per group sets of distinct aggregates, the hash aggregation spills by
+  /// hash partition.
+  static constexpr const char* kDistinctAggregationAsGroupByEnabled =
+      "distinct_aggregation_as_group_by_enabled";
+
+  /// If true, the Task adjusts the number of running drivers of pipelines
+  /// that start with a TableScan and consist of operators that do not depend
+  /// on their peers, e.g. FilterProject, partial aggregation and the probe of
+  /// inner or left joins. Drivers are parked between splits while they spend
+  /// most time blocked on input or output and resumed while the running ones
+  /// are busy.
+  static constexpr const char* kElasticDriversEnabled =
+      "elastic_drivers_enabled";
+
+  /// Least number of running drivers of an elastic pipeline.
+  static constexpr const char* kElasticDriversMinPerPipeline =
+      "elastic_drivers_min_per_pipeline";
+
+  /// Most number of running drivers of an elastic pipeline. 0 means the number
+  /// of drivers the pipeline would have without elasticity.
+  static constexpr const char* kElasticDriversMaxPerPipeline =
+      "elastic_drivers_max_per_pipeline";
+
+  /// Interval at which the Task decides whether to add or retire a driver of
+  /// an elastic pipeline.
+  static constexpr const char* kElasticDriversAdjustIntervalMs =
+      "elastic_drivers_adjust_interval_ms";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
@@ -153,6 +257,47 @@ class QueryConfig {
 
   static constexpr const char* kMaxOutputBufferSize = "max_output_buffer_size";
 
+  /// Target size in bytes of the pages a partitioned output buffer gives to
+  /// its consumers. Smaller pages enqueued for the same destination are
+  /// merged into one page of up to this size. 0 disables merging.
+  static constexpr const char* kOutputBufferCoalesceTargetBytes =
+      "output_buffer_coalesce_target_bytes";
+
+  /// Maximum time in milliseconds a small page waits in a partitioned output
+  /// buffer to be merged with later pages. Checked when pages are enqueued or
+  /// fetched.
+  static constexpr const char* kOutputBufferCoalesceMaxDelayMs =
+      "output_buffer_coalesce_max_delay_ms";
+
+  /// If true, a partitioned output buffer that exceeds kMaxOutputBufferSize
+  /// writes the pages its slowest consumers have not fetched yet to the
+  /// task's spill directory instead of blocking the producers. The pages are
+  /// read back when the consumers fetch them.
+  static constexpr const char* kOutputBufferSpillEnabled =
+      "output_buffer_spill_enabled";
+
+  /// If true, the PartitionedOutput operator keeps the dictionary and
+  /// constant encodings of the output columns in the serialized pages and the
+  /// Exchange operator outputs each page as a separate batch so that the
+  /// encodings are kept on the consumer side too.
+  static constexpr const char* kPartitionedOutputPreserveEncodings =
+      "partitioned_output_preserve_encodings";
+
+  /// Maximum CPU time in nanoseconds the PartitionedOutput operator may spend
+  /// compressing per byte saved. Each destination stops compressing for a
+  /// while when its pages take longer, and retries later. 0 means no limit.
+  /// Only used when exchange compression is enabled.
+  static constexpr const char*
+      kPartitionedOutputMaxCompressionNanosPerSavedByte =
+          "partitioned_output_max_compression_nanos_per_saved_byte";
+
+  /// If true, the Exchange operator outputs lazy vectors. A column is
+  /// deserialized only when it is first accessed, so that columns that are
+  /// dropped or only needed for the rows passing a filter are not decoded for
+  /// all rows.
+  static constexpr const char* kExchangeLazyDeserialization =
+      "exchange_lazy_deserialization";
+
   /// Preferred size of batches in bytes to be returned by operators from
   /// Operator::getOutput. It is used when an estimate of average row size is
   /// known. Otherwise kPreferredOutputBatchRows is used.
@@ -172,12 +317,36 @@ class QueryConfig {
   /// output rows.
   static constexpr const char* kMaxOutputBatchRows = "max_output_batch_rows";
 
+  /// If not zero, operators size their output batches to about this many
+  /// bytes instead of kPreferredOutputBatchBytes, e.g. a part of the L2 cache.
+  /// Operators that have no estimate of their row size use the average size
+  /// of the rows they have produced so far, and TableScan sizes the batches
+  /// it reads from the width of the rows it returned.
+  static constexpr const char* kAdaptiveOutputBatchBytes =
+      "adaptive_output_batch_bytes";
+
+  /// If true, the batches produced by filters, hash probes and unnests are
+  /// merged into batches of about the output batch size before they reach
+  /// the next operator. Batches that are already large pass through.
+  static constexpr const char* kCoalesceBatches = "coalesce_batches";
+
+  /// Max time rows wait to be merged with later rows when kCoalesceBatches is
+  /// set.
+  static constexpr const char* kCoalesceBatchesMaxDelayMs =
+      "coalesce_batches_max_delay_ms";
+
   /// TableScan operator will exit getOutput() method after this many
   /// milliseconds even if it has no data to return yet. Zero means 'no time
   /// limit'.
   static constexpr const char* kTableScanGetOutputTimeLimitMs =
       "table_scan_getoutput_time_limit_ms";
 
+  /// If true, TableScan replays the output of splits from the process-wide
+  /// SplitResultCache, if one is set, and adds the output of the splits it
+  /// reads to the cache.
+  static constexpr const char* kSplitResultCacheEnabled =
+      "split_result_cache_enabled";
+
   /// If false, the 'group by' code is forced to use generic hash mode
   /// hashtable.
   static constexpr const char* kHashAdaptivityEnabled =
@@ -195,6 +364,14 @@ class QueryConfig {
   static constexpr const char* kAggregationSpillEnabled =
       "aggregation_spill_enabled";
 
+  /// If true, the final aggregation spills its groups hash partitioned without
+  /// sorting and aggregates one spilled partition at a time when producing the
+  /// output, recursively spilling a partition which still doesn't fit in
+  /// memory up to 'kMaxSpillLevel'. If false, the spilled groups are sorted and
+  /// the sorted runs are merged when producing the output.
+  static constexpr const char* kAggregationSpillPartitioned =
+      "aggregation_spill_partitioned";
+
   /// Join spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kJoinSpillEnabled = "join_spill_enabled";
 
@@ -212,6 +389,10 @@ class QueryConfig {
   static constexpr const char* kRowNumberSpillEnabled =
       "row_number_spill_enabled";
 
+  /// MarkDistinct spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kMarkDistinctSpillEnabled =
+      "mark_distinct_spill_enabled";
+
   /// TopNRowNumber spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kTopNRowNumberSpillEnabled =
       "topn_row_number_spill_enabled";
@@ -230,8 +411,9 @@ class QueryConfig {
   static constexpr const char* kMaxSpillBytes = "max_spill_bytes";
 
   /// The max allowed spilling level with zero being the initial spilling level.
-  /// This only applies for hash build spilling which might trigger recursive
-  /// spilling when the build table is too big. If it is set to -1, then there
+  /// This only applies for hash build spilling and partitioned aggregation
+  /// spilling which might trigger recursive spilling when the build table or
+  /// the aggregation is too big. If it is set to -1, then there
   /// is no limit and then some extreme large query might run out of spilling
   /// partition bits (see kSpillPartitionBits) at the end. The max spill level
   /// is used in production to prevent some bad user queries from using too much
@@ -253,10 +435,45 @@ class QueryConfig {
 
   /// Config used to create spill files. This config is provided to underlying
   /// file system and the config is free form. The form should be defined by the
-  /// underlying file system.
+  /// underlying file system. The local file system takes a comma separated
+  /// list of 'io_uring' and 'direct', see LocalFileOptions.
   static constexpr const char* kSpillFileCreateConfig =
       "spill_file_create_config";
 
+  /// The max number of sorted spill files to merge at once when reading back
+  /// sorted spill data, e.g. the spill runs of order by or aggregation. Each
+  /// merged file takes a read buffer of up to 1MB. If there are more files,
+  /// groups of these are first merged into larger intermediate files in as
+  /// many passes as needed. If it is zero, then all files are merged at once.
+  static constexpr const char* kSpillMaxMergeFanIn = "spill_max_merge_fan_in";
+
+  /// The max bytes of serialized spill data waiting to be written to a spill
+  /// file on the spill executor while the spilling thread serializes the next
+  /// data. If it is zero or the query has no spill executor, then spill data
+  /// is written on the spilling thread.
+  static constexpr const char* kSpillWriteBehindBytes =
+      "spill_write_behind_bytes";
+
+  /// The max bytes of read-ahead buffers of the spill files read at once by
+  /// a sorted merge of spill data. Each file within the budget reads its next
+  /// buffer on the spill executor while the current one is consumed. If it is
+  /// zero or the query has no spill executor, then there is no read-ahead.
+  static constexpr const char* kSpillReadAheadBytes = "spill_read_ahead_bytes";
+
+  /// If true, spill files are written in a columnar format that keeps the
+  /// dictionary and constant encodings of the spilled columns and stores
+  /// flat integers and strings with lightweight compression. If false, spill
+  /// files are written in the Presto serialization format.
+  static constexpr const char* kSpillColumnarFormat = "spill_columnar_format";
+
+  /// If not zero and spill compression is zstd, each spill writer trains a
+  /// zstd dictionary of up to this many bytes on its first spilled batch and
+  /// compresses its spill pages with it. The dictionary is kept in memory
+  /// with the spill file info for reading. Not used with the columnar spill
+  /// format.
+  static constexpr const char* kSpillZstdDictionarySize =
+      "spill_zstd_dictionary_size";
+
   /// Default offset spill start partition bit.
   static constexpr const char* kSpillStartPartitionBit =
       "spiller_start_partition_bit";
@@ -316,6 +533,56 @@ class QueryConfig {
   static constexpr const char* kHashProbeFinishEarlyOnEmptyBuild =
       "hash_probe_finish_early_on_empty_build";
 
+  /// The maximum size in bytes of a Bloom filter built from the keys of a hash
+  /// join build side and pushed down into the probe side table scan. Used for
+  /// join keys that have too many distinct values for an IN-list filter. 0
+  /// disables the Bloom filter pushdown.
+  static constexpr const char* kHashProbeBloomFilterPushdownMaxSize =
+      "hash_probe_bloom_filter_pushdown_max_size";
+
+  /// The minimum size in bytes of a hash join table in hash mode for which
+  /// the probe rows of a batch are radix-partitioned by bucket offset before
+  /// probing. Each partition covers a cache-sized range of the table. 0
+  /// disables partitioned probing.
+  static constexpr const char* kHashProbePartitionedProbeMinTableSize =
+      "hash_probe_partitioned_probe_min_table_size";
+
+  /// If true, the hash probe returns the build side output columns as lazy
+  /// vectors that extract the values of the matched build rows on first
+  /// access. Helps joins with wide build sides when most of the build columns
+  /// are read for few of the output rows, e.g. after a selective filter.
+  /// Ignored if spilling is enabled for the join.
+  static constexpr const char* kHashProbeLazyBuildColumns =
+      "hash_probe_lazy_build_columns";
+
+  /// The minimum total width in bytes of the fixed width payload columns of a
+  /// hash join build side or an order by for which these columns are stored
+  /// column-wise in chunks instead of in the rows of the row container. Makes
+  /// the rows smaller for wide payloads. 0 disables the columnar layout.
+  static constexpr const char* kRowContainerColumnarPayloadMinWidth =
+      "row_container_columnar_payload_min_width";
+
+  /// The minimum percentage of the build rows of a hash join table that a
+  /// join key must hold to be reported as a heavy hitter. If set, the hash
+  /// build scans the table with duplicate keys after building to report the
+  /// skew of the build rows across the keys. 0 disables the scan.
+  static constexpr const char* kHashBuildHeavyHitterMinPct =
+      "hash_build_heavy_hitter_min_pct";
+
+  /// If true, a TopN operator whose first sorting key is of an integer or
+  /// floating point type pushes the key of its current last row down to the
+  /// upstream table scan as a dynamic range filter once it holds 'count' rows.
+  /// The filter tightens as better rows arrive, letting the scan skip rows and
+  /// the row groups whose stats cannot beat the threshold.
+  static constexpr const char* kTopNDynamicFilterEnabled =
+      "topn_dynamic_filter_enabled";
+
+  /// If true, aggregate window functions that are not order sensitive evaluate
+  /// sliding frames over a segment tree of partial aggregates of the window
+  /// partition instead of aggregating all rows of each frame.
+  static constexpr const char* kWindowSegmentTreeEnabled =
+      "window_segment_tree_enabled";
+
   /// The minimum number of table rows that can trigger the parallel hash join
   /// table build.
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
@@ -348,22 +615,87 @@ class QueryConfig {
   static constexpr const char* kMaxSplitPreloadPerDriver =
       "max_split_preload_per_driver";
 
+  /// If true, the number of splits a TableScan driver preloads adapts to the
+  /// observed time to open and to read a split, up to
+  /// 'max_split_preload_per_driver'. Nothing is preloaded while the query uses
+  /// most of its memory capacity.
+  static constexpr const char* kAdaptiveSplitPreloadEnabled =
+      "adaptive_split_preload_enabled";
+
+  /// Maximum number of batches an ArrowStream operator fetches ahead of its
+  /// consumer on the query executor. 0 fetches on the driver thread.
+  static constexpr const char* kArrowStreamPrefetchBatches =
+      "arrow_stream_prefetch_batches";
+
   /// If not zero, specifies the cpu time slice limit in ms that a driver thread
   /// can continuously run without yielding. If it is zero, then there is no
   /// limit.
   static constexpr const char* kDriverCpuTimeSliceLimitMs =
       "driver_cpu_time_slice_limit_ms";
 
+  /// If not zero, each Driver keeps this many of its most recent timeline
+  /// events, e.g. when it ran, why it was blocked and how long its operators'
+  /// calls took. Task::timelineJson() exports them.
+  static constexpr const char* kDriverTimelineEvents =
+      "driver_timeline_events";
+
+  /// If not zero, the threads that run the Drivers of the query take a CPU
+  /// profile sample every this many microseconds of their CPU time.
+  /// QueryCtx::cpuProfile() returns the samples as folded stacks.
+  static constexpr const char* kCpuProfilingIntervalMicros =
+      "cpu_profiling_interval_us";
+
+  /// Maximum number of CPU profile samples kept for the query.
+  static constexpr const char* kCpuProfilingMaxSamples =
+      "cpu_profiling_max_samples";
+
+  /// Name of the group of queries that share the CPU of a FairShareScheduler
+  /// executor. If empty, the query is a group of its own.
+  static constexpr const char* kSchedulingGroup = "scheduling_group";
+
+  /// Share of the CPU of a FairShareScheduler executor that the group of the
+  /// query gets, relative to the other groups with runnable Drivers.
+  static constexpr const char* kSchedulingWeight = "scheduling_weight";
+
+  /// If not zero, grouped execution starts a split group whenever enough
+  /// driver slots are free, even while the groups that freed them still run,
+  /// as long as the Task uses less than this many bytes of memory. If zero, at
+  /// most the number of concurrent split groups run at a time.
+  static constexpr const char* kSplitGroupsMemoryLimit =
+      "split_groups_memory_limit";
+
   uint64_t queryMaxMemoryPerNode() const {
     return toCapacity(
         get<std::string>(kQueryMaxMemoryPerNode, "0B"), CapacityUnit::BYTE);
   }
 
+  std::string queryPriority() const {
+    return get<std::string>(kQueryPriority, "DEFAULT");
+  }
+
+  uint64_t queryGuaranteedMemoryPerNode() const {
+    return toCapacity(
+        get<std::string>(kQueryGuaranteedMemoryPerNode, "0B"),
+        CapacityUnit::BYTE);
+  }
+
+  bool asyncMemoryReservationEnabled() const {
+    return get<bool>(kAsyncMemoryReservationEnabled, false);
+  }
+
+  uint64_t operatorMemoryTimelineIntervalMs() const {
+    return get<uint64_t>(kOperatorMemoryTimelineIntervalMs, 0);
+  }
+
   uint64_t maxPartialAggregationMemoryUsage() const {
     static constexpr uint64_t kDefault = 1L << 24;
     return get<uint64_t>(kMaxPartialAggregationMemory, kDefault);
   }
 
+  bool partialAggregationClusteredFlushEnabled() const {
+    return get<bool>(kPartialAggregationClusteredFlushEnabled, false);
+  }
+
   uint64_t maxExtendedPartialAggregationMemoryUsage() const {
     static constexpr uint64_t kDefault = 1L << 26;
     return get<uint64_t>(kMaxExtendedPartialAggregationMemory, kDefault);
@@ -377,6 +709,38 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  int32_t abandonPartialAggregationSketchRows() const {
+    return get<int32_t>(kAbandonPartialAggregationSketchRows, 0);
+  }
+
+  int32_t aggregationCompactionFragmentationPct() const {
+    return get<int32_t>(kAggregationCompactionFragmentationPct, 0);
+  }
+
+  bool groupingSetsRollupEnabled() const {
+    return get<bool>(kGroupingSetsRollupEnabled, false);
+  }
+
+  bool distinctAggregationAsGroupByEnabled() const {
+    return get<bool>(kDistinctAggregationAsGroupByEnabled, false);
+  }
+
+  bool elasticDriversEnabled() const {
+    return get<bool>(kElasticDriversEnabled, false);
+  }
+
+  int32_t elasticDriversMinPerPipeline() const {
+    return get<int32_t>(kElasticDriversMinPerPipeline, 1);
+  }
+
+  int32_t elasticDriversMaxPerPipeline() const {
+    return get<int32_t>(kElasticDriversMaxPerPipeline, 0);
+  }
+
+  uint64_t elasticDriversAdjustIntervalMs() const {
+    return get<uint64_t>(kElasticDriversAdjustIntervalMs, 500);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -416,11 +780,40 @@ class QueryConfig {
     return get<uint64_t>(kMaxOutputBufferSize, kDefault);
   }
 
+  uint64_t outputBufferCoalesceTargetBytes() const {
+    return get<uint64_t>(kOutputBufferCoalesceTargetBytes, 0);
+  }
+
+  uint64_t outputBufferCoalesceMaxDelayMs() const {
+    static constexpr uint64_t kDefault = 100;
+    return get<uint64_t>(kOutputBufferCoalesceMaxDelayMs, kDefault);
+  }
+
+  bool outputBufferSpillEnabled() const {
+    return get<bool>(kOutputBufferSpillEnabled, false);
+  }
+
+  bool partitionedOutputPreserveEncodings() const {
+    return get<bool>(kPartitionedOutputPreserveEncodings, false);
+  }
+
+  float partitionedOutputMaxCompressionNanosPerSavedByte() const {
+    return get<float>(kPartitionedOutputMaxCompressionNanosPerSavedByte, 0);
+  }
+
+  bool exchangeLazyDeserialization() const {
+    return get<bool>(kExchangeLazyDeserialization, false);
+  }
+
   uint64_t maxLocalExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
   }
 
+  double retainedStringBufferMinLiveRatio() const {
+    return get<double>(kRetainedStringBufferMinLiveRatio, 0.0);
+  }
+
   uint64_t maxExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxExchangeBufferSize, kDefault);
@@ -444,10 +837,26 @@ class QueryConfig {
     return get<uint32_t>(kMaxOutputBatchRows, 10'000);
   }
 
+  uint64_t adaptiveOutputBatchBytes() const {
+    return get<uint64_t>(kAdaptiveOutputBatchBytes, 0);
+  }
+
+  bool coalesceBatches() const {
+    return get<bool>(kCoalesceBatches, false);
+  }
+
+  uint64_t coalesceBatchesMaxDelayMs() const {
+    return get<uint64_t>(kCoalesceBatchesMaxDelayMs, 100);
+  }
+
   uint32_t tableScanGetOutputTimeLimitMs() const {
     return get<uint64_t>(kTableScanGetOutputTimeLimitMs, 5'000);
   }
 
+  bool splitResultCacheEnabled() const {
+    return get<bool>(kSplitResultCacheEnabled, false);
+  }
+
   bool hashAdaptivityEnabled() const {
     return get<bool>(kHashAdaptivityEnabled, true);
   }
@@ -486,6 +895,10 @@ class QueryConfig {
     return get<bool>(kExprEvalSimplified, false);
   }
 
+  bool exprFusionEnabled() const {
+    return get<bool>(kExprFusionEnabled, false);
+  }
+
   /// Returns true if spilling is enabled.
   bool spillEnabled() const {
     return get<bool>(kSpillEnabled, false);
@@ -497,6 +910,12 @@ class QueryConfig {
     return get<bool>(kAggregationSpillEnabled, true);
   }
 
+  /// Returns true if the aggregation spills hash partitioned groups instead of
+  /// sorted runs.
+  bool aggregationSpillPartitioned() const {
+    return get<bool>(kAggregationSpillPartitioned, false);
+  }
+
   /// Returns 'is join spilling enabled' flag. Must also check the
   /// spillEnabled()!
   bool joinSpillEnabled() const {
@@ -527,6 +946,12 @@ class QueryConfig {
     return get<bool>(kRowNumberSpillEnabled, true);
   }
 
+  /// Returns true if spilling is enabled for MarkDistinct operator. Must also
+  /// check the spillEnabled()!
+  bool markDistinctSpillEnabled() const {
+    return get<bool>(kMarkDistinctSpillEnabled, false);
+  }
+
   /// Returns true if spilling is enabled for TopNRowNumber operator. Must also
   /// check the spillEnabled()!
   bool topNRowNumberSpillEnabled() const {
@@ -592,6 +1017,26 @@ class QueryConfig {
     return get<std::string>(kSpillFileCreateConfig, "");
   }
 
+  uint32_t spillMaxMergeFanIn() const {
+    return get<uint32_t>(kSpillMaxMergeFanIn, 0);
+  }
+
+  uint64_t spillWriteBehindBytes() const {
+    return get<uint64_t>(kSpillWriteBehindBytes, 0);
+  }
+
+  uint64_t spillReadAheadBytes() const {
+    return get<uint64_t>(kSpillReadAheadBytes, 0);
+  }
+
+  bool spillColumnarFormat() const {
+    return get<bool>(kSpillColumnarFormat, false);
+  }
+
+  uint64_t spillZstdDictionarySize() const {
+    return get<uint64_t>(kSpillZstdDictionarySize, 0);
+  }
+
   /// Returns the minimal available spillable memory reservation in percentage
   /// of the current memory usage. Suppose the current memory usage size of M,
   /// available memory reservation size of N and min reservation percentage of
@@ -674,6 +1119,34 @@ class QueryConfig {
     return get<bool>(kHashProbeFinishEarlyOnEmptyBuild, true);
   }
 
+  uint64_t hashProbeBloomFilterPushdownMaxSize() const {
+    return get<uint64_t>(kHashProbeBloomFilterPushdownMaxSize, 0);
+  }
+
+  uint64_t hashProbePartitionedProbeMinTableSize() const {
+    return get<uint64_t>(kHashProbePartitionedProbeMinTableSize, 0);
+  }
+
+  bool hashProbeLazyBuildColumns() const {
+    return get<bool>(kHashProbeLazyBuildColumns, false);
+  }
+
+  int32_t rowContainerColumnarPayloadMinWidth() const {
+    return get<int32_t>(kRowContainerColumnarPayloadMinWidth, 0);
+  }
+
+  int32_t hashBuildHeavyHitterMinPct() const {
+    return get<int32_t>(kHashBuildHeavyHitterMinPct, 0);
+  }
+
+  bool topNDynamicFilterEnabled() const {
+    return get<bool>(kTopNDynamicFilterEnabled, true);
+  }
+
+  bool windowSegmentTreeEnabled() const {
+    return get<bool>(kWindowSegmentTreeEnabled, true);
+  }
+
   uint32_t minTableRowsForParallelJoinBuild() const {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
@@ -706,10 +1179,42 @@ class QueryConfig {
     return get<int32_t>(kMaxSplitPreloadPerDriver, 2);
   }
 
+  bool adaptiveSplitPreloadEnabled() const {
+    return get<bool>(kAdaptiveSplitPreloadEnabled, false);
+  }
+
+  int32_t arrowStreamPrefetchBatches() const {
+    return get<int32_t>(kArrowStreamPrefetchBatches, 0);
+  }
+
   uint32_t driverCpuTimeSliceLimitMs() const {
     return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
   }
 
+  uint32_t driverTimelineEvents() const {
+    return get<uint32_t>(kDriverTimelineEvents, 0);
+  }
+
+  int32_t cpuProfilingIntervalMicros() const {
+    return get<int32_t>(kCpuProfilingIntervalMicros, 0);
+  }
+
+  int32_t cpuProfilingMaxSamples() const {
+    return get<int32_t>(kCpuProfilingMaxSamples, 10'000);
+  }
+
+  std::string schedulingGroup() const {
+    return get<std::string>(kSchedulingGroup, "");
+  }
+
+  double schedulingWeight() const {
+    return get<double>(kSchedulingWeight, 1.0);
+  }
+
+  uint64_t splitGroupsMemoryLimit() const {
+    return get<uint64_t>(kSplitGroupsMemoryLimit, 0);
+  }
+
   template <typename T>
   T get(const std::string& key, const T& defaultValue) const {
     return config_->get<T>(key, defaultValue);
@@ -719,6 +1224,11 @@ class QueryConfig {
     return std::optional<T>(config_->get<T>(key));
   }
 
+  /// Returns the properties set for the query.
+  const std::unordered_map<std::string, std::string>& values() const {
+    return config_->values();
+  }
+
   /// Test-only method to override the current query config properties.
   /// It is not thread safe.
   void testingOverrideConfigUnsafe(
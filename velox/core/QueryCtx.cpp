@@ -81,6 +81,20 @@ QueryCtx::QueryCtx(
   return fmt::format("query.{}.{}", queryId.c_str(), seqNum++);
 }
 
+void QueryCtx::initArbitrationPriority() {
+  const auto priority =
+      memory::arbitrationPriorityFromName(queryConfig_.queryPriority());
+  const auto guaranteedCapacity = queryConfig_.queryGuaranteedMemoryPerNode();
+  if (priority == memory::ArbitrationPriority::kDefault &&
+      guaranteedCapacity == 0) {
+    return;
+  }
+  VELOX_CHECK(
+      pool_->isRoot(),
+      "The query priority class is only supported with a root memory pool");
+  pool_->setArbitrationPriority(priority, guaranteedCapacity);
+}
+
 void QueryCtx::updateSpilledBytesAndCheckLimit(uint64_t bytes) {
   const auto numSpilledBytes = numSpilledBytes_.fetch_add(bytes) + bytes;
   if (queryConfig_.maxSpillBytes() > 0 &&
@@ -91,4 +105,20 @@ void QueryCtx::updateSpilledBytesAndCheckLimit(uint64_t bytes) {
   }
 }
 
+process::QueryProfiler* QueryCtx::cpuProfiler() {
+  std::call_once(cpuProfilerOnce_, [&]() {
+    if (queryConfig_.cpuProfilingIntervalMicros() > 0) {
+      cpuProfiler_ = std::make_unique<process::QueryProfiler>(
+          queryConfig_.cpuProfilingIntervalMicros(),
+          queryConfig_.cpuProfilingMaxSamples());
+    }
+  });
+  return cpuProfiler_.get();
+}
+
+std::string QueryCtx::cpuProfile() {
+  auto* profiler = cpuProfiler();
+  return profiler == nullptr ? "" : profiler->foldedStacks();
+}
+
 } // namespace facebook::velox::core
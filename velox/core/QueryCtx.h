@@ -20,6 +20,7 @@
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/process/QueryProfiler.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/VectorPool.h"
@@ -133,6 +134,14 @@ class QueryCtx {
   /// exceeds the max spill bytes limit.
   void updateSpilledBytesAndCheckLimit(uint64_t bytes);
 
+  /// Returns the CPU profiler of the query, or nullptr if
+  /// QueryConfig::kCpuProfilingIntervalMicros is not set.
+  process::QueryProfiler* cpuProfiler();
+
+  /// Returns the CPU profile samples of the query so far as folded stacks, or
+  /// an empty string if the query is not profiled.
+  std::string cpuProfile();
+
  private:
   static Config* getEmptyConfig() {
     static const std::unique_ptr<Config> kEmptyConfig =
@@ -147,8 +156,13 @@ class QueryCtx {
           memory::kMaxMemory,
           memory::MemoryReclaimer::create());
     }
+    initArbitrationPriority();
   }
 
+  // Sets the priority class and the guaranteed capacity of the query on its
+  // root memory pool if configured.
+  void initArbitrationPriority();
+
   const std::string queryId_;
   folly::Executor* const executor_{nullptr};
   folly::Executor* const spillExecutor_{nullptr};
@@ -160,6 +174,8 @@ class QueryCtx {
   folly::Executor::KeepAlive<> executorKeepalive_;
   QueryConfig queryConfig_;
   std::atomic<uint64_t> numSpilledBytes_{0};
+  std::once_flag cpuProfilerOnce_;
+  std::unique_ptr<process::QueryProfiler> cpuProfiler_;
 };
 
 // Represents the state of one thread of query execution.
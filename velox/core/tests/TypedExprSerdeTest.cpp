@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/serialization/BinarySerde.h"
 #include "velox/core/Expressions.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
@@ -42,6 +43,10 @@ class TypedExprSerDeTest : public testing::Test,
     ASSERT_EQ(expression->toString(), copy->toString());
     ASSERT_EQ(*expression->type(), *copy->type());
     ASSERT_EQ(*expression, *copy);
+
+    copy = velox::ISerializable::deserialize<ITypedExpr>(
+        deserializeBinary(serializeBinary(serialized)), pool());
+    ASSERT_EQ(*expression, *copy);
   }
 
   std::vector<RowVectorPtr> data_;
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/AdaptivePrefetchPolicy.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::dwio::common {
+
+AdaptivePrefetchPolicy::AdaptivePrefetchPolicy(
+    int32_t maxDepth,
+    memory::MemoryPool* pool)
+    : maxDepth_(maxDepth), pool_(pool) {
+  VELOX_CHECK_GE(maxDepth_, 0);
+}
+
+void AdaptivePrefetchPolicy::recordLoad(uint64_t ioBytes, Duration loadTime) {
+  loadNanos_.add(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(loadTime).count());
+  ioBytes_.add(ioBytes);
+}
+
+void AdaptivePrefetchPolicy::recordRead(Duration readTime) {
+  readNanos_.add(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(readTime).count());
+}
+
+int32_t AdaptivePrefetchPolicy::depth() {
+  int64_t depth = 1;
+  if (!loadNanos_.empty() && !readNanos_.empty()) {
+    if (readNanos_.value() > 0) {
+      depth = std::ceil(loadNanos_.value() / readNanos_.value());
+    } else if (loadNanos_.value() > 0) {
+      depth = maxDepth_;
+    }
+  }
+  depth = std::clamp<int64_t>(depth, 1, std::max(maxDepth_, 1));
+  depth = std::min<int64_t>(
+      {depth, maxDepth_, static_cast<int64_t>(depthWithinMemory())});
+  maxChosenDepth_ = std::max<int32_t>(maxChosenDepth_, depth);
+  return depth;
+}
+
+int32_t AdaptivePrefetchPolicy::depthWithinMemory() const {
+  if (pool_ == nullptr || ioBytes_.empty() || ioBytes_.value() <= 0 ||
+      pool_->maxCapacity() == memory::kMaxMemory) {
+    return maxDepth_;
+  }
+  const auto available = std::max<int64_t>(
+      0, pool_->maxCapacity() - pool_->root()->reservedBytes());
+  return static_cast<int32_t>(std::min<double>(
+      maxDepth_, kMaxMemoryFraction * available / ioBytes_.value()));
+}
+
+} // namespace facebook::velox::dwio::common
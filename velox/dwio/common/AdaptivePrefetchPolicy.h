@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "velox/common/memory/MemoryPool.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Chooses how many units, i.e. row groups or stripes, a reader loads ahead of
+/// the unit it reads. Loading ahead hides the latency of loading a unit while
+/// the units loaded before it are read, so the depth is the average time the
+/// reader blocks on loading a unit divided by the average time it takes to
+/// read one. The units loaded ahead must further fit in a fraction of the
+/// memory the pool of the reader can still reserve.
+class AdaptivePrefetchPolicy {
+ public:
+  using Duration = std::chrono::high_resolution_clock::duration;
+
+  /// Share of the memory the pool can still reserve that the units loaded
+  /// ahead may take.
+  static constexpr double kMaxMemoryFraction = 0.5;
+
+  /// Weight of a new sample in the moving averages of load and read times.
+  static constexpr double kSampleWeight = 0.3;
+
+  /// Loads at most 'maxDepth' units ahead. Memory is not considered if 'pool'
+  /// is nullptr.
+  AdaptivePrefetchPolicy(int32_t maxDepth, memory::MemoryPool* pool);
+
+  /// Records that loading a unit of 'ioBytes' blocked the reader for
+  /// 'loadTime'.
+  void recordLoad(uint64_t ioBytes, Duration loadTime);
+
+  /// Records that the reader took 'readTime' to read a loaded unit.
+  void recordRead(Duration readTime);
+
+  /// Returns the number of units to load ahead of the unit being read. This
+  /// is 1 until a unit has been loaded and read, and at least 1 afterwards
+  /// unless loading more would exceed the memory limit or 'maxDepth'.
+  int32_t depth();
+
+  /// Returns the largest value returned by depth().
+  int32_t maxChosenDepth() const {
+    return maxChosenDepth_;
+  }
+
+ private:
+  class MovingAverage {
+   public:
+    void add(double sample) {
+      value_ = empty_ ? sample
+                      : kSampleWeight * sample + (1 - kSampleWeight) * value_;
+      empty_ = false;
+    }
+
+    bool empty() const {
+      return empty_;
+    }
+
+    double value() const {
+      return value_;
+    }
+
+   private:
+    bool empty_{true};
+    double value_{0};
+  };
+
+  // Returns the largest number of units of the average size that fit in the
+  // memory 'pool_' can still reserve, or 'maxDepth_' if there is no limit.
+  int32_t depthWithinMemory() const;
+
+  const int32_t maxDepth_;
+  memory::MemoryPool* const pool_;
+
+  MovingAverage loadNanos_;
+  MovingAverage readNanos_;
+  MovingAverage ioBytes_;
+  int32_t maxChosenDepth_{0};
+};
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/AdaptivePrefetchUnitLoader.h"
+
+#include <algorithm>
+#include <optional>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/AdaptivePrefetchPolicy.h"
+#include "velox/dwio/common/MeasureTime.h"
+#include "velox/dwio/common/Statistics.h"
+
+using facebook::velox::dwio::common::measureTimeIfCallback;
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+class AdaptivePrefetchUnitLoader : public UnitLoader {
+ public:
+  AdaptivePrefetchUnitLoader(
+      std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+      int32_t maxPrefetchUnits,
+      memory::MemoryPool* pool,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback)
+      : loadUnits_{std::move(loadUnits)},
+        policy_{maxPrefetchUnits, pool},
+        blockedOnIoCallback_{std::move(blockedOnIoCallback)},
+        loaded_(loadUnits_.size(), false) {}
+
+  ~AdaptivePrefetchUnitLoader() override = default;
+
+  LoadUnit& getLoadedUnit(uint32_t unit) override {
+    VELOX_CHECK(unit < loadUnits_.size(), "Unit out of range");
+    if (currentUnit_ == unit) {
+      return *loadUnits_[unit];
+    }
+    if (currentUnit_.has_value()) {
+      policy_.recordRead(
+          std::chrono::high_resolution_clock::now() - readStartTime_);
+    }
+
+    {
+      auto measure = measureTimeIfCallback(blockedOnIoCallback_);
+      load(unit);
+      // The depth reflects the load of 'unit' if it was not loaded ahead.
+      const uint32_t lastUnit = std::min<uint64_t>(
+          static_cast<uint64_t>(unit) + policy_.depth(),
+          loadUnits_.size() - 1);
+      // Frees the units out of the window before loading more ahead.
+      for (uint32_t i = 0; i < loadUnits_.size(); ++i) {
+        if (loaded_[i] && (i < unit || i > lastUnit)) {
+          loadUnits_[i]->unload();
+          loaded_[i] = false;
+        }
+      }
+      for (auto i = unit + 1; i <= lastUnit; ++i) {
+        load(i);
+      }
+    }
+    currentUnit_ = unit;
+    readStartTime_ = std::chrono::high_resolution_clock::now();
+
+    return *loadUnits_[unit];
+  }
+
+  void onRead(uint32_t unit, uint64_t rowOffsetInUnit, uint64_t /* rowCount */)
+      override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    VELOX_CHECK_LT(
+        rowOffsetInUnit, loadUnits_[unit]->getNumRows(), "Row out of range");
+  }
+
+  void onSeek(uint32_t unit, uint64_t rowOffsetInUnit) override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    VELOX_CHECK_LE(
+        rowOffsetInUnit, loadUnits_[unit]->getNumRows(), "Row out of range");
+  }
+
+  void updateRuntimeStats(RuntimeStatistics& stats) const override {
+    stats.maxPrefetchDepth =
+        std::max<int64_t>(stats.maxPrefetchDepth, policy_.maxChosenDepth());
+  }
+
+ private:
+  void load(uint32_t unit) {
+    if (loaded_[unit]) {
+      return;
+    }
+    const auto startTime = std::chrono::high_resolution_clock::now();
+    // The IO size of a unit may be known only after reading its metadata,
+    // which is part of the load.
+    const auto ioSize = loadUnits_[unit]->getIoSize();
+    loadUnits_[unit]->load();
+    loaded_[unit] = true;
+    policy_.recordLoad(
+        ioSize, std::chrono::high_resolution_clock::now() - startTime);
+  }
+
+  std::vector<std::unique_ptr<LoadUnit>> loadUnits_;
+  AdaptivePrefetchPolicy policy_;
+  std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+  std::vector<bool> loaded_;
+  std::optional<uint32_t> currentUnit_;
+  std::chrono::high_resolution_clock::time_point readStartTime_;
+};
+
+} // namespace
+
+std::unique_ptr<UnitLoader> AdaptivePrefetchUnitLoaderFactory::create(
+    std::vector<std::unique_ptr<LoadUnit>> loadUnits) {
+  return std::make_unique<AdaptivePrefetchUnitLoader>(
+      std::move(loadUnits), maxPrefetchUnits_, pool_, blockedOnIoCallback_);
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+#include "velox/common/memory/MemoryPool.h"
+#include "velox/dwio/common/UnitLoader.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Makes unit loaders that load the unit being read like the on demand loader
+/// and load the units after it ahead, as many as AdaptivePrefetchPolicy
+/// chooses from the load and read times of the units and the memory 'pool'
+/// can still reserve. Loading ahead overlaps IO with reading when the
+/// buffered inputs of the units load asynchronously.
+class AdaptivePrefetchUnitLoaderFactory
+    : public velox::dwio::common::UnitLoaderFactory {
+ public:
+  AdaptivePrefetchUnitLoaderFactory(
+      int32_t maxPrefetchUnits,
+      memory::MemoryPool* pool,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback)
+      : maxPrefetchUnits_{maxPrefetchUnits},
+        pool_{pool},
+        blockedOnIoCallback_{std::move(blockedOnIoCallback)} {}
+  ~AdaptivePrefetchUnitLoaderFactory() override = default;
+
+  std::unique_ptr<velox::dwio::common::UnitLoader> create(
+      std::vector<std::unique_ptr<velox::dwio::common::LoadUnit>> loadUnits)
+      override;
+
+ private:
+  const int32_t maxPrefetchUnits_;
+  memory::MemoryPool* const pool_;
+  std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+};
+
+} // namespace facebook::velox::dwio::common
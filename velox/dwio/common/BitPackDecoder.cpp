@@ -16,6 +16,11 @@
 
 #include "velox/dwio/common/BitPackDecoder.h"
 
+#if defined(__x86_64__)
+#include <folly/CpuId.h>
+#include <immintrin.h>
+#endif
+
 namespace facebook::velox::dwio::common {
 
 using int128_t = __int128_t;
@@ -178,6 +183,182 @@ int32_t decode1To24(
 
 #endif
 
+#if defined(__x86_64__)
+
+namespace {
+
+#define VELOX_AVX512_VBMI \
+  __attribute__((__target__("avx512f,avx512bw,avx512vbmi")))
+
+// Stores the low bits of the 16 32 bit lanes of 'values' to 'result'.
+template <typename T>
+VELOX_AVX512_VBMI inline void store16Avx512(__m512i values, T* result) {
+  if constexpr (sizeof(T) == 1) {
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(result), _mm512_cvtepi32_epi8(values));
+  } else if constexpr (sizeof(T) == 2) {
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(result), _mm512_cvtepi32_epi16(values));
+  } else if constexpr (sizeof(T) == 4) {
+    _mm512_storeu_si512(result, values);
+  } else {
+    _mm512_storeu_si512(
+        result, _mm512_cvtepu32_epi64(_mm512_castsi512_si256(values)));
+    _mm512_storeu_si512(
+        result + 8,
+        _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(values, 1)));
+  }
+}
+
+// Unpacks 16 values per iteration for widths up to 25. Each 32 bit lane gets
+// the 4 bytes starting at the first byte of its field, which hold the field
+// for any start bit in the byte. 16 fields take 2 * 'bitWidth' bytes, so the
+// permutation and the shifts are the same in every iteration.
+template <typename T>
+VELOX_AVX512_VBMI int32_t unpack16Avx512(
+    const uint8_t* bits,
+    int32_t bitOffset,
+    int32_t numValues,
+    uint8_t bitWidth,
+    T* result) {
+  alignas(64) uint8_t indices[64];
+  alignas(64) uint32_t shifts[16];
+  for (auto lane = 0; lane < 16; ++lane) {
+    const auto bit = bitOffset + lane * bitWidth;
+    for (auto byte = 0; byte < 4; ++byte) {
+      indices[lane * 4 + byte] = (bit >> 3) + byte;
+    }
+    shifts[lane] = bit & 7;
+  }
+  const auto permute = _mm512_load_si512(indices);
+  const auto shift = _mm512_load_si512(shifts);
+  const auto mask = _mm512_set1_epi32(bits::lowMask(bitWidth));
+  // Loads only the bytes of the fields, so that the last iteration does not
+  // read past the end of the data.
+  const __mmask64 loadMask =
+      bits::lowMask(bits::roundUp(bitOffset + 16 * bitWidth, 8) / 8);
+  int32_t i = 0;
+  for (; i + 16 <= numValues; i += 16) {
+    const auto data = _mm512_maskz_loadu_epi8(loadMask, bits);
+    const auto values = _mm512_srlv_epi32(
+        _mm512_permutexvar_epi8(permute, data), shift);
+    store16Avx512(_mm512_and_si512(values, mask), result + i);
+    bits += 2 * bitWidth;
+  }
+  return i;
+}
+
+// Unpacks 8 values per iteration into 64 bit lanes for widths 26 to 32, where
+// a field with its start bit in a byte may span 5 bytes.
+template <typename T>
+VELOX_AVX512_VBMI int32_t unpack8Avx512(
+    const uint8_t* bits,
+    int32_t bitOffset,
+    int32_t numValues,
+    uint8_t bitWidth,
+    T* result) {
+  alignas(64) uint8_t indices[64];
+  alignas(64) uint64_t shifts[8];
+  for (auto lane = 0; lane < 8; ++lane) {
+    const auto bit = bitOffset + lane * bitWidth;
+    for (auto byte = 0; byte < 8; ++byte) {
+      indices[lane * 8 + byte] = (bit >> 3) + byte;
+    }
+    shifts[lane] = bit & 7;
+  }
+  const auto permute = _mm512_load_si512(indices);
+  const auto shift = _mm512_load_si512(shifts);
+  const auto mask = _mm512_set1_epi64(bits::lowMask(bitWidth));
+  const __mmask64 loadMask =
+      bits::lowMask(bits::roundUp(bitOffset + 8 * bitWidth, 8) / 8);
+  int32_t i = 0;
+  for (; i + 8 <= numValues; i += 8) {
+    const auto data = _mm512_maskz_loadu_epi8(loadMask, bits);
+    const auto values = _mm512_and_si512(
+        _mm512_srlv_epi64(_mm512_permutexvar_epi8(permute, data), shift),
+        mask);
+    if constexpr (sizeof(T) == 4) {
+      _mm256_storeu_si256(
+          reinterpret_cast<__m256i*>(result + i),
+          _mm512_cvtepi64_epi32(values));
+    } else {
+      _mm512_storeu_si512(result + i, values);
+    }
+    bits += bitWidth;
+  }
+  return i;
+}
+
+bool& avx512UnpackFlag() {
+  static bool enabled = hasAvx512Vbmi();
+  return enabled;
+}
+
+} // namespace
+
+#endif
+
+bool hasAvx512Vbmi() {
+#if defined(__x86_64__)
+  static const bool kHasAvx512Vbmi = [] {
+    folly::CpuId cpuId;
+    return cpuId.avx512f() && cpuId.avx512bw() && cpuId.avx512vbmi();
+  }();
+  return kHasAvx512Vbmi;
+#else
+  return false;
+#endif
+}
+
+bool avx512UnpackEnabled() {
+#if defined(__x86_64__)
+  return avx512UnpackFlag();
+#else
+  return false;
+#endif
+}
+
+void setAvx512UnpackEnabled(bool enabled) {
+#if defined(__x86_64__)
+  avx512UnpackFlag() = enabled && hasAvx512Vbmi();
+#endif
+}
+
+template <typename T>
+int32_t unpackAvx512(
+    const uint8_t* bits,
+    int32_t bitOffset,
+    int32_t numValues,
+    uint8_t bitWidth,
+    T* result) {
+  VELOX_DCHECK(hasAvx512Vbmi());
+  VELOX_DCHECK_LT(bitOffset, 8);
+  VELOX_DCHECK_GE(bitWidth, 1);
+  VELOX_DCHECK_LE(bitWidth, std::min<int32_t>(32, 8 * sizeof(T)));
+#if defined(__x86_64__)
+  if (bitWidth <= 25) {
+    return unpack16Avx512(bits, bitOffset, numValues, bitWidth, result);
+  }
+  if constexpr (sizeof(T) >= sizeof(uint32_t)) {
+    return unpack8Avx512(bits, bitOffset, numValues, bitWidth, result);
+  }
+#endif
+  return 0;
+}
+
+template int32_t
+unpackAvx512(const uint8_t*, int32_t, int32_t, uint8_t, uint8_t*);
+template int32_t
+unpackAvx512(const uint8_t*, int32_t, int32_t, uint8_t, uint16_t*);
+template int32_t
+unpackAvx512(const uint8_t*, int32_t, int32_t, uint8_t, uint32_t*);
+template int32_t
+unpackAvx512(const uint8_t*, int32_t, int32_t, uint8_t, int16_t*);
+template int32_t
+unpackAvx512(const uint8_t*, int32_t, int32_t, uint8_t, int32_t*);
+template int32_t
+unpackAvx512(const uint8_t*, int32_t, int32_t, uint8_t, int64_t*);
+
 template <typename T>
 void unpack(
     const uint64_t* bits,
@@ -236,35 +417,52 @@ void unpack(
   }
   int32_t i = 0;
 
+  if constexpr (sizeof(T) <= sizeof(int64_t)) {
+    // Dense rows, e.g. a run of dictionary indices, are unpacked 16 at a time
+    // with AVX-512.
+    if (numRows >= 16 && bitWidth <= std::min<int32_t>(32, 8 * sizeof(T)) &&
+        rows.back() - rows[0] + 1 == numRows && avx512UnpackEnabled()) {
+      const auto firstBit = bitOffset + rows[0] * bitWidth;
+      i = unpackAvx512(
+          reinterpret_cast<const uint8_t*>(bits) + (firstBit >> 3),
+          firstBit & 7,
+          numRows,
+          bitWidth,
+          result);
+    }
+  }
+
 #if XSIMD_WITH_AVX2
-  // Use AVX2 for specific widths.
-  switch (bitWidth) {
-    WIDTH_CASE(1);
-    WIDTH_CASE(2);
-    WIDTH_CASE(3);
-    WIDTH_CASE(4);
-    WIDTH_CASE(5);
-    WIDTH_CASE(6);
-    WIDTH_CASE(7);
-    WIDTH_CASE(8);
-    WIDTH_CASE(9);
-    WIDTH_CASE(10);
-    WIDTH_CASE(11);
-    WIDTH_CASE(12);
-    WIDTH_CASE(13);
-    WIDTH_CASE(14);
-    WIDTH_CASE(15);
-    WIDTH_CASE(16);
-    WIDTH_CASE(17);
-    WIDTH_CASE(18);
-    WIDTH_CASE(19);
-    WIDTH_CASE(20);
-    WIDTH_CASE(21);
-    WIDTH_CASE(22);
-    WIDTH_CASE(23);
-    WIDTH_CASE(24);
-    default:
-      break;
+  // Use AVX2 for specific widths if the rows were not unpacked above.
+  if (i == 0) {
+    switch (bitWidth) {
+      WIDTH_CASE(1);
+      WIDTH_CASE(2);
+      WIDTH_CASE(3);
+      WIDTH_CASE(4);
+      WIDTH_CASE(5);
+      WIDTH_CASE(6);
+      WIDTH_CASE(7);
+      WIDTH_CASE(8);
+      WIDTH_CASE(9);
+      WIDTH_CASE(10);
+      WIDTH_CASE(11);
+      WIDTH_CASE(12);
+      WIDTH_CASE(13);
+      WIDTH_CASE(14);
+      WIDTH_CASE(15);
+      WIDTH_CASE(16);
+      WIDTH_CASE(17);
+      WIDTH_CASE(18);
+      WIDTH_CASE(19);
+      WIDTH_CASE(20);
+      WIDTH_CASE(21);
+      WIDTH_CASE(22);
+      WIDTH_CASE(23);
+      WIDTH_CASE(24);
+      default:
+        break;
+    }
   }
 #endif
 
@@ -280,7 +478,7 @@ void unpack(
   if (anyUnsafe) {
     auto lastSafeWord = bufferEnd - sizeof(uint64_t);
     VELOX_DCHECK(lastSafeWord);
-    for (auto i_2 = numSafeRows; i_2 < numRows; ++i_2) {
+    for (auto i_2 = std::max<int32_t>(i, numSafeRows); i_2 < numRows; ++i_2) {
       auto bit = bitOffset + (rows[i_2]) * bitWidth;
       auto byte = bit / 8;
       auto shift = bit & 7;
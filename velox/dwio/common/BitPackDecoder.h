@@ -98,6 +98,31 @@ void unpack(
     const char* bufferEnd,
     T* result);
 
+/// Returns true if the CPU has the AVX-512 VBMI instructions used by
+/// unpackAvx512().
+bool hasAvx512Vbmi();
+
+/// Returns true if unpack() uses unpackAvx512(). This is the default if
+/// hasAvx512Vbmi().
+bool avx512UnpackEnabled();
+
+/// Enables or disables unpackAvx512() in unpack(), e.g. to compare it with the
+/// AVX2 kernels in tests and benchmarks. Has no effect unless hasAvx512Vbmi().
+void setAvx512UnpackEnabled(bool enabled);
+
+/// Unpacks up to 'numValues' bit fields of 'bitWidth' bits that start at
+/// 'bitOffset' (< 8) bits into 'bits' to 'result' with AVX-512 VBMI. Unpacks a
+/// multiple of 16 values, or of 8 for widths over 25, and returns how many.
+/// Reads only the bytes of the unpacked fields. 'bitWidth' is at most 32 and
+/// at most the width of T. Must only be called if hasAvx512Vbmi().
+template <typename T>
+int32_t unpackAvx512(
+    const uint8_t* bits,
+    int32_t bitOffset,
+    int32_t numValues,
+    uint8_t bitWidth,
+    T* result);
+
 /// Unpack numValues number of input values from inputBuffer. The results
 /// will be written to result. numValues must be a multiple of 8. The
 /// caller needs to make sure the inputBufferLen contains at least numValues
@@ -179,6 +204,28 @@ static inline uint32_t unpackNaive(
   return numValues;
 }
 
+// Unpacks the leading values with unpackAvx512() if it is enabled and advances
+// 'inputBits', 'result' and 'numValues' past them.
+template <typename T>
+inline void unpackAvx512Prefix(
+    const uint8_t* FOLLY_NONNULL& inputBits,
+    uint64_t& numValues,
+    uint8_t bitWidth,
+    T* FOLLY_NONNULL& result) {
+  if (numValues < 16 || !avx512UnpackEnabled()) {
+    return;
+  }
+  const auto numUnpacked = unpackAvx512(
+      inputBits,
+      0,
+      static_cast<int32_t>(std::min<uint64_t>(numValues, 1 << 30)),
+      bitWidth,
+      result);
+  inputBits += numUnpacked * bitWidth / 8;
+  result += numUnpacked;
+  numValues -= numUnpacked;
+}
+
 #if XSIMD_WITH_AVX2
 
 // numValues number of uint16_t values with bitWidth in
@@ -643,6 +690,7 @@ inline void unpack<uint8_t>(
     uint8_t* FOLLY_NONNULL& result) {
   VELOX_CHECK(bitWidth >= 1 && bitWidth <= 8);
   VELOX_CHECK(inputBufferLen * 8 >= bitWidth * numValues);
+  unpackAvx512Prefix(inputBits, numValues, bitWidth, result);
 
 #if XSIMD_WITH_AVX2
 
@@ -679,6 +727,7 @@ inline void unpack<uint16_t>(
     uint16_t* FOLLY_NONNULL& result) {
   VELOX_CHECK(bitWidth >= 1 && bitWidth <= 16);
   VELOX_CHECK(inputBufferLen * 8 >= bitWidth * numValues);
+  unpackAvx512Prefix(inputBits, numValues, bitWidth, result);
 
 #if XSIMD_WITH_AVX2
 
@@ -728,6 +777,7 @@ inline void unpack<uint32_t>(
     uint32_t* FOLLY_NONNULL& result) {
   VELOX_CHECK(bitWidth >= 1 && bitWidth <= 32);
   VELOX_CHECK(inputBufferLen * 8 >= bitWidth * numValues);
+  unpackAvx512Prefix(inputBits, numValues, bitWidth, result);
 
 #if XSIMD_WITH_AVX2
 
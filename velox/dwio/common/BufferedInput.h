@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "velox/common/memory/AllocationPool.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/StreamIdentifier.h"
@@ -116,6 +118,13 @@ class BufferedInput {
 
   virtual void setNumStripes(int32_t /*numStripes*/) {}
 
+  // Returns the process-wide id of the file if it is read through a cache
+  // that identifies files by id. Such ids are stable across readers of the
+  // same file and can be used as keys of other process-wide caches.
+  virtual std::optional<uint64_t> fileNum() const {
+    return std::nullopt;
+  }
+
   // Create a new (clean) instance of BufferedInput sharing the same
   // underlying file and memory pool.  The enqueued regions are NOT copied.
   virtual std::unique_ptr<BufferedInput> clone() const {
@@ -194,7 +194,8 @@ void CacheInputStream::loadSync(Region region) {
       pin_.checkedEntry()->makeEvictable();
     }
     pin_.clear();
-    pin_ = cache_->findOrCreate(key, region.length, &wait);
+    pin_ = cache_->findOrCreate(
+        key, region.length, &wait, bufferedInput_->cacheGroup());
     if (pin_.empty()) {
       VELOX_CHECK(wait.valid());
       auto& exec = folly::QueuedImmediateExecutor::instance();
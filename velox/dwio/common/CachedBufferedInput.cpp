@@ -17,6 +17,7 @@
 #include "velox/dwio/common/CachedBufferedInput.h"
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
 
 DEFINE_int32(
@@ -218,7 +219,15 @@ void CachedBufferedInput::makeLoads(
     return;
   }
   bool isSsd = !requests[0]->ssdPin.empty();
-  int32_t maxDistance = isSsd ? 20000 : options_.maxCoalesceDistance();
+  io::AdaptiveCoalescing::Parameters parameters{
+      options_.maxCoalesceDistance(), options_.maxCoalesceBytes()};
+  if (!isSsd && !storage_.empty()) {
+    parameters =
+        io::AdaptiveCoalescing::instance().parameters(storage_, parameters);
+    ioStats_->coalesceDistance().increment(parameters.maxCoalesceDistance);
+    ioStats_->coalesceBytes().increment(parameters.maxCoalesceBytes);
+  }
+  int32_t maxDistance = isSsd ? 20000 : parameters.maxCoalesceDistance;
   std::sort(
       requests.begin(),
       requests.end(),
@@ -248,7 +257,7 @@ void CachedBufferedInput::makeLoads(
         return size;
       },
       [&](int32_t index) {
-        if (coalescedBytes > options_.maxCoalesceBytes()) {
+        if (coalescedBytes > parameters.maxCoalesceBytes) {
           coalescedBytes = 0;
           return kNoCoalesce;
         }
@@ -264,7 +273,7 @@ void CachedBufferedInput::makeLoads(
           uint64_t /*offset*/,
           const std::vector<CacheRequest*>& ranges) {
         ++numNewLoads;
-        readRegion(ranges, prefetch);
+        readRegion(ranges, prefetch, parameters.maxCoalesceDistance);
       });
   if (prefetch && executor_) {
     std::vector<int32_t> doneIndices;
@@ -296,11 +305,13 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
       cache::AsyncDataCache& cache,
       std::shared_ptr<IoStatistics> ioStats,
       uint64_t groupId,
+      int32_t cacheGroup,
       std::vector<CacheRequest*> requests)
       : CoalescedLoad(makeKeys(requests), makeSizes(requests)),
         cache_(cache),
         ioStats_(std::move(ioStats)),
-        groupId_(groupId) {
+        groupId_(groupId),
+        cacheGroup_(cacheGroup) {
     for (auto& request : requests) {
       size_ += request->size;
       requests_.push_back(std::move(*request));
@@ -368,6 +379,7 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
   std::vector<CacheRequest> requests_;
   std::shared_ptr<IoStatistics> ioStats_;
   const uint64_t groupId_;
+  const int32_t cacheGroup_;
   int64_t size_{0};
 };
 
@@ -379,11 +391,19 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
       std::shared_ptr<ReadFileInputStream> input,
       std::shared_ptr<IoStatistics> ioStats,
       uint64_t groupId,
+      int32_t cacheGroup,
       std::vector<CacheRequest*> requests,
-      int32_t maxCoalesceDistance)
-      : DwioCoalescedLoadBase(cache, ioStats, groupId, std::move(requests)),
+      int32_t maxCoalesceDistance,
+      std::string storage)
+      : DwioCoalescedLoadBase(
+            cache,
+            ioStats,
+            groupId,
+            cacheGroup,
+            std::move(requests)),
         input_(std::move(input)),
-        maxCoalesceDistance_(maxCoalesceDistance) {}
+        maxCoalesceDistance_(maxCoalesceDistance),
+        storage_(std::move(storage)) {}
 
   std::vector<CachePin> loadData(bool isPrefetch) override {
     std::vector<CachePin> pins;
@@ -396,7 +416,8 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             pin.checkedEntry()->setPrefetch(true);
           }
           pins.push_back(std::move(pin));
-        });
+        },
+        cacheGroup_);
     if (pins.empty()) {
       return pins;
     }
@@ -410,7 +431,19 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             int32_t /*end*/,
             uint64_t offset,
             const std::vector<folly::Range<char*>>& buffers) {
-          input_->read(buffers, offset, LogType::FILE);
+          uint64_t usecs = 0;
+          {
+            MicrosecondTimer timer(&usecs);
+            input_->read(buffers, offset, LogType::FILE);
+          }
+          if (!storage_.empty()) {
+            uint64_t bytes = 0;
+            for (const auto& buffer : buffers) {
+              bytes += buffer.size();
+            }
+            io::AdaptiveCoalescing::instance().recordRead(
+                storage_, bytes, usecs);
+          }
         });
     updateStats(stats, isPrefetch, false);
     return pins;
@@ -418,6 +451,8 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
 
   std::shared_ptr<ReadFileInputStream> input_;
   const int32_t maxCoalesceDistance_;
+  // Storage system to record the time of reads for, or empty.
+  const std::string storage_;
 };
 
 // Represents a CoalescedLoad from local SSD cache.
@@ -427,8 +462,14 @@ class SsdLoad : public DwioCoalescedLoadBase {
       cache::AsyncDataCache& cache,
       std::shared_ptr<IoStatistics> ioStats,
       uint64_t groupId,
+      int32_t cacheGroup,
       std::vector<CacheRequest*> requests)
-      : DwioCoalescedLoadBase(cache, ioStats, groupId, std::move(requests)) {}
+      : DwioCoalescedLoadBase(
+            cache,
+            ioStats,
+            groupId,
+            cacheGroup,
+            std::move(requests)) {}
 
   std::vector<CachePin> loadData(bool isPrefetch) override {
     std::vector<SsdPin> ssdPins;
@@ -442,7 +483,8 @@ class SsdLoad : public DwioCoalescedLoadBase {
           }
           pins.push_back(std::move(pin));
           ssdPins.push_back(std::move(requests_[index].ssdPin));
-        });
+        },
+        cacheGroup_);
     if (pins.empty()) {
       return pins;
     }
@@ -457,21 +499,25 @@ class SsdLoad : public DwioCoalescedLoadBase {
 
 void CachedBufferedInput::readRegion(
     std::vector<CacheRequest*> requests,
-    bool prefetch) {
+    bool prefetch,
+    int32_t maxCoalesceDistance) {
   if (requests.empty() || (requests.size() == 1 && !prefetch)) {
     return;
   }
   std::shared_ptr<cache::CoalescedLoad> load;
   if (!requests[0]->ssdPin.empty()) {
-    load = std::make_shared<SsdLoad>(*cache_, ioStats_, groupId_, requests);
+    load = std::make_shared<SsdLoad>(
+        *cache_, ioStats_, groupId_, cacheGroup_, requests);
   } else {
     load = std::make_shared<DwioCoalescedLoad>(
         *cache_,
         input_,
         ioStats_,
         groupId_,
+        cacheGroup_,
         requests,
-        options_.maxCoalesceDistance());
+        maxCoalesceDistance,
+        storage_);
   }
   allCoalescedLoads_.push_back(load);
   coalescedLoads_.withWLock([&](auto& loads) {
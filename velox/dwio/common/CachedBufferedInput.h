@@ -21,6 +21,7 @@
 #include "velox/common/caching/FileGroupStats.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/SsdCache.h"
+#include "velox/common/io/AdaptiveCoalescing.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/common/io/Options.h"
 #include "velox/dwio/common/BufferedInput.h"
@@ -77,7 +78,9 @@ class CachedBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(readerOptions),
+        cacheGroup_(cache->cacheGroupId(readerOptions.cacheGroup())),
+        storage_(storageName(*input_, readerOptions)) {}
 
   CachedBufferedInput(
       std::shared_ptr<ReadFileInputStream> input,
@@ -96,7 +99,9 @@ class CachedBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(readerOptions),
+        cacheGroup_(cache->cacheGroupId(readerOptions.cacheGroup())),
+        storage_(storageName(*input_, readerOptions)) {}
 
   ~CachedBufferedInput() override {
     for (auto& load : allCoalescedLoads_) {
@@ -132,6 +137,10 @@ class CachedBufferedInput : public BufferedInput {
     }
   }
 
+  std::optional<uint64_t> fileNum() const override {
+    return fileNum_;
+  }
+
   virtual std::unique_ptr<BufferedInput> clone() const override {
     return std::make_unique<CachedBufferedInput>(
         input_,
@@ -148,6 +157,11 @@ class CachedBufferedInput : public BufferedInput {
     return cache_;
   }
 
+  /// Returns the cache group of the entries made for 'this'.
+  int32_t cacheGroup() const {
+    return cacheGroup_;
+  }
+
   // Returns the CoalescedLoad that contains the correlated loads for
   // 'stream' or nullptr if none. Returns nullptr on all but first
   // call for 'stream' since the load is to be triggered by the first
@@ -171,9 +185,22 @@ class CachedBufferedInput : public BufferedInput {
   // Makes a CoalescedLoad for 'requests' to be read together, coalescing
   // IO is appropriate. If 'prefetch' is set, schedules the CoalescedLoad
   // on 'executor_'. Links the CoalescedLoad  to all CacheInputStreams that it
-  // concerns.
-
-  void readRegion(std::vector<CacheRequest*> requests, bool prefetch);
+  // concerns. Gaps of up to 'maxCoalesceDistance' between the requests are
+  // read.
+  void readRegion(
+      std::vector<CacheRequest*> requests,
+      bool prefetch,
+      int32_t maxCoalesceDistance);
+
+  // Returns the storage system of 'input' if 'options' adapt coalescing to
+  // it, otherwise an empty string.
+  static std::string storageName(
+      const ReadFileInputStream& input,
+      const io::ReaderOptions& options) {
+    return options.adaptiveCoalescing()
+        ? io::AdaptiveCoalescing::storageName(input.getName())
+        : "";
+  }
 
   cache::AsyncDataCache* cache_;
   const uint64_t fileNum_;
@@ -196,6 +223,11 @@ class CachedBufferedInput : public BufferedInput {
 
   const uint64_t fileSize_;
   io::ReaderOptions options_;
+  // Id of options_.cacheGroup() in 'cache_'.
+  const int32_t cacheGroup_;
+  // Storage system whose learned coalescing parameters are used, or empty if
+  // the parameters are set by 'options_'.
+  const std::string storage_;
 };
 
 } // namespace facebook::velox::dwio::common
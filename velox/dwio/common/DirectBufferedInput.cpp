@@ -17,6 +17,7 @@
 #include "velox/dwio/common/DirectBufferedInput.h"
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/DirectInputStream.h"
 
 DECLARE_int32(cache_prefetch_min_pct);
@@ -128,13 +129,21 @@ void DirectBufferedInput::makeLoads(
     // eligible to prefetch. This will be loaded by itself on first use.
     return;
   }
-  const int32_t maxDistance = options_.maxCoalesceDistance();
+  io::AdaptiveCoalescing::Parameters parameters{
+      options_.maxCoalesceDistance(), options_.maxCoalesceBytes()};
+  if (!storage_.empty()) {
+    parameters =
+        io::AdaptiveCoalescing::instance().parameters(storage_, parameters);
+    ioStats_->coalesceDistance().increment(parameters.maxCoalesceDistance);
+    ioStats_->coalesceBytes().increment(parameters.maxCoalesceBytes);
+  }
+  const int32_t maxDistance = parameters.maxCoalesceDistance;
   const auto loadQuantum = options_.loadQuantum();
   // If reading densely accessed, coalesce into large for best throughput, if
   // for sparse, coalesce to quantum to reduce overread. Not all sparse access
   // is correlated.
   const auto maxCoalesceBytes =
-      shouldPrefetch ? options_.maxCoalesceBytes() : loadQuantum;
+      shouldPrefetch ? parameters.maxCoalesceBytes : loadQuantum;
   std::sort(
       requests.begin(),
       requests.end(),
@@ -199,7 +208,13 @@ void DirectBufferedInput::readRegion(
     return;
   }
   auto load = std::make_shared<DirectCoalescedLoad>(
-      input_, ioStats_, groupId_, requests, pool_, options_.loadQuantum());
+      input_,
+      ioStats_,
+      groupId_,
+      requests,
+      pool_,
+      options_.loadQuantum(),
+      storage_);
   coalescedLoads_.push_back(load);
   streamToCoalescedLoad_.withWLock([&](auto& loads) {
     for (auto& request : requests) {
@@ -272,7 +287,15 @@ std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool isPrefetch) {
     lastEnd = region.offset + request.loadSize;
     size += std::min<int32_t>(loadQuantum_, region.length);
   }
-  input_->read(buffers, requests_[0].region.offset, LogType::FILE);
+  uint64_t usecs = 0;
+  {
+    MicrosecondTimer timer(&usecs);
+    input_->read(buffers, requests_[0].region.offset, LogType::FILE);
+  }
+  if (!storage_.empty()) {
+    io::AdaptiveCoalescing::instance().recordRead(
+        storage_, lastEnd - requests_[0].region.offset, usecs);
+  }
   ioStats_->read().increment(size);
   ioStats_->incRawOverreadBytes(overread);
   if (isPrefetch) {
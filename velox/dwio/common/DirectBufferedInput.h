@@ -21,6 +21,7 @@
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/FileGroupStats.h"
 #include "velox/common/caching/ScanTracker.h"
+#include "velox/common/io/AdaptiveCoalescing.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/common/io/Options.h"
 #include "velox/dwio/common/BufferedInput.h"
@@ -47,7 +48,9 @@ struct LoadRequest {
   int32_t loadSize{0};
 };
 
-/// Represents planned loads that should be performed as a single IO.
+/// Represents planned loads that should be performed as a single IO. If
+/// 'storage' is not empty, the time of the IO is recorded for adapting the
+/// coalescing of reads from 'storage'.
 class DirectCoalescedLoad : public cache::CoalescedLoad {
  public:
   DirectCoalescedLoad(
@@ -56,12 +59,14 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
       uint64_t groupId,
       const std::vector<LoadRequest*>& requests,
       memory::MemoryPool& pool,
-      int32_t loadQuantum)
+      int32_t loadQuantum,
+      std::string storage = "")
       : CoalescedLoad({}, {}),
         ioStats_(ioStats),
         groupId_(groupId),
         input_(std::move(input)),
         loadQuantum_(loadQuantum),
+        storage_(std::move(storage)),
         pool_(pool) {
     requests_.reserve(requests.size());
     for (auto i = 0; i < requests.size(); ++i) {
@@ -95,6 +100,7 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
   const uint64_t groupId_;
   const std::shared_ptr<ReadFileInputStream> input_;
   const int32_t loadQuantum_;
+  const std::string storage_;
   memory::MemoryPool& pool_;
   std::vector<LoadRequest> requests_;
 };
@@ -122,7 +128,8 @@ class DirectBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(readerOptions),
+        storage_(storageName(*input_, readerOptions)) {}
 
   ~DirectBufferedInput() override {
     for (auto& load : coalescedLoads_) {
@@ -151,6 +158,10 @@ class DirectBufferedInput : public BufferedInput {
     }
   }
 
+  std::optional<uint64_t> fileNum() const override {
+    return fileNum_;
+  }
+
   virtual std::unique_ptr<BufferedInput> clone() const override {
     std::unique_ptr<DirectBufferedInput> input(new DirectBufferedInput(
         input_, fileNum_, tracker_, groupId_, ioStats_, executor_, options_));
@@ -193,7 +204,18 @@ class DirectBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(readerOptions),
+        storage_(storageName(*input_, readerOptions)) {}
+
+  // Returns the storage system of 'input' if 'options' adapt coalescing to
+  // it, otherwise an empty string.
+  static std::string storageName(
+      const ReadFileInputStream& input,
+      const io::ReaderOptions& options) {
+    return options.adaptiveCoalescing()
+        ? io::AdaptiveCoalescing::storageName(input.getName())
+        : "";
+  }
 
   // Sorts requests and makes CoalescedLoads for nearby requests. If
   // 'shouldPrefetch' is true, starts background loading.
@@ -225,6 +247,10 @@ class DirectBufferedInput : public BufferedInput {
   std::vector<std::shared_ptr<cache::CoalescedLoad>> coalescedLoads_;
 
   io::ReaderOptions options_;
+
+  // Storage system whose learned coalescing parameters are used, or empty if
+  // the parameters are set by 'options_'.
+  const std::string storage_;
 };
 
 } // namespace facebook::velox::dwio::common
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include <fmt/format.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+FileMetadataCache*& instance() {
+  static FileMetadataCache* cache{nullptr};
+  return cache;
+}
+} // namespace
+
+std::string FileMetadataCache::Stats::toString() const {
+  return fmt::format(
+      "File metadata cache: {} entries, {}, {} lookups, {} hits, {} evictions",
+      numEntries,
+      succinctBytes(bytes),
+      numLookups,
+      numHits,
+      numEvictions);
+}
+
+FileMetadataCache::FileMetadataCache(uint64_t capacity)
+    : capacity_(capacity),
+      pool_(memory::memoryManager()->addLeafPool("FileMetadataCache")) {}
+
+// static
+FileMetadataCache* FileMetadataCache::getInstance() {
+  return instance();
+}
+
+// static
+void FileMetadataCache::setInstance(FileMetadataCache* cache) {
+  instance() = cache;
+}
+
+std::shared_ptr<const FileMetadataCache::Entry> FileMetadataCache::get(
+    const std::string& fileName,
+    uint64_t fileLength) {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numLookups_;
+  auto it = entries_.find(Key{fileName, fileLength});
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  ++numHits_;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->entry;
+}
+
+void FileMetadataCache::put(
+    const std::string& fileName,
+    uint64_t fileLength,
+    std::shared_ptr<const Entry> entry,
+    uint64_t bytes) {
+  VELOX_CHECK_NOT_NULL(entry);
+  if (bytes > capacity_ / 4) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  Key key{fileName, fileLength};
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    removeLocked(it->second);
+  }
+  while (!lru_.empty() && bytes_ + bytes > capacity_) {
+    removeLocked(std::prev(lru_.end()));
+    ++numEvictions_;
+  }
+  lru_.push_front(CachedEntry{key, std::move(entry), bytes});
+  entries_.emplace(std::move(key), lru_.begin());
+  bytes_ += bytes;
+}
+
+void FileMetadataCache::removeLocked(EntryList::iterator it) {
+  bytes_ -= it->bytes;
+  entries_.erase(it->key);
+  lru_.erase(it);
+}
+
+void FileMetadataCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  bytes_ = 0;
+}
+
+FileMetadataCache::Stats FileMetadataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  Stats stats;
+  stats.numEntries = entries_.size();
+  stats.bytes = bytes_;
+  stats.numLookups = numLookups_;
+  stats.numHits = numHits_;
+  stats.numEvictions = numEvictions_;
+  return stats;
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "velox/common/memory/Memory.h"
+
+namespace facebook::velox::dwio::common {
+
+/// A process-wide, memory-bounded cache of parsed file metadata, e.g. the
+/// DWRF post script, footer and stripe metadata or the Parquet FileMetaData.
+/// Readers of the same file in different splits and queries share one parsed
+/// copy instead of each reading and parsing the file tail. Entries are keyed
+/// by file name and file length, so a file rewritten with a different length
+/// is not confused with its earlier version. Least recently used entries are
+/// evicted when the total size exceeds the capacity. Buffers held by entries
+/// are allocated from pool(), so the memory of the cache shows up under its
+/// own MemoryPool.
+class FileMetadataCache {
+ public:
+  /// Parsed metadata of one file. Subclasses are specific to a file format.
+  /// Entries are immutable once added and may be used by many readers at a
+  /// time.
+  class Entry {
+   public:
+    virtual ~Entry() = default;
+  };
+
+  struct Stats {
+    int64_t numEntries{0};
+    /// Estimated memory of the cached entries.
+    uint64_t bytes{0};
+    uint64_t numLookups{0};
+    uint64_t numHits{0};
+    uint64_t numEvictions{0};
+
+    std::string toString() const;
+  };
+
+  /// Constructs a cache holding up to 'capacity' bytes of metadata.
+  explicit FileMetadataCache(uint64_t capacity);
+
+  /// Returns the process-wide cache or nullptr if metadata is not cached.
+  static FileMetadataCache* getInstance();
+
+  /// Sets the process-wide cache. The caller keeps ownership. nullptr turns
+  /// off caching.
+  static void setInstance(FileMetadataCache* cache);
+
+  /// Returns the entry for the file of 'fileLength' bytes named 'fileName'
+  /// or nullptr if not cached.
+  std::shared_ptr<const Entry> get(
+      const std::string& fileName,
+      uint64_t fileLength);
+
+  /// Like get() but returns nullptr also if the entry is not a 'T'.
+  template <typename T>
+  std::shared_ptr<const T> get(
+      const std::string& fileName,
+      uint64_t fileLength) {
+    return std::dynamic_pointer_cast<const T>(get(fileName, fileLength));
+  }
+
+  /// Adds 'entry' of an estimated 'bytes' for the file of 'fileLength' bytes
+  /// named 'fileName'. Replaces an existing entry for the same key. Entries
+  /// larger than a quarter of the capacity are not added.
+  void put(
+      const std::string& fileName,
+      uint64_t fileLength,
+      std::shared_ptr<const Entry> entry,
+      uint64_t bytes);
+
+  /// Pool for the buffers held by entries. An entry with buffers from the
+  /// pool should also hold a reference to the pool since the entry may be in
+  /// use after the cache is gone.
+  const std::shared_ptr<memory::MemoryPool>& pool() const {
+    return pool_;
+  }
+
+  uint64_t capacity() const {
+    return capacity_;
+  }
+
+  /// Drops all entries. Entries in use by readers stay valid.
+  void clear();
+
+  Stats stats() const;
+
+ private:
+  using Key = std::pair<std::string, uint64_t>;
+
+  struct CachedEntry {
+    Key key;
+    std::shared_ptr<const Entry> entry;
+    uint64_t bytes;
+  };
+
+  using EntryList = std::list<CachedEntry>;
+
+  // Removes 'it' from 'entries_' and 'lru_'. 'mutex_' must be held.
+  void removeLocked(EntryList::iterator it);
+
+  const uint64_t capacity_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  // Entries from most to least recently used.
+  EntryList lru_;
+  folly::F14FastMap<Key, EntryList::iterator> entries_;
+  uint64_t bytes_{0};
+  uint64_t numLookups_{0};
+  uint64_t numHits_{0};
+  uint64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox::dwio::common
@@ -95,6 +95,9 @@ class FormatData {
         const velox::common::MetadataFilter::LeafNode*,
         std::vector<uint64_t>>>
         metadataFilterResults;
+    /// Row groups in 'filterResult' that were dropped by bloom filters after
+    /// passing the filter on their statistics.
+    std::vector<uint64_t> bloomFilterResult;
     int totalCount = 0;
   };
 
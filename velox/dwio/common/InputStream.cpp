@@ -22,6 +22,7 @@
 #include <glog/logging.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <algorithm>
 #include <cerrno>
 #include <cstdint>
 #include <cstring>
@@ -70,7 +71,31 @@ ReadFileInputStream::ReadFileInputStream(
     const MetricsLogPtr& metricsLog,
     IoStatistics* stats)
     : InputStream(readFile->getName(), metricsLog, stats),
-      readFile_(std::move(readFile)) {}
+      readFile_(std::move(readFile)),
+      hedgedFile_(dynamic_cast<const HedgedReadFile*>(readFile_.get())) {}
+
+void ReadFileInputStream::recordHedge(const HedgeOutcome& outcome) {
+  if (stats_ == nullptr || !outcome.hedged) {
+    return;
+  }
+  stats_->incNumHedgedReads(1);
+  if (outcome.hedgeWon) {
+    stats_->incNumHedgeWins(1);
+  }
+}
+
+void ReadFileInputStream::recordLocality(uint64_t offset, uint64_t length) {
+  if (stats_ == nullptr) {
+    return;
+  }
+  const auto localBytes = readFile_->localBytes(offset, length);
+  if (!localBytes.has_value()) {
+    return;
+  }
+  const auto local = std::min(localBytes.value(), length);
+  stats_->incLocalBytesRead(local);
+  stats_->incRemoteBytesRead(length - local);
+}
 
 void ReadFileInputStream::read(
     void* buf,
@@ -82,7 +107,15 @@ void ReadFileInputStream::read(
   }
   logRead(offset, length, purpose);
   auto readStartMicros = getCurrentTimeMicro();
-  std::string_view data_read = readFile_->pread(offset, length, buf);
+  std::string_view data_read;
+  if (hedgedFile_ != nullptr) {
+    HedgeOutcome outcome;
+    data_read = hedgedFile_->pread(offset, length, buf, &outcome);
+    recordHedge(outcome);
+  } else {
+    data_read = readFile_->pread(offset, length, buf);
+  }
+  recordLocality(offset, length);
   if (stats_) {
     stats_->incRawBytesRead(length);
     stats_->incTotalScanTime((getCurrentTimeMicro() - readStartMicros) * 1000);
@@ -107,7 +140,15 @@ void ReadFileInputStream::read(
     LogType logType) {
   const int64_t bufferSize = totalBufferSize(buffers);
   logRead(offset, bufferSize, logType);
-  auto size = readFile_->preadv(offset, buffers);
+  uint64_t size;
+  if (hedgedFile_ != nullptr) {
+    HedgeOutcome outcome;
+    size = hedgedFile_->preadv(offset, buffers, &outcome);
+    recordHedge(outcome);
+  } else {
+    size = readFile_->preadv(offset, buffers);
+  }
+  recordLocality(offset, bufferSize);
   DWIO_ENSURE_EQ(
       size,
       bufferSize,
@@ -127,6 +168,7 @@ folly::SemiFuture<uint64_t> ReadFileInputStream::readAsync(
     LogType logType) {
   const int64_t bufferSize = totalBufferSize(buffers);
   logRead(offset, bufferSize, logType);
+  recordLocality(offset, bufferSize);
   return readFile_->preadvAsync(offset, buffers);
 }
 
@@ -147,6 +189,9 @@ void ReadFileInputStream::vread(
   logRead(regions[0].offset, length, purpose);
   auto readStartMicros = getCurrentTimeMicro();
   readFile_->preadv(regions, iobufs);
+  for (const auto& region : regions) {
+    recordLocality(region.offset, region.length);
+  }
   if (stats_) {
     stats_->incRawBytesRead(length);
     stats_->incTotalScanTime((getCurrentTimeMicro() - readStartMicros) * 1000);
@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "velox/common/file/File.h"
+#include "velox/common/file/HedgedReadFile.h"
 #include "velox/common/file/Region.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/dwio/common/MetricsLog.h"
@@ -177,7 +178,16 @@ class ReadFileInputStream final : public InputStream {
   }
 
  private:
+  // Adds the hedge of a read of 'hedgedFile_' to 'stats_'.
+  void recordHedge(const HedgeOutcome& outcome);
+
+  // Adds the local and remote bytes of a read of 'length' bytes at 'offset'
+  // to 'stats_' if 'readFile_' knows where its data is stored.
+  void recordLocality(uint64_t offset, uint64_t length);
+
   std::shared_ptr<velox::ReadFile> readFile_;
+  // 'readFile_' if it hedges its reads, otherwise nullptr.
+  const HedgedReadFile* hedgedFile_;
 };
 
 } // namespace facebook::velox::dwio::common
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/MmapBufferedInput.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <folly/String.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/file/File.h"
+
+namespace facebook::velox::dwio::common {
+
+MmapBufferedInput::Mapping::Mapping(int32_t fd, uint64_t size) : size(size) {
+  void* address = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  VELOX_CHECK(
+      address != MAP_FAILED,
+      "mmap of {} bytes failed: {}",
+      size,
+      folly::errnoStr(errno));
+  data = reinterpret_cast<const char*>(address);
+}
+
+MmapBufferedInput::Mapping::~Mapping() {
+  if (munmap(const_cast<char*>(data), size) != 0) {
+    LOG(WARNING) << "munmap failed: " << folly::errnoStr(errno);
+  }
+}
+
+MmapBufferedInput::MmapBufferedInput(
+    std::shared_ptr<ReadFile> readFile,
+    memory::MemoryPool& pool,
+    std::shared_ptr<IoStatistics> ioStats,
+    const MetricsLogPtr& metricsLog)
+    : BufferedInput(readFile, pool, metricsLog),
+      ioStats_(std::move(ioStats)),
+      mapping_(std::make_shared<Mapping>(
+          dynamic_cast<const LocalReadFile&>(*readFile).fd(),
+          readFile->size())) {}
+
+MmapBufferedInput::MmapBufferedInput(
+    std::shared_ptr<ReadFileInputStream> input,
+    memory::MemoryPool& pool,
+    std::shared_ptr<IoStatistics> ioStats,
+    std::shared_ptr<const Mapping> mapping)
+    : BufferedInput(std::move(input), pool),
+      ioStats_(std::move(ioStats)),
+      mapping_(std::move(mapping)) {}
+
+// static
+bool MmapBufferedInput::canMap(const ReadFile& readFile) {
+  const auto* localFile = dynamic_cast<const LocalReadFile*>(&readFile);
+  return localFile != nullptr && localFile->fd() >= 0 &&
+      !localFile->directIo() && localFile->size() > 0;
+}
+
+std::unique_ptr<SeekableInputStream> MmapBufferedInput::enqueue(
+    velox::common::Region region,
+    const StreamIdentifier* /*sid*/) {
+  if (region.length == 0) {
+    return std::make_unique<SeekableArrayInputStream>(
+        static_cast<const char*>(nullptr), 0);
+  }
+  regions_.push_back(region);
+  return makeStream(region.offset, region.length);
+}
+
+void MmapBufferedInput::load(const LogType /*logType*/) {
+  static const uint64_t kPageSize = sysconf(_SC_PAGESIZE);
+  for (const auto& region : regions_) {
+    // madvise() takes page aligned addresses.
+    const uint64_t begin = region.offset / kPageSize * kPageSize;
+    const uint64_t end = bits::roundUp(
+        std::min(region.offset + region.length, mapping_->size), kPageSize);
+    if (madvise(
+            const_cast<char*>(mapping_->data) + begin,
+            end - begin,
+            MADV_WILLNEED) != 0) {
+      VLOG(1) << "madvise failed: " << folly::errnoStr(errno);
+    }
+  }
+  regions_.clear();
+}
+
+bool MmapBufferedInput::isBuffered(uint64_t offset, uint64_t length) const {
+  return offset + length <= mapping_->size;
+}
+
+std::unique_ptr<SeekableInputStream>
+MmapBufferedInput::read(uint64_t offset, uint64_t length, LogType /*logType*/)
+    const {
+  return makeStream(offset, length);
+}
+
+std::unique_ptr<BufferedInput> MmapBufferedInput::clone() const {
+  return std::unique_ptr<MmapBufferedInput>(
+      new MmapBufferedInput(input_, pool_, ioStats_, mapping_));
+}
+
+uint64_t MmapBufferedInput::nextFetchSize() const {
+  uint64_t size = 0;
+  for (const auto& region : regions_) {
+    size += region.length;
+  }
+  return size;
+}
+
+std::unique_ptr<SeekableInputStream> MmapBufferedInput::makeStream(
+    uint64_t offset,
+    uint64_t length) const {
+  VELOX_CHECK_LE(
+      offset + length,
+      mapping_->size,
+      "Read past the end of {}",
+      input_->getName());
+  if (ioStats_) {
+    ioStats_->incRawBytesRead(length);
+    ioStats_->read().increment(length);
+  }
+  return std::make_unique<SeekableArrayInputStream>(
+      mapping_->data + offset, length);
+}
+
+} // namespace facebook::velox::dwio::common
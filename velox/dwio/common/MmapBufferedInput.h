@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/io/IoStatistics.h"
+#include "velox/dwio/common/BufferedInput.h"
+
+namespace facebook::velox::dwio::common {
+
+/// BufferedInput that maps a local file into memory and returns streams over
+/// the mapped pages, so that decoders read the file's page cache without
+/// copying it into buffers or cache entries. load() asks the kernel to read
+/// ahead the enqueued regions.
+///
+/// The mapped pages belong to the page cache and are not allocated from the
+/// memory pool. The bytes returned by streams are counted as storage reads
+/// in 'IoStatistics' and the size of the mapping in mappedBytes().
+class MmapBufferedInput : public BufferedInput {
+ public:
+  /// 'readFile' must be a file for which canMap() is true.
+  MmapBufferedInput(
+      std::shared_ptr<ReadFile> readFile,
+      memory::MemoryPool& pool,
+      std::shared_ptr<IoStatistics> ioStats = nullptr,
+      const MetricsLogPtr& metricsLog = MetricsLog::voidLog());
+
+  /// True if 'readFile' is a local file that can be mapped, i.e. an open
+  /// non-empty local file not opened for direct IO.
+  static bool canMap(const ReadFile& readFile);
+
+  std::unique_ptr<SeekableInputStream> enqueue(
+      velox::common::Region region,
+      const StreamIdentifier* sid = nullptr) override;
+
+  void load(const LogType logType) override;
+
+  bool isBuffered(uint64_t offset, uint64_t length) const override;
+
+  std::unique_ptr<SeekableInputStream>
+  read(uint64_t offset, uint64_t length, LogType logType) const override;
+
+  std::unique_ptr<BufferedInput> clone() const override;
+
+  uint64_t nextFetchSize() const override;
+
+  /// Size of the mapping of the file.
+  uint64_t mappedBytes() const {
+    return mapping_->size;
+  }
+
+ private:
+  // A read-only shared mapping of a whole file. Shared by clones.
+  struct Mapping {
+    Mapping(int32_t fd, uint64_t size);
+
+    ~Mapping();
+
+    const char* data{nullptr};
+    uint64_t size{0};
+  };
+
+  MmapBufferedInput(
+      std::shared_ptr<ReadFileInputStream> input,
+      memory::MemoryPool& pool,
+      std::shared_ptr<IoStatistics> ioStats,
+      std::shared_ptr<const Mapping> mapping);
+
+  std::unique_ptr<SeekableInputStream> makeStream(
+      uint64_t offset,
+      uint64_t length) const;
+
+  const std::shared_ptr<IoStatistics> ioStats_;
+  const std::shared_ptr<const Mapping> mapping_;
+
+  // Regions enqueued since the last load().
+  std::vector<velox::common::Region> regions_;
+};
+
+} // namespace facebook::velox::dwio::common
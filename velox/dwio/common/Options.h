@@ -613,6 +613,13 @@ struct WriterOptions {
   std::optional<uint64_t> maxDictionaryMemory{std::nullopt};
   std::map<std::string, std::string> serdeParameters;
   std::optional<uint8_t> parquetWriteTimestampUnit;
+  /// Optional executor on which writers may encode columns in parallel,
+  /// using up to 'encodingParallelismFactor' threads.
+  std::shared_ptr<folly::Executor> encodingExecutor;
+  size_t encodingParallelismFactor{0};
+  /// Optional executor on which writers may write flushed data to the sink
+  /// in the background. Must outlive the writer.
+  folly::Executor* uploadExecutor{nullptr};
 };
 
 } // namespace facebook::velox::dwio::common
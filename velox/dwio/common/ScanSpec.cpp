@@ -24,9 +24,11 @@ ScanSpec* ScanSpec::getOrCreateChild(const Subfield& subfield) {
   auto& path = subfield.path();
   for (size_t depth = 0; depth < path.size(); ++depth) {
     auto element = path[depth].get();
-    VELOX_CHECK_EQ(element->kind(), kNestedField);
-    auto* nestedField = static_cast<const Subfield::NestedField*>(element);
-    auto it = container->childByFieldName_.find(nestedField->name());
+    // Subscripts are allowed for the values of single map keys.
+    const auto name = element->kind() == kNestedField
+        ? static_cast<const Subfield::NestedField*>(element)->name()
+        : element->toString();
+    auto it = container->childByFieldName_.find(name);
     if (it != container->childByFieldName_.end()) {
       container = it->second;
     } else {
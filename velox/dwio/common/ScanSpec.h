@@ -49,8 +49,16 @@ class ScanSpec {
       auto field = reinterpret_cast<const Subfield::NestedField*>(&element);
       fieldName_ = field->name();
 
+    } else if (element.kind() == kStringSubscript) {
+      fieldName_ = element.toString();
+      mapKey_ =
+          reinterpret_cast<const Subfield::StringSubscript*>(&element)->index();
+    } else if (element.kind() == kLongSubscript) {
+      fieldName_ = element.toString();
+      mapKey_ = std::to_string(
+          reinterpret_cast<const Subfield::LongSubscript*>(&element)->index());
     } else {
-      VELOX_CHECK(false, "Only nested fields are supported");
+      VELOX_CHECK(false, "Only nested fields and subscripts are supported");
     }
   }
 
@@ -322,6 +330,15 @@ class ScanSpec {
     flatMapFeatureSelection_ = std::move(features);
   }
 
+  // The key if 'this' is the spec of the values of a single key of a map,
+  // e.g. for a filter on m['key']. Such children are made by
+  // getOrCreateChild() for a subscript and are named by the subscript, e.g.
+  // '["key"]'. Integer keys are in decimal. Only the DWRF flat map reader
+  // supports them.
+  const std::optional<std::string>& mapKey() const {
+    return mapKey_;
+  }
+
   /// Invoke the function provided on each node of the ScanSpec tree.
   template <typename F>
   void visit(const Type& type, F&& f);
@@ -405,6 +422,9 @@ class ScanSpec {
 
   // Used only for bulk reader to project flat map features.
   std::vector<std::string> flatMapFeatureSelection_;
+
+  // See mapKey().
+  std::optional<std::string> mapKey_;
 };
 
 template <typename F>
@@ -269,7 +269,14 @@ SelectiveMapColumnReader::SelectiveMapColumnReader(
           params,
           scanSpec,
           fileType),
-      requestedType_{requestedType} {}
+      requestedType_{requestedType} {
+  for (auto& child : scanSpec.children()) {
+    VELOX_USER_CHECK(
+        !child->mapKey().has_value(),
+        "Filters on map subscripts are only supported on DWRF flat maps: {}",
+        child->fieldName());
+  }
+}
 
 uint64_t SelectiveMapColumnReader::skip(uint64_t numValues) {
   numValues = formatData_->skipNulls(numValues);
@@ -18,6 +18,7 @@
 
 #include "velox/common/process/TraceContext.h"
 #include "velox/dwio/common/ColumnLoader.h"
+#include "velox/dwio/common/ParallelFor.h"
 
 namespace facebook::velox::dwio::common {
 
@@ -158,6 +159,8 @@ void SelectiveStructColumnReaderBase::read(
 
   auto& childSpecs = scanSpec_->children();
   VELOX_CHECK(!childSpecs.empty());
+  // Children without filters that are read in parallel after the filters.
+  std::vector<SelectiveColumnReader*> parallelReaders;
   for (size_t i = 0; i < childSpecs.size(); ++i) {
     auto& childSpec = childSpecs[i];
     VELOX_TRACE_HISTORY_PUSH("read %s", childSpec->fieldName().c_str());
@@ -168,7 +171,10 @@ void SelectiveStructColumnReaderBase::read(
     auto reader = children_.at(fieldIndex);
     if (reader->isTopLevel() && childSpec->projectOut() &&
         !childSpec->hasFilter() && !childSpec->extractValues()) {
-      // Will make a LazyVector.
+      if (decodesInParallel()) {
+        parallelReaders.push_back(reader);
+      }
+      // Otherwise will make a LazyVector.
       continue;
     }
     advanceFieldReader(reader, offset);
@@ -193,6 +199,20 @@ void SelectiveStructColumnReaderBase::read(
     }
   }
 
+  if (!parallelReaders.empty() && !activeRows.empty()) {
+    for (auto* reader : parallelReaders) {
+      advanceFieldReader(reader, offset);
+    }
+    ParallelFor(
+        decodingExecutor_,
+        0,
+        parallelReaders.size(),
+        decodingParallelismFactor_)
+        .execute([&](size_t i) {
+          parallelReaders[i]->read(offset, activeRows, structNulls);
+        });
+  }
+
   // If this adds nulls, the field readers will miss a value for each null added
   // here.
   recordParentNullsInChildren(offset, rows);
@@ -363,6 +383,8 @@ void SelectiveStructColumnReaderBase::getValues(
     resultRow->clearNulls(0, rows.size());
   }
   bool lazyPrepared = false;
+  // Children read in parallel in read() and the results to fill from them.
+  std::vector<std::pair<SelectiveColumnReader*, VectorPtr*>> parallelResults;
   for (auto& childSpec : scanSpec_->children()) {
     VELOX_TRACE_HISTORY_PUSH("getValues %s", childSpec->fieldName().c_str());
     if (!childSpec->projectOut()) {
@@ -387,6 +409,10 @@ void SelectiveStructColumnReaderBase::getValues(
       children_[index]->getValues(rows, &childResult);
       continue;
     }
+    if (decodesInParallel()) {
+      parallelResults.emplace_back(children_[index], &childResult);
+      continue;
+    }
     // LazyVector result.
     if (!lazyPrepared) {
       if (rows.size() != outputRows_.size()) {
@@ -408,6 +434,14 @@ void SelectiveStructColumnReaderBase::getValues(
           std::move(childResult));
     }
   }
+  ParallelFor(
+      decodingExecutor_,
+      0,
+      parallelResults.size(),
+      decodingParallelismFactor_)
+      .execute([&](size_t i) {
+        parallelResults[i].first->getValues(rows, parallelResults[i].second);
+      });
   resultRow->updateContainsLazyNotLoaded();
 }
 
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/dwio/common/SelectiveColumnReaderInternal.h"
 
 namespace facebook::velox::dwio::common {
@@ -95,6 +97,19 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
     return debugString_;
   }
 
+  /// Decodes the projected children without filters eagerly with up to
+  /// 'parallelismFactor' threads, using 'executor' for all but one of them,
+  /// instead of returning them as LazyVectors. The filtered children are
+  /// still read first and one at a time. Only for the root struct, so that
+  /// tasks on 'executor' do not wait for other tasks on it.
+  void setDecodingParallelism(
+      folly::Executor* executor,
+      size_t parallelismFactor) {
+    VELOX_CHECK(isRoot_, "Parallel decoding is only for the root struct");
+    decodingExecutor_ = executor;
+    decodingParallelismFactor_ = parallelismFactor;
+  }
+
  protected:
   // The subscript of childSpecs will be set to this value if the column is
   // constant (either explicitly or because it's missing).
@@ -126,6 +141,10 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
   // need to read it).
   bool isChildConstant(const velox::common::ScanSpec& childSpec) const;
 
+  bool decodesInParallel() const {
+    return decodingExecutor_ && decodingParallelismFactor_ > 1;
+  }
+
   const std::shared_ptr<const dwio::common::TypeWithId> requestedType_;
 
   std::vector<SelectiveColumnReader*> children_;
@@ -155,6 +174,11 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
   // Whether or not this is the root Struct that represents entire rows of the
   // table.
   const bool isRoot_;
+
+  // Executor and number of threads for decoding the children without filters
+  // in parallel. See setDecodingParallelism().
+  folly::Executor* decodingExecutor_{nullptr};
+  size_t decodingParallelismFactor_{0};
 };
 
 struct SelectiveStructColumnReader : SelectiveStructColumnReaderBase {
@@ -535,16 +535,44 @@ struct RuntimeStatistics {
   // Number of strides (row groups) skipped based on statistics.
   int64_t skippedStrides{0};
 
+  // Number of the strides in 'skippedStrides' that passed the filters on
+  // their min/max statistics and were skipped based on bloom filters.
+  int64_t skippedStridesByBloomFilter{0};
+
+  // Number of the strides in 'skippedStrides' that passed the filters on
+  // their statistics and were skipped because no value in the dictionary of
+  // a fully dictionary encoded column passed the filter on the column.
+  int64_t skippedStridesByDictionary{0};
+
+  // Number of data pages of filtered columns skipped based on the statistics
+  // in the page index.
+  int64_t skippedPages{0};
+
+  // Largest number of units (stripes or row groups) loaded ahead of the unit
+  // being read by readers with adaptive prefetch. 0 if there is no such
+  // reader.
+  int64_t maxPrefetchDepth{0};
+
   ColumnReaderStatistics columnReaderStatistics;
 
   std::unordered_map<std::string, RuntimeCounter> toMap() {
-    return {
+    std::unordered_map<std::string, RuntimeCounter> map{
         {"skippedSplits", RuntimeCounter(skippedSplits)},
         {"skippedSplitBytes",
          RuntimeCounter(skippedSplitBytes, RuntimeCounter::Unit::kBytes)},
         {"skippedStrides", RuntimeCounter(skippedStrides)},
+        {"skippedStridesByBloomFilter",
+         RuntimeCounter(skippedStridesByBloomFilter)},
+        {"skippedStridesByDictionary",
+         RuntimeCounter(skippedStridesByDictionary)},
+        {"skippedPages", RuntimeCounter(skippedPages)},
         {"flattenStringDictionaryValues",
          RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues)}};
+    // Reported only by scans with adaptive prefetch.
+    if (maxPrefetchDepth > 0) {
+      map.emplace("maxPrefetchDepth", RuntimeCounter(maxPrefetchDepth));
+    }
+    return map;
   }
 };
 
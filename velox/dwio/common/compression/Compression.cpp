@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/common/compression/Compression.h"
+#include "velox/common/compression/HardwareDecompressor.h"
 #include "velox/common/compression/LzoDecompressor.h"
 #include "velox/dwio/common/IntCodecCommon.h"
 #include "velox/dwio/common/compression/PagedInputStream.h"
@@ -494,6 +495,60 @@ std::pair<int64_t, bool> SnappyDecompressor::getDecompressedLength(
   return {uncompressedLength, true};
 }
 
+// Offloads blocks to a HardwareDecompressor and decompresses them with
+// 'software_' if the offload fails.
+class OffloadingDecompressor : public Decompressor {
+ public:
+  OffloadingDecompressor(
+      std::unique_ptr<Decompressor> software,
+      std::shared_ptr<velox::common::HardwareDecompressor> hardware,
+      CompressionKind kind,
+      int32_t windowBits,
+      IoStatistics* ioStats,
+      uint64_t blockSize,
+      const std::string& streamDebugInfo)
+      : Decompressor{blockSize, streamDebugInfo},
+        software_{std::move(software)},
+        hardware_{std::move(hardware)},
+        kind_{kind},
+        windowBits_{windowBits},
+        ioStats_{ioStats} {}
+
+  std::pair<int64_t, bool> getDecompressedLength(
+      const char* src,
+      uint64_t srcLength) const override {
+    return software_->getDecompressedLength(src, srcLength);
+  }
+
+  uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override {
+    auto result = hardware_
+                      ->decompress(
+                          kind_,
+                          windowBits_,
+                          folly::StringPiece(src, srcLength),
+                          folly::MutableStringPiece(dest, destLength))
+                      .getTry();
+    if (result.hasValue() && result.value() <= destLength) {
+      if (ioStats_ != nullptr) {
+        ioStats_->incOffloadedDecompressionBytes(srcLength);
+      }
+      return result.value();
+    }
+    return software_->decompress(src, srcLength, dest, destLength);
+  }
+
+ private:
+  const std::unique_ptr<Decompressor> software_;
+  const std::shared_ptr<velox::common::HardwareDecompressor> hardware_;
+  const CompressionKind kind_;
+  const int32_t windowBits_;
+  IoStatistics* const ioStats_;
+};
+
 // TODO: Is this really needed?
 class ZlibDecompressionStream : public PagedInputStream,
                                 private ZlibDecompressor {
@@ -650,7 +705,25 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     const std::string& streamDebugInfo,
     const Decrypter* decrypter,
     bool useRawDecompression,
-    size_t compressedLength) {
+    size_t compressedLength,
+    IoStatistics* ioStats) {
+  // Blocks are offloaded one at a time, so zlib is decompressed by block
+  // instead of streaming when it can be offloaded.
+  auto hardware = velox::common::hardwareDecompressor();
+  int32_t windowBits = 0;
+  if (kind == CompressionKind::CompressionKind_ZLIB ||
+      kind == CompressionKind::CompressionKind_GZIP) {
+    windowBits = options.format.zlib.windowBits;
+  } else if (
+      (kind == CompressionKind::CompressionKind_LZ4 ||
+       kind == CompressionKind::CompressionKind_LZO) &&
+      options.format.lz4_lzo.isHadoopFrameFormat) {
+    hardware = nullptr;
+  }
+  if (hardware != nullptr && !hardware->supports(kind, windowBits)) {
+    hardware = nullptr;
+  }
+
   std::unique_ptr<Decompressor> decompressor;
   switch (static_cast<int64_t>(kind)) {
     case CompressionKind::CompressionKind_NONE:
@@ -658,9 +731,10 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
         return input;
       }
       // decompressor remain as nullptr
+      hardware = nullptr;
       break;
     case CompressionKind::CompressionKind_ZLIB:
-      if (!decrypter) {
+      if (!decrypter && hardware == nullptr) {
         // When file is not encrypted, we can use zlib streaming codec to avoid
         // copying data
         return std::make_unique<ZlibDecompressionStream>(
@@ -677,7 +751,7 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
           blockSize, options.format.zlib.windowBits, streamDebugInfo, false);
       break;
     case CompressionKind::CompressionKind_GZIP:
-      if (!decrypter) {
+      if (!decrypter && hardware == nullptr) {
         // When file is not encrypted, we can use zlib streaming codec to avoid
         // copying data
         return std::make_unique<ZlibDecompressionStream>(
@@ -716,6 +790,16 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     default:
       DWIO_RAISE("Unknown compression codec ", kind);
   }
+  if (hardware != nullptr) {
+    decompressor = std::make_unique<OffloadingDecompressor>(
+        std::move(decompressor),
+        std::move(hardware),
+        kind,
+        windowBits,
+        ioStats,
+        blockSize,
+        streamDebugInfo);
+  }
   return std::make_unique<PagedInputStream>(
       std::move(input),
       pool,
@@ -164,10 +164,25 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
 
   // perform decryption
   if (decrypter_) {
-    decryptionBuffer_ =
-        decrypter_->decrypt(folly::StringPiece{input, remainingLength_});
-    input = reinterpret_cast<const char*>(decryptionBuffer_->data());
-    remainingLength_ = decryptionBuffer_->length();
+    const folly::StringPiece encrypted{input, remainingLength_};
+    std::optional<size_t> decryptedSize;
+    if (decrypter_->supportsDecryptInto()) {
+      if (!decryptedBuffer_ ||
+          decryptedBuffer_->capacity() < remainingLength_) {
+        decryptedBuffer_ = std::make_unique<dwio::common::DataBuffer<char>>(
+            pool_, remainingLength_);
+      }
+      decryptedSize = decrypter_->decryptInto(
+          encrypted, decryptedBuffer_->data(), decryptedBuffer_->capacity());
+    }
+    if (decryptedSize.has_value()) {
+      input = decryptedBuffer_->data();
+      remainingLength_ = decryptedSize.value();
+    } else {
+      decryptionBuffer_ = decrypter_->decrypt(encrypted);
+      input = reinterpret_cast<const char*>(decryptionBuffer_->data());
+      remainingLength_ = decryptionBuffer_->length();
+    }
     if (data) {
       *data = input;
     }
@@ -141,6 +141,10 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
   // unencrypted output
   std::unique_ptr<folly::IOBuf> decryptionBuffer_{nullptr};
 
+  // unencrypted output of decrypters that write to a caller's buffer. Reused
+  // across blocks.
+  std::unique_ptr<dwio::common::DataBuffer<char>> decryptedBuffer_{nullptr};
+
   // the current state
   State state_{State::HEADER};
 
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "folly/Range.h"
 #include "folly/io/IOBuf.h"
 #include "velox/dwio/common/exception/Exception.h"
@@ -89,6 +91,23 @@ class Decrypter {
   virtual std::unique_ptr<folly::IOBuf> decrypt(
       folly::StringPiece input) const = 0;
 
+  /// Returns true if decryptInto() is supported. Readers then decrypt every
+  /// block into one reused buffer instead of allocating a result per block.
+  virtual bool supportsDecryptInto() const {
+    return false;
+  }
+
+  /// Decrypts 'input' into 'output', which has 'capacity' bytes, and returns
+  /// the decrypted size. Readers pass a 'capacity' of at least the size of
+  /// 'input'. Returns std::nullopt if the result does not fit, in which case
+  /// the caller falls back to decrypt().
+  virtual std::optional<size_t> decryptInto(
+      folly::StringPiece /* input */,
+      char* /* output */,
+      size_t /* capacity */) const {
+    DWIO_RAISE("decryptInto is not supported");
+  }
+
   virtual std::unique_ptr<Decrypter> clone() const = 0;
 };
 
@@ -52,6 +52,16 @@ class TestEncryption {
     return folly::IOBuf::copyBuffer(decoded);
   }
 
+  std::optional<size_t>
+  decryptInto(folly::StringPiece input, char* output, size_t capacity) const {
+    auto decrypted = decrypt(input);
+    if (decrypted->length() > capacity) {
+      return std::nullopt;
+    }
+    ::memcpy(output, decrypted->data(), decrypted->length());
+    return decrypted->length();
+  }
+
   size_t getCount() const {
     return count_;
   }
@@ -94,6 +104,17 @@ class TestDecrypter : public TestEncryption, public Decrypter {
     return TestEncryption::decrypt(input);
   }
 
+  bool supportsDecryptInto() const override {
+    return true;
+  }
+
+  std::optional<size_t> decryptInto(
+      folly::StringPiece input,
+      char* output,
+      size_t capacity) const override {
+    return TestEncryption::decryptInto(input, output, capacity);
+  }
+
   std::unique_ptr<Decrypter> clone() const override {
     auto decrypter = std::make_unique<TestDecrypter>();
     decrypter->setKey(getKey());
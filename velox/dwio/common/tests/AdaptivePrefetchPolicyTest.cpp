@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/common/memory/Memory.h"
+#include "velox/dwio/common/AdaptivePrefetchPolicy.h"
+
+using namespace facebook::velox;
+using facebook::velox::dwio::common::AdaptivePrefetchPolicy;
+using std::chrono::milliseconds;
+
+namespace {
+
+class AdaptivePrefetchPolicyTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+};
+
+TEST_F(AdaptivePrefetchPolicyTest, depth) {
+  AdaptivePrefetchPolicy policy(3, nullptr);
+  // One unit ahead until there are load and read times.
+  ASSERT_EQ(policy.depth(), 1);
+  policy.recordLoad(1 << 20, milliseconds(20));
+  ASSERT_EQ(policy.depth(), 1);
+
+  // Loads twice as long as reads.
+  policy.recordRead(milliseconds(10));
+  ASSERT_EQ(policy.depth(), 2);
+
+  // Much slower loads are limited by the maximum depth.
+  for (auto i = 0; i < 10; ++i) {
+    policy.recordLoad(1 << 20, milliseconds(100));
+  }
+  ASSERT_EQ(policy.depth(), 3);
+
+  // Slow reads need only one unit ahead.
+  for (auto i = 0; i < 10; ++i) {
+    policy.recordLoad(1 << 20, milliseconds(1));
+    policy.recordRead(milliseconds(100));
+  }
+  ASSERT_EQ(policy.depth(), 1);
+  ASSERT_EQ(policy.maxChosenDepth(), 3);
+
+  // Reads that take no time load as far ahead as allowed.
+  AdaptivePrefetchPolicy instantReads(5, nullptr);
+  instantReads.recordLoad(1 << 20, milliseconds(10));
+  instantReads.recordRead(milliseconds(0));
+  ASSERT_EQ(instantReads.depth(), 5);
+
+  AdaptivePrefetchPolicy noPrefetch(0, nullptr);
+  noPrefetch.recordLoad(1 << 20, milliseconds(10));
+  noPrefetch.recordRead(milliseconds(1));
+  ASSERT_EQ(noPrefetch.depth(), 0);
+  ASSERT_EQ(noPrefetch.maxChosenDepth(), 0);
+}
+
+TEST_F(AdaptivePrefetchPolicyTest, memory) {
+  constexpr int64_t kCapacity = 16 << 20;
+  auto rootPool = memory::memoryManager()->addRootPool("", kCapacity);
+  auto leafPool = rootPool->addLeafChild("leaf");
+
+  AdaptivePrefetchPolicy policy(10, leafPool.get());
+  policy.recordLoad(1 << 20, milliseconds(40));
+  policy.recordRead(milliseconds(10));
+  // Half of the capacity fits 8 units.
+  ASSERT_EQ(policy.depth(), 4);
+
+  constexpr int64_t kAllocationSize = 12 << 20;
+  auto* buffer = leafPool->allocate(kAllocationSize);
+  // Half of the remaining 4MB fits 2 units.
+  ASSERT_EQ(policy.depth(), 2);
+
+  AdaptivePrefetchPolicy largeUnits(10, leafPool.get());
+  largeUnits.recordLoad(8 << 20, milliseconds(40));
+  largeUnits.recordRead(milliseconds(10));
+  ASSERT_EQ(largeUnits.depth(), 0);
+  leafPool->free(buffer, kAllocationSize);
+  ASSERT_EQ(largeUnits.depth(), 1);
+}
+
+} // namespace
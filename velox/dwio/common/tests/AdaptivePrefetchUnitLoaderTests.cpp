@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/dwio/common/AdaptivePrefetchUnitLoader.h"
+#include "velox/dwio/common/Statistics.h"
+#include "velox/dwio/common/tests/utils/UnitLoaderTestTools.h"
+
+using facebook::velox::dwio::common::AdaptivePrefetchUnitLoaderFactory;
+using facebook::velox::dwio::common::test::ReaderMock;
+
+TEST(AdaptivePrefetchUnitLoaderTests, LoadsAhead) {
+  size_t blockedOnIoCount = 0;
+  // There is one unit ahead before the first read and at most 2 after.
+  AdaptivePrefetchUnitLoaderFactory factory(
+      4, nullptr, [&](auto) { ++blockedOnIoCount; });
+  ReaderMock readerMock{{10, 20, 30}, {0, 0, 0}, factory};
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, false}));
+
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 0, rows: 0-2, load(0), load(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+  EXPECT_EQ(blockedOnIoCount, 1);
+
+  EXPECT_TRUE(readerMock.read(7)); // Unit: 0, rows: 3-9
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+  EXPECT_EQ(blockedOnIoCount, 1);
+
+  EXPECT_TRUE(readerMock.read(20)); // Unit: 1, rows: 0-19, unload(0), load(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, true}));
+  EXPECT_EQ(blockedOnIoCount, 2);
+
+  EXPECT_TRUE(readerMock.read(30)); // Unit: 2, rows: 0-29, unload(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+  EXPECT_EQ(blockedOnIoCount, 3);
+
+  EXPECT_FALSE(readerMock.read(30)); // No more data
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+}
+
+TEST(AdaptivePrefetchUnitLoaderTests, SeekBackward) {
+  AdaptivePrefetchUnitLoaderFactory factory(1, nullptr, nullptr);
+  ReaderMock readerMock{{10, 20, 30, 40}, {0, 0, 0, 0}, factory};
+
+  readerMock.seek(35); // Unit 2
+  EXPECT_TRUE(readerMock.read(5)); // load(2), load(3)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(),
+      std::vector<bool>({false, false, true, true}));
+
+  readerMock.seek(0); // Unit 0
+  EXPECT_TRUE(readerMock.read(5)); // unload(2), unload(3), load(0), load(1)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(),
+      std::vector<bool>({true, true, false, false}));
+}
+
+TEST(AdaptivePrefetchUnitLoaderTests, NoPrefetch) {
+  AdaptivePrefetchUnitLoaderFactory factory(0, nullptr, nullptr);
+  ReaderMock readerMock{{10, 20, 30}, {0, 0, 0}, factory};
+
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 0, load(0)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, false, false}));
+
+  EXPECT_TRUE(readerMock.read(20)); // Unit: 1, unload(0), load(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, false}));
+}
+
+TEST(AdaptivePrefetchUnitLoaderTests, RuntimeStats) {
+  AdaptivePrefetchUnitLoaderFactory factory(4, nullptr, nullptr);
+  std::vector<std::unique_ptr<facebook::velox::dwio::common::LoadUnit>> units;
+  auto unitsLoaded =
+      facebook::velox::dwio::common::test::getUnitsLoadedWithFalse(2);
+  for (size_t i = 0; i < 2; ++i) {
+    units.push_back(
+        std::make_unique<facebook::velox::dwio::common::test::LoadUnitMock>(
+            10, 0, unitsLoaded, i));
+  }
+  auto loader = factory.create(std::move(units));
+
+  facebook::velox::dwio::common::RuntimeStatistics stats;
+  loader->updateRuntimeStats(stats);
+  EXPECT_EQ(stats.maxPrefetchDepth, 0);
+  EXPECT_EQ(stats.toMap().count("maxPrefetchDepth"), 0);
+
+  loader->getLoadedUnit(0);
+  loader->updateRuntimeStats(stats);
+  EXPECT_EQ(stats.maxPrefetchDepth, 1);
+  EXPECT_EQ(stats.toMap().at("maxPrefetchDepth").value, 1);
+}
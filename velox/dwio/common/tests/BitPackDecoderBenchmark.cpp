@@ -17,6 +17,9 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/dwio/common/BitPackDecoder.h"
+#ifdef VELOX_ENABLE_PARQUET
+#include "velox/dwio/parquet/reader/RleBpDecoder.h"
+#endif
 
 #ifdef __BMI2__
 #include "velox/dwio/common/tests/Lemire/bmipacking32.h"
@@ -285,6 +288,14 @@ void veloxBitUnpack(uint8_t bitWidth, T* result) {
       inputIter, BYTES(kNumValues, bitWidth), kNumValues, bitWidth, result);
 }
 
+// Unpacks with the AVX2 kernels also on CPUs with AVX-512 VBMI.
+template <typename T>
+void veloxBitUnpackAvx2(uint8_t bitWidth, T* result) {
+  facebook::velox::dwio::common::setAvx512UnpackEnabled(false);
+  veloxBitUnpack<T>(bitWidth, result);
+  facebook::velox::dwio::common::setAvx512UnpackEnabled(true);
+}
+
 template <typename T>
 void fastpforlib(uint8_t bitWidth, T* result) {
   uint64_t numBatches = kNumValues / 32;
@@ -329,6 +340,9 @@ void duckdbBitUnpack(uint8_t bitWidth, T* result) {
   BENCHMARK(velox_unpack_fullrows_##width##_8) {                 \
     veloxBitUnpack<uint8_t>(width, result8.data());              \
   }                                                              \
+  BENCHMARK_RELATIVE(velox_avx2_unpack_fullrows_##width##_8) {   \
+    veloxBitUnpackAvx2<uint8_t>(width, result8.data());          \
+  }                                                              \
   BENCHMARK_RELATIVE(legacy_unpack_naive_fullrows_##width##_8) { \
     legacyUnpackNaive<uint8_t>(allRows, width, result8.data());  \
   }                                                              \
@@ -350,6 +364,9 @@ void duckdbBitUnpack(uint8_t bitWidth, T* result) {
   BENCHMARK(velox_unpack_fullrows_##width##_16) {                 \
     veloxBitUnpack<uint16_t>(width, result16.data());             \
   }                                                               \
+  BENCHMARK_RELATIVE(velox_avx2_unpack_fullrows_##width##_16) {   \
+    veloxBitUnpackAvx2<uint16_t>(width, result16.data());         \
+  }                                                               \
   BENCHMARK_RELATIVE(legacy_unpack_naive_fullrows_##width##_16) { \
     legacyUnpackNaive<uint16_t>(allRows, width, result16.data()); \
   }                                                               \
@@ -371,6 +388,9 @@ void duckdbBitUnpack(uint8_t bitWidth, T* result) {
   BENCHMARK(velox_unpack_fullrows_##width##_32) {                 \
     veloxBitUnpack<uint32_t>(width, result32.data());             \
   }                                                               \
+  BENCHMARK_RELATIVE(velox_avx2_unpack_fullrows_##width##_32) {   \
+    veloxBitUnpackAvx2<uint32_t>(width, result32.data());         \
+  }                                                               \
   BENCHMARK_RELATIVE(legacy_unpack_naive_fullrows_##width##_32) { \
     legacyUnpackNaive<uint32_t>(allRows, width, result32.data()); \
   }                                                               \
@@ -500,6 +520,92 @@ BENCHMARK_UNPACK_ODDROWS_CASE_32(22)
 BENCHMARK_UNPACK_ODDROWS_CASE_32(24)
 BENCHMARK_UNPACK_ODDROWS_CASE_32(31)
 
+#ifdef VELOX_ENABLE_PARQUET
+
+// RLE/bit packed hybrid encodings of kNumRleValues values, at the index of
+// their bit width. A third of the values start a run of up to 100 repeats, as
+// in the levels of nested columns and the indices of skewed dictionaries.
+static const uint64_t kNumRleValues = 1024 * 1024;
+std::vector<std::vector<uint8_t>> rleEncodedData;
+std::vector<int16_t> levelsResult;
+std::vector<int32_t> indicesResult;
+
+void populateRleEncoded() {
+  rleEncodedData.resize(33);
+  for (auto bitWidth = 1; bitWidth <= 32; ++bitWidth) {
+    auto& encoded = rleEncodedData[bitWidth];
+    encoded.resize(
+        arrow::util::RleEncoder::MaxBufferSize(bitWidth, kNumRleValues));
+    arrow::util::RleEncoder encoder(encoded.data(), encoded.size(), bitWidth);
+    for (uint64_t i = 0; i < kNumRleValues;) {
+      const uint64_t value = randomInts_u32[i] & bits::lowMask(bitWidth);
+      const auto count = std::min<uint64_t>(
+          randomInts_u32[i] % 3 == 0 ? 1 + randomInts_u32[i] / 3 % 100 : 1,
+          kNumRleValues - i);
+      for (uint64_t j = 0; j < count; ++j) {
+        encoder.Put(value);
+      }
+      i += count;
+    }
+    encoded.resize(encoder.Flush());
+  }
+  levelsResult.resize(kNumRleValues);
+  indicesResult.resize(kNumRleValues);
+}
+
+template <typename T>
+void veloxRleBpDecode(uint8_t bitWidth, T* result) {
+  const auto& encoded = rleEncodedData[bitWidth];
+  facebook::velox::parquet::RleBpDecoder decoder(
+      reinterpret_cast<const char*>(encoded.data()),
+      reinterpret_cast<const char*>(encoded.data() + encoded.size()),
+      bitWidth);
+  decoder.next(result, kNumRleValues);
+}
+
+template <typename T>
+void veloxRleBpDecodeAvx2(uint8_t bitWidth, T* result) {
+  facebook::velox::dwio::common::setAvx512UnpackEnabled(false);
+  veloxRleBpDecode<T>(bitWidth, result);
+  facebook::velox::dwio::common::setAvx512UnpackEnabled(true);
+}
+
+template <typename T>
+void arrowRleDecode(uint8_t bitWidth, T* result) {
+  const auto& encoded = rleEncodedData[bitWidth];
+  arrow::util::RleDecoder decoder(encoded.data(), encoded.size(), bitWidth);
+  decoder.GetBatch(result, kNumRleValues);
+}
+
+#define BENCHMARK_RLE_DECODE_CASE(name, width, result)    \
+  BENCHMARK(velox_rlebp_##name##_##width) {               \
+    veloxRleBpDecode(width, result.data());               \
+  }                                                       \
+  BENCHMARK_RELATIVE(velox_avx2_rlebp_##name##_##width) { \
+    veloxRleBpDecodeAvx2(width, result.data());           \
+  }                                                       \
+  BENCHMARK_RELATIVE(arrow_rle_##name##_##width) {        \
+    arrowRleDecode(width, result.data());                 \
+  }                                                       \
+  BENCHMARK_DRAW_LINE();
+
+BENCHMARK_RLE_DECODE_CASE(levels, 1, levelsResult)
+BENCHMARK_RLE_DECODE_CASE(levels, 2, levelsResult)
+BENCHMARK_RLE_DECODE_CASE(levels, 3, levelsResult)
+BENCHMARK_RLE_DECODE_CASE(levels, 4, levelsResult)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_RLE_DECODE_CASE(indices, 4, indicesResult)
+BENCHMARK_RLE_DECODE_CASE(indices, 8, indicesResult)
+BENCHMARK_RLE_DECODE_CASE(indices, 12, indicesResult)
+BENCHMARK_RLE_DECODE_CASE(indices, 16, indicesResult)
+BENCHMARK_RLE_DECODE_CASE(indices, 20, indicesResult)
+BENCHMARK_RLE_DECODE_CASE(indices, 24, indicesResult)
+BENCHMARK_RLE_DECODE_CASE(indices, 32, indicesResult)
+
+#endif
+
 void populateBitPacked() {
   bitPackedData.resize(33);
   for (auto bitWidth = 1; bitWidth <= 32; ++bitWidth) {
@@ -605,6 +711,9 @@ int32_t main(int32_t argc, char* argv[]) {
   randomInts_u32_result.resize(randomInts_u32.size());
 
   populateBitPacked();
+#ifdef VELOX_ENABLE_PARQUET
+  populateRleEncoded();
+#endif
 
   result8.resize(randomInts_u32.size());
   result16.resize(randomInts_u32.size());
@@ -84,6 +84,10 @@ void E2EFilterTestBase::makeStringUnique(const std::string& fieldName) {
   dataSetBuilder_->withUniqueStringsForField(Subfield(fieldName));
 }
 
+void E2EFilterTestBase::makePreEpochTimestamps(const std::string& fieldName) {
+  dataSetBuilder_->withPreEpochTimestampsForField(Subfield(fieldName));
+}
+
 void E2EFilterTestBase::makeNotNull(int32_t firstRow) {
   dataSetBuilder_->withNoNullsAfter(firstRow);
 }
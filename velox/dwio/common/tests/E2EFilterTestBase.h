@@ -152,6 +152,9 @@ class E2EFilterTestBase : public testing::Test {
   // Makes non-null strings unique by appending a row number.
   void makeStringUnique(const std::string& fieldName);
 
+  // Makes non-null timestamps span both sides of the Unix epoch.
+  void makePreEpochTimestamps(const std::string& fieldName);
+
   // Makes all data in 'batches_' non-null. This finds a sampling of
   // non-null values from each column and replaces nulls in the column
   // in question with one of these. A column where only nulls are
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+
+namespace {
+
+struct TestEntry : public FileMetadataCache::Entry {
+  explicit TestEntry(int32_t _value) : value(_value) {}
+
+  const int32_t value;
+};
+
+struct OtherEntry : public FileMetadataCache::Entry {};
+
+class FileMetadataCacheTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+};
+
+TEST_F(FileMetadataCacheTest, getAndPut) {
+  FileMetadataCache cache(1'000);
+  ASSERT_EQ(cache.get("file", 100), nullptr);
+  cache.put("file", 100, std::make_shared<TestEntry>(1), 10);
+  auto entry = cache.get<TestEntry>("file", 100);
+  ASSERT_NE(entry, nullptr);
+  ASSERT_EQ(entry->value, 1);
+  // A different length is a different version of the file.
+  ASSERT_EQ(cache.get("file", 200), nullptr);
+  // An entry of another type is not returned.
+  ASSERT_EQ(cache.get<OtherEntry>("file", 100), nullptr);
+
+  // Replacing an entry keeps the old one valid for its users.
+  cache.put("file", 100, std::make_shared<TestEntry>(2), 20);
+  ASSERT_EQ(entry->value, 1);
+  ASSERT_EQ(cache.get<TestEntry>("file", 100)->value, 2);
+
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.numEntries, 1);
+  ASSERT_EQ(stats.bytes, 20);
+  ASSERT_EQ(stats.numLookups, 5);
+  ASSERT_EQ(stats.numHits, 3);
+  ASSERT_EQ(stats.numEvictions, 0);
+
+  cache.clear();
+  ASSERT_EQ(cache.get("file", 100), nullptr);
+  ASSERT_EQ(cache.stats().bytes, 0);
+}
+
+TEST_F(FileMetadataCacheTest, evict) {
+  FileMetadataCache cache(1'000);
+  for (auto i = 0; i < 4; ++i) {
+    cache.put(fmt::format("file{}", i), 1, std::make_shared<TestEntry>(i), 250);
+  }
+  // Makes 'file0' the most recently used.
+  ASSERT_NE(cache.get("file0", 1), nullptr);
+  cache.put("file4", 1, std::make_shared<TestEntry>(4), 250);
+  ASSERT_NE(cache.get("file0", 1), nullptr);
+  ASSERT_EQ(cache.get("file1", 1), nullptr);
+  ASSERT_NE(cache.get("file4", 1), nullptr);
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.numEntries, 4);
+  ASSERT_EQ(stats.bytes, 1'000);
+  ASSERT_EQ(stats.numEvictions, 1);
+
+  // Entries over a quarter of the capacity are not cached.
+  cache.put("large", 1, std::make_shared<TestEntry>(5), 251);
+  ASSERT_EQ(cache.get("large", 1), nullptr);
+  ASSERT_EQ(cache.stats().numEvictions, 1);
+}
+
+TEST_F(FileMetadataCacheTest, instance) {
+  ASSERT_EQ(FileMetadataCache::getInstance(), nullptr);
+  FileMetadataCache cache(1'000);
+  FileMetadataCache::setInstance(&cache);
+  ASSERT_EQ(FileMetadataCache::getInstance(), &cache);
+  FileMetadataCache::setInstance(nullptr);
+  ASSERT_EQ(FileMetadataCache::getInstance(), nullptr);
+  ASSERT_NE(cache.pool(), nullptr);
+}
+
+} // namespace
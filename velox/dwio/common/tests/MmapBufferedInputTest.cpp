@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/MmapBufferedInput.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/File.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/exec/tests/utils/TempFilePath.h"
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+using facebook::velox::common::Region;
+
+namespace {
+
+class MmapBufferedInputTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void SetUp() override {
+    tempFile_ = exec::test::TempFilePath::create();
+    content_.resize(100'000);
+    for (auto i = 0; i < content_.size(); ++i) {
+      content_[i] = 'a' + i % 26;
+    }
+    LocalWriteFile writeFile(tempFile_->getPath());
+    writeFile.append(content_);
+  }
+
+  // Returns the bytes of 'stream'.
+  static std::string readAll(SeekableInputStream& stream) {
+    std::string result;
+    const void* buffer;
+    int32_t size;
+    while (stream.Next(&buffer, &size)) {
+      result.append(reinterpret_cast<const char*>(buffer), size);
+    }
+    return result;
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool()};
+  std::shared_ptr<exec::test::TempFilePath> tempFile_;
+  std::string content_;
+};
+
+TEST_F(MmapBufferedInputTest, canMap) {
+  ASSERT_TRUE(MmapBufferedInput::canMap(LocalReadFile(tempFile_->getPath())));
+  LocalFileOptions directIo;
+  directIo.directIo = true;
+  ASSERT_FALSE(MmapBufferedInput::canMap(
+      LocalReadFile(tempFile_->getPath(), directIo)));
+  ASSERT_FALSE(MmapBufferedInput::canMap(InMemoryReadFile(content_)));
+}
+
+TEST_F(MmapBufferedInputTest, enqueueAndLoad) {
+  auto ioStats = std::make_shared<io::IoStatistics>();
+  MmapBufferedInput input(
+      std::make_shared<LocalReadFile>(tempFile_->getPath()), *pool_, ioStats);
+  ASSERT_EQ(input.mappedBytes(), content_.size());
+
+  auto first = input.enqueue(Region{10, 1'000});
+  auto second = input.enqueue(Region{50'000, 49'999});
+  auto empty = input.enqueue(Region{200, 0});
+  ASSERT_EQ(input.nextFetchSize(), 50'999);
+  input.load(LogType::TEST);
+  ASSERT_EQ(input.nextFetchSize(), 0);
+
+  ASSERT_EQ(readAll(*first), content_.substr(10, 1'000));
+  ASSERT_EQ(readAll(*second), content_.substr(50'000, 49'999));
+  ASSERT_EQ(readAll(*empty), "");
+  ASSERT_EQ(ioStats->rawBytesRead(), 50'999);
+
+  // Streams over the same bytes point into the same mapped pages.
+  const void* firstBuffer;
+  const void* secondBuffer;
+  int32_t size;
+  ASSERT_TRUE(input.read(100, 10, LogType::TEST)->Next(&firstBuffer, &size));
+  ASSERT_TRUE(input.read(100, 10, LogType::TEST)->Next(&secondBuffer, &size));
+  ASSERT_EQ(firstBuffer, secondBuffer);
+
+  ASSERT_TRUE(input.isBuffered(0, content_.size()));
+  ASSERT_FALSE(input.isBuffered(1, content_.size()));
+  VELOX_ASSERT_THROW(
+      input.read(content_.size() - 1, 2, LogType::TEST), "Read past the end");
+}
+
+TEST_F(MmapBufferedInputTest, clone) {
+  std::unique_ptr<BufferedInput> clone;
+  {
+    MmapBufferedInput input(
+        std::make_shared<LocalReadFile>(tempFile_->getPath()), *pool_);
+    clone = input.clone();
+  }
+  // The clone keeps the mapping.
+  auto stream = clone->enqueue(Region{0, 100});
+  clone->load(LogType::TEST);
+  ASSERT_EQ(readAll(*stream), content_.substr(0, 100));
+}
+
+} // namespace
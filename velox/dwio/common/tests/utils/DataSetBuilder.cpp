@@ -205,6 +205,47 @@ DataSetBuilder& DataSetBuilder::withUniqueStringsForField(
   return *this;
 }
 
+DataSetBuilder& DataSetBuilder::withPreEpochTimestampsForField(
+    const Subfield& field) {
+  // About 400 years on either side of the epoch.
+  constexpr int64_t kSecondsRange = 400LL * 365 * 24 * 60 * 60;
+  static const std::vector<uint64_t> kNanos = {
+      0,
+      1,
+      10,
+      100,
+      1'000,
+      10'000,
+      100'000,
+      1'000'000,
+      10'000'000,
+      100'000'000,
+      123'456'700,
+      999'999'999};
+  int32_t counter = 0;
+  for (RowVectorPtr batch : *batches_) {
+    auto timestamps =
+        getChildBySubfield(batch.get(), field)->as<FlatVector<Timestamp>>();
+    for (auto row = 0; row < timestamps->size(); ++row) {
+      if (timestamps->isNullAt(row)) {
+        continue;
+      }
+      const int64_t offset = folly::Random::rand64(rng_) % (2 * kSecondsRange);
+      int64_t seconds = offset - kSecondsRange;
+      const auto nanos = kNanos[counter++ % kNanos.size()];
+      // The DWRF writer imitates the Java ORC writer and moves the second
+      // before the epoch to the epoch when nanos are not 0, so this value
+      // does not round trip.
+      if (seconds == -1 && nanos != 0) {
+        seconds = -2;
+      }
+      timestamps->set(row, Timestamp(seconds, nanos));
+    }
+  }
+
+  return *this;
+}
+
 DataSetBuilder& DataSetBuilder::makeUniformMapKeys(
     const common::Subfield& field) {
   for (auto& batch : *batches_) {
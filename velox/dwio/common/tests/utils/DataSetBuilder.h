@@ -75,6 +75,12 @@ class DataSetBuilder {
   DataSetBuilder& withUniqueStringsForField(
       const facebook::velox::common::Subfield& field);
 
+  // Replaces the non-null values of the timestamp Subfield 'field' with
+  // values on both sides of the Unix epoch. The nanos cycle through values
+  // with 0 to 8 trailing zeros so that every encoded nanos scale occurs.
+  DataSetBuilder& withPreEpochTimestampsForField(
+      const common::Subfield& field);
+
   template <typename T>
   DataSetBuilder& withIntDistributionForField(
       const common::Subfield& field,
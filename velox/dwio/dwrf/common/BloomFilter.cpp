@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+
+#include <cstring>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::dwrf {
+
+namespace {
+// Constants of the Murmur3 hash used by the ORC and DWRF writers.
+constexpr uint64_t kC1 = 0x87c37b91114253d5ULL;
+constexpr uint64_t kC2 = 0x4cf5ad432745937fULL;
+constexpr int32_t kR1 = 31;
+constexpr int32_t kR2 = 27;
+constexpr uint64_t kM = 5;
+constexpr uint64_t kN1 = 0x52dce729;
+constexpr uint64_t kSeed = 104729;
+
+inline uint64_t rotateLeft(uint64_t value, int32_t shift) {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+inline uint64_t fmix64(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+inline uint64_t mixK(uint64_t k) {
+  k *= kC1;
+  k = rotateLeft(k, kR1);
+  k *= kC2;
+  return k;
+}
+
+// Arithmetic right shift as done by Java's '>>' on a long.
+inline uint64_t shiftRight(uint64_t value, int32_t shift) {
+  return static_cast<uint64_t>(static_cast<int64_t>(value) >> shift);
+}
+
+// Returns the index of the bit of the 'i'th hash function for 'hash'. Wraps
+// around like the 32 bit arithmetic of the writers.
+inline uint64_t bitIndex(uint64_t hash, int32_t i, uint64_t numBits) {
+  const auto hash1 = static_cast<uint32_t>(hash);
+  const auto hash2 = static_cast<uint32_t>(hash >> 32);
+  auto combined =
+      static_cast<int32_t>(hash1 + static_cast<uint32_t>(i) * hash2);
+  if (combined < 0) {
+    combined = ~combined;
+  }
+  return combined % numBits;
+}
+} // namespace
+
+BloomFilter::BloomFilter(const proto::BloomFilter& proto)
+    : numHashFunctions_(proto.numhashfunctions()) {
+  if (proto.bitset_size() > 0) {
+    bits_.assign(proto.bitset().begin(), proto.bitset().end());
+  } else if (proto.has_utf8bitset()) {
+    const auto& bytes = proto.utf8bitset();
+    VELOX_CHECK_EQ(
+        bytes.size() % sizeof(uint64_t),
+        0,
+        "Bloom filter size is not a multiple of 8 bytes");
+    bits_.resize(bytes.size() / sizeof(uint64_t));
+    ::memcpy(bits_.data(), bytes.data(), bytes.size());
+  }
+}
+
+BloomFilter::BloomFilter(uint64_t numBits, int32_t numHashFunctions)
+    : numHashFunctions_(numHashFunctions), bits_(bits::nwords(numBits)) {
+  VELOX_CHECK_GT(numBits, 0);
+  VELOX_CHECK_GT(numHashFunctions, 0);
+}
+
+// static
+uint64_t BloomFilter::hashLong(int64_t value) {
+  auto key = static_cast<uint64_t>(value);
+  key = ~key + (key << 21);
+  key ^= shiftRight(key, 24);
+  key = key + (key << 3) + (key << 8);
+  key ^= shiftRight(key, 14);
+  key = key + (key << 2) + (key << 4);
+  key ^= shiftRight(key, 28);
+  key += key << 31;
+  return key;
+}
+
+// static
+uint64_t BloomFilter::hashBytes(std::string_view value) {
+  const auto* data = reinterpret_cast<const uint8_t*>(value.data());
+  const auto length = value.size();
+  uint64_t hash = kSeed;
+  const auto numBlocks = length / 8;
+  for (size_t i = 0; i < numBlocks; ++i) {
+    uint64_t k;
+    ::memcpy(&k, data + i * 8, sizeof(k));
+    hash ^= mixK(k);
+    hash = rotateLeft(hash, kR2) * kM + kN1;
+  }
+  const auto* tail = data + numBlocks * 8;
+  uint64_t k = 0;
+  switch (length & 7) {
+    case 7:
+      k ^= static_cast<uint64_t>(tail[6]) << 48;
+      [[fallthrough]];
+    case 6:
+      k ^= static_cast<uint64_t>(tail[5]) << 40;
+      [[fallthrough]];
+    case 5:
+      k ^= static_cast<uint64_t>(tail[4]) << 32;
+      [[fallthrough]];
+    case 4:
+      k ^= static_cast<uint64_t>(tail[3]) << 24;
+      [[fallthrough]];
+    case 3:
+      k ^= static_cast<uint64_t>(tail[2]) << 16;
+      [[fallthrough]];
+    case 2:
+      k ^= static_cast<uint64_t>(tail[1]) << 8;
+      [[fallthrough]];
+    case 1:
+      k ^= static_cast<uint64_t>(tail[0]);
+      hash ^= mixK(k);
+  }
+  hash ^= length;
+  return fmix64(hash);
+}
+
+void BloomFilter::addHash(uint64_t hash) {
+  VELOX_CHECK(!bits_.empty());
+  const uint64_t numBits = bits_.size() * 64;
+  for (int32_t i = 1; i <= numHashFunctions_; ++i) {
+    bits::setBit(bits_.data(), bitIndex(hash, i, numBits));
+  }
+}
+
+bool BloomFilter::testHash(uint64_t hash) const {
+  if (bits_.empty()) {
+    return true;
+  }
+  const uint64_t numBits = bits_.size() * 64;
+  for (int32_t i = 1; i <= numHashFunctions_; ++i) {
+    if (!bits::isBitSet(bits_.data(), bitIndex(hash, i, numBits))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace facebook::velox::dwrf
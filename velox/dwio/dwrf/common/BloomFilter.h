@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
+
+namespace facebook::velox::dwrf {
+
+/// Bloom filter of the values of a column in a row group as written by ORC
+/// and DWRF writers. Integers are hashed with the 64 bit integer hash of
+/// Thomas Wang and strings with the 64 bit Murmur3 hash of their UTF-8
+/// bytes. Nulls are not added.
+class BloomFilter {
+ public:
+  /// Reads the filter from 'proto'. The bits are in 'bitset' or, for filters
+  /// of the BLOOM_FILTER_UTF8 stream, in 'utf8bitset' as little endian
+  /// 64 bit words.
+  explicit BloomFilter(const proto::BloomFilter& proto);
+
+  /// Makes an empty filter of 'numBits' bits, rounded up to a multiple of 64.
+  BloomFilter(uint64_t numBits, int32_t numHashFunctions);
+
+  static uint64_t hashLong(int64_t value);
+
+  static uint64_t hashBytes(std::string_view value);
+
+  void addHash(uint64_t hash);
+
+  /// Returns false if no value with 'hash' was added.
+  bool testHash(uint64_t hash) const;
+
+  void addLong(int64_t value) {
+    addHash(hashLong(value));
+  }
+
+  void addBytes(std::string_view value) {
+    addHash(hashBytes(value));
+  }
+
+  bool testLong(int64_t value) const {
+    return testHash(hashLong(value));
+  }
+
+  bool testBytes(std::string_view value) const {
+    return testHash(hashBytes(value));
+  }
+
+  /// Returns true if the filter has no bits, e.g. if the writer did not
+  /// fill it in. Such a filter matches all values.
+  bool empty() const {
+    return bits_.empty();
+  }
+
+  int32_t numHashFunctions() const {
+    return numHashFunctions_;
+  }
+
+  const std::vector<uint64_t>& bits() const {
+    return bits_;
+  }
+
+ private:
+  int32_t numHashFunctions_;
+  std::vector<uint64_t> bits_;
+};
+
+} // namespace facebook::velox::dwrf
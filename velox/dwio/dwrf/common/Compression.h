@@ -105,6 +105,7 @@ inline CompressionOptions getDwrfOrcDecompressionOptions(
  * @param input The input stream that is the underlying source
  * @param bufferSize The maximum size of the buffer
  * @param pool The memory pool
+ * @param ioStats Records the bytes offloaded to a HardwareDecompressor
  */
 inline std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     facebook::velox::common::CompressionKind kind,
@@ -112,7 +113,8 @@ inline std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     uint64_t bufferSize,
     memory::MemoryPool& pool,
     const std::string& streamDebugInfo,
-    const dwio::common::encryption::Decrypter* decryptr = nullptr) {
+    const dwio::common::encryption::Decrypter* decryptr = nullptr,
+    dwio::common::IoStatistics* ioStats = nullptr) {
   const CompressionOptions& options = getDwrfOrcDecompressionOptions(kind);
   return createDecompressor(
       kind,
@@ -121,7 +123,10 @@ inline std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
       pool,
       options,
       streamDebugInfo,
-      decryptr);
+      decryptr,
+      false,
+      0,
+      ioStats);
 }
 
 } // namespace facebook::velox::dwrf
@@ -15,9 +15,12 @@
  */
 
 #include "velox/dwio/dwrf/common/RLEv2.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/dwrf/common/Common.h"
 
+#include <cstring>
+
 namespace facebook::velox::dwrf {
 
 using memory::MemoryPool;
@@ -107,6 +110,117 @@ inline uint32_t getClosestFixedBits(uint32_t n) {
   }
 }
 
+namespace {
+inline uint64_t loadBigEndian(const char* bytes) {
+  uint64_t word;
+  ::memcpy(&word, bytes, sizeof(word));
+  return __builtin_bswap64(word);
+}
+
+// Unpacks 'numGroups' groups of 8 values of kWidth bits packed most
+// significant bit first. A group takes kWidth bytes. The shifts and offsets
+// are constants, so that the compiler unrolls the loop over a group into
+// straight line code and vectorizes it where the target allows. Loads 8
+// bytes at a time and may read up to 8 bytes past the last group.
+template <int32_t kWidth>
+void unpackGroups(const char* input, uint64_t numGroups, int64_t* result) {
+  for (uint64_t group = 0; group < numGroups; ++group) {
+    for (int32_t i = 0; i < 8; ++i) {
+      if constexpr (kWidth == 64) {
+        result[i] = loadBigEndian(input + i * 8);
+      } else {
+        const int32_t bit = i * kWidth;
+        result[i] =
+            (loadBigEndian(input + bit / 8) << (bit % 8)) >> (64 - kWidth);
+      }
+    }
+    input += kWidth;
+    result += 8;
+  }
+}
+
+// Dispatches to the kernel for 'width'. Returns false if there is none.
+bool unpackGroups(
+    uint64_t width,
+    const char* input,
+    uint64_t numGroups,
+    int64_t* result) {
+  switch (width) {
+#define VELOX_RLEV2_UNPACK(w)                  \
+  case w:                                      \
+    unpackGroups<w>(input, numGroups, result); \
+    return true;
+    VELOX_RLEV2_UNPACK(1)
+    VELOX_RLEV2_UNPACK(2)
+    VELOX_RLEV2_UNPACK(3)
+    VELOX_RLEV2_UNPACK(4)
+    VELOX_RLEV2_UNPACK(5)
+    VELOX_RLEV2_UNPACK(6)
+    VELOX_RLEV2_UNPACK(7)
+    VELOX_RLEV2_UNPACK(8)
+    VELOX_RLEV2_UNPACK(9)
+    VELOX_RLEV2_UNPACK(10)
+    VELOX_RLEV2_UNPACK(11)
+    VELOX_RLEV2_UNPACK(12)
+    VELOX_RLEV2_UNPACK(13)
+    VELOX_RLEV2_UNPACK(14)
+    VELOX_RLEV2_UNPACK(15)
+    VELOX_RLEV2_UNPACK(16)
+    VELOX_RLEV2_UNPACK(17)
+    VELOX_RLEV2_UNPACK(18)
+    VELOX_RLEV2_UNPACK(19)
+    VELOX_RLEV2_UNPACK(20)
+    VELOX_RLEV2_UNPACK(21)
+    VELOX_RLEV2_UNPACK(22)
+    VELOX_RLEV2_UNPACK(23)
+    VELOX_RLEV2_UNPACK(24)
+    VELOX_RLEV2_UNPACK(26)
+    VELOX_RLEV2_UNPACK(28)
+    VELOX_RLEV2_UNPACK(30)
+    VELOX_RLEV2_UNPACK(32)
+    VELOX_RLEV2_UNPACK(40)
+    VELOX_RLEV2_UNPACK(48)
+    VELOX_RLEV2_UNPACK(56)
+    VELOX_RLEV2_UNPACK(64)
+#undef VELOX_RLEV2_UNPACK
+    default:
+      return false;
+  }
+}
+
+// Returns 'batch' with each lane replaced by the sum of itself and the lanes
+// below it. Adds the batch shifted up by 1, 2, 4... lanes.
+template <int32_t kShift = 1>
+xsimd::batch<int64_t> inclusiveScan(xsimd::batch<int64_t> batch) {
+  if constexpr (kShift >= xsimd::batch<int64_t>::size) {
+    return batch;
+  } else {
+    return inclusiveScan<kShift * 2>(
+        batch + xsimd::slide_left<kShift * sizeof(int64_t)>(batch));
+  }
+}
+
+// Replaces 'deltas' with 'value' plus the running sum of 'deltas' or, if
+// 'kNegate', minus it. Returns the last value.
+template <bool kNegate>
+int64_t addDeltas(int64_t* deltas, uint64_t numValues, int64_t value) {
+  using Batch = xsimd::batch<int64_t>;
+  uint64_t i = 0;
+  for (; i + Batch::size <= numValues; i += Batch::size) {
+    auto batch = Batch::load_unaligned(deltas + i);
+    if constexpr (kNegate) {
+      batch = -batch;
+    }
+    (inclusiveScan(batch) + value).store_unaligned(deltas + i);
+    value = deltas[i + Batch::size - 1];
+  }
+  for (; i < numValues; ++i) {
+    value = deltas[i] = kNegate ? value - deltas[i] : value + deltas[i];
+  }
+  return value;
+}
+} // namespace
+
 template <bool isSigned>
 int64_t RleDecoderV2<isSigned>::readLongBE(uint64_t bsz) {
   int64_t ret = 0, val;
@@ -119,6 +233,70 @@ int64_t RleDecoderV2<isSigned>::readLongBE(uint64_t bsz) {
   return ret;
 }
 
+template <bool isSigned>
+uint64_t RleDecoderV2<isSigned>::readLongs(
+    int64_t* data,
+    uint64_t offset,
+    uint64_t len,
+    uint64_t fb,
+    const uint64_t* nulls) {
+  if (!nulls) {
+    readDenseLongs(data + offset, len, fb);
+    return len;
+  }
+  const uint64_t numNonNulls = bits::countBits(nulls, offset, offset + len);
+  readDenseLongs(data + offset, numNonNulls, fb);
+  // Moves the values to their non-null positions, last first so that no
+  // value is overwritten before it is moved.
+  uint64_t source = offset + numNonNulls;
+  for (uint64_t pos = offset + len; source > offset;) {
+    --pos;
+    if (!bits::isBitNull(nulls, pos)) {
+      data[pos] = data[--source];
+    }
+  }
+  return numNonNulls;
+}
+
+template <bool isSigned>
+void RleDecoderV2<isSigned>::readDenseLongs(
+    int64_t* data,
+    uint64_t numValues,
+    uint64_t fb) {
+  uint64_t numRead = 0;
+  if (bitsLeft == 0) {
+    const uint64_t available = this->bufferEnd - this->bufferStart;
+    // Leaves 8 bytes of slack for the 8 byte loads of the last group.
+    if (available > 8) {
+      const auto numGroups = std::min(numValues / 8, (available - 8) / fb);
+      if (numGroups > 0 &&
+          unpackGroups(fb, this->bufferStart, numGroups, data)) {
+        this->bufferStart += numGroups * fb;
+        numRead = numGroups * 8;
+      }
+    }
+  }
+  for (; numRead < numValues; ++numRead) {
+    uint64_t result = 0;
+    uint64_t bitsLeftToRead = fb;
+    while (bitsLeftToRead > bitsLeft) {
+      result <<= bitsLeft;
+      result |= curByte & ((1 << bitsLeft) - 1);
+      bitsLeftToRead -= bitsLeft;
+      curByte = readByte();
+      bitsLeft = 8;
+    }
+
+    // handle the left over bits
+    if (bitsLeftToRead > 0) {
+      result <<= bitsLeftToRead;
+      bitsLeft -= static_cast<uint32_t>(bitsLeftToRead);
+      result |= (curByte >> bitsLeft) & ((1 << bitsLeftToRead) - 1);
+    }
+    data[numRead] = static_cast<int64_t>(result);
+  }
+}
+
 template <bool isSigned>
 RleDecoderV2<isSigned>::RleDecoderV2(
     std::unique_ptr<dwio::common::SeekableInputStream> input,
@@ -559,7 +737,11 @@ uint64_t RleDecoderV2<isSigned>::nextDelta(
     uint64_t remaining = (offset + nRead) - pos;
     runRead += readLongs(data, pos, remaining, bitSize, nulls);
 
-    if (deltaBase < 0) {
+    if (!nulls) {
+      prevValue = deltaBase < 0
+          ? addDeltas<true>(data + pos, remaining, prevValue)
+          : addDeltas<false>(data + pos, remaining, prevValue);
+    } else if (deltaBase < 0) {
       for (; pos < offset + nRead; ++pos) {
         // skip null positions
         if (nulls && bits::isBitNull(nulls, pos)) {
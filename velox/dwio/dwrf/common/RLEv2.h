@@ -152,42 +152,20 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   }
 
   int64_t readLongBE(uint64_t bsz);
+
+  // Reads 'len' values of 'fb' bits into 'data' starting at 'offset',
+  // skipping null positions. Returns the number of values read.
   uint64_t readLongs(
       int64_t* data,
       uint64_t offset,
       uint64_t len,
       uint64_t fb,
-      const uint64_t* nulls = nullptr) {
-    uint64_t ret = 0;
-
-    // TODO: unroll to improve performance
-    for (uint64_t i = offset; i < (offset + len); i++) {
-      // skip null positions
-      if (nulls && bits::isBitNull(nulls, i)) {
-        continue;
-      }
-      uint64_t result = 0;
-      uint64_t bitsLeftToRead = fb;
-      while (bitsLeftToRead > bitsLeft) {
-        result <<= bitsLeft;
-        result |= curByte & ((1 << bitsLeft) - 1);
-        bitsLeftToRead -= bitsLeft;
-        curByte = readByte();
-        bitsLeft = 8;
-      }
+      const uint64_t* nulls = nullptr);
 
-      // handle the left over bits
-      if (bitsLeftToRead > 0) {
-        result <<= bitsLeftToRead;
-        bitsLeft -= static_cast<uint32_t>(bitsLeftToRead);
-        result |= (curByte >> bitsLeft) & ((1 << bitsLeftToRead) - 1);
-      }
-      data[i] = static_cast<int64_t>(result);
-      ++ret;
-    }
-
-    return ret;
-  }
+  // Reads 'numValues' consecutive values of 'fb' bits into 'data'. Unpacks
+  // whole groups of 8 values with a kernel specialized for 'fb' when they
+  // start at a byte boundary and are in the current buffer.
+  void readDenseLongs(int64_t* data, uint64_t numValues, uint64_t fb);
 
   uint64_t nextShortRepeats(
       int64_t* data,
@@ -20,11 +20,109 @@
 
 namespace facebook::velox::dwrf {
 
+namespace {
+// IN lists longer than this are not tested against bloom filters since the
+// test would cost more than reading the row groups it may skip.
+constexpr size_t kMaxBloomFilterValues = 10'000;
+
+// Returns the bloom filter hashes of the values that pass 'filter' or
+// std::nullopt if 'filter' passes values that are not in bloom filters,
+// e.g. nulls or ranges, or if 'type' is not hashed like the filter values.
+std::optional<std::vector<uint64_t>> bloomFilterHashes(
+    const common::Filter* filter,
+    const Type& type) {
+  if (filter == nullptr || filter->testNull() || type.isDecimal()) {
+    return std::nullopt;
+  }
+  std::vector<uint64_t> hashes;
+  const auto addLongs = [&](const std::vector<int64_t>& values) {
+    if (values.size() > kMaxBloomFilterValues) {
+      return false;
+    }
+    for (auto value : values) {
+      hashes.push_back(BloomFilter::hashLong(value));
+    }
+    return true;
+  };
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      switch (filter->kind()) {
+        case common::FilterKind::kBigintRange: {
+          auto* range = static_cast<const common::BigintRange*>(filter);
+          if (!range->isSingleValue()) {
+            return std::nullopt;
+          }
+          hashes.push_back(BloomFilter::hashLong(range->lower()));
+          return hashes;
+        }
+        case common::FilterKind::kBigintValuesUsingHashTable:
+          if (!addLongs(
+                  static_cast<const common::BigintValuesUsingHashTable*>(
+                      filter)
+                      ->values())) {
+            return std::nullopt;
+          }
+          return hashes;
+        case common::FilterKind::kBigintValuesUsingBitmask:
+          if (!addLongs(
+                  static_cast<const common::BigintValuesUsingBitmask*>(filter)
+                      ->values())) {
+            return std::nullopt;
+          }
+          return hashes;
+        default:
+          return std::nullopt;
+      }
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      switch (filter->kind()) {
+        case common::FilterKind::kBytesRange: {
+          auto* range = static_cast<const common::BytesRange*>(filter);
+          if (!range->isSingleValue()) {
+            return std::nullopt;
+          }
+          hashes.push_back(BloomFilter::hashBytes(range->lower()));
+          return hashes;
+        }
+        case common::FilterKind::kBytesValues: {
+          const auto& values =
+              static_cast<const common::BytesValues*>(filter)->values();
+          if (values.size() > kMaxBloomFilterValues) {
+            return std::nullopt;
+          }
+          for (const auto& value : values) {
+            hashes.push_back(BloomFilter::hashBytes(value));
+          }
+          return hashes;
+        }
+        default:
+          return std::nullopt;
+      }
+    default:
+      return std::nullopt;
+  }
+}
+
+// Kind of the bloom filter stream. ORC numbers its stream kinds differently
+// from DWRF.
+proto::Stream_Kind bloomFilterStreamKind(DwrfFormat format) {
+  if (format == DwrfFormat::kOrc) {
+    return static_cast<proto::Stream_Kind>(
+        proto::orc::Stream_Kind_BLOOM_FILTER_UTF8);
+  }
+  return proto::Stream_Kind_BLOOM_FILTER_UTF8;
+}
+} // namespace
+
 DwrfData::DwrfData(
     std::shared_ptr<const dwio::common::TypeWithId> fileType,
     StripeStreams& stripe,
     const StreamLabels& streamLabels,
-    FlatMapContext flatMapContext)
+    FlatMapContext flatMapContext,
+    const common::ScanSpec* scanSpec)
     : memoryPool_(stripe.getMemoryPool()),
       fileType_(std::move(fileType)),
       flatMapContext_(std::move(flatMapContext)),
@@ -48,6 +146,17 @@ DwrfData::DwrfData(
       encodingKey.forKind(proto::Stream_Kind_ROW_INDEX),
       streamLabels.label(),
       false);
+
+  // Unlike the index, bloom filters are only read for the filters known at
+  // construct time. They are large and only help equality and IN filters,
+  // so that reading them for every column would cost more than it saves.
+  if (scanSpec != nullptr &&
+      bloomFilterHashes(scanSpec->filter(), *fileType_->type()).has_value()) {
+    bloomFilterStream_ = stripe.getStream(
+        encodingKey.forKind(bloomFilterStreamKind(stripe.format())),
+        streamLabels.label(),
+        false);
+  }
 }
 
 uint64_t DwrfData::skipNulls(uint64_t numValues, bool /*nullsOnly*/) {
@@ -90,6 +199,34 @@ void DwrfData::ensureRowGroupIndex() {
   }
 }
 
+void DwrfData::ensureBloomFilters() {
+  if (!bloomFilterStream_) {
+    return;
+  }
+  auto index = ProtoUtils::readProto<proto::BloomFilterIndex>(
+      std::move(bloomFilterStream_));
+  bloomFilters_.reserve(index->bloomfilter_size());
+  for (const auto& bloomFilter : index->bloomfilter()) {
+    bloomFilters_.emplace_back(bloomFilter);
+  }
+}
+
+bool DwrfData::excludedByBloomFilter(
+    int32_t index,
+    const std::vector<uint64_t>& hashes) const {
+  if (index >= static_cast<int32_t>(bloomFilters_.size()) ||
+      bloomFilters_[index].empty()) {
+    return false;
+  }
+  const auto& bloomFilter = bloomFilters_[index];
+  for (auto hash : hashes) {
+    if (bloomFilter.testHash(hash)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 dwio::common::PositionProvider DwrfData::seekToRowGroup(uint32_t index) {
   ensureRowGroupIndex();
   tempPositions_ = toPositionsInner(index_->entry(index));
@@ -153,6 +290,14 @@ void DwrfData::filterRowGroups(
   if (result.filterResult.size() < nwords) {
     result.filterResult.resize(nwords);
   }
+  ensureBloomFilters();
+  std::optional<std::vector<uint64_t>> bloomHashes;
+  if (!bloomFilters_.empty()) {
+    bloomHashes = bloomFilterHashes(filter, *fileType_->type());
+    if (bloomHashes.has_value() && result.bloomFilterResult.size() < nwords) {
+      result.bloomFilterResult.resize(nwords);
+    }
+  }
   auto metadataFiltersStartIndex = result.metadataFilterResults.size();
   for (int i = 0; i < scanSpec.numMetadataFilters(); ++i) {
     result.metadataFilterResults.emplace_back(
@@ -169,6 +314,16 @@ void DwrfData::filterRowGroups(
       bits::setBit(result.filterResult.data(), i);
       continue;
     }
+    if (bloomHashes.has_value() &&
+        excludedByBloomFilter(i, bloomHashes.value())) {
+      VLOG(1) << "Drop stride " << i << " by bloom filter on "
+              << scanSpec.toString();
+      if (!bits::isBitSet(result.filterResult.data(), i)) {
+        bits::setBit(result.bloomFilterResult.data(), i);
+      }
+      bits::setBit(result.filterResult.data(), i);
+      continue;
+    }
     for (int j = 0; j < scanSpec.numMetadataFilters(); ++j) {
       auto* metadataFilter = scanSpec.metadataFilterAt(j);
       if (!testFilter(
@@ -21,6 +21,7 @@
 #include "velox/dwio/common/FormatData.h"
 #include "velox/dwio/common/TypeWithId.h"
 #include "velox/dwio/common/compression/Compression.h"
+#include "velox/dwio/dwrf/common/BloomFilter.h"
 #include "velox/dwio/dwrf/common/ByteRLE.h"
 #include "velox/dwio/dwrf/common/RLEv1.h"
 #include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
@@ -37,7 +38,8 @@ class DwrfData : public dwio::common::FormatData {
       std::shared_ptr<const dwio::common::TypeWithId> fileType,
       StripeStreams& stripe,
       const StreamLabels& streamLabels,
-      FlatMapContext flatMapContext);
+      FlatMapContext flatMapContext,
+      const common::ScanSpec* scanSpec = nullptr);
 
   void readNulls(
       vector_size_t numValues,
@@ -100,12 +102,27 @@ class DwrfData : public dwio::common::FormatData {
         entry.positions().begin(), entry.positions().end());
   }
 
+  // Decodes 'bloomFilters_' from 'bloomFilterStream_' if not already
+  // decoded.
+  void ensureBloomFilters();
+
+  // Returns true if the bloom filter of row group 'index' shows that no value
+  // with one of 'hashes' is in the row group.
+  bool excludedByBloomFilter(
+      int32_t index,
+      const std::vector<uint64_t>& hashes) const;
+
   memory::MemoryPool& memoryPool_;
   const std::shared_ptr<const dwio::common::TypeWithId> fileType_;
   FlatMapContext flatMapContext_;
   std::unique_ptr<ByteRleDecoder> notNullDecoder_;
   std::unique_ptr<dwio::common::SeekableInputStream> indexStream_;
   std::unique_ptr<proto::RowIndex> index_;
+  // Bloom filters of the row groups. The stream is only read if the filter
+  // of the column at construction time can be tested against bloom
+  // filters.
+  std::unique_ptr<dwio::common::SeekableInputStream> bloomFilterStream_;
+  std::vector<BloomFilter> bloomFilters_;
   int64_t stripeRows_;
   // Number of rows in a row group. Last row group may have fewer rows.
   uint32_t rowsPerRowGroup_;
@@ -133,9 +150,9 @@ class DwrfParams : public dwio::common::FormatParams {
 
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
-      const common::ScanSpec& /*scanSpec*/) override {
+      const common::ScanSpec& scanSpec) override {
     return std::make_unique<DwrfData>(
-        type, stripeStreams_, streamLabels_, flatMapContext_);
+        type, stripeStreams_, streamLabels_, flatMapContext_, &scanSpec);
   }
 
   StripeStreams& stripeStreams() {
@@ -18,7 +18,9 @@
 
 #include <chrono>
 
+#include "velox/dwio/common/AdaptivePrefetchUnitLoader.h"
 #include "velox/dwio/common/OnDemandUnitLoader.h"
+#include "velox/dwio/common/SelectiveStructColumnReader.h"
 #include "velox/dwio/common/TypeUtils.h"
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/reader/ColumnReader.h"
@@ -166,6 +168,16 @@ void DwrfUnit::ensureDecoders() {
         flatMapContext,
         true); // isRoot
     selectiveColumnReader_->setIsTopLevel();
+    if (options_.getDecodingParallelismFactor() > 1) {
+      auto* root =
+          dynamic_cast<dwio::common::SelectiveStructColumnReaderBase*>(
+              selectiveColumnReader_.get());
+      if (root) {
+        root->setDecodingParallelism(
+            options_.getDecodingExecutor().get(),
+            options_.getDecodingParallelismFactor());
+      }
+    }
   } else {
     columnReader_ = ColumnReader::build( // enqueue streams
         requestedType,
@@ -459,6 +471,7 @@ void DwrfRowReader::checkSkipStrides(uint64_t strideSize) {
     stridesToSkip_ = res.filterResult.data();
     stridesToSkipSize_ = res.totalCount;
     stripeStridesToSkip_[currentStripe_] = std::move(res.filterResult);
+    bloomFilterStridesToSkip_ = std::move(res.bloomFilterResult);
     recomputeStridesToSkip_ = false;
   }
 
@@ -469,6 +482,10 @@ void DwrfRowReader::checkSkipStrides(uint64_t strideSize) {
     foundStridesToSkip = true;
     currentRowInStripe_ =
         std::min(currentRowInStripe_ + strideSize, rowsInCurrentStripe_);
+    if (currentStride < bloomFilterStridesToSkip_.size() * 64 &&
+        bits::isBitSet(bloomFilterStridesToSkip_.data(), currentStride)) {
+      skippedStridesByBloomFilter_++;
+    }
     currentStride++;
     skippedStrides_++;
   }
@@ -1124,7 +1141,18 @@ std::unique_ptr<dwio::common::RowReader> DwrfReader::createRowReader(
 
 std::unique_ptr<DwrfRowReader> DwrfReader::createDwrfRowReader(
     const RowReaderOptions& opts) const {
-  auto rowReader = std::make_unique<DwrfRowReader>(readerBase_, opts);
+  std::unique_ptr<DwrfRowReader> rowReader;
+  if (options_.adaptivePrefetchRowGroups() && !opts.getUnitLoaderFactory()) {
+    auto adaptiveOpts = opts;
+    adaptiveOpts.setUnitLoaderFactory(
+        std::make_shared<dwio::common::AdaptivePrefetchUnitLoaderFactory>(
+            options_.prefetchRowGroups(),
+            &readerBase_->getMemoryPool(),
+            opts.getBlockedOnIoCallback()));
+    rowReader = std::make_unique<DwrfRowReader>(readerBase_, adaptiveOpts);
+  } else {
+    rowReader = std::make_unique<DwrfRowReader>(readerBase_, opts);
+  }
   if (opts.getEagerFirstStripeLoad()) {
     // Load the first stripe on construction so that readers created in
     // background have a reader tree and can preload the first
@@ -95,6 +95,10 @@ class DwrfRowReader : public StrideIndexProvider,
   void updateRuntimeStats(
       dwio::common::RuntimeStatistics& stats) const override {
     stats.skippedStrides += skippedStrides_;
+    stats.skippedStridesByBloomFilter += skippedStridesByBloomFilter_;
+    if (unitLoader_) {
+      unitLoader_->updateRuntimeStats(stats);
+    }
     stats.columnReaderStatistics.flattenStringDictionaryValues +=
         columnReaderStatistics_.flattenStringDictionaryValues;
   }
@@ -150,8 +154,13 @@ class DwrfRowReader : public StrideIndexProvider,
   int stridesToSkipSize_;
   // Record of strides to skip in each visited stripe. Used for diagnostics.
   std::unordered_map<uint32_t, std::vector<uint64_t>> stripeStridesToSkip_;
+  // Strides of the current stripe that are skipped based on bloom filters.
+  std::vector<uint64_t> bloomFilterStridesToSkip_;
   // Number of skipped strides.
   int64_t skippedStrides_{0};
+  // Number of the strides in 'skippedStrides_' skipped based on bloom
+  // filters.
+  int64_t skippedStridesByBloomFilter_{0};
 
   // Set to true after clearing filter caches, i.e. adding a dynamic
   // filter. Causes filters to be re-evaluated against stride stats on
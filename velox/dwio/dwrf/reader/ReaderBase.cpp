@@ -32,6 +32,17 @@ using dwio::common::encryption::DecrypterFactory;
 using encryption::DecryptionHandler;
 using memory::MemoryPool;
 
+namespace {
+std::unique_ptr<PostScript> copyPostScript(const PostScript& postScript) {
+  if (postScript.format() == DwrfFormat::kDwrf) {
+    return std::make_unique<PostScript>(
+        proto::PostScript(*postScript.getDwrfPtr()));
+  }
+  return std::make_unique<PostScript>(
+      proto::orc::PostScript(*postScript.getOrcPtr()));
+}
+} // namespace
+
 FooterStatisticsImpl::FooterStatisticsImpl(
     const ReaderBase& reader,
     const StatsContext& statsContext) {
@@ -104,12 +115,54 @@ ReaderBase::ReaderBase(
       input_(std::move(input)),
       randomSkip_(std::move(randomSkip)) {
   process::TraceContext trace("ReaderBase::ReaderBase");
-  // read last bytes into buffer to get PostScript
-  // If file is small, load the entire file.
-  // TODO: make a config
   fileLength_ = input_->getReadFile()->size();
   DWIO_ENSURE(fileLength_ > 0, "ORC file is empty");
 
+  auto* metadataCache = dwio::common::FileMetadataCache::getInstance();
+  const auto fileName =
+      metadataCache != nullptr ? input_->getReadFile()->getName() : "";
+  if (fileName.empty()) {
+    readTail(fileFormat, nullptr, fileName);
+  } else if (
+      auto tail = metadataCache->get<DwrfFileTail>(fileName, fileLength_)) {
+    initFromTail(std::move(tail));
+    if (fileLength_ <= filePreloadThreshold_) {
+      // Small files are still read whole in one IO.
+      input_->enqueue({0, fileLength_, "file"});
+      input_->load(LogType::FILE);
+    }
+  } else {
+    readTail(fileFormat, metadataCache, fileName);
+  }
+
+  schema_ = std::dynamic_pointer_cast<const RowType>(
+      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
+  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
+
+  if (!cache_ && input_->shouldPrefetchStripes()) {
+    auto numStripes = getFooter().stripesSize();
+    for (auto i = 0; i < numStripes; i++) {
+      const auto stripe = getFooter().stripes(i);
+      input_->enqueue(
+          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
+           stripe.footerLength(),
+           "stripe_footer"});
+    }
+    if (numStripes) {
+      input_->load(LogType::FOOTER);
+    }
+  }
+  // initialize file decrypter
+  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+}
+
+void ReaderBase::readTail(
+    FileFormat fileFormat,
+    dwio::common::FileMetadataCache* metadataCache,
+    const std::string& fileName) {
+  // read last bytes into buffer to get PostScript
+  // If file is small, load the entire file.
+  // TODO: make a config
   auto preloadFile = fileLength_ <= filePreloadThreshold_;
   uint64_t readSize =
       preloadFile ? fileLength_ : std::min(fileLength_, footerEstimatedSize_);
@@ -186,43 +239,53 @@ ReaderBase::ReaderBase(
     footer_ = std::make_unique<FooterWrapper>(footer);
   }
 
-  schema_ = std::dynamic_pointer_cast<const RowType>(
-      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
-  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
-
   // load stripe index/footer cache
+  std::shared_ptr<dwio::common::DataBuffer<char>> stripeCacheBuffer;
   if (cacheSize > 0) {
     DWIO_ENSURE_EQ(format(), DwrfFormat::kDwrf);
-    if (input_->shouldPrefetchStripes()) {
+    if (input_->shouldPrefetchStripes() && metadataCache == nullptr) {
       cache_ = std::make_unique<StripeMetadataCache>(
           postScript_->cacheMode(),
           *footer_,
           input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER));
       input_->load(LogType::FOOTER);
     } else {
-      auto cacheBuffer =
-          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
+      // A cached tail outlives 'input_', so it keeps its own copy of the
+      // stripe metadata in the pool of the cache.
+      stripeCacheBuffer = std::make_shared<dwio::common::DataBuffer<char>>(
+          metadataCache != nullptr ? *metadataCache->pool() : pool_,
+          cacheSize);
       input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER)
-          ->readFully(cacheBuffer->data(), cacheSize);
+          ->readFully(stripeCacheBuffer->data(), cacheSize);
       cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
+          postScript_->cacheMode(), *footer_, stripeCacheBuffer);
     }
   }
-  if (!cache_ && input_->shouldPrefetchStripes()) {
-    auto numStripes = getFooter().stripesSize();
-    for (auto i = 0; i < numStripes; i++) {
-      const auto stripe = getFooter().stripes(i);
-      input_->enqueue(
-          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
-           stripe.footerLength(),
-           "stripe_footer"});
-    }
-    if (numStripes) {
-      input_->load(LogType::FOOTER);
-    }
+
+  if (metadataCache != nullptr) {
+    auto tail = std::make_shared<DwrfFileTail>();
+    tail->arena = std::move(arena_);
+    arena_ = std::make_unique<google::protobuf::Arena>();
+    tail->postScript = copyPostScript(*postScript_);
+    tail->footer = std::make_unique<FooterWrapper>(*footer_);
+    tail->pool = metadataCache->pool();
+    tail->stripeCacheBuffer = std::move(stripeCacheBuffer);
+    tail->psLength = psLength_;
+    const auto bytes = tail->arena->SpaceUsed() + psLength_ + cacheSize;
+    tail_ = tail;
+    metadataCache->put(fileName, fileLength_, std::move(tail), bytes);
   }
-  // initialize file decrypter
-  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+}
+
+void ReaderBase::initFromTail(std::shared_ptr<const DwrfFileTail> tail) {
+  psLength_ = tail->psLength;
+  postScript_ = copyPostScript(*tail->postScript);
+  footer_ = std::make_unique<FooterWrapper>(*tail->footer);
+  if (tail->stripeCacheBuffer != nullptr) {
+    cache_ = std::make_unique<StripeMetadataCache>(
+        postScript_->cacheMode(), *footer_, tail->stripeCacheBuffer);
+  }
+  tail_ = std::move(tail);
 }
 
 std::vector<uint64_t> ReaderBase::getRowsPerStripe() const {
@@ -18,6 +18,7 @@
 
 #include "velox/common/base/RandomUtil.h"
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/TypeWithId.h"
@@ -58,6 +59,20 @@ class FooterStatisticsImpl : public dwio::common::Statistics {
   }
 };
 
+/// The parsed post script, footer and stripe metadata of a file. Shared by
+/// the readers of the file through dwio::common::FileMetadataCache.
+struct DwrfFileTail : public dwio::common::FileMetadataCache::Entry {
+  // Owns the messages referenced by 'footer'.
+  std::unique_ptr<google::protobuf::Arena> arena;
+  std::unique_ptr<PostScript> postScript;
+  std::unique_ptr<FooterWrapper> footer;
+  // Pool of 'stripeCacheBuffer'. Declared before it to be destroyed after.
+  std::shared_ptr<memory::MemoryPool> pool;
+  // The stripe index and footer section for StripeMetadataCache or nullptr.
+  std::shared_ptr<dwio::common::DataBuffer<char>> stripeCacheBuffer;
+  uint64_t psLength{0};
+};
+
 class ReaderBase {
  public:
   // create reader base from buffered input
@@ -211,7 +226,16 @@ class ReaderBase {
         getCompressionBlockSize(),
         pool_,
         streamDebugInfo,
-        decrypter);
+        decrypter,
+        ioStats());
+  }
+
+  /// Returns the IO statistics of the file, nullptr if none.
+  dwio::common::IoStatistics* ioStats() const {
+    if (input_ == nullptr || input_->getInputStream() == nullptr) {
+      return nullptr;
+    }
+    return input_->getInputStream()->getStats();
   }
 
   template <typename T>
@@ -242,7 +266,19 @@ class ReaderBase {
       uint32_t index = 0,
       bool fileColumnNamesReadAsLowerCase = false);
 
+  // Reads and parses the post script, footer and stripe metadata cache. If
+  // 'metadataCache' is set, adds the result to it under 'fileName'.
+  void readTail(
+      dwio::common::FileFormat fileFormat,
+      dwio::common::FileMetadataCache* metadataCache,
+      const std::string& fileName);
+
+  // Sets the post script, footer and stripe metadata cache from 'tail'.
+  void initFromTail(std::shared_ptr<const DwrfFileTail> tail);
+
   memory::MemoryPool& pool_;
+  // The shared tail the footer is from, if the file metadata cache is used.
+  std::shared_ptr<const DwrfFileTail> tail_;
   std::unique_ptr<google::protobuf::Arena> arena_;
   std::unique_ptr<PostScript> postScript_;
   std::unique_ptr<FooterWrapper> footer_ = nullptr;
@@ -16,6 +16,7 @@
 
 #include "velox/dwio/dwrf/reader/SelectiveFlatMapColumnReader.h"
 
+#include "velox/common/base/SelectivityInfo.h"
 #include "velox/dwio/common/FlatMapHelper.h"
 #include "velox/dwio/dwrf/reader/SelectiveDwrfReader.h"
 #include "velox/dwio/dwrf/reader/SelectiveStructColumnReader.h"
@@ -74,13 +75,17 @@ struct KeyNode {
         inMap(std::move(inMap)) {}
 };
 
+// Makes the readers of the keys of the flat map. If not 'asStruct', sets
+// 'missingKeyFiltersOut' to true if a key with a filter that does not pass
+// nulls, e.g. m['key'] = 1, is not in the stripe, so that no row can pass.
 template <typename T>
 std::vector<KeyNode<T>> getKeyNodes(
     const std::shared_ptr<const dwio::common::TypeWithId>& requestedType,
     const std::shared_ptr<const dwio::common::TypeWithId>& fileType,
     DwrfParams& params,
     common::ScanSpec& scanSpec,
-    bool asStruct) {
+    bool asStruct,
+    bool* missingKeyFiltersOut = nullptr) {
   using namespace dwio::common::flatmap;
 
   std::vector<KeyNode<T>> keyNodes;
@@ -105,6 +110,27 @@ std::vector<KeyNode<T>> getKeyNodes(
     valuesSpec->setExtractValues(true);
   }
 
+  // Specs of the values of single keys, e.g. for filters on m['key']. These
+  // keys are read even if pruned by 'keysSpec'.
+  std::unordered_map<std::string, common::ScanSpec*> keyValueSpecs;
+  for (auto& c : scanSpec.children()) {
+    if (!c->mapKey().has_value()) {
+      continue;
+    }
+    VELOX_USER_CHECK(
+        !asStruct,
+        "Subscript filters are not supported on flat maps read as structs: {}",
+        c->fieldName());
+    VELOX_USER_CHECK(
+        requestedValueType->type()->isPrimitiveType(),
+        "Filters on flat map values of complex type are not supported: {}",
+        c->fieldName());
+    c->setProjectOut(true);
+    c->setExtractValues(true);
+    keyValueSpecs[c->mapKey().value()] = c.get();
+  }
+  std::unordered_set<common::ScanSpec*> foundKeyValueSpecs;
+
   std::unordered_map<KeyValue<T>, common::ScanSpec*, KeyValueHash<T>>
       childSpecs;
   if (asStruct) {
@@ -141,6 +167,10 @@ std::vector<KeyNode<T>> getKeyNodes(
         } else if (asStruct) {
           // Column not selected in 'scanSpec', skipping it.
           return;
+        } else if (auto keyIt = keyValueSpecs.find(toString(key.get()));
+                   keyIt != keyValueSpecs.end()) {
+          childSpecs[key] = childSpec = keyIt->second;
+          foundKeyValueSpecs.insert(childSpec);
         } else {
           if (keysSpec && keysSpec->filter() &&
               !common::applyFilter(*keysSpec->filter(), key.get())) {
@@ -167,6 +197,17 @@ std::vector<KeyNode<T>> getKeyNodes(
             key, sequence, std::move(reader), std::move(inMapDecoder));
       });
 
+  if (missingKeyFiltersOut) {
+    *missingKeyFiltersOut = false;
+    for (auto& [_, spec] : keyValueSpecs) {
+      // The values of a key that is not in the stripe are all null.
+      if (!foundKeyValueSpecs.count(spec) && spec->filter() &&
+          !spec->filter()->testNull()) {
+        *missingKeyFiltersOut = true;
+      }
+    }
+  }
+
   VLOG(1) << "[Flat-Map] Initialized a flat-map column reader for node "
           << fileType->id() << ", keys=" << keyNodes.size()
           << ", streams=" << streams;
@@ -217,8 +258,13 @@ class SelectiveFlatMapReader : public SelectiveStructColumnReaderBase {
             fileType,
             params,
             scanSpec),
-        keyNodes_(
-            getKeyNodes<T>(requestedType, fileType, params, scanSpec, false)) {
+        keyNodes_(getKeyNodes<T>(
+            requestedType,
+            fileType,
+            params,
+            scanSpec,
+            false,
+            &missingKeyFiltersOut_)) {
     std::sort(keyNodes_.begin(), keyNodes_.end(), [](auto& x, auto& y) {
       return x.sequence < y.sequence;
     });
@@ -226,6 +272,9 @@ class SelectiveFlatMapReader : public SelectiveStructColumnReaderBase {
     for (int i = 0; i < keyNodes_.size(); ++i) {
       children_[i] = keyNodes_[i].reader.get();
       children_[i]->setIsFlatMapValue(true);
+      if (children_[i]->scanSpec()->hasFilter()) {
+        filteredChildren_.push_back(i);
+      }
     }
     if (auto type = requestedType_->type()->childAt(1); type->isRow()) {
       childValues_ = BaseVector::create(type, 0, &memoryPool_);
@@ -262,10 +311,40 @@ class SelectiveFlatMapReader : public SelectiveStructColumnReaderBase {
     for (auto* reader : children_) {
       advanceFieldReader(reader, offset);
     }
-    for (auto* reader : children_) {
+    if (missingKeyFiltersOut_) {
+      activeRows = {};
+    }
+    // The keys with filters are read first and narrow down the rows for the
+    // others.
+    for (auto i : filteredChildren_) {
+      if (activeRows.empty()) {
+        break;
+      }
+      auto* reader = children_[i];
+      auto& selectivity = reader->scanSpec()->selectivity();
+      SelectivityTimer timer(selectivity, activeRows.size());
+      reader->resetInitTimeClocks();
       reader->read(offset, activeRows, mapNulls);
+      timer.subtract(reader->initTimeClocks());
+      activeRows = reader->outputRows();
+      selectivity.addOutput(activeRows.size());
+    }
+    if (!activeRows.empty()) {
+      for (auto* reader : children_) {
+        if (!reader->scanSpec()->hasFilter()) {
+          reader->read(offset, activeRows, mapNulls);
+        }
+      }
+    }
+    for (auto* reader : children_) {
       reader->addParentNulls(offset, mapNulls, rows);
     }
+    // 'outputRows_' is already set if only the map itself has a filter.
+    if (scanSpec_->hasFilter() &&
+        (!scanSpec_->filter() || missingKeyFiltersOut_ ||
+         !filteredChildren_.empty())) {
+      setOutputRows(activeRows);
+    }
     lazyVectorReadOffset_ = offset;
     readOffset_ = offset + rows.back() + 1;
   }
@@ -444,7 +523,11 @@ class SelectiveFlatMapReader : public SelectiveStructColumnReaderBase {
     }
   }
 
+  // True if no row can pass the filters, see getKeyNodes().
+  bool missingKeyFiltersOut_{false};
   std::vector<KeyNode<T>> keyNodes_;
+  // Indices in 'children_' of the keys with filters.
+  std::vector<int32_t> filteredChildren_;
   VectorPtr childValues_;
   DecodedVector decodedChildValues_;
   std::vector<const uint64_t*> inMaps_;
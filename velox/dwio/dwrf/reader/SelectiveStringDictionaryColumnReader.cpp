@@ -35,6 +35,16 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
   version_ = convertRleVersion(stripe.getEncoding(encodingKey).kind());
   scanState_.dictionary.numValues =
       stripe.getEncoding(encodingKey).dictionarysize();
+  if (auto* cache = SharedStringDictionaryCache::getInstance()) {
+    if (auto fileNum = stripe.fileNum()) {
+      dictionaryCacheKey_ = SharedStringDictionaryCache::Key{
+          *fileNum,
+          stripe.stripeOffset(),
+          fileType_->id(),
+          params.flatMapContext().sequence};
+      cachedDictionary_ = cache->find(*dictionaryCacheKey_);
+    }
+  }
 
   const auto dataId = encodingKey.forKind(proto::Stream_Kind_DATA);
   bool dictVInts = stripe.getUseVInts(dataId);
@@ -45,19 +55,21 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
       dictVInts,
       dwio::common::INT_BYTE_SIZE);
 
-  const auto lenId = encodingKey.forKind(proto::Stream_Kind_LENGTH);
-  bool lenVInts = stripe.getUseVInts(lenId);
-  lengthDecoder_ = createRleDecoder</*isSigned*/ false>(
-      stripe.getStream(lenId, params.streamLabels().label(), false),
-      version_,
-      memoryPool_,
-      lenVInts,
-      dwio::common::INT_BYTE_SIZE);
+  if (!cachedDictionary_) {
+    const auto lenId = encodingKey.forKind(proto::Stream_Kind_LENGTH);
+    bool lenVInts = stripe.getUseVInts(lenId);
+    lengthDecoder_ = createRleDecoder</*isSigned*/ false>(
+        stripe.getStream(lenId, params.streamLabels().label(), false),
+        version_,
+        memoryPool_,
+        lenVInts,
+        dwio::common::INT_BYTE_SIZE);
 
-  blobStream_ = stripe.getStream(
-      encodingKey.forKind(proto::Stream_Kind_DICTIONARY_DATA),
-      params.streamLabels().label(),
-      false);
+    blobStream_ = stripe.getStream(
+        encodingKey.forKind(proto::Stream_Kind_DICTIONARY_DATA),
+        params.streamLabels().label(),
+        false);
+  }
 
   // handle in dictionary stream
   std::unique_ptr<SeekableInputStream> inDictStream = stripe.getStream(
@@ -100,10 +112,11 @@ uint64_t SelectiveStringDictionaryColumnReader::skip(uint64_t numValues) {
 void SelectiveStringDictionaryColumnReader::loadDictionary(
     SeekableInputStream& data,
     IntDecoder</*isSigned*/ false>& lengthDecoder,
-    DictionaryValues& values) {
+    DictionaryValues& values,
+    memory::MemoryPool& pool) {
   // read lengths from length reader
   dwio::common::ensureCapacity<StringView>(
-      values.values, values.numValues, &memoryPool_);
+      values.values, values.numValues, &pool);
   // The lengths are read in the low addresses of the string views array.
   auto* lengths = values.values->asMutable<int32_t>();
   lengthDecoder.nextLengths(lengths, values.numValues);
@@ -112,7 +125,7 @@ void SelectiveStringDictionaryColumnReader::loadDictionary(
     stringsBytes += lengths[i];
   }
   // read bytes from underlying string
-  values.strings = AlignedBuffer::allocate<char>(stringsBytes, &memoryPool_);
+  values.strings = AlignedBuffer::allocate<char>(stringsBytes, &pool);
   data.readFully(values.strings->asMutable<char>(), stringsBytes);
   // fill the values with StringViews over the strings. 'strings' will
   // exist even if 'stringsBytes' is 0, which can happen if the only
@@ -147,7 +160,10 @@ void SelectiveStringDictionaryColumnReader::loadStrideDictionary() {
     strideDictLengthDecoder_->seekToRowGroup(pp);
 
     loadDictionary(
-        *strideDictStream_, *strideDictLengthDecoder_, scanState_.dictionary2);
+        *strideDictStream_,
+        *strideDictLengthDecoder_,
+        scanState_.dictionary2,
+        memoryPool_);
   }
   lastStrideIndex_ = nextStride;
   dictionaryValues_ = nullptr;
@@ -324,6 +340,28 @@ void SelectiveStringDictionaryColumnReader::getValues(
       &memoryPool_, resultNulls(), numValues_, dictionaryValues_, values_);
 }
 
+void SelectiveStringDictionaryColumnReader::loadStripeDictionary() {
+  const auto numValues = scanState_.dictionary.numValues;
+  if (cachedDictionary_) {
+    scanState_.dictionary = std::move(cachedDictionary_.value());
+    cachedDictionary_.reset();
+  } else if (auto* cache = dictionaryCacheKey_
+                 ? SharedStringDictionaryCache::getInstance()
+                 : nullptr) {
+    scanState_.dictionary = cache->getOrLoad(
+        *dictionaryCacheKey_, [&](memory::MemoryPool& pool) {
+          DictionaryValues values;
+          values.numValues = numValues;
+          loadDictionary(*blobStream_, *lengthDecoder_, values, pool);
+          return values;
+        });
+  } else {
+    loadDictionary(
+        *blobStream_, *lengthDecoder_, scanState_.dictionary, memoryPool_);
+  }
+  VELOX_CHECK_EQ(scanState_.dictionary.numValues, numValues);
+}
+
 void SelectiveStringDictionaryColumnReader::ensureInitialized() {
   if (LIKELY(initialized_)) {
     return;
@@ -331,7 +369,7 @@ void SelectiveStringDictionaryColumnReader::ensureInitialized() {
 
   Timer timer;
 
-  loadDictionary(*blobStream_, *lengthDecoder_, scanState_.dictionary);
+  loadStripeDictionary();
 
   if (scanSpec_->hasFilter()) {
     scanState_.filterCache.resize(scanState_.dictionary.numValues);
@@ -19,6 +19,7 @@
 #include "velox/dwio/common/SelectiveColumnReaderInternal.h"
 #include "velox/dwio/dwrf/common/DecoderUtil.h"
 #include "velox/dwio/dwrf/reader/DwrfData.h"
+#include "velox/dwio/dwrf/reader/SharedStringDictionaryCache.h"
 
 namespace facebook::velox::dwrf {
 
@@ -74,12 +75,17 @@ class SelectiveStringDictionaryColumnReader
       RowSet rows,
       ExtractValues extractValues);
 
-  // Fills 'values' from 'data' and 'lengthDecoder'. The count of
-  // values is in 'values.numValues'.
+  // Fills 'values' from 'data' and 'lengthDecoder', allocating from 'pool'.
+  // The count of values is in 'values.numValues'.
   void loadDictionary(
       dwio::common::SeekableInputStream& data,
       dwio::common::IntDecoder</*isSigned*/ false>& lengthDecoder,
-      dwio::common::DictionaryValues& values);
+      dwio::common::DictionaryValues& values,
+      memory::MemoryPool& pool);
+
+  // Sets the stripe dictionary from the SharedStringDictionaryCache or by
+  // decoding it.
+  void loadStripeDictionary();
   void ensureInitialized();
 
   void makeFlat(VectorPtr* result);
@@ -105,6 +111,13 @@ class SelectiveStringDictionaryColumnReader
   std::unique_ptr<dwio::common::SeekableInputStream> blobStream_;
   bool initialized_{false};
   vector_size_t numRowsScanned_;
+
+  // Key of the stripe dictionary in the SharedStringDictionaryCache if the
+  // file can be cached.
+  std::optional<SharedStringDictionaryCache::Key> dictionaryCacheKey_;
+  // The stripe dictionary if found in the cache at construction. The
+  // dictionary streams are then not read.
+  std::optional<dwio::common::DictionaryValues> cachedDictionary_;
 };
 
 template <typename TVisitor>
@@ -22,6 +22,30 @@ namespace facebook::velox::dwrf {
 
 using namespace dwio::common;
 
+namespace {
+// Scale of the nanos indexed by the low 3 bits of the encoded value. The
+// writer removes trailing decimal zeros: 0 means none were removed and n > 0
+// means n + 1 were.
+constexpr uint64_t kNanosScale[8] = {
+    1,
+    100,
+    1'000,
+    10'000,
+    100'000,
+    1'000'000,
+    10'000'000,
+    100'000'000};
+
+// Combines the encoded 'seconds' and 'nanos' of a DWRF timestamp. Has no
+// branches so that the loops calling it are vectorized.
+inline Timestamp decodeTimestamp(int64_t seconds, uint64_t nanos) {
+  nanos = (nanos >> 3) * kNanosScale[nanos & 7];
+  seconds += EPOCH_OFFSET;
+  seconds -= (seconds < 0) & (nanos != 0);
+  return Timestamp(seconds, nanos);
+}
+} // namespace
+
 SelectiveTimestampColumnReader::SelectiveTimestampColumnReader(
     const std::shared_ptr<const TypeWithId>& fileType,
     DwrfParams& params,
@@ -126,30 +150,23 @@ void SelectiveTimestampColumnReader::readHelper(
   }
 
   // Merge the seconds and nanos into 'values_'
-  auto secondsData = secondsValues_->as<int64_t>();
-  auto nanosData = values_->as<uint64_t>();
+  auto secondsData = secondsValues_->asMutable<int64_t>();
+  auto nanosData = values_->asMutable<uint64_t>();
   const auto rawNulls = nullsInReadRange_
       ? (isDense ? nullsInReadRange_->as<uint64_t>() : rawResultNulls_)
       : nullptr;
+  if (rawNulls) {
+    // The values of null rows are not decoded. Zero them so that all rows go
+    // through the same loop below.
+    bits::forEachUnsetBit(rawNulls, 0, numValues_, [&](auto i) {
+      secondsData[i] = 0;
+      nanosData[i] = 0;
+    });
+  }
   auto tsValues = AlignedBuffer::allocate<Timestamp>(numValues_, &memoryPool_);
   auto rawTs = tsValues->asMutable<Timestamp>();
-
   for (vector_size_t i = 0; i < numValues_; i++) {
-    if (!rawNulls || !bits::isBitNull(rawNulls, i)) {
-      auto nanos = nanosData[i];
-      uint64_t zeros = nanos & 0x7;
-      nanos >>= 3;
-      if (zeros != 0) {
-        for (uint64_t j = 0; j <= zeros; ++j) {
-          nanos *= 10;
-        }
-      }
-      auto seconds = secondsData[i] + EPOCH_OFFSET;
-      if (seconds < 0 && nanos != 0) {
-        seconds -= 1;
-      }
-      rawTs[i] = Timestamp(seconds, nanos);
-    }
+    rawTs[i] = decodeTimestamp(secondsData[i], nanosData[i]);
   }
   values_ = tsValues;
   rawValues_ = values_->asMutable<char>();
@@ -163,9 +180,10 @@ void SelectiveTimestampColumnReader::readHelper(
           : filter->kind()) {
     case common::FilterKind::kAlwaysTrue:
       // Simply add all rows to output.
-      for (vector_size_t i = 0; i < numValues_; i++) {
-        addOutputRow(rows[i]);
-      }
+      std::copy(
+          rows.begin(),
+          rows.begin() + numValues_,
+          mutableOutputRows(numValues_));
       break;
     case common::FilterKind::kIsNull:
       processNulls(true, rows, rawNulls);
@@ -174,6 +192,9 @@ void SelectiveTimestampColumnReader::readHelper(
       processNulls(false, rows, rawNulls);
       break;
     case common::FilterKind::kTimestampRange:
+      processFilter(
+          static_cast<const common::TimestampRange*>(filter), rows, rawNulls);
+      break;
     case common::FilterKind::kMultiRange:
       processFilter(filter, rows, rawNulls);
       break;
@@ -213,11 +234,30 @@ void SelectiveTimestampColumnReader::processNulls(
   }
 }
 
+template <typename TFilter>
 void SelectiveTimestampColumnReader::processFilter(
-    const common::Filter* filter,
+    const TFilter* filter,
     const RowSet rows,
     const uint64_t* rawNulls) {
   auto rawTs = values_->asMutable<Timestamp>();
+  if (!rawNulls) {
+    // Tests all values and compacts the passing ones without branches. The
+    // test is inlined when 'TFilter' is a final filter class.
+    const auto numOutputRows = numRows();
+    auto* outputRows = mutableOutputRows(numValues_);
+    vector_size_t numPassed = 0;
+    for (vector_size_t i = 0; i < numValues_; i++) {
+      const bool passed = filter->testTimestamp(rawTs[i]);
+      rawTs[numPassed] = rawTs[i];
+      outputRows[numPassed] = rows[i];
+      numPassed += passed;
+    }
+    setNumRows(numOutputRows + numPassed);
+    returnReaderNulls_ = false;
+    anyNulls_ = false;
+    allNull_ = numPassed == 0;
+    return;
+  }
 
   returnReaderNulls_ = false;
   anyNulls_ = false;
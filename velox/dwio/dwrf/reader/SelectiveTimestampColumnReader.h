@@ -46,8 +46,11 @@ class SelectiveTimestampColumnReader
 
   void
   processNulls(const bool isNull, const RowSet rows, const uint64_t* rawNulls);
+  // Keeps the rows whose value passes 'filter'. 'TFilter' is either
+  // common::Filter or a final filter class whose test is inlined.
+  template <typename TFilter>
   void processFilter(
-      const common::Filter* filter,
+      const TFilter* filter,
       const RowSet rows,
       const uint64_t* rawNulls);
 
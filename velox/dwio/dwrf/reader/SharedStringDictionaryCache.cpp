@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/reader/SharedStringDictionaryCache.h"
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::dwrf {
+
+namespace {
+SharedStringDictionaryCache* instance = nullptr;
+} // namespace
+
+size_t SharedStringDictionaryCache::KeyHasher::operator()(
+    const Key& key) const {
+  auto hash = bits::hashMix(key.fileNum, key.stripeOffset);
+  return bits::hashMix(
+      hash, (static_cast<uint64_t>(key.node) << 32) | key.sequence);
+}
+
+SharedStringDictionaryCache::SharedStringDictionaryCache(
+    uint64_t capacityBytes,
+    std::shared_ptr<memory::MemoryPool> pool)
+    : capacityBytes_(capacityBytes), pool_(std::move(pool)) {
+  VELOX_CHECK_NOT_NULL(pool_);
+  VELOX_CHECK(pool_->isLeaf());
+}
+
+// static
+SharedStringDictionaryCache* SharedStringDictionaryCache::getInstance() {
+  return instance;
+}
+
+// static
+void SharedStringDictionaryCache::setInstance(
+    SharedStringDictionaryCache* cache) {
+  instance = cache;
+}
+
+// static
+uint64_t SharedStringDictionaryCache::bytesOf(
+    const dwio::common::DictionaryValues& values) {
+  return (values.values ? values.values->capacity() : 0) +
+      (values.strings ? values.strings->capacity() : 0);
+}
+
+std::optional<dwio::common::DictionaryValues>
+SharedStringDictionaryCache::find(const Key& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  ++stats_.numHits;
+  lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+  return it->second.values;
+}
+
+dwio::common::DictionaryValues SharedStringDictionaryCache::getOrLoad(
+    const Key& key,
+    const std::function<dwio::common::DictionaryValues(memory::MemoryPool&)>&
+        load) {
+  if (auto values = find(key)) {
+    return std::move(values.value());
+  }
+  // Two readers may decode the same dictionary at the same time. The second
+  // one to finish uses the cached copy.
+  auto values = load(*pool_);
+  const auto bytes = bytesOf(values);
+  std::lock_guard<std::mutex> l(mutex_);
+  ++stats_.numMisses;
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+    return it->second.values;
+  }
+  if (bytes > capacityBytes_) {
+    return values;
+  }
+  lru_.push_front(key);
+  entries_.emplace(key, Entry{values, bytes, lru_.begin()});
+  stats_.bytes += bytes;
+  evictLocked();
+  return values;
+}
+
+void SharedStringDictionaryCache::evictLocked() {
+  while (stats_.bytes > capacityBytes_) {
+    VELOX_CHECK(!lru_.empty());
+    auto it = entries_.find(lru_.back());
+    VELOX_CHECK(it != entries_.end());
+    stats_.bytes -= it->second.bytes;
+    ++stats_.numEvictions;
+    entries_.erase(it);
+    lru_.pop_back();
+  }
+}
+
+void SharedStringDictionaryCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  stats_.bytes = 0;
+}
+
+SharedStringDictionaryCache::Stats SharedStringDictionaryCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto stats = stats_;
+  stats.numEntries = entries_.size();
+  return stats;
+}
+
+} // namespace facebook::velox::dwrf
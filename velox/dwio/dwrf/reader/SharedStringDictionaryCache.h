@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+
+#include "velox/dwio/common/SelectiveColumnReader.h"
+
+namespace facebook::velox::dwrf {
+
+/// Process-wide cache of decoded stripe string dictionaries. Lets the scans
+/// of different splits of the same stripe, and repeated scans of the same
+/// file, decode a dictionary once. The cached dictionaries are shared with
+/// the readers without copying, so they must not be modified. Their memory
+/// is allocated from and accounted to the pool of the cache. The cache
+/// keeps at most 'capacityBytes' of dictionaries and evicts the least
+/// recently used. Files are identified by the ids of
+/// BufferedInput::fileNum(), so only files read through the AsyncDataCache
+/// or DirectBufferedInput are cached.
+class SharedStringDictionaryCache {
+ public:
+  struct Key {
+    uint64_t fileNum;
+    uint64_t stripeOffset;
+    uint32_t node;
+    uint32_t sequence;
+
+    bool operator==(const Key& other) const {
+      return fileNum == other.fileNum && stripeOffset == other.stripeOffset &&
+          node == other.node && sequence == other.sequence;
+    }
+  };
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Stats {
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+    uint64_t numEvictions{0};
+    uint64_t numEntries{0};
+    uint64_t bytes{0};
+  };
+
+  /// 'pool' is a leaf pool that the dictionaries are allocated from.
+  SharedStringDictionaryCache(
+      uint64_t capacityBytes,
+      std::shared_ptr<memory::MemoryPool> pool);
+
+  /// Returns the process-wide cache or nullptr if there is none.
+  static SharedStringDictionaryCache* getInstance();
+
+  /// Sets the process-wide cache. The caller keeps ownership and must reset
+  /// the instance before destroying 'cache'.
+  static void setInstance(SharedStringDictionaryCache* cache);
+
+  /// Returns the dictionary for 'key' if it is cached.
+  std::optional<dwio::common::DictionaryValues> find(const Key& key);
+
+  /// Returns the dictionary for 'key'. If it is not cached, decodes it with
+  /// 'load', which must allocate from the pool it is given, and caches it.
+  /// 'load' runs outside of the lock of the cache.
+  dwio::common::DictionaryValues getOrLoad(
+      const Key& key,
+      const std::function<dwio::common::DictionaryValues(
+          memory::MemoryPool&)>& load);
+
+  /// Drops all entries. Readers keep the dictionaries they reference.
+  void clear();
+
+  Stats stats() const;
+
+  memory::MemoryPool& pool() const {
+    return *pool_;
+  }
+
+ private:
+  struct Entry {
+    dwio::common::DictionaryValues values;
+    uint64_t bytes;
+    std::list<Key>::iterator lruPosition;
+  };
+
+  static uint64_t bytesOf(const dwio::common::DictionaryValues& values);
+
+  // Evicts the least recently used entries until at most 'capacityBytes_'
+  // are cached.
+  void evictLocked();
+
+  const uint64_t capacityBytes_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<Key, Entry, KeyHasher> entries_;
+  // Keys from the most to the least recently used.
+  std::list<Key> lru_;
+  Stats stats_;
+};
+
+} // namespace facebook::velox::dwrf
@@ -168,6 +168,17 @@ class StripeStreams {
 
   // Number of rows per row group. Last row group may have fewer rows.
   virtual uint32_t rowsPerRowGroup() const = 0;
+
+  // Returns the process-wide id of the file, if any. See
+  // BufferedInput::fileNum().
+  virtual std::optional<uint64_t> fileNum() const {
+    return std::nullopt;
+  }
+
+  // Offset of the stripe in the file.
+  virtual uint64_t stripeOffset() const {
+    return 0;
+  }
 };
 
 class StripeStreamsBase : public StripeStreams {
@@ -326,6 +337,14 @@ class StripeStreamsImpl : public StripeStreamsBase {
     return stripeNumberOfRows_;
   }
 
+  std::optional<uint64_t> fileNum() const override {
+    return readState_->readerBase->getBufferedInput().fileNum();
+  }
+
+  uint64_t stripeOffset() const override {
+    return stripeStart_;
+  }
+
   uint32_t rowsPerRowGroup() const override {
     return readState_->readerBase->getFooter().rowIndexStride();
   }
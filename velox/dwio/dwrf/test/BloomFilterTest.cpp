@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+
+using namespace facebook::velox::dwrf;
+
+namespace {
+
+constexpr int32_t kNumValues = 10'000;
+
+// Sized like the writers do for a false positive rate of 5%.
+BloomFilter makeFilter() {
+  return BloomFilter(kNumValues * 7, 4);
+}
+
+TEST(BloomFilterTest, longs) {
+  auto filter = makeFilter();
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    filter.addLong(i * 1'000'003);
+  }
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    ASSERT_TRUE(filter.testLong(i * 1'000'003));
+  }
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    numFalsePositives += filter.testLong(-i - 1);
+  }
+  ASSERT_LT(numFalsePositives, kNumValues / 10);
+  // The integer hash maps 0 to 0.
+  ASSERT_EQ(BloomFilter::hashLong(0), 0ULL);
+}
+
+TEST(BloomFilterTest, bytes) {
+  auto filter = makeFilter();
+  // Covers all lengths of the tail of the hash.
+  for (int32_t i = 0; i < kNumValues; ++i) {
+    filter.addBytes(std::string(i % 20, 'x') + std::to_string(i));
+  }
+  for (int32_t i = 0; i < kNumValues; ++i) {
+    ASSERT_TRUE(filter.testBytes(std::string(i % 20, 'x') + std::to_string(i)));
+  }
+  int32_t numFalsePositives = 0;
+  for (int32_t i = 0; i < kNumValues; ++i) {
+    numFalsePositives += filter.testBytes(std::string(i % 20, 'y'));
+  }
+  ASSERT_LT(numFalsePositives, kNumValues / 10);
+  ASSERT_NE(BloomFilter::hashBytes("a"), BloomFilter::hashBytes("b"));
+  ASSERT_NE(BloomFilter::hashBytes(""), BloomFilter::hashBytes("a"));
+}
+
+TEST(BloomFilterTest, proto) {
+  auto filter = makeFilter();
+  filter.addLong(17);
+  filter.addBytes("abc");
+
+  proto::BloomFilter bitset;
+  bitset.set_numhashfunctions(filter.numHashFunctions());
+  for (auto word : filter.bits()) {
+    bitset.add_bitset(word);
+  }
+  proto::BloomFilter utf8;
+  utf8.set_numhashfunctions(filter.numHashFunctions());
+  std::string bytes(filter.bits().size() * sizeof(uint64_t), '\0');
+  ::memcpy(bytes.data(), filter.bits().data(), bytes.size());
+  utf8.set_utf8bitset(bytes);
+
+  for (const auto& message : {bitset, utf8}) {
+    BloomFilter read(message);
+    ASSERT_EQ(read.bits(), filter.bits());
+    ASSERT_TRUE(read.testLong(17));
+    ASSERT_TRUE(read.testBytes("abc"));
+    ASSERT_FALSE(read.testLong(18));
+  }
+
+  // A filter without bits matches everything.
+  BloomFilter empty{proto::BloomFilter()};
+  ASSERT_TRUE(empty.empty());
+  ASSERT_TRUE(empty.testLong(18));
+}
+
+} // namespace
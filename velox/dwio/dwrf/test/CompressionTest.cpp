@@ -22,8 +22,10 @@
 #include "velox/dwio/dwrf/test/OrcTest.h"
 
 #include <folly/Random.h>
+#include <folly/ScopeGuard.h>
 #include <gtest/gtest.h>
 #include "velox/common/compression/Compression.h"
+#include "velox/common/compression/HardwareDecompressor.h"
 
 #include <algorithm>
 
@@ -296,6 +298,85 @@ VELOX_INSTANTIATE_TEST_SUITE_P(
         std::make_tuple(CompressionKind_NONE, nullptr, nullptr),
         std::make_tuple(CompressionKind_NONE, &testEncrypter, &testDecrypter)));
 
+namespace {
+// Decompresses zstd with the software codec and fails every other block.
+class TestHardwareDecompressor : public HardwareDecompressor {
+ public:
+  bool supports(CompressionKind kind, int32_t /*windowBits*/) const override {
+    return kind == CompressionKind_ZSTD;
+  }
+
+  folly::SemiFuture<uint64_t> decompress(
+      CompressionKind /*kind*/,
+      int32_t /*windowBits*/,
+      folly::StringPiece input,
+      folly::MutableStringPiece output) override {
+    if (numCalls_++ % 2 == 1) {
+      return folly::makeSemiFuture<uint64_t>(
+          std::runtime_error("Accelerator queue is full"));
+    }
+    auto data = folly::io::getCodec(folly::io::CodecType::ZSTD)
+                    ->uncompress(input, output.size());
+    VELOX_CHECK_LE(data.size(), output.size());
+    ::memcpy(output.data(), data.data(), data.size());
+    return folly::makeSemiFuture<uint64_t>(data.size());
+  }
+
+  int32_t numCalls() const {
+    return numCalls_;
+  }
+
+ private:
+  int32_t numCalls_{0};
+};
+} // namespace
+
+TEST(HardwareDecompressorTest, offload) {
+  MemoryManager::testingSetInstance({});
+  auto pool = memoryManager()->addLeafPool();
+  MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool.get()});
+  constexpr uint64_t kBlock = 1024;
+  constexpr size_t kDataSize = 64 * 1024;
+  std::vector<char> data(kDataSize);
+  generateRandomData(data.data(), kDataSize, true);
+  compressAndVerify(
+      CompressionKind_ZSTD,
+      memSink,
+      kBlock,
+      *pool,
+      data.data(),
+      kDataSize,
+      nullptr);
+
+  auto hardware = std::make_shared<TestHardwareDecompressor>();
+  setHardwareDecompressor(hardware);
+  SCOPE_EXIT {
+    setHardwareDecompressor(nullptr);
+  };
+  IoStatistics ioStats;
+  auto decompressStream = createDecompressor(
+      CompressionKind_ZSTD,
+      std::make_unique<SeekableArrayInputStream>(
+          memSink.data(), memSink.size()),
+      kBlock,
+      *pool,
+      "Test Compression",
+      nullptr,
+      &ioStats);
+  const char* buffer;
+  int32_t size;
+  std::string decompressed;
+  while (decompressStream->Next(
+      reinterpret_cast<const void**>(&buffer), &size)) {
+    decompressed.append(buffer, size);
+  }
+  ASSERT_EQ(decompressed, std::string(data.data(), kDataSize));
+  // Every other block falls back to software decompression.
+  ASSERT_GT(hardware->numCalls(), 2);
+  ASSERT_GT(ioStats.offloadedDecompressionBytes(), 0);
+  ASSERT_LT(ioStats.offloadedDecompressionBytes(), memSink.size());
+}
+
 typedef std::tuple<CompressionKind, const Encrypter*> TestParams2;
 
 class RecordPositionTest : public TestWithParam<TestParams2> {
@@ -21,6 +21,7 @@
 #include "velox/dwio/dwrf/writer/FlushPolicy.h"
 #include "velox/dwio/dwrf/writer/Writer.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 
 using namespace facebook::velox::dwio::common;
@@ -95,6 +96,10 @@ class E2EFilterTest : public E2EFilterTestBase {
     if (!flatmapNodeIdsAsStruct_.empty()) {
       opts.setFlatmapNodeIdsAsStruct(flatmapNodeIdsAsStruct_);
     }
+    if (decodingExecutor_) {
+      opts.setDecodingExecutor(decodingExecutor_);
+      opts.setDecodingParallelismFactor(3);
+    }
   }
 
   std::unique_ptr<dwio::common::Reader> makeReader(
@@ -104,6 +109,7 @@ class E2EFilterTest : public E2EFilterTestBase {
   }
 
   std::unordered_set<std::string> flatMapColumns_;
+  std::shared_ptr<folly::Executor> decodingExecutor_;
 
  private:
   dwrf::WriterOptions createWriterOptions(const TypePtr& type) {
@@ -300,6 +306,22 @@ TEST_F(E2EFilterTest, timestamp) {
       true);
 }
 
+TEST_F(E2EFilterTest, preEpochTimestamp) {
+  // Negative seconds with non-zero nanos need the one second adjustment on
+  // read. Filters drop rows in the middle of batches of various sizes, with
+  // and without nulls, so that the decoded values get compacted.
+  readSizes_ = {1, 7, 100, 1000, 1001, 10000};
+  testWithTypes(
+      "timestamp_val:timestamp,"
+      "long_val:bigint",
+      [&]() { makePreEpochTimestamps("timestamp_val"); },
+      true,
+      {"timestamp_val"},
+      20,
+      true,
+      true);
+}
+
 TEST_F(E2EFilterTest, listAndMap) {
   int numCombinations = 20;
 #if !defined(NDEBUG) || defined(TSAN_BUILD)
@@ -354,6 +376,24 @@ TEST_F(E2EFilterTest, lazyStruct) {
       false);
 }
 
+TEST_F(E2EFilterTest, parallelDecoding) {
+  decodingExecutor_ = std::make_shared<folly::CPUThreadPoolExecutor>(2);
+  testWithTypes(
+      "long_val:bigint,"
+      "short_val:smallint,"
+      "double_val:double,"
+      "string_val:string,"
+      "int_val:int,"
+      "array_val:array<bigint>,"
+      "struct_val:struct<nested1:bigint, nested2:string>",
+      [&]() {},
+      true,
+      {"long_val", "string_val"},
+      10,
+      true,
+      false);
+}
+
 TEST_F(E2EFilterTest, filterStruct) {
 #ifdef TSAN_BUILD
   // The test is running slow under TSAN; reduce the number of combinations to
@@ -437,6 +477,88 @@ TEST_F(E2EFilterTest, flatMapComplex) {
       kColumns, customize, false, {"long_val"}, numCombinations, true);
 }
 
+TEST_F(E2EFilterTest, flatMapKeyFilter) {
+  batchCount_ = 4;
+  batchSize_ = 1'000;
+  flatMapColumns_ = {"m"};
+  test::VectorMaker vectorMaker(leafPool_.get());
+  std::vector<RowVectorPtr> batches;
+  for (int i = 0; i < batchCount_; ++i) {
+    const auto first = i * batchSize_;
+    // Key 3 is only in the maps of even rows. The values are 10 * row + key.
+    auto keyAt = [&](vector_size_t j, vector_size_t k) -> int64_t {
+      return (first + j) % 2 == 0 || k < 3 ? k : 4;
+    };
+    auto a = vectorMaker.flatVector<int64_t>(
+        batchSize_, [&](auto j) { return first + j; });
+    auto m = vectorMaker.mapVector<int64_t, int64_t>(
+        batchSize_,
+        [&](auto j) { return (first + j) % 2 == 0 ? 5 : 4; },
+        keyAt,
+        [&](vector_size_t j, vector_size_t k) -> int64_t {
+          return (first + j) * 10 + keyAt(j, k);
+        },
+        [&](auto j) { return (first + j) % 17 == 5; });
+    batches.push_back(vectorMaker.rowVector({"a", "m"}, {a, m}));
+  }
+  writeToMemory(batches[0]->type(), batches, false);
+
+  // Reads m[1] and m[3] of the rows where m[3] >= 15'003 and returns the
+  // rows read.
+  auto read = [&](std::unique_ptr<common::Filter> missingKeyFilter) {
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addFieldRecursively("a", *BIGINT(), 0);
+    spec->addFieldRecursively("m", *MAP(BIGINT(), BIGINT()), 1)
+        ->childByName(common::ScanSpec::kMapKeysFieldName)
+        ->setFilter(common::createBigintValues({1, 3}, false));
+    spec->getOrCreateChild(common::Subfield("m[3]"))
+        ->setFilter(std::make_unique<common::BigintRange>(
+            15'003, std::numeric_limits<int64_t>::max(), false));
+    if (missingKeyFilter) {
+      spec->getOrCreateChild(common::Subfield("m[7]"))
+          ->setFilter(std::move(missingKeyFilter));
+    }
+    ReaderOptions readerOpts{leafPool_.get()};
+    RowReaderOptions rowReaderOpts;
+    std::string_view data(sinkPtr_->data(), sinkPtr_->size());
+    auto input = std::make_unique<BufferedInput>(
+        std::make_shared<InMemoryReadFile>(data), readerOpts.getMemoryPool());
+    auto reader = makeReader(readerOpts, std::move(input));
+    setUpRowReaderOptions(rowReaderOpts, spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto result = BaseVector::create(batches[0]->type(), 1, leafPool_.get());
+    std::vector<int64_t> rows;
+    while (rowReader->next(100, result)) {
+      auto* row = result->as<RowVector>();
+      auto* a = row->childAt(0)->loadedVector()->asFlatVector<int64_t>();
+      auto* m = row->childAt(1)->loadedVector()->as<MapVector>();
+      auto* keys = m->mapKeys()->asFlatVector<int64_t>();
+      auto* values = m->mapValues()->asFlatVector<int64_t>();
+      for (vector_size_t i = 0; i < row->size(); ++i) {
+        rows.push_back(a->valueAt(i));
+        EXPECT_FALSE(m->isNullAt(i));
+        EXPECT_EQ(m->sizeAt(i), 2);
+        for (auto k = m->offsetAt(i); k < m->offsetAt(i) + m->sizeAt(i);
+             ++k) {
+          EXPECT_EQ(values->valueAt(k), a->valueAt(i) * 10 + keys->valueAt(k));
+        }
+      }
+    }
+    return rows;
+  };
+
+  std::vector<int64_t> expected;
+  for (int64_t row = 1'500; row < batchCount_ * batchSize_; ++row) {
+    if (row % 2 == 0 && row % 17 != 5) {
+      expected.push_back(row);
+    }
+  }
+  ASSERT_EQ(read(nullptr), expected);
+  // Key 7 is in no map, so none of its values is null.
+  ASSERT_EQ(read(std::make_unique<common::IsNull>()), expected);
+  ASSERT_TRUE(read(std::make_unique<common::IsNotNull>()).empty());
+}
+
 TEST_F(E2EFilterTest, metadataFilter) {
   testMetadataFilter();
 }
@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -944,6 +945,79 @@ TEST_F(E2EWriterTest, PartialStride) {
   ASSERT_EQ(true, reader->columnStatistics(1)->hasNull().value());
 }
 
+TEST_F(E2EWriterTest, parallelEncoding) {
+  auto type = ROW({
+      {"int_val", INTEGER()},
+      {"long_val", BIGINT()},
+      {"double_val", DOUBLE()},
+      {"string_val", VARCHAR()},
+      {"array_val", ARRAY(REAL())},
+      {"flatmap_val", MAP(INTEGER(), BIGINT())},
+      {"struct_val", ROW({{"a", REAL()}, {"b", VARCHAR()}})},
+  });
+  VectorFuzzer fuzzer(
+      {
+          .vectorSize = 1'000,
+          .nullRatio = 0.05,
+          .stringLength = 20,
+          .stringVariableLength = true,
+          .containerLength = 5,
+          .containerVariableLength = true,
+      },
+      leafPool_.get(),
+      /*seed=*/1234);
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < 10; ++i) {
+    batches.push_back(fuzzer.fuzzInputRow(type));
+  }
+
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::FLATTEN_MAP, true);
+  config->set(dwrf::Config::MAP_FLAT_COLS, {5});
+  config->set(dwrf::Config::ROW_INDEX_STRIDE, static_cast<uint32_t>(1'000));
+  config->set<uint64_t>(dwrf::Config::COMPRESSION_BLOCK_SIZE_MIN, 64UL);
+
+  auto write = [&](const std::shared_ptr<folly::Executor>& executor) {
+    auto sink = std::make_unique<MemorySink>(
+        10 * kSizeMB, dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.encodingExecutor = executor;
+    options.encodingParallelismFactor = 4;
+    dwrf::Writer writer{std::move(sink), options};
+    for (const auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  const auto expected = write(nullptr);
+  const auto parallel =
+      write(std::make_shared<folly::CPUThreadPoolExecutor>(4));
+  // The columns are encoded the same way on any thread.
+  ASSERT_EQ(expected, parallel);
+
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto reader = std::make_unique<dwrf::DwrfReader>(
+      readerOpts,
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(parallel), *leafPool_));
+  auto rowReader = reader->createRowReader(RowReaderOptions{});
+  VectorPtr result;
+  for (const auto& batch : batches) {
+    ASSERT_EQ(rowReader->next(batch->size(), result), batch->size());
+    for (vector_size_t i = 0; i < batch->size(); ++i) {
+      ASSERT_TRUE(result->equalValueAt(batch.get(), i, i))
+          << result->toString(i) << " vs " << batch->toString(i);
+    }
+  }
+  ASSERT_EQ(rowReader->next(1, result), 0);
+}
+
 TEST_F(E2EWriterTest, OversizeRows) {
   auto pool = facebook::velox::memory::memoryManager()->addLeafPool();
 
@@ -18,10 +18,12 @@
 #include <gtest/gtest.h>
 #include <velox/buffer/Buffer.h>
 #include "folly/Random.h"
+#include "folly/ScopeGuard.h"
 #include "folly/executors/CPUThreadPoolExecutor.h"
 #include "folly/lang/Assume.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/common/ExecutorBarrier.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/FileSink.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -1361,6 +1363,35 @@ TEST_F(TestReader, fileColumnNamesReadAsLowerCase) {
   EXPECT_EQ(type->childByName("bool_val"), col0);
 }
 
+TEST_F(TestReader, fileMetadataCache) {
+  FileMetadataCache cache(1 << 20);
+  FileMetadataCache::setInstance(&cache);
+  SCOPE_EXIT {
+    FileMetadataCache::setInstance(nullptr);
+  };
+  std::vector<uint64_t> numRows;
+  for (auto i = 0; i < 2; ++i) {
+    dwio::common::ReaderOptions readerOpts{pool()};
+    auto reader = DwrfReader::create(
+        createFileBufferedInput(getFMSmallFile(), readerOpts.getMemoryPool()),
+        readerOpts);
+    ASSERT_EQ(*reader->rowType(), *getFlatmapSchema());
+    auto rowReader = reader->createRowReader(RowReaderOptions{});
+    VectorPtr batch;
+    uint64_t rows = 0;
+    while (rowReader->next(100, batch)) {
+      rows += batch->size();
+    }
+    ASSERT_EQ(rows, reader->numberOfRows().value());
+    numRows.push_back(rows);
+  }
+  ASSERT_EQ(numRows[0], numRows[1]);
+  const auto stats = cache.stats();
+  ASSERT_EQ(stats.numEntries, 1);
+  ASSERT_EQ(stats.numLookups, 2);
+  ASSERT_EQ(stats.numHits, 1);
+}
+
 TEST_F(TestReader, fileColumnNamesReadAsLowerCaseComplexStruct) {
   // upper_complex.orc holds type
   // Cc:struct<CcLong0:bigint,CcMap1:map<string,struct<CcArray2:array<struct<CcInt3:int>>>>>
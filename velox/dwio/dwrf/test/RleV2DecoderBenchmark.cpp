@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+
+#include <unordered_map>
+
+#include "velox/common/memory/Memory.h"
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/dwrf/common/DecoderUtil.h"
+#include "velox/dwio/dwrf/test/RleV2TestEncoder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwrf;
+
+namespace {
+
+constexpr int32_t kNumValues = 1 << 20;
+constexpr int32_t kBatchSize = 1024;
+
+std::shared_ptr<memory::MemoryPool> pool;
+// Encoded streams of kNumValues values by bit width.
+std::unordered_map<uint32_t, std::vector<unsigned char>> directStreams;
+std::unordered_map<uint32_t, std::vector<unsigned char>> deltaStreams;
+
+uint64_t randomBits(uint32_t width) {
+  return folly::Random::rand64() &
+      (width == 64 ? ~0ULL : (1ULL << width) - 1);
+}
+
+void makeStreams(uint32_t width) {
+  std::vector<uint64_t> values(kNumValues);
+  for (auto& value : values) {
+    value = randomBits(width);
+  }
+  RleV2TestEncoder::appendDirect(values, width, directStreams[width]);
+
+  // Same range of deltas as the decodeDelta benchmarks.
+  if (width < 2 || width > 32) {
+    return;
+  }
+  auto& delta = deltaStreams[width];
+  std::vector<uint64_t> deltas(RleV2TestEncoder::kMaxRunLength - 2);
+  for (int32_t i = 0; i < kNumValues; i += RleV2TestEncoder::kMaxRunLength) {
+    for (auto& value : deltas) {
+      value = randomBits(width);
+    }
+    RleV2TestEncoder::appendDelta(i, 1, deltas, width, delta);
+  }
+}
+
+void decode(uint32_t iters, const std::vector<unsigned char>& stream) {
+  std::vector<int64_t> values(kBatchSize);
+  for (uint32_t iter = 0; iter < iters; ++iter) {
+    auto decoder = createRleDecoder<true>(
+        std::make_unique<dwio::common::SeekableArrayInputStream>(
+            stream.data(), stream.size()),
+        RleVersion_2,
+        *pool,
+        true,
+        dwio::common::LONG_BYTE_SIZE);
+    for (int32_t i = 0; i < kNumValues; i += kBatchSize) {
+      decoder->next(values.data(), kBatchSize, nullptr);
+      folly::doNotOptimizeAway(values);
+    }
+  }
+}
+
+void decodeDirect(uint32_t iters, uint32_t width) {
+  decode(iters, directStreams[width]);
+}
+
+void decodeDelta(uint32_t iters, uint32_t width) {
+  decode(iters, deltaStreams[width]);
+}
+
+} // namespace
+
+BENCHMARK_NAMED_PARAM(decodeDirect, 1_bit, 1);
+BENCHMARK_NAMED_PARAM(decodeDirect, 2_bits, 2);
+BENCHMARK_NAMED_PARAM(decodeDirect, 4_bits, 4);
+BENCHMARK_NAMED_PARAM(decodeDirect, 7_bits, 7);
+BENCHMARK_NAMED_PARAM(decodeDirect, 8_bits, 8);
+BENCHMARK_NAMED_PARAM(decodeDirect, 12_bits, 12);
+BENCHMARK_NAMED_PARAM(decodeDirect, 16_bits, 16);
+BENCHMARK_NAMED_PARAM(decodeDirect, 20_bits, 20);
+BENCHMARK_NAMED_PARAM(decodeDirect, 24_bits, 24);
+BENCHMARK_NAMED_PARAM(decodeDirect, 32_bits, 32);
+BENCHMARK_NAMED_PARAM(decodeDirect, 48_bits, 48);
+BENCHMARK_NAMED_PARAM(decodeDirect, 64_bits, 64);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(decodeDelta, 2_bits, 2);
+BENCHMARK_NAMED_PARAM(decodeDelta, 4_bits, 4);
+BENCHMARK_NAMED_PARAM(decodeDelta, 8_bits, 8);
+BENCHMARK_NAMED_PARAM(decodeDelta, 12_bits, 12);
+BENCHMARK_NAMED_PARAM(decodeDelta, 16_bits, 16);
+BENCHMARK_NAMED_PARAM(decodeDelta, 24_bits, 24);
+BENCHMARK_NAMED_PARAM(decodeDelta, 32_bits, 32);
+
+int32_t main(int32_t argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  pool = memory::memoryManager()->addLeafPool();
+  for (uint32_t width : {1, 2, 4, 7, 8, 12, 16, 20, 24, 32, 48, 64}) {
+    makeStreams(width);
+  }
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/encode/Coding.h"
+
+namespace facebook::velox::dwrf {
+
+/// Minimal RLEv2 encoder for tests and benchmarks of the decoder. Writes the
+/// DIRECT and DELTA sub-encodings with a given bit width, packing values
+/// most significant bit first like the ORC writers do.
+class RleV2TestEncoder {
+ public:
+  /// Maximum number of values in a run.
+  static constexpr int32_t kMaxRunLength = 512;
+
+  /// Appends 'values' as DIRECT runs of 'width' bits. 'values' are the
+  /// encoded values, i.e. zigzag encoded for signed streams, and must fit
+  /// in 'width' bits.
+  static void appendDirect(
+      const std::vector<uint64_t>& values,
+      uint32_t width,
+      std::vector<unsigned char>& out) {
+    for (size_t begin = 0; begin < values.size(); begin += kMaxRunLength) {
+      const auto end = std::min(values.size(), begin + kMaxRunLength);
+      appendHeader(1, width, end - begin, out);
+      pack(values.data() + begin, end - begin, width, out);
+    }
+  }
+
+  /// Appends a DELTA run of a signed stream that starts at 'firstValue',
+  /// then adds 'deltaBase' and then adds, or subtracts if 'deltaBase' is
+  /// negative, each of 'deltas' packed with 'width' bits. 'width' must be
+  /// at least 2 since 1 is not representable for DELTA.
+  static void appendDelta(
+      int64_t firstValue,
+      int64_t deltaBase,
+      const std::vector<uint64_t>& deltas,
+      uint32_t width,
+      std::vector<unsigned char>& out) {
+    VELOX_CHECK_GE(width, 2);
+    VELOX_CHECK_LE(deltas.size() + 2, kMaxRunLength);
+    appendHeader(3, width, deltas.size() + 2, out);
+    appendVarint(ZigZag::encode(firstValue), out);
+    appendVarint(ZigZag::encode(deltaBase), out);
+    pack(deltas.data(), deltas.size(), width, out);
+  }
+
+ private:
+  static uint32_t encodeWidth(uint32_t width) {
+    if (width <= 24) {
+      return width - 1;
+    }
+    switch (width) {
+      case 26:
+        return 24;
+      case 28:
+        return 25;
+      case 30:
+        return 26;
+      case 32:
+        return 27;
+      case 40:
+        return 28;
+      case 48:
+        return 29;
+      case 56:
+        return 30;
+      case 64:
+        return 31;
+      default:
+        VELOX_FAIL("Bit width {} is not encodable in RLEv2", width);
+    }
+  }
+
+  static void appendHeader(
+      uint32_t encoding,
+      uint32_t width,
+      size_t runLength,
+      std::vector<unsigned char>& out) {
+    VELOX_CHECK_GT(runLength, 0);
+    const auto length = runLength - 1;
+    out.push_back(
+        (encoding << 6) | (encodeWidth(width) << 1) | ((length >> 8) & 1));
+    out.push_back(length & 0xff);
+  }
+
+  static void appendVarint(uint64_t value, std::vector<unsigned char>& out) {
+    while (value >= 0x80) {
+      out.push_back(static_cast<unsigned char>(value | 0x80));
+      value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+  }
+
+  static void pack(
+      const uint64_t* values,
+      size_t numValues,
+      uint32_t width,
+      std::vector<unsigned char>& out) {
+    uint32_t numBits = 0;
+    uint32_t current = 0;
+    for (size_t i = 0; i < numValues; ++i) {
+      for (int32_t bit = width - 1; bit >= 0; --bit) {
+        current = (current << 1) | ((values[i] >> bit) & 1);
+        if (++numBits == 8) {
+          out.push_back(current);
+          numBits = 0;
+          current = 0;
+        }
+      }
+    }
+    if (numBits > 0) {
+      out.push_back(current << (8 - numBits));
+    }
+  }
+};
+
+} // namespace facebook::velox::dwrf
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/dwio/dwrf/reader/SharedStringDictionaryCache.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwrf;
+using dwio::common::DictionaryValues;
+
+namespace {
+
+class SharedStringDictionaryCacheTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void SetUp() override {
+    pool_ = memory::memoryManager()->addLeafPool();
+  }
+
+  // Returns a loader making a dictionary of 'numValues' strings of
+  // 'length' bytes. Counts its calls in 'numLoads_'.
+  std::function<DictionaryValues(memory::MemoryPool&)> loader(
+      int32_t numValues,
+      int32_t length) {
+    return [this, numValues, length](memory::MemoryPool& pool) {
+      ++numLoads_;
+      DictionaryValues values;
+      values.numValues = numValues;
+      values.values = AlignedBuffer::allocate<StringView>(numValues, &pool);
+      values.strings =
+          AlignedBuffer::allocate<char>(numValues * length, &pool, 'x');
+      auto* strings = values.strings->as<char>();
+      auto* views = values.values->asMutable<StringView>();
+      for (auto i = 0; i < numValues; ++i) {
+        views[i] = StringView(strings + i * length, length);
+      }
+      return values;
+    };
+  }
+
+  static SharedStringDictionaryCache::Key key(uint32_t node) {
+    return {1, 3, node, 0};
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_;
+  int32_t numLoads_{0};
+};
+
+TEST_F(SharedStringDictionaryCacheTest, hitAndMiss) {
+  SharedStringDictionaryCache cache(1 << 20, pool_);
+  ASSERT_FALSE(cache.find(key(1)).has_value());
+
+  auto first = cache.getOrLoad(key(1), loader(100, 20));
+  ASSERT_EQ(numLoads_, 1);
+  ASSERT_EQ(first.numValues, 100);
+  ASSERT_GT(pool_->currentBytes(), 0);
+
+  // The cached buffers are shared, not copied.
+  auto second = cache.getOrLoad(key(1), loader(100, 20));
+  ASSERT_EQ(numLoads_, 1);
+  ASSERT_EQ(second.values.get(), first.values.get());
+  ASSERT_EQ(second.strings.get(), first.strings.get());
+  ASSERT_EQ(cache.find(key(1))->values.get(), first.values.get());
+
+  // Other keys miss.
+  ASSERT_FALSE(cache.find({2, 3, 1, 0}).has_value());
+  ASSERT_FALSE(cache.find({1, 4, 1, 0}).has_value());
+  ASSERT_FALSE(cache.find({1, 3, 1, 1}).has_value());
+
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.numHits, 2);
+  ASSERT_EQ(stats.numMisses, 1);
+  ASSERT_EQ(stats.numEntries, 1);
+  ASSERT_GT(stats.bytes, 100 * 20);
+}
+
+TEST_F(SharedStringDictionaryCacheTest, evict) {
+  const auto bytes = [&]() {
+    SharedStringDictionaryCache probe(1 << 20, pool_);
+    probe.getOrLoad(key(0), loader(100, 100));
+    return probe.stats().bytes;
+  }();
+  numLoads_ = 0;
+  SharedStringDictionaryCache cache(bytes * 2, pool_);
+  cache.getOrLoad(key(1), loader(100, 100));
+  cache.getOrLoad(key(2), loader(100, 100));
+  // Makes 1 the most recently used.
+  ASSERT_TRUE(cache.find(key(1)).has_value());
+  cache.getOrLoad(key(3), loader(100, 100));
+
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.numEntries, 2);
+  ASSERT_EQ(stats.numEvictions, 1);
+  ASSERT_LE(stats.bytes, bytes * 2);
+  ASSERT_TRUE(cache.find(key(1)).has_value());
+  ASSERT_FALSE(cache.find(key(2)).has_value());
+  ASSERT_TRUE(cache.find(key(3)).has_value());
+  ASSERT_EQ(numLoads_, 3);
+}
+
+TEST_F(SharedStringDictionaryCacheTest, oversize) {
+  SharedStringDictionaryCache cache(1'000, pool_);
+  auto values = cache.getOrLoad(key(1), loader(1'000, 10));
+  ASSERT_EQ(values.numValues, 1'000);
+  ASSERT_EQ(cache.stats().numEntries, 0);
+  ASSERT_EQ(cache.stats().bytes, 0);
+  cache.getOrLoad(key(1), loader(1'000, 10));
+  ASSERT_EQ(numLoads_, 2);
+}
+
+TEST_F(SharedStringDictionaryCacheTest, clear) {
+  SharedStringDictionaryCache cache(1 << 20, pool_);
+  auto values = cache.getOrLoad(key(1), loader(100, 20));
+  cache.clear();
+  ASSERT_EQ(cache.stats().numEntries, 0);
+  ASSERT_EQ(cache.stats().bytes, 0);
+  ASSERT_FALSE(cache.find(key(1)).has_value());
+  // Readers keep the dictionaries they reference.
+  ASSERT_EQ(values.values->as<StringView>()[99].size(), 20);
+  values = {};
+  ASSERT_EQ(pool_->currentBytes(), 0);
+}
+
+TEST_F(SharedStringDictionaryCacheTest, instance) {
+  ASSERT_EQ(SharedStringDictionaryCache::getInstance(), nullptr);
+  SharedStringDictionaryCache cache(1 << 20, pool_);
+  SharedStringDictionaryCache::setInstance(&cache);
+  ASSERT_EQ(SharedStringDictionaryCache::getInstance(), &cache);
+  SharedStringDictionaryCache::setInstance(nullptr);
+  ASSERT_EQ(SharedStringDictionaryCache::getInstance(), nullptr);
+}
+
+} // namespace
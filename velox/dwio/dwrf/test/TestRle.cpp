@@ -21,6 +21,9 @@
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/dwrf/common/DecoderUtil.h"
 #include "velox/dwio/dwrf/test/OrcTest.h"
+#include "velox/dwio/dwrf/test/RleV2TestEncoder.h"
+
+#include <folly/Random.h>
 
 using namespace facebook::velox;
 using namespace facebook::velox::dwrf;
@@ -30,10 +33,12 @@ std::vector<int64_t> decodeRLEv2(
     unsigned long l,
     size_t n,
     size_t count,
-    const uint64_t* nulls = nullptr) {
+    const uint64_t* nulls = nullptr,
+    uint64_t blockSize = 0) {
   auto pool = memory::memoryManager()->addLeafPool();
   std::unique_ptr<dwio::common::IntDecoder<true>> rle = createRleDecoder<true>(
-      std::make_unique<dwio::common::SeekableArrayInputStream>(bytes, l),
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          bytes, l, blockSize),
       RleVersion_2,
       *pool,
       true /* doesn't matter */,
@@ -673,6 +678,93 @@ TEST_F(RLEv2Test, bitsLeftByPreviousStream) {
   }
 };
 
+// Bit widths that RLEv2 can encode.
+const std::vector<uint32_t> kRleV2Widths = {
+    1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 16,
+    17, 18, 19, 20, 21, 22, 23, 24, 26, 28, 30, 32, 40, 48, 56, 64};
+
+// Checks decoding 'bytes' into 'values' in batches of several sizes, with
+// and without nulls, and with the input split into buffers of several
+// sizes so that runs cross buffer boundaries.
+void checkAllBatchSizes(
+    const std::vector<unsigned char>& bytes,
+    const std::vector<int64_t>& values) {
+  const auto count = values.size();
+  for (uint64_t blockSize : {0, 37, 1000}) {
+    for (size_t n : {1, 7, 100, 513}) {
+      checkResults(
+          values,
+          decodeRLEv2(bytes.data(), bytes.size(), n, count, nullptr, blockSize),
+          n);
+    }
+  }
+
+  // Every fifth row is null. The non-null rows take the values in order.
+  const auto numRows = count + count / 4;
+  std::vector<uint64_t> nulls(bits::nwords(numRows), bits::kNotNull64);
+  std::vector<int64_t> expected(numRows);
+  size_t valueIndex = 0;
+  for (size_t row = 0; row < numRows; ++row) {
+    if (row % 5 == 4 || valueIndex == count) {
+      bits::setNull(nulls.data(), row);
+    } else {
+      expected[row] = values[valueIndex++];
+    }
+  }
+  for (size_t n : {7, 513}) {
+    checkResults(
+        expected,
+        decodeRLEv2(bytes.data(), bytes.size(), n, numRows, nulls.data()),
+        n,
+        nulls.data());
+  }
+}
+
+TEST_F(RLEv2Test, directAllWidths) {
+  for (auto width : kRleV2Widths) {
+    SCOPED_TRACE("width " + std::to_string(width));
+    const uint64_t mask = width == 64 ? ~0ULL : (1ULL << width) - 1;
+    std::vector<uint64_t> encoded;
+    std::vector<int64_t> values;
+    for (int32_t i = 0; i < 1'200; ++i) {
+      encoded.push_back(folly::Random::rand64() & mask);
+      values.push_back(zigZagDecode(encoded.back()));
+    }
+    std::vector<unsigned char> bytes;
+    RleV2TestEncoder::appendDirect(encoded, width, bytes);
+    checkAllBatchSizes(bytes, values);
+  }
+}
+
+TEST_F(RLEv2Test, deltaAllWidths) {
+  for (auto width : kRleV2Widths) {
+    // 1 bit deltas are not representable and wide ones would overflow.
+    if (width < 2 || width > 32) {
+      continue;
+    }
+    SCOPED_TRACE("width " + std::to_string(width));
+    const uint64_t mask = (1ULL << width) - 1;
+    std::vector<unsigned char> bytes;
+    std::vector<int64_t> values;
+    // An increasing run and a decreasing one.
+    for (int64_t deltaBase : {5, -5}) {
+      std::vector<uint64_t> deltas;
+      int64_t value = 1'000;
+      values.push_back(value);
+      value += deltaBase;
+      values.push_back(value);
+      for (int32_t i = 0; i < RleV2TestEncoder::kMaxRunLength - 2; ++i) {
+        deltas.push_back(folly::Random::rand64() & mask);
+        value += deltaBase < 0 ? -static_cast<int64_t>(deltas.back())
+                               : static_cast<int64_t>(deltas.back());
+        values.push_back(value);
+      }
+      RleV2TestEncoder::appendDelta(1'000, deltaBase, deltas, width, bytes);
+    }
+    checkAllBatchSizes(bytes, values);
+  }
+}
+
 class RLEv1Test : public testing::Test {
  protected:
   static void SetUpTestCase() {
@@ -106,6 +106,47 @@ TEST_F(TestStatisticsBuilderUtils, addIntegerValues) {
   }
 }
 
+TEST_F(TestStatisticsBuilderUtils, addIntegerBatch) {
+  auto expectSame = [](const auto& values) {
+    IntegerStatisticsBuilder batch{options};
+    IntegerStatisticsBuilder single{options};
+    batch.addBatch(values.data(), values.size());
+    for (auto value : values) {
+      single.addValues(value);
+    }
+    auto batchStats = batch.build();
+    auto singleStats = single.build();
+    auto* batchInt = dynamic_cast<IntegerColumnStatistics*>(batchStats.get());
+    auto* singleInt =
+        dynamic_cast<IntegerColumnStatistics*>(singleStats.get());
+    EXPECT_EQ(batchInt->getNumberOfValues(), singleInt->getNumberOfValues());
+    EXPECT_EQ(batchInt->getMinimum(), singleInt->getMinimum());
+    EXPECT_EQ(batchInt->getMaximum(), singleInt->getMaximum());
+    EXPECT_EQ(batchInt->getSum(), singleInt->getSum());
+  };
+
+  std::vector<int32_t> ints;
+  for (int32_t i = 0; i < 1'000; ++i) {
+    ints.push_back(i % 2 ? -i * 1'000'003 : i * 7);
+  }
+  expectSame(ints);
+
+  std::vector<int64_t> longs{1, std::numeric_limits<int64_t>::max(), -5};
+  expectSame(longs);
+  {
+    // The sum overflows in between and is not set.
+    IntegerStatisticsBuilder builder{options};
+    builder.addBatch(longs.data(), longs.size());
+    auto stats = builder.build();
+    auto intStats = dynamic_cast<IntegerColumnStatistics*>(stats.get());
+    EXPECT_FALSE(intStats->getSum().has_value());
+    EXPECT_EQ(-5, intStats->getMinimum().value());
+  }
+
+  std::vector<int16_t> shorts{-3, 4, 9};
+  expectSame(shorts);
+}
+
 TEST_F(TestStatisticsBuilderUtils, addDoubleValues) {
   DoubleStatisticsBuilder builder{options};
 
@@ -18,6 +18,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "folly/Random.h"
+#include "folly/executors/CPUThreadPoolExecutor.h"
+#include "folly/synchronization/Baton.h"
 #include "velox/common/base/tests/GTestUtils.h"
 
 using namespace ::testing;
@@ -25,6 +27,34 @@ using namespace facebook::velox::dwio::common;
 using namespace facebook::velox::dwrf;
 using namespace facebook::velox::memory;
 
+namespace {
+// Appends to a string once 'unblock' is posted, or fails if 'fail' is set.
+class BlockingWriteFile : public facebook::velox::WriteFile {
+ public:
+  explicit BlockingWriteFile(std::string* file) : file_{file} {}
+
+  void append(std::string_view data) override {
+    unblock.wait();
+    VELOX_CHECK(!fail, "Append failed");
+    file_.append(data);
+  }
+
+  void flush() override {}
+
+  void close() override {}
+
+  uint64_t size() const override {
+    return file_.size();
+  }
+
+  folly::Baton<> unblock;
+  bool fail{false};
+
+ private:
+  facebook::velox::InMemoryWriteFile file_;
+};
+} // namespace
+
 class WriterSinkTest : public Test {
  protected:
   static void SetUpTestCase() {
@@ -511,3 +541,44 @@ TEST_F(WriterSinkTest, SetModeOutOfOrder) {
   sink.addBuffer(*pool, data.data(), 10);
   ASSERT_EQ(sink.getChecksum()->getDigest(false), 977966233);
 }
+
+TEST_F(WriterSinkTest, asyncUpload) {
+  auto pool = memoryManager()->addLeafPool();
+  std::string file;
+  auto writeFile = std::make_unique<BlockingWriteFile>(&file);
+  auto* writeFilePtr = writeFile.get();
+  WriteFileSink out{std::move(writeFile), "test"};
+  Config config;
+  config.set(Config::CHECKSUM_ALGORITHM, proto::ChecksumAlgorithm::NULL_);
+  config.set(Config::STRIPE_CACHE_MODE, StripeCacheMode::NA);
+  folly::CPUThreadPoolExecutor executor(1);
+  WriterSink sink{out, *pool, config};
+  sink.setUploadExecutor(&executor);
+  sink.init(*pool);
+
+  sink.setMode(WriterSink::Mode::Data);
+  sink.addBuffer(*pool, data.data(), data.size());
+  // The upload blocks on the append but flush() returns.
+  sink.flush();
+  ASSERT_EQ(sink.size(), ORC_MAGIC_LEN + data.size());
+  sink.addBuffer(*pool, data.data(), data.size());
+  ASSERT_EQ(sink.size(), ORC_MAGIC_LEN + 2 * data.size());
+  ASSERT_TRUE(file.empty());
+
+  writeFilePtr->unblock.post();
+  sink.flush();
+  sink.waitForUpload();
+  ASSERT_EQ(out.size(), ORC_MAGIC_LEN + 2 * data.size());
+  ASSERT_EQ(sink.size(), out.size());
+  const std::string expected(data.data(), data.size());
+  ASSERT_EQ(file.substr(ORC_MAGIC_LEN), expected + expected);
+
+  // The error of an upload is thrown by the next flush.
+  writeFilePtr->fail = true;
+  sink.addBuffer(*pool, data.data(), data.size());
+  sink.flush();
+  sink.addBuffer(*pool, data.data(), data.size());
+  VELOX_ASSERT_THROW(sink.flush(), "Append failed");
+  sink.flush();
+  VELOX_ASSERT_THROW(sink.waitForUpload(), "Append failed");
+}
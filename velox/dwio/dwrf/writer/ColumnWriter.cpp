@@ -16,7 +16,9 @@
 
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
 #include <velox/dwio/common/exception/Exception.h>
+#include <optional>
 #include "velox/dwio/common/ChainedBuffer.h"
+#include "velox/dwio/common/ParallelFor.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
@@ -35,7 +37,12 @@ namespace facebook::velox::dwrf {
 WriterContext::LocalDecodedVector BaseColumnWriter::decode(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
-  auto& selected = context_.getSharedSelectivityVector(slice->size());
+  // The shared vector can not be used by column writers that write
+  // concurrently.
+  std::optional<SelectivityVector> localSelected;
+  auto& selected = context_.parallelEncoding()
+      ? localSelected.emplace(slice->size())
+      : context_.getSharedSelectivityVector(slice->size());
   // initialize
   selected.clearAll();
   for (auto& range : ranges.getRanges()) {
@@ -508,10 +515,30 @@ uint64_t IntegerColumnWriter<T>::writeDict(
   writeNulls(decodedVector, ranges);
   // make sure we have enough space
   rows_.reserve(rows_.size() + ranges.size());
+  // Runs of equal values, common in sorted, clustered and constant columns,
+  // are added to the dictionary and the statistics with one lookup.
+  T runValue{};
+  uint32_t runLength = 0;
+  auto flushRun = [&]() {
+    if (runLength == 0) {
+      return;
+    }
+    const auto index = dictEncoder_.addKey(runValue, runLength);
+    for (uint32_t i = 0; i < runLength; ++i) {
+      rows_.unsafeAppend(index);
+    }
+    statsBuilder.addValues(runValue, runLength);
+    runLength = 0;
+  };
   auto processRow = [&](vector_size_t pos) {
     T value = decodedVector.valueAt<T>(pos);
-    rows_.unsafeAppend(dictEncoder_.addKey(value));
-    statsBuilder.addValues(value);
+    if (runLength > 0 && value == runValue) {
+      ++runLength;
+      return;
+    }
+    flushRun();
+    runValue = value;
+    runLength = 1;
   };
 
   uint64_t nullCount = 0;
@@ -528,6 +555,7 @@ uint64_t IntegerColumnWriter<T>::writeDict(
       processRow(pos);
     }
   }
+  flushRun();
 
   uint64_t rawSize = (ranges.size() - nullCount) * sizeof(T);
   if (nullCount > 0) {
@@ -1113,11 +1141,40 @@ uint64_t StringColumnWriter::writeDict(
   rows_.reserve(rows_.size() + ranges.size());
   size_t strideIndex = strideOffsets_.size() - 1;
   uint64_t rawSize = 0;
+  // Runs of equal values are hashed and added to the statistics once. Rows
+  // with the same index into the base of a dictionary or constant vector are
+  // equal without comparing the strings.
+  StringView runValue;
+  vector_size_t runBaseIndex = -1;
+  uint32_t runLength = 0;
+  auto flushRun = [&]() {
+    if (runLength == 0) {
+      return;
+    }
+    const auto index = dictEncoder_.addKey(runValue, strideIndex, runLength);
+    for (uint32_t i = 0; i < runLength; ++i) {
+      rows_.unsafeAppend(index);
+    }
+    statsBuilder.addValues(runValue, runLength);
+    rawSize += runValue.size() * runLength;
+    runLength = 0;
+  };
   auto processRow = [&](size_t pos) {
+    const auto baseIndex = decodedVector.index(pos);
+    if (runLength > 0 && baseIndex == runBaseIndex) {
+      ++runLength;
+      return;
+    }
     auto sp = decodedVector.valueAt<StringView>(pos);
-    rows_.unsafeAppend(dictEncoder_.addKey(sp, strideIndex));
-    statsBuilder.addValues(sp);
-    rawSize += sp.size();
+    if (runLength > 0 && sp == runValue) {
+      runBaseIndex = baseIndex;
+      ++runLength;
+      return;
+    }
+    flushRun();
+    runValue = sp;
+    runBaseIndex = baseIndex;
+    runLength = 1;
   };
 
   uint64_t nullCount = 0;
@@ -1134,6 +1191,7 @@ uint64_t StringColumnWriter::writeDict(
       processRow(pos);
     }
   }
+  flushRun();
 
   if (nullCount > 0) {
     statsBuilder.setHasNull();
@@ -1623,6 +1681,12 @@ class StructColumnWriter : public BaseColumnWriter {
       const RowVector* rowSlice,
       const common::Ranges& ranges,
       uint64_t nullCount);
+
+  // Writes the children of the root on the encoding executor of the context.
+  // Children that do not support it are written on the calling thread.
+  uint64_t writeChildrenInParallel(
+      const RowVector* rowSlice,
+      const common::Ranges& ranges);
 };
 
 uint64_t StructColumnWriter::writeChildrenAndStats(
@@ -1631,8 +1695,12 @@ uint64_t StructColumnWriter::writeChildrenAndStats(
     uint64_t nullCount) {
   uint64_t rawSize = 0;
   if (ranges.size() > 0) {
-    for (size_t i = 0; i < children_.size(); ++i) {
-      rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+    if (isRoot() && context_.parallelEncoding()) {
+      rawSize = writeChildrenInParallel(rowSlice, ranges);
+    } else {
+      for (size_t i = 0; i < children_.size(); ++i) {
+        rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+      }
     }
   }
   if (nullCount) {
@@ -1644,6 +1712,39 @@ uint64_t StructColumnWriter::writeChildrenAndStats(
   return rawSize;
 }
 
+uint64_t StructColumnWriter::writeChildrenInParallel(
+    const RowVector* rowSlice,
+    const common::Ranges& ranges) {
+  std::vector<size_t> parallelChildren;
+  std::vector<size_t> serialChildren;
+  for (size_t i = 0; i < children_.size(); ++i) {
+    if (children_[i]->supportsParallelWrite()) {
+      parallelChildren.push_back(i);
+    } else {
+      serialChildren.push_back(i);
+    }
+  }
+  std::vector<uint64_t> rawSizes(children_.size());
+  dwio::common::ParallelFor(
+      context_.encodingExecutor(),
+      0,
+      parallelChildren.size(),
+      context_.encodingParallelismFactor())
+      .execute([&](size_t i) {
+        const auto child = parallelChildren[i];
+        rawSizes[child] =
+            children_[child]->write(rowSlice->childAt(child), ranges);
+      });
+  for (auto child : serialChildren) {
+    rawSizes[child] = children_[child]->write(rowSlice->childAt(child), ranges);
+  }
+  uint64_t rawSize = 0;
+  for (auto size : rawSizes) {
+    rawSize += size;
+  }
+  return rawSize;
+}
+
 uint64_t StructColumnWriter::write(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
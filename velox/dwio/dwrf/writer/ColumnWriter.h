@@ -54,6 +54,13 @@ class ColumnWriter {
 
   virtual bool tryAbandonDictionaries(bool force) = 0;
 
+  /// Returns true if write() may run concurrently with write() of other
+  /// columns. Such writers do not change the state of the context shared with
+  /// other columns.
+  virtual bool supportsParallelWrite() const {
+    return true;
+  }
+
  protected:
   ColumnWriter(
       WriterContext& context,
@@ -276,6 +276,11 @@ class FlatMapColumnWriter : public BaseColumnWriter {
   uint64_t writeFileStats(std::function<proto::ColumnStatistics&(uint32_t)>
                               statsFactory) const override;
 
+  // Creates streams for new keys while writing.
+  bool supportsParallelWrite() const override {
+    return false;
+  }
+
  private:
   using KeyType = typename TypeTraits<K>::NativeType;
 
@@ -231,6 +231,49 @@ class IntegerStatisticsBuilder : public StatisticsBuilder,
     addWithOverflowCheck(sum_, value, count);
   }
 
+  /// Adds 'numValues' non-null 'values'. Same as adding them one by one, but
+  /// min, max and sum are computed in loops that the compiler vectorizes.
+  template <typename T>
+  void addBatch(const T* values, size_t numValues) {
+    static_assert(std::is_integral_v<T> && std::is_signed_v<T>);
+    if (numValues == 0) {
+      return;
+    }
+    increaseValueCount(numValues);
+    T batchMin = values[0];
+    T batchMax = values[0];
+    for (size_t i = 1; i < numValues; ++i) {
+      batchMin = std::min(batchMin, values[i]);
+      batchMax = std::max(batchMax, values[i]);
+    }
+    if (min_.has_value() && batchMin < min_.value()) {
+      min_ = batchMin;
+    }
+    if (max_.has_value() && batchMax > max_.value()) {
+      max_ = batchMax;
+    }
+    if (!sum_.has_value()) {
+      return;
+    }
+    if constexpr (sizeof(T) < sizeof(int64_t)) {
+      // No partial sum of less than 2^31 values of at most 32 bits can
+      // overflow when the sum before them is at most 2^62.
+      constexpr int64_t kMaxSafeSum = int64_t{1} << 62;
+      if (numValues < (size_t{1} << 31) && sum_.value() <= kMaxSafeSum &&
+          sum_.value() >= -kMaxSafeSum) {
+        int64_t batchSum = 0;
+        for (size_t i = 0; i < numValues; ++i) {
+          batchSum += values[i];
+        }
+        sum_ = sum_.value() + batchSum;
+        return;
+      }
+    }
+    for (size_t i = 0; i < numValues && sum_.has_value(); ++i) {
+      addWithOverflowCheck<int64_t>(sum_, values[i], 1);
+    }
+  }
+
   void merge(
       const dwio::common::ColumnStatistics& other,
       bool ignoreSize = false) override;
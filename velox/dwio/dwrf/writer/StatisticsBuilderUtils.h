@@ -76,18 +76,19 @@ void StatisticsBuilderUtils::addValues(
     const common::Ranges& ranges) {
   auto nulls = vector->rawNulls();
   auto vals = vector->asFlatVector<INT>()->rawValues();
-  if (vector->mayHaveNulls()) {
-    for (auto& pos : ranges) {
+  // Ranges without nulls are added in batches.
+  for (const auto& [begin, end] : ranges.getRanges()) {
+    if (!vector->mayHaveNulls() || bits::isAllSet(nulls, begin, end)) {
+      builder.addBatch(vals + begin, end - begin);
+      continue;
+    }
+    for (auto pos = begin; pos < end; ++pos) {
       if (bits::isBitNull(nulls, pos)) {
         builder.setHasNull();
       } else {
         builder.addValues(vals[pos]);
       }
     }
-  } else {
-    for (auto& pos : ranges) {
-      builder.addValues(vals[pos]);
-    }
   }
 }
 
@@ -104,6 +105,10 @@ void StatisticsBuilderUtils::addValues(
         builder.addValues(vector.valueAt<INT>(pos));
       }
     }
+  } else if (vector.isIdentityMapping()) {
+    for (const auto& [begin, end] : ranges.getRanges()) {
+      builder.addBatch(vector.data<INT>() + begin, end - begin);
+    }
   } else {
     for (auto& pos : ranges) {
       builder.addValues(vector.valueAt<INT>(pos));
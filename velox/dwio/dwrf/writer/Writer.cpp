@@ -73,9 +73,15 @@ Writer::Writer(
                                     *options.encryptionSpec,
                                     options.encrypterFactory.get())
                               : nullptr);
+  const bool encrypted = handler != nullptr;
   writerBase_->initContext(options.config, pool, std::move(handler));
 
   auto& context = writerBase_->getContext();
+  if (!encrypted) {
+    context.setEncodingExecutor(
+        options.encodingExecutor, options.encodingParallelismFactor);
+  }
+  writerBase_->getSink().setUploadExecutor(options.uploadExecutor);
   VELOX_CHECK_EQ(
       context.getTotalMemoryUsage(),
       0,
@@ -762,6 +768,8 @@ uint64_t Writer::MemoryReclaimer::reclaim(
   auto reclaimBytes = memory::MemoryReclaimer::run(
       [&]() {
         writer_->flushInternal(false);
+        // Frees the buffers of the stripe being uploaded.
+        writer_->writerBase_->getSink().waitForUpload();
         return pool->shrink(targetBytes);
       },
       stats);
@@ -792,6 +800,9 @@ dwrf::WriterOptions getDwrfOptions(const dwio::common::WriterOptions& options) {
   dwrfOptions.memoryPool = options.memoryPool;
   dwrfOptions.spillConfig = options.spillConfig;
   dwrfOptions.nonReclaimableSection = options.nonReclaimableSection;
+  dwrfOptions.encodingExecutor = options.encodingExecutor;
+  dwrfOptions.encodingParallelismFactor = options.encodingParallelismFactor;
+  dwrfOptions.uploadExecutor = options.uploadExecutor;
   return dwrfOptions;
 }
 
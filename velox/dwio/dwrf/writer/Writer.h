@@ -51,6 +51,14 @@ struct WriterOptions {
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
       columnWriterFactory;
+  /// If set with 'encodingParallelismFactor' > 1, the columns are encoded
+  /// and compressed in parallel on this executor. Flat map columns and
+  /// encrypted files are encoded on the thread calling write().
+  std::shared_ptr<folly::Executor> encodingExecutor;
+  size_t encodingParallelismFactor{0};
+  /// If set, a flushed stripe is written to the sink on this executor while
+  /// the next stripe is encoded. Must outlive the writer.
+  folly::Executor* uploadExecutor{nullptr};
 };
 
 class Writer : public dwio::common::Writer {
@@ -91,10 +91,11 @@ void WriterContext::validateConfigs() const {
 }
 
 void WriterContext::initBuffer() {
-  VELOX_CHECK_NULL(compressionBuffer_);
+  VELOX_CHECK(compressionBuffers_.empty());
   if (compression_ != common::CompressionKind_NONE) {
-    compressionBuffer_ = std::make_unique<dwio::common::DataBuffer<char>>(
-        *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+    compressionBuffers_.push_back(
+        std::make_unique<dwio::common::DataBuffer<char>>(
+            *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE));
   }
 }
 
@@ -145,7 +146,7 @@ void WriterContext::releaseMemoryReservation() {
 }
 
 void WriterContext::abort() {
-  compressionBuffer_.reset();
+  compressionBuffers_.clear();
   physicalSizeAggregators_.clear();
   streams_.clear();
   dictEncoders_.clear();
@@ -17,6 +17,9 @@
 #pragma once
 
 #include <limits>
+#include <mutex>
+
+#include <folly/Executor.h>
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -247,18 +250,55 @@ class WriterContext : public CompressionBufferPool {
 
   void initBuffer();
 
+  /// Returns a compression buffer of at least 'size' bytes. Streams of
+  /// columns encoded in parallel compress concurrently, so a buffer is
+  /// allocated if none is free.
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
       uint64_t size) override {
-    VELOX_CHECK_NOT_NULL(compressionBuffer_);
-    VELOX_CHECK_GE(compressionBuffer_->size(), size);
-    return std::move(compressionBuffer_);
+    std::unique_ptr<dwio::common::DataBuffer<char>> buffer;
+    {
+      std::lock_guard<std::mutex> l(compressionBufferMutex_);
+      if (!compressionBuffers_.empty()) {
+        buffer = std::move(compressionBuffers_.back());
+        compressionBuffers_.pop_back();
+      }
+    }
+    if (buffer == nullptr) {
+      buffer = std::make_unique<dwio::common::DataBuffer<char>>(
+          *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+    }
+    VELOX_CHECK_GE(buffer->size(), size);
+    return buffer;
   }
 
   void returnBuffer(
       std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
     VELOX_CHECK_NOT_NULL(buffer);
-    VELOX_CHECK_NULL(compressionBuffer_);
-    compressionBuffer_ = std::move(buffer);
+    std::lock_guard<std::mutex> l(compressionBufferMutex_);
+    compressionBuffers_.push_back(std::move(buffer));
+  }
+
+  /// Sets the executor on which the column writers of the root encode and
+  /// compress in parallel. 'parallelismFactor' of 0 or 1, or a null
+  /// 'executor', keeps encoding on the calling thread.
+  void setEncodingExecutor(
+      std::shared_ptr<folly::Executor> executor,
+      size_t parallelismFactor) {
+    encodingExecutor_ = std::move(executor);
+    encodingParallelismFactor_ = parallelismFactor;
+  }
+
+  const std::shared_ptr<folly::Executor>& encodingExecutor() const {
+    return encodingExecutor_;
+  }
+
+  size_t encodingParallelismFactor() const {
+    return encodingParallelismFactor_;
+  }
+
+  /// True if column writers may write concurrently.
+  bool parallelEncoding() const {
+    return encodingExecutor_ != nullptr && encodingParallelismFactor_ > 1;
   }
 
   void incrementNodeSize(uint32_t node, uint64_t size) {
@@ -583,13 +623,16 @@ class WriterContext : public CompressionBufferPool {
   void abort();
 
   dwio::common::DataBuffer<char>* testingCompressionBuffer() const {
-    return compressionBuffer_.get();
+    std::lock_guard<std::mutex> l(compressionBufferMutex_);
+    return compressionBuffers_.empty() ? nullptr
+                                       : compressionBuffers_.front().get();
   }
 
  private:
   void validateConfigs() const;
 
   std::unique_ptr<velox::DecodedVector> getDecodedVector() {
+    std::lock_guard<std::mutex> l(decodedVectorMutex_);
     if (decodedVectorPool_.empty()) {
       return std::make_unique<velox::DecodedVector>();
     }
@@ -599,6 +642,7 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void releaseDecodedVector(std::unique_ptr<velox::DecodedVector>&& vector) {
+    std::lock_guard<std::mutex> l(decodedVectorMutex_);
     decodedVectorPool_.push_back(std::move(vector));
   }
 
@@ -637,12 +681,20 @@ class WriterContext : public CompressionBufferPool {
   std::function<std::unique_ptr<IndexBuilder>(
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
-  std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  // Free compression buffers. There is one per stream compressing at the
+  // same time.
+  mutable std::mutex compressionBufferMutex_;
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>>
+      compressionBuffers_;
   // A pool of reusable DecodedVectors.
+  std::mutex decodedVectorMutex_;
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
-  // Reusable SelectivityVector
+  // Reusable SelectivityVector. Not used when encoding in parallel.
   std::unique_ptr<velox::SelectivityVector> selectivityVector_;
 
+  std::shared_ptr<folly::Executor> encodingExecutor_;
+  size_t encodingParallelismFactor_{0};
+
   std::unique_ptr<encryption::EncryptionHandler> handler_;
   folly::F14FastMap<uint32_t, uint64_t> nodeSize_;
   CompressionRatioTracker compressionRatioTracker_;
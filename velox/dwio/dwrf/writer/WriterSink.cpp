@@ -59,6 +59,32 @@ void WriterSink::addBuffer(dwio::common::DataBuffer<char> buffer) {
   }
 }
 
+void WriterSink::flush() {
+  waitForUpload();
+  if (uploadExecutor_ == nullptr || buffers_.empty()) {
+    sink_->write(buffers_);
+    buffers_.clear();
+    size_ = 0;
+    return;
+  }
+  uploadedSize_ += size_;
+  size_ = 0;
+  upload_ = folly::via(
+      uploadExecutor_, [this, buffers = std::move(buffers_)]() mutable {
+        sink_->write(buffers);
+      });
+  buffers_.clear();
+}
+
+void WriterSink::waitForUpload() {
+  if (!upload_.has_value()) {
+    return;
+  }
+  auto upload = std::move(upload_.value());
+  upload_.reset();
+  std::move(upload).get();
+}
+
 void WriterSink::init(memory::MemoryPool& pool) {
   VELOX_CHECK(!initialized_);
   VELOX_CHECK(offsets_.empty());
@@ -17,6 +17,8 @@
 #pragma once
 
 #include <folly/container/Array.h>
+#include <folly/futures/Future.h>
+#include <optional>
 
 #include "velox/dwio/common/DataBufferHolder.h"
 #include "velox/dwio/dwrf/common/Checksum.h"
@@ -53,6 +55,13 @@ class WriterSink {
         exceedsLimit_{false} {}
 
   ~WriterSink() {
+    if (upload_.has_value()) {
+      try {
+        waitForUpload();
+      } catch (const std::exception& e) {
+        LOG(WARNING) << "Failed upload in writer sink: " << e.what();
+      }
+    }
     if (!buffers_.empty() || size_ != 0) {
       LOG(WARNING) << "Unflushed data in writer sink: " << succinctBytes(size_)
                    << ", " << buffers_.size() << " buffers";
@@ -60,9 +69,28 @@ class WriterSink {
   }
 
   uint64_t size() const {
-    return sink_->size() + size_;
+    // The size of the sink changes while an upload runs.
+    return (uploadExecutor_ != nullptr ? uploadedSize_ : sink_->size()) +
+        size_;
+  }
+
+  /// Makes flush() hand the buffered data to 'executor' to write to the sink
+  /// in the background. The next flush() waits for it, so that the data of
+  /// one stripe is written while the next stripe is encoded. The buffers of
+  /// the upload stay allocated from the writer's pool until it completes.
+  /// Has no effect if the sink buffers writes itself. Must be called before
+  /// anything is written.
+  void setUploadExecutor(folly::Executor* executor) {
+    VELOX_CHECK(!initialized_);
+    if (shouldBuffer_) {
+      uploadExecutor_ = executor;
+      uploadedSize_ = sink_->size();
+    }
   }
 
+  /// Waits for the background upload, if any, and rethrows its error.
+  void waitForUpload();
+
   void init(memory::MemoryPool& pool);
 
   void addBuffer(memory::MemoryPool& pool, const char* data, size_t size) {
@@ -81,11 +109,7 @@ class WriterSink {
     other.clear();
   }
 
-  void flush() {
-    sink_->write(buffers_);
-    buffers_.clear();
-    size_ = 0;
-  }
+  void flush();
 
   Checksum* getChecksum() {
     return checksum_.get();
@@ -182,6 +206,12 @@ class WriterSink {
   bool exceedsLimit_;
 
   std::vector<dwio::common::DataBuffer<char>> buffers_;
+
+  folly::Executor* uploadExecutor_{nullptr};
+  // Bytes flushed to the sink, including the running upload. Used instead of
+  // the size of the sink if 'uploadExecutor_' is set.
+  uint64_t uploadedSize_{0};
+  std::optional<folly::Future<folly::Unit>> upload_;
 };
 
 } // namespace facebook::velox::dwrf
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include <limits>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+// IN lists longer than this are not tested against bloom filters since the
+// test would cost more than reading the row groups it may skip.
+constexpr size_t kMaxBloomFilterValues = 10'000;
+
+constexpr int32_t kWordsPerBlock = BloomFilter::kBytesPerBlock / 4;
+
+// Odd constants that select the bit in each word of a block.
+constexpr uint32_t kSalt[kWordsPerBlock] = {
+    0x47b6137bU,
+    0x44974d91U,
+    0x8824ad5bU,
+    0xa2b7289dU,
+    0x705495c7U,
+    0x2df1424bU,
+    0x9efc4947U,
+    0x5c6bfb31U};
+
+inline uint32_t bitInWord(uint64_t hash, int32_t word) {
+  const auto key = static_cast<uint32_t>(hash);
+  return 1U << ((key * kSalt[word]) >> 27);
+}
+} // namespace
+
+BloomFilter::BloomFilter(std::vector<uint32_t> bitset)
+    : bitset_(std::move(bitset)) {
+  VELOX_CHECK(!bitset_.empty());
+  VELOX_CHECK_EQ(
+      bitset_.size() % kWordsPerBlock,
+      0,
+      "Bloom filter size is not a multiple of the block size");
+}
+
+// static
+uint64_t BloomFilter::hashInt32(int32_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t BloomFilter::hashInt64(int64_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t BloomFilter::hashBytes(std::string_view value) {
+  return XXH64(value.data(), value.size(), 0);
+}
+
+// static
+std::optional<std::vector<uint64_t>> BloomFilter::filterHashes(
+    const common::Filter* filter,
+    const ParquetTypeWithId& type) {
+  if (filter == nullptr || filter->testNull() || type.type()->isDecimal() ||
+      !type.parquetType_.has_value()) {
+    return std::nullopt;
+  }
+  std::vector<int64_t> longs;
+  std::vector<std::string_view> strings;
+  switch (filter->kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto* range = static_cast<const common::BigintRange*>(filter);
+      if (!range->isSingleValue()) {
+        return std::nullopt;
+      }
+      longs.push_back(range->lower());
+      break;
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      longs =
+          static_cast<const common::BigintValuesUsingHashTable*>(filter)
+              ->values();
+      break;
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      longs =
+          static_cast<const common::BigintValuesUsingBitmask*>(filter)
+              ->values();
+      break;
+    case common::FilterKind::kBytesRange: {
+      auto* range = static_cast<const common::BytesRange*>(filter);
+      if (!range->isSingleValue()) {
+        return std::nullopt;
+      }
+      strings.push_back(range->lower());
+      break;
+    }
+    case common::FilterKind::kBytesValues:
+      for (const auto& value :
+           static_cast<const common::BytesValues*>(filter)->values()) {
+        strings.push_back(value);
+      }
+      break;
+    default:
+      return std::nullopt;
+  }
+  if (longs.size() + strings.size() > kMaxBloomFilterValues) {
+    return std::nullopt;
+  }
+
+  std::vector<uint64_t> hashes;
+  switch (type.type()->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      if (longs.empty()) {
+        return std::nullopt;
+      }
+      if (type.parquetType_ == thrift::Type::INT64) {
+        for (auto value : longs) {
+          hashes.push_back(hashInt64(value));
+        }
+        return hashes;
+      }
+      if (type.parquetType_ == thrift::Type::INT32) {
+        // Unsigned 32 bit values are stored with the same bits as negative
+        // ones.
+        for (auto value : longs) {
+          if (value >= std::numeric_limits<int32_t>::min() &&
+              value <= std::numeric_limits<uint32_t>::max()) {
+            hashes.push_back(hashInt32(static_cast<int32_t>(value)));
+          }
+        }
+        return hashes;
+      }
+      return std::nullopt;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      if (strings.empty() ||
+          (type.parquetType_ != thrift::Type::BYTE_ARRAY &&
+           type.parquetType_ != thrift::Type::FIXED_LEN_BYTE_ARRAY)) {
+        return std::nullopt;
+      }
+      for (auto value : strings) {
+        hashes.push_back(hashBytes(value));
+      }
+      return hashes;
+    default:
+      return std::nullopt;
+  }
+}
+
+size_t BloomFilter::blockOffset(uint64_t hash) const {
+  const uint64_t numBlocks = bitset_.size() / kWordsPerBlock;
+  return ((hash >> 32) * numBlocks >> 32) * kWordsPerBlock;
+}
+
+void BloomFilter::addHash(uint64_t hash) {
+  auto* block = bitset_.data() + blockOffset(hash);
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    block[i] |= bitInWord(hash, i);
+  }
+}
+
+bool BloomFilter::testHash(uint64_t hash) const {
+  const auto* block = bitset_.data() + blockOffset(hash);
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    if ((block[i] & bitInWord(hash, i)) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool BloomFilter::testHashes(const std::vector<uint64_t>& hashes) const {
+  for (auto hash : hashes) {
+    if (testHash(hash)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::parquet {
+
+/// Split block bloom filter of the values of a column chunk as specified by
+/// Parquet. Values are hashed with XXH64 of their plain encoding, without the
+/// length prefix for byte arrays. Each hash sets 8 bits in one block of 256
+/// bits. Nulls are not added.
+class BloomFilter {
+ public:
+  static constexpr int32_t kBytesPerBlock = 32;
+
+  /// Upper bound of the size of the BloomFilterHeader before the bitset.
+  static constexpr int32_t kMaxHeaderSize = 64;
+
+  /// Makes a filter with 'bitset', which has 32 bit little endian words. Its
+  /// size in bytes is a positive multiple of kBytesPerBlock.
+  explicit BloomFilter(std::vector<uint32_t> bitset);
+
+  static uint64_t hashInt32(int32_t value);
+
+  static uint64_t hashInt64(int64_t value);
+
+  static uint64_t hashBytes(std::string_view value);
+
+  /// Returns the hashes of the values that pass 'filter' on a column of
+  /// 'type', or std::nullopt if 'filter' passes values that are not in bloom
+  /// filters, e.g. nulls or ranges, or if the column is not hashed like the
+  /// filter values. Values that can not be in the column are left out.
+  static std::optional<std::vector<uint64_t>> filterHashes(
+      const common::Filter* filter,
+      const ParquetTypeWithId& type);
+
+  void addHash(uint64_t hash);
+
+  /// Returns false if no value with 'hash' was added.
+  bool testHash(uint64_t hash) const;
+
+  /// Returns false if no value with any of 'hashes' was added.
+  bool testHashes(const std::vector<uint64_t>& hashes) const;
+
+  const std::vector<uint32_t>& bitset() const {
+    return bitset_;
+  }
+
+ private:
+  // Returns the index of the first word of the block for 'hash'.
+  size_t blockOffset(uint64_t hash) const;
+
+  std::vector<uint32_t> bitset_;
+};
+
+} // namespace facebook::velox::parquet
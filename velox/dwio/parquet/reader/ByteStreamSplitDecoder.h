@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstring>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::parquet {
+
+// Decoder for BYTE_STREAM_SPLIT encoded fixed width values. Byte k of value i
+// of a page of n values is at k * n + i. Values are decoded in batches: each
+// byte stream is copied into its position in a batch of values, which reads
+// the streams sequentially and vectorizes. Skipping decodes nothing.
+class ByteStreamSplitDecoder {
+ public:
+  ByteStreamSplitDecoder(const char* start, const char* end, int32_t byteWidth)
+      : bufferStart_(start),
+        byteWidth_(byteWidth),
+        numValues_((end - start) / byteWidth) {
+    VELOX_CHECK(byteWidth_ == 4 || byteWidth_ == 8);
+    VELOX_CHECK_EQ(
+        (end - start) % byteWidth_,
+        0,
+        "BYTE_STREAM_SPLIT page size is not a multiple of the value size");
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_DCHECK_LE(nextValue_ + numValues, numValues_);
+    nextValue_ += numValues;
+  }
+
+  // Reads values of physical type 'T', which is 'byteWidth' bytes wide.
+  template <typename T, bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    VELOX_DCHECK_EQ(static_cast<int32_t>(sizeof(T)), byteWidth_);
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readValue<T>(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+ private:
+  static constexpr int32_t kBatchSize = 64;
+
+  template <typename T>
+  T readValue() {
+    if (nextValue_ < batchBegin_ || nextValue_ >= batchEnd_) {
+      decodeBatch<sizeof(T)>();
+    }
+    T value;
+    ::memcpy(
+        &value,
+        batch_.data() + (nextValue_ - batchBegin_) * sizeof(T),
+        sizeof(T));
+    ++nextValue_;
+    return value;
+  }
+
+  // Decodes up to kBatchSize values from 'nextValue_' into 'batch_'.
+  template <int32_t kWidth>
+  void decodeBatch() {
+    VELOX_CHECK_LT(
+        nextValue_, numValues_, "Reading past the end of BYTE_STREAM_SPLIT");
+    const auto numValues =
+        std::min<int64_t>(kBatchSize, numValues_ - nextValue_);
+    auto* values = reinterpret_cast<uint8_t*>(batch_.data());
+    for (auto byte = 0; byte < kWidth; ++byte) {
+      const auto* stream = reinterpret_cast<const uint8_t*>(bufferStart_) +
+          byte * numValues_ + nextValue_;
+      for (auto i = 0; i < numValues; ++i) {
+        values[i * kWidth + byte] = stream[i];
+      }
+    }
+    batchBegin_ = nextValue_;
+    batchEnd_ = nextValue_ + numValues;
+  }
+
+  const char* const bufferStart_;
+  const int32_t byteWidth_;
+  const int64_t numValues_;
+  // Index of the next value in the page.
+  int64_t nextValue_{0};
+  // Values [batchBegin_, batchEnd_) of the page are decoded in 'batch_'.
+  int64_t batchBegin_{0};
+  int64_t batchEnd_{0};
+  std::array<uint64_t, kBatchSize> batch_;
+};
+
+} // namespace facebook::velox::parquet
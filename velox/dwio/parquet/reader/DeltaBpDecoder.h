@@ -33,6 +33,28 @@ class DeltaBpDecoder {
     skip<false>(numValues, 0, nullptr);
   }
 
+  // Number of values in the page.
+  uint64_t numValues() const {
+    return totalValueCount_;
+  }
+
+  // Reads the next 'numValues' values into 'values'.
+  template <typename T>
+  void readValues(T* values, uint64_t numValues) {
+    for (uint64_t i = 0; i < numValues; ++i) {
+      values[i] = readLong();
+    }
+  }
+
+  // Returns the first byte after the encoded values. All values must have
+  // been read. The last mini block is padded to its full size.
+  const char* endOfValues() const {
+    if (valuesRemainingCurrentMiniBlock_ > 0) {
+      return bufferStart_ + bits::nbytes(deltaBitWidth_ * valuesPerMiniBlock_);
+    }
+    return bufferStart_;
+  }
+
   template <bool hasNulls>
   inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
     if (hasNulls) {
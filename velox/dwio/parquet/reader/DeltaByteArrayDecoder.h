@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/reader/DeltaLengthByteArrayDecoder.h"
+
+namespace facebook::velox::parquet {
+
+// Decoder for DELTA_BYTE_ARRAY encoded strings. Each value is the first
+// 'prefix length' bytes of the previous value followed by a suffix. The
+// DELTA_BINARY_PACKED prefix lengths of all values are followed by the
+// suffixes as DELTA_LENGTH_BYTE_ARRAY. The prefix lengths are decoded in bulk
+// when the decoder is made. Each value is assembled in 'value_', which is
+// valid until the next value is read.
+class DeltaByteArrayDecoder {
+ public:
+  DeltaByteArrayDecoder(const char* start, const char* end)
+      : DeltaByteArrayDecoder(DeltaBpDecoder(start), end) {}
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    // The values after the skipped ones share prefixes with them.
+    for (auto i = 0; i < numValues; ++i) {
+      readString();
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+ private:
+  DeltaByteArrayDecoder(DeltaBpDecoder prefixDecoder, const char* end)
+      : prefixLengths_(readPrefixLengths(prefixDecoder)),
+        suffixDecoder_(prefixDecoder.endOfValues(), end) {
+    VELOX_CHECK_EQ(
+        prefixLengths_.size(),
+        suffixDecoder_.numValues(),
+        "DELTA_BYTE_ARRAY prefix and suffix counts differ");
+  }
+
+  static std::vector<int32_t> readPrefixLengths(DeltaBpDecoder& decoder) {
+    std::vector<int32_t> lengths(decoder.numValues());
+    decoder.readValues(lengths.data(), lengths.size());
+    return lengths;
+  }
+
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(nextValue_, prefixLengths_.size());
+    const auto prefixLength = prefixLengths_[nextValue_++];
+    VELOX_CHECK(
+        prefixLength >= 0 && prefixLength <= value_.size(),
+        "Invalid DELTA_BYTE_ARRAY prefix length {}",
+        prefixLength);
+    const auto suffix = suffixDecoder_.readString();
+    value_.resize(prefixLength);
+    value_.append(suffix.data(), suffix.size());
+    return folly::StringPiece(value_);
+  }
+
+  const std::vector<int32_t> prefixLengths_;
+  DeltaLengthByteArrayDecoder suffixDecoder_;
+  // Index of the next value in 'prefixLengths_'.
+  size_t nextValue_{0};
+  std::string value_;
+};
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+namespace facebook::velox::parquet {
+
+// Decoder for DELTA_LENGTH_BYTE_ARRAY encoded strings. The lengths of all
+// values are DELTA_BINARY_PACKED encoded before the concatenated bytes of the
+// values. The lengths are decoded in bulk when the decoder is made, so that
+// reading a value is a lookup and skipping touches no string bytes.
+class DeltaLengthByteArrayDecoder {
+ public:
+  DeltaLengthByteArrayDecoder(const char* start, const char* end) {
+    DeltaBpDecoder lengthDecoder(start);
+    lengths_.resize(lengthDecoder.numValues());
+    lengthDecoder.readValues(lengths_.data(), lengths_.size());
+    bufferStart_ = lengthDecoder.endOfValues();
+    int64_t totalLength = 0;
+    for (auto length : lengths_) {
+      VELOX_CHECK_GE(length, 0, "Negative DELTA_LENGTH_BYTE_ARRAY length");
+      totalLength += length;
+    }
+    VELOX_CHECK_LE(
+        bufferStart_ + totalLength,
+        end,
+        "DELTA_LENGTH_BYTE_ARRAY values exceed the page");
+  }
+
+  // Number of values in the page.
+  size_t numValues() const {
+    return lengths_.size();
+  }
+
+  // Returns the next value. The bytes are in the page.
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(nextValue_, lengths_.size());
+    const auto length = lengths_[nextValue_++];
+    bufferStart_ += length;
+    return folly::StringPiece(bufferStart_ - length, length);
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_DCHECK_LE(nextValue_ + numValues, lengths_.size());
+    for (auto i = 0; i < numValues; ++i) {
+      bufferStart_ += lengths_[nextValue_++];
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+ private:
+  std::vector<int32_t> lengths_;
+  // Index of the next value in 'lengths_'.
+  size_t nextValue_{0};
+  // Start of the bytes of the next value.
+  const char* bufferStart_;
+};
+
+} // namespace facebook::velox::parquet
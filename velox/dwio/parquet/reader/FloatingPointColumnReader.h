@@ -43,6 +43,11 @@ class FloatingPointColumnReader
     this->formatData_->template as<ParquetData>().seekToRowGroup(index);
   }
 
+  bool hasBulkPath() const override {
+    return base::hasBulkPath() &&
+        !this->formatData_->template as<ParquetData>().isByteStreamSplit();
+  }
+
   uint64_t skip(uint64_t numValues) override;
 
   void read(vector_size_t offset, RowSet rows, const uint64_t* incomingNulls)
@@ -219,6 +219,40 @@ ColumnChunkMetaDataPtr::getColumnStatistics(
       thriftColumnChunkPtr(ptr_)->meta_data.statistics, *type, numRows);
 };
 
+bool ColumnChunkMetaDataPtr::isFullyDictionaryEncoded() const {
+  if (!hasDictionaryPageOffset()) {
+    return false;
+  }
+  const auto& metaData = thriftColumnChunkPtr(ptr_)->meta_data;
+  auto isDictionary = [](thrift::Encoding::type encoding) {
+    return encoding == thrift::Encoding::PLAIN_DICTIONARY ||
+        encoding == thrift::Encoding::RLE_DICTIONARY;
+  };
+  if (metaData.__isset.encoding_stats) {
+    for (const auto& stats : metaData.encoding_stats) {
+      const bool isDataPage = stats.page_type == thrift::PageType::DATA_PAGE ||
+          stats.page_type == thrift::PageType::DATA_PAGE_V2;
+      if (isDataPage && stats.count > 0 && !isDictionary(stats.encoding)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // The dictionary page of RLE_DICTIONARY is PLAIN, so that a PLAIN encoding
+  // may as well be of a data page.
+  bool hasPlainDictionary = false;
+  for (auto encoding : metaData.encodings) {
+    if (encoding == thrift::Encoding::PLAIN_DICTIONARY) {
+      hasPlainDictionary = true;
+    } else if (
+        encoding != thrift::Encoding::RLE &&
+        encoding != thrift::Encoding::BIT_PACKED) {
+      return false;
+    }
+  }
+  return hasPlainDictionary;
+}
+
 int64_t ColumnChunkMetaDataPtr::dataPageOffset() const {
   return thriftColumnChunkPtr(ptr_)->meta_data.data_page_offset;
 }
@@ -241,6 +275,32 @@ int64_t ColumnChunkMetaDataPtr::totalUncompressedSize() const {
   return thriftColumnChunkPtr(ptr_)->meta_data.total_uncompressed_size;
 }
 
+bool ColumnChunkMetaDataPtr::hasPageIndex() const {
+  const auto& isset = thriftColumnChunkPtr(ptr_)->__isset;
+  return isset.column_index_offset && isset.column_index_length &&
+      isset.offset_index_offset && isset.offset_index_length;
+}
+
+int64_t ColumnChunkMetaDataPtr::columnIndexOffset() const {
+  VELOX_CHECK(hasPageIndex());
+  return thriftColumnChunkPtr(ptr_)->column_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::columnIndexLength() const {
+  VELOX_CHECK(hasPageIndex());
+  return thriftColumnChunkPtr(ptr_)->column_index_length;
+}
+
+int64_t ColumnChunkMetaDataPtr::offsetIndexOffset() const {
+  VELOX_CHECK(hasPageIndex());
+  return thriftColumnChunkPtr(ptr_)->offset_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::offsetIndexLength() const {
+  VELOX_CHECK(hasPageIndex());
+  return thriftColumnChunkPtr(ptr_)->offset_index_length;
+}
+
 FOLLY_ALWAYS_INLINE const thrift::RowGroup* thriftRowGroupPtr(
     const void* metadata) {
   return reinterpret_cast<const thrift::RowGroup*>(metadata);
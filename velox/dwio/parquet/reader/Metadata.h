@@ -21,6 +21,18 @@
 
 namespace facebook::velox::parquet {
 
+namespace thrift {
+class Statistics;
+} // namespace thrift
+
+/// Returns the statistics of 'numRows' values of 'type' described by
+/// 'columnChunkStats'. These are the statistics of a column chunk or of a
+/// data page in a ColumnIndex.
+std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
+    const thrift::Statistics& columnChunkStats,
+    const velox::Type& type,
+    uint64_t numRowsInRowGroup);
+
 /// ColumnChunkMetaDataPtr is a proxy around pointer to thrift::ColumnChunk.
 class ColumnChunkMetaDataPtr {
  public:
@@ -37,6 +49,12 @@ class ColumnChunkMetaDataPtr {
   /// Check the presence of the dictionary page offset in ColumnChunk metadata.
   bool hasDictionaryPageOffset() const;
 
+  /// True if the column chunk has a dictionary page and all its data pages
+  /// are dictionary encoded according to the page encoding stats. Without
+  /// encoding stats, only chunks with the PLAIN_DICTIONARY encoding of older
+  /// writers can be told to have no PLAIN data pages.
+  bool isFullyDictionaryEncoded() const;
+
   /// Return the ColumnChunk statistics.
   std::unique_ptr<dwio::common::ColumnStatistics> getColumnStatistics(
       const TypePtr type,
@@ -65,6 +83,20 @@ class ColumnChunkMetaDataPtr {
   /// This information is optional and may be 0 if omitted.
   int64_t totalUncompressedSize() const;
 
+  /// Check the presence of the ColumnIndex and OffsetIndex of the column
+  /// chunk, together called the page index.
+  bool hasPageIndex() const;
+
+  /// File offset and length of the ColumnIndex with the statistics of each
+  /// data page. Must check for its presence using hasPageIndex().
+  int64_t columnIndexOffset() const;
+  int32_t columnIndexLength() const;
+
+  /// File offset and length of the OffsetIndex with the location and first
+  /// row of each data page. Must check for its presence using hasPageIndex().
+  int64_t offsetIndexOffset() const;
+  int32_t offsetIndexLength() const;
+
  private:
   const void* ptr_;
 };
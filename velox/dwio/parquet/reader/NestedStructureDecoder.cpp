@@ -16,10 +16,160 @@
 
 #include "velox/dwio/parquet/reader/NestedStructureDecoder.h"
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/dwio/common/BufferUtil.h"
 
 namespace facebook::velox::parquet {
 
+namespace {
+
+using LevelBatch = xsimd::batch<int16_t>;
+constexpr int32_t kBatchSize = LevelBatch::size;
+static_assert(kBatchSize < 64);
+
+// Bit masks of the levels of a batch, one bit per level.
+struct LevelMasks {
+  // Levels that start a list.
+  uint64_t begins;
+  // Levels that add an element to the list they are in.
+  uint64_t elements;
+  // Levels of lists that are not null.
+  uint64_t valids;
+};
+
+// Levels below 'repeatedAncestorDef' belong to a null or empty ancestor list
+// and levels above 'repLevel' to a list nested in an element. The others
+// start a list if their repetition level is below 'repLevel' and continue
+// one otherwise.
+struct LevelThresholds {
+  int16_t repeatedAncestorDef;
+  int16_t repLevel;
+  int16_t defLevel;
+};
+
+LevelMasks batchMasks(
+    const int16_t* defs,
+    const int16_t* reps,
+    const LevelThresholds& thresholds) {
+  const auto def = LevelBatch::load_unaligned(defs);
+  const auto rep = LevelBatch::load_unaligned(reps);
+  const auto repLevel = LevelBatch::broadcast(thresholds.repLevel);
+  const auto kept =
+      (def >= LevelBatch::broadcast(thresholds.repeatedAncestorDef)) &
+      (rep <= repLevel);
+  return {
+      static_cast<uint64_t>(simd::toBitMask(kept & (rep < repLevel))),
+      static_cast<uint64_t>(simd::toBitMask(
+          kept &
+          ((rep == repLevel) |
+           (def >= LevelBatch::broadcast(thresholds.defLevel))))),
+      static_cast<uint64_t>(simd::toBitMask(
+          def >=
+          LevelBatch::broadcast(
+              static_cast<int16_t>(thresholds.defLevel - 1))))};
+}
+
+LevelMasks scalarMasks(
+    const int16_t* defs,
+    const int16_t* reps,
+    int32_t numLevels,
+    const LevelThresholds& thresholds) {
+  LevelMasks masks{0, 0, 0};
+  for (auto i = 0; i < numLevels; ++i) {
+    const bool kept = defs[i] >= thresholds.repeatedAncestorDef &&
+        reps[i] <= thresholds.repLevel;
+    const uint64_t bit = 1ULL << i;
+    if (kept && reps[i] < thresholds.repLevel) {
+      masks.begins |= bit;
+    }
+    if (kept &&
+        (reps[i] == thresholds.repLevel || defs[i] >= thresholds.defLevel)) {
+      masks.elements |= bit;
+    }
+    if (defs[i] >= thresholds.defLevel - 1) {
+      masks.valids |= bit;
+    }
+  }
+  return masks;
+}
+
+template <bool kHasLengths>
+int32_t decodeLevels(
+    const int16_t* defs,
+    const int16_t* reps,
+    int32_t numLevels,
+    const LevelThresholds& thresholds,
+    int32_t maxItems,
+    int32_t* lengths,
+    uint64_t* nulls,
+    int32_t nullsStartIndex) {
+  int32_t numItems = 0;
+  // Adds the lists and elements of 'width' levels with 'masks'.
+  auto addLevels = [&](const LevelMasks& masks, int32_t width) {
+    auto begins = masks.begins;
+    if (begins == 0) {
+      // All levels continue the last list or are skipped. Elements before
+      // the first list start belong to no list in the range.
+      if (kHasLengths && numItems > 0) {
+        lengths[numItems - 1] += __builtin_popcountll(masks.elements);
+      }
+      return;
+    }
+    const auto numBegins = __builtin_popcountll(begins);
+    VELOX_CHECK_LE(
+        numItems + numBegins,
+        maxItems,
+        "Definition levels exceeded upper bound: {}",
+        maxItems);
+    auto firstBegin = __builtin_ctzll(begins);
+    if (kHasLengths && numItems > 0) {
+      lengths[numItems - 1] +=
+          __builtin_popcountll(masks.elements & bits::lowMask(firstBegin));
+    }
+    if (numBegins == width && masks.valids == bits::lowMask(width)) {
+      // Each level starts a list that is not null, e.g. lists of at most one
+      // element.
+      bits::fillBits(
+          nulls,
+          nullsStartIndex + numItems,
+          nullsStartIndex + numItems + width,
+          true);
+      if constexpr (kHasLengths) {
+        for (auto i = 0; i < width; ++i) {
+          lengths[numItems + i] = (masks.elements >> i) & 1;
+        }
+      }
+      numItems += width;
+      return;
+    }
+    while (begins) {
+      const auto lane = __builtin_ctzll(begins);
+      begins &= begins - 1;
+      if constexpr (kHasLengths) {
+        const auto end = begins ? __builtin_ctzll(begins) : width;
+        lengths[numItems] = __builtin_popcountll(
+            masks.elements & bits::lowMask(end) & ~bits::lowMask(lane));
+      }
+      bits::setBit(
+          nulls, nullsStartIndex + numItems, (masks.valids >> lane) & 1);
+      ++numItems;
+    }
+  };
+
+  int32_t i = 0;
+  for (; i + kBatchSize <= numLevels; i += kBatchSize) {
+    addLevels(batchMasks(defs + i, reps + i, thresholds), kBatchSize);
+  }
+  if (i < numLevels) {
+    addLevels(
+        scalarMasks(defs + i, reps + i, numLevels - i, thresholds),
+        numLevels - i);
+  }
+  return numItems;
+}
+
+} // namespace
+
 int64_t NestedStructureDecoder::readOffsetsAndNulls(
     const uint8_t* definitionLevels,
     const uint8_t* repetitionLevels,
@@ -79,4 +229,93 @@ int64_t NestedStructureDecoder::readOffsetsAndNulls(
   return outputIndex;
 }
 
+// static
+int32_t NestedStructureDecoder::readLengthsAndNulls(
+    const int16_t* defs,
+    const int16_t* reps,
+    int32_t numLevels,
+    const arrow::LevelInfo& info,
+    int32_t maxItems,
+    int32_t* lengths,
+    uint64_t* nulls,
+    int32_t nullsStartIndex) {
+  const LevelThresholds thresholds{
+      info.repeated_ancestor_def_level, info.rep_level, info.def_level};
+  if (lengths == nullptr) {
+    return decodeLevels<false>(
+        defs,
+        reps,
+        numLevels,
+        thresholds,
+        maxItems,
+        nullptr,
+        nulls,
+        nullsStartIndex);
+  }
+  return decodeLevels<true>(
+      defs,
+      reps,
+      numLevels,
+      thresholds,
+      maxItems,
+      lengths,
+      nulls,
+      nullsStartIndex);
+}
+
+// static
+int32_t NestedStructureDecoder::readStructNulls(
+    const int16_t* defs,
+    const int16_t* reps,
+    int32_t numLevels,
+    const arrow::LevelInfo& info,
+    int32_t maxItems,
+    uint64_t* nulls,
+    int32_t nullsStartIndex) {
+  // A struct starts at the levels that would start a list one level deeper.
+  const LevelThresholds thresholds{
+      info.repeated_ancestor_def_level,
+      static_cast<int16_t>(info.rep_level + 1),
+      static_cast<int16_t>(info.def_level + 1)};
+  return decodeLevels<false>(
+      defs,
+      reps,
+      numLevels,
+      thresholds,
+      maxItems,
+      nullptr,
+      nulls,
+      nullsStartIndex);
+}
+
+// static
+int32_t NestedStructureDecoder::findTopLevelRowsEnd(
+    const int16_t* reps,
+    int32_t numLevels,
+    int32_t numTopLevelRows) {
+  // The first level starts a row, so the end is at the row start after the
+  // first 'numTopLevelRows' + 1 starts.
+  int32_t numToFind = numTopLevelRows + 1;
+  int32_t i = 0;
+  for (; i + kBatchSize <= numLevels; i += kBatchSize) {
+    auto starts = static_cast<uint64_t>(simd::toBitMask(
+        LevelBatch::load_unaligned(reps + i) == LevelBatch::broadcast(0)));
+    const auto numStarts = __builtin_popcountll(starts);
+    if (numStarts < numToFind) {
+      numToFind -= numStarts;
+      continue;
+    }
+    for (auto n = 1; n < numToFind; ++n) {
+      starts &= starts - 1;
+    }
+    return i + __builtin_ctzll(starts);
+  }
+  for (; i < numLevels; ++i) {
+    if (reps[i] == 0 && --numToFind == 0) {
+      return i;
+    }
+  }
+  return numLevels;
+}
+
 } // namespace facebook::velox::parquet
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/buffer/Buffer.h"
+#include "velox/dwio/parquet/writer/arrow/LevelConversion.h"
 
 namespace facebook::velox::parquet {
 
@@ -60,6 +61,46 @@ class NestedStructureDecoder {
       BufferPtr& nullsBuffer,
       memory::MemoryPool& pool);
 
+  /// Computes the lengths and nulls of the lists at the level of 'info' from
+  /// 'numLevels' definition and repetition levels starting at 'defs' and
+  /// 'reps'. Sets 'lengths[i]' to the number of elements of the ith list and
+  /// bit 'nullsStartIndex + i' of 'nulls' if the list is not null. Returns
+  /// the number of lists, which must not exceed 'maxItems'. This gives the
+  /// same results as arrow::DefRepLevelsToList() followed by turning the
+  /// offsets into lengths, but compares the levels a SIMD batch at a time and
+  /// counts the elements of a list by popcount, so that a batch of levels in
+  /// the middle of a list, e.g. a run of present values, costs a few
+  /// instructions. 'lengths' may be nullptr if only the nulls are needed.
+  static int32_t readLengthsAndNulls(
+      const int16_t* defs,
+      const int16_t* reps,
+      int32_t numLevels,
+      const arrow::LevelInfo& info,
+      int32_t maxItems,
+      int32_t* lengths,
+      uint64_t* nulls,
+      int32_t nullsStartIndex);
+
+  /// Computes the nulls of a struct that has a list descendant, like
+  /// arrow::DefRepLevelsToBitmap(). The arguments are as in
+  /// readLengthsAndNulls().
+  static int32_t readStructNulls(
+      const int16_t* defs,
+      const int16_t* reps,
+      int32_t numLevels,
+      const arrow::LevelInfo& info,
+      int32_t maxItems,
+      uint64_t* nulls,
+      int32_t nullsStartIndex);
+
+  /// Returns the position of the first repetition level of 0 after the first
+  /// 'numTopLevelRows' of them in 'reps', or 'numLevels' if there are not
+  /// that many. 'reps' are the levels from the beginning of a top level row.
+  static int32_t findTopLevelRowsEnd(
+      const int16_t* reps,
+      int32_t numLevels,
+      int32_t numTopLevelRows);
+
  private:
   NestedStructureDecoder() {}
 };
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/PageIndex.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+template <typename T>
+T readThrift(
+    dwio::common::BufferedInput& input,
+    int64_t offset,
+    int32_t length) {
+  auto stream =
+      input.read(offset, length, dwio::common::LogType::STRIPE_INDEX);
+  const void* buffer;
+  int32_t size;
+  VELOX_CHECK(stream->Next(&buffer, &size), "Empty page index stream");
+  auto bufferStart = reinterpret_cast<const char*>(buffer);
+  auto bufferEnd = bufferStart + size;
+  std::shared_ptr<thrift::ThriftTransport> transport =
+      std::make_shared<thrift::ThriftStreamingTransport>(
+          stream.get(), bufferStart, bufferEnd);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  T result;
+  result.read(&protocol);
+  return result;
+}
+} // namespace
+
+std::vector<RowRange> intersectRowRanges(
+    const std::vector<RowRange>& left,
+    const std::vector<RowRange>& right) {
+  std::vector<RowRange> result;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < left.size() && j < right.size()) {
+    const auto begin = std::max(left[i].begin, right[j].begin);
+    const auto end = std::min(left[i].end, right[j].end);
+    if (begin < end) {
+      result.push_back({begin, end});
+    }
+    if (left[i].end < right[j].end) {
+      ++i;
+    } else {
+      ++j;
+    }
+  }
+  return result;
+}
+
+PageIndex::PageIndex(
+    thrift::ColumnIndex columnIndex,
+    thrift::OffsetIndex offsetIndex,
+    int64_t numRows)
+    : columnIndex_(std::move(columnIndex)),
+      offsetIndex_(std::move(offsetIndex)),
+      numRows_(numRows) {
+  const auto numPages = offsetIndex_.page_locations.size();
+  VELOX_CHECK_EQ(columnIndex_.null_pages.size(), numPages);
+  VELOX_CHECK_EQ(columnIndex_.min_values.size(), numPages);
+  VELOX_CHECK_EQ(columnIndex_.max_values.size(), numPages);
+  if (columnIndex_.__isset.null_counts) {
+    VELOX_CHECK_EQ(columnIndex_.null_counts.size(), numPages);
+  }
+}
+
+// static
+std::unique_ptr<PageIndex> PageIndex::read(
+    const ColumnChunkMetaDataPtr& chunk,
+    int64_t numRows,
+    dwio::common::BufferedInput& input) {
+  return std::make_unique<PageIndex>(
+      readThrift<thrift::ColumnIndex>(
+          input, chunk.columnIndexOffset(), chunk.columnIndexLength()),
+      readThrift<thrift::OffsetIndex>(
+          input, chunk.offsetIndexOffset(), chunk.offsetIndexLength()),
+      numRows);
+}
+
+std::vector<RowRange> PageIndex::filterPages(
+    common::Filter* filter,
+    const TypePtr& type,
+    int64_t& numSkippedPages) const {
+  std::vector<RowRange> ranges;
+  for (auto page = 0; page < numPages(); ++page) {
+    if (!pageMatches(page, filter, type)) {
+      ++numSkippedPages;
+      continue;
+    }
+    const auto begin = firstRowOfPage(page);
+    const auto end = endRowOfPage(page);
+    if (!ranges.empty() && ranges.back().end == begin) {
+      ranges.back().end = end;
+    } else {
+      ranges.push_back({begin, end});
+    }
+  }
+  return ranges;
+}
+
+bool PageIndex::pageMatches(
+    int32_t page,
+    common::Filter* filter,
+    const TypePtr& type) const {
+  const auto numRowsInPage = endRowOfPage(page) - firstRowOfPage(page);
+  thrift::Statistics stats;
+  if (columnIndex_.null_pages[page]) {
+    // The min and max of a page of only nulls are not set.
+    stats.__set_null_count(numRowsInPage);
+  } else {
+    stats.__set_min_value(columnIndex_.min_values[page]);
+    stats.__set_max_value(columnIndex_.max_values[page]);
+    if (columnIndex_.__isset.null_counts) {
+      stats.__set_null_count(columnIndex_.null_counts[page]);
+    }
+  }
+  auto columnStats =
+      buildColumnStatisticsFromThrift(stats, *type, numRowsInPage);
+  return common::testFilter(filter, columnStats.get(), numRowsInPage, type);
+}
+
+} // namespace facebook::velox::parquet
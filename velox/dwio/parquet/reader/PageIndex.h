@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/parquet/reader/Metadata.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::parquet {
+
+/// Rows [begin, end) of a row group.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+
+  bool operator==(const RowRange& other) const {
+    return begin == other.begin && end == other.end;
+  }
+};
+
+/// Returns the rows that are in both 'left' and 'right'. The ranges in
+/// 'left', 'right' and the result are ascending and do not overlap.
+std::vector<RowRange> intersectRowRanges(
+    const std::vector<RowRange>& left,
+    const std::vector<RowRange>& right);
+
+/// Page index of a column chunk. The ColumnIndex has the min/max statistics of
+/// each data page and the OffsetIndex has the first row of each data page.
+/// Writers place both outside of the row groups, so that a reader can tell
+/// which pages may have values that pass a filter before reading any page.
+class PageIndex {
+ public:
+  PageIndex(
+      thrift::ColumnIndex columnIndex,
+      thrift::OffsetIndex offsetIndex,
+      int64_t numRows);
+
+  /// Reads the page index of 'chunk' in a row group of 'numRows' rows from
+  /// 'input'. 'chunk' must have a page index.
+  static std::unique_ptr<PageIndex> read(
+      const ColumnChunkMetaDataPtr& chunk,
+      int64_t numRows,
+      dwio::common::BufferedInput& input);
+
+  int32_t numPages() const {
+    return offsetIndex_.page_locations.size();
+  }
+
+  /// Returns the rows of the pages that may have values passing 'filter'.
+  /// The rows of consecutive pages are merged into one range. 'type' is the
+  /// type of the column in the file. Adds the number of the other pages to
+  /// 'numSkippedPages'.
+  std::vector<RowRange> filterPages(
+      common::Filter* filter,
+      const TypePtr& type,
+      int64_t& numSkippedPages) const;
+
+ private:
+  int64_t firstRowOfPage(int32_t page) const {
+    return offsetIndex_.page_locations[page].first_row_index;
+  }
+
+  int64_t endRowOfPage(int32_t page) const {
+    return page + 1 < numPages() ? firstRowOfPage(page + 1) : numRows_;
+  }
+
+  // Returns false if no value of 'page' can pass 'filter'.
+  bool pageMatches(int32_t page, common::Filter* filter, const TypePtr& type)
+      const;
+
+  const thrift::ColumnIndex columnIndex_;
+  const thrift::OffsetIndex offsetIndex_;
+  const int64_t numRows_;
+};
+
+} // namespace facebook::velox::parquet
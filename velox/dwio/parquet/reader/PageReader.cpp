@@ -18,6 +18,7 @@
 
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/ColumnVisitors.h"
+#include "velox/dwio/parquet/reader/NestedStructureDecoder.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 #include "velox/vector/FlatVector.h"
 
@@ -94,6 +95,15 @@ PageHeader PageReader::readPageHeader() {
   return pageHeader;
 }
 
+const dwio::common::DictionaryValues* PageReader::readDictionaryPage() {
+  auto pageHeader = readPageHeader();
+  if (pageHeader.type != thrift::PageType::DICTIONARY_PAGE) {
+    return nullptr;
+  }
+  prepareDictionary(pageHeader);
+  return &dictionary_;
+}
+
 const char* PageReader::readBytes(int32_t size, BufferPtr& copy) {
   if (bufferEnd_ == bufferStart_) {
     const void* buffer = nullptr;
@@ -137,7 +147,8 @@ const char* PageReader::decompressData(
           streamDebugInfo,
           nullptr,
           true,
-          compressedSize);
+          compressedSize,
+          ioStats_);
 
   dwio::common::ensureCapacity<char>(
       decompressedData_, uncompressedSize, &pool_);
@@ -166,7 +177,8 @@ void PageReader::setPageRowInfo(bool forRepDef) {
 void PageReader::readPageDefLevels() {
   VELOX_CHECK(kRowsUnknown == numRowsInPage_ || maxDefine_ > 1);
   definitionLevels_.resize(numRepDefsInPage_);
-  wideDefineDecoder_->GetBatch(definitionLevels_.data(), numRepDefsInPage_);
+  auto* levels = definitionLevels_.data();
+  wideDefineDecoder_->next(levels, numRepDefsInPage_);
   leafNulls_.resize(bits::nwords(numRepDefsInPage_));
   leafNullsSize_ = getLengthsAndNulls(
       LevelMode::kNulls,
@@ -213,9 +225,9 @@ void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
   auto pageEnd = pageData_ + pageHeader.uncompressed_page_size;
   if (maxRepeat_ > 0) {
     uint32_t repeatLength = readField<int32_t>(pageData_);
-    repeatDecoder_ = std::make_unique<::arrow::util::RleDecoder>(
-        reinterpret_cast<const uint8_t*>(pageData_),
-        repeatLength,
+    repeatDecoder_ = std::make_unique<RleBpDecoder>(
+        pageData_,
+        pageData_ + repeatLength,
         ::arrow::bit_util::NumRequiredBits(maxRepeat_));
 
     pageData_ += repeatLength;
@@ -229,9 +241,9 @@ void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
           pageData_ + defineLength,
           ::arrow::bit_util::NumRequiredBits(maxDefine_));
     }
-    wideDefineDecoder_ = std::make_unique<::arrow::util::RleDecoder>(
-        reinterpret_cast<const uint8_t*>(pageData_),
-        defineLength,
+    wideDefineDecoder_ = std::make_unique<RleBpDecoder>(
+        pageData_,
+        pageData_ + defineLength,
         ::arrow::bit_util::NumRequiredBits(maxDefine_));
     pageData_ += defineLength;
   }
@@ -271,9 +283,9 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
   pageData_ = readBytes(bytes, pageBuffer_);
 
   if (repeatLength) {
-    repeatDecoder_ = std::make_unique<::arrow::util::RleDecoder>(
-        reinterpret_cast<const uint8_t*>(pageData_),
-        repeatLength,
+    repeatDecoder_ = std::make_unique<RleBpDecoder>(
+        pageData_,
+        pageData_ + repeatLength,
         ::arrow::bit_util::NumRequiredBits(maxRepeat_));
   }
 
@@ -496,13 +508,13 @@ void PageReader::preloadRepDefs() {
     auto begin = definitionLevels_.size();
     auto numLevels = definitionLevels_.size() + numRepDefsInPage_;
     definitionLevels_.resize(numLevels);
-    wideDefineDecoder_->GetBatch(
-        definitionLevels_.data() + begin, numRepDefsInPage_);
+    auto* defineLevels = definitionLevels_.data() + begin;
+    wideDefineDecoder_->next(defineLevels, numRepDefsInPage_);
     if (repeatDecoder_) {
       repetitionLevels_.resize(numLevels);
 
-      repeatDecoder_->GetBatch(
-          repetitionLevels_.data() + begin, numRepDefsInPage_);
+      auto* repeatLevels = repetitionLevels_.data() + begin;
+      repeatDecoder_->next(repeatLevels, numRepDefsInPage_);
     }
     leafNulls_.resize(bits::nwords(leafNullsSize_ + numRepDefsInPage_));
     auto numLeaves = getLengthsAndNulls(
@@ -535,20 +547,14 @@ void PageReader::decodeRepDefs(int32_t numTopLevelRows) {
   }
   repDefBegin_ = repDefEnd_;
   int32_t numLevels = definitionLevels_.size();
-  int32_t topFound = 0;
-  int32_t i = repDefBegin_;
   if (maxRepeat_ > 0) {
-    for (; i < numLevels; ++i) {
-      if (repetitionLevels_[i] == 0) {
-        ++topFound;
-        if (topFound == numTopLevelRows + 1) {
-          break;
-        }
-      }
-    }
-    repDefEnd_ = i;
+    repDefEnd_ = repDefBegin_ +
+        NestedStructureDecoder::findTopLevelRowsEnd(
+                 repetitionLevels_.data() + repDefBegin_,
+                 numLevels - repDefBegin_,
+                 numTopLevelRows);
   } else {
-    repDefEnd_ = i + numTopLevelRows;
+    repDefEnd_ = repDefBegin_ + numTopLevelRows;
   }
 }
 
@@ -561,43 +567,39 @@ int32_t PageReader::getLengthsAndNulls(
     int32_t* lengths,
     uint64_t* nulls,
     int32_t nullsStartIndex) const {
-  arrow::ValidityBitmapInputOutput bits;
-  bits.values_read_upper_bound = maxItems;
-  bits.values_read = 0;
-  bits.null_count = 0;
-  bits.valid_bits = reinterpret_cast<uint8_t*>(nulls);
-  bits.valid_bits_offset = nullsStartIndex;
-
   switch (mode) {
-    case LevelMode::kNulls:
+    case LevelMode::kNulls: {
+      arrow::ValidityBitmapInputOutput bits;
+      bits.values_read_upper_bound = maxItems;
+      bits.values_read = 0;
+      bits.null_count = 0;
+      bits.valid_bits = reinterpret_cast<uint8_t*>(nulls);
+      bits.valid_bits_offset = nullsStartIndex;
       DefLevelsToBitmap(
           definitionLevels_.data() + begin, end - begin, info, &bits);
-      break;
-    case LevelMode::kList: {
-      arrow::DefRepLevelsToList(
+      return bits.values_read;
+    }
+    case LevelMode::kList:
+      return NestedStructureDecoder::readLengthsAndNulls(
           definitionLevels_.data() + begin,
           repetitionLevels_.data() + begin,
           end - begin,
           info,
-          &bits,
-          lengths);
-      // Convert offsets to lengths.
-      for (auto i = 0; i < bits.values_read; ++i) {
-        lengths[i] = lengths[i + 1] - lengths[i];
-      }
-      break;
-    }
-    case LevelMode::kStructOverLists: {
-      DefRepLevelsToBitmap(
+          maxItems,
+          lengths,
+          nulls,
+          nullsStartIndex);
+    case LevelMode::kStructOverLists:
+      return NestedStructureDecoder::readStructNulls(
           definitionLevels_.data() + begin,
           repetitionLevels_.data() + begin,
           end - begin,
           info,
-          &bits);
-      break;
-    }
+          maxItems,
+          nulls,
+          nullsStartIndex);
   }
-  return bits.values_read;
+  VELOX_UNREACHABLE();
 }
 
 void PageReader::makeDecoder() {
@@ -646,6 +648,39 @@ void PageReader::makeDecoder() {
               "DELTA_BINARY_PACKED decoder only supports INT32 and INT64");
       }
       break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      if (parquetType != thrift::Type::BYTE_ARRAY) {
+        VELOX_UNSUPPORTED(
+            "DELTA_LENGTH_BYTE_ARRAY decoder only supports BYTE_ARRAY");
+      }
+      deltaLengthByteArrayDecoder_ =
+          std::make_unique<DeltaLengthByteArrayDecoder>(
+              pageData_, pageData_ + encodedDataSize_);
+      break;
+    case Encoding::DELTA_BYTE_ARRAY:
+      if (parquetType != thrift::Type::BYTE_ARRAY) {
+        VELOX_UNSUPPORTED("DELTA_BYTE_ARRAY decoder only supports BYTE_ARRAY");
+      }
+      deltaByteArrayDecoder_ = std::make_unique<DeltaByteArrayDecoder>(
+          pageData_, pageData_ + encodedDataSize_);
+      break;
+    case Encoding::BYTE_STREAM_SPLIT:
+      switch (parquetType) {
+        case thrift::Type::INT32:
+        case thrift::Type::INT64:
+        case thrift::Type::FLOAT:
+        case thrift::Type::DOUBLE:
+          byteStreamSplitDecoder_ = std::make_unique<ByteStreamSplitDecoder>(
+              pageData_,
+              pageData_ + encodedDataSize_,
+              parquetTypeBytes(parquetType));
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "BYTE_STREAM_SPLIT decoder only supports INT32, INT64, FLOAT "
+              "and DOUBLE");
+      }
+      break;
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
@@ -672,6 +707,12 @@ void PageReader::skip(int64_t numRows) {
   // Skip the decoder
   if (isDictionary()) {
     dictionaryIdDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+    deltaLengthByteArrayDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::DELTA_BYTE_ARRAY) {
+    deltaByteArrayDecoder_->skip(toSkip);
+  } else if (isByteStreamSplit()) {
+    byteStreamSplitDecoder_->skip(toSkip);
   } else if (directDecoder_) {
     directDecoder_->skip(toSkip);
   } else if (stringDecoder_) {
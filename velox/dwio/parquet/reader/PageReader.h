@@ -22,7 +22,10 @@
 #include "velox/dwio/common/SelectiveColumnReader.h"
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaLengthByteArrayDecoder.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/reader/RleBpDataDecoder.h"
 #include "velox/dwio/parquet/reader/StringDecoder.h"
@@ -41,9 +44,11 @@ class PageReader {
       memory::MemoryPool& pool,
       ParquetTypeWithIdPtr fileType,
       common::CompressionKind codec,
-      int64_t chunkSize)
+      int64_t chunkSize,
+      io::IoStatistics* ioStats = nullptr)
       : pool_(pool),
         inputStream_(std::move(stream)),
+        ioStats_(ioStats),
         type_(std::move(fileType)),
         maxRepeat_(type_->maxRepeat_),
         maxDefine_(type_->maxDefine_),
@@ -127,6 +132,10 @@ class PageReader {
     return encoding_ == thrift::Encoding::DELTA_BINARY_PACKED;
   }
 
+  bool isByteStreamSplit() const {
+    return encoding_ == thrift::Encoding::BYTE_STREAM_SPLIT;
+  }
+
   /// Returns the range of repdefs for the top level rows covered by the last
   /// decoderepDefs().
   std::pair<int32_t, int32_t> repDefRange() const {
@@ -137,6 +146,11 @@ class PageReader {
   // bufferEnd_ to the corresponding positions.
   thrift::PageHeader readPageHeader();
 
+  /// Reads the dictionary page at the start of the column chunk without
+  /// reading any data page. Returns nullptr if the column chunk does not
+  /// start with a dictionary page.
+  const dwio::common::DictionaryValues* readDictionaryPage();
+
  private:
   // Indicates that we only want the repdefs for the next page. Used when
   // prereading repdefs with seekToPage.
@@ -268,6 +282,9 @@ class PageReader {
       } else if (encoding_ == thrift::Encoding::DELTA_BINARY_PACKED) {
         nullsFromFastPath = false;
         deltaBpDecoder_->readWithVisitor<true>(nulls, visitor);
+      } else if (isByteStreamSplit()) {
+        nullsFromFastPath = false;
+        readByteStreamSplit<true>(nulls, visitor);
       } else {
         directDecoder_->readWithVisitor<true>(
             nulls, visitor, nullsFromFastPath);
@@ -278,6 +295,8 @@ class PageReader {
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
       } else if (encoding_ == thrift::Encoding::DELTA_BINARY_PACKED) {
         deltaBpDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (isByteStreamSplit()) {
+        readByteStreamSplit<false>(nulls, visitor);
       } else {
         directDecoder_->readWithVisitor<false>(
             nulls, visitor, !this->type_->type()->isShortDecimal());
@@ -297,6 +316,12 @@ class PageReader {
         nullsFromFastPath = dwio::common::useFastPath<Visitor, true>(visitor);
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<true>(nulls, dictVisitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        nullsFromFastPath = false;
+        deltaLengthByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
+        nullsFromFastPath = false;
+        deltaByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
       } else {
         nullsFromFastPath = false;
         stringDecoder_->readWithVisitor<true>(nulls, visitor);
@@ -305,12 +330,38 @@ class PageReader {
       if (isDictionary()) {
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        deltaLengthByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
+        deltaByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         stringDecoder_->readWithVisitor<false>(nulls, visitor);
       }
     }
   }
 
+  // Reads BYTE_STREAM_SPLIT values of the physical type of the column.
+  template <bool hasNulls, typename Visitor>
+  void readByteStreamSplit(const uint64_t* nulls, Visitor visitor) {
+    if constexpr (std::is_floating_point_v<typename Visitor::DataType>) {
+      if (type_->parquetType_ == thrift::Type::FLOAT) {
+        byteStreamSplitDecoder_->readWithVisitor<float, hasNulls>(
+            nulls, visitor);
+      } else {
+        byteStreamSplitDecoder_->readWithVisitor<double, hasNulls>(
+            nulls, visitor);
+      }
+    } else {
+      if (type_->parquetType_ == thrift::Type::INT32) {
+        byteStreamSplitDecoder_->readWithVisitor<int32_t, hasNulls>(
+            nulls, visitor);
+      } else {
+        byteStreamSplitDecoder_->readWithVisitor<int64_t, hasNulls>(
+            nulls, visitor);
+      }
+    }
+  }
+
   template <
       typename Visitor,
       typename std::enable_if<
@@ -343,6 +394,8 @@ class PageReader {
   memory::MemoryPool& pool_;
 
   std::unique_ptr<dwio::common::SeekableInputStream> inputStream_;
+  // Records the bytes of pages decompressed by a HardwareDecompressor.
+  io::IoStatistics* const ioStats_{nullptr};
   ParquetTypeWithIdPtr type_;
   const int32_t maxRepeat_;
   const int32_t maxDefine_;
@@ -355,11 +408,11 @@ class PageReader {
   BufferPtr tempNulls_;
   BufferPtr nullsInReadRange_;
   BufferPtr multiPageNulls_;
-  // Decoder for single bit definition levels. the arrow decoders are used for
-  // multibit levels pending fixing RleBpDecoder for the case.
+  // Decoder for single bit definition levels.
   std::unique_ptr<RleBpDecoder> defineDecoder_;
-  std::unique_ptr<::arrow::util::RleDecoder> repeatDecoder_;
-  std::unique_ptr<::arrow::util::RleDecoder> wideDefineDecoder_;
+  // Decoders for multibit levels, which are decoded for whole pages.
+  std::unique_ptr<RleBpDecoder> repeatDecoder_;
+  std::unique_ptr<RleBpDecoder> wideDefineDecoder_;
 
   // True for a leaf column for which repdefs are loaded for the whole column
   // chunk. This is typically the leaftmost leaf of a list. Other leaves under
@@ -479,6 +532,9 @@ class PageReader {
   std::unique_ptr<StringDecoder> stringDecoder_;
   std::unique_ptr<BooleanDecoder> booleanDecoder_;
   std::unique_ptr<DeltaBpDecoder> deltaBpDecoder_;
+  std::unique_ptr<DeltaLengthByteArrayDecoder> deltaLengthByteArrayDecoder_;
+  std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrayDecoder_;
+  std::unique_ptr<ByteStreamSplitDecoder> byteStreamSplitDecoder_;
   // Add decoders for other encodings here.
 };
 
@@ -20,6 +20,31 @@
 
 namespace facebook::velox::parquet {
 
+namespace {
+template <typename T>
+bool anyValuePasses(
+    const dwio::common::DictionaryValues& dictionary,
+    const common::Filter& filter) {
+  const auto* values = dictionary.values->as<T>();
+  for (auto i = 0; i < dictionary.numValues; ++i) {
+    bool passes;
+    if constexpr (std::is_same_v<T, StringView>) {
+      passes = filter.testBytes(values[i].data(), values[i].size());
+    } else if constexpr (std::is_same_v<T, float>) {
+      passes = filter.testFloat(values[i]);
+    } else if constexpr (std::is_same_v<T, double>) {
+      passes = filter.testDouble(values[i]);
+    } else {
+      passes = filter.testInt64(values[i]);
+    }
+    if (passes) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
     const common::ScanSpec& /*scanSpec*/) {
@@ -80,6 +105,115 @@ bool ParquetData::rowGroupMatches(uint32_t rowGroupId, common::Filter* filter) {
   return true;
 }
 
+std::optional<std::vector<RowRange>> ParquetData::filterPages(
+    uint32_t index,
+    common::Filter* filter,
+    dwio::common::BufferedInput& input,
+    int64_t& numSkippedPages) const {
+  auto rowGroup = fileMetaDataPtr_.rowGroup(index);
+  auto columnChunk = rowGroup.columnChunk(type_->column());
+  if (!columnChunk.hasPageIndex()) {
+    return std::nullopt;
+  }
+  auto pageIndex = PageIndex::read(columnChunk, rowGroup.numRows(), input);
+  return pageIndex->filterPages(filter, type_->type(), numSkippedPages);
+}
+
+bool ParquetData::dictionaryMatches(
+    uint32_t index,
+    common::Filter* filter,
+    dwio::common::BufferedInput& input) const {
+  if (filter->testNull() || !type_->parquetType_.has_value()) {
+    return true;
+  }
+  switch (filter->kind()) {
+    case common::FilterKind::kAlwaysTrue:
+    case common::FilterKind::kIsNotNull:
+      return true;
+    default:
+      break;
+  }
+  // The type of the values in the dictionary after prepareDictionary().
+  const auto& type = type_->type();
+  const auto parquetType = type_->parquetType_.value();
+  TypeKind valueKind;
+  if (type->isShortDecimal()) {
+    valueKind = TypeKind::BIGINT;
+  } else if (type->isLongDecimal()) {
+    return true;
+  } else {
+    switch (type->kind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+        if (parquetType != thrift::Type::INT32) {
+          return true;
+        }
+        valueKind = TypeKind::INTEGER;
+        break;
+      case TypeKind::BIGINT:
+        if (parquetType != thrift::Type::INT64) {
+          return true;
+        }
+        valueKind = TypeKind::BIGINT;
+        break;
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+        if (parquetType != thrift::Type::FLOAT &&
+            parquetType != thrift::Type::DOUBLE) {
+          return true;
+        }
+        valueKind = parquetType == thrift::Type::FLOAT ? TypeKind::REAL
+                                                       : TypeKind::DOUBLE;
+        break;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        if (parquetType != thrift::Type::BYTE_ARRAY) {
+          return true;
+        }
+        valueKind = TypeKind::VARCHAR;
+        break;
+      default:
+        return true;
+    }
+  }
+
+  auto columnChunk =
+      fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
+  if (!columnChunk.isFullyDictionaryEncoded()) {
+    return true;
+  }
+  const auto offset = columnChunk.dictionaryPageOffset();
+  const auto length = columnChunk.dataPageOffset() - offset;
+  if (offset < 4 || length <= 0) {
+    return true;
+  }
+  PageReader reader(
+      input.read(offset, length, dwio::common::LogType::STREAM),
+      pool_,
+      type_,
+      columnChunk.compression(),
+      length);
+  const auto* dictionary = reader.readDictionaryPage();
+  if (!dictionary) {
+    return true;
+  }
+  switch (valueKind) {
+    case TypeKind::INTEGER:
+      return anyValuePasses<int32_t>(*dictionary, *filter);
+    case TypeKind::BIGINT:
+      return anyValuePasses<int64_t>(*dictionary, *filter);
+    case TypeKind::REAL:
+      return anyValuePasses<float>(*dictionary, *filter);
+    case TypeKind::DOUBLE:
+      return anyValuePasses<double>(*dictionary, *filter);
+    case TypeKind::VARCHAR:
+      return anyValuePasses<StringView>(*dictionary, *filter);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
 void ParquetData::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
@@ -104,6 +238,9 @@ void ParquetData::enqueueRowGroup(
 
   auto id = dwio::common::StreamIdentifier(type_->column());
   streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
+  if (input.getInputStream() != nullptr) {
+    ioStats_ = input.getInputStream()->getStats();
+  }
 }
 
 dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
@@ -116,7 +253,8 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
       pool_,
       type_,
       metadata.compression(),
-      metadata.totalCompressedSize());
+      metadata.totalCompressedSize(),
+      ioStats_);
   return dwio::common::PositionProvider(empty);
 }
 
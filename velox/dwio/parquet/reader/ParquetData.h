@@ -18,6 +18,7 @@
 
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/parquet/reader/Metadata.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/PageReader.h"
 
 namespace facebook::velox::common {
@@ -73,6 +74,25 @@ class ParquetData : public dwio::common::FormatData {
       const dwio::common::StatsContext& writerContext,
       FilterRowGroupsResult&) override;
 
+  /// Returns the rows of 'index'th row group that may pass 'filter' according
+  /// to the page index of the column chunk, which is read from 'input'.
+  /// Returns std::nullopt if the column chunk has no page index. Adds the
+  /// number of pages without such rows to 'numSkippedPages'.
+  std::optional<std::vector<RowRange>> filterPages(
+      uint32_t index,
+      common::Filter* filter,
+      dwio::common::BufferedInput& input,
+      int64_t& numSkippedPages) const;
+
+  /// Returns false if the column chunk of 'index'th row group is fully
+  /// dictionary encoded and no value in its dictionary passes 'filter'. The
+  /// dictionary page is read from 'input'. Returns true if 'filter' may pass
+  /// nulls or the values of the column can not be tested this way.
+  bool dictionaryMatches(
+      uint32_t index,
+      common::Filter* filter,
+      dwio::common::BufferedInput& input) const;
+
   PageReader* reader() const {
     return reader_.get();
   }
@@ -179,6 +199,10 @@ class ParquetData : public dwio::common::FormatData {
     return reader_->isDeltaBinaryPacked();
   }
 
+  bool isByteStreamSplit() const {
+    return reader_->isByteStreamSplit();
+  }
+
   bool parentNullsInLeaves() const override {
     return true;
   }
@@ -195,6 +219,8 @@ class ParquetData : public dwio::common::FormatData {
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
   const FileMetaDataPtr fileMetaDataPtr_;
+  // IO statistics of the file, nullptr if none.
+  io::IoStatistics* ioStats_{nullptr};
   // Streams for this column in each of 'rowGroups_'. Will be created on or
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
@@ -16,8 +16,14 @@
 
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 
+#include <chrono>
+#include <limits>
+
 #include <thrift/protocol/TCompactProtocol.h> //@manual
 
+#include "velox/dwio/common/AdaptivePrefetchPolicy.h"
+#include "velox/dwio/common/FileMetadataCache.h"
+#include "velox/dwio/parquet/reader/BloomFilter.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
@@ -26,6 +32,28 @@ namespace facebook::velox::parquet {
 
 using dwio::common::ColumnSelector;
 
+namespace {
+// Parsed FileMetaData shared through dwio::common::FileMetadataCache.
+struct CachedFileMetaData : public dwio::common::FileMetadataCache::Entry {
+  thrift::FileMetaData metaData;
+};
+
+// Estimated ratio of the memory of a parsed FileMetaData to the size of its
+// compact thrift encoding.
+constexpr uint64_t kParsedFileMetaDataRatio = 4;
+
+uint64_t rowGroupCompressedSize(const thrift::RowGroup& rowGroup) {
+  if (rowGroup.__isset.total_compressed_size) {
+    return rowGroup.total_compressed_size;
+  }
+  uint64_t size = 0;
+  for (const auto& column : rowGroup.columns) {
+    size += column.meta_data.total_compressed_size;
+  }
+  return size;
+}
+} // namespace
+
 /// Metadata and options for reading Parquet.
 class ReaderBase {
  public:
@@ -67,12 +95,23 @@ class ReaderBase {
     return options_.isFileColumnNamesReadAsLowerCase();
   }
 
+  int64_t prefetchRowGroups() const {
+    return options_.prefetchRowGroups();
+  }
+
+  bool adaptivePrefetchRowGroups() const {
+    return options_.adaptivePrefetchRowGroups();
+  }
+
   /// Ensures that streams are enqueued and loading for the row group at
-  /// 'currentGroup'. May start loading one or more subsequent groups.
+  /// 'currentGroup'. May start loading one or more subsequent groups. Their
+  /// number is chosen by 'prefetchPolicy' if not nullptr, which is told how
+  /// long the loads take.
   void scheduleRowGroups(
       const std::vector<uint32_t>& groups,
       int32_t currentGroup,
-      StructColumnReader& reader);
+      StructColumnReader& reader,
+      dwio::common::AdaptivePrefetchPolicy* prefetchPolicy = nullptr);
 
   /// Returns the uncompressed size for columns in 'type' and its children in
   /// row group.
@@ -84,10 +123,26 @@ class ReaderBase {
   /// the data still exists in the buffered inputs.
   bool isRowGroupBuffered(int32_t rowGroupIndex) const;
 
+  /// Reads the bloom filter at 'offset'. Returns nullptr if it is not a split
+  /// block filter of XXH64 hashes without compression, which is the only
+  /// kind specified by Parquet.
+  std::unique_ptr<BloomFilter> readBloomFilter(int64_t offset) const;
+
  private:
   // Reads and parses file footer.
   void loadFileMetaData();
 
+  // Keeps the bytes of the bloom filters in 'tail', which has the bytes of
+  // the file from 'tailOffset' to the footer, so that reading them needs no
+  // more IO. Writers place the bloom filters after the row groups.
+  void retainBloomFilters(const std::vector<char>& tail, uint64_t tailOffset);
+
+  // Returns a stream over 'length' bytes at 'offset', which are served from
+  // 'bloomFilterBytes_' if it covers them.
+  std::unique_ptr<dwio::common::SeekableInputStream> readBloomFilterBytes(
+      uint64_t offset,
+      uint64_t length) const;
+
   void initializeSchema();
 
   std::unique_ptr<ParquetTypeWithId> getParquetColumnInfo(
@@ -112,9 +167,14 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  // Shared with other readers of the file if the file metadata cache is used.
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData_;
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
+  // Bytes of the file from 'bloomFilterBytesOffset_' to the footer if these
+  // were read with the footer and have bloom filters.
+  std::vector<char> bloomFilterBytes_;
+  uint64_t bloomFilterBytesOffset_{0};
 
   const bool binaryAsString = false;
 
@@ -144,6 +204,21 @@ void ReaderBase::loadFileMetaData() {
       fileLength_ <= std::max(filePreloadThreshold_, footerEstimatedSize_);
   uint64_t readSize = preloadFile ? fileLength_ : footerEstimatedSize_;
 
+  auto* metadataCache = dwio::common::FileMetadataCache::getInstance();
+  const auto fileName =
+      metadataCache != nullptr ? input_->getReadFile()->getName() : "";
+  if (!fileName.empty()) {
+    if (auto cached =
+            metadataCache->get<CachedFileMetaData>(fileName, fileLength_)) {
+      fileMetaData_ = std::shared_ptr<const thrift::FileMetaData>(
+          cached, &cached->metaData);
+      if (preloadFile) {
+        input_->loadCompleteFile();
+      }
+      return;
+    }
+  }
+
   std::unique_ptr<dwio::common::SeekableInputStream> stream;
   if (preloadFile) {
     stream = input_->loadCompleteFile();
@@ -186,8 +261,21 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto parsed = std::make_shared<CachedFileMetaData>();
+  parsed->metaData.read(thriftProtocol.get());
+  fileMetaData_ =
+      std::shared_ptr<const thrift::FileMetaData>(parsed, &parsed->metaData);
+  if (!preloadFile && footerOffsetInBuffer > 0) {
+    copy.resize(footerOffsetInBuffer);
+    retainBloomFilters(copy, fileLength_ - readSize);
+  }
+  if (!fileName.empty()) {
+    metadataCache->put(
+        fileName,
+        fileLength_,
+        std::move(parsed),
+        kParsedFileMetaDataRatio * footerLength);
+  }
 }
 
 void ReaderBase::initializeSchema() {
@@ -638,14 +726,24 @@ std::shared_ptr<const RowType> ReaderBase::createRowType(
 void ReaderBase::scheduleRowGroups(
     const std::vector<uint32_t>& rowGroupIds,
     int32_t currentGroup,
-    StructColumnReader& reader) {
+    StructColumnReader& reader,
+    dwio::common::AdaptivePrefetchPolicy* prefetchPolicy) {
+  const int64_t numPrefetch = prefetchPolicy
+      ? prefetchPolicy->depth()
+      : options_.prefetchRowGroups();
   auto numRowGroupsToLoad = std::min(
-      options_.prefetchRowGroups() + 1,
+      numPrefetch + 1,
       static_cast<int64_t>(rowGroupIds.size() - currentGroup));
   for (auto i = 0; i < numRowGroupsToLoad; i++) {
     auto thisGroup = rowGroupIds[currentGroup + i];
     if (!inputs_[thisGroup]) {
+      const auto startTime = std::chrono::high_resolution_clock::now();
       inputs_[thisGroup] = reader.loadRowGroup(thisGroup, input_);
+      if (prefetchPolicy) {
+        prefetchPolicy->recordLoad(
+            rowGroupCompressedSize(fileMetaData_->row_groups[thisGroup]),
+            std::chrono::high_resolution_clock::now() - startTime);
+      }
     }
   }
 
@@ -676,6 +774,72 @@ bool ReaderBase::isRowGroupBuffered(int32_t rowGroupIndex) const {
   return inputs_.count(rowGroupIndex) != 0;
 }
 
+void ReaderBase::retainBloomFilters(
+    const std::vector<char>& tail,
+    uint64_t tailOffset) {
+  const uint64_t tailEnd = tailOffset + tail.size();
+  auto firstOffset = tailEnd;
+  for (const auto& rowGroup : fileMetaData_->row_groups) {
+    for (const auto& column : rowGroup.columns) {
+      if (!column.meta_data.__isset.bloom_filter_offset) {
+        continue;
+      }
+      const auto offset = column.meta_data.bloom_filter_offset;
+      if (offset >= tailOffset && offset < firstOffset) {
+        firstOffset = offset;
+      }
+    }
+  }
+  if (firstOffset == tailEnd) {
+    return;
+  }
+  bloomFilterBytes_.assign(
+      tail.begin() + (firstOffset - tailOffset), tail.end());
+  bloomFilterBytesOffset_ = firstOffset;
+}
+
+std::unique_ptr<dwio::common::SeekableInputStream>
+ReaderBase::readBloomFilterBytes(uint64_t offset, uint64_t length) const {
+  if (offset >= bloomFilterBytesOffset_ &&
+      offset + length <= bloomFilterBytesOffset_ + bloomFilterBytes_.size()) {
+    return std::make_unique<dwio::common::SeekableArrayInputStream>(
+        bloomFilterBytes_.data() + (offset - bloomFilterBytesOffset_), length);
+  }
+  return input_->read(offset, length, dwio::common::LogType::STRIPE_INDEX);
+}
+
+std::unique_ptr<BloomFilter> ReaderBase::readBloomFilter(int64_t offset) const {
+  VELOX_CHECK_GE(offset, 0);
+  VELOX_CHECK_LT(offset, fileLength_);
+  auto stream = readBloomFilterBytes(
+      offset,
+      std::min<uint64_t>(BloomFilter::kMaxHeaderSize, fileLength_ - offset));
+  const void* buffer;
+  int32_t size;
+  VELOX_CHECK(stream->Next(&buffer, &size), "Empty bloom filter stream");
+  auto bufferStart = reinterpret_cast<const char*>(buffer);
+  auto bufferEnd = bufferStart + size;
+  std::shared_ptr<thrift::ThriftTransport> transport =
+      std::make_shared<thrift::ThriftStreamingTransport>(
+          stream.get(), bufferStart, bufferEnd);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  thrift::BloomFilterHeader header;
+  const auto headerSize = header.read(&protocol);
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED || header.numBytes <= 0 ||
+      header.numBytes % BloomFilter::kBytesPerBlock != 0) {
+    return nullptr;
+  }
+  std::vector<uint32_t> bitset(header.numBytes / sizeof(uint32_t));
+  stream = readBloomFilterBytes(offset + headerSize, header.numBytes);
+  bufferStart = nullptr;
+  bufferEnd = nullptr;
+  dwio::common::readBytes(
+      header.numBytes, stream.get(), bitset.data(), bufferStart, bufferEnd);
+  return std::make_unique<BloomFilter>(std::move(bitset));
+}
+
 namespace {
 struct ParquetStatsContext : dwio::common::StatsContext {};
 } // namespace
@@ -693,6 +857,10 @@ class ParquetRowReader::Impl {
         currentRowGroupPtr_{nullptr},
         rowsInCurrentRowGroup_{0},
         currentRowInGroup_{0} {
+    if (readerBase_->adaptivePrefetchRowGroups()) {
+      prefetchPolicy_ = std::make_unique<dwio::common::AdaptivePrefetchPolicy>(
+          readerBase_->prefetchRowGroups(), &pool_);
+    }
     // Validate the requested type is compatible with what's in the file
     std::function<std::string()> createExceptionContext = [&]() {
       std::string exceptionMessageContext = fmt::format(
@@ -737,6 +905,8 @@ class ParquetRowReader::Impl {
     if (auto& metadataFilter = options_.getMetadataFilter()) {
       metadataFilter->eval(res.metadataFilterResults, res.filterResult);
     }
+    std::vector<BloomFilterColumn> bloomFilterColumns;
+    collectBloomFilterColumns(*columnReader_, bloomFilterColumns);
 
     uint64_t rowNumber = 0;
     for (auto i = 0; i < rowGroups_.size(); i++) {
@@ -758,6 +928,16 @@ class ParquetRowReader::Impl {
       // Add a row group to read if it is within range and not empty and not in
       // the excluded list.
       if (rowGroupInRange && !isExcluded && !isEmpty) {
+        if (excludedByBloomFilter(rowGroups_[i], bloomFilterColumns)) {
+          ++skippedStridesByBloomFilter_;
+          rowNumber += rowGroups_[i].num_rows;
+          continue;
+        }
+        if (excludedByDictionary(i, *columnReader_)) {
+          ++skippedStridesByDictionary_;
+          rowNumber += rowGroups_[i].num_rows;
+          continue;
+        }
         rowGroupIds_.push_back(i);
         firstRowOfRowGroup_.push_back(rowNumber);
       }
@@ -766,9 +946,10 @@ class ParquetRowReader::Impl {
   }
 
   int64_t nextRowNumber() {
-    if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
-        !advanceToNextRowGroup()) {
-      return kAtEnd;
+    while (!skipToRowRange()) {
+      if (!advanceToNextRowGroup()) {
+        return kAtEnd;
+      }
     }
     return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] + currentRowInGroup_;
   }
@@ -778,7 +959,8 @@ class ParquetRowReader::Impl {
     if (nextRowNumber() == kAtEnd) {
       return kAtEnd;
     }
-    return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+    return std::min<uint64_t>(
+        size, rowRanges_[currentRowRange_].end - currentRowInGroup_);
   }
 
   uint64_t next(
@@ -806,6 +988,13 @@ class ParquetRowReader::Impl {
 
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const {
     stats.skippedStrides += rowGroups_.size() - rowGroupIds_.size();
+    stats.skippedStridesByBloomFilter += skippedStridesByBloomFilter_;
+    stats.skippedStridesByDictionary += skippedStridesByDictionary_;
+    stats.skippedPages += skippedPages_;
+    if (prefetchPolicy_) {
+      stats.maxPrefetchDepth = std::max<int64_t>(
+          stats.maxPrefetchDepth, prefetchPolicy_->maxChosenDepth());
+    }
   }
 
   void resetFilterCaches() {
@@ -823,15 +1012,162 @@ class ParquetRowReader::Impl {
     }
 
     auto nextRowGroupIndex = rowGroupIds_[nextRowGroupIdsIdx_];
+    if (prefetchPolicy_ && readStartTime_.has_value()) {
+      prefetchPolicy_->recordRead(
+          std::chrono::high_resolution_clock::now() - *readStartTime_);
+    }
     readerBase_->scheduleRowGroups(
         rowGroupIds_,
         nextRowGroupIdsIdx_,
-        static_cast<StructColumnReader&>(*columnReader_));
+        static_cast<StructColumnReader&>(*columnReader_),
+        prefetchPolicy_.get());
     currentRowGroupPtr_ = &rowGroups_[rowGroupIds_[nextRowGroupIdsIdx_]];
     rowsInCurrentRowGroup_ = currentRowGroupPtr_->num_rows;
     currentRowInGroup_ = 0;
     nextRowGroupIdsIdx_++;
     columnReader_->seekToRowGroup(nextRowGroupIndex);
+    rowRanges_ = {{0, static_cast<int64_t>(rowsInCurrentRowGroup_)}};
+    currentRowRange_ = 0;
+    filterPages(nextRowGroupIndex, *columnReader_);
+    // The time to read the first row group includes the wait of a preloaded
+    // split for a driver, so the read time is measured from the second.
+    if (prefetchPolicy_ && nextRowGroupIdsIdx_ > 1) {
+      readStartTime_ = std::chrono::high_resolution_clock::now();
+    }
+    return true;
+  }
+
+  // Leaf column with a filter whose values can be tested against the bloom
+  // filters of its column chunks.
+  struct BloomFilterColumn {
+    uint32_t column;
+    std::vector<uint64_t> hashes;
+  };
+
+  // Adds the leaf columns under 'reader' whose filters pass only values that
+  // can be looked up in a bloom filter to 'columns'. Leaves under lists and
+  // maps are not considered since their filters do not select top level rows.
+  void collectBloomFilterColumns(
+      const dwio::common::SelectiveColumnReader& reader,
+      std::vector<BloomFilterColumn>& columns) const {
+    for (auto* child : reader.children()) {
+      if (!child) {
+        continue;
+      }
+      const auto kind = child->fileType().type()->kind();
+      if (kind == TypeKind::ROW) {
+        collectBloomFilterColumns(*child, columns);
+        continue;
+      }
+      if (kind == TypeKind::ARRAY || kind == TypeKind::MAP) {
+        continue;
+      }
+      const auto& type =
+          static_cast<const ParquetTypeWithId&>(child->fileType());
+      auto hashes =
+          BloomFilter::filterHashes(child->scanSpec()->filter(), type);
+      if (hashes.has_value()) {
+        columns.push_back({type.column(), std::move(hashes.value())});
+      }
+    }
+  }
+
+  // Returns true if the bloom filter of a column chunk of 'rowGroup' in
+  // 'columns' has none of the values that pass the filter on the column.
+  bool excludedByBloomFilter(
+      const thrift::RowGroup& rowGroup,
+      const std::vector<BloomFilterColumn>& columns) const {
+    for (const auto& column : columns) {
+      VELOX_CHECK_LT(column.column, rowGroup.columns.size());
+      const auto& metaData = rowGroup.columns[column.column].meta_data;
+      if (!metaData.__isset.bloom_filter_offset) {
+        continue;
+      }
+      auto bloomFilter =
+          readerBase_->readBloomFilter(metaData.bloom_filter_offset);
+      if (bloomFilter && !bloomFilter->testHashes(column.hashes)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Returns true if no value in the dictionary of a fully dictionary encoded
+  // column chunk of 'index'th row group passes the filter on a leaf column
+  // under 'reader'. Leaves under lists and maps are not considered since
+  // their filters do not select top level rows.
+  bool excludedByDictionary(
+      uint32_t index,
+      const dwio::common::SelectiveColumnReader& reader) const {
+    for (auto* child : reader.children()) {
+      if (!child) {
+        continue;
+      }
+      const auto kind = child->fileType().type()->kind();
+      if (kind == TypeKind::ROW) {
+        if (excludedByDictionary(index, *child)) {
+          return true;
+        }
+        continue;
+      }
+      auto* filter = child->scanSpec()->filter();
+      if (!filter || kind == TypeKind::ARRAY || kind == TypeKind::MAP) {
+        continue;
+      }
+      if (!child->formatData().as<ParquetData>().dictionaryMatches(
+              index, filter, readerBase_->bufferedInput())) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Intersects 'rowRanges_' with the rows of 'index'th row group that may
+  // pass the filters on the leaf columns under 'reader' according to their
+  // page index. Leaves under lists and maps are not considered since their
+  // filters do not select top level rows.
+  void filterPages(
+      uint32_t index,
+      const dwio::common::SelectiveColumnReader& reader) {
+    for (auto* child : reader.children()) {
+      if (!child || rowRanges_.empty()) {
+        continue;
+      }
+      const auto kind = child->fileType().type()->kind();
+      if (kind == TypeKind::ROW) {
+        filterPages(index, *child);
+        continue;
+      }
+      auto* filter = child->scanSpec()->filter();
+      if (!filter || kind == TypeKind::ARRAY || kind == TypeKind::MAP) {
+        continue;
+      }
+      auto ranges = child->formatData().as<ParquetData>().filterPages(
+          index, filter, readerBase_->bufferedInput(), skippedPages_);
+      if (ranges.has_value()) {
+        rowRanges_ = intersectRowRanges(rowRanges_, ranges.value());
+      }
+    }
+  }
+
+  // Moves 'currentRowInGroup_' to the first row from it on in 'rowRanges_'.
+  // The column readers skip the rows in between on their next read, which
+  // skips the pages that have only such rows without decompressing them.
+  // Returns false if there is no such row in the current row group.
+  bool skipToRowRange() {
+    const auto row = static_cast<int64_t>(currentRowInGroup_);
+    while (currentRowRange_ < rowRanges_.size() &&
+           rowRanges_[currentRowRange_].end <= row) {
+      ++currentRowRange_;
+    }
+    if (currentRowRange_ == rowRanges_.size()) {
+      return false;
+    }
+    const auto begin = rowRanges_[currentRowRange_].begin;
+    if (begin > row) {
+      columnReader_->setReadOffset(begin);
+      currentRowInGroup_ = begin;
+    }
     return true;
   }
 
@@ -848,6 +1184,21 @@ class ParquetRowReader::Impl {
   const thrift::RowGroup* currentRowGroupPtr_{nullptr};
   uint64_t rowsInCurrentRowGroup_;
   uint64_t currentRowInGroup_;
+  // Rows of the current row group that may pass the filters according to the
+  // page index. All rows of the row group if there is no page index.
+  std::vector<RowRange> rowRanges_;
+  // Index of the first range in 'rowRanges_' that ends after
+  // 'currentRowInGroup_'.
+  size_t currentRowRange_{0};
+  int64_t skippedStridesByBloomFilter_{0};
+  int64_t skippedStridesByDictionary_{0};
+  int64_t skippedPages_{0};
+
+  // Chooses the number of row groups to prefetch if it adapts to the load and
+  // read times of the row groups.
+  std::unique_ptr<dwio::common::AdaptivePrefetchPolicy> prefetchPolicy_;
+  // When the reading of the current row group started.
+  std::optional<std::chrono::high_resolution_clock::time_point> readStartTime_;
 
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
@@ -907,6 +1258,68 @@ std::optional<uint64_t> ParquetReader::numberOfRows() const {
   return readerBase_->thriftFileMetaData().num_rows;
 }
 
+std::unique_ptr<dwio::common::ColumnStatistics>
+ParquetReader::columnStatistics(uint32_t index) const {
+  const ParquetTypeWithId* column = nullptr;
+  for (const auto& child : typeWithId()->getChildren()) {
+    if (child->id() == index) {
+      column = static_cast<const ParquetTypeWithId*>(child.get());
+      break;
+    }
+  }
+  if (column == nullptr || !column->isLeaf()) {
+    return nullptr;
+  }
+  const auto fileMetaData = readerBase_->fileMetaData();
+  uint64_t valueCount = 0;
+  bool hasNull = false;
+  std::optional<int64_t> min;
+  std::optional<int64_t> max;
+  bool hasMinMax = column->type()->isPrimitiveType() &&
+      !column->type()->isDecimal() &&
+      (column->type()->kind() == TypeKind::TINYINT ||
+       column->type()->kind() == TypeKind::SMALLINT ||
+       column->type()->kind() == TypeKind::INTEGER ||
+       column->type()->kind() == TypeKind::BIGINT);
+  for (auto i = 0; i < fileMetaData.numRowGroups(); ++i) {
+    auto rowGroup = fileMetaData.rowGroup(i);
+    auto chunk = rowGroup.columnChunk(column->column());
+    if (!chunk.hasStatistics()) {
+      return nullptr;
+    }
+    auto stats = chunk.getColumnStatistics(column->type(), rowGroup.numRows());
+    if (!stats->getNumberOfValues().has_value() ||
+        !stats->hasNull().has_value()) {
+      return nullptr;
+    }
+    valueCount += stats->getNumberOfValues().value();
+    hasNull |= stats->hasNull().value();
+    if (!hasMinMax || stats->getNumberOfValues().value() == 0) {
+      continue;
+    }
+    auto* integerStats =
+        dynamic_cast<const dwio::common::IntegerColumnStatistics*>(
+            stats.get());
+    if (integerStats == nullptr || !integerStats->getMinimum().has_value() ||
+        !integerStats->getMaximum().has_value()) {
+      hasMinMax = false;
+      continue;
+    }
+    min = std::min(
+        min.value_or(std::numeric_limits<int64_t>::max()),
+        integerStats->getMinimum().value());
+    max = std::max(
+        max.value_or(std::numeric_limits<int64_t>::min()),
+        integerStats->getMaximum().value());
+  }
+  if (!hasMinMax) {
+    return std::make_unique<dwio::common::ColumnStatistics>(
+        valueCount, hasNull, std::nullopt, std::nullopt);
+  }
+  return std::make_unique<dwio::common::IntegerColumnStatistics>(
+      valueCount, hasNull, std::nullopt, std::nullopt, min, max, std::nullopt);
+}
+
 const velox::RowTypePtr& ParquetReader::rowType() const {
   return readerBase_->schema();
 }
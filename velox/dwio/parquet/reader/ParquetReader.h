@@ -90,10 +90,11 @@ class ParquetReader : public dwio::common::Reader {
 
   std::optional<uint64_t> numberOfRows() const override;
 
+  /// Returns the statistics of the top-level primitive column with node id
+  /// 'index' merged over all row groups, or nullptr if some row group has no
+  /// statistics for it. Only integer columns have a minimum and maximum.
   std::unique_ptr<dwio::common::ColumnStatistics> columnStatistics(
-      uint32_t index) const override {
-    return nullptr;
-  }
+      uint32_t index) const override;
 
   const velox::RowTypePtr& rowType() const override;
 
@@ -59,23 +59,13 @@ class RleBpDecoder {
           remainingUnpackedValuesOffset_ = 0;
           // The parquet standard requires the bit packed values are always a
           // multiple of 8. So we read a multiple of 8 values each time
-          dwio::common::unpack<T>(
-              reinterpret_cast<const uint8_t*&>(bufferStart_),
-              bufferEnd_ - bufferStart_,
-              numValuesToRead & 0xfffffff8,
-              bitWidth_,
-              reinterpret_cast<T * FOLLY_NONNULL&>(outputBuffer));
+          unpackBitPacked(outputBuffer, numValuesToRead & 0xfffffff8);
           remainingValues_ -= (numValuesToRead & 0xfffffff8);
 
           // Unpack the next 8 values to remainingUnpackedValues_ if necessary
           if ((numValuesToRead & 7) != 0) {
             T* output = reinterpret_cast<T*>(remainingUnpackedValues_);
-            dwio::common::unpack<T>(
-                reinterpret_cast<const uint8_t*&>(bufferStart_),
-                bufferEnd_ - bufferStart_,
-                8,
-                bitWidth_,
-                output);
+            unpackBitPacked(output, 8);
             numRemainingUnpackedValues_ = 8;
             remainingUnpackedValuesOffset_ = 0;
 
@@ -101,6 +91,47 @@ class RleBpDecoder {
  protected:
   void readHeader();
 
+  // Unpacks 'numValues' values, a multiple of 8, of the current bit packed
+  // run to 'output' and advances 'output' past them. Levels and dictionary
+  // indices are unpacked as unsigned, which have SIMD kernels. The kernels may
+  // load a word past their last value, so the values that end after
+  // 'lastSafeWord_' are unpacked one at a time.
+  template <typename T>
+  void unpackBitPacked(T* FOLLY_NONNULL& output, uint64_t numValues) {
+    VELOX_DCHECK_EQ(0, bitOffset_);
+    if (bitWidth_ == 0) {
+      std::fill(output, output + numValues, 0);
+      output += numValues;
+      return;
+    }
+    using TUnsigned = std::make_unsigned_t<T>;
+    auto input = reinterpret_cast<const uint8_t*>(bufferStart_);
+    auto result = reinterpret_cast<TUnsigned*>(output);
+    uint64_t numFast = 0;
+    if (bufferStart_ < lastSafeWord_) {
+      numFast = std::min<uint64_t>(
+          numValues, ((lastSafeWord_ - bufferStart_) * 8 / bitWidth_) & ~7ULL);
+    }
+    if (numFast > 0) {
+      dwio::common::unpack<TUnsigned>(
+          input, bufferEnd_ - bufferStart_, numFast, bitWidth_, result);
+    }
+    if (numFast < numValues) {
+      input = reinterpret_cast<const uint8_t*>(bufferStart_) +
+          numFast * bitWidth_ / 8;
+      result = reinterpret_cast<TUnsigned*>(output) + numFast;
+      dwio::common::unpackNaive<TUnsigned>(
+          input,
+          bufferEnd_ - reinterpret_cast<const char*>(input),
+          numValues - numFast,
+          bitWidth_,
+          result);
+    }
+    // Not all kernels leave 'input' after the last value.
+    bufferStart_ += numValues * bitWidth_ / 8;
+    output += numValues;
+  }
+
   template <typename T>
   inline void copyRemainingUnpackedValues(
       T* FOLLY_NONNULL& outputBuffer,
@@ -111,7 +142,7 @@ class RleBpDecoder {
         outputBuffer,
         reinterpret_cast<T*>(remainingUnpackedValues_) +
             remainingUnpackedValuesOffset_,
-        numValues);
+        numValues * sizeof(T));
 
     outputBuffer += numValues;
     numRemainingUnpackedValues_ -= numValues;
@@ -21,6 +21,8 @@
 
 #include <folly/Benchmark.h>
 
+#include <random>
+
 using namespace facebook::velox;
 using namespace facebook::velox::parquet;
 
@@ -90,6 +92,116 @@ BENCHMARK(randomDefs) {
   folly::doNotOptimizeAway(numCollections);
 }
 
+namespace {
+
+// Levels of the inner list of ARRAY<STRUCT<ARRAY<INTEGER>>> rows with up to
+// 'maxLength' structs and elements per list. A level is null with
+// 'nullPercent' probability.
+struct NestedLevels {
+  NestedLevels(int32_t numRows, int32_t maxLength, int32_t nullPercent) {
+    std::mt19937 rng(1);
+    auto isNull = [&]() { return rng() % 100 < nullPercent; };
+    for (auto row = 0; row < numRows; ++row) {
+      const auto numStructs = 1 + rng() % maxLength;
+      for (auto i = 0; i < numStructs; ++i) {
+        const int16_t structRep = i == 0 ? 0 : 1;
+        if (isNull()) {
+          defs.push_back(2);
+          reps.push_back(structRep);
+          continue;
+        }
+        const auto numElements = 1 + rng() % maxLength;
+        for (auto j = 0; j < numElements; ++j) {
+          defs.push_back(isNull() ? 5 : 6);
+          reps.push_back(j == 0 ? structRep : 2);
+        }
+      }
+    }
+    offsets.resize(defs.size() + 1);
+    lengths.resize(defs.size());
+    nulls.resize(bits::nwords(defs.size()));
+  }
+
+  std::vector<int16_t> defs;
+  std::vector<int16_t> reps;
+  std::vector<int32_t> offsets;
+  std::vector<int32_t> lengths;
+  std::vector<uint64_t> nulls;
+};
+
+// The inner list level: present elements at 5, empty lists at 4 and null
+// structs below 3.
+const arrow::LevelInfo kInnerList(1, 5, 2, 3);
+
+int32_t arrowLengths(NestedLevels& levels) {
+  arrow::ValidityBitmapInputOutput output;
+  output.values_read_upper_bound = levels.defs.size();
+  output.valid_bits = reinterpret_cast<uint8_t*>(levels.nulls.data());
+  output.valid_bits_offset = 0;
+  levels.offsets[0] = 0;
+  arrow::DefRepLevelsToList(
+      levels.defs.data(),
+      levels.reps.data(),
+      levels.defs.size(),
+      kInnerList,
+      &output,
+      levels.offsets.data());
+  for (auto i = 0; i < output.values_read; ++i) {
+    levels.lengths[i] = levels.offsets[i + 1] - levels.offsets[i];
+  }
+  return output.values_read;
+}
+
+int32_t simdLengths(NestedLevels& levels) {
+  return NestedStructureDecoder::readLengthsAndNulls(
+      levels.defs.data(),
+      levels.reps.data(),
+      levels.defs.size(),
+      kInnerList,
+      levels.defs.size(),
+      levels.lengths.data(),
+      levels.nulls.data(),
+      0);
+}
+
+void runLengths(
+    int32_t (*decode)(NestedLevels&),
+    int32_t maxLength,
+    int32_t nullPercent) {
+  folly::BenchmarkSuspender suspender;
+  NestedLevels levels(100'000, maxLength, nullPercent);
+  suspender.dismiss();
+  for (auto i = 0; i < 10; ++i) {
+    folly::doNotOptimizeAway(decode(levels));
+  }
+}
+
+} // namespace
+
+BENCHMARK(arrowShortListsWithNulls) {
+  runLengths(arrowLengths, 3, 10);
+}
+
+BENCHMARK_RELATIVE(simdShortListsWithNulls) {
+  runLengths(simdLengths, 3, 10);
+}
+
+BENCHMARK(arrowLongLists) {
+  runLengths(arrowLengths, 50, 0);
+}
+
+BENCHMARK_RELATIVE(simdLongLists) {
+  runLengths(simdLengths, 50, 0);
+}
+
+BENCHMARK(arrowSingleElementLists) {
+  runLengths(arrowLengths, 1, 0);
+}
+
+BENCHMARK_RELATIVE(simdSingleElementLists) {
+  runLengths(simdLengths, 1, 0);
+}
+
 int main(int /*argc*/, char** /*argv*/) {
   memory::MemoryManager::initialize({});
   folly::runBenchmarks();
@@ -21,6 +21,8 @@
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 using namespace facebook::velox;
 using namespace facebook::velox::parquet;
 
@@ -103,6 +105,125 @@ class NestedStructureDecoderTest : public testing::Test {
   }
 
   std::shared_ptr<memory::MemoryPool> pool_;
+
+ protected:
+  // Checks readLengthsAndNulls() and readStructNulls() against the arrow
+  // functions for the levels of 'info'.
+  void assertSameAsArrow(
+      const std::vector<int16_t>& defs,
+      const std::vector<int16_t>& reps,
+      const arrow::LevelInfo& info) {
+    const int32_t numLevels = defs.size();
+    std::vector<int32_t> offsets(numLevels + 1, 0);
+    std::vector<uint64_t> expectedNulls(bits::nwords(numLevels), 0);
+    arrow::ValidityBitmapInputOutput output;
+    output.values_read_upper_bound = numLevels;
+    output.valid_bits = reinterpret_cast<uint8_t*>(expectedNulls.data());
+    output.valid_bits_offset = 0;
+    arrow::DefRepLevelsToList(
+        defs.data(), reps.data(), numLevels, info, &output, offsets.data());
+
+    std::vector<int32_t> lengths(numLevels);
+    std::vector<uint64_t> nulls(bits::nwords(numLevels), 0);
+    auto numLists = NestedStructureDecoder::readLengthsAndNulls(
+        defs.data(),
+        reps.data(),
+        numLevels,
+        info,
+        numLevels,
+        lengths.data(),
+        nulls.data(),
+        0);
+    ASSERT_EQ(numLists, output.values_read);
+    for (auto i = 0; i < numLists; ++i) {
+      ASSERT_EQ(lengths[i], offsets[i + 1] - offsets[i]) << i;
+      ASSERT_EQ(
+          bits::isBitSet(nulls.data(), i),
+          bits::isBitSet(expectedNulls.data(), i))
+          << i;
+    }
+
+    std::fill(expectedNulls.begin(), expectedNulls.end(), 0);
+    output.values_read = 0;
+    output.null_count = 0;
+    arrow::DefRepLevelsToBitmap(
+        defs.data(), reps.data(), numLevels, info, &output);
+    // Starts the nulls at an offset that is not a multiple of 64.
+    std::vector<uint64_t> structNulls(bits::nwords(numLevels + 3), 0);
+    auto numStructs = NestedStructureDecoder::readStructNulls(
+        defs.data(),
+        reps.data(),
+        numLevels,
+        info,
+        numLevels,
+        structNulls.data(),
+        3);
+    ASSERT_EQ(numStructs, output.values_read);
+    for (auto i = 0; i < numStructs; ++i) {
+      ASSERT_EQ(
+          bits::isBitSet(structNulls.data(), i + 3),
+          bits::isBitSet(expectedNulls.data(), i))
+          << i;
+    }
+  }
+
+  // Makes 'numRows' rows of ARRAY<STRUCT<ARRAY<INTEGER>>> levels where the
+  // lists have up to 'maxLength' elements and a level is null with
+  // 'nullPercent' probability.
+  void makeLevels(
+      int32_t numRows,
+      int32_t maxLength,
+      int32_t nullPercent,
+      std::vector<int16_t>& defs,
+      std::vector<int16_t>& reps) {
+    // Definition levels: 0 null outer list, 1 empty outer list, 2 null
+    // struct, 3 null inner list, 4 empty inner list, 5 null element and 6
+    // element.
+    std::mt19937 rng(numRows + maxLength + nullPercent);
+    auto isNull = [&]() { return rng() % 100 < nullPercent; };
+    auto length = [&]() { return rng() % (maxLength + 1); };
+    defs.clear();
+    reps.clear();
+    for (auto row = 0; row < numRows; ++row) {
+      int16_t rep = 0;
+      auto add = [&](int16_t def) {
+        defs.push_back(def);
+        reps.push_back(rep);
+        rep = std::max<int16_t>(rep, 1);
+      };
+      if (isNull()) {
+        add(0);
+        continue;
+      }
+      const auto numStructs = length();
+      if (numStructs == 0) {
+        add(1);
+        continue;
+      }
+      for (auto i = 0; i < numStructs; ++i) {
+        rep = i == 0 ? rep : 1;
+        if (isNull()) {
+          add(2);
+          continue;
+        }
+        if (isNull()) {
+          add(3);
+          continue;
+        }
+        const auto numElements = length();
+        if (numElements == 0) {
+          add(4);
+          continue;
+        }
+        for (auto j = 0; j < numElements; ++j) {
+          add(isNull() ? 5 : 6);
+          rep = 2;
+        }
+      }
+    }
+  }
+
+ private:
   BufferPtr offsetsBuffer_;
   BufferPtr lengthsBuffer_;
   BufferPtr nullsBuffer_;
@@ -266,3 +387,63 @@ TEST_F(NestedStructureDecoderTest, emptyRowAtEnd) {
   assertStructure(
       defs, reps, 4, 3, 2, expectedOffsets, expectedLengths, expectedNulls);
 }
+
+TEST_F(NestedStructureDecoderTest, simdLevels) {
+  // The outer list, the struct and the inner list of
+  // ARRAY<STRUCT<ARRAY<INTEGER>>>.
+  const std::vector<arrow::LevelInfo> infos = {
+      arrow::LevelInfo(1, 2, 1, 0),
+      arrow::LevelInfo(1, 3, 1, 2),
+      arrow::LevelInfo(1, 5, 2, 3)};
+  std::vector<int16_t> defs;
+  std::vector<int16_t> reps;
+  // Short lists with nulls, long lists without nulls that have many levels
+  // without a list start, and lists of at most one element.
+  for (auto [maxLength, nullPercent] :
+       {std::pair{3, 20}, std::pair{100, 0}, std::pair{1, 0}}) {
+    for (auto numRows : {1, 7, 100, 1'000}) {
+      makeLevels(numRows, maxLength, nullPercent, defs, reps);
+      for (const auto& info : infos) {
+        SCOPED_TRACE(fmt::format(
+            "maxLength {} nullPercent {} numRows {} def {} rep {}",
+            maxLength,
+            nullPercent,
+            numRows,
+            info.def_level,
+            info.rep_level));
+        assertSameAsArrow(defs, reps, info);
+      }
+    }
+  }
+}
+
+TEST_F(NestedStructureDecoderTest, findTopLevelRowsEnd) {
+  std::vector<int16_t> defs;
+  std::vector<int16_t> reps;
+  makeLevels(1'000, 10, 10, defs, reps);
+  std::vector<int32_t> rowStarts;
+  for (auto i = 0; i < reps.size(); ++i) {
+    if (reps[i] == 0) {
+      rowStarts.push_back(i);
+    }
+  }
+  ASSERT_EQ(rowStarts.size(), 1'000);
+  for (auto begin : {0, 1, 17, 500}) {
+    for (auto numRows : {1, 2, 31, 400}) {
+      const auto end = begin + numRows;
+      const int32_t expected =
+          end < rowStarts.size() ? rowStarts[end] : reps.size();
+      ASSERT_EQ(
+          rowStarts[begin] +
+              NestedStructureDecoder::findTopLevelRowsEnd(
+                  reps.data() + rowStarts[begin],
+                  reps.size() - rowStarts[begin],
+                  numRows),
+          expected);
+    }
+  }
+  ASSERT_EQ(
+      NestedStructureDecoder::findTopLevelRowsEnd(
+          reps.data(), reps.size(), 1'000),
+      reps.size());
+}
@@ -50,6 +50,14 @@ FilterSpec ParquetReaderBenchmark::createFilterSpec(
           FilterKind::kBigintRange,
           isForRowGroupSkip,
           allowNulls);
+    case TypeKind::REAL:
+      return FilterSpec(
+          columnName,
+          startPct,
+          selectPct,
+          FilterKind::kFloatRange,
+          isForRowGroupSkip,
+          allowNulls);
     case TypeKind::DOUBLE:
       return FilterSpec(
           columnName,
@@ -229,4 +237,19 @@ void run(
       columnName, type, 0, filterRateX100, nullsRateX100, nextSize);
 }
 
+void runWithEncoding(
+    uint32_t,
+    const std::string& columnName,
+    const TypePtr& type,
+    float filterRateX100,
+    uint8_t nullsRateX100,
+    uint32_t nextSize,
+    arrow::Encoding::type encoding) {
+  RowTypePtr rowType = ROW({columnName}, {type});
+  facebook::velox::parquet::test::ParquetReaderBenchmark benchmark(
+      true, rowType, encoding);
+  benchmark.readSingleColumn(
+      columnName, type, 0, filterRateX100, nullsRateX100, nextSize);
+}
+
 } // namespace facebook::velox::parquet::test
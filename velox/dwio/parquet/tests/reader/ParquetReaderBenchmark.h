@@ -36,10 +36,13 @@ constexpr double kFilterErrorMargin = 0.2;
 
 class ParquetReaderBenchmark {
  public:
-  explicit ParquetReaderBenchmark(
+  // Writes the values with 'encoding' and without dictionary if 'encoding' is
+  // set.
+  ParquetReaderBenchmark(
       bool disableDictionary,
-      const facebook::velox::RowTypePtr& rowType)
-      : disableDictionary_(disableDictionary) {
+      const facebook::velox::RowTypePtr& rowType,
+      std::optional<arrow::Encoding::type> encoding = std::nullopt)
+      : disableDictionary_(disableDictionary || encoding.has_value()) {
     rootPool_ = facebook::velox::memory::memoryManager()->addRootPool(
         "ParquetReaderBenchmark");
     leafPool_ = rootPool_->addLeafChild("ParquetReaderBenchmark");
@@ -55,6 +58,9 @@ class ParquetReaderBenchmark {
       // The parquet file is in plain encoding format.
       options.enableDictionary = false;
     }
+    if (encoding.has_value()) {
+      options.encoding = encoding.value();
+    }
     options.memoryPool = rootPool_.get();
     writer_ = std::make_unique<facebook::velox::parquet::Writer>(
         std::move(sink), options, rowType);
@@ -124,4 +130,14 @@ void run(
     uint32_t nextSize,
     bool disableDictionary);
 
+/// Like run() for a file written with 'encoding' and without dictionary.
+void runWithEncoding(
+    uint32_t,
+    const std::string& columnName,
+    const facebook::velox::TypePtr& type,
+    float filterRateX100,
+    uint8_t nullsRateX100,
+    uint32_t nextSize,
+    arrow::Encoding::type encoding);
+
 } // namespace facebook::velox::parquet::test
@@ -28,6 +28,18 @@ TEST(ParquetReaderBenchmarkTest, basic) {
   run(5, "Varchar", VARCHAR(), 0, 0, 500, false);
   run(6, "Map", MAP(BIGINT(), BIGINT()), 100, 20, 500, false);
   run(7, "Array", ARRAY(BIGINT()), 100, 0, 500, false);
+  runWithEncoding(
+      8, "Varchar", VARCHAR(), 20, 10, 500, arrow::Encoding::DELTA_BYTE_ARRAY);
+  runWithEncoding(
+      9,
+      "Varchar",
+      VARCHAR(),
+      20,
+      10,
+      500,
+      arrow::Encoding::DELTA_LENGTH_BYTE_ARRAY);
+  runWithEncoding(
+      10, "Double", DOUBLE(), 5, 10, 500, arrow::Encoding::BYTE_STREAM_SPLIT);
 }
 } // namespace
 } // namespace facebook::velox::parquet::test
@@ -14,15 +14,81 @@
  * limitations under the License.
  */
 
+#include "velox/dwio/common/FileMetadataCache.h"
+#include "velox/dwio/parquet/reader/BloomFilter.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
 
+#include <folly/ScopeGuard.h>
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include <thrift/transport/TBufferTransports.h> //@manual
+
 using namespace facebook::velox;
 using namespace facebook::velox::common;
 using namespace facebook::velox::dwio::common;
 using namespace facebook::velox::parquet;
 
+namespace {
+template <typename T>
+std::string serializeThrift(const T& object) {
+  auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+  apache::thrift::protocol::TCompactProtocolT<
+      apache::thrift::transport::TMemoryBuffer>
+      protocol(buffer);
+  object.write(&protocol);
+  return buffer->getBufferAsString();
+}
+
+// Copies the Parquet file at 'path' to 'newPath' with a bloom filter of
+// 'values(i)' for column 0 of the i'th row group. The Velox writer does not
+// write bloom filters.
+void addBloomFilters(
+    const std::string& path,
+    const std::string& newPath,
+    const std::function<std::vector<int64_t>(int32_t)>& values) {
+  LocalReadFile file(path);
+  auto content = file.pread(0, file.size());
+  uint32_t footerLength;
+  ::memcpy(&footerLength, content.data() + content.size() - 8, 4);
+  const auto footerOffset = content.size() - 8 - footerLength;
+  thrift::FileMetaData metaData;
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      content.data() + footerOffset, footerLength);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>
+      protocol(transport);
+  metaData.read(&protocol);
+  content.resize(footerOffset);
+
+  for (auto i = 0; i < metaData.row_groups.size(); ++i) {
+    BloomFilter filter(std::vector<uint32_t>(1'024));
+    for (auto value : values(i)) {
+      filter.addHash(BloomFilter::hashInt64(value));
+    }
+    thrift::BloomFilterHeader header;
+    header.__set_numBytes(filter.bitset().size() * sizeof(uint32_t));
+    header.algorithm.__set_BLOCK(thrift::SplitBlockAlgorithm());
+    header.hash.__set_XXHASH(thrift::XxHash());
+    header.compression.__set_UNCOMPRESSED(thrift::Uncompressed());
+    metaData.row_groups[i].columns[0].meta_data.__set_bloom_filter_offset(
+        content.size());
+    content += serializeThrift(header);
+    content.append(
+        reinterpret_cast<const char*>(filter.bitset().data()),
+        header.numBytes);
+  }
+  auto footer = serializeThrift(metaData);
+  footerLength = footer.size();
+  content += footer;
+  content.append(reinterpret_cast<const char*>(&footerLength), 4);
+  content += "PAR1";
+  LocalWriteFile newFile(newPath);
+  newFile.append(content);
+  newFile.close();
+}
+} // namespace
+
 class ParquetReaderTest : public ParquetTestBase {
  public:
   std::unique_ptr<dwio::common::RowReader> createRowReader(
@@ -97,6 +163,35 @@ TEST_F(ParquetReaderTest, parseSample) {
       sampleSchema(), *rowReader, expected, *leafPool_);
 }
 
+TEST_F(ParquetReaderTest, fileMetadataCache) {
+  FileMetadataCache cache(1 << 20);
+  FileMetadataCache::setInstance(&cache);
+  SCOPE_EXIT {
+    FileMetadataCache::setInstance(nullptr);
+  };
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(20, [](auto row) { return row + 1; }),
+      makeFlatVector<double>(20, [](auto row) { return row + 1; }),
+  });
+  for (auto i = 0; i < 2; ++i) {
+    facebook::velox::dwio::common::ReaderOptions readerOptions{
+        leafPool_.get()};
+    auto reader = createReader(sample, readerOptions);
+    EXPECT_EQ(reader->numberOfRows(), 20ULL);
+    auto rowReaderOpts = getReaderOpts(sampleSchema());
+    rowReaderOpts.setScanSpec(makeScanSpec(sampleSchema()));
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(
+        sampleSchema(), *rowReader, expected, *leafPool_);
+  }
+  const auto stats = cache.stats();
+  EXPECT_EQ(stats.numEntries, 1);
+  EXPECT_EQ(stats.numLookups, 2);
+  EXPECT_EQ(stats.numHits, 1);
+  EXPECT_GT(stats.bytes, 0);
+}
+
 TEST_F(ParquetReaderTest, parseUnannotatedList) {
   // unannotated_list.parquet has the following the schema
   // the list is defined without the middle layer
@@ -1004,6 +1099,45 @@ TEST_F(ParquetReaderTest, prefetchRowGroups) {
   }
 }
 
+TEST_F(ParquetReaderTest, adaptivePrefetchRowGroups) {
+  auto rowType = ROW({"id"}, {BIGINT()});
+  const std::string sample(getExampleFilePath("multiple_row_groups.parquet"));
+  const int numRowGroups = 4;
+
+  facebook::velox::dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  readerOptions.setFilePreloadThreshold(0);
+  readerOptions.setPrefetchRowGroups(2);
+  readerOptions.setAdaptivePrefetchRowGroups(true);
+  auto reader = createReader(sample, readerOptions);
+
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(makeScanSpec(rowType));
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto parquetRowReader = dynamic_cast<ParquetRowReader*>(rowReader.get());
+
+  constexpr int kBatchSize = 1000;
+  auto result = BaseVector::create(rowType, kBatchSize, pool_.get());
+  uint64_t numRows = 0;
+  for (int i = 0; i < numRowGroups; i++) {
+    // At least one row group is loaded ahead and at most 2.
+    EXPECT_TRUE(parquetRowReader->isRowGroupBuffered(i));
+    if (i < numRowGroups - 1) {
+      EXPECT_TRUE(parquetRowReader->isRowGroupBuffered(i + 1));
+    }
+    if (i < numRowGroups - 3) {
+      EXPECT_FALSE(parquetRowReader->isRowGroupBuffered(i + 3));
+    }
+    numRows += parquetRowReader->next(kBatchSize, result);
+    parquetRowReader->nextRowNumber();
+  }
+  EXPECT_EQ(numRows, reader->numberOfRows());
+
+  RuntimeStatistics stats;
+  parquetRowReader->updateRuntimeStats(stats);
+  EXPECT_GE(stats.maxPrefetchDepth, 1);
+  EXPECT_LE(stats.maxPrefetchDepth, 2);
+}
+
 TEST_F(ParquetReaderTest, testEmptyRowGroups) {
   // empty_row_groups.parquet contains empty row groups
   const std::string sample(getExampleFilePath("empty_row_groups.parquet"));
@@ -1054,3 +1188,229 @@ TEST_F(ParquetReaderTest, testEnumType) {
 
   assertReadWithReaderAndExpected(fileSchema, *rowReader, expected, *leafPool_);
 }
+
+TEST_F(ParquetReaderTest, pageIndex) {
+  // Writes c0 in ascending order in at least 20 pages. A filter on c0 selects
+  // rows of at most 2 of the pages.
+  constexpr int32_t kSize = 20'000;
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), DOUBLE()});
+  auto data = makeRowVector(
+      rowType->names(),
+      {makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+       makeFlatVector<double>(kSize, [](auto row) { return row * 0.5; })});
+  auto expected = makeRowVector(
+      rowType->names(),
+      {makeFlatVector<int64_t>(100, [](auto row) { return 9'950 + row; }),
+       makeFlatVector<double>(
+           100, [](auto row) { return (9'950 + row) * 0.5; })});
+
+  for (auto writePageIndex : {false, true}) {
+    SCOPED_TRACE(fmt::format("writePageIndex: {}", writePageIndex));
+    const auto filePath = fmt::format(
+        "{}/pageIndex{}.parquet", tempPath_->path, writePageIndex);
+    facebook::velox::parquet::WriterOptions options;
+    options.memoryPool = rootPool_.get();
+    options.enableDictionary = false;
+    options.dataPageSize = 4 * 1024;
+    options.writePageIndex = writePageIndex;
+    auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+        createSink(filePath), options, rowType);
+    writer->write(data);
+    writer->close();
+
+    ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReader(filePath, readerOptions);
+    auto scanSpec = makeScanSpec(rowType);
+    scanSpec->childByName("c0")->setFilter(
+        std::make_unique<BigintRange>(9'950, 10'049, false));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(rowType, *rowReader, expected, *leafPool_);
+
+    RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    if (writePageIndex) {
+      EXPECT_GE(stats.skippedPages, 18);
+    } else {
+      EXPECT_EQ(stats.skippedPages, 0);
+    }
+  }
+}
+
+TEST_F(ParquetReaderTest, bloomFilter) {
+  // Writes 4 row groups of 1000 even values of c0 in ascending order. The odd
+  // values in the filter are within the min and max of each row group, so
+  // only the bloom filters tell that 3 of the row groups have no match.
+  constexpr int32_t kRowsInRowGroup = 1'000;
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  const auto filePath =
+      fmt::format("{}/noBloomFilter.parquet", tempPath_->path);
+  const auto bloomFilterPath =
+      fmt::format("{}/bloomFilter.parquet", tempPath_->path);
+  facebook::velox::parquet::WriterOptions options;
+  options.memoryPool = rootPool_.get();
+  // Row groups with dictionaries would also be skipped based on these.
+  options.enableDictionary = false;
+  options.flushPolicyFactory = []() {
+    return std::make_unique<DefaultFlushPolicy>(
+        kRowsInRowGroup, 128 * 1'024 * 1'024);
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      createSink(filePath), options, rowType);
+  for (auto i = 0; i < 4; ++i) {
+    writer->write(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int64_t>(kRowsInRowGroup, [&](auto row) {
+          return (i * kRowsInRowGroup + row) * 2;
+        })}));
+  }
+  writer->close();
+  addBloomFilters(filePath, bloomFilterPath, [&](int32_t rowGroup) {
+    std::vector<int64_t> values;
+    for (auto row = 0; row < kRowsInRowGroup; ++row) {
+      values.push_back((rowGroup * kRowsInRowGroup + row) * 2);
+    }
+    return values;
+  });
+
+  auto expected = makeRowVector(
+      rowType->names(), {makeFlatVector<int64_t>(std::vector<int64_t>{4'000})});
+  for (const auto& path : {filePath, bloomFilterPath}) {
+    SCOPED_TRACE(path);
+    ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReader(path, readerOptions);
+    ASSERT_EQ(reader->fileMetaData().numRowGroups(), 4);
+    auto scanSpec = makeScanSpec(rowType);
+    scanSpec->childByName("c0")->setFilter(
+        createBigintValues({1'001, 3'001, 4'000, 5'001, 7'001}, false));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(rowType, *rowReader, expected, *leafPool_);
+
+    RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    if (path == bloomFilterPath) {
+      EXPECT_EQ(stats.skippedStridesByBloomFilter, 3);
+      EXPECT_EQ(stats.skippedStrides, 3);
+    } else {
+      EXPECT_EQ(stats.skippedStridesByBloomFilter, 0);
+      EXPECT_EQ(stats.skippedStrides, 0);
+    }
+  }
+}
+
+TEST_F(ParquetReaderTest, dictionaryFilter) {
+  // Writes 4 row groups of dictionary encoded c0 with the values "a" and "c".
+  // Row group 2 also has one "b". The filter on "b" is within the min and
+  // max of each row group, so only the dictionaries tell that 3 of the row
+  // groups have no match.
+  constexpr int32_t kRowsInRowGroup = 1'000;
+  auto rowType = ROW({"c0"}, {VARCHAR()});
+  auto expected = makeRowVector(
+      rowType->names(), {makeFlatVector<std::string>({"b"})});
+  for (auto useNativeWriter : {false, true}) {
+    SCOPED_TRACE(fmt::format("useNativeWriter: {}", useNativeWriter));
+    const auto filePath = fmt::format(
+        "{}/dictionaryFilter{}.parquet", tempPath_->path, useNativeWriter);
+    facebook::velox::parquet::WriterOptions options;
+    options.memoryPool = rootPool_.get();
+    options.useNativeWriter = useNativeWriter;
+    options.flushPolicyFactory = []() {
+      return std::make_unique<DefaultFlushPolicy>(
+          kRowsInRowGroup, 128 * 1'024 * 1'024);
+    };
+    auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+        createSink(filePath), options, rowType);
+    for (auto i = 0; i < 4; ++i) {
+      // The native writer writes the base of the DictionaryVector as the
+      // dictionary of the row group.
+      auto dictionary = i == 2
+          ? makeFlatVector<std::string>({"a", "c", "b"})
+          : makeFlatVector<std::string>({"a", "c"});
+      auto indices = makeIndices(kRowsInRowGroup, [&](auto row) {
+        return i == 2 && row == 500 ? 2 : row % 2;
+      });
+      writer->write(makeRowVector(
+          rowType->names(),
+          {BaseVector::wrapInDictionary(
+              nullptr, indices, kRowsInRowGroup, dictionary)}));
+    }
+    writer->close();
+
+    ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReader(filePath, readerOptions);
+    ASSERT_EQ(reader->fileMetaData().numRowGroups(), 4);
+    for (auto i = 0; i < 4; ++i) {
+      ASSERT_TRUE(reader->fileMetaData()
+                      .rowGroup(i)
+                      .columnChunk(0)
+                      .isFullyDictionaryEncoded());
+    }
+    auto scanSpec = makeScanSpec(rowType);
+    scanSpec->childByName("c0")->setFilter(exec::equal("b"));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(rowType, *rowReader, expected, *leafPool_);
+
+    RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    EXPECT_EQ(stats.skippedStridesByDictionary, 3);
+    EXPECT_EQ(stats.skippedStrides, 3);
+  }
+}
+
+TEST_F(ParquetReaderTest, fileColumnStatistics) {
+  // Writes 3 row groups of 1000 rows. c0 has nulls in the second row group
+  // only and c1 has no minimum and maximum.
+  constexpr int32_t kRowsInRowGroup = 1'000;
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  const auto filePath = fmt::format("{}/stats.parquet", tempPath_->path);
+  facebook::velox::parquet::WriterOptions options;
+  options.memoryPool = rootPool_.get();
+  options.flushPolicyFactory = []() {
+    return std::make_unique<DefaultFlushPolicy>(
+        kRowsInRowGroup, 128 * 1'024 * 1'024);
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      createSink(filePath), options, rowType);
+  for (auto i = 0; i < 3; ++i) {
+    writer->write(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int64_t>(
+             kRowsInRowGroup,
+             [&](auto row) { return i * kRowsInRowGroup + row - 500; },
+             [&](auto row) { return i == 1 && row % 10 == 0; }),
+         makeFlatVector<std::string>(
+             kRowsInRowGroup, [](auto row) { return std::to_string(row); })}));
+  }
+  writer->close();
+
+  ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReader(filePath, readerOptions);
+  ASSERT_EQ(reader->fileMetaData().numRowGroups(), 3);
+  const auto& type = reader->typeWithId();
+
+  auto stats = reader->columnStatistics(type->childByName("c0")->id());
+  ASSERT_NE(stats, nullptr);
+  EXPECT_EQ(stats->getNumberOfValues(), 3 * kRowsInRowGroup - 100);
+  EXPECT_EQ(stats->hasNull(), true);
+  auto* integerStats =
+      dynamic_cast<const dwio::common::IntegerColumnStatistics*>(stats.get());
+  ASSERT_NE(integerStats, nullptr);
+  EXPECT_EQ(integerStats->getMinimum(), -500);
+  EXPECT_EQ(integerStats->getMaximum(), 3 * kRowsInRowGroup - 501);
+
+  stats = reader->columnStatistics(type->childByName("c1")->id());
+  ASSERT_NE(stats, nullptr);
+  EXPECT_EQ(stats->getNumberOfValues(), 3 * kRowsInRowGroup);
+  EXPECT_EQ(stats->hasNull(), false);
+  EXPECT_EQ(
+      dynamic_cast<const dwio::common::IntegerColumnStatistics*>(stats.get()),
+      nullptr);
+
+  // The root is not a primitive column.
+  EXPECT_EQ(reader->columnStatistics(type->id()), nullptr);
+}
@@ -15,10 +15,12 @@
  */
 
 #include "velox/dwio/common/BitPackDecoder.h"
+#include "velox/dwio/parquet/reader/RleBpDecoder.h"
 
 #include <arrow/util/rle_encoding.h> // @manual
 #include <gtest/gtest.h>
 
+#include <numeric>
 #include <random>
 
 using namespace facebook::velox;
@@ -140,3 +142,133 @@ TEST(RleBpDecoderTest, DISABLED_allOnes) {
   RleBpDecoderTest<uint8_t> test;
   test.testDecodeSuppliedData(allOnesVector, 1);
 }
+
+namespace {
+
+// Returns 'numValues' random values of 'bitWidth' bits packed after
+// 'bitOffset' bits. The last value ends in the last byte.
+std::vector<uint8_t> makeBitPacked(
+    int32_t bitOffset,
+    int32_t numValues,
+    uint8_t bitWidth,
+    std::vector<uint64_t>& values) {
+  std::mt19937 rng(bitWidth * 8 + bitOffset);
+  std::vector<uint64_t> words(
+      bits::nwords(bitOffset + numValues * bitWidth) + 1);
+  values.resize(numValues);
+  for (auto i = 0; i < numValues; ++i) {
+    values[i] = rng() & bits::lowMask(bitWidth);
+    bits::copyBits(
+        &values[i], 0, words.data(), bitOffset + i * bitWidth, bitWidth);
+  }
+  auto data = reinterpret_cast<const uint8_t*>(words.data());
+  return std::vector<uint8_t>(
+      data, data + bits::roundUp(bitOffset + numValues * bitWidth, 8) / 8);
+}
+
+template <typename T>
+void testAvx512(uint8_t maxBitWidth) {
+  std::vector<uint64_t> expected;
+  for (uint8_t bitWidth = 1; bitWidth <= maxBitWidth; ++bitWidth) {
+    for (auto bitOffset = 0; bitOffset < 8; ++bitOffset) {
+      for (auto numValues : {8, 16, 40, 1000}) {
+        auto data = makeBitPacked(bitOffset, numValues, bitWidth, expected);
+        std::vector<T> result(numValues);
+        auto numUnpacked = unpackAvx512(
+            data.data(), bitOffset, numValues, bitWidth, result.data());
+        const auto valuesPerLoop = bitWidth <= 25 ? 16 : 8;
+        ASSERT_EQ(numUnpacked, numValues / valuesPerLoop * valuesPerLoop);
+        for (auto i = 0; i < numUnpacked; ++i) {
+          ASSERT_EQ(result[i], static_cast<T>(expected[i]))
+              << "bitWidth " << (int)bitWidth << " bitOffset " << bitOffset
+              << " i " << i;
+        }
+      }
+    }
+  }
+}
+
+} // namespace
+
+TEST(RleBpDecoderTest, avx512) {
+  if (!hasAvx512Vbmi()) {
+    GTEST_SKIP() << "AVX-512 VBMI is not supported";
+  }
+  testAvx512<uint8_t>(8);
+  testAvx512<uint16_t>(16);
+  testAvx512<uint32_t>(32);
+  testAvx512<int64_t>(32);
+}
+
+TEST(RleBpDecoderTest, unpackWithAndWithoutAvx512) {
+  std::vector<uint64_t> expected;
+  for (auto enabled : {true, false}) {
+    setAvx512UnpackEnabled(enabled);
+    for (uint8_t bitWidth = 1; bitWidth <= 32; ++bitWidth) {
+      auto data = makeBitPacked(0, 1000, bitWidth, expected);
+      // Dense rows from the middle of the data, as in a run of dictionary
+      // indices.
+      std::vector<int32_t> rows(900);
+      std::iota(rows.begin(), rows.end(), 50);
+      std::vector<int32_t> result(rows.size());
+      unpack(
+          reinterpret_cast<const uint64_t*>(data.data()),
+          0,
+          RowSet(rows),
+          0,
+          bitWidth,
+          reinterpret_cast<const char*>(data.data() + data.size()),
+          result.data());
+      for (auto i = 0; i < rows.size(); ++i) {
+        ASSERT_EQ(result[i], static_cast<int32_t>(expected[rows[i]]));
+      }
+
+      // The AVX2 kernels may read a word past the last value.
+      data.resize(data.size() + sizeof(uint64_t));
+      std::vector<uint32_t> values(1000);
+      const uint8_t* input = data.data();
+      uint32_t* output = values.data();
+      unpack<uint32_t>(input, data.size(), 1000, bitWidth, output);
+      for (auto i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(values[i], expected[i]);
+      }
+    }
+  }
+  setAvx512UnpackEnabled(true);
+}
+
+TEST(RleBpDecoderTest, levels) {
+  for (uint8_t bitWidth = 1; bitWidth <= 4; ++bitWidth) {
+    std::mt19937 rng(bitWidth);
+    // Runs of repeated levels between bit packed levels, like the repetition
+    // and definition levels of a nested column.
+    std::vector<int16_t> levels;
+    while (levels.size() < 10'000) {
+      auto level = rng() & bits::lowMask(bitWidth);
+      auto count = rng() % 3 == 0 ? rng() % 100 : 1;
+      levels.insert(levels.end(), count, level);
+    }
+    std::vector<uint8_t> encoded(
+        arrow::util::RleEncoder::MaxBufferSize(bitWidth, levels.size()));
+    arrow::util::RleEncoder encoder(encoded.data(), encoded.size(), bitWidth);
+    for (auto level : levels) {
+      ASSERT_TRUE(encoder.Put(level));
+    }
+    encoded.resize(encoder.Flush());
+
+    std::vector<int16_t> result(levels.size());
+    parquet::RleBpDecoder decoder(
+        reinterpret_cast<const char*>(encoded.data()),
+        reinterpret_cast<const char*>(encoded.data() + encoded.size()),
+        bitWidth);
+    auto* output = result.data();
+    // Batches that end inside both runs and groups of 8 bit packed values.
+    for (auto numRead = 0; numRead < levels.size();) {
+      auto batch = std::min<int32_t>(1 + rng() % 300, levels.size() - numRead);
+      decoder.next(output, batch);
+      numRead += batch;
+      ASSERT_EQ(output, result.data() + numRead);
+    }
+    ASSERT_EQ(result, levels);
+  }
+}
@@ -135,6 +135,139 @@ TEST_F(ParquetWriterTest, compression) {
   assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
 };
 
+TEST_F(ParquetWriterTest, nativeWriter) {
+  const auto schema =
+      ROW({"c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7", "c8", "c9"},
+          {BOOLEAN(),
+           TINYINT(),
+           SMALLINT(),
+           INTEGER(),
+           BIGINT(),
+           REAL(),
+           DOUBLE(),
+           VARCHAR(),
+           ARRAY(BIGINT()),
+           VARCHAR()});
+  const vector_size_t kRows = 1'000;
+  auto makeBatch = [&](int32_t seed, const VectorPtr& dictionary) {
+    return makeRowVector(
+        schema->names(),
+        {makeFlatVector<bool>(
+             kRows,
+             [&](auto row) { return (row + seed) % 3 == 0; },
+             nullEvery(7)),
+         makeFlatVector<int8_t>(
+             kRows,
+             [&](auto row) { return (row + seed) % 100; },
+             nullEvery(11)),
+         makeFlatVector<int16_t>(
+             kRows, [&](auto row) { return row * 3 - seed; }, nullEvery(13)),
+         makeFlatVector<int32_t>(
+             kRows, [&](auto row) { return row * seed; }, nullEvery(5)),
+         makeFlatVector<int64_t>(
+             kRows, [&](auto row) { return row - (1LL << 40); }),
+         makeFlatVector<float>(
+             kRows, [&](auto row) { return row / 4.0; }, nullEvery(3)),
+         makeFlatVector<double>(
+             kRows, [&](auto row) { return row * 1.5 + seed; }, nullEvery(17)),
+         makeFlatVector<std::string>(
+             kRows,
+             [&](auto row) {
+               return std::string(row % 20, 'x') + std::to_string(row + seed);
+             },
+             nullEvery(19)),
+         makeArrayVector<int64_t>(
+             kRows,
+             [](auto row) { return row % 5; },
+             [&](auto index) { return index + seed; },
+             nullEvery(9),
+             nullEvery(7)),
+         BaseVector::wrapInDictionary(
+             makeNulls(kRows, nullEvery(23)),
+             makeIndices(kRows, [&](auto row) { return (row + seed) % 50; }),
+             kRows,
+             dictionary)});
+  };
+  auto makeDictionary = [&](const std::string& prefix) {
+    return makeFlatVector<std::string>(
+        50, [&](auto row) { return prefix + std::to_string(row); });
+  };
+  // The first 2 batches share the dictionary of the first row group. The
+  // last one is in a row group of its own with another dictionary.
+  const auto dictionary = makeDictionary("shared value ");
+  const std::vector<RowVectorPtr> batches = {
+      makeBatch(1, dictionary),
+      makeBatch(2, dictionary),
+      makeBatch(3, makeDictionary("other value "))};
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.useNativeWriter = true;
+  writerOptions.compression = CompressionKind::CompressionKind_SNAPPY;
+  writerOptions.dataPageSize = 1'024;
+  writerOptions.flushPolicyFactory = [&]() {
+    return std::make_unique<DefaultFlushPolicy>(2 * kRows, 1LL << 30);
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  auto expected = BaseVector::create<RowVector>(schema, 0, leafPool_.get());
+  for (const auto& batch : batches) {
+    writer->write(batch);
+    expected->append(batch.get());
+  }
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  ASSERT_EQ(reader->numberOfRows(), 3 * kRows);
+  ASSERT_EQ(*reader->rowType(), *schema);
+  ASSERT_EQ(reader->fileMetaData().numRowGroups(), 2);
+  for (auto i = 0; i < 2; ++i) {
+    const auto rowGroup = reader->fileMetaData().rowGroup(i);
+    EXPECT_EQ(
+        rowGroup.columnChunk(0).compression(),
+        CompressionKind::CompressionKind_SNAPPY);
+    // Only the dictionary encoded column has a dictionary.
+    EXPECT_FALSE(rowGroup.columnChunk(7).hasDictionaryPageOffset());
+    EXPECT_TRUE(rowGroup.columnChunk(9).hasDictionaryPageOffset());
+  }
+
+  auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+  assertReadWithReaderAndExpected(schema, *rowReader, expected, *leafPool_);
+}
+
+TEST_F(ParquetWriterTest, nativeWriterFallback) {
+  // Maps are not supported by the native writer and are written with Arrow.
+  const auto data = makeRowVector({makeMapVector<int32_t, int64_t>(
+      100,
+      [](auto row) { return row % 3; },
+      [](auto index) { return index; },
+      [](auto index) { return index * 2; })});
+  const auto schema = asRowType(data->type());
+  ASSERT_FALSE(NativeWriter::supports(*schema));
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.useNativeWriter = true;
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  writer->write(data);
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+  assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
+}
+
 DEBUG_ONLY_TEST_F(ParquetWriterTest, unitFromWriterOptions) {
   SCOPED_TESTVALUE_SET(
       "facebook::velox::parquet::Writer::write",
@@ -0,0 +1,846 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/writer/NativeWriter.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include <thrift/transport/TVirtualTransport.h> //@manual
+
+#include <cmath>
+#include <map>
+#include <set>
+
+#include "velox/dwio/common/DataBuffer.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/dwio/parquet/writer/arrow/Exception.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::parquet {
+
+using dwio::common::DataBuffer;
+
+namespace {
+constexpr std::string_view kMagic = "PAR1";
+
+// Thrift transport that appends to a DataBuffer.
+class DataBufferTransport : public apache::thrift::transport::TVirtualTransport<
+                                DataBufferTransport> {
+ public:
+  explicit DataBufferTransport(DataBuffer<char>& buffer) : buffer_(buffer) {}
+
+  void write(const uint8_t* data, uint32_t size) {
+    buffer_.extendAppend(
+        buffer_.size(), reinterpret_cast<const char*>(data), size);
+  }
+
+ private:
+  DataBuffer<char>& buffer_;
+};
+
+// Appends the compact protocol serialization of 'object' to 'out' and returns
+// its size.
+template <typename T>
+uint32_t serializeThrift(const T& object, DataBuffer<char>& out) {
+  auto transport = std::make_shared<DataBufferTransport>(out);
+  apache::thrift::protocol::TCompactProtocolT<DataBufferTransport> protocol(
+      transport);
+  return object.write(&protocol);
+}
+
+template <typename T>
+void appendRaw(T value, DataBuffer<char>& out) {
+  out.extendAppend(
+      out.size(), reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void appendVarint(uint64_t value, DataBuffer<char>& out) {
+  while (value >= 0x80) {
+    out.append(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.append(static_cast<char>(value));
+}
+
+// Appends the PLAIN encoding of a non-boolean value.
+template <typename T>
+void appendPlain(T value, DataBuffer<char>& out) {
+  if constexpr (std::is_same_v<T, StringView>) {
+    appendRaw<int32_t>(value.size(), out);
+    out.extendAppend(out.size(), value.data(), value.size());
+  } else if constexpr (
+      std::is_same_v<T, int8_t> || std::is_same_v<T, int16_t>) {
+    // Parquet has no integers narrower than INT32.
+    appendRaw<int32_t>(value, out);
+  } else {
+    appendRaw<T>(value, out);
+  }
+}
+
+int32_t bitWidth(uint32_t maxValue) {
+  return maxValue == 0 ? 0 : 32 - __builtin_clz(maxValue);
+}
+
+// Appends values [begin, end) of 'values' as one bit packed run of the
+// RLE/bit packing hybrid encoding. The last group of 8 values is padded with
+// zeros.
+void appendBitPacked(
+    const std::vector<uint32_t>& values,
+    size_t begin,
+    size_t end,
+    int32_t bitWidth,
+    DataBuffer<char>& out) {
+  if (begin == end) {
+    return;
+  }
+  const auto numGroups = (end - begin + 7) / 8;
+  appendVarint((numGroups << 1) | 1, out);
+  uint64_t bits = 0;
+  int32_t numBits = 0;
+  for (auto i = begin; i < begin + numGroups * 8; ++i) {
+    const uint64_t value = i < end ? values[i] : 0;
+    bits |= value << numBits;
+    numBits += bitWidth;
+    while (numBits >= 8) {
+      out.append(static_cast<char>(bits & 0xff));
+      bits >>= 8;
+      numBits -= 8;
+    }
+  }
+}
+
+void appendRleRun(
+    uint32_t value,
+    size_t count,
+    int32_t bitWidth,
+    DataBuffer<char>& out) {
+  appendVarint(count << 1, out);
+  for (auto i = 0; i < (bitWidth + 7) / 8; ++i) {
+    out.append(static_cast<char>((value >> (i * 8)) & 0xff));
+  }
+}
+
+// Appends 'values' to 'out' with the RLE/bit packing hybrid encoding. Runs of
+// at least 8 equal values are run length encoded and the values between them
+// are bit packed.
+void encodeRleBitPacked(
+    const std::vector<uint32_t>& values,
+    int32_t bitWidth,
+    DataBuffer<char>& out) {
+  size_t literalBegin = 0;
+  size_t i = 0;
+  while (i < values.size()) {
+    auto runEnd = i + 1;
+    while (runEnd < values.size() && values[runEnd] == values[i]) {
+      ++runEnd;
+    }
+    // Bit packed runs are whole groups of 8 values, so the first values of
+    // the run may pad the last group of the bit packed values before it.
+    const auto runBegin = i + (8 - (i - literalBegin) % 8) % 8;
+    if (runEnd >= runBegin + 8) {
+      appendBitPacked(values, literalBegin, runBegin, bitWidth, out);
+      appendRleRun(values[i], runEnd - runBegin, bitWidth, out);
+      literalBegin = runEnd;
+    }
+    i = runEnd;
+  }
+  appendBitPacked(values, literalBegin, values.size(), bitWidth, out);
+}
+
+// Appends 'levels' with the 4 byte length prefix of levels in V1 data pages.
+void appendLevels(
+    const std::vector<uint32_t>& levels,
+    int32_t bitWidth,
+    DataBuffer<char>& out) {
+  const auto lengthOffset = out.size();
+  appendRaw<int32_t>(0, out);
+  encodeRleBitPacked(levels, bitWidth, out);
+  const int32_t length = out.size() - lengthOffset - sizeof(int32_t);
+  ::memcpy(out.data() + lengthOffset, &length, sizeof(length));
+}
+
+thrift::CompressionCodec::type thriftCodec(
+    common::CompressionKind compression) {
+  switch (compression) {
+    case common::CompressionKind_NONE:
+      return thrift::CompressionCodec::UNCOMPRESSED;
+    case common::CompressionKind_SNAPPY:
+      return thrift::CompressionCodec::SNAPPY;
+    case common::CompressionKind_GZIP:
+      return thrift::CompressionCodec::GZIP;
+    case common::CompressionKind_ZSTD:
+      return thrift::CompressionCodec::ZSTD;
+    case common::CompressionKind_LZ4:
+      // Compressed with the Hadoop framing like the Arrow writer does.
+      return thrift::CompressionCodec::LZ4;
+    default:
+      VELOX_FAIL("Unsupported compression {}", compression);
+  }
+}
+
+bool isSupportedLeaf(const TypePtr& type) {
+  if (type->isDecimal() || type->isDate() || type->isIntervalDayTime() ||
+      type->isIntervalYearMonth()) {
+    return false;
+  }
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+thrift::SchemaElement leafSchemaElement(
+    const std::string& name,
+    const TypePtr& type) {
+  thrift::SchemaElement element;
+  element.__set_name(name);
+  element.__set_repetition_type(thrift::FieldRepetitionType::OPTIONAL);
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      element.__set_type(thrift::Type::BOOLEAN);
+      break;
+    case TypeKind::TINYINT:
+      element.__set_type(thrift::Type::INT32);
+      element.__set_converted_type(thrift::ConvertedType::INT_8);
+      break;
+    case TypeKind::SMALLINT:
+      element.__set_type(thrift::Type::INT32);
+      element.__set_converted_type(thrift::ConvertedType::INT_16);
+      break;
+    case TypeKind::INTEGER:
+      element.__set_type(thrift::Type::INT32);
+      break;
+    case TypeKind::BIGINT:
+      element.__set_type(thrift::Type::INT64);
+      break;
+    case TypeKind::REAL:
+      element.__set_type(thrift::Type::FLOAT);
+      break;
+    case TypeKind::DOUBLE:
+      element.__set_type(thrift::Type::DOUBLE);
+      break;
+    case TypeKind::VARCHAR:
+      element.__set_type(thrift::Type::BYTE_ARRAY);
+      element.__set_converted_type(thrift::ConvertedType::UTF8);
+      break;
+    case TypeKind::VARBINARY:
+      element.__set_type(thrift::Type::BYTE_ARRAY);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+  return element;
+}
+} // namespace
+
+// Encodes the values of one leaf column into the pages of a column chunk.
+// Top level columns have definition level 1 for non-null values. Arrays are
+// written as the 3 level LIST group of the Parquet spec, i.e. definition
+// level 1 is an empty array, 2 is a null element and 3 is a non-null element.
+class ColumnChunkWriter {
+ public:
+  ColumnChunkWriter(
+      TypePtr type,
+      bool isArray,
+      std::vector<std::string> path,
+      thrift::Type::type parquetType,
+      const WriterOptions& options,
+      common::CompressionKind compression,
+      memory::MemoryPool& pool)
+      : type_(std::move(type)),
+        maxRepeat_(isArray ? 1 : 0),
+        maxDefine_(isArray ? 3 : 1),
+        path_(std::move(path)),
+        parquetType_(parquetType),
+        enableDictionary_(
+            options.enableDictionary && type_->kind() != TypeKind::BOOLEAN),
+        dataPageSize_(options.dataPageSize),
+        dictionaryPageSizeLimit_(options.dictionaryPageSizeLimit),
+        codecKind_(thriftCodec(compression)),
+        pool_(pool),
+        chunk_(std::make_unique<DataBuffer<char>>(pool)),
+        pageValues_(pool) {
+    const auto arrowCompression = getArrowParquetCompression(compression);
+    codec_ = options.codecOptions
+        ? arrow::GetCodec(arrowCompression, *options.codecOptions)
+        : arrow::GetCodec(arrowCompression);
+  }
+
+  void write(const VectorPtr& column) {
+    decodedColumn_.decode(*column);
+    const BaseVector* leaf = column.get();
+    if (maxRepeat_ > 0) {
+      leaf = decodedColumn_.base()
+                 ->asUnchecked<ArrayVector>()
+                 ->elements()
+                 .get();
+      decodedValues_.decode(*leaf);
+    }
+    const bool useDictionary = startBatch(*leaf);
+    switch (type_->kind()) {
+      case TypeKind::BOOLEAN:
+        writeBatch<bool>(column->size(), useDictionary);
+        break;
+      case TypeKind::TINYINT:
+        writeBatch<int8_t>(column->size(), useDictionary);
+        break;
+      case TypeKind::SMALLINT:
+        writeBatch<int16_t>(column->size(), useDictionary);
+        break;
+      case TypeKind::INTEGER:
+        writeBatch<int32_t>(column->size(), useDictionary);
+        break;
+      case TypeKind::BIGINT:
+        writeBatch<int64_t>(column->size(), useDictionary);
+        break;
+      case TypeKind::REAL:
+        writeBatch<float>(column->size(), useDictionary);
+        break;
+      case TypeKind::DOUBLE:
+        writeBatch<double>(column->size(), useDictionary);
+        break;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        writeBatch<StringView>(column->size(), useDictionary);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+
+  int64_t numStagedBytes() const {
+    return chunk_->size() + pageSize();
+  }
+
+  // Writes the last page and moves the pages of the column chunk to
+  // 'buffers'. 'offset' is the position of the column chunk in the file.
+  thrift::ColumnChunk finish(
+      int64_t offset,
+      std::vector<DataBuffer<char>>& buffers) {
+    flushPage();
+    thrift::ColumnMetaData metaData;
+    metaData.__set_type(parquetType_);
+    metaData.__set_encodings(
+        std::vector<thrift::Encoding::type>(
+            encodings_.begin(), encodings_.end()));
+    std::vector<thrift::PageEncodingStats> encodingStats;
+    for (const auto& [pageEncoding, count] : pageEncodingCounts_) {
+      thrift::PageEncodingStats stats;
+      stats.__set_page_type(pageEncoding.first);
+      stats.__set_encoding(pageEncoding.second);
+      stats.__set_count(count);
+      encodingStats.push_back(stats);
+    }
+    metaData.__set_encoding_stats(std::move(encodingStats));
+    metaData.__set_path_in_schema(path_);
+    metaData.__set_codec(codecKind_);
+    metaData.__set_num_values(numValues_);
+    metaData.__set_total_uncompressed_size(totalUncompressedSize_);
+    metaData.__set_total_compressed_size(chunk_->size());
+    if (dictionary_ != nullptr) {
+      metaData.__set_dictionary_page_offset(offset);
+    }
+    metaData.__set_data_page_offset(offset + dictionaryPageSize_);
+    metaData.__set_statistics(statistics());
+
+    thrift::ColumnChunk columnChunk;
+    columnChunk.__set_file_offset(offset);
+    columnChunk.__set_meta_data(metaData);
+
+    buffers.push_back(std::move(*chunk_));
+    chunk_ = std::make_unique<DataBuffer<char>>(pool_);
+    dictionary_ = nullptr;
+    dictionaryPageSize_ = 0;
+    encodings_.clear();
+    pageEncodingCounts_.clear();
+    numValues_ = 0;
+    totalUncompressedSize_ = 0;
+    numNulls_ = 0;
+    hasMinMax_ = false;
+    minString_.clear();
+    maxString_.clear();
+    return columnChunk;
+  }
+
+ private:
+  // Returns true if the values of the batch with 'leaf' values are written as
+  // indices into the dictionary of the column chunk. The dictionary is the
+  // base of the first DictionaryVector written into the column chunk if it is
+  // flat and fits in a dictionary page. Other DictionaryVectors with the same
+  // base are written as indices and all other vectors as PLAIN values.
+  bool startBatch(const BaseVector& leaf) {
+    bool useDictionary = false;
+    if (enableDictionary_ &&
+        leaf.encoding() == VectorEncoding::Simple::DICTIONARY &&
+        leaf.valueVector()->isFlatEncoding()) {
+      const auto& base = leaf.valueVector();
+      if (dictionary_ != nullptr) {
+        useDictionary = dictionary_ == base;
+      } else {
+        useDictionary = numValues_ == 0 && pageDefLevels_.empty() &&
+            writeDictionaryPage(base);
+      }
+    }
+    if (!pageDefLevels_.empty() && useDictionary != pageIsDictionary_) {
+      flushPage();
+    }
+    pageIsDictionary_ = useDictionary;
+    return useDictionary;
+  }
+
+  bool writeDictionaryPage(const VectorPtr& base) {
+    DataBuffer<char> body(pool_);
+    switch (type_->kind()) {
+      case TypeKind::TINYINT:
+        return writeDictionaryPage<int8_t>(base, body);
+      case TypeKind::SMALLINT:
+        return writeDictionaryPage<int16_t>(base, body);
+      case TypeKind::INTEGER:
+        return writeDictionaryPage<int32_t>(base, body);
+      case TypeKind::BIGINT:
+        return writeDictionaryPage<int64_t>(base, body);
+      case TypeKind::REAL:
+        return writeDictionaryPage<float>(base, body);
+      case TypeKind::DOUBLE:
+        return writeDictionaryPage<double>(base, body);
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        return writeDictionaryPage<StringView>(base, body);
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+
+  template <typename T>
+  bool writeDictionaryPage(const VectorPtr& base, DataBuffer<char>& body) {
+    auto* values = base->asUnchecked<FlatVector<T>>();
+    for (vector_size_t i = 0; i < base->size(); ++i) {
+      // Null entries of the base are never referenced by a non-null value.
+      appendPlain<T>(values->isNullAt(i) ? T() : values->valueAt(i), body);
+      if (body.size() > dictionaryPageSizeLimit_) {
+        return false;
+      }
+    }
+    thrift::DictionaryPageHeader dictionaryHeader;
+    dictionaryHeader.__set_num_values(base->size());
+    dictionaryHeader.__set_encoding(thrift::Encoding::PLAIN);
+    thrift::PageHeader header;
+    header.__set_type(thrift::PageType::DICTIONARY_PAGE);
+    header.__set_dictionary_page_header(dictionaryHeader);
+    writePage(header, body);
+    encodings_.insert(thrift::Encoding::PLAIN);
+    ++pageEncodingCounts_[{
+        thrift::PageType::DICTIONARY_PAGE, thrift::Encoding::PLAIN}];
+    dictionary_ = base;
+    dictionaryPageSize_ = chunk_->size();
+    dictionaryBitWidth_ = std::max(1, bitWidth(base->size() - 1));
+    return true;
+  }
+
+  template <typename T>
+  void writeBatch(vector_size_t numRows, bool useDictionary) {
+    const auto& values = maxRepeat_ == 0 ? decodedColumn_ : decodedValues_;
+    auto appendValue = [&](vector_size_t row) {
+      const auto value = values.valueAt<T>(row);
+      updateStats<T>(value);
+      if (useDictionary) {
+        pageIndices_.push_back(values.index(row));
+      } else if constexpr (std::is_same_v<T, bool>) {
+        if (numPageBooleans_ % 8 == 0) {
+          pageValues_.append('\0');
+        }
+        if (value) {
+          pageValues_.data()[numPageBooleans_ / 8] |= 1 << numPageBooleans_ % 8;
+        }
+        ++numPageBooleans_;
+      } else {
+        appendPlain<T>(value, pageValues_);
+      }
+    };
+
+    for (vector_size_t row = 0; row < numRows; ++row) {
+      if (decodedColumn_.isNullAt(row)) {
+        addLevels(0, 0);
+      } else if (maxRepeat_ == 0) {
+        addLevels(1, 0);
+        appendValue(row);
+      } else {
+        auto* array = decodedColumn_.base()->asUnchecked<ArrayVector>();
+        const auto index = decodedColumn_.index(row);
+        const auto offset = array->offsetAt(index);
+        const auto size = array->sizeAt(index);
+        if (size == 0) {
+          addLevels(1, 0);
+        }
+        for (auto element = offset; element < offset + size; ++element) {
+          const uint32_t repeat = element == offset ? 0 : 1;
+          if (decodedValues_.isNullAt(element)) {
+            addLevels(2, repeat);
+          } else {
+            addLevels(3, repeat);
+            appendValue(element);
+          }
+        }
+      }
+      // Pages end at row boundaries.
+      if (pageSize() >= dataPageSize_) {
+        flushPage();
+      }
+    }
+  }
+
+  void addLevels(uint32_t define, uint32_t repeat) {
+    pageDefLevels_.push_back(define);
+    if (maxRepeat_ > 0) {
+      pageRepLevels_.push_back(repeat);
+    }
+    if (define < maxDefine_) {
+      ++numNulls_;
+    }
+  }
+
+  // Estimated size of the page being written before compression.
+  int64_t pageSize() const {
+    return pageValues_.size() + pageIndices_.size() * dictionaryBitWidth_ / 8 +
+        pageDefLevels_.size() / 4;
+  }
+
+  void flushPage() {
+    if (pageDefLevels_.empty()) {
+      return;
+    }
+    DataBuffer<char> body(pool_);
+    if (maxRepeat_ > 0) {
+      appendLevels(pageRepLevels_, bitWidth(maxRepeat_), body);
+    }
+    appendLevels(pageDefLevels_, bitWidth(maxDefine_), body);
+    const auto encoding = pageIsDictionary_ ? thrift::Encoding::RLE_DICTIONARY
+                                            : thrift::Encoding::PLAIN;
+    if (pageIsDictionary_) {
+      body.append(static_cast<char>(dictionaryBitWidth_));
+      encodeRleBitPacked(pageIndices_, dictionaryBitWidth_, body);
+    } else {
+      body.extendAppend(body.size(), pageValues_.data(), pageValues_.size());
+    }
+
+    thrift::DataPageHeader dataHeader;
+    dataHeader.__set_num_values(pageDefLevels_.size());
+    dataHeader.__set_encoding(encoding);
+    dataHeader.__set_definition_level_encoding(thrift::Encoding::RLE);
+    dataHeader.__set_repetition_level_encoding(thrift::Encoding::RLE);
+    thrift::PageHeader header;
+    header.__set_type(thrift::PageType::DATA_PAGE);
+    header.__set_data_page_header(dataHeader);
+    writePage(header, body);
+    encodings_.insert(encoding);
+    encodings_.insert(thrift::Encoding::RLE);
+    ++pageEncodingCounts_[{thrift::PageType::DATA_PAGE, encoding}];
+
+    numValues_ += pageDefLevels_.size();
+    pageDefLevels_.clear();
+    pageRepLevels_.clear();
+    pageIndices_.clear();
+    pageValues_.resize(0);
+    numPageBooleans_ = 0;
+  }
+
+  // Compresses 'body' and appends it with 'header' to 'chunk_'.
+  void writePage(thrift::PageHeader& header, const DataBuffer<char>& body) {
+    header.__set_uncompressed_page_size(body.size());
+    const char* data = body.data();
+    int64_t size = body.size();
+    DataBuffer<char> compressed(pool_);
+    if (codec_ != nullptr) {
+      const auto* input = reinterpret_cast<const uint8_t*>(data);
+      compressed.resize(codec_->MaxCompressedLen(size, input));
+      PARQUET_ASSIGN_OR_THROW(
+          size,
+          codec_->Compress(
+              size,
+              input,
+              compressed.size(),
+              reinterpret_cast<uint8_t*>(compressed.data())));
+      data = compressed.data();
+    }
+    header.__set_compressed_page_size(size);
+    const auto headerSize = serializeThrift(header, *chunk_);
+    chunk_->extendAppend(chunk_->size(), data, size);
+    totalUncompressedSize_ += headerSize + body.size();
+  }
+
+  template <typename T>
+  void updateStats(const T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+      return;
+    } else if constexpr (std::is_same_v<T, StringView>) {
+      const std::string_view view(value.data(), value.size());
+      if (!hasMinMax_ || view < minString_) {
+        minString_ = view;
+      }
+      if (!hasMinMax_ || view > maxString_) {
+        maxString_ = view;
+      }
+      hasMinMax_ = true;
+    } else if constexpr (std::is_floating_point_v<T>) {
+      // The order of NaN is not defined.
+      if (std::isnan(value)) {
+        return;
+      }
+      minDouble_ = hasMinMax_ ? std::min<double>(minDouble_, value) : value;
+      maxDouble_ = hasMinMax_ ? std::max<double>(maxDouble_, value) : value;
+      hasMinMax_ = true;
+    } else {
+      minInt_ = hasMinMax_ ? std::min<int64_t>(minInt_, value) : value;
+      maxInt_ = hasMinMax_ ? std::max<int64_t>(maxInt_, value) : value;
+      hasMinMax_ = true;
+    }
+  }
+
+  // Returns the statistics of the column chunk with the min and max in their
+  // PLAIN encoding without length.
+  thrift::Statistics statistics() const {
+    thrift::Statistics stats;
+    stats.__set_null_count(numNulls_);
+    if (!hasMinMax_) {
+      return stats;
+    }
+    auto raw = [](auto value) {
+      return std::string(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    switch (type_->kind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+        stats.__set_min_value(raw(static_cast<int32_t>(minInt_)));
+        stats.__set_max_value(raw(static_cast<int32_t>(maxInt_)));
+        break;
+      case TypeKind::BIGINT:
+        stats.__set_min_value(raw(minInt_));
+        stats.__set_max_value(raw(maxInt_));
+        break;
+      case TypeKind::REAL:
+        stats.__set_min_value(raw(static_cast<float>(minDouble_)));
+        stats.__set_max_value(raw(static_cast<float>(maxDouble_)));
+        break;
+      case TypeKind::DOUBLE:
+        stats.__set_min_value(raw(minDouble_));
+        stats.__set_max_value(raw(maxDouble_));
+        break;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        stats.__set_min_value(minString_);
+        stats.__set_max_value(maxString_);
+        break;
+      default:
+        break;
+    }
+    return stats;
+  }
+
+  const TypePtr type_;
+  const uint32_t maxRepeat_;
+  const uint32_t maxDefine_;
+  const std::vector<std::string> path_;
+  const thrift::Type::type parquetType_;
+  const bool enableDictionary_;
+  const int64_t dataPageSize_;
+  const int64_t dictionaryPageSizeLimit_;
+  const thrift::CompressionCodec::type codecKind_;
+  memory::MemoryPool& pool_;
+  std::unique_ptr<arrow::util::Codec> codec_;
+
+  DecodedVector decodedColumn_;
+  // Elements of the arrays of 'decodedColumn_'.
+  DecodedVector decodedValues_;
+
+  // Pages of the column chunk being written.
+  std::unique_ptr<DataBuffer<char>> chunk_;
+  // Base vector of the DictionaryVectors written as indices.
+  VectorPtr dictionary_;
+  int32_t dictionaryBitWidth_{0};
+  // Size of the dictionary page at the start of 'chunk_'.
+  int64_t dictionaryPageSize_{0};
+  std::set<thrift::Encoding::type> encodings_;
+  // Number of pages of each type and encoding. Readers tell from these
+  // whether all data pages are dictionary encoded.
+  std::map<std::pair<thrift::PageType::type, thrift::Encoding::type>, int32_t>
+      pageEncodingCounts_;
+  int64_t numValues_{0};
+  int64_t totalUncompressedSize_{0};
+
+  // Levels and values of the page being written.
+  std::vector<uint32_t> pageDefLevels_;
+  std::vector<uint32_t> pageRepLevels_;
+  std::vector<uint32_t> pageIndices_;
+  DataBuffer<char> pageValues_;
+  int64_t numPageBooleans_{0};
+  bool pageIsDictionary_{false};
+
+  // Statistics of the column chunk.
+  int64_t numNulls_{0};
+  bool hasMinMax_{false};
+  int64_t minInt_{0};
+  int64_t maxInt_{0};
+  double minDouble_{0};
+  double maxDouble_{0};
+  std::string minString_;
+  std::string maxString_;
+};
+
+NativeWriter::NativeWriter(
+    std::unique_ptr<dwio::common::FileSink> sink,
+    const WriterOptions& options,
+    RowTypePtr schema,
+    memory::MemoryPool& pool)
+    : sink_(std::move(sink)), schema_(std::move(schema)), pool_(pool) {
+  VELOX_CHECK(supports(*schema_));
+  thrift::SchemaElement root;
+  root.__set_name("schema");
+  root.__set_num_children(schema_->size());
+  schemaElements_.push_back(root);
+  for (auto i = 0; i < schema_->size(); ++i) {
+    const auto& name = schema_->nameOf(i);
+    const auto& type = schema_->childAt(i);
+    const auto leafType =
+        type->isArray() ? type->asArray().elementType() : type;
+    std::vector<std::string> path{name};
+    if (type->isArray()) {
+      thrift::SchemaElement list;
+      list.__set_name(name);
+      list.__set_repetition_type(thrift::FieldRepetitionType::OPTIONAL);
+      list.__set_converted_type(thrift::ConvertedType::LIST);
+      list.__set_num_children(1);
+      thrift::SchemaElement repeated;
+      repeated.__set_name("list");
+      repeated.__set_repetition_type(thrift::FieldRepetitionType::REPEATED);
+      repeated.__set_num_children(1);
+      schemaElements_.push_back(list);
+      schemaElements_.push_back(repeated);
+      schemaElements_.push_back(leafSchemaElement("element", leafType));
+      path.push_back("list");
+      path.push_back("element");
+    } else {
+      schemaElements_.push_back(leafSchemaElement(name, leafType));
+    }
+    auto compression = options.compression;
+    auto it = options.columnCompressionsMap.find(name);
+    if (it != options.columnCompressionsMap.end()) {
+      compression = it->second;
+    }
+    columns_.push_back(std::make_unique<ColumnChunkWriter>(
+        leafType,
+        type->isArray(),
+        std::move(path),
+        schemaElements_.back().type,
+        options,
+        compression,
+        pool_));
+  }
+
+  DataBuffer<char> magic(pool_);
+  magic.append(0, kMagic.data(), kMagic.size());
+  fileOffset_ = kMagic.size();
+  sink_->write(std::move(magic));
+}
+
+NativeWriter::~NativeWriter() = default;
+
+// static
+bool NativeWriter::supports(const RowType& schema) {
+  for (const auto& type : schema.children()) {
+    if (!isSupportedLeaf(
+            type->isArray() ? type->asArray().elementType() : type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void NativeWriter::write(const RowVector& data) {
+  VELOX_CHECK_EQ(data.childrenSize(), columns_.size());
+  for (auto i = 0; i < columns_.size(); ++i) {
+    columns_[i]->write(data.childAt(i));
+  }
+  numStagedRows_ += data.size();
+}
+
+int64_t NativeWriter::numStagedBytes() const {
+  int64_t size = 0;
+  for (const auto& column : columns_) {
+    size += column->numStagedBytes();
+  }
+  return size;
+}
+
+void NativeWriter::flush() {
+  if (numStagedRows_ == 0) {
+    return;
+  }
+  std::vector<DataBuffer<char>> buffers;
+  std::vector<thrift::ColumnChunk> columnChunks;
+  const auto rowGroupOffset = fileOffset_;
+  int64_t totalByteSize = 0;
+  for (auto& column : columns_) {
+    columnChunks.push_back(column->finish(fileOffset_, buffers));
+    const auto& metaData = columnChunks.back().meta_data;
+    fileOffset_ += metaData.total_compressed_size;
+    totalByteSize += metaData.total_uncompressed_size;
+  }
+  thrift::RowGroup rowGroup;
+  rowGroup.__set_columns(std::move(columnChunks));
+  rowGroup.__set_num_rows(numStagedRows_);
+  rowGroup.__set_total_byte_size(totalByteSize);
+  rowGroup.__set_file_offset(rowGroupOffset);
+  rowGroup.__set_total_compressed_size(fileOffset_ - rowGroupOffset);
+  rowGroups_.push_back(std::move(rowGroup));
+  sink_->write(buffers);
+  numRows_ += numStagedRows_;
+  numStagedRows_ = 0;
+}
+
+void NativeWriter::close() {
+  flush();
+  thrift::FileMetaData fileMetaData;
+  fileMetaData.__set_version(1);
+  fileMetaData.__set_schema(schemaElements_);
+  fileMetaData.__set_num_rows(numRows_);
+  fileMetaData.__set_row_groups(rowGroups_);
+  fileMetaData.__set_created_by("parquet-cpp-velox");
+
+  DataBuffer<char> footer(pool_);
+  const int32_t footerSize = serializeThrift(fileMetaData, footer);
+  appendRaw(footerSize, footer);
+  footer.extendAppend(footer.size(), kMagic.data(), kMagic.size());
+  sink_->write(std::move(footer));
+  sink_->close();
+  columns_.clear();
+}
+
+void NativeWriter::abort() {
+  sink_.reset();
+  columns_.clear();
+}
+
+} // namespace facebook::velox::parquet
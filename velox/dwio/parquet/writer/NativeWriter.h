@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/compression/Compression.h"
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/writer/arrow/Types.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::parquet {
+
+struct WriterOptions;
+
+class ColumnChunkWriter;
+
+arrow::Compression::type getArrowParquetCompression(
+    common::CompressionKind compression);
+
+/// Writes Velox vectors into Parquet pages without converting them to Arrow.
+/// Flat values are written PLAIN. A column of DictionaryVectors over one flat
+/// base vector is written with the base as the dictionary of the column chunk
+/// and the indices of the DictionaryVectors as RLE_DICTIONARY data pages, so
+/// that no value is hashed. The encoded pages of the row group being written
+/// are staged in buffers of 'pool' until flush(), so that the memory of a
+/// large row group is visible to the arbitrator. Supports top level columns
+/// of boolean, integer, floating point and string types and arrays of these.
+class NativeWriter {
+ public:
+  NativeWriter(
+      std::unique_ptr<dwio::common::FileSink> sink,
+      const WriterOptions& options,
+      RowTypePtr schema,
+      memory::MemoryPool& pool);
+
+  ~NativeWriter();
+
+  /// Returns true if all columns of 'schema' can be written by NativeWriter.
+  static bool supports(const RowType& schema);
+
+  /// Encodes 'data' into the pages of the current row group.
+  void write(const RowVector& data);
+
+  uint64_t numStagedRows() const {
+    return numStagedRows_;
+  }
+
+  /// Returns the size of the encoded pages of the current row group.
+  int64_t numStagedBytes() const;
+
+  /// Writes the staged pages as a row group. No-op if no row is staged.
+  void flush();
+
+  /// Writes the staged row group and the footer and closes the sink.
+  void close();
+
+  void abort();
+
+ private:
+  std::unique_ptr<dwio::common::FileSink> sink_;
+  const RowTypePtr schema_;
+  memory::MemoryPool& pool_;
+  // Leaf columns in schema order.
+  std::vector<std::unique_ptr<ColumnChunkWriter>> columns_;
+  std::vector<thrift::SchemaElement> schemaElements_;
+  std::vector<thrift::RowGroup> rowGroups_;
+  uint64_t numStagedRows_{0};
+  int64_t numRows_{0};
+  // Number of bytes written to 'sink_'.
+  int64_t fileOffset_{0};
+};
+
+} // namespace facebook::velox::parquet
@@ -140,6 +140,9 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
   }
   properties = properties->encoding(options.encoding);
   properties = properties->data_pagesize(options.dataPageSize);
+  if (options.writePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
   properties = properties->max_row_group_length(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
   properties = properties->codec_options(options.codecOptions);
@@ -222,13 +225,16 @@ Writer::Writer(
     RowTypePtr schema)
     : pool_(std::move(pool)),
       generalPool_{pool_->addLeafChild(".general")},
-      stream_(std::make_shared<ArrowDataBufferSink>(
-          std::move(sink),
-          *generalPool_,
-          options.bufferGrowRatio)),
       arrowContext_(std::make_shared<ArrowContext>()),
       schema_(std::move(schema)) {
   validateSchemaRecursive(schema_);
+  if (options.useNativeWriter && NativeWriter::supports(*schema_)) {
+    nativeWriter_ = std::make_unique<NativeWriter>(
+        std::move(sink), options, schema_, *generalPool_);
+  } else {
+    stream_ = std::make_shared<ArrowDataBufferSink>(
+        std::move(sink), *generalPool_, options.bufferGrowRatio);
+  }
 
   if (options.flushPolicyFactory) {
     flushPolicy_ = options.flushPolicyFactory();
@@ -254,7 +260,13 @@ Writer::Writer(
               folly::to<std::string>(folly::Random::rand64()))),
           std::move(schema)} {}
 
+Writer::~Writer() = default;
+
 void Writer::flush() {
+  if (nativeWriter_) {
+    nativeWriter_->flush();
+    return;
+  }
   if (arrowContext_->stagingRows > 0) {
     if (!arrowContext_->writer) {
       auto arrowProperties = ArrowWriterProperties::Builder().build();
@@ -313,6 +325,18 @@ void Writer::write(const VectorPtr& data) {
       data->type()->equivalent(*schema_),
       "The file schema type should be equal with the input rowvector type.");
 
+  if (nativeWriter_) {
+    if (flushPolicy_->shouldFlush(getStripeProgress(
+            nativeWriter_->numStagedRows(),
+            nativeWriter_->numStagedBytes()))) {
+      nativeWriter_->flush();
+    }
+    auto* rowVector = data->as<RowVector>();
+    VELOX_CHECK_NOT_NULL(rowVector, "Expected a RowVector");
+    nativeWriter_->write(*rowVector);
+    return;
+  }
+
   ArrowArray array;
   ArrowSchema schema;
   exportToArrow(data, array, generalPool_.get(), options_);
@@ -363,10 +387,18 @@ bool Writer::isCodecAvailable(common::CompressionKind compression) {
 }
 
 void Writer::newRowGroup(int32_t numRows) {
+  if (nativeWriter_) {
+    nativeWriter_->flush();
+    return;
+  }
   PARQUET_THROW_NOT_OK(arrowContext_->writer->NewRowGroup(numRows));
 }
 
 void Writer::close() {
+  if (nativeWriter_) {
+    nativeWriter_->close();
+    return;
+  }
   flush();
 
   if (arrowContext_->writer) {
@@ -379,6 +411,10 @@ void Writer::close() {
 }
 
 void Writer::abort() {
+  if (nativeWriter_) {
+    nativeWriter_->abort();
+    return;
+  }
   stream_->abort();
   arrowContext_.reset();
 }
@@ -23,6 +23,7 @@
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
+#include "velox/dwio/parquet/writer/NativeWriter.h"
 #include "velox/dwio/parquet/writer/arrow/Types.h"
 #include "velox/dwio/parquet/writer/arrow/util/Compression.h"
 #include "velox/vector/ComplexVector.h"
@@ -90,6 +91,9 @@ struct WriterOptions {
   bool enableDictionary = true;
   int64_t dataPageSize = 1'024 * 1'024;
   int64_t dictionaryPageSizeLimit = 1'024 * 1'024;
+  // If true, writes the ColumnIndex and OffsetIndex of each column chunk so
+  // that readers can skip the data pages that do not pass their filters.
+  bool writePageIndex = false;
   // Growth ratio passed to ArrowDataBufferSink. The default value is a
   // heuristic borrowed from
   // folly/FBVector(https://github.com/facebook/folly/blob/main/folly/docs/FBVector.md#memory-handling).
@@ -105,6 +109,10 @@ struct WriterOptions {
       columnCompressionsMap;
   uint8_t parquetWriteTimestampUnit =
       static_cast<uint8_t>(TimestampUnit::kNano);
+  // If true, schemas supported by NativeWriter are encoded directly from
+  // Velox vectors instead of through Arrow. Other schemas are written with
+  // Arrow.
+  bool useNativeWriter = false;
 };
 
 // Writes Velox vectors into  a DataSink using Arrow Parquet writer.
@@ -126,7 +134,7 @@ class Writer : public dwio::common::Writer {
       const WriterOptions& options,
       RowTypePtr schema);
 
-  ~Writer() override = default;
+  ~Writer() override;
 
   static bool isCodecAvailable(common::CompressionKind compression);
 
@@ -153,9 +161,14 @@ class Writer : public dwio::common::Writer {
   std::shared_ptr<memory::MemoryPool> pool_;
   std::shared_ptr<memory::MemoryPool> generalPool_;
 
-  // Temporary Arrow stream for capturing the output.
+  // Temporary Arrow stream for capturing the output. Not set if
+  // 'nativeWriter_' is set.
   std::shared_ptr<ArrowDataBufferSink> stream_;
 
+  // Encodes the data without Arrow if the options ask for it and the schema
+  // is supported.
+  std::unique_ptr<NativeWriter> nativeWriter_;
+
   std::shared_ptr<ArrowContext> arrowContext_;
 
   std::unique_ptr<DefaultFlushPolicy> flushPolicy_;
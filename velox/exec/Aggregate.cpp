@@ -20,6 +20,7 @@
 #include "velox/exec/AggregateCompanionAdapter.h"
 #include "velox/exec/AggregateCompanionSignatures.h"
 #include "velox/exec/AggregateWindow.h"
+#include "velox/expression/LazyFunctionRegistration.h"
 #include "velox/expression/SignatureBinder.h"
 
 namespace facebook::velox::exec {
@@ -34,10 +35,18 @@ bool isPartialOutput(core::AggregationNode::Step step) {
       step == core::AggregationNode::Step::kIntermediate;
 }
 
-AggregateFunctionMap& aggregateFunctions() {
+namespace {
+// The registry without the functions that are registered lazily.
+AggregateFunctionMap& aggregateFunctionsInternal() {
   static AggregateFunctionMap functions;
   return functions;
 }
+} // namespace
+
+AggregateFunctionMap& aggregateFunctions() {
+  ensureLazyFunctionsRegistered();
+  return aggregateFunctionsInternal();
+}
 
 const AggregateFunctionEntry* FOLLY_NULLABLE
 getAggregateFunctionEntry(const std::string& name) {
@@ -64,14 +73,14 @@ AggregateRegistrationResult registerAggregateFunction(
   AggregateRegistrationResult registered;
 
   if (overwrite) {
-    aggregateFunctions().withWLock([&](auto& aggregationFunctionMap) {
+    aggregateFunctionsInternal().withWLock([&](auto& aggregationFunctionMap) {
       aggregationFunctionMap[sanitizedName] = {
           signatures, std::move(factory), metadata};
     });
     registered.mainFunction = true;
   } else {
-    auto inserted =
-        aggregateFunctions().withWLock([&](auto& aggregationFunctionMap) {
+    auto inserted = aggregateFunctionsInternal().withWLock(
+        [&](auto& aggregationFunctionMap) {
           auto [_, inserted_2] = aggregationFunctionMap.insert(
               {sanitizedName, {signatures, factory, metadata}});
           return inserted_2;
@@ -89,6 +89,22 @@ class Aggregate {
     setAllocatorInternal(allocator);
   }
 
+  /// Returns true if relocate() is supported.
+  virtual bool supportsRelocation() const {
+    return false;
+  }
+
+  /// Copies the out of line state of the accumulators of 'groups' to
+  /// 'allocator' and points the accumulators to the copy. The previous state is
+  /// not freed because the caller frees the previous allocator as a whole. The
+  /// caller calls setAllocator() with 'allocator' after relocating all groups.
+  /// Used for compacting a fragmented allocator.
+  virtual void relocate(
+      folly::Range<char**> /*groups*/,
+      HashStringAllocator* /*allocator*/) {
+    VELOX_UNSUPPORTED("Aggregate does not support relocation");
+  }
+
   /// Called for functions that take one or more lambda expression as input.
   /// These expressions must appear after all non-lambda inputs.
   /// These expressions cannot use captures.
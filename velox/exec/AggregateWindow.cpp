@@ -29,6 +29,12 @@ namespace {
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
 // to frameEnd boundaries at that row using singleGroup.
+//
+// Sliding frames of aggregates that are not order sensitive are computed over
+// a segment tree of intermediate results of the partition instead. The leaves
+// hold the accumulators of kSegmentTreeLeafRows consecutive rows and each
+// upper node combines kSegmentTreeFanout nodes of the level below. A frame
+// adds the raw rows at its edges and the largest nodes covering the rest.
 class AggregateWindowFunction : public exec::WindowFunction {
  public:
   AggregateWindowFunction(
@@ -39,7 +45,8 @@ class AggregateWindowFunction : public exec::WindowFunction {
       velox::memory::MemoryPool* pool,
       HashStringAllocator* stringAllocator,
       const core::QueryConfig& config)
-      : WindowFunction(resultType, pool, stringAllocator) {
+      : WindowFunction(resultType, pool, stringAllocator),
+        segmentTreeEnabled_(useSegmentTree(name, config)) {
     VELOX_USER_CHECK(
         !ignoreNulls, "Aggregate window functions do not support IGNORE NULLS");
     argTypes_.reserve(args.size());
@@ -100,6 +107,11 @@ class AggregateWindowFunction : public exec::WindowFunction {
     // the aggregate to the final result.
     aggregateResultVector_ = BaseVector::create(resultType, 1, pool_);
 
+    if (segmentTreeEnabled_) {
+      accumulatorVector_ = BaseVector::create(
+          exec::Aggregate::intermediateType(name, argTypes_), 1, pool_);
+    }
+
     computeDefaultAggregateValue(resultType);
   }
 
@@ -116,6 +128,7 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    segmentTree_.clear();
   }
 
   void apply(
@@ -163,6 +176,21 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
+    } else if (
+        segmentTreeEnabled_ &&
+        frameMetadata.maxFrameSize >= kMinSegmentTreeFrameRows) {
+      if (segmentTree_.empty()) {
+        buildSegmentTree();
+      }
+      fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
+      segmentTreeAggregation(
+          validRows,
+          frameMetadata.firstRow,
+          frameMetadata.lastRow,
+          rawFrameStarts,
+          rawFrameEnds,
+          resultOffset,
+          result);
     } else {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
       simpleAggregation(
@@ -178,6 +206,30 @@ class AggregateWindowFunction : public exec::WindowFunction {
   }
 
  private:
+  // Number of rows aggregated by each leaf of the segment tree.
+  static constexpr vector_size_t kSegmentTreeLeafRows = 16;
+  // Number of child nodes combined by each upper node of the segment tree.
+  static constexpr vector_size_t kSegmentTreeFanout = 16;
+  // Frames with fewer rows are cheaper to aggregate directly.
+  static constexpr vector_size_t kMinSegmentTreeFrameRows =
+      2 * kSegmentTreeLeafRows;
+  // Number of partition rows to extract at once when building the leaves.
+  static constexpr vector_size_t kSegmentTreeBuildRows =
+      kSegmentTreeLeafRows * 64;
+
+  // The segment tree evaluation combines intermediate results of arbitrary
+  // groups of rows, so it only applies to aggregates that are not order
+  // sensitive.
+  static bool useSegmentTree(
+      const std::string& name,
+      const core::QueryConfig& config) {
+    if (!config.windowSegmentTreeEnabled()) {
+      return false;
+    }
+    const auto* entry = exec::getAggregateFunctionEntry(name);
+    return entry != nullptr && !entry->metadata.orderSensitive;
+  }
+
   struct FrameMetadata {
     // Min frame start row required for aggregation.
     vector_size_t firstRow;
@@ -193,6 +245,19 @@ class AggregateWindowFunction : public exec::WindowFunction {
 
     // Resume incremental aggregation from the prior block.
     bool usePreviousAggregate;
+
+    // Max number of rows in a valid frame of the block.
+    vector_size_t maxFrameSize;
+  };
+
+  // One level of the segment tree.
+  struct SegmentTreeLevel {
+    // The single argument for addSingleGroupIntermediateResults() with the
+    // intermediate result of each node of the level.
+    std::vector<VectorPtr> nodes;
+
+    // Selects the nodes to add to the accumulator.
+    SelectivityVector rows;
   };
 
   bool handleAllEmptyFrames(
@@ -225,9 +290,12 @@ class AggregateWindowFunction : public exec::WindowFunction {
     vector_size_t prevFrameEnds = lastRow;
 
     bool incrementalAggregation = true;
+    vector_size_t maxFrameSize = 0;
     validRows.applyToSelected([&](auto i) {
       firstRow = std::min(firstRow, rawFrameStarts[i]);
       lastRow = std::max(lastRow, rawFrameEnds[i]);
+      maxFrameSize =
+          std::max(maxFrameSize, rawFrameEnds[i] + 1 - rawFrameStarts[i]);
 
       // Incremental aggregation can be done if :
       // i) All rows have the same frameStart value.
@@ -251,7 +319,12 @@ class AggregateWindowFunction : public exec::WindowFunction {
       }
     }
 
-    return {firstRow, lastRow, incrementalAggregation, usePreviousAggregate};
+    return {
+        firstRow,
+        lastRow,
+        incrementalAggregation,
+        usePreviousAggregate,
+        maxFrameSize};
   }
 
   void fillArgVectors(vector_size_t firstRow, vector_size_t lastRow) {
@@ -345,6 +418,161 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Starts a new aggregation in the single group row.
+  void initializeSingleGroup() {
+    static const auto kSingleGroup = std::vector<vector_size_t>{0};
+    aggregate_->clear();
+    aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
+    aggregateInitialized_ = true;
+  }
+
+  // Appends the intermediate result of the single group row as node 'node' of
+  // 'level'.
+  void extractSegmentTreeNode(SegmentTreeLevel& level, vector_size_t node) {
+    BaseVector::prepareForReuse(accumulatorVector_, 1);
+    aggregate_->extractAccumulators(
+        &rawSingleGroupRow_, 1, &accumulatorVector_);
+    level.nodes[0]->copy(accumulatorVector_.get(), node, 0, 1);
+  }
+
+  SegmentTreeLevel& addSegmentTreeLevel(vector_size_t numNodes) {
+    auto& level = segmentTree_.emplace_back();
+    level.nodes.push_back(
+        BaseVector::create(accumulatorVector_->type(), numNodes, pool_));
+    level.rows.resize(numNodes);
+    return level;
+  }
+
+  // Builds the segment tree over all rows of 'partition_'.
+  void buildSegmentTree() {
+    const auto numRows = partition_->numRows();
+    auto* level = &addSegmentTreeLevel(
+        bits::divRoundUp(numRows, kSegmentTreeLeafRows));
+    SelectivityVector rows;
+    for (vector_size_t start = 0; start < numRows;
+         start += kSegmentTreeBuildRows) {
+      const auto end = std::min(numRows, start + kSegmentTreeBuildRows);
+      fillArgVectors(start, end - 1);
+      rows.resize(end - start);
+      for (auto leafStart = start; leafStart < end;
+           leafStart += kSegmentTreeLeafRows) {
+        const auto leafEnd = std::min(end, leafStart + kSegmentTreeLeafRows);
+        rows.clearAll();
+        rows.setValidRange(leafStart - start, leafEnd - start, true);
+        rows.updateBounds();
+        initializeSingleGroup();
+        aggregate_->addSingleGroupRawInput(
+            rawSingleGroupRow_, rows, argVectors_, false);
+        extractSegmentTreeNode(*level, leafStart / kSegmentTreeLeafRows);
+      }
+    }
+
+    while (level->rows.size() > 1) {
+      const auto numChildren = level->rows.size();
+      level = &addSegmentTreeLevel(
+          bits::divRoundUp(numChildren, kSegmentTreeFanout));
+      const auto childLevel = segmentTree_.size() - 2;
+      for (vector_size_t node = 0; node < level->rows.size(); ++node) {
+        initializeSingleGroup();
+        addSegmentTreeNodes(
+            childLevel,
+            node * kSegmentTreeFanout,
+            std::min(numChildren, (node + 1) * kSegmentTreeFanout));
+        extractSegmentTreeNode(*level, node);
+      }
+    }
+  }
+
+  // Adds the nodes ['begin', 'end') of level 'level' to the single group row.
+  void addSegmentTreeNodes(
+      vector_size_t level,
+      vector_size_t begin,
+      vector_size_t end) {
+    if (begin >= end) {
+      return;
+    }
+    auto& treeLevel = segmentTree_[level];
+    treeLevel.rows.clearAll();
+    treeLevel.rows.setValidRange(begin, end, true);
+    treeLevel.rows.updateBounds();
+    aggregate_->addSingleGroupIntermediateResults(
+        rawSingleGroupRow_, treeLevel.rows, treeLevel.nodes, false);
+  }
+
+  // Adds the partition rows ['begin', 'end') to the single group row. The
+  // arguments of these rows are in 'argVectors_' starting at partition row
+  // 'firstRow'.
+  void addRawRows(
+      SelectivityVector& rows,
+      vector_size_t firstRow,
+      vector_size_t begin,
+      vector_size_t end) {
+    if (begin >= end) {
+      return;
+    }
+    rows.clearAll();
+    rows.setValidRange(begin - firstRow, end - firstRow, true);
+    rows.updateBounds();
+    aggregate_->addSingleGroupRawInput(
+        rawSingleGroupRow_, rows, argVectors_, false);
+  }
+
+  // Adds the partition rows ['begin', 'end') to the single group row using
+  // the largest segment tree nodes within the range.
+  void addSegmentTreeFrame(
+      SelectivityVector& rows,
+      vector_size_t firstRow,
+      vector_size_t begin,
+      vector_size_t end) {
+    auto nodeBegin = bits::divRoundUp(begin, kSegmentTreeLeafRows);
+    auto nodeEnd = end / kSegmentTreeLeafRows;
+    if (nodeBegin >= nodeEnd) {
+      addRawRows(rows, firstRow, begin, end);
+      return;
+    }
+    addRawRows(rows, firstRow, begin, nodeBegin * kSegmentTreeLeafRows);
+    addRawRows(rows, firstRow, nodeEnd * kSegmentTreeLeafRows, end);
+
+    for (vector_size_t level = 0;; ++level) {
+      const auto parentBegin = bits::divRoundUp(nodeBegin, kSegmentTreeFanout);
+      const auto parentEnd = nodeEnd / kSegmentTreeFanout;
+      if (level + 1 == segmentTree_.size() || parentBegin >= parentEnd) {
+        addSegmentTreeNodes(level, nodeBegin, nodeEnd);
+        return;
+      }
+      addSegmentTreeNodes(
+          level, nodeBegin, parentBegin * kSegmentTreeFanout);
+      addSegmentTreeNodes(level, parentEnd * kSegmentTreeFanout, nodeEnd);
+      nodeBegin = parentBegin;
+      nodeEnd = parentEnd;
+    }
+  }
+
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      vector_size_t minFrame,
+      vector_size_t maxFrame,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    SelectivityVector rows;
+    rows.resize(maxFrame + 1 - minFrame);
+
+    validRows.applyToSelected([&](auto i) {
+      initializeSingleGroup();
+      addSegmentTreeFrame(
+          rows, minFrame, frameStartsVector[i], frameEndsVector[i] + 1);
+      BaseVector::prepareForReuse(aggregateResultVector_, 1);
+      aggregate_->extractValues(
+          &rawSingleGroupRow_, 1, &aggregateResultVector_);
+      result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -358,6 +586,9 @@ class AggregateWindowFunction : public exec::WindowFunction {
     aggregate_->clear();
   }
 
+  // True if sliding frames may be computed over 'segmentTree_'.
+  const bool segmentTreeEnabled_;
+
   // Aggregate function object required for this window function evaluation.
   std::unique_ptr<exec::Aggregate> aggregate_;
 
@@ -389,6 +620,14 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // to optimize aggregate computation and reading argument vectors.
   std::optional<FrameMetadata> previousFrameMetadata_;
 
+  // The levels of the segment tree over the rows of 'partition_' starting at
+  // the leaves. Built on first use for a partition.
+  std::vector<SegmentTreeLevel> segmentTree_;
+
+  // Single row intermediate result used to copy from the aggregate to the
+  // segment tree.
+  VectorPtr accumulatorVector_;
+
   // Stores default result value for empty frame aggregation. Window functions
   // return the default value of an aggregate (aggregation with no rows) for
   // empty frames. e.g. count for empty frames should return 0 and not null.
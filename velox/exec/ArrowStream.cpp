@@ -14,10 +14,20 @@
  * limitations under the License.
  */
 #include "velox/exec/ArrowStream.h"
+#include "velox/exec/Task.h"
 #include "velox/vector/arrow/Bridge.h"
 
 namespace facebook::velox::exec {
 
+ArrowStream::Batch::~Batch() {
+  if (array.release) {
+    array.release(&array);
+  }
+  if (schema.release) {
+    schema.release(&schema);
+  }
+}
+
 ArrowStream::ArrowStream(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -27,7 +37,11 @@ ArrowStream::ArrowStream(
           arrowStreamNode->outputType(),
           operatorId,
           arrowStreamNode->id(),
-          "ArrowStream") {
+          "ArrowStream"),
+      prefetchBatches_(driverCtx->queryConfig().arrowStreamPrefetchBatches()),
+      executor_(
+          prefetchBatches_ > 0 ? driverCtx->task->queryCtx()->executor()
+                               : nullptr) {
   arrowStream_ = arrowStreamNode->arrowStream();
 }
 
@@ -35,39 +49,107 @@ ArrowStream::~ArrowStream() {
   close();
 }
 
-RowVectorPtr ArrowStream::getOutput() {
+std::unique_ptr<ArrowStream::Batch> ArrowStream::fetch() {
   // Get Arrow array.
-  struct ArrowArray arrowArray;
-  if (arrowStream_->get_next(arrowStream_.get(), &arrowArray)) {
-    if (arrowArray.release) {
-      arrowArray.release(&arrowArray);
-    }
+  auto batch = std::make_unique<Batch>();
+  if (arrowStream_->get_next(arrowStream_.get(), &batch->array)) {
     VELOX_FAIL(
         "Failed to call get_next on ArrowStream: {}", std::string(getError()));
   }
-  if (arrowArray.release == nullptr) {
+  if (batch->array.release == nullptr) {
     // End of Stream.
-    finished_ = true;
     return nullptr;
   }
 
   // Get Arrow schema.
-  struct ArrowSchema arrowSchema;
-  if (arrowStream_->get_schema(arrowStream_.get(), &arrowSchema)) {
-    if (arrowSchema.release) {
-      arrowSchema.release(&arrowSchema);
-    }
-    if (arrowArray.release) {
-      arrowArray.release(&arrowArray);
-    }
+  if (arrowStream_->get_schema(arrowStream_.get(), &batch->schema)) {
     VELOX_FAIL(
         "Failed to call get_schema on ArrowStream: {}",
         std::string(getError()));
   }
+  return batch;
+}
+
+RowVectorPtr ArrowStream::getOutput() {
+  std::unique_ptr<Batch> batch;
+  if (executor_ == nullptr) {
+    batch = fetch();
+    if (batch == nullptr) {
+      finished_ = true;
+      return nullptr;
+    }
+  } else {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    if (batches_.empty()) {
+      finished_ = atEnd_;
+      maybeScheduleFetchLocked();
+      return nullptr;
+    }
+    batch = std::move(batches_.front());
+    batches_.pop_front();
+    maybeScheduleFetchLocked();
+  }
 
-  // Convert Arrow Array into RowVector and return.
+  // Convert Arrow Array into RowVector and return. The vector takes over the
+  // Arrow buffers.
   return std::dynamic_pointer_cast<RowVector>(
-      importFromArrowAsOwner(arrowSchema, arrowArray, pool()));
+      importFromArrowAsOwner(batch->schema, batch->array, pool()));
+}
+
+BlockingReason ArrowStream::isBlocked(ContinueFuture* future) {
+  if (executor_ == nullptr) {
+    return BlockingReason::kNotBlocked;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (!batches_.empty() || atEnd_ || error_) {
+    return BlockingReason::kNotBlocked;
+  }
+  maybeScheduleFetchLocked();
+  promises_.emplace_back("ArrowStream::isBlocked");
+  *future = promises_.back().getSemiFuture();
+  return BlockingReason::kWaitForProducer;
+}
+
+void ArrowStream::maybeScheduleFetchLocked() {
+  if (fetching_ || atEnd_ || closed_ || error_ ||
+      static_cast<int32_t>(batches_.size()) >= prefetchBatches_) {
+    return;
+  }
+  fetching_ = true;
+  executor_->add([this]() { fetchInBackground(); });
+}
+
+void ArrowStream::fetchInBackground() {
+  std::unique_ptr<Batch> batch;
+  std::exception_ptr error;
+  try {
+    batch = fetch();
+  } catch (const std::exception&) {
+    error = std::current_exception();
+  }
+
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    fetching_ = false;
+    if (error) {
+      error_ = std::move(error);
+    } else if (batch == nullptr) {
+      atEnd_ = true;
+    } else {
+      batches_.push_back(std::move(batch));
+    }
+    maybeScheduleFetchLocked();
+    promises = takePromisesLocked();
+    // close() may free 'this' once the mutex is released.
+    fetchDone_.notify_all();
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
 }
 
 bool ArrowStream::isFinished() {
@@ -81,6 +163,20 @@ const char* ArrowStream::getError() const {
 }
 
 void ArrowStream::close() {
+  if (executor_ != nullptr) {
+    std::vector<ContinuePromise> promises;
+    {
+      // The stream must not be released while a fetch is using it.
+      std::unique_lock<std::mutex> l(mutex_);
+      closed_ = true;
+      fetchDone_.wait(l, [&]() { return !fetching_; });
+      batches_.clear();
+      promises = takePromisesLocked();
+    }
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  }
   if (arrowStream_->release) {
     arrowStream_->release(arrowStream_.get());
   }
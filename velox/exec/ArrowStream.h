@@ -14,12 +14,23 @@
  * limitations under the License.
  */
 #include "velox/core/PlanNode.h"
+#include <condition_variable>
+#include <deque>
+
 #include "velox/exec/Operator.h"
 
 #include "velox/vector/arrow/Abi.h"
 
 namespace facebook::velox::exec {
 
+/// Reads the batches of an ArrowArrayStream. The Arrow buffers are imported
+/// without copies where the layouts match and stay alive until the vectors
+/// referencing them are freed.
+///
+/// If kArrowStreamPrefetchBatches is positive and the query has an executor,
+/// the batches are fetched from the stream on the executor, up to that many
+/// ahead of the consumer, so that a slow stream, e.g. Arrow Flight, does not
+/// stall the driver. The stream is only called from one thread at a time.
 class ArrowStream : public SourceOperator {
  public:
   ArrowStream(
@@ -31,20 +42,58 @@ class ArrowStream : public SourceOperator {
 
   RowVectorPtr getOutput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
   void close() override;
 
  private:
+  // An array fetched from the stream with its schema. Releases both unless
+  // they have been imported.
+  struct Batch {
+    ~Batch();
+
+    ArrowArray array{};
+    ArrowSchema schema{};
+  };
+
   /// Return last error in Arrow array stream.
   const char* getError() const;
 
+  // Fetches the next batch from 'arrowStream_'. Returns nullptr at the end of
+  // the stream.
+  std::unique_ptr<Batch> fetch();
+
+  // Schedules a fetch on 'executor_' unless one is running, the stream is at
+  // end or 'prefetchBatches_' batches are queued.
+  void maybeScheduleFetchLocked();
+
+  // Runs on 'executor_'. Appends the next batch to 'batches_' or records the
+  // end of the stream or the error, and wakes up the driver.
+  void fetchInBackground();
+
+  // Returns the promises of the drivers waiting for a batch.
+  std::vector<ContinuePromise> takePromisesLocked() {
+    return std::move(promises_);
+  }
+
+  const int32_t prefetchBatches_;
+  folly::Executor* const executor_;
+
   bool finished_ = false;
   std::shared_ptr<ArrowArrayStream> arrowStream_;
+
+  // State shared with the background fetches.
+  std::mutex mutex_;
+  // Signaled when a background fetch ends.
+  std::condition_variable fetchDone_;
+  std::deque<std::unique_ptr<Batch>> batches_;
+  bool fetching_{false};
+  bool atEnd_{false};
+  bool closed_{false};
+  std::exception_ptr error_;
+  std::vector<ContinuePromise> promises_;
 };
 
 } // namespace facebook::velox::exec
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/CoalesceBatches.h"
+
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::exec {
+
+CoalesceBatches::CoalesceBatches(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    const core::PlanNodePtr& upstreamNode)
+    : Operator(
+          driverCtx,
+          upstreamNode->outputType(),
+          operatorId,
+          upstreamNode->id(),
+          "CoalesceBatches"),
+      maxDelayMs_(driverCtx->queryConfig().coalesceBatchesMaxDelayMs()) {
+  const auto numColumns = outputType_->size();
+  identityProjections_.reserve(numColumns);
+  for (column_index_t i = 0; i < numColumns; ++i) {
+    identityProjections_.emplace_back(i, i);
+  }
+}
+
+// static
+bool CoalesceBatches::mayProduceSmallBatches(const core::PlanNode& node) {
+  return dynamic_cast<const core::FilterNode*>(&node) != nullptr ||
+      dynamic_cast<const core::HashJoinNode*>(&node) != nullptr ||
+      dynamic_cast<const core::UnnestNode*>(&node) != nullptr;
+}
+
+void CoalesceBatches::addInput(RowVectorPtr input) {
+  if (targetRows_ == 0) {
+    targetRows_ = outputBatchRows(input->estimateFlatSize() / input->size());
+  }
+  input_ = std::move(input);
+}
+
+RowVectorPtr CoalesceBatches::getOutput() {
+  const auto minRows = std::max<vector_size_t>(1, targetRows_ / 2);
+  if (input_ != nullptr) {
+    if (input_->size() >= minRows) {
+      // Keeps the order of the rows by producing the buffered ones first.
+      if (numBufferedRows_ > 0) {
+        return flush();
+      }
+      return std::move(input_);
+    }
+    appendInput();
+  }
+  if (numBufferedRows_ == 0) {
+    return nullptr;
+  }
+  if (numBufferedRows_ >= minRows || noMoreInput_ ||
+      getCurrentTimeMs() - bufferStartMs_ >= maxDelayMs_) {
+    return flush();
+  }
+  return nullptr;
+}
+
+void CoalesceBatches::appendInput() {
+  if (buffer_ == nullptr) {
+    if (lastOutput_ != nullptr && lastOutput_.unique()) {
+      VectorPtr released = std::move(lastOutput_);
+      vectorPool_.release(released);
+    }
+    buffer_ = std::static_pointer_cast<RowVector>(
+        vectorPool_.get(outputType_, 0));
+    bufferStartMs_ = getCurrentTimeMs();
+  }
+  const auto numRows = input_->size();
+  input_->loadedVector();
+  buffer_->resize(numBufferedRows_ + numRows);
+  const BaseVector::CopyRange range{0, numBufferedRows_, numRows};
+  buffer_->copyRanges(input_.get(), folly::Range(&range, 1));
+  numBufferedRows_ += numRows;
+  ++numBufferedBatches_;
+  input_ = nullptr;
+}
+
+RowVectorPtr CoalesceBatches::flush() {
+  addRuntimeStat(
+      "coalescedInputBatches", RuntimeCounter(numBufferedBatches_));
+  numBufferedRows_ = 0;
+  numBufferedBatches_ = 0;
+  lastOutput_ = std::move(buffer_);
+  return lastOutput_;
+}
+
+void CoalesceBatches::close() {
+  Operator::close();
+  buffer_ = nullptr;
+  lastOutput_ = nullptr;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/exec/Operator.h"
+#include "velox/vector/VectorPool.h"
+
+namespace facebook::velox::exec {
+
+/// Merges the small batches of its upstream operator, e.g. a selective
+/// filter, a hash probe or an unnest, into batches of about the preferred
+/// output batch size, so that the downstream operators do not pay their
+/// per-batch overhead on each small batch. Batches of at least half the
+/// target size pass through without a copy. Small batches are copied into
+/// recycled vectors with copyRanges(). Buffered rows are produced when they
+/// reach half the target size, at the end of the input or after
+/// QueryConfig::kCoalesceBatchesMaxDelayMs. Reports under the plan node of
+/// the upstream operator, in PlanNodeStats::operatorStats only, so the totals
+/// of the node are the same as without it. Added by the LocalPlanner if
+/// QueryConfig::kCoalesceBatches is set.
+class CoalesceBatches : public Operator {
+ public:
+  CoalesceBatches(
+      int32_t operatorId,
+      DriverCtx* driverCtx,
+      const core::PlanNodePtr& upstreamNode);
+
+  /// Returns true if the output of 'node' may have much fewer rows than its
+  /// input.
+  static bool mayProduceSmallBatches(const core::PlanNode& node);
+
+  bool isFilter() const override {
+    return true;
+  }
+
+  bool preservesOrder() const override {
+    return true;
+  }
+
+  bool needsInput() const override {
+    return !noMoreInput_ && input_ == nullptr;
+  }
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override;
+
+  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
+    return BlockingReason::kNotBlocked;
+  }
+
+  bool isFinished() override {
+    return noMoreInput_ && input_ == nullptr && numBufferedRows_ == 0;
+  }
+
+  void close() override;
+
+ private:
+  // Copies 'input_' to the end of 'buffer_'.
+  void appendInput();
+
+  // Returns the buffered rows and starts a new buffer.
+  RowVectorPtr flush();
+
+  const uint64_t maxDelayMs_;
+
+  // Number of rows to coalesce to. Set on the first input.
+  vector_size_t targetRows_{0};
+
+  RowVectorPtr buffer_;
+  vector_size_t numBufferedRows_{0};
+  int32_t numBufferedBatches_{0};
+
+  // Time the first row in 'buffer_' was added.
+  uint64_t bufferStartMs_{0};
+
+  // Last flushed buffer. Recycled once the consumers release it.
+  RowVectorPtr lastOutput_;
+
+  VectorPool vectorPool_{pool()};
+};
+
+} // namespace facebook::velox::exec
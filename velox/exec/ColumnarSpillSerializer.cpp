@@ -0,0 +1,904 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/ColumnarSpillSerializer.h"
+
+#include <folly/container/F14Map.h>
+#include <folly/lang/Bits.h>
+
+#include <numeric>
+
+#include "velox/common/base/Nulls.h"
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::exec {
+namespace {
+// The encodings of a column in a batch.
+enum class ColumnEncoding : uint8_t {
+  // A Presto block of all the rows.
+  kPresto = 0,
+  // A null flag followed by the value as a column of one row if not null.
+  kConstant = 1,
+  // The dictionary nulls, the indices and the values as a column.
+  kDictionary = 2,
+  // The nulls and the integers as frame of reference deltas.
+  kFrameOfReference = 3,
+  // The nulls, the string lengths and the string bytes.
+  kStrings = 4,
+  // The nulls, the indices of the distinct strings and the distinct strings.
+  kStringDictionary = 5,
+};
+
+// The Presto blocks serialize timestamps with nanosecond precision like the
+// Presto spill format.
+serializer::presto::PrestoVectorSerde::PrestoOptions prestoOptions() {
+  return {
+      true /*useLosslessTimestamp*/,
+      common::CompressionKind::CompressionKind_NONE,
+      true /*nullsFirst*/};
+}
+
+template <typename T>
+void append(T value, std::string& out) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void appendEncoding(ColumnEncoding encoding, std::string& out) {
+  append(static_cast<uint8_t>(encoding), out);
+}
+
+void writeNulls(
+    const uint64_t* nulls,
+    vector_size_t numRows,
+    std::string& out) {
+  if (nulls == nullptr || bits::countNulls(nulls, 0, numRows) == 0) {
+    append<uint8_t>(0, out);
+    return;
+  }
+  append<uint8_t>(1, out);
+  out.append(reinterpret_cast<const char*>(nulls), bits::nbytes(numRows));
+}
+
+// Returns the byte width of the deltas of values at most 'range' apart.
+uint8_t deltaWidth(uint64_t range) {
+  if (range == 0) {
+    return 0;
+  }
+  if (range <= std::numeric_limits<uint8_t>::max()) {
+    return 1;
+  }
+  if (range <= std::numeric_limits<uint16_t>::max()) {
+    return 2;
+  }
+  if (range <= std::numeric_limits<uint32_t>::max()) {
+    return 4;
+  }
+  return 8;
+}
+
+template <typename D, typename T>
+void writeDeltas(
+    const T* values,
+    const uint64_t* nulls,
+    vector_size_t numRows,
+    int64_t min,
+    char* deltas) {
+  for (auto row = 0; row < numRows; ++row) {
+    D delta = 0;
+    if (nulls == nullptr || !bits::isBitNull(nulls, row)) {
+      delta = static_cast<D>(
+          static_cast<uint64_t>(static_cast<int64_t>(values[row])) -
+          static_cast<uint64_t>(min));
+    }
+    ::memcpy(deltas + row * sizeof(D), &delta, sizeof(D));
+  }
+}
+
+// Writes the minimum of the non-null 'values', the delta width and the
+// deltas of 'values' from the minimum. The deltas of null rows are 0.
+template <typename T>
+void writeInts(
+    const T* values,
+    const uint64_t* nulls,
+    vector_size_t numRows,
+    std::string& out) {
+  int64_t min = std::numeric_limits<int64_t>::max();
+  int64_t max = std::numeric_limits<int64_t>::min();
+  for (auto row = 0; row < numRows; ++row) {
+    if (nulls == nullptr || !bits::isBitNull(nulls, row)) {
+      min = std::min<int64_t>(min, values[row]);
+      max = std::max<int64_t>(max, values[row]);
+    }
+  }
+  if (min > max) {
+    min = 0;
+    max = 0;
+  }
+  const auto width =
+      deltaWidth(static_cast<uint64_t>(max) - static_cast<uint64_t>(min));
+  append(min, out);
+  append(width, out);
+  if (width == 0) {
+    return;
+  }
+  const auto offset = out.size();
+  out.resize(offset + static_cast<size_t>(numRows) * width);
+  auto* deltas = out.data() + offset;
+  switch (width) {
+    case 1:
+      writeDeltas<uint8_t>(values, nulls, numRows, min, deltas);
+      break;
+    case 2:
+      writeDeltas<uint16_t>(values, nulls, numRows, min, deltas);
+      break;
+    case 4:
+      writeDeltas<uint32_t>(values, nulls, numRows, min, deltas);
+      break;
+    default:
+      writeDeltas<uint64_t>(values, nulls, numRows, min, deltas);
+      break;
+  }
+}
+
+template <typename T>
+void writeFrameOfReference(const BaseVector& vector, std::string& out) {
+  const auto* flat = vector.asUnchecked<FlatVector<T>>();
+  appendEncoding(ColumnEncoding::kFrameOfReference, out);
+  writeNulls(flat->rawNulls(), flat->size(), out);
+  writeInts(flat->rawValues(), flat->rawNulls(), flat->size(), out);
+}
+
+// Writes the lengths and then the bytes of 'strings'.
+void writeStringBytes(
+    const std::vector<std::string_view>& strings,
+    std::string& out) {
+  std::vector<int32_t> lengths(strings.size());
+  for (auto i = 0; i < strings.size(); ++i) {
+    lengths[i] = strings[i].size();
+  }
+  writeInts(lengths.data(), nullptr, lengths.size(), out);
+  for (auto string : strings) {
+    out.append(string);
+  }
+}
+
+void writeStrings(const BaseVector& vector, std::string& out) {
+  const auto* flat = vector.asUnchecked<FlatVector<StringView>>();
+  const auto numRows = flat->size();
+  const auto* nulls = flat->rawNulls();
+  const auto* values = flat->rawValues();
+  const auto numNonNull =
+      numRows - (nulls == nullptr ? 0 : bits::countNulls(nulls, 0, numRows));
+
+  // The strings are kept with a dictionary if at most half of them are
+  // distinct.
+  folly::F14FastMap<std::string_view, int32_t> ids;
+  std::vector<std::string_view> strings;
+  std::vector<int32_t> rowIds(numRows, 0);
+  bool useDictionary = numNonNull > 1;
+  for (auto row = 0; row < numRows && useDictionary; ++row) {
+    if (nulls != nullptr && bits::isBitNull(nulls, row)) {
+      continue;
+    }
+    const std::string_view value(values[row].data(), values[row].size());
+    const auto [it, inserted] = ids.emplace(value, strings.size());
+    if (inserted) {
+      strings.push_back(value);
+      useDictionary = strings.size() <= numNonNull / 2;
+    }
+    rowIds[row] = it->second;
+  }
+
+  if (useDictionary) {
+    appendEncoding(ColumnEncoding::kStringDictionary, out);
+    writeNulls(nulls, numRows, out);
+    append<int32_t>(strings.size(), out);
+    writeInts(rowIds.data(), nulls, numRows, out);
+    writeStringBytes(strings, out);
+    return;
+  }
+  strings.clear();
+  strings.reserve(numNonNull);
+  for (auto row = 0; row < numRows; ++row) {
+    if (nulls == nullptr || !bits::isBitNull(nulls, row)) {
+      strings.emplace_back(values[row].data(), values[row].size());
+    }
+  }
+  appendEncoding(ColumnEncoding::kStrings, out);
+  writeNulls(nulls, numRows, out);
+  writeStringBytes(strings, out);
+}
+
+void writePresto(
+    const VectorPtr& vector,
+    memory::MemoryPool* pool,
+    std::string& out) {
+  appendEncoding(ColumnEncoding::kPresto, out);
+  const auto rowType = ROW({"c0"}, {vector->type()});
+  auto row = std::make_shared<RowVector>(
+      pool,
+      rowType,
+      nullptr,
+      vector->size(),
+      std::vector<VectorPtr>{vector});
+  const auto options = prestoOptions();
+  StreamArena arena(pool);
+  serializer::presto::PrestoVectorSerde serde;
+  auto serializer =
+      serde.createIterativeSerializer(rowType, row->size(), &arena, &options);
+  serializer->append(row);
+  IOBufOutputStream stream(*pool, nullptr, serializer->maxSerializedSize());
+  serializer->flush(&stream);
+  for (auto range : *stream.getIOBuf()) {
+    out.append(reinterpret_cast<const char*>(range.data()), range.size());
+  }
+}
+
+// Writes 'vector', which is flat if it is of a scalar type.
+void writeFlat(
+    const VectorPtr& vector,
+    memory::MemoryPool* pool,
+    std::string& out) {
+  switch (vector->typeKind()) {
+    case TypeKind::TINYINT:
+      writeFrameOfReference<int8_t>(*vector, out);
+      break;
+    case TypeKind::SMALLINT:
+      writeFrameOfReference<int16_t>(*vector, out);
+      break;
+    case TypeKind::INTEGER:
+      writeFrameOfReference<int32_t>(*vector, out);
+      break;
+    case TypeKind::BIGINT:
+      writeFrameOfReference<int64_t>(*vector, out);
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      writeStrings(*vector, out);
+      break;
+    default:
+      writePresto(vector, pool, out);
+      break;
+  }
+}
+
+BufferPtr copyToBuffer(
+    const void* data,
+    size_t bytes,
+    memory::MemoryPool* pool) {
+  auto buffer = AlignedBuffer::allocate<char>(bytes, pool);
+  ::memcpy(buffer->asMutable<char>(), data, bytes);
+  return buffer;
+}
+
+// Decodes the columns of a batch. The strings of the result point into the
+// batch.
+class BatchReader {
+ public:
+  BatchReader(BufferPtr data, memory::MemoryPool* pool)
+      : data_(std::move(data)),
+        pool_(pool),
+        position_(data_->as<char>()),
+        end_(position_ + data_->size()) {}
+
+  template <typename T>
+  T read() {
+    T value;
+    ::memcpy(&value, readBytes(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  const char* readBytes(size_t bytes) {
+    VELOX_CHECK_LE(bytes, end_ - position_, "Reading past end of spill batch");
+    const auto* begin = position_;
+    position_ += bytes;
+    return begin;
+  }
+
+  const char* position() const {
+    return position_;
+  }
+
+  // Skips to 'position', which is not before the current position.
+  void skipTo(const char* position) {
+    VELOX_CHECK(position >= position_ && position <= end_);
+    position_ = position;
+  }
+
+  VectorPtr readColumn(const TypePtr& type, vector_size_t numRows);
+
+ private:
+  BufferPtr readNulls(vector_size_t numRows);
+
+  template <typename T>
+  void readInts(vector_size_t numRows, T* values);
+
+  template <typename D, typename T>
+  void readDeltas(vector_size_t numRows, int64_t min, T* values);
+
+  template <typename T>
+  VectorPtr readFrameOfReference(const TypePtr& type, vector_size_t numRows);
+
+  // Reads the lengths and the bytes of 'numStrings' strings.
+  BufferPtr readStringViews(vector_size_t numStrings, const uint64_t* nulls);
+
+  VectorPtr readPresto(const TypePtr& type);
+
+  const BufferPtr data_;
+  memory::MemoryPool* const pool_;
+  const char* position_;
+  const char* const end_;
+};
+
+BufferPtr BatchReader::readNulls(vector_size_t numRows) {
+  if (read<uint8_t>() == 0) {
+    return nullptr;
+  }
+  auto nulls = AlignedBuffer::allocate<bool>(numRows, pool_);
+  ::memcpy(
+      nulls->asMutable<char>(),
+      readBytes(bits::nbytes(numRows)),
+      bits::nbytes(numRows));
+  return nulls;
+}
+
+template <typename D, typename T>
+void BatchReader::readDeltas(vector_size_t numRows, int64_t min, T* values) {
+  const auto* deltas = readBytes(static_cast<size_t>(numRows) * sizeof(D));
+  for (auto row = 0; row < numRows; ++row) {
+    values[row] = static_cast<T>(
+        static_cast<uint64_t>(min) +
+        folly::loadUnaligned<D>(deltas + row * sizeof(D)));
+  }
+}
+
+template <typename T>
+void BatchReader::readInts(vector_size_t numRows, T* values) {
+  const auto min = read<int64_t>();
+  const auto width = read<uint8_t>();
+  switch (width) {
+    case 0:
+      std::fill(values, values + numRows, static_cast<T>(min));
+      break;
+    case 1:
+      readDeltas<uint8_t>(numRows, min, values);
+      break;
+    case 2:
+      readDeltas<uint16_t>(numRows, min, values);
+      break;
+    case 4:
+      readDeltas<uint32_t>(numRows, min, values);
+      break;
+    case 8:
+      readDeltas<uint64_t>(numRows, min, values);
+      break;
+    default:
+      VELOX_FAIL("Bad frame of reference width in spill batch: {}", width);
+  }
+}
+
+template <typename T>
+VectorPtr BatchReader::readFrameOfReference(
+    const TypePtr& type,
+    vector_size_t numRows) {
+  auto nulls = readNulls(numRows);
+  auto values = AlignedBuffer::allocate<T>(numRows, pool_);
+  readInts(numRows, values->template asMutable<T>());
+  return std::make_shared<FlatVector<T>>(
+      pool_,
+      type,
+      std::move(nulls),
+      numRows,
+      std::move(values),
+      std::vector<BufferPtr>{});
+}
+
+BufferPtr BatchReader::readStringViews(
+    vector_size_t numStrings,
+    const uint64_t* nulls) {
+  auto values = AlignedBuffer::allocate<StringView>(numStrings, pool_);
+  auto* rawValues = values->asMutable<StringView>();
+  const auto numNonNull = numStrings -
+      (nulls == nullptr ? 0 : bits::countNulls(nulls, 0, numStrings));
+  std::vector<int32_t> lengths(numNonNull);
+  readInts(numNonNull, lengths.data());
+  auto next = 0;
+  for (auto i = 0; i < numStrings; ++i) {
+    if (nulls != nullptr && bits::isBitNull(nulls, i)) {
+      rawValues[i] = StringView();
+      continue;
+    }
+    const auto length = lengths[next++];
+    rawValues[i] = StringView(readBytes(length), length);
+  }
+  return values;
+}
+
+VectorPtr BatchReader::readPresto(const TypePtr& type) {
+  ByteInputStream input({ByteRange{
+      reinterpret_cast<uint8_t*>(const_cast<char*>(position_)),
+      static_cast<int32_t>(end_ - position_),
+      0}});
+  RowVectorPtr row;
+  const auto options = prestoOptions();
+  serializer::presto::PrestoVectorSerde().deserialize(
+      &input, pool_, ROW({"c0"}, {type}), &row, &options);
+  position_ += static_cast<int64_t>(input.tellp());
+  return row->childAt(0);
+}
+
+VectorPtr BatchReader::readColumn(const TypePtr& type, vector_size_t numRows) {
+  const auto encoding = static_cast<ColumnEncoding>(read<uint8_t>());
+  switch (encoding) {
+    case ColumnEncoding::kPresto:
+      return readPresto(type);
+    case ColumnEncoding::kConstant:
+      if (read<uint8_t>() != 0) {
+        return BaseVector::createNullConstant(type, numRows, pool_);
+      }
+      return BaseVector::wrapInConstant(numRows, 0, readColumn(type, 1));
+    case ColumnEncoding::kDictionary: {
+      auto nulls = readNulls(numRows);
+      auto indices = allocateIndices(numRows, pool_);
+      readInts(numRows, indices->asMutable<vector_size_t>());
+      const auto numValues = read<int32_t>();
+      return BaseVector::wrapInDictionary(
+          std::move(nulls),
+          std::move(indices),
+          numRows,
+          readColumn(type, numValues));
+    }
+    case ColumnEncoding::kFrameOfReference:
+      switch (type->kind()) {
+        case TypeKind::TINYINT:
+          return readFrameOfReference<int8_t>(type, numRows);
+        case TypeKind::SMALLINT:
+          return readFrameOfReference<int16_t>(type, numRows);
+        case TypeKind::INTEGER:
+          return readFrameOfReference<int32_t>(type, numRows);
+        case TypeKind::BIGINT:
+          return readFrameOfReference<int64_t>(type, numRows);
+        default:
+          VELOX_FAIL(
+              "Frame of reference spill column of type {}", type->toString());
+      }
+    case ColumnEncoding::kStrings: {
+      auto nulls = readNulls(numRows);
+      auto values = readStringViews(
+          numRows, nulls == nullptr ? nullptr : nulls->as<uint64_t>());
+      return std::make_shared<FlatVector<StringView>>(
+          pool_,
+          type,
+          std::move(nulls),
+          numRows,
+          std::move(values),
+          std::vector<BufferPtr>{data_});
+    }
+    case ColumnEncoding::kStringDictionary: {
+      auto nulls = readNulls(numRows);
+      const auto numValues = read<int32_t>();
+      auto indices = allocateIndices(numRows, pool_);
+      readInts(numRows, indices->asMutable<vector_size_t>());
+      auto values = std::make_shared<FlatVector<StringView>>(
+          pool_,
+          type,
+          nullptr,
+          numValues,
+          readStringViews(numValues, nullptr),
+          std::vector<BufferPtr>{data_});
+      return BaseVector::wrapInDictionary(
+          std::move(nulls), std::move(indices), numRows, std::move(values));
+    }
+    default:
+      VELOX_FAIL(
+          "Unknown spill column encoding: {}", static_cast<int>(encoding));
+  }
+}
+} // namespace
+
+// The rows of a column appended to a batch. The column keeps its encoding
+// while all of its appended vectors are constant with the same value or
+// dictionaries over the same values. Otherwise the rows are copied.
+class ColumnarSpillSerializer::ColumnBuffer {
+ public:
+  ColumnBuffer(TypePtr type, memory::MemoryPool* pool)
+      : type_(std::move(type)), pool_(pool) {}
+
+  void append(
+      const VectorPtr& vector,
+      const folly::Range<IndexRange*>& ranges,
+      vector_size_t numNewRows);
+
+  uint64_t size() const;
+
+  // Writes the appended rows to 'out' and clears them.
+  void flush(std::string& out);
+
+ private:
+  enum class State { kEmpty, kConstant, kDictionary, kFlat };
+
+  void appendIndices(
+      const BaseVector& vector,
+      const folly::Range<IndexRange*>& ranges);
+
+  void appendFlat(
+      const BaseVector& vector,
+      const folly::Range<IndexRange*>& ranges,
+      vector_size_t numNewRows);
+
+  // Copies the appended constant or dictionary rows into 'flat_'.
+  void flatten();
+
+  void writeConstant(std::string& out);
+
+  void writeDictionary(std::string& out);
+
+  const TypePtr type_;
+  memory::MemoryPool* const pool_;
+
+  State state_{State::kEmpty};
+  vector_size_t numRows_{0};
+  // The first appended vector if 'state_' is kConstant.
+  VectorPtr constant_;
+  // The values, indices and nulls of the appended dictionaries if 'state_' is
+  // kDictionary. 'nulls_' has a bit for each index.
+  VectorPtr base_;
+  std::vector<vector_size_t> indices_;
+  std::vector<uint64_t> nulls_;
+  bool hasNulls_{false};
+  // The copied rows if 'state_' is kFlat.
+  VectorPtr flat_;
+};
+
+void ColumnarSpillSerializer::ColumnBuffer::append(
+    const VectorPtr& vector,
+    const folly::Range<IndexRange*>& ranges,
+    vector_size_t numNewRows) {
+  const auto& loaded = BaseVector::loadedVectorShared(vector);
+  const bool isDictionary =
+      loaded->encoding() == VectorEncoding::Simple::DICTIONARY;
+  switch (state_) {
+    case State::kEmpty:
+      if (loaded->isConstantEncoding()) {
+        state_ = State::kConstant;
+        constant_ = loaded;
+      } else if (isDictionary) {
+        state_ = State::kDictionary;
+        base_ = BaseVector::loadedVectorShared(loaded->valueVector());
+        appendIndices(*loaded, ranges);
+      } else {
+        state_ = State::kFlat;
+        appendFlat(*loaded, ranges, numNewRows);
+      }
+      break;
+    case State::kConstant:
+      if (!loaded->isConstantEncoding() ||
+          !loaded->equalValueAt(constant_.get(), 0, 0)) {
+        flatten();
+        appendFlat(*loaded, ranges, numNewRows);
+      }
+      break;
+    case State::kDictionary:
+      if (isDictionary &&
+          BaseVector::loadedVectorShared(loaded->valueVector()) == base_) {
+        appendIndices(*loaded, ranges);
+      } else {
+        flatten();
+        appendFlat(*loaded, ranges, numNewRows);
+      }
+      break;
+    case State::kFlat:
+      appendFlat(*loaded, ranges, numNewRows);
+      break;
+  }
+  numRows_ += numNewRows;
+}
+
+void ColumnarSpillSerializer::ColumnBuffer::appendIndices(
+    const BaseVector& vector,
+    const folly::Range<IndexRange*>& ranges) {
+  const auto* indices = vector.wrapInfo()->as<vector_size_t>();
+  const auto* nulls = vector.rawNulls();
+  for (const auto& range : ranges) {
+    for (auto row = range.begin; row < range.begin + range.size; ++row) {
+      const auto position = indices_.size();
+      if (position % 64 == 0) {
+        nulls_.push_back(bits::kNotNull64);
+      }
+      if (nulls != nullptr && bits::isBitNull(nulls, row)) {
+        bits::setNull(nulls_.data(), position);
+        hasNulls_ = true;
+        indices_.push_back(0);
+      } else {
+        indices_.push_back(indices[row]);
+      }
+    }
+  }
+}
+
+void ColumnarSpillSerializer::ColumnBuffer::appendFlat(
+    const BaseVector& vector,
+    const folly::Range<IndexRange*>& ranges,
+    vector_size_t numNewRows) {
+  if (flat_ == nullptr) {
+    flat_ = BaseVector::create(type_, 0, pool_);
+  }
+  const auto offset = flat_->size();
+  flat_->resize(offset + numNewRows);
+  std::vector<BaseVector::CopyRange> copyRanges;
+  copyRanges.reserve(ranges.size());
+  auto targetIndex = offset;
+  for (const auto& range : ranges) {
+    copyRanges.push_back({range.begin, targetIndex, range.size});
+    targetIndex += range.size;
+  }
+  flat_->copyRanges(&vector, copyRanges);
+}
+
+void ColumnarSpillSerializer::ColumnBuffer::flatten() {
+  VectorPtr encoded;
+  if (state_ == State::kConstant) {
+    encoded = BaseVector::wrapInConstant(numRows_, 0, constant_);
+  } else {
+    VELOX_CHECK(state_ == State::kDictionary);
+    encoded = BaseVector::wrapInDictionary(
+        hasNulls_ ? copyToBuffer(nulls_.data(), bits::nbytes(numRows_), pool_)
+                  : nullptr,
+        copyToBuffer(
+            indices_.data(), numRows_ * sizeof(vector_size_t), pool_),
+        numRows_,
+        base_);
+  }
+  flat_ = BaseVector::create(type_, numRows_, pool_);
+  flat_->copy(encoded.get(), 0, 0, numRows_);
+  constant_.reset();
+  base_.reset();
+  indices_.clear();
+  nulls_.clear();
+  hasNulls_ = false;
+  state_ = State::kFlat;
+}
+
+uint64_t ColumnarSpillSerializer::ColumnBuffer::size() const {
+  switch (state_) {
+    case State::kEmpty:
+      return 0;
+    case State::kConstant:
+      // Counts the rows as if flat, so that the batch size is bounded if the
+      // column is flattened.
+      return numRows_ *
+          (type_->isFixedWidth() ? type_->cppSizeInBytes()
+                                 : sizeof(StringView));
+    case State::kDictionary:
+      // Counts all the values, also the ones that are not referenced.
+      return indices_.size() * sizeof(vector_size_t) +
+          base_->estimateFlatSize();
+    case State::kFlat:
+      return flat_->estimateFlatSize();
+  }
+  VELOX_UNREACHABLE();
+}
+
+void ColumnarSpillSerializer::ColumnBuffer::flush(std::string& out) {
+  switch (state_) {
+    case State::kEmpty:
+      writeFlat(BaseVector::create(type_, 0, pool_), pool_, out);
+      break;
+    case State::kConstant:
+      writeConstant(out);
+      break;
+    case State::kDictionary:
+      writeDictionary(out);
+      break;
+    case State::kFlat:
+      writeFlat(flat_, pool_, out);
+      break;
+  }
+  state_ = State::kEmpty;
+  numRows_ = 0;
+  constant_.reset();
+  base_.reset();
+  indices_.clear();
+  nulls_.clear();
+  hasNulls_ = false;
+  flat_.reset();
+}
+
+void ColumnarSpillSerializer::ColumnBuffer::writeConstant(std::string& out) {
+  appendEncoding(ColumnEncoding::kConstant, out);
+  const bool isNull = constant_->isNullAt(0);
+  append<uint8_t>(isNull, out);
+  if (!isNull) {
+    auto value = BaseVector::create(type_, 1, pool_);
+    value->copy(constant_.get(), 0, 0, 1);
+    writeFlat(value, pool_, out);
+  }
+}
+
+void ColumnarSpillSerializer::ColumnBuffer::writeDictionary(std::string& out) {
+  // Numbers the referenced values in the order of first reference.
+  constexpr vector_size_t kNotReferenced = -1;
+  std::vector<vector_size_t> newIndices(base_->size(), kNotReferenced);
+  std::vector<BaseVector::CopyRange> valueRanges;
+  std::vector<vector_size_t> indices(numRows_, 0);
+  for (auto row = 0; row < numRows_; ++row) {
+    if (hasNulls_ && bits::isBitNull(nulls_.data(), row)) {
+      continue;
+    }
+    auto& newIndex = newIndices[indices_[row]];
+    if (newIndex == kNotReferenced) {
+      newIndex = valueRanges.size();
+      valueRanges.push_back({indices_[row], newIndex, 1});
+    }
+    indices[row] = newIndex;
+  }
+  // A dictionary that does not repeat values is written flat.
+  if (valueRanges.size() * 2 > numRows_) {
+    flatten();
+    writeFlat(flat_, pool_, out);
+    return;
+  }
+  auto values = BaseVector::create(type_, valueRanges.size(), pool_);
+  values->copyRanges(base_.get(), valueRanges);
+
+  appendEncoding(ColumnEncoding::kDictionary, out);
+  writeNulls(hasNulls_ ? nulls_.data() : nullptr, numRows_, out);
+  writeInts(indices.data(), nullptr, numRows_, out);
+  append<int32_t>(valueRanges.size(), out);
+  writeFlat(values, pool_, out);
+}
+
+ColumnarSpillSerializer::ColumnarSpillSerializer(
+    RowTypePtr type,
+    common::CompressionKind compressionKind,
+    memory::MemoryPool* pool)
+    : type_(std::move(type)), compressionKind_(compressionKind), pool_(pool) {
+  columns_.reserve(type_->size());
+  for (const auto& childType : type_->children()) {
+    columns_.push_back(std::make_unique<ColumnBuffer>(childType, pool_));
+  }
+}
+
+ColumnarSpillSerializer::~ColumnarSpillSerializer() = default;
+
+void ColumnarSpillSerializer::append(
+    const RowVectorPtr& rows,
+    const folly::Range<IndexRange*>& ranges) {
+  vector_size_t numNewRows = 0;
+  for (const auto& range : ranges) {
+    numNewRows += range.size;
+  }
+  if (numNewRows == 0) {
+    return;
+  }
+  for (auto i = 0; i < columns_.size(); ++i) {
+    columns_[i]->append(rows->childAt(i), ranges, numNewRows);
+  }
+  numRows_ += numNewRows;
+}
+
+uint64_t ColumnarSpillSerializer::size() const {
+  uint64_t size = 0;
+  for (const auto& column : columns_) {
+    size += column->size();
+  }
+  return size;
+}
+
+void ColumnarSpillSerializer::flush(OutputStream* out) {
+  std::string data;
+  append<int32_t>(numRows_, data);
+  append<int32_t>(columns_.size(), data);
+  for (auto& column : columns_) {
+    const auto sizeOffset = data.size();
+    append<int32_t>(0, data);
+    column->flush(data);
+    const int32_t columnSize = data.size() - sizeOffset - sizeof(int32_t);
+    ::memcpy(data.data() + sizeOffset, &columnSize, sizeof(int32_t));
+  }
+  numRows_ = 0;
+
+  const int32_t uncompressedSize = data.size();
+  const auto codec = common::compressionKindToCodec(compressionKind_);
+  if (codec->type() != folly::io::CodecType::NO_COMPRESSION) {
+    const auto uncompressed =
+        folly::IOBuf::wrapBuffer(data.data(), data.size());
+    auto compressed = codec->compress(uncompressed.get());
+    const int32_t compressedSize = compressed->computeChainDataLength();
+    if (compressedSize < uncompressedSize) {
+      out->write(
+          reinterpret_cast<const char*>(&uncompressedSize), sizeof(int32_t));
+      out->write(
+          reinterpret_cast<const char*>(&compressedSize), sizeof(int32_t));
+      for (auto range : *compressed) {
+        out->write(reinterpret_cast<const char*>(range.data()), range.size());
+      }
+      return;
+    }
+  }
+  const int32_t notCompressed = 0;
+  out->write(
+      reinterpret_cast<const char*>(&uncompressedSize), sizeof(int32_t));
+  out->write(reinterpret_cast<const char*>(&notCompressed), sizeof(int32_t));
+  out->write(data.data(), data.size());
+}
+
+// static
+RowVectorPtr ColumnarSpillSerializer::read(
+    ByteInputStream* input,
+    const RowTypePtr& type,
+    const std::vector<column_index_t>& projection,
+    common::CompressionKind compressionKind,
+    memory::MemoryPool* pool) {
+  const auto uncompressedSize = input->read<int32_t>();
+  const auto compressedSize = input->read<int32_t>();
+  auto data = AlignedBuffer::allocate<char>(uncompressedSize, pool);
+  if (compressedSize == 0) {
+    input->readBytes(data->asMutable<char>(), uncompressedSize);
+  } else {
+    auto compressed = folly::IOBuf::create(compressedSize);
+    input->readBytes(compressed->writableData(), compressedSize);
+    compressed->append(compressedSize);
+    const auto uncompressed =
+        common::compressionKindToCodec(compressionKind)
+            ->uncompress(compressed.get(), uncompressedSize);
+    auto* target = data->asMutable<char>();
+    for (auto range : *uncompressed) {
+      ::memcpy(target, range.data(), range.size());
+      target += range.size();
+    }
+  }
+
+  BatchReader reader(data, pool);
+  const auto numRows = reader.read<int32_t>();
+  const auto numColumns = reader.read<int32_t>();
+  VELOX_CHECK_EQ(numColumns, type->size());
+
+  // The output position of each column of the batch or -1 if not projected.
+  std::vector<int32_t> outputs(numColumns, -1);
+  RowTypePtr outputType = type;
+  if (projection.empty()) {
+    std::iota(outputs.begin(), outputs.end(), 0);
+  } else {
+    std::vector<std::string> names;
+    std::vector<TypePtr> types;
+    for (auto i = 0; i < projection.size(); ++i) {
+      VELOX_CHECK_LT(projection[i], numColumns);
+      VELOX_CHECK_EQ(
+          outputs[projection[i]], -1, "Spill column projected twice");
+      outputs[projection[i]] = i;
+      names.push_back(type->nameOf(projection[i]));
+      types.push_back(type->childAt(projection[i]));
+    }
+    outputType = ROW(std::move(names), std::move(types));
+  }
+
+  std::vector<VectorPtr> columns(outputType->size());
+  for (auto column = 0; column < numColumns; ++column) {
+    const auto columnSize = reader.read<int32_t>();
+    const auto* columnEnd = reader.position() + columnSize;
+    if (outputs[column] >= 0) {
+      columns[outputs[column]] =
+          reader.readColumn(type->childAt(column), numRows);
+    }
+    reader.skipTo(columnEnd);
+  }
+  return std::make_shared<RowVector>(
+      pool, outputType, nullptr, numRows, std::move(columns));
+}
+
+} // namespace facebook::velox::exec
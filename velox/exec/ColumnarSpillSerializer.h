@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/compression/Compression.h"
+#include "velox/common/memory/ByteStream.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::exec {
+
+/// Serializes batches of spilled rows column by column in a format only read
+/// back by spilling. Unlike the Presto format, the top level columns keep
+/// their constant and dictionary encodings and are read back with them. Flat
+/// integers are stored as frame of reference deltas of the smallest width
+/// that fits the batch. Flat strings are stored with a dictionary when at
+/// most half of them are distinct. The other columns are stored as Presto
+/// blocks. Each column is prefixed with its size, so that a reader may skip
+/// the columns it does not need.
+///
+/// A batch is: uncompressedSize(4) | compressedSize(4) | data, where
+/// 'compressedSize' is 0 if 'data' is not compressed. 'data' is:
+/// numRows(4) | numColumns(4) | {columnSize(4) | column} * numColumns.
+class ColumnarSpillSerializer {
+ public:
+  ColumnarSpillSerializer(
+      RowTypePtr type,
+      common::CompressionKind compressionKind,
+      memory::MemoryPool* pool);
+
+  ~ColumnarSpillSerializer();
+
+  /// Adds the rows of 'rows' in 'ranges'. A column keeps its encoding while
+  /// the appended rows of the batch are all constant with the same value or
+  /// all dictionary encoded over the same values.
+  void append(
+      const RowVectorPtr& rows,
+      const folly::Range<IndexRange*>& ranges);
+
+  /// Returns the number of appended rows.
+  vector_size_t numRows() const {
+    return numRows_;
+  }
+
+  /// Returns an estimate of the serialized size of the appended rows.
+  uint64_t size() const;
+
+  /// Writes the appended rows as one batch to 'out' and clears them.
+  void flush(OutputStream* out);
+
+  /// Reads the next batch from 'input'. Returns the columns of 'type' in
+  /// 'projection' in this order, or all columns if 'projection' is empty.
+  /// The other columns are skipped without decoding. The strings of the
+  /// result point into the read batch instead of being copied.
+  static RowVectorPtr read(
+      ByteInputStream* input,
+      const RowTypePtr& type,
+      const std::vector<column_index_t>& projection,
+      common::CompressionKind compressionKind,
+      memory::MemoryPool* pool);
+
+ private:
+  class ColumnBuffer;
+
+  const RowTypePtr type_;
+  const common::CompressionKind compressionKind_;
+  memory::MemoryPool* const pool_;
+
+  std::vector<std::unique_ptr<ColumnBuffer>> columns_;
+  vector_size_t numRows_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -24,8 +24,10 @@
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
+#include "velox/exec/FairShareScheduler.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Task.h"
+#include "velox/exec/WorkStealingExecutor.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -155,7 +157,7 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       [this](uint64_t bytes) {
         task->queryCtx()->updateSpilledBytesAndCheckLimit(bytes);
       };
-  return common::SpillConfig(
+  common::SpillConfig spillConfig(
       std::move(getSpillDirPathCb),
       std::move(updateAndCheckSpillLimitCb),
       spillFilePrefix,
@@ -170,7 +172,22 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.maxSpillRunRows(),
       queryConfig.writerFlushThresholdBytes(),
       queryConfig.spillCompressionKind(),
-      queryConfig.spillFileCreateConfig());
+      queryConfig.spillFileCreateConfig(),
+      queryConfig.spillMaxMergeFanIn(),
+      queryConfig.spillWriteBehindBytes(),
+      queryConfig.spillReadAheadBytes(),
+      queryConfig.spillColumnarFormat(),
+      queryConfig.spillZstdDictionarySize());
+  if (task->numSpillTiers() > 0) {
+    spillConfig.tiers.numTiers = task->numSpillTiers();
+    spillConfig.tiers.getDirectoryPathCb = [this](int32_t tier) {
+      return task->getOrCreateSpillTierDirectory(tier);
+    };
+    spillConfig.tiers.reserveCb = [this](int32_t tier, uint64_t bytes) {
+      return task->reserveSpillSpace(tier, bytes);
+    };
+  }
+  return spillConfig;
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -190,6 +207,9 @@ BlockingState::BlockingState(
               .count()) {
   // Set before leaving the thread.
   driver_->state().hasBlockingFuture = true;
+  if (const auto& timeline = driver_->timeline()) {
+    timeline->setBlocked(static_cast<int32_t>(reason));
+  }
   numBlockedDrivers_++;
 }
 
@@ -203,19 +223,35 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
         auto& driver = state->driver_;
         auto& task = driver->task();
 
-        std::lock_guard<std::timed_mutex> l(task->mutex());
-        if (!driver->state().isTerminated) {
-          state->operator_->recordBlockingTime(
-              state->sinceMicros_, state->reason_);
+        // Promises of parked drivers of an elastic pipeline that resume.
+        std::vector<ContinuePromise> resumePromises;
+        {
+          std::lock_guard<std::timed_mutex> l(task->mutex());
+          if (!driver->state().isTerminated) {
+            state->operator_->recordBlockingTime(
+                state->sinceMicros_, state->reason_);
+            const uint64_t nowMicros =
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::high_resolution_clock::now()
+                        .time_since_epoch())
+                    .count();
+            task->recordBlockingTimeLocked(
+                *driver->driverCtx(),
+                state->reason_,
+                nowMicros - state->sinceMicros_,
+                resumePromises);
+          }
+          VELOX_CHECK(!driver->state().suspended());
+          VELOX_CHECK(driver->state().hasBlockingFuture);
+          driver->state().hasBlockingFuture = false;
+          // If a pause is requested, the thread will be enqueued at resume.
+          if (!task->pauseRequested()) {
+            Driver::enqueue(state->driver_);
+          }
         }
-        VELOX_CHECK(!driver->state().suspended());
-        VELOX_CHECK(driver->state().hasBlockingFuture);
-        driver->state().hasBlockingFuture = false;
-        if (task->pauseRequested()) {
-          // The thread will be enqueued at resume.
-          return;
+        for (auto& promise : resumePromises) {
+          promise.setValue();
         }
-        Driver::enqueue(state->driver_);
       })
       .thenError(
           folly::tag_t<std::exception>{}, [state](std::exception const& e) {
@@ -266,8 +302,24 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  auto* executor = driver->task()->queryCtx()->executor();
+  if (auto* workStealing = dynamic_cast<WorkStealingExecutor*>(executor)) {
+    // Runs the Driver on the worker it last ran on, which is likely to have
+    // its state in cache, unless another worker steals it first.
+    const auto worker = driver->lastWorker_;
+    workStealing->addToWorker([driver]() { Driver::run(driver); }, worker);
+    return;
+  }
+  if (auto* fairShare = dynamic_cast<FairShareScheduler*>(executor)) {
+    const auto& queryCtx = *driver->task()->queryCtx();
+    const auto group = queryCtx.queryConfig().schedulingGroup();
+    fairShare->add(
+        [driver]() { Driver::run(driver); },
+        group.empty() ? queryCtx.queryId() : group,
+        queryCtx.queryConfig().schedulingWeight());
+    return;
+  }
+  executor->add([driver]() { Driver::run(driver); });
 }
 
 void Driver::init(
@@ -280,6 +332,27 @@ void Driver::init(
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  if (const auto capacity = ctx_->queryConfig().driverTimelineEvents()) {
+    std::vector<std::string> operatorTypes;
+    for (const auto& op : operators_) {
+      if (op->operatorId() >= operatorTypes.size()) {
+        operatorTypes.resize(op->operatorId() + 1);
+      }
+      operatorTypes[op->operatorId()] = op->operatorType();
+    }
+    timeline_ = std::make_shared<DriverTimeline>(
+        ctx_->pipelineId, ctx_->driverId, std::move(operatorTypes), capacity);
+  }
+  profiler_ = ctx_->task->queryCtx()->cpuProfiler();
+  if (profiler_ != nullptr) {
+    for (const auto& op : operators_) {
+      if (op->operatorId() >= profilerLabels_.size()) {
+        profilerLabels_.resize(op->operatorId() + 1, -1);
+      }
+      profilerLabels_[op->operatorId()] = profiler_->addLabel(
+          fmt::format("{}.{}", op->planNodeId(), op->operatorType()));
+    }
+  }
 }
 
 void Driver::initializeOperators() {
@@ -347,6 +420,7 @@ RowVectorPtr Driver::next(std::shared_ptr<BlockingState>& blockingState) {
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
   ScopedDriverThreadContext scopedDriverThreadContext(*self->driverCtx());
+  process::QueryProfiler::Sampling sampling(self->profiler_);
   RowVectorPtr result;
   auto stop = runInternal(self, blockingState, result);
 
@@ -375,7 +449,11 @@ void Driver::enqueueInternal() {
     RuntimeStatWriterScopeGuard statsWriterGuard(operatorPtr);             \
     threadNumVeloxThrow() = 0;                                             \
     opCallStatus_.start(operatorId, operatorMethod);                       \
-    auto stopGuard = folly::makeGuard([&]() { opCallStatus_.stop(); });    \
+    setProfilerLabel(operatorPtr->operatorId());                           \
+    auto stopGuard = folly::makeGuard([&]() {                              \
+      opCallStatus_.stop();                                                \
+      setProfilerLabel(-1);                                                \
+    });                                                                    \
     call;                                                                  \
     recordSilentThrows(*operatorPtr);                                      \
   } catch (const VeloxException&) {                                        \
@@ -458,6 +536,15 @@ CpuWallTiming Driver::processLazyTiming(
       timing.cpuNanos >= cpuDelta ? timing.cpuNanos - cpuDelta : 0};
 }
 
+void Driver::recordTimeline(
+    TimelineEvent::Kind kind,
+    const Operator& op,
+    const CpuWallTiming& timing) {
+  if (timeline_) {
+    timeline_->recordOperator(kind, op.operatorId(), timing.wallNanos);
+  }
+}
+
 bool Driver::shouldYield() const {
   if (cpuSliceMs_ == 0) {
     return false;
@@ -500,6 +587,15 @@ StopReason Driver::runInternal(
         RuntimeCounter(queuedTime, RuntimeCounter::Unit::kNanos));
   }
 
+  if (timeline_) {
+    timeline_->startRun();
+  }
+  auto timelineGuard = folly::makeGuard([&]() {
+    if (timeline_) {
+      timeline_->endRun();
+    }
+  });
+
   CancelGuard guard(task().get(), &state_, [&](StopReason reason) {
     // This is run on error or cancel exit.
     if (reason == StopReason::kTerminate) {
@@ -585,9 +681,20 @@ StopReason Driver::runInternal(
             RowVectorPtr intermediateResult;
             {
               auto timer = createDeltaCpuWallTimer(
-                  [op, this](const CpuWallTiming& deltaTiming) {
+                  [op, &intermediateResult, this](
+                      const CpuWallTiming& deltaTiming) {
                     processLazyTiming(*op, deltaTiming);
-                    op->stats().wlock()->getOutputTiming.add(deltaTiming);
+                    {
+                      auto lockedStats = op->stats().wlock();
+                      lockedStats->getOutputTiming.add(deltaTiming);
+                      if (intermediateResult) {
+                        lockedStats->outputBatchNanos.addValue(
+                            deltaTiming.wallNanos);
+                      }
+                    }
+                    op->maybeRecordMemorySample();
+                    recordTimeline(
+                        TimelineEvent::Kind::kGetOutput, *op, deltaTiming);
                   });
               TestValue::adjust(
                   "facebook::velox::exec::Driver::runInternal::getOutput", op);
@@ -619,6 +726,9 @@ StopReason Driver::runInternal(
                   [nextOp, this](const CpuWallTiming& timing) {
                     auto selfDelta = processLazyTiming(*nextOp, timing);
                     nextOp->stats().wlock()->addInputTiming.add(selfDelta);
+                    nextOp->maybeRecordMemorySample();
+                    recordTimeline(
+                        TimelineEvent::Kind::kAddInput, *nextOp, timing);
                   });
               {
                 auto lockedStats = nextOp->stats().wlock();
@@ -671,9 +781,11 @@ StopReason Driver::runInternal(
                   kOpMethodIsFinished);
               if (finished) {
                 auto timer = createDeltaCpuWallTimer(
-                    [op, this](const CpuWallTiming& timing) {
+                    [op, nextOp, this](const CpuWallTiming& timing) {
                       processLazyTiming(*op, timing);
                       op->stats().wlock()->finishTiming.add(timing);
+                      recordTimeline(
+                          TimelineEvent::Kind::kNoMoreInput, *nextOp, timing);
                     });
                 TestValue::adjust(
                     "facebook::velox::exec::Driver::runInternal::noMoreInput",
@@ -694,9 +806,18 @@ StopReason Driver::runInternal(
           // will come back here after this is again on thread.
           {
             auto timer = createDeltaCpuWallTimer(
-                [op, this](const CpuWallTiming& timing) {
+                [op, &result, this](const CpuWallTiming& timing) {
                   auto selfDelta = processLazyTiming(*op, timing);
-                  op->stats().wlock()->getOutputTiming.add(selfDelta);
+                  {
+                    auto lockedStats = op->stats().wlock();
+                    lockedStats->getOutputTiming.add(selfDelta);
+                    if (result) {
+                      lockedStats->outputBatchNanos.addValue(
+                          selfDelta.wallNanos);
+                    }
+                  }
+                  op->maybeRecordMemorySample();
+                  recordTimeline(TimelineEvent::Kind::kGetOutput, *op, timing);
                 });
             CALL_OPERATOR(
                 result = op->getOutput(),
@@ -771,6 +892,8 @@ void Driver::run(std::shared_ptr<Driver> self) {
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
   ScopedDriverThreadContext scopedDriverThreadContext(*self->driverCtx());
+  self->lastWorker_ = WorkStealingExecutor::currentWorker();
+  process::QueryProfiler::Sampling sampling(self->profiler_);
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr nullResult;
   auto reason = self->runInternal(self, blockingState, nullResult);
@@ -26,6 +26,7 @@
 #include "velox/core/PlanFragment.h"
 #include "velox/core/PlanNode.h"
 #include "velox/core/QueryCtx.h"
+#include "velox/exec/DriverTimeline.h"
 #include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
@@ -422,6 +423,12 @@ class Driver : public std::enable_shared_from_this<Driver> {
     return opCallStatus_();
   }
 
+  /// Returns the recent events of 'this' or nullptr if the
+  /// driver_timeline_events query config is zero.
+  const std::shared_ptr<DriverTimeline>& timeline() const {
+    return timeline_;
+  }
+
   DriverCtx* driverCtx() const {
     return ctx_.get();
   }
@@ -497,6 +504,21 @@ class Driver : public std::enable_shared_from_this<Driver> {
   // but these do not bias the op's timing.
   CpuWallTiming processLazyTiming(Operator& op, const CpuWallTiming& timing);
 
+  // Records a call of 'op' that took 'timing' in 'timeline_' if set.
+  void recordTimeline(
+      TimelineEvent::Kind kind,
+      const Operator& op,
+      const CpuWallTiming& timing);
+
+  // Labels the CPU profile samples of the thread with the operator with
+  // 'operatorId', or with no operator if -1.
+  void setProfilerLabel(int32_t operatorId) {
+    if (!profilerLabels_.empty()) {
+      process::QueryProfiler::setLabel(
+          operatorId < 0 ? -1 : profilerLabels_[operatorId]);
+    }
+  }
+
   std::unique_ptr<DriverCtx> ctx_;
 
   // If not zero, specifies the driver cpu time slice.
@@ -513,6 +535,15 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   // Timer used to track down the time we are sitting in the driver queue.
   size_t queueTimeStartMicros_{0};
+  // Worker of a WorkStealingExecutor that last ran the Driver. -1 if none.
+  int32_t lastWorker_{-1};
+  // Set if the driver_timeline_events query config is not zero.
+  std::shared_ptr<DriverTimeline> timeline_;
+  // Set if the cpu_profiling_interval_us query config is not zero. Owned by
+  // the QueryCtx.
+  process::QueryProfiler* profiler_{nullptr};
+  // Profiler label ids by operator id.
+  std::vector<int32_t> profilerLabels_;
   // Id (index in the vector) of the current operator to run (or the 1st one if
   // we haven't started yet). Used to determine which operator's queueTime we
   // should update.
@@ -562,6 +593,12 @@ struct DriverFactory {
   /// grouped execution it is 'numDrivers' * 'numSplitGroups', otherwise it is
   /// 'numDrivers'.
   uint32_t numTotalDrivers;
+  /// Number of drivers that run at start if the Task adjusts the number of
+  /// running drivers of this pipeline at runtime, 0 otherwise. The other
+  /// drivers of the pipeline start parked. See Task::parkElasticDriver().
+  uint32_t numInitialElasticDrivers{0};
+  /// Least number of running drivers if the pipeline is elastic.
+  uint32_t minElasticDrivers{0};
   /// The (local) node that will consume results supplied by this pipeline.
   /// Can be null. We use that to determine the max drivers.
   std::shared_ptr<const core::PlanNode> consumerNode;
@@ -654,6 +691,12 @@ struct DriverFactory {
   /// based on this pipeline.
   std::vector<core::PlanNodeId> needsNestedLoopJoinBridges() const;
 
+  /// Returns true if drivers of this pipeline can be parked between splits
+  /// and resumed without affecting their peers. This is the case for
+  /// ungrouped pipelines that start with a TableScan and whose other operators
+  /// process each batch independently of the other drivers.
+  bool supportsElasticDrivers() const;
+
   static std::vector<DriverAdapter> adapters;
 };
 
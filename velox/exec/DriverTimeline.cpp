@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverTimeline.h"
+
+#include <folly/system/ThreadId.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/Driver.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+// Chrome trace process ids of the events on thread and of the blocked time.
+constexpr int32_t kThreadsPid = 1;
+constexpr int32_t kDriversPid = 2;
+
+const char* kindName(TimelineEvent::Kind kind) {
+  switch (kind) {
+    case TimelineEvent::Kind::kRun:
+      return "run";
+    case TimelineEvent::Kind::kBlocked:
+      return "blocked";
+    case TimelineEvent::Kind::kAddInput:
+      return "addInput";
+    case TimelineEvent::Kind::kGetOutput:
+      return "getOutput";
+    case TimelineEvent::Kind::kNoMoreInput:
+      return "noMoreInput";
+    case TimelineEvent::Kind::kSpill:
+      return "spill";
+    case TimelineEvent::Kind::kArbitration:
+      return "arbitration";
+  }
+  VELOX_UNREACHABLE();
+}
+
+const char* category(TimelineEvent::Kind kind) {
+  switch (kind) {
+    case TimelineEvent::Kind::kRun:
+    case TimelineEvent::Kind::kBlocked:
+      return "driver";
+    case TimelineEvent::Kind::kAddInput:
+    case TimelineEvent::Kind::kGetOutput:
+    case TimelineEvent::Kind::kNoMoreInput:
+      return "operator";
+    case TimelineEvent::Kind::kSpill:
+    case TimelineEvent::Kind::kArbitration:
+      return "memory";
+  }
+  VELOX_UNREACHABLE();
+}
+
+folly::dynamic metadataEvent(
+    const char* type,
+    int32_t pid,
+    int64_t tid,
+    const std::string& name) {
+  folly::dynamic event = folly::dynamic::object;
+  event["name"] = type;
+  event["ph"] = "M";
+  event["pid"] = pid;
+  event["tid"] = tid;
+  event["args"] = folly::dynamic::object("name", name);
+  return event;
+}
+} // namespace
+
+DriverTimeline::DriverTimeline(
+    int32_t pipelineId,
+    int32_t driverId,
+    std::vector<std::string> operatorTypes,
+    uint32_t capacity)
+    : pipelineId_(pipelineId),
+      driverId_(driverId),
+      operatorTypes_(std::move(operatorTypes)),
+      events_(capacity) {
+  VELOX_CHECK_GT(capacity, 0);
+}
+
+void DriverTimeline::append(const TimelineEvent& event) {
+  const auto index = numRecorded_.load(std::memory_order_relaxed);
+  events_[index % events_.size()] = event;
+  numRecorded_.store(index + 1, std::memory_order_release);
+}
+
+void DriverTimeline::record(
+    TimelineEvent::Kind kind,
+    uint64_t startMicros,
+    int32_t operatorId,
+    int32_t detail) {
+  const uint64_t now = getCurrentTimeMicro();
+  TimelineEvent event;
+  event.kind = kind;
+  event.detail = detail;
+  event.operatorId = operatorId;
+  if (kind != TimelineEvent::Kind::kBlocked) {
+    event.osTid = folly::getOSThreadID();
+  }
+  event.startMicros = std::min(startMicros, now);
+  event.durationMicros = now - event.startMicros;
+  append(event);
+}
+
+void DriverTimeline::recordOperator(
+    TimelineEvent::Kind kind,
+    int32_t operatorId,
+    uint64_t wallNanos) {
+  record(kind, getCurrentTimeMicro() - wallNanos / 1'000, operatorId);
+}
+
+void DriverTimeline::startRun() {
+  if (blockedStartMicros_ != 0) {
+    record(
+        TimelineEvent::Kind::kBlocked, blockedStartMicros_, -1, blockedReason_);
+    blockedStartMicros_ = 0;
+  }
+  runStartMicros_ = getCurrentTimeMicro();
+}
+
+void DriverTimeline::endRun() {
+  if (runStartMicros_ != 0) {
+    record(TimelineEvent::Kind::kRun, runStartMicros_);
+    runStartMicros_ = 0;
+  }
+}
+
+void DriverTimeline::setBlocked(int32_t reason) {
+  blockedStartMicros_ = getCurrentTimeMicro();
+  blockedReason_ = reason;
+}
+
+void DriverTimeline::startArbitration() {
+  if (arbitrationStartMicros_ == 0) {
+    arbitrationStartMicros_ = getCurrentTimeMicro();
+  }
+}
+
+void DriverTimeline::endArbitration() {
+  if (arbitrationStartMicros_ != 0) {
+    record(TimelineEvent::Kind::kArbitration, arbitrationStartMicros_);
+    arbitrationStartMicros_ = 0;
+  }
+}
+
+std::vector<TimelineEvent> DriverTimeline::events() const {
+  const auto numRecorded = this->numRecorded();
+  const uint64_t numEvents = std::min<uint64_t>(numRecorded, events_.size());
+  std::vector<TimelineEvent> events;
+  events.reserve(numEvents);
+  for (auto i = numRecorded - numEvents; i < numRecorded; ++i) {
+    events.push_back(events_[i % events_.size()]);
+  }
+  return events;
+}
+
+const std::string& DriverTimeline::operatorType(int32_t operatorId) const {
+  static const std::string kUnknown;
+  if (operatorId < 0 || operatorId >= operatorTypes_.size()) {
+    return kUnknown;
+  }
+  return operatorTypes_[operatorId];
+}
+
+folly::dynamic timelinesToChromeTrace(
+    const std::string& name,
+    const std::vector<std::shared_ptr<DriverTimeline>>& timelines) {
+  folly::dynamic traceEvents = folly::dynamic::array;
+  traceEvents.push_back(
+      metadataEvent("process_name", kThreadsPid, 0, name + " threads"));
+  traceEvents.push_back(
+      metadataEvent("process_name", kDriversPid, 0, name + " blocked"));
+  for (auto i = 0; i < timelines.size(); ++i) {
+    const auto& timeline = *timelines[i];
+    // The blocked time of each Driver goes to a thread of its own.
+    const int64_t driverTid = i + 1;
+    traceEvents.push_back(metadataEvent(
+        "thread_name",
+        kDriversPid,
+        driverTid,
+        fmt::format(
+            "pipeline {} driver {}",
+            timeline.pipelineId(),
+            timeline.driverId())));
+    for (const auto& event : timeline.events()) {
+      const bool blocked = event.kind == TimelineEvent::Kind::kBlocked;
+      folly::dynamic json = folly::dynamic::object;
+      if (blocked) {
+        json["name"] = blockingReasonToString(
+            static_cast<BlockingReason>(event.detail));
+      } else if (event.operatorId >= 0) {
+        json["name"] = fmt::format(
+            "{}::{}",
+            timeline.operatorType(event.operatorId),
+            kindName(event.kind));
+      } else {
+        json["name"] = kindName(event.kind);
+      }
+      json["cat"] = category(event.kind);
+      json["ph"] = "X";
+      json["ts"] = event.startMicros;
+      json["dur"] = event.durationMicros;
+      json["pid"] = blocked ? kDriversPid : kThreadsPid;
+      json["tid"] = blocked ? driverTid : static_cast<int64_t>(event.osTid);
+      folly::dynamic args = folly::dynamic::object;
+      args["pipelineId"] = timeline.pipelineId();
+      args["driverId"] = timeline.driverId();
+      if (event.operatorId >= 0) {
+        args["operatorId"] = event.operatorId;
+      }
+      json["args"] = std::move(args);
+      traceEvents.push_back(std::move(json));
+    }
+  }
+  folly::dynamic trace = folly::dynamic::object;
+  trace["traceEvents"] = std::move(traceEvents);
+  trace["displayTimeUnit"] = "ms";
+  return trace;
+}
+
+} // namespace facebook::velox::exec
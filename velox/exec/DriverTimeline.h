@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/dynamic.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+/// An interval in the execution of a Driver.
+struct TimelineEvent {
+  enum class Kind : uint8_t {
+    /// The Driver was on thread.
+    kRun,
+    /// The Driver was off thread, waiting for the BlockingReason in 'detail'.
+    kBlocked,
+    /// Operator methods.
+    kAddInput,
+    kGetOutput,
+    kNoMoreInput,
+    /// The memory arbitrator made the operator spill.
+    kSpill,
+    /// The Driver waited for memory arbitration.
+    kArbitration,
+  };
+
+  Kind kind;
+  /// The BlockingReason of kBlocked events.
+  int32_t detail{0};
+  /// The operator of operator and kSpill events, -1 for the others.
+  int32_t operatorId{-1};
+  /// The thread that ran the Driver. 0 for kBlocked events.
+  uint64_t osTid{0};
+  uint64_t startMicros;
+  uint64_t durationMicros;
+};
+
+/// Keeps the last events of a Driver in a fixed size ring buffer. Only the
+/// thread that has the Driver, or the memory arbitrator while the Driver is
+/// paused, records events, so recording takes no lock. Reading the events
+/// while the Driver runs may return a garbled copy of the events that are
+/// being overwritten.
+class DriverTimeline {
+ public:
+  /// 'operatorTypes' are the types of the operators of the Driver by
+  /// operator id. Keeps the last 'capacity' events.
+  DriverTimeline(
+      int32_t pipelineId,
+      int32_t driverId,
+      std::vector<std::string> operatorTypes,
+      uint32_t capacity);
+
+  /// Records an event of 'kind' that ends now.
+  void record(
+      TimelineEvent::Kind kind,
+      uint64_t startMicros,
+      int32_t operatorId = -1,
+      int32_t detail = 0);
+
+  /// Records an operator event of 'kind' that took 'wallNanos' and ends now.
+  void recordOperator(
+      TimelineEvent::Kind kind,
+      int32_t operatorId,
+      uint64_t wallNanos);
+
+  /// Called when the Driver gets on thread. Records the time the Driver was
+  /// blocked, if it was.
+  void startRun();
+
+  /// Called when the Driver goes off thread.
+  void endRun();
+
+  /// Called when the Driver goes off thread because it is blocked for
+  /// 'reason', a BlockingReason.
+  void setBlocked(int32_t reason);
+
+  void startArbitration();
+
+  void endArbitration();
+
+  /// Returns the recorded events that are still in the buffer, oldest first.
+  std::vector<TimelineEvent> events() const;
+
+  /// Returns the number of events that were recorded, including the ones
+  /// that were overwritten.
+  uint64_t numRecorded() const {
+    return numRecorded_.load(std::memory_order_acquire);
+  }
+
+  int32_t pipelineId() const {
+    return pipelineId_;
+  }
+
+  int32_t driverId() const {
+    return driverId_;
+  }
+
+  /// Returns the type of operator 'operatorId' or "" if not known.
+  const std::string& operatorType(int32_t operatorId) const;
+
+ private:
+  void append(const TimelineEvent& event);
+
+  const int32_t pipelineId_;
+  const int32_t driverId_;
+  const std::vector<std::string> operatorTypes_;
+  std::vector<TimelineEvent> events_;
+  std::atomic<uint64_t> numRecorded_{0};
+
+  // The starts of the intervals in progress, 0 if none. Only used by the
+  // thread that has the Driver.
+  uint64_t runStartMicros_{0};
+  uint64_t blockedStartMicros_{0};
+  int32_t blockedReason_{0};
+  uint64_t arbitrationStartMicros_{0};
+};
+
+/// Returns the events of 'timelines' in the JSON format of Chrome trace
+/// events, which chrome://tracing and the Perfetto UI load. The events on
+/// thread are grouped by thread under one process and the time the Drivers
+/// were blocked is grouped by Driver under another. 'name' names the two
+/// processes, e.g. after the Task.
+folly::dynamic timelinesToChromeTrace(
+    const std::string& name,
+    const std::vector<std::shared_ptr<DriverTimeline>>& timelines);
+
+} // namespace facebook::velox::exec
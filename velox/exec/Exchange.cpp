@@ -74,7 +74,8 @@ BlockingReason Exchange::isBlocked(ContinueFuture* future) {
     getSplits(&splitFuture_);
   }
 
-  const auto maxBytes = getSerde()->supportsAppendInDeserialize()
+  const auto maxBytes =
+      getSerde()->supportsAppendInDeserialize() && !preserveEncodings_
       ? preferredOutputBatchBytes_
       : 1;
 
@@ -114,6 +115,10 @@ RowVectorPtr Exchange::getOutput() {
     return nullptr;
   }
 
+  if (getSerde()->supportsAppendInDeserialize()) {
+    recycleResults();
+  }
+
   uint64_t rawInputBytes{0};
   vector_size_t resultOffset = 0;
   for (const auto& page : currentPages_) {
@@ -140,10 +145,33 @@ RowVectorPtr Exchange::getOutput() {
   return result_;
 }
 
+void Exchange::recycleResults() {
+  if (result_ != nullptr && !result_.unique()) {
+    if (heldResults_.size() >= kMaxHeldResults) {
+      heldResults_.erase(heldResults_.begin());
+    }
+    heldResults_.push_back(std::move(result_));
+  }
+  for (auto it = heldResults_.begin(); it != heldResults_.end();) {
+    if (it->unique()) {
+      VectorPtr released = std::move(*it);
+      vectorPool_.release(released);
+      it = heldResults_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  if (result_ == nullptr) {
+    result_ = std::static_pointer_cast<RowVector>(
+        vectorPool_.get(outputType_, 0));
+  }
+}
+
 void Exchange::close() {
   SourceOperator::close();
   currentPages_.clear();
   result_ = nullptr;
+  heldResults_.clear();
   if (exchangeClient_) {
     recordExchangeClientStats();
     exchangeClient_->close();
@@ -21,6 +21,7 @@
 #include "velox/exec/Operator.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/VectorPool.h"
 
 namespace facebook::velox::exec {
 
@@ -51,10 +52,14 @@ class Exchange : public SourceOperator {
             operatorType),
         preferredOutputBatchBytes_{
             driverCtx->queryConfig().preferredOutputBatchBytes()},
+        preserveEncodings_{
+            driverCtx->queryConfig().partitionedOutputPreserveEncodings()},
         processSplits_{operatorCtx_->driverCtx()->driverId == 0},
         exchangeClient_{std::move(exchangeClient)} {
     options_.compressionKind =
         OutputBufferManager::getInstance().lock()->compressionKind();
+    options_.lazyColumns =
+        driverCtx->queryConfig().exchangeLazyDeserialization();
   }
 
   ~Exchange() override {
@@ -94,6 +99,11 @@ class Exchange : public SourceOperator {
 
   const uint64_t preferredOutputBatchBytes_;
 
+  /// True if the producers keep the dictionary and constant encodings in the
+  /// pages. Each page is then output as a separate batch since appending to
+  /// the result of a previous page flattens it.
+  const bool preserveEncodings_;
+
   /// True if this operator is responsible for fetching splits from the Task and
   /// passing these to ExchangeClient.
   const bool processSplits_;
@@ -103,14 +113,31 @@ class Exchange : public SourceOperator {
   /// there are more splits available or no-more-splits signal has arrived.
   ContinueFuture splitFuture_{ContinueFuture::makeEmpty()};
 
+  // Moves the previous results the consumers have released into
+  // 'vectorPool_' and makes 'result_' a recycled vector if the consumers still
+  // hold the last result.
+  void recycleResults();
+
+  // Max number of previous results that consumers still hold to check for
+  // release on the next getOutput().
+  static constexpr int32_t kMaxHeldResults = 4;
+
   // Reusable result vector.
   RowVectorPtr result_;
 
+  // Previous results that were still referenced by the consumers when the next
+  // result was produced.
+  std::vector<RowVectorPtr> heldResults_;
+
   std::shared_ptr<ExchangeClient> exchangeClient_;
   std::vector<std::unique_ptr<SerializedPage>> currentPages_;
   bool atEnd_{false};
   std::default_random_engine rng_{std::random_device{}()};
   serializer::presto::PrestoVectorSerde::PrestoOptions options_;
+
+  // Recycled result vectors. Used only with serdes that deserialize into an
+  // existing result.
+  VectorPool vectorPool_{pool()};
 };
 
 } // namespace facebook::velox::exec
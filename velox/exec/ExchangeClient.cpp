@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/ExchangeClient.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::exec {
 
@@ -74,6 +75,10 @@ void ExchangeClient::close() {
     }
     closed_ = true;
     sources = std::move(sources_);
+    // Pending requests are not waited for and the queue is cleared below.
+    if (memoryConsumer_ != nullptr) {
+      memoryConsumer_->setUsedBytes(0);
+    }
   }
 
   // Outside of mutex.
@@ -102,6 +107,24 @@ folly::F14FastMap<std::string, RuntimeMetric> ExchangeClient::stats() const {
     }
   }
 
+  // One value per source, so that the min and max show the slow sources.
+  for (const auto& source : sources_) {
+    auto it = sourceStats_.find(source.get());
+    if (it == sourceStats_.end() || it->second.numRequests == 0) {
+      continue;
+    }
+    if (UNLIKELY(stats.count("sourceRequestWallNanos") == 0)) {
+      stats.emplace(
+          "sourceRequestWallNanos",
+          RuntimeMetric(RuntimeCounter::Unit::kNanos));
+      stats.emplace(
+          "sourceReceivedBytes", RuntimeMetric(RuntimeCounter::Unit::kBytes));
+    }
+    stats["sourceRequestWallNanos"].addValue(
+        (int64_t)(it->second.averageRequestUs() * 1'000));
+    stats["sourceReceivedBytes"].addValue(it->second.numBytes);
+  }
+
   stats["peakBytes"] =
       RuntimeMetric(queue_->peakBytes(), RuntimeCounter::Unit::kBytes);
   stats["numReceivedPages"] = RuntimeMetric(queue_->receivedPages());
@@ -124,6 +147,7 @@ ExchangeClient::next(uint32_t maxBytes, bool* atEnd, ContinueFuture* future) {
 
     *atEnd = false;
     pages = queue_->dequeueLocked(maxBytes, atEnd, future);
+    updateMemoryUsageLocked();
     if (*atEnd) {
       return pages;
     }
@@ -150,21 +174,32 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
       future = spec.source->request(spec.maxBytes, kRequestDataMaxWait);
     }
     VELOX_CHECK(future.valid());
+    const auto startUs = getCurrentTimeMicro();
     std::move(future)
         .via(executor_)
-        .thenValue([self, spec = std::move(spec)](auto&& response) {
+        .thenValue([self, spec = std::move(spec), startUs](auto&& response) {
           std::vector<RequestSpec> requestSpecs;
           {
             std::lock_guard<std::mutex> l(self->queue_->mutex());
             if (self->closed_) {
               return;
             }
+            // Requests for data sizes wait for the producer and do not tell
+            // the transfer speed.
+            if (spec.maxBytes > 0) {
+              const uint64_t requestUs = getCurrentTimeMicro() - startUs;
+              auto& stats = self->sourceStats_[spec.source.get()];
+              ++stats.numRequests;
+              stats.numBytes += response.bytes;
+              stats.totalRequestUs += requestUs;
+              stats.maxRequestUs = std::max(stats.maxRequestUs, requestUs);
+            }
             if (!response.atEnd) {
               if (!response.remainingBytes.empty()) {
                 for (auto bytes : response.remainingBytes) {
                   VELOX_CHECK_GT(bytes, 0);
                 }
-                self->producingSources_.push(
+                self->producingSources_.push_back(
                     {std::move(spec.source),
                      std::move(response.remainingBytes)});
               } else {
@@ -195,12 +230,28 @@ ExchangeClient::pickSourcesToRequestLocked() {
     requestSpecs.push_back({std::move(source), 0});
     emptySources_.pop();
   }
+  updateMemoryUsageLocked();
   int64_t availableSpace =
       maxQueuedBytes_ - queue_->totalBytes() - totalPendingBytes_;
+  if (memoryConsumer_ != nullptr) {
+    availableSpace =
+        std::min(availableSpace, memoryConsumer_->availableBytes());
+  }
+  if (availableSpace > 0 && producingSources_.size() > 1) {
+    prioritizeProducingSourcesLocked();
+  }
+  // Each source gets at least one page and at most its share of the space so
+  // that the first sources do not take all of it while the others wait.
+  const int64_t sourceBudget = producingSources_.empty()
+      ? 0
+      : availableSpace / (int64_t)producingSources_.size();
   while (availableSpace > 0 && !producingSources_.empty()) {
     auto& source = producingSources_.front().source;
     int64_t requestBytes = 0;
     for (auto bytes : producingSources_.front().remainingBytes) {
+      if (requestBytes > 0 && requestBytes + bytes > sourceBudget) {
+        break;
+      }
       availableSpace -= bytes;
       if (availableSpace < 0) {
         break;
@@ -213,7 +264,7 @@ ExchangeClient::pickSourcesToRequestLocked() {
     }
     VELOX_CHECK(source->shouldRequestLocked());
     requestSpecs.push_back({std::move(source), requestBytes});
-    producingSources_.pop();
+    producingSources_.pop_front();
     totalPendingBytes_ += requestBytes;
   }
   if (queue_->totalBytes() == 0 && totalPendingBytes_ == 0 &&
@@ -226,12 +277,50 @@ ExchangeClient::pickSourcesToRequestLocked() {
               << " bytes, exceeding capacity " << maxQueuedBytes_;
     VELOX_CHECK(source->shouldRequestLocked());
     requestSpecs.push_back({std::move(source), requestBytes});
-    producingSources_.pop();
+    producingSources_.pop_front();
     totalPendingBytes_ += requestBytes;
   }
+  updateMemoryUsageLocked();
   return requestSpecs;
 }
 
+void ExchangeClient::updateMemoryUsageLocked() {
+  if (memoryConsumer_ != nullptr) {
+    memoryConsumer_->setUsedBytes(queue_->totalBytes() + totalPendingBytes_);
+  }
+}
+
+void ExchangeClient::prioritizeProducingSourcesLocked() {
+  for (auto& producing : producingSources_) {
+    auto it = sourceStats_.find(producing.source.get());
+    if (it == sourceStats_.end() || it->second.numBytes == 0) {
+      producing.expectedFetchUs = std::numeric_limits<double>::max();
+      continue;
+    }
+    int64_t remainingBytes = 0;
+    for (auto bytes : producing.remainingBytes) {
+      remainingBytes += bytes;
+    }
+    producing.expectedFetchUs = (double)remainingBytes *
+        it->second.totalRequestUs / it->second.numBytes;
+  }
+  std::stable_sort(
+      producingSources_.begin(),
+      producingSources_.end(),
+      [](const ProducingSource& left, const ProducingSource& right) {
+        return left.expectedFetchUs > right.expectedFetchUs;
+      });
+}
+
+folly::dynamic ExchangeClient::SourceStats::toJson() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["numRequests"] = numRequests;
+  obj["numBytes"] = numBytes;
+  obj["averageRequestUs"] = averageRequestUs();
+  obj["maxRequestUs"] = maxRequestUs;
+  return obj;
+}
+
 ExchangeClient::~ExchangeClient() {
   close();
 }
@@ -251,7 +340,12 @@ folly::dynamic ExchangeClient::toJson() const {
   folly::dynamic clientsObj = folly::dynamic::object;
   int index = 0;
   for (auto& source : sources_) {
-    clientsObj[std::to_string(index++)] = source->toJson();
+    auto sourceObj = source->toJson();
+    auto it = sourceStats_.find(source.get());
+    if (it != sourceStats_.end() && sourceObj.isObject()) {
+      sourceObj["requestStats"] = it->second.toJson();
+    }
+    clientsObj[std::to_string(index++)] = std::move(sourceObj);
   }
   obj["clients"] = clientsObj;
   return obj;
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/exec/ExchangeMemoryManager.h"
 #include "velox/exec/ExchangeQueue.h"
 #include "velox/exec/ExchangeSource.h"
 
@@ -40,7 +41,8 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
         maxQueuedBytes_{maxQueuedBytes},
         pool_(pool),
         executor_(executor),
-        queue_(std::make_shared<ExchangeQueue>()) {
+        queue_(std::make_shared<ExchangeQueue>()),
+        memoryConsumer_(ExchangeMemoryManager::makeConsumer()) {
     VELOX_CHECK_NOT_NULL(pool_);
     VELOX_CHECK_NOT_NULL(executor_);
     // NOTE: the executor is used to run async response callback from the
@@ -75,7 +77,8 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
 
   // Returns runtime statistics aggregated across all of the exchange sources.
   // ExchangeClient is expected to report background CPU time by including a
-  // runtime metric named ExchangeClient::kBackgroundCpuTimeMs.
+  // runtime metric named ExchangeClient::kBackgroundCpuTimeMs. The per-source
+  // request stats are reported with one value per source, see SourceStats.
   folly::F14FastMap<std::string, RuntimeMetric> stats() const;
 
   const std::shared_ptr<ExchangeQueue>& queue() const {
@@ -109,12 +112,42 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   struct ProducingSource {
     std::shared_ptr<ExchangeSource> source;
     std::vector<int64_t> remainingBytes;
+    // Estimated time in microseconds to fetch 'remainingBytes'. Set by
+    // prioritizeProducingSourcesLocked().
+    double expectedFetchUs{0};
+  };
+
+  // The history of the data requests to a source, used to schedule the
+  // requests.
+  struct SourceStats {
+    int64_t numRequests{0};
+    // Bytes received.
+    int64_t numBytes{0};
+    // Total and maximum time from sending a data request to its response.
+    uint64_t totalRequestUs{0};
+    uint64_t maxRequestUs{0};
+
+    double averageRequestUs() const {
+      return numRequests == 0 ? 0 : (double)totalRequestUs / numRequests;
+    }
+
+    folly::dynamic toJson() const;
   };
 
   std::vector<RequestSpec> pickSourcesToRequestLocked();
 
+  // Orders 'producingSources_' so that the sources that are expected to take
+  // the longest to fetch their remaining data, i.e. the ones that have fallen
+  // behind, are requested first. Sources with no history of data requests go
+  // first so that their throughput gets measured.
+  void prioritizeProducingSourcesLocked();
+
   void request(std::vector<RequestSpec>&& requestSpecs);
 
+  // Reports the queued and pending bytes to the node-wide exchange memory
+  // budget, if any.
+  void updateMemoryUsageLocked();
+
   // Handy for ad-hoc logging.
   const std::string taskId_;
   const int destination_;
@@ -122,6 +155,9 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   memory::MemoryPool* const pool_;
   folly::Executor* const executor_;
   const std::shared_ptr<ExchangeQueue> queue_;
+  // Share of the node-wide exchange memory budget. nullptr if there is no
+  // node-wide budget.
+  const std::unique_ptr<ExchangeMemoryManager::Consumer> memoryConsumer_;
 
   std::unordered_set<std::string> remoteTaskIds_;
   std::vector<std::shared_ptr<ExchangeSource>> sources_;
@@ -132,7 +168,9 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
 
   // A queue of sources that have returned non-empty response from the latest
   // request.
-  std::queue<ProducingSource> producingSources_;
+  std::deque<ProducingSource> producingSources_;
+  // Request history per source.
+  folly::F14FastMap<const ExchangeSource*, SourceStats> sourceStats_;
   // A queue of sources that returned empty response from the latest request.
   std::queue<std::shared_ptr<ExchangeSource>> emptySources_;
 };
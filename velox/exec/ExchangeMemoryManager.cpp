@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/ExchangeMemoryManager.h"
+
+#include <algorithm>
+
+#include <folly/Synchronized.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::exec {
+namespace {
+folly::Synchronized<std::shared_ptr<ExchangeMemoryManager>>& instance() {
+  static folly::Synchronized<std::shared_ptr<ExchangeMemoryManager>> kInstance;
+  return kInstance;
+}
+} // namespace
+
+ExchangeMemoryManager::ExchangeMemoryManager(int64_t capacity)
+    : capacity_(capacity) {
+  VELOX_CHECK_GT(capacity_, 0);
+}
+
+// static
+std::shared_ptr<ExchangeMemoryManager> ExchangeMemoryManager::getInstance() {
+  return *instance().rlock();
+}
+
+// static
+void ExchangeMemoryManager::setInstance(
+    std::shared_ptr<ExchangeMemoryManager> manager) {
+  *instance().wlock() = std::move(manager);
+}
+
+// static
+std::unique_ptr<ExchangeMemoryManager::Consumer>
+ExchangeMemoryManager::makeConsumer() {
+  auto manager = getInstance();
+  if (manager == nullptr) {
+    return nullptr;
+  }
+  return std::make_unique<Consumer>(std::move(manager));
+}
+
+void ExchangeMemoryManager::setCapacity(int64_t capacity) {
+  VELOX_CHECK_GT(capacity, 0);
+  std::lock_guard<std::mutex> l(mutex_);
+  capacity_ = capacity;
+}
+
+int64_t ExchangeMemoryManager::capacity() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return capacity_;
+}
+
+int64_t ExchangeMemoryManager::usedBytes() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return usedBytes_;
+}
+
+int32_t ExchangeMemoryManager::numActiveConsumers() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numActiveConsumers_;
+}
+
+void ExchangeMemoryManager::update(Consumer& consumer, int64_t bytes) {
+  VELOX_CHECK_GE(bytes, 0);
+  std::lock_guard<std::mutex> l(mutex_);
+  if (consumer.usedBytes_ == 0 && bytes > 0) {
+    ++numActiveConsumers_;
+  } else if (consumer.usedBytes_ > 0 && bytes == 0) {
+    --numActiveConsumers_;
+  }
+  usedBytes_ += bytes - consumer.usedBytes_;
+  consumer.usedBytes_ = bytes;
+}
+
+int64_t ExchangeMemoryManager::availableBytes(const Consumer& consumer) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  // A consumer that asks for memory is about to become active, so it counts
+  // in the number the budget is split between.
+  const auto numConsumers =
+      numActiveConsumers_ + (consumer.usedBytes_ == 0 ? 1 : 0);
+  const auto share = capacity_ / numConsumers;
+  return std::min(share - consumer.usedBytes_, capacity_ - usedBytes_);
+}
+
+} // namespace facebook::velox::exec
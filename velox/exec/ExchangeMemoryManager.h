@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+
+namespace facebook::velox::exec {
+
+/// Node-wide budget for the bytes buffered by exchanges, i.e. the pages
+/// queued or in flight in ExchangeClients and the pages in OutputBuffers.
+/// The per-task limits kMaxExchangeBufferSize and kMaxOutputBufferSize still
+/// apply. On top of these, a buffer may only hold its share of the node
+/// budget. The share is split evenly between the buffers that hold data, so
+/// that idle tasks do not reserve memory and busy ones can use what the idle
+/// ones leave. A buffer that is over its share gets backpressure: an
+/// ExchangeClient stops requesting data and an OutputBuffer blocks its
+/// producers. A buffer may always hold one page, so that every task makes
+/// progress.
+///
+/// The manager is disabled unless an instance is set with setInstance().
+class ExchangeMemoryManager {
+ public:
+  /// Accounts the bytes of one ExchangeClient or OutputBuffer. Returns all
+  /// its bytes to the manager on destruction.
+  class Consumer {
+   public:
+    explicit Consumer(std::shared_ptr<ExchangeMemoryManager> manager)
+        : manager_(std::move(manager)) {}
+
+    ~Consumer() {
+      setUsedBytes(0);
+    }
+
+    /// Sets the bytes buffered by the consumer.
+    void setUsedBytes(int64_t bytes) {
+      manager_->update(*this, bytes);
+    }
+
+    int64_t usedBytes() const {
+      return usedBytes_;
+    }
+
+    /// Returns how many more bytes the consumer may buffer. Negative if the
+    /// consumer is over its share.
+    int64_t availableBytes() const {
+      return manager_->availableBytes(*this);
+    }
+
+   private:
+    friend class ExchangeMemoryManager;
+
+    const std::shared_ptr<ExchangeMemoryManager> manager_;
+    // Guarded by 'manager_->mutex_'.
+    int64_t usedBytes_{0};
+  };
+
+  explicit ExchangeMemoryManager(int64_t capacity);
+
+  static std::shared_ptr<ExchangeMemoryManager> getInstance();
+
+  /// Sets the process-wide instance. nullptr disables the node budget for
+  /// the buffers created afterwards.
+  static void setInstance(std::shared_ptr<ExchangeMemoryManager> instance);
+
+  /// Returns a consumer of the process-wide instance or nullptr if there is
+  /// none.
+  static std::unique_ptr<Consumer> makeConsumer();
+
+  /// Changes the node budget, e.g. to give memory back to queries when the
+  /// node is low on memory. Buffers over their new share get backpressure
+  /// until they drain.
+  void setCapacity(int64_t capacity);
+
+  int64_t capacity() const;
+
+  /// Returns the bytes buffered by all consumers.
+  int64_t usedBytes() const;
+
+  /// Returns the number of consumers that buffer data.
+  int32_t numActiveConsumers() const;
+
+ private:
+  void update(Consumer& consumer, int64_t bytes);
+
+  int64_t availableBytes(const Consumer& consumer) const;
+
+  mutable std::mutex mutex_;
+  int64_t capacity_;
+  int64_t usedBytes_{0};
+  int32_t numActiveConsumers_{0};
+};
+
+} // namespace facebook::velox::exec
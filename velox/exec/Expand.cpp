@@ -56,6 +56,7 @@ Expand::Expand(
     fieldProjections_.emplace_back(std::move(rowProjection));
     constantProjections_.emplace_back(std::move(constantProjection));
   }
+  constantVectors_.resize(numRows, std::vector<VectorPtr>(numColumns));
 }
 
 bool Expand::needsInput() const {
@@ -82,20 +83,25 @@ RowVectorPtr Expand::getOutput() {
 
   const auto& rowProjection = fieldProjections_[rowIndex_];
   const auto& constantProjection = constantProjections_[rowIndex_];
+  auto& constantVectors = constantVectors_[rowIndex_];
   const auto numColumns = rowProjection.size();
 
   for (auto i = 0; i < numColumns; ++i) {
     if (rowProjection[i] == kConstantChannel) {
-      const auto& constantExpr = constantProjection[i];
-      if (constantExpr->value().isNull()) {
-        // Add null column.
-        outputColumns[i] = BaseVector::createNullConstant(
-            outputType_->childAt(i), numInput, pool());
-      } else {
-        // Add constant column.
-        outputColumns[i] = BaseVector::createConstant(
-            constantExpr->type(), constantExpr->value(), numInput, pool());
+      auto& constantVector = constantVectors[i];
+      if (constantVector == nullptr || constantVector->size() != numInput) {
+        const auto& constantExpr = constantProjection[i];
+        if (constantExpr->value().isNull()) {
+          // Add null column.
+          constantVector = BaseVector::createNullConstant(
+              outputType_->childAt(i), numInput, pool());
+        } else {
+          // Add constant column.
+          constantVector = BaseVector::createConstant(
+              constantExpr->type(), constantExpr->value(), numInput, pool());
+        }
       }
+      outputColumns[i] = constantVector;
     } else {
       outputColumns[i] = input_->childAt(rowProjection[i]);
     }
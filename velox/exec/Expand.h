@@ -47,6 +47,11 @@ class Expand : public Operator {
   std::vector<std::vector<std::shared_ptr<const core::ConstantTypedExpr>>>
       constantProjections_;
 
+  // Constant output columns by projection and column. Reused while the input
+  // batches have the same size, since downstream operators do not modify
+  // their input vectors.
+  std::vector<std::vector<VectorPtr>> constantVectors_;
+
   // Used to indicate the index of fieldProjections_.
   int32_t rowIndex_{0};
 };
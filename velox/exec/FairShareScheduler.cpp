@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/FairShareScheduler.h"
+
+#include <folly/ScopeGuard.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/process/ProcessBase.h"
+
+namespace facebook::velox::exec {
+
+FairShareScheduler::FairShareScheduler(
+    folly::Executor* executor,
+    int32_t maxRunning)
+    : executor_(executor), maxRunning_(maxRunning) {
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK_GT(maxRunning_, 0);
+}
+
+void FairShareScheduler::add(folly::Func func) {
+  add(std::move(func), "", 1);
+}
+
+void FairShareScheduler::add(
+    folly::Func func,
+    const std::string& group,
+    double weight) {
+  VELOX_CHECK_GT(weight, 0);
+  std::vector<folly::Func> toRun;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto& entry = groups_[group];
+    if (entry == nullptr) {
+      entry = std::make_unique<Group>();
+      entry->name = group;
+    }
+    entry->weight = weight;
+    entry->queue.push_back(std::move(func));
+    if (entry->queue.size() == 1) {
+      setReadyLocked(entry.get());
+    }
+    takeReadyLocked(toRun);
+  }
+  run(std::move(toRun));
+}
+
+double FairShareScheduler::virtualRuntime(const std::string& group) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = groups_.find(group);
+  return it == groups_.end() ? 0 : it->second->virtualRuntime;
+}
+
+void FairShareScheduler::setReadyLocked(Group* group) {
+  // A group that was idle does not catch up for the time it did not run.
+  group->virtualRuntime = std::max(group->virtualRuntime, minVirtualRuntime_);
+  group->readyKey = group->virtualRuntime;
+  ready_.insert({group->readyKey, group});
+}
+
+void FairShareScheduler::takeReadyLocked(std::vector<folly::Func>& toRun) {
+  while (numRunning_ < maxRunning_ && !ready_.empty()) {
+    auto* group = ready_.begin()->second;
+    ready_.erase(ready_.begin());
+    minVirtualRuntime_ = std::max(minVirtualRuntime_, group->virtualRuntime);
+    auto func = std::move(group->queue.front());
+    group->queue.pop_front();
+    // Charges the expected time now, so that the functions of one group do
+    // not take all the free threads before any of them ends.
+    const double chargedNanos = group->averageNanos / group->weight;
+    group->virtualRuntime += chargedNanos;
+    ++group->numRunning;
+    ++numRunning_;
+    if (!group->queue.empty()) {
+      group->readyKey = group->virtualRuntime;
+      ready_.insert({group->readyKey, group});
+    }
+    toRun.push_back(
+        [this, group, chargedNanos, func = std::move(func)]() mutable {
+          const auto startNanos = process::threadCpuNanos();
+          auto finishGuard = folly::makeGuard([&]() {
+            finished(
+                group, chargedNanos, process::threadCpuNanos() - startNanos);
+          });
+          func();
+        });
+  }
+}
+
+void FairShareScheduler::finished(
+    Group* group,
+    double chargedNanos,
+    uint64_t nanos) {
+  std::vector<folly::Func> toRun;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    group->virtualRuntime += nanos / group->weight - chargedNanos;
+    group->averageNanos = group->averageNanos * 0.875 + nanos * 0.125;
+    --group->numRunning;
+    --numRunning_;
+    if (!group->queue.empty()) {
+      ready_.erase({group->readyKey, group});
+      group->readyKey = group->virtualRuntime;
+      ready_.insert({group->readyKey, group});
+    } else if (group->numRunning == 0) {
+      const auto name = group->name;
+      groups_.erase(name);
+    }
+    takeReadyLocked(toRun);
+  }
+  run(std::move(toRun));
+}
+
+void FairShareScheduler::run(std::vector<folly::Func> toRun) {
+  for (auto& func : toRun) {
+    executor_->add(std::move(func));
+  }
+}
+
+} // namespace facebook::velox::exec
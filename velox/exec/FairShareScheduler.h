@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+/// Executor that shares the threads of another executor among groups of
+/// queries by weighted fair share. Each group has a virtual runtime, the thread
+/// CPU time of its functions divided by its weight. At most 'maxRunning'
+/// functions run at a time and the next one comes from the group with the
+/// least virtual runtime. A group that becomes runnable starts at the least
+/// virtual runtime of the runnable groups, so that it does not get the time it
+/// was idle. Use as the executor of a QueryCtx. Driver::enqueue() adds the
+/// Driver to the group and with the weight in the QueryConfig of the query.
+/// Drivers that yield when their time slice is used up let the groups take
+/// turns.
+class FairShareScheduler : public folly::Executor {
+ public:
+  /// Runs the functions on 'executor', which must outlive 'this'.
+  FairShareScheduler(folly::Executor* executor, int32_t maxRunning);
+
+  /// Adds 'func' to the group "".
+  void add(folly::Func func) override;
+
+  /// Adds 'func' to 'group' and sets the weight of 'group' to 'weight'.
+  void add(folly::Func func, const std::string& group, double weight);
+
+  /// Returns the virtual runtime of 'group' in nanoseconds or 0 if 'group'
+  /// has no queued or running functions.
+  double virtualRuntime(const std::string& group) const;
+
+  int32_t numRunning() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numRunning_;
+  }
+
+ private:
+  struct Group {
+    std::string name;
+    double weight{1};
+    double virtualRuntime{0};
+    // Key of the group in 'ready_' if it has queued functions.
+    double readyKey{0};
+    std::deque<folly::Func> queue;
+    int32_t numRunning{0};
+    // Moving average of the CPU time of the functions of the group, which is
+    // charged when a function starts to run and corrected when it ends.
+    double averageNanos{kInitialAverageNanos};
+  };
+
+  static constexpr double kInitialAverageNanos = 1'000'000;
+
+  // Takes the functions to run next. Called with 'mutex_' held.
+  void takeReadyLocked(std::vector<folly::Func>& toRun);
+
+  // Records that a function of 'group' that was charged 'chargedNanos' ran
+  // for 'nanos'.
+  void finished(Group* group, double chargedNanos, uint64_t nanos);
+
+  void setReadyLocked(Group* group);
+
+  void run(std::vector<folly::Func> toRun);
+
+  folly::Executor* const executor_;
+  const int32_t maxRunning_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::unique_ptr<Group>> groups_;
+  // Groups with queued functions by virtual runtime.
+  std::set<std::pair<double, Group*>> ready_;
+  int32_t numRunning_{0};
+  // Virtual runtime of the last group to run. The floor of the virtual
+  // runtime of groups that become runnable.
+  double minVirtualRuntime_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -117,6 +117,40 @@ bool FilterProject::allInputProcessed() {
   return false;
 }
 
+void FilterProject::recordExprStats() {
+  uint64_t numPeeledVectors = 0;
+  uint64_t numDictionaryCacheHits = 0;
+  for (const auto& [name, stats] : exprs_->stats()) {
+    numPeeledVectors += stats.numPeeledVectors;
+    numDictionaryCacheHits += stats.numDictionaryCacheHits;
+  }
+  if (numPeeledVectors > 0) {
+    addRuntimeStat(kExprNumPeeledVectors, RuntimeCounter(numPeeledVectors));
+  }
+  if (numDictionaryCacheHits > 0) {
+    addRuntimeStat(
+        kExprNumDictionaryCacheHits, RuntimeCounter(numDictionaryCacheHits));
+  }
+
+  if (!operatorCtx_->driverCtx()->queryConfig().exprTrackCpuUsage()) {
+    return;
+  }
+  std::vector<std::string> rootNames(exprs_->exprs().size());
+  if (hasFilter_) {
+    rootNames[0] = "filter";
+  }
+  for (const auto& projection : resultProjections_) {
+    rootNames[projection.inputChannel] =
+        outputType_->nameOf(projection.outputChannel);
+  }
+  for (const auto& [stack, nanos] :
+       exprStatsToFoldedStacks(*exprs_, rootNames)) {
+    addRuntimeStat(
+        kExprCpuNanosPrefix + stack,
+        RuntimeCounter(nanos, RuntimeCounter::Unit::kNanos));
+  }
+}
+
 bool FilterProject::isFinished() {
   return noMoreInput_ && allInputProcessed();
 }
@@ -51,9 +51,26 @@ class FilterProject : public Operator {
 
   bool isFinished() override;
 
+  /// Prefix of the runtime stats with the CPU time spent in each expression
+  /// node. The rest of the name is the folded stack of the node as returned
+  /// by exprStatsToFoldedStacks(), with the filter rooted at 'filter' and the
+  /// projections rooted at the names of their output columns. Reported only if
+  /// QueryConfig.exprTrackCpuUsage() is 'true'.
+  static inline const std::string kExprCpuNanosPrefix{"exprCpuNanos."};
+
+  /// Number of vectors evaluated on peeled inputs by all expression nodes.
+  static inline const std::string kExprNumPeeledVectors{
+      "exprNumPeeledVectors"};
+
+  /// Number of vectors that reused memoized dictionary results in all
+  /// expression nodes.
+  static inline const std::string kExprNumDictionaryCacheHits{
+      "exprNumDictionaryCacheHits"};
+
   void close() override {
     Operator::close();
     if (exprs_ != nullptr) {
+      recordExprStats();
       exprs_->clear();
     } else {
       VELOX_CHECK(!initialized_);
@@ -79,6 +96,9 @@ class FilterProject : public Operator {
   // should return nullptr.
   bool allInputProcessed();
 
+  // Adds the per node stats of 'exprs_' to the runtime stats.
+  void recordExprStats();
+
   // Evaluate filter on all rows. Return number of rows that passed the filter.
   // Populate filterEvalCtx_.selectedBits and selectedIndices with the indices
   // of the passing rows if only some rows pass the filter. If all or no rows
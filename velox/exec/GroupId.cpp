@@ -55,6 +55,8 @@ GroupId::GroupId(
 
     groupingKeyMappings_.emplace_back(std::move(mappings));
   }
+  nullConstants_.resize(numGroupingKeys);
+  groupIdConstants_.resize(groupingKeyMappings_.size());
 
   const auto& aggregationInputs = groupIdNode->aggregationInputs();
   aggregationInputs_.reserve(aggregationInputs.size());
@@ -94,8 +96,12 @@ RowVectorPtr GroupId::getOutput() {
   for (auto i = 0; i < numGroupingKeys; ++i) {
     if (mapping[i] == kMissingGroupingKey) {
       // Add null column.
-      outputColumns[i] = BaseVector::createNullConstant(
-          outputType_->childAt(i), numInput, pool());
+      auto& nullConstant = nullConstants_[i];
+      if (nullConstant == nullptr || nullConstant->size() != numInput) {
+        nullConstant = BaseVector::createNullConstant(
+            outputType_->childAt(i), numInput, pool());
+      }
+      outputColumns[i] = nullConstant;
     } else {
       outputColumns[i] = input_->childAt(mapping[i]);
     }
@@ -107,9 +113,12 @@ RowVectorPtr GroupId::getOutput() {
   }
 
   // Add groupId column.
-  outputColumns[outputType_->size() - 1] =
-      std::make_shared<ConstantVector<int64_t>>(
-          pool(), numInput, false, BIGINT(), groupingSetIndex_);
+  auto& groupIdConstant = groupIdConstants_[groupingSetIndex_];
+  if (groupIdConstant == nullptr || groupIdConstant->size() != numInput) {
+    groupIdConstant = std::make_shared<ConstantVector<int64_t>>(
+        pool(), numInput, false, BIGINT(), groupingSetIndex_);
+  }
+  outputColumns[outputType_->size() - 1] = groupIdConstant;
 
   ++groupingSetIndex_;
   if (groupingSetIndex_ == groupingKeyMappings_.size()) {
@@ -58,6 +58,12 @@ class GroupId : public Operator {
   /// position in the list identifies the column in the output.
   std::vector<column_index_t> aggregationInputs_;
 
+  /// Null constants for the grouping key columns and groupId constants for the
+  /// grouping sets. Reused while the input batches have the same size, since
+  /// downstream operators do not modify their input vectors.
+  std::vector<VectorPtr> nullConstants_;
+  std::vector<VectorPtr> groupIdConstants_;
+
   /// 'getOutput()' returns 'input_' for one grouping set at a time.
   /// 'groupingSetIndex_' contains the index of the grouping set to output in
   /// the next 'getOutput' call. This index is used to generate groupId column
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/exec/GroupingSet.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Task.h"
 
@@ -54,7 +56,8 @@ GroupingSet::GroupingSet(
     tsan_atomic<bool>* nonReclaimableSection,
     OperatorCtx* operatorCtx,
     folly::Synchronized<common::SpillStats>* spillStats)
-    : preGroupedKeyChannels_(std::move(preGroupedKeys)),
+    : inputType_(inputType),
+      preGroupedKeyChannels_(std::move(preGroupedKeys)),
       hashers_(std::move(hashers)),
       isGlobal_(hashers_.empty()),
       isPartial_(isPartial),
@@ -70,6 +73,8 @@ GroupingSet::GroupingSet(
       stringAllocator_(operatorCtx->pool()),
       rows_(operatorCtx->pool()),
       isAdaptive_(queryConfig_.hashAdaptivityEnabled()),
+      compactionFragmentationPct_(
+          queryConfig_.aggregationCompactionFragmentationPct()),
       pool_(*operatorCtx->pool()),
       spillStats_(spillStats) {
   VELOX_CHECK_NOT_NULL(nonReclaimableSection_);
@@ -108,6 +113,17 @@ GroupingSet::GroupingSet(
       distinctAggregations_.push_back(nullptr);
     }
   }
+
+  // The sorted and distinct aggregations and the distinct hash aggregation
+  // rely on the sorted spilled runs. The aggregates of the spilled groups are
+  // merged with 'addIntermediateResults' in partitioned mode.
+  partitionedSpill_ = spillConfig_ != nullptr &&
+      queryConfig_.aggregationSpillPartitioned() && !isDistinct() &&
+      sortedAggregations_ == nullptr &&
+      std::none_of(
+          distinctAggregations_.begin(),
+          distinctAggregations_.end(),
+          [](const auto& aggregation) { return aggregation != nullptr; });
 }
 
 GroupingSet::~GroupingSet() {
@@ -116,27 +132,6 @@ GroupingSet::~GroupingSet() {
   }
 }
 
-std::unique_ptr<GroupingSet> GroupingSet::createForMarkDistinct(
-    const RowTypePtr& inputType,
-    std::vector<std::unique_ptr<VectorHasher>>&& hashers,
-    OperatorCtx* operatorCtx,
-    tsan_atomic<bool>* nonReclaimableSection) {
-  return std::make_unique<GroupingSet>(
-      inputType,
-      std::move(hashers),
-      /*preGroupedKeys*/ std::vector<column_index_t>{},
-      /*aggregates*/ std::vector<AggregateInfo>{},
-      /*ignoreNullKeys*/ false,
-      /*isPartial*/ false,
-      /*isRawInput*/ false,
-      /*globalGroupingSets*/ std::vector<vector_size_t>{},
-      /*groupIdColumn*/ std::nullopt,
-      /*spillConfig*/ nullptr,
-      nonReclaimableSection,
-      operatorCtx,
-      /*spillStats_*/ nullptr);
-};
-
 namespace {
 bool equalKeys(
     const std::vector<column_index_t>& keys,
@@ -230,6 +225,9 @@ void GroupingSet::addInputForActiveRows(
       activeRows_,
       ignoreNullKeys_,
       BaseHashTable::kNoSpillInputStartPartitionBit);
+  if (keySketchEnabled_) {
+    updateKeySketch();
+  }
   if (lookup_->rows.empty()) {
     // No rows to probe. Can happen when ignoreNullKeys_ is true and all rows
     // have null keys.
@@ -290,6 +288,93 @@ void GroupingSet::addInputForActiveRows(
     }
     sortedAggregations_->addInput(groups, input);
   }
+
+  if (compactionFragmentationPct_ > 0) {
+    maybeCompactStringAllocator();
+  }
+}
+
+void GroupingSet::maybeCompactStringAllocator() {
+  // Compacting small allocators does not pay off.
+  constexpr int64_t kMinCompactionBytes = 16 << 20;
+  auto* rows = table_->rows();
+  auto& allocator = rows->stringAllocator();
+  if (allocator.retainedSize() < kMinCompactionBytes ||
+      stringAllocatorFragmentationPct() < compactionFragmentationPct_) {
+    return;
+  }
+  if (sortedAggregations_ != nullptr || !distinctAggregations_.empty() ||
+      rows->stringAllocatorShared().use_count() != 1) {
+    return;
+  }
+  for (const auto& aggregate : aggregates_) {
+    if (!aggregate.function->supportsRelocation()) {
+      return;
+    }
+  }
+  rows->compactStringAllocator(
+      [&](folly::Range<char**> groups, HashStringAllocator* newAllocator) {
+        for (auto& aggregate : aggregates_) {
+          aggregate.function->relocate(groups, newAllocator);
+        }
+      });
+  for (auto& aggregate : aggregates_) {
+    aggregate.function->setAllocator(&rows->stringAllocator());
+  }
+  ++numStringAllocatorCompactions_;
+}
+
+void GroupingSet::enableKeySketch() {
+  VELOX_CHECK(!isGlobal_);
+  if (keySketchEnabled_) {
+    return;
+  }
+  // 2KB of memory with the max standard error of 0.023.
+  constexpr int8_t kIndexBitLength = 11;
+  keySketchEnabled_ = true;
+  sparseKeySketch_ =
+      std::make_unique<common::hll::SparseHll>(&stringAllocator_);
+  sparseKeySketch_->setSoftMemoryLimit(
+      common::hll::DenseHll::estimateInMemorySize(kIndexBitLength));
+  denseKeySketch_ = std::make_unique<common::hll::DenseHll>(
+      kIndexBitLength, &stringAllocator_);
+}
+
+void GroupingSet::disableKeySketch() {
+  keySketchEnabled_ = false;
+  sparseKeySketch_.reset();
+  denseKeySketch_.reset();
+  keySketchHashes_.clear();
+}
+
+std::optional<int64_t> GroupingSet::estimateNumDistinctKeys() const {
+  if (!keySketchEnabled_) {
+    return std::nullopt;
+  }
+  return sparseKeySketch_ != nullptr ? sparseKeySketch_->cardinality()
+                                     : denseKeySketch_->cardinality();
+}
+
+void GroupingSet::updateKeySketch() {
+  const uint64_t* hashes = lookup_->hashes.data();
+  if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+    // The lookup has the value ids of the keys which are not stable across
+    // the hash mode changes. The keys are already decoded by the hashers.
+    keySketchHashes_.resize(activeRows_.end());
+    const auto& hashers = lookup_->hashers;
+    for (auto i = 0; i < hashers.size(); ++i) {
+      hashers[i]->hash(activeRows_, i > 0, keySketchHashes_);
+    }
+    hashes = keySketchHashes_.data();
+  }
+  for (auto row : lookup_->rows) {
+    if (sparseKeySketch_ == nullptr) {
+      denseKeySketch_->insertHash(hashes[row]);
+    } else if (sparseKeySketch_->insertHash(hashes[row])) {
+      sparseKeySketch_->toDense(*denseKeySketch_);
+      sparseKeySketch_.reset();
+    }
+  }
 }
 
 void GroupingSet::addRemainingInput() {
@@ -825,19 +910,11 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
     return;
   }
 
-  const auto numDistinct = table_->numDistinct();
-  if (numDistinct == 0) {
+  if (table_->numDistinct() == 0) {
     // Table is empty. Nothing to spill.
     return;
   }
 
-  auto* rows = table_->rows();
-  auto [freeRows, outOfLineFreeBytes] = rows->freeSpace();
-  const auto outOfLineBytes =
-      rows->stringAllocator().retainedSize() - outOfLineFreeBytes;
-  const auto outOfLineBytesPerRow = outOfLineBytes / numDistinct;
-  const int64_t flatBytes = input->estimateFlatSize();
-
   // Test-only spill path.
   if (testingTriggerSpill(pool_.name())) {
     memory::ReclaimableSectionGuard guard(nonReclaimableSection_);
@@ -845,6 +922,37 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
     return;
   }
 
+  const auto targetIncrementBytes = inputReservationBytes(input);
+  if (targetIncrementBytes == 0) {
+    return;
+  }
+  {
+    memory::ReclaimableSectionGuard guard(nonReclaimableSection_);
+    if (pool_.maybeReserve(targetIncrementBytes)) {
+      return;
+    }
+  }
+  LOG(WARNING) << "Failed to reserve " << succinctBytes(targetIncrementBytes)
+               << " for memory pool " << pool_.name()
+               << ", usage: " << succinctBytes(pool_.currentBytes())
+               << ", reservation: " << succinctBytes(pool_.reservedBytes());
+}
+
+int64_t GroupingSet::inputReservationBytes(const RowVectorPtr& input) const {
+  if (isPartial_ || spillConfig_ == nullptr || table_ == nullptr) {
+    return 0;
+  }
+  const auto numDistinct = table_->numDistinct();
+  if (numDistinct == 0) {
+    return 0;
+  }
+
+  auto* rows = table_->rows();
+  auto [freeRows, outOfLineFreeBytes] = rows->freeSpace();
+  const auto outOfLineBytes =
+      rows->stringAllocator().retainedSize() - outOfLineFreeBytes;
+  const int64_t flatBytes = input->estimateFlatSize();
+
   const auto currentUsage = pool_.currentBytes();
   const auto minReservationBytes =
       currentUsage * spillConfig_->minSpillableReservationPct / 100;
@@ -864,7 +972,7 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
       // stopgap because the real increase can be higher, specially with
       // aggregates that have stl or folly containers. Make a way to raise the
       // reservation in the spill protected section instead.
-      return;
+      return 0;
     }
 
     // If there is variable length data we take double the flat size of the
@@ -873,26 +981,16 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
     // area instead.
     // There must be at least 2x the increment in reservation.
     if (availableReservationBytes > 2 * incrementBytes) {
-      return;
+      return 0;
     }
   }
 
   // Check if we can increase reservation. The increment is the larger of twice
   // the maximum increment from this input and 'spillableReservationGrowthPct_'
   // of the current memory usage.
-  const auto targetIncrementBytes = std::max<int64_t>(
+  return std::max<int64_t>(
       incrementBytes * 2,
       currentUsage * spillConfig_->spillableReservationGrowthPct / 100);
-  {
-    memory::ReclaimableSectionGuard guard(nonReclaimableSection_);
-    if (pool_.maybeReserve(targetIncrementBytes)) {
-      return;
-    }
-  }
-  LOG(WARNING) << "Failed to reserve " << succinctBytes(targetIncrementBytes)
-               << " for memory pool " << pool_.name()
-               << ", usage: " << succinctBytes(pool_.currentBytes())
-               << ", reservation: " << succinctBytes(pool_.reservedBytes());
 }
 
 void GroupingSet::ensureOutputFits() {
@@ -951,9 +1049,25 @@ void GroupingSet::spill() {
     return;
   }
 
-  if (!hasSpilled()) {
-    auto rows = table_->rows();
-    VELOX_DCHECK(pool_.trackUsage());
+  if (!hasSpilled() || spiller_->finalized()) {
+    setupSpiller();
+  }
+  spiller_->spill();
+  if (isDistinct() && numDistinctSpilledFiles_ == 0) {
+    numDistinctSpilledFiles_ = spiller_->state().numFinishedFiles(0);
+    VELOX_CHECK_GT(numDistinctSpilledFiles_, 0);
+  }
+  if (sortedAggregations_) {
+    sortedAggregations_->clear();
+  }
+  table_->clear();
+}
+
+void GroupingSet::setupSpiller() {
+  auto* rows = table_->rows();
+  VELOX_DCHECK(pool_.trackUsage());
+  if (!partitionedSpill_) {
+    VELOX_CHECK(!hasSpilled());
     VELOX_CHECK_EQ(numDistinctSpilledFiles_, 0);
     spiller_ = std::make_unique<Spiller>(
         Spiller::Type::kAggregateInput,
@@ -964,16 +1078,24 @@ void GroupingSet::spill() {
         spillConfig_,
         spillStats_);
     VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
+    return;
   }
-  spiller_->spill();
-  if (isDistinct() && numDistinctSpilledFiles_ == 0) {
-    numDistinctSpilledFiles_ = spiller_->state().numFinishedFiles(0);
-    VELOX_CHECK_GT(numDistinctSpilledFiles_, 0);
-  }
-  if (sortedAggregations_) {
-    sortedAggregations_->clear();
-  }
-  table_->clear();
+
+  // A restored partition is spilled by the hash bits following the ones of
+  // the partition.
+  const uint8_t startPartitionBit = restoringPartitionId_.has_value()
+      ? restoringPartitionId_->partitionBitOffset() +
+          spillConfig_->numPartitionBits
+      : spillConfig_->startPartitionBit;
+  spiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kAggregateInputPartitioned,
+      rows,
+      makeSpillType(),
+      HashBitRange(
+          startPartitionBit,
+          startPartitionBit + spillConfig_->numPartitionBits),
+      spillConfig_,
+      spillStats_);
 }
 
 void GroupingSet::spill(const RowContainerIterator& rowIterator) {
@@ -1000,6 +1122,10 @@ bool GroupingSet::getOutputWithSpill(
     int32_t maxOutputRows,
     int32_t maxOutputBytes,
     const RowVectorPtr& result) {
+  if (spiller_->type() == Spiller::Type::kAggregateInputPartitioned) {
+    return getOutputWithPartitionedSpill(maxOutputRows, maxOutputBytes, result);
+  }
+
   if (merge_ == nullptr) {
     VELOX_CHECK_NULL(mergeRows_);
     VELOX_CHECK(mergeArgs_.empty());
@@ -1030,7 +1156,8 @@ bool GroupingSet::getOutputWithSpill(
 
     VELOX_CHECK_NULL(merge_);
     auto spillPartition = spiller_->finishSpill();
-    merge_ = spillPartition.createOrderedReader(&pool_, spillStats_);
+    merge_ =
+        spillPartition.createOrderedReader(&pool_, spillStats_, spillConfig_);
   }
   VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
   if (merge_ == nullptr) {
@@ -1039,6 +1166,109 @@ bool GroupingSet::getOutputWithSpill(
   return mergeNext(maxOutputRows, maxOutputBytes, result);
 }
 
+bool GroupingSet::getOutputWithPartitionedSpill(
+    int32_t maxOutputRows,
+    int32_t maxOutputBytes,
+    const RowVectorPtr& result) {
+  // @lint-ignore CLANGTIDY
+  char* groups[maxOutputRows];
+  for (;;) {
+    const int32_t numGroups = table_->rows()->listRows(
+        &spillOutputIterator_, maxOutputRows, maxOutputBytes, groups);
+    if (numGroups > 0) {
+      extractGroups(folly::Range<char**>(groups, numGroups), result);
+      return true;
+    }
+    table_->clear();
+    spillOutputIterator_.reset();
+    if (!restoreNextSpillPartition()) {
+      return false;
+    }
+  }
+  VELOX_UNREACHABLE();
+}
+
+bool GroupingSet::restoreNextSpillPartition() {
+  VELOX_CHECK_EQ(table_->numDistinct(), 0);
+  VELOX_CHECK_NULL(spillInputReader_);
+
+  if (!spiller_->finalized()) {
+    spiller_->finishSpill(spillPartitionSet_);
+    removeEmptyPartitions(spillPartitionSet_);
+  }
+  if (spillPartitionSet_.empty()) {
+    restoringPartitionId_.reset();
+    return false;
+  }
+
+  auto it = spillPartitionSet_.begin();
+  restoringPartitionId_ = it->first;
+  spillInputReader_ = it->second->createUnorderedReader(&pool_, spillStats_);
+  spillPartitionSet_.erase(it);
+
+  // Disable spilling if exceeding the max spill level and the query might run
+  // out of memory if the restored partition still can't fit in memory.
+  exceededMaxSpillLevelLimit_ = spillConfig_->exceedSpillLevelLimit(
+      restoringPartitionId_->partitionBitOffset() +
+      spillConfig_->numPartitionBits);
+  if (exceededMaxSpillLevelLimit_) {
+    RECORD_METRIC_VALUE(kMetricMaxSpillLevelExceededCount);
+    FB_LOG_EVERY_MS(WARNING, 1'000)
+        << "Exceeded spill level limit: " << spillConfig_->maxSpillLevel
+        << ", and disable spilling for memory pool: " << pool_.name();
+    ++spillStats_->wlock()->spillMaxLevelExceededCount;
+  }
+
+  RowVectorPtr input;
+  while (spillInputReader_->nextBatch(input)) {
+    addSpillInput(input);
+  }
+  spillInputReader_.reset();
+
+  // If the restored partition has been spilled again, spills the rest of it
+  // too. Its spilled partitions are restored by the next calls.
+  if (!spiller_->finalized()) {
+    spill();
+  }
+  return true;
+}
+
+void GroupingSet::addSpillInput(const RowVectorPtr& input) {
+  // NOTE: this might spill and clear 'table_'.
+  ensureInputFits(input);
+
+  // Place the spilled keys at the input channels of the hashers.
+  const auto& hashers = table_->hashers();
+  std::vector<VectorPtr> columns(inputType_->size());
+  for (auto i = 0; i < hashers.size(); ++i) {
+    columns[hashers[i]->channel()] = input->childAt(i);
+  }
+  const auto keys = std::make_shared<RowVector>(
+      &pool_, inputType_, nullptr, input->size(), std::move(columns));
+
+  activeRows_.resize(input->size());
+  activeRows_.setAll();
+  table_->prepareForGroupProbe(
+      *lookup_,
+      keys,
+      activeRows_,
+      false,
+      restoringPartitionId_->partitionBitOffset());
+  table_->groupProbe(*lookup_);
+
+  auto* groups = lookup_->hits.data();
+  const auto& newGroups = lookup_->newGroups;
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    auto& function = aggregates_[i].function;
+    if (!newGroups.empty()) {
+      function->initializeNewGroups(groups, newGroups);
+    }
+    tempVectors_.push_back(input->childAt(hashers.size() + i));
+    function->addIntermediateResults(groups, activeRows_, tempVectors_, false);
+    tempVectors_.clear();
+  }
+}
+
 bool GroupingSet::mergeNext(
     int32_t maxOutputRows,
     int32_t maxOutputBytes,
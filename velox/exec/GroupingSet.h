@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include "velox/common/hyperloglog/DenseHll.h"
+#include "velox/common/hyperloglog/SparseHll.h"
 #include "velox/exec/AggregateInfo.h"
 #include "velox/exec/AggregationMasks.h"
 #include "velox/exec/DistinctAggregations.h"
@@ -45,13 +47,6 @@ class GroupingSet {
 
   ~GroupingSet();
 
-  // Used by MarkDistinct operator to identify rows with unique values.
-  static std::unique_ptr<GroupingSet> createForMarkDistinct(
-      const RowTypePtr& inputType,
-      std::vector<std::unique_ptr<VectorHasher>>&& hashers,
-      OperatorCtx* operatorCtx,
-      tsan_atomic<bool>* nonReclaimableSection);
-
   void addInput(const RowVectorPtr& input, bool mayPushdown);
 
   void noMoreInput();
@@ -122,11 +117,43 @@ class GroupingSet {
   /// Returns true if spilling has triggered on this grouping set.
   bool hasSpilled() const;
 
+  /// Returns true if the hash partitioned spilling is restoring a spilled
+  /// partition into the hash table which can be spilled again by spill(). This
+  /// is the only case that spilling is allowed after spilling has triggered.
+  bool canSpillRestoredPartition() const {
+    return spillInputReader_ != nullptr && !exceededMaxSpillLevelLimit_;
+  }
+
   /// Returns the hashtable stats.
   HashTableStats hashTableStats() const {
     return table_ ? table_->stats() : HashTableStats{};
   }
 
+  /// Runtime stats for the compaction of the variable width state of the
+  /// groups, see QueryConfig::kAggregationCompactionFragmentationPct.
+  static inline const std::string kStringAllocatorFragmentationPct{
+      "stringAllocatorFragmentationPct"};
+  static inline const std::string kNumStringAllocatorCompactions{
+      "numStringAllocatorCompactions"};
+
+  bool stringAllocatorCompactionEnabled() const {
+    return compactionFragmentationPct_ > 0;
+  }
+
+  /// Returns the percentage of the variable width memory of the groups that is
+  /// on the free lists.
+  int32_t stringAllocatorFragmentationPct() const {
+    return table_
+        ? 100 * table_->rows()->stringAllocator().fragmentationRatio()
+        : 0;
+  }
+
+  /// Returns the number of times the variable width state of the groups has
+  /// been compacted.
+  uint64_t numStringAllocatorCompactions() const {
+    return numStringAllocatorCompactions_;
+  }
+
   /// Return the number of rows kept in memory.
   int64_t numRows() const {
     return table_ ? table_->rows()->numRows() : 0;
@@ -154,6 +181,24 @@ class GroupingSet {
 
   std::optional<int64_t> estimateOutputRowSize() const;
 
+  /// Starts to maintain a HyperLogLog sketch over the hashes of the grouping
+  /// keys of the input rows. Used by partial aggregation to estimate the
+  /// reduction across the table flushes.
+  void enableKeySketch();
+
+  /// Stops to maintain the sketch of the grouping keys and frees its memory.
+  void disableKeySketch();
+
+  /// Returns the estimated number of distinct grouping keys added since
+  /// enableKeySketch(), or std::nullopt if the sketch is not enabled.
+  std::optional<int64_t> estimateNumDistinctKeys() const;
+
+  /// Returns the number of bytes to add to the memory reservation before
+  /// 'input' can be added without allocating from the spill unprotected
+  /// section, or 0 if the current reservation suffices or spilling is not
+  /// enabled.
+  int64_t inputReservationBytes(const RowVectorPtr& input) const;
+
  private:
   bool isDistinct() const {
     return aggregates_.empty();
@@ -163,6 +208,10 @@ class GroupingSet {
 
   void addRemainingInput();
 
+  // Adds the hashes of the grouping keys of the rows in 'lookup_' to the key
+  // sketch.
+  void updateKeySketch();
+
   void initializeGlobalAggregation();
 
   void destroyGlobalAggregations();
@@ -252,17 +301,48 @@ class GroupingSet {
   // Returns a RowType of the spilled data.
   RowTypePtr makeSpillType() const;
 
+  // Creates 'spiller_' to spill the rows of 'table_'. If 'partitionedSpill_'
+  // is set, the spiller partitions the rows by the hash bits following the
+  // ones of the spilled partition being restored, if any.
+  void setupSpiller();
+
+  // Produces output if the hash partitioned spilling has occurred. Restores
+  // and aggregates one spilled partition at a time in 'table_' and produces
+  // the output from it. Returns false when all the spilled partitions have
+  // been processed.
+  bool getOutputWithPartitionedSpill(
+      int32_t maxOutputRows,
+      int32_t maxOutputBytes,
+      const RowVectorPtr& result);
+
+  // Restores the next spilled partition into 'table_'. If the restored
+  // partition doesn't fit in memory, 'table_' is spilled again into the
+  // partitions of the next spill level which are restored by the subsequent
+  // calls. Returns false if there are no more spilled partitions.
+  bool restoreNextSpillPartition();
+
+  // Adds a batch of spilled groups to 'table_' and merges their accumulators
+  // into the ones of the matching groups.
+  void addSpillInput(const RowVectorPtr& input);
+
   // Copies the finalized state from 'mergeRows' to 'result' and clears
   // 'mergeRows'. Used for producing a batch of results when aggregating spilled
   // groups.
   void extractSpillResult(const RowVectorPtr& result);
 
+  // Copies the variable width state of the groups in 'table_' to a new
+  // HashStringAllocator if the current one has more free memory than
+  // 'compactionFragmentationPct_' and all the aggregates support relocation.
+  void maybeCompactStringAllocator();
+
   // Return a list of accumulators for 'aggregates_', plus one more accumulator
   // for 'sortedAggregations_', and one for each 'distinctAggregations_'.  When
   // 'excludeToIntermediate' is true, skip the functions that support
   // 'toIntermediate'.
   std::vector<Accumulator> accumulators(bool excludeToIntermediate);
 
+  const RowTypePtr inputType_;
+
   std::vector<column_index_t> keyChannels_;
 
   /// A subset of grouping keys on which the input is clustered.
@@ -312,6 +392,12 @@ class GroupingSet {
   memory::AllocationPool rows_;
   const bool isAdaptive_;
 
+  // See QueryConfig::kAggregationCompactionFragmentationPct. 0 if disabled.
+  const int32_t compactionFragmentationPct_;
+
+  // Number of compactions done by maybeCompactStringAllocator().
+  uint64_t numStringAllocatorCompactions_{0};
+
   bool noMoreInput_{false};
 
   // In case of partial streaming aggregation, the input vector passed to
@@ -333,6 +419,27 @@ class GroupingSet {
   size_t numDistinctSpilledFiles_{0};
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
 
+  // True if the groups are spilled hash partitioned without sorting, see
+  // core::QueryConfig::kAggregationSpillPartitioned.
+  bool partitionedSpill_{false};
+
+  // The spilled partitions which haven't been restored yet.
+  SpillPartitionSet spillPartitionSet_;
+
+  // The id of the spilled partition restored into 'table_', if any.
+  std::optional<SpillPartitionId> restoringPartitionId_;
+
+  // Reads the spilled partition being restored into 'table_'. Only set while
+  // restoring the partition.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
+
+  // Indicates if the restored partition has exceeded the max spill level and
+  // can't be spilled again.
+  bool exceededMaxSpillLevelLimit_{false};
+
+  // Points to the next group to output from the restored partition.
+  RowContainerIterator spillOutputIterator_;
+
   // Container for materializing batches of output from spilling.
   std::unique_ptr<RowContainer> mergeRows_;
 
@@ -366,6 +473,15 @@ class GroupingSet {
   std::vector<char*> firstGroup_;
 
   folly::Synchronized<common::SpillStats>* const spillStats_;
+
+  // Sketch of the grouping keys, see enableKeySketch(). Starts sparse and
+  // turns dense after reaching the memory size of the dense one. Allocated
+  // from 'stringAllocator_'.
+  bool keySketchEnabled_{false};
+  std::unique_ptr<common::hll::SparseHll> sparseKeySketch_;
+  std::unique_ptr<common::hll::DenseHll> denseKeySketch_;
+  // Hashes of the grouping keys if 'lookup_' has value ids.
+  raw_vector<uint64_t> keySketchHashes_;
 };
 
 } // namespace facebook::velox::exec
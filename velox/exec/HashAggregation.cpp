@@ -45,6 +45,13 @@ HashAggregation::HashAggregation(
           driverCtx->queryConfig().abandonPartialAggregationMinRows()),
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      abandonPartialAggregationSketchRows_(
+          isPartialOutput_ && !isGlobal_
+              ? driverCtx->queryConfig().abandonPartialAggregationSketchRows()
+              : 0),
+      clusteredFlushEnabled_(
+          isPartialOutput_ && !isGlobal_ && !isDistinct_ &&
+          driverCtx->queryConfig().partialAggregationClusteredFlushEnabled()),
       maxPartialAggregationMemoryUsage_(
           driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
 
@@ -108,6 +115,9 @@ void HashAggregation::initialize() {
       &nonReclaimableSection_,
       operatorCtx_.get(),
       &spillStats_);
+  if (abandonPartialAggregationSketchRows_ > 0) {
+    groupingSet_->enableKeySketch();
+  }
 
   aggregationNode_.reset();
 }
@@ -118,6 +128,25 @@ bool HashAggregation::abandonPartialAggregationEarly(int64_t numOutput) const {
       100 * numOutput / numInputRows_ >= abandonPartialAggregationMinPct_;
 }
 
+void HashAggregation::checkKeySketch() {
+  VELOX_CHECK(isPartialOutput_ && !isGlobal_);
+  const auto numDistinctKeys = groupingSet_->estimateNumDistinctKeys();
+  VELOX_CHECK(numDistinctKeys.has_value());
+  // The decision is made once, free the sketch.
+  groupingSet_->disableKeySketch();
+
+  const int64_t estimatedPct =
+      std::min<int64_t>(100, 100 * *numDistinctKeys / numSketchInputRows_);
+  addRuntimeStat(
+      "estimatedNumDistinctKeys", RuntimeCounter(numDistinctKeys.value()));
+  addRuntimeStat(
+      "estimatedPartialAggregationPct", RuntimeCounter(estimatedPct));
+  if (estimatedPct >= abandonPartialAggregationMinPct_) {
+    sketchNonReducing_ = true;
+    partialFull_ = true;
+  }
+}
+
 void HashAggregation::addInput(RowVectorPtr input) {
   if (!pushdownChecked_) {
     mayPushdown_ = operatorCtx_->driver()->mayPushdownAggregation(this);
@@ -133,17 +162,36 @@ void HashAggregation::addInput(RowVectorPtr input) {
 
   updateRuntimeStats();
 
+  if (abandonPartialAggregationSketchRows_ > 0 && !sketchNonReducing_ &&
+      numSketchInputRows_ < abandonPartialAggregationSketchRows_) {
+    numSketchInputRows_ += input->size();
+    if (numSketchInputRows_ >= abandonPartialAggregationSketchRows_) {
+      checkKeySketch();
+    }
+  }
+
   // NOTE: we should not trigger partial output flush in case of global
   // aggregation as the final aggregator will handle it the same way as the
   // partial aggregator. Hence, we have to use more memory anyway.
   const bool abandonPartialEarly = isPartialOutput_ && !isGlobal_ &&
-      abandonPartialAggregationEarly(groupingSet_->numDistinct());
+      (sketchNonReducing_ ||
+       abandonPartialAggregationEarly(groupingSet_->numDistinct()));
   if (isPartialOutput_ && !isGlobal_ &&
       (abandonPartialEarly ||
        groupingSet_->isPartialFull(maxPartialAggregationMemoryUsage_))) {
     partialFull_ = true;
   }
 
+  if (clusteredFlushEnabled_ && clusteredInput_) {
+    clusteredInput_ = isLastInputClustered();
+    if (clusteredInput_ && !partialFull_ &&
+        groupingSet_->numDistinct() >=
+            outputBatchRows(estimatedOutputRowSize_)) {
+      partialFull_ = true;
+      clusteredFlush_ = true;
+    }
+  }
+
   if (isDistinct_) {
     newDistincts_ = !groupingSet_->hasSpilled() &&
         !groupingSet_->hashLookup().newGroups.empty();
@@ -158,6 +206,40 @@ void HashAggregation::addInput(RowVectorPtr input) {
       partialFull_ = false;
     }
   }
+
+  maybeReserveForNextInput(input);
+}
+
+bool HashAggregation::isLastInputClustered() {
+  const auto& lookup = groupingSet_->hashLookup();
+  // Each run of rows of the same group other than a run continuing
+  // 'lastGroup_' must have created its group.
+  size_t numRuns = 0;
+  for (auto row : lookup.rows) {
+    if (lookup.hits[row] != lastGroup_) {
+      lastGroup_ = lookup.hits[row];
+      ++numRuns;
+    }
+  }
+  return numRuns == lookup.newGroups.size();
+}
+
+void HashAggregation::maybeReserveForNextInput(const RowVectorPtr& input) {
+  if (partialFull_) {
+    return;
+  }
+  const auto bytes = groupingSet_->inputReservationBytes(input);
+  if (bytes > 0) {
+    reserveMemoryAsync(bytes, &memoryReservationFuture_);
+  }
+}
+
+BlockingReason HashAggregation::isBlocked(ContinueFuture* future) {
+  if (memoryReservationFuture_.valid()) {
+    *future = std::move(memoryReservationFuture_);
+    return BlockingReason::kWaitForMemory;
+  }
+  return BlockingReason::kNotBlocked;
 }
 
 void HashAggregation::updateRuntimeStats() {
@@ -188,6 +270,12 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats[BaseHashTable::kNumTombstones] =
       RuntimeMetric(hashTableStats.numTombstones);
+  if (groupingSet_->stringAllocatorCompactionEnabled()) {
+    runtimeStats[GroupingSet::kStringAllocatorFragmentationPct] =
+        RuntimeMetric(groupingSet_->stringAllocatorFragmentationPct());
+    runtimeStats[GroupingSet::kNumStringAllocatorCompactions] =
+        RuntimeMetric(groupingSet_->numStringAllocatorCompactions());
+  }
 }
 
 void HashAggregation::prepareOutput(vector_size_t size) {
@@ -215,12 +303,19 @@ void HashAggregation::resetPartialOutputIfNeed() {
     lockedStats->addRuntimeStat("flushTimes", RuntimeCounter(1));
     lockedStats->addRuntimeStat(
         "partialAggregationPct", RuntimeCounter(aggregationPct));
+    if (clusteredFlush_) {
+      lockedStats->addRuntimeStat("clusteredFlushTimes", RuntimeCounter(1));
+    }
   }
   groupingSet_->resetTable();
   partialFull_ = false;
-  if (!finished_) {
+  // A flush of clustered input is not because of the memory limit.
+  if (!finished_ && !clusteredFlush_) {
     maybeIncreasePartialAggregationMemoryUsage(aggregationPct);
   }
+  clusteredInput_ = true;
+  clusteredFlush_ = false;
+  lastGroup_ = nullptr;
   numOutputRows_ = 0;
   numInputRows_ = 0;
 }
@@ -232,7 +327,7 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
   VELOX_DCHECK(isPartialOutput_);
   // If size is at max and there still is not enough reduction, abandon partial
   // aggregation.
-  if (abandonPartialAggregationEarly(numOutputRows_) ||
+  if (sketchNonReducing_ || abandonPartialAggregationEarly(numOutputRows_) ||
       (aggregationPct > kPartialMinFinalPct &&
        maxPartialAggregationMemoryUsage_ >=
            maxExtendedPartialAggregationMemoryUsage_)) {
@@ -404,25 +499,28 @@ void HashAggregation::reclaim(
   updateEstimatedOutputRowSize();
 
   if (noMoreInput_) {
-    if (groupingSet_->hasSpilled()) {
+    if (groupingSet_->canSpillRestoredPartition()) {
+      // Spill the groups restored so far from a spilled partition together
+      // with the rest of the partition.
+      groupingSet_->spill();
+    } else if (groupingSet_->hasSpilled()) {
       LOG(WARNING)
           << "Can't reclaim from aggregation operator which has spilled and is under output processing, pool "
           << pool()->name()
           << ", memory usage: " << succinctBytes(pool()->currentBytes())
           << ", reservation: " << succinctBytes(pool()->reservedBytes());
       return;
-    }
-    if (isDistinct_) {
+    } else if (isDistinct_) {
       // Since we have seen all the input, we can safely reset the hash table.
       groupingSet_->resetTable();
       // Release the minimum reserved memory.
       pool()->release();
       return;
+    } else {
+      // Spill all the rows starting from the next output row pointed by
+      // 'resultIterator_'.
+      groupingSet_->spill(resultIterator_);
     }
-
-    // Spill all the rows starting from the next output row pointed by
-    // 'resultIterator_'.
-    groupingSet_->spill(resultIterator_);
   } else {
     // TODO: support fine-grain disk spilling based on 'targetBytes' after
     // having row container memory compaction support later.
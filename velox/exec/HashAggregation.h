@@ -39,9 +39,7 @@ class HashAggregation : public Operator {
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
@@ -70,10 +68,26 @@ class HashAggregation : public Operator {
   // 'abandonPartialAggregationMinPct_' % of rows are unique.
   bool abandonPartialAggregationEarly(int64_t numOutput) const;
 
+  // Invoked after 'abandonPartialAggregationSketchRows_' input rows to check
+  // the grouping key cardinality estimated by the key sketch of
+  // 'groupingSet_'. Sets 'sketchNonReducing_' and 'partialFull_' if more than
+  // 'abandonPartialAggregationMinPct_' % of rows are estimated to be unique.
+  void checkKeySketch();
+
+  // Returns true if the rows of each group of the last input are consecutive
+  // and no group other than the one of the first row existed before the
+  // input. Sets 'lastGroup_' to the group of the last row.
+  bool isLastInputClustered();
+
   RowVectorPtr getDistinctOutput();
 
   void updateEstimatedOutputRowSize();
 
+  // Invoked after 'input' is added to grow the memory reservation for the next
+  // input of about the same size off the driver thread if
+  // 'async_memory_reservation_enabled' is set.
+  void maybeReserveForNextInput(const RowVectorPtr& input);
+
   std::shared_ptr<const core::AggregationNode> aggregationNode_;
 
   const bool isPartialOutput_;
@@ -86,6 +100,13 @@ class HashAggregation : public Operator {
   // Min unique rows pct for partial aggregation. If more than this many rows
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
+  // Number of input rows to see before checking the key sketch of
+  // 'groupingSet_'. 0 if the key sketch is disabled.
+  const int32_t abandonPartialAggregationSketchRows_;
+
+  // True if partial aggregation flushes early on input clustered on the
+  // grouping keys.
+  const bool clusteredFlushEnabled_;
 
   int64_t maxPartialAggregationMemoryUsage_;
   std::unique_ptr<GroupingSet> groupingSet_;
@@ -100,6 +121,19 @@ class HashAggregation : public Operator {
   bool finished_ = false;
   // True if partial aggregation has been found to be non-reducing.
   bool abandonedPartialAggregation_{false};
+  // True if the key sketch has estimated partial aggregation to be
+  // non-reducing. Partial aggregation is abandoned on the next flush.
+  bool sketchNonReducing_{false};
+  // Count the number of input rows added to the key sketch. It is not reset on
+  // partial aggregation output flush.
+  int64_t numSketchInputRows_{0};
+  // True if all the input since the last partial aggregation flush was
+  // clustered on the grouping keys.
+  bool clusteredInput_{true};
+  // True if the pending flush is because of clustered input.
+  bool clusteredFlush_{false};
+  // Group of the last input row. Reset on partial aggregation output flush.
+  char* lastGroup_{nullptr};
 
   RowContainerIterator resultIterator_;
   bool pushdownChecked_ = false;
@@ -114,6 +148,10 @@ class HashAggregation : public Operator {
 
   // Possibly reusable output vector.
   RowVectorPtr output_;
+
+  // Completes when the memory reservation started by
+  // maybeReserveForNextInput() has finished.
+  ContinueFuture memoryReservationFuture_{ContinueFuture::makeEmpty()};
 };
 
 } // namespace facebook::velox::exec
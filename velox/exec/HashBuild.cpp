@@ -38,6 +38,8 @@ BlockingReason fromStateToBlockingReason(HashBuild::State state) {
     case HashBuild::State::kWaitForSpill:
       return BlockingReason::kWaitForSpill;
     case HashBuild::State::kWaitForBuild:
+      [[fallthrough]];
+    case HashBuild::State::kWaitForSharedTable:
       return BlockingReason::kWaitForJoinBuild;
     case HashBuild::State::kWaitForProbe:
       return BlockingReason::kWaitForJoinProbe;
@@ -45,6 +47,38 @@ BlockingReason fromStateToBlockingReason(HashBuild::State state) {
       VELOX_UNREACHABLE(HashBuild::stateName(state));
   }
 }
+
+template <typename T>
+void addIntegersToBloomFilter(
+    const BaseVector& keys,
+    BloomFilter<>& bloomFilter,
+    int64_t& min,
+    int64_t& max) {
+  const auto* flatKeys = keys.asUnchecked<FlatVector<T>>();
+  for (vector_size_t row = 0; row < keys.size(); ++row) {
+    if (flatKeys->isNullAt(row)) {
+      continue;
+    }
+    const int64_t value = flatKeys->valueAt(row);
+    bloomFilter.insert(common::BloomFilterValues::hashInt64(value));
+    min = std::min(min, value);
+    max = std::max(max, value);
+  }
+}
+
+void addStringsToBloomFilter(
+    const BaseVector& keys,
+    BloomFilter<>& bloomFilter) {
+  const auto* flatKeys = keys.asUnchecked<FlatVector<StringView>>();
+  for (vector_size_t row = 0; row < keys.size(); ++row) {
+    if (flatKeys->isNullAt(row)) {
+      continue;
+    }
+    const auto value = flatKeys->valueAt(row);
+    bloomFilter.insert(
+        common::BloomFilterValues::hashBytes(value.data(), value.size()));
+  }
+}
 } // namespace
 
 HashBuild::HashBuild(
@@ -73,6 +107,17 @@ HashBuild::HashBuild(
 
   joinBridge_->addBuilder();
 
+  // NOTE: the shared table is built for the whole task, so it does not apply
+  // to grouped execution where each split group builds its own table.
+  const auto& queryId = operatorCtx_->task()->queryCtx()->queryId();
+  if (joinNode_->sharedBuildTable() && !queryId.empty() &&
+      operatorCtx_->task()->isUngroupedExecution()) {
+    sharedTable_ = HashTableCache::instance()->get(
+        queryId, planNodeId(), operatorCtx_->taskId());
+    sharedTableBuilder_ =
+        sharedTable_->builderTaskId() == operatorCtx_->taskId();
+  }
+
   auto inputType = joinNode_->sources()[1]->outputType();
 
   const auto numKeys = joinNode_->rightKeys().size();
@@ -136,12 +181,18 @@ void HashBuild::setupTable() {
         VectorHasher::create(tableType_->childAt(i), keyChannels_[i]));
   }
 
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
   const auto numDependents = tableType_->size() - numKeys;
   std::vector<TypePtr> dependentTypes;
   dependentTypes.reserve(numDependents);
   for (int i = numKeys; i < tableType_->size(); ++i) {
     dependentTypes.emplace_back(tableType_->childAt(i));
   }
+  const auto columnarPayloadMinWidth =
+      queryConfig.rowContainerColumnarPayloadMinWidth();
+  const bool columnarDependents = columnarPayloadMinWidth > 0 &&
+      RowContainer::columnarDependentsWidth(dependentTypes) >=
+          columnarPayloadMinWidth;
   if (joinNode_->isRightJoin() || joinNode_->isFullJoin() ||
       joinNode_->isRightSemiProjectJoin()) {
     // Do not ignore null keys.
@@ -153,7 +204,8 @@ void HashBuild::setupTable() {
         operatorCtx_->driverCtx()
             ->queryConfig()
             .minTableRowsForParallelJoinBuild(),
-        pool());
+        pool(),
+        columnarDependents);
   } else {
     // (Left) semi and anti join with no extra filter only needs to know whether
     // there is a match. Hence, no need to store entries with duplicate keys.
@@ -173,7 +225,8 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          pool(),
+          columnarDependents);
     } else {
       // Ignore null keys
       table_ = HashTable<true>::createForJoin(
@@ -184,9 +237,14 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          pool(),
+          columnarDependents);
     }
   }
+  table_->setMinTableBytesForPartitionedProbe(
+      operatorCtx_->driverCtx()
+          ->queryConfig()
+          .hashProbePartitionedProbeMinTableSize());
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
 }
 
@@ -313,6 +371,9 @@ void HashBuild::removeInputRowsForAntiJoinFilter() {
 
 void HashBuild::addInput(RowVectorPtr input) {
   checkRunning();
+  if (usesSharedTableOfOtherTask()) {
+    return;
+  }
   ensureInputFits(input);
 
   TestValue::adjust("facebook::velox::exec::HashBuild::addInput", this);
@@ -636,9 +697,37 @@ void HashBuild::noMoreInputInternal() {
     return;
   }
 
+  if (sharedTableBuilder_) {
+    shareBuildResult();
+  }
   postHashBuildProcess();
 }
 
+bool HashBuild::setSharedBuildResult() {
+  VELOX_CHECK(usesSharedTableOfOtherTask());
+  auto buildResult = sharedTable_->buildResultOrFuture(&future_);
+  if (!buildResult.has_value()) {
+    VELOX_CHECK(future_.valid());
+    setState(State::kWaitForSharedTable);
+    return false;
+  }
+  sharedTable_.reset();
+  joinBridge_->setSharedBuildResult(std::move(buildResult.value()));
+  stats_.wlock()->addRuntimeStat(kSharedTableAttached, RuntimeCounter(1));
+  return true;
+}
+
+void HashBuild::shareBuildResult() {
+  VELOX_CHECK(sharedTableBuilder_);
+  VELOX_CHECK_NOT_NULL(sharedTable_);
+  ContinueFuture future;
+  auto buildResult = joinBridge_->tableOrFuture(&future);
+  VELOX_CHECK(buildResult.has_value());
+  sharedTable_->setBuildResult(
+      operatorCtx_->task(), std::move(buildResult.value()));
+  sharedTable_.reset();
+}
+
 bool HashBuild::finishHashBuild() {
   checkRunning();
 
@@ -655,6 +744,8 @@ bool HashBuild::finishHashBuild() {
   // build pipeline.
   if (!operatorCtx_->task()->allPeersFinished(
           planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    // Only the last driver shares or receives the shared build result.
+    sharedTable_.reset();
     setState(State::kWaitForBuild);
     return false;
   }
@@ -670,6 +761,10 @@ bool HashBuild::finishHashBuild() {
     }
   });
 
+  if (usesSharedTableOfOtherTask()) {
+    return setSharedBuildResult();
+  }
+
   if (joinHasNullKeys_ && isAntiJoin(joinType_) && nullAware_ &&
       !joinNode_->filter()) {
     joinBridge_->setAntiJoinHasNullKeys();
@@ -738,6 +833,7 @@ bool HashBuild::finishHashBuild() {
   const bool allowParallelJoinBuild =
       !otherTables.empty() && spillPartitions.empty();
   CpuWallTiming timing;
+  std::vector<std::shared_ptr<const common::BloomFilterValues>> keyBloomFilters;
   {
     CpuWallTimer cpuWallTimer{timing};
     table_->prepareJoinTable(
@@ -746,6 +842,16 @@ bool HashBuild::finishHashBuild() {
                                : nullptr,
         isInputFromSpill() ? spillConfig()->startPartitionBit
                            : BaseHashTable::kNoSpillInputStartPartitionBit);
+    // The filters must cover all the build rows, so they are not made if part
+    // of the build side is spilled or restored from spill.
+    if (!isInputFromSpill() && spillPartitions.empty()) {
+      keyBloomFilters = makeKeyBloomFilters();
+    }
+    const auto heavyHitterMinPct =
+        operatorCtx_->driverCtx()->queryConfig().hashBuildHeavyHitterMinPct();
+    if (heavyHitterMinPct > 0) {
+      table_->computeJoinKeySkew(heavyHitterMinPct);
+    }
   }
   stats_.wlock()->addRuntimeStat(
       BaseHashTable::kBuildWallNanos,
@@ -753,7 +859,10 @@ bool HashBuild::finishHashBuild() {
 
   addRuntimeStats();
   joinBridge_->setHashTable(
-      std::move(table_), std::move(spillPartitions), joinHasNullKeys_);
+      std::move(table_),
+      std::move(spillPartitions),
+      joinHasNullKeys_,
+      std::move(keyBloomFilters));
   if (spillEnabled()) {
     stateCleared_ = true;
   }
@@ -901,6 +1010,113 @@ void HashBuild::processSpillInput() {
   noMoreInputInternal();
 }
 
+std::vector<std::shared_ptr<const common::BloomFilterValues>>
+HashBuild::makeKeyBloomFilters() const {
+  const auto maxSize = operatorCtx_->driverCtx()
+                           ->queryConfig()
+                           .hashProbeBloomFilterPushdownMaxSize();
+  // Same join types for which HashProbe pushes down dynamic filters.
+  if (maxSize == 0 ||
+      !(isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
+        isRightSemiFilterJoin(joinType_) ||
+        isRightSemiProjectJoin(joinType_))) {
+    return {};
+  }
+  const uint64_t capacity = table_->numDistinct();
+  // BloomFilter::reset() allocates 2 bytes per entry of 'capacity' rounded up
+  // to a power of 2.
+  if (capacity == 0 || capacity > std::numeric_limits<int32_t>::max() ||
+      bits::nextPowerOfTwo(capacity) * 2 > maxSize) {
+    return {};
+  }
+
+  const auto& hashers = table_->hashers();
+  const bool hashMode = table_->hashMode() == BaseHashTable::HashMode::kHash;
+  std::vector<std::shared_ptr<BloomFilter<>>> bloomFilters(hashers.size());
+  bool hasBloomFilter = false;
+  for (auto i = 0; i < hashers.size(); ++i) {
+    // HashProbe pushes down an IN-list filter if the hasher can make one.
+    if (!hashMode && hashers[i]->hasFilter()) {
+      continue;
+    }
+    switch (hashers[i]->typeKind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        bloomFilters[i] = std::make_shared<BloomFilter<>>();
+        bloomFilters[i]->reset(capacity);
+        hasBloomFilter = true;
+        break;
+      default:
+        break;
+    }
+  }
+  if (!hasBloomFilter) {
+    return {};
+  }
+
+  // Insert the keys of all the rows including the ones in the tables merged
+  // from the other build drivers.
+  constexpr int32_t kBatchSize = 1'024;
+  std::vector<char*> rows(kBatchSize);
+  std::vector<int64_t> mins(
+      hashers.size(), std::numeric_limits<int64_t>::max());
+  std::vector<int64_t> maxs(
+      hashers.size(), std::numeric_limits<int64_t>::min());
+  BaseHashTable::RowsIterator iter;
+  while (const auto numRows = table_->listAllRows(
+             &iter, kBatchSize, RowContainer::kUnlimited, rows.data())) {
+    for (auto i = 0; i < hashers.size(); ++i) {
+      if (bloomFilters[i] == nullptr) {
+        continue;
+      }
+      auto keys = BaseVector::create(hashers[i]->type(), numRows, pool());
+      table_->rows()->extractColumn(rows.data(), numRows, i, keys);
+      switch (hashers[i]->typeKind()) {
+        case TypeKind::TINYINT:
+          addIntegersToBloomFilter<int8_t>(
+              *keys, *bloomFilters[i], mins[i], maxs[i]);
+          break;
+        case TypeKind::SMALLINT:
+          addIntegersToBloomFilter<int16_t>(
+              *keys, *bloomFilters[i], mins[i], maxs[i]);
+          break;
+        case TypeKind::INTEGER:
+          addIntegersToBloomFilter<int32_t>(
+              *keys, *bloomFilters[i], mins[i], maxs[i]);
+          break;
+        case TypeKind::BIGINT:
+          addIntegersToBloomFilter<int64_t>(
+              *keys, *bloomFilters[i], mins[i], maxs[i]);
+          break;
+        default:
+          addStringsToBloomFilter(*keys, *bloomFilters[i]);
+          break;
+      }
+    }
+  }
+
+  std::vector<std::shared_ptr<const common::BloomFilterValues>> result(
+      hashers.size());
+  for (auto i = 0; i < hashers.size(); ++i) {
+    if (bloomFilters[i] == nullptr) {
+      continue;
+    }
+    if (hashers[i]->typeKind() == TypeKind::VARCHAR ||
+        hashers[i]->typeKind() == TypeKind::VARBINARY) {
+      result[i] = std::make_shared<common::BloomFilterValues>(
+          std::move(bloomFilters[i]), false);
+    } else if (mins[i] <= maxs[i]) {
+      result[i] = std::make_shared<common::BloomFilterValues>(
+          std::move(bloomFilters[i]), false, mins[i], maxs[i]);
+    }
+  }
+  return result;
+}
+
 void HashBuild::addRuntimeStats() {
   // Report range sizes and number of distinct values for the join keys.
   const auto& hashers = table_->hashers();
@@ -932,6 +1148,17 @@ void HashBuild::addRuntimeStats() {
     lockedStats->runtimeStats[BaseHashTable::kNumTombstones] =
         RuntimeMetric(hashTableStats.numTombstones);
   }
+  const auto& skewStats = table_->joinKeySkewStats();
+  if (skewStats.numDuplicateKeys != 0) {
+    lockedStats->addRuntimeStat(
+        BaseHashTable::kMaxRowsPerKey, RuntimeCounter(skewStats.maxRowsPerKey));
+    lockedStats->addRuntimeStat(
+        BaseHashTable::kNumHeavyHitterKeys,
+        RuntimeCounter(skewStats.numHeavyHitterKeys));
+    lockedStats->addRuntimeStat(
+        BaseHashTable::kNumHeavyHitterRows,
+        RuntimeCounter(skewStats.numHeavyHitterRows));
+  }
 
   // Add max spilling level stats if spilling has been triggered.
   if (spiller_ != nullptr && spiller_->isAnySpilled()) {
@@ -971,6 +1198,14 @@ BlockingReason HashBuild::isBlocked(ContinueFuture* future) {
         postHashBuildProcess();
       }
       break;
+    case State::kWaitForSharedTable:
+      if (!future_.valid()) {
+        setRunning();
+        if (setSharedBuildResult()) {
+          postHashBuildProcess();
+        }
+      }
+      break;
     default:
       VELOX_UNREACHABLE("Unexpected state: {}", stateName(state_));
       break;
@@ -1008,7 +1243,10 @@ void HashBuild::checkStateTransition(State state) {
   switch (state) {
     case State::kRunning:
       if (!spillEnabled()) {
-        VELOX_CHECK_EQ(state_, State::kWaitForBuild);
+        VELOX_CHECK(
+            state_ == State::kWaitForBuild ||
+                state_ == State::kWaitForSharedTable,
+            stateName(state_));
       } else {
         VELOX_CHECK_NE(state_, State::kFinish);
       }
@@ -1019,6 +1257,8 @@ void HashBuild::checkStateTransition(State state) {
       [[fallthrough]];
     case State::kWaitForProbe:
       [[fallthrough]];
+    case State::kWaitForSharedTable:
+      [[fallthrough]];
     case State::kFinish:
       VELOX_CHECK_EQ(state_, State::kRunning);
       break;
@@ -1040,6 +1280,8 @@ std::string HashBuild::stateName(State state) {
       return "WAIT_FOR_BUILD";
     case State::kWaitForProbe:
       return "WAIT_FOR_PROBE";
+    case State::kWaitForSharedTable:
+      return "WAIT_FOR_SHARED_TABLE";
     case State::kFinish:
       return "FINISH";
     default:
@@ -1180,5 +1422,14 @@ void HashBuild::close() {
     spiller_.reset();
     table_.reset();
   }
+
+  // Unblocks the other tasks of the query if this task stops before sharing
+  // the hash table it builds.
+  if (sharedTable_ != nullptr) {
+    if (sharedTableBuilder_) {
+      sharedTable_->abandon();
+    }
+    sharedTable_.reset();
+  }
 }
 } // namespace facebook::velox::exec
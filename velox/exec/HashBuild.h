@@ -17,6 +17,7 @@
 
 #include "velox/exec/HashJoinBridge.h"
 #include "velox/exec/HashTable.h"
+#include "velox/exec/HashTableCache.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Spill.h"
 #include "velox/exec/Spiller.h"
@@ -55,9 +56,17 @@ class HashBuild final : public Operator {
     kWaitForProbe = 5,
     /// The finishing state.
     kFinish = 6,
+    /// The state that waits for another task of the query to build the shared
+    /// hash table. This state only applies if the join has a shared build
+    /// table and this task is not the one building it.
+    kWaitForSharedTable = 7,
   };
   static std::string stateName(State state);
 
+  /// Runtime stat set to 1 by the task which probes a shared hash table built
+  /// by another task of the query.
+  static inline const std::string kSharedTableAttached{"sharedTableAttached"};
+
   HashBuild(
       int32_t operatorId,
       DriverCtx* driverCtx,
@@ -204,10 +213,34 @@ class HashBuild final : public Operator {
 
   void addRuntimeStats();
 
+  // Invoked by the last build driver after the join table is built to make
+  // Bloom filters of the join key values which are pushed down into the probe
+  // side table scan by HashProbe. Returns an empty vector if the Bloom filter
+  // pushdown is disabled or not applicable to this join. A key has a nullptr
+  // entry if its type is not supported or if the probe side can use an
+  // IN-list filter instead.
+  std::vector<std::shared_ptr<const common::BloomFilterValues>>
+  makeKeyBloomFilters() const;
+
   // Indicates if this hash build operator is under non-reclaimable state or
   // not.
   bool nonReclaimableState() const;
 
+  // Returns true if another task of the query builds the shared hash table
+  // for this join. This operator then discards its input.
+  bool usesSharedTableOfOtherTask() const {
+    return sharedTable_ != nullptr && !sharedTableBuilder_;
+  }
+
+  // Invoked by the last build driver of a task which does not build the
+  // shared hash table to hand the shared build result over to the probe side.
+  // Returns false and sets 'future_' if the result is not ready.
+  bool setSharedBuildResult();
+
+  // Invoked by the last build driver of the task that builds the shared hash
+  // table to share the build result with the other tasks.
+  void shareBuildResult();
+
   const std::shared_ptr<const core::HashJoinNode> joinNode_;
 
   const core::JoinType joinType_;
@@ -223,6 +256,14 @@ class HashBuild final : public Operator {
 
   std::shared_ptr<HashJoinBridge> joinBridge_;
 
+  // Set if the join has a shared build table, see
+  // core::HashJoinNode::sharedBuildTable(). Released once the build result has
+  // been shared or received.
+  std::shared_ptr<HashTableCache::Entry> sharedTable_;
+
+  // True if this task builds the shared hash table.
+  bool sharedTableBuilder_{false};
+
   bool exceededMaxSpillLevelLimit_{false};
 
   State state_{State::kRunning};
@@ -36,7 +36,9 @@ void HashJoinBridge::addBuilder() {
 void HashJoinBridge::setHashTable(
     std::unique_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
-    bool hasNullKeys) {
+    bool hasNullKeys,
+    std::vector<std::shared_ptr<const common::BloomFilterValues>>
+        keyBloomFilters) {
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
 
   auto spillPartitionIdSet = toSpillPartitionIdSet(spillPartitionSet);
@@ -65,7 +67,8 @@ void HashJoinBridge::setHashTable(
         std::move(table),
         std::move(restoringSpillPartitionId_),
         std::move(spillPartitionIdSet),
-        hasNullKeys);
+        hasNullKeys,
+        std::move(keyBloomFilters));
     restoringSpillPartitionId_.reset();
     promises = std::move(promises_);
   }
@@ -105,6 +108,22 @@ void HashJoinBridge::setAntiJoinHasNullKeys() {
   notify(std::move(promises));
 }
 
+void HashJoinBridge::setSharedBuildResult(HashBuildResult buildResult) {
+  VELOX_CHECK(buildResult.spillPartitionIds.empty());
+  VELOX_CHECK(!buildResult.restoredPartitionId.has_value());
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(started_);
+    VELOX_CHECK(!buildResult_.has_value());
+    VELOX_CHECK(spillPartitionSets_.empty());
+
+    buildResult_ = std::move(buildResult);
+    promises = std::move(promises_);
+  }
+  notify(std::move(promises));
+}
+
 std::optional<HashJoinBridge::HashBuildResult> HashJoinBridge::tableOrFuture(
     ContinueFuture* future) {
   std::lock_guard<std::mutex> l(mutex_);
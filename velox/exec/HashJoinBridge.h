@@ -19,6 +19,7 @@
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/Spill.h"
+#include "velox/type/Filter.h"
 
 namespace facebook::velox::exec {
 
@@ -42,10 +43,14 @@ class HashJoinBridge : public JoinBridge {
   /// Invoked by the build operator to set the built hash table.
   /// 'spillPartitionSet' contains the spilled partitions while building
   /// 'table' which only applies if the disk spilling is enabled.
+  /// 'keyBloomFilters' contains optional Bloom filters of the values of each
+  /// join key for dynamic filter pushdown on the probe side.
   void setHashTable(
       std::unique_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
-      bool hasNullKeys);
+      bool hasNullKeys,
+      std::vector<std::shared_ptr<const common::BloomFilterValues>>
+          keyBloomFilters = {});
 
   /// Invoked by the probe operator to set the spilled hash table while the
   /// probing. The function puts the spilled table partitions into
@@ -66,11 +71,14 @@ class HashJoinBridge : public JoinBridge {
         std::shared_ptr<BaseHashTable> _table,
         std::optional<SpillPartitionId> _restoredPartitionId,
         SpillPartitionIdSet _spillPartitionIds,
-        bool _hasNullKeys)
+        bool _hasNullKeys,
+        std::vector<std::shared_ptr<const common::BloomFilterValues>>
+            _keyBloomFilters = {})
         : hasNullKeys(_hasNullKeys),
           table(std::move(_table)),
           restoredPartitionId(std::move(_restoredPartitionId)),
-          spillPartitionIds(std::move(_spillPartitionIds)) {}
+          spillPartitionIds(std::move(_spillPartitionIds)),
+          keyBloomFilters(std::move(_keyBloomFilters)) {}
 
     HashBuildResult() : hasNullKeys(true) {}
 
@@ -78,8 +86,17 @@ class HashJoinBridge : public JoinBridge {
     std::shared_ptr<BaseHashTable> table;
     std::optional<SpillPartitionId> restoredPartitionId;
     SpillPartitionIdSet spillPartitionIds;
+    /// Bloom filters of the join key values indexed by key. Empty or nullptr
+    /// for a key if no Bloom filter was built.
+    std::vector<std::shared_ptr<const common::BloomFilterValues>>
+        keyBloomFilters;
   };
 
+  /// Invoked by the build operator to set the build result of another task
+  /// of the query that shares its hash table with this task. See
+  /// HashTableCache.
+  void setSharedBuildResult(HashBuildResult buildResult);
+
   /// Invoked by HashProbe operator to get the table to probe which is built by
   /// HashBuild operators. If HashProbe operator calls this early, 'future' will
   /// be set to wait asynchronously, otherwise the built table along with
@@ -23,6 +23,9 @@ HashPartitionFunction::HashPartitionFunction(
     const std::vector<column_index_t>& keyChannels,
     const std::vector<VectorPtr>& constValues)
     : numPartitions_{numPartitions} {
+  if (numPartitions_ > 0) {
+    modulo_.emplace(numPartitions_);
+  }
   init(inputType, keyChannels, constValues);
 }
 
@@ -85,7 +88,7 @@ std::optional<uint32_t> HashPartitionFunction::partition(
     }
   } else {
     for (auto i = 0; i < size; ++i) {
-      partitions[i] = hashes_[i] % numPartitions_;
+      partitions[i] = (*modulo_)(hashes_[i]);
     }
   }
 
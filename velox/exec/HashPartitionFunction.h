@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <velox/common/base/FastModulo.h>
 #include <velox/exec/HashBitRange.h>
 #include <velox/exec/VectorHasher.h>
 #include "velox/core/PlanNode.h"
@@ -59,6 +60,8 @@ class HashPartitionFunction : public core::PartitionFunction {
 
   const int numPartitions_;
   const std::optional<HashBitRange> hashBitRange_ = std::nullopt;
+  // Computes 'hash % numPartitions_' if 'hashBitRange_' is not set.
+  std::optional<FastModulo> modulo_;
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
 
   // Reusable memory.
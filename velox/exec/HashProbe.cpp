@@ -83,6 +83,82 @@ void extractColumns(
   }
 }
 
+// Extracts a build side column for the rows of a probe output batch when the
+// lazy vector of the column is loaded. Owns a copy of the build row pointers
+// of the batch and keeps the table alive.
+class BuildColumnLoader : public VectorLoader {
+ public:
+  BuildColumnLoader(
+      std::shared_ptr<BaseHashTable> table,
+      std::shared_ptr<const std::vector<char*>> rows,
+      column_index_t column,
+      TypePtr type,
+      memory::MemoryPool* pool)
+      : table_(std::move(table)),
+        rows_(std::move(rows)),
+        column_(column),
+        type_(std::move(type)),
+        pool_(pool) {}
+
+  void loadInternal(
+      RowSet rowSet,
+      ValueHook* hook,
+      vector_size_t resultSize,
+      VectorPtr* result) override {
+    VELOX_CHECK(!hook, "BuildColumnLoader doesn't support ValueHook");
+    VELOX_CHECK_LE(resultSize, rows_->size());
+    const char* const* rows = rows_->data();
+    std::vector<char*> loadRows;
+    if (rowSet.size() < resultSize) {
+      // Extracts nulls for the rows not loaded to skip reading their values.
+      loadRows.resize(resultSize, nullptr);
+      for (auto row : rowSet) {
+        loadRows[row] = (*rows_)[row];
+      }
+      rows = loadRows.data();
+    }
+    auto& child = *result;
+    if (!child || !BaseVector::isVectorWritable(child) ||
+        !child->isFlatEncoding()) {
+      child = BaseVector::create(type_, resultSize, pool_);
+    }
+    child->resize(resultSize);
+    table_->rows()->extractColumn(rows, resultSize, column_, child);
+  }
+
+ private:
+  const std::shared_ptr<BaseHashTable> table_;
+  const std::shared_ptr<const std::vector<char*>> rows_;
+  const column_index_t column_;
+  const TypePtr type_;
+  memory::MemoryPool* const pool_;
+};
+
+// Sets the 'projections' of 'result' to lazy vectors extracting the values of
+// 'rows' of 'table' on first access.
+void makeLazyColumns(
+    const std::shared_ptr<BaseHashTable>& table,
+    folly::Range<char**> rows,
+    folly::Range<const IdentityProjection*> projections,
+    memory::MemoryPool* pool,
+    const std::vector<TypePtr>& resultTypes,
+    std::vector<VectorPtr>& resultVectors) {
+  VELOX_CHECK_EQ(resultTypes.size(), resultVectors.size());
+  auto lazyRows =
+      std::make_shared<const std::vector<char*>>(rows.begin(), rows.end());
+  for (auto projection : projections) {
+    const auto resultChannel = projection.outputChannel;
+    VELOX_CHECK_LT(resultChannel, resultVectors.size());
+    const auto& type = resultTypes[resultChannel];
+    resultVectors[resultChannel] = std::make_shared<LazyVector>(
+        pool,
+        type,
+        rows.size(),
+        std::make_unique<BuildColumnLoader>(
+            table, lazyRows, projection.inputChannel, type, pool));
+  }
+}
+
 BlockingReason fromStateToBlockingReason(ProbeOperatorState state) {
   switch (state) {
     case ProbeOperatorState::kRunning:
@@ -183,6 +259,11 @@ void HashProbe::initialize() {
   if (nullAware_) {
     filterTableResult_.resize(1);
   }
+
+  // The lazy build columns reference the table rows which are freed when the
+  // table is spilled.
+  lazyBuildColumns_ = !tableOutputProjections_.empty() && !canSpill() &&
+      operatorCtx_->driverCtx()->queryConfig().hashProbeLazyBuildColumns();
 }
 
 void HashProbe::initializeFilter(
@@ -329,8 +410,9 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      (table_->hashMode() != BaseHashTable::HashMode::kHash ||
+       !hashBuildResult->keyBloomFilters.empty()) &&
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept dynamic
     // filters on all or a subset of the join keys. Create dynamic filters to
     // push down.
@@ -339,7 +421,13 @@ void HashProbe::asyncWaitForHashTable() {
     // probe input is read from spilled data and there is no upstream operators
     // involved; (2) if there is spill data to restore, then we can't filter
     // probe inputs solely based on the current table's join keys.
+    //
+    // The keys that have too many distinct values for an IN-list filter use a
+    // Bloom filter if the build side has made one.
     const auto& buildHashers = table_->hashers();
+    const auto& keyBloomFilters = hashBuildResult->keyBloomFilters;
+    const bool hashMode =
+        table_->hashMode() == BaseHashTable::HashMode::kHash;
     const auto channels = operatorCtx_->driverCtx()->driver->canPushdownFilters(
         this, keyChannels_);
 
@@ -348,10 +436,25 @@ void HashProbe::asyncWaitForHashTable() {
     const auto nullAllowed = isRightSemiProjectJoin(joinType_) && nullAware_;
 
     for (auto i = 0; i < keyChannels_.size(); ++i) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(nullAllowed)) {
-          dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
-        }
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      std::shared_ptr<common::Filter> filter;
+      if (!hashMode) {
+        filter = buildHashers[i]->getFilter(nullAllowed);
+      }
+      if (filter == nullptr && i < keyBloomFilters.size() &&
+          keyBloomFilters[i] != nullptr) {
+        // Each probe driver pushes down its own copy sharing the bits of the
+        // Bloom filter, so that its table scan reports its own stats.
+        filter = std::make_shared<common::BloomFilterValues>(
+            keyBloomFilters[i]->bloomFilter(),
+            nullAllowed,
+            keyBloomFilters[i]->min(),
+            keyBloomFilters[i]->max());
+      }
+      if (filter != nullptr) {
+        dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
       }
     }
     hasGeneratedDynamicFilters_ = !dynamicFilters_.empty();
@@ -533,9 +636,12 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down filter when the
   // following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the pushed down filter is exact, i.e. not a Bloom filter.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      dynamicFilters_.begin()->second->kind() !=
+          common::FilterKind::kBloomFilter) {
     canReplaceWithDynamicFilter_ = true;
   }
 
@@ -741,6 +847,14 @@ void HashProbe::fillOutput(vector_size_t size) {
 
   if (isLeftSemiProjectJoin(joinType_)) {
     fillLeftSemiProjectMatchColumn(size);
+  } else if (lazyBuildColumns_) {
+    makeLazyColumns(
+        table_,
+        folly::Range<char**>(outputTableRows_.data(), size),
+        tableOutputProjections_,
+        pool(),
+        outputType_->children(),
+        output_->children());
   } else {
     extractColumns(
         table_.get(),
@@ -353,6 +353,10 @@ class HashProbe : public Operator {
   // pipeline.
   std::shared_ptr<BaseHashTable> table_;
 
+  // True if the build side output columns are returned as lazy vectors, see
+  // core::QueryConfig::kHashProbeLazyBuildColumns.
+  bool lazyBuildColumns_{false};
+
   // Indicates whether there was no input. Used for right semi join project.
   bool noInput_{true};
 
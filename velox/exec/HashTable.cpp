@@ -53,7 +53,8 @@ HashTable<ignoreNullKeys>::HashTable(
     bool hasProbedFlag,
     uint32_t minTableSizeForParallelJoinBuild,
     memory::MemoryPool* pool,
-    const std::shared_ptr<velox::HashStringAllocator>& stringArena)
+    const std::shared_ptr<velox::HashStringAllocator>& stringArena,
+    bool columnarDependents)
     : BaseHashTable(std::move(hashers)),
       minTableSizeForParallelJoinBuild_(minTableSizeForParallelJoinBuild),
       isJoinBuild_(isJoinBuild) {
@@ -75,7 +76,8 @@ HashTable<ignoreNullKeys>::HashTable(
       hasProbedFlag,
       hashMode_ != HashMode::kHash,
       pool,
-      stringArena);
+      stringArena,
+      columnarDependents);
   nextOffset_ = rows_->nextOffset();
 }
 
@@ -596,9 +598,75 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
     joinNormalizedKeyProbe(lookup);
     return;
   }
+  const auto partitionBits = partitionedProbeBits(lookup.rows.size());
+  if (partitionBits > 0) {
+    partitionedJoinProbe(lookup, partitionBits);
+    return;
+  }
+  hashJoinProbe(lookup, lookup.rows.data(), lookup.rows.size());
+}
+
+template <bool ignoreNullKeys>
+int32_t HashTable<ignoreNullKeys>::partitionedProbeBits(
+    int32_t numProbes) const {
+  if (minTableBytesForPartitionedProbe_ == 0) {
+    return 0;
+  }
+  const uint64_t tableBytes = sizeMask_ + 1;
+  if (tableBytes < minTableBytesForPartitionedProbe_ ||
+      tableBytes <= kPartitionedProbeChunkBytes ||
+      numProbes < 2 * kMinPartitionedProbeRowsPerPartition) {
+    return 0;
+  }
+  // Both the table size and the chunk size are powers of 2.
+  const int32_t tableBits =
+      sizeBits_ - __builtin_ctzll(kPartitionedProbeChunkBytes);
+  const int32_t rowBits =
+      63 - __builtin_clzll(numProbes / kMinPartitionedProbeRowsPerPartition);
+  return std::min({tableBits, rowBits, kMaxPartitionedProbeBits});
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::partitionedJoinProbe(
+    HashLookup& lookup,
+    int32_t partitionBits) {
+  const int32_t numProbes = lookup.rows.size();
+  const int32_t numPartitions = 1 << partitionBits;
+  const int32_t shift = sizeBits_ - partitionBits;
+  const auto* hashes = lookup.hashes.data();
+  const auto* rows = lookup.rows.data();
+
+  // Counting sort of the probe rows by the high bits of their bucket offset.
+  // Each partition then covers a contiguous range of the table that fits in
+  // cache, which is the same layout as the ranges built by the parallel join
+  // build.
+  auto& partitionStarts = lookup.partitionStarts;
+  partitionStarts.resize(numPartitions + 1);
+  std::fill(partitionStarts.begin(), partitionStarts.end(), 0);
+  for (auto i = 0; i < numProbes; ++i) {
+    ++partitionStarts[(bucketOffset(hashes[rows[i]]) >> shift) + 1];
+  }
+  for (auto i = 1; i <= numPartitions; ++i) {
+    partitionStarts[i] += partitionStarts[i - 1];
+  }
+  auto& partitionedRows = lookup.partitionedRows;
+  partitionedRows.resize(numProbes);
+  for (auto i = 0; i < numProbes; ++i) {
+    const auto row = rows[i];
+    partitionedRows[partitionStarts[bucketOffset(hashes[row]) >> shift]++] =
+        row;
+  }
+  // The hits are indexed by row number, so the order of probing does not
+  // change the result.
+  hashJoinProbe(lookup, partitionedRows.data(), numProbes);
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::hashJoinProbe(
+    HashLookup& lookup,
+    const vector_size_t* rows,
+    int32_t numProbes) {
   int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
   ProbeState state1;
   ProbeState state2;
   ProbeState state3;
@@ -722,7 +790,13 @@ void HashTable<ignoreNullKeys>::allocateTables(uint64_t size) {
       memory::AllocationTraits::numPages(size * tableSlotSize());
   rows_->pool()->allocateContiguous(numPages, tableAllocation_);
   table_ = tableAllocation_.data<char*>();
-  memset(table_, 0, capacity_ * sizeof(char*));
+  // A parallel join build zeroes each partition of the table in the thread
+  // that builds it. The pages of a fresh mapping are placed on first touch, so
+  // this spreads the table over the memory nodes of the build threads instead
+  // of the node of the thread that allocates it.
+  if (numDistinct_ == 0 || !canApplyParallelJoinBuild()) {
+    memset(table_, 0, capacity_ * sizeof(char*));
+  }
 }
 
 template <bool ignoreNullKeys>
@@ -1044,6 +1118,11 @@ void HashTable<ignoreNullKeys>::buildJoinPartition(
       overflow};
   auto rowContainer =
       (partition == 0 ? this : otherTables_[partition - 1].get())->rows();
+  // The table is not zeroed by allocateTables() for a parallel build.
+  ::memset(
+      reinterpret_cast<char*>(table_) + partitionInfo.start,
+      0,
+      partitionInfo.end - partitionInfo.start);
   for (auto i = 0; i < numPartitions; ++i) {
     auto* table = i == 0 ? this : otherTables_[i - 1].get();
     RowContainerIterator iter;
@@ -2087,6 +2166,51 @@ void BaseHashTable::prepareForGroupProbe(
   populateLookupRows(rows, lookup.rows);
 }
 
+void BaseHashTable::computeJoinKeySkew(int32_t minHeavyHitterPct) {
+  VELOX_CHECK_GT(minHeavyHitterPct, 0);
+  joinKeySkewStats_ = {};
+  heavyHitters_.clear();
+  if (!hasDuplicateKeys()) {
+    return;
+  }
+
+  const auto containers = allRows();
+  int64_t numRows{0};
+  for (const auto* container : containers) {
+    numRows += container->numRows();
+  }
+  // A heavy hitter has at least two rows.
+  const int64_t minHeavyHitterRows =
+      std::max<int64_t>(2, numRows * minHeavyHitterPct / 100);
+
+  // The rows of a key share a NextRowVector which starts with the first row
+  // of the key. Counts each key once at its first row.
+  constexpr int32_t kBatchSize = 1'024;
+  std::vector<char*> rows(kBatchSize);
+  for (auto* container : containers) {
+    RowContainerIterator iter;
+    int32_t numListed;
+    while ((numListed = container->listRows(&iter, kBatchSize, rows.data())) >
+           0) {
+      for (auto i = 0; i < numListed; ++i) {
+        const auto* keyRows = container->getNextRowVector(rows[i]);
+        if (keyRows == nullptr || keyRows->front() != rows[i]) {
+          continue;
+        }
+        const int64_t numKeyRows = keyRows->size();
+        ++joinKeySkewStats_.numDuplicateKeys;
+        joinKeySkewStats_.maxRowsPerKey =
+            std::max(joinKeySkewStats_.maxRowsPerKey, numKeyRows);
+        if (numKeyRows >= minHeavyHitterRows) {
+          ++joinKeySkewStats_.numHeavyHitterKeys;
+          joinKeySkewStats_.numHeavyHitterRows += numKeyRows;
+          heavyHitters_.push_back(rows[i]);
+        }
+      }
+    }
+  }
+}
+
 void BaseHashTable::prepareForJoinProbe(
     HashLookup& lookup,
     const RowVectorPtr& input,
@@ -95,6 +95,11 @@ struct HashLookup {
   /// If using valueIds, list of concatenated valueIds. 1:1 with 'hashes'.
   /// Populated by groupProbe and joinProbe.
   raw_vector<uint64_t> normalizedKeys;
+
+  /// Scratch memory used by the partitioned joinProbe. Row numbers from
+  /// 'rows' grouped by partition and the end offset of each partition.
+  raw_vector<vector_size_t> partitionedRows;
+  raw_vector<int32_t> partitionStarts;
 };
 
 struct HashTableStats {
@@ -105,6 +110,18 @@ struct HashTableStats {
   int64_t numTombstones{0};
 };
 
+/// Skew of the build rows across the keys of a hash join table, see
+/// BaseHashTable::computeJoinKeySkew().
+struct JoinKeySkewStats {
+  /// Number of keys with more than one build row.
+  int64_t numDuplicateKeys{0};
+  /// Max number of build rows of a key.
+  int64_t maxRowsPerKey{0};
+  /// Number of heavy hitter keys and the sum of their build rows.
+  int64_t numHeavyHitterKeys{0};
+  int64_t numHeavyHitterRows{0};
+};
+
 class BaseHashTable {
  public:
 #if XSIMD_WITH_SSE2
@@ -132,6 +149,11 @@ class BaseHashTable {
 
   /// The same as above but only reported by the HashBuild operator.
   static inline const std::string kBuildWallNanos{"hashtable.buildWallNanos"};
+  static inline const std::string kMaxRowsPerKey{"hashtable.maxRowsPerKey"};
+  static inline const std::string kNumHeavyHitterKeys{
+      "hashtable.numHeavyHitterKeys"};
+  static inline const std::string kNumHeavyHitterRows{
+      "hashtable.numHeavyHitterRows"};
 
   /// Returns the string of the given 'mode'.
   static std::string modeString(HashMode mode);
@@ -383,6 +405,32 @@ class BaseHashTable {
     return offThreadBuildTiming_;
   }
 
+  /// Enables the radix-partitioned joinProbe in kHash mode for tables of at
+  /// least 'bytes' bytes. The probe rows of a batch are grouped by the high
+  /// bits of their bucket offset before probing, so that consecutive probes
+  /// hit a cache-sized range of the table. 0 disables.
+  void setMinTableBytesForPartitionedProbe(uint64_t bytes) {
+    minTableBytesForPartitionedProbe_ = bytes;
+  }
+
+  /// Scans the build rows of a join table with duplicate keys to compute the
+  /// skew of the rows across the keys. A key with at least
+  /// 'minHeavyHitterPct' % of the build rows is a heavy hitter. Invoked after
+  /// prepareJoinTable().
+  void computeJoinKeySkew(int32_t minHeavyHitterPct);
+
+  /// Returns the stats computed by the last computeJoinKeySkew().
+  const JoinKeySkewStats& joinKeySkewStats() const {
+    return joinKeySkewStats_;
+  }
+
+  /// Returns the first build row of each heavy hitter key found by
+  /// computeJoinKeySkew(). The rows of a key are listed by
+  /// RowContainer::getNextRowVector() of the returned row.
+  const std::vector<char*>& heavyHitters() const {
+    return heavyHitters_;
+  }
+
  protected:
   static FOLLY_ALWAYS_INLINE size_t tableSlotSize() {
     // Each slot is 8 bytes.
@@ -410,6 +458,13 @@ class BaseHashTable {
 
   // Time spent in build outside of the calling thread.
   CpuWallTiming offThreadBuildTiming_;
+
+  // Minimum table size in bytes for the partitioned joinProbe. 0 means
+  // disabled.
+  uint64_t minTableBytesForPartitionedProbe_{0};
+
+  JoinKeySkewStats joinKeySkewStats_;
+  std::vector<char*> heavyHitters_;
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
@@ -435,6 +490,8 @@ class HashTable : public BaseHashTable {
   // not occur. In this case the row does not need a link to the next
   // match. 'hasProbedFlag' adds an extra bit in every row for tracking rows
   // that matches join condition for right and full outer joins.
+  // 'columnarDependents' stores the fixed width dependents column-wise, see
+  // RowContainer.
   HashTable(
       std::vector<std::unique_ptr<VectorHasher>>&& hashers,
       const std::vector<Accumulator>& accumulators,
@@ -444,7 +501,8 @@ class HashTable : public BaseHashTable {
       bool hasProbedFlag,
       uint32_t minTableSizeForParallelJoinBuild,
       memory::MemoryPool* pool,
-      const std::shared_ptr<velox::HashStringAllocator>& stringArena = nullptr);
+      const std::shared_ptr<velox::HashStringAllocator>& stringArena = nullptr,
+      bool columnarDependents = false);
 
   ~HashTable() override {
     if (otherTables_.size() > 0) {
@@ -479,7 +537,8 @@ class HashTable : public BaseHashTable {
       bool allowDuplicates,
       bool hasProbedFlag,
       uint32_t minTableSizeForParallelJoinBuild,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      bool columnarDependents = false) {
     return std::make_unique<HashTable>(
         std::move(hashers),
         std::vector<Accumulator>{},
@@ -488,7 +547,9 @@ class HashTable : public BaseHashTable {
         true, // isJoinBuild
         hasProbedFlag,
         minTableSizeForParallelJoinBuild,
-        pool);
+        pool,
+        nullptr, // stringArena
+        columnarDependents);
   }
 
   void groupProbe(HashLookup& lookup) override;
@@ -674,6 +735,17 @@ class HashTable : public BaseHashTable {
   static_assert(sizeof(Bucket) == 128);
   static constexpr uint64_t kBucketSize = sizeof(Bucket);
 
+  // Size of the table range covered by one partition of the partitioned
+  // joinProbe. Chosen to fit in L2 cache.
+  static constexpr uint64_t kPartitionedProbeChunkBytes = 256 << 10;
+
+  // Minimum average number of probe rows per partition for the partitioned
+  // joinProbe.
+  static constexpr int32_t kMinPartitionedProbeRowsPerPartition = 16;
+
+  // Maximum number of partition bits for the partitioned joinProbe.
+  static constexpr int32_t kMaxPartitionedProbeBits = 12;
+
   // Returns the bucket at byte offset 'offset' from 'table_'.
   Bucket* bucketAt(int64_t offset) const {
     VELOX_DCHECK_EQ(0, offset & (kBucketSize - 1));
@@ -841,6 +913,23 @@ class HashTable : public BaseHashTable {
   // Shortcut for probe with normalized keys.
   void joinNormalizedKeyProbe(HashLookup& lookup);
 
+  // Probes 'numProbes' row numbers from 'rows' in kHash mode.
+  void hashJoinProbe(
+      HashLookup& lookup,
+      const vector_size_t* rows,
+      int32_t numProbes);
+
+  // Returns the number of high bucket offset bits by which to partition a
+  // batch of 'numProbes' probe rows in kHash mode, 0 if the batch should not
+  // be partitioned. Each partition covers at least
+  // kPartitionedProbeChunkBytes of the table and has on average at least
+  // kMinPartitionedProbeRowsPerPartition rows.
+  int32_t partitionedProbeBits(int32_t numProbes) const;
+
+  // Groups the rows of 'lookup' by the top 'partitionBits' bits of their
+  // bucket offset and probes them one partition at a time.
+  void partitionedJoinProbe(HashLookup& lookup, int32_t partitionBits);
+
   // Adds a row to a hash join table in kArray hash mode. Returns true
   // if a new entry was made and false if the row was added to an
   // existing set of rows with the same key.
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/HashTableCache.h"
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+
+void HashTableCache::Entry::setBuildResult(
+    std::shared_ptr<Task> builderTask,
+    HashJoinBridge::HashBuildResult buildResult) {
+  VELOX_CHECK_NOT_NULL(builderTask);
+  VELOX_CHECK_EQ(builderTask->taskId(), builderTaskId_);
+  VELOX_CHECK(
+      buildResult.spillPartitionIds.empty(),
+      "Shared hash table can't be spilled");
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(!buildResult_.has_value());
+    VELOX_CHECK(!abandoned_);
+    builderTask_ = std::move(builderTask);
+    buildResult_ = std::move(buildResult);
+    promises = std::move(promises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+void HashTableCache::Entry::abandon() {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (buildResult_.has_value() || abandoned_) {
+      return;
+    }
+    abandoned_ = true;
+    promises = std::move(promises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+std::optional<HashJoinBridge::HashBuildResult>
+HashTableCache::Entry::buildResultOrFuture(ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(
+      !abandoned_,
+      "Task {} stopped before building the shared hash table {}",
+      builderTaskId_,
+      key_);
+  if (!buildResult_.has_value()) {
+    promises_.emplace_back("HashTableCache::Entry::buildResultOrFuture");
+    *future = promises_.back().getSemiFuture();
+    return std::nullopt;
+  }
+  auto result = buildResult_.value();
+  if (result.table != nullptr) {
+    // Alias the table to this entry so that the builder task and its memory
+    // pools outlive all the references to the table.
+    result.table =
+        std::shared_ptr<BaseHashTable>(shared_from_this(), result.table.get());
+  }
+  return result;
+}
+
+// static
+HashTableCache* HashTableCache::instance() {
+  static HashTableCache kInstance;
+  return &kInstance;
+}
+
+std::shared_ptr<HashTableCache::Entry> HashTableCache::get(
+    const std::string& queryId,
+    const core::PlanNodeId& planNodeId,
+    const std::string& taskId) {
+  auto key = fmt::format("{}:{}", queryId, planNodeId);
+  std::lock_guard<std::mutex> l(mutex_);
+  // Drop the entries of the finished joins.
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.expired()) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    if (auto entry = it->second.lock()) {
+      return entry;
+    }
+  }
+  auto entry = std::make_shared<Entry>(key, taskId);
+  entries_[std::move(key)] = entry;
+  return entry;
+}
+
+size_t HashTableCache::numEntries() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  size_t numEntries{0};
+  for (const auto& [key, entry] : entries_) {
+    numEntries += !entry.expired();
+  }
+  return numEntries;
+}
+} // namespace facebook::velox::exec
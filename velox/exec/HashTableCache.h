@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/exec/HashJoinBridge.h"
+
+namespace facebook::velox::exec {
+
+class Task;
+
+/// Node-level registry of the hash join tables shared by the tasks of a query
+/// for a join with a broadcast build side, see
+/// core::HashJoinNode::sharedBuildTable(). The first task of the query to
+/// register for a join builds the table, the other tasks of the query on this
+/// node attach to it read-only.
+///
+/// The table memory stays allocated from the memory pools of the builder task
+/// and is accounted once for the query. The builder task is kept alive until
+/// the last task probing the shared table releases it.
+class HashTableCache {
+ public:
+  /// The shared build result of one join of one query.
+  class Entry : public std::enable_shared_from_this<Entry> {
+   public:
+    Entry(std::string key, std::string builderTaskId)
+        : key_(std::move(key)), builderTaskId_(std::move(builderTaskId)) {}
+
+    /// The id of the task building the table.
+    const std::string& builderTaskId() const {
+      return builderTaskId_;
+    }
+
+    /// Invoked by the last HashBuild operator of the builder task to share
+    /// the build result with the other tasks. 'builderTask' is kept alive as
+    /// long as the shared table is referenced.
+    void setBuildResult(
+        std::shared_ptr<Task> builderTask,
+        HashJoinBridge::HashBuildResult buildResult);
+
+    /// Invoked if the builder task stops before sharing the build result.
+    /// No-op if the build result has been set.
+    void abandon();
+
+    /// Returns the shared build result if set, otherwise sets 'future' to
+    /// wait for it. The returned table shares ownership of this entry. Throws
+    /// if the builder task has abandoned the build.
+    std::optional<HashJoinBridge::HashBuildResult> buildResultOrFuture(
+        ContinueFuture* future);
+
+   private:
+    const std::string key_;
+    const std::string builderTaskId_;
+
+    std::mutex mutex_;
+    // Owns the memory pools of the table in 'buildResult_'. Declared before
+    // 'buildResult_' to be destroyed after it.
+    std::shared_ptr<Task> builderTask_;
+    std::optional<HashJoinBridge::HashBuildResult> buildResult_;
+    bool abandoned_{false};
+    std::vector<ContinuePromise> promises_;
+  };
+
+  static HashTableCache* instance();
+
+  /// Returns the entry for join 'planNodeId' of query 'queryId'. Makes a new
+  /// entry built by task 'taskId' if there is none or the previous one is no
+  /// longer referenced.
+  std::shared_ptr<Entry> get(
+      const std::string& queryId,
+      const core::PlanNodeId& planNodeId,
+      const std::string& taskId);
+
+  /// Returns the number of entries that are still referenced.
+  size_t numEntries() const;
+
+ private:
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, std::weak_ptr<Entry>> entries_;
+};
+} // namespace facebook::velox::exec
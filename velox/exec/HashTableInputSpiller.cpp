@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/HashTableInputSpiller.h"
+#include "velox/common/memory/MemoryArbitrator.h"
+#include "velox/exec/OperatorUtils.h"
+
+namespace facebook::velox::exec {
+
+HashTableInputSpiller::HashTableInputSpiller(
+    RowTypePtr inputType,
+    const common::SpillConfig* spillConfig,
+    folly::Synchronized<common::SpillStats>* spillStats)
+    : inputType_(std::move(inputType)),
+      spillConfig_(spillConfig),
+      spillStats_(spillStats),
+      partitionBits_(
+          spillConfig_->startPartitionBit,
+          spillConfig_->startPartitionBit + spillConfig_->numPartitionBits) {}
+
+SpillPartitionNumSet HashTableInputSpiller::spillTable(BaseHashTable& table) {
+  VELOX_CHECK(!spilled());
+
+  auto columnTypes = table.rows()->columnTypes();
+  auto tableType = ROW(std::move(columnTypes));
+
+  // TODO Replace Spiller::Type::kRowNumber.
+  auto tableSpiller = std::make_unique<Spiller>(
+      Spiller::Type::kRowNumber,
+      table.rows(),
+      tableType,
+      partitionBits_,
+      spillConfig_,
+      spillStats_);
+
+  tableSpiller->spill();
+  tableSpiller->finishSpill(tablePartitionSet_);
+
+  table.clear();
+  return tableSpiller->state().spilledPartitionSet();
+}
+
+void HashTableInputSpiller::setupInputSpiller(
+    const BaseHashTable& table,
+    const SpillPartitionNumSet& partitions) {
+  VELOX_CHECK(!partitions.empty());
+  VELOX_CHECK(!spilled());
+
+  // TODO Replace Spiller::Type::kHashJoinProbe.
+  inputSpiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kHashJoinProbe,
+      inputType_,
+      partitionBits_,
+      spillConfig_,
+      spillStats_);
+  inputSpiller_->setPartitionsSpilled(partitions);
+
+  const auto& hashers = table.hashers();
+
+  std::vector<column_index_t> keyChannels;
+  keyChannels.reserve(hashers.size());
+  for (const auto& hasher : hashers) {
+    keyChannels.push_back(hasher->channel());
+  }
+
+  hashFunction_ = std::make_unique<HashPartitionFunction>(
+      inputSpiller_->hashBits(), inputType_, keyChannels);
+}
+
+void HashTableInputSpiller::spillInput(
+    const RowVectorPtr& input,
+    memory::MemoryPool* pool) {
+  VELOX_CHECK(spilled());
+  const auto numInput = input->size();
+
+  std::vector<uint32_t> spillPartitions(numInput);
+  const auto singlePartition =
+      hashFunction_->partition(*input, spillPartitions);
+
+  const auto numPartitions = hashFunction_->numPartitions();
+
+  std::vector<BufferPtr> partitionIndices(numPartitions);
+  std::vector<vector_size_t*> rawPartitionIndices(numPartitions);
+
+  for (auto i = 0; i < numPartitions; ++i) {
+    partitionIndices[i] = allocateIndices(numInput, pool);
+    rawPartitionIndices[i] = partitionIndices[i]->asMutable<vector_size_t>();
+  }
+
+  std::vector<vector_size_t> numSpillInputs(numPartitions, 0);
+
+  for (auto row = 0; row < numInput; ++row) {
+    const auto partition = singlePartition.has_value() ? singlePartition.value()
+                                                       : spillPartitions[row];
+    rawPartitionIndices[partition][numSpillInputs[partition]++] = row;
+  }
+
+  // Ensure vector are lazy loaded before spilling.
+  for (auto i = 0; i < input->childrenSize(); ++i) {
+    input->childAt(i)->loadedVector();
+  }
+
+  for (int32_t partition = 0; partition < numSpillInputs.size(); ++partition) {
+    const auto numInputs = numSpillInputs[partition];
+    if (numInputs == 0) {
+      continue;
+    }
+
+    inputSpiller_->spill(
+        partition, wrap(numInputs, partitionIndices[partition], input));
+  }
+}
+
+void HashTableInputSpiller::finishInputSpill() {
+  VELOX_CHECK(spilled());
+  inputSpiller_->finishSpill(inputPartitionSet_);
+  removeEmptyPartitions(inputPartitionSet_);
+}
+
+bool HashTableInputSpiller::restoreNextPartition(
+    BaseHashTable& table,
+    HashLookup& lookup,
+    memory::MemoryPool* pool,
+    const std::function<void(const RowVectorPtr&, const HashLookup&)>&
+        addedTableRows,
+    RowVectorPtr& input) {
+  VELOX_CHECK(!restoring());
+  if (inputPartitionSet_.empty()) {
+    return false;
+  }
+
+  auto it = inputPartitionSet_.begin();
+  inputReader_ = it->second->createUnorderedReader(pool, spillStats_);
+
+  // Find matching partition for the hash table.
+  auto tableIt = tablePartitionSet_.find(it->first);
+  if (tableIt != tablePartitionSet_.end()) {
+    auto tableReader =
+        tableIt->second->createUnorderedReader(pool, spillStats_);
+
+    RowVectorPtr data;
+    while (tableReader->nextBatch(data)) {
+      // 'data' contains the keys followed by the dependent columns. Transform
+      // 'data' to match 'inputType_' so it can be added to 'table'. Move the
+      // key columns and leave other columns unset.
+      std::vector<VectorPtr> columns(inputType_->size());
+
+      const auto& hashers = table.hashers();
+      for (auto i = 0; i < hashers.size(); ++i) {
+        columns[hashers[i]->channel()] = data->childAt(i);
+      }
+
+      auto tableInput = std::make_shared<RowVector>(
+          pool, inputType_, nullptr, data->size(), std::move(columns));
+      probeRestoredInput(table, lookup, tableInput);
+      addedTableRows(data, lookup);
+    }
+    tablePartitionSet_.erase(tableIt);
+  }
+
+  inputPartitionSet_.erase(it);
+
+  // Empty partitions are removed when the input spill is finished.
+  const bool hasInput = nextInput(input);
+  VELOX_CHECK(hasInput);
+  return true;
+}
+
+bool HashTableInputSpiller::nextInput(RowVectorPtr& input) {
+  VELOX_CHECK(restoring());
+  if (inputReader_->nextBatch(input)) {
+    return true;
+  }
+  inputReader_ = nullptr;
+  input = nullptr;
+  return false;
+}
+
+void HashTableInputSpiller::probeRestoredInput(
+    BaseHashTable& table,
+    HashLookup& lookup,
+    const RowVectorPtr& input) const {
+  SelectivityVector rows(input->size());
+  table.prepareForGroupProbe(
+      lookup, input, rows, false, spillConfig_->startPartitionBit);
+  table.groupProbe(lookup);
+}
+
+void ensureHashTableInputFits(
+    Operator& op,
+    const common::SpillConfig& spillConfig,
+    BaseHashTable& table,
+    const RowVectorPtr& input) {
+  const auto numDistinct = table.numDistinct();
+  if (numDistinct == 0) {
+    // Table is empty. Nothing to spill.
+    return;
+  }
+
+  auto* pool = op.pool();
+  auto* rows = table.rows();
+  auto [freeRows, outOfLineFreeBytes] = rows->freeSpace();
+  const auto outOfLineBytes =
+      rows->stringAllocator().retainedSize() - outOfLineFreeBytes;
+  const auto outOfLineBytesPerRow = outOfLineBytes / numDistinct;
+
+  // Test-only spill path.
+  if (testingTriggerSpill(pool->name())) {
+    Operator::ReclaimableSectionGuard guard(&op);
+    memory::testingRunArbitration(pool);
+    return;
+  }
+
+  const auto currentUsage = pool->currentBytes();
+  const auto minReservationBytes =
+      currentUsage * spillConfig.minSpillableReservationPct / 100;
+  const auto availableReservationBytes = pool->availableReservation();
+  const auto tableIncrementBytes = table.hashTableSizeIncrease(input->size());
+  const auto incrementBytes =
+      rows->sizeIncrement(input->size(), outOfLineBytesPerRow * input->size()) +
+      tableIncrementBytes;
+
+  // First to check if we have sufficient minimal memory reservation.
+  if (availableReservationBytes >= minReservationBytes) {
+    if ((tableIncrementBytes == 0) && (freeRows > input->size()) &&
+        (outOfLineBytes == 0 ||
+         outOfLineFreeBytes >= outOfLineBytesPerRow * input->size())) {
+      // Enough free rows for input rows and enough variable length free space.
+      return;
+    }
+  }
+
+  // Check if we can increase reservation. The increment is the largest of twice
+  // the maximum increment from this input and 'spillableReservationGrowthPct_'
+  // of the current memory usage.
+  const auto targetIncrementBytes = std::max<int64_t>(
+      incrementBytes * 2,
+      currentUsage * spillConfig.spillableReservationGrowthPct / 100);
+  {
+    Operator::ReclaimableSectionGuard guard(&op);
+    if (pool->maybeReserve(targetIncrementBytes)) {
+      return;
+    }
+  }
+
+  LOG(WARNING) << "Failed to reserve " << succinctBytes(targetIncrementBytes)
+               << " for memory pool " << pool->name()
+               << ", usage: " << succinctBytes(pool->currentBytes())
+               << ", reservation: " << succinctBytes(pool->reservedBytes());
+}
+
+} // namespace facebook::velox::exec
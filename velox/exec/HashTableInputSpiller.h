@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <functional>
+
+#include "velox/exec/HashPartitionFunction.h"
+#include "velox/exec/HashTable.h"
+#include "velox/exec/Operator.h"
+#include "velox/exec/Spiller.h"
+
+namespace facebook::velox::exec {
+
+/// Spills the hash table of an operator that keeps per key state of its
+/// input, e.g. RowNumber and MarkDistinct, and the input received after
+/// spilling, both partitioned by the hash of the keys. After all input is
+/// received, the spilled partitions are restored one at a time: the spilled
+/// rows of the hash table are added back to the table and then the spilled
+/// input of the partition is read back.
+class HashTableInputSpiller {
+ public:
+  HashTableInputSpiller(
+      RowTypePtr inputType,
+      const common::SpillConfig* spillConfig,
+      folly::Synchronized<common::SpillStats>* spillStats);
+
+  /// Returns true if the hash table has been spilled.
+  bool spilled() const {
+    return inputSpiller_ != nullptr;
+  }
+
+  /// Returns true while the input of a restored partition is being read.
+  bool restoring() const {
+    return inputReader_ != nullptr;
+  }
+
+  /// Spills the rows of 'table' and clears it. Returns the partitions with
+  /// spilled rows. The caller may release the memory of its pool after.
+  SpillPartitionNumSet spillTable(BaseHashTable& table);
+
+  /// Sets up spilling the input of 'partitions'. The keys of the input are
+  /// the columns of the hashers of 'table'. Called after spillTable().
+  void setupInputSpiller(
+      const BaseHashTable& table,
+      const SpillPartitionNumSet& partitions);
+
+  /// Spills the rows of 'input' to their partitions. Allocates the indices of
+  /// the rows of each partition from 'pool'.
+  void spillInput(const RowVectorPtr& input, memory::MemoryPool* pool);
+
+  /// Finishes spilling the input. Called when all input is received.
+  void finishInputSpill();
+
+  /// Starts restoring the next spilled partition. Adds the spilled rows of
+  /// the hash table in the partition back to 'table', calling
+  /// 'addedTableRows' with each batch of the spilled rows and 'lookup' after
+  /// the batch is added. Returns false if no partition is left, otherwise
+  /// sets 'input' to the first batch of spilled input of the partition.
+  bool restoreNextPartition(
+      BaseHashTable& table,
+      HashLookup& lookup,
+      memory::MemoryPool* pool,
+      const std::function<void(const RowVectorPtr&, const HashLookup&)>&
+          addedTableRows,
+      RowVectorPtr& input);
+
+  /// Sets 'input' to the next batch of spilled input of the partition being
+  /// restored. Returns false if the partition has no more input.
+  bool nextInput(RowVectorPtr& input);
+
+  /// Probes 'table' with 'input', a batch of restored input, with 'lookup'.
+  void probeRestoredInput(
+      BaseHashTable& table,
+      HashLookup& lookup,
+      const RowVectorPtr& input) const;
+
+ private:
+  const RowTypePtr inputType_;
+  const common::SpillConfig* const spillConfig_;
+  folly::Synchronized<common::SpillStats>* const spillStats_;
+
+  // The spill partition bits used by both hash table content spill and input
+  // data spill.
+  const HashBitRange partitionBits_;
+
+  SpillPartitionSet tablePartitionSet_;
+
+  // Spiller for input received after spilling has been triggered.
+  std::unique_ptr<Spiller> inputSpiller_;
+
+  // Used to calculate the spill partition numbers of the inputs.
+  std::unique_ptr<HashPartitionFunction> hashFunction_;
+
+  SpillPartitionSet inputPartitionSet_;
+
+  // Used to restore previously spilled input.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> inputReader_;
+};
+
+/// Reserves memory for adding 'input' to 'table' of 'op', whose spill config
+/// is 'spillConfig', so that the memory arbitrator can spill 'op' instead of
+/// failing an allocation while 'input' is added.
+void ensureHashTableInputFits(
+    Operator& op,
+    const common::SpillConfig& spillConfig,
+    BaseHashTable& table,
+    const RowVectorPtr& input);
+
+} // namespace facebook::velox::exec
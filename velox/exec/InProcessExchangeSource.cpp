@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/InProcessExchangeSource.h"
+#include "velox/exec/OutputBufferManager.h"
+
+namespace facebook::velox::exec {
+
+// static
+std::shared_ptr<ExchangeSource> InProcessExchangeSource::create(
+    const std::string& taskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool) {
+  auto buffers = OutputBufferManager::getInstance().lock();
+  if (buffers == nullptr || buffers->getBufferIfExists(taskId) == nullptr) {
+    return nullptr;
+  }
+  return std::make_shared<InProcessExchangeSource>(
+      taskId, destination, std::move(queue), pool);
+}
+
+bool InProcessExchangeSource::shouldRequestLocked() {
+  if (atEnd_) {
+    return false;
+  }
+  return !requestPending_.exchange(true);
+}
+
+folly::SemiFuture<ExchangeSource::Response> InProcessExchangeSource::request(
+    uint32_t maxBytes,
+    std::chrono::microseconds maxWait) {
+  auto buffers = OutputBufferManager::getInstance().lock();
+  VELOX_CHECK_NOT_NULL(buffers, "invalid OutputBufferManager");
+
+  auto promise = VeloxPromise<Response>("InProcessExchangeSource::request");
+  auto future = promise.getSemiFuture();
+  int64_t requestId;
+  int64_t requestedSequence;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    VELOX_CHECK(requestPending_);
+    promise_ = std::move(promise);
+    requestId = ++requestId_;
+    requestedSequence = sequence_;
+  }
+
+  // The callback may be called after 'this' is freed, e.g. when the producer
+  // finishes after the consumer has been closed.
+  std::weak_ptr<ExchangeSource> weakSelf = shared_from_this();
+  const bool found = buffers->getData(
+      taskId_,
+      destination_,
+      maxBytes,
+      requestedSequence,
+      [weakSelf, requestId, requestedSequence](
+          std::vector<std::unique_ptr<folly::IOBuf>> data,
+          int64_t sequence,
+          std::vector<int64_t> remainingBytes) {
+        if (auto self = weakSelf.lock()) {
+          static_cast<InProcessExchangeSource*>(self.get())
+              ->processData(
+                  requestId,
+                  requestedSequence,
+                  std::move(data),
+                  sequence,
+                  std::move(remainingBytes));
+        }
+      });
+  if (!found) {
+    // The producer task has been removed, e.g. after a failure.
+    queue_->setError(fmt::format(
+        "Output buffer of in-process producer task {} not found", taskId_));
+    timeout(requestId);
+    return std::move(future);
+  }
+
+  return std::move(future).within(maxWait).deferError(
+      folly::tag_t<folly::FutureTimeout>{},
+      [weakSelf, requestId](const folly::FutureTimeout&) {
+        if (auto self = weakSelf.lock()) {
+          static_cast<InProcessExchangeSource*>(self.get())->timeout(requestId);
+        }
+        return Response{0, false, {}};
+      });
+}
+
+folly::SemiFuture<ExchangeSource::Response>
+InProcessExchangeSource::requestDataSizes(std::chrono::microseconds maxWait) {
+  return request(0, maxWait);
+}
+
+void InProcessExchangeSource::processData(
+    int64_t requestId,
+    int64_t requestedSequence,
+    std::vector<std::unique_ptr<folly::IOBuf>> data,
+    int64_t sequence,
+    std::vector<int64_t> remainingBytes) {
+  if (requestedSequence > sequence && !data.empty()) {
+    // Drops the pages before the requested ones.
+    const int64_t numExtra = requestedSequence - sequence;
+    VELOX_CHECK_LT(numExtra, data.size());
+    data.erase(data.begin(), data.begin() + numExtra);
+  }
+
+  std::vector<std::unique_ptr<SerializedPage>> pages;
+  bool atEnd = false;
+  int64_t totalBytes = 0;
+  for (auto& buffer : data) {
+    if (buffer == nullptr) {
+      atEnd = true;
+      // Keeps looping, there could be extra end markers.
+      continue;
+    }
+    totalBytes += buffer->computeChainDataLength();
+    // Shares the producer's memory. No copy.
+    pages.push_back(std::make_unique<SerializedPage>(std::move(buffer)));
+  }
+
+  VeloxPromise<Response> requestPromise;
+  int64_t ackSequence{-1};
+  {
+    std::vector<ContinuePromise> queuePromises;
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      if (requestId == requestId_) {
+        requestPending_ = false;
+        requestPromise = std::move(promise_);
+      }
+      // A later request may have consumed the data already.
+      if (requestedSequence == sequence_ && !atEnd_) {
+        for (auto& page : pages) {
+          queue_->enqueueLocked(std::move(page), queuePromises);
+        }
+        if (atEnd) {
+          queue_->enqueueLocked(nullptr, queuePromises);
+          atEnd_ = true;
+        }
+        if (!pages.empty()) {
+          ackSequence = sequence_ = requestedSequence + pages.size();
+        }
+        numPages_ += pages.size();
+        totalBytes_ += totalBytes;
+      } else {
+        totalBytes = 0;
+        atEnd = false;
+      }
+    }
+    for (auto& promise : queuePromises) {
+      promise.setValue();
+    }
+  }
+
+  // Outside of the queue mutex.
+  auto buffers = OutputBufferManager::getInstance().lock();
+  if (buffers != nullptr) {
+    if (atEnd) {
+      buffers->deleteResults(taskId_, destination_);
+    } else if (ackSequence >= 0) {
+      buffers->acknowledge(taskId_, destination_, ackSequence);
+    }
+  }
+
+  if (requestPromise.valid() && !requestPromise.isFulfilled()) {
+    requestPromise.setValue(
+        Response{totalBytes, atEnd, std::move(remainingBytes)});
+  }
+}
+
+void InProcessExchangeSource::timeout(int64_t requestId) {
+  VeloxPromise<Response> promise;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    if (requestId != requestId_) {
+      return;
+    }
+    requestPending_ = false;
+    promise = std::move(promise_);
+  }
+  if (promise.valid() && !promise.isFulfilled()) {
+    promise.setValue(Response{0, false, {}});
+  }
+}
+
+void InProcessExchangeSource::close() {
+  VeloxPromise<Response> promise;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    // Ignores the responses to the pending request and drops late data.
+    ++requestId_;
+    atEnd_ = true;
+    promise = std::move(promise_);
+  }
+  if (promise.valid() && !promise.isFulfilled()) {
+    promise.setValue(Response{0, false, {}});
+  }
+  if (auto buffers = OutputBufferManager::getInstance().lock()) {
+    buffers->deleteResults(taskId_, destination_);
+  }
+}
+
+folly::F14FastMap<std::string, RuntimeMetric>
+InProcessExchangeSource::metrics() const {
+  return {
+      {"inProcessExchangeSource.numPages", RuntimeMetric(numPages_)},
+      {"inProcessExchangeSource.totalBytes",
+       RuntimeMetric(totalBytes_, RuntimeCounter::Unit::kBytes)},
+  };
+}
+
+} // namespace facebook::velox::exec
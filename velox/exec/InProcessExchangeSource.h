@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/ExchangeSource.h"
+
+namespace facebook::velox::exec {
+
+/// ExchangeSource for a producer task that runs in the same process. Takes the
+/// pages directly from the producer's buffer in OutputBufferManager instead
+/// of going through a network transport. The pages share the memory of the
+/// producer's buffers, which keep the producer task alive until the pages are
+/// freed, so no data is copied.
+class InProcessExchangeSource : public ExchangeSource {
+ public:
+  InProcessExchangeSource(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool)
+      : ExchangeSource(taskId, destination, std::move(queue), pool) {}
+
+  /// Factory to register with ExchangeSource::registerFactory(). Returns an
+  /// InProcessExchangeSource if OutputBufferManager has a buffer for
+  /// 'taskId', i.e. the producer task has been created in this process, and
+  /// nullptr otherwise. Must be registered before the factories of the
+  /// network sources to take precedence over them.
+  static std::shared_ptr<ExchangeSource> create(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool);
+
+  bool supportsMetrics() const override {
+    return true;
+  }
+
+  bool shouldRequestLocked() override;
+
+  folly::SemiFuture<Response> request(
+      uint32_t maxBytes,
+      std::chrono::microseconds maxWait) override;
+
+  folly::SemiFuture<Response> requestDataSizes(
+      std::chrono::microseconds maxWait) override;
+
+  void close() override;
+
+  folly::F14FastMap<std::string, RuntimeMetric> metrics() const override;
+
+ private:
+  // Called by OutputBufferManager with the data for request 'requestId',
+  // which asked for the pages from 'requestedSequence'. 'data' starts at
+  // 'sequence'.
+  void processData(
+      int64_t requestId,
+      int64_t requestedSequence,
+      std::vector<std::unique_ptr<folly::IOBuf>> data,
+      int64_t sequence,
+      std::vector<int64_t> remainingBytes);
+
+  // Called when request 'requestId' times out. Lets the caller issue a new
+  // request unless the request has been answered in the meantime.
+  void timeout(int64_t requestId);
+
+  // Promise for the pending request. Accessed under queue_->mutex().
+  VeloxPromise<Response> promise_{VeloxPromise<Response>::makeEmpty()};
+  // Increments with each request. Used to ignore the responses and timeouts
+  // of earlier requests. Accessed under queue_->mutex().
+  int64_t requestId_{0};
+
+  std::atomic<int64_t> numPages_{0};
+  std::atomic<uint64_t> totalBytes_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -29,27 +29,43 @@ void notify(std::vector<ContinuePromise>& promises) {
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
     ContinueFuture* future,
     int64_t added) {
-  std::lock_guard<std::mutex> l(mutex_);
-  bufferedBytes_ += added;
-
-  if (bufferedBytes_ >= maxBufferSize_) {
-    promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
-    *future = promises_.back().getSemiFuture();
-    return true;
+  if (bufferedBytes_.fetch_add(added) + added < maxBufferSize_) {
+    return false;
   }
 
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    hasWaiters_ = true;
+    // A consumer may have freed memory before 'hasWaiters_' was set, in which
+    // case it did not look for promises to fulfill.
+    if (bufferedBytes_ >= maxBufferSize_) {
+      promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
+      *future = promises_.back().getSemiFuture();
+      return true;
+    }
+    promises = std::move(promises_);
+    promises_.clear();
+    hasWaiters_ = false;
+  }
+  notify(promises);
   return false;
 }
 
 std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
     int64_t removed) {
+  if (bufferedBytes_.fetch_sub(removed) - removed >= maxBufferSize_ ||
+      !hasWaiters_) {
+    return {};
+  }
+
   std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
-    bufferedBytes_ -= removed;
-
     if (bufferedBytes_ < maxBufferSize_) {
       promises = std::move(promises_);
+      promises_.clear();
+      hasWaiters_ = false;
     }
   }
   return promises;
@@ -78,21 +94,16 @@ void LocalExchangeQueue::noMoreProducers() {
 BlockingReason LocalExchangeQueue::enqueue(
     RowVectorPtr input,
     ContinueFuture* future) {
-  auto inputBytes = input->estimateFlatSize();
+  const int64_t inputBytes = input->estimateFlatSize();
 
   std::vector<ContinuePromise> consumerPromises;
-  bool blockedOnConsumer = false;
   bool isClosed = queue_.withWLock([&](auto& queue) {
     if (closed_) {
       return true;
     }
-    queue.push(std::move(input));
+    queue.push({std::move(input), inputBytes});
     consumerPromises = std::move(consumerPromises_);
-
-    if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
-      blockedOnConsumer = true;
-    }
-
+    consumerPromises_.clear();
     return false;
   });
 
@@ -102,7 +113,10 @@ BlockingReason LocalExchangeQueue::enqueue(
 
   notify(consumerPromises);
 
-  if (blockedOnConsumer) {
+  // Outside of the queue lock. A consumer may dequeue and account for the
+  // vector before it is accounted here, which only makes the usage briefly
+  // lower than the actual.
+  if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
     return BlockingReason::kWaitForConsumer;
   }
 
@@ -125,7 +139,7 @@ BlockingReason LocalExchangeQueue::next(
     ContinueFuture* future,
     memory::MemoryPool* pool,
     RowVectorPtr* data) {
-  std::vector<ContinuePromise> memoryPromises;
+  int64_t bytes = 0;
   auto blockingReason = queue_.withWLock([&](auto& queue) {
     *data = nullptr;
     if (queue.empty()) {
@@ -139,20 +153,20 @@ BlockingReason LocalExchangeQueue::next(
       return BlockingReason::kWaitForProducer;
     }
 
-    *data = queue.front();
+    *data = std::move(queue.front().vector);
+    bytes = queue.front().bytes;
     queue.pop();
-
-    memoryPromises =
-        memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
-
     return BlockingReason::kNotBlocked;
   });
-  notify(memoryPromises);
+  if (bytes > 0) {
+    auto memoryPromises = memoryManager_->decreaseMemoryUsage(bytes);
+    notify(memoryPromises);
+  }
   return blockingReason;
 }
 
 bool LocalExchangeQueue::isFinishedLocked(
-    const std::queue<RowVectorPtr>& queue) const {
+    const std::queue<Entry>& queue) const {
   if (closed_) {
     return true;
   }
@@ -165,16 +179,17 @@ bool LocalExchangeQueue::isFinishedLocked(
 }
 
 bool LocalExchangeQueue::isFinished() {
-  return queue_.withWLock([&](auto& queue) { return isFinishedLocked(queue); });
+  return queue_.withRLock(
+      [&](const auto& queue) { return isFinishedLocked(queue); });
 }
 
 void LocalExchangeQueue::close() {
   std::vector<ContinuePromise> consumerPromises;
   std::vector<ContinuePromise> memoryPromises;
   queue_.withWLock([&](auto& queue) {
-    uint64_t freedBytes = 0;
+    int64_t freedBytes = 0;
     while (!queue.empty()) {
-      freedBytes += queue.front()->estimateFlatSize();
+      freedBytes += queue.front().bytes;
       queue.pop();
     }
 
@@ -251,7 +266,9 @@ LocalPartition::LocalPartition(
       partitionFunction_(
           numPartitions_ == 1
               ? nullptr
-              : planNode->partitionFunctionSpec().create(numPartitions_)) {
+              : planNode->partitionFunctionSpec().create(numPartitions_)),
+      minStringLiveRatio_(
+          ctx->queryConfig().retainedStringBufferMinLiveRatio()) {
   VELOX_CHECK(numPartitions_ == 1 || partitionFunction_ != nullptr);
 
   for (auto& queue : queues_) {
@@ -306,6 +323,13 @@ void LocalPartition::addInput(RowVectorPtr input) {
     child->loadedVector();
   }
 
+  // The queues keep 'input' until it is consumed. Copy the strings a filter
+  // left of a larger batch, so that the queues do not hold the whole batch.
+  if (minStringLiveRatio_ > 0) {
+    input = std::static_pointer_cast<RowVector>(
+        BaseVector::compactStringBuffers(input, minStringLiveRatio_));
+  }
+
   if (numPartitions_ == 1) {
     ContinueFuture future;
     auto blockingReason = queues_[0]->enqueue(input, &future);
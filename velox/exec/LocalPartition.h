@@ -21,7 +21,9 @@
 namespace facebook::velox::exec {
 
 /// Keeps track of the total size in bytes of the data buffered in all
-/// LocalExchangeQueues.
+/// LocalExchangeQueues. The size is an atomic counter so that producers and
+/// consumers only take the mutex when a producer has to wait or may be
+/// unblocked.
 class LocalExchangeMemoryManager {
  public:
   explicit LocalExchangeMemoryManager(int64_t maxBufferSize)
@@ -36,10 +38,18 @@ class LocalExchangeMemoryManager {
   /// caller to fulfill.
   std::vector<ContinuePromise> decreaseMemoryUsage(int64_t removed);
 
+  int64_t bufferedBytes() const {
+    return bufferedBytes_;
+  }
+
  private:
   const int64_t maxBufferSize_;
+  std::atomic<int64_t> bufferedBytes_{0};
+  // True if 'promises_' may be non-empty. Set under 'mutex_' before a
+  // producer re-checks 'bufferedBytes_', read by consumers after decreasing
+  // 'bufferedBytes_', so that a wakeup is never lost.
+  std::atomic<bool> hasWaiters_{false};
   std::mutex mutex_;
-  int64_t bufferedBytes_{0};
   std::vector<ContinuePromise> promises_;
 };
 
@@ -89,11 +99,18 @@ class LocalExchangeQueue {
   void close();
 
  private:
-  bool isFinishedLocked(const std::queue<RowVectorPtr>& queue) const;
+  // A vector and its estimateFlatSize(), so that the size is not recomputed
+  // while holding the lock.
+  struct Entry {
+    RowVectorPtr vector;
+    int64_t bytes;
+  };
+
+  bool isFinishedLocked(const std::queue<Entry>& queue) const;
 
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
   const int partition_;
-  folly::Synchronized<std::queue<RowVectorPtr>> queue_;
+  folly::Synchronized<std::queue<Entry>> queue_;
   // Satisfied when data becomes available or all producers report that they
   // finished producing, e.g. queue_ is not empty or noMoreProducers_ is true
   // and pendingProducers_ is zero.
@@ -175,6 +192,8 @@ class LocalPartition : public Operator {
   const std::vector<std::shared_ptr<LocalExchangeQueue>> queues_;
   const size_t numPartitions_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
+  // See QueryConfig::kRetainedStringBufferMinLiveRatio.
+  const double minStringLiveRatio_;
 
   std::vector<BlockingReason> blockingReasons_;
   std::vector<ContinueFuture> futures_;
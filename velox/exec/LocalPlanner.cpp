@@ -15,9 +15,11 @@
  */
 #include "velox/exec/LocalPlanner.h"
 #include "velox/core/PlanFragment.h"
+#include "velox/exec/AggregateFunctionRegistry.h"
 #include "velox/exec/ArrowStream.h"
 #include "velox/exec/AssignUniqueId.h"
 #include "velox/exec/CallbackSink.h"
+#include "velox/exec/CoalesceBatches.h"
 #include "velox/exec/EnforceSingleRow.h"
 #include "velox/exec/Exchange.h"
 #include "velox/exec/Expand.h"
@@ -85,6 +87,13 @@ OperatorSupplier makeConsumerSupplier(
     return [localMerge](int32_t operatorId, DriverCtx* ctx) {
       auto mergeSource = ctx->task->addLocalMergeSource(
           ctx->splitGroupId, localMerge->id(), localMerge->outputType());
+      if (localMerge->sortingKeys().empty()) {
+        // The sources are concatenated in the order they are added, which
+        // must be the driver order.
+        const auto& sources = ctx->task->getLocalMergeSources(
+            ctx->splitGroupId, localMerge->id());
+        VELOX_CHECK_EQ(sources.size(), static_cast<size_t>(ctx->driverId) + 1);
+      }
 
       auto consumer = [mergeSource](
                           RowVectorPtr input, ContinueFuture* future) {
@@ -132,12 +141,228 @@ OperatorSupplier makeConsumerSupplier(
   return Operator::operatorSupplierFromPlanNode(planNode);
 }
 
+/// Returns a plan equivalent to 'planNode' if it is an aggregation of raw
+/// input over a GroupId node, or nullptr otherwise. GroupId copies each input
+/// row once per grouping set, so that the aggregation hashes each row that
+/// many times. The returned plan instead aggregates the input once on the
+/// union of the grouping keys, expands the partial results with GroupId and
+/// merges them per grouping set. This requires aggregates without masks,
+/// sorting keys or distinct whose inputs are GroupId aggregation inputs or
+/// constants.
+core::PlanNodePtr rollUpGroupingSets(const core::PlanNodePtr& planNode) {
+  auto aggregation =
+      std::dynamic_pointer_cast<const core::AggregationNode>(planNode);
+  if (!aggregation || !isRawInput(aggregation->step()) ||
+      aggregation->isPreGrouped() || aggregation->aggregates().empty()) {
+    return nullptr;
+  }
+  auto groupId = std::dynamic_pointer_cast<const core::GroupIdNode>(
+      aggregation->sources()[0]);
+  if (!groupId || groupId->groupingSets().size() < 2) {
+    return nullptr;
+  }
+
+  std::unordered_set<std::string> names;
+  for (const auto& input : groupId->aggregationInputs()) {
+    names.insert(input->name());
+  }
+  for (const auto& aggregate : aggregation->aggregates()) {
+    if (aggregate.distinct || aggregate.mask ||
+        !aggregate.sortingKeys.empty()) {
+      return nullptr;
+    }
+    for (const auto& input : aggregate.call->inputs()) {
+      if (auto field = core::TypedExprs::asFieldAccess(input)) {
+        if (names.count(field->name()) == 0) {
+          return nullptr;
+        }
+      } else if (!core::TypedExprs::isConstant(input)) {
+        return nullptr;
+      }
+    }
+  }
+
+  // The partial aggregation groups on the distinct inputs of the grouping
+  // keys. Its results replace the aggregation inputs of GroupId, so their
+  // names must not clash with any column of the partial aggregation or
+  // GroupId.
+  names = {groupId->outputType()->names().back()};
+  std::vector<core::FieldAccessTypedExprPtr> keys;
+  for (const auto& info : groupId->groupingKeyInfos()) {
+    if (names.insert(info.input->name()).second) {
+      keys.push_back(info.input);
+    }
+  }
+  for (const auto& info : groupId->groupingKeyInfos()) {
+    names.insert(info.output);
+  }
+
+  const auto& aggregateNames = aggregation->aggregateNames();
+  std::vector<core::AggregationNode::Aggregate> partialAggregates;
+  std::vector<core::AggregationNode::Aggregate> rollUpAggregates;
+  std::vector<core::FieldAccessTypedExprPtr> rollUpInputs;
+  for (auto i = 0; i < aggregateNames.size(); ++i) {
+    const auto& aggregate = aggregation->aggregates()[i];
+    const auto& name = aggregate.call->name();
+    auto intermediateType =
+        resolveAggregateFunction(name, aggregate.rawInputTypes).second;
+    if (!intermediateType || !names.insert(aggregateNames[i]).second) {
+      return nullptr;
+    }
+    auto& partial = partialAggregates.emplace_back(aggregate);
+    partial.call = std::make_shared<core::CallTypedExpr>(
+        intermediateType, aggregate.call->inputs(), name);
+
+    rollUpInputs.push_back(std::make_shared<core::FieldAccessTypedExpr>(
+        intermediateType, aggregateNames[i]));
+    auto& rollUp = rollUpAggregates.emplace_back(aggregate);
+    rollUp.call = std::make_shared<core::CallTypedExpr>(
+        aggregate.call->type(),
+        std::vector<core::TypedExprPtr>{rollUpInputs.back()},
+        name);
+  }
+
+  auto partialAggregation = std::make_shared<core::AggregationNode>(
+      fmt::format("{}.rollup", aggregation->id()),
+      core::AggregationNode::Step::kPartial,
+      keys,
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      aggregateNames,
+      partialAggregates,
+      /*ignoreNullKeys=*/false,
+      groupId->sources()[0]);
+  auto expand = std::make_shared<core::GroupIdNode>(
+      groupId->id(),
+      groupId->groupingSets(),
+      groupId->groupingKeyInfos(),
+      rollUpInputs,
+      groupId->outputType()->names().back(),
+      partialAggregation);
+  return std::make_shared<core::AggregationNode>(
+      aggregation->id(),
+      aggregation->step() == core::AggregationNode::Step::kPartial
+          ? core::AggregationNode::Step::kIntermediate
+          : core::AggregationNode::Step::kFinal,
+      aggregation->groupingKeys(),
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      aggregateNames,
+      rollUpAggregates,
+      aggregation->globalGroupingSets(),
+      aggregation->groupId(),
+      aggregation->ignoreNullKeys(),
+      expand);
+}
+
+/// Returns a plan equivalent to 'planNode' if it is a single aggregation
+/// whose aggregates are all distinct over the same input columns, or nullptr
+/// otherwise. Distinct aggregates keep a set of the inputs per group and
+/// aggregate, which can not be spilled by hash partition. The returned plan
+/// instead removes duplicates with a hash aggregation on the grouping keys
+/// and the input columns, then aggregates the result without distinct.
+/// Constant inputs and grouping keys as inputs are allowed. Masks and sorting
+/// keys are not.
+core::PlanNodePtr distinctAsGroupBy(const core::PlanNodePtr& planNode) {
+  auto aggregation =
+      std::dynamic_pointer_cast<const core::AggregationNode>(planNode);
+  if (!aggregation ||
+      aggregation->step() != core::AggregationNode::Step::kSingle ||
+      aggregation->isPreGrouped() || aggregation->aggregates().empty()) {
+    return nullptr;
+  }
+
+  auto keys = aggregation->groupingKeys();
+  std::unordered_set<std::string> keyNames;
+  for (const auto& key : keys) {
+    keyNames.insert(key->name());
+  }
+  std::vector<std::string> distinctInputs;
+  auto aggregates = aggregation->aggregates();
+  for (auto i = 0; i < aggregates.size(); ++i) {
+    auto& aggregate = aggregates[i];
+    if (!aggregate.distinct || aggregate.mask ||
+        !aggregate.sortingKeys.empty()) {
+      return nullptr;
+    }
+    std::vector<std::string> inputs;
+    for (const auto& input : aggregate.call->inputs()) {
+      if (auto field = core::TypedExprs::asFieldAccess(input)) {
+        inputs.push_back(field->name());
+        if (i == 0 && keyNames.insert(field->name()).second) {
+          keys.push_back(field);
+        }
+      } else if (!core::TypedExprs::isConstant(input)) {
+        return nullptr;
+      }
+    }
+    if (i == 0) {
+      distinctInputs = std::move(inputs);
+    } else if (inputs != distinctInputs) {
+      return nullptr;
+    }
+    aggregate.distinct = false;
+  }
+
+  auto distinct = std::make_shared<core::AggregationNode>(
+      fmt::format("{}.distinct", aggregation->id()),
+      core::AggregationNode::Step::kSingle,
+      keys,
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      std::vector<std::string>{},
+      std::vector<core::AggregationNode::Aggregate>{},
+      /*ignoreNullKeys=*/false,
+      aggregation->sources()[0]);
+  return std::make_shared<core::AggregationNode>(
+      aggregation->id(),
+      core::AggregationNode::Step::kSingle,
+      aggregation->groupingKeys(),
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      aggregation->aggregateNames(),
+      aggregates,
+      aggregation->globalGroupingSets(),
+      aggregation->groupId(),
+      aggregation->ignoreNullKeys(),
+      distinct);
+}
+
+/// Plan rewrites enabled by the query config.
+struct PlanRewrites {
+  bool rollUpGroupingSets{false};
+  bool distinctAsGroupBy{false};
+};
+
+/// Returns an equivalent of 'planNode' with the first applicable one of
+/// 'rewrites', or nullptr if none applies.
+core::PlanNodePtr rewrite(
+    const core::PlanNodePtr& planNode,
+    const PlanRewrites& rewrites) {
+  core::PlanNodePtr result;
+  if (rewrites.rollUpGroupingSets) {
+    result = rollUpGroupingSets(planNode);
+  }
+  if (!result && rewrites.distinctAsGroupBy) {
+    result = distinctAsGroupBy(planNode);
+  }
+  return result;
+}
+
 void plan(
     const std::shared_ptr<const core::PlanNode>& planNode,
     std::vector<std::shared_ptr<const core::PlanNode>>* currentPlanNodes,
     const std::shared_ptr<const core::PlanNode>& consumerNode,
     OperatorSupplier consumerSupplier,
-    std::vector<std::unique_ptr<DriverFactory>>* driverFactories) {
+    std::vector<std::unique_ptr<DriverFactory>>* driverFactories,
+    const PlanRewrites& rewrites) {
+  if (auto rewritten = rewrite(planNode, rewrites)) {
+    plan(
+        rewritten,
+        currentPlanNodes,
+        consumerNode,
+        std::move(consumerSupplier),
+        driverFactories,
+        rewrites);
+    return;
+  }
+
   if (!currentPlanNodes) {
     driverFactories->push_back(std::make_unique<DriverFactory>());
     currentPlanNodes = &driverFactories->back()->planNodes;
@@ -155,7 +380,8 @@ void plan(
           mustStartNewPipeline(planNode, i) ? nullptr : currentPlanNodes,
           planNode,
           makeConsumerSupplier(planNode),
-          driverFactories);
+          driverFactories,
+          rewrites);
     }
   }
 
@@ -274,12 +500,21 @@ void LocalPlanner::plan(
       adapter.inspect(planFragment);
     }
   }
+  // Grouped execution matches pipelines by their plan nodes, which the
+  // rewrites replace.
+  detail::PlanRewrites rewrites;
+  if (!planFragment.isGroupedExecution()) {
+    rewrites.rollUpGroupingSets = queryConfig.groupingSetsRollupEnabled();
+    rewrites.distinctAsGroupBy =
+        queryConfig.distinctAggregationAsGroupByEnabled();
+  }
   detail::plan(
       planFragment.planNode,
       nullptr,
       nullptr,
       detail::makeConsumerSupplier(consumerSupplier),
-      driverFactories);
+      driverFactories,
+      rewrites);
 
   (*driverFactories)[0]->outputDriver = true;
 
@@ -293,6 +528,24 @@ void LocalPlanner::plan(
     factory->maxDrivers = detail::maxDrivers(*factory, queryConfig);
     factory->numDrivers = std::min(factory->maxDrivers, maxDrivers);
 
+    // Elastic pipelines get drivers up to the configured maximum. The ones
+    // above the usual number start parked.
+    if (queryConfig.elasticDriversEnabled() && maxDrivers > 1 &&
+        factory->supportsElasticDrivers()) {
+      const auto configuredMax = queryConfig.elasticDriversMaxPerPipeline();
+      const uint32_t upper = configuredMax > 0
+          ? std::min<uint32_t>(configuredMax, factory->maxDrivers)
+          : factory->numDrivers;
+      const uint32_t lower = std::clamp<uint32_t>(
+          queryConfig.elasticDriversMinPerPipeline(), 1, upper);
+      if (lower < upper) {
+        factory->minElasticDrivers = lower;
+        factory->numInitialElasticDrivers =
+            std::clamp(factory->numDrivers, lower, upper);
+        factory->numDrivers = upper;
+      }
+    }
+
     // Pipelines running grouped/bucketed execution would have separate groups
     // of drivers dealing with separate split groups (one driver can access
     // splits from only one designated split group), hence we will have total
@@ -414,6 +667,18 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
   std::vector<std::unique_ptr<Operator>> operators;
   operators.reserve(planNodes.size());
 
+  // Adds a CoalesceBatches after the operator just made for
+  // 'planNodes[first]' to 'planNodes[last]' if enabled and useful.
+  const bool coalesceBatches = ctx->queryConfig().coalesceBatches();
+  auto maybeCoalesceBatches = [&](int32_t first, int32_t last) {
+    if (coalesceBatches &&
+        CoalesceBatches::mayProduceSmallBatches(*planNodes[first]) &&
+        (last < planNodes.size() - 1 || consumerSupplier)) {
+      operators.push_back(std::make_unique<CoalesceBatches>(
+          operators.size(), ctx.get(), planNodes[last]));
+    }
+  };
+
   for (int32_t i = 0; i < planNodes.size(); i++) {
     // Id of the Operator being made. This is not the same as 'i'
     // because some PlanNodes may get fused.
@@ -427,6 +692,7 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
                 std::dynamic_pointer_cast<const core::ProjectNode>(next)) {
           operators.push_back(std::make_unique<FilterProject>(
               id, ctx.get(), filterNode, projectNode));
+          maybeCoalesceBatches(i, i + 1);
           i++;
           continue;
         }
@@ -600,6 +866,7 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
       VELOX_CHECK(extended, "Unsupported plan node: {}", planNode->toString());
       operators.push_back(std::move(extended));
     }
+    maybeCoalesceBatches(i, i);
   }
   if (consumerSupplier) {
     operators.push_back(consumerSupplier(operators.size(), ctx.get()));
@@ -670,6 +937,48 @@ std::vector<core::PlanNodeId> DriverFactory::needsHashJoinBridges() const {
   return planNodeIds;
 }
 
+bool DriverFactory::supportsElasticDrivers() const {
+  VELOX_CHECK(!planNodes.empty());
+  if (groupedExecution ||
+      !std::dynamic_pointer_cast<const core::TableScanNode>(
+          planNodes.front())) {
+    return false;
+  }
+  // The drivers of a HashBuild or local merge wait for each other. A local
+  // partition gets rows from any number of producers.
+  if (consumerNode != nullptr &&
+      !std::dynamic_pointer_cast<const core::LocalPartitionNode>(
+          consumerNode)) {
+    return false;
+  }
+  for (auto i = 1; i < planNodes.size(); ++i) {
+    const auto& node = planNodes[i];
+    if (std::dynamic_pointer_cast<const core::FilterNode>(node) ||
+        std::dynamic_pointer_cast<const core::ProjectNode>(node) ||
+        std::dynamic_pointer_cast<const core::PartitionedOutputNode>(node)) {
+      continue;
+    }
+    if (auto aggregation =
+            std::dynamic_pointer_cast<const core::AggregationNode>(node)) {
+      if (aggregation->step() == core::AggregationNode::Step::kPartial) {
+        continue;
+      }
+      return false;
+    }
+    if (auto join = std::dynamic_pointer_cast<const core::HashJoinNode>(node)) {
+      // The probes of joins that produce the misses of the build side wait
+      // for their peers.
+      if (join->isInnerJoin() || join->isLeftJoin() ||
+          join->isLeftSemiFilterJoin()) {
+        continue;
+      }
+      return false;
+    }
+    return false;
+  }
+  return true;
+}
+
 std::vector<core::PlanNodeId> DriverFactory::needsNestedLoopJoinBridges()
     const {
   std::vector<core::PlanNodeId> planNodeIds;
@@ -16,9 +16,9 @@
 
 #include "velox/exec/MarkDistinct.h"
 #include "velox/common/base/Range.h"
+#include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/vector/FlatVector.h"
 
-#include <algorithm>
 #include <utility>
 
 namespace facebook::velox::exec {
@@ -32,34 +32,89 @@ MarkDistinct::MarkDistinct(
           planNode->outputType(),
           operatorId,
           planNode->id(),
-          "MarkDistinct") {
-  const auto& inputType = planNode->sources()[0]->outputType();
-
+          "MarkDistinct",
+          planNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
+      inputType_{planNode->sources()[0]->outputType()} {
   // Set all input columns as identity projection.
-  for (auto i = 0; i < inputType->size(); ++i) {
+  for (auto i = 0; i < inputType_->size(); ++i) {
     identityProjections_.emplace_back(i, i);
   }
 
   // We will use result[0] for distinct mask output.
-  resultProjections_.emplace_back(0, inputType->size());
-
-  groupingSet_ = GroupingSet::createForMarkDistinct(
-      inputType,
-      createVectorHashers(inputType, planNode->distinctKeys()),
-      operatorCtx_.get(),
-      &nonReclaimableSection_);
+  resultProjections_.emplace_back(0, inputType_->size());
+
+  table_ = std::make_unique<HashTable<false>>(
+      createVectorHashers(inputType_, planNode->distinctKeys()),
+      std::vector<Accumulator>{},
+      std::vector<TypePtr>{},
+      false, // allowDuplicates
+      false, // isJoinBuild
+      false, // hasProbedFlag
+      0, // minTableSizeForParallelJoinBuild
+      pool());
+  lookup_ = std::make_unique<HashLookup>(table_->hashers());
+
+  if (spillEnabled()) {
+    spiller_ = std::make_unique<HashTableInputSpiller>(
+        inputType_, spillConfig(), &spillStats_);
+  }
 
   results_.resize(1);
 }
 
 void MarkDistinct::addInput(RowVectorPtr input) {
-  groupingSet_->addInput(input, false /*mayPushdown*/);
+  ensureInputFits(input);
+
+  if (spiller_ != nullptr && spiller_->spilled()) {
+    spiller_->spillInput(input, pool());
+    return;
+  }
+
+  SelectivityVector rows(input->size());
+  table_->prepareForGroupProbe(
+      *lookup_,
+      input,
+      rows,
+      false,
+      BaseHashTable::kNoSpillInputStartPartitionBit);
+  table_->groupProbe(*lookup_);
 
   input_ = std::move(input);
 }
 
+void MarkDistinct::addSpillInput() {
+  spiller_->probeRestoredInput(*table_, *lookup_, input_);
+}
+
+void MarkDistinct::noMoreInput() {
+  Operator::noMoreInput();
+
+  if (spiller_ != nullptr && spiller_->spilled()) {
+    spiller_->finishInputSpill();
+    if (input_ == nullptr) {
+      restoreNextSpillPartition();
+    }
+  }
+}
+
+void MarkDistinct::restoreNextSpillPartition() {
+  // The keys seen before spilling are added back to the hash table, so that
+  // the spilled input rows with these keys are not marked as distinct.
+  const auto restored = spiller_->restoreNextPartition(
+      *table_,
+      *lookup_,
+      pool(),
+      [](const RowVectorPtr& /*data*/, const HashLookup& /*lookup*/) {},
+      input_);
+  if (restored) {
+    addSpillInput();
+  }
+}
+
 RowVectorPtr MarkDistinct::getOutput() {
-  if (isFinished() || !input_) {
+  if (!input_) {
     return nullptr;
   }
 
@@ -79,7 +134,7 @@ RowVectorPtr MarkDistinct::getOutput() {
       results_[0]->as<FlatVector<bool>>()->mutableRawValues<uint64_t>();
 
   bits::fillBits(resultBits, 0, outputSize, false);
-  for (const auto i : groupingSet_->hashLookup().newGroups) {
+  for (const auto i : lookup_->newGroups) {
     bits::setBit(resultBits, i, true);
   }
   auto output = fillOutput(outputSize, nullptr);
@@ -88,10 +143,69 @@ RowVectorPtr MarkDistinct::getOutput() {
   // allow for memory reuse.
   input_ = nullptr;
 
+  if (spiller_ != nullptr && spiller_->restoring()) {
+    if (spiller_->nextInput(input_)) {
+      addSpillInput();
+    } else {
+      table_->clear();
+      restoreNextSpillPartition();
+    }
+  } else if (noMoreInput_ && spiller_ != nullptr && spiller_->spilled()) {
+    // The input received before spilling has been output.
+    restoreNextSpillPartition();
+  }
+
   return output;
 }
 
 bool MarkDistinct::isFinished() {
-  return noMoreInput_ && !input_;
+  return noMoreInput_ && !input_ &&
+      (spiller_ == nullptr || !spiller_->restoring());
 }
+
+void MarkDistinct::ensureInputFits(const RowVectorPtr& input) {
+  if (!spillEnabled()) {
+    // Spilling is disabled.
+    return;
+  }
+
+  ensureHashTableInputFits(*this, spillConfig_.value(), *table_, input);
+}
+
+bool MarkDistinct::canReclaim() const {
+  return Operator::canReclaim() && !spiller_->spilled();
+}
+
+void MarkDistinct::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  VELOX_CHECK(canReclaim());
+  VELOX_CHECK(!nonReclaimableSection_);
+
+  if (table_->numDistinct() == 0) {
+    // Nothing to spill.
+    return;
+  }
+
+  spill();
+}
+
+void MarkDistinct::spill() {
+  VELOX_CHECK(spillEnabled());
+
+  spiller_->spillTable(*table_);
+  pool()->release();
+
+  // Input rows are spilled even if no rows with the same partition were in the
+  // hash table.
+  SpillPartitionNumSet spillPartitionSet;
+  for (auto i = 0; i < (1 << spillConfig_->numPartitionBits); ++i) {
+    spillPartitionSet.insert(i);
+  }
+  spiller_->setupInputSpiller(*table_, spillPartitionSet);
+
+  // 'input_' has already been added to the hash table, which was spilled with
+  // its keys. It is output as is since 'lookup_' has its distinct rows.
+}
+
 } // namespace facebook::velox::exec
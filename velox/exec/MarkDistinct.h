@@ -16,11 +16,19 @@
 
 #pragma once
 
-#include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashTable.h"
+#include "velox/exec/HashTableInputSpiller.h"
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
 
+/// Marks the first row of each distinct combination of the distinct keys. If
+/// spilling is triggered, the hash table of the keys seen so far and the rest
+/// of the input are spilled to partitions by the hash of the distinct keys.
+/// The spilled partitions are processed one at a time after all input is
+/// received, so the rows of a spilled partition are output after the rows that
+/// were not spilled. Spilling happens at most once: the keys of a restored
+/// partition must fit in memory.
 class MarkDistinct : public Operator {
  public:
   MarkDistinct(
@@ -29,7 +37,7 @@ class MarkDistinct : public Operator {
       const std::shared_ptr<const core::MarkDistinctNode>& planNode);
 
   bool preservesOrder() const override {
-    return true;
+    return !spillEnabled();
   }
 
   bool needsInput() const override {
@@ -38,6 +46,8 @@ class MarkDistinct : public Operator {
 
   void addInput(RowVectorPtr input) override;
 
+  void noMoreInput() override;
+
   RowVectorPtr getOutput() override;
 
   BlockingReason isBlocked(ContinueFuture* /*future*/) override {
@@ -46,8 +56,32 @@ class MarkDistinct : public Operator {
 
   bool isFinished() override;
 
+  /// Not reclaimable once spilled since recursive spilling is not supported.
+  bool canReclaim() const override;
+
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
  private:
-  // TODO: Document spilling configuration in spilling.rst.
-  std::unique_ptr<GroupingSet> groupingSet_;
+  bool spillEnabled() const {
+    return spillConfig_.has_value();
+  }
+
+  void ensureInputFits(const RowVectorPtr& input);
+
+  void addSpillInput();
+
+  void restoreNextSpillPartition();
+
+  void spill();
+
+  const RowTypePtr inputType_;
+
+  // Hash table of the distinct keys seen so far.
+  std::unique_ptr<BaseHashTable> table_;
+  std::unique_ptr<HashLookup> lookup_;
+
+  // Spills 'table_' and the input. Set if spilling is enabled.
+  std::unique_ptr<HashTableInputSpiller> spiller_;
 };
 } // namespace facebook::velox::exec
@@ -38,6 +38,9 @@ void MemoryReclaimer::enterArbitration() {
     // terminated.
     VELOX_FAIL("Terminate detected when entering suspension");
   }
+  if (const auto& timeline = driver->timeline()) {
+    timeline->startArbitration();
+  }
 }
 
 void MemoryReclaimer::leaveArbitration() noexcept {
@@ -48,6 +51,9 @@ void MemoryReclaimer::leaveArbitration() noexcept {
     return;
   }
   Driver* const driver = driverThreadCtx->driverCtx.driver;
+  if (const auto& timeline = driver->timeline()) {
+    timeline->endArbitration();
+  }
   driver->task()->leaveSuspended(driver->state());
 }
 
@@ -88,8 +88,8 @@ BlockingReason Merge::isBlocked(ContinueFuture* future) {
     return BlockingReason::kNotBlocked;
   }
 
-  // No merging is needed if there is only one source.
-  if (streams_.empty() && sources_.size() > 1) {
+  // No merging is needed if there is only one source or no sorting keys.
+  if (streams_.empty() && sources_.size() > 1 && !sortingKeys_.empty()) {
     initializeTreeOfLosers();
   }
 
@@ -117,18 +117,9 @@ RowVectorPtr Merge::getOutput() {
     return nullptr;
   }
 
-  // No merging is needed if there is only one source.
-  if (sources_.size() == 1) {
-    ContinueFuture future;
-    RowVectorPtr data;
-    auto reason = sources_[0]->next(data, &future);
-    if (reason != BlockingReason::kNotBlocked) {
-      sourceBlockingFutures_.emplace_back(std::move(future));
-      return nullptr;
-    }
-
-    finished_ = data == nullptr;
-    return data;
+  // No merging is needed if there is only one source or no sorting keys.
+  if (sources_.size() == 1 || sortingKeys_.empty()) {
+    return concatenateSources();
   }
 
   if (!output_) {
@@ -181,6 +172,24 @@ RowVectorPtr Merge::getOutput() {
   }
 }
 
+RowVectorPtr Merge::concatenateSources() {
+  while (currentSource_ < sources_.size()) {
+    ContinueFuture future;
+    RowVectorPtr data;
+    auto reason = sources_[currentSource_]->next(data, &future);
+    if (reason != BlockingReason::kNotBlocked) {
+      sourceBlockingFutures_.emplace_back(std::move(future));
+      return nullptr;
+    }
+    if (data != nullptr) {
+      return data;
+    }
+    ++currentSource_;
+  }
+  finished_ = true;
+  return nullptr;
+}
+
 void Merge::close() {
   for (auto& source : sources_) {
     source->close();
@@ -210,7 +219,7 @@ bool SourceStream::pop(std::vector<ContinueFuture>& futures) {
   ++currentSourceRow_;
   if (currentSourceRow_ == data_->size()) {
     // Make sure all current data has been copied out.
-    VELOX_CHECK(!outputRows_.hasSelections());
+    VELOX_CHECK(outputRanges_.empty());
     return fetchMoreData(futures);
   }
 
@@ -218,28 +227,14 @@ bool SourceStream::pop(std::vector<ContinueFuture>& futures) {
 }
 
 void SourceStream::copyToOutput(RowVectorPtr& output) {
-  outputRows_.updateBounds();
-
-  if (!outputRows_.hasSelections()) {
+  if (outputRanges_.empty()) {
     return;
   }
 
-  vector_size_t sourceRow = firstSourceRow_;
-  outputRows_.applyToSelected(
-      [&](auto row) { sourceRows_[row] = sourceRow++; });
-
   for (auto i = 0; i < output->type()->size(); ++i) {
-    output->childAt(i)->copy(
-        data_->childAt(i).get(), outputRows_, sourceRows_.data());
-  }
-
-  outputRows_.clearAll();
-
-  if (sourceRow == data_->size()) {
-    firstSourceRow_ = 0;
-  } else {
-    firstSourceRow_ = sourceRow;
+    output->childAt(i)->copyRanges(data_->childAt(i).get(), outputRanges_);
   }
+  outputRanges_.clear();
 }
 
 bool SourceStream::fetchMoreData(std::vector<ContinueFuture>& futures) {
@@ -283,6 +278,10 @@ LocalMerge::LocalMerge(
       operatorCtx_->driverCtx()->driverId,
       0,
       "LocalMerge needs to run single-threaded");
+  VELOX_CHECK(
+      !localMergeNode->sortingKeys().empty() ||
+          localMergeNode->sources().size() == 1,
+      "LocalMerge without sorting keys needs a single source");
 }
 
 BlockingReason LocalMerge::addMergeSources(ContinueFuture* /* future */) {
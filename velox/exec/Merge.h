@@ -25,7 +25,8 @@ class SourceStream;
 
 // Merge operator Implementation: This implementation uses priority queue
 // to perform a k-way merge of its inputs. It stops merging if any one of
-// its inputs is blocked.
+// its inputs is blocked. Without sorting keys, the inputs are concatenated in
+// the order of the sources.
 class Merge : public SourceOperator {
  public:
   Merge(
@@ -58,6 +59,10 @@ class Merge : public SourceOperator {
  private:
   void initializeTreeOfLosers();
 
+  // Returns the next batch of the first source that is not at end. Used when
+  // there is only one source or no sorting keys.
+  RowVectorPtr concatenateSources();
+
   /// Maximum number of rows in the output batch.
   const uint32_t outputBatchSize_;
 
@@ -77,6 +82,9 @@ class Merge : public SourceOperator {
 
   bool finished_{false};
 
+  /// Index of the source read by concatenateSources().
+  size_t currentSource_{0};
+
   /// A list of blocking futures for sources. These are populates when a given
   /// source is blocked waiting for the next batch of data.
   std::vector<ContinueFuture> sourceBlockingFutures_;
@@ -88,11 +96,9 @@ class SourceStream final : public MergeStream {
       MergeSource* source,
       const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys,
       uint32_t outputBatchSize)
-      : source_{source},
-        sortingKeys_{sortingKeys},
-        outputRows_(outputBatchSize, false),
-        sourceRows_(outputBatchSize) {
+      : source_{source}, sortingKeys_{sortingKeys} {
     keyColumns_.reserve(sortingKeys.size());
+    outputRanges_.reserve(outputBatchSize);
   }
 
   /// Returns true and appends a future to 'futures' if needs to wait for the
@@ -124,13 +130,20 @@ class SourceStream final : public MergeStream {
   /// call 'setOutputRow' before calling 'pop'. The output rows must
   /// monotonically increase in between calls to 'copyToOutput'.
   bool setOutputRow(vector_size_t row) {
-    outputRows_.setValid(row, true);
+    if (!outputRanges_.empty() &&
+        outputRanges_.back().targetIndex + outputRanges_.back().count == row) {
+      // Consecutive output rows from this stream are copied as one range.
+      ++outputRanges_.back().count;
+    } else {
+      outputRanges_.push_back({currentSourceRow_, row, 1});
+    }
     return currentSourceRow_ == data_->size() - 1;
   }
 
   /// Called if either current row is the last row in the current batch or the
   /// caller accumulated enough output rows across all sources to produce an
-  /// output batch.
+  /// output batch. Copies each run of consecutive output rows with one range
+  /// copy per column.
   void copyToOutput(RowVectorPtr& output);
 
  private:
@@ -157,19 +170,17 @@ class SourceStream final : public MergeStream {
   /// returned by 'source_->next()'.
   bool needData_{true};
 
-  /// First source row that hasn't been copied out yet.
-  vector_size_t firstSourceRow_{0};
-
-  /// Output row numbers for source rows that haven't been copied out yet.
-  SelectivityVector outputRows_;
-
-  /// Reusable memory.
-  std::vector<vector_size_t> sourceRows_;
+  /// The source rows that haven't been copied out yet and their output rows.
+  /// The source rows of a stream are consecutive, so each range is a run of
+  /// consecutive output rows.
+  std::vector<BaseVector::CopyRange> outputRanges_;
 };
 
 // LocalMerge merges its source's output into a single stream of
 // sorted rows. It runs single threaded. The sources may run multi-threaded and
-// in the same task.
+// in the same task. Without sorting keys, it concatenates the outputs of the
+// source drivers in driver order, e.g. the ranges of a range partitioned
+// LocalPartition sorted by one driver each.
 class LocalMerge : public Merge {
  public:
   LocalMerge(
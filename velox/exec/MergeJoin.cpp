@@ -163,9 +163,60 @@ bool MergeJoin::needsInput() const {
   return input_ == nullptr;
 }
 
+namespace {
+// Returns the first row of 'input' from which on none of 'keys' is null.
+vector_size_t firstRowWithoutNullKeys(
+    const RowVectorPtr& input,
+    const std::vector<column_index_t>& keys) {
+  vector_size_t start = 0;
+  for (auto key : keys) {
+    const auto& child = input->childAt(key);
+    if (!child->mayHaveNulls()) {
+      continue;
+    }
+    for (auto i = input->size(); i > start; --i) {
+      if (child->isNullAt(i - 1)) {
+        start = i;
+        break;
+      }
+    }
+  }
+  return start;
+}
+
+// Returns the first row in ('start', 'end') for which 'isBefore' is false or
+// 'end' if there is none. 'isBefore' is true for 'start' and does not change
+// from false to true over the rows. Probes rows at exponentially growing
+// distances from 'start' and then does a binary search between the last 2
+// probes, so that a run of n rows is skipped with O(log(n)) probes while
+// short runs take as many probes as a linear scan.
+template <typename IsBefore>
+vector_size_t
+gallop(vector_size_t start, vector_size_t end, IsBefore isBefore) {
+  vector_size_t low = start;
+  vector_size_t high = start + 1;
+  int64_t step = 1;
+  while (high < end && isBefore(high)) {
+    low = high;
+    step *= 2;
+    high = std::min<int64_t>(low + step, end);
+  }
+  while (high - low > 1) {
+    const auto middle = low + (high - low) / 2;
+    if (isBefore(middle)) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  return high;
+}
+} // namespace
+
 void MergeJoin::addInput(RowVectorPtr input) {
   input_ = std::move(input);
   index_ = 0;
+  leftGallopStart_ = firstRowWithoutNullKeys(input_, leftKeys_);
 
   if (leftJoinTracker_) {
     leftJoinTracker_->resetLastVector();
@@ -467,6 +518,7 @@ RowVectorPtr MergeJoin::getOutput() {
 
         if (rightInput_) {
           rightIndex_ = firstNonNull(rightInput_, rightKeys_);
+          rightGallopStart_ = firstRowWithoutNullKeys(rightInput_, rightKeys_);
           if (rightIndex_ == rightInput_->size()) {
             // Ran out of rows on the right side.
             rightInput_ = nullptr;
@@ -604,7 +656,21 @@ RowVectorPtr MergeJoin::doGetOutput() {
         addOutputRowForLeftJoin(input_, index_);
       }
 
-      ++index_;
+      if (!isLeftJoin(joinType_) && index_ >= leftGallopStart_) {
+        // Skip the rows before the right side key. A batch that ends before
+        // the right side key is skipped with O(log(n)) comparisons.
+        index_ = gallop(index_, input_->size(), [&](vector_size_t row) {
+          return compare(
+                     leftKeys_,
+                     input_,
+                     row,
+                     rightKeys_,
+                     rightInput_,
+                     rightIndex_) < 0;
+        });
+      } else {
+        ++index_;
+      }
       if (index_ == input_->size()) {
         // Ran out of rows on the left side.
         input_ = nullptr;
@@ -615,7 +681,20 @@ RowVectorPtr MergeJoin::doGetOutput() {
 
     // Catch up rightInput_ with input_.
     while (compareResult > 0) {
-      rightIndex_ = firstNonNull(rightInput_, rightKeys_, rightIndex_ + 1);
+      if (rightIndex_ >= rightGallopStart_) {
+        rightIndex_ =
+            gallop(rightIndex_, rightInput_->size(), [&](vector_size_t row) {
+              return compare(
+                         leftKeys_,
+                         input_,
+                         index_,
+                         rightKeys_,
+                         rightInput_,
+                         row) > 0;
+            });
+      } else {
+        rightIndex_ = firstNonNull(rightInput_, rightKeys_, rightIndex_ + 1);
+      }
       if (rightIndex_ == rightInput_->size()) {
         // Ran out of rows on the right side.
         rightInput_ = nullptr;
@@ -628,8 +707,14 @@ RowVectorPtr MergeJoin::doGetOutput() {
       // Found a match. Identify all rows on the left and right that have the
       // matching keys.
       vector_size_t endIndex = index_ + 1;
-      while (endIndex < input_->size() && compareLeft(endIndex) == 0) {
-        ++endIndex;
+      if (index_ >= leftGallopStart_) {
+        endIndex = gallop(index_, input_->size(), [&](vector_size_t row) {
+          return compareLeft(row) == 0;
+        });
+      } else {
+        while (endIndex < input_->size() && compareLeft(endIndex) == 0) {
+          ++endIndex;
+        }
       }
 
       if (endIndex == input_->size()) {
@@ -640,9 +725,16 @@ RowVectorPtr MergeJoin::doGetOutput() {
           {input_}, index_, endIndex, endIndex < input_->size(), std::nullopt};
 
       vector_size_t endRightIndex = rightIndex_ + 1;
-      while (endRightIndex < rightInput_->size() &&
-             compareRight(endRightIndex) == 0) {
-        ++endRightIndex;
+      if (rightIndex_ >= rightGallopStart_) {
+        endRightIndex =
+            gallop(rightIndex_, rightInput_->size(), [&](vector_size_t row) {
+              return compareRight(row) == 0;
+            });
+      } else {
+        while (endRightIndex < rightInput_->size() &&
+               compareRight(endRightIndex) == 0) {
+          ++endRightIndex;
+        }
       }
 
       rightMatch_ = Match{
@@ -392,6 +392,14 @@ class MergeJoin : public Operator {
   // Row number on the right side (rightInput_) to process next.
   vector_size_t rightIndex_{0};
 
+  // First row of input_ from which on no join key is null. The rows from here
+  // on are ordered by the join keys, so that these can be skipped with a
+  // galloping search.
+  vector_size_t leftGallopStart_{0};
+
+  // Same as 'leftGallopStart_' for rightInput_.
+  vector_size_t rightGallopStart_{0};
+
   // A set of rows with matching keys on the left side.
   std::optional<Match> leftMatch_;
 
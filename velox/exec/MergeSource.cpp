@@ -124,6 +124,7 @@ class MergeExchangeSource : public MergeSource {
       memory::MemoryPool* pool,
       folly::Executor* executor)
       : mergeExchange_(mergeExchange),
+        maxQueuedBytes_(maxQueuedBytes),
         client_(std::make_shared<ExchangeClient>(
             mergeExchange->taskId(),
             destination,
@@ -137,14 +138,15 @@ class MergeExchangeSource : public MergeSource {
   BlockingReason next(RowVectorPtr& data, ContinueFuture* future) override {
     data.reset();
 
+    if (!currentPage_) {
+      currentPage_ = std::move(nextPage_);
+    }
     if (atEnd_ && !currentPage_) {
       return BlockingReason::kNotBlocked;
     }
 
     if (!currentPage_) {
-      auto pages = client_->next(1, &atEnd_, future);
-      VELOX_CHECK_LE(pages.size(), 1);
-      currentPage_ = pages.empty() ? nullptr : std::move(pages.front());
+      currentPage_ = nextPage(future);
 
       if (!currentPage_) {
         if (atEnd_) {
@@ -156,6 +158,7 @@ class MergeExchangeSource : public MergeSource {
     if (!inputStream_.has_value()) {
       mergeExchange_->stats().wlock()->rawInputBytes += currentPage_->size();
       inputStream_.emplace(currentPage_->prepareStreamForDeserialize());
+      prefetch();
     }
 
     if (!inputStream_->atEnd()) {
@@ -186,13 +189,44 @@ class MergeExchangeSource : public MergeSource {
       client_->close();
       client_ = nullptr;
     }
+    nextPage_ = nullptr;
   }
 
  private:
+  // Returns the next page from 'client_' or nullptr with 'future' set if
+  // there is none yet.
+  std::unique_ptr<SerializedPage> nextPage(ContinueFuture* future) {
+    auto pages = client_->next(1, &atEnd_, future);
+    VELOX_CHECK_LE(pages.size(), 1);
+    return pages.empty() ? nullptr : std::move(pages.front());
+  }
+
+  // Takes the page after 'currentPage_' out of 'client_' while
+  // 'currentPage_' is merged, so that 'client_' requests the next one
+  // without waiting for the merge to run out of rows of this source. Skipped
+  // if two pages like the current one do not fit in the memory budget of the
+  // source.
+  void prefetch() {
+    if (nextPage_ != nullptr || atEnd_ ||
+        2 * currentPage_->size() > maxQueuedBytes_) {
+      return;
+    }
+    // The merge does not wait for the page to arrive.
+    ContinueFuture future;
+    nextPage_ = nextPage(&future);
+    if (nextPage_ != nullptr) {
+      mergeExchange_->stats().wlock()->addRuntimeStat(
+          "prefetchedPages", RuntimeCounter(1));
+    }
+  }
+
   MergeExchange* const mergeExchange_;
+  const int64_t maxQueuedBytes_;
   std::shared_ptr<ExchangeClient> client_;
   std::optional<ByteInputStream> inputStream_;
   std::unique_ptr<SerializedPage> currentPage_;
+  // Page after 'currentPage_' if prefetched.
+  std::unique_ptr<SerializedPage> nextPage_;
   bool atEnd_ = false;
 
   BlockingReason enqueue(RowVectorPtr input, ContinueFuture* future) override {
@@ -50,7 +50,9 @@ NestedLoopJoinBuild::NestedLoopJoinBuild(
           nullptr,
           operatorId,
           joinNode->id(),
-          "NestedLoopJoinBuild") {}
+          "NestedLoopJoinBuild"),
+      minStringLiveRatio_(
+          driverCtx->queryConfig().retainedStringBufferMinLiveRatio()) {}
 
 void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
   if (input->size() > 0) {
@@ -58,6 +60,10 @@ void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
     for (auto& child : input->children()) {
       child->loadedVector();
     }
+    if (minStringLiveRatio_ > 0) {
+      input = std::static_pointer_cast<RowVector>(
+          BaseVector::compactStringBuffers(input, minStringLiveRatio_));
+    }
     dataVectors_.emplace_back(std::move(input));
   }
 }
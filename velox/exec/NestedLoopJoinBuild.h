@@ -59,6 +59,9 @@ class NestedLoopJoinBuild : public Operator {
   }
 
  private:
+  // See QueryConfig::kRetainedStringBufferMinLiveRatio.
+  const double minStringLiveRatio_;
+
   std::vector<RowVectorPtr> dataVectors_;
 
   // Future for synchronizing with other Drivers of the same pipeline. All build
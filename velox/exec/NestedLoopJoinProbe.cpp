@@ -42,6 +42,69 @@ std::vector<IdentityProjection> extractProjections(
   }
   return projections;
 }
+
+bool isRangeKeyType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the value at 'row' of 'decoded' as an integer with the same order.
+// The difference of two such integers does not overflow.
+int128_t rangeKey(const DecodedVector& decoded, vector_size_t row) {
+  switch (decoded.base()->typeKind()) {
+    case TypeKind::TINYINT:
+      return decoded.valueAt<int8_t>(row);
+    case TypeKind::SMALLINT:
+      return decoded.valueAt<int16_t>(row);
+    case TypeKind::INTEGER:
+      return decoded.valueAt<int32_t>(row);
+    case TypeKind::BIGINT:
+      return decoded.valueAt<int64_t>(row);
+    case TypeKind::TIMESTAMP: {
+      const auto value = decoded.valueAt<Timestamp>(row);
+      return static_cast<int128_t>(value.getSeconds()) * 1'000'000'000 +
+          value.getNanos();
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+void collectConjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<core::CallTypedExprPtr>& conjuncts) {
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  if (call == nullptr) {
+    return;
+  }
+  if (call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      collectConjuncts(input, conjuncts);
+    }
+    return;
+  }
+  conjuncts.push_back(call);
+}
+
+std::optional<column_index_t> inputChannel(
+    const core::TypedExprPtr& expr,
+    const RowTypePtr& type) {
+  auto field =
+      std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(expr);
+  if (field == nullptr || !field->isInputColumn() ||
+      !isRangeKeyType(field->type())) {
+    return std::nullopt;
+  }
+  return type->getChildIdxIfExists(field->name());
+}
 } // namespace
 
 NestedLoopJoinProbe::NestedLoopJoinProbe(
@@ -72,6 +135,10 @@ void NestedLoopJoinProbe::initialize() {
         joinNode_->joinCondition(),
         joinNode_->sources()[0]->outputType(),
         joinNode_->sources()[1]->outputType());
+    initializeRangeCondition(
+        joinNode_->joinCondition(),
+        joinNode_->sources()[0]->outputType(),
+        joinNode_->sources()[1]->outputType());
   }
 
   joinNode_.reset();
@@ -96,6 +163,9 @@ BlockingReason NestedLoopJoinProbe::isBlocked(ContinueFuture* future) {
         return BlockingReason::kWaitForJoinBuild;
       }
       VELOX_CHECK(buildVectors_.has_value());
+      if (rangeCondition_.has_value()) {
+        buildRangeIndices();
+      }
 
       if (needsBuildMismatch(joinType_)) {
         buildMatched_.resize(buildVectors_->size());
@@ -117,6 +187,7 @@ void NestedLoopJoinProbe::close() {
     joinCondition_->clear();
   }
   buildVectors_.reset();
+  rangeIndices_.clear();
   Operator::close();
 }
 
@@ -132,6 +203,11 @@ void NestedLoopJoinProbe::addInput(RowVectorPtr input) {
   if (needsProbeMismatch(joinType_)) {
     probeMatched_.resizeFill(input_->size(), false);
   }
+  if (rangeCondition_.has_value()) {
+    probeRangeKeys_.decode(
+        *input_->childAt(rangeCondition_->probeChannel),
+        SelectivityVector(input_->size()));
+  }
 }
 
 RowVectorPtr NestedLoopJoinProbe::getOutput() {
@@ -178,7 +254,9 @@ RowVectorPtr NestedLoopJoinProbe::getOutput() {
       break;
     }
 
-    const vector_size_t probeCnt = getNumProbeRows();
+    const vector_size_t probeCnt = rangeCondition_.has_value()
+        ? getNumRangeProbeRows()
+        : getNumProbeRows();
     output = doMatch(probeCnt);
     if (advanceProbeRows(probeCnt)) {
       if (!needsProbeMismatch(joinType_)) {
@@ -232,6 +310,75 @@ void NestedLoopJoinProbe::initializeFilter(
   filterInputType_ = ROW(std::move(names), std::move(types));
 }
 
+void NestedLoopJoinProbe::initializeRangeCondition(
+    const core::TypedExprPtr& filter,
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType) {
+  std::vector<core::CallTypedExprPtr> conjuncts;
+  collectConjuncts(filter, conjuncts);
+
+  // Lower and upper bounds found so far for each probe channel.
+  std::unordered_map<
+      column_index_t,
+      std::pair<
+          std::optional<column_index_t>,
+          std::optional<column_index_t>>>
+      bounds;
+  auto addBound = [&](column_index_t probeChannel,
+                      column_index_t buildChannel,
+                      bool isLower) {
+    if (!probeType->childAt(probeChannel)
+             ->equivalent(*buildType->childAt(buildChannel))) {
+      return;
+    }
+    auto& [lower, upper] = bounds[probeChannel];
+    if (isLower) {
+      lower = buildChannel;
+    } else {
+      upper = buildChannel;
+    }
+    if (lower.has_value() && upper.has_value()) {
+      rangeCondition_ =
+          RangeCondition{probeChannel, lower.value(), upper.value()};
+    }
+  };
+
+  for (const auto& conjunct : conjuncts) {
+    if (rangeCondition_.has_value()) {
+      return;
+    }
+    const auto& inputs = conjunct->inputs();
+    const auto& name = conjunct->name();
+    if (name == "between" && inputs.size() == 3) {
+      auto probeChannel = inputChannel(inputs[0], probeType);
+      auto lowerChannel = inputChannel(inputs[1], buildType);
+      auto upperChannel = inputChannel(inputs[2], buildType);
+      if (probeChannel.has_value() && lowerChannel.has_value() &&
+          upperChannel.has_value()) {
+        addBound(probeChannel.value(), lowerChannel.value(), true);
+        addBound(probeChannel.value(), upperChannel.value(), false);
+      }
+      continue;
+    }
+    const bool isGreater = name == "gt" || name == "gte";
+    const bool isLess = name == "lt" || name == "lte";
+    if (!(isGreater || isLess) || inputs.size() != 2) {
+      continue;
+    }
+    auto probeChannel = inputChannel(inputs[0], probeType);
+    auto buildChannel = inputChannel(inputs[1], buildType);
+    if (probeChannel.has_value() && buildChannel.has_value()) {
+      addBound(probeChannel.value(), buildChannel.value(), isGreater);
+      continue;
+    }
+    probeChannel = inputChannel(inputs[1], probeType);
+    buildChannel = inputChannel(inputs[0], buildType);
+    if (probeChannel.has_value() && buildChannel.has_value()) {
+      addBound(probeChannel.value(), buildChannel.value(), isLess);
+    }
+  }
+}
+
 RowVectorPtr NestedLoopJoinProbe::getMismatchedOutput(
     const RowVectorPtr& data,
     const SelectivityVector& matched,
@@ -341,6 +488,43 @@ bool NestedLoopJoinProbe::getBuildData(ContinueFuture* future) {
   return true;
 }
 
+void NestedLoopJoinProbe::buildRangeIndices() {
+  VELOX_CHECK(rangeCondition_.has_value());
+  const auto& buildVectors = buildVectors_.value();
+  rangeIndices_.resize(buildVectors.size());
+  DecodedVector lowers;
+  DecodedVector uppers;
+  std::vector<int128_t> keys;
+  for (auto i = 0; i < buildVectors.size(); ++i) {
+    const auto& vector = buildVectors[i];
+    auto& index = rangeIndices_[i];
+    const SelectivityVector rows(vector->size());
+    lowers.decode(*vector->childAt(rangeCondition_->lowerChannel), rows);
+    uppers.decode(*vector->childAt(rangeCondition_->upperChannel), rows);
+    keys.resize(vector->size());
+    // Rows with a null bound can not match.
+    for (auto row = 0; row < vector->size(); ++row) {
+      if (lowers.isNullAt(row) || uppers.isNullAt(row)) {
+        continue;
+      }
+      keys[row] = rangeKey(lowers, row);
+      index.maxWidth =
+          std::max(index.maxWidth, rangeKey(uppers, row) - keys[row]);
+      index.rows.push_back(row);
+    }
+    std::sort(
+        index.rows.begin(),
+        index.rows.end(),
+        [&](vector_size_t left, vector_size_t right) {
+          return keys[left] < keys[right];
+        });
+    index.lowers.reserve(index.rows.size());
+    for (auto row : index.rows) {
+      index.lowers.push_back(keys[row]);
+    }
+  }
+}
+
 vector_size_t NestedLoopJoinProbe::getNumProbeRows() const {
   VELOX_CHECK_NOT_NULL(input_);
   VELOX_CHECK(!hasProbedAllBuildData());
@@ -357,6 +541,83 @@ vector_size_t NestedLoopJoinProbe::getNumProbeRows() const {
   return numProbeRows;
 }
 
+vector_size_t NestedLoopJoinProbe::getNumRangeProbeRows() {
+  VELOX_CHECK_NOT_NULL(input_);
+  VELOX_CHECK(!hasProbedAllBuildData());
+
+  const auto& index = rangeIndices_[buildIndex_];
+  const auto& lowers = index.lowers;
+  candidateRanges_.clear();
+  vector_size_t numCandidates{0};
+  for (auto row = probeRow_; row < input_->size(); ++row) {
+    vector_size_t begin{0};
+    vector_size_t end{0};
+    if (!probeRangeKeys_.isNullAt(row)) {
+      const auto key = rangeKey(probeRangeKeys_, row);
+      end = std::upper_bound(lowers.begin(), lowers.end(), key) -
+          lowers.begin();
+      begin = std::lower_bound(
+                  lowers.begin(), lowers.begin() + end, key - index.maxWidth) -
+          lowers.begin();
+    }
+    if (!candidateRanges_.empty() &&
+        numCandidates + (end - begin) > (vector_size_t)outputBatchSize_) {
+      break;
+    }
+    candidateRanges_.emplace_back(begin, end);
+    numCandidates += end - begin;
+  }
+  return candidateRanges_.size();
+}
+
+RowVectorPtr NestedLoopJoinProbe::getRangeCandidates(vector_size_t probeCnt) {
+  VELOX_CHECK_EQ(probeCnt, candidateRanges_.size());
+
+  vector_size_t numCandidates{0};
+  for (const auto& [begin, end] : candidateRanges_) {
+    numCandidates += end - begin;
+  }
+  if (numCandidates == 0) {
+    return nullptr;
+  }
+
+  auto rawProbeIndices =
+      initializeRowNumberMapping(probeIndices_, numCandidates, pool());
+  auto rawBuildIndices =
+      initializeRowNumberMapping(buildIndices_, numCandidates, pool());
+  const auto& rows = rangeIndices_[buildIndex_].rows;
+  vector_size_t candidate{0};
+  for (auto i = 0; i < probeCnt; ++i) {
+    const auto [begin, end] = candidateRanges_[i];
+    for (auto j = begin; j < end; ++j) {
+      rawProbeIndices[candidate] = probeRow_ + i;
+      rawBuildIndices[candidate] = rows[j];
+      ++candidate;
+    }
+  }
+
+  std::vector<VectorPtr> projectedChildren(filterInputType_->size());
+  projectChildren(
+      projectedChildren,
+      input_,
+      filterProbeProjections_,
+      numCandidates,
+      probeIndices_);
+  projectChildren(
+      projectedChildren,
+      buildVectors_.value()[buildIndex_],
+      filterBuildProjections_,
+      numCandidates,
+      buildIndices_);
+
+  return std::make_shared<RowVector>(
+      pool(),
+      filterInputType_,
+      nullptr,
+      numCandidates,
+      std::move(projectedChildren));
+}
+
 RowVectorPtr NestedLoopJoinProbe::getCrossProduct(
     vector_size_t probeCnt,
     const RowTypePtr& outputType,
@@ -431,11 +692,16 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
         probeCnt, outputType_, identityProjections_, buildProjections_);
   }
 
-  auto filterInput = getCrossProduct(
-      probeCnt,
-      filterInputType_,
-      filterProbeProjections_,
-      filterBuildProjections_);
+  auto filterInput = rangeCondition_.has_value()
+      ? getRangeCandidates(probeCnt)
+      : getCrossProduct(
+            probeCnt,
+            filterInputType_,
+            filterProbeProjections_,
+            filterBuildProjections_);
+  if (filterInput == nullptr) {
+    return nullptr;
+  }
 
   if (filterInputRows_.size() != filterInput->size()) {
     filterInputRows_.resizeFill(filterInput->size(), true);
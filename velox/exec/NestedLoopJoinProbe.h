@@ -56,12 +56,34 @@ class NestedLoopJoinProbe : public Operator {
       const RowTypePtr& leftType,
       const RowTypePtr& rightType);
 
+  // Sets 'rangeCondition_' if 'filter' has conjuncts that bound a probe column
+  // from below and above by build columns, e.g. 'p BETWEEN b0 AND b1' or
+  // 'p >= b0 AND p < b1'.
+  void initializeRangeCondition(
+      const core::TypedExprPtr& filter,
+      const RowTypePtr& probeType,
+      const RowTypePtr& buildType);
+
   bool getBuildData(ContinueFuture* future);
 
+  // Makes 'rangeIndices_' for 'buildVectors_'.
+  void buildRangeIndices();
+
   // Calculates the number of probe rows to match with the build side vectors
   // given the output batch size limit.
   vector_size_t getNumProbeRows() const;
 
+  // Range join counterpart of getNumProbeRows(). Finds the build rows that may
+  // match each probe row from 'probeRow_' on and records them in
+  // 'candidateRanges_' until the number of candidate pairs reaches the output
+  // batch size. Returns the number of probe rows with recorded candidates.
+  vector_size_t getNumRangeProbeRows();
+
+  // Range join counterpart of getCrossProduct(). Returns the candidate pairs of
+  // the next 'probeCnt' probe rows and the build vector at 'buildIndex_' as
+  // input for the join condition, or nullptr if there are none.
+  RowVectorPtr getRangeCandidates(vector_size_t probeCnt);
+
   // Generates cross product of next 'probeCnt' rows of input_, and all rows of
   // build side vector at 'buildIndex_' in 'buildData_'.
   // 'outputType' specifies the type of output.
@@ -78,8 +100,8 @@ class NestedLoopJoinProbe : public Operator {
       const std::vector<IdentityProjection>& buildProjections);
 
   // Evaluates joinCondition against the output of getCrossProduct(probeCnt),
-  // returns the result that passed joinCondition, updates probeMatched_,
-  // buildMatched_ accordingly.
+  // or getRangeCandidates(probeCnt) for range joins, returns the result that
+  // passed joinCondition, updates probeMatched_, buildMatched_ accordingly.
   RowVectorPtr doMatch(vector_size_t probeCnt);
 
   // Updates 'probeRow_' and 'buildIndex_' by advancing 'probeRow_' by probeCnt.
@@ -134,6 +156,34 @@ class NestedLoopJoinProbe : public Operator {
   RowTypePtr filterInputType_;
   SelectivityVector filterInputRows_;
 
+  // Channels of a probe column and the build columns that are its lower and
+  // upper bounds in the join condition.
+  struct RangeCondition {
+    column_index_t probeChannel;
+    column_index_t lowerChannel;
+    column_index_t upperChannel;
+  };
+
+  // The build rows of one build vector with non-null bounds, ordered by lower
+  // bound. A probe value 'x' can only match rows with lower bounds in
+  // [x - maxWidth, x].
+  struct RangeIndex {
+    std::vector<vector_size_t> rows;
+    std::vector<int128_t> lowers;
+    int128_t maxWidth{0};
+  };
+
+  // Set if the join condition implies a range condition. Then the join
+  // condition is evaluated only on the pairs of probe and build rows that
+  // 'rangeIndices_' finds instead of on the cross product.
+  std::optional<RangeCondition> rangeCondition_;
+  std::vector<RangeIndex> rangeIndices_;
+  // Probe values of 'rangeCondition_' for 'input_'.
+  DecodedVector probeRangeKeys_;
+  // Begin and end in the RangeIndex of the candidate build rows for each probe
+  // row from 'probeRow_' on.
+  std::vector<std::pair<vector_size_t, vector_size_t>> candidateRanges_;
+
   // Probe side state
   // Input row to process on next call to getOutput().
   vector_size_t probeRow_{0};
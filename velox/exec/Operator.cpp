@@ -18,6 +18,7 @@
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/Driver.h"
 #include "velox/exec/HashJoinBridge.h"
 #include "velox/exec/OperatorUtils.h"
@@ -85,7 +86,9 @@ Operator::Operator(
           operatorId,
           driverCtx->pipelineId,
           std::move(planNodeId),
-          std::move(operatorType)}) {}
+          std::move(operatorType)}),
+      memoryTimelineIntervalMs_(
+          driverCtx->queryConfig().operatorMemoryTimelineIntervalMs()) {}
 
 void Operator::maybeSetReclaimer() {
   VELOX_CHECK_NULL(pool()->reclaimer());
@@ -254,8 +257,30 @@ OperatorStats Operator::stats(bool clear) {
   return stats;
 }
 
+uint32_t Operator::outputBatchRows(std::optional<uint64_t> averageRowSize) {
+  const auto& queryConfig = operatorCtx_->task()->queryCtx()->queryConfig();
+  const auto adaptiveBytes = queryConfig.adaptiveOutputBatchBytes();
+  if (adaptiveBytes == 0) {
+    return outputBatchRows(
+        averageRowSize, queryConfig.preferredOutputBatchBytes());
+  }
+
+  if (!averageRowSize.has_value()) {
+    auto lockedStats = stats_.rlock();
+    if (lockedStats->outputPositions > 0) {
+      averageRowSize =
+          lockedStats->outputBytes / lockedStats->outputPositions;
+    }
+  }
+  const auto numRows = outputBatchRows(averageRowSize, adaptiveBytes);
+  stats_.wlock()->addRuntimeStat(
+      "adaptiveOutputBatchRows", RuntimeCounter(numRows));
+  return numRows;
+}
+
 uint32_t Operator::outputBatchRows(
-    std::optional<uint64_t> averageRowSize) const {
+    std::optional<uint64_t> averageRowSize,
+    uint64_t batchBytes) const {
   const auto& queryConfig = operatorCtx_->task()->queryCtx()->queryConfig();
 
   if (!averageRowSize.has_value()) {
@@ -264,12 +289,10 @@ uint32_t Operator::outputBatchRows(
 
   const uint64_t rowSize = averageRowSize.value();
 
-  if (rowSize * queryConfig.maxOutputBatchRows() <
-      queryConfig.preferredOutputBatchBytes()) {
+  if (rowSize * queryConfig.maxOutputBatchRows() < batchBytes) {
     return queryConfig.maxOutputBatchRows();
   }
-  return std::max<uint32_t>(
-      queryConfig.preferredOutputBatchBytes() / rowSize, 1);
+  return std::max<uint32_t>(batchBytes / rowSize, 1);
 }
 
 void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
@@ -289,6 +312,60 @@ void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
       fmt::format("blocked{}Times", blockReason), RuntimeCounter(1));
 }
 
+bool Operator::reserveMemoryAsync(uint64_t bytes, ContinueFuture* future) {
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  auto* executor = operatorCtx_->task()->queryCtx()->spillExecutor();
+  if (executor == nullptr || !queryConfig.asyncMemoryReservationEnabled()) {
+    return false;
+  }
+  auto [promise, reservationFuture] = makeVeloxContinuePromiseContract(
+      fmt::format("Operator::reserveMemoryAsync {}", pool()->name()));
+  // The task owns the operator pools and is kept alive until the reservation
+  // is done.
+  executor->add([task = operatorCtx_->task(),
+                 pool = pool(),
+                 bytes,
+                 promise = std::move(promise)]() mutable {
+    try {
+      if (!pool->maybeReserve(bytes)) {
+        LOG(WARNING) << "Failed to reserve " << succinctBytes(bytes)
+                     << " for memory pool " << pool->name()
+                     << " asynchronously";
+      }
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Async memory reservation failed for memory pool "
+                   << pool->name() << ": " << e.what();
+    }
+    promise.setValue();
+  });
+  *future = std::move(reservationFuture);
+  return true;
+}
+
+uint64_t Operator::memorySampleTimeMs() const {
+  const uint64_t nowMs = getCurrentTimeMs();
+  return nowMs / memoryTimelineIntervalMs_ * memoryTimelineIntervalMs_;
+}
+
+MemoryTimelineSample Operator::makeMemorySample(uint64_t spilledBytes) const {
+  MemoryTimelineSample sample;
+  sample.timeMs = memorySampleTimeMs();
+  sample.usedBytes = pool()->currentBytes();
+  sample.reservedBytes = pool()->reservedBytes();
+  sample.spilledBytes = spilledBytes;
+  return sample;
+}
+
+void Operator::recordMemorySample() {
+  const auto timeMs = memorySampleTimeMs();
+  if (timeMs == lastMemorySampleTimeMs_) {
+    return;
+  }
+  lastMemorySampleTimeMs_ = timeMs;
+  auto lockedStats = stats_.wlock();
+  lockedStats->addMemorySample(makeMemorySample(lockedStats->spilledBytes));
+}
+
 void Operator::recordSpillStats() {
   const auto lockedSpillStats = spillStats_.wlock();
   auto lockedStats = stats_.wlock();
@@ -388,7 +465,62 @@ void Operator::recordSpillStats() {
         RuntimeCounter{static_cast<int64_t>(
             lockedSpillStats->spillDeserializationTimeUs)});
   }
+
+  if (lockedSpillStats->spillMergePasses != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillMergePasses,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spillMergePasses)});
+  }
+
+  if (lockedSpillStats->spillMergeBytes != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillMergeBytes,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spillMergeBytes),
+            RuntimeCounter::Unit::kBytes});
+  }
+
+  if (lockedSpillStats->spillWriteWaitTimeUs != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillWriteWaitTime,
+        RuntimeCounter{
+            static_cast<int64_t>(
+                lockedSpillStats->spillWriteWaitTimeUs *
+                Timestamp::kNanosecondsInMicrosecond),
+            RuntimeCounter::Unit::kNanos});
+  }
+
+  if (lockedSpillStats->spillReadAheadTimeUs != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillReadAheadTime,
+        RuntimeCounter{
+            static_cast<int64_t>(
+                lockedSpillStats->spillReadAheadTimeUs *
+                Timestamp::kNanosecondsInMicrosecond),
+            RuntimeCounter::Unit::kNanos});
+    lockedStats->addRuntimeStat(
+        kSpillReadAheadWaitTime,
+        RuntimeCounter{
+            static_cast<int64_t>(
+                lockedSpillStats->spillReadAheadWaitTimeUs *
+                Timestamp::kNanosecondsInMicrosecond),
+            RuntimeCounter::Unit::kNanos});
+  }
+
+  if (lockedSpillStats->spilledFallbackBytes != 0) {
+    lockedStats->addRuntimeStat(
+        kSpilledFallbackBytes,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spilledFallbackBytes),
+            RuntimeCounter::Unit::kBytes});
+  }
   lockedSpillStats->reset();
+
+  // Samples the memory usage at each spill regardless of the last sample.
+  if (memoryTimelineIntervalMs_ != 0) {
+    lockedStats->addMemorySample(makeMemorySample(lockedStats->spilledBytes));
+  }
 }
 
 std::string Operator::toString() const {
@@ -463,6 +595,105 @@ void OperatorStats::addRuntimeStat(
   addOperatorRuntimeStats(name, value, runtimeStats);
 }
 
+void OperatorStats::addMemorySample(const MemoryTimelineSample& sample) {
+  if (!memoryTimeline.empty() &&
+      memoryTimeline.back().timeMs == sample.timeMs) {
+    memoryTimeline.back() = sample;
+    return;
+  }
+  if (memoryTimeline.size() < kMaxMemoryTimelineSamples) {
+    memoryTimeline.push_back(sample);
+  }
+}
+
+namespace {
+// Adds the usage of a timeline in the interval starting at 'out.timeMs' to
+// 'out'. 'last' is the last sample of the timeline at or before the interval,
+// or nullptr if the timeline has not started yet. 'hasMore' is true if the
+// timeline has samples after the interval. After its last sample, the
+// operators of a timeline no longer hold memory but their spilled bytes still
+// count.
+void addTimelineUsage(
+    const MemoryTimelineSample* last,
+    bool hasMore,
+    MemoryTimelineSample& out) {
+  if (last == nullptr) {
+    return;
+  }
+  out.spilledBytes += last->spilledBytes;
+  if (hasMore || last->timeMs == out.timeMs) {
+    out.usedBytes += last->usedBytes;
+    out.reservedBytes += last->reservedBytes;
+  }
+}
+
+// Merges runs of consecutive samples of 'timeline' so that it holds at most
+// OperatorStats::kMaxMemoryTimelineSamples. A merged sample starts at the
+// first sample of its run and keeps the max of each counter.
+void downsample(std::vector<MemoryTimelineSample>& timeline) {
+  constexpr size_t kMaxSamples = OperatorStats::kMaxMemoryTimelineSamples;
+  if (timeline.size() <= kMaxSamples) {
+    return;
+  }
+  const auto runSize = (timeline.size() + kMaxSamples - 1) / kMaxSamples;
+  size_t numOut = 0;
+  for (size_t i = 0; i < timeline.size(); i += runSize) {
+    auto sample = timeline[i];
+    const auto runEnd = std::min(i + runSize, timeline.size());
+    for (auto j = i + 1; j < runEnd; ++j) {
+      sample.usedBytes = std::max(sample.usedBytes, timeline[j].usedBytes);
+      sample.reservedBytes =
+          std::max(sample.reservedBytes, timeline[j].reservedBytes);
+      sample.spilledBytes =
+          std::max(sample.spilledBytes, timeline[j].spilledBytes);
+    }
+    timeline[numOut++] = sample;
+  }
+  timeline.resize(numOut);
+}
+} // namespace
+
+// static
+void MemoryTimelineSample::merge(
+    std::vector<MemoryTimelineSample>& timeline,
+    const std::vector<MemoryTimelineSample>& other) {
+  if (other.empty()) {
+    return;
+  }
+  // Each timeline only has samples for the intervals in which its operators
+  // ran. Its usage in an interval without a sample is the one of its previous
+  // sample. The merged timeline has a sample for every interval that either
+  // timeline has one for, each the sum of the usage of both timelines.
+  std::vector<MemoryTimelineSample> merged;
+  merged.reserve(timeline.size() + other.size());
+  size_t index = 0;
+  size_t otherIndex = 0;
+  const MemoryTimelineSample* last = nullptr;
+  const MemoryTimelineSample* otherLast = nullptr;
+  while (index < timeline.size() || otherIndex < other.size()) {
+    uint64_t timeMs = std::numeric_limits<uint64_t>::max();
+    if (index < timeline.size()) {
+      timeMs = timeline[index].timeMs;
+    }
+    if (otherIndex < other.size()) {
+      timeMs = std::min(timeMs, other[otherIndex].timeMs);
+    }
+    if (index < timeline.size() && timeline[index].timeMs == timeMs) {
+      last = &timeline[index++];
+    }
+    if (otherIndex < other.size() && other[otherIndex].timeMs == timeMs) {
+      otherLast = &other[otherIndex++];
+    }
+    MemoryTimelineSample sample;
+    sample.timeMs = timeMs;
+    addTimelineUsage(last, index < timeline.size(), sample);
+    addTimelineUsage(otherLast, otherIndex < other.size(), sample);
+    merged.push_back(sample);
+  }
+  downsample(merged);
+  timeline = std::move(merged);
+}
+
 void OperatorStats::add(const OperatorStats& other) {
   numSplits += other.numSplits;
   rawInputBytes += other.rawInputBytes;
@@ -487,6 +718,7 @@ void OperatorStats::add(const OperatorStats& other) {
   backgroundTiming.add(other.backgroundTiming);
 
   memoryStats.add(other.memoryStats);
+  MemoryTimelineSample::merge(memoryTimeline, other.memoryTimeline);
 
   for (const auto& [name, stats] : other.runtimeStats) {
     if (UNLIKELY(runtimeStats.count(name) == 0)) {
@@ -495,6 +727,9 @@ void OperatorStats::add(const OperatorStats& other) {
       runtimeStats.at(name).merge(stats);
     }
   }
+  inputBatchRows.merge(other.inputBatchRows);
+  outputBatchRows.merge(other.outputBatchRows);
+  outputBatchNanos.merge(other.outputBatchNanos);
 
   numDrivers += other.numDrivers;
   spilledInputBytes += other.spilledInputBytes;
@@ -530,8 +765,12 @@ void OperatorStats::clear() {
   backgroundTiming.clear();
 
   memoryStats.clear();
+  memoryTimeline.clear();
 
   runtimeStats.clear();
+  inputBatchRows.clear();
+  outputBatchRows.clear();
+  outputBatchNanos.clear();
 
   numDrivers = 0;
   spilledInputBytes = 0;
@@ -577,6 +816,9 @@ void Operator::MemoryReclaimer::enterArbitration() {
     // terminated.
     VELOX_FAIL("Terminate detected when entering suspension");
   }
+  if (const auto& timeline = runningDriver->timeline()) {
+    timeline->startArbitration();
+  }
 }
 
 void Operator::MemoryReclaimer::leaveArbitration() noexcept {
@@ -593,6 +835,9 @@ void Operator::MemoryReclaimer::leaveArbitration() noexcept {
         opDriver->task()->taskId(),
         "The current running driver and the request driver must be from the same task");
   }
+  if (const auto& timeline = runningDriver->timeline()) {
+    timeline->endArbitration();
+  }
   runningDriver->task()->leaveSuspended(runningDriver->state());
 }
 
@@ -649,12 +894,17 @@ uint64_t Operator::MemoryReclaimer::reclaim(
 
   RuntimeStatWriterScopeGuard opStatsGuard(op_);
 
+  const auto startMicros = getCurrentTimeMicro();
   auto reclaimBytes = memory::MemoryReclaimer::run(
       [&]() {
         op_->reclaim(targetBytes, stats);
         return pool->shrink(targetBytes);
       },
       stats);
+  if (const auto& timeline = driver->timeline()) {
+    timeline->record(
+        TimelineEvent::Kind::kSpill, startMicros, op_->operatorId());
+  }
 
   return reclaimBytes;
 }
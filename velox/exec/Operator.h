@@ -88,13 +88,30 @@ struct DynamicFilterStats {
   /// operator. If it is empty, then there is no dynamic filter added.
   std::unordered_set<core::PlanNodeId> producerNodeIds;
 
+  /// Number of values tested and rejected by Bloom filter dynamic filters.
+  uint64_t bloomFilterRowsTested{0};
+  uint64_t bloomFilterRowsRejected{0};
+
+  /// Number of value ranges, e.g. row groups or stripes, tested and pruned
+  /// based on their statistics by Bloom filter dynamic filters.
+  uint64_t bloomFilterRangesTested{0};
+  uint64_t bloomFilterRangesRejected{0};
+
   void clear() {
     producerNodeIds.clear();
+    bloomFilterRowsTested = 0;
+    bloomFilterRowsRejected = 0;
+    bloomFilterRangesTested = 0;
+    bloomFilterRangesRejected = 0;
   }
 
   void add(const DynamicFilterStats& other) {
     producerNodeIds.insert(
         other.producerNodeIds.begin(), other.producerNodeIds.end());
+    bloomFilterRowsTested += other.bloomFilterRowsTested;
+    bloomFilterRowsRejected += other.bloomFilterRowsRejected;
+    bloomFilterRangesTested += other.bloomFilterRangesTested;
+    bloomFilterRangesRejected += other.bloomFilterRangesRejected;
   }
 
   bool empty() const {
@@ -102,6 +119,30 @@ struct DynamicFilterStats {
   }
 };
 
+/// A sample of the memory usage of an operator, see
+/// core::QueryConfig::kOperatorMemoryTimelineIntervalMs.
+struct MemoryTimelineSample {
+  /// Start of the sampling interval in milliseconds since epoch.
+  uint64_t timeMs{0};
+  /// Used and reserved bytes of the operator memory pool.
+  uint64_t usedBytes{0};
+  uint64_t reservedBytes{0};
+  /// Total bytes spilled by the operator up to this sample.
+  uint64_t spilledBytes{0};
+
+  /// Adds the samples in 'other' to 'timeline'. Both must be in time order
+  /// with sample times at the starts of the same sampling intervals. The
+  /// result has a sample for each interval that either has one for. Its usage
+  /// is the sum of both, where a timeline without a sample in the interval
+  /// counts its previous sample, and counts only its spilled bytes after its
+  /// last sample. The result is downsampled to at most
+  /// OperatorStats::kMaxMemoryTimelineSamples by keeping the max of runs of
+  /// consecutive samples.
+  static void merge(
+      std::vector<MemoryTimelineSample>& timeline,
+      const std::vector<MemoryTimelineSample>& other);
+};
+
 struct OperatorStats {
   /// Initial ordinal position in the operator's pipeline.
   int32_t operatorId = 0;
@@ -182,6 +223,21 @@ struct OperatorStats {
 
   std::unordered_map<std::string, RuntimeMetric> runtimeStats;
 
+  /// Distributions of the number of rows of the input and output batches and
+  /// of the wall time of the getOutput() calls that returned a batch. Show
+  /// where selective operators leave small batches behind.
+  RuntimeHistogram inputBatchRows;
+  RuntimeHistogram outputBatchRows;
+  RuntimeHistogram outputBatchNanos{RuntimeCounter::Unit::kNanos};
+
+  /// At most one memory usage sample per sampling interval in time order.
+  /// Empty unless core::QueryConfig::kOperatorMemoryTimelineIntervalMs is set.
+  /// Holds up to kMaxMemoryTimelineSamples. Later samples of an operator are
+  /// dropped, and merged timelines are downsampled.
+  std::vector<MemoryTimelineSample> memoryTimeline;
+
+  static constexpr int32_t kMaxMemoryTimelineSamples = 1'000;
+
   int numDrivers = 0;
 
   OperatorStats() = default;
@@ -200,15 +256,22 @@ struct OperatorStats {
     inputBytes += bytes;
     inputPositions += positions;
     inputVectors += 1;
+    inputBatchRows.addValue(positions);
   }
 
   void addOutputVector(uint64_t bytes, uint64_t positions) {
     outputBytes += bytes;
     outputPositions += positions;
     outputVectors += 1;
+    outputBatchRows.addValue(positions);
   }
 
   void addRuntimeStat(const std::string& name, const RuntimeCounter& value);
+
+  /// Appends 'sample' to 'memoryTimeline' or replaces the last sample if it is
+  /// of the same sampling interval.
+  void addMemorySample(const MemoryTimelineSample& sample);
+
   void add(const OperatorStats& other);
   void clear();
 };
@@ -347,6 +410,14 @@ class Operator : public BaseRuntimeStatWriter {
   static inline const std::string kSpillReadTimeUs{"spillReadTimeUs"};
   static inline const std::string kSpillDeserializationTimeUs{
       "spillDeserializationTimeUs"};
+  static inline const std::string kSpillMergePasses{"spillMergePasses"};
+  static inline const std::string kSpillMergeBytes{"spillMergeBytes"};
+  static inline const std::string kSpillWriteWaitTime{"spillWriteWaitTime"};
+  static inline const std::string kSpillReadAheadTime{"spillReadAheadTime"};
+  static inline const std::string kSpillReadAheadWaitTime{
+      "spillReadAheadWaitTime"};
+  static inline const std::string kSpilledFallbackBytes{
+      "spilledFallbackBytes"};
 
   /// 'operatorId' is the initial index of the 'this' in the Driver's list of
   /// Operators. This is used as in index into OperatorStats arrays in the Task.
@@ -497,6 +568,17 @@ class Operator : public BaseRuntimeStatWriter {
 
   void recordBlockingTime(uint64_t start, BlockingReason reason);
 
+  /// Records a memory timeline sample if the operator has not been sampled in
+  /// the current sampling interval. No-op unless
+  /// core::QueryConfig::kOperatorMemoryTimelineIntervalMs is set. Invoked by
+  /// the driver after addInput() and getOutput().
+  void maybeRecordMemorySample() {
+    if (FOLLY_LIKELY(memoryTimelineIntervalMs_ == 0)) {
+      return;
+    }
+    recordMemorySample();
+  }
+
   virtual std::string toString() const;
 
   /// Used in debug ednpoints.
@@ -739,12 +821,26 @@ class Operator : public BaseRuntimeStatWriter {
   /// must not be negative. If the averageRowSize is 0 which is not advised,
   /// returns maxOutputBatchRows. If the averageRowSize is not given, returns
   /// preferredOutputBatchRows.
+  ///
+  /// If adaptiveOutputBatchBytes is set, the rows fit in that many bytes
+  /// instead, averageRowSize defaults to the average size of the rows output
+  /// so far and the result is recorded in the 'adaptiveOutputBatchRows'
+  /// runtime stat.
   uint32_t outputBatchRows(
-      std::optional<uint64_t> averageRowSize = std::nullopt) const;
+      std::optional<uint64_t> averageRowSize = std::nullopt);
 
   /// Invoked to record spill stats in operator stats.
   virtual void recordSpillStats();
 
+  /// Starts to grow the reservation of pool() by 'bytes' on the spill executor
+  /// so that the memory arbitration does not hold the driver thread. Returns
+  /// true and sets 'future' to complete when the reservation is done. The
+  /// operator is then expected to return BlockingReason::kWaitForMemory with
+  /// 'future' from isBlocked(). Returns false if the async reservation is not
+  /// enabled or there is no spill executor. The reservation may fail, in which
+  /// case the operator reserves or spills on the driver thread as before.
+  bool reserveMemoryAsync(uint64_t bytes, ContinueFuture* future);
+
   const std::unique_ptr<OperatorCtx> operatorCtx_;
   const RowTypePtr outputType_;
   /// Contains the disk spilling related configs if spilling is enabled (e.g.
@@ -756,6 +852,9 @@ class Operator : public BaseRuntimeStatWriter {
   folly::Synchronized<OperatorStats> stats_;
   folly::Synchronized<common::SpillStats> spillStats_;
 
+  /// The sampling interval of the memory timeline. 0 if not sampled.
+  const uint64_t memoryTimelineIntervalMs_;
+
   /// Indicates if an operator is under a non-reclaimable execution section.
   /// This prevents the memory arbitrator from reclaiming memory from this
   /// operator if it happens to be suspended for memory arbitration processing.
@@ -779,6 +878,24 @@ class Operator : public BaseRuntimeStatWriter {
 
   std::unordered_map<column_index_t, std::shared_ptr<common::Filter>>
       dynamicFilters_;
+
+ private:
+  // Returns the start of the current sampling interval of the memory timeline.
+  uint64_t memorySampleTimeMs() const;
+
+  // Returns a memory timeline sample of the current sampling interval.
+  MemoryTimelineSample makeMemorySample(uint64_t spilledBytes) const;
+
+  void recordMemorySample();
+
+  // Returns the number of rows of 'averageRowSize' that fit in 'batchBytes'.
+  uint32_t outputBatchRows(
+      std::optional<uint64_t> averageRowSize,
+      uint64_t batchBytes) const;
+
+  // Start of the sampling interval of the last sample recorded by
+  // maybeRecordMemorySample(). Only accessed by the driver thread.
+  uint64_t lastMemorySampleTimeMs_{0};
 };
 
 /// Given a row type returns indices for the specified subset of columns.
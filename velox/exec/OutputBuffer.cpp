@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/OutputBuffer.h"
+#include "velox/common/file/FileSystems.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/exec/Task.h"
 
@@ -91,20 +92,31 @@ void DestinationBuffer::Stats::recordEnqueue(const SerializedPage& data) {
 void DestinationBuffer::Stats::recordAcknowledge(const SerializedPage& data) {
   const auto numRows = data.numRows();
   VELOX_CHECK(numRows.has_value(), "SerializedPage's numRows must be valid");
-  const int64_t size = data.size();
-  bytesBuffered -= size;
+  recordDelete(data.size(), numRows.value());
+}
+
+void DestinationBuffer::Stats::recordDelete(const SerializedPage& data) {
+  recordAcknowledge(data);
+}
+
+void DestinationBuffer::Stats::recordDelete(int64_t bytes, int64_t rows) {
+  bytesBuffered -= bytes;
   VELOX_DCHECK_GE(bytesBuffered, 0, "bytesBuffered must be non-negative");
-  rowsBuffered -= numRows.value();
+  rowsBuffered -= rows;
   VELOX_DCHECK_GE(rowsBuffered, 0, "rowsBuffered must be non-negative");
   --pagesBuffered;
   VELOX_DCHECK_GE(pagesBuffered, 0, "pagesBuffered must be non-negative");
-  bytesSent += size;
-  rowsSent += numRows.value();
+  bytesSent += bytes;
+  rowsSent += rows;
   ++pagesSent;
 }
 
-void DestinationBuffer::Stats::recordDelete(const SerializedPage& data) {
-  recordAcknowledge(data);
+DestinationBuffer::~DestinationBuffer() {
+  try {
+    removeSpillFile();
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to remove output buffer spill file: " << e.what();
+  }
 }
 
 DestinationBuffer::Data DestinationBuffer::getData(
@@ -127,6 +139,7 @@ DestinationBuffer::Data DestinationBuffer::getData(
     }
     if (maxBytes == 0) {
       std::vector<int64_t> remainingBytes;
+      getSpilledPageSizes(remainingBytes);
       if (arbitraryBuffer) {
         arbitraryBuffer->getAvailablePageSizes(remainingBytes);
       }
@@ -164,6 +177,7 @@ DestinationBuffer::Data DestinationBuffer::getData(
       }
     }
   }
+  fetchedSequence_ = std::max<int64_t>(fetchedSequence_, sequence_ + i);
   bool atEnd = false;
   std::vector<int64_t> remainingBytes;
   remainingBytes.reserve(data_.size() - i);
@@ -175,6 +189,9 @@ DestinationBuffer::Data DestinationBuffer::getData(
     }
     remainingBytes.push_back(data_[i]->size());
   }
+  if (!atEnd) {
+    getSpilledPageSizes(remainingBytes);
+  }
   if (!atEnd && arbitraryBuffer) {
     arbitraryBuffer->getAvailablePageSizes(remainingBytes);
   }
@@ -185,15 +202,198 @@ DestinationBuffer::Data DestinationBuffer::getData(
 }
 
 void DestinationBuffer::enqueue(std::shared_ptr<SerializedPage> data) {
+  // The pages enqueued after spilled pages go after them.
+  auto& pages = spilledPages_.empty() ? data_ : tailPages_;
   // Drop duplicate end markers.
-  if (data == nullptr && !data_.empty() && data_.back() == nullptr) {
+  if (data == nullptr && !pages.empty() && pages.back() == nullptr) {
     return;
   }
 
   if (data != nullptr) {
     stats_.recordEnqueue(*data);
   }
-  data_.push_back(std::move(data));
+  pages.push_back(std::move(data));
+}
+
+uint64_t DestinationBuffer::spillableBytes() const {
+  uint64_t bytes = 0;
+  if (spilledPages_.empty()) {
+    for (auto i = std::max<int64_t>(0, fetchedSequence_ - sequence_);
+         i < data_.size();
+         ++i) {
+      if (data_[i] != nullptr) {
+        bytes += data_[i]->size();
+      }
+    }
+    return bytes;
+  }
+  for (const auto& page : tailPages_) {
+    if (page != nullptr) {
+      bytes += page->size();
+    }
+  }
+  return bytes;
+}
+
+std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::spill(
+    const std::string& pathPrefix,
+    const std::string& fileCreateConfig) {
+  std::vector<std::shared_ptr<SerializedPage>> spilled;
+  if (spilledPages_.empty()) {
+    VELOX_CHECK(tailPages_.empty());
+    // The pages given out by getData() stay in memory because the consumer
+    // may fetch them again until they are acknowledged.
+    const int64_t firstUnfetched = std::min<int64_t>(
+        std::max<int64_t>(0, fetchedSequence_ - sequence_), data_.size());
+    if (firstUnfetched == data_.size() || data_[firstUnfetched] == nullptr) {
+      return spilled;
+    }
+    tailPages_.assign(
+        std::make_move_iterator(data_.begin() + firstUnfetched),
+        std::make_move_iterator(data_.end()));
+    data_.resize(firstUnfetched);
+  }
+
+  if (spillFile_ == nullptr) {
+    spillFile_ = SpillWriteFile::create(0, pathPrefix, fileCreateConfig);
+  }
+  for (auto& page : tailPages_) {
+    // The end marker stays last.
+    if (page == nullptr) {
+      break;
+    }
+    const auto offset = spillFile_->size();
+    const auto size = spillFile_->write(page->getIOBuf());
+    spilledPages_.push_back({offset, size, page->numRows().value()});
+    spilled.push_back(std::move(page));
+  }
+  tailPages_.erase(tailPages_.begin(), tailPages_.begin() + spilled.size());
+  // Makes the spilled pages readable.
+  spillFile_->file()->flush();
+  return spilled;
+}
+
+bool DestinationBuffer::needsUnspill(int64_t sequence, uint64_t maxBytes)
+    const {
+  if (spilledPages_.empty() || maxBytes == 0) {
+    return false;
+  }
+  uint64_t bytes = 0;
+  for (auto i = std::max<int64_t>(0, sequence - sequence_); i < data_.size();
+       ++i) {
+    bytes += data_[i]->size();
+    if (bytes >= maxBytes) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::unspill(
+    uint64_t maxBytes) {
+  VELOX_CHECK(!spilledPages_.empty());
+  if (spillReadFile_ == nullptr) {
+    auto fs = filesystems::getFileSystem(spillFile_->path(), nullptr);
+    spillReadFile_ = fs->openFileForRead(
+        spillFile_->path(),
+        filesystems::FileOptions{
+            {{filesystems::FileOptions::kFileCreateConfig.toString(),
+              spillFile_->fileCreateConfig()}},
+            nullptr,
+            std::nullopt});
+  }
+
+  std::vector<std::shared_ptr<SerializedPage>> pages;
+  uint64_t bytes = 0;
+  while (!spilledPages_.empty() && (pages.empty() || bytes < maxBytes)) {
+    const auto& spilled = spilledPages_.front();
+    auto iobuf = folly::IOBuf::create(spilled.size);
+    spillReadFile_->pread(spilled.offset, spilled.size, iobuf->writableData());
+    iobuf->append(spilled.size);
+    bytes += spilled.size;
+    pages.push_back(std::make_shared<SerializedPage>(
+        std::move(iobuf), nullptr, spilled.numRows));
+    data_.push_back(pages.back());
+    spilledPages_.pop_front();
+  }
+
+  if (spilledPages_.empty()) {
+    removeSpillFile();
+    for (auto& page : tailPages_) {
+      data_.push_back(std::move(page));
+    }
+    tailPages_.clear();
+  }
+  return pages;
+}
+
+void DestinationBuffer::getSpilledPageSizes(std::vector<int64_t>& out) const {
+  for (const auto& spilled : spilledPages_) {
+    out.push_back(spilled.size);
+  }
+  for (const auto& page : tailPages_) {
+    if (page != nullptr) {
+      out.push_back(page->size());
+    }
+  }
+}
+
+void DestinationBuffer::removeSpillFile() {
+  if (spillFile_ == nullptr) {
+    return;
+  }
+  spillReadFile_.reset();
+  const auto path = spillFile_->path();
+  spillFile_->finish();
+  spillFile_.reset();
+  filesystems::getFileSystem(path, nullptr)->remove(path);
+}
+
+void DestinationBuffer::addPendingPage(
+    std::unique_ptr<SerializedPage> data,
+    uint64_t nowMs) {
+  VELOX_CHECK_NOT_NULL(data);
+  if (pendingPages_.empty()) {
+    pendingStartMs_ = nowMs;
+  }
+  pendingBytes_ += data->size();
+  pendingPages_.push_back(std::move(data));
+}
+
+int32_t DestinationBuffer::flushPendingPages() {
+  const int32_t numPages = pendingPages_.size();
+  if (numPages == 0) {
+    return 0;
+  }
+  pendingBytes_ = 0;
+  if (numPages == 1) {
+    enqueue(std::move(pendingPages_[0]));
+    pendingPages_.clear();
+    return 1;
+  }
+
+  // Chains the buffers of the pages without copying. The pages are
+  // self-delimiting, so the consumer reads them one after the other.
+  std::unique_ptr<folly::IOBuf> iobuf;
+  int64_t numRows = 0;
+  for (const auto& page : pendingPages_) {
+    if (iobuf == nullptr) {
+      iobuf = page->getIOBuf();
+    } else {
+      iobuf->prependChain(page->getIOBuf());
+    }
+    numRows += page->numRows().value();
+  }
+  // The merged page shares the memory of the pending pages. Keeps them alive
+  // until the merged page is freed.
+  auto pages = std::make_shared<std::vector<std::unique_ptr<SerializedPage>>>(
+      std::move(pendingPages_));
+  pendingPages_.clear();
+  enqueue(std::make_shared<SerializedPage>(
+      std::move(iobuf),
+      [pages](folly::IOBuf& /*unused*/) { pages->clear(); },
+      numRows));
+  return numPages;
 }
 
 DataAvailable DestinationBuffer::getAndClearNotify() {
@@ -221,6 +421,10 @@ void DestinationBuffer::clearNotify() {
 void DestinationBuffer::finish() {
   VELOX_CHECK_NULL(notify_, "notify must be cleared before finish");
   VELOX_CHECK(data_.empty(), "data must be fetched before finish");
+  VELOX_CHECK(pendingPages_.empty(), "pending pages must be freed first");
+  VELOX_CHECK(
+      spilledPages_.empty() && tailPages_.empty(),
+      "spilled pages must be freed first");
   stats_.finished = true;
 }
 
@@ -293,6 +497,23 @@ DestinationBuffer::deleteResults() {
     freed.push_back(std::move(data_[i]));
   }
   data_.clear();
+  for (auto& page : pendingPages_) {
+    freed.push_back(std::move(page));
+  }
+  pendingPages_.clear();
+  pendingBytes_ = 0;
+  for (const auto& spilled : spilledPages_) {
+    stats_.recordDelete(spilled.size, spilled.numRows);
+  }
+  spilledPages_.clear();
+  for (auto& page : tailPages_) {
+    if (page != nullptr) {
+      stats_.recordDelete(*page);
+      freed.push_back(std::move(page));
+    }
+  }
+  tailPages_.clear();
+  removeSpillFile();
   return freed;
 }
 
@@ -303,7 +524,11 @@ DestinationBuffer::Stats DestinationBuffer::stats() const {
 std::string DestinationBuffer::toString() {
   std::stringstream out;
   out << "[available: " << data_.size() << ", " << "sequence: " << sequence_
-      << ", " << (notify_ ? "notify registered, " : "") << this << "]";
+      << ", " << (notify_ ? "notify registered, " : "");
+  if (!spilledPages_.empty()) {
+    out << "spilled: " << spilledPages_.size() << ", ";
+  }
+  out << this << "]";
   return out.str();
 }
 
@@ -334,6 +559,17 @@ OutputBuffer::OutputBuffer(
       continueSize_((maxSize_ * kContinuePct) / 100),
       arbitraryBuffer_(
           isArbitrary() ? std::make_unique<ArbitraryBuffer>() : nullptr),
+      coalesceTargetBytes_(
+          isPartitioned() ? task_->queryCtx()
+                                ->queryConfig()
+                                .outputBufferCoalesceTargetBytes()
+                          : 0),
+      coalesceMaxDelayMs_(
+          task_->queryCtx()->queryConfig().outputBufferCoalesceMaxDelayMs()),
+      spillEnabled_(
+          isPartitioned() &&
+          task_->queryCtx()->queryConfig().outputBufferSpillEnabled()),
+      memoryConsumer_(ExchangeMemoryManager::makeConsumer()),
       numDrivers_(numDrivers) {
   buffers_.reserve(numDestinations);
   for (int i = 0; i < numDestinations; i++) {
@@ -415,8 +651,12 @@ void OutputBuffer::updateStatsWithEnqueuedPageLocked(
 
   bufferedBytes_ += pageBytes;
   ++bufferedPages_;
+  if (memoryConsumer_ != nullptr) {
+    memoryConsumer_->setUsedBytes(bufferedBytes_);
+  }
 
   ++numOutputPages_;
+  ++numEnqueuedPages_;
   numOutputRows_ += pageRows;
   numOutputBytes_ += pageBytes;
 }
@@ -430,6 +670,9 @@ void OutputBuffer::updateStatsWithFreedPagesLocked(
   VELOX_CHECK_GE(bufferedBytes_, 0);
   bufferedPages_ -= numPages;
   VELOX_CHECK_GE(bufferedPages_, 0);
+  if (memoryConsumer_ != nullptr) {
+    memoryConsumer_->setUsedBytes(bufferedBytes_);
+  }
 }
 
 void OutputBuffer::updateTotalBufferedBytesMsLocked() {
@@ -450,6 +693,8 @@ bool OutputBuffer::enqueue(
   VELOX_CHECK(
       task_->isRunning(), "Task is terminated, cannot add data to output.");
   std::vector<DataAvailable> dataAvailableCallbacks;
+  std::vector<std::shared_ptr<SerializedPage>> freed;
+  std::vector<ContinuePromise> promises;
   bool blocked = false;
   {
     std::lock_guard<std::mutex> l(mutex_);
@@ -474,7 +719,17 @@ bool OutputBuffer::enqueue(
         VELOX_UNREACHABLE(PartitionedOutputNode::kindString(kind_));
     }
 
-    if (bufferedBytes_ > maxSize_ && future) {
+    if (bufferedBytes_ > maxSize_ && coalesceTargetBytes_ > 0) {
+      // The consumers must be able to fetch all buffered data so that a
+      // blocked producer gets unblocked.
+      flushAllPendingPagesLocked(dataAvailableCallbacks);
+    }
+
+    if (bufferedBytes_ > maxSize_ && spillEnabled_) {
+      spillLocked(freed, promises);
+    }
+
+    if ((bufferedBytes_ > maxSize_ || overMemoryBudgetLocked()) && future) {
       promises_.emplace_back("OutputBuffer::enqueue");
       *future = promises_.back().getSemiFuture();
       blocked = true;
@@ -485,6 +740,7 @@ bool OutputBuffer::enqueue(
   for (auto& callback : dataAvailableCallbacks) {
     callback.notify();
   }
+  releaseAfterAcknowledge(freed, promises);
 
   return blocked;
 }
@@ -548,6 +804,18 @@ void OutputBuffer::enqueuePartitionedOutputLocked(
   VELOX_CHECK_LT(destination, buffers_.size());
   auto* buffer = buffers_[destination].get();
   if (buffer != nullptr) {
+    if (data->size() < coalesceTargetBytes_) {
+      const auto nowMs = getCurrentTimeMs();
+      buffer->addPendingPage(std::move(data), nowMs);
+      if ((buffer->pendingBytes() >= coalesceTargetBytes_ ||
+           buffer->pendingPagesExpired(nowMs, coalesceMaxDelayMs_)) &&
+          flushPendingPagesLocked(buffer)) {
+        dataAvailableCbs.emplace_back(buffer->getAndClearNotify());
+      }
+      return;
+    }
+    // Keeps the order of the pages.
+    flushPendingPagesLocked(buffer);
     buffer->enqueue(std::move(data));
     dataAvailableCbs.emplace_back(buffer->getAndClearNotify());
   } else {
@@ -557,6 +825,94 @@ void OutputBuffer::enqueuePartitionedOutputLocked(
   }
 }
 
+bool OutputBuffer::flushPendingPagesLocked(DestinationBuffer* buffer) {
+  const auto numPages = buffer->flushPendingPages();
+  if (numPages == 0) {
+    return false;
+  }
+  // The merged pages count as one.
+  bufferedPages_ -= numPages - 1;
+  numOutputPages_ -= numPages - 1;
+  return true;
+}
+
+void OutputBuffer::flushAllPendingPagesLocked(
+    std::vector<DataAvailable>& dataAvailableCbs) {
+  for (auto& buffer : buffers_) {
+    if (buffer != nullptr && flushPendingPagesLocked(buffer.get())) {
+      dataAvailableCbs.emplace_back(buffer->getAndClearNotify());
+    }
+  }
+}
+
+void OutputBuffer::spillLocked(
+    std::vector<std::shared_ptr<SerializedPage>>& freed,
+    std::vector<ContinuePromise>& promises) {
+  const auto& spillDirectory = task_->getOrCreateSpillDirectory();
+  if (spillDirectory.empty()) {
+    return;
+  }
+
+  // Starts with the destinations with the most unfetched data, which are the
+  // ones with the slowest consumers.
+  std::vector<std::pair<uint64_t, int32_t>> candidates;
+  for (auto i = 0; i < buffers_.size(); ++i) {
+    if (buffers_[i] == nullptr) {
+      continue;
+    }
+    const auto bytes = buffers_[i]->spillableBytes();
+    if (bytes > 0) {
+      candidates.emplace_back(bytes, i);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(), std::greater<>());
+
+  const auto& fileCreateConfig =
+      task_->queryCtx()->queryConfig().spillFileCreateConfig();
+  for (const auto& candidate : candidates) {
+    if (bufferedBytes_ < continueSize_) {
+      break;
+    }
+    const auto destination = candidate.second;
+    auto spilled = buffers_[destination]->spill(
+        fmt::format("{}/output-{}", spillDirectory, destination),
+        fileCreateConfig);
+    uint64_t spilledBytes = 0;
+    for (const auto& page : spilled) {
+      spilledBytes += page->size();
+    }
+    updateStatsWithFreedPagesLocked(spilled.size(), spilledBytes);
+    numSpilledBytes_ += spilledBytes;
+    numSpilledPages_ += spilled.size();
+    freed.insert(
+        freed.end(),
+        std::make_move_iterator(spilled.begin()),
+        std::make_move_iterator(spilled.end()));
+  }
+
+  if (canContinueLocked()) {
+    promises = std::move(promises_);
+  }
+}
+
+void OutputBuffer::unspillLocked(
+    DestinationBuffer* buffer,
+    int64_t sequence,
+    uint64_t maxBytes) {
+  if (!buffer->needsUnspill(sequence, maxBytes)) {
+    return;
+  }
+  const auto pages = buffer->unspill(maxBytes);
+  updateTotalBufferedBytesMsLocked();
+  for (const auto& page : pages) {
+    bufferedBytes_ += page->size();
+  }
+  bufferedPages_ += pages.size();
+  if (memoryConsumer_ != nullptr) {
+    memoryConsumer_->setUsedBytes(bufferedBytes_);
+  }
+}
+
 void OutputBuffer::noMoreData() {
   // Increment number of finished drivers.
   checkIfDone(true);
@@ -593,6 +949,7 @@ void OutputBuffer::checkIfDone(bool oneDriverFinished) {
     } else {
       for (auto& buffer : buffers_) {
         if (buffer != nullptr) {
+          flushPendingPagesLocked(buffer.get());
           buffer->enqueue(nullptr);
           finished.push_back(buffer->getAndClearNotify());
         }
@@ -662,7 +1019,7 @@ void OutputBuffer::updateAfterAcknowledgeLocked(
 
   updateStatsWithFreedPagesLocked(freedPages, freedBytes);
 
-  if (bufferedBytes_ < continueSize_) {
+  if (canContinueLocked()) {
     promises = std::move(promises_);
   }
 }
@@ -726,6 +1083,13 @@ void OutputBuffer::getData(
     if (buffer) {
       freed = buffer->acknowledge(sequence, true);
       updateAfterAcknowledgeLocked(freed, promises);
+      if (buffer->pendingPagesExpired(
+              getCurrentTimeMs(), coalesceMaxDelayMs_)) {
+        flushPendingPagesLocked(buffer);
+      }
+      if (spillEnabled_) {
+        unspillLocked(buffer, sequence, maxBytes);
+      }
       data = buffer->getData(
           maxBytes, sequence, notify, activeCheck, arbitraryBuffer_.get());
     } else {
@@ -851,6 +1215,9 @@ OutputBuffer::Stats OutputBuffer::stats() {
       numOutputBytes_,
       numOutputRows_,
       numOutputPages_,
+      numEnqueuedPages_,
+      numSpilledBytes_,
+      numSpilledPages_,
       getAverageBufferTimeMsLocked(),
       countTopBuffers(bufferStats, numOutputBytes_),
       bufferStats);
@@ -16,7 +16,9 @@
 #pragma once
 
 #include "velox/core/PlanNode.h"
+#include "velox/exec/ExchangeMemoryManager.h"
 #include "velox/exec/ExchangeQueue.h"
+#include "velox/exec/SpillFile.h"
 
 namespace facebook::velox::exec {
 
@@ -92,6 +94,8 @@ class ArbitraryBuffer {
 
 class DestinationBuffer {
  public:
+  ~DestinationBuffer();
+
   /// The data transferred by the destination buffer has two phases:
   /// 1. Buffered: the data resides in the buffer after enqueued and before
   ///              acked / deleted.
@@ -104,6 +108,9 @@ class DestinationBuffer {
 
     void recordDelete(const SerializedPage& data);
 
+    /// Records the delete of a spilled page of 'bytes' and 'rows'.
+    void recordDelete(int64_t bytes, int64_t rows);
+
     bool finished{false};
 
     /// Number of buffered bytes / rows / pages.
@@ -119,6 +126,55 @@ class DestinationBuffer {
 
   void enqueue(std::shared_ptr<SerializedPage> data);
 
+  /// Adds 'data' to the small pages waiting to be merged into one page by
+  /// flushPendingPages(). The pending pages are not visible to getData().
+  /// 'nowMs' is the current time, used to bound the wait.
+  void addPendingPage(std::unique_ptr<SerializedPage> data, uint64_t nowMs);
+
+  /// Returns the total size of the pending pages.
+  uint64_t pendingBytes() const {
+    return pendingBytes_;
+  }
+
+  bool hasPendingPages() const {
+    return !pendingPages_.empty();
+  }
+
+  /// Returns true if the first pending page was added at least 'maxDelayMs'
+  /// before 'nowMs'.
+  bool pendingPagesExpired(uint64_t nowMs, uint64_t maxDelayMs) const {
+    return !pendingPages_.empty() && nowMs - pendingStartMs_ >= maxDelayMs;
+  }
+
+  /// Merges the pending pages into one page and enqueues it. Returns the
+  /// number of merged pages.
+  int32_t flushPendingPages();
+
+  /// Writes the pages the consumer has not fetched yet to a spill file
+  /// created with 'pathPrefix' and 'fileCreateConfig'. The pages enqueued
+  /// after this are kept in memory after the spilled pages, and are written
+  /// by the next call. Returns the spilled pages, which are no longer buffered
+  /// in memory.
+  std::vector<std::shared_ptr<SerializedPage>> spill(
+      const std::string& pathPrefix,
+      const std::string& fileCreateConfig);
+
+  /// Returns the size of the pages spill() would write.
+  uint64_t spillableBytes() const;
+
+  bool hasSpilledPages() const {
+    return !spilledPages_.empty();
+  }
+
+  /// Returns true if the consumer fetching from 'sequence' with 'maxBytes'
+  /// needs more pages than the ones in memory and there are spilled pages.
+  bool needsUnspill(int64_t sequence, uint64_t maxBytes) const;
+
+  /// Reads spilled pages of at least 'maxBytes' back into memory, at least
+  /// one page. The pages enqueued after the spilled pages become available
+  /// once all spilled pages are read. Returns the pages read.
+  std::vector<std::shared_ptr<SerializedPage>> unspill(uint64_t maxBytes);
+
   /// Invoked to load data with up to 'notifyMaxBytes_' bytes from arbitrary
   /// 'buffer' if there is pending fetch from this destination in which case
   /// 'notify_' is not null. Otherwise, it does nothing. This only used by
@@ -169,7 +225,8 @@ class DestinationBuffer {
       int64_t sequence,
       bool fromGetData);
 
-  /// Removes all remaining data from the queue and returns the removed data.
+  /// Removes all remaining data from the queue, including the pending pages,
+  /// and returns the removed data.
   std::vector<std::shared_ptr<SerializedPage>> deleteResults();
 
   /// Returns and clears the notify callback, if any, along with arguments for
@@ -187,6 +244,19 @@ class DestinationBuffer {
  private:
   void clearNotify();
 
+  // Appends the sizes of the spilled pages and the pages after them to 'out'.
+  void getSpilledPageSizes(std::vector<int64_t>& out) const;
+
+  // Deletes the spill file, if any.
+  void removeSpillFile();
+
+  // A page in 'spillFile_'.
+  struct SpilledPage {
+    uint64_t offset;
+    uint64_t size;
+    int64_t numRows;
+  };
+
   std::vector<std::shared_ptr<SerializedPage>> data_;
   // The sequence number of the first in 'data_'.
   int64_t sequence_ = 0;
@@ -196,6 +266,19 @@ class DestinationBuffer {
   int64_t notifySequence_{0};
   uint64_t notifyMaxBytes_{0};
   Stats stats_;
+  // Small pages waiting to be merged into one page. See addPendingPage().
+  std::vector<std::unique_ptr<SerializedPage>> pendingPages_;
+  uint64_t pendingBytes_{0};
+  // Time in ms when the first page of 'pendingPages_' was added.
+  uint64_t pendingStartMs_{0};
+  // The sequence number after the last page returned by getData().
+  int64_t fetchedSequence_{0};
+  // The pages that follow 'data_' and are written to 'spillFile_'.
+  std::deque<SpilledPage> spilledPages_;
+  // The pages enqueued after the spilled pages, including the end marker.
+  std::vector<std::shared_ptr<SerializedPage>> tailPages_;
+  std::unique_ptr<SpillWriteFile> spillFile_;
+  std::unique_ptr<ReadFile> spillReadFile_;
 };
 
 class Task;
@@ -213,6 +296,9 @@ class OutputBuffer {
         int64_t _totalBytesSent,
         int64_t _totalRowsSent,
         int64_t _totalPagesSent,
+        int64_t _totalPagesEnqueued,
+        int64_t _totalBytesSpilled,
+        int64_t _totalPagesSpilled,
         int64_t _averageBufferTimeMs,
         int32_t _numTopBuffers,
         const std::vector<DestinationBuffer::Stats>& _buffersStats)
@@ -225,6 +311,9 @@ class OutputBuffer {
           totalBytesSent(_totalBytesSent),
           totalRowsSent(_totalRowsSent),
           totalPagesSent(_totalPagesSent),
+          totalPagesEnqueued(_totalPagesEnqueued),
+          totalBytesSpilled(_totalBytesSpilled),
+          totalPagesSpilled(_totalPagesSpilled),
           averageBufferTimeMs(_averageBufferTimeMs),
           numTopBuffers(_numTopBuffers),
           buffersStats(_buffersStats) {}
@@ -245,6 +334,16 @@ class OutputBuffer {
     int64_t totalRowsSent{0};
     int64_t totalPagesSent{0};
 
+    /// The total number of pages enqueued by the producers. This is more than
+    /// 'totalPagesSent' if small pages are merged, see
+    /// QueryConfig::kOutputBufferCoalesceTargetBytes.
+    int64_t totalPagesEnqueued{0};
+
+    /// The total number of bytes/pages written to disk for slow consumers, see
+    /// QueryConfig::kOutputBufferSpillEnabled.
+    int64_t totalBytesSpilled{0};
+    int64_t totalPagesSpilled{0};
+
     /// Average time each piece of data has been buffered for in milliseconds.
     int64_t averageBufferTimeMs{0};
 
@@ -365,6 +464,42 @@ class OutputBuffer {
       std::unique_ptr<SerializedPage> data,
       std::vector<DataAvailable>& dataAvailableCbs);
 
+  // Makes the pending small pages of 'buffer' available to its consumer as
+  // one page. Returns true if any page was made available.
+  bool flushPendingPagesLocked(DestinationBuffer* buffer);
+
+  // Calls flushPendingPagesLocked() for all destinations and adds the
+  // notifications of the waiting consumers to 'dataAvailableCbs'.
+  void flushAllPendingPagesLocked(std::vector<DataAvailable>& dataAvailableCbs);
+
+  // Spills the unfetched pages of the destinations with the most buffered
+  // data until the buffered size goes below 'continueSize_'. Adds the spilled
+  // pages to 'freed' and the producers to unblock to 'promises'.
+  void spillLocked(
+      std::vector<std::shared_ptr<SerializedPage>>& freed,
+      std::vector<ContinuePromise>& promises);
+
+  // Reads back the spilled pages of 'buffer' the consumer fetching from
+  // 'sequence' with 'maxBytes' needs.
+  void unspillLocked(
+      DestinationBuffer* buffer,
+      int64_t sequence,
+      uint64_t maxBytes);
+
+  // Returns true if 'this' holds more than its share of the node-wide
+  // exchange memory budget.
+  bool overMemoryBudgetLocked() const {
+    return memoryConsumer_ != nullptr && memoryConsumer_->availableBytes() < 0;
+  }
+
+  // Returns true if blocked producers may resume. This is when the buffered
+  // size is below 'continueSize_' and within the share of the node-wide
+  // budget, or when nothing is buffered.
+  bool canContinueLocked() const {
+    return static_cast<uint64_t>(bufferedBytes_) < continueSize_ &&
+        (bufferedBytes_ == 0 || !overMemoryBudgetLocked());
+  }
+
   std::string toStringLocked() const;
 
   FOLLY_ALWAYS_INLINE bool isBroadcast() const {
@@ -388,6 +523,17 @@ class OutputBuffer {
   // resumed.
   const uint64_t continueSize_;
   const std::unique_ptr<ArbitraryBuffer> arbitraryBuffer_;
+  // Pages smaller than this are merged per destination for partitioned
+  // output. 0 if disabled.
+  const uint64_t coalesceTargetBytes_;
+  // Maximum time a small page waits to be merged.
+  const uint64_t coalesceMaxDelayMs_;
+  // True if unfetched pages are spilled instead of blocking the producers.
+  // Only for partitioned output.
+  const bool spillEnabled_;
+  // Share of the node-wide exchange memory budget. nullptr if there is no
+  // node-wide budget. Producers are blocked while 'this' is over its share.
+  const std::unique_ptr<ExchangeMemoryManager::Consumer> memoryConsumer_;
 
   // Total number of drivers expected to produce results. This number will
   // decrease in the end of grouped execution, when we understand the real
@@ -412,6 +558,11 @@ class OutputBuffer {
   uint64_t numOutputBytes_{0};
   uint64_t numOutputRows_{0};
   uint64_t numOutputPages_{0};
+  // The number of pages enqueued by the producers before merging.
+  uint64_t numEnqueuedPages_{0};
+  // The total number of spilled bytes and pages.
+  uint64_t numSpilledBytes_{0};
+  uint64_t numSpilledPages_{0};
   std::vector<ContinuePromise> promises_;
   // The next buffer index in 'buffers_' to load data from arbitrary buffer
   // which is only used by arbitrary output type.
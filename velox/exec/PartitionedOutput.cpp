@@ -15,6 +15,9 @@
  */
 
 #include "velox/exec/PartitionedOutput.h"
+
+#include <algorithm>
+
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
 
@@ -58,6 +61,9 @@ BlockingReason Destination::advance(
     options.compressionKind =
         OutputBufferManager::getInstance().lock()->compressionKind();
     options.minCompressionRatio = PartitionedOutput::minCompressionRatio();
+    options.preserveEncodings = preserveEncodings_;
+    options.maxCompressionNanosPerSavedByte =
+        maxCompressionNanosPerSavedByte_;
     current_->createStreamTree(rowType, rowsInCurrent_, &options);
   }
   current_->append(
@@ -82,14 +88,20 @@ BlockingReason Destination::flush(
 
   // Upper limit of message size with no columns.
   constexpr int32_t kMinMessageSize = 128;
+  // The serialized pages of 'current_' are referenced, not copied, so
+  // 'stream' holds mostly headers and small ranges.
+  constexpr int64_t kMaxInitialMessageSize = 64 << 10;
   auto listener = bufferManager.newListener();
   IOBufOutputStream stream(
       *current_->pool(),
       listener.get(),
-      std::max<int64_t>(kMinMessageSize, current_->size()));
+      std::clamp<int64_t>(
+          current_->size(), kMinMessageSize, kMaxInitialMessageSize));
+  stream.setReferenceArenaBytes();
   const int64_t flushedRows = rowsInCurrent_;
 
   current_->flush(&stream);
+  auto referencedArena = current_->detach();
   current_->clear();
 
   const int64_t flushedBytes = stream.tellp();
@@ -102,7 +114,9 @@ BlockingReason Destination::flush(
       taskId_,
       destination_,
       std::make_unique<SerializedPage>(
-          stream.getIOBuf(bufferReleaseFn), nullptr, flushedRows),
+          stream.getIOBuf(bufferReleaseFn, std::move(referencedArena)),
+          nullptr,
+          flushedRows),
       future);
 
   recordEnqueued_(flushedBytes, flushedRows);
@@ -155,7 +169,14 @@ PartitionedOutput::PartitionedOutput(
       maxBufferedBytes_(ctx->task->queryCtx()
                             ->queryConfig()
                             .maxPartitionedOutputBufferSize()),
-      eagerFlush_(eagerFlush) {
+      eagerFlush_(eagerFlush),
+      preserveEncodings_(ctx->task->queryCtx()
+                             ->queryConfig()
+                             .partitionedOutputPreserveEncodings()),
+      maxCompressionNanosPerSavedByte_(
+          ctx->task->queryCtx()
+              ->queryConfig()
+              .partitionedOutputMaxCompressionNanosPerSavedByte()) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -197,10 +218,16 @@ void PartitionedOutput::initializeDestinations() {
     auto taskId = operatorCtx_->taskId();
     for (int i = 0; i < numDestinations_; ++i) {
       destinations_.push_back(std::make_unique<detail::Destination>(
-          taskId, i, pool(), eagerFlush_, [&](uint64_t bytes, uint64_t rows) {
+          taskId,
+          i,
+          pool(),
+          eagerFlush_,
+          [&](uint64_t bytes, uint64_t rows) {
             auto lockedStats = stats_.wlock();
             lockedStats->addOutputVector(bytes, rows);
-          }));
+          },
+          preserveEncodings_,
+          maxCompressionNanosPerSavedByte_));
     }
   }
 }
@@ -279,8 +306,19 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
         destinations_[singlePartition.value()]->addRows(
             IndexRange{0, numInput});
       } else {
+        // Counts the rows of each destination first, so that the row numbers
+        // are scattered in one pass without growing the destinations.
+        numDestinationRows_.assign(numDestinations_, 0);
+        for (vector_size_t i = 0; i < numInput; ++i) {
+          ++numDestinationRows_[partitions_[i]];
+        }
+        destinationRows_.resize(numDestinations_);
+        for (auto i = 0; i < numDestinations_; ++i) {
+          destinationRows_[i] =
+              destinations_[i]->appendRows(numDestinationRows_[i]);
+        }
         for (vector_size_t i = 0; i < numInput; ++i) {
-          destinations_[partitions_[i]]->addRow(i);
+          *destinationRows_[partitions_[i]]++ = i;
         }
       }
     }
@@ -32,12 +32,16 @@ class Destination {
       int destination,
       memory::MemoryPool* pool,
       bool eagerFlush,
-      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued)
+      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued,
+      bool preserveEncodings = false,
+      float maxCompressionNanosPerSavedByte = 0)
       : taskId_(taskId),
         destination_(destination),
         pool_(pool),
         eagerFlush_(eagerFlush),
-        recordEnqueued_(std::move(recordEnqueued)) {
+        recordEnqueued_(std::move(recordEnqueued)),
+        preserveEncodings_(preserveEncodings),
+        maxCompressionNanosPerSavedByte_(maxCompressionNanosPerSavedByte) {
     setTargetSizePct();
   }
 
@@ -57,6 +61,13 @@ class Destination {
     }
   }
 
+  /// Adds 'numRows' rows and returns where to write their row numbers.
+  vector_size_t* appendRows(vector_size_t numRows) {
+    const auto size = rows_.size();
+    rows_.resize(size + numRows);
+    return rows_.data() + size;
+  }
+
   // Serializes row from 'output' till either 'maxBytes' have been serialized or
   BlockingReason advance(
       uint64_t maxBytes,
@@ -107,6 +118,11 @@ class Destination {
   memory::MemoryPool* const pool_;
   const bool eagerFlush_;
   const std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued_;
+  // Keeps dictionary and constant encodings in the serialized pages. See
+  // PrestoVectorSerde::PrestoOptions::preserveEncodings.
+  const bool preserveEncodings_;
+  // See PrestoVectorSerde::PrestoOptions::maxCompressionNanosPerSavedByte.
+  const float maxCompressionNanosPerSavedByte_;
 
   // Bytes serialized in 'current_'
   uint64_t bytesInCurrent_{0};
@@ -219,6 +235,8 @@ class PartitionedOutput : public Operator {
   const std::function<void()> bufferReleaseFn_;
   const int64_t maxBufferedBytes_;
   const bool eagerFlush_;
+  const bool preserveEncodings_;
+  const float maxCompressionNanosPerSavedByte_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -233,6 +251,8 @@ class PartitionedOutput : public Operator {
   SelectivityVector rows_;
   SelectivityVector nullRows_;
   std::vector<uint32_t> partitions_;
+  std::vector<vector_size_t> numDestinationRows_;
+  std::vector<vector_size_t*> destinationRows_;
   std::vector<DecodedVector> decodedVectors_;
   Scratch scratch_;
 };
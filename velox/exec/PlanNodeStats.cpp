@@ -14,11 +14,25 @@
  * limitations under the License.
  */
 #include "velox/exec/PlanNodeStats.h"
+
+#include <algorithm>
+
 #include "velox/common/base/SuccinctPrinter.h"
+#include "velox/exec/HashTable.h"
 #include "velox/exec/TaskStats.h"
 
 namespace facebook::velox::exec {
 
+namespace {
+// Returns true for the operators the LocalPlanner adds under the plan node of
+// the operator they follow. They pass the rows of the node through, so adding
+// their stats to the totals of the node would count its rows and batches
+// twice.
+bool isAddedByPlanner(const std::string& operatorType) {
+  return operatorType == "CoalesceBatches";
+}
+} // namespace
+
 void PlanNodeStats::add(const OperatorStats& stats) {
   auto it = operatorStats.find(stats.operatorType);
   if (it != operatorStats.end()) {
@@ -28,7 +42,16 @@ void PlanNodeStats::add(const OperatorStats& stats) {
     opStats->addTotals(stats);
     operatorStats.emplace(stats.operatorType, std::move(opStats));
   }
-  addTotals(stats);
+  if (!isAddedByPlanner(stats.operatorType)) {
+    addTotals(stats);
+  }
+}
+
+bool PlanNodeStats::isMultiOperatorTypeNode() const {
+  return std::count_if(
+             operatorStats.begin(), operatorStats.end(), [](const auto& entry) {
+               return !isAddedByPlanner(entry.first);
+             }) > 1;
 }
 
 void PlanNodeStats::addTotals(const OperatorStats& stats) {
@@ -55,6 +78,7 @@ void PlanNodeStats::addTotals(const OperatorStats& stats) {
 
   peakMemoryBytes += stats.memoryStats.peakTotalMemoryReservation;
   numMemoryAllocations += stats.memoryStats.numMemoryAllocations;
+  MemoryTimelineSample::merge(memoryTimeline, stats.memoryTimeline);
 
   physicalWrittenBytes += stats.physicalWrittenBytes;
 
@@ -65,6 +89,9 @@ void PlanNodeStats::addTotals(const OperatorStats& stats) {
       customStats.at(name).merge(runtimeStats);
     }
   }
+  inputBatchRows.merge(stats.inputBatchRows);
+  outputBatchRows.merge(stats.outputBatchRows);
+  outputBatchNanos.merge(stats.outputBatchNanos);
 
   // Populating number of drivers for plan nodes with multiple operators is not
   // useful. Each operator could have been executed in different pipelines with
@@ -82,6 +109,20 @@ void PlanNodeStats::addTotals(const OperatorStats& stats) {
   spilledRows += stats.spilledRows;
   spilledPartitions += stats.spilledPartitions;
   spilledFiles += stats.spilledFiles;
+
+  auto it = stats.runtimeStats.find(BaseHashTable::kMaxRowsPerKey);
+  if (it != stats.runtimeStats.end()) {
+    maxBuildRowsPerKey =
+        std::max<uint64_t>(maxBuildRowsPerKey, it->second.max);
+  }
+  it = stats.runtimeStats.find(BaseHashTable::kNumHeavyHitterKeys);
+  if (it != stats.runtimeStats.end()) {
+    numHeavyHitterKeys += it->second.sum;
+  }
+  it = stats.runtimeStats.find(BaseHashTable::kNumHeavyHitterRows);
+  if (it != stats.runtimeStats.end()) {
+    numHeavyHitterBuildRows += it->second.sum;
+  }
 }
 
 std::string PlanNodeStats::toString(bool includeInputStats) const {
@@ -114,9 +155,27 @@ std::string PlanNodeStats::toString(bool includeInputStats) const {
         << succinctBytes(spilledBytes) << ", " << spilledFiles << " files)";
   }
 
+  if (maxBuildRowsPerKey > 0) {
+    out << ", Max build rows per key: " << maxBuildRowsPerKey;
+  }
+
+  if (numHeavyHitterKeys > 0) {
+    out << ", Heavy hitter keys: " << numHeavyHitterKeys << " ("
+        << numHeavyHitterBuildRows << " build rows)";
+  }
+
   if (!dynamicFilterStats.empty()) {
     out << ", DynamicFilter producer plan nodes: "
         << folly::join(',', dynamicFilterStats.producerNodeIds);
+    if (dynamicFilterStats.bloomFilterRowsTested > 0 ||
+        dynamicFilterStats.bloomFilterRangesTested > 0) {
+      out << ", BloomFilter rejected rows: "
+          << dynamicFilterStats.bloomFilterRowsRejected << "/"
+          << dynamicFilterStats.bloomFilterRowsTested
+          << ", rejected ranges: "
+          << dynamicFilterStats.bloomFilterRangesRejected << "/"
+          << dynamicFilterStats.bloomFilterRangesTested;
+    }
   }
 
   return out.str();
@@ -177,6 +236,19 @@ folly::dynamic toPlanStatsJson(const facebook::velox::exec::TaskStats& stats) {
       }
       stat["customStats"] = cs;
 
+      if (!operatorStat.second->memoryTimeline.empty()) {
+        folly::dynamic timeline = folly::dynamic::array;
+        for (const auto& sample : operatorStat.second->memoryTimeline) {
+          folly::dynamic entry = folly::dynamic::object;
+          entry["timeMs"] = sample.timeMs;
+          entry["usedBytes"] = sample.usedBytes;
+          entry["reservedBytes"] = sample.reservedBytes;
+          entry["spilledBytes"] = sample.spilledBytes;
+          timeline.push_back(entry);
+        }
+        stat["memoryTimeline"] = timeline;
+      }
+
       jsonStats.push_back(stat);
     }
   }
@@ -208,12 +280,48 @@ void printCustomStats(
     metric.printMetric(stream);
   }
 }
+
+void printBatchHistograms(
+    const PlanNodeStats& stats,
+    const std::string& indentation,
+    std::stringstream& stream) {
+  std::pair<const char*, const RuntimeHistogram*> histograms[] = {
+      {"Input batch rows: ", &stats.inputBatchRows},
+      {"Output batch rows: ", &stats.outputBatchRows},
+      {"Output batch latency: ", &stats.outputBatchNanos}};
+  for (const auto& [name, histogram] : histograms) {
+    if (!histogram->empty()) {
+      stream << std::endl << indentation << name << histogram->toString();
+    }
+  }
+}
+
+void printMemoryTimeline(
+    const std::vector<MemoryTimelineSample>& timeline,
+    uint64_t startTimeMs,
+    const std::string& indentation,
+    std::stringstream& stream) {
+  if (timeline.empty()) {
+    return;
+  }
+  stream << std::endl << indentation << "Memory timeline:";
+  for (const auto& sample : timeline) {
+    const auto timeMs =
+        sample.timeMs > startTimeMs ? sample.timeMs - startTimeMs : 0;
+    stream << std::endl
+           << indentation << "   " << succinctMillis(timeMs)
+           << ": used: " << succinctBytes(sample.usedBytes)
+           << ", reserved: " << succinctBytes(sample.reservedBytes)
+           << ", spilled: " << succinctBytes(sample.spilledBytes);
+  }
+}
 } // namespace
 
 std::string printPlanWithStats(
     const core::PlanNode& plan,
     const TaskStats& taskStats,
-    bool includeCustomStats) {
+    bool includeCustomStats,
+    bool includeBatchHistograms) {
   auto planStats = toPlanStats(taskStats);
   auto leafPlanNodes = plan.leafPlanNodeIds();
 
@@ -231,7 +339,7 @@ std::string printPlanWithStats(
 
         // Include break down by operator type for plan nodes with multiple
         // operators. Print input rows and sizes for all such nodes.
-        if (stats.isMultiOperatorTypeNode()) {
+        if (stats.operatorStats.size() > 1) {
           for (const auto& entry : stats.operatorStats) {
             stream << std::endl;
             stream << indentation << entry.first << ": "
@@ -241,11 +349,27 @@ std::string printPlanWithStats(
               printCustomStats(
                   entry.second->customStats, indentation + "   ", stream);
             }
+            if (includeBatchHistograms) {
+              printBatchHistograms(*entry.second, indentation + "   ", stream);
+            }
+            printMemoryTimeline(
+                entry.second->memoryTimeline,
+                taskStats.executionStartTimeMs,
+                indentation + "   ",
+                stream);
           }
         } else {
           if (includeCustomStats) {
             printCustomStats(stats.customStats, indentation + "   ", stream);
           }
+          if (includeBatchHistograms) {
+            printBatchHistograms(stats, indentation + "   ", stream);
+          }
+          printMemoryTimeline(
+              stats.memoryTimeline,
+              taskStats.executionStartTimeMs,
+              indentation + "   ",
+              stream);
         }
       });
 }
@@ -95,12 +95,25 @@ struct PlanNodeStats {
 
   uint64_t numMemoryAllocations{0};
 
+  /// Sum of the memory timelines of all corresponding operators, see
+  /// MemoryTimelineSample::merge(). An operator that did not run in an
+  /// interval counts its previous sample.
+  std::vector<MemoryTimelineSample> memoryTimeline;
+
   uint64_t physicalWrittenBytes{0};
 
   /// Operator-specific counters.
   std::unordered_map<std::string, RuntimeMetric> customStats;
 
-  /// Breakdown of stats by operator type.
+  /// Sum of the batch histograms of all corresponding operators, see
+  /// OperatorStats::inputBatchRows.
+  RuntimeHistogram inputBatchRows;
+  RuntimeHistogram outputBatchRows;
+  RuntimeHistogram outputBatchNanos{RuntimeCounter::Unit::kNanos};
+
+  /// Breakdown of stats by operator type. Includes the operators the
+  /// LocalPlanner adds under the plan node, e.g. CoalesceBatches, which are
+  /// not included in the totals above.
   std::unordered_map<std::string, std::unique_ptr<PlanNodeStats>> operatorStats;
 
   /// Number of drivers that executed the pipeline.
@@ -124,14 +137,23 @@ struct PlanNodeStats {
   /// Total spilled files.
   uint32_t spilledFiles{0};
 
+  /// Max number of build rows of a single join key of a hash join, see
+  /// core::QueryConfig::kHashBuildHeavyHitterMinPct.
+  uint64_t maxBuildRowsPerKey{0};
+
+  /// Total number of heavy hitter join keys of a hash join and of their build
+  /// rows.
+  uint64_t numHeavyHitterKeys{0};
+  uint64_t numHeavyHitterBuildRows{0};
+
   /// Add stats for a single operator instance.
   void add(const OperatorStats& stats);
 
   std::string toString(bool includeInputStats = false) const;
 
-  bool isMultiOperatorTypeNode() const {
-    return operatorStats.size() > 1;
-  }
+  /// Returns true if the plan node corresponds to multiple operator types,
+  /// not counting the ones added by the LocalPlanner.
+  bool isMultiOperatorTypeNode() const;
 
  private:
   void addTotals(const OperatorStats& stats);
@@ -150,10 +172,15 @@ folly::dynamic toPlanStatsJson(const facebook::velox::exec::TaskStats& stats);
 /// statistics per operator type.
 ///
 /// Note that input row counts and sizes are printed only for leaf plan nodes.
+/// The memory timeline is printed for plan nodes that have one, with times
+/// relative to TaskStats::executionStartTimeMs.
 ///
 /// @param includeCustomStats If true, prints operator-specific counters.
+/// @param includeBatchHistograms If true, prints the histograms of input and
+/// output batch rows and of output batch latency.
 std::string printPlanWithStats(
     const core::PlanNode& plan,
     const TaskStats& taskStats,
-    bool includeCustomStats = false);
+    bool includeCustomStats = false,
+    bool includeBatchHistograms = false);
 } // namespace facebook::velox::exec
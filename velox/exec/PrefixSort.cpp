@@ -43,6 +43,100 @@ FOLLY_ALWAYS_INLINE void encodeRowColumn(
       value, prefix + prefixSortLayout.prefixOffsets[index]);
 }
 
+FOLLY_ALWAYS_INLINE void encodeStringRowColumn(
+    const PrefixSortLayout& prefixSortLayout,
+    const uint32_t index,
+    const RowColumn& rowColumn,
+    char* const row,
+    char* const prefix) {
+  std::optional<StringView> value;
+  std::string storage;
+  if (!RowContainer::isNullAt(
+          row, rowColumn.nullByte(), rowColumn.nullMask())) {
+    value = HashStringAllocator::contiguousString(
+        *reinterpret_cast<StringView*>(row + rowColumn.offset()), storage);
+  }
+  prefixSortLayout.encoders[index].encode(
+      value,
+      prefix + prefixSortLayout.prefixOffsets[index],
+      prefixSortLayout.stringPrefixLength);
+}
+
+template <typename T>
+FOLLY_ALWAYS_INLINE void encodeStructChild(
+    const PrefixSortEncoder& encoder,
+    const BaseVector& child,
+    vector_size_t index,
+    char* const dest) {
+  std::optional<T> value;
+  if (!child.isNullAt(index)) {
+    value = child.asUnchecked<SimpleVector<T>>()->valueAt(index);
+  }
+  encoder.encode(value, dest);
+}
+
+// Encodes structs[index] as its null byte followed by the encodings of its
+// leading children. The children of null structs are encoded as zeros.
+void encodeStructColumn(
+    const PrefixSortLayout& prefixSortLayout,
+    const uint32_t keyIndex,
+    const RowVector& structs,
+    vector_size_t index,
+    char* const prefix) {
+  const auto& encoder = prefixSortLayout.encoders[keyIndex];
+  const auto begin = prefixSortLayout.prefixOffsets[keyIndex];
+  const auto end = keyIndex + 1 < prefixSortLayout.numNormalizedKeys
+      ? prefixSortLayout.prefixOffsets[keyIndex + 1]
+      : prefixSortLayout.normalizedBufferSize - prefixSortLayout.padding;
+  char* dest = prefix + begin;
+  if (structs.isNullAt(index)) {
+    encoder.encodeNullByte(true, dest);
+    simd::memset(dest + 1, 0, end - begin - 1);
+    return;
+  }
+  encoder.encodeNullByte(false, dest);
+  ++dest;
+  const auto stringPrefixLength = prefixSortLayout.stringPrefixLength;
+  const auto numChildren = PrefixSortEncoder::numEncodedChildren(
+      structs.type(), stringPrefixLength);
+  for (auto i = 0; i < numChildren; ++i) {
+    const auto& child = *structs.childAt(i);
+    const auto kind = child.typeKind();
+    switch (kind) {
+      case TypeKind::INTEGER:
+        encodeStructChild<int32_t>(encoder, child, index, dest);
+        break;
+      case TypeKind::BIGINT:
+        encodeStructChild<int64_t>(encoder, child, index, dest);
+        break;
+      case TypeKind::REAL:
+        encodeStructChild<float>(encoder, child, index, dest);
+        break;
+      case TypeKind::DOUBLE:
+        encodeStructChild<double>(encoder, child, index, dest);
+        break;
+      case TypeKind::TIMESTAMP:
+        encodeStructChild<Timestamp>(encoder, child, index, dest);
+        break;
+      case TypeKind::VARCHAR:
+        [[fallthrough]];
+      case TypeKind::VARBINARY: {
+        std::optional<StringView> value;
+        if (!child.isNullAt(index)) {
+          value = child.asUnchecked<SimpleVector<StringView>>()->valueAt(index);
+        }
+        encoder.encode(value, dest, stringPrefixLength);
+        break;
+      }
+      default:
+        VELOX_UNREACHABLE(
+            "prefix-sort does not support struct child type kind: {}",
+            mapTypeKindToName(kind));
+    }
+    dest += PrefixSortEncoder::encodedSize(kind, stringPrefixLength).value();
+  }
+}
+
 FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
     TypeKind typeKind,
     const PrefixSortLayout& prefixSortLayout,
@@ -72,6 +166,12 @@ FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
           prefixSortLayout, index, rowColumn, row, prefix);
       return;
     }
+    case TypeKind::VARCHAR:
+      [[fallthrough]];
+    case TypeKind::VARBINARY: {
+      encodeStringRowColumn(prefixSortLayout, index, rowColumn, row, prefix);
+      return;
+    }
     default:
       VELOX_UNSUPPORTED(
           "prefix-sort does not support type kind: {}",
@@ -115,27 +215,36 @@ compareByWord(uint64_t* left, uint64_t* right, int32_t bytes) {
 PrefixSortLayout PrefixSortLayout::makeSortLayout(
     const std::vector<TypePtr>& types,
     const std::vector<CompareFlags>& compareFlags,
-    uint32_t maxNormalizedKeySize) {
+    uint32_t maxNormalizedKeySize,
+    uint32_t maxStringPrefixLength) {
   uint32_t normalizedKeySize = 0;
   uint32_t numNormalizedKeys = 0;
+  bool lastKeyIsPrefix = false;
   const uint32_t numKeys = types.size();
   std::vector<uint32_t> prefixOffsets;
   std::vector<PrefixSortEncoder> encoders;
 
   // Calculate encoders and prefix-offsets, and stop the loop if a key that
-  // cannot be normalized is encountered.
+  // cannot be normalized is encountered. A string key stops the loop after it
+  // is added, the order of the following keys is only decided by their prefix
+  // if the full strings are equal.
   for (auto i = 0; i < numKeys; ++i) {
     if (normalizedKeySize > maxNormalizedKeySize) {
       break;
     }
     std::optional<uint32_t> encodedSize =
-        PrefixSortEncoder::encodedSize(types[i]->kind());
+        PrefixSortEncoder::encodedSize(types[i], maxStringPrefixLength);
     if (encodedSize.has_value()) {
       prefixOffsets.push_back(normalizedKeySize);
       encoders.push_back(
           {compareFlags[i].ascending, compareFlags[i].nullsFirst});
       normalizedKeySize += encodedSize.value();
       numNormalizedKeys++;
+      if (PrefixSortEncoder::isPrefixEncoded(
+              types[i], maxStringPrefixLength)) {
+        lastKeyIsPrefix = true;
+        break;
+      }
     } else {
       break;
     }
@@ -149,7 +258,9 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
       numKeys,
       compareFlags,
       numNormalizedKeys == 0,
-      numNormalizedKeys < numKeys,
+      numNormalizedKeys < numKeys || lastKeyIsPrefix,
+      numNormalizedKeys - (lastKeyIsPrefix ? 1 : 0),
+      maxStringPrefixLength,
       std::move(prefixOffsets),
       std::move(encoders),
       padding};
@@ -167,10 +278,12 @@ int PrefixSort::comparePartNormalizedKeys(char* left, char* right) {
   if (result != 0) {
     return result;
   }
-  // If prefixes are equal, compare the left sort keys with rowContainer.
+  // If prefixes are equal, compare the left sort keys with rowContainer. A
+  // string key stored as a prefix is compared again with its full value.
   char* leftAddress = getAddressFromPrefix(left);
   char* rightAddress = getAddressFromPrefix(right);
-  for (auto i = sortLayout_.numNormalizedKeys; i < sortLayout_.numKeys; ++i) {
+  for (auto i = sortLayout_.numFullyNormalizedKeys; i < sortLayout_.numKeys;
+       ++i) {
     result = rowContainer_->compare(
         leftAddress, rightAddress, i, sortLayout_.compareFlags[i]);
     if (result != 0) {
@@ -186,10 +299,36 @@ PrefixSort::PrefixSort(
     const std::vector<CompareFlags>& keyCompareFlags,
     const PrefixSortConfig& config,
     const PrefixSortLayout& sortLayout)
-    : pool_(pool), sortLayout_(sortLayout), rowContainer_(rowContainer) {}
+    : pool_(pool), sortLayout_(sortLayout), rowContainer_(rowContainer) {
+  structKeys_.resize(sortLayout_.numNormalizedKeys);
+  for (auto i = 0; i < sortLayout_.numNormalizedKeys; ++i) {
+    if (rowContainer_->keyTypes()[i]->kind() == TypeKind::ROW) {
+      hasStructKeys_ = true;
+    }
+  }
+}
 
-void PrefixSort::extractRowToPrefix(char* row, char* prefix) {
+void PrefixSort::extractStructKeys(const char* const* rows, int32_t numRows) {
+  for (auto i = 0; i < sortLayout_.numNormalizedKeys; ++i) {
+    const auto& type = rowContainer_->keyTypes()[i];
+    if (type->kind() != TypeKind::ROW) {
+      continue;
+    }
+    auto structs = BaseVector::create(type, numRows, pool_);
+    rowContainer_->extractColumn(rows, numRows, i, structs);
+    structKeys_[i] = std::static_pointer_cast<RowVector>(structs);
+  }
+}
+
+void PrefixSort::extractRowToPrefix(
+    char* row,
+    char* prefix,
+    vector_size_t structIndex) {
   for (auto i = 0; i < sortLayout_.numNormalizedKeys; i++) {
+    if (structKeys_[i] != nullptr) {
+      encodeStructColumn(sortLayout_, i, *structKeys_[i], structIndex, prefix);
+      continue;
+    }
     extractRowColumnToPrefix(
         rowContainer_->keyTypes()[i]->kind(),
         sortLayout_,
@@ -225,10 +364,20 @@ void PrefixSort::sortInternal(std::vector<char*>& rows) {
   }
   char* const prefixes = prefixAllocation.data<char>();
 
-  // 2. Extract rows to prefixes with row address.
-  for (auto i = 0; i < rows.size(); ++i) {
-    extractRowToPrefix(rows[i], prefixes + entrySize * i);
+  // 2. Extract rows to prefixes with row address. Struct keys are serialized
+  // in the RowContainer. These are deserialized once per row, a batch at a
+  // time, instead of in each comparison.
+  const auto batchSize = hasStructKeys_ ? kStructBatchSize : numRows;
+  for (size_t begin = 0; begin < numRows; begin += batchSize) {
+    const auto end = std::min<size_t>(begin + batchSize, numRows);
+    if (hasStructKeys_) {
+      extractStructKeys(rows.data() + begin, end - begin);
+    }
+    for (auto i = begin; i < end; ++i) {
+      extractRowToPrefix(rows[i], prefixes + entrySize * i, i - begin);
+    }
   }
+  std::fill(structKeys_.begin(), structKeys_.end(), nullptr);
 
   // 3. Sort prefixes with row address.
   {
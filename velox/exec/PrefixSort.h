@@ -42,8 +42,13 @@ FOLLY_ALWAYS_INLINE void stdSort(
 }; // namespace detail
 
 struct PrefixSortConfig {
-  PrefixSortConfig(uint32_t maxNormalizedKeySize, uint32_t threshold = 130)
-      : maxNormalizedKeySize(maxNormalizedKeySize), threshold(threshold) {}
+  PrefixSortConfig(
+      uint32_t maxNormalizedKeySize,
+      uint32_t threshold = 130,
+      uint32_t maxStringPrefixLength = 16)
+      : maxNormalizedKeySize(maxNormalizedKeySize),
+        threshold(threshold),
+        maxStringPrefixLength(maxStringPrefixLength) {}
 
   /// Max number of bytes can store normalized keys in prefix-sort buffer per
   /// entry.
@@ -53,17 +58,23 @@ struct PrefixSortConfig {
   /// The threshold is set to 100 according to the benchmark test results by
   /// default.
   const int64_t threshold;
+
+  /// Number of leading bytes of a VARCHAR or VARBINARY key stored in the
+  /// prefix. Rows with equal prefixes are compared with the full values from
+  /// the RowContainer. 0 disables the normalization of string keys.
+  const uint32_t maxStringPrefixLength;
 };
 
 /// The layout of prefix-sort buffer, a prefix entry includes:
 /// 1. normalized keys
-/// 2. non-normalized data ptr for semi-normalized types such as
-/// string_view`s ptr, it will be filled when support Varchar.
-/// 3. the row address ptr point to RowContainer`s rows is added at the end of
+/// 2. the row address ptr point to RowContainer`s rows is added at the end of
 /// prefix.
+/// A VARCHAR or VARBINARY key stores the first
+/// 'PrefixSortConfig::maxStringPrefixLength' bytes of its value and is the last
+/// normalized key, as its prefix does not decide the order when equal.
 struct PrefixSortLayout {
   /// Number of bytes to store a prefix, it equals to:
-  /// normalizedKeySize_ + 8 (non-normalized-ptr) + 8(row address).
+  /// normalizedKeySize_ + 8(row address).
   const uint64_t entrySize;
 
   /// If a sort key supports normalization and can be added to the prefix
@@ -82,9 +93,19 @@ struct PrefixSortLayout {
   /// It equals to 'numNormalizedKeys == 0', a little faster.
   const bool noNormalizedKeys;
 
-  /// Whether the sort keys contains non-normalized key.
+  /// Whether the sort keys contains non-normalized key or the last normalized
+  /// key is a string prefix. The keys from 'numFullyNormalizedKeys' on are
+  /// compared with the RowContainer if the prefixes are equal.
   const bool hasNonNormalizedKey;
 
+  /// The number of leading keys whose order is decided by the prefix alone.
+  /// Equals 'numNormalizedKeys' - 1 if the last normalized key is a string
+  /// prefix, 'numNormalizedKeys' otherwise.
+  const uint32_t numFullyNormalizedKeys;
+
+  /// Number of bytes stored for a normalized string key.
+  const uint32_t stringPrefixLength;
+
   /// Offsets of normalized keys, used to find write locations when
   /// extracting columns
   const std::vector<uint32_t> prefixOffsets;
@@ -99,7 +120,8 @@ struct PrefixSortLayout {
   static PrefixSortLayout makeSortLayout(
       const std::vector<TypePtr>& types,
       const std::vector<CompareFlags>& compareFlags,
-      uint32_t maxNormalizedKeySize);
+      uint32_t maxNormalizedKeySize,
+      uint32_t maxStringPrefixLength = 0);
 };
 
 class PrefixSort {
@@ -122,13 +144,12 @@ class PrefixSort {
   /// the normalized binary string.
   /// For keys can not normalized, we use RowContainer`s compare method to
   /// compare value.
-  /// For keys can part-normalized(Varchar, Row etc.), we will store the
-  /// normalized part and points to raw data in prefix, and custom the points
-  /// compare. The compare strategy will be defined in PrefixSortLayout as
-  /// follow-up, we treat this part as non-normalized until we implement all
-  /// fixed width types.
-  /// For complex types, e.g. ROW that can be converted to scalar types will be
-  /// supported.
+  /// For keys can part-normalized(Varchar, Varbinary), we store a prefix of
+  /// the value and compare the full values with RowContainer`s compare method
+  /// only when the prefixes are equal.
+  /// A ROW key stores the encodings of its leading scalar children. It is
+  /// compared with RowContainer`s compare method when the prefixes are equal
+  /// unless all its children are fully normalized.
   /// 4. Extract the original row address ptr from prefixes (previously stored
   /// them in the prefix buffer) into the input rows vector.
   ///
@@ -146,7 +167,10 @@ class PrefixSort {
     }
     VELOX_DCHECK_EQ(rowContainer->keyTypes().size(), compareFlags.size());
     const auto sortLayout = PrefixSortLayout::makeSortLayout(
-        rowContainer->keyTypes(), compareFlags, config.maxNormalizedKeySize);
+        rowContainer->keyTypes(),
+        compareFlags,
+        config.maxNormalizedKeySize,
+        config.maxStringPrefixLength);
     // All keys can not normalize, skip the binary string compare opt.
     // Putting this outside sort-internal helps with inline std-sort.
     if (sortLayout.noNormalizedKeys) {
@@ -165,7 +189,15 @@ class PrefixSort {
 
   int comparePartNormalizedKeys(char* left, char* right);
 
-  void extractRowToPrefix(char* row, char* prefix);
+  // Number of rows whose struct keys are deserialized at a time.
+  static constexpr int32_t kStructBatchSize = 1'024;
+
+  // Deserializes the ROW keys of 'rows' into 'structKeys_'.
+  void extractStructKeys(const char* const* rows, int32_t numRows);
+
+  // Encodes the normalized keys of 'row' into 'prefix'. The ROW keys are read
+  // from row 'structIndex' of 'structKeys_'.
+  void extractRowToPrefix(char* row, char* prefix, vector_size_t structIndex);
 
   // Return the reference of row address ptr for read/write.
   FOLLY_ALWAYS_INLINE char*& getAddressFromPrefix(char* prefix) {
@@ -175,5 +207,12 @@ class PrefixSort {
   memory::MemoryPool* const pool_;
   const PrefixSortLayout sortLayout_;
   RowContainer* const rowContainer_;
+
+  // True if a normalized key is a ROW.
+  bool hasStructKeys_{false};
+
+  // The current batch of values of each normalized ROW key, nullptr for the
+  // other keys.
+  std::vector<RowVectorPtr> structKeys_;
 };
 } // namespace facebook::velox::exec
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/RangePartitionFunction.h"
+#include "velox/common/encode/Base64.h"
+#include "velox/vector/VectorSaver.h"
+
+namespace facebook::velox::exec {
+
+RangePartitionFunction::RangePartitionFunction(
+    int numPartitions,
+    std::vector<column_index_t> keyChannels,
+    std::vector<CompareFlags> compareFlags,
+    RowVectorPtr boundaries,
+    std::vector<vector_size_t> boundaryRows)
+    : numPartitions_{numPartitions},
+      keyChannels_{std::move(keyChannels)},
+      compareFlags_{std::move(compareFlags)},
+      boundaries_{std::move(boundaries)},
+      boundaryRows_{std::move(boundaryRows)} {
+  VELOX_CHECK_GT(numPartitions_, 0);
+  VELOX_CHECK_EQ(keyChannels_.size(), compareFlags_.size());
+  VELOX_CHECK_LT(boundaryRows_.size(), numPartitions_);
+  if (!boundaryRows_.empty()) {
+    VELOX_CHECK_EQ(boundaries_->childrenSize(), keyChannels_.size());
+  }
+}
+
+bool RangePartitionFunction::lessThanBoundary(
+    const RowVector& input,
+    vector_size_t row,
+    vector_size_t boundary) const {
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    const auto result = input.childAt(keyChannels_[i])
+                            ->compare(
+                                boundaries_->childAt(i).get(),
+                                row,
+                                boundaryRows_[boundary],
+                                compareFlags_[i])
+                            .value();
+    if (result != 0) {
+      return result < 0;
+    }
+  }
+  return false;
+}
+
+std::optional<uint32_t> RangePartitionFunction::partition(
+    const RowVector& input,
+    std::vector<uint32_t>& partitions) {
+  if (boundaryRows_.empty()) {
+    return 0u;
+  }
+
+  const auto size = input.size();
+  partitions.resize(size);
+  for (auto row = 0; row < size; ++row) {
+    // Finds the first boundary the row sorts before. Rows equal to a boundary
+    // go to the partition ending at that boundary.
+    uint32_t low = 0;
+    uint32_t high = boundaryRows_.size();
+    while (low < high) {
+      const auto mid = (low + high) / 2;
+      if (lessThanBoundary(input, row, mid)) {
+        high = mid;
+      } else {
+        low = mid + 1;
+      }
+    }
+    partitions[row] = low;
+  }
+  return std::nullopt;
+}
+
+RangePartitionFunctionSpec::RangePartitionFunctionSpec(
+    RowTypePtr inputType,
+    std::vector<column_index_t> keyChannels,
+    std::vector<core::SortOrder> sortingOrders,
+    RowVectorPtr sample)
+    : inputType_{std::move(inputType)},
+      keyChannels_{std::move(keyChannels)},
+      sortingOrders_{std::move(sortingOrders)},
+      sample_{std::move(sample)} {
+  VELOX_CHECK(!keyChannels_.empty());
+  VELOX_CHECK_EQ(keyChannels_.size(), sortingOrders_.size());
+  VELOX_CHECK_NOT_NULL(sample_);
+  VELOX_CHECK_EQ(sample_->childrenSize(), keyChannels_.size());
+  compareFlags_.reserve(sortingOrders_.size());
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    VELOX_CHECK(
+        sample_->childAt(i)->type()->equivalent(
+            *inputType_->childAt(keyChannels_[i])),
+        "Type of sample column {} does not match the sort key: {} vs. {}",
+        i,
+        sample_->childAt(i)->type()->toString(),
+        inputType_->childAt(keyChannels_[i])->toString());
+    compareFlags_.push_back(
+        {sortingOrders_[i].isNullsFirst(),
+         sortingOrders_[i].isAscending(),
+         false,
+         CompareFlags::NullHandlingMode::kNullAsValue});
+  }
+
+  sortedRows_.resize(sample_->size());
+  std::iota(sortedRows_.begin(), sortedRows_.end(), 0);
+  std::sort(
+      sortedRows_.begin(),
+      sortedRows_.end(),
+      [&](vector_size_t left, vector_size_t right) {
+        for (auto i = 0; i < compareFlags_.size(); ++i) {
+          const auto& child = sample_->childAt(i);
+          const auto result =
+              child->compare(child.get(), left, right, compareFlags_[i])
+                  .value();
+          if (result != 0) {
+            return result < 0;
+          }
+        }
+        return false;
+      });
+}
+
+std::unique_ptr<core::PartitionFunction> RangePartitionFunctionSpec::create(
+    int numPartitions) const {
+  // Picks the sample rows at the 1 / numPartitions quantiles as the
+  // boundaries.
+  std::vector<vector_size_t> boundaryRows;
+  if (!sortedRows_.empty()) {
+    boundaryRows.reserve(numPartitions - 1);
+    for (auto i = 1; i < numPartitions; ++i) {
+      boundaryRows.push_back(
+          sortedRows_[(int64_t)i * sortedRows_.size() / numPartitions]);
+    }
+  }
+  return std::make_unique<RangePartitionFunction>(
+      numPartitions,
+      keyChannels_,
+      compareFlags_,
+      sample_,
+      std::move(boundaryRows));
+}
+
+std::string RangePartitionFunctionSpec::toString() const {
+  std::ostringstream keys;
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    if (i > 0) {
+      keys << ", ";
+    }
+    keys << inputType_->nameOf(keyChannels_[i]) << " "
+         << sortingOrders_[i].toString();
+  }
+  return fmt::format("RANGE({})", keys.str());
+}
+
+folly::dynamic RangePartitionFunctionSpec::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["name"] = "RangePartitionFunctionSpec";
+  obj["inputType"] = inputType_->serialize();
+  obj["keyChannels"] = ISerializable::serialize(keyChannels_);
+  folly::dynamic sortingOrders = folly::dynamic::array;
+  for (const auto& order : sortingOrders_) {
+    sortingOrders.push_back(order.serialize());
+  }
+  obj["sortingOrders"] = sortingOrders;
+  std::ostringstream out;
+  saveVector(*sample_, out);
+  const auto serializedSample = out.str();
+  obj["sample"] = encoding::Base64::encode(
+      serializedSample.data(), serializedSample.size());
+  return obj;
+}
+
+// static
+core::PartitionFunctionSpecPtr RangePartitionFunctionSpec::deserialize(
+    const folly::dynamic& obj,
+    void* context) {
+  const auto keys = ISerializable::deserialize<std::vector<column_index_t>>(
+      obj["keyChannels"], context);
+  std::vector<core::SortOrder> sortingOrders;
+  for (const auto& order : obj["sortingOrders"]) {
+    sortingOrders.push_back(core::SortOrder::deserialize(order));
+  }
+
+  auto* pool = static_cast<memory::MemoryPool*>(context);
+  std::istringstream sampleStream(
+      encoding::Base64::decode(obj["sample"].asString()));
+  auto sample = std::dynamic_pointer_cast<RowVector>(
+      restoreVector(sampleStream, pool));
+  VELOX_CHECK_NOT_NULL(sample);
+  return std::make_shared<RangePartitionFunctionSpec>(
+      ISerializable::deserialize<RowType>(obj["inputType"]),
+      keys,
+      std::move(sortingOrders),
+      std::move(sample));
+}
+} // namespace facebook::velox::exec
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/PlanNode.h"
+
+namespace facebook::velox::exec {
+
+/// Assigns rows to partitions by ranges of the sort keys. Partition 'i' gets
+/// the rows that sort after the boundary 'i - 1' and not after the boundary
+/// 'i' so that the partitions hold consecutive, non-overlapping ranges of the
+/// sort order. Sorting each partition and concatenating the partitions in
+/// partition order gives the sorted result. Rows with equal keys always go to
+/// the same partition.
+class RangePartitionFunction : public core::PartitionFunction {
+ public:
+  /// @param keyChannels Indices of the sort keys in the input.
+  /// @param compareFlags The sort order of each key.
+  /// @param boundaries The key values separating the partitions, one column
+  /// per key. 'boundaryRows' lists the numPartitions - 1 rows of
+  /// 'boundaries' in sort order.
+  RangePartitionFunction(
+      int numPartitions,
+      std::vector<column_index_t> keyChannels,
+      std::vector<CompareFlags> compareFlags,
+      RowVectorPtr boundaries,
+      std::vector<vector_size_t> boundaryRows);
+
+  std::optional<uint32_t> partition(
+      const RowVector& input,
+      std::vector<uint32_t>& partitions) override;
+
+  int numPartitions() const {
+    return numPartitions_;
+  }
+
+ private:
+  // Returns true if row 'row' of 'input' sorts before boundary 'boundary'.
+  bool lessThanBoundary(
+      const RowVector& input,
+      vector_size_t row,
+      vector_size_t boundary) const;
+
+  const int numPartitions_;
+  const std::vector<column_index_t> keyChannels_;
+  const std::vector<CompareFlags> compareFlags_;
+  const RowVectorPtr boundaries_;
+  const std::vector<vector_size_t> boundaryRows_;
+};
+
+/// Factory class to create RangePartitionFunction. The partition boundaries
+/// are picked as the quantiles of a sample of the sort keys, e.g. a sample of
+/// the input taken by the planner, for the number of partitions known at
+/// runtime. 'sample' has one column per key in the order of 'keyChannels'. An
+/// empty sample puts all rows into partition 0.
+class RangePartitionFunctionSpec : public core::PartitionFunctionSpec {
+ public:
+  RangePartitionFunctionSpec(
+      RowTypePtr inputType,
+      std::vector<column_index_t> keyChannels,
+      std::vector<core::SortOrder> sortingOrders,
+      RowVectorPtr sample);
+
+  std::unique_ptr<core::PartitionFunction> create(
+      int numPartitions) const override;
+
+  std::string toString() const override;
+
+  folly::dynamic serialize() const override;
+
+  static core::PartitionFunctionSpecPtr deserialize(
+      const folly::dynamic& obj,
+      void* context);
+
+ private:
+  const RowTypePtr inputType_;
+  const std::vector<column_index_t> keyChannels_;
+  const std::vector<core::SortOrder> sortingOrders_;
+  const RowVectorPtr sample_;
+  std::vector<CompareFlags> compareFlags_;
+  // Rows of 'sample_' in sort order.
+  std::vector<vector_size_t> sortedRows_;
+};
+} // namespace facebook::velox::exec
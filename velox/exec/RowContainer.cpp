@@ -139,7 +139,8 @@ RowContainer::RowContainer(
     bool hasProbedFlag,
     bool hasNormalizedKeys,
     memory::MemoryPool* pool,
-    std::shared_ptr<HashStringAllocator> stringAllocator)
+    std::shared_ptr<HashStringAllocator> stringAllocator,
+    bool columnarDependents)
     : keyTypes_(keyTypes),
       nullableKeys_(nullableKeys),
       isJoinBuild_(isJoinBuild),
@@ -148,7 +149,8 @@ RowContainer::RowContainer(
       rows_(pool),
       stringAllocator_(
           stringAllocator ? stringAllocator
-                          : std::make_shared<HashStringAllocator>(pool)) {
+                          : std::make_shared<HashStringAllocator>(pool)),
+      columnarChunks_(pool) {
   // Compute the layout of the payload row.  The row has keys, null flags,
   // accumulators, dependent fields. All fields are fixed width. If variable
   // width data is referenced, this is done with StringView(for VARCHAR) and
@@ -177,6 +179,19 @@ RowContainer::RowContainer(
   // cardinality grows too large for packing all in 64
   // bits. 'numRowsWithNormalizedKey_' gives the number of rows with
   // the extra field.
+  //
+  // If 'columnarDependents' is true, the values of the fixed width dependents
+  // are in a chunk instead and the row ends with the pointer to its chunk and
+  // its index in the chunk. The null flags of these dependents stay in the
+  // row.
+  if (columnarDependents) {
+    VELOX_CHECK(
+        accumulators.empty(),
+        "Columnar dependents are not supported with accumulators");
+    if (columnarDependentsWidth(dependentTypes) > 0) {
+      columnarWidths_.resize(keyTypes.size() + dependentTypes.size(), 0);
+    }
+  }
   int32_t offset = 0;
   int32_t nullOffset = 0;
   bool isVariableWidth = false;
@@ -241,9 +256,17 @@ RowContainer::RowContainer(
     offsets_.push_back(offset);
     offset += accumulator.fixedWidthSize();
   }
-  for (auto& type : dependentTypes) {
+  for (auto i = 0; i < dependentTypes.size(); ++i) {
+    const auto kind = dependentTypes[i]->kind();
+    if (!columnarWidths_.empty() && isColumnarType(kind)) {
+      // The offset of the values in the chunk.
+      offsets_.push_back(columnarRowSize_ * kColumnarChunkRows);
+      columnarWidths_[keyTypes_.size() + i] = typeKindSize(kind);
+      columnarRowSize_ += typeKindSize(kind);
+      continue;
+    }
     offsets_.push_back(offset);
-    offset += typeKindSize(type->kind());
+    offset += typeKindSize(kind);
   }
   if (isVariableWidth) {
     rowSizeOffset_ = offset;
@@ -253,6 +276,12 @@ RowContainer::RowContainer(
     nextOffset_ = offset;
     offset += sizeof(void*);
   }
+  if (columnarRowSize_ > 0) {
+    columnarChunkOffset_ = offset;
+    offset += sizeof(char*);
+    columnarIndexOffset_ = offset;
+    offset += sizeof(uint32_t);
+  }
   fixedRowSize_ = bits::roundUp(offset, alignment_);
   // A distinct hash table has no aggregates and if the hash table has
   // no nulls, it may be that there are no null flags.
@@ -289,6 +318,35 @@ RowContainer::~RowContainer() {
   clear();
 }
 
+// static
+bool RowContainer::isColumnarType(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// static
+int32_t RowContainer::columnarDependentsWidth(
+    const std::vector<TypePtr>& dependentTypes) {
+  int32_t width = 0;
+  for (const auto& type : dependentTypes) {
+    if (isColumnarType(type->kind())) {
+      width += typeKindSize(type->kind());
+    }
+  }
+  return width;
+}
+
 char* RowContainer::newRow() {
   VELOX_DCHECK(mutable_, "Can't add row into an immutable row container");
   ++numRows_;
@@ -304,10 +362,28 @@ char* RowContainer::newRow() {
     if (normalizedKeySize_) {
       ++numRowsWithNormalizedKey_;
     }
+    if (columnarRowSize_ > 0) {
+      // A reused free row keeps its slot.
+      newColumnarSlot(row);
+    }
   }
   return initializeRow(row, false /* reuse */);
 }
 
+void RowContainer::newColumnarSlot(char* row) {
+  if (columnarChunk_ == nullptr ||
+      numColumnarChunkRows_ == kColumnarChunkRows) {
+    // The values of each column start 16 byte aligned as the values of a
+    // column take a multiple of 16 bytes.
+    columnarChunk_ = columnarChunks_.allocateFixed(
+        columnarRowSize_ * kColumnarChunkRows, 16);
+    numColumnarChunkRows_ = 0;
+  }
+  *reinterpret_cast<char**>(row + columnarChunkOffset_) = columnarChunk_;
+  *reinterpret_cast<uint32_t*>(row + columnarIndexOffset_) =
+      numColumnarChunkRows_++;
+}
+
 char* RowContainer::initializeRow(char* row, bool reuse) {
   if (reuse) {
     auto rows = folly::Range<char**>(&row, 1);
@@ -316,8 +392,10 @@ char* RowContainer::initializeRow(char* row, bool reuse) {
     VELOX_CHECK_EQ(nextOffset_, 0);
   } else if (rowSizeOffset_ != 0) {
     // zero out string views so that clear() will not hit uninited data. The
-    // fastest way is to set the whole row to 0.
-    ::memset(row, 0, fixedRowSize_);
+    // fastest way is to set the whole row to 0. Keeps the columnar slot at the
+    // end of the row.
+    ::memset(
+        row, 0, columnarRowSize_ > 0 ? columnarChunkOffset_ : fixedRowSize_);
   }
   if (!nullOffsets_.empty()) {
     ::memcpy(
@@ -421,6 +499,66 @@ void RowContainer::freeVariableWidthFields(folly::Range<char**> rows) {
   }
 }
 
+void RowContainer::relocateVariableWidthFields(
+    folly::Range<char**> rows,
+    HashStringAllocator& allocator) {
+  std::string storage;
+  for (auto i = 0; i < types_.size(); ++i) {
+    const auto kind = typeKinds_[i];
+    const bool isString =
+        kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY;
+    const bool isComplex = kind == TypeKind::ROW ||
+        kind == TypeKind::ARRAY || kind == TypeKind::MAP;
+    if (!isString && !isComplex) {
+      continue;
+    }
+    const auto column = columnAt(i);
+    for (auto row : rows) {
+      if (isNullAt(row, column.nullByte(), column.nullMask())) {
+        continue;
+      }
+      if (isString) {
+        const auto view = valueAt<StringView>(row, column.offset());
+        if (!view.isInline()) {
+          allocator.copyMultipart(
+              HashStringAllocator::contiguousString(view, storage),
+              row,
+              column.offset());
+        }
+        continue;
+      }
+      auto& view = valueAt<std::string_view>(row, column.offset());
+      if (view.empty()) {
+        continue;
+      }
+      const auto positions = allocator.relocate(
+          HashStringAllocator::headerOf(view.data()), view.size(), 0);
+      view = std::string_view(positions.first.position, view.size());
+    }
+  }
+}
+
+void RowContainer::compactStringAllocator(
+    const std::function<
+        void(folly::Range<char**> rows, HashStringAllocator* allocator)>&
+        relocateAccumulators) {
+  VELOX_CHECK_EQ(
+      stringAllocator_.use_count(),
+      1,
+      "Cannot compact a string allocator shared with another container");
+  auto allocator =
+      std::make_shared<HashStringAllocator>(stringAllocator_->pool());
+  constexpr int32_t kBatch = 1000;
+  std::vector<char*> rows(kBatch);
+  RowContainerIterator iter;
+  while (const auto numRows = listRows(&iter, kBatch, rows.data())) {
+    const folly::Range<char**> range(rows.data(), numRows);
+    relocateVariableWidthFields(range, *allocator);
+    relocateAccumulators(range, allocator.get());
+  }
+  stringAllocator_ = std::move(allocator);
+}
+
 void RowContainer::checkConsistency() {
   constexpr int32_t kBatch = 1000;
   std::vector<char*> rows(kBatch);
@@ -509,6 +647,11 @@ void RowContainer::store(
     vector_size_t index,
     char* row,
     int32_t column) {
+  if (isColumnar(column)) {
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        storeColumnar, typeKinds_[column], decoded, index, row, column);
+    return;
+  }
   auto numKeys = keyTypes_.size();
   bool isKey = column < numKeys;
   if (isKey && !nullableKeys_) {
@@ -536,6 +679,24 @@ void RowContainer::store(
   }
 }
 
+void RowContainer::extractColumnarColumn(
+    const char* const* rows,
+    folly::Range<const vector_size_t*> rowNumbers,
+    int32_t numRows,
+    int32_t column,
+    int32_t resultOffset,
+    const VectorPtr& result) const {
+  VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+      extractColumnarColumnTyped,
+      typeKinds_[column],
+      rows,
+      rowNumbers,
+      numRows,
+      column,
+      resultOffset,
+      result);
+}
+
 ByteInputStream RowContainer::prepareRead(const char* row, int32_t offset) {
   const auto& view = reinterpret_cast<const std::string_view*>(row + offset);
   // We set 'stream' to range over the ranges that start at the Header
@@ -638,6 +799,9 @@ int32_t RowContainer::storeVariableSizeAt(
 void RowContainer::extractSerializedRows(
     folly::Range<char**> rows,
     const VectorPtr& result) {
+  VELOX_CHECK(
+      columnarWidths_.empty(),
+      "Serialized rows are not supported with columnar dependents");
   // The format of the extracted row is: null bytes followed by keys and
   // dependent columns. Fixed-width columns are serialized into fixed number of
   // bytes (see typeKindSize). Variable-width columns are serialized as 4 bytes
@@ -911,6 +1075,9 @@ void RowContainer::clear() {
     }
   }
   rows_.clear();
+  columnarChunks_.clear();
+  columnarChunk_ = nullptr;
+  numColumnarChunkRows_ = 0;
   if (!sharedStringAllocator) {
     if (checkFree_) {
       stringAllocator_->checkEmpty();
@@ -986,6 +1153,7 @@ std::optional<int64_t> RowContainer::estimateRowSize() const {
   }
   int64_t freeBytes = rows_.freeBytes() + fixedRowSize_ * numFreeRows_;
   int64_t usedSize = rows_.allocatedBytes() - freeBytes +
+      columnarChunks_.allocatedBytes() - columnarChunks_.freeBytes() +
       stringAllocator_->retainedSize() - stringAllocator_->freeSpace();
   int64_t rowSize = usedSize / numRows_;
   VELOX_CHECK_GT(
@@ -1002,7 +1170,8 @@ int64_t RowContainer::sizeIncrement(
   int32_t needRows = std::max<int64_t>(0, numRows - numFreeRows_);
   int64_t needBytes =
       std::max<int64_t>(0, variableLengthBytes - stringAllocator_->freeSpace());
-  return bits::roundUp(needRows * fixedRowSize_, kAllocUnit) +
+  return bits::roundUp(
+             needRows * (fixedRowSize_ + columnarRowSize_), kAllocUnit) +
       bits::roundUp(needBytes, kAllocUnit);
 }
 
@@ -1164,7 +1333,7 @@ std::string RowContainer::toString(const char* row) const {
   auto vector = BaseVector::create<RowVector>(rowType, 1, pool());
 
   for (auto i = 0; i < rowType->size(); ++i) {
-    extractColumn(&row, 1, columnAt(i), 0, vector->childAt(i));
+    extractColumn(&row, 1, i, 0, vector->childAt(i));
   }
 
   return vector->toString(0);
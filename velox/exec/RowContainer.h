@@ -230,6 +230,10 @@ class RowContainer {
   /// 'stringAllocator' allows sharing the variable length data arena with
   /// another RowContainer. This is needed for spilling where the same
   /// aggregates are used for reading one container and merging into another.
+  /// If 'columnarDependents' is true, the fixed width dependents, see
+  /// isColumnarType(), are stored column-wise in chunks of
+  /// kColumnarChunkRows rows instead of in the rows. The keys and the flags
+  /// stay in the rows. Such a container may not have accumulators.
   RowContainer(
       const std::vector<TypePtr>& keyTypes,
       bool nullableKeys,
@@ -240,7 +244,24 @@ class RowContainer {
       bool hasProbedFlag,
       bool hasNormalizedKey,
       memory::MemoryPool* pool,
-      std::shared_ptr<HashStringAllocator> stringAllocator = nullptr);
+      std::shared_ptr<HashStringAllocator> stringAllocator = nullptr,
+      bool columnarDependents = false);
+
+  /// The number of rows of a chunk of columnar dependents.
+  static constexpr int32_t kColumnarChunkRows = 1'024;
+
+  /// Returns true if a dependent of 'kind' can be stored column-wise.
+  static bool isColumnarType(TypeKind kind);
+
+  /// Returns the total width in bytes of the 'dependentTypes' that would be
+  /// stored column-wise with 'columnarDependents' set.
+  static int32_t columnarDependentsWidth(
+      const std::vector<TypePtr>& dependentTypes);
+
+  /// Returns true if the values of 'columnIndex' are stored column-wise.
+  bool isColumnar(int32_t columnIndex) const {
+    return !columnarWidths_.empty() && columnarWidths_[columnIndex] != 0;
+  }
 
   /// Allocates a new row and initializes possible aggregates to null.
   char* newRow();
@@ -310,6 +331,17 @@ class RowContainer {
     return stringAllocator_;
   }
 
+  /// Replaces stringAllocator() with a new one holding a compact copy of the
+  /// variable width keys and dependents of all rows and frees the previous
+  /// one. 'relocateAccumulators' is called for each batch of rows to copy the
+  /// out of line accumulator state to the new allocator, see
+  /// Aggregate::relocate(). The string allocator must not be shared with
+  /// another container.
+  void compactStringAllocator(
+      const std::function<
+          void(folly::Range<char**> rows, HashStringAllocator* allocator)>&
+          relocateAccumulators);
+
   /// Returns the number of used rows in 'this'. This is the number of rows a
   /// RowContainerIterator would access.
   int64_t numRows() const {
@@ -383,8 +415,8 @@ class RowContainer {
       const char* const* rows,
       int32_t numRows,
       int32_t columnIndex,
-      const VectorPtr& result) {
-    extractColumn(rows, numRows, columnAt(columnIndex), result);
+      const VectorPtr& result) const {
+    extractColumn(rows, numRows, columnIndex, 0, result);
   }
 
   /// Copies the values at 'columnIndex' into 'result' (starting at
@@ -395,7 +427,12 @@ class RowContainer {
       int32_t numRows,
       int32_t columnIndex,
       int32_t resultOffset,
-      const VectorPtr& result) {
+      const VectorPtr& result) const {
+    if (isColumnar(columnIndex)) {
+      extractColumnarColumn(
+          rows, {}, numRows, columnIndex, resultOffset, result);
+      return;
+    }
     extractColumn(rows, numRows, columnAt(columnIndex), resultOffset, result);
   }
 
@@ -411,7 +448,17 @@ class RowContainer {
       folly::Range<const vector_size_t*> rowNumbers,
       int32_t columnIndex,
       const vector_size_t resultOffset,
-      const VectorPtr& result) {
+      const VectorPtr& result) const {
+    if (isColumnar(columnIndex)) {
+      extractColumnarColumn(
+          rows,
+          rowNumbers,
+          rowNumbers.size(),
+          columnIndex,
+          resultOffset,
+          result);
+      return;
+    }
     extractColumn(
         rows, rowNumbers, columnAt(columnIndex), resultOffset, result);
   }
@@ -616,6 +663,10 @@ class RowContainer {
     normalizedKeySize_ = 0;
   }
 
+  /// Returns the offsets of the value and the null flag of 'index' in a row.
+  /// For a columnar dependent, the value offset is in the chunk of the row
+  /// instead, so the value must be accessed with the member functions that
+  /// take a column index.
   RowColumn columnAt(int32_t index) const {
     return rowColumns_[index];
   }
@@ -657,7 +708,8 @@ class RowContainer {
       uint64_t* result);
 
   uint64_t allocatedBytes() const {
-    return rows_.allocatedBytes() + stringAllocator_->retainedSize();
+    return rows_.allocatedBytes() + columnarChunks_.allocatedBytes() +
+        stringAllocator_->retainedSize();
   }
 
   /// Returns the number of fixed size rows that can be allocated without
@@ -984,6 +1036,97 @@ class RowContainer {
 
   static ByteInputStream prepareRead(const char* row, int32_t offset);
 
+  // Returns the address of the value of columnar dependent 'column' of 'row'.
+  char* columnarValueAt(const char* row, int32_t column) const {
+    auto* chunk = *reinterpret_cast<char* const*>(row + columnarChunkOffset_);
+    const auto index =
+        *reinterpret_cast<const uint32_t*>(row + columnarIndexOffset_);
+    return chunk + rowColumns_[column].offset() +
+        index * columnarWidths_[column];
+  }
+
+  // Assigns the next slot in the columnar dependent chunks to a new 'row'.
+  void newColumnarSlot(char* row);
+
+  template <TypeKind Kind>
+  void storeColumnar(
+      const DecodedVector& decoded,
+      vector_size_t index,
+      char* row,
+      int32_t column) {
+    using T = typename TypeTraits<Kind>::NativeType;
+    const auto rowColumn = rowColumns_[column];
+    auto* value = reinterpret_cast<T*>(columnarValueAt(row, column));
+    if (decoded.isNullAt(index)) {
+      row[rowColumn.nullByte()] |= rowColumn.nullMask();
+      *value = T();
+      return;
+    }
+    *value = decoded.valueAt<T>(index);
+  }
+
+  void extractColumnarColumn(
+      const char* const* rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t numRows,
+      int32_t column,
+      int32_t resultOffset,
+      const VectorPtr& result) const;
+
+  template <TypeKind Kind>
+  void extractColumnarColumnTyped(
+      const char* const* rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t numRows,
+      int32_t column,
+      int32_t resultOffset,
+      const VectorPtr& result) const {
+    using T = typename KindToFlatVector<Kind>::HashRowType;
+    result->resize(numRows + resultOffset);
+    auto* flatResult = result->as<FlatVector<T>>();
+    if (rowNumbers.size() > 0) {
+      extractColumnarValues<true, T>(
+          rows, rowNumbers, numRows, column, resultOffset, flatResult);
+    } else {
+      extractColumnarValues<false, T>(
+          rows, rowNumbers, numRows, column, resultOffset, flatResult);
+    }
+  }
+
+  template <bool useRowNumbers, typename T>
+  void extractColumnarValues(
+      const char* const* rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t numRows,
+      int32_t column,
+      int32_t resultOffset,
+      FlatVector<T>* result) const {
+    const auto maxRows = numRows + resultOffset;
+    VELOX_DCHECK_LE(maxRows, result->size());
+    const auto rowColumn = rowColumns_[column];
+    const auto nullByte = rowColumn.nullByte();
+    const auto nullMask = rowColumn.nullMask();
+    auto* nulls = result->mutableNulls(maxRows)->template asMutable<uint64_t>();
+    auto* values = result->mutableValues(maxRows)->template asMutable<T>();
+    for (int32_t i = 0; i < numRows; ++i) {
+      const char* row;
+      if constexpr (useRowNumbers) {
+        auto rowNumber = rowNumbers[i];
+        row = rowNumber >= 0 ? rows[rowNumber] : nullptr;
+      } else {
+        row = rows[i];
+      }
+      const auto resultIndex = resultOffset + i;
+      if (row == nullptr || isNullAt(row, nullByte, nullMask)) {
+        bits::setNull(nulls, resultIndex, true);
+      } else {
+        bits::setNull(nulls, resultIndex, false);
+        values[resultIndex] =
+            *reinterpret_cast<const T*>(columnarValueAt(row, column));
+      }
+    }
+  }
+
   template <TypeKind Kind>
   void hashTyped(
       const Type* type,
@@ -1226,6 +1369,12 @@ class RowContainer {
   // complex-typed field in 'rows'.
   void freeVariableWidthFields(folly::Range<char**> rows);
 
+  // Copies the variable-width fields of 'rows' to 'allocator' and points the
+  // fields to the copies. The previous allocations are not freed.
+  void relocateVariableWidthFields(
+      folly::Range<char**> rows,
+      HashStringAllocator& allocator);
+
   // Free any aggregates associated with the 'rows'.
   void freeAggregates(folly::Range<char**> rows);
 
@@ -1295,6 +1444,25 @@ class RowContainer {
   memory::AllocationPool rows_;
   std::shared_ptr<HashStringAllocator> stringAllocator_;
 
+  // Width of each column stored column-wise, 0 for the other columns. Empty if
+  // there are no columnar dependents. Corresponds pairwise to 'types_'.
+  std::vector<int32_t> columnarWidths_;
+  // Sum of 'columnarWidths_'.
+  int32_t columnarRowSize_{0};
+  // Offsets of the pointer to the chunk of the columnar dependents of a row
+  // and of the uint32_t index of the row in the chunk. The chunk starts with
+  // the values of the first columnar dependent for kColumnarChunkRows rows,
+  // followed by the values of the next columnar dependent and so on. Rows of
+  // other containers with the same layout are accessed the same way, e.g. the
+  // rows of the tables of a parallel join build.
+  int32_t columnarChunkOffset_{0};
+  int32_t columnarIndexOffset_{0};
+  // The chunk for the next new row and the number of its used slots.
+  char* columnarChunk_{nullptr};
+  int32_t numColumnarChunkRows_{0};
+  // Holds the chunks. Separate from 'rows_' which is walked as rows.
+  memory::AllocationPool columnarChunks_;
+
   int alignment_ = 1;
 };
 
@@ -54,6 +54,11 @@ RowNumber::RowNumber(
     numRowsOffset_ = numRowsColumn.offset();
 
     inputType_ = rowNumberNode->sources()[0]->outputType();
+
+    if (spillEnabled()) {
+      spiller_ = std::make_unique<HashTableInputSpiller>(
+          inputType_, spillConfig(), &spillStats_);
+    }
   }
 
   identityProjections_.reserve(inputType->size());
@@ -73,8 +78,8 @@ void RowNumber::addInput(RowVectorPtr input) {
   if (table_) {
     ensureInputFits(input);
 
-    if (inputSpiller_ != nullptr) {
-      spillInput(input, pool());
+    if (spiller_ != nullptr && spiller_->spilled()) {
+      spiller_->spillInput(input, pool());
       return;
     }
 
@@ -97,11 +102,7 @@ void RowNumber::addInput(RowVectorPtr input) {
 }
 
 void RowNumber::addSpillInput() {
-  const auto numInput = input_->size();
-  SelectivityVector rows(numInput);
-  table_->prepareForGroupProbe(
-      *lookup_, input_, rows, false, spillConfig_->startPartitionBit);
-  table_->groupProbe(*lookup_);
+  spiller_->probeRestoredInput(*table_, *lookup_, input_);
 
   // Initialize new partitions with zeros.
   for (auto i : lookup_->newGroups) {
@@ -114,131 +115,40 @@ void RowNumber::addSpillInput() {
 void RowNumber::noMoreInput() {
   Operator::noMoreInput();
 
-  if (inputSpiller_ != nullptr) {
-    inputSpiller_->finishSpill(spillInputPartitionSet_);
-    removeEmptyPartitions(spillInputPartitionSet_);
+  if (spiller_ != nullptr && spiller_->spilled()) {
+    spiller_->finishInputSpill();
     restoreNextSpillPartition();
   }
 }
 
 void RowNumber::restoreNextSpillPartition() {
-  if (spillInputPartitionSet_.empty()) {
-    return;
-  }
-
-  auto it = spillInputPartitionSet_.begin();
-  spillInputReader_ = it->second->createUnorderedReader(pool(), &spillStats_);
-
-  // Find matching partition for the hash table.
-  auto hashTableIt = spillHashTablePartitionSet_.find(it->first);
-  if (hashTableIt != spillHashTablePartitionSet_.end()) {
-    spillHashTableReader_ =
-        hashTableIt->second->createUnorderedReader(pool(), &spillStats_);
-
-    RowVectorPtr data;
-    while (spillHashTableReader_->nextBatch(data)) {
-      // 'data' contains partition-by keys and count. Transform 'data' to match
-      // 'inputType_' so it can be added to the 'table_'. Move partition-by
-      // columns and leave other columns unset.
-      std::vector<VectorPtr> columns(inputType_->size());
-
-      const auto& hashers = table_->hashers();
-      for (auto i = 0; i < hashers.size(); ++i) {
-        columns[hashers[i]->channel()] = data->childAt(i);
-      }
-
-      auto input = std::make_shared<RowVector>(
-          pool(), inputType_, nullptr, data->size(), std::move(columns));
-
-      const auto numInput = input->size();
-      SelectivityVector rows(numInput);
-      table_->prepareForGroupProbe(
-          *lookup_, input, rows, false, spillConfig_->startPartitionBit);
-      table_->groupProbe(*lookup_);
-
-      auto* counts = data->children().back()->as<FlatVector<int64_t>>();
-
-      for (auto i = 0; i < numInput; ++i) {
-        auto* partition = lookup_->hits[i];
-        setNumRows(partition, counts->valueAt(i));
-      }
-    }
+  const auto restored = spiller_->restoreNextPartition(
+      *table_,
+      *lookup_,
+      pool(),
+      [&](const RowVectorPtr& data, const HashLookup& lookup) {
+        // 'data' contains partition-by keys and count.
+        auto* counts = data->children().back()->as<FlatVector<int64_t>>();
+        for (auto i = 0; i < data->size(); ++i) {
+          setNumRows(lookup.hits[i], counts->valueAt(i));
+        }
+      },
+      input_);
+  if (restored) {
+    addSpillInput();
   }
-
-  spillInputPartitionSet_.erase(it);
-
-  spillInputReader_->nextBatch(input_);
-  addSpillInput();
 }
 
 void RowNumber::ensureInputFits(const RowVectorPtr& input) {
-  if (!spillEnabled()) {
-    // Spilling is disabled.
-    return;
-  }
-
-  if (table_ == nullptr) {
-    // No hash table. Nothing to spill.
+  if (spiller_ == nullptr) {
+    // No hash table or spilling is disabled.
     return;
   }
 
-  const auto numDistinct = table_->numDistinct();
-  if (numDistinct == 0) {
-    // Table is empty. Nothing to spill.
-    return;
-  }
-
-  auto* rows = table_->rows();
-  auto [freeRows, outOfLineFreeBytes] = rows->freeSpace();
-  const auto outOfLineBytes =
-      rows->stringAllocator().retainedSize() - outOfLineFreeBytes;
-  const auto outOfLineBytesPerRow = outOfLineBytes / numDistinct;
-
-  // Test-only spill path.
-  if (testingTriggerSpill(pool()->name())) {
-    Operator::ReclaimableSectionGuard guard(this);
-    memory::testingRunArbitration(pool());
-    return;
-  }
-
-  const auto currentUsage = pool()->currentBytes();
-  const auto minReservationBytes =
-      currentUsage * spillConfig_->minSpillableReservationPct / 100;
-  const auto availableReservationBytes = pool()->availableReservation();
-  const auto tableIncrementBytes = table_->hashTableSizeIncrease(input->size());
-  const auto incrementBytes =
-      rows->sizeIncrement(input->size(), outOfLineBytesPerRow * input->size()) +
-      tableIncrementBytes;
-
-  // First to check if we have sufficient minimal memory reservation.
-  if (availableReservationBytes >= minReservationBytes) {
-    if ((tableIncrementBytes == 0) && (freeRows > input->size()) &&
-        (outOfLineBytes == 0 ||
-         outOfLineFreeBytes >= outOfLineBytesPerRow * input->size())) {
-      // Enough free rows for input rows and enough variable length free space.
-      return;
-    }
-  }
-
-  // Check if we can increase reservation. The increment is the largest of twice
-  // the maximum increment from this input and 'spillableReservationGrowthPct_'
-  // of the current memory usage.
-  const auto targetIncrementBytes = std::max<int64_t>(
-      incrementBytes * 2,
-      currentUsage * spillConfig_->spillableReservationGrowthPct / 100);
-  {
-    Operator::ReclaimableSectionGuard guard(this);
-    if (pool()->maybeReserve(targetIncrementBytes)) {
-      return;
-    }
-  }
-
-  LOG(WARNING) << "Failed to reserve " << succinctBytes(targetIncrementBytes)
-               << " for memory pool " << pool()->name()
-               << ", usage: " << succinctBytes(pool()->currentBytes())
-               << ", reservation: " << succinctBytes(pool()->reservedBytes());
+  ensureHashTableInputFits(*this, spillConfig_.value(), *table_, input);
 }
 
+
 FlatVector<int64_t>& RowNumber::getOrCreateRowNumberVector(vector_size_t size) {
   VectorPtr& result = results_[0];
   if (result && result.unique()) {
@@ -305,12 +215,10 @@ RowVectorPtr RowNumber::getOutput() {
     output = fillOutput(numInput, nullptr);
   }
 
-  if (spillInputReader_ != nullptr) {
-    if (spillInputReader_->nextBatch(input_)) {
+  if (spiller_ != nullptr && spiller_->restoring()) {
+    if (spiller_->nextInput(input_)) {
       addSpillInput();
     } else {
-      input_ = nullptr;
-      spillInputReader_ = nullptr;
       table_->clear();
       restoreNextSpillPartition();
     }
@@ -368,7 +276,7 @@ void RowNumber::reclaim(
     return;
   }
 
-  if (inputSpiller_ != nullptr) {
+  if (spiller_->spilled()) {
     // Already spilled.
     return;
   }
@@ -376,117 +284,18 @@ void RowNumber::reclaim(
   spill();
 }
 
-SpillPartitionNumSet RowNumber::spillHashTable() {
-  // TODO Replace joinPartitionBits and Spiller::Type::kHashJoinBuild.
-  VELOX_CHECK_NOT_NULL(table_);
-
-  const auto& spillConfig = spillConfig_.value();
-
-  auto columnTypes = table_->rows()->columnTypes();
-  auto tableType = ROW(std::move(columnTypes));
-
-  auto hashTableSpiller = std::make_unique<Spiller>(
-      Spiller::Type::kRowNumber,
-      table_->rows(),
-      tableType,
-      spillPartitionBits_,
-      &spillConfig,
-      &spillStats_);
-
-  hashTableSpiller->spill();
-  hashTableSpiller->finishSpill(spillHashTablePartitionSet_);
-
-  table_->clear();
-  pool()->release();
-  return hashTableSpiller->state().spilledPartitionSet();
-}
-
-void RowNumber::setupInputSpiller(
-    const SpillPartitionNumSet& spillPartitionSet) {
-  VELOX_CHECK(!spillPartitionSet.empty());
-
-  const auto& spillConfig = spillConfig_.value();
-
-  // TODO Replace Spiller::Type::kHashJoinProbe.
-  inputSpiller_ = std::make_unique<Spiller>(
-      Spiller::Type::kHashJoinProbe,
-      inputType_,
-      spillPartitionBits_,
-      &spillConfig,
-      &spillStats_);
-  inputSpiller_->setPartitionsSpilled(spillPartitionSet);
-
-  const auto& hashers = table_->hashers();
-
-  std::vector<column_index_t> keyChannels;
-  keyChannels.reserve(hashers.size());
-  for (const auto& hasher : hashers) {
-    keyChannels.push_back(hasher->channel());
-  }
-
-  spillHashFunction_ = std::make_unique<HashPartitionFunction>(
-      inputSpiller_->hashBits(), inputType_, keyChannels);
-}
-
 void RowNumber::spill() {
   VELOX_CHECK(spillEnabled());
-  VELOX_CHECK_NULL(inputSpiller_);
 
-  spillPartitionBits_ = HashBitRange(
-      spillConfig_->startPartitionBit,
-      spillConfig_->startPartitionBit + spillConfig_->numPartitionBits);
-
-  const auto spillPartitionSet = spillHashTable();
+  const auto spillPartitionSet = spiller_->spillTable(*table_);
+  pool()->release();
 
-  setupInputSpiller(spillPartitionSet);
+  spiller_->setupInputSpiller(*table_, spillPartitionSet);
 
   if (input_ != nullptr) {
-    spillInput(input_, memory::spillMemoryPool());
+    spiller_->spillInput(input_, memory::spillMemoryPool());
     input_ = nullptr;
   }
 }
 
-void RowNumber::spillInput(
-    const RowVectorPtr& input,
-    memory::MemoryPool* pool) {
-  const auto numInput = input->size();
-
-  std::vector<uint32_t> spillPartitions(numInput);
-  const auto singlePartition =
-      spillHashFunction_->partition(*input, spillPartitions);
-
-  const auto numPartitions = spillHashFunction_->numPartitions();
-
-  std::vector<BufferPtr> partitionIndices(numPartitions);
-  std::vector<vector_size_t*> rawPartitionIndices(numPartitions);
-
-  for (auto i = 0; i < numPartitions; ++i) {
-    partitionIndices[i] = allocateIndices(numInput, pool);
-    rawPartitionIndices[i] = partitionIndices[i]->asMutable<vector_size_t>();
-  }
-
-  std::vector<vector_size_t> numSpillInputs(numPartitions, 0);
-
-  for (auto row = 0; row < numInput; ++row) {
-    const auto partition = singlePartition.has_value() ? singlePartition.value()
-                                                       : spillPartitions[row];
-    rawPartitionIndices[partition][numSpillInputs[partition]++] = row;
-  }
-
-  // Ensure vector are lazy loaded before spilling.
-  for (auto i = 0; i < input->childrenSize(); ++i) {
-    input->childAt(i)->loadedVector();
-  }
-
-  for (int32_t partition = 0; partition < numSpillInputs.size(); ++partition) {
-    const auto numInputs = numSpillInputs[partition];
-    if (numInputs == 0) {
-      continue;
-    }
-
-    inputSpiller_->spill(
-        partition, wrap(numInputs, partitionIndices[partition], input));
-  }
-}
-
 } // namespace facebook::velox::exec
@@ -15,8 +15,8 @@
  */
 #pragma once
 
-#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/HashTable.h"
+#include "velox/exec/HashTableInputSpiller.h"
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
@@ -44,7 +44,7 @@ class RowNumber : public Operator {
 
   bool isFinished() override {
     return (noMoreInput_ && input_ == nullptr &&
-            spillInputReader_ == nullptr) ||
+            (spiller_ == nullptr || !spiller_->restoring())) ||
         finishedEarly_;
   }
 
@@ -56,20 +56,14 @@ class RowNumber : public Operator {
     return spillConfig_.has_value();
   }
 
-  void setupInputSpiller(const SpillPartitionNumSet& spillPartitionSet);
-
   void ensureInputFits(const RowVectorPtr& input);
 
-  void spillInput(const RowVectorPtr& input, memory::MemoryPool* pool);
-
   void spill();
 
   void addSpillInput();
 
   void restoreNextSpillPartition();
 
-  SpillPartitionNumSet spillHashTable();
-
   int64_t numRows(char* partition);
 
   void setNumRows(char* partition, int64_t numRows);
@@ -98,24 +92,8 @@ class RowNumber : public Operator {
 
   RowTypePtr inputType_;
 
-  // The spill partition bits used by both hash table content spill and input
-  // data spill.
-  HashBitRange spillPartitionBits_;
-
-  // Used to restore previously spilled hash table.
-  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillHashTableReader_;
-
-  SpillPartitionSet spillHashTablePartitionSet_;
-
-  // Spiller for input received after spilling has been triggered.
-  std::unique_ptr<Spiller> inputSpiller_;
-
-  // Used to restore previously spilled input.
-  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
-
-  SpillPartitionSet spillInputPartitionSet_;
-
-  // Used to calculate the spill partition numbers of the inputs.
-  std::unique_ptr<HashPartitionFunction> spillHashFunction_;
+  // Spills 'table_' and the input. Set if there is a hash table and spilling
+  // is enabled.
+  std::unique_ptr<HashTableInputSpiller> spiller_;
 };
 } // namespace facebook::velox::exec
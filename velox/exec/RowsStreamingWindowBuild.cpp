@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/RowsStreamingWindowBuild.h"
+
+namespace facebook::velox::exec {
+
+RowsStreamingWindowBuild::RowsStreamingWindowBuild(
+    const std::shared_ptr<const core::WindowNode>& windowNode,
+    velox::memory::MemoryPool* pool,
+    const common::SpillConfig* spillConfig,
+    tsan_atomic<bool>* nonReclaimableSection)
+    : WindowBuild(windowNode, pool, spillConfig, nonReclaimableSection) {}
+
+void RowsStreamingWindowBuild::addPartitionInputs() {
+  if (inputRows_.empty()) {
+    return;
+  }
+  inputPartition_->addRows(inputRows_);
+  inputRows_.clear();
+}
+
+void RowsStreamingWindowBuild::addInput(RowVectorPtr input) {
+  for (auto i = 0; i < inputChannels_.size(); ++i) {
+    decodedInputVectors_[i].decode(*input->childAt(inputChannels_[i]));
+  }
+
+  for (auto row = 0; row < input->size(); ++row) {
+    char* newRow = data_->newRow();
+
+    for (auto col = 0; col < input->childrenSize(); ++col) {
+      data_->store(decodedInputVectors_[col], row, newRow, col);
+    }
+
+    if (previousRow_ == nullptr ||
+        compareRowsWithKeys(previousRow_, newRow, partitionKeyInfo_)) {
+      if (inputPartition_ != nullptr) {
+        addPartitionInputs();
+        inputPartition_->setComplete();
+      }
+      inputPartition_ = std::make_shared<WindowPartition>(
+          data_.get(), inversedInputChannels_, sortKeyInfo_);
+      windowPartitions_.push_back(inputPartition_);
+    }
+
+    inputRows_.push_back(newRow);
+    previousRow_ = newRow;
+  }
+
+  addPartitionInputs();
+}
+
+void RowsStreamingWindowBuild::noMoreInput() {
+  if (inputPartition_ != nullptr) {
+    addPartitionInputs();
+    inputPartition_->setComplete();
+  }
+}
+
+std::shared_ptr<WindowPartition> RowsStreamingWindowBuild::nextPartition() {
+  VELOX_CHECK(hasNextPartition(), "No window partitions available");
+  VELOX_CHECK(
+      outputPartition_ == nullptr || outputPartition_->complete(),
+      "The current window partition is not complete");
+  outputPartition_ = std::move(windowPartitions_.front());
+  windowPartitions_.pop_front();
+  return outputPartition_;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/WindowBuild.h"
+
+namespace facebook::velox::exec {
+
+/// The RowsStreamingWindowBuild is used when the input data is already sorted
+/// by {partition keys + order by keys} and all the window functions have
+/// WindowFunction::ProcessMode::kRows, e.g. row_number, rank and dense_rank.
+/// Unlike the StreamingWindowBuild, it doesn't wait for a partition to be
+/// complete. It adds each input batch to a partial WindowPartition that the
+/// Window operator outputs right away. The operator removes the output rows,
+/// so the memory used is bounded by the size of the input batches, not of
+/// the partitions.
+class RowsStreamingWindowBuild : public WindowBuild {
+ public:
+  RowsStreamingWindowBuild(
+      const std::shared_ptr<const core::WindowNode>& windowNode,
+      velox::memory::MemoryPool* pool,
+      const common::SpillConfig* spillConfig,
+      tsan_atomic<bool>* nonReclaimableSection);
+
+  void addInput(RowVectorPtr input) override;
+
+  void spill() override {
+    VELOX_UNREACHABLE();
+  }
+
+  std::optional<common::SpillStats> spilledStats() const override {
+    return std::nullopt;
+  }
+
+  void noMoreInput() override;
+
+  bool hasNextPartition() override {
+    return !windowPartitions_.empty();
+  }
+
+  std::shared_ptr<WindowPartition> nextPartition() override;
+
+  bool needsInput() override {
+    // Accepts input once all the rows received so far have been output.
+    return windowPartitions_.empty() &&
+        (outputPartition_ == nullptr ||
+         outputPartition_->numRowsForProcessing() == 0);
+  }
+
+ private:
+  // Adds 'inputRows_' to 'inputPartition_'.
+  void addPartitionInputs();
+
+  // Partitions that have not been given to the Window operator yet, in input
+  // order. Only the last one can be incomplete.
+  std::deque<std::shared_ptr<WindowPartition>> windowPartitions_;
+
+  // The partition the input rows are added to.
+  std::shared_ptr<WindowPartition> inputPartition_;
+
+  // The partition being output by the Window operator.
+  std::shared_ptr<WindowPartition> outputPartition_;
+
+  // Input rows of the current input batch not yet added to
+  // 'inputPartition_'.
+  std::vector<char*> inputRows_;
+
+  // Used to compare rows based on partitionKeys.
+  char* previousRow_ = nullptr;
+};
+
+} // namespace facebook::velox::exec
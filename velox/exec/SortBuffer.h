@@ -19,6 +19,7 @@
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/Spill.h"
 #include "velox/vector/BaseVector.h"
@@ -27,7 +28,10 @@ namespace facebook::velox::exec {
 
 /// A utility class to accumulate data inside and output the sorted result.
 /// Spilling would be triggered if spilling is enabled and memory usage exceeds
-/// limit.
+/// limit. The fixed width non-sort columns are stored column-wise if their
+/// total width is at least 'columnarPayloadMinWidth' bytes, see
+/// core::QueryConfig::kRowContainerColumnarPayloadMinWidth. The in-memory rows
+/// are sorted with PrefixSort if 'prefixSortConfig' is set.
 class SortBuffer {
  public:
   SortBuffer(
@@ -37,7 +41,9 @@ class SortBuffer {
       velox::memory::MemoryPool* pool,
       tsan_atomic<bool>* nonReclaimableSection,
       const common::SpillConfig* spillConfig = nullptr,
-      folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr);
+      folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr,
+      int32_t columnarPayloadMinWidth = 0,
+      const std::optional<PrefixSortConfig>& prefixSortConfig = std::nullopt);
 
   void addInput(const VectorPtr& input);
 
@@ -89,6 +95,7 @@ class SortBuffer {
   tsan_atomic<bool>* const nonReclaimableSection_;
   const common::SpillConfig* const spillConfig_;
   folly::Synchronized<common::SpillStats>* const spillStats_;
+  const std::optional<PrefixSortConfig> prefixSortConfig_;
 
   // The column projection map between 'input_' and 'spillerStoreType_' as sort
   // buffer stores the sort columns first in 'data_'.
@@ -18,11 +18,91 @@
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/prefixsort/PrefixSortEncoder.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
+namespace {
+template <TypeKind Kind>
+void encodeKey(
+    const BaseVector& key,
+    vector_size_t index,
+    const prefixsort::PrefixSortEncoder& encoder,
+    char* dest) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  std::optional<T> value;
+  if (!key.isNullAt(index)) {
+    value = key.asUnchecked<SimpleVector<T>>()->valueAt(index);
+  }
+  if constexpr (std::is_same_v<T, StringView>) {
+    // The null byte and 7 bytes of the string fill the normalized key.
+    encoder.encode(value, dest, sizeof(uint64_t) - 1);
+  } else {
+    encoder.encode(value, dest);
+  }
+}
+} // namespace
+
+// static
+bool SpillMergeStream::supportsNormalizedKey(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+uint64_t SpillMergeStream::normalizedKey() const {
+  static const CompareFlags kDefaultFlags;
+  const auto& flags =
+      sortCompareFlags().empty() ? kDefaultFlags : sortCompareFlags()[0];
+  const prefixsort::PrefixSortEncoder encoder(
+      flags.ascending, flags.nullsFirst);
+  // Large enough for the encoding of any supported type. Only the first 8
+  // bytes are used, a longer encoding is truncated.
+  char encoded[32];
+  const auto& key = *rowVector_->childAt(0);
+  switch (key.typeKind()) {
+    case TypeKind::INTEGER:
+      encodeKey<TypeKind::INTEGER>(key, index_, encoder, encoded);
+      break;
+    case TypeKind::BIGINT:
+      encodeKey<TypeKind::BIGINT>(key, index_, encoder, encoded);
+      break;
+    case TypeKind::REAL:
+      encodeKey<TypeKind::REAL>(key, index_, encoder, encoded);
+      break;
+    case TypeKind::DOUBLE:
+      encodeKey<TypeKind::DOUBLE>(key, index_, encoder, encoded);
+      break;
+    case TypeKind::TIMESTAMP:
+      encodeKey<TypeKind::TIMESTAMP>(key, index_, encoder, encoded);
+      break;
+    case TypeKind::VARCHAR:
+      encodeKey<TypeKind::VARCHAR>(key, index_, encoder, encoded);
+      break;
+    case TypeKind::VARBINARY:
+      encodeKey<TypeKind::VARBINARY>(key, index_, encoder, encoded);
+      break;
+    default:
+      VELOX_UNREACHABLE(
+          "Unsupported type of normalized key: {}", key.type()->toString());
+  }
+  // The encoding compares bytewise, the first byte is the most significant.
+  uint64_t normalized;
+  std::memcpy(&normalized, encoded, sizeof(normalized));
+  return __builtin_bswap64(normalized);
+}
+
 void SpillMergeStream::pop() {
   if (++index_ >= size_) {
     setNextBatch();
@@ -76,7 +156,12 @@ SpillState::SpillState(
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    folly::Executor* writeExecutor,
+    uint64_t writeBehindBytes,
+    const common::SpillTiers& tiers,
+    bool columnarFormat,
+    uint64_t zstdDictionarySize)
     : getSpillDirPathCb_(getSpillDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileNamePrefix_(fileNamePrefix),
@@ -89,6 +174,11 @@ SpillState::SpillState(
       fileCreateConfig_(fileCreateConfig),
       pool_(pool),
       stats_(stats),
+      writeExecutor_(writeExecutor),
+      writeBehindBytes_(writeBehindBytes),
+      tiers_(tiers),
+      columnarFormat_(columnarFormat),
+      zstdDictionarySize_(zstdDictionarySize),
       partitionWriters_(maxPartitions_) {}
 
 void SpillState::setPartitionSpilled(uint32_t partition) {
@@ -132,7 +222,12 @@ uint64_t SpillState::appendToPartition(
         fileCreateConfig_,
         updateAndCheckSpillLimitCb_,
         pool_,
-        stats_);
+        stats_,
+        writeExecutor_,
+        writeBehindBytes_,
+        tiers_,
+        columnarFormat_,
+        zstdDictionarySize_);
   }
 
   updateSpilledInputBytes(rows->estimateFlatSize());
@@ -238,6 +333,31 @@ std::string SpillPartition::toString() const {
       succinctBytes(size_));
 }
 
+namespace {
+// Returns the executor to read ahead each of 'files' on, or nullptr for the
+// files without read-ahead. The files get read-ahead in order while their
+// read-ahead buffers fit in the budget of 'spillConfig'.
+std::vector<folly::Executor*> readAheadExecutors(
+    const SpillFiles& files,
+    const common::SpillConfig* spillConfig) {
+  std::vector<folly::Executor*> executors(files.size(), nullptr);
+  if (spillConfig == nullptr || spillConfig->executor == nullptr) {
+    return executors;
+  }
+  uint64_t budget = spillConfig->readAheadBytes;
+  for (auto i = 0; i < files.size(); ++i) {
+    const auto bufferSize = SpillReadFile::readBufferSize(files[i].size);
+    // A file read in one buffer has nothing to read ahead.
+    if (files[i].size <= bufferSize || bufferSize > budget) {
+      continue;
+    }
+    budget -= bufferSize;
+    executors[i] = spillConfig->executor;
+  }
+  return executors;
+}
+} // namespace
+
 std::unique_ptr<UnorderedStreamReader<BatchStream>>
 SpillPartition::createUnorderedReader(
     memory::MemoryPool* pool,
@@ -257,19 +377,195 @@ SpillPartition::createUnorderedReader(
 std::unique_ptr<TreeOfLosers<SpillMergeStream>>
 SpillPartition::createOrderedReader(
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* spillStats) {
+    folly::Synchronized<common::SpillStats>* spillStats,
+    const common::SpillConfig* spillConfig) {
+  if (spillConfig != nullptr && spillConfig->maxMergeFanIn != 0) {
+    mergeFiles(spillConfig->maxMergeFanIn, *spillConfig, pool, spillStats);
+  }
   std::vector<std::unique_ptr<SpillMergeStream>> streams;
   streams.reserve(files_.size());
-  for (auto& fileInfo : files_) {
-    streams.push_back(FileSpillMergeStream::create(
-        SpillReadFile::create(fileInfo, pool, spillStats)));
+  const auto executors = readAheadExecutors(files_, spillConfig);
+  // Compares the normalized first sort keys inline in the merge if these are
+  // supported.
+  bool normalizedKeys = !files_.empty();
+  for (auto i = 0; i < files_.size(); ++i) {
+    const auto& fileInfo = files_[i];
+    normalizedKeys &= fileInfo.numSortKeys > 0 &&
+        SpillMergeStream::supportsNormalizedKey(fileInfo.type->childAt(0));
+    streams.push_back(FileSpillMergeStream::create(SpillReadFile::create(
+        fileInfo, pool, spillStats, executors[i])));
   }
   files_.clear();
   // Check if the partition is empty or not.
   if (FOLLY_UNLIKELY(streams.empty())) {
     return nullptr;
   }
-  return std::make_unique<TreeOfLosers<SpillMergeStream>>(std::move(streams));
+  return std::make_unique<TreeOfLosers<SpillMergeStream>>(
+      std::move(streams), normalizedKeys);
+}
+
+namespace {
+// Merges the sorted 'files' into one sorted file and returns its info with the
+// file id set to 'fileId'. The input files are removed after the merge.
+SpillFileInfo mergeSpillFiles(
+    const SpillFiles& files,
+    uint32_t fileId,
+    const common::SpillConfig& spillConfig,
+    memory::MemoryPool* pool,
+    folly::Synchronized<common::SpillStats>* spillStats) {
+  constexpr vector_size_t kOutputBatchRows = 1'024;
+  VELOX_CHECK_GE(files.size(), 2);
+  const auto& firstFile = files[0];
+  std::vector<std::unique_ptr<SpillMergeStream>> streams;
+  streams.reserve(files.size());
+  const auto executors = readAheadExecutors(files, &spillConfig);
+  for (auto i = 0; i < files.size(); ++i) {
+    streams.push_back(FileSpillMergeStream::create(SpillReadFile::create(
+        files[i], pool, spillStats, executors[i])));
+  }
+  TreeOfLosers<SpillMergeStream> merge(
+      std::move(streams),
+      firstFile.numSortKeys > 0 &&
+          SpillMergeStream::supportsNormalizedKey(firstFile.type->childAt(0)));
+
+  // The merged file is named after the first input file which is not reused.
+  auto updateAndCheckSpillLimitCb = spillConfig.updateAndCheckSpillLimitCb;
+  SpillWriter writer(
+      firstFile.type,
+      firstFile.numSortKeys,
+      firstFile.sortFlags,
+      firstFile.compressionKind,
+      fmt::format("{}-merge", firstFile.path),
+      std::numeric_limits<uint64_t>::max(),
+      spillConfig.writeBufferSize,
+      spillConfig.fileCreateConfig,
+      updateAndCheckSpillLimitCb,
+      pool,
+      spillStats,
+      nullptr,
+      0,
+      spillConfig.tiers,
+      firstFile.columnarFormat,
+      spillConfig.zstdDictionarySize);
+
+  RowVectorPtr output;
+  vector_size_t outputSize{0};
+  // The run of consecutive rows from the same batch of 'runStream' to copy
+  // into 'output'.
+  SpillMergeStream* runStream{nullptr};
+  vector_size_t runStart{0};
+  vector_size_t runSize{0};
+  auto copyRun = [&]() {
+    if (runSize == 0) {
+      return;
+    }
+    if (output == nullptr) {
+      output = BaseVector::create<RowVector>(firstFile.type, 0, pool);
+    }
+    output->resize(outputSize + runSize);
+    output->copy(&runStream->current(), outputSize, runStart, runSize);
+    outputSize += runSize;
+    runSize = 0;
+    if (outputSize >= kOutputBatchRows) {
+      IndexRange range{0, outputSize};
+      writer.write(output, folly::Range<IndexRange*>(&range, 1));
+      output = nullptr;
+      outputSize = 0;
+    }
+  };
+
+  while (auto* stream = merge.next()) {
+    bool isLastRow;
+    const auto index = stream->currentIndex(&isLastRow);
+    if (stream != runStream || index != runStart + runSize) {
+      copyRun();
+      runStream = stream;
+      runStart = index;
+    }
+    ++runSize;
+    // The batch of 'stream' is replaced on pop() after its last row.
+    if (isLastRow || outputSize + runSize >= kOutputBatchRows) {
+      copyRun();
+    }
+    stream->pop();
+  }
+  VELOX_CHECK_EQ(runSize, 0);
+  if (outputSize > 0) {
+    IndexRange range{0, outputSize};
+    writer.write(output, folly::Range<IndexRange*>(&range, 1));
+  }
+
+  auto mergedFiles = writer.finish();
+  VELOX_CHECK_EQ(mergedFiles.size(), 1);
+  auto mergedFile = std::move(mergedFiles[0]);
+  mergedFile.id = fileId;
+
+  for (const auto& fileInfo : files) {
+    auto fs = filesystems::getFileSystem(fileInfo.path, nullptr);
+    fs->remove(fileInfo.path);
+  }
+  return mergedFile;
+}
+} // namespace
+
+void SpillPartition::mergeFiles(
+    uint32_t maxFanIn,
+    const common::SpillConfig& spillConfig,
+    memory::MemoryPool* pool,
+    folly::Synchronized<common::SpillStats>* spillStats) {
+  VELOX_CHECK_GE(maxFanIn, 2);
+  if (files_.size() <= maxFanIn) {
+    return;
+  }
+  uint32_t nextFileId{0};
+  for (const auto& fileInfo : files_) {
+    nextFileId = std::max(nextFileId, fileInfo.id + 1);
+  }
+
+  uint64_t numPasses{0};
+  uint64_t mergedBytes{0};
+  while (files_.size() > maxFanIn) {
+    ++numPasses;
+    // Merges the smallest files first.
+    std::sort(
+        files_.begin(),
+        files_.end(),
+        [](const SpillFileInfo& left, const SpillFileInfo& right) {
+          return left.size < right.size;
+        });
+    SpillFiles files;
+    size_t next{0};
+    // Merges groups until the merged and the remaining files fit in one final
+    // merge. Each group of n files reduces the number of files by n - 1.
+    while (files_.size() - next + files.size() > maxFanIn) {
+      const auto groupSize = std::min<size_t>(
+          maxFanIn, files_.size() - next + files.size() - maxFanIn + 1);
+      if (next + groupSize > files_.size()) {
+        break;
+      }
+      SpillFiles group(
+          std::make_move_iterator(files_.begin() + next),
+          std::make_move_iterator(files_.begin() + next + groupSize));
+      next += groupSize;
+      files.push_back(mergeSpillFiles(
+          group, nextFileId++, spillConfig, pool, spillStats));
+      mergedBytes += files.back().size;
+    }
+    files.insert(
+        files.end(),
+        std::make_move_iterator(files_.begin() + next),
+        std::make_move_iterator(files_.end()));
+    files_ = std::move(files);
+  }
+
+  size_ = 0;
+  for (const auto& fileInfo : files_) {
+    size_ += fileInfo.size;
+  }
+  auto lockedStats = spillStats->wlock();
+  lockedStats->spillMergePasses += numPasses;
+  lockedStats->spillMergeBytes += mergedBytes;
+  common::updateGlobalSpillMergeStats(numPasses, mergedBytes);
 }
 
 uint32_t FileSpillMergeStream::id() const {
@@ -51,6 +51,14 @@ class SpillMergeStream : public MergeStream {
 
   int32_t compare(const MergeStream& other) const override;
 
+  /// Encodes the first sort key of the current row with
+  /// prefixsort::PrefixSortEncoder and returns the first 8 bytes of the
+  /// encoding. The key type must pass supportsNormalizedKey().
+  uint64_t normalizedKey() const final;
+
+  /// Returns true if normalizedKey() supports a first sort key of 'type'.
+  static bool supportsNormalizedKey(const TypePtr& type);
+
   void pop();
 
   const RowVector& current() const {
@@ -299,14 +307,31 @@ class SpillPartition {
   /// Invoked to create an ordered stream reader from this spill partition.
   /// The created reader will take the ownership of the spill files.
   /// 'spillStats' is provided to collect the spill stats when reading data from
-  /// spilled files.
+  /// spilled files. If 'spillConfig' is set with a non-zero 'maxMergeFanIn'
+  /// less than the number of files, the files are first merged by
+  /// mergeFiles() so that the reader reads at most 'maxMergeFanIn' files at
+  /// once. The files whose read-ahead buffers fit in 'readAheadBytes' of
+  /// 'spillConfig' read ahead on its executor.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReader(
+      memory::MemoryPool* pool,
+      folly::Synchronized<common::SpillStats>* spillStats,
+      const common::SpillConfig* spillConfig = nullptr);
+
+  /// Merges groups of at most 'maxFanIn' sorted spill files into larger sorted
+  /// intermediate files until there are at most 'maxFanIn' files left. Each
+  /// pass merges the smallest files first and only as many as needed. The
+  /// merged files are removed. The intermediate files are written with the
+  /// write settings of 'spillConfig'.
+  void mergeFiles(
+      uint32_t maxFanIn,
+      const common::SpillConfig& spillConfig,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* spillStats);
 
   std::string toString() const;
 
  private:
+
   SpillPartitionId id_;
   SpillFiles files_;
   // Counts the total file size in bytes from this spilled partition.
@@ -326,7 +351,12 @@ class SpillState {
   /// 'numSortKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. If 'writeExecutor' is set, up to 'writeBehindBytes' of spill
+  /// data of each partition may be pending write on it, in which case 'pool'
+  /// must be thread-safe. 'tiers' places the spill files on spill tiers. If
+  /// 'columnarFormat' is true, the spill files are written with
+  /// ColumnarSpillSerializer. 'zstdDictionarySize' is passed to the
+  /// SpillWriters.
   SpillState(
       const common::GetSpillDirectoryPathCB& getSpillDirectoryPath,
       const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
@@ -339,7 +369,12 @@ class SpillState {
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      folly::Executor* writeExecutor = nullptr,
+      uint64_t writeBehindBytes = 0,
+      const common::SpillTiers& tiers = {},
+      bool columnarFormat = false,
+      uint64_t zstdDictionarySize = 0);
 
   /// Indicates if a given 'partition' has been spilled or not.
   bool isPartitionSpilled(uint32_t partition) const {
@@ -436,6 +471,11 @@ class SpillState {
   const std::string fileCreateConfig_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  folly::Executor* const writeExecutor_;
+  const uint64_t writeBehindBytes_;
+  const common::SpillTiers tiers_;
+  const bool columnarFormat_;
+  const uint64_t zstdDictionarySize_;
 
   // A set of spilled partition numbers.
   SpillPartitionNumSet spilledPartitionSet_;
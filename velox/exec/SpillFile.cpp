@@ -16,6 +16,7 @@
 
 #include "velox/exec/SpillFile.h"
 #include "velox/common/base/RuntimeMetrics.h"
+#include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/file/FileSystems.h"
 
 namespace facebook::velox::exec {
@@ -26,9 +27,103 @@ namespace {
 // nanosecond precision, we use this serde option to ensure the serializer
 // preserves precision.
 static const bool kDefaultUseLosslessTimestamp = true;
+
+// The size of the samples a zstd dictionary is trained on.
+constexpr size_t kZstdDictionarySampleBytes = 4 << 10;
+
+// Same as the default level of the folly zstd codec.
+constexpr int32_t kZstdDictionaryLevel = 1;
+
+serializer::presto::PrestoVectorSerde::PrestoOptions spillSerdeOptions(
+    common::CompressionKind compressionKind,
+    std::shared_ptr<const common::ZstdDictionary> zstdDictionary) {
+  serializer::presto::PrestoVectorSerde::PrestoOptions options = {
+      kDefaultUseLosslessTimestamp, compressionKind, true /*nullsFirst*/};
+  options.zstdDictionary = std::move(zstdDictionary);
+  return options;
+}
+
+// Trains a zstd dictionary of up to 'maxSize' bytes on the uncompressed
+// serialization of 'rows' in 'indices'. Returns nullptr if there is too little
+// data to train on.
+std::shared_ptr<const common::ZstdDictionary> trainZstdDictionary(
+    const RowVectorPtr& rows,
+    const folly::Range<IndexRange*>& indices,
+    uint64_t maxSize,
+    memory::MemoryPool* pool) {
+  auto options = spillSerdeOptions(common::CompressionKind_NONE, nullptr);
+  VectorStreamGroup group(pool);
+  group.createStreamTree(asRowType(rows->type()), 1'000, &options);
+  group.append(rows, indices);
+  IOBufOutputStream out(*pool, nullptr, std::max<int64_t>(1, group.size()));
+  group.flush(&out);
+  auto iobuf = out.getIOBuf();
+  const auto data = iobuf->coalesce();
+  std::vector<std::string_view> samples;
+  for (size_t offset = 0; offset < data.size();
+       offset += kZstdDictionarySampleBytes) {
+    samples.emplace_back(
+        reinterpret_cast<const char*>(data.data()) + offset,
+        std::min(kZstdDictionarySampleBytes, data.size() - offset));
+  }
+  return common::ZstdDictionary::train(samples, maxSize, kZstdDictionaryLevel);
+}
+
+// Invoked to update the disk write stats.
+void updateWriteStats(
+    folly::Synchronized<common::SpillStats>* stats,
+    uint64_t spilledBytes,
+    uint64_t flushTimeUs,
+    uint64_t fileWriteTimeUs) {
+  auto statsLocked = stats->wlock();
+  statsLocked->spilledBytes += spilledBytes;
+  statsLocked->spillFlushTimeUs += flushTimeUs;
+  statsLocked->spillWriteTimeUs += fileWriteTimeUs;
+  ++statsLocked->spillWrites;
+  common::updateGlobalSpillWriteStats(
+      spilledBytes, flushTimeUs, fileWriteTimeUs);
+}
+
+// Returns the type of the columns of 'type' in 'projection'.
+RowTypePtr projectRowType(
+    const RowTypePtr& type,
+    const std::vector<column_index_t>& projection) {
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (auto channel : projection) {
+    names.push_back(type->nameOf(channel));
+    types.push_back(type->childAt(channel));
+  }
+  return ROW(std::move(names), std::move(types));
+}
 } // namespace
 
+SpillInputStream::~SpillInputStream() {
+  if (readAhead_ != nullptr && readAhead_->started.exchange(true)) {
+    // The read on the executor writes to 'readAheadBuffer_'.
+    readAheadFuture_.wait();
+  }
+}
+
 void SpillInputStream::next(bool /*throwIfPastEnd*/) {
+  if (readAhead_ != nullptr) {
+    VELOX_CHECK_EQ(readAhead_->offset, offset_);
+    const int32_t readBytes = readAhead_->bytes;
+    uint64_t waitTimeUs{0};
+    const auto readTimeUs = finishReadAhead(waitTimeUs);
+    std::swap(buffer_, readAheadBuffer_);
+    setRange({buffer_->asMutable<uint8_t>(), readBytes, 0});
+    updateSpillStats(readBytes, readTimeUs);
+    {
+      auto lockedStats = stats_->wlock();
+      lockedStats->spillReadAheadTimeUs += readTimeUs;
+      lockedStats->spillReadAheadWaitTimeUs += waitTimeUs;
+    }
+    offset_ += readBytes;
+    startReadAhead();
+    return;
+  }
+
   const int32_t readBytes = std::min(size_ - offset_, buffer_->capacity());
   VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
   setRange({buffer_->asMutable<uint8_t>(), readBytes, 0});
@@ -39,6 +134,50 @@ void SpillInputStream::next(bool /*throwIfPastEnd*/) {
   }
   updateSpillStats(readBytes, readTimeUs);
   offset_ += readBytes;
+  startReadAhead();
+}
+
+void SpillInputStream::startReadAhead() {
+  if (readAheadBuffer_ == nullptr || offset_ >= size_) {
+    return;
+  }
+  readAhead_ = std::make_shared<ReadAhead>(
+      offset_,
+      std::min(size_ - offset_, readAheadBuffer_->capacity()),
+      readAheadBuffer_->asMutable<char>());
+  auto read = [file = file_.get(), readAhead = readAhead_]() {
+    uint64_t readTimeUs{0};
+    if (readAhead->started.exchange(true)) {
+      return readTimeUs;
+    }
+    {
+      MicrosecondTimer timer{&readTimeUs};
+      file->pread(readAhead->offset, readAhead->bytes, readAhead->buffer);
+    }
+    return readTimeUs;
+  };
+  readAheadFuture_ = folly::via(readAheadExecutor_, std::move(read)).semi();
+}
+
+uint64_t SpillInputStream::finishReadAhead(uint64_t& waitTimeUs) {
+  auto readAhead = std::move(readAhead_);
+  uint64_t readTimeUs{0};
+  if (!readAhead->started.exchange(true)) {
+    // Reads inline if the executor has not started the read, e.g. if it is
+    // busy with the reads of other files.
+    readAheadFuture_ = folly::SemiFuture<uint64_t>::makeEmpty();
+    {
+      MicrosecondTimer timer{&readTimeUs};
+      file_->pread(readAhead->offset, readAhead->bytes, readAhead->buffer);
+    }
+    waitTimeUs = readTimeUs;
+    return readTimeUs;
+  }
+  {
+    MicrosecondTimer timer{&waitTimeUs};
+    readTimeUs = std::move(readAheadFuture_).get();
+  }
+  return readTimeUs;
 }
 
 void SpillInputStream::updateSpillStats(uint64_t readBytes, uint64_t readTimeUs)
@@ -62,7 +201,9 @@ SpillWriteFile::SpillWriteFile(
     uint32_t id,
     const std::string& pathPrefix,
     const std::string& fileCreateConfig)
-    : id_(id), path_(fmt::format("{}-{}", pathPrefix, ordinalCounter_++)) {
+    : id_(id),
+      path_(fmt::format("{}-{}", pathPrefix, ordinalCounter_++)),
+      fileCreateConfig_(fileCreateConfig) {
   auto fs = filesystems::getFileSystem(path_, nullptr);
   file_ = fs->openFileForWrite(
       path_,
@@ -104,7 +245,12 @@ SpillWriter::SpillWriter(
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* writeExecutor,
+    uint64_t maxWriteBehindBytes,
+    common::SpillTiers tiers,
+    bool columnarFormat,
+    uint64_t zstdDictionarySize)
     : type_(type),
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
@@ -115,30 +261,99 @@ SpillWriter::SpillWriter(
       fileCreateConfig_(fileCreateConfig),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       pool_(pool),
-      stats_(stats) {
+      stats_(stats),
+      writeExecutor_(writeExecutor),
+      maxWriteBehindBytes_(maxWriteBehindBytes),
+      writeBehind_(
+          writeExecutor_ == nullptr
+              ? nullptr
+              : std::make_shared<WriteBehindState>(stats_)),
+      tiers_(std::move(tiers)),
+      columnarFormat_(columnarFormat),
+      zstdDictionarySize_(zstdDictionarySize) {
   // NOTE: if the associated spilling operator has specified the sort
   // comparison flags, then it must match the number of sorting keys.
   VELOX_CHECK(
       sortCompareFlags_.empty() || sortCompareFlags_.size() == numSortKeys_);
 }
 
-SpillWriteFile* SpillWriter::ensureFile() {
-  if ((currentFile_ != nullptr) && (currentFile_->size() > targetFileSize_)) {
+SpillWriter::~SpillWriter() {
+  if (writeBehind_ == nullptr) {
+    return;
+  }
+  // Drops the writes not started yet and waits for the one in progress since
+  // it writes to 'currentFile_'.
+  std::unique_lock<std::mutex> l(writeBehind_->mutex);
+  writeBehind_->pending.clear();
+  writeBehind_->pendingBytes = 0;
+  writeBehind_->cv.wait(l, [&]() { return !writeBehind_->writing; });
+}
+
+SpillWriteFile* SpillWriter::ensureFile(uint64_t bytes) {
+  if (currentFile_ != nullptr) {
+    const auto fileSize = writeBehind_ == nullptr ? currentFile_->size()
+                                                  : currentFileBytes_;
+    if (fileSize > targetFileSize_) {
+      closeFile();
+    }
+  }
+  if (currentFile_ != nullptr && !tiers_.empty() &&
+      !reserveOnTier(currentTier_, bytes)) {
     closeFile();
   }
   if (currentFile_ == nullptr) {
+    std::string_view pathPrefix = pathPrefix_;
+    std::string tierPathPrefix;
+    if (!tiers_.empty()) {
+      currentTier_ = reserveOnFirstTier(bytes);
+      if (currentTier_ > 0) {
+        // Places the file in the spill directory of the tier under the same
+        // file name.
+        tierPathPrefix = fmt::format(
+            "{}/{}",
+            tiers_.getDirectoryPathCb(currentTier_),
+            pathPrefix_.substr(pathPrefix_.rfind('/') + 1));
+        pathPrefix = tierPathPrefix;
+      }
+    }
+    currentFileBytes_ = 0;
     currentFile_ = SpillWriteFile::create(
         nextFileId_++,
-        fmt::format("{}-{}", pathPrefix_, finishedFiles_.size()),
+        fmt::format("{}-{}", pathPrefix, finishedFiles_.size()),
         fileCreateConfig_);
   }
   return currentFile_.get();
 }
 
+bool SpillWriter::reserveOnTier(int32_t tier, uint64_t bytes) {
+  if (!tiers_.reserveCb(tier, bytes)) {
+    return false;
+  }
+  if (tier > 0) {
+    stats_->wlock()->spilledFallbackBytes += bytes;
+  }
+  addThreadLocalRuntimeStat(
+      fmt::format("spillTier{}Bytes", tier),
+      RuntimeCounter(bytes, RuntimeCounter::Unit::kBytes));
+  return true;
+}
+
+int32_t SpillWriter::reserveOnFirstTier(uint64_t bytes) {
+  for (auto tier = 0; tier < tiers_.numTiers; ++tier) {
+    if (reserveOnTier(tier, bytes)) {
+      return tier;
+    }
+  }
+  VELOX_SPILL_LIMIT_EXCEEDED(fmt::format(
+      "No spill tier has room for {} of spill data",
+      succinctBytes(bytes)));
+}
+
 void SpillWriter::closeFile() {
   if (currentFile_ == nullptr) {
     return;
   }
+  drainWrites();
   currentFile_->finish();
   updateSpilledFileStats(currentFile_->size());
   finishedFiles_.push_back(SpillFileInfo{
@@ -148,7 +363,10 @@ void SpillWriter::closeFile() {
       .size = currentFile_->size(),
       .numSortKeys = numSortKeys_,
       .sortFlags = sortCompareFlags_,
-      .compressionKind = compressionKind_});
+      .compressionKind = compressionKind_,
+      .fileCreateConfig = fileCreateConfig_,
+      .columnarFormat = columnarFormat_,
+      .zstdDictionary = zstdDictionary_});
   currentFile_.reset();
 }
 
@@ -157,45 +375,182 @@ size_t SpillWriter::numFinishedFiles() const {
 }
 
 uint64_t SpillWriter::flush() {
-  if (batch_ == nullptr) {
+  if (batch_ == nullptr && columnarBatch_ == nullptr) {
     return 0;
   }
 
-  auto* file = ensureFile();
-  VELOX_CHECK_NOT_NULL(file);
-
   IOBufOutputStream out(
-      *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
+      *pool_,
+      nullptr,
+      std::max<int64_t>(
+          64 * 1024,
+          columnarBatch_ != nullptr ? columnarBatch_->size() : batch_->size()));
   uint64_t flushTimeUs{0};
+  // Holds the serialized pages of 'batch_' that 'out' references.
+  std::shared_ptr<StreamArena> referencedArena;
   {
     MicrosecondTimer timer(&flushTimeUs);
-    batch_->flush(&out);
+    if (columnarBatch_ != nullptr) {
+      columnarBatch_->flush(&out);
+    } else {
+      out.setReferenceArenaBytes();
+      batch_->flush(&out);
+      referencedArena = batch_->detach();
+    }
   }
   batch_.reset();
+  columnarBatch_.reset();
+
+  auto iobuf = out.getIOBuf(nullptr, std::move(referencedArena));
+  const auto bytes = iobuf->computeChainDataLength();
+  auto* file = ensureFile(bytes);
+  VELOX_CHECK_NOT_NULL(file);
+  if (writeBehind_ != nullptr) {
+    currentFileBytes_ += bytes;
+    updateAndCheckSpillLimitCb_(bytes);
+    bool schedule{false};
+    bool drain{false};
+    {
+      std::lock_guard<std::mutex> l(writeBehind_->mutex);
+      if (writeBehind_->error != nullptr) {
+        std::rethrow_exception(writeBehind_->error);
+      }
+      writeBehind_->pending.push_back(
+          PendingWrite{file, std::move(iobuf), bytes, flushTimeUs});
+      writeBehind_->pendingBytes += bytes;
+      schedule = !writeBehind_->scheduled;
+      writeBehind_->scheduled = true;
+      drain = writeBehind_->pendingBytes > maxWriteBehindBytes_;
+    }
+    if (schedule) {
+      writeExecutor_->add([state = writeBehind_]() { runWrites(state); });
+    }
+    if (drain) {
+      drainWrites(maxWriteBehindBytes_);
+    }
+    return bytes;
+  }
 
   uint64_t writeTimeUs{0};
   uint64_t writtenBytes{0};
-  auto iobuf = out.getIOBuf();
   {
     MicrosecondTimer timer(&writeTimeUs);
     writtenBytes = file->write(std::move(iobuf));
   }
-  updateWriteStats(writtenBytes, flushTimeUs, writeTimeUs);
+  updateWriteStats(stats_, writtenBytes, flushTimeUs, writeTimeUs);
   updateAndCheckSpillLimitCb_(writtenBytes);
   return writtenBytes;
 }
 
+// static
+void SpillWriter::writeFront(
+    WriteBehindState& state,
+    std::unique_lock<std::mutex>& lock) {
+  VELOX_CHECK(!state.writing);
+  auto write = std::move(state.pending.front());
+  state.pending.pop_front();
+  state.writing = true;
+  lock.unlock();
+
+  std::exception_ptr error;
+  uint64_t writeTimeUs{0};
+  try {
+    MicrosecondTimer timer(&writeTimeUs);
+    write.file->write(std::move(write.iobuf));
+  } catch (...) {
+    error = std::current_exception();
+  }
+  if (error == nullptr) {
+    updateWriteStats(state.stats, write.bytes, write.flushTimeUs, writeTimeUs);
+  }
+
+  lock.lock();
+  state.writing = false;
+  state.pendingBytes -= std::min(state.pendingBytes, write.bytes);
+  if (error != nullptr && state.error == nullptr) {
+    state.error = error;
+    state.pending.clear();
+    state.pendingBytes = 0;
+  }
+  state.cv.notify_all();
+}
+
+// static
+void SpillWriter::runWrites(const std::shared_ptr<WriteBehindState>& state) {
+  std::unique_lock<std::mutex> l(state->mutex);
+  while (!state->pending.empty() && !state->writing) {
+    writeFront(*state, l);
+  }
+  state->scheduled = false;
+}
+
+void SpillWriter::drainWrites(uint64_t maxPendingBytes) {
+  if (writeBehind_ == nullptr) {
+    return;
+  }
+  uint64_t waitTimeUs{0};
+  std::exception_ptr error;
+  bool schedule{false};
+  {
+    MicrosecondTimer timer(&waitTimeUs);
+    std::unique_lock<std::mutex> l(writeBehind_->mutex);
+    for (;;) {
+      writeBehind_->cv.wait(l, [&]() { return !writeBehind_->writing; });
+      if (writeBehind_->pending.empty() ||
+          writeBehind_->pendingBytes <= maxPendingBytes) {
+        break;
+      }
+      writeFront(*writeBehind_, l);
+    }
+    error = writeBehind_->error;
+    // The task on 'writeExecutor_' returns if it finds this writing, so
+    // schedules another one for the writes left.
+    if (!writeBehind_->pending.empty() && !writeBehind_->scheduled) {
+      writeBehind_->scheduled = true;
+      schedule = true;
+    }
+  }
+  if (schedule) {
+    writeExecutor_->add([state = writeBehind_]() { runWrites(state); });
+  }
+  stats_->wlock()->spillWriteWaitTimeUs += waitTimeUs;
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
 uint64_t SpillWriter::write(
     const RowVectorPtr& rows,
     const folly::Range<IndexRange*>& indices) {
   checkNotFinished();
 
   uint64_t timeUs{0};
+  if (columnarFormat_) {
+    {
+      MicrosecondTimer timer(&timeUs);
+      if (columnarBatch_ == nullptr) {
+        columnarBatch_ = std::make_unique<ColumnarSpillSerializer>(
+            asRowType(rows->type()), compressionKind_, pool_);
+      }
+      columnarBatch_->append(rows, indices);
+    }
+    updateAppendStats(rows->size(), timeUs);
+    if (columnarBatch_->size() < writeBufferSize_) {
+      return 0;
+    }
+    return flush();
+  }
+
   {
     MicrosecondTimer timer(&timeUs);
     if (batch_ == nullptr) {
-      serializer::presto::PrestoVectorSerde::PrestoOptions options = {
-          kDefaultUseLosslessTimestamp, compressionKind_, true /*nullsFirst*/};
+      if (!zstdDictionaryTrained_ && zstdDictionarySize_ > 0 &&
+          compressionKind_ == common::CompressionKind_ZSTD) {
+        zstdDictionary_ =
+            trainZstdDictionary(rows, indices, zstdDictionarySize_, pool_);
+        zstdDictionaryTrained_ = true;
+      }
+      auto options = spillSerdeOptions(compressionKind_, zstdDictionary_);
       batch_ = std::make_unique<VectorStreamGroup>(pool_);
       batch_->createStreamTree(
           std::static_pointer_cast<const RowType>(rows->type()),
@@ -220,19 +575,6 @@ void SpillWriter::updateAppendStats(
   common::updateGlobalSpillAppendStats(numRows, serializationTimeUs);
 }
 
-void SpillWriter::updateWriteStats(
-    uint64_t spilledBytes,
-    uint64_t flushTimeUs,
-    uint64_t fileWriteTimeUs) {
-  auto statsLocked = stats_->wlock();
-  statsLocked->spilledBytes += spilledBytes;
-  statsLocked->spillFlushTimeUs += flushTimeUs;
-  statsLocked->spillWriteTimeUs += fileWriteTimeUs;
-  ++statsLocked->spillWrites;
-  common::updateGlobalSpillWriteStats(
-      spilledBytes, flushTimeUs, fileWriteTimeUs);
-}
-
 void SpillWriter::updateSpilledFileStats(uint64_t fileSize) {
   ++stats_->wlock()->spilledFiles;
   addThreadLocalRuntimeStat(
@@ -284,7 +626,9 @@ std::vector<uint32_t> SpillWriter::testingSpilledFileIds() const {
 std::unique_ptr<SpillReadFile> SpillReadFile::create(
     const SpillFileInfo& fileInfo,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats) {
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* readAheadExecutor,
+    std::vector<column_index_t> projection) {
   return std::unique_ptr<SpillReadFile>(new SpillReadFile(
       fileInfo.id,
       fileInfo.path,
@@ -293,8 +637,13 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
       fileInfo.numSortKeys,
       fileInfo.sortFlags,
       fileInfo.compressionKind,
+      fileInfo.fileCreateConfig,
+      fileInfo.columnarFormat,
+      fileInfo.zstdDictionary,
+      std::move(projection),
       pool,
-      stats));
+      stats,
+      readAheadExecutor));
 }
 
 SpillReadFile::SpillReadFile(
@@ -305,8 +654,13 @@ SpillReadFile::SpillReadFile(
     uint32_t numSortKeys,
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
+    const std::string& fileCreateConfig,
+    bool columnarFormat,
+    std::shared_ptr<const common::ZstdDictionary> zstdDictionary,
+    std::vector<column_index_t> projection,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* readAheadExecutor)
     : id_(id),
       path_(path),
       size_(size),
@@ -314,20 +668,37 @@ SpillReadFile::SpillReadFile(
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
       compressionKind_(compressionKind),
-      readOptions_{
-          kDefaultUseLosslessTimestamp,
-          compressionKind_,
-          true /*nullsFirst*/},
+      columnarFormat_(columnarFormat),
+      projection_(std::move(projection)),
+      outputType_(
+          projection_.empty() ? type_ : projectRowType(type_, projection_)),
+      readOptions_(
+          spillSerdeOptions(compressionKind_, std::move(zstdDictionary))),
       pool_(pool),
       stats_(stats) {
-  constexpr uint64_t kMaxReadBufferSize =
-      (1 << 20) - AlignedBuffer::kPaddedSize; // 1MB - padding.
   auto fs = filesystems::getFileSystem(path_, nullptr);
-  auto file = fs->openFileForRead(path_);
-  auto buffer = AlignedBuffer::allocate<char>(
-      std::min<uint64_t>(size_, kMaxReadBufferSize), pool_);
+  auto file = fs->openFileForRead(
+      path_,
+      filesystems::FileOptions{
+          {{filesystems::FileOptions::kFileCreateConfig.toString(),
+            fileCreateConfig}},
+          nullptr,
+          std::nullopt});
+  const auto bufferSize = readBufferSize(size_);
+  auto buffer = AlignedBuffer::allocate<char>(bufferSize, pool_);
+  // A file read in one buffer has nothing to read ahead.
+  if (readAheadExecutor == nullptr || size_ <= bufferSize) {
+    input_ = std::make_unique<SpillInputStream>(
+        std::move(file), std::move(buffer), stats_);
+    return;
+  }
+  auto readAheadBuffer = AlignedBuffer::allocate<char>(bufferSize, pool_);
   input_ = std::make_unique<SpillInputStream>(
-      std::move(file), std::move(buffer), stats_);
+      std::move(file),
+      std::move(buffer),
+      stats_,
+      std::move(readAheadBuffer),
+      readAheadExecutor);
 }
 
 bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
@@ -338,12 +709,31 @@ bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
   uint64_t timeUs{0};
   {
     MicrosecondTimer timer{&timeUs};
-    VectorStreamGroup::read(
-        input_.get(), pool_, type_, &rowVector, &readOptions_);
+    if (columnarFormat_) {
+      rowVector = ColumnarSpillSerializer::read(
+          input_.get(), type_, projection_, compressionKind_, pool_);
+    } else if (projection_.empty()) {
+      VectorStreamGroup::read(
+          input_.get(), pool_, type_, &rowVector, &readOptions_);
+    } else {
+      VectorStreamGroup::read(
+          input_.get(), pool_, type_, &batch_, &readOptions_);
+      rowVector = project(batch_);
+    }
   }
   stats_->wlock()->spillDeserializationTimeUs += timeUs;
   common::updateGlobalSpillDeserializationTimeUs(timeUs);
 
   return true;
 }
+
+RowVectorPtr SpillReadFile::project(const RowVectorPtr& batch) const {
+  std::vector<VectorPtr> columns;
+  columns.reserve(projection_.size());
+  for (auto channel : projection_) {
+    columns.push_back(batch->childAt(channel));
+  }
+  return std::make_shared<RowVector>(
+      pool_, outputType_, nullptr, batch->size(), std::move(columns));
+}
 } // namespace facebook::velox::exec
@@ -16,13 +16,20 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <folly/container/F14Set.h>
+#include <folly/futures/Future.h>
+
+#include <condition_variable>
+#include <deque>
 
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/SpillStats.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/common/compression/ZstdDictionary.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/exec/ColumnarSpillSerializer.h"
 #include "velox/exec/TreeOfLosers.h"
 #include "velox/exec/UnorderedStreamReader.h"
 #include "velox/serializers/PrestoSerializer.h"
@@ -52,6 +59,12 @@ class SpillWriteFile {
     return path_;
   }
 
+  /// Returns the config the file was created with. The file is read back
+  /// with the same config.
+  const std::string& fileCreateConfig() const {
+    return fileCreateConfig_;
+  }
+
   uint64_t write(std::unique_ptr<folly::IOBuf> iobuf);
 
   WriteFile* file() {
@@ -73,6 +86,7 @@ class SpillWriteFile {
   // associated spill partition.
   const uint32_t id_;
   const std::string path_;
+  const std::string fileCreateConfig_;
 
   std::unique_ptr<WriteFile> file_;
   // Byte size of the backing file. Set when finishing writing.
@@ -89,6 +103,12 @@ struct SpillFileInfo {
   uint32_t numSortKeys;
   std::vector<CompareFlags> sortFlags;
   common::CompressionKind compressionKind;
+  /// The config the file was created with, also used for reading it.
+  std::string fileCreateConfig;
+  /// True if the file is written with ColumnarSpillSerializer.
+  bool columnarFormat{false};
+  /// The zstd dictionary the file is compressed with if any.
+  std::shared_ptr<const common::ZstdDictionary> zstdDictionary;
 };
 
 using SpillFiles = std::vector<SpillFileInfo>;
@@ -107,6 +127,24 @@ class SpillWriter {
   /// constructing the result data read from 'this'. 'stats' is used to collect
   /// the spill write stats.
   ///
+  /// If 'writeExecutor' is set, the serialized data is written to file on
+  /// 'writeExecutor' while the caller serializes the next batch. Up to
+  /// 'maxWriteBehindBytes' of serialized data may be pending write before a
+  /// flush waits for the pending writes. The writes of a file are done one at
+  /// a time in order.
+  ///
+  /// If 'tiers' is not empty, each file goes to the first spill tier with
+  /// room for its first data. The file name of 'pathPrefix' is used in the
+  /// spill directory of the tier. Once the tier of the current file is full,
+  /// the data continues in a new file.
+  ///
+  /// If 'columnarFormat' is true, the data is written with
+  /// ColumnarSpillSerializer instead of the Presto serialization format.
+  ///
+  /// If 'zstdDictionarySize' is not zero and 'compressionKind' is zstd, a zstd
+  /// dictionary of up to 'zstdDictionarySize' bytes is trained on the first
+  /// written data and the files in the Presto format are compressed with it.
+  ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
   SpillWriter(
@@ -120,7 +158,15 @@ class SpillWriter {
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* writeExecutor = nullptr,
+      uint64_t maxWriteBehindBytes = 0,
+      common::SpillTiers tiers = {},
+      bool columnarFormat = false,
+      uint64_t zstdDictionarySize = 0);
+
+  /// Waits for the pending writes if any.
+  ~SpillWriter();
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
@@ -152,31 +198,78 @@ class SpillWriter {
     VELOX_CHECK(!finished_, "SpillWriter has finished");
   }
 
-  // Returns an open spill file for write. If there is no open spill file, then
-  // the function creates a new one. If the current open spill file exceeds the
-  // target file size limit, then it first closes the current one and then
-  // creates a new one. 'currentFile_' points to the current open spill file.
-  SpillWriteFile* ensureFile();
+  // Returns an open spill file for writing 'bytes'. If there is no open spill
+  // file, then the function creates a new one. If the current open spill file
+  // exceeds the target file size limit or its spill tier has no room for
+  // 'bytes', then it first closes the current one and then creates a new one.
+  // 'currentFile_' points to the current open spill file.
+  SpillWriteFile* ensureFile(uint64_t bytes);
+
+  // Reserves 'bytes' on spill tier 'tier'. Returns false if it has no room.
+  bool reserveOnTier(int32_t tier, uint64_t bytes);
+
+  // Reserves 'bytes' on the first spill tier with room and returns it. Throws
+  // if no tier has room.
+  int32_t reserveOnFirstTier(uint64_t bytes);
 
   // Closes the current open spill file pointed by 'currentFile_'.
   void closeFile();
 
   // Writes data from 'batch_' to the current output file. Returns the actual
-  // written size.
+  // written size. With write-behind, returns the size queued for write.
   uint64_t flush();
 
+  // Serialized data pending write to 'file' on 'writeExecutor_'.
+  struct PendingWrite {
+    SpillWriteFile* file;
+    std::unique_ptr<folly::IOBuf> iobuf;
+    uint64_t bytes;
+    uint64_t flushTimeUs;
+  };
+
+  // The write-behind queue shared with the tasks on 'writeExecutor_'. The
+  // writes are done one at a time by either a task on 'writeExecutor_' or a
+  // flush waiting for the pending writes. The latter runs the pending writes
+  // itself instead of waiting for a task that may be queued behind it on the
+  // same executor.
+  struct WriteBehindState {
+    explicit WriteBehindState(folly::Synchronized<common::SpillStats>* _stats)
+        : stats(_stats) {}
+
+    folly::Synchronized<common::SpillStats>* const stats;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<PendingWrite> pending;
+    uint64_t pendingBytes{0};
+    // True if a write is in progress.
+    bool writing{false};
+    // True if a task is queued or running on 'writeExecutor_'.
+    bool scheduled{false};
+    // The first write error, rethrown on the next flush.
+    std::exception_ptr error;
+  };
+
+  // Writes the front write of 'state'. 'lock' is held on entry and on return
+  // and is released while writing.
+  static void writeFront(
+      WriteBehindState& state,
+      std::unique_lock<std::mutex>& lock);
+
+  // Runs the pending writes of 'state' on 'writeExecutor_'. Returns if the
+  // queue is empty or if another thread is writing.
+  static void runWrites(const std::shared_ptr<WriteBehindState>& state);
+
+  // Writes or waits for the pending writes until at most 'maxPendingBytes'
+  // are left and rethrows the first write error if any.
+  void drainWrites(uint64_t maxPendingBytes = 0);
+
   // Invoked to increment the number of spilled files and the file size.
   void updateSpilledFileStats(uint64_t fileSize);
 
   // Invoked to update the number of spilled rows.
   void updateAppendStats(uint64_t numRows, uint64_t serializationTimeUs);
 
-  // Invoked to update the disk write stats.
-  void updateWriteStats(
-      uint64_t spilledBytes,
-      uint64_t flushTimeUs,
-      uint64_t writeTimeUs);
-
   const RowTypePtr type_;
   const uint32_t numSortKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
@@ -191,11 +284,28 @@ class SpillWriter {
   common::UpdateAndCheckSpillLimitCB updateAndCheckSpillLimitCb_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  folly::Executor* const writeExecutor_;
+  const uint64_t maxWriteBehindBytes_;
+  // Set if 'writeExecutor_' is set.
+  const std::shared_ptr<WriteBehindState> writeBehind_;
+  const common::SpillTiers tiers_;
+  const bool columnarFormat_;
+  const uint64_t zstdDictionarySize_;
 
   bool finished_{false};
+  // True if the zstd dictionary has been trained, successfully or not.
+  bool zstdDictionaryTrained_{false};
+  std::shared_ptr<const common::ZstdDictionary> zstdDictionary_;
   uint32_t nextFileId_{0};
   std::unique_ptr<VectorStreamGroup> batch_;
+  // Used instead of 'batch_' if 'columnarFormat_' is true.
+  std::unique_ptr<ColumnarSpillSerializer> columnarBatch_;
   std::unique_ptr<SpillWriteFile> currentFile_;
+  // The bytes written or queued for write to 'currentFile_'. Used instead of
+  // the file size with write-behind.
+  uint64_t currentFileBytes_{0};
+  // The spill tier of 'currentFile_' if 'tiers_' is not empty.
+  int32_t currentTier_{0};
   SpillFiles finishedFiles_;
 };
 
@@ -206,34 +316,73 @@ class SpillWriter {
 /// remainingSize() APIs do not work properly.
 class SpillInputStream : public ByteInputStream {
  public:
-  /// Reads from 'input' using 'buffer' for buffering reads.
+  /// Reads from 'input' using 'buffer' for buffering reads. If
+  /// 'readAheadBuffer' is set, the next buffer of data is read into it on
+  /// 'readAheadExecutor' while 'buffer' is consumed. The two buffers have the
+  /// same size.
   SpillInputStream(
       std::unique_ptr<ReadFile>&& file,
       BufferPtr buffer,
-      folly::Synchronized<common::SpillStats>* stats)
+      folly::Synchronized<common::SpillStats>* stats,
+      BufferPtr readAheadBuffer = nullptr,
+      folly::Executor* readAheadExecutor = nullptr)
       : file_(std::move(file)),
         size_(file_->size()),
         buffer_(std::move(buffer)),
+        readAheadBuffer_(std::move(readAheadBuffer)),
+        readAheadExecutor_(readAheadExecutor),
         stats_(stats) {
+    VELOX_CHECK_EQ(readAheadBuffer_ == nullptr, readAheadExecutor_ == nullptr);
     next(true);
   }
 
+  /// Waits for the read-ahead in progress if any.
+  ~SpillInputStream() override;
+
   /// True if all of the file has been read into vectors.
   bool atEnd() const override {
     return offset_ >= size_ && ranges()[0].position >= ranges()[0].size;
   }
 
  private:
+  // A read of 'bytes' at 'offset' into 'buffer' run on 'readAheadExecutor_'.
+  // The read is done by whoever sets 'started' first, i.e. by the task on the
+  // executor or by next() if the task has not started by then.
+  struct ReadAhead {
+    ReadAhead(uint64_t _offset, uint64_t _bytes, char* _buffer)
+        : offset(_offset), bytes(_bytes), buffer(_buffer) {}
+
+    const uint64_t offset;
+    const uint64_t bytes;
+    char* const buffer;
+    std::atomic_bool started{false};
+  };
+
   void updateSpillStats(uint64_t readBytes, uint64_t readTimeUs) const;
   void next(bool throwIfPastEnd) override;
 
+  // Starts reading the data after 'buffer_' into 'readAheadBuffer_' if there
+  // is read-ahead and data left.
+  void startReadAhead();
+
+  // Returns the read time of 'readAhead_' after it finishes. Sets 'waitTimeUs'
+  // to the time waited for it.
+  uint64_t finishReadAhead(uint64_t& waitTimeUs);
+
   const std::unique_ptr<ReadFile> file_;
   const uint64_t size_;
-  const BufferPtr buffer_;
+  BufferPtr buffer_;
+  BufferPtr readAheadBuffer_;
+  folly::Executor* const readAheadExecutor_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
   // Offset of first byte not in 'buffer_'
   uint64_t offset_ = 0;
+
+  // The read-ahead in progress into 'readAheadBuffer_' if any.
+  std::shared_ptr<ReadAhead> readAhead_;
+  folly::SemiFuture<uint64_t> readAheadFuture_{
+      folly::SemiFuture<uint64_t>::makeEmpty()};
 };
 
 /// Represents a spill file for read which turns the serialized spilled data on
@@ -245,10 +394,26 @@ class SpillInputStream : public ByteInputStream {
 /// rmdir() call.
 class SpillReadFile {
  public:
+  /// Each read buffer of a file takes up to this many bytes.
+  static constexpr uint64_t kMaxReadBufferSize =
+      (1 << 20) - AlignedBuffer::kPaddedSize; // 1MB - padding.
+
+  /// Returns the size of a read buffer of a file of 'fileSize' bytes.
+  static uint64_t readBufferSize(uint64_t fileSize) {
+    return std::min(fileSize, kMaxReadBufferSize);
+  }
+
+  /// Makes a reader of 'fileInfo'. If 'readAheadExecutor' is set, the file
+  /// takes a second read buffer to read ahead on 'readAheadExecutor'. If
+  /// 'projection' is not empty, the batches have only the columns of the file
+  /// in 'projection' in this order. A file in the columnar format does not
+  /// decode the other columns.
   static std::unique_ptr<SpillReadFile> create(
       const SpillFileInfo& fileInfo,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* readAheadExecutor = nullptr,
+      std::vector<column_index_t> projection = {});
 
   uint32_t id() const {
     return id_;
@@ -282,8 +447,16 @@ class SpillReadFile {
       uint32_t numSortKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
+      const std::string& fileCreateConfig,
+      bool columnarFormat,
+      std::shared_ptr<const common::ZstdDictionary> zstdDictionary,
+      std::vector<column_index_t> projection,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* readAheadExecutor);
+
+  // Returns the columns of 'batch' in 'projection_'.
+  RowVectorPtr project(const RowVectorPtr& batch) const;
 
   // The spill file id which is monotonically increasing and unique for each
   // associated spill partition.
@@ -296,10 +469,16 @@ class SpillReadFile {
   const uint32_t numSortKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
   const common::CompressionKind compressionKind_;
+  const bool columnarFormat_;
+  const std::vector<column_index_t> projection_;
+  // The type of the batches. Differs from 'type_' if 'projection_' is set.
+  const RowTypePtr outputType_;
   const serializer::presto::PrestoVectorSerde::PrestoOptions readOptions_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
   std::unique_ptr<SpillInputStream> input_;
+  // The batch read from a file in the Presto format before projection.
+  RowVectorPtr batch_;
 };
 } // namespace facebook::velox::exec
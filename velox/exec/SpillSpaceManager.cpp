@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SpillSpaceManager.h"
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SuccinctPrinter.h"
+
+namespace facebook::velox::exec {
+
+SpillSpaceManager::SpillSpaceManager(std::vector<Tier> tiers)
+    : tiers_(std::move(tiers)), usedBytes_(tiers_.size()) {
+  VELOX_CHECK(!tiers_.empty(), "Spill space manager needs at least one tier");
+  for (auto i = 1; i < tiers_.size(); ++i) {
+    VELOX_CHECK(!tiers_[i].path.empty(), "Spill tier {} has no path", i);
+  }
+}
+
+// static
+SpillSpaceManager* SpillSpaceManager::getInstance() {
+  return *getInstancePtr();
+}
+
+// static
+void SpillSpaceManager::setInstance(SpillSpaceManager* manager) {
+  *getInstancePtr() = manager;
+}
+
+// static
+SpillSpaceManager** SpillSpaceManager::getInstancePtr() {
+  static SpillSpaceManager* manager_{nullptr};
+  return &manager_;
+}
+
+bool SpillSpaceManager::tryReserve(int32_t tier, uint64_t bytes) {
+  const auto capacity = tiers_.at(tier).capacity;
+  auto& usedBytes = usedBytes_[tier];
+  auto used = usedBytes.load();
+  do {
+    if (used + bytes > capacity) {
+      return false;
+    }
+  } while (!usedBytes.compare_exchange_weak(used, used + bytes));
+  return true;
+}
+
+void SpillSpaceManager::release(int32_t tier, uint64_t bytes) {
+  const auto used = usedBytes_.at(tier).fetch_sub(bytes);
+  VELOX_CHECK_GE(used, bytes, "Released more than reserved on spill tier");
+}
+
+std::string SpillSpaceManager::toString() const {
+  std::stringstream out;
+  out << "SpillSpaceManager[";
+  for (auto i = 0; i < tiers_.size(); ++i) {
+    out << (i > 0 ? ", " : "") << i << ": " << succinctBytes(usedBytes_[i])
+        << "/" << succinctBytes(tiers_[i].capacity);
+  }
+  out << "]";
+  return out.str();
+}
+
+} // namespace facebook::velox::exec
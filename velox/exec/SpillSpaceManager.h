@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+/// Manages the spill space of a node on an ordered list of spill tiers, e.g.
+/// local NVMe first and then a remote object store through its FileSystem.
+/// Each tier has a capacity in bytes shared by all the queries on the node. A
+/// spill file is placed on the first tier with room. Once the tier of a spill
+/// file is full, the spill data continues in a new file on the next tier with
+/// room.
+///
+/// The spill directory of a Task is expected to be on the first tier. The
+/// spill directories of the Task on the other tiers are made under the paths
+/// of the tiers. The space reserved by a Task is released when the Task
+/// removes its spill directories.
+class SpillSpaceManager {
+ public:
+  struct Tier {
+    /// The directory under which the spill directories of the tasks on this
+    /// tier are made. Not used for the first tier.
+    std::string path;
+    /// The max bytes of spill data on this tier.
+    uint64_t capacity;
+  };
+
+  explicit SpillSpaceManager(std::vector<Tier> tiers);
+
+  /// Returns the process-wide instance or nullptr if spill tiers are not
+  /// used.
+  static SpillSpaceManager* getInstance();
+
+  static void setInstance(SpillSpaceManager* manager);
+
+  int32_t numTiers() const {
+    return tiers_.size();
+  }
+
+  const Tier& tier(int32_t tier) const {
+    return tiers_.at(tier);
+  }
+
+  /// Reserves 'bytes' on 'tier'. Returns false without reserving if that
+  /// would exceed the capacity of 'tier'.
+  bool tryReserve(int32_t tier, uint64_t bytes);
+
+  /// Releases 'bytes' reserved on 'tier'.
+  void release(int32_t tier, uint64_t bytes);
+
+  /// Returns the bytes reserved on 'tier'.
+  uint64_t usedBytes(int32_t tier) const {
+    return usedBytes_.at(tier);
+  }
+
+  std::string toString() const;
+
+ private:
+  static SpillSpaceManager** getInstancePtr();
+
+  const std::vector<Tier> tiers_;
+  std::vector<std::atomic<uint64_t>> usedBytes_;
+};
+
+} // namespace facebook::velox::exec
@@ -58,6 +58,10 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->writeBehindBytes,
+          spillConfig->tiers,
+          spillConfig->columnarFormat,
+          spillConfig->zstdDictionarySize,
           spillStats) {
   VELOX_CHECK(
       type_ == Type::kOrderByInput || type_ == Type::kAggregateInput,
@@ -90,6 +94,10 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->writeBehindBytes,
+          spillConfig->tiers,
+          spillConfig->columnarFormat,
+          spillConfig->zstdDictionarySize,
           spillStats) {
   VELOX_CHECK(
       type_ == Type::kAggregateOutput || type_ == Type::kOrderByOutput,
@@ -122,6 +130,10 @@ Spiller::Spiller(
           spillConfig->executor,
           0,
           spillConfig->fileCreateConfig,
+          spillConfig->writeBehindBytes,
+          spillConfig->tiers,
+          spillConfig->columnarFormat,
+          spillConfig->zstdDictionarySize,
           spillStats) {
   VELOX_CHECK_EQ(
       type_,
@@ -155,6 +167,10 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->writeBehindBytes,
+          spillConfig->tiers,
+          spillConfig->columnarFormat,
+          spillConfig->zstdDictionarySize,
           spillStats) {
   VELOX_CHECK_EQ(type_, Type::kHashJoinBuild);
   VELOX_CHECK(isHashJoinTableSpillType(rowType_, joinType));
@@ -184,8 +200,15 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->writeBehindBytes,
+          spillConfig->tiers,
+          spillConfig->columnarFormat,
+          spillConfig->zstdDictionarySize,
           spillStats) {
-  VELOX_CHECK_EQ(type_, Type::kRowNumber);
+  VELOX_CHECK(
+      type_ == Type::kRowNumber || type_ == Type::kAggregateInputPartitioned,
+      "Unexpected spiller type: {}",
+      typeName(type_));
 }
 
 Spiller::Spiller(
@@ -205,6 +228,10 @@ Spiller::Spiller(
     folly::Executor* executor,
     uint64_t maxSpillRunRows,
     const std::string& fileCreateConfig,
+    uint64_t writeBehindBytes,
+    const common::SpillTiers& tiers,
+    bool columnarFormat,
+    uint64_t zstdDictionarySize,
     folly::Synchronized<common::SpillStats>* spillStats)
     : type_(type),
       container_(container),
@@ -226,7 +253,12 @@ Spiller::Spiller(
           compressionKind,
           memory::spillMemoryPool(),
           spillStats,
-          fileCreateConfig) {
+          fileCreateConfig,
+          writeBehindBytes == 0 ? nullptr : executor,
+          writeBehindBytes,
+          tiers,
+          columnarFormat,
+          zstdDictionarySize) {
   TestValue::adjust("facebook::velox::exec::Spiller", this);
 
   VELOX_CHECK(!spillProbedFlag_ || type_ == Type::kHashJoinBuild);
@@ -504,7 +536,8 @@ void Spiller::updateSpillSortTime(uint64_t timeUs) {
 bool Spiller::needSort() const {
   return type_ != Type::kHashJoinProbe && type_ != Type::kHashJoinBuild &&
       type_ != Type::kRowNumber && type_ != Type::kAggregateOutput &&
-      type_ != Type::kOrderByOutput;
+      type_ != Type::kOrderByOutput &&
+      type_ != Type::kAggregateInputPartitioned;
 }
 
 void Spiller::spill() {
@@ -710,6 +743,8 @@ std::string Spiller::typeName(Type type) {
       return "AGGREGATE_OUTPUT";
     case Type::kRowNumber:
       return "ROW_NUMBER";
+    case Type::kAggregateInputPartitioned:
+      return "AGGREGATE_INPUT_PARTITIONED";
     default:
       VELOX_UNREACHABLE("Unknown type: {}", static_cast<int>(type));
   }
@@ -41,8 +41,10 @@ class Spiller {
     kOrderByOutput = 5,
     // Used for row number.
     kRowNumber = 6,
+    // Used for hash partitioned aggregation input processing stage.
+    kAggregateInputPartitioned = 7,
     // Number of spiller types.
-    kNumTypes = 7,
+    kNumTypes = 8,
   };
 
   static std::string typeName(Type);
@@ -88,7 +90,7 @@ class Spiller {
       const common::SpillConfig* spillConfig,
       folly::Synchronized<common::SpillStats>* spillStats);
 
-  /// type == Type::kRowNumber
+  /// type == Type::kRowNumber || type == Type::kAggregateInputPartitioned
   Spiller(
       Type type,
       RowContainer* container,
@@ -210,6 +212,10 @@ class Spiller {
       folly::Executor* executor,
       uint64_t maxSpillRunRows,
       const std::string& fileCreateConfig,
+      uint64_t writeBehindBytes,
+      const common::SpillTiers& tiers,
+      bool columnarFormat,
+      uint64_t zstdDictionarySize,
       folly::Synchronized<common::SpillStats>* spillStats);
 
   // Invoked to spill. If 'startRowIter' is not null, then we only spill rows
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SplitResultCache.h"
+
+#include "velox/common/serialization/BinarySerde.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+SplitResultCache** instancePtr() {
+  static SplitResultCache* cache{nullptr};
+  return &cache;
+}
+
+std::vector<RowVectorPtr> copyBatches(
+    const std::vector<RowVectorPtr>& batches,
+    memory::MemoryPool* pool) {
+  std::vector<RowVectorPtr> copies;
+  copies.reserve(batches.size());
+  for (const auto& batch : batches) {
+    auto copy = BaseVector::create<RowVector>(
+        batch->type(), batch->size(), pool);
+    copy->copy(batch.get(), 0, 0, batch->size());
+    copies.push_back(std::move(copy));
+  }
+  return copies;
+}
+} // namespace
+
+SplitResultCache::SplitResultCache(
+    std::shared_ptr<memory::MemoryPool> pool,
+    uint64_t maxBytes,
+    uint64_t maxEntryBytes)
+    : pool_(std::move(pool)),
+      maxBytes_(maxBytes),
+      maxEntryBytes_(std::min(maxEntryBytes, maxBytes)) {
+  VELOX_CHECK_NOT_NULL(pool_);
+}
+
+SplitResultCache::~SplitResultCache() {
+  clear();
+}
+
+// static
+SplitResultCache* SplitResultCache::getInstance() {
+  return *instancePtr();
+}
+
+// static
+void SplitResultCache::setInstance(SplitResultCache* cache) {
+  *instancePtr() = cache;
+}
+
+// static
+std::optional<std::string> SplitResultCache::fingerprint(
+    const core::TableScanNode& scanNode) {
+  try {
+    auto obj = scanNode.serialize();
+    obj.erase("id");
+    // The assignments come from an unordered map.
+    auto& assignments = obj["assignments"];
+    std::sort(
+        assignments.begin(),
+        assignments.end(),
+        [](const folly::dynamic& left, const folly::dynamic& right) {
+          return left["assign"].asString() < right["assign"].asString();
+        });
+    return serializeBinary(obj);
+  } catch (const VeloxException&) {
+    return std::nullopt;
+  }
+}
+
+// static
+std::optional<std::string> SplitResultCache::makeKey(
+    const std::string& fingerprint,
+    const connector::ConnectorSplit& split) {
+  auto splitKey = split.cacheKey();
+  if (!splitKey.has_value()) {
+    return std::nullopt;
+  }
+  return fmt::format("{}:{}\n{}", split.connectorId, *splitKey, fingerprint);
+}
+
+std::optional<std::vector<RowVectorPtr>> SplitResultCache::find(
+    const std::string& key,
+    memory::MemoryPool* pool) {
+  std::vector<RowVectorPtr> batches;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    ++numLookups_;
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      return std::nullopt;
+    }
+    ++numHits_;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    batches = it->second->batches;
+  }
+  // The batches are immutable, so they can be copied outside of the lock.
+  return copyBatches(batches, pool);
+}
+
+void SplitResultCache::insert(
+    const std::string& key,
+    const std::vector<RowVectorPtr>& batches) {
+  auto copies = copyBatches(batches, pool_.get());
+  uint64_t bytes = key.size();
+  for (const auto& copy : copies) {
+    bytes += copy->retainedSize();
+  }
+  if (bytes > maxEntryBytes_) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (entries_.count(key) > 0) {
+    return;
+  }
+  lru_.push_front(Entry{key, std::move(copies), bytes});
+  entries_.emplace(lru_.front().key, lru_.begin());
+  numBytes_ += bytes;
+  evictLocked();
+}
+
+void SplitResultCache::evictLocked() {
+  while (numBytes_ > maxBytes_) {
+    auto& entry = lru_.back();
+    entries_.erase(entry.key);
+    numBytes_ -= entry.bytes;
+    ++numEvictions_;
+    lru_.pop_back();
+  }
+}
+
+void SplitResultCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  numBytes_ = 0;
+}
+
+SplitResultCache::Stats SplitResultCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return Stats{
+      numLookups_, numHits_, numEvictions_, entries_.size(), numBytes_};
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <list>
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/connectors/Connector.h"
+#include "velox/core/PlanNode.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// Process-wide cache of the output of TableScan for a split. Dashboards run
+/// the same scans over mostly unchanged files again and again. With a cache
+/// set by setInstance() and QueryConfig::kSplitResultCacheEnabled, TableScan
+/// replays the cached output of a split instead of reading it. The operators
+/// after the scan, e.g. FilterProject and partial aggregation, run on the
+/// replayed batches as usual.
+///
+/// An entry is keyed by the fingerprint of the scan, i.e. its table handle
+/// with the pushed down filters, its assignments and output type, and by the
+/// identity of the split, see ConnectorSplit::cacheKey(). Splits without a
+/// cache key and scans with dynamic filters are not cached. Batches are
+/// copied into 'pool' on insertion and into the pool of the scan on lookup.
+/// Entries are evicted in LRU order to stay under 'maxBytes'. The output of
+/// a split over 'maxEntryBytes' is not cached. Thread-safe.
+class SplitResultCache {
+ public:
+  struct Stats {
+    uint64_t numLookups{0};
+    uint64_t numHits{0};
+    uint64_t numEvictions{0};
+    uint64_t numEntries{0};
+    uint64_t numBytes{0};
+  };
+
+  SplitResultCache(
+      std::shared_ptr<memory::MemoryPool> pool,
+      uint64_t maxBytes,
+      uint64_t maxEntryBytes);
+
+  ~SplitResultCache();
+
+  /// Returns the cache used by TableScan, nullptr if none.
+  static SplitResultCache* getInstance();
+
+  /// Sets the cache used by TableScan. The caller keeps ownership. nullptr
+  /// disables caching.
+  static void setInstance(SplitResultCache* cache);
+
+  /// Returns the part of the key that depends on 'scanNode', or std::nullopt
+  /// if its table handle or column handles can not be serialized. Does not
+  /// depend on the plan node ID.
+  static std::optional<std::string> fingerprint(
+      const core::TableScanNode& scanNode);
+
+  /// Returns the key for the output of 'split' in a scan with 'fingerprint',
+  /// or std::nullopt if 'split' can not be keyed.
+  static std::optional<std::string> makeKey(
+      const std::string& fingerprint,
+      const connector::ConnectorSplit& split);
+
+  uint64_t maxEntryBytes() const {
+    return maxEntryBytes_;
+  }
+
+  /// Returns copies in 'pool' of the batches for 'key', std::nullopt if not
+  /// found.
+  std::optional<std::vector<RowVectorPtr>> find(
+      const std::string& key,
+      memory::MemoryPool* pool);
+
+  /// Adds 'batches', all the output of a split, for 'key'. The batches must
+  /// not have lazy vectors that are not loaded.
+  void insert(const std::string& key, const std::vector<RowVectorPtr>& batches);
+
+  void clear();
+
+  Stats stats() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    std::vector<RowVectorPtr> batches;
+    uint64_t bytes;
+  };
+
+  // Removes least recently used entries until 'numBytes_' is at most
+  // 'maxBytes_'.
+  void evictLocked();
+
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  const uint64_t maxBytes_;
+  const uint64_t maxEntryBytes_;
+
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> lru_;
+  folly::F14FastMap<std::string_view, std::list<Entry>::iterator> entries_;
+  uint64_t numBytes_{0};
+  uint64_t numLookups_{0};
+  uint64_t numHits_{0};
+  uint64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox::exec
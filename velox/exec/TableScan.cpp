@@ -16,6 +16,7 @@
 #include "velox/exec/TableScan.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
+#include "velox/exec/SplitResultCache.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
 
@@ -44,11 +45,21 @@ TableScan::TableScan(
           tableHandle_->connectorId())),
       maxSplitPreloadPerDriver_(
           driverCtx_->queryConfig().maxSplitPreloadPerDriver()),
+      adaptiveSplitPreload_(
+          driverCtx_->queryConfig().adaptiveSplitPreloadEnabled()),
+      splitPreloadPerDriver_(
+          adaptiveSplitPreload_ ? std::min(1, maxSplitPreloadPerDriver_)
+                                : maxSplitPreloadPerDriver_),
       readBatchSize_(driverCtx_->queryConfig().preferredOutputBatchRows()),
       maxReadBatchSize_(driverCtx_->queryConfig().maxOutputBatchRows()),
+      adaptiveReadBatchSize_(
+          driverCtx_->queryConfig().adaptiveOutputBatchBytes() > 0),
       getOutputTimeLimitMs_(
           driverCtx_->queryConfig().tableScanGetOutputTimeLimitMs()) {
   connector_ = connector::getConnector(tableHandle_->connectorId());
+  if (driverCtx_->queryConfig().splitResultCacheEnabled()) {
+    resultCacheFingerprint_ = SplitResultCache::fingerprint(*tableScanNode);
+  }
 }
 
 folly::dynamic TableScan::toJson() const {
@@ -101,6 +112,14 @@ RowVectorPtr TableScan::getOutput() {
       // A point for test code injection.
       TestValue::adjust("facebook::velox::exec::TableScan::getOutput", this);
 
+      // Elastic pipelines park drivers between splits.
+      curStatus_ = "getOutput: task->parkElasticDriver";
+      blockingReason_ =
+          driverCtx_->task->parkElasticDriver(*driverCtx_, blockingFuture_);
+      if (blockingReason_ != BlockingReason::kNotBlocked) {
+        return nullptr;
+      }
+
       exec::Split split;
       curStatus_ = "getOutput: task->getSplitOrFuture";
       blockingReason_ = driverCtx_->task->getSplitOrFuture(
@@ -117,6 +136,7 @@ RowVectorPtr TableScan::getOutput() {
       if (!split.hasConnectorSplit()) {
         noMoreSplits_ = true;
         dynamicFilters_.clear();
+        updateBloomFilterStats();
         if (dataSource_) {
           curStatus_ = "getOutput: noMoreSplits_=1, updating stats_";
           const auto connectorStats = dataSource_->runtimeStats();
@@ -148,6 +168,17 @@ RowVectorPtr TableScan::getOutput() {
           connectorSplit->connectorId,
           "Got splits with different connector IDs");
 
+      if (lookupResultCache(*connectorSplit)) {
+        curStatus_ = "getOutput: split result cache hit";
+        if (connectorSplit->dataSource != nullptr) {
+          connectorSplit->dataSource->close();
+        }
+        auto lockedStats = stats_.wlock();
+        ++lockedStats->numSplits;
+        lockedStats->addRuntimeStat("splitResultCacheHits", RuntimeCounter(1));
+        continue;
+      }
+
       if (dataSource_ == nullptr) {
         curStatus_ = "getOutput: creating dataSource_";
         connectorQueryCtx_ = operatorCtx_->createConnectorQueryCtx(
@@ -173,30 +204,43 @@ RowVectorPtr TableScan::getOutput() {
            },
            &debugString_});
 
+      std::unique_ptr<connector::DataSource> preparedDataSource;
       if (connectorSplit->dataSource != nullptr) {
         curStatus_ = "getOutput: preloaded split";
         ++numPreloadedSplits_;
         // The AsyncSource returns a unique_ptr to a shared_ptr. The unique_ptr
         // will be nullptr if there was a cancellation.
-        numReadyPreloadedSplits_ += connectorSplit->dataSource->hasValue();
-        auto preparedDataSource = connectorSplit->dataSource->move();
-        stats_.wlock()->getOutputTiming.add(
-            connectorSplit->dataSource->prepareTiming());
-        if (!preparedDataSource) {
-          // There must be a cancellation.
-          VELOX_CHECK(operatorCtx_->task()->isCancelled());
+        const bool ready = connectorSplit->dataSource->hasValue();
+        numReadyPreloadedSplits_ += ready;
+        const auto moveStartMicros = getCurrentTimeMicro();
+        preparedDataSource = connectorSplit->dataSource->move();
+        const auto& prepareTiming = connectorSplit->dataSource->prepareTiming();
+        auto lockedStats = stats_.wlock();
+        lockedStats->getOutputTiming.add(prepareTiming);
+        splitOpenNanos_ = prepareTiming.wallNanos;
+        if (adaptiveSplitPreload_ && !ready) {
+          lockedStats->addRuntimeStat(
+              "preloadWaitWallNanos",
+              RuntimeCounter(
+                  (getCurrentTimeMicro() - moveStartMicros) * 1'000,
+                  RuntimeCounter::Unit::kNanos));
+        }
+        if (!preparedDataSource && operatorCtx_->task()->isCancelled()) {
           return nullptr;
         }
+        // Otherwise the TableScan that preloaded the split closed before the
+        // preload started and the split is added below.
+      }
+      if (preparedDataSource != nullptr) {
         dataSource_->setFromDataSource(std::move(preparedDataSource));
       } else {
         curStatus_ = "getOutput: adding split";
         const auto addSplitStartMicros = getCurrentTimeMicro();
         dataSource_->addSplit(connectorSplit);
+        splitOpenNanos_ = (getCurrentTimeMicro() - addSplitStartMicros) * 1'000;
         stats_.wlock()->addRuntimeStat(
             "dataSourceAddSplitWallNanos",
-            RuntimeCounter(
-                (getCurrentTimeMicro() - addSplitStartMicros) * 1'000,
-                RuntimeCounter::Unit::kNanos));
+            RuntimeCounter(splitOpenNanos_, RuntimeCounter::Unit::kNanos));
       }
       curStatus_ = "getOutput: updating stats_.numSplits";
       ++stats_.wlock()->numSplits;
@@ -209,6 +253,19 @@ RowVectorPtr TableScan::getOutput() {
           : outputBatchRows(estimatedRowSize);
     }
 
+    if (cachedOutput_.has_value()) {
+      curStatus_ = "getOutput: replaying cached split output";
+      if (nextCachedOutput_ < cachedOutput_->size()) {
+        auto data = (*cachedOutput_)[nextCachedOutput_++];
+        stats_.wlock()->addInputVector(data->estimateFlatSize(), data->size());
+        return data;
+      }
+      cachedOutput_.reset();
+      driverCtx_->task->splitFinished(true, currentSplitWeight_);
+      needNewSplit_ = true;
+      continue;
+    }
+
     const auto ioTimeStartMicros = getCurrentTimeMicro();
     // Check for  cancellation since scans that filter everything out will not
     // hit the check in Driver.
@@ -223,6 +280,9 @@ RowVectorPtr TableScan::getOutput() {
          },
          &debugString_});
 
+    if (lastOutput_ != nullptr) {
+      adaptReadBatchSize();
+    }
     int readBatchSize = readBatchSize_;
     if (maxFilteringRatio_ > 0) {
       readBatchSize = std::min(
@@ -236,12 +296,13 @@ RowVectorPtr TableScan::getOutput() {
 
     {
       curStatus_ = "getOutput: updating stats_.dataSourceReadWallNanos";
+      const uint64_t readNanos =
+          (getCurrentTimeMicro() - ioTimeStartMicros) * 1'000;
+      splitReadNanos_ += readNanos;
       auto lockedStats = stats_.wlock();
       lockedStats->addRuntimeStat(
           "dataSourceReadWallNanos",
-          RuntimeCounter(
-              (getCurrentTimeMicro() - ioTimeStartMicros) * 1'000,
-              RuntimeCounter::Unit::kNanos));
+          RuntimeCounter(readNanos, RuntimeCounter::Unit::kNanos));
 
       if (!dataOptional.has_value()) {
         blockingReason_ = BlockingReason::kWaitForConnector;
@@ -260,6 +321,10 @@ RowVectorPtr TableScan::getOutput() {
               {maxFilteringRatio_,
                1.0 * data->size() / readBatchSize,
                1.0 / kMaxSelectiveBatchSizeMultiplier});
+          if (adaptiveReadBatchSize_) {
+            lastOutput_ = data;
+          }
+          addResultCacheOutput(data);
           return data;
         }
         continue;
@@ -280,6 +345,15 @@ RowVectorPtr TableScan::getOutput() {
         numReadyPreloadedSplits_ = 0;
       }
     }
+    if (adaptiveSplitPreload_) {
+      curStatus_ = "getOutput: updateSplitPreloadDepth";
+      updateSplitPreloadDepth();
+    }
+    splitOpenNanos_ = 0;
+    splitReadNanos_ = 0;
+
+    curStatus_ = "getOutput: finishResultCacheOutput";
+    finishResultCacheOutput();
 
     curStatus_ = "getOutput: task->splitFinished";
     driverCtx_->task->splitFinished(true, currentSplitWeight_);
@@ -287,6 +361,60 @@ RowVectorPtr TableScan::getOutput() {
   }
 }
 
+bool TableScan::lookupResultCache(const connector::ConnectorSplit& split) {
+  resultCacheKey_.reset();
+  resultCacheOutput_.clear();
+  resultCacheOutputBytes_ = 0;
+
+  auto* cache = SplitResultCache::getInstance();
+  if (cache == nullptr || !resultCacheFingerprint_.has_value() ||
+      !dynamicFilters_.empty()) {
+    return false;
+  }
+  auto key = SplitResultCache::makeKey(*resultCacheFingerprint_, split);
+  if (!key.has_value()) {
+    return false;
+  }
+  cachedOutput_ = cache->find(*key, pool());
+  if (cachedOutput_.has_value()) {
+    nextCachedOutput_ = 0;
+    return true;
+  }
+  resultCacheKey_ = std::move(key);
+  return false;
+}
+
+void TableScan::addResultCacheOutput(const RowVectorPtr& data) {
+  if (!resultCacheKey_.has_value()) {
+    return;
+  }
+  // The lazy vectors can not be loaded after the data source moves on.
+  for (const auto& child : data->children()) {
+    child->loadedVector();
+  }
+  resultCacheOutputBytes_ += data->retainedSize();
+  auto* cache = SplitResultCache::getInstance();
+  if (cache == nullptr ||
+      resultCacheOutputBytes_ > cache->maxEntryBytes()) {
+    // The output of the split is too large to cache.
+    resultCacheKey_.reset();
+    resultCacheOutput_.clear();
+    return;
+  }
+  resultCacheOutput_.push_back(data);
+}
+
+void TableScan::finishResultCacheOutput() {
+  if (!resultCacheKey_.has_value()) {
+    return;
+  }
+  if (auto* cache = SplitResultCache::getInstance()) {
+    cache->insert(*resultCacheKey_, resultCacheOutput_);
+  }
+  resultCacheKey_.reset();
+  resultCacheOutput_.clear();
+}
+
 void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
   // The AsyncSource returns a unique_ptr to the shared_ptr of the
   // DataSource. The callback may outlive the Task, hence it captures
@@ -302,8 +430,9 @@ void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
            split->connectorId, planNodeId(), connectorPool_),
        task = operatorCtx_->task(),
        dynamicFilters = dynamicFilters_,
+       cancelled = preloadCancelled_,
        split]() -> std::unique_ptr<connector::DataSource> {
-        if (task->isCancelled()) {
+        if (task->isCancelled() || *cancelled) {
           return nullptr;
         }
         auto debugString =
@@ -327,6 +456,43 @@ void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
       });
 }
 
+void TableScan::updateSplitPreloadDepth() {
+  // Weight of the latest split in the moving averages.
+  constexpr double kLatestSplitWeight = 0.25;
+  // Nothing is preloaded while the query reserves more than this percentage of
+  // its maximum capacity.
+  constexpr int64_t kMaxPreloadMemoryPct = 70;
+
+  if (stats_.rlock()->numSplits == 1) {
+    avgSplitOpenNanos_ = splitOpenNanos_;
+    avgSplitReadNanos_ = splitReadNanos_;
+  } else {
+    avgSplitOpenNanos_ +=
+        kLatestSplitWeight * (splitOpenNanos_ - avgSplitOpenNanos_);
+    avgSplitReadNanos_ +=
+        kLatestSplitWeight * (splitReadNanos_ - avgSplitReadNanos_);
+  }
+
+  // Enough splits are opening in the background to cover the time to open the
+  // next one while reading the current ones.
+  int32_t depth = maxSplitPreloadPerDriver_;
+  if (avgSplitReadNanos_ > 0) {
+    depth = std::max<int32_t>(
+        1,
+        std::min<double>(
+            std::ceil(avgSplitOpenNanos_ / avgSplitReadNanos_),
+            maxSplitPreloadPerDriver_));
+  }
+  const auto* root = connectorPool_->root();
+  if (root->maxCapacity() != memory::kMaxMemory &&
+      root->reservedBytes() >
+          root->maxCapacity() / 100 * kMaxPreloadMemoryPct) {
+    depth = 0;
+  }
+  splitPreloadPerDriver_ = depth;
+  stats_.wlock()->addRuntimeStat("splitPreloadDepth", RuntimeCounter(depth));
+}
+
 void TableScan::checkPreload() {
   auto* executor = connector_->executor();
   if (maxSplitPreloadPerDriver_ == 0 || !executor ||
@@ -335,7 +501,7 @@ void TableScan::checkPreload() {
   }
   if (dataSource_->allPrefetchIssued()) {
     maxPreloadedSplits_ = driverCtx_->task->numDrivers(driverCtx_->driver) *
-        maxSplitPreloadPerDriver_;
+        splitPreloadPerDriver_;
     if (!splitPreloader_) {
       splitPreloader_ =
           [executor,
@@ -355,6 +521,23 @@ bool TableScan::isFinished() {
   return noMoreSplits_;
 }
 
+void TableScan::adaptReadBatchSize() {
+  const auto bytes = lastOutput_->estimateFlatSize();
+  const auto numRows = lastOutput_->size();
+  lastOutput_.reset();
+  if (bytes > 0) {
+    readBatchSize_ = outputBatchRows(bytes / numRows);
+  }
+}
+
+void TableScan::close() {
+  preloadCancelled_->store(true);
+  lastOutput_.reset();
+  cachedOutput_.reset();
+  resultCacheOutput_.clear();
+  Operator::close();
+}
+
 void TableScan::addDynamicFilter(
     const core::PlanNodeId& producer,
     column_index_t outputChannel,
@@ -362,8 +545,43 @@ void TableScan::addDynamicFilter(
   if (dataSource_) {
     dataSource_->addDynamicFilter(outputChannel, filter);
   }
-  dynamicFilters_.emplace(outputChannel, filter);
+  // The output of the current split after the filter is not all of its rows.
+  resultCacheKey_.reset();
+  resultCacheOutput_.clear();
+  // Merges with a previous filter on the same channel, e.g. when a TopN
+  // tightens its threshold, for the data sources created later.
+  auto it = dynamicFilters_.find(outputChannel);
+  if (it == dynamicFilters_.end()) {
+    dynamicFilters_.emplace(outputChannel, filter);
+  } else {
+    it->second = it->second->mergeWith(filter.get());
+  }
+  if (filter->kind() == common::FilterKind::kBloomFilter) {
+    bloomFilterStats_.push_back(
+        static_cast<const common::BloomFilterValues*>(filter.get())->stats());
+  }
   stats_.wlock()->dynamicFilterStats.producerNodeIds.emplace(producer);
 }
 
+void TableScan::updateBloomFilterStats() {
+  if (bloomFilterStats_.empty()) {
+    return;
+  }
+  uint64_t rowsTested{0};
+  uint64_t rowsRejected{0};
+  uint64_t rangesTested{0};
+  uint64_t rangesRejected{0};
+  for (const auto& stats : bloomFilterStats_) {
+    rowsTested += stats->numRowsTested;
+    rowsRejected += stats->numRowsRejected;
+    rangesTested += stats->numRangesTested;
+    rangesRejected += stats->numRangesRejected;
+  }
+  auto lockedStats = stats_.wlock();
+  lockedStats->dynamicFilterStats.bloomFilterRowsTested = rowsTested;
+  lockedStats->dynamicFilterStats.bloomFilterRowsRejected = rowsRejected;
+  lockedStats->dynamicFilterStats.bloomFilterRangesTested = rangesTested;
+  lockedStats->dynamicFilterStats.bloomFilterRangesRejected = rangesRejected;
+}
+
 } // namespace facebook::velox::exec
@@ -41,6 +41,8 @@ class TableScan : public SourceOperator {
 
   bool isFinished() override;
 
+  void close() override;
+
   bool canAddDynamicFilter() const override {
     return connector_->canAddDynamicFilter();
   }
@@ -59,17 +61,40 @@ class TableScan : public SourceOperator {
   // terminated.
   bool shouldStop(StopReason taskStopReason) const;
 
+  // Copies the counters of the Bloom filter dynamic filters into
+  // 'stats_.dynamicFilterStats'.
+  void updateBloomFilterStats();
+
+  // Updates 'splitPreloadPerDriver_' after reading a split that took
+  // 'splitOpenNanos_' to open and 'splitReadNanos_' to read.
+  void updateSplitPreloadDepth();
+
   // Sets 'maxPreloadSplits' and 'splitPreloader' if prefetching splits is
   // appropriate. The preloader will be applied to the 'first 'maxPreloadSplits'
   // of the Task's split queue for 'this' when getting splits.
   void checkPreload();
 
+  // Sets 'readBatchSize_' from the width of the rows of 'lastOutput_' and
+  // clears 'lastOutput_'.
+  void adaptReadBatchSize();
+
   // Sets 'split->dataSource' to be an AsyncSource that makes a DataSource to
   // read 'split'. This source will be prepared in the background on the
   // executor of the connector. If the DataSource is needed before prepare is
   // done, it will be made when needed.
   void preload(std::shared_ptr<connector::ConnectorSplit> split);
 
+  // Returns true and sets 'cachedOutput_' if the output of 'split' is in the
+  // SplitResultCache. Otherwise sets 'resultCacheKey_' if the output of
+  // 'split' can be added to the cache.
+  bool lookupResultCache(const connector::ConnectorSplit& split);
+
+  // Adds 'data' to the output of the current split to add to the cache.
+  void addResultCacheOutput(const RowVectorPtr& data);
+
+  // Adds the output of the current split to the cache when the split is done.
+  void finishResultCacheOutput();
+
   const std::shared_ptr<connector::ConnectorTableHandle> tableHandle_;
   const std::
       unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
@@ -87,11 +112,37 @@ class TableScan : public SourceOperator {
   // Dynamic filters to add to the data source when it gets created.
   std::unordered_map<column_index_t, std::shared_ptr<common::Filter>>
       dynamicFilters_;
+  // Counters shared with the copies of the Bloom filter dynamic filters used
+  // by 'dataSource_'.
+  std::vector<std::shared_ptr<common::BloomFilterValues::Stats>>
+      bloomFilterStats_;
 
   int32_t maxPreloadedSplits_{0};
 
   const int32_t maxSplitPreloadPerDriver_{0};
 
+  // True if the number of splits to preload adapts to the open and read times
+  // of the splits and to the memory headroom of the query.
+  const bool adaptiveSplitPreload_;
+
+  // Number of splits to preload per driver. Always
+  // 'maxSplitPreloadPerDriver_' unless 'adaptiveSplitPreload_'.
+  int32_t splitPreloadPerDriver_;
+
+  // Moving averages of the wall time to open a split and to read it.
+  double avgSplitOpenNanos_{0};
+  double avgSplitReadNanos_{0};
+
+  // Wall times of opening and reading the current split. Opening a preloaded
+  // split counts the time of making its DataSource in the background.
+  uint64_t splitOpenNanos_{0};
+  uint64_t splitReadNanos_{0};
+
+  // Set when 'this' closes, e.g. after a downstream Limit is satisfied.
+  // Preloads that have not started by then do not make their DataSource.
+  const std::shared_ptr<std::atomic_bool> preloadCancelled_{
+      std::make_shared<std::atomic_bool>(false)};
+
   // Callback passed to getSplitOrFuture() for triggering async preload. The
   // callback's lifetime is the lifetime of 'this'. This callback can schedule
   // preloads on an executor. These preloads may outlive the Task and therefore
@@ -108,6 +159,15 @@ class TableScan : public SourceOperator {
   int32_t readBatchSize_;
   int32_t maxReadBatchSize_;
 
+  // True if the read batch size follows the width of the rows read, see
+  // QueryConfig::kAdaptiveOutputBatchBytes.
+  const bool adaptiveReadBatchSize_;
+
+  // The last batch returned if 'adaptiveReadBatchSize_'. The consumers have
+  // loaded the lazy columns they need by the next getOutput(), so that its
+  // size is the size of the rows read.
+  RowVectorPtr lastOutput_;
+
   // Exits getOutput() method after this many milliseconds. Zero means 'no
   // limit'.
   size_t getOutputTimeLimitMs_{0};
@@ -117,6 +177,21 @@ class TableScan : public SourceOperator {
   // String shown in ExceptionContext inside DataSource and LazyVector loading.
   std::string debugString_;
 
+  // Fingerprint of the scan for the SplitResultCache. Not set if the cache is
+  // disabled or the scan can not be cached.
+  std::optional<std::string> resultCacheFingerprint_;
+
+  // The output of the current split found in the cache, replayed instead of
+  // reading the split, and the index of the next batch to return.
+  std::optional<std::vector<RowVectorPtr>> cachedOutput_;
+  size_t nextCachedOutput_{0};
+
+  // Key of the current split if its output is to be added to the cache, the
+  // output so far, and its retained size.
+  std::optional<std::string> resultCacheKey_;
+  std::vector<RowVectorPtr> resultCacheOutput_;
+  uint64_t resultCacheOutputBytes_{0};
+
   // Holds the current status of the operator. Used when debugging to understand
   // what operator is doing.
   std::atomic<const char*> curStatus_{""};
@@ -107,6 +107,20 @@ void TableWriter::abortDataSink() {
   }
 }
 
+BlockingReason TableWriter::isBlocked(ContinueFuture* future) {
+  if (finishFuture_.valid()) {
+    *future = std::move(finishFuture_);
+    return BlockingReason::kWaitForConnector;
+  }
+  return BlockingReason::kNotBlocked;
+}
+
+bool TableWriter::finishDataSink() {
+  VELOX_CHECK(!closed_);
+  VELOX_CHECK_NOT_NULL(dataSink_);
+  return dataSink_->finish(finishFuture_);
+}
+
 std::vector<std::string> TableWriter::closeDataSink() {
   // We only expect closeDataSink called once.
   VELOX_CHECK(!closed_);
@@ -165,6 +179,10 @@ RowVectorPtr TableWriter::getOutput() {
         pool());
   }
 
+  if (!finishDataSink()) {
+    return nullptr;
+  }
+
   finished_ = true;
   const std::vector<std::string> fragments = closeDataSink();
   updateStats(dataSink_->stats());
@@ -107,9 +107,7 @@ class TableWriter : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::TableWriteNode>& tableWriteNode);
 
-  BlockingReason isBlocked(ContinueFuture* /* future */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   void initialize() override;
 
@@ -183,6 +181,10 @@ class TableWriter : public Operator {
 
   void createDataSink();
 
+  // Returns true if the data sink is ready to be closed. Otherwise sets
+  // 'finishFuture_' to wait for the data sink to finish its writes.
+  bool finishDataSink();
+
   std::vector<std::string> closeDataSink();
 
   void abortDataSink();
@@ -208,6 +210,10 @@ class TableWriter : public Operator {
 
   bool finished_{false};
   bool closed_{false};
+
+  // Set if the data sink is finishing its writes in the background after all
+  // input has been received.
+  ContinueFuture finishFuture_{ContinueFuture::makeEmpty()};
   vector_size_t numWrittenRows_{0};
 };
 } // namespace facebook::velox::exec
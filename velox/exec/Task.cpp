@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
@@ -332,7 +333,8 @@ Task::Task(
       consumerSupplier_(std::move(consumerSupplier)),
       onError_(onError),
       splitsStates_(buildSplitStates(planFragment_.planNode)),
-      bufferManager_(OutputBufferManager::getInstance()) {
+      bufferManager_(OutputBufferManager::getInstance()),
+      spillSpaceManager_(SpillSpaceManager::getInstance()) {
   // NOTE: the executor must not be folly::InlineLikeExecutor for parallel
   // execution.
   if (mode_ == Task::ExecutionMode::kParallel) {
@@ -434,7 +436,76 @@ const std::string& Task::getOrCreateSpillDirectory() {
   return spillDirectory_;
 }
 
+int32_t Task::numSpillTiers() const {
+  return spillSpaceManager_ == nullptr ? 0 : spillSpaceManager_->numTiers();
+}
+
+std::string_view Task::getOrCreateSpillTierDirectory(int32_t tier) {
+  VELOX_CHECK_LT(tier, numSpillTiers());
+  if (tier == 0) {
+    return getOrCreateSpillDirectory();
+  }
+  std::lock_guard<std::mutex> l(spillDirCreateMutex_);
+  spillTierDirectories_.resize(numSpillTiers() - 1);
+  auto& directory = spillTierDirectories_[tier - 1];
+  if (!directory.empty()) {
+    return directory;
+  }
+  const auto path =
+      fmt::format("{}/{}", spillSpaceManager_->tier(tier).path, taskId_);
+  try {
+    auto fileSystem = filesystems::getFileSystem(path, nullptr);
+    fileSystem->mkdir(path);
+  } catch (const std::exception& e) {
+    VELOX_FAIL(
+        "Failed to create spill directory '{}' on spill tier {} for Task {}: "
+        "{}",
+        path,
+        tier,
+        taskId(),
+        e.what());
+  }
+  directory = path;
+  return directory;
+}
+
+bool Task::reserveSpillSpace(int32_t tier, uint64_t bytes) {
+  VELOX_CHECK_LT(tier, numSpillTiers());
+  if (!spillSpaceManager_->tryReserve(tier, bytes)) {
+    return false;
+  }
+  std::lock_guard<std::mutex> l(spillSpaceMutex_);
+  spillTierReservedBytes_.resize(numSpillTiers());
+  spillTierReservedBytes_[tier] += bytes;
+  return true;
+}
+
 void Task::removeSpillDirectoryIfExists() {
+  {
+    std::lock_guard<std::mutex> l(spillDirCreateMutex_);
+    for (const auto& directory : spillTierDirectories_) {
+      if (directory.empty()) {
+        continue;
+      }
+      try {
+        auto fs = filesystems::getFileSystem(directory, nullptr);
+        fs->rmdir(directory);
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "Failed to remove spill directory '" << directory
+                   << "' for Task " << taskId() << ": " << e.what();
+      }
+    }
+    spillTierDirectories_.clear();
+  }
+  {
+    std::lock_guard<std::mutex> l(spillSpaceMutex_);
+    for (auto tier = 0; tier < spillTierReservedBytes_.size(); ++tier) {
+      if (spillTierReservedBytes_[tier] != 0) {
+        spillSpaceManager_->release(tier, spillTierReservedBytes_[tier]);
+      }
+    }
+    spillTierReservedBytes_.clear();
+  }
   if (spillDirectory_.empty() || !spillDirectoryCreated_) {
     return;
   }
@@ -731,6 +802,7 @@ void Task::start(uint32_t maxDrivers, uint32_t concurrentSplitGroups) {
         return;
       }
       createDriverFactoriesLocked(maxDrivers);
+      createElasticPipelinesLocked();
     }
     initializePartitionOutput();
     createAndStartDrivers(concurrentSplitGroups);
@@ -784,6 +856,31 @@ void Task::createDriverFactoriesLocked(uint32_t maxDrivers) {
   validateGroupedExecutionLeafNodes();
 }
 
+void Task::createElasticPipelinesLocked() {
+  for (auto pipeline = 0; pipeline < driverFactories_.size(); ++pipeline) {
+    const auto& factory = driverFactories_[pipeline];
+    if (factory->numInitialElasticDrivers == 0) {
+      continue;
+    }
+    auto& state = elasticPipelines_[pipeline];
+    state.leafNodeId = factory->leafNodeId();
+    state.minDrivers = factory->minElasticDrivers;
+    state.maxDrivers = factory->numDrivers;
+    state.targetDrivers = factory->numInitialElasticDrivers;
+    state.numRunning = factory->numInitialElasticDrivers;
+    // The drivers above the initial number park when they ask for their
+    // first split.
+    state.parked.resize(factory->numDrivers, false);
+    for (auto i = factory->numInitialElasticDrivers; i < factory->numDrivers;
+         ++i) {
+      state.parked[i] = true;
+    }
+    state.intervalStartMicros = getCurrentTimeMicro();
+  }
+  elasticAdjustIntervalMicros_ =
+      queryCtx_->queryConfig().elasticDriversAdjustIntervalMs() * 1'000;
+}
+
 void Task::createAndStartDrivers(uint32_t concurrentSplitGroups) {
   checkExecutionMode(Task::ExecutionMode::kParallel);
   std::unique_lock<std::timed_mutex> l(mutex_);
@@ -797,6 +894,7 @@ void Task::createAndStartDrivers(uint32_t concurrentSplitGroups) {
   VELOX_CHECK(drivers_.empty());
 
   concurrentSplitGroups_ = concurrentSplitGroups;
+  splitGroupsMemoryLimit_ = queryCtx_->queryConfig().splitGroupsMemoryLimit();
   // Pre-allocates slots for maximum possible number of drivers.
   if (numDriversPerSplitGroup_ > 0) {
     drivers_.resize(numDriversPerSplitGroup_ * concurrentSplitGroups_);
@@ -1078,6 +1176,9 @@ std::vector<std::shared_ptr<Driver>> Task::createDriversLocked(
                 ? self->driverFactories_[i]->numTotalDrivers
                 : 0;
           }));
+      if (drivers.back() != nullptr && drivers.back()->timeline() != nullptr) {
+        driverTimelines_.push_back(drivers.back()->timeline());
+      }
       ++splitGroupState.numRunningDrivers;
     }
   }
@@ -1153,6 +1254,11 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
         } else {
           splitGroupState.clear();
         }
+      } else if (
+          splitGroupId != kUngroupedGroupId &&
+          self->splitGroupsMemoryLimit_ != 0) {
+        // The slot of 'driver' may complete the room for a queued group.
+        self->ensureSplitGroupsAreBeingProcessedLocked();
       }
       foundDriver = true;
       break;
@@ -1182,8 +1288,7 @@ void Task::ensureSplitGroupsAreBeingProcessedLocked() {
     return;
   }
 
-  while (numRunningSplitGroups_ < concurrentSplitGroups_ and
-         not queuedSplitGroups_.empty()) {
+  while (not queuedSplitGroups_.empty() and canStartSplitGroupLocked()) {
     const uint32_t splitGroupId = queuedSplitGroups_.front();
     queuedSplitGroups_.pop();
 
@@ -1209,6 +1314,23 @@ void Task::ensureSplitGroupsAreBeingProcessedLocked() {
   }
 }
 
+bool Task::canStartSplitGroupLocked() const {
+  if (splitGroupsMemoryLimit_ == 0) {
+    return numRunningSplitGroups_ < concurrentSplitGroups_;
+  }
+  // Grouped execution drivers take the slots in the front of 'drivers_'.
+  const auto numGroupedSlots =
+      numDriversPerSplitGroup_ * concurrentSplitGroups_;
+  const auto numFreeSlots = std::count(
+      drivers_.begin(), drivers_.begin() + numGroupedSlots, nullptr);
+  if (numFreeSlots < numDriversPerSplitGroup_) {
+    return false;
+  }
+  // One group runs whatever memory it takes.
+  return numRunningSplitGroups_ == 0 ||
+      pool_->currentBytes() < splitGroupsMemoryLimit_;
+}
+
 void Task::setMaxSplitSequenceId(
     const core::PlanNodeId& planNodeId,
     long maxSequenceId) {
@@ -1408,6 +1530,15 @@ void Task::noMoreSplits(const core::PlanNodeId& planNodeId) {
       }
     }
 
+    // The parked drivers of an elastic pipeline resume to take the remaining
+    // splits and finish.
+    for (auto& [pipelineId, elastic] : elasticPipelines_) {
+      if (elastic.leafNodeId == planNodeId) {
+        elastic.noMoreParking = true;
+        movePromisesOut(elastic.parkedPromises, splitPromises);
+      }
+    }
+
     allFinished = checkNoMoreSplitGroupsLocked();
 
     if (!isRunningLocked()) {
@@ -1547,6 +1678,133 @@ exec::Split Task::getSplitLocked(
   return split;
 }
 
+BlockingReason Task::parkElasticDriver(
+    const DriverCtx& driverCtx,
+    ContinueFuture& future) {
+  std::vector<ContinuePromise> promises;
+  bool park{false};
+  {
+    std::lock_guard<std::timed_mutex> l(mutex_);
+    auto it = elasticPipelines_.find(driverCtx.pipelineId);
+    if (it == elasticPipelines_.end()) {
+      return BlockingReason::kNotBlocked;
+    }
+    auto& pipeline = it->second;
+    auto& stats = taskStats_.pipelineStats[driverCtx.pipelineId];
+    adjustElasticPipelineLocked(driverCtx.pipelineId, pipeline, promises);
+    const bool parked = pipeline.parked[driverCtx.driverId];
+    if (pipeline.noMoreParking || !isRunningLocked()) {
+      park = false;
+    } else if (parked) {
+      park = pipeline.numRunning >= pipeline.targetDrivers;
+      if (!park) {
+        ++stats.numElasticDriversAdded;
+      }
+    } else {
+      park = pipeline.numRunning > pipeline.targetDrivers;
+      if (park) {
+        ++stats.numElasticDriversRetired;
+      }
+    }
+    if (parked != park) {
+      pipeline.parked[driverCtx.driverId] = park;
+      if (park) {
+        --pipeline.numRunning;
+      } else {
+        ++pipeline.numRunning;
+      }
+    }
+    if (park) {
+      auto [promise, parkFuture] = makeVeloxContinuePromiseContract(
+          fmt::format("Task::parkElasticDriver {}", taskId_));
+      future = std::move(parkFuture);
+      pipeline.parkedPromises.push_back(std::move(promise));
+    }
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  return park ? BlockingReason::kWaitForSplit : BlockingReason::kNotBlocked;
+}
+
+void Task::recordBlockingTimeLocked(
+    const DriverCtx& driverCtx,
+    BlockingReason reason,
+    uint64_t blockedMicros,
+    std::vector<ContinuePromise>& promises) {
+  if (elasticPipelines_.empty()) {
+    return;
+  }
+  auto it = elasticPipelines_.find(driverCtx.pipelineId);
+  if (it == elasticPipelines_.end()) {
+    return;
+  }
+  auto& pipeline = it->second;
+  // Parked drivers wait for the Task, not for input.
+  if (pipeline.parked[driverCtx.driverId]) {
+    return;
+  }
+  switch (reason) {
+    case BlockingReason::kWaitForSplit:
+    case BlockingReason::kWaitForProducer:
+    case BlockingReason::kWaitForJoinBuild:
+      pipeline.inputBlockedMicros += blockedMicros;
+      break;
+    case BlockingReason::kWaitForConsumer:
+      pipeline.outputBlockedMicros += blockedMicros;
+      break;
+    default:
+      // Waits for memory or IO are not a reason to run fewer drivers.
+      break;
+  }
+  adjustElasticPipelineLocked(driverCtx.pipelineId, pipeline, promises);
+}
+
+void Task::adjustElasticPipelineLocked(
+    int pipelineId,
+    ElasticPipeline& pipeline,
+    std::vector<ContinuePromise>& promises) {
+  // The running drivers retire while they are blocked more than this fraction
+  // of their time and parked drivers resume while they are blocked less than
+  // the second fraction.
+  constexpr double kRetireBlockedFraction = 0.5;
+  constexpr double kAddBlockedFraction = 0.1;
+  const auto nowMicros = getCurrentTimeMicro();
+  if (pipeline.noMoreParking ||
+      nowMicros < pipeline.intervalStartMicros + elasticAdjustIntervalMicros_) {
+    return;
+  }
+  const double runningMicros = static_cast<double>(
+      (nowMicros - pipeline.intervalStartMicros) *
+      std::max<uint32_t>(1, pipeline.numRunning));
+  const double blockedFraction =
+      (pipeline.inputBlockedMicros + pipeline.outputBlockedMicros) /
+      runningMicros;
+  auto& stats = taskStats_.pipelineStats[pipelineId];
+  stats.elasticInputBlockedMicros += pipeline.inputBlockedMicros;
+  stats.elasticOutputBlockedMicros += pipeline.outputBlockedMicros;
+  pipeline.inputBlockedMicros = 0;
+  pipeline.outputBlockedMicros = 0;
+  pipeline.intervalStartMicros = nowMicros;
+
+  if (blockedFraction > kRetireBlockedFraction &&
+      pipeline.targetDrivers > pipeline.minDrivers) {
+    // The running drivers retire when they ask for their next split.
+    --pipeline.targetDrivers;
+  } else if (
+      blockedFraction < kAddBlockedFraction &&
+      pipeline.targetDrivers < pipeline.maxDrivers) {
+    ++pipeline.targetDrivers;
+  }
+  uint32_t numResumed{0};
+  while (pipeline.numRunning + numResumed < pipeline.targetDrivers &&
+         !pipeline.parkedPromises.empty()) {
+    promises.push_back(std::move(pipeline.parkedPromises.back()));
+    pipeline.parkedPromises.pop_back();
+    ++numResumed;
+  }
+}
+
 void Task::splitFinished(bool fromTableScan, int64_t splitWeight) {
   std::lock_guard<std::timed_mutex> l(mutex_);
   ++taskStats_.numFinishedSplits;
@@ -1966,6 +2224,10 @@ ContinueFuture Task::terminate(TaskState terminalState) {
       splitGroupStates.push_back(std::move(splitGroupState.second));
     }
 
+    for (auto& [pipelineId, elastic] : elasticPipelines_) {
+      movePromisesOut(elastic.parkedPromises, splitPromises);
+    }
+
     // Collect all outstanding split promises from all splits state structures.
     for (auto& pair : splitsStates_) {
       auto& splitState = pair.second;
@@ -2303,6 +2565,15 @@ folly::dynamic Task::toShortJson() const {
   return toShortJsonLocked();
 }
 
+folly::dynamic Task::timelineJson() const {
+  std::vector<std::shared_ptr<DriverTimeline>> timelines;
+  {
+    std::lock_guard<std::timed_mutex> l(mutex_);
+    timelines = driverTimelines_;
+  }
+  return timelinesToChromeTrace(taskId_, timelines);
+}
+
 folly::dynamic Task::toJson() const {
   std::lock_guard<std::timed_mutex> l(mutex_);
   auto obj = toShortJsonLocked();
@@ -20,6 +20,7 @@
 #include "velox/exec/LocalPartition.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/MergeSource.h"
+#include "velox/exec/SpillSpaceManager.h"
 #include "velox/exec/Split.h"
 #include "velox/exec/TaskStats.h"
 #include "velox/exec/TaskStructs.h"
@@ -120,6 +121,11 @@ class Task : public std::enable_shared_from_this<Task> {
 
   folly::dynamic toShortJson() const;
 
+  /// Returns the recent timeline events of the Drivers of this Task, including
+  /// the finished ones, as Chrome trace events. See the driver_timeline_events
+  /// query config. Has no events if the config is zero.
+  folly::dynamic timelineJson() const;
+
   /// Returns universally unique identifier of the task.
   const std::string& uuid() const {
     return uuid_;
@@ -416,6 +422,27 @@ class Task : public std::enable_shared_from_this<Task> {
       int32_t maxPreloadSplits = 0,
       const ConnectorSplitPreloadFunc& preload = nullptr);
 
+  /// Called by the TableScan of a driver before it gets a new split. Returns
+  /// kNotBlocked if the driver may continue, which is always the case unless
+  /// the driver is in an elastic pipeline, see
+  /// DriverFactory::supportsElasticDrivers(). Otherwise parks the driver:
+  /// returns kWaitForSplit and sets 'future', which is realized when the
+  /// pipeline needs more running drivers or gets no more splits.
+  BlockingReason parkElasticDriver(
+      const DriverCtx& driverCtx,
+      ContinueFuture& future);
+
+  /// Records that the driver of 'driverCtx' resumed after being blocked for
+  /// 'reason' for 'blockedMicros'. The blocking time of the running drivers
+  /// of an elastic pipeline decides whether the pipeline gets more or fewer
+  /// running drivers. Adds the promises of the parked drivers to resume to
+  /// 'promises'. The caller realizes them after releasing 'mutex_'.
+  void recordBlockingTimeLocked(
+      const DriverCtx& driverCtx,
+      BlockingReason reason,
+      uint64_t blockedMicros,
+      std::vector<ContinuePromise>& promises);
+
   void splitFinished(bool fromTableScan, int64_t splitWeight);
 
   void multipleSplitsFinished(
@@ -660,6 +687,22 @@ class Task : public std::enable_shared_from_this<Task> {
   /// folder could not be created.
   const std::string& getOrCreateSpillDirectory();
 
+  /// Returns the number of spill tiers of SpillSpaceManager or zero if there
+  /// is no SpillSpaceManager.
+  int32_t numSpillTiers() const;
+
+  /// Returns the spill directory on spill tier 'tier' of SpillSpaceManager.
+  /// Ensures that the directory is created before returning. Tier 0 has the
+  /// spill directory. The directories on the other tiers are named after the
+  /// task id under the path of the tier. Is thread safe.
+  std::string_view getOrCreateSpillTierDirectory(int32_t tier);
+
+  /// Reserves 'bytes' of spill space on spill tier 'tier' of
+  /// SpillSpaceManager. Returns false without reserving if the tier is full.
+  /// The reservations are released when the spill directories are removed.
+  /// Is thread safe.
+  bool reserveSpillSpace(int32_t tier, uint64_t bytes);
+
   /// True if produces output via OutputBufferManager.
   bool hasPartitionedOutput() const {
     return numDriversInPartitionedOutput_ > 0;
@@ -847,6 +890,46 @@ class Task : public std::enable_shared_from_this<Task> {
       const core::PlanNodeId& planNodeId,
       const exec::Split& split);
 
+  /// State of a pipeline whose number of running drivers the Task adjusts at
+  /// runtime. All its drivers are created at start. The ones that should not
+  /// run are parked between splits in parkElasticDriver().
+  struct ElasticPipeline {
+    /// The TableScan that starts the pipeline.
+    core::PlanNodeId leafNodeId;
+    uint32_t minDrivers;
+    uint32_t maxDrivers;
+    /// Number of drivers that should run.
+    uint32_t targetDrivers;
+    /// Number of drivers that are not parked.
+    uint32_t numRunning;
+    /// True for the parked drivers. The subscript is the driver id.
+    std::vector<bool> parked;
+    /// Realized to resume parked drivers.
+    std::vector<ContinuePromise> parkedPromises;
+    /// Set when the TableScan gets no more splits. The parked drivers then
+    /// resume and finish.
+    bool noMoreParking{false};
+    /// Start of the current adjustment interval.
+    uint64_t intervalStartMicros{0};
+    /// Time the running drivers were blocked in the current interval waiting
+    /// for splits or join builds.
+    uint64_t inputBlockedMicros{0};
+    /// Time the running drivers were blocked in the current interval waiting
+    /// for their consumers.
+    uint64_t outputBlockedMicros{0};
+  };
+
+  /// Creates the state of the elastic pipelines after the driver factories.
+  void createElasticPipelinesLocked();
+
+  /// Decides whether 'pipeline' should have more or fewer running drivers at
+  /// the end of an adjustment interval. Adds the promises of the parked
+  /// drivers to resume to 'promises'.
+  void adjustElasticPipelineLocked(
+      int pipelineId,
+      ElasticPipeline& pipeline,
+      std::vector<ContinuePromise>& promises);
+
   /// Retrieve a split or split future from the given split store structure.
   BlockingReason getSplitOrFutureLocked(
       bool forTableScan,
@@ -873,6 +956,10 @@ class Task : public std::enable_shared_from_this<Task> {
   // processed. If yes, creates split group state and Drivers and runs them.
   void ensureSplitGroupsAreBeingProcessedLocked();
 
+  // Returns true if there is capacity to run one more split group. See
+  // 'splitGroupsMemoryLimit_'.
+  bool canStartSplitGroupLocked() const;
+
   void driverClosedLocked();
 
   // Returns true if Task is in kRunning state, but all output drivers finished
@@ -1048,6 +1135,8 @@ class Task : public std::enable_shared_from_this<Task> {
 
   std::vector<std::unique_ptr<DriverFactory>> driverFactories_;
   std::vector<std::shared_ptr<Driver>> drivers_;
+  /// The timelines of all Drivers created so far. Outlive the Drivers.
+  std::vector<std::shared_ptr<DriverTimeline>> driverTimelines_;
   /// The total number of running drivers in all pipelines.
   /// This number changes over time as drivers finish their work and maybe new
   /// get created.
@@ -1079,6 +1168,12 @@ class Task : public std::enable_shared_from_this<Task> {
   bool groupedPartitionedOutput_{false};
   /// The number of splits groups we run concurrently.
   uint32_t concurrentSplitGroups_{1};
+  /// If not zero, split groups start whenever there are free slots for their
+  /// drivers in the first 'numDriversPerSplitGroup_ * concurrentSplitGroups_'
+  /// entries of 'drivers_' and the Task uses less than this many bytes, instead
+  /// of keeping 'concurrentSplitGroups_' groups running. Drivers that finish
+  /// early, e.g. those of a join build, then make room for the next group.
+  uint64_t splitGroupsMemoryLimit_{0};
 
   /// Have we already initialized stats of operators in the drivers for Grouped
   /// Execution?
@@ -1109,6 +1204,13 @@ class Task : public std::enable_shared_from_this<Task> {
   /// manage splits of the plan nodes that expect splits.
   std::unordered_map<core::PlanNodeId, SplitsState> splitsStates_;
 
+  /// Pipelines whose number of running drivers is adjusted at runtime, keyed
+  /// on pipeline id. Created at start in parallel execution mode.
+  std::unordered_map<int, ElasticPipeline> elasticPipelines_;
+
+  /// Interval of the adjustments of 'elasticPipelines_'.
+  uint64_t elasticAdjustIntervalMicros_{0};
+
   // Promises that are fulfilled when the task is completed (terminated).
   std::vector<ContinuePromise> taskCompletionPromises_;
 
@@ -1157,6 +1259,18 @@ class Task : public std::enable_shared_from_this<Task> {
   // Indicates whether the spill directory has been created.
   std::atomic<bool> spillDirectoryCreated_{false};
 
+  // The spill space manager at the task creation if any.
+  SpillSpaceManager* const spillSpaceManager_;
+
+  // The spill directories on the spill tiers after the first one, indexed by
+  // tier - 1. Empty for the tiers not spilled to yet. Guarded by
+  // 'spillDirCreateMutex_'.
+  std::vector<std::string> spillTierDirectories_;
+
+  // The bytes reserved by this on each spill tier of 'spillSpaceManager_'.
+  std::mutex spillSpaceMutex_;
+  std::vector<uint64_t> spillTierReservedBytes_;
+
   // Stores unconsumed preloading splits to ensure they are closed promptly.
   folly::F14FastSet<std::shared_ptr<connector::ConnectorSplit>>
       preloadingSplits_;
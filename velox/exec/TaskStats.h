@@ -43,6 +43,21 @@ struct PipelineStats {
   /// True if contains the sync node for the task.
   bool outputPipeline;
 
+  /// Number of times a parked driver of an elastic pipeline resumed to take
+  /// more splits. See QueryConfig::kElasticDriversEnabled.
+  int32_t numElasticDriversAdded{0};
+
+  /// Number of times a running driver of an elastic pipeline was parked.
+  int32_t numElasticDriversRetired{0};
+
+  /// Time the running drivers of an elastic pipeline were blocked waiting for
+  /// input, i.e. splits or join builds.
+  uint64_t elasticInputBlockedMicros{0};
+
+  /// Time the running drivers of an elastic pipeline were blocked waiting for
+  /// their consumers.
+  uint64_t elasticOutputBlockedMicros{0};
+
   PipelineStats(bool _inputPipeline, bool _outputPipeline)
       : inputPipeline{_inputPipeline}, outputPipeline{_outputPipeline} {}
 };
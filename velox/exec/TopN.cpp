@@ -31,6 +31,7 @@ TopN::TopN(
           topNNode->id(),
           "TopN"),
       count_(topNNode->count()),
+      firstKeyOrder_(topNNode->sortingOrders()[0]),
       data_(std::make_unique<RowContainer>(outputType_->children(), pool())),
       comparator_(
           outputType_,
@@ -57,6 +58,99 @@ TopN::TopN(
   }
 }
 
+void TopN::initialize() {
+  Operator::initialize();
+  auto* driverCtx = operatorCtx_->driverCtx();
+  if (!driverCtx->queryConfig().topNDynamicFilterEnabled()) {
+    return;
+  }
+  const auto channel = sortingKeyColumns_[0];
+  switch (outputType_->childAt(channel)->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      break;
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      // NaN sorts after all other values but does not pass a range filter.
+      if (!firstKeyOrder_.isAscending()) {
+        return;
+      }
+      break;
+    default:
+      return;
+  }
+  pushdownThreshold_ =
+      !driverCtx->driver->canPushdownFilters(this, {channel}).empty();
+}
+
+std::shared_ptr<common::Filter> TopN::makeThresholdFilter(
+    const char* row,
+    int64_t& threshold) const {
+  const auto channel = sortingKeyColumns_[0];
+  const auto& column = data_->columnAt(channel);
+  if (RowContainer::isNullAt(row, column.nullByte(), column.nullMask())) {
+    return nullptr;
+  }
+  const bool ascending = firstKeyOrder_.isAscending();
+  const bool nullAllowed = firstKeyOrder_.isNullsFirst();
+  const auto kind = outputType_->childAt(channel)->kind();
+  if (kind == TypeKind::REAL || kind == TypeKind::DOUBLE) {
+    const double value = kind == TypeKind::REAL
+        ? RowContainer::valueAt<float>(row, column.offset())
+        : RowContainer::valueAt<double>(row, column.offset());
+    if (std::isnan(value)) {
+      return nullptr;
+    }
+    std::memcpy(&threshold, &value, sizeof(threshold));
+    if (kind == TypeKind::REAL) {
+      return std::make_shared<common::FloatRange>(
+          0, true, false, static_cast<float>(value), false, false, nullAllowed);
+    }
+    return std::make_shared<common::DoubleRange>(
+        0, true, false, value, false, false, nullAllowed);
+  }
+
+  switch (kind) {
+    case TypeKind::TINYINT:
+      threshold = RowContainer::valueAt<int8_t>(row, column.offset());
+      break;
+    case TypeKind::SMALLINT:
+      threshold = RowContainer::valueAt<int16_t>(row, column.offset());
+      break;
+    case TypeKind::INTEGER:
+      threshold = RowContainer::valueAt<int32_t>(row, column.offset());
+      break;
+    case TypeKind::BIGINT:
+      threshold = RowContainer::valueAt<int64_t>(row, column.offset());
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+  if (ascending) {
+    return std::make_shared<common::BigintRange>(
+        std::numeric_limits<int64_t>::min(), threshold, nullAllowed);
+  }
+  return std::make_shared<common::BigintRange>(
+      threshold, std::numeric_limits<int64_t>::max(), nullAllowed);
+}
+
+void TopN::maybePushdownThreshold() {
+  if (!pushdownThreshold_ || topRows_.size() < count_) {
+    return;
+  }
+  int64_t threshold;
+  auto filter = makeThresholdFilter(topRows_.top(), threshold);
+  if (filter == nullptr || lastThreshold_ == threshold) {
+    return;
+  }
+  lastThreshold_ = threshold;
+  // Rows equal to the threshold on the first key are kept as they may sort
+  // before the last row on the following keys.
+  dynamicFilters_[sortingKeyColumns_[0]] = std::move(filter);
+}
+
 void TopN::addInput(RowVectorPtr input) {
   for (const auto col : sortingKeyColumns_) {
     decodedVectors_[col].decode(*input->childAt(col));
@@ -104,6 +198,8 @@ void TopN::addInput(RowVectorPtr input) {
       }
     }
   }
+
+  maybePushdownThreshold();
 }
 
 RowVectorPtr TopN::getOutput() {
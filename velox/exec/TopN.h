@@ -27,6 +27,8 @@ class TopN : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::TopNNode>& topNNode);
 
+  void initialize() override;
+
   bool needsInput() const override {
     return !noMoreInput_;
   }
@@ -44,7 +46,26 @@ class TopN : public Operator {
   bool isFinished() override;
 
  private:
+  // Sets 'dynamicFilters_' to a range filter on the first sorting key passing
+  // the values that can still make it into the top rows if 'topRows_' is full
+  // and its last row changed since the last pushdown.
+  void maybePushdownThreshold();
+
+  // Returns a range filter passing the values of the first sorting key that
+  // sort before or equal to the key of 'row', or nullptr if the key is null.
+  // Sets 'threshold' to the bits of the key.
+  std::shared_ptr<common::Filter> makeThresholdFilter(
+      const char* row,
+      int64_t& threshold) const;
+
   const int32_t count_;
+  const core::SortOrder firstKeyOrder_;
+
+  // True if the threshold on the first sorting key is pushed down as a
+  // dynamic filter. Set in initialize().
+  bool pushdownThreshold_{false};
+  // Bits of the first sorting key of the last pushed down threshold.
+  std::optional<int64_t> lastThreshold_;
 
   bool finished_ = false;
   uint32_t numRowsReturned_ = 0;
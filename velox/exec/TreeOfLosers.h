@@ -52,6 +52,15 @@ class MergeStream {
   virtual int32_t compare(const MergeStream& /*other*/) const {
     VELOX_UNSUPPORTED();
   }
+
+  /// Returns a normalized prefix of the first element of 'this'. If the
+  /// normalized key of 'this' is less than the one of 'other', then 'this' is
+  /// less than 'other'. Equal normalized keys say nothing about the order of
+  /// the elements. hasData() must be true. Required only for a TreeOfLosers
+  /// constructed with 'normalizedKeys' set.
+  virtual uint64_t normalizedKey() const {
+    VELOX_UNSUPPORTED();
+  }
 };
 
 /// Implements a tree of losers algorithm for merging ordered streams. The
@@ -59,13 +68,22 @@ class MergeStream {
 /// it returns the Stream that has the lowest value as first value from the set
 /// of Streams. It returns nullptr when all Streams are at end. The order is
 /// determined by Stream::operator<.
+///
+/// If 'normalizedKeys' is set, the tree keeps the Stream::normalizedKey() of
+/// the first element of each stream and compares these inline. Only equal keys
+/// fall back to Stream::operator< or Stream::compare. This replaces the
+/// comparisons at each level of the tree with one normalizedKey() call per
+/// element when the comparisons of the streams are expensive, e.g. virtual
+/// comparisons of vectors.
 template <typename Stream, typename TIndex = uint16_t>
 class TreeOfLosers {
  public:
   using IndexAndFlag = std::pair<TIndex, bool>;
 
-  explicit TreeOfLosers(std::vector<std::unique_ptr<Stream>> streams)
-      : streams_(std::move(streams)) {
+  explicit TreeOfLosers(
+      std::vector<std::unique_ptr<Stream>> streams,
+      bool normalizedKeys = false)
+      : streams_(std::move(streams)), normalizedKeys_(normalizedKeys) {
     static_assert(std::is_base_of_v<MergeStream, Stream>);
     VELOX_CHECK_LT(streams_.size(), std::numeric_limits<TIndex>::max());
     VELOX_CHECK_GE(streams_.size(), 1);
@@ -98,6 +116,9 @@ class TreeOfLosers {
     }
     values_.resize(firstStream_, kEmpty);
     equals_.resize(firstStream_, false);
+    if (normalizedKeys_) {
+      keys_.resize(streams_.size());
+    }
   }
 
   /// Returns the number of streams.
@@ -118,7 +139,7 @@ class TreeOfLosers {
     } else {
       lastIndex_ = propagate(
           parent(firstStream_ + lastIndex_),
-          streams_[lastIndex_]->hasData() ? lastIndex_ : kEmpty);
+          hasData(lastIndex_) ? lastIndex_ : kEmpty);
     }
     return lastIndex_ == kEmpty ? nullptr : streams_[lastIndex_].get();
   }
@@ -142,7 +163,7 @@ class TreeOfLosers {
     } else {
       result = propagateWithEquals(
           parent(firstStream_ + lastIndex_),
-          streams_[lastIndex_]->hasData() ? lastIndex_ : kEmpty);
+          hasData(lastIndex_) ? lastIndex_ : kEmpty);
     }
     lastIndex_ = result.first;
 
@@ -158,10 +179,35 @@ class TreeOfLosers {
     return std::pair<TIndex, bool>{index, flag};
   }
 
+  // Returns true if the stream at 'index' has data and loads the normalized
+  // key of its first element if 'normalizedKeys_' is set.
+  FOLLY_ALWAYS_INLINE bool hasData(TIndex index) {
+    if (!streams_[index]->hasData()) {
+      return false;
+    }
+    if (normalizedKeys_) {
+      keys_[index] = streams_[index]->normalizedKey();
+    }
+    return true;
+  }
+
+  FOLLY_ALWAYS_INLINE bool less(TIndex left, TIndex right) const {
+    if (normalizedKeys_ && keys_[left] != keys_[right]) {
+      return keys_[left] < keys_[right];
+    }
+    return *streams_[left] < *streams_[right];
+  }
+
+  FOLLY_ALWAYS_INLINE int32_t compare(TIndex left, TIndex right) const {
+    if (normalizedKeys_ && keys_[left] != keys_[right]) {
+      return keys_[left] < keys_[right] ? -1 : 1;
+    }
+    return streams_[left]->compare(*streams_[right]);
+  }
+
   TIndex first(TIndex node) {
     if (node >= firstStream_) {
-      return streams_[node - firstStream_]->hasData() ? node - firstStream_
-                                                      : kEmpty;
+      return hasData(node - firstStream_) ? node - firstStream_ : kEmpty;
     }
     auto left = first(leftChild(node));
     auto right = first(rightChild(node));
@@ -169,7 +215,7 @@ class TreeOfLosers {
       return right;
     } else if (right == kEmpty) {
       return left;
-    } else if (*streams_[left] < *streams_[right]) {
+    } else if (less(left, right)) {
       values_[node] = right;
       return left;
     } else {
@@ -191,7 +237,7 @@ class TreeOfLosers {
       } else if (UNLIKELY(value == kEmpty)) {
         value = values_[node];
         values_[node] = kEmpty;
-      } else if (*streams_[values_[node]] < *streams_[value]) {
+      } else if (less(values_[node], value)) {
         // The node had the lower value, the value stays here and the previous
         // value goes up.
         std::swap(value, values_[node]);
@@ -211,9 +257,7 @@ class TreeOfLosers {
     if (node >= firstStream_) {
       VELOX_DCHECK_LT(node - firstStream_, streams_.size());
       return indexAndFlag(
-          streams_[node - firstStream_]->hasData() ? node - firstStream_
-                                                   : kEmpty,
-          false);
+          hasData(node - firstStream_) ? node - firstStream_ : kEmpty, false);
     }
     auto left = firstWithEquals(leftChild(node));
     auto right = firstWithEquals(rightChild(node));
@@ -222,7 +266,7 @@ class TreeOfLosers {
     } else if (right.first == kEmpty) {
       return left;
     } else {
-      auto comparison = streams_[left.first]->compare(*streams_[right.first]);
+      auto comparison = compare(left.first, right.first);
       if (comparison == 0) {
         values_[node] = right.first;
         equals_[node] = right.second;
@@ -256,8 +300,7 @@ class TreeOfLosers {
         values_[node] = kEmpty;
         equals_[node] = false;
       } else {
-        auto comparison =
-            streams_[values_[node]]->compare(*streams_[value.first]);
+        auto comparison = compare(values_[node], value.first);
         if (comparison == 0) {
           // the value goes up with equals set.
           value.second = true;
@@ -294,7 +337,11 @@ class TreeOfLosers {
   }
 
   const std::vector<std::unique_ptr<Stream>> streams_;
+  const bool normalizedKeys_;
 
+  // The normalized keys of the first elements of 'streams_' if
+  // 'normalizedKeys_' is set.
+  std::vector<uint64_t> keys_;
   std::vector<TIndex> values_;
   // 'true' if the corresponding element of 'values_' has met an equal
   // element on its way to its present position. Used only in nextWithEquals().
@@ -114,32 +114,46 @@ RowVectorPtr Unnest::getOutput() {
   }
 
   const auto size = input_->size();
-  const auto maxOutputSize = outputBatchRows();
+  const vector_size_t maxOutputSize = outputBatchRows();
 
   // Limit the number of input rows to keep output batch size within
-  // 'maxOutputSize' if possible. Process each input row fully. Do not break
-  // single row's output into multiple batches.
-  vector_size_t numInput = 0;
-  vector_size_t numElements = 0;
+  // 'maxOutputSize'. The elements of a row that does not fit are split
+  // across batches.
+  RowRange range{nextInputRow_, 0, nextInputRowStart_, std::nullopt, 0};
   for (auto row = nextInputRow_; row < size; ++row) {
-    numElements += rawMaxSizes_[row];
-    ++numInput;
+    const auto rowStart = row == nextInputRow_ ? nextInputRowStart_ : 0;
+    const auto numRowElements = rawMaxSizes_[row] - rowStart;
+    ++range.size;
 
-    if (numElements >= maxOutputSize) {
+    if (range.numElements + numRowElements > maxOutputSize) {
+      range.lastRowEnd = rowStart + maxOutputSize - range.numElements;
+      range.numElements = maxOutputSize;
+      break;
+    }
+
+    range.numElements += numRowElements;
+    if (range.numElements == maxOutputSize) {
       break;
     }
   }
 
-  if (numElements == 0) {
+  if (range.numElements == 0) {
     // All arrays/maps are null or empty.
     input_ = nullptr;
     nextInputRow_ = 0;
+    nextInputRowStart_ = 0;
     return nullptr;
   }
 
-  auto output = generateOutput(nextInputRow_, numInput, numElements);
+  auto output = generateOutput(range);
 
-  nextInputRow_ += numInput;
+  if (range.lastRowEnd.has_value()) {
+    nextInputRow_ += range.size - 1;
+    nextInputRowStart_ = range.lastRowEnd.value();
+  } else {
+    nextInputRow_ += range.size;
+    nextInputRowStart_ = 0;
+  }
 
   if (nextInputRow_ >= size) {
     input_ = nullptr;
@@ -150,37 +164,37 @@ RowVectorPtr Unnest::getOutput() {
 }
 
 void Unnest::generateRepeatedColumns(
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements,
+    const RowRange& range,
     std::vector<VectorPtr>& outputs) {
+  if (identityProjections_.empty()) {
+    return;
+  }
+
   // Create "indices" buffer to repeat rows as many times as there are elements
   // in the array (or map) in unnestDecoded.
-  auto repeatedIndices = allocateIndices(numElements, pool());
+  auto repeatedIndices = allocateIndices(range.numElements, pool());
   auto* rawRepeatedIndices = repeatedIndices->asMutable<vector_size_t>();
-  vector_size_t index = 0;
-  for (auto row = start; row < start + size; ++row) {
-    for (auto i = 0; i < rawMaxSizes_[row]; i++) {
-      rawRepeatedIndices[index++] = row;
-    }
-  }
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto start, auto end) {
+    std::fill(rawRepeatedIndices, rawRepeatedIndices + end - start, row);
+    rawRepeatedIndices += end - start;
+  });
 
   // Wrap "replicated" columns in a dictionary using 'repeatedIndices'.
   for (const auto& projection : identityProjections_) {
     outputs.at(projection.outputChannel) = wrapChild(
-        numElements, repeatedIndices, input_->childAt(projection.inputChannel));
+        range.numElements,
+        repeatedIndices,
+        input_->childAt(projection.inputChannel));
   }
 }
 
 const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
     column_index_t channel,
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements) {
-  BufferPtr elementIndices = allocateIndices(numElements, pool());
+    const RowRange& range) {
+  BufferPtr elementIndices = allocateIndices(range.numElements, pool());
   auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
 
-  auto nulls = allocateNulls(numElements, pool());
+  auto nulls = allocateNulls(range.numElements, pool());
   auto rawNulls = nulls->asMutable<uint64_t>();
 
   auto& currentDecoded = unnestDecoded_[channel];
@@ -191,67 +205,60 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
   // Make dictionary index for elements column since they may be out of order.
   vector_size_t index = 0;
   bool identityMapping = true;
-  for (auto row = start; row < start + size; ++row) {
-    auto maxSize = rawMaxSizes_[row];
-
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto start, auto end) {
     if (!currentDecoded.isNullAt(row)) {
       auto offset = currentOffsets[currentIndices[row]];
       auto unnestSize = currentSizes[currentIndices[row]];
 
-      if (index != offset || unnestSize < maxSize) {
+      if (index != offset + start || unnestSize < end) {
         identityMapping = false;
       }
 
-      for (auto i = 0; i < unnestSize; i++) {
+      const auto elementsEnd = std::min(unnestSize, end);
+      for (auto i = start; i < elementsEnd; i++) {
         rawElementIndices[index++] = offset + i;
       }
 
-      for (auto i = unnestSize; i < maxSize; ++i) {
+      for (auto i = std::max(start, elementsEnd); i < end; ++i) {
         bits::setNull(rawNulls, index++, true);
       }
-    } else if (maxSize > 0) {
+    } else if (end > start) {
       identityMapping = false;
 
-      for (auto i = 0; i < maxSize; ++i) {
+      for (auto i = start; i < end; ++i) {
         bits::setNull(rawNulls, index++, true);
       }
     }
-  }
+  });
   return {elementIndices, nulls, identityMapping};
 }
 
-VectorPtr Unnest::generateOrdinalityVector(
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements) {
-  auto ordinalityVector =
-      BaseVector::create<FlatVector<int64_t>>(BIGINT(), numElements, pool());
+VectorPtr Unnest::generateOrdinalityVector(const RowRange& range) {
+  auto ordinalityVector = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), range.numElements, pool());
 
   // Set the ordinality at each result row to be the index of the element in
   // the original array (or map) plus one.
   auto rawOrdinality = ordinalityVector->mutableRawValues();
-  for (auto row = start; row < start + size; ++row) {
-    auto maxSize = rawMaxSizes_[row];
-    std::iota(rawOrdinality, rawOrdinality + maxSize, 1);
-    rawOrdinality += maxSize;
-  }
+  range.forEachRow(rawMaxSizes_, [&](auto /*row*/, auto start, auto end) {
+    std::iota(rawOrdinality, rawOrdinality + end - start, start + 1);
+    rawOrdinality += end - start;
+  });
 
   return ordinalityVector;
 }
 
-RowVectorPtr Unnest::generateOutput(
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements) {
+RowVectorPtr Unnest::generateOutput(const RowRange& range) {
+  const auto numElements = range.numElements;
   std::vector<VectorPtr> outputs(outputType_->size());
-  generateRepeatedColumns(start, size, numElements, outputs);
+  generateRepeatedColumns(range, outputs);
 
   // Create unnest columns.
   vector_size_t outputsIndex = identityProjections_.size();
   for (auto channel = 0; channel < unnestChannels_.size(); ++channel) {
     auto& currentDecoded = unnestDecoded_[channel];
     auto unnestChannelEncoding =
-        generateEncodingForChannel(channel, start, size, numElements);
+        generateEncodingForChannel(channel, range);
 
     if (currentDecoded.base()->typeKind() == TypeKind::ARRAY) {
       // Construct unnest column using Array elements wrapped using above
@@ -287,7 +294,7 @@ RowVectorPtr Unnest::generateOutput(
 
   if (withOrdinality_) {
     // Ordinality column is always at the end.
-    outputs.back() = generateOrdinalityVector(start, size, numElements);
+    outputs.back() = generateOrdinalityVector(range);
   }
 
   return std::make_shared<RowVector>(
@@ -39,22 +39,46 @@ class Unnest : public Operator {
   bool isFinished() override;
 
  private:
-  // Generate output for 'size' input rows starting from 'start' input row.
-  //
-  // @param start First input row to include in the output.
-  // @param size Number of input rows to include in the output.
-  // @param outputSize Pre-computed number of output rows.
-  RowVectorPtr generateOutput(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t outputSize);
+  // Range of input rows and their elements to include in one output batch.
+  // The elements of a row with more elements than fit in a batch are split
+  // across batches, so the first row may start after its first element and
+  // the last row may end before its last element.
+  struct RowRange {
+    // First input row to include in the output.
+    vector_size_t start;
+    // Number of input rows to include in the output.
+    vector_size_t size;
+    // The first element of the first row to include in the output.
+    vector_size_t firstRowStart;
+    // The end of the elements of the last row to include in the output if
+    // not all of them are included.
+    std::optional<vector_size_t> lastRowEnd;
+    // Pre-computed number of output rows.
+    vector_size_t numElements;
+
+    // Invokes 'func(row, start, end)' for each row with the range of its
+    // elements [start, end) to include in the output. 'rawMaxSizes' has the
+    // number of elements of each row.
+    template <typename Func>
+    void forEachRow(const vector_size_t* rawMaxSizes, Func func) const {
+      const auto end = this->start + size;
+      for (auto row = this->start; row < end; ++row) {
+        const auto rowStart = row == this->start ? firstRowStart : 0;
+        const auto rowEnd = row == end - 1 && lastRowEnd.has_value()
+            ? lastRowEnd.value()
+            : rawMaxSizes[row];
+        func(row, rowStart, rowEnd);
+      }
+    }
+  };
+
+  // Generate output for the input rows in 'range'.
+  RowVectorPtr generateOutput(const RowRange& range);
 
   // Invoked by generateOutput function above to generate the repeated output
   // columns.
   void generateRepeatedColumns(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t numElements,
+      const RowRange& range,
       std::vector<VectorPtr>& outputs);
 
   struct UnnestChannelEncoding {
@@ -67,15 +91,10 @@ class Unnest : public Operator {
   // Array or Map.
   const UnnestChannelEncoding generateEncodingForChannel(
       column_index_t channel,
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t numElements);
+      const RowRange& range);
 
   // Invoked by generateOutput for the ordinality column.
-  VectorPtr generateOrdinalityVector(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t numElements);
+  VectorPtr generateOrdinalityVector(const RowRange& range);
 
   const bool withOrdinality_;
   std::vector<column_index_t> unnestChannels_;
@@ -92,5 +111,9 @@ class Unnest : public Operator {
 
   // Next 'input_' row to process in getOutput().
   vector_size_t nextInputRow_{0};
+
+  // First element of 'nextInputRow_' to process in getOutput(). Non-zero if
+  // the previous output ended in the middle of the row.
+  vector_size_t nextInputRowStart_{0};
 };
 } // namespace facebook::velox::exec
@@ -62,6 +62,50 @@ uint64_t hashOne(DecodedVector& decoded, vector_size_t index) {
   using T = typename KindToFlatVector<Kind>::HashRowType;
   return folly::hasher<T>()(decoded.valueAt<T>(index));
 }
+
+// Same as bits::hashMix() for a batch of hashes.
+xsimd::batch<uint64_t> hashMix(
+    xsimd::batch<uint64_t> upper,
+    xsimd::batch<uint64_t> lower) {
+  constexpr uint64_t kMul = 0x9ddfea08eb382d69ULL;
+  auto a = (lower ^ upper) * kMul;
+  a ^= (a >> 47);
+  auto b = (upper ^ a) * kMul;
+  b ^= (b >> 47);
+  return b * kMul;
+}
+
+// Hashes the non-null 'values' in [begin, end) into 'result'. The hashes of
+// fixed width values are computed in a loop the compiler can vectorize and
+// are mixed with the hashes of the previous keys a SIMD batch at a time.
+template <typename T>
+void hashFlat(
+    const T* values,
+    vector_size_t begin,
+    vector_size_t end,
+    bool mix,
+    uint64_t* result) {
+  if (!mix) {
+    for (auto row = begin; row < end; ++row) {
+      result[row] = folly::hasher<T>()(values[row]);
+    }
+    return;
+  }
+  using Batch = xsimd::batch<uint64_t>;
+  constexpr int32_t kWidth = Batch::size;
+  auto row = begin;
+  for (; row + kWidth <= end; row += kWidth) {
+    uint64_t hashes[kWidth];
+    for (auto i = 0; i < kWidth; ++i) {
+      hashes[i] = folly::hasher<T>()(values[row + i]);
+    }
+    hashMix(Batch::load_unaligned(result + row), Batch::load_unaligned(hashes))
+        .store_unaligned(result + row);
+  }
+  for (; row < end; ++row) {
+    result[row] = bits::hashMix(result[row], folly::hasher<T>()(values[row]));
+  }
+}
 } // namespace
 
 template <TypeKind Kind>
@@ -70,6 +114,17 @@ void VectorHasher::hashValues(
     bool mix,
     uint64_t* result) {
   using T = typename TypeTraits<Kind>::NativeType;
+  if constexpr (
+      TypeTraits<Kind>::isPrimitiveType && Kind != TypeKind::BOOLEAN &&
+      Kind != TypeKind::UNKNOWN) {
+    if (decoded_.isIdentityMapping() && !decoded_.mayHaveNulls() &&
+        rows.isAllSelected()) {
+      using HashType = typename KindToFlatVector<Kind>::HashRowType;
+      hashFlat<HashType>(
+          decoded_.data<HashType>(), rows.begin(), rows.end(), mix, result);
+      return;
+    }
+  }
   if (decoded_.isConstantMapping()) {
     auto hash = decoded_.isNullAt(rows.begin())
         ? kNullHash
@@ -658,6 +713,18 @@ std::unique_ptr<common::Filter> VectorHasher::getFilter(
   }
 }
 
+bool VectorHasher::hasFilter() const {
+  switch (typeKind_) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return !distinctOverflow_;
+    default:
+      return false;
+  }
+}
+
 namespace {
 template <typename T>
 // Adds 'reserve' to either end of the range between 'min' and 'max' while
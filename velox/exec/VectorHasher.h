@@ -244,6 +244,9 @@ class VectorHasher {
   // Returns null if distinctOverflow_ is true.
   std::unique_ptr<common::Filter> getFilter(bool nullAllowed) const;
 
+  // Returns true if getFilter() returns a filter.
+  bool hasFilter() const;
+
   void resetStats() {
     uniqueValues_.clear();
     uniqueValuesStorage_.clear();
@@ -15,12 +15,34 @@
  */
 #include "velox/exec/Window.h"
 #include "velox/exec/OperatorUtils.h"
+#include "velox/exec/RowsStreamingWindowBuild.h"
 #include "velox/exec/SortWindowBuild.h"
 #include "velox/exec/StreamingWindowBuild.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
 
+namespace {
+// Returns true if all the window functions compute each row from the rows
+// before it, so that they can be evaluated over partial partitions. Frames
+// with k PRECEDING or FOLLOWING bounds need the rows around the current row
+// and are not supported.
+bool supportsRowsStreaming(const core::WindowNode& windowNode) {
+  for (const auto& function : windowNode.windowFunctions()) {
+    const auto metadata =
+        getWindowFunctionMetadata(function.functionCall->name());
+    if (!metadata.has_value() ||
+        metadata->processMode != WindowFunction::ProcessMode::kRows) {
+      return false;
+    }
+    if (function.frame.startValue || function.frame.endValue) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 Window::Window(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -40,7 +62,10 @@ Window::Window(
       stringAllocator_(pool()) {
   auto* spillConfig =
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
-  if (windowNode->inputsSorted()) {
+  if (windowNode->inputsSorted() && supportsRowsStreaming(*windowNode)) {
+    windowBuild_ = std::make_unique<RowsStreamingWindowBuild>(
+        windowNode, pool(), spillConfig, &nonReclaimableSection_);
+  } else if (windowNode->inputsSorted()) {
     windowBuild_ = std::make_unique<StreamingWindowBuild>(
         windowNode, pool(), spillConfig, &nonReclaimableSection_);
   } else {
@@ -562,6 +587,9 @@ void Window::callApplyForPartitionRows(
   vector_size_t numRows = endRow - startRow;
   numProcessedRows_ += numRows;
   partitionOffset_ += numRows;
+  if (currentPartition_->partial()) {
+    currentPartition_->removeProcessedRows(numRows);
+  }
 }
 
 vector_size_t Window::callApplyLoop(
@@ -580,13 +608,21 @@ vector_size_t Window::callApplyLoop(
     if (rowsForCurrentPartition <= numOutputRowsLeft) {
       // Current partition can fit completely in the output buffer.
       // So output all its rows.
-      callApplyForPartitionRows(
-          partitionOffset_,
-          partitionOffset_ + rowsForCurrentPartition,
-          resultIndex,
-          result);
-      resultIndex += rowsForCurrentPartition;
-      numOutputRowsLeft -= rowsForCurrentPartition;
+      if (rowsForCurrentPartition > 0) {
+        callApplyForPartitionRows(
+            partitionOffset_,
+            partitionOffset_ + rowsForCurrentPartition,
+            resultIndex,
+            result);
+        resultIndex += rowsForCurrentPartition;
+        numOutputRowsLeft -= rowsForCurrentPartition;
+      }
+      if (!currentPartition_->complete()) {
+        // The rest of the partial partition is not in the input yet. Keep
+        // the partition and the function states until the next getOutput
+        // call.
+        break;
+      }
       callResetPartition();
       if (!currentPartition_) {
         // The WindowBuild doesn't have any more partitions to process right
@@ -164,8 +164,8 @@ class Window : public Operator {
   std::shared_ptr<const core::WindowNode> windowNode_;
 
   // Used to access window partition rows and columns by the window
-  // operator and functions. This structure is owned by the WindowBuild.
-  std::unique_ptr<WindowPartition> currentPartition_;
+  // operator and functions. This structure is shared with the WindowBuild.
+  std::shared_ptr<WindowPartition> currentPartition_;
 
   // HashStringAllocator required by functions that allocate out of line
   // buffers.
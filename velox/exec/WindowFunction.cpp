@@ -16,14 +16,23 @@
 
 #include "velox/exec/WindowFunction.h"
 #include "velox/expression/FunctionSignature.h"
+#include "velox/expression/LazyFunctionRegistration.h"
 #include "velox/expression/SignatureBinder.h"
 
 namespace facebook::velox::exec {
 
-WindowFunctionMap& windowFunctions() {
+namespace {
+// The registry without the functions that are registered lazily.
+WindowFunctionMap& windowFunctionsInternal() {
   static WindowFunctionMap functions;
   return functions;
 }
+} // namespace
+
+WindowFunctionMap& windowFunctions() {
+  ensureLazyFunctionsRegistered();
+  return windowFunctionsInternal();
+}
 
 namespace {
 std::optional<const WindowFunctionEntry*> getWindowFunctionEntry(
@@ -42,9 +51,21 @@ bool registerWindowFunction(
     const std::string& name,
     std::vector<FunctionSignaturePtr> signatures,
     WindowFunctionFactory factory) {
+  return registerWindowFunction(
+      name,
+      std::move(signatures),
+      WindowFunction::Metadata::defaultMetadata(),
+      std::move(factory));
+}
+
+bool registerWindowFunction(
+    const std::string& name,
+    std::vector<FunctionSignaturePtr> signatures,
+    WindowFunction::Metadata metadata,
+    WindowFunctionFactory factory) {
   auto sanitizedName = sanitizeName(name);
-  windowFunctions()[sanitizedName] = {
-      std::move(signatures), std::move(factory)};
+  windowFunctionsInternal()[sanitizedName] = {
+      std::move(signatures), std::move(factory), metadata};
   return true;
 }
 
@@ -57,6 +78,15 @@ std::optional<std::vector<FunctionSignaturePtr>> getWindowFunctionSignatures(
   return std::nullopt;
 }
 
+std::optional<WindowFunction::Metadata> getWindowFunctionMetadata(
+    const std::string& name) {
+  auto sanitizedName = sanitizeName(name);
+  if (auto func = getWindowFunctionEntry(sanitizedName)) {
+    return func.value()->metadata;
+  }
+  return std::nullopt;
+}
+
 std::unique_ptr<WindowFunction> WindowFunction::create(
     const std::string& name,
     const std::vector<WindowFunctionArg>& args,
@@ -43,6 +43,26 @@ class WindowFunction {
 
   virtual ~WindowFunction() = default;
 
+  /// How a window function consumes the rows of a partition.
+  enum class ProcessMode {
+    /// The function needs access to the whole partition, e.g. to evaluate
+    /// frames or to use the number of rows in the partition.
+    kPartition,
+    /// The function computes each row from the preceding rows and the peer
+    /// group starts only, e.g. row_number and rank. The Window operator can
+    /// pass such a function the rows of a partition as they arrive.
+    kRows,
+  };
+
+  struct Metadata {
+    ProcessMode processMode{ProcessMode::kPartition};
+
+    static Metadata defaultMetadata() {
+      static Metadata defaultValue{ProcessMode::kPartition};
+      return defaultValue;
+    }
+  };
+
   // Row number to use in WindowPartition::extractColumn to request a NULL
   // value.
   static constexpr vector_size_t kNullRow = -1;
@@ -151,14 +171,27 @@ bool registerWindowFunction(
     std::vector<FunctionSignaturePtr> signatures,
     WindowFunctionFactory factory);
 
+/// Same as above, with the function's metadata.
+bool registerWindowFunction(
+    const std::string& name,
+    std::vector<FunctionSignaturePtr> signatures,
+    WindowFunction::Metadata metadata,
+    WindowFunctionFactory factory);
+
 /// Returns signatures of the window function with the specified name.
 /// Returns empty std::optional if function with that name is not found.
 std::optional<std::vector<FunctionSignaturePtr>> getWindowFunctionSignatures(
     const std::string& name);
 
+/// Returns the metadata of the window function with the specified name.
+/// Returns empty std::optional if function with that name is not found.
+std::optional<WindowFunction::Metadata> getWindowFunctionMetadata(
+    const std::string& name);
+
 struct WindowFunctionEntry {
   std::vector<FunctionSignaturePtr> signatures;
   WindowFunctionFactory factory;
+  WindowFunction::Metadata metadata;
 };
 
 using WindowFunctionMap = std::unordered_map<std::string, WindowFunctionEntry>;
@@ -22,7 +22,9 @@ WindowPartition::WindowPartition(
     const folly::Range<char**>& rows,
     const std::vector<column_index_t>& inputMapping,
     const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
-    : data_(data),
+    : partial_(false),
+      complete_(true),
+      data_(data),
       partition_(rows),
       inputMapping_(inputMapping),
       sortKeyInfo_(sortKeyInfo) {
@@ -31,6 +33,54 @@ WindowPartition::WindowPartition(
   }
 }
 
+WindowPartition::WindowPartition(
+    RowContainer* data,
+    const std::vector<column_index_t>& inputMapping,
+    const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
+    : partial_(true),
+      complete_(false),
+      data_(data),
+      inputMapping_(inputMapping),
+      sortKeyInfo_(sortKeyInfo) {
+  for (int i = 0; i < inputMapping_.size(); i++) {
+    columns_.emplace_back(data_->columnAt(inputMapping_[i]));
+  }
+}
+
+void WindowPartition::addRows(const std::vector<char*>& rows) {
+  VELOX_CHECK(partial_);
+  VELOX_CHECK(!complete_);
+  rows_.insert(rows_.end(), rows.begin(), rows.end());
+  partition_ = folly::Range(rows_.data(), rows_.size());
+}
+
+void WindowPartition::setComplete() {
+  VELOX_CHECK(partial_);
+  complete_ = true;
+  // Erases the last processed row if all the rows have been output.
+  removeProcessedRows(0);
+}
+
+void WindowPartition::removeProcessedRows(vector_size_t numRows) {
+  VELOX_CHECK(partial_);
+  VELOX_CHECK_LE(numRows, numRowsForProcessing());
+  numProcessedRows_ += numRows;
+
+  // Keeps the last processed row to compare the next rows with unless no
+  // more rows will come.
+  const vector_size_t lastRow =
+      complete_ && numRowsForProcessing() == 0 ? numProcessedRows_
+                                               : numProcessedRows_ - 1;
+  const auto numErasedRows = lastRow - startRow_;
+  if (numErasedRows <= 0) {
+    return;
+  }
+  data_->eraseRows(folly::Range<char**>(rows_.data(), numErasedRows));
+  rows_.erase(rows_.begin(), rows_.begin() + numErasedRows);
+  startRow_ += numErasedRows;
+  partition_ = folly::Range(rows_.data(), rows_.size());
+}
+
 void WindowPartition::extractColumn(
     int32_t columnIndex,
     folly::Range<const vector_size_t*> rowNumbers,
@@ -51,7 +101,7 @@ void WindowPartition::extractColumn(
     vector_size_t resultOffset,
     const VectorPtr& result) const {
   RowContainer::extractColumn(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       resultOffset,
@@ -64,7 +114,7 @@ void WindowPartition::extractNulls(
     vector_size_t numRows,
     const BufferPtr& nullsBuffer) const {
   RowContainer::extractNulls(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       nullsBuffer);
@@ -158,11 +208,15 @@ std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
 
     if (i == 0 || i >= peerEnd) {
       // Compute peerStart and peerEnd rows for the first row of the partition
-      // or when past the previous peerGroup.
-      peerStart = i;
+      // or when past the previous peerGroup. The last peer group of a partial
+      // partition may continue in the rows added after the previous call.
+      if (i == 0 || !partial_ || i != peerEnd ||
+          peerCompare(rowAt(i - 1), rowAt(i))) {
+        peerStart = i;
+      }
       peerEnd = i;
       while (peerEnd <= lastPartitionRow) {
-        if (peerCompare(partition_[peerStart], partition_[peerEnd])) {
+        if (peerCompare(rowAt(i), rowAt(peerEnd))) {
           break;
         }
         peerEnd++;
@@ -42,11 +42,56 @@ class WindowPartition {
       const std::vector<std::pair<column_index_t, core::SortOrder>>&
           sortKeyInfo);
 
-  /// Returns the number of rows in the current WindowPartition.
+  /// Constructs an empty partial WindowPartition. The WindowBuild adds the
+  /// rows of the partition with addRows() as they arrive in the input and
+  /// the Window operator removes the rows it has output with
+  /// removeProcessedRows(). Only window functions with
+  /// WindowFunction::ProcessMode::kRows can be evaluated over a partial
+  /// partition. These use only extractColumn() over a range of rows and
+  /// computePeerBuffers(). Row numbers stay relative to the start of the
+  /// partition.
+  WindowPartition(
+      RowContainer* data,
+      const std::vector<column_index_t>& inputMapping,
+      const std::vector<std::pair<column_index_t, core::SortOrder>>&
+          sortKeyInfo);
+
+  /// Returns the number of rows in the current WindowPartition. For a
+  /// partial partition, this is the number of rows added so far, including
+  /// the removed ones.
   vector_size_t numRows() const {
-    return partition_.size();
+    return startRow_ + partition_.size();
+  }
+
+  /// Returns true if this is a partial partition.
+  bool partial() const {
+    return partial_;
+  }
+
+  /// Returns true if all the rows of the partition have been added. Always
+  /// true for a partition that is not partial.
+  bool complete() const {
+    return complete_;
+  }
+
+  /// Marks a partial partition as having all its rows.
+  void setComplete();
+
+  /// Appends 'rows' to a partial partition.
+  void addRows(const std::vector<char*>& rows);
+
+  /// Returns the number of rows of a partial partition that have been added
+  /// and not yet passed to removeProcessedRows().
+  vector_size_t numRowsForProcessing() const {
+    return numRows() - numProcessedRows_;
   }
 
+  /// Notifies a partial partition that the next 'numRows' rows have been
+  /// output. Erases them from the RowContainer except for the last one,
+  /// which the next rows are compared with to find the peer groups. Erases
+  /// all the rows once the partition is complete and fully processed.
+  void removeProcessedRows(vector_size_t numRows);
+
   /// Copies the values at 'columnIndex' into 'result' (starting at
   /// 'resultOffset') for the rows at positions in the 'rowNumbers'
   /// array from the partition input data.
@@ -162,6 +207,17 @@ class WindowPartition {
       const vector_size_t* rawPeerBounds,
       vector_size_t* rawFrameBounds) const;
 
+  // Returns the row at position 'row' of the partition.
+  char* rowAt(vector_size_t row) const {
+    return partition_[row - startRow_];
+  }
+
+  // True if the partition is built incrementally with addRows().
+  const bool partial_;
+
+  // False for a partial partition until all its rows have been added.
+  bool complete_;
+
   // The RowContainer associated with the partition.
   // It is owned by the WindowBuild that creates the partition.
   RowContainer* data_;
@@ -172,6 +228,17 @@ class WindowPartition {
   // of WindowPartition.
   folly::Range<char**> partition_;
 
+  // The rows of a partial partition that are not yet erased. 'partition_'
+  // points into this.
+  std::vector<char*> rows_;
+
+  // Number of rows erased from the start of a partial partition. The row
+  // at position 'startRow_' is 'partition_[0]'.
+  vector_size_t startRow_{0};
+
+  // Number of rows of a partial partition that have been output.
+  vector_size_t numProcessedRows_{0};
+
   // Mapping from window input column -> index in data_. This is required
   // because the WindowBuild reorders data_ to place partition and sort keys
   // before other columns in data_. But the Window Operator and Function code
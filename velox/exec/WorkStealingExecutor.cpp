@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/WorkStealingExecutor.h"
+
+#include <glog/logging.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+thread_local const WorkStealingExecutor* threadExecutor{nullptr};
+thread_local int32_t threadWorker{-1};
+} // namespace
+
+WorkStealingExecutor::WorkStealingExecutor(int32_t numWorkers) {
+  VELOX_CHECK_GT(numWorkers, 0);
+  workers_.reserve(numWorkers);
+  for (auto i = 0; i < numWorkers; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  for (auto i = 0; i < numWorkers; ++i) {
+    workers_[i]->thread = std::thread([this, i]() { run(i); });
+  }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+  {
+    std::lock_guard<std::mutex> l(sleepMutex_);
+    stopped_ = true;
+  }
+  sleepCv_.notify_all();
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+// static
+int32_t WorkStealingExecutor::currentWorker() {
+  return threadWorker;
+}
+
+void WorkStealingExecutor::add(folly::Func func) {
+  if (threadExecutor == this) {
+    push(std::move(func), threadWorker);
+    return;
+  }
+  push(std::move(func), nextWorker_++ % workers_.size());
+}
+
+void WorkStealingExecutor::addToWorker(folly::Func func, int32_t worker) {
+  if (worker < 0 || worker >= numWorkers()) {
+    add(std::move(func));
+    return;
+  }
+  push(std::move(func), worker);
+}
+
+void WorkStealingExecutor::push(folly::Func func, int32_t worker) {
+  {
+    std::lock_guard<std::mutex> l(workers_[worker]->mutex);
+    workers_[worker]->queue.push_back(std::move(func));
+  }
+  // A worker that goes to sleep increments 'numSleeping_' before checking
+  // 'numQueued_', so that either it sees the new function or it is woken up.
+  ++numQueued_;
+  if (numSleeping_ > 0) {
+    std::lock_guard<std::mutex> l(sleepMutex_);
+    sleepCv_.notify_one();
+  }
+}
+
+bool WorkStealingExecutor::take(int32_t worker, folly::Func& func) {
+  const int32_t numWorkers = workers_.size();
+  for (auto i = 0; i < numWorkers; ++i) {
+    if (i > 0 && numQueued_ <= 0) {
+      return false;
+    }
+    auto& queue = *workers_[(worker + i) % numWorkers];
+    std::lock_guard<std::mutex> l(queue.mutex);
+    if (queue.queue.empty()) {
+      continue;
+    }
+    func = std::move(queue.queue.front());
+    queue.queue.pop_front();
+    --numQueued_;
+    if (i == 0) {
+      ++numLocal_;
+    } else {
+      ++numStolen_;
+    }
+    return true;
+  }
+  return false;
+}
+
+bool WorkStealingExecutor::wait() {
+  std::unique_lock<std::mutex> l(sleepMutex_);
+  ++numSleeping_;
+  sleepCv_.wait(l, [&]() { return numQueued_ > 0 || stopped_; });
+  --numSleeping_;
+  return numQueued_ > 0 || !stopped_;
+}
+
+void WorkStealingExecutor::run(int32_t worker) {
+  threadExecutor = this;
+  threadWorker = worker;
+  folly::Func func;
+  for (;;) {
+    if (take(worker, func)) {
+      try {
+        func();
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "WorkStealingExecutor function threw: " << e.what();
+      }
+      func = nullptr;
+      continue;
+    }
+    if (!wait()) {
+      return;
+    }
+  }
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+/// Executor for Drivers with a run queue per worker thread. A worker runs the
+/// functions of its own queue first and steals from the other queues when its
+/// own is empty. Functions added from a worker are queued to that worker, so
+/// that a Driver that yields continues on the core that has its state in
+/// cache, and no queue is shared by all threads. Driver::enqueue() requeues a
+/// resumed Driver on the worker it last ran on. Use as the executor of a
+/// QueryCtx.
+class WorkStealingExecutor : public folly::Executor {
+ public:
+  struct Stats {
+    /// Number of functions run by the worker whose queue they were in.
+    uint64_t numLocal{0};
+    /// Number of functions run by another worker.
+    uint64_t numStolen{0};
+  };
+
+  explicit WorkStealingExecutor(int32_t numWorkers);
+
+  /// Runs the queued functions and joins the workers.
+  ~WorkStealingExecutor() override;
+
+  /// Queues 'func' to the calling worker, or to the workers round robin when
+  /// not called from a worker.
+  void add(folly::Func func) override;
+
+  /// Queues 'func' to 'worker'. Same as add() if 'worker' is not a worker of
+  /// this executor, e.g. -1.
+  void addToWorker(folly::Func func, int32_t worker);
+
+  /// Returns the index of the calling worker thread in its executor or -1 if
+  /// not called from a worker.
+  static int32_t currentWorker();
+
+  int32_t numWorkers() const {
+    return workers_.size();
+  }
+
+  Stats stats() const {
+    return {numLocal_, numStolen_};
+  }
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<folly::Func> queue;
+    std::thread thread;
+  };
+
+  void push(folly::Func func, int32_t worker);
+
+  // Takes the oldest function of the queue of 'worker' or, if that is empty,
+  // of the queue of another worker. Returns false if all queues are empty.
+  bool take(int32_t worker, folly::Func& func);
+
+  // Waits until a function is queued. Returns false when the executor is
+  // destroyed and all queues are empty.
+  bool wait();
+
+  void run(int32_t worker);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  // Number of functions in all queues.
+  std::atomic<int64_t> numQueued_{0};
+  std::atomic<uint32_t> nextWorker_{0};
+
+  // Guards sleeping and waking up of idle workers. Taken by add() only when
+  // some worker sleeps.
+  std::mutex sleepMutex_;
+  std::condition_variable sleepCv_;
+  std::atomic<int32_t> numSleeping_{0};
+  bool stopped_{false};
+
+  std::atomic<uint64_t> numLocal_{0};
+  std::atomic<uint64_t> numStolen_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+#include <folly/synchronization/Baton.h>
+
+#include <thread>
+
+#include "velox/exec/WorkStealingExecutor.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+// Runs 'numChains' chains of short functions on an executor with a thread per
+// core. Each function updates the state of its chain and queues the next
+// function of the chain from the worker thread, like a Driver that yields at
+// the end of its time slice.
+void runChains(bool workStealing, int32_t numChains) {
+  folly::BenchmarkSuspender suspender;
+  constexpr int32_t kSteps = 2'000;
+  constexpr int32_t kStateWords = 2'048;
+  const auto numThreads = std::thread::hardware_concurrency();
+  std::unique_ptr<folly::Executor> executor;
+  if (workStealing) {
+    executor = std::make_unique<WorkStealingExecutor>(numThreads);
+  } else {
+    executor = std::make_unique<folly::CPUThreadPoolExecutor>(numThreads);
+  }
+  std::vector<std::vector<int64_t>> states(
+      numChains, std::vector<int64_t>(kStateWords));
+  std::atomic<int32_t> numDone{0};
+  folly::Baton<> done;
+  std::function<void(int32_t, int32_t)> step = [&](auto chain, auto n) {
+    for (auto& word : states[chain]) {
+      word += n;
+    }
+    if (n + 1 < kSteps) {
+      executor->add([&, chain, n]() { step(chain, n + 1); });
+    } else if (++numDone == numChains) {
+      done.post();
+    }
+  };
+  suspender.dismiss();
+
+  for (auto chain = 0; chain < numChains; ++chain) {
+    executor->add([&, chain]() { step(chain, 0); });
+  }
+  done.wait();
+  folly::doNotOptimizeAway(states[0][0]);
+  suspender.rehire();
+  // Joins the threads before the state of the chains goes away.
+  executor.reset();
+}
+} // namespace
+
+BENCHMARK(threadPool16) {
+  runChains(false, 16);
+}
+
+BENCHMARK_RELATIVE(workStealing16) {
+  runChains(true, 16);
+}
+
+BENCHMARK(threadPool256) {
+  runChains(false, 256);
+}
+
+BENCHMARK_RELATIVE(workStealing256) {
+  runChains(true, 256);
+}
+
+BENCHMARK(threadPool4096) {
+  runChains(false, 4'096);
+}
+
+BENCHMARK_RELATIVE(workStealing4096) {
+  runChains(true, 4'096);
+}
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  folly::runBenchmarks();
+  return 0;
+}
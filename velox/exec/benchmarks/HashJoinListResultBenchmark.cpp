@@ -36,7 +36,8 @@ struct HashTableBenchmarkParams {
   //  -the build & probe row schema,
   //  -the expected hash table size,
   //  -number of probing rows,
-  //  -build key repetition distribution.
+  //  -build key repetition distribution,
+  //  -whether to use the partitioned probe in hash mode.
   HashTableBenchmarkParams(
       BaseHashTable::HashMode mode,
       const TypePtr& buildType,
@@ -44,13 +45,15 @@ struct HashTableBenchmarkParams {
       int64_t probeSize,
       const std::vector<std::pair<int32_t, int32_t>>&
           keyRepeatTimesDistribution,
-      bool runErase)
+      bool runErase,
+      bool partitionedProbe = false)
       : mode{mode},
         buildType{buildType},
         hashTableSize{hashTableSize},
         probeSize{probeSize},
         keyRepeatTimesDistribution{keyRepeatTimesDistribution},
-        runErase{runErase} {
+        runErase{runErase},
+        partitionedProbe{partitionedProbe} {
     int32_t distSum = 0;
     buildSize = 0;
     buildKeyRepeat.reserve(keyRepeatTimesDistribution.size());
@@ -93,6 +96,12 @@ struct HashTableBenchmarkParams {
     if (runErase) {
       title += ",withErase";
     }
+    if (partitionedProbe) {
+      VELOX_CHECK(
+          mode == BaseHashTable::HashMode::kHash,
+          "Partitioned probe only applies to hash mode.");
+      title += ",partitionedProbe";
+    }
   }
 
   // Expected mode.
@@ -113,6 +122,9 @@ struct HashTableBenchmarkParams {
 
   bool runErase;
 
+  // Whether to radix-partition the probe rows by bucket offset before probing.
+  bool partitionedProbe{false};
+
   // Title for reporting
   std::string title;
 
@@ -160,6 +172,8 @@ struct HashTableBenchmarkResult {
 
   double buildClocks{0};
 
+  double probeClocks{0};
+
   double listJoinResultClocks{0};
 
   double totalClock{0};
@@ -172,6 +186,7 @@ struct HashTableBenchmarkResult {
   void merge(HashTableBenchmarkResult other) {
     numIter++;
     buildClocks += other.buildClocks;
+    probeClocks += other.probeClocks;
     listJoinResultClocks += other.listJoinResultClocks;
     totalClock += other.totalClock;
     eraseClock += other.eraseClock;
@@ -183,6 +198,8 @@ struct HashTableBenchmarkResult {
     out << std::endl
         << " mode=" << BaseHashTable::modeString(hashMode)
         << " numOutput=" << numOutput << " totalClock=" << totalClock
+        << " probeClocks=" << probeClocks << "("
+        << (probeClocks / totalClock * 100) << "%)"
         << " listJoinResultClocks=" << listJoinResultClocks << "("
         << (listJoinResultClocks / totalClock * 100)
         << "%) buildClocks=" << buildClocks << "("
@@ -207,6 +224,7 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
     SelectivityInfo totalClock;
     {
       SelectivityTimer timer(totalClock, 0);
+      probeTime_ = 0;
       buildTable();
       result.numOutput = probeTableAndListResult();
       result.hashMode = topTable_->hashMode();
@@ -218,6 +236,7 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
       topTable_.reset();
     }
     result.buildClocks += buildTime_;
+    result.probeClocks += probeTime_;
     result.listJoinResultClocks += listJoinResultTime_;
     result.totalClock += totalClock.timeToDropValue();
 
@@ -377,6 +396,9 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
       SelectivityTimer timer(buildClocks, 0);
       topTable_->prepareJoinTable(std::move(otherTables), executor_.get());
     }
+    // Enables the partitioned probe for any table size.
+    topTable_->setMinTableBytesForPartitionedProbe(
+        params_.partitionedProbe ? 1 : 0);
     buildTime_ = buildClocks.timeToDropValue();
   }
 
@@ -400,7 +422,12 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
     }
     lookup.rows.resize(rows.size());
     std::iota(lookup.rows.begin(), lookup.rows.end(), 0);
-    topTable_->joinProbe(lookup);
+    SelectivityInfo probeClocks;
+    {
+      SelectivityTimer timer(probeClocks, 0);
+      topTable_->joinProbe(lookup);
+    }
+    probeTime_ += probeClocks.timeToDropValue();
   }
 
   // Hash probe andd list join result.
@@ -471,6 +498,7 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
   HashTableBenchmarkParams params_;
 
   double buildTime_{0};
+  double probeTime_{0};
   double eraseTime_{0};
   double listJoinResultTime_{0};
 };
@@ -538,6 +566,18 @@ int main(int argc, char** argv) {
       }
     }
   }
+  // The partitioned probe on hash mode tables, to compare with the plain hash
+  // mode probe above. The tables are much larger than the CPU caches.
+  for (auto& dist : keyRepeatDists) {
+    params.emplace_back(HashTableBenchmarkParams(
+        BaseHashTable::HashMode::kHash,
+        onlyKeyType,
+        hashTableSize,
+        probeRowSize,
+        dist,
+        false,
+        true));
+  }
 
   for (auto& param : params) {
     folly::addBenchmark(__FILE__, param.title, [param, &bm, &results]() {
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/HashPartitionFunction.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+class HashPartitionFunctionBenchmark : public test::VectorTestBase {
+ public:
+  HashPartitionFunctionBenchmark() {
+    constexpr vector_size_t kSize = 10'000;
+    input_ = makeRowVector({
+        makeFlatVector<int64_t>(
+            kSize, [](auto row) { return row * 1'000'003; }),
+        makeFlatVector<int32_t>(kSize, [](auto row) { return row % 1'001; }),
+    });
+  }
+
+  // Partitions 'input_' 'numIterations' times into 'numPartitions'
+  // partitions, by the bits of the hash if 'useBitRange' is true.
+  void run(int32_t numPartitions, bool useBitRange, int32_t numIterations) {
+    folly::BenchmarkSuspender suspender;
+    const auto rowType = asRowType(input_->type());
+    std::unique_ptr<HashPartitionFunction> function;
+    if (useBitRange) {
+      function = std::make_unique<HashPartitionFunction>(
+          HashBitRange(0, __builtin_ctz(numPartitions)),
+          rowType,
+          std::vector<column_index_t>{0, 1});
+    } else {
+      function = std::make_unique<HashPartitionFunction>(
+          numPartitions, rowType, std::vector<column_index_t>{0, 1});
+    }
+    std::vector<uint32_t> partitions;
+    suspender.dismiss();
+
+    for (auto i = 0; i < numIterations; ++i) {
+      function->partition(*input_, partitions);
+      folly::doNotOptimizeAway(partitions[0]);
+    }
+  }
+
+ private:
+  RowVectorPtr input_;
+};
+
+std::unique_ptr<HashPartitionFunctionBenchmark> benchmark;
+
+BENCHMARK_MULTI(modulo16) {
+  benchmark->run(16, false, 1'000);
+  return 1'000;
+}
+
+BENCHMARK_RELATIVE_MULTI(bitRange16) {
+  benchmark->run(16, true, 1'000);
+  return 1'000;
+}
+
+BENCHMARK_MULTI(modulo1000) {
+  benchmark->run(1'000, false, 1'000);
+  return 1'000;
+}
+
+BENCHMARK_MULTI(modulo4096) {
+  benchmark->run(4'096, false, 1'000);
+  return 1'000;
+}
+
+BENCHMARK_RELATIVE_MULTI(bitRange4096) {
+  benchmark->run(4'096, true, 1'000);
+  return 1'000;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  benchmark = std::make_unique<HashPartitionFunctionBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
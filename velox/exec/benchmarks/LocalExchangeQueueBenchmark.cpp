@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <thread>
+
+#include "velox/exec/LocalPartition.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+
+// Measures the throughput of the local exchange queues with 'numProducers'
+// threads enqueuing small vectors into 'numQueues' queues that share a memory
+// manager, and one consumer thread per queue.
+void runQueues(int numProducers, int numQueues, bool lowMemoryLimit) {
+  folly::BenchmarkSuspender suspender;
+  constexpr int kBatchesPerProducer = 20'000;
+  auto pool = memory::memoryManager()->addLeafPool();
+  VectorMaker vectorMaker(pool.get());
+  auto batch = vectorMaker.rowVector(
+      {vectorMaker.flatVector<int64_t>(16, [](auto row) { return row; })});
+
+  auto memoryManager = std::make_shared<LocalExchangeMemoryManager>(
+      lowMemoryLimit ? batch->estimateFlatSize() * numQueues * 4
+                     : std::numeric_limits<int64_t>::max());
+  std::vector<std::shared_ptr<LocalExchangeQueue>> queues;
+  for (auto i = 0; i < numQueues; ++i) {
+    queues.push_back(std::make_shared<LocalExchangeQueue>(memoryManager, i));
+    for (auto j = 0; j < numProducers; ++j) {
+      queues.back()->addProducer();
+    }
+    queues.back()->noMoreProducers();
+  }
+  suspender.dismiss();
+
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < numProducers; ++i) {
+    threads.emplace_back([&, i]() {
+      for (auto j = 0; j < kBatchesPerProducer; ++j) {
+        ContinueFuture future;
+        if (queues[(i + j) % numQueues]->enqueue(batch, &future) ==
+            BlockingReason::kWaitForConsumer) {
+          future.wait();
+        }
+      }
+      for (auto& queue : queues) {
+        queue->noMoreData();
+      }
+    });
+  }
+  for (auto i = 0; i < numQueues; ++i) {
+    threads.emplace_back([&, i]() {
+      for (;;) {
+        ContinueFuture future;
+        RowVectorPtr data;
+        if (queues[i]->next(&future, pool.get(), &data) ==
+            BlockingReason::kWaitForProducer) {
+          future.wait();
+          continue;
+        }
+        if (data == nullptr) {
+          break;
+        }
+        folly::doNotOptimizeAway(data);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+} // namespace
+
+BENCHMARK(producers1) {
+  runQueues(1, 4, false);
+}
+
+BENCHMARK_RELATIVE(producers4) {
+  runQueues(4, 4, false);
+}
+
+BENCHMARK_RELATIVE(producers16) {
+  runQueues(16, 4, false);
+}
+
+BENCHMARK(producers1LowMemory) {
+  runQueues(1, 4, true);
+}
+
+BENCHMARK_RELATIVE(producers4LowMemory) {
+  runQueues(4, 4, true);
+}
+
+BENCHMARK_RELATIVE(producers16LowMemory) {
+  runQueues(16, 4, true);
+}
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  folly::runBenchmarks();
+  return 0;
+}
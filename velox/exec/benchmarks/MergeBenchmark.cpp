@@ -19,12 +19,96 @@
 
 #include <gflags/gflags.h>
 
+#include "velox/exec/Spill.h"
 #include "velox/exec/TreeOfLosers.h"
 #include "velox/exec/tests/utils/MergeTestBase.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
 
 using namespace facebook::velox;
+using namespace facebook::velox::exec;
 using namespace facebook::velox::exec::test;
 
+namespace {
+// Spill merge stream over in-memory sorted batches. Compares rows with the
+// vector comparisons of SpillMergeStream like a merge of spill files.
+class VectorMergeStream : public SpillMergeStream {
+ public:
+  VectorMergeStream(uint32_t id, const std::vector<RowVectorPtr>& batches)
+      : id_(id), batches_(batches) {
+    nextBatch();
+  }
+
+  uint32_t id() const override {
+    return id_;
+  }
+
+ private:
+  int32_t numSortKeys() const override {
+    return 1;
+  }
+
+  const std::vector<CompareFlags>& sortCompareFlags() const override {
+    return compareFlags_;
+  }
+
+  void nextBatch() override {
+    index_ = 0;
+    if (nextBatch_ >= batches_.size()) {
+      size_ = 0;
+      return;
+    }
+    rowVector_ = batches_[nextBatch_++];
+    size_ = rowVector_->size();
+  }
+
+  const uint32_t id_;
+  const std::vector<RowVectorPtr>& batches_;
+  const std::vector<CompareFlags> compareFlags_{CompareFlags{}};
+  size_t nextBatch_{0};
+};
+
+class SpillMergeData : public facebook::velox::test::VectorTestBase {
+ public:
+  // Makes 'numStreams' streams of 'numBatches' sorted batches of
+  // 'batchSize' BIGINT keys each.
+  void makeStreams(int32_t numStreams, int32_t numBatches, int32_t batchSize) {
+    folly::Random::DefaultGenerator rng(1);
+    streams_.resize(numStreams);
+    for (auto& stream : streams_) {
+      std::vector<int64_t> keys(numBatches * batchSize);
+      for (auto& key : keys) {
+        key = folly::Random::rand64(rng) % 1'000'000'000;
+      }
+      std::sort(keys.begin(), keys.end());
+      for (auto i = 0; i < numBatches; ++i) {
+        stream.push_back(makeRowVector({makeFlatVector<int64_t>(
+            batchSize, [&](auto row) { return keys[i * batchSize + row]; })}));
+      }
+    }
+  }
+
+  void merge(bool normalizedKeys) const {
+    std::vector<std::unique_ptr<SpillMergeStream>> streams;
+    for (auto i = 0; i < streams_.size(); ++i) {
+      streams.push_back(std::make_unique<VectorMergeStream>(i, streams_[i]));
+    }
+    TreeOfLosers<SpillMergeStream> tree(std::move(streams), normalizedKeys);
+    int64_t sum = 0;
+    while (auto* stream = tree.next()) {
+      sum += stream->currentIndex();
+      stream->pop();
+    }
+    folly::doNotOptimizeAway(sum);
+  }
+
+ private:
+  std::vector<std::vector<RowVectorPtr>> streams_;
+};
+
+std::unique_ptr<SpillMergeData> spill128;
+std::unique_ptr<SpillMergeData> spill1024;
+} // namespace
+
 TestData narrow;
 TestData medium;
 TestData wide;
@@ -53,6 +137,24 @@ BENCHMARK_RELATIVE(wideArray) {
   MergeTestBase::test<MergeArray<TestingStream>>(wide, false);
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(spill128Streams) {
+  spill128->merge(false);
+}
+
+BENCHMARK_RELATIVE(spill128StreamsNormalizedKeys) {
+  spill128->merge(true);
+}
+
+BENCHMARK(spill1024Streams) {
+  spill1024->merge(false);
+}
+
+BENCHMARK_RELATIVE(spill1024StreamsNormalizedKeys) {
+  spill1024->merge(true);
+}
+
 int main(int argc, char* argv[]) {
   folly::Init init{&argc, &argv};
   gflags::ParseCommandLineFlags(&argc, &argv, true);
@@ -61,6 +163,11 @@ int main(int argc, char* argv[]) {
   narrow = test.makeTestData(100'000'000, 7);
   medium = test.makeTestData(10'000'0000, 37);
   wide = test.makeTestData(10'000'0000, 1029);
+  memory::MemoryManager::initialize({});
+  spill128 = std::make_unique<SpillMergeData>();
+  spill128->makeStreams(128, 40, 1'000);
+  spill1024 = std::make_unique<SpillMergeData>();
+  spill1024->makeStreams(1024, 5, 1'000);
   folly::runBenchmarks();
   return 0;
 }
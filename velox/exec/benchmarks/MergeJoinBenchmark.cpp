@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+DEFINE_int32(num_fact_batches, 1'000, "Number of batches of the fact side");
+DEFINE_int32(batch_size, 1'024, "Number of rows per batch");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+// Merge joins a sorted fact side with a sorted dimension side that has one
+// key every 'stride' fact keys.
+class MergeJoinBenchmark : public facebook::velox::test::VectorTestBase {
+ public:
+  // Makes a plan joining consecutive fact keys with keys 'stride' apart on the
+  // dimension side. The dimension side has as many batches as the fact side
+  // with keys in the same range when 'sparseLeft' is false. Otherwise, the
+  // sides are swapped.
+  core::PlanNodePtr makePlan(int32_t stride, bool sparseLeft) {
+    const auto numRows = FLAGS_num_fact_batches * FLAGS_batch_size;
+    std::vector<RowVectorPtr> fact;
+    for (auto i = 0; i < FLAGS_num_fact_batches; ++i) {
+      fact.push_back(makeRowVector(
+          {"f0", "f1"},
+          {makeFlatVector<int64_t>(
+               FLAGS_batch_size,
+               [&](auto row) { return i * FLAGS_batch_size + row; }),
+           makeFlatVector<int64_t>(
+               FLAGS_batch_size, [](auto row) { return row; })}));
+    }
+    std::vector<RowVectorPtr> dimension;
+    const auto numDimensionRows = numRows / stride;
+    for (auto start = 0; start < numDimensionRows;
+         start += FLAGS_batch_size) {
+      const auto size =
+          std::min<int32_t>(FLAGS_batch_size, numDimensionRows - start);
+      dimension.push_back(makeRowVector(
+          {"d0", "d1"},
+          {makeFlatVector<int64_t>(
+               size, [&](auto row) { return (start + row) * stride; }),
+           makeFlatVector<int64_t>(size, [](auto row) { return row; })}));
+    }
+
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    if (sparseLeft) {
+      return PlanBuilder(planNodeIdGenerator)
+          .values(dimension)
+          .mergeJoin(
+              {"d0"},
+              {"f0"},
+              PlanBuilder(planNodeIdGenerator).values(fact).planNode(),
+              "",
+              {"d0", "d1", "f1"})
+          .singleAggregation({}, {"count(1)"})
+          .planNode();
+    }
+    return PlanBuilder(planNodeIdGenerator)
+        .values(fact)
+        .mergeJoin(
+            {"f0"},
+            {"d0"},
+            PlanBuilder(planNodeIdGenerator).values(dimension).planNode(),
+            "",
+            {"f0", "f1", "d1"})
+        .singleAggregation({}, {"count(1)"})
+        .planNode();
+  }
+
+  void run(const core::PlanNodePtr& plan) {
+    auto result = AssertQueryBuilder(plan).copyResults(pool());
+    folly::doNotOptimizeAway(result);
+  }
+};
+
+std::unique_ptr<MergeJoinBenchmark> benchmark;
+
+void addBenchmarks(int32_t stride) {
+  for (const auto sparseLeft : {false, true}) {
+    auto plan = benchmark->makePlan(stride, sparseLeft);
+    folly::addBenchmark(
+        __FILE__,
+        fmt::format(
+            "stride{}_{}", stride, sparseLeft ? "sparseLeft" : "sparseRight"),
+        [plan]() {
+          benchmark->run(plan);
+          return 1;
+        });
+  }
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  aggregate::prestosql::registerAllAggregateFunctions();
+  benchmark = std::make_unique<MergeJoinBenchmark>();
+  // Every fact row matches, 1 in 16, 1 in 1K and 1 in 64K rows match.
+  for (const auto stride : {1, 16, 1'024, 65'536}) {
+    addBenchmarks(stride);
+  }
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/serialization/BinarySerde.h"
+#include "velox/connectors/hive/TableHandle.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+DEFINE_int32(num_projections, 200, "Number of projected expressions");
+DEFINE_int32(in_list_size, 10'000, "Number of values in the IN-list filters");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec::test;
+
+/// Compares serializing a plan fragment to JSON text and to the binary format
+/// of serializeBinary() and back. The fragment scans a Hive table with big
+/// IN-list filters and projects many expressions before an aggregation, like
+/// the fragments a coordinator sends to every task of a stage.
+
+namespace {
+
+class PlanSerdeBenchmark : public facebook::velox::test::VectorTestBase {
+ public:
+  PlanSerdeBenchmark() {
+    auto rowType = ROW(
+        {"c0", "c1", "c2", "c3"}, {BIGINT(), BIGINT(), VARCHAR(), DOUBLE()});
+    std::string inList;
+    std::string stringInList;
+    for (auto i = 0; i < FLAGS_in_list_size; ++i) {
+      inList += fmt::format("{}{}", i == 0 ? "" : ", ", i * 7);
+      stringInList += fmt::format("{}'s{}'", i == 0 ? "" : ", ", i);
+    }
+    std::vector<std::string> projections;
+    for (auto i = 0; i < FLAGS_num_projections; ++i) {
+      projections.push_back(fmt::format(
+          "c0 * {} + c1 AS p{}, concat(c2, '{}') AS s{}, c3 / {} AS d{}",
+          i,
+          i,
+          i,
+          i,
+          i + 1,
+          i));
+    }
+    plan_ = PlanBuilder()
+                .tableScan(
+                    rowType,
+                    {fmt::format("c0 IN ({})", inList),
+                     fmt::format("c2 IN ({})", stringInList)},
+                    fmt::format("c1 IN ({}) OR c3 > 0.5", inList))
+                .project(projections)
+                .partialAggregation({"p0", "s0"}, {"sum(d0)", "count(p1)"})
+                .planNode();
+    serialized_ = plan_->serialize();
+    json_ = folly::toJson(serialized_);
+    binary_ = serializeBinary(serialized_);
+    LOG(INFO) << "JSON size: " << json_.size()
+              << ", binary size: " << binary_.size();
+  }
+
+  const folly::dynamic& serialized() const {
+    return serialized_;
+  }
+
+  const std::string& json() const {
+    return json_;
+  }
+
+  const std::string& binary() const {
+    return binary_;
+  }
+
+  core::PlanNodePtr deserialize(const folly::dynamic& serialized) {
+    return ISerializable::deserialize<core::PlanNode>(serialized, pool());
+  }
+
+ private:
+  core::PlanNodePtr plan_;
+  folly::dynamic serialized_;
+  std::string json_;
+  std::string binary_;
+};
+
+std::unique_ptr<PlanSerdeBenchmark> benchmark;
+
+BENCHMARK(toJson) {
+  folly::doNotOptimizeAway(folly::toJson(benchmark->serialized()));
+}
+
+BENCHMARK_RELATIVE(serializeBinary) {
+  folly::doNotOptimizeAway(serializeBinary(benchmark->serialized()));
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(parseJson) {
+  folly::doNotOptimizeAway(folly::parseJson(benchmark->json()));
+}
+
+BENCHMARK_RELATIVE(deserializeBinary) {
+  folly::doNotOptimizeAway(deserializeBinary(benchmark->binary()));
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(planFromJson) {
+  folly::doNotOptimizeAway(
+      benchmark->deserialize(folly::parseJson(benchmark->json())));
+}
+
+BENCHMARK_RELATIVE(planFromBinary) {
+  folly::doNotOptimizeAway(
+      benchmark->deserialize(deserializeBinary(benchmark->binary())));
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  parse::registerTypeResolver();
+
+  Type::registerSerDe();
+  common::Filter::registerSerDe();
+  connector::hive::HiveTableHandle::registerSerDe();
+  connector::hive::HiveColumnHandle::registerSerDe();
+  core::PlanNode::registerSerDe();
+  core::ITypedExpr::registerSerDe();
+
+  benchmark = std::make_unique<PlanSerdeBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
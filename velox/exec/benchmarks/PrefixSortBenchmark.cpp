@@ -298,6 +298,32 @@ class PrefixSortBenchmark {
         "no-payloads", "varchar", batchSizes, rowTypes, numKeys, iterations);
   }
 
+  void smallVarchar() {
+    const auto iterations = 100'000;
+    const std::vector<vector_size_t> batchSizes = {10, 50, 100, 500};
+    std::vector<RowTypePtr> rowTypes = {
+        ROW({VARCHAR()}),
+        ROW({VARCHAR(), VARCHAR()}),
+    };
+    std::vector<int> numKeys = {1, 2};
+    benchmark(
+        "no-payloads", "varchar", batchSizes, rowTypes, numKeys, iterations);
+  }
+
+  // A fixed width key followed by a string key, the prefix covers both.
+  void largeBigintVarcharWithPayloads() {
+    const auto iterations = 10;
+    const std::vector<vector_size_t> batchSizes = {
+        1'000, 10'000, 100'000, 1'000'000};
+    std::vector<RowTypePtr> rowTypes = {
+        ROW({BIGINT(), VARCHAR(), VARCHAR()}),
+        ROW({BIGINT(), BIGINT(), VARCHAR(), VARCHAR()}),
+    };
+    std::vector<int> numKeys = {2, 3};
+    benchmark(
+        "payload", "bigint-varchar", batchSizes, rowTypes, numKeys, iterations);
+  }
+
  private:
   std::vector<std::unique_ptr<TestCase>> testCases_;
   memory::MemoryPool* pool_;
@@ -318,6 +344,8 @@ int main(int argc, char** argv) {
   bm.largeBigintWithPayloads();
   bm.smallBigintWithPayload();
   bm.largeVarchar();
+  bm.smallVarchar();
+  bm.largeBigintVarcharWithPayloads();
   folly::runBenchmarks();
 
   return 0;
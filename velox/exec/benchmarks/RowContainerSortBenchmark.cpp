@@ -213,6 +213,71 @@ void BM_STR_timSort(uint32_t iterations) {
     suspender.rehire();
   }
 }
+
+// Sorts rows with a BIGINT key and 'numPayloads' BIGINT payload columns and
+// extracts the payload in sorted order, with the payload stored in the rows
+// or column-wise.
+void rowContainerPayloadBenchmark(
+    uint32_t iterations,
+    size_t numPayloads,
+    bool columnarPayload) {
+  folly::BenchmarkSuspender suspender;
+  constexpr vector_size_t kNumRows = 500'000;
+  auto pool = memory::memoryManager()->addLeafPool();
+  VectorMaker vectorMaker(pool.get());
+  auto key = vectorMaker.flatVector<int64_t>(
+      kNumRows, [](auto row) { return (row * 7'919) % kNumRows; });
+  auto payload =
+      vectorMaker.flatVector<int64_t>(kNumRows, [](auto row) { return row; });
+  DecodedVector decodedKey(*key);
+  DecodedVector decodedPayload(*payload);
+  std::vector<TypePtr> payloadTypes(numPayloads, BIGINT());
+  std::vector<VectorPtr> results(numPayloads);
+  for (auto& result : results) {
+    result = BaseVector::create(BIGINT(), kNumRows, pool.get());
+  }
+
+  for (size_t k = 0; k < iterations; ++k) {
+    auto rowContainer = std::make_unique<velox::exec::RowContainer>(
+        std::vector<TypePtr>{BIGINT()},
+        true, // nullableKeys
+        std::vector<velox::exec::Accumulator>{},
+        payloadTypes,
+        false, // hasNext
+        false, // isJoinBuild
+        false, // hasProbedFlag
+        false, // hasNormalizedKeys
+        pool.get(),
+        nullptr, // stringAllocator
+        columnarPayload);
+    std::vector<char*> rows(kNumRows);
+    for (auto row = 0; row < kNumRows; ++row) {
+      rows[row] = rowContainer->newRow();
+      rowContainer->store(decodedKey, row, rows[row], 0);
+      for (auto column = 1; column <= numPayloads; ++column) {
+        rowContainer->store(decodedPayload, row, rows[row], column);
+      }
+    }
+    suspender.dismiss();
+    std::sort(
+        rows.begin(), rows.end(), [&](const char* left, const char* right) {
+          return rowContainer->compareRows(left, right) < 0;
+        });
+    for (auto column = 1; column <= numPayloads; ++column) {
+      rowContainer->extractColumn(
+          rows.data(), kNumRows, column, results[column - 1]);
+    }
+    suspender.rehire();
+  }
+}
+
+void BM_RowWisePayload(uint32_t iterations, size_t numPayloads) {
+  rowContainerPayloadBenchmark(iterations, numPayloads, false);
+}
+
+void BM_ColumnarPayload(uint32_t iterations, size_t numPayloads) {
+  rowContainerPayloadBenchmark(iterations, numPayloads, true);
+}
 } // namespace
 
 BENCHMARK_NAMED_PARAM(BM_Int64_stdSort, 100k_uni_noseq, 100000);
@@ -230,6 +295,18 @@ BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM(BM_STR_stdSort, RealWorldData_stdSort);
 BENCHMARK_RELATIVE_NAMED_PARAM(BM_STR_timSort, RealWorldData_timSort);
 BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(BM_RowWisePayload, 2_payloads, 2);
+BENCHMARK_RELATIVE_NAMED_PARAM(BM_ColumnarPayload, 2_payloads, 2);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(BM_RowWisePayload, 8_payloads, 8);
+BENCHMARK_RELATIVE_NAMED_PARAM(BM_ColumnarPayload, 8_payloads, 8);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(BM_RowWisePayload, 32_payloads, 32);
+BENCHMARK_RELATIVE_NAMED_PARAM(BM_ColumnarPayload, 32_payloads, 32);
+BENCHMARK_DRAW_LINE();
 } // namespace facebook::velox::test
 
 int main(int argc, char** argv) {
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+constexpr int32_t kNumBuckets = 16;
+constexpr int32_t kNumDrivers = 4;
+constexpr int32_t kConcurrentSplitGroups = 2;
+
+// Runs a bucketed hash join in grouped execution where the first bucket has
+// many times the probe rows of the others, with and without a memory limit for
+// split groups.
+class SplitGroupsBenchmark : public HiveConnectorTestBase {
+ public:
+  SplitGroupsBenchmark() {
+    HiveConnectorTestBase::SetUp();
+
+    rowType_ = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+    VectorFuzzer::Options opts;
+    opts.vectorSize = 10'000;
+    VectorFuzzer fuzzer(opts, pool());
+    std::vector<RowVectorPtr> probe;
+    for (auto i = 0; i < 20; ++i) {
+      probe.push_back(fuzzer.fuzzInputFlatRow(rowType_));
+    }
+    probeFile_ = TempFilePath::create();
+    writeToFile(probeFile_->getPath(), probe);
+
+    opts.vectorSize = 1'000;
+    fuzzer.setOptions(opts);
+    buildFile_ = TempFilePath::create();
+    writeToFile(
+        buildFile_->getPath(),
+        std::vector<RowVectorPtr>{fuzzer.fuzzInputFlatRow(rowType_)});
+  }
+
+  ~SplitGroupsBenchmark() override {
+    HiveConnectorTestBase::TearDown();
+  }
+
+  void TestBody() override {}
+
+  void run(uint64_t memoryLimit) {
+    folly::BenchmarkSuspender suspender;
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId probeScanId;
+    core::PlanNodeId buildScanId;
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .tableScan(rowType_)
+                    .capturePlanNodeId(probeScanId)
+                    .hashJoin(
+                        {"c0"},
+                        {"r0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .tableScan(rowType_)
+                            .capturePlanNodeId(buildScanId)
+                            .project({"c0 as r0"})
+                            .planNode(),
+                        "",
+                        {"c0", "c1"})
+                    .partialAggregation({}, {"count(1)"})
+                    .planNode();
+
+    std::vector<Split> probeSplits;
+    std::vector<Split> buildSplits;
+    for (auto bucket = 0; bucket < kNumBuckets; ++bucket) {
+      // The first bucket has 8 times the probe rows of the others.
+      const auto numProbeSplits = bucket == 0 ? 8 : 1;
+      for (auto i = 0; i < numProbeSplits; ++i) {
+        probeSplits.emplace_back(
+            makeHiveConnectorSplit(probeFile_->getPath()), bucket);
+      }
+      buildSplits.emplace_back(
+          makeHiveConnectorSplit(buildFile_->getPath()), bucket);
+    }
+    suspender.dismiss();
+
+    auto result =
+        AssertQueryBuilder(plan)
+            .maxDrivers(kNumDrivers)
+            .executionStrategy(core::ExecutionStrategy::kGrouped)
+            .numSplitGroups(kNumBuckets)
+            .numConcurrentSplitGroups(kConcurrentSplitGroups)
+            .groupedExecutionLeafNodeIds({probeScanId, buildScanId})
+            .config(
+                core::QueryConfig::kSplitGroupsMemoryLimit,
+                std::to_string(memoryLimit))
+            .splits(probeScanId, std::move(probeSplits))
+            .splits(buildScanId, std::move(buildSplits))
+            .copyResults(pool());
+    folly::doNotOptimizeAway(result);
+  }
+
+ private:
+  RowTypePtr rowType_;
+  std::shared_ptr<TempFilePath> probeFile_;
+  std::shared_ptr<TempFilePath> buildFile_;
+};
+
+std::unique_ptr<SplitGroupsBenchmark> benchmark;
+
+BENCHMARK(concurrentSplitGroups) {
+  benchmark->run(0);
+}
+
+BENCHMARK_RELATIVE(splitGroupsMemoryLimit) {
+  benchmark->run(1UL << 30);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+  OperatorTestBase::SetUpTestCase();
+  benchmark = std::make_unique<SplitGroupsBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  OperatorTestBase::TearDownTestCase();
+  return 0;
+}
@@ -239,6 +239,51 @@ BENCHMARK(computeValueIdsLowCardinalityNotAllUsed) {
   }
 }
 
+// Hashes 'numKeys' flat columns of 10K rows without nulls, like the keys of a
+// join or an aggregation that do not fit a value ID range.
+void benchmarkHashMultipleKeys(int32_t numKeys, bool strings) {
+  folly::BenchmarkSuspender suspender;
+  constexpr vector_size_t kSize = 10'000;
+  BenchmarkBase base;
+  std::vector<VectorPtr> keys;
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  for (auto i = 0; i < numKeys; ++i) {
+    if (strings) {
+      keys.push_back(base.vectorMaker().flatVector<StringView>(
+          kSize, [i](vector_size_t row) {
+            return StringView::makeInline(fmt::format("{}-{}", i, row));
+          }));
+    } else {
+      keys.push_back(base.vectorMaker().flatVector<int64_t>(
+          kSize, [i](vector_size_t row) { return row * 1'000'003 + i; }));
+    }
+    hashers.push_back(VectorHasher::create(keys.back()->type(), i));
+  }
+  SelectivityVector rows(kSize);
+  raw_vector<uint64_t> hashes(kSize);
+  suspender.dismiss();
+
+  for (int i = 0; i < 1'000; i++) {
+    for (auto j = 0; j < numKeys; ++j) {
+      hashers[j]->decode(*keys[j], rows);
+      hashers[j]->hash(rows, j > 0, hashes);
+    }
+    folly::doNotOptimizeAway(hashes[0]);
+  }
+}
+
+BENCHMARK(hashBigintKeys3) {
+  benchmarkHashMultipleKeys(3, false);
+}
+
+BENCHMARK(hashBigintKeys5) {
+  benchmarkHashMultipleKeys(5, false);
+}
+
+BENCHMARK(hashStringKeys3) {
+  benchmarkHashMultipleKeys(3, true);
+}
+
 int main(int argc, char** argv) {
   folly::Init init{&argc, &argv};
   memory::MemoryManager::initialize({});
@@ -391,7 +391,8 @@ velox::test::ResultOrError AggregationFuzzerBase::execute(
     const std::vector<exec::Split>& splits,
     bool injectSpill,
     bool abandonPartial,
-    int32_t maxDrivers) {
+    int32_t maxDrivers,
+    const std::unordered_map<std::string, std::string>& extraQueryConfigs) {
   LOG(INFO) << "Executing query plan: " << std::endl
             << plan->toString(true, true);
 
@@ -401,6 +402,7 @@ velox::test::ResultOrError AggregationFuzzerBase::execute(
     AssertQueryBuilder builder(plan);
 
     builder.configs(queryConfigs_);
+    builder.configs(extraQueryConfigs);
 
     int32_t spillPct{0};
     if (injectSpill) {
@@ -224,7 +224,9 @@ class AggregationFuzzerBase {
       const std::vector<exec::Split>& splits = {},
       bool injectSpill = false,
       bool abandonPartial = false,
-      int32_t maxDrivers = 2);
+      int32_t maxDrivers = 2,
+      const std::unordered_map<std::string, std::string>& extraQueryConfigs =
+          {});
 
   // Will throw if referenceQueryRunner doesn't support
   // returning results as a vector.
@@ -352,6 +352,20 @@ void WindowFuzzer::testAlternativePlans(
     testPlan(
         plan, false, false, customVerification, {customVerifier}, expected);
   }
+
+  // Sliding aggregate frames are evaluated over a segment tree. Checks them
+  // against the per-frame evaluation.
+  const auto actual = execute(
+      PlanBuilder()
+          .values(input)
+          .window({fmt::format("{} over ({})", functionCall, frame)})
+          .planNode(),
+      {},
+      false,
+      false,
+      2,
+      {{core::QueryConfig::kWindowSegmentTreeEnabled, "false"}});
+  compare(actual, customVerification, {customVerifier}, expected);
 }
 
 namespace {
@@ -22,6 +22,7 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
+#include "velox/type/StringView.h"
 #include "velox/type/Timestamp.h"
 #include "velox/type/Type.h"
 
@@ -34,7 +35,7 @@ class PrefixSortEncoder {
       : ascending_(ascending), nullsFirst_(nullsFirst){};
 
   /// Encode native primitive types(such as uint64_t, int64_t, uint32_t,
-  /// int32_t, float, double, Timestamp). TODO: Add support for strings.
+  /// int32_t, float, double, Timestamp).
   /// 1. The first byte of the encoded result is null byte. The value is 0 if
   ///    (nulls first and value is null) or (nulls last and value is not null).
   ///    Otherwise, the value is 1.
@@ -53,6 +54,47 @@ class PrefixSortEncoder {
     }
   }
 
+  /// Encode the first 'prefixLength' bytes of a string. The null byte is
+  /// set as for the fixed width types, the remaining 'prefixLength' bytes are
+  /// set by encodeNoNulls. Strings sharing the encoded prefix compare equal,
+  /// the caller needs to compare the full values to break such ties.
+  FOLLY_ALWAYS_INLINE void encode(
+      std::optional<StringView> value,
+      char* dest,
+      uint32_t prefixLength) const {
+    if (value.has_value()) {
+      dest[0] = nullsFirst_ ? 1 : 0;
+      encodeNoNulls(value.value(), dest + 1, prefixLength);
+    } else {
+      dest[0] = nullsFirst_ ? 0 : 1;
+      simd::memset(dest + 1, 0, prefixLength);
+    }
+  }
+
+  /// Sets the null byte of a value as 'encode' does.
+  FOLLY_ALWAYS_INLINE void encodeNullByte(bool isNull, char* dest) const {
+    dest[0] = isNull == nullsFirst_ ? 0 : 1;
+  }
+
+  /// Copies the first 'prefixLength' bytes of 'value' and pads shorter
+  /// strings with '\0'. Bytes compare unsigned as in StringView::compare, so
+  /// inverting the bits gives the descending order.
+  FOLLY_ALWAYS_INLINE void
+  encodeNoNulls(StringView value, char* dest, uint32_t prefixLength) const {
+    const uint32_t copySize = std::min<uint32_t>(value.size(), prefixLength);
+    if (copySize > 0) {
+      std::memcpy(dest, value.data(), copySize);
+    }
+    if (copySize < prefixLength) {
+      simd::memset(dest + copySize, 0, prefixLength - copySize);
+    }
+    if (!ascending_) {
+      for (auto i = 0; i < prefixLength; ++i) {
+        dest[i] = ~dest[i];
+      }
+    }
+  }
+
   /// @tparam T Type of value. Supported type are: uint64_t, int64_t, uint32_t,
   /// int32_t, float, double, Timestamp. TODO Add support for int16_t, uint16_t.
   template <typename T>
@@ -66,10 +108,19 @@ class PrefixSortEncoder {
     return nullsFirst_;
   }
 
+  /// Returns true if 'typeKind' is encoded as a prefix of the value that may
+  /// not decide the order of two values on its own.
+  FOLLY_ALWAYS_INLINE static bool isPrefixEncoded(TypeKind typeKind) {
+    return typeKind == TypeKind::VARCHAR || typeKind == TypeKind::VARBINARY;
+  }
+
   /// @return For supported types, returns the encoded size, assume nullable.
-  ///         For not supported types, returns 'std::nullopt'.
+  ///         For not supported types, returns 'std::nullopt'. VARCHAR and
+  ///         VARBINARY are encoded as a prefix of 'stringPrefixLength' bytes
+  ///         and are not supported if 'stringPrefixLength' is 0.
   FOLLY_ALWAYS_INLINE static std::optional<uint32_t> encodedSize(
-      TypeKind typeKind) {
+      TypeKind typeKind,
+      uint32_t stringPrefixLength = 0) {
     switch ((typeKind)) {
       case ::facebook::velox::TypeKind::INTEGER: {
         return 5;
@@ -86,11 +137,75 @@ class PrefixSortEncoder {
       case ::facebook::velox::TypeKind::TIMESTAMP: {
         return 17;
       }
+      case ::facebook::velox::TypeKind::VARCHAR:
+        [[fallthrough]];
+      case ::facebook::velox::TypeKind::VARBINARY: {
+        if (stringPrefixLength == 0) {
+          return std::nullopt;
+        }
+        return 1 + stringPrefixLength;
+      }
       default:
         return std::nullopt;
     }
   }
 
+  /// Returns the number of leading children of the ROW 'type' that are
+  /// encoded: the children up to the first one that can not be encoded or up
+  /// to and including the first prefix encoded one.
+  static uint32_t numEncodedChildren(
+      const TypePtr& type,
+      uint32_t stringPrefixLength = 0) {
+    VELOX_DCHECK_EQ(type->kind(), TypeKind::ROW);
+    uint32_t numChildren = 0;
+    for (const auto& child : type->asRow().children()) {
+      if (!encodedSize(child->kind(), stringPrefixLength).has_value()) {
+        break;
+      }
+      ++numChildren;
+      if (isPrefixEncoded(child->kind())) {
+        break;
+      }
+    }
+    return numChildren;
+  }
+
+  /// Same as above for scalar types. A ROW is encoded as its null byte
+  /// followed by the encodings of its 'numEncodedChildren' leading children.
+  /// Structs compare child by child, so the encoding keeps their order as far
+  /// as it is decided by the encoded children. A ROW without encoded children
+  /// is not supported.
+  static std::optional<uint32_t> encodedSize(
+      const TypePtr& type,
+      uint32_t stringPrefixLength = 0) {
+    if (type->kind() != TypeKind::ROW) {
+      return encodedSize(type->kind(), stringPrefixLength);
+    }
+    const auto numChildren = numEncodedChildren(type, stringPrefixLength);
+    if (numChildren == 0) {
+      return std::nullopt;
+    }
+    uint32_t size = 1;
+    for (auto i = 0; i < numChildren; ++i) {
+      size += encodedSize(type->childAt(i)->kind(), stringPrefixLength).value();
+    }
+    return size;
+  }
+
+  /// Same as above for scalar types. A ROW is prefix encoded if not all of its
+  /// children are encoded or if its last encoded child is prefix encoded.
+  static bool isPrefixEncoded(
+      const TypePtr& type,
+      uint32_t stringPrefixLength = 0) {
+    if (type->kind() != TypeKind::ROW) {
+      return isPrefixEncoded(type->kind());
+    }
+    const auto numChildren = numEncodedChildren(type, stringPrefixLength);
+    return numChildren < type->size() ||
+        (numChildren > 0 &&
+         isPrefixEncoded(type->childAt(numChildren - 1)->kind()));
+  }
+
  private:
   const bool ascending_;
   const bool nullsFirst_;
@@ -337,6 +337,80 @@ TEST_F(PrefixEncoderTest, compare) {
   testCompare<Timestamp>();
 }
 
+TEST_F(PrefixEncoderTest, string) {
+  const PrefixSortEncoder ascEncoder = {true, true};
+  const PrefixSortEncoder descEncoder = {false, false};
+  const uint32_t prefixLength = 4;
+  char encoded[prefixLength + 1];
+
+  ascEncoder.encode(std::optional<StringView>("ab"), encoded, prefixLength);
+  ASSERT_EQ(std::memcmp(encoded, "\1ab\0\0", prefixLength + 1), 0);
+  ascEncoder.encode(
+      std::optional<StringView>("abcdef"), encoded, prefixLength);
+  ASSERT_EQ(std::memcmp(encoded, "\1abcd", prefixLength + 1), 0);
+  ascEncoder.encode(std::optional<StringView>(), encoded, prefixLength);
+  ASSERT_EQ(std::memcmp(encoded, "\0\0\0\0\0", prefixLength + 1), 0);
+
+  descEncoder.encode(std::optional<StringView>("ab"), encoded, prefixLength);
+  ASSERT_EQ(encoded[0], 0);
+  ASSERT_EQ(encoded[1], (char)~'a');
+  ASSERT_EQ(encoded[2], (char)~'b');
+  ASSERT_EQ(encoded[3], (char)0xff);
+  ASSERT_EQ(encoded[4], (char)0xff);
+
+  // The encoded prefixes keep the order of the values they do not tie on.
+  const std::vector<std::string> values = {
+      "", "\x01", "a", "ab", "abc", "b", "\xff", "\xff\xff"};
+  for (const auto& encoder : {ascEncoder, descEncoder}) {
+    for (auto i = 1; i < values.size(); ++i) {
+      char left[prefixLength + 1];
+      char right[prefixLength + 1];
+      encoder.encode(
+          std::optional<StringView>(values[i - 1]), left, prefixLength);
+      encoder.encode(std::optional<StringView>(values[i]), right, prefixLength);
+      const auto result = std::memcmp(left, right, prefixLength + 1);
+      if (encoder.isAscending()) {
+        ASSERT_LT(result, 0) << values[i];
+      } else {
+        ASSERT_GT(result, 0) << values[i];
+      }
+    }
+  }
+
+  ASSERT_FALSE(
+      PrefixSortEncoder::encodedSize(TypeKind::VARCHAR).has_value());
+  ASSERT_EQ(
+      PrefixSortEncoder::encodedSize(TypeKind::VARBINARY, 12).value(), 13);
+}
+
+TEST_F(PrefixEncoderTest, rowEncodedSize) {
+  // All children are encoded.
+  auto type = ROW({BIGINT(), DOUBLE()});
+  ASSERT_EQ(PrefixSortEncoder::numEncodedChildren(type), 2);
+  ASSERT_EQ(PrefixSortEncoder::encodedSize(type).value(), 1 + 9 + 9);
+  ASSERT_FALSE(PrefixSortEncoder::isPrefixEncoded(type));
+
+  // A string child ends the encoded children.
+  type = ROW({INTEGER(), VARCHAR(), BIGINT()});
+  ASSERT_EQ(PrefixSortEncoder::numEncodedChildren(type), 1);
+  ASSERT_EQ(PrefixSortEncoder::encodedSize(type).value(), 1 + 5);
+  ASSERT_TRUE(PrefixSortEncoder::isPrefixEncoded(type));
+  ASSERT_EQ(PrefixSortEncoder::numEncodedChildren(type, 8), 2);
+  ASSERT_EQ(PrefixSortEncoder::encodedSize(type, 8).value(), 1 + 5 + 9);
+  ASSERT_TRUE(PrefixSortEncoder::isPrefixEncoded(type, 8));
+
+  type = ROW({INTEGER(), VARCHAR()});
+  ASSERT_TRUE(PrefixSortEncoder::isPrefixEncoded(type, 8));
+
+  // Children that can not be encoded end the encoded children.
+  type = ROW({TIMESTAMP(), ARRAY(BIGINT())});
+  ASSERT_EQ(PrefixSortEncoder::encodedSize(type).value(), 1 + 17);
+  ASSERT_TRUE(PrefixSortEncoder::isPrefixEncoded(type));
+
+  type = ROW({ARRAY(BIGINT()), BIGINT()});
+  ASSERT_FALSE(PrefixSortEncoder::encodedSize(type).has_value());
+}
+
 TEST_F(PrefixEncoderTest, fuzzyInteger) {
   testFuzz<TypeKind::INTEGER>();
 }
@@ -68,13 +68,17 @@ void AggregateSpillBenchmarkBase::setUp() {
 }
 
 void AggregateSpillBenchmarkBase::run() {
-  MicrosecondTimer timer(&executionTimeUs_);
-  if (spillerType_ == Spiller::Type::kAggregateInput) {
-    spiller_->spill();
-  } else {
-    spiller_->spill(RowContainerIterator{});
+  const auto startCpuTimeUs = processCpuTimeUs();
+  {
+    MicrosecondTimer timer(&executionTimeUs_);
+    if (spillerType_ == Spiller::Type::kAggregateOutput) {
+      spiller_->spill(RowContainerIterator{});
+    } else {
+      spiller_->spill();
+    }
+    rowContainer_->clear();
   }
-  rowContainer_->clear();
+  executionCpuTimeUs_ = processCpuTimeUs() - startCpuTimeUs;
 }
 
 void AggregateSpillBenchmarkBase::printStats() const {
@@ -91,7 +95,7 @@ void AggregateSpillBenchmarkBase::printStats() const {
   // List files under file path.
   SpillPartitionSet partitionSet;
   spiller_->finishSpill(partitionSet);
-  VELOX_CHECK_EQ(partitionSet.size(), 1);
+  LOG(INFO) << partitionSet.size() << " partitions have been spilled";
   const auto files = fs_->list(spillDir_);
   for (const auto& file : files) {
     auto rfile = fs_->openFileForRead(file);
@@ -138,7 +142,8 @@ std::unique_ptr<Spiller> AggregateSpillBenchmarkBase::makeSpiller() {
   spillConfig.maxSpillRunRows = 0;
   spillConfig.fileCreateConfig = {};
 
-  if (spillerType_ == Spiller::Type::kAggregateInput) {
+  if (spillerType_ == Spiller::Type::kAggregateInput ||
+      spillerType_ == Spiller::Type::kOrderByInput) {
     return std::make_unique<Spiller>(
         spillerType_,
         rowContainer_.get(),
@@ -147,6 +152,14 @@ std::unique_ptr<Spiller> AggregateSpillBenchmarkBase::makeSpiller() {
         std::vector<CompareFlags>{},
         &spillConfig,
         &spillStats_);
+  } else if (spillerType_ == Spiller::Type::kAggregateInputPartitioned) {
+    return std::make_unique<Spiller>(
+        spillerType_,
+        rowContainer_.get(),
+        rowType_,
+        HashBitRange{29, 29 + FLAGS_spiller_benchmark_num_partition_bits},
+        &spillConfig,
+        &spillStats_);
   } else {
     // TODO: Add config flag to control the max spill rows.
     return std::make_unique<Spiller>(
@@ -890,6 +890,53 @@ TEST_F(AggregationTest, partialAggregationMemoryLimit) {
           .customStats.count("flushRowCount"));
 }
 
+TEST_F(AggregationTest, partialAggregationClusteredFlush) {
+  // Input sorted on c0, so that each batch continues the last group of the
+  // previous one.
+  std::vector<RowVectorPtr> sorted;
+  std::vector<RowVectorPtr> unsorted;
+  for (auto i = 0; i < 10; ++i) {
+    sorted.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            100, [i](auto row) { return (i * 100 + row) / 3; }),
+        makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+    }));
+    unsorted.push_back(makeRowVector({
+        makeFlatVector<int64_t>(100, [](auto row) { return row % 37; }),
+        makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+    }));
+  }
+
+  auto testClusteredFlush = [&](const std::vector<RowVectorPtr>& input,
+                                bool expectFlush) {
+    createDuckDbTable(input);
+    core::PlanNodeId aggNodeId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kPartialAggregationClusteredFlushEnabled, true)
+            .config(QueryConfig::kPreferredOutputBatchRows, 50)
+            .plan(PlanBuilder()
+                      .values(input)
+                      .partialAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                      .capturePlanNodeId(aggNodeId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults(
+                "SELECT c0, sum(c1), count(1) FROM tmp GROUP BY 1");
+    const auto stats = toPlanStats(task->taskStats()).at(aggNodeId);
+    if (expectFlush) {
+      ASSERT_GT(stats.customStats.at("clusteredFlushTimes").sum, 0);
+      // Groups are flushed in batches, not one by one.
+      ASSERT_LT(stats.outputRows, 400);
+    } else {
+      ASSERT_EQ(stats.customStats.count("clusteredFlushTimes"), 0);
+    }
+  };
+
+  testClusteredFlush(sorted, true);
+  testClusteredFlush(unsorted, false);
+}
+
 TEST_F(AggregationTest, partialDistinctWithAbandon) {
   auto vectors = {
       // 1st batch will produce 100 distinct groups from 10 rows.
@@ -936,6 +983,59 @@ TEST_F(AggregationTest, partialDistinctWithAbandon) {
              .assertResults("SELECT distinct c0, sum(c0) FROM tmp group by c0");
 }
 
+TEST_F(AggregationTest, partialAggregationAbandonByKeySketch) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return i * 1'000 + row; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row % 10; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  struct {
+    std::string key;
+    bool expectAbandon;
+
+    std::string debugString() const {
+      return fmt::format("key {}, expectAbandon {}", key, expectAbandon);
+    }
+  } testSettings[] = {{"c0", true}, {"c1", false}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    core::PlanNodeId aggNodeId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            // Only the key sketch can trigger the abandonment.
+            .config(QueryConfig::kAbandonPartialAggregationMinRows, 1'000'000)
+            .config(QueryConfig::kAbandonPartialAggregationSketchRows, 2'000)
+            .config(QueryConfig::kAbandonPartialAggregationMinPct, 80)
+            .config("max_drivers_per_task", 1)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation({testData.key}, {"count(1)"})
+                      .capturePlanNodeId(aggNodeId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults(fmt::format(
+                "SELECT {0}, count(1) FROM tmp GROUP BY {0}", testData.key));
+
+    auto runtimeStats =
+        toPlanStats(task->taskStats()).at(aggNodeId).customStats;
+    ASSERT_EQ(runtimeStats.count("estimatedNumDistinctKeys"), 1);
+    ASSERT_EQ(runtimeStats.at("estimatedPartialAggregationPct").count, 1);
+    if (testData.expectAbandon) {
+      ASSERT_GE(runtimeStats.at("estimatedPartialAggregationPct").sum, 80);
+      ASSERT_EQ(runtimeStats.count("abandonedPartialAggregation"), 1);
+    } else {
+      ASSERT_LT(runtimeStats.at("estimatedPartialAggregationPct").sum, 80);
+      ASSERT_EQ(runtimeStats.count("abandonedPartialAggregation"), 0);
+    }
+  }
+}
+
 TEST_F(AggregationTest, largeValueRangeArray) {
   // We have keys that map to integer range. The keys are
   // a little under max array hash table size apart. This wastes 16MB of
@@ -1147,6 +1247,114 @@ TEST_F(AggregationTest, spillAll) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(AggregationTest, asyncMemoryReservation) {
+  auto inputs = makeVectors(rowType_, 100, 10);
+  createDuckDbTable(inputs);
+  auto plan = PlanBuilder()
+                  .values(inputs)
+                  .singleAggregation({"c0"}, {"sum(c1)", "max(c6)"})
+                  .planNode();
+  const std::string sql = "SELECT c0, sum(c1), max(c6) FROM tmp GROUP BY c0";
+
+  for (const bool asyncReservation : {false, true}) {
+    SCOPED_TRACE(fmt::format("asyncReservation {}", asyncReservation));
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    auto queryCtx = std::make_shared<core::QueryCtx>(
+        executor_.get(),
+        core::QueryConfig({}),
+        std::unordered_map<std::string, std::shared_ptr<Config>>{},
+        cache::AsyncDataCache::getInstance(),
+        nullptr,
+        executor_.get());
+    // Makes the reservation grow on every input.
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .queryCtx(queryCtx)
+            .spillDirectory(tempDirectory->getPath())
+            .config(QueryConfig::kSpillEnabled, true)
+            .config(QueryConfig::kAggregationSpillEnabled, true)
+            .config(QueryConfig::kMinSpillableReservationPct, 100)
+            .config(
+                QueryConfig::kAsyncMemoryReservationEnabled, asyncReservation)
+            .assertResults(sql);
+
+    auto runtimeStats =
+        task->taskStats().pipelineStats[0].operatorStats[1].runtimeStats;
+    if (asyncReservation) {
+      ASSERT_LT(0, runtimeStats["blockedWaitForMemoryTimes"].count);
+    } else {
+      ASSERT_EQ(0, runtimeStats.count("blockedWaitForMemoryTimes"));
+    }
+  }
+}
+
+TEST_F(AggregationTest, partitionedSpill) {
+  auto vectors = makeVectors(rowType_, 100, 10);
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId aggrNodeId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation(
+                      {"c0", "c1"}, {"sum(c2)", "min(c6)", "count(c3)"})
+                  .capturePlanNodeId(aggrNodeId)
+                  .planNode();
+  const std::string sql =
+      "SELECT c0, c1, sum(c2), min(c6), count(c3) FROM tmp GROUP BY c0, c1";
+
+  for (int32_t maxSpillLevel : {0, 1}) {
+    SCOPED_TRACE(fmt::format("maxSpillLevel {}", maxSpillLevel));
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                    .spillDirectory(spillDirectory->getPath())
+                    .config(QueryConfig::kSpillEnabled, true)
+                    .config(QueryConfig::kAggregationSpillEnabled, true)
+                    .config(QueryConfig::kAggregationSpillPartitioned, true)
+                    .config(QueryConfig::kSpillNumPartitionBits, 2)
+                    .config(QueryConfig::kMaxSpillLevel, maxSpillLevel)
+                    .plan(plan)
+                    .assertResults(sql);
+
+    auto planStats = toPlanStats(task->taskStats());
+    auto& stats = planStats.at(aggrNodeId);
+    ASSERT_GT(stats.spilledRows, 0);
+    ASSERT_GT(stats.spilledBytes, 0);
+    // The spilled groups are not sorted.
+    ASSERT_EQ(stats.customStats[Operator::kSpillSortTime].sum, 0);
+    if (maxSpillLevel == 0) {
+      // The restored partitions can't be spilled again.
+      ASSERT_EQ(stats.spilledPartitions, 4);
+      ASSERT_GT(stats.customStats[Operator::kExceededMaxSpillLevel].sum, 0);
+    } else {
+      // The restored partitions are spilled into the next level partitions.
+      ASSERT_GT(stats.spilledPartitions, 4);
+    }
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+
+  // The distinct aggregation always spills sorted runs.
+  {
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->getPath())
+            .config(QueryConfig::kSpillEnabled, true)
+            .config(QueryConfig::kAggregationSpillEnabled, true)
+            .config(QueryConfig::kAggregationSpillPartitioned, true)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .singleAggregation({"c0"}, {})
+                      .capturePlanNodeId(aggrNodeId)
+                      .planNode())
+            .assertResults("SELECT distinct c0 FROM tmp");
+    auto planStats = toPlanStats(task->taskStats());
+    ASSERT_EQ(planStats.at(aggrNodeId).spilledPartitions, 1);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+}
+
 // Verify number of memory allocations in the HashAggregation operator.
 TEST_F(AggregationTest, memoryAllocations) {
   vector_size_t size = 1'024;
@@ -1514,6 +1722,122 @@ TEST_F(AggregationTest, groupingSetsEmptyInput) {
       }));
 }
 
+TEST_F(AggregationTest, groupingSetsRollup) {
+  vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"k1", "k2", "a", "b"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 11; }),
+          makeFlatVector<int64_t>(
+              size, [](auto row) { return row % 17; }, nullEvery(7)),
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<std::string>(
+              size, [](auto row) { return std::string(row % 12, 'x'); }),
+      });
+
+  createDuckDbTable({data});
+
+  core::PlanNodeId groupIdNodeId;
+  core::PlanNodeId aggNodeId;
+  auto plan =
+      PlanBuilder()
+          .values({data})
+          .groupId({"k1", "k2"}, {{"k1", "k2"}, {"k1"}, {"k2"}, {}}, {"a", "b"})
+          .capturePlanNodeId(groupIdNodeId)
+          .singleAggregation(
+              {"k1", "k2", "group_id"},
+              {"count(1) as count_1",
+               "count(k2) as count_k2",
+               "sum(a) as sum_a",
+               "avg(a) as avg_a",
+               "max(b) as max_b"})
+          .capturePlanNodeId(aggNodeId)
+          .project(
+              {"k1", "k2", "count_1", "count_k2", "sum_a", "avg_a", "max_b"})
+          .planNode();
+  const std::string sql =
+      "SELECT k1, k2, count(1), count(k2), sum(a), avg(a), max(b) FROM tmp "
+      "GROUP BY CUBE (k1, k2)";
+
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .config(QueryConfig::kGroupingSetsRollupEnabled, true)
+                  .assertResults(sql);
+  // GroupId expands one row per distinct combination of the keys.
+  std::set<std::pair<int64_t, std::optional<int64_t>>> keys;
+  for (auto row = 0; row < size; ++row) {
+    keys.insert(
+        {row % 11,
+         row % 7 == 0 ? std::nullopt : std::optional<int64_t>(row % 17)});
+  }
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(planStats.at(aggNodeId + ".rollup").inputRows, size);
+  ASSERT_EQ(planStats.at(groupIdNodeId).inputRows, keys.size());
+
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_).assertResults(sql);
+  ASSERT_EQ(toPlanStats(task->taskStats()).count(aggNodeId + ".rollup"), 0);
+
+  // Partial and final aggregation.
+  plan = PlanBuilder()
+             .values({data})
+             .groupId({"k1", "k2"}, {{"k1", "k2"}, {"k1"}, {}}, {"a", "b"})
+             .partialAggregation(
+                 {"k1", "k2", "group_id"},
+                 {"count(1) as count_1", "sum(a) as sum_a", "max(b) as max_b"})
+             .capturePlanNodeId(aggNodeId)
+             .finalAggregation()
+             .project({"k1", "k2", "count_1", "sum_a", "max_b"})
+             .planNode();
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config(QueryConfig::kGroupingSetsRollupEnabled, true)
+             .assertResults(
+                 "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp "
+                 "GROUP BY ROLLUP (k1, k2)");
+  ASSERT_EQ(toPlanStats(task->taskStats()).count(aggNodeId + ".rollup"), 1);
+
+  // Masks are evaluated on the expanded rows, so the aggregation is not
+  // rewritten.
+  plan = PlanBuilder()
+             .values({data})
+             .groupId({"k1", "k2"}, {{"k1"}, {"k2"}}, {"a", "b"})
+             .project(
+                 {"k1",
+                  "k2",
+                  "group_id",
+                  "a",
+                  "b",
+                  "group_id = 0 as mask_a",
+                  "group_id = 1 as mask_b"})
+             .singleAggregation(
+                 {"k1", "k2", "group_id"},
+                 {"sum(a) as sum_a", "max(b) as max_b"},
+                 {"mask_a", "mask_b"})
+             .capturePlanNodeId(aggNodeId)
+             .project({"k1", "k2", "sum_a", "max_b"})
+             .planNode();
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config(QueryConfig::kGroupingSetsRollupEnabled, true)
+             .assertResults(
+                 "SELECT k1, null, sum(a), null FROM tmp GROUP BY k1 "
+                 "UNION ALL "
+                 "SELECT null, k2, null, max(b) FROM tmp GROUP BY k2");
+  ASSERT_EQ(toPlanStats(task->taskStats()).count(aggNodeId + ".rollup"), 0);
+
+  // Empty input with a global grouping set.
+  plan =
+      PlanBuilder()
+          .values({data})
+          .filter("k1 < 0")
+          .groupId({"k1"}, {{"k1"}, {}}, {"a"})
+          .singleAggregation({"k1", "group_id"}, {"count(a) as count_a"})
+          .project({"count_a"})
+          .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(QueryConfig::kGroupingSetsRollupEnabled, true)
+      .assertResults(
+          "SELECT count(a) FROM tmp WHERE k1 < 0 "
+          "GROUP BY GROUPING SETS ((k1), ())");
+}
+
 TEST_F(AggregationTest, outputBatchSizeCheckWithSpill) {
   const int numVectors = 5;
   const int vectorSize = 20;
@@ -1832,6 +2156,70 @@ TEST_F(AggregationTest, spillingForAggrsWithDistinct) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(AggregationTest, distinctAsGroupBy) {
+  auto vectors = makeVectors(rowType_, 100, 10);
+  createDuckDbTable(vectors);
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  core::PlanNodeId aggrNodeId;
+
+  auto testPlan = [&](const std::vector<std::string>& groupingKeys,
+                      const std::vector<std::string>& aggregates,
+                      const std::string& sql,
+                      bool rewritten) {
+    SCOPED_TRACE(sql);
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->getPath())
+            .config(QueryConfig::kSpillEnabled, true)
+            .config(QueryConfig::kAggregationSpillEnabled, true)
+            .config(QueryConfig::kDistinctAggregationAsGroupByEnabled, true)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .singleAggregation(groupingKeys, aggregates)
+                      .capturePlanNodeId(aggrNodeId)
+                      .planNode())
+            .assertResults(sql);
+    auto planStats = toPlanStats(task->taskStats());
+    ASSERT_EQ(planStats.count(aggrNodeId + ".distinct"), rewritten ? 1 : 0);
+    if (rewritten) {
+      // Unlike the sets of the distinct aggregates, the duplicate removal
+      // spills.
+      ASSERT_GT(planStats.at(aggrNodeId + ".distinct").spilledBytes, 0);
+    }
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  };
+
+  testPlan(
+      {"c1"},
+      {"count(DISTINCT c0)", "sum(DISTINCT c0)"},
+      "SELECT c1, count(DISTINCT c0), sum(DISTINCT c0) FROM tmp GROUP BY c1",
+      true);
+  testPlan(
+      {"c1"},
+      {"count(DISTINCT c1)"},
+      "SELECT c1, count(DISTINCT c1) FROM tmp GROUP BY c1",
+      true);
+  testPlan(
+      {},
+      {"count(DISTINCT c2)", "max(DISTINCT c2)"},
+      "SELECT count(DISTINCT c2), max(DISTINCT c2) FROM tmp",
+      true);
+
+  // Distinct aggregates over different columns, or mixed with other
+  // aggregates, keep their sets.
+  testPlan(
+      {"c1"},
+      {"count(DISTINCT c0)", "count(DISTINCT c2)"},
+      "SELECT c1, count(DISTINCT c0), count(DISTINCT c2) FROM tmp GROUP BY c1",
+      false);
+  testPlan(
+      {"c1"},
+      {"count(DISTINCT c0)", "sum(c2)"},
+      "SELECT c1, count(DISTINCT c0), sum(c2) FROM tmp GROUP BY c1",
+      false);
+}
+
 TEST_F(AggregationTest, spillingForAggrsWithSorting) {
   auto vectors = makeVectors(rowType_, 100, 10);
   createDuckDbTable(vectors);
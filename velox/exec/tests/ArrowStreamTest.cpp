@@ -202,6 +202,44 @@ TEST_F(ArrowStreamTest, basic) {
   assertQuery(plan, "SELECT * FROM tmp");
 }
 
+TEST_F(ArrowStreamTest, prefetch) {
+  vector_size_t size = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(
+             size, [&](auto row) { return size * i + row; }, nullEvery(5)),
+         makeFlatVector<std::string>(
+             size, [](auto row) { return std::string(row % 30, 'x'); })}));
+  }
+  createDuckDbTable(vectors);
+  auto type = asRowType(vectors[0]->type());
+  for (const auto* prefetchBatches : {"1", "3", "20"}) {
+    SCOPED_TRACE(prefetchBatches);
+    struct ArrowArrayStream arrowStream;
+    exportArrowStream(
+        std::make_shared<ArrowReader>(pool_, vectors, type), &arrowStream);
+    auto plan = std::make_shared<core::ArrowStreamNode>(
+        "0", type, std::make_shared<ArrowArrayStream>(arrowStream));
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kArrowStreamPrefetchBatches, prefetchBatches)
+        .assertResults("SELECT * FROM tmp");
+  }
+
+  // Errors of the background fetches are thrown by the driver.
+  struct ArrowArrayStream arrowStream;
+  exportArrowStream(
+      std::make_shared<ArrowReader>(pool_, vectors, type, true, false),
+      &arrowStream);
+  auto plan = std::make_shared<core::ArrowStreamNode>(
+      "0", type, std::make_shared<ArrowArrayStream>(arrowStream));
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kArrowStreamPrefetchBatches, "2")
+          .copyResults(pool_.get()),
+      "Failed to call get_next on ArrowStream: get_next failed.");
+}
+
 TEST_F(ArrowStreamTest, error) {
   vector_size_t size = 1'000;
   std::vector<RowVectorPtr> vectors;
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class CoalesceBatchesTest : public OperatorTestBase {
+ protected:
+  // 30 batches of 100 rows with c0 counting up from 0.
+  std::vector<RowVectorPtr> makeBatches() {
+    std::vector<RowVectorPtr> batches;
+    for (auto i = 0; i < 30; ++i) {
+      batches.push_back(makeRowVector({
+          makeFlatVector<int64_t>(100, [&](auto row) { return i * 100 + row; }),
+          makeFlatVector<StringView>(
+              100, [](auto row) { return StringView::makeInline("s"); }),
+      }));
+    }
+    return batches;
+  }
+
+  // Runs 'plan' with coalescing to 100 rows if 'coalesce' and returns the
+  // stats of the CoalesceBatches operator of 'nodeId' or nullptr if there is
+  // none.
+  std::unique_ptr<PlanNodeStats> run(
+      const core::PlanNodePtr& plan,
+      const core::PlanNodeId& nodeId,
+      bool coalesce,
+      const RowVectorPtr& expected) {
+    std::shared_ptr<Task> task;
+    auto result = AssertQueryBuilder(plan)
+                      .config(
+                          core::QueryConfig::kCoalesceBatches,
+                          coalesce ? "true" : "false")
+                      .config(core::QueryConfig::kMaxOutputBatchRows, "100")
+                      .copyResults(pool(), task);
+    // A single driver keeps the order of the rows.
+    assertEqualVectors(expected, result);
+    auto planStats = toPlanStats(task->taskStats());
+    auto& operatorStats = planStats.at(nodeId).operatorStats;
+    auto it = operatorStats.find("CoalesceBatches");
+    if (it == operatorStats.end()) {
+      return nullptr;
+    }
+    return std::move(it->second);
+  }
+};
+
+TEST_F(CoalesceBatchesTest, selectiveFilter) {
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values(makeBatches())
+                  .filter("c0 % 100 < 10")
+                  .project({"c0 + 1 as c0", "c1"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(
+          300, [](auto row) { return row / 10 * 100 + row % 10 + 1; }),
+      makeFlatVector<StringView>(
+          300, [](auto row) { return StringView::makeInline("s"); }),
+  });
+
+  ASSERT_EQ(run(plan, projectId, false, expected), nullptr);
+
+  auto stats = run(plan, projectId, true, expected);
+  ASSERT_NE(stats, nullptr);
+  ASSERT_EQ(stats->inputVectors, 30);
+  // Batches of 10 rows are merged until they have half of 100 rows.
+  ASSERT_EQ(stats->outputVectors, 6);
+  ASSERT_EQ(stats->outputRows, 300);
+  ASSERT_EQ(stats->customStats.at("coalescedInputBatches").sum, 30);
+}
+
+TEST_F(CoalesceBatchesTest, largeBatches) {
+  core::PlanNodeId filterId;
+  auto plan = PlanBuilder()
+                  .values(makeBatches())
+                  .filter("c0 % 100 < 90")
+                  .capturePlanNodeId(filterId)
+                  .project({"c0"})
+                  .planNode();
+  auto expected = makeRowVector({makeFlatVector<int64_t>(
+      2'700, [](auto row) { return row / 90 * 100 + row % 90; })});
+
+  // Batches of 90 rows pass through.
+  auto stats = run(plan, filterId, true, expected);
+  ASSERT_NE(stats, nullptr);
+  ASSERT_EQ(stats->inputVectors, 30);
+  ASSERT_EQ(stats->outputVectors, 30);
+  ASSERT_EQ(stats->customStats.count("coalescedInputBatches"), 0);
+}
+
+TEST_F(CoalesceBatchesTest, mixedBatches) {
+  // Small batches before a large one are produced first.
+  std::vector<RowVectorPtr> batches;
+  for (auto size : {10, 10, 80, 10, 10, 10}) {
+    batches.push_back(makeRowVector({makeFlatVector<int64_t>(
+        size, [&](auto row) { return batches.size() * 100 + row; })}));
+  }
+  auto plan = PlanBuilder().values(batches).filter("c0 >= 0").planNode();
+  auto expected = makeRowVector({makeFlatVector<int64_t>(
+      130, [](auto row) {
+        const int64_t sizes[] = {10, 10, 80, 10, 10, 10};
+        int64_t batch = 0;
+        while (row >= sizes[batch]) {
+          row -= sizes[batch++];
+        }
+        return batch * 100 + row;
+      })});
+
+  auto stats = run(plan, plan->id(), true, expected);
+  ASSERT_NE(stats, nullptr);
+  ASSERT_EQ(stats->inputVectors, 6);
+  // [10, 10], [80] and [10, 10, 10] at the end of the input.
+  ASSERT_EQ(stats->outputVectors, 3);
+  ASSERT_EQ(stats->customStats.at("coalescedInputBatches").sum, 5);
+}
+
+TEST_F(CoalesceBatchesTest, hashProbe) {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId joinId;
+  auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .values(makeBatches())
+          .hashJoin(
+              {"c0"},
+              {"u0"},
+              PlanBuilder(planNodeIdGenerator)
+                  .values({makeRowVector(
+                      {"u0"},
+                      {makeFlatVector<int64_t>(
+                          300, [](auto row) { return row * 10; })})})
+                  .planNode(),
+              "",
+              {"c0"})
+          .capturePlanNodeId(joinId)
+          .project({"c0"})
+          .planNode();
+  auto expected = makeRowVector(
+      {makeFlatVector<int64_t>(300, [](auto row) { return row * 10; })});
+
+  auto stats = run(plan, joinId, true, expected);
+  ASSERT_NE(stats, nullptr);
+  ASSERT_EQ(stats->inputVectors, 30);
+  ASSERT_EQ(stats->outputVectors, 6);
+}
+
+TEST_F(CoalesceBatchesTest, nodeTotals) {
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values(makeBatches())
+                  .filter("c0 % 100 < 10")
+                  .project({"c0"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+
+  auto nodeStats = [&](bool coalesce) {
+    std::shared_ptr<Task> task;
+    AssertQueryBuilder(plan)
+        .config(
+            core::QueryConfig::kCoalesceBatches, coalesce ? "true" : "false")
+        .config(core::QueryConfig::kMaxOutputBatchRows, "100")
+        .copyResults(pool(), task);
+    return std::move(toPlanStats(task->taskStats()).at(projectId));
+  };
+
+  const auto expected = nodeStats(false);
+  const auto stats = nodeStats(true);
+  // The CoalesceBatches stats are reported in the breakdown by operator type
+  // only.
+  ASSERT_EQ(stats.operatorStats.count("CoalesceBatches"), 1);
+  ASSERT_FALSE(stats.isMultiOperatorTypeNode());
+  ASSERT_EQ(stats.inputRows, expected.inputRows);
+  ASSERT_EQ(stats.inputVectors, expected.inputVectors);
+  ASSERT_EQ(stats.outputRows, expected.outputRows);
+  ASSERT_EQ(stats.outputVectors, expected.outputVectors);
+  ASSERT_EQ(stats.outputVectors, 30);
+  ASSERT_EQ(stats.numDrivers, expected.numDrivers);
+}
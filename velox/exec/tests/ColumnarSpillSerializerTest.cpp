@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/ColumnarSpillSerializer.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+class ColumnarSpillSerializerTest : public testing::Test,
+                                    public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  // Serializes 'batches' as one spill batch and returns it.
+  std::unique_ptr<folly::IOBuf> serialize(
+      const std::vector<RowVectorPtr>& batches,
+      common::CompressionKind compressionKind =
+          common::CompressionKind::CompressionKind_NONE) {
+    ColumnarSpillSerializer serializer(
+        asRowType(batches[0]->type()), compressionKind, pool());
+    for (const auto& batch : batches) {
+      IndexRange range{0, batch->size()};
+      serializer.append(batch, folly::Range<IndexRange*>(&range, 1));
+    }
+    IOBufOutputStream out(*pool());
+    serializer.flush(&out);
+    EXPECT_EQ(serializer.numRows(), 0);
+    return out.getIOBuf();
+  }
+
+  RowVectorPtr read(
+      const folly::IOBuf& batch,
+      const RowTypePtr& type,
+      const std::vector<column_index_t>& projection = {},
+      common::CompressionKind compressionKind =
+          common::CompressionKind::CompressionKind_NONE) {
+    std::vector<ByteRange> ranges;
+    for (auto range : batch) {
+      ranges.push_back(
+          {const_cast<uint8_t*>(range.data()),
+           static_cast<int32_t>(range.size()),
+           0});
+    }
+    ByteInputStream input(std::move(ranges));
+    auto result = ColumnarSpillSerializer::read(
+        &input, type, projection, compressionKind, pool());
+    EXPECT_TRUE(input.atEnd());
+    return result;
+  }
+
+  // Serializes and reads back 'batches' and checks that the result has their
+  // rows.
+  RowVectorPtr roundTrip(const std::vector<RowVectorPtr>& batches) {
+    const auto type = asRowType(batches[0]->type());
+    auto result = read(*serialize(batches), type);
+    auto expected = BaseVector::create<RowVector>(type, 0, pool());
+    for (const auto& batch : batches) {
+      expected->append(batch.get());
+    }
+    velox::test::assertEqualVectors(expected, result);
+    return result;
+  }
+};
+
+TEST_F(ColumnarSpillSerializerTest, flatColumns) {
+  const vector_size_t size = 1'000;
+  auto batch = makeRowVector({
+      makeFlatVector<int8_t>(size, [](auto row) { return row % 7 - 3; }),
+      makeFlatVector<int16_t>(size, [](auto row) { return row * 11; }),
+      makeFlatVector<int32_t>(
+          size, [](auto row) { return 1'000'000 + row; }, nullEvery(5)),
+      makeFlatVector<int64_t>(
+          size,
+          [](auto row) {
+            return row % 2 == 0 ? std::numeric_limits<int64_t>::min()
+                                : std::numeric_limits<int64_t>::max();
+          }),
+      // Few distinct strings.
+      makeFlatVector<std::string>(
+          size,
+          [](auto row) { return std::string(20 + row % 3, 'a' + row % 3); },
+          nullEvery(7)),
+      // Distinct strings.
+      makeFlatVector<std::string>(
+          size, [](auto row) { return fmt::format("string {}", row * 17); }),
+      makeFlatVector<double>(size, [](auto row) { return row / 3.0; }),
+      makeFlatVector<Timestamp>(
+          size, [](auto row) { return Timestamp(row, row * 1'001); }),
+      makeArrayVector<int32_t>(
+          size,
+          [](auto row) { return row % 4; },
+          [](auto row) { return row; }),
+      makeAllNullFlatVector<int64_t>(size),
+  });
+
+  auto result = roundTrip({batch});
+  ASSERT_EQ(
+      result->childAt(4)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(result->childAt(5)->encoding(), VectorEncoding::Simple::FLAT);
+
+  // The integers take no more bytes than their range needs.
+  auto ints = makeRowVector({makeFlatVector<int64_t>(
+      size, [](auto row) { return 1'000'000'000'000 + row % 200; })});
+  ASSERT_LT(serialize({ints})->computeChainDataLength(), size + 100);
+  roundTrip({ints});
+}
+
+TEST_F(ColumnarSpillSerializerTest, keepEncodings) {
+  const vector_size_t size = 100;
+  auto names = makeFlatVector<std::string>(
+      10, [](auto row) { return fmt::format("a long name {}", row); });
+  auto makeBatch = [&](int32_t constant, const VectorPtr& values) {
+    return makeRowVector({
+        makeConstant<int32_t>(constant, size),
+        BaseVector::wrapInDictionary(
+            makeNulls(size, nullEvery(9)),
+            makeIndices(size, [](auto row) { return row % 10; }),
+            size,
+            values),
+        BaseVector::createNullConstant(VARCHAR(), size, pool()),
+        makeConstant<std::string>("constant string", size),
+    });
+  };
+
+  // The same constants and dictionary values in both batches keep their
+  // encodings.
+  auto result = roundTrip({makeBatch(1, names), makeBatch(1, names)});
+  ASSERT_TRUE(result->childAt(0)->isConstantEncoding());
+  ASSERT_EQ(
+      result->childAt(1)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(result->childAt(1)->valueVector()->size(), 10);
+  ASSERT_TRUE(result->childAt(2)->isConstantEncoding());
+  ASSERT_TRUE(result->childAt(3)->isConstantEncoding());
+
+  // Different constants and dictionary values are copied.
+  auto otherNames = makeFlatVector<std::string>(
+      10, [](auto row) { return fmt::format("another long name {}", row); });
+  result = roundTrip({makeBatch(1, names), makeBatch(2, otherNames)});
+  ASSERT_EQ(result->childAt(0)->encoding(), VectorEncoding::Simple::FLAT);
+  ASSERT_TRUE(result->childAt(3)->isConstantEncoding());
+
+  // A dictionary that hardly repeats its values is written flat.
+  auto flat = makeRowVector({BaseVector::wrapInDictionary(
+      nullptr,
+      makeIndicesInReverse(size),
+      size,
+      makeFlatVector<int32_t>(size, [](auto row) { return row; }))});
+  result = roundTrip({flat});
+  ASSERT_EQ(result->childAt(0)->encoding(), VectorEncoding::Simple::FLAT);
+}
+
+TEST_F(ColumnarSpillSerializerTest, projection) {
+  const vector_size_t size = 100;
+  auto batch = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeMapVector<int32_t, int32_t>(
+          size,
+          [](auto row) { return row % 3; },
+          [](auto row) { return row; },
+          [](auto row) { return row * 2; }),
+      makeFlatVector<std::string>(
+          size, [](auto row) { return fmt::format("s{}", row); }),
+  });
+  const auto type = asRowType(batch->type());
+  auto serialized = serialize({batch});
+
+  auto result = read(*serialized, type, {2, 0});
+  ASSERT_EQ(*result->type(), *ROW({"c2", "c0"}, {VARCHAR(), BIGINT()}));
+  velox::test::assertEqualVectors(batch->childAt(2), result->childAt(0));
+  velox::test::assertEqualVectors(batch->childAt(0), result->childAt(1));
+
+  result = read(*serialized, type, {1});
+  velox::test::assertEqualVectors(batch->childAt(1), result->childAt(0));
+
+  VELOX_ASSERT_THROW(
+      read(*serialized, type, {0, 0}), "Spill column projected twice");
+}
+
+TEST_F(ColumnarSpillSerializerTest, compression) {
+  const vector_size_t size = 10'000;
+  auto batch = makeRowVector({
+      makeFlatVector<std::string>(
+          size, [](auto row) { return fmt::format("repeated {}", row / 3); }),
+  });
+  const auto type = asRowType(batch->type());
+  const auto uncompressedSize = serialize({batch})->computeChainDataLength();
+  for (auto kind :
+       {common::CompressionKind::CompressionKind_ZSTD,
+        common::CompressionKind::CompressionKind_LZ4}) {
+    SCOPED_TRACE(common::compressionKindToString(kind));
+    auto serialized = serialize({batch}, kind);
+    ASSERT_LT(serialized->computeChainDataLength(), uncompressedSize);
+    velox::test::assertEqualVectors(
+        batch, read(*serialized, type, {}, kind));
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::exec
@@ -1519,6 +1519,50 @@ DEBUG_ONLY_TEST_F(DriverTest, driverCpuTimeSlicingCheck) {
   }
 }
 
+TEST_F(DriverTest, timeline) {
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 10; ++i) {
+    batches.push_back(makeRowVector({makeFlatVector<int32_t>({1, 2, 3})}));
+  }
+  auto plan = PlanBuilder()
+                  .values(batches)
+                  .filter("c0 > 1")
+                  .project({"c0 + 1 AS c1"})
+                  .planNode();
+
+  auto countEvents = [](const std::shared_ptr<Task>& task) {
+    std::unordered_map<std::string, int32_t> counts;
+    for (const auto& event : task->timelineJson()["traceEvents"]) {
+      if (event["ph"] == "X") {
+        ++counts[event["name"].asString()];
+        ++counts["all"];
+      }
+    }
+    return counts;
+  };
+
+  // No events by default.
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(plan).copyResults(pool(), task);
+  ASSERT_EQ(countEvents(task)["all"], 0);
+
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kDriverTimelineEvents, "1000")
+      .copyResults(pool(), task);
+  auto counts = countEvents(task);
+  ASSERT_GT(counts["run"], 0);
+  // One call per batch and one at the end.
+  ASSERT_GE(counts["Values::getOutput"], 11);
+  ASSERT_EQ(counts["FilterProject::addInput"], 10);
+  ASSERT_EQ(counts["FilterProject::noMoreInput"], 1);
+
+  // Only the last events are kept.
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kDriverTimelineEvents, "5")
+      .copyResults(pool(), task);
+  ASSERT_EQ(countEvents(task)["all"], 5);
+}
+
 class OpCallStatusTest : public OperatorTestBase {};
 
 // Test that the opCallStatus is returned properly and formats the call as
@@ -260,6 +260,66 @@ TEST_F(ExchangeClientTest, flowControl) {
   client->close();
 }
 
+TEST_F(ExchangeClientTest, sourceStats) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  auto plan = test::PlanBuilder()
+                  .values({data})
+                  .partitionedOutput({"c0"}, 100)
+                  .planNode();
+
+  // Limit at 2.5 pages so that the sources are fetched a few pages at a time.
+  const auto pageSize = toSerializedPage(data)->size();
+  auto client = std::make_shared<ExchangeClient>(
+      "source.stats", 17, pageSize * 2.5, pool(), executor());
+  std::vector<std::shared_ptr<Task>> tasks;
+  for (auto i = 0; i < 4; ++i) {
+    auto taskId = fmt::format("local://t{}", i);
+    auto task = makeTask(taskId, plan);
+    bufferManager_->initializeTask(
+        task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 16);
+    // The sources have different amounts of data.
+    for (auto j = 0; j <= i; ++j) {
+      enqueue(taskId, 17, data);
+    }
+    tasks.push_back(task);
+    client->addRemoteTaskId(taskId);
+  }
+
+  fetchPages(*client, 10);
+
+  // The response callbacks update the stats on the executor after the pages
+  // are queued.
+  folly::F14FastMap<std::string, RuntimeMetric> stats;
+  for (auto i = 0; i < 100; ++i) {
+    stats = client->stats();
+    if (stats.count("sourceReceivedBytes") > 0 &&
+        stats.at("sourceReceivedBytes").sum == pageSize * 10) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  // One value per source.
+  ASSERT_EQ(tasks.size(), stats.at("sourceReceivedBytes").count);
+  ASSERT_EQ(pageSize * 10, stats.at("sourceReceivedBytes").sum);
+  ASSERT_EQ(pageSize, stats.at("sourceReceivedBytes").min);
+  ASSERT_EQ(tasks.size(), stats.at("sourceRequestWallNanos").count);
+  ASSERT_EQ(
+      RuntimeCounter::Unit::kNanos, stats.at("sourceRequestWallNanos").unit);
+
+  const auto json = client->toJson();
+  for (const auto& source : json["clients"].values()) {
+    ASSERT_GE(source["requestStats"]["numRequests"].asInt(), 1);
+  }
+
+  for (auto& task : tasks) {
+    task->requestCancel();
+    bufferManager_->removeTask(task->taskId());
+  }
+  client->close();
+}
+
 TEST_F(ExchangeClientTest, largeSinglePage) {
   auto data = {
       makeRowVector({makeFlatVector<int64_t>(10000, folly::identity)}),
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/ExchangeMemoryManager.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox::exec::test {
+namespace {
+
+class ExchangeMemoryManagerTest : public testing::Test {
+ protected:
+  void TearDown() override {
+    ExchangeMemoryManager::setInstance(nullptr);
+  }
+};
+
+TEST_F(ExchangeMemoryManagerTest, noInstance) {
+  ASSERT_EQ(ExchangeMemoryManager::getInstance(), nullptr);
+  ASSERT_EQ(ExchangeMemoryManager::makeConsumer(), nullptr);
+}
+
+TEST_F(ExchangeMemoryManagerTest, shares) {
+  auto manager = std::make_shared<ExchangeMemoryManager>(1'000);
+  ExchangeMemoryManager::setInstance(manager);
+  auto first = ExchangeMemoryManager::makeConsumer();
+  auto second = ExchangeMemoryManager::makeConsumer();
+  ASSERT_NE(first, nullptr);
+
+  // An idle consumer does not take a share.
+  ASSERT_EQ(first->availableBytes(), 1'000);
+  first->setUsedBytes(800);
+  ASSERT_EQ(first->availableBytes(), 200);
+  ASSERT_EQ(manager->numActiveConsumers(), 1);
+
+  // A second consumer asking for memory halves the share of the first one.
+  ASSERT_EQ(second->availableBytes(), 200);
+  second->setUsedBytes(100);
+  ASSERT_EQ(manager->numActiveConsumers(), 2);
+  ASSERT_EQ(manager->usedBytes(), 900);
+  ASSERT_EQ(first->availableBytes(), -300);
+  ASSERT_EQ(second->availableBytes(), 100);
+
+  // The first consumer gets its memory back when the second one drains.
+  second->setUsedBytes(0);
+  ASSERT_EQ(manager->numActiveConsumers(), 1);
+  ASSERT_EQ(first->availableBytes(), 200);
+
+  manager->setCapacity(500);
+  ASSERT_EQ(first->availableBytes(), -300);
+
+  // A destroyed consumer returns its memory.
+  first.reset();
+  ASSERT_EQ(manager->usedBytes(), 0);
+  ASSERT_EQ(manager->numActiveConsumers(), 0);
+  ASSERT_EQ(second->availableBytes(), 500);
+}
+
+TEST_F(ExchangeMemoryManagerTest, consumerOutlivesInstance) {
+  ExchangeMemoryManager::setInstance(
+      std::make_shared<ExchangeMemoryManager>(1'000));
+  auto consumer = ExchangeMemoryManager::makeConsumer();
+  consumer->setUsedBytes(100);
+  ExchangeMemoryManager::setInstance(nullptr);
+  ASSERT_EQ(ExchangeMemoryManager::makeConsumer(), nullptr);
+  // Keeps accounting with the manager it was made by.
+  ASSERT_EQ(consumer->availableBytes(), 900);
+  consumer.reset();
+}
+
+} // namespace
+} // namespace facebook::velox::exec::test
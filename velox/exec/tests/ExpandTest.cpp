@@ -134,6 +134,33 @@ TEST_F(ExpandTest, countDistinct) {
   assertQuery(plan, "SELECT count(distinct a), count(distinct b) FROM tmp");
 }
 
+TEST_F(ExpandTest, batchSizes) {
+  // Constant columns are reused across batches of the same size and remade
+  // when the size changes.
+  std::vector<RowVectorPtr> data = {
+      makeRowVectorData(100),
+      makeRowVectorData(100),
+      makeRowVectorData(37),
+      makeRowVectorData(100)};
+
+  createDuckDbTable(data);
+
+  auto plan =
+      PlanBuilder()
+          .values(data)
+          .expand(
+              {{"k1", "null::bigint as k2", "a", "0 as gid"},
+               {"null", "k2", "a", "1"}})
+          .singleAggregation(
+              {"k1", "k2", "gid"}, {"count(1) as count_1", "sum(a) as sum_a"})
+          .project({"k1", "k2", "count_1", "sum_a"})
+          .planNode();
+
+  assertQuery(
+      plan,
+      "SELECT k1, k2, count(1), sum(a) FROM tmp GROUP BY GROUPING SETS ((k1), (k2))");
+}
+
 TEST_F(ExpandTest, invalidUseCases) {
   auto data = makeRowVector(
       ROW({"k1", "k2", "a", "b"}, {BIGINT(), BIGINT(), BIGINT(), VARCHAR()}),
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/FairShareScheduler.h"
+
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/process/ProcessBase.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+// Spends 'nanos' of CPU time of the calling thread.
+void spin(uint64_t nanos) {
+  const auto start = process::threadCpuNanos();
+  while (process::threadCpuNanos() - start < nanos) {
+  }
+}
+
+class FairShareSchedulerTest : public OperatorTestBase {
+ protected:
+  // Adds 'count' functions of 1ms of CPU time to 'group' of 'scheduler'.
+  // Appends the group to 'order_' when a function ends.
+  void addFunctions(
+      FairShareScheduler& scheduler,
+      const std::string& group,
+      double weight,
+      int32_t count) {
+    for (auto i = 0; i < count; ++i) {
+      scheduler.add(
+          [this, group]() {
+            spin(1'000'000);
+            std::lock_guard<std::mutex> l(mutex_);
+            order_.push_back(group);
+          },
+          group,
+          weight);
+    }
+  }
+
+  // Waits until 'count' functions have ended.
+  void waitFor(size_t count) {
+    for (;;) {
+      {
+        std::lock_guard<std::mutex> l(mutex_);
+        if (order_.size() >= count) {
+          return;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  // Returns the number of times 'group' ran in the functions [begin, end).
+  int32_t countRuns(const std::string& group, size_t begin, size_t end) {
+    std::lock_guard<std::mutex> l(mutex_);
+    return std::count(order_.begin() + begin, order_.begin() + end, group);
+  }
+
+  std::mutex mutex_;
+  std::vector<std::string> order_;
+};
+
+TEST_F(FairShareSchedulerTest, weights) {
+  FairShareScheduler scheduler(executor_.get(), 1);
+  addFunctions(scheduler, "a", 3, 40);
+  addFunctions(scheduler, "b", 1, 40);
+  waitFor(80);
+  // 'a' gets 3 of 4 turns while both groups have functions to run.
+  const auto numA = countRuns("a", 0, 40);
+  ASSERT_GE(numA, 26);
+  ASSERT_LE(numA, 34);
+  ASSERT_EQ(scheduler.virtualRuntime("unknown"), 0);
+}
+
+TEST_F(FairShareSchedulerTest, idleGroup) {
+  FairShareScheduler scheduler(executor_.get(), 1);
+  addFunctions(scheduler, "a", 1, 20);
+  waitFor(10);
+  // 'b' starts at the virtual runtime of 'a' instead of running until it has
+  // used as much CPU as 'a', so the groups take turns.
+  addFunctions(scheduler, "b", 1, 20);
+  addFunctions(scheduler, "a", 1, 20);
+  waitFor(60);
+  ASSERT_GE(countRuns("a", 20, 40), 5);
+  ASSERT_GE(countRuns("b", 20, 40), 5);
+}
+
+TEST_F(FairShareSchedulerTest, maxRunning) {
+  FairShareScheduler scheduler(executor_.get(), 2);
+  std::atomic<int32_t> numRunning{0};
+  std::atomic<int32_t> maxRunning{0};
+  std::atomic<int32_t> numDone{0};
+  folly::Baton<> done;
+  for (auto i = 0; i < 20; ++i) {
+    scheduler.add([&]() {
+      const auto running = ++numRunning;
+      auto previous = maxRunning.load();
+      while (running > previous &&
+             !maxRunning.compare_exchange_weak(previous, running)) {
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      --numRunning;
+      if (++numDone == 20) {
+        done.post();
+      }
+    });
+  }
+  ASSERT_TRUE(done.try_wait_for(std::chrono::seconds(10)));
+  ASSERT_LE(maxRunning, 2);
+}
+
+TEST_F(FairShareSchedulerTest, query) {
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 20; ++i) {
+    data.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return row + i; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7; }),
+    }));
+  }
+  auto plan = PlanBuilder()
+                  .values(data, true)
+                  .project({"c0 % 17 AS k", "c1"})
+                  .partialAggregation({"k"}, {"sum(c1)"})
+                  .localPartition({"k"})
+                  .finalAggregation()
+                  .planNode();
+  auto expected = AssertQueryBuilder(plan).maxDrivers(4).copyResults(pool());
+
+  FairShareScheduler scheduler(executor_.get(), 4);
+  auto queryCtx = std::make_shared<core::QueryCtx>(
+      &scheduler,
+      core::QueryConfig({
+          {core::QueryConfig::kSchedulingGroup, "interactive"},
+          {core::QueryConfig::kSchedulingWeight, "4"},
+      }));
+  AssertQueryBuilder(plan)
+      .maxDrivers(4)
+      .queryCtx(queryCtx)
+      .assertResults(expected);
+}
+
+} // namespace
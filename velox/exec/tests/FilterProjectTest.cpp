@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
+#include "velox/exec/FilterProject.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
@@ -363,3 +364,34 @@ TEST_F(FilterProjectTest, numSilentThrow) {
   auto planStats = toPlanStats(task->taskStats());
   ASSERT_EQ(100, planStats.at(filterId).customStats.at("numSilentThrow").sum);
 }
+
+TEST_F(FilterProjectTest, exprCpuNanos) {
+  auto row = makeRowVector(
+      {makeFlatVector<int64_t>(10'000, [&](auto row) { return row; })});
+
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values({row})
+                  .filter("c0 % 3 = 0")
+                  .project({"c0 * 2 AS x"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+
+  auto task = AssertQueryBuilder(plan)
+                  .config(core::QueryConfig::kExprTrackCpuUsage, "true")
+                  .assertResults(makeRowVector({makeFlatVector<int64_t>(
+                      3'334, [&](auto row) { return row * 6; })}));
+  auto planStats = toPlanStats(task->taskStats());
+  int32_t numStacks = 0;
+  for (const auto& [name, metric] : planStats.at(projectId).customStats) {
+    if (name.find(FilterProject::kExprCpuNanosPrefix) != 0) {
+      continue;
+    }
+    const auto stack = name.substr(FilterProject::kExprCpuNanosPrefix.size());
+    ASSERT_TRUE(stack.find("filter;eq") == 0 || stack.find("x;multiply") == 0)
+        << stack;
+    ASSERT_EQ(metric.unit, RuntimeCounter::Unit::kNanos);
+    ++numStacks;
+  }
+  ASSERT_GT(numStacks, 0);
+}
@@ -660,6 +660,93 @@ TEST_F(GroupedExecutionTest, groupedExecutionWithHashAndNestedLoopJoin) {
   }
 }
 
+// Checks that with a memory limit for split groups the drivers of a finished
+// join build make room for the next split group.
+TEST_F(GroupedExecutionTest, splitGroupsMemoryLimit) {
+  auto vectors = makeVectors(4, 20);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+
+  for (const uint64_t memoryLimit : {0UL, 1UL << 30}) {
+    SCOPED_TRACE(fmt::format("memoryLimit {}", memoryLimit));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId probeScanNodeId;
+    core::PlanNodeId buildScanNodeId;
+    auto planFragment =
+        PlanBuilder(planNodeIdGenerator, pool_.get())
+            .tableScan(rowType_)
+            .capturePlanNodeId(probeScanNodeId)
+            .hashJoin(
+                {"c0"},
+                {"r"},
+                PlanBuilder(planNodeIdGenerator, pool_.get())
+                    .tableScan(rowType_)
+                    .capturePlanNodeId(buildScanNodeId)
+                    .project({"c0 as r"})
+                    .planNode(),
+                "",
+                {"c0", "c1"})
+            .partitionedOutput({}, 1, {"c0", "c1"})
+            .planFragment();
+    planFragment.executionStrategy = core::ExecutionStrategy::kGrouped;
+    planFragment.groupedExecutionLeafNodeIds.emplace(probeScanNodeId);
+    planFragment.groupedExecutionLeafNodeIds.emplace(buildScanNodeId);
+    planFragment.numSplitGroups = 10;
+
+    auto queryCtx = std::make_shared<core::QueryCtx>(
+        executor_.get(),
+        core::QueryConfig(
+            {{core::QueryConfig::kSplitGroupsMemoryLimit,
+              std::to_string(memoryLimit)}}));
+    auto task = exec::Task::create(
+        "0",
+        std::move(planFragment),
+        0,
+        std::move(queryCtx),
+        Task::ExecutionMode::kParallel);
+    // 2 drivers per pipeline, so 4 per split group, and 2 concurrent split
+    // groups.
+    task->start(2, 2);
+
+    for (const auto group : {1, 2, 3}) {
+      task->addSplit(
+          probeScanNodeId, makeHiveSplitWithGroup(filePath->getPath(), group));
+      task->addSplit(
+          buildScanNodeId, makeHiveSplitWithGroup(filePath->getPath(), group));
+    }
+    EXPECT_EQ(8, task->numRunningDrivers());
+
+    // Finish the builds of the running groups. The probes wait for more
+    // splits.
+    task->noMoreSplitsForGroup(buildScanNodeId, 1);
+    task->noMoreSplitsForGroup(buildScanNodeId, 2);
+    waitForFinishedDrivers(task, 4);
+    EXPECT_EQ(std::unordered_set<int32_t>{}, getCompletedSplitGroups(task));
+    if (memoryLimit == 0) {
+      // Two groups are still running, so group 3 waits.
+      EXPECT_EQ(4, task->numRunningDrivers());
+    } else {
+      // The slots of the build drivers go to group 3.
+      EXPECT_EQ(4 + 4, task->numRunningDrivers());
+    }
+
+    task->noMoreSplitsForGroup(buildScanNodeId, 3);
+    for (const auto group : {1, 2, 3}) {
+      task->noMoreSplitsForGroup(probeScanNodeId, group);
+    }
+    waitForFinishedDrivers(task, 12);
+    EXPECT_EQ(0, task->numRunningDrivers());
+    EXPECT_EQ(
+        std::unordered_set<int32_t>({1, 2, 3}), getCompletedSplitGroups(task));
+
+    task->noMoreSplits(buildScanNodeId);
+    task->noMoreSplits(probeScanNodeId);
+    auto outputBufferManager = exec::OutputBufferManager::getInstance().lock();
+    outputBufferManager->deleteResults(task->taskId(), 0);
+    EXPECT_EQ(exec::TaskState::kFinished, task->state());
+  }
+}
+
 // Here we test various aspects of grouped/bucketed execution.
 TEST_F(GroupedExecutionTest, groupedExecution) {
   // Create source file - we will read from it in 6 splits.
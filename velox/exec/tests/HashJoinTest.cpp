@@ -24,6 +24,7 @@
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/HashBuild.h"
 #include "velox/exec/HashJoinBridge.h"
+#include "velox/exec/HashTableCache.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/ArbitratorTestUtil.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
@@ -7658,4 +7659,286 @@ DEBUG_ONLY_TEST_F(HashJoinTest, spillCheckOnLeftSemiFilterWithDynamicFilters) {
       })
       .run();
 }
+
+DEBUG_ONLY_TEST_F(HashJoinTest, sharedBuildTable) {
+  const std::string kQueryId = "sharedBuildTable";
+  constexpr int32_t kNumTasks = 4;
+  auto probeVectors = makeBatches(4, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {"t0", "t1"},
+        {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 300; }),
+         makeFlatVector<int64_t>(1'000, folly::identity)});
+  });
+  auto buildVectors = makeBatches(2, [&](int32_t batch) {
+    return makeRowVector(
+        {"u0", "u1"},
+        {makeFlatVector<int64_t>(
+             200, [batch](auto row) { return batch * 100 + row; }),
+         makeFlatVector<int64_t>(200, folly::identity)});
+  });
+
+  auto makePlan = [&](bool sharedBuildTable, core::PlanNodeId& joinNodeId) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return PlanBuilder(planNodeIdGenerator)
+        .values(probeVectors)
+        .hashJoin(
+            {"t0"},
+            {"u0"},
+            PlanBuilder(planNodeIdGenerator).values(buildVectors).planNode(),
+            "",
+            {"t0", "t1", "u1"},
+            core::JoinType::kInner,
+            false,
+            sharedBuildTable)
+        .capturePlanNodeId(joinNodeId)
+        .planNode();
+  };
+  core::PlanNodeId joinNodeId;
+  const auto expected =
+      AssertQueryBuilder(makePlan(false, joinNodeId)).copyResults(pool());
+  const auto plan = makePlan(true, joinNodeId);
+
+  // Holds the task building the shared table until all the tasks have
+  // registered for it.
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::unordered_set<std::string> finishedTaskIds;
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::HashBuild::finishHashBuild",
+      std::function<void(Operator*)>([&](Operator* op) {
+        const auto entry =
+            HashTableCache::instance()->get(kQueryId, op->planNodeId(), "");
+        std::unique_lock<std::mutex> l(mutex);
+        finishedTaskIds.insert(op->taskId());
+        cv.notify_all();
+        if (entry->builderTaskId() == op->taskId()) {
+          cv.wait(l, [&]() { return finishedTaskIds.size() == kNumTasks; });
+        }
+      }));
+
+  auto queryCtx = std::make_shared<core::QueryCtx>(
+      driverExecutor_.get(),
+      core::QueryConfig({}),
+      std::unordered_map<std::string, std::shared_ptr<Config>>{},
+      cache::AsyncDataCache::getInstance(),
+      nullptr,
+      static_cast<folly::Executor*>(nullptr),
+      kQueryId);
+  std::vector<std::shared_ptr<Task>> tasks(kNumTasks);
+  std::vector<std::thread> threads;
+  threads.reserve(kNumTasks);
+  for (auto i = 0; i < kNumTasks; ++i) {
+    threads.emplace_back([&, i]() {
+      tasks[i] = AssertQueryBuilder(plan)
+                     .queryCtx(queryCtx)
+                     .maxDrivers(numDrivers_)
+                     .assertResults(expected);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  int32_t numAttached = 0;
+  for (const auto& task : tasks) {
+    ASSERT_NE(task, nullptr);
+    const auto& customStats =
+        toPlanStats(task->taskStats()).at(joinNodeId).customStats;
+    numAttached += customStats.count(HashBuild::kSharedTableAttached);
+  }
+  ASSERT_EQ(numAttached, kNumTasks - 1);
+  ASSERT_EQ(HashTableCache::instance()->numEntries(), 0);
+}
+
+TEST_F(HashJoinTest, heavyHitterStats) {
+  // Half of the build rows have key 0, the other keys have 5 rows each.
+  auto buildVectors = makeBatches(10, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {"u0", "u1"},
+        {makeFlatVector<int64_t>(
+             100, [](auto row) { return row < 50 ? 0 : row % 50 / 5 + 1; }),
+         makeFlatVector<int64_t>(100, [](auto row) { return row; })});
+  });
+  auto probeVectors = makeBatches(5, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {"t0", "t1"},
+        {makeFlatVector<int64_t>(100, [](auto row) { return row % 20; }),
+         makeFlatVector<int64_t>(100, [](auto row) { return row; })});
+  });
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId joinNodeId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probeVectors)
+                  .hashJoin(
+                      {"t0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors)
+                          .planNode(),
+                      "",
+                      {"t1", "u1"})
+                  .capturePlanNodeId(joinNodeId)
+                  .planNode();
+
+  const std::string sql = "SELECT t1, u1 FROM t, u WHERE t0 = u0";
+  for (const int32_t minPct : {0, 10, 60}) {
+    SCOPED_TRACE(fmt::format("minPct: {}", minPct));
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .config(
+                        core::QueryConfig::kHashBuildHeavyHitterMinPct,
+                        std::to_string(minPct))
+                    .assertResults(sql);
+    const auto stats = toPlanStats(task->taskStats()).at(joinNodeId);
+    if (minPct == 0) {
+      ASSERT_EQ(stats.maxBuildRowsPerKey, 0);
+      ASSERT_EQ(stats.numHeavyHitterKeys, 0);
+      continue;
+    }
+    // 1000 build rows, 500 of which have key 0.
+    ASSERT_EQ(stats.maxBuildRowsPerKey, 500);
+    if (minPct == 10) {
+      ASSERT_EQ(stats.numHeavyHitterKeys, 1);
+      ASSERT_EQ(stats.numHeavyHitterBuildRows, 500);
+      ASSERT_NE(
+          stats.toString().find("Heavy hitter keys: 1"), std::string::npos);
+    } else {
+      ASSERT_EQ(stats.numHeavyHitterKeys, 0);
+      ASSERT_EQ(stats.numHeavyHitterBuildRows, 0);
+    }
+    const auto& buildStats = stats.operatorStats.at("HashBuild")->customStats;
+    ASSERT_EQ(buildStats.at(BaseHashTable::kMaxRowsPerKey).max, 500);
+  }
+}
+
+TEST_F(HashJoinTest, lazyBuildColumns) {
+  auto buildVectors = makeBatches(5, [&](int32_t batch) {
+    return makeRowVector(
+        {"u0", "u1", "u2", "u3"},
+        {makeFlatVector<int32_t>(
+             100, [&](auto row) { return (batch * 100 + row) % 150; }),
+         makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+         makeFlatVector<StringView>(
+             100,
+             [](auto row) {
+               return StringView::makeInline(fmt::format("payload {}", row));
+             },
+             nullEvery(7)),
+         makeArrayVector<int64_t>(
+             100,
+             [](auto row) { return row % 4; },
+             [](auto row, auto index) { return row + index; })});
+  });
+  auto probeVectors = makeBatches(5, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {"t0", "t1"},
+        {makeFlatVector<int32_t>(100, [](auto row) { return row * 2; }),
+         makeFlatVector<int64_t>(100, [](auto row) { return row; })});
+  });
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  struct {
+    core::JoinType joinType;
+    std::string joinFilter;
+    std::string sql;
+  } testSettings[] = {
+      {core::JoinType::kInner,
+       "",
+       "SELECT t1, u2, u3 FROM t, u "
+       "WHERE t0 = u0 AND (t1 + u1) % 5 = 0"},
+      {core::JoinType::kInner,
+       "t1 > u1",
+       "SELECT t1, u2, u3 FROM t, u "
+       "WHERE t0 = u0 AND t1 > u1 AND (t1 + u1) % 5 = 0"},
+      {core::JoinType::kLeft,
+       "",
+       "SELECT t1, u2, u3 FROM t LEFT JOIN u ON t0 = u0 "
+       "WHERE (t1 + coalesce(u1, 0)) % 5 = 0"},
+  };
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.sql);
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .hashJoin(
+                        {"t0"},
+                        {"u0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .planNode(),
+                        testData.joinFilter,
+                        {"t1", "u1", "u2", "u3"},
+                        testData.joinType)
+                    .filter("(t1 + coalesce(u1, 0)) % 5 = 0")
+                    .project({"t1", "u2", "u3"})
+                    .planNode();
+    for (const bool lazyBuildColumns : {false, true}) {
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(
+              core::QueryConfig::kHashProbeLazyBuildColumns,
+              lazyBuildColumns ? "true" : "false")
+          .assertResults(testData.sql);
+    }
+  }
+}
+
+TEST_F(HashJoinTest, columnarPayload) {
+  auto buildType =
+      ROW({"u0", "u1", "u2", "u3", "u4"},
+          {BIGINT(), BIGINT(), VARCHAR(), DOUBLE(), INTEGER()});
+  auto probeType = ROW({"t0", "t1"}, {BIGINT(), INTEGER()});
+  auto buildVectors = makeBatches(10, [&](int32_t batch) {
+    return makeRowVector(
+        buildType->names(),
+        {makeFlatVector<int64_t>(
+             500, [&](auto row) { return (batch * 500 + row) % 1'200; }),
+         makeFlatVector<int64_t>(
+             500, [&](auto row) { return batch * 500 + row; }, nullEvery(3)),
+         makeFlatVector<std::string>(
+             500, [](auto row) { return fmt::format("payload {}", row); }),
+         makeFlatVector<double>(
+             500, [](auto row) { return row * 0.5; }, nullEvery(7)),
+         makeFlatVector<int32_t>(500, [](auto row) { return row % 17; })});
+  });
+  auto probeVectors = makeBatches(5, [&](int32_t batch) {
+    return makeRowVector(
+        probeType->names(),
+        {makeFlatVector<int64_t>(
+             400, [&](auto row) { return (batch * 400 + row) % 1'500; }),
+         makeFlatVector<int32_t>(400, [](auto row) { return row; })});
+  });
+
+  for (const auto joinType :
+       {core::JoinType::kInner, core::JoinType::kRight}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors, true)
+                    .hashJoin(
+                        {"t0"},
+                        {"u0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors, true)
+                            .planNode(),
+                        "t1 % 5 <> u4",
+                        {"t0", "t1", "u1", "u2", "u3", "u4"},
+                        joinType)
+                    .planNode();
+    const auto expected = AssertQueryBuilder(plan)
+                              .maxDrivers(4)
+                              .config(
+                                  core::QueryConfig::
+                                      kMinTableRowsForParallelJoinBuild,
+                                  1)
+                              .copyResults(pool());
+    AssertQueryBuilder(plan)
+        .maxDrivers(4)
+        .config(core::QueryConfig::kMinTableRowsForParallelJoinBuild, 1)
+        .config(core::QueryConfig::kRowContainerColumnarPayloadMinWidth, 8)
+        .assertResults(expected);
+  }
+}
 } // namespace
@@ -156,6 +156,8 @@ class HashTableTest : public testing::TestWithParam<bool>,
         topTable_->estimateHashTableSize(numRows);
     const uint64_t usedMemoryBytes = topTable_->rows()->pool()->currentBytes();
     topTable_->prepareJoinTable(std::move(otherTables), executor_.get());
+    topTable_->setMinTableBytesForPartitionedProbe(
+        minTableBytesForPartitionedProbe_);
     ASSERT_GE(
         estimatedTableSize,
         topTable_->rows()->pool()->currentBytes() - usedMemoryBytes);
@@ -573,6 +575,9 @@ class HashTableTest : public testing::TestWithParam<bool>,
   // Spacing between consecutive generated keys. Affects whether
   // Vectorhashers make ranges or ids of distinct values.
   int64_t keySpacing_ = 1;
+  // Minimum table size for the partitioned joinProbe in kHash mode. 0
+  // disables.
+  uint64_t minTableBytesForPartitionedProbe_ = 0;
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
@@ -625,6 +630,16 @@ TEST_P(HashTableTest, mixed6Sparse) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
 }
 
+TEST_P(HashTableTest, mixed6SparsePartitionedProbe) {
+  auto type =
+      ROW({"k1", "k2", "k3", "k4", "k5", "k6"},
+          {BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), VARCHAR()});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  minTableBytesForPartitionedProbe_ = 1;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
+}
+
 // It should be safe to call clear() before we insert any data into HashTable
 TEST_P(HashTableTest, clear) {
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
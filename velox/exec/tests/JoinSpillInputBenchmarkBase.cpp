@@ -48,17 +48,27 @@ void JoinSpillInputBenchmarkBase::setUp() {
   spiller_ = std::make_unique<Spiller>(
       exec::Spiller::Type::kHashJoinProbe,
       rowType_,
-      HashBitRange{29, 29},
+      HashBitRange{29, 29 + FLAGS_spiller_benchmark_num_partition_bits},
       &spillConfig,
       &spillStats_);
-  spiller_->setPartitionsSpilled({0});
+  numPartitions_ = 1 << FLAGS_spiller_benchmark_num_partition_bits;
+  SpillPartitionNumSet partitions;
+  for (auto partition = 0; partition < numPartitions_; ++partition) {
+    partitions.insert(partition);
+  }
+  spiller_->setPartitionsSpilled(partitions);
 }
 
 void JoinSpillInputBenchmarkBase::run() {
-  MicrosecondTimer timer(&executionTimeUs_);
-  for (auto i = 0; i < numInputVectors_; ++i) {
-    spiller_->spill(0, rowVectors_[i % numSampleVectors]);
+  const auto startCpuTimeUs = processCpuTimeUs();
+  {
+    MicrosecondTimer timer(&executionTimeUs_);
+    // The input vectors go round robin to the spill partitions.
+    for (auto i = 0; i < numInputVectors_; ++i) {
+      spiller_->spill(i % numPartitions_, rowVectors_[i % numSampleVectors]);
+    }
   }
+  executionCpuTimeUs_ = processCpuTimeUs() - startCpuTimeUs;
 }
 
 } // namespace facebook::velox::exec::test
@@ -27,5 +27,8 @@ class JoinSpillInputBenchmarkBase : public SpillerBenchmarkBase {
 
   /// Runs the test.
   void run() override;
+
+ private:
+  uint32_t numPartitions_{1};
 };
 } // namespace facebook::velox::exec::test
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/LocalPartition.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
@@ -625,3 +626,138 @@ TEST_F(LocalPartitionTest, unionAllLocalExchange) {
       "   SELECT * FROM (VALUES ('y')) as t2(c0)"
       ")");
 }
+
+TEST_F(LocalPartitionTest, rangePartition) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.emplace_back(makeRowVector({makeFlatVector<int64_t>(
+        1'000, [i](auto row) { return (row * 7919 + i * 13) % 10'000; })}));
+  }
+  createDuckDbTable(vectors);
+
+  // Every 10th value of the input as the sample.
+  const auto sample = makeRowVector({makeFlatVector<int64_t>(
+      1'000, [](auto row) { return (row * 10 * 7919) % 10'000; })});
+
+  const int numDrivers = 4;
+  for (const auto& key : {"c0", "c0 DESC"}) {
+    SCOPED_TRACE(key);
+    // Each driver aggregates the range of the sort key it receives.
+    auto plan = PlanBuilder()
+                    .values(vectors)
+                    .localPartitionByRange({key}, sample)
+                    .singleAggregation({}, {"min(c0)", "max(c0)", "count(1)"})
+                    .planNode();
+    auto ranges = AssertQueryBuilder(plan)
+                      .maxDrivers(numDrivers)
+                      .copyResults(pool());
+    ASSERT_EQ(ranges->size(), numDrivers);
+
+    std::vector<std::tuple<int64_t, int64_t, int64_t>> nonEmptyRanges;
+    auto* minValues = ranges->childAt(0)->asFlatVector<int64_t>();
+    auto* maxValues = ranges->childAt(1)->asFlatVector<int64_t>();
+    auto* counts = ranges->childAt(2)->asFlatVector<int64_t>();
+    int64_t totalCount = 0;
+    for (auto i = 0; i < ranges->size(); ++i) {
+      totalCount += counts->valueAt(i);
+      if (counts->valueAt(i) > 0) {
+        nonEmptyRanges.emplace_back(
+            minValues->valueAt(i), maxValues->valueAt(i), counts->valueAt(i));
+        // The sample splits the input into ranges of similar size.
+        ASSERT_GT(counts->valueAt(i), 10'000 / numDrivers / 2);
+      }
+    }
+    ASSERT_EQ(totalCount, 10'000);
+    ASSERT_EQ(nonEmptyRanges.size(), numDrivers);
+
+    // The ranges do not overlap.
+    std::sort(nonEmptyRanges.begin(), nonEmptyRanges.end());
+    for (auto i = 1; i < nonEmptyRanges.size(); ++i) {
+      ASSERT_LT(
+          std::get<1>(nonEmptyRanges[i - 1]), std::get<0>(nonEmptyRanges[i]));
+    }
+
+    // Sorting each range gives the same rows.
+    plan = PlanBuilder()
+               .values(vectors)
+               .localPartitionByRange({key}, sample)
+               .orderBy({key}, true)
+               .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .maxDrivers(numDrivers)
+        .assertResults("SELECT * FROM tmp");
+
+    // Concatenating the sorted ranges in driver order gives the sorted input.
+    plan = PlanBuilder()
+               .values(vectors)
+               .localPartitionByRange({key}, sample)
+               .orderBy({key}, true)
+               .localMerge({})
+               .planNode();
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .maxDrivers(numDrivers)
+                    .assertResults(
+                        fmt::format("SELECT * FROM tmp ORDER BY {}", key),
+                        std::vector<uint32_t>{0});
+    // The ranges are sorted by all drivers.
+    const auto planStats = exec::toPlanStats(task->taskStats());
+    ASSERT_EQ(planStats.at("2").numDrivers, numDrivers);
+  }
+}
+
+TEST_F(LocalPartitionTest, concurrentQueueAccess) {
+  const int kNumProducers = 8;
+  const int kNumConsumers = 4;
+  const int kBatchesPerProducer = 200;
+  auto batch = makeRowVector({makeFlatSequence<int64_t>(0, 100)});
+  const auto batchBytes = batch->estimateFlatSize();
+
+  // A limit of a few batches makes the producers block and unblock often.
+  auto memoryManager =
+      std::make_shared<LocalExchangeMemoryManager>(batchBytes * 3);
+  auto queue = std::make_shared<LocalExchangeQueue>(memoryManager, 0);
+  for (auto i = 0; i < kNumProducers; ++i) {
+    queue->addProducer();
+  }
+  queue->noMoreProducers();
+
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumProducers; ++i) {
+    threads.emplace_back([&]() {
+      for (auto j = 0; j < kBatchesPerProducer; ++j) {
+        ContinueFuture future;
+        if (queue->enqueue(batch, &future) ==
+            BlockingReason::kWaitForConsumer) {
+          future.wait();
+        }
+      }
+      queue->noMoreData();
+    });
+  }
+
+  std::atomic<int64_t> numRows{0};
+  for (auto i = 0; i < kNumConsumers; ++i) {
+    threads.emplace_back([&]() {
+      for (;;) {
+        ContinueFuture future;
+        RowVectorPtr data;
+        if (queue->next(&future, pool(), &data) ==
+            BlockingReason::kWaitForProducer) {
+          future.wait();
+          continue;
+        }
+        if (data == nullptr) {
+          break;
+        }
+        numRows += data->size();
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(numRows, kNumProducers * kBatchesPerProducer * batch->size());
+  ASSERT_TRUE(queue->isFinished());
+  ASSERT_EQ(memoryManager->bufferedBytes(), 0);
+}
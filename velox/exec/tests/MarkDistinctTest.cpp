@@ -14,9 +14,12 @@
  * limitations under the License.
  */
 
+#include "velox/common/file/FileSystems.h"
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::test;
@@ -24,6 +27,10 @@ using namespace facebook::velox::exec::test;
 
 class MarkDistinctTest : public OperatorTestBase {
  public:
+  MarkDistinctTest() {
+    filesystems::registerLocalFileSystem();
+  }
+
   void runBasicTest(const VectorPtr& base) {
     const vector_size_t size = base->size() * 2;
     auto indices = makeIndices(size, [](auto row) { return row / 2; });
@@ -141,3 +148,79 @@ TEST_F(MarkDistinctTest, aggregation) {
       .assertResults(
           "SELECT c0, sum(distinct c1), sum(distinct c2) FROM tmp GROUP BY 1");
 }
+
+TEST_F(MarkDistinctTest, spill) {
+  // Each batch repeats some of the keys of the previous one, so that keys are
+  // seen both before and after spilling.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 8; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return i * 500 + row % 700; }),
+        makeFlatVector<std::string>(
+            1'000, [](auto row) { return std::string(row % 13, 'x'); }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const auto spillDirectory = TempDirectoryPath::create();
+  for (const auto spillPartitionBits : {2, 3}) {
+    SCOPED_TRACE(fmt::format("spillPartitionBits {}", spillPartitionBits));
+    exec::TestScopedSpillInjection scopedSpillInjection(100);
+
+    core::PlanNodeId markDistinctId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->getPath())
+            .config(core::QueryConfig::kSpillEnabled, true)
+            .config(core::QueryConfig::kMarkDistinctSpillEnabled, true)
+            .config(
+                core::QueryConfig::kSpillNumPartitionBits, spillPartitionBits)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .markDistinct("c0_c1_distinct", {"c0", "c1"})
+                      .capturePlanNodeId(markDistinctId)
+                      .singleAggregation(
+                          {"c1"},
+                          {"count(c0)", "count(1)"},
+                          {"c0_c1_distinct", ""})
+                      .planNode())
+            .assertResults(
+                "SELECT c1, count(DISTINCT c0), count(1) FROM tmp GROUP BY 1");
+
+    auto planStats = toPlanStats(task->taskStats());
+    const auto& stats = planStats.at(markDistinctId);
+    ASSERT_GT(stats.spilledBytes, 0);
+    ASSERT_GT(stats.spilledPartitions, 0);
+    ASSERT_GT(stats.spilledRows, 0);
+
+    task.reset();
+    waitForAllTasksToBeDeleted();
+  }
+}
+
+TEST_F(MarkDistinctTest, spillDisabledByDefault) {
+  std::vector<RowVectorPtr> vectors{makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 100; }),
+  })};
+  createDuckDbTable(vectors);
+
+  const auto spillDirectory = TempDirectoryPath::create();
+  exec::TestScopedSpillInjection scopedSpillInjection(100);
+
+  core::PlanNodeId markDistinctId;
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .spillDirectory(spillDirectory->getPath())
+                  .config(core::QueryConfig::kSpillEnabled, true)
+                  .plan(PlanBuilder()
+                            .values(vectors)
+                            .markDistinct("c0_distinct", {"c0"})
+                            .capturePlanNodeId(markDistinctId)
+                            .singleAggregation(
+                                {}, {"count(c0)"}, {"c0_distinct"})
+                            .planNode())
+                  .assertResults("SELECT count(DISTINCT c0) FROM tmp");
+
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(planStats.at(markDistinctId).spilledBytes, 0);
+}
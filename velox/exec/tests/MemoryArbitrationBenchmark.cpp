@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/memory/SharedArbitrator.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/ArbitratorTestUtil.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+#include <map>
+#include <random>
+#include <thread>
+
+DEFINE_int64(
+    arbitration_capacity_mb,
+    512,
+    "Memory capacity of the node shared by the queries in MB");
+DEFINE_int64(
+    arbitration_query_capacity_mb,
+    0,
+    "Max memory capacity of each query in MB. 0 means no limit besides the "
+    "node capacity");
+DEFINE_int64(
+    arbitration_pool_init_capacity_mb,
+    16,
+    "Initial memory capacity of each query in MB");
+DEFINE_int64(
+    arbitration_pool_transfer_capacity_mb,
+    8,
+    "Minimum memory capacity transferred to a query by one arbitration in MB");
+DEFINE_uint64(
+    arbitration_max_reclaim_wait_ms,
+    0,
+    "Max time to wait for a query to be paused for reclaim. 0 means no limit");
+DEFINE_int32(arbitration_num_queries, 64, "Total number of queries to run");
+DEFINE_int32(
+    arbitration_num_concurrent_queries,
+    8,
+    "Number of queries running at the same time");
+DEFINE_int32(arbitration_num_drivers, 4, "Number of drivers of each query");
+DEFINE_int32(
+    arbitration_num_executor_threads,
+    32,
+    "Number of threads of the executor shared by the queries");
+DEFINE_int32(
+    arbitration_aggregation_weight,
+    1,
+    "Relative weight of hash aggregation queries in the mix");
+DEFINE_int32(
+    arbitration_join_weight,
+    1,
+    "Relative weight of hash join queries in the mix");
+DEFINE_int32(
+    arbitration_order_by_weight,
+    0,
+    "Relative weight of order by queries in the mix");
+DEFINE_int64(
+    arbitration_input_mb,
+    64,
+    "Size of the input of each query in MB. All queries read the same input");
+DEFINE_bool(
+    arbitration_enable_spilling,
+    true,
+    "If true, the queries spill when memory is reclaimed from them. "
+    "Otherwise they can only be aborted");
+DEFINE_uint32(arbitration_seed, 0, "Seed of the input data and query mix");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+// Runs a mix of spilling aggregations, joins and order bys concurrently
+// against a SharedArbitrator with a fixed capacity. Reports the throughput,
+// the percentiles of the time each query spent in memory arbitration and of
+// the query latency, the spilled bytes and the number of aborted queries,
+// next to the arbitrator stats.
+namespace {
+
+enum class QueryKind { kAggregation, kJoin, kOrderBy };
+
+std::string kindName(QueryKind kind) {
+  switch (kind) {
+    case QueryKind::kAggregation:
+      return "aggregation";
+    case QueryKind::kJoin:
+      return "join";
+    case QueryKind::kOrderBy:
+      return "order by";
+  }
+  VELOX_UNREACHABLE();
+}
+
+struct QueryResult {
+  QueryKind kind;
+  bool aborted{false};
+  uint64_t wallUs{0};
+  uint64_t arbitrationWallUs{0};
+  uint64_t spilledBytes{0};
+};
+
+template <typename T>
+T percentile(std::vector<T> values, double pct) {
+  if (values.empty()) {
+    return 0;
+  }
+  std::sort(values.begin(), values.end());
+  const auto index = std::min<size_t>(
+      values.size() - 1, static_cast<size_t>(values.size() * pct / 100));
+  return values[index];
+}
+
+class MemoryArbitrationBenchmark {
+ public:
+  MemoryArbitrationBenchmark()
+      : pool_(memory::memoryManager()->addLeafPool("arbitrationBenchmark")),
+        executor_(std::make_unique<folly::CPUThreadPoolExecutor>(
+            FLAGS_arbitration_num_executor_threads)) {
+    memoryManager_ = createMemoryManager(
+        FLAGS_arbitration_capacity_mb << 20,
+        FLAGS_arbitration_pool_init_capacity_mb << 20,
+        FLAGS_arbitration_pool_transfer_capacity_mb << 20,
+        FLAGS_arbitration_max_reclaim_wait_ms);
+    makeInput();
+  }
+
+  void run() {
+    const auto statsBefore = memoryManager_->arbitrator()->stats();
+    std::vector<QueryResult> results(FLAGS_arbitration_num_queries);
+    std::atomic<int32_t> nextQuery{0};
+    const auto startUs = getCurrentTimeMicro();
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < FLAGS_arbitration_num_concurrent_queries; ++i) {
+      threads.emplace_back([&]() {
+        for (;;) {
+          const auto query = nextQuery++;
+          if (query >= FLAGS_arbitration_num_queries) {
+            return;
+          }
+          results[query] = runQuery(query);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    const auto wallUs = getCurrentTimeMicro() - startUs;
+    // The tasks hold memory of 'memoryManager_' until they are destroyed.
+    waitForAllTasksToBeDeleted();
+    const auto stats = memoryManager_->arbitrator()->stats() - statsBefore;
+    report(results, wallUs, stats);
+  }
+
+ private:
+  void makeInput() {
+    const auto rowType = ROW({
+        {"c0", INTEGER()},
+        {"c1", INTEGER()},
+        {"c2", VARCHAR()},
+    });
+    VectorFuzzer::Options options;
+    options.vectorSize = 1024;
+    options.nullRatio = 0;
+    options.stringLength = 1024;
+    options.stringVariableLength = false;
+    options.allowLazyVector = false;
+    VectorFuzzer fuzzer(options, pool_.get(), FLAGS_arbitration_seed);
+    uint64_t bytes = 0;
+    while (bytes < (FLAGS_arbitration_input_mb << 20)) {
+      input_.push_back(fuzzer.fuzzInputRow(rowType));
+      bytes += input_.back()->estimateFlatSize();
+    }
+  }
+
+  QueryKind pickKind(int32_t query) const {
+    const auto total = FLAGS_arbitration_aggregation_weight +
+        FLAGS_arbitration_join_weight + FLAGS_arbitration_order_by_weight;
+    VELOX_USER_CHECK_GT(total, 0, "The query mix has no queries");
+    std::mt19937 rng(FLAGS_arbitration_seed + query);
+    const int32_t pick = rng() % total;
+    if (pick < FLAGS_arbitration_aggregation_weight) {
+      return QueryKind::kAggregation;
+    }
+    if (pick < FLAGS_arbitration_aggregation_weight +
+            FLAGS_arbitration_join_weight) {
+      return QueryKind::kJoin;
+    }
+    return QueryKind::kOrderBy;
+  }
+
+  QueryResult runQuery(int32_t query) {
+    QueryResult result;
+    result.kind = pickKind(query);
+    const auto queryCapacity = FLAGS_arbitration_query_capacity_mb > 0
+        ? FLAGS_arbitration_query_capacity_mb << 20
+        : memory::kMaxMemory;
+    auto queryCtx =
+        newQueryCtx(memoryManager_.get(), executor_.get(), queryCapacity);
+    const auto startUs = getCurrentTimeMicro();
+    try {
+      QueryTestResult queryResult;
+      switch (result.kind) {
+        case QueryKind::kAggregation:
+          queryResult = runAggregateTask(
+              input_,
+              queryCtx,
+              FLAGS_arbitration_enable_spilling,
+              FLAGS_arbitration_num_drivers,
+              pool_.get());
+          break;
+        case QueryKind::kJoin:
+          queryResult = runHashJoinTask(
+              input_,
+              queryCtx,
+              FLAGS_arbitration_num_drivers,
+              pool_.get(),
+              FLAGS_arbitration_enable_spilling);
+          break;
+        case QueryKind::kOrderBy:
+          queryResult = runOrderByTask(
+              input_,
+              queryCtx,
+              FLAGS_arbitration_num_drivers,
+              pool_.get(),
+              FLAGS_arbitration_enable_spilling);
+          break;
+      }
+      for (const auto& [_, nodeStats] :
+           toPlanStats(queryResult.task->taskStats())) {
+        result.spilledBytes += nodeStats.spilledBytes;
+        auto it = nodeStats.customStats.find(
+            memory::SharedArbitrator::kMemoryArbitrationWallNanos);
+        if (it != nodeStats.customStats.end()) {
+          result.arbitrationWallUs += it->second.sum / 1'000;
+        }
+      }
+    } catch (const VeloxRuntimeError& e) {
+      if (e.errorCode() != error_code::kMemAborted &&
+          e.errorCode() != error_code::kMemCapExceeded) {
+        throw;
+      }
+      result.aborted = true;
+    }
+    result.wallUs = getCurrentTimeMicro() - startUs;
+    return result;
+  }
+
+  void report(
+      const std::vector<QueryResult>& results,
+      uint64_t wallUs,
+      const memory::MemoryArbitrator::Stats& stats) const {
+    std::vector<uint64_t> arbitrationWallUs;
+    std::vector<uint64_t> queryWallUs;
+    uint64_t spilledBytes = 0;
+    int32_t numAborted = 0;
+    std::map<std::string, int32_t> numQueries;
+    for (const auto& result : results) {
+      ++numQueries[kindName(result.kind)];
+      if (result.aborted) {
+        ++numAborted;
+        continue;
+      }
+      arbitrationWallUs.push_back(result.arbitrationWallUs);
+      queryWallUs.push_back(result.wallUs);
+      spilledBytes += result.spilledBytes;
+    }
+    std::cout << "Queries:";
+    for (const auto& [kind, count] : numQueries) {
+      std::cout << " " << kind << "=" << count;
+    }
+    std::cout << std::endl
+              << "Wall time: " << succinctMicros(wallUs)
+              << ", throughput: "
+              << fmt::format(
+                     "{:.2f}",
+                     (results.size() - numAborted) * 1'000'000.0 /
+                         std::max<uint64_t>(wallUs, 1))
+              << " queries/s" << std::endl
+              << "Aborted queries: " << numAborted << std::endl
+              << "Spilled: " << succinctBytes(spilledBytes) << std::endl;
+    for (const auto& [name, values] :
+         {std::make_pair("Arbitration wait", arbitrationWallUs),
+          std::make_pair("Query latency", queryWallUs)}) {
+      std::cout << name << ": p50 " << succinctMicros(percentile(values, 50))
+                << ", p90 " << succinctMicros(percentile(values, 90))
+                << ", p99 " << succinctMicros(percentile(values, 99))
+                << ", max " << succinctMicros(percentile(values, 100))
+                << std::endl;
+    }
+    std::cout << "Arbitrator: " << stats.toString() << std::endl;
+  }
+
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  const std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+  std::unique_ptr<memory::MemoryManager> memoryManager_;
+  std::vector<RowVectorPtr> input_;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  memory::SharedArbitrator::registerFactory();
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  MemoryArbitrationBenchmark().run();
+  return 0;
+}
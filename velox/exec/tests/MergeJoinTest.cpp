@@ -196,6 +196,23 @@ TEST_F(MergeJoinTest, fewMatch) {
       [](auto row) { return row * 5; }, [](auto row) { return row * 7; });
 }
 
+TEST_F(MergeJoinTest, sparseMatch) {
+  // The rows between the matches are skipped with a galloping search.
+  testJoin<int32_t>(
+      [](auto row) { return row; }, [](auto row) { return row * 97; });
+  testJoin<int32_t>(
+      [](auto row) { return row * 500; }, [](auto row) { return row; });
+
+  // Long runs of equal keys.
+  testJoin<int32_t>(
+      [](auto row) { return row / 300; }, [](auto row) { return row * 3; });
+
+  // No overlap between the key ranges of the batches of the two sides.
+  testJoin<int32_t>(
+      [](auto row) { return row % 1'000 + (row / 1'000) * 10'000; },
+      [](auto row) { return 5'000 + row; });
+}
+
 TEST_F(MergeJoinTest, duplicateMatch) {
   testJoin<int32_t>(
       [](auto row) { return row / 2; }, [](auto row) { return row / 3; });
@@ -540,6 +557,42 @@ TEST_F(MergeJoinTest, nullKeys) {
       .assertResults("SELECT * FROM t LEFT JOIN u ON t.t0 = u.u0");
 }
 
+TEST_F(MergeJoinTest, nullKeysLast) {
+  // Null keys at the end of the batches are not skipped over by the galloping
+  // search.
+  auto left = makeRowVector(
+      {"t0"},
+      {makeNullableFlatVector<int64_t>(
+          {1, 2, 3, 4, 5, 6, 7, 8, 10, std::nullopt, std::nullopt})});
+  auto right = makeRowVector(
+      {"u0"},
+      {makeNullableFlatVector<int64_t>(
+          {0, 2, 9, 10, std::nullopt, std::nullopt})});
+
+  createDuckDbTable("t", {left});
+  createDuckDbTable("u", {right});
+
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan =
+        PlanBuilder(planNodeIdGenerator)
+            .values({left})
+            .mergeJoin(
+                {"t0"},
+                {"u0"},
+                PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+                "",
+                {"t0", "u0"},
+                joinType)
+            .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .assertResults(
+            joinType == core::JoinType::kInner
+                ? "SELECT * FROM t, u WHERE t.t0 = u.u0"
+                : "SELECT * FROM t LEFT JOIN u ON t.t0 = u.u0");
+  }
+}
+
 TEST_F(MergeJoinTest, complexTypedFilter) {
   constexpr vector_size_t size{1000};
 
@@ -182,3 +182,53 @@ TEST_F(MergeTest, offByOne) {
       {{core::QueryConfig::kPreferredOutputBatchRows, "6"}});
   assertQueryOrdered(params, "VALUES (0), (1), (2), (3), (4), (5), (10)", {0});
 }
+
+/// Verifies that runs of rows from the same source are copied correctly when
+/// they span output batches and sources alternate after runs of different
+/// lengths.
+TEST_F(MergeTest, runs) {
+  constexpr int32_t kNumSources = 3;
+  constexpr vector_size_t kSize = 200;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < kNumSources; ++i) {
+    // Source i has the keys k with (k / (i + 1)) % kNumSources == i, so that
+    // the runs of the sources have different lengths.
+    std::vector<int64_t> keys;
+    for (int64_t k = 0; keys.size() < kSize; ++k) {
+      if ((k / (i + 1)) % kNumSources == i) {
+        keys.push_back(k);
+      }
+    }
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(keys),
+        makeFlatVector<std::string>(
+            kSize,
+            [&](auto row) {
+              return fmt::format("a long string of source {} {}", i, row);
+            },
+            nullEvery(7)),
+        makeArrayVector<int32_t>(
+            kSize,
+            [](auto row) { return row % 4; },
+            [&](auto row) { return row + i; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  std::vector<core::PlanNodePtr> sources;
+  for (const auto& vector : vectors) {
+    sources.push_back(
+        PlanBuilder(planNodeIdGenerator).values({vector}).planNode());
+  }
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .localMerge({"c0"}, std::move(sources))
+                  .planNode();
+
+  CursorParameters params;
+  params.planNode = plan;
+  params.queryCtx = std::make_shared<core::QueryCtx>(executor_.get());
+  params.queryCtx->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kPreferredOutputBatchRows, "7"}});
+  assertQueryOrdered(params, "SELECT * FROM tmp ORDER BY c0", {0});
+}
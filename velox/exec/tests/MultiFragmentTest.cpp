@@ -21,6 +21,7 @@
 #include "velox/dwio/common/FileSink.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Exchange.h"
+#include "velox/exec/InProcessExchangeSource.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PartitionedOutput.h"
 #include "velox/exec/PlanNodeStats.h"
@@ -2035,8 +2036,12 @@ TEST_F(MultiFragmentTest, compression) {
 
   const auto test = [&](const std::string& producerTaskId,
                         float minCompressionRatio,
+                        float maxNanosPerSavedByte,
                         bool expectSkipCompression) {
     PartitionedOutput::testingSetMinCompressionRatio(minCompressionRatio);
+    configSettings_[core::QueryConfig::
+                        kPartitionedOutputMaxCompressionNanosPerSavedByte] =
+        std::to_string(maxNanosPerSavedByte);
     auto producerTask = makeTask(producerTaskId, producerPlan);
     producerTask->start(1);
 
@@ -2057,13 +2062,65 @@ TEST_F(MultiFragmentTest, compression) {
           producerStats.customStats.at("compressedBytes").sum,
           producerStats.customStats.at("compressionInputBytes").sum);
       EXPECT_EQ(0, producerStats.customStats.at("compressionSkippedBytes").sum);
+      EXPECT_LT(0, producerStats.customStats.at("compressionSavedBytes").sum);
+      EXPECT_LT(0, producerStats.customStats.at("compressionCpuNanos").sum);
     } else {
       EXPECT_LT(0, producerStats.customStats.at("compressionSkippedBytes").sum);
     }
   };
 
-  test("local://t1", 0.7, false);
-  test("local://t2", 0.0000001, true);
+  test("local://t1", 0.7, 0, false);
+  test("local://t2", 0.0000001, 0, true);
+  // Compresses well but takes more CPU than allowed per saved byte.
+  test("local://t3", 0.7, 0.0000001, true);
+}
+
+TEST_F(MultiFragmentTest, inProcessExchangeSource) {
+  exec::ExchangeSource::factories().clear();
+  exec::ExchangeSource::registerFactory(InProcessExchangeSource::create);
+
+  // No source for a task that is not in this process.
+  ASSERT_EQ(
+      InProcessExchangeSource::create(
+          "unknown", 0, std::make_shared<ExchangeQueue>(), pool()),
+      nullptr);
+
+  const auto data = makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+       makeFlatVector<int32_t>(1'000, [](auto row) { return row % 7; })});
+
+  const auto producerTaskId = makeTaskId("producer", 0);
+  const auto producerPlan = PlanBuilder()
+                                .values({data}, false, 3)
+                                .partitionedOutput({"c1"}, 2)
+                                .planNode();
+  auto producerTask = makeTask(producerTaskId, producerPlan);
+  producerTask->start(1);
+
+  // The groups do not span partitions, so the results of the consumers add up
+  // to the result of a single aggregation.
+  std::vector<RowVectorPtr> results;
+  for (int destination = 0; destination < 2; ++destination) {
+    const auto plan = PlanBuilder()
+                          .exchange(asRowType(data->type()))
+                          .singleAggregation({"c1"}, {"count(1)", "sum(c0)"})
+                          .planNode();
+    std::shared_ptr<Task> task;
+    results.push_back(AssertQueryBuilder(plan)
+                          .split(remoteSplit(producerTaskId))
+                          .destination(destination)
+                          .copyResults(pool(), task));
+    const auto stats = exec::toPlanStats(task->taskStats()).at("0");
+    ASSERT_LT(0, stats.customStats.at("inProcessExchangeSource.numPages").sum);
+  }
+  const auto expected =
+      AssertQueryBuilder(PlanBuilder()
+                             .values({data}, false, 3)
+                             .singleAggregation({"c1"}, {"count(1)", "sum(c0)"})
+                             .planNode())
+          .copyResults(pool());
+  ASSERT_TRUE(assertEqualResults({expected}, results));
+  ASSERT_TRUE(waitForTaskCompletion(producerTask.get()));
 }
 
 } // namespace
@@ -421,3 +421,48 @@ TEST_F(NestedLoopJoinTest, allTypes) {
       "SELECT t0, u0 FROM t {0} JOIN u ON t.t0 {1} u0 AND t1 {1} u1 AND t2 {1} u2 AND t3 {1} u3 AND t4 {1} u4 AND t5 {1} u5 AND t6 {1} u6");
   runSingleAndMultiDriverTest(probeVectors, buildVectors);
 }
+
+TEST_F(NestedLoopJoinTest, rangeCondition) {
+  // Probe values are in [0, 1000) and build intervals are at most 50 wide.
+  // Some of the values and bounds are null.
+  auto makeProbe = [&](int32_t start) {
+    return makeRowVector(
+        {"t0", "t1"},
+        {makeFlatVector<int64_t>(
+             100,
+             [start](auto row) { return (start + row * 37) % 1'000; },
+             [](auto row) { return row % 17 == 0; }),
+         makeFlatVector<int32_t>(100, [](auto row) { return row % 3; })});
+  };
+  auto makeBuild = [&](int32_t start) {
+    return makeRowVector(
+        {"u0", "u1", "u2"},
+        {makeFlatVector<int64_t>(
+             60,
+             [start](auto row) { return (start + row * 53) % 1'000; },
+             [](auto row) { return row % 13 == 0; }),
+         makeFlatVector<int64_t>(
+             60,
+             [start](auto row) {
+               return (start + row * 53) % 1'000 + row % 50;
+             },
+             [](auto row) { return row % 11 == 0; }),
+         makeFlatVector<int32_t>(60, [](auto row) { return row % 2; })});
+  };
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 5; ++i) {
+    probeVectors.push_back(makeProbe(i * 101));
+    buildVectors.push_back(makeBuild(i * 211));
+  }
+
+  setComparisons(
+      {"t0 BETWEEN u0 AND u1",
+       "t0 >= u0 AND t0 < u1",
+       "u0 < t0 AND u1 >= t0 AND t1 = u2",
+       "t0 BETWEEN u0 AND u1 OR t1 = u2"});
+  setJoinConditionStr("{}");
+  setOutputLayout({"t0", "u0", "u1"});
+  setQueryStr("SELECT t0, u0, u1 FROM t {} JOIN u ON {}");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+}
@@ -537,6 +537,36 @@ TEST_F(OrderByTest, spill) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(OrderByTest, columnarPayload) {
+  const auto rowType =
+      ROW({"c0", "c1", "c2", "c3", "c4"},
+          {BIGINT(), INTEGER(), VARCHAR(), DOUBLE(), TIMESTAMP()});
+  const auto vectors = createVectors(rowType, 1024, 4 << 20);
+  core::PlanNodeId orderById;
+  const auto plan = PlanBuilder()
+                        .values(vectors)
+                        .orderBy({"c0 ASC NULLS LAST", "c2 DESC"}, false)
+                        .capturePlanNodeId(orderById)
+                        .planNode();
+  const auto expectedResult = AssertQueryBuilder(plan).copyResults(pool());
+
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kRowContainerColumnarPayloadMinWidth, 16)
+      .assertResults(expectedResult);
+
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  TestScopedSpillInjection scopedSpillInjection(100);
+  auto task =
+      AssertQueryBuilder(plan)
+          .spillDirectory(spillDirectory->getPath())
+          .config(core::QueryConfig::kSpillEnabled, true)
+          .config(core::QueryConfig::kOrderBySpillEnabled, true)
+          .config(core::QueryConfig::kRowContainerColumnarPayloadMinWidth, 16)
+          .assertResults(expectedResult);
+  ASSERT_GT(toPlanStats(task->taskStats()).at(orderById).spilledRows, 0);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
+
 DEBUG_ONLY_TEST_F(OrderByTest, reclaimDuringInputProcessing) {
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
   auto rowType = ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), INTEGER()});
@@ -18,8 +18,10 @@
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
+#include "velox/common/file/FileSystems.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 using namespace facebook::velox;
@@ -59,14 +61,14 @@ class OutputBufferManagerTest : public testing::Test {
       PartitionedOutputNode::Kind kind,
       int numDestinations,
       int numDrivers,
-      int maxOutputBufferSize = 0) {
+      int maxOutputBufferSize = 0,
+      std::unordered_map<std::string, std::string> configSettings = {}) {
     bufferManager_->removeTask(taskId);
 
     auto planFragment = exec::test::PlanBuilder()
                             .values({std::dynamic_pointer_cast<RowVector>(
                                 BatchMaker::createBatch(rowType, 100, *pool_))})
                             .planFragment();
-    std::unordered_map<std::string, std::string> configSettings;
     if (maxOutputBufferSize != 0) {
       configSettings[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
           std::to_string(maxOutputBufferSize);
@@ -809,6 +811,114 @@ TEST_F(OutputBufferManagerTest, basicPartitioned) {
   EXPECT_TRUE(task->isFinished());
 }
 
+TEST_F(OutputBufferManagerTest, coalescePartitionedPages) {
+  const std::string taskId = "t0";
+  const auto smallPageSize = makeSerializedPage(rowType_, 10)->size();
+  auto task = initializeTask(
+      taskId,
+      rowType_,
+      PartitionedOutputNode::Kind::kPartitioned,
+      2,
+      1,
+      0,
+      {{core::QueryConfig::kOutputBufferCoalesceTargetBytes,
+        std::to_string(3 * smallPageSize)},
+       {core::QueryConfig::kOutputBufferCoalesceMaxDelayMs, "1000000"}});
+
+  // The consumer is notified once three small pages are merged.
+  bool receivedData;
+  registerForData(taskId, 0, 0, 1, receivedData);
+  enqueue(taskId, 0, rowType_, 10);
+  enqueue(taskId, 0, rowType_, 10);
+  EXPECT_FALSE(receivedData);
+  enqueue(taskId, 0, rowType_, 10);
+  EXPECT_TRUE(receivedData);
+
+  // A large page is not delayed. The pending small page goes before it.
+  enqueue(taskId, 1, rowType_, 10);
+  enqueue(taskId, 1, rowType_, 1'000);
+  fetch(taskId, 1, 0, std::numeric_limits<uint64_t>::max(), 2);
+
+  // The pending pages are released when the producers finish.
+  enqueue(taskId, 0, rowType_, 10);
+  noMoreData(taskId);
+  fetch(taskId, 0, 1, std::numeric_limits<uint64_t>::max(), 2, true);
+
+  const auto stats = getStats(taskId);
+  ASSERT_EQ(stats.totalPagesEnqueued, 6);
+  ASSERT_EQ(stats.totalPagesSent, 4);
+
+  fetchEndMarker(taskId, 0, 2);
+  fetchEndMarker(taskId, 1, 2);
+  bufferManager_->removeTask(taskId);
+  EXPECT_TRUE(task->isFinished());
+}
+
+TEST_F(OutputBufferManagerTest, spillPartitionedPages) {
+  filesystems::registerLocalFileSystem();
+  const std::string taskId = "t0";
+  const auto pageSize = makeSerializedPage(rowType_, 100)->size();
+  auto task = initializeTask(
+      taskId,
+      rowType_,
+      PartitionedOutputNode::Kind::kPartitioned,
+      2,
+      1,
+      3 * pageSize,
+      {{core::QueryConfig::kOutputBufferSpillEnabled, "true"}});
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  task->setSpillDirectory(spillDirectory->getPath());
+
+  // Fetches one page of 'destination' at 'sequence', acknowledges the
+  // previous ones and returns the page size.
+  auto fetchPage = [&](int destination, int64_t sequence) {
+    int64_t size = -1;
+    bufferManager_->getData(
+        taskId,
+        destination,
+        1,
+        sequence,
+        [&](std::vector<std::unique_ptr<folly::IOBuf>> pages,
+            int64_t /*sequence*/,
+            std::vector<int64_t> /*remainingBytes*/) {
+          ASSERT_EQ(pages.size(), 1);
+          ASSERT_NE(pages[0], nullptr);
+          size = pages[0]->computeChainDataLength();
+        });
+    return size;
+  };
+
+  // Destination 0 does not fetch after its first page. Its later pages are
+  // spilled and the producer is never blocked. The page sizes differ because
+  // of the random strings.
+  std::vector<int64_t> pageSizes;
+  pageSizes.push_back(enqueue(taskId, 0, rowType_, 100));
+  ASSERT_EQ(fetchPage(0, 0), pageSizes[0]);
+  for (auto i = 0; i < 20; ++i) {
+    pageSizes.push_back(enqueue(taskId, 0, rowType_, 100 + i));
+    enqueue(taskId, 1, rowType_, 100);
+    ASSERT_GT(fetchPage(1, i), 0);
+  }
+  noMoreData(taskId);
+
+  auto stats = getStats(taskId);
+  ASSERT_GT(stats.totalPagesSpilled, 0);
+  ASSERT_GT(stats.totalBytesSpilled, 0);
+  ASSERT_LT(stats.bufferedBytes, 3 * pageSize);
+
+  // The spilled pages are read back in order.
+  for (auto i = 1; i < pageSizes.size(); ++i) {
+    ASSERT_EQ(fetchPage(0, i), pageSizes[i]);
+  }
+  fetchEndMarker(taskId, 0, pageSizes.size());
+  fetchEndMarker(taskId, 1, 20);
+  stats = getStats(taskId);
+  ASSERT_EQ(stats.bufferedBytes, 0);
+  ASSERT_EQ(stats.buffersStats[0].pagesSent, pageSizes.size());
+  bufferManager_->removeTask(taskId);
+  EXPECT_TRUE(task->isFinished());
+}
+
 TEST_F(OutputBufferManagerTest, basicBroadcast) {
   vector_size_t size = 100;
 
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/serialization/BinarySerde.h"
 #include "velox/exec/PartitionFunction.h"
 #include "velox/exec/WindowFunction.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
@@ -61,6 +62,10 @@ class PlanNodeSerdeTest : public testing::Test,
         velox::ISerializable::deserialize<core::PlanNode>(serialized, pool());
 
     ASSERT_EQ(plan->toString(true, true), copy->toString(true, true));
+
+    copy = velox::ISerializable::deserialize<core::PlanNode>(
+        deserializeBinary(serializeBinary(serialized)), pool());
+    ASSERT_EQ(plan->toString(true, true), copy->toString(true, true));
   }
 
   std::vector<RowVectorPtr> data_;
@@ -300,6 +305,21 @@ TEST_F(PlanNodeSerdeTest, mergeJoin) {
              .planNode();
 
   testSerde(plan);
+
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({probe})
+             .hashJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator).values({build}).planNode(),
+                 "", // no filter
+                 {"t0", "t1", "u2", "t2"},
+                 core::JoinType::kInner,
+                 false,
+                 true /*sharedBuildTable*/)
+             .planNode();
+
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, orderBy) {
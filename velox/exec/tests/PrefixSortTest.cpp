@@ -41,7 +41,8 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
 
   void testPrefixSort(
       const std::vector<CompareFlags>& compareFlags,
-      const RowVectorPtr& data) {
+      const RowVectorPtr& data,
+      uint32_t maxStringPrefixLength = 16) {
     const auto numRows = data->size();
     const auto expectedResult =
         generateExpectedResult(compareFlags, numRows, data);
@@ -67,7 +68,8 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
         compareFlags,
         {1024,
          // Set threshold to 0 to enable prefix-sort in small dataset.
-         0});
+         0,
+         maxStringPrefixLength});
 
     // Extract data from the RowContainer in order.
     const RowVectorPtr actual =
@@ -217,6 +219,110 @@ TEST_F(PrefixSortTest, multipleKeys) {
   }
 }
 
+TEST_F(PrefixSortTest, stringPrefix) {
+  // Strings sharing the encoded prefix, shorter than the prefix and differing
+  // only in trailing zero bytes.
+  const auto strings = makeNullableFlatVector<std::string>(
+      {"abcd",
+       "abce",
+       std::nullopt,
+       "ab",
+       "",
+       std::string("ab\0", 3),
+       "abcdefghijklmnopqrstuvwxyz",
+       "abcdefghijklmnopqrstuvwxyy",
+       "b",
+       std::nullopt,
+       "abcd"},
+      VARBINARY());
+  const auto bigints =
+      makeFlatVector<int64_t>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11});
+
+  for (const auto prefixLength : {0, 1, 2, 3, 16}) {
+    SCOPED_TRACE(fmt::format("prefixLength: {}", prefixLength));
+    // The string key is the only key.
+    testPrefixSort({kAsc}, makeRowVector({strings}), prefixLength);
+    testPrefixSort({kDesc}, makeRowVector({strings}), prefixLength);
+
+    // Ties of the string prefix are broken by the full string before the
+    // following key.
+    testPrefixSort(
+        {kAsc, kDesc}, makeRowVector({strings, bigints}), prefixLength);
+    testPrefixSort(
+        {kDesc, kAsc}, makeRowVector({strings, bigints}), prefixLength);
+
+    // The string key follows a fixed width key.
+    testPrefixSort(
+        {kAsc, kAsc},
+        makeRowVector({makeConstant<int64_t>(1, strings->size()), strings}),
+        prefixLength);
+  }
+}
+
+TEST_F(PrefixSortTest, structKeys) {
+  const auto structs = makeRowVector(
+      {makeNullableFlatVector<int64_t>(
+           {1, 1, std::nullopt, 2, 1, std::nullopt, 2, 1}),
+       makeNullableFlatVector<std::string>(
+           {"b",
+            "a",
+            "a",
+            std::nullopt,
+            "Longer test string",
+            std::nullopt,
+            "a",
+            "Longer test string 2"}),
+       makeNullableFlatVector<double>(
+           {1.0, 2.0, 3.0, 4.0, std::nullopt, 6.0, 7.0, 8.0})},
+      [](auto row) { return row == 3; });
+  const auto fixedWidthStructs = makeRowVector(
+      {structs->childAt(0), structs->childAt(2)},
+      [](auto row) { return row == 5; });
+  const auto bigints = makeFlatVector<int64_t>({8, 7, 6, 5, 4, 3, 2, 1});
+
+  for (const auto prefixLength : {0, 1, 16}) {
+    SCOPED_TRACE(fmt::format("prefixLength: {}", prefixLength));
+    for (const auto& flags : {kAsc, kDesc}) {
+      // The fixed width struct is fully normalized.
+      testPrefixSort({flags}, makeRowVector({fixedWidthStructs}), prefixLength);
+      testPrefixSort(
+          {flags, kAsc},
+          makeRowVector({fixedWidthStructs, bigints}),
+          prefixLength);
+
+      // Ties of the encoded children are broken by the full struct.
+      testPrefixSort({flags}, makeRowVector({structs}), prefixLength);
+      testPrefixSort(
+          {flags, kDesc}, makeRowVector({structs, bigints}), prefixLength);
+      testPrefixSort(
+          {kAsc, flags}, makeRowVector({bigints, structs}), prefixLength);
+    }
+  }
+
+  // Structs with leading children that can not be encoded are not normalized.
+  const auto arrays = makeRowVector({
+      makeArrayVector<int64_t>({{1, 2}, {}, {3}, {1}, {2}, {}, {4}, {1, 1}}),
+      bigints,
+  });
+  testPrefixSort({kAsc}, makeRowVector({arrays}));
+}
+
+TEST_F(PrefixSortTest, fuzzStructKeys) {
+  VectorFuzzer fuzzer({.vectorSize = 10'240, .nullRatio = 0.1}, pool());
+  const std::vector<TypePtr> types = {
+      ROW({BIGINT(), INTEGER()}),
+      ROW({DOUBLE(), VARCHAR(), BIGINT()}),
+      ROW({REAL(), TIMESTAMP()}),
+      ROW({SMALLINT(), BIGINT()}),
+      ROW({VARCHAR()})};
+  for (const auto& type : types) {
+    SCOPED_TRACE(type->toString());
+    auto data = fuzzer.fuzzRow(ROW({type, BIGINT()}));
+    testPrefixSort({kAsc, kAsc}, data);
+    testPrefixSort({kDesc, kAsc}, data);
+  }
+}
+
 TEST_F(PrefixSortTest, fuzz) {
   std::vector<TypePtr> keyTypes = {
       INTEGER(),
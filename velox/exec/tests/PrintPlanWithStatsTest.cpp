@@ -207,9 +207,12 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"          runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"          runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"          runningGetOutputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
+       {"          skippedPages        [ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          skippedSplitBytes   [ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
        {"          skippedSplits       [ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          skippedStrides      [ ]* sum: 0, count: 1, min: 0, max: 0"},
+       {"          skippedStridesByBloomFilter [ ]* sum: 0, count: 1, min: 0, max: 0"},
+       {"          skippedStridesByDictionary[ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          storageReadBytes    [ ]* sum: .+, count: 1, min: .+, max: .+"},
        {"          totalRemainingFilterTime\\s+sum: .+, count: .+, min: .+, max: .+"},
        {"          totalScanTime       [ ]* sum: .+, count: .+, min: .+, max: .+"},
@@ -303,11 +306,151 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"        runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"        runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"        runningGetOutputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
+         {"        skippedPages     [ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        skippedSplitBytes[ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
          {"        skippedSplits    [ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        skippedStrides   [ ]* sum: 0, count: 1, min: 0, max: 0"},
+         {"        skippedStridesByBloomFilter [ ]* sum: 0, count: 1, min: 0, max: 0"},
+         {"        skippedStridesByDictionary[ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        storageReadBytes [ ]* sum: .+, count: 1, min: .+, max: .+"},
          {"        totalRemainingFilterTime\\s+sum: .+, count: .+, min: .+, max: .+"},
          {"        totalScanTime    [ ]* sum: .+, count: .+, min: .+, max: .+"}});
   }
 }
+
+TEST_F(PrintPlanWithStatsTest, memoryTimeline) {
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 100; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+
+  core::PlanNodeId aggregationId;
+  auto plan = PlanBuilder()
+                  .values({data, data, data})
+                  .singleAggregation({"c0"}, {"sum(c1)"})
+                  .capturePlanNodeId(aggregationId)
+                  .planNode();
+
+  for (const uint64_t intervalMs : {0, 1}) {
+    SCOPED_TRACE(fmt::format("intervalMs {}", intervalMs));
+    std::shared_ptr<exec::Task> task;
+    AssertQueryBuilder(plan)
+        .config(
+            core::QueryConfig::kOperatorMemoryTimelineIntervalMs, intervalMs)
+        .copyResults(pool(), task);
+    ensureTaskCompletion(task.get());
+
+    auto planStats = exec::toPlanStats(task->taskStats());
+    const auto& timeline = planStats.at(aggregationId).memoryTimeline;
+    const auto printed = printPlanWithStats(*plan, task->taskStats());
+    if (intervalMs == 0) {
+      ASSERT_TRUE(timeline.empty());
+      ASSERT_EQ(printed.find("Memory timeline:"), std::string::npos);
+      continue;
+    }
+    ASSERT_FALSE(timeline.empty());
+    uint64_t maxUsedBytes = timeline[0].usedBytes;
+    for (auto i = 1; i < timeline.size(); ++i) {
+      ASSERT_LT(timeline[i - 1].timeMs, timeline[i].timeMs);
+      maxUsedBytes = std::max(maxUsedBytes, timeline[i].usedBytes);
+    }
+    ASSERT_LT(0, maxUsedBytes);
+    ASSERT_TRUE(RE2::PartialMatch(
+        printed,
+        "   Memory timeline:\n"
+        "      .+: used: .+, reserved: .+, spilled: 0B"));
+  }
+}
+
+TEST_F(PrintPlanWithStatsTest, memoryTimelineMerge) {
+  using exec::MemoryTimelineSample;
+  auto sample = [](uint64_t timeMs,
+                   uint64_t usedBytes,
+                   uint64_t reservedBytes,
+                   uint64_t spilledBytes) {
+    return MemoryTimelineSample{timeMs, usedBytes, reservedBytes, spilledBytes};
+  };
+  auto assertSample = [](const MemoryTimelineSample& actual,
+                         const MemoryTimelineSample& expected) {
+    ASSERT_EQ(actual.timeMs, expected.timeMs);
+    ASSERT_EQ(actual.usedBytes, expected.usedBytes);
+    ASSERT_EQ(actual.reservedBytes, expected.reservedBytes);
+    ASSERT_EQ(actual.spilledBytes, expected.spilledBytes);
+  };
+
+  // The first driver runs in intervals 0 and 20, the second only in 10. The
+  // first driver counts its sample of interval 0 in interval 10. The second
+  // counts only its spilled bytes after its last sample.
+  std::vector<MemoryTimelineSample> timeline{
+      sample(0, 10, 20, 0), sample(20, 30, 40, 5)};
+  MemoryTimelineSample::merge(timeline, {sample(10, 100, 100, 1)});
+  ASSERT_EQ(timeline.size(), 3);
+  assertSample(timeline[0], sample(0, 10, 20, 0));
+  assertSample(timeline[1], sample(10, 110, 120, 1));
+  assertSample(timeline[2], sample(20, 30, 40, 6));
+
+  // Merging into an empty timeline copies the other one.
+  std::vector<MemoryTimelineSample> empty;
+  MemoryTimelineSample::merge(empty, timeline);
+  ASSERT_EQ(empty.size(), 3);
+  assertSample(empty[1], sample(10, 110, 120, 1));
+
+  // The merged timeline is downsampled to the max number of samples and keeps
+  // the peak usage.
+  const auto numSamples = exec::OperatorStats::kMaxMemoryTimelineSamples;
+  std::vector<MemoryTimelineSample> first;
+  std::vector<MemoryTimelineSample> second;
+  for (auto i = 0; i < numSamples; ++i) {
+    first.push_back(sample(2 * i, i == 7 ? 1'000 : 1, 1, 0));
+    second.push_back(sample(2 * i + 1, 1, 1, 0));
+  }
+  MemoryTimelineSample::merge(first, second);
+  ASSERT_EQ(first.size(), numSamples);
+  uint64_t maxUsedBytes = 0;
+  for (auto i = 1; i < first.size(); ++i) {
+    ASSERT_LT(first[i - 1].timeMs, first[i].timeMs);
+    maxUsedBytes = std::max(maxUsedBytes, first[i].usedBytes);
+  }
+  ASSERT_EQ(maxUsedBytes, 1'001);
+}
+
+TEST_F(PrintPlanWithStatsTest, batchHistograms) {
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+  });
+
+  core::PlanNodeId filterId;
+  auto plan = PlanBuilder()
+                  .values(std::vector<RowVectorPtr>(30, data))
+                  .filter("c0 < 10")
+                  .capturePlanNodeId(filterId)
+                  .planNode();
+  std::shared_ptr<exec::Task> task;
+  AssertQueryBuilder(plan).copyResults(pool(), task);
+  ensureTaskCompletion(task.get());
+
+  auto planStats = exec::toPlanStats(task->taskStats());
+  const auto& filterStats = planStats.at(filterId);
+  ASSERT_EQ(
+      filterStats.inputBatchRows.counts[RuntimeHistogram::bucket(100)], 30);
+  ASSERT_EQ(
+      filterStats.outputBatchRows.counts[RuntimeHistogram::bucket(10)], 30);
+  int64_t numOutputBatches = 0;
+  for (auto count : filterStats.outputBatchNanos.counts) {
+    numOutputBatches += count;
+  }
+  ASSERT_EQ(numOutputBatches, 30);
+
+  ASSERT_EQ(
+      printPlanWithStats(*plan, task->taskStats()).find("batch rows"),
+      std::string::npos);
+  const auto printed =
+      printPlanWithStats(*plan, task->taskStats(), false, true);
+  ASSERT_TRUE(RE2::PartialMatch(
+      printed,
+      "-- Filter.*\n.*\n"
+      "      Input batch rows: \\[64, 128\\): 30\n"
+      "      Output batch rows: \\[8, 16\\): 30\n"
+      "      Output batch latency: \\[.+\\): .+"))
+      << printed;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/RangePartitionFunction.h"
+#include <gtest/gtest.h>
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+class RangePartitionFunctionTest : public test::VectorTestBase,
+                                   public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  std::vector<uint32_t> partition(
+      const core::PartitionFunctionSpec& spec,
+      int numPartitions,
+      const RowVectorPtr& input) {
+    auto function = spec.create(numPartitions);
+    std::vector<uint32_t> partitions;
+    const auto singlePartition = function->partition(*input, partitions);
+    if (singlePartition.has_value()) {
+      return std::vector<uint32_t>(input->size(), singlePartition.value());
+    }
+    return partitions;
+  }
+
+  const core::SortOrder kAscNullsFirst{true, true};
+  const core::SortOrder kDescNullsLast{false, false};
+};
+
+TEST_F(RangePartitionFunctionTest, singleKey) {
+  const auto input = makeRowVector({makeNullableFlatVector<int32_t>(
+      {0, 9, 10, 19, 20, 29, 30, 39, std::nullopt})});
+  const auto rowType = asRowType(input->type());
+  // The sample is not sorted and has duplicates.
+  const auto sample = makeRowVector({makeFlatVector<int32_t>(
+      {30, 10, 20, 0, 10, 20, 30, 0, 0, 10, 20, 30})});
+
+  {
+    const RangePartitionFunctionSpec spec(
+        rowType, {0}, {kAscNullsFirst}, sample);
+    ASSERT_EQ(
+        partition(spec, 4, input),
+        (std::vector<uint32_t>{0, 0, 1, 1, 2, 2, 3, 3, 0}));
+    ASSERT_EQ(
+        partition(spec, 2, input),
+        (std::vector<uint32_t>{0, 0, 0, 0, 1, 1, 1, 1, 0}));
+    ASSERT_EQ(
+        partition(spec, 1, input), (std::vector<uint32_t>(input->size(), 0)));
+  }
+
+  {
+    const RangePartitionFunctionSpec spec(
+        rowType, {0}, {kDescNullsLast}, sample);
+    ASSERT_EQ(
+        partition(spec, 4, input),
+        (std::vector<uint32_t>{3, 2, 2, 1, 1, 0, 0, 0, 3}));
+  }
+}
+
+TEST_F(RangePartitionFunctionTest, multipleKeys) {
+  const auto input = makeRowVector(
+      {makeFlatVector<std::string>({"a", "b", "b", "b", "c"}),
+       makeFlatVector<int64_t>({5, 1, 2, 3, 0}),
+       makeFlatVector<int64_t>({0, 0, 0, 0, 0})});
+  const auto rowType = asRowType(input->type());
+  const auto sample = makeRowVector(
+      {makeFlatVector<std::string>({"b", "a"}),
+       makeFlatVector<int64_t>({2, 0})});
+
+  // Boundaries: (b, 2) for 2 partitions.
+  const RangePartitionFunctionSpec spec(
+      rowType, {0, 1}, {kAscNullsFirst, kDescNullsLast}, sample);
+  ASSERT_EQ(
+      partition(spec, 2, input), (std::vector<uint32_t>{0, 1, 1, 0, 1}));
+  ASSERT_EQ("RANGE(c0 ASC NULLS FIRST, c1 DESC NULLS LAST)", spec.toString());
+}
+
+TEST_F(RangePartitionFunctionTest, emptySample) {
+  const auto input = makeRowVector({makeFlatVector<int32_t>({1, 2, 3})});
+  const RangePartitionFunctionSpec spec(
+      asRowType(input->type()),
+      {0},
+      {kAscNullsFirst},
+      makeRowVector({makeFlatVector<int32_t>(std::vector<int32_t>{})}));
+  auto function = spec.create(10);
+  std::vector<uint32_t> partitions;
+  const auto singlePartition = function->partition(*input, partitions);
+  ASSERT_TRUE(singlePartition.has_value());
+  ASSERT_EQ(singlePartition.value(), 0u);
+}
+
+TEST_F(RangePartitionFunctionTest, spec) {
+  Type::registerSerDe();
+
+  const auto input =
+      makeRowVector({makeFlatVector<int64_t>(100, [](auto row) {
+        return row;
+      })});
+  const auto sample =
+      makeRowVector({makeFlatVector<int64_t>(10, [](auto row) {
+        return row * 10;
+      })});
+  const RangePartitionFunctionSpec spec(
+      asRowType(input->type()), {0}, {kDescNullsLast}, sample);
+  ASSERT_EQ("RANGE(c0 DESC NULLS LAST)", spec.toString());
+
+  const auto copy =
+      RangePartitionFunctionSpec::deserialize(spec.serialize(), pool());
+  ASSERT_EQ(spec.toString(), copy->toString());
+  ASSERT_EQ(partition(spec, 3, input), partition(*copy, 3, input));
+
+  VELOX_ASSERT_THROW(
+      RangePartitionFunctionSpec(
+          asRowType(input->type()),
+          {0},
+          {kAscNullsFirst},
+          makeRowVector({makeFlatVector<int32_t>({1})})),
+      "Type of sample column 0 does not match the sort key");
+}
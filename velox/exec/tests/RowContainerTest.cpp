@@ -1172,6 +1172,146 @@ TEST_F(RowContainerTest, erase) {
   data->checkConsistency();
 }
 
+TEST_F(RowContainerTest, columnarDependents) {
+  constexpr int32_t kNumRows = 3 * RowContainer::kColumnarChunkRows + 10;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          kNumRows, [](auto row) { return row * 3; }, nullEvery(5)),
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) { return fmt::format("{} a long enough string", row); },
+          nullEvery(7)),
+      makeFlatVector<double>(
+          kNumRows, [](auto row) { return row / 2.0; }, nullEvery(11)),
+      makeFlatVector<int16_t>(kNumRows, [](auto row) { return row % 1000; }),
+      makeFlatVector<Timestamp>(
+          kNumRows,
+          [](auto row) { return Timestamp(row, row * 1'000); },
+          nullEvery(3)),
+  });
+  const std::vector<TypePtr> keyTypes{BIGINT()};
+  const std::vector<TypePtr> dependentTypes{
+      BIGINT(), VARCHAR(), DOUBLE(), SMALLINT(), TIMESTAMP()};
+  ASSERT_EQ(
+      RowContainer::columnarDependentsWidth(dependentTypes),
+      sizeof(int64_t) + sizeof(double) + sizeof(int16_t) + sizeof(Timestamp));
+
+  auto makeContainer = [&](bool columnarDependents) {
+    return std::make_unique<RowContainer>(
+        keyTypes,
+        true, // nullableKeys
+        std::vector<Accumulator>{},
+        dependentTypes,
+        true, // hasNext
+        true, // isJoinBuild
+        false, // hasProbedFlag
+        false, // hasNormalizedKeys
+        pool(),
+        nullptr, // stringAllocator
+        columnarDependents);
+  };
+  auto rowWise = makeContainer(false);
+  auto columnar = makeContainer(true);
+  ASSERT_FALSE(rowWise->isColumnar(1));
+  ASSERT_TRUE(columnar->isColumnar(1));
+  ASSERT_FALSE(columnar->isColumnar(0));
+  ASSERT_FALSE(columnar->isColumnar(2));
+  ASSERT_TRUE(columnar->isColumnar(5));
+  ASSERT_LT(columnar->fixedRowSize(), rowWise->fixedRowSize());
+
+  auto store = [&](RowContainer& container,
+                   const RowVectorPtr& input,
+                   std::vector<char*>& rows) {
+    for (auto i = 0; i < input->size(); ++i) {
+      rows[i] = container.newRow();
+    }
+    for (auto column = 0; column < input->childrenSize(); ++column) {
+      DecodedVector decoded(*input->childAt(column));
+      for (auto i = 0; i < input->size(); ++i) {
+        container.store(decoded, i, rows[i], column);
+      }
+    }
+  };
+  auto verify = [&](RowContainer& container,
+                    const std::vector<char*>& rows,
+                    const RowVectorPtr& expected) {
+    std::vector<vector_size_t> reversed(rows.size());
+    for (auto i = 0; i < rows.size(); ++i) {
+      reversed[i] = rows.size() - 1 - i;
+    }
+    for (auto column = 0; column < expected->childrenSize(); ++column) {
+      auto result =
+          BaseVector::create(expected->childAt(column)->type(), 0, pool());
+      container.extractColumn(rows.data(), rows.size(), column, result);
+      assertEqualVectors(expected->childAt(column), result);
+
+      container.extractColumn(
+          rows.data(),
+          folly::Range<const vector_size_t*>(reversed.data(), reversed.size()),
+          column,
+          0,
+          result);
+      for (auto i = 0; i < rows.size(); ++i) {
+        ASSERT_TRUE(
+            expected->childAt(column)->equalValueAt(
+                result.get(), reversed[i], i));
+      }
+    }
+  };
+
+  std::vector<char*> rowWiseRows(kNumRows);
+  std::vector<char*> columnarRows(kNumRows);
+  store(*rowWise, data, rowWiseRows);
+  store(*columnar, data, columnarRows);
+  verify(*rowWise, rowWiseRows, data);
+  verify(*columnar, columnarRows, data);
+
+  // Erased rows keep their columnar slot when reused.
+  std::vector<char*> erased;
+  for (auto i = 0; i < kNumRows; i += 2) {
+    erased.push_back(columnarRows[i]);
+  }
+  columnar->eraseRows(folly::Range<char**>(erased.data(), erased.size()));
+  auto newData = makeRowVector({
+      makeFlatVector<int64_t>(erased.size(), [](auto row) { return -row; }),
+      makeFlatVector<int64_t>(
+          erased.size(), [](auto row) { return row * 7; }, nullEvery(2)),
+      makeFlatVector<std::string>(
+          erased.size(), [](auto row) { return std::to_string(row); }),
+      makeFlatVector<double>(erased.size(), [](auto row) { return row; }),
+      makeFlatVector<int16_t>(erased.size(), [](auto row) { return row % 7; }),
+      makeFlatVector<Timestamp>(
+          erased.size(), [](auto row) { return Timestamp(row, 0); }),
+  });
+  std::vector<char*> newRows(erased.size());
+  store(*columnar, newData, newRows);
+  std::unordered_set<char*> erasedSet(erased.begin(), erased.end());
+  for (auto* row : newRows) {
+    ASSERT_EQ(erasedSet.count(row), 1);
+  }
+  verify(*columnar, newRows, newData);
+
+  std::vector<char*> remaining;
+  std::vector<vector_size_t> remainingIndices;
+  for (auto i = 1; i < kNumRows; i += 2) {
+    remaining.push_back(columnarRows[i]);
+    remainingIndices.push_back(i);
+  }
+  auto indices = makeIndices(
+      remainingIndices.size(), [&](auto row) { return remainingIndices[row]; });
+  std::vector<VectorPtr> remainingChildren;
+  for (const auto& child : data->children()) {
+    remainingChildren.push_back(wrapInDictionary(indices, child));
+  }
+  auto remainingData = makeRowVector(remainingChildren);
+  verify(*columnar, remaining, remainingData);
+
+  ASSERT_GT(columnar->estimateRowSize().value(), 0);
+  columnar->clear();
+  ASSERT_EQ(columnar->numRows(), 0);
+}
+
 TEST_F(RowContainerTest, initialNulls) {
   std::vector<TypePtr> keys{INTEGER()};
   std::vector<TypePtr> dependent{INTEGER()};
@@ -176,6 +176,55 @@ TEST_F(SortBufferTest, multipleKeys) {
   ASSERT_EQ(output->childAt(1)->asFlatVector<int32_t>()->valueAt(4), 2);
 }
 
+TEST_F(SortBufferTest, prefixSort) {
+  // Specifies the sort columns ["c5", "c0"] so that the string key is
+  // normalized as a prefix.
+  const std::vector<column_index_t> sortColumnIndices{5, 0};
+  const std::vector<CompareFlags> sortCompareFlags{
+      {true, true, false, CompareFlags::NullHandlingMode::kNullAsValue},
+      {false, false, false, CompareFlags::NullHandlingMode::kNullAsValue}};
+  VectorFuzzer fuzzer(
+      {.vectorSize = 1000, .nullRatio = 0.1, .stringLength = 20}, pool_.get());
+  std::vector<RowVectorPtr> inputs;
+  for (int i = 0; i < 3; ++i) {
+    inputs.push_back(fuzzer.fuzzRow(inputType_));
+  }
+
+  const auto sort = [&](const std::optional<PrefixSortConfig>& config) {
+    SortBuffer sortBuffer(
+        inputType_,
+        sortColumnIndices,
+        sortCompareFlags,
+        pool_.get(),
+        &nonReclaimableSection_,
+        nullptr,
+        nullptr,
+        0,
+        config);
+    for (const auto& input : inputs) {
+      sortBuffer.addInput(input);
+    }
+    sortBuffer.noMoreInput();
+    const auto output = sortBuffer.getOutput(10'000);
+    EXPECT_EQ(output->size(), 3'000);
+    // Copies the output as the sort buffer owns it.
+    return std::static_pointer_cast<RowVector>(
+        BaseVector::copy(*output));
+  };
+
+  const auto expected = sort(std::nullopt);
+  for (uint32_t maxStringPrefixLength : {0, 4, 16}) {
+    SCOPED_TRACE(
+        fmt::format("maxStringPrefixLength {}", maxStringPrefixLength));
+    const auto actual =
+        sort(PrefixSortConfig(1024, 100, maxStringPrefixLength));
+    // Rows with equal keys may be in any order.
+    for (auto column : sortColumnIndices) {
+      assertEqualVectors(expected->childAt(column), actual->childAt(column));
+    }
+  }
+}
+
 // TODO: enable it later with test utility to compare the sorted result.
 TEST_F(SortBufferTest, DISABLED_randomData) {
   struct {
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SpillSpaceManager.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+TEST(SpillSpaceManagerTest, reserve) {
+  SpillSpaceManager manager({{"", 100}, {"/remote", 1'000}});
+  ASSERT_EQ(manager.numTiers(), 2);
+  ASSERT_EQ(manager.tier(1).path, "/remote");
+
+  ASSERT_TRUE(manager.tryReserve(0, 60));
+  ASSERT_TRUE(manager.tryReserve(0, 40));
+  // A reservation past the capacity fails without reserving.
+  ASSERT_FALSE(manager.tryReserve(0, 1));
+  ASSERT_EQ(manager.usedBytes(0), 100);
+  ASSERT_TRUE(manager.tryReserve(1, 1'000));
+  ASSERT_FALSE(manager.tryReserve(1, 1));
+  ASSERT_EQ(
+      manager.toString(),
+      "SpillSpaceManager[0: 100B/100B, 1: 1000B/1000B]");
+
+  manager.release(0, 60);
+  ASSERT_EQ(manager.usedBytes(0), 40);
+  ASSERT_TRUE(manager.tryReserve(0, 60));
+  manager.release(0, 100);
+  manager.release(1, 1'000);
+  ASSERT_EQ(manager.usedBytes(0), 0);
+  ASSERT_EQ(manager.usedBytes(1), 0);
+  VELOX_ASSERT_THROW(
+      manager.release(1, 1), "Released more than reserved on spill tier");
+}
+
+TEST(SpillSpaceManagerTest, invalidTiers) {
+  VELOX_ASSERT_THROW(
+      SpillSpaceManager({}), "Spill space manager needs at least one tier");
+  VELOX_ASSERT_THROW(
+      SpillSpaceManager({{"", 100}, {"", 100}}), "Spill tier 1 has no path");
+}
+
+TEST(SpillSpaceManagerTest, instance) {
+  ASSERT_EQ(SpillSpaceManager::getInstance(), nullptr);
+  SpillSpaceManager manager({{"", 100}});
+  SpillSpaceManager::setInstance(&manager);
+  ASSERT_EQ(SpillSpaceManager::getInstance(), &manager);
+  SpillSpaceManager::setInstance(nullptr);
+}
+
+} // namespace
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -23,6 +24,7 @@
 #include "velox/common/file/FileSystems.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Spill.h"
+#include "velox/exec/SpillSpaceManager.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/serializers/PrestoSerializer.h"
 #include "velox/type/Timestamp.h"
@@ -403,7 +405,10 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
             "spillFillTimeUs[{}] spillSortTime[{}] spillSerializationTime[{}] "
             "spillWrites[{}] spillFlushTime[{}] spillWriteTime[{}] "
             "maxSpillExceededLimitCount[0] spillReadBytes[{}] spillReads[{}] "
-            "spillReadTime[{}] spillReadDeserializationTime[{}]",
+            "spillReadTime[{}] spillReadDeserializationTime[{}] "
+            "spillMergePasses[0] spillMergeBytes[0B] "
+            "spillWriteWaitTime[{}] spillReadAheadTime[0us] "
+            "spillReadAheadWaitTime[0us] spilledFallbackBytes[0B]",
             finalStats.spillRuns,
             succinctBytes(finalStats.spilledInputBytes),
             succinctBytes(finalStats.spilledBytes),
@@ -419,7 +424,8 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
             succinctBytes(finalStats.spillReadBytes),
             finalStats.spillReads,
             succinctMicros(finalStats.spillReadTimeUs),
-            succinctMicros(finalStats.spillDeserializationTimeUs)));
+            succinctMicros(finalStats.spillDeserializationTimeUs),
+            succinctMicros(finalStats.spillWriteWaitTimeUs)));
 
     // Verify the spilled files are still there after spill state destruction.
     for (const auto& spilledFile : spilledFileSet) {
@@ -516,6 +522,454 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, writeBehind) {
+  const int numBatches = 32;
+  const int numRowsPerBatch = 100;
+  const std::vector<CompareFlags> compareFlags{CompareFlags{}};
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(2);
+  struct {
+    uint64_t writeBehindBytes;
+    uint64_t targetFileSize;
+
+    std::string debugString() const {
+      return fmt::format(
+          "writeBehindBytes: {}, targetFileSize: {}",
+          writeBehindBytes,
+          targetFileSize);
+    }
+  } testSettings[] = {{1, kGB}, {kGB, kGB}, {1, 1'000}, {kGB, 1'000}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    spillStats_.wlock()->reset();
+    SpillState state(
+        [&]() -> const std::string& { return tempDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        "test",
+        1,
+        1,
+        compareFlags,
+        testData.targetFileSize,
+        0,
+        compressionKind_,
+        pool(),
+        &spillStats_,
+        "",
+        executor.get(),
+        testData.writeBehindBytes);
+    state.setPartitionSpilled(0);
+    for (auto batch = 0; batch < numBatches; ++batch) {
+      state.appendToPartition(
+          0,
+          makeRowVector({makeFlatVector<int64_t>(
+              numRowsPerBatch,
+              [&](auto row) { return batch * numRowsPerBatch + row; })}));
+    }
+    auto files = state.finish(0);
+    ASSERT_EQ(files.size() > 1, testData.targetFileSize < kGB);
+
+    const auto stats = spillStats_.copy();
+    ASSERT_EQ(stats.spillWrites, numBatches);
+    ASSERT_EQ(stats.spilledFiles, files.size());
+    uint64_t fileBytes{0};
+    for (const auto& file : files) {
+      fileBytes += file.size;
+    }
+    ASSERT_EQ(stats.spilledBytes, fileBytes);
+
+    SpillPartition spillPartition(SpillPartitionId{0, 0}, std::move(files));
+    auto merge = spillPartition.createOrderedReader(pool(), &spillStats_);
+    for (auto i = 0; i < numBatches * numRowsPerBatch; ++i) {
+      auto* stream = merge->next();
+      ASSERT_NE(stream, nullptr);
+      ASSERT_EQ(stream->decoded(0).valueAt<int64_t>(stream->currentIndex()), i);
+      stream->pop();
+    }
+    ASSERT_EQ(merge->next(), nullptr);
+  }
+}
+
+TEST_P(SpillTest, readAhead) {
+  // Two files of several read buffers each with incompressible data.
+  const int numFiles = 2;
+  const int numBatches = 32;
+  const int numRowsPerBatch = 10'000;
+  const std::vector<CompareFlags> compareFlags{CompareFlags{}};
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(2);
+  folly::Random::DefaultGenerator rng(1);
+  std::vector<int64_t> payloads(numFiles * numBatches * numRowsPerBatch);
+  for (auto& payload : payloads) {
+    payload = folly::Random::rand64(rng);
+  }
+
+  struct {
+    uint64_t readAheadBytes;
+    bool expectReadAhead;
+
+    std::string debugString() const {
+      return fmt::format(
+          "readAheadBytes: {}, expectReadAhead: {}",
+          readAheadBytes,
+          expectReadAhead);
+    }
+  } testSettings[] = {{0, false}, {1'000, false}, {kGB, true}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    spillStats_.wlock()->reset();
+    SpillState state(
+        [&]() -> const std::string& { return tempDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        "test",
+        1,
+        1,
+        compareFlags,
+        kGB,
+        0,
+        compressionKind_,
+        pool(),
+        &spillStats_);
+    state.setPartitionSpilled(0);
+    // File 'i' has the keys that are 'i' modulo 'numFiles'.
+    for (auto file = 0; file < numFiles; ++file) {
+      for (auto batch = 0; batch < numBatches; ++batch) {
+        auto key = [&](auto row) {
+          return (batch * numRowsPerBatch + row) * numFiles + file;
+        };
+        state.appendToPartition(
+            0,
+            makeRowVector(
+                {makeFlatVector<int64_t>(numRowsPerBatch, key),
+                 makeFlatVector<int64_t>(numRowsPerBatch, [&](auto row) {
+                   return payloads[key(row)];
+                 })}));
+      }
+      state.finishFile(0);
+    }
+    auto files = state.finish(0);
+    ASSERT_EQ(files.size(), numFiles);
+    for (const auto& file : files) {
+      ASSERT_GT(file.size, 2 * SpillReadFile::kMaxReadBufferSize);
+    }
+
+    common::SpillConfig spillConfig;
+    spillConfig.executor = executor.get();
+    spillConfig.readAheadBytes = testData.readAheadBytes;
+    SpillPartition spillPartition(SpillPartitionId{0, 0}, std::move(files));
+    auto merge =
+        spillPartition.createOrderedReader(pool(), &spillStats_, &spillConfig);
+    for (auto i = 0; i < payloads.size(); ++i) {
+      auto* stream = merge->next();
+      ASSERT_NE(stream, nullptr);
+      ASSERT_EQ(stream->decoded(0).valueAt<int64_t>(stream->currentIndex()), i);
+      ASSERT_EQ(
+          stream->decoded(1).valueAt<int64_t>(stream->currentIndex()),
+          payloads[i]);
+      stream->pop();
+    }
+    ASSERT_EQ(merge->next(), nullptr);
+
+    const auto stats = spillStats_.copy();
+    ASSERT_EQ(stats.spillReadBytes, stats.spilledBytes);
+    if (testData.expectReadAhead) {
+      ASSERT_GT(stats.spillReadAheadTimeUs, 0);
+      ASSERT_LE(stats.spillReadAheadTimeUs, stats.spillReadTimeUs);
+    } else {
+      ASSERT_EQ(stats.spillReadAheadTimeUs, 0);
+      ASSERT_EQ(stats.spillReadAheadWaitTimeUs, 0);
+    }
+  }
+}
+
+TEST_P(SpillTest, spillTiers) {
+  const int numBatches = 10;
+  const int numRowsPerBatch = 1'000;
+  const std::vector<CompareFlags> compareFlags{CompareFlags{}};
+  auto localDir = exec::test::TempDirectoryPath::create();
+  auto remoteDir = exec::test::TempDirectoryPath::create();
+  auto makeBatch = [&](int batch) {
+    return makeRowVector({makeFlatVector<int64_t>(
+        numRowsPerBatch,
+        [&](auto row) { return batch * numRowsPerBatch + row; })});
+  };
+
+  // Measures the spill bytes of a batch without tiers.
+  uint64_t batchBytes;
+  {
+    SpillState state(
+        [&]() -> const std::string& { return localDir->getPath(); },
+        updateSpilledBytesCb_,
+        "size",
+        1,
+        1,
+        compareFlags,
+        kGB,
+        0,
+        compressionKind_,
+        pool(),
+        &spillStats_);
+    state.setPartitionSpilled(0);
+    batchBytes = state.appendToPartition(0, makeBatch(0));
+  }
+  ASSERT_GT(batchBytes, 0);
+
+  // The local tier has room for about a third of the batches.
+  SpillSpaceManager manager(
+      {{"", numBatches / 3 * batchBytes + batchBytes / 2},
+       {remoteDir->getPath(), kGB}});
+  auto makeTiers = [&](SpillSpaceManager& tierManager) {
+    common::SpillTiers tiers;
+    tiers.numTiers = 2;
+    tiers.getDirectoryPathCb = [&](int32_t tier) -> std::string_view {
+      return tier == 0 ? localDir->getPath() : remoteDir->getPath();
+    };
+    tiers.reserveCb = [&](int32_t tier, uint64_t bytes) {
+      return tierManager.tryReserve(tier, bytes);
+    };
+    return tiers;
+  };
+
+  spillStats_.wlock()->reset();
+  SpillState state(
+      [&]() -> const std::string& { return localDir->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      1,
+      compareFlags,
+      kGB,
+      0,
+      compressionKind_,
+      pool(),
+      &spillStats_,
+      "",
+      nullptr,
+      0,
+      makeTiers(manager));
+  state.setPartitionSpilled(0);
+  for (auto batch = 0; batch < numBatches; ++batch) {
+    state.appendToPartition(0, makeBatch(batch));
+  }
+  // The spill data continues on the remote tier once the local one is full.
+  auto files = state.finish(0);
+  ASSERT_EQ(files.size(), 2);
+  ASSERT_EQ(files[0].path.find(localDir->getPath()), 0);
+  ASSERT_EQ(files[1].path.find(remoteDir->getPath()), 0);
+  ASSERT_EQ(manager.usedBytes(0), files[0].size);
+  ASSERT_EQ(manager.usedBytes(1), files[1].size);
+  ASSERT_EQ(spillStats_.rlock()->spilledFallbackBytes, files[1].size);
+  ASSERT_EQ(runtimeStats_.at("spillTier0Bytes").sum, files[0].size);
+  ASSERT_EQ(runtimeStats_.at("spillTier1Bytes").sum, files[1].size);
+
+  SpillPartition spillPartition(SpillPartitionId{0, 0}, std::move(files));
+  auto merge = spillPartition.createOrderedReader(pool(), &spillStats_);
+  for (auto i = 0; i < numBatches * numRowsPerBatch; ++i) {
+    auto* stream = merge->next();
+    ASSERT_NE(stream, nullptr);
+    ASSERT_EQ(stream->decoded(0).valueAt<int64_t>(stream->currentIndex()), i);
+    stream->pop();
+  }
+  ASSERT_EQ(merge->next(), nullptr);
+
+  // Fails if no tier has room.
+  SpillSpaceManager fullManager({{"", 1}, {remoteDir->getPath(), 1}});
+  SpillState fullState(
+      [&]() -> const std::string& { return localDir->getPath(); },
+      updateSpilledBytesCb_,
+      "full",
+      1,
+      1,
+      compareFlags,
+      kGB,
+      0,
+      compressionKind_,
+      pool(),
+      &spillStats_,
+      "",
+      nullptr,
+      0,
+      makeTiers(fullManager));
+  fullState.setPartitionSpilled(0);
+  VELOX_ASSERT_THROW(
+      fullState.appendToPartition(0, makeBatch(0)),
+      "No spill tier has room for");
+}
+
+TEST_P(SpillTest, columnarFormat) {
+  const int numBatches = 10;
+  const int numRowsPerBatch = 1'000;
+  const std::vector<CompareFlags> compareFlags{CompareFlags{}};
+  // A sorted key, a dictionary over the same names in all batches and a
+  // constant.
+  auto names = makeFlatVector<std::string>(
+      10, [](auto row) { return fmt::format("a long name {}", row); });
+  std::vector<RowVectorPtr> batches;
+  for (auto batch = 0; batch < numBatches; ++batch) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            numRowsPerBatch,
+            [&](auto row) { return batch * numRowsPerBatch + row; }),
+        BaseVector::wrapInDictionary(
+            nullptr,
+            makeIndices(numRowsPerBatch, [](auto row) { return row % 10; }),
+            numRowsPerBatch,
+            names),
+        makeConstant<int32_t>(batch, numRowsPerBatch),
+    }));
+  }
+
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  auto spill = [&](bool columnarFormat) {
+    SpillState state(
+        [&]() -> const std::string& { return tempDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        columnarFormat ? "columnar" : "presto",
+        1,
+        1,
+        compareFlags,
+        kGB,
+        0,
+        compressionKind_,
+        pool(),
+        &spillStats_,
+        {},
+        nullptr,
+        0,
+        {},
+        columnarFormat);
+    state.setPartitionSpilled(0);
+    for (const auto& batch : batches) {
+      state.appendToPartition(0, batch);
+    }
+    state.finishFile(0);
+    auto files = state.finish(0);
+    EXPECT_EQ(files.size(), 1);
+    return files[0];
+  };
+  const auto prestoFile = spill(false);
+  const auto columnarFile = spill(true);
+  ASSERT_FALSE(prestoFile.columnarFormat);
+  ASSERT_TRUE(columnarFile.columnarFormat);
+  if (compressionKind_ == common::CompressionKind::CompressionKind_NONE) {
+    // The names and the constants are not flattened on disk.
+    ASSERT_LT(columnarFile.size * 4, prestoFile.size);
+  }
+
+  for (const auto& file : {prestoFile, columnarFile}) {
+    SCOPED_TRACE(fmt::format("columnarFormat: {}", file.columnarFormat));
+    RowVectorPtr batch;
+    auto reader = SpillReadFile::create(file, pool(), &spillStats_);
+    for (const auto& expected : batches) {
+      ASSERT_TRUE(reader->nextBatch(batch));
+      assertEqualVectors(expected, batch);
+      if (file.columnarFormat) {
+        ASSERT_EQ(
+            batch->childAt(1)->encoding(),
+            VectorEncoding::Simple::DICTIONARY);
+        ASSERT_TRUE(batch->childAt(2)->isConstantEncoding());
+      }
+    }
+    ASSERT_FALSE(reader->nextBatch(batch));
+
+    // Reads only the constant and the key.
+    batch = nullptr;
+    auto projectedReader =
+        SpillReadFile::create(file, pool(), &spillStats_, nullptr, {2, 0});
+    for (const auto& expected : batches) {
+      ASSERT_TRUE(projectedReader->nextBatch(batch));
+      ASSERT_EQ(batch->childrenSize(), 2);
+      assertEqualVectors(expected->childAt(2), batch->childAt(0));
+      assertEqualVectors(expected->childAt(0), batch->childAt(1));
+    }
+    ASSERT_FALSE(projectedReader->nextBatch(batch));
+
+    // The sorted merge reads the keys in order.
+    SpillPartition spillPartition(SpillPartitionId{0, 0}, {file});
+    auto merge = spillPartition.createOrderedReader(pool(), &spillStats_);
+    for (auto i = 0; i < numBatches * numRowsPerBatch; ++i) {
+      auto* stream = merge->next();
+      ASSERT_NE(stream, nullptr);
+      ASSERT_EQ(stream->decoded(0).valueAt<int64_t>(stream->currentIndex()), i);
+      ASSERT_EQ(
+          stream->decoded(2).valueAt<int32_t>(stream->currentIndex()),
+          i / numRowsPerBatch);
+      stream->pop();
+    }
+    ASSERT_EQ(merge->next(), nullptr);
+  }
+}
+
+TEST_P(SpillTest, zstdDictionary) {
+  const int numBatches = 20;
+  const int numRowsPerBatch = 20;
+  std::vector<RowVectorPtr> batches;
+  for (auto batch = 0; batch < numBatches; ++batch) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            numRowsPerBatch,
+            [&](auto row) { return batch * numRowsPerBatch + row; }),
+        makeFlatVector<std::string>(
+            numRowsPerBatch,
+            [&](auto row) {
+              return fmt::format(
+                  "customer name {} of nation {}", row * 7, batch % 5);
+            }),
+    }));
+  }
+
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  auto spill = [&](uint64_t zstdDictionarySize) {
+    // Flushes each batch to a page of its own.
+    SpillState state(
+        [&]() -> const std::string& { return tempDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        fmt::format("dictionary-{}", zstdDictionarySize),
+        1,
+        0,
+        {},
+        kGB,
+        0,
+        compressionKind_,
+        pool(),
+        &spillStats_,
+        {},
+        nullptr,
+        0,
+        {},
+        false,
+        zstdDictionarySize);
+    state.setPartitionSpilled(0);
+    for (const auto& batch : batches) {
+      state.appendToPartition(0, batch);
+    }
+    state.finishFile(0);
+    auto files = state.finish(0);
+    EXPECT_EQ(files.size(), 1);
+    return files[0];
+  };
+  const auto plainFile = spill(0);
+  const auto dictionaryFile = spill(4 << 10);
+  ASSERT_EQ(plainFile.zstdDictionary, nullptr);
+  if (compressionKind_ == common::CompressionKind::CompressionKind_ZSTD) {
+    ASSERT_NE(dictionaryFile.zstdDictionary, nullptr);
+    ASSERT_LT(dictionaryFile.size, plainFile.size);
+  } else {
+    ASSERT_EQ(dictionaryFile.zstdDictionary, nullptr);
+  }
+
+  for (const auto& file : {plainFile, dictionaryFile}) {
+    RowVectorPtr batch;
+    auto reader = SpillReadFile::create(file, pool(), &spillStats_);
+    for (const auto& expected : batches) {
+      ASSERT_TRUE(reader->nextBatch(batch));
+      assertEqualVectors(expected, batch);
+    }
+    ASSERT_FALSE(reader->nextBatch(batch));
+  }
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
@@ -535,6 +989,79 @@ TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   spillStateTest(1, 2, 8, 8, {}, 8 * 2);
 }
 
+TEST_P(SpillTest, mergeFiles) {
+  // Every two batches make one spill file.
+  const int numBatches = 16;
+  const int numRowsPerBatch = 100;
+  struct {
+    uint32_t maxFanIn;
+    uint64_t expectedMergePasses;
+    size_t expectedNumFiles;
+
+    std::string debugString() const {
+      return fmt::format(
+          "maxFanIn: {}, expectedMergePasses: {}, expectedNumFiles: {}",
+          maxFanIn,
+          expectedMergePasses,
+          expectedNumFiles);
+    }
+  } testSettings[] = {{2, 2, 2}, {3, 1, 3}, {7, 1, 7}, {8, 0, 8}, {0, 0, 8}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    setupSpillState(kGB, 0, 1, numBatches, numRowsPerBatch);
+    const auto spilledFiles = state_->testingSpilledFilePaths();
+    ASSERT_EQ(spilledFiles.size(), numBatches / 2);
+    SpillPartition spillPartition(SpillPartitionId{0, 0}, state_->finish(0));
+    const auto spilledBytes = spillStats_.rlock()->spilledBytes;
+
+    common::SpillConfig spillConfig;
+    spillConfig.updateAndCheckSpillLimitCb = updateSpilledBytesCb_;
+    spillConfig.writeBufferSize = 0;
+    spillConfig.maxMergeFanIn = testData.maxFanIn;
+    auto merge = spillPartition.createOrderedReader(
+        pool(), &spillStats_, &spillConfig);
+    ASSERT_EQ(merge->numStreams(), testData.expectedNumFiles);
+
+    const auto stats = spillStats_.copy();
+    ASSERT_EQ(stats.spillMergePasses, testData.expectedMergePasses);
+    if (testData.expectedMergePasses == 0) {
+      ASSERT_EQ(stats.spillMergeBytes, 0);
+    } else {
+      ASSERT_GT(stats.spillMergeBytes, 0);
+      ASSERT_EQ(stats.spilledBytes, spilledBytes + stats.spillMergeBytes);
+      // The merged files are removed.
+      auto fs = filesystems::getFileSystem(tempDir_->getPath(), nullptr);
+      int numRemovedFiles{0};
+      for (const auto& spilledFile : spilledFiles) {
+        numRemovedFiles += !fs->exists(spilledFile);
+      }
+      ASSERT_GT(numRemovedFiles, 0);
+    }
+
+    for (auto i = 0; i < numBatches * numRowsPerBatch; ++i) {
+      auto* stream = merge->next();
+      ASSERT_NE(stream, nullptr);
+      if (values_[i].has_value()) {
+        ASSERT_EQ(
+            values_[i].value(),
+            stream->decoded(0).valueAt<int64_t>(stream->currentIndex()))
+            << i;
+      } else {
+        ASSERT_TRUE(stream->decoded(0).isNullAt(stream->currentIndex())) << i;
+      }
+      stream->pop();
+    }
+    ASSERT_EQ(merge->next(), nullptr);
+  }
+
+  common::SpillConfig spillConfig;
+  VELOX_ASSERT_THROW(
+      SpillPartition(SpillPartitionId{0, 0})
+          .mergeFiles(1, spillConfig, pool(), &spillStats_),
+      "");
+}
+
 TEST_P(SpillTest, spillPartitionId) {
   SpillPartitionId partitionId1_2(1, 2);
   ASSERT_EQ(partitionId1_2.partitionBitOffset(), 1);
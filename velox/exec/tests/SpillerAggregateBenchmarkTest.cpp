@@ -40,9 +40,16 @@ int main(int argc, char* argv[]) {
   } else if (
       spillerTypeName == Spiller::typeName(Spiller::Type::kAggregateOutput)) {
     spillerType = Spiller::Type::kAggregateOutput;
+  } else if (
+      spillerTypeName ==
+      Spiller::typeName(Spiller::Type::kAggregateInputPartitioned)) {
+    spillerType = Spiller::Type::kAggregateInputPartitioned;
+  } else if (
+      spillerTypeName == Spiller::typeName(Spiller::Type::kOrderByInput)) {
+    spillerType = Spiller::Type::kOrderByInput;
   } else {
     VELOX_UNSUPPORTED(
-        "The spiller type {} is not one of [AGGREGATE_INPUT, AGGREGATE_OUTPUT], the aggregate spiller dose not support it.",
+        "The spiller type {} is not one of [AGGREGATE_INPUT, AGGREGATE_OUTPUT, AGGREGATE_INPUT_PARTITIONED, ORDER_BY_INPUT], the aggregate spiller dose not support it.",
         spillerTypeName);
   }
   auto test = std::make_unique<test::AggregateSpillBenchmarkBase>(spillerType);
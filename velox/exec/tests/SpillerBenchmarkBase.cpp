@@ -16,6 +16,7 @@
 
 #include <gflags/gflags.h>
 #include <glog/logging.h>
+#include <sys/resource.h>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -74,6 +75,11 @@ DEFINE_uint64(
     spiller_benchmark_write_buffer_size,
     1 << 20,
     "The spill write buffer size");
+DEFINE_uint32(
+    spiller_benchmark_num_partition_bits,
+    0,
+    "The number of hash bits that select the spill partition of the hash "
+    "join and hash partitioned aggregation spillers");
 
 using namespace facebook::velox::memory;
 
@@ -130,7 +136,7 @@ void SpillerBenchmarkBase::printStats() const {
   // List files under file path.
   SpillPartitionSet partitionSet;
   spiller_->finishSpill(partitionSet);
-  VELOX_CHECK_EQ(partitionSet.size(), 1);
+  LOG(INFO) << partitionSet.size() << " partitions have been spilled";
   const auto files = fs_->list(spillDir_);
   for (const auto& file : files) {
     auto rfile = fs_->openFileForRead(file);
@@ -139,9 +145,67 @@ void SpillerBenchmarkBase::printStats() const {
   }
 }
 
+void SpillerBenchmarkBase::readSpilledData() {
+  SpillPartitionSet partitionSet;
+  spiller_->finishSpill(partitionSet);
+  mergedRead_ = spiller_->type() == Spiller::Type::kAggregateInput ||
+      spiller_->type() == Spiller::Type::kOrderByInput;
+  const auto startCpuTimeUs = processCpuTimeUs();
+  {
+    MicrosecondTimer timer(&readTimeUs_);
+    for (auto& [id, partition] : partitionSet) {
+      if (mergedRead_) {
+        auto merge = partition->createOrderedReader(pool_.get(), &spillStats_);
+        while (auto* stream = merge->next()) {
+          ++numReadRows_;
+          stream->pop();
+        }
+      } else {
+        auto reader =
+            partition->createUnorderedReader(pool_.get(), &spillStats_);
+        RowVectorPtr batch;
+        while (reader->nextBatch(batch)) {
+          numReadRows_ += batch->size();
+        }
+      }
+    }
+  }
+  readCpuTimeUs_ = processCpuTimeUs() - startCpuTimeUs;
+}
+
+std::string SpillerBenchmarkBase::ioStats() const {
+  const auto stats = spillStats_.copy();
+  const auto throughput = [](uint64_t bytes, uint64_t timeUs) {
+    return succinctBytes(timeUs == 0 ? 0 : bytes * 1'000'000 / timeUs);
+  };
+  const auto cpuPerMB = [](uint64_t cpuTimeUs, uint64_t bytes) {
+    return succinctMicros(bytes == 0 ? 0 : cpuTimeUs * (1 << 20) / bytes);
+  };
+  return fmt::format(
+      "write {} in {} at {}/s, {} cpu/MB; {} {} rows, {} in {} at {}/s, "
+      "{} cpu/MB",
+      succinctBytes(stats.spilledBytes),
+      succinctMicros(executionTimeUs_),
+      throughput(stats.spilledBytes, executionTimeUs_),
+      cpuPerMB(executionCpuTimeUs_, stats.spilledBytes),
+      mergedRead_ ? "merge" : "read",
+      numReadRows_,
+      succinctBytes(stats.spillReadBytes),
+      succinctMicros(readTimeUs_),
+      throughput(stats.spillReadBytes, readTimeUs_),
+      cpuPerMB(readCpuTimeUs_, stats.spillReadBytes));
+}
+
 void SpillerBenchmarkBase::cleanup() {
   LOG(INFO) << "Remove spill dir: " << spillDir_;
   fs_->rmdir(spillDir_);
 }
 
+uint64_t processCpuTimeUs() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1'000'000 +
+      usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
 } // namespace facebook::velox::exec::test
@@ -35,6 +35,7 @@ DECLARE_uint32(spiller_benchmark_spill_vector_size);
 DECLARE_uint64(spiller_benchmark_max_spill_file_size);
 DECLARE_uint64(spiller_benchmark_min_spill_run_size);
 DECLARE_uint64(spiller_benchmark_write_buffer_size);
+DECLARE_uint32(spiller_benchmark_num_partition_bits);
 
 namespace facebook::velox::exec::test {
 // This test measures the spill input overhead in spill join & probe.
@@ -50,9 +51,20 @@ class SpillerBenchmarkBase {
   /// Runs the test.
   virtual void run() = 0;
 
-  /// Prints out the measured test stats.
+  /// Prints out the measured test stats. This finishes the spill, so it can
+  /// not be combined with readSpilledData().
   virtual void printStats() const;
 
+  /// Finishes the spill and reads back all the spilled partitions. The sorted
+  /// spill runs of aggregation and order by input are merged with an ordered
+  /// reader as these operators do when they unspill. The others are read with
+  /// an unordered reader.
+  void readSpilledData();
+
+  /// Returns the wall time, throughput and cpu time per MB of the spill write
+  /// in run() and of the read in readSpilledData().
+  std::string ioStats() const;
+
   /// Cleans up the test.
   virtual void cleanup();
 
@@ -72,5 +84,15 @@ class SpillerBenchmarkBase {
   // Stats.
   uint64_t executionTimeUs_{0};
   folly::Synchronized<common::SpillStats> spillStats_;
+  // The user and system cpu time of the process in run(), including the
+  // spill executor threads.
+  uint64_t executionCpuTimeUs_{0};
+  uint64_t readTimeUs_{0};
+  uint64_t readCpuTimeUs_{0};
+  uint64_t numReadRows_{0};
+  bool mergedRead_{false};
 };
+
+/// Returns the user and system cpu time of the process so far.
+uint64_t processCpuTimeUs();
 } // namespace facebook::velox::exec::test
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/String.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/connectors/hive/HiveConnector.h"
+#include "velox/exec/tests/AggregateSpillBenchmarkBase.h"
+#include "velox/exec/tests/JoinSpillInputBenchmarkBase.h"
+#include "velox/serializers/PrestoSerializer.h"
+
+DEFINE_string(
+    spiller_matrix_spiller_types,
+    "AGGREGATE_INPUT,ORDER_BY_INPUT,AGGREGATE_INPUT_PARTITIONED,"
+    "HASH_JOIN_PROBE",
+    "Comma separated spiller types to run. AGGREGATE_INPUT and "
+    "ORDER_BY_INPUT are read back with a merge of the sorted spill runs like "
+    "their operators do when they unspill");
+DEFINE_string(
+    spiller_matrix_compression_kinds,
+    "none,lz4,zstd",
+    "Comma separated compression kinds of the spill files");
+DEFINE_string(
+    spiller_matrix_write_buffer_sizes,
+    "65536,1048576,8388608",
+    "Comma separated spill write buffer sizes in bytes");
+DEFINE_string(
+    spiller_matrix_paths,
+    "",
+    "Comma separated spill directories, e.g. '/local/spill,/dev/shm/spill,"
+    "s3://bucket/spill' for a local disk, tmpfs and a remote file system. "
+    "Remote file systems must be enabled in the build, e.g. with "
+    "VELOX_ENABLE_S3. An empty value uses a local temporary directory");
+DEFINE_string(
+    spiller_matrix_partition_bits,
+    "0,3",
+    "Comma separated numbers of spill partition bits for the hash join and "
+    "hash partitioned aggregation spillers");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+std::vector<std::string> splitFlag(const std::string& flag) {
+  std::vector<std::string> values;
+  folly::split(',', flag, values);
+  return values;
+}
+
+Spiller::Type toSpillerType(const std::string& name) {
+  for (auto i = 0; i < static_cast<int>(Spiller::Type::kNumTypes); ++i) {
+    const auto type = static_cast<Spiller::Type>(i);
+    if (Spiller::typeName(type) == name) {
+      return type;
+    }
+  }
+  VELOX_USER_FAIL("Unknown spiller type: {}", name);
+}
+
+void setFlag(const std::string& name, const std::string& value) {
+  VELOX_CHECK(
+      !gflags::SetCommandLineOption(name.c_str(), value.c_str()).empty(),
+      "Failed to set --{}={}",
+      name,
+      value);
+}
+} // namespace
+
+// Runs the spill write and read back of each combination of the spiller
+// types, compression kinds, write buffer sizes, spill directories and
+// partition bits in the --spiller_matrix_* flags and prints one line of
+// throughput and cpu per byte for each.
+int main(int argc, char* argv[]) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  memory::MemoryManager::initialize({});
+  serializer::presto::PrestoVectorSerde::registerVectorSerde();
+  filesystems::registerLocalFileSystem();
+  // Registers the remote file systems enabled in the build.
+  connector::getConnectorFactory(
+      connector::hive::HiveConnectorFactory::kHiveConnectorName);
+
+  for (const auto& typeName : splitFlag(FLAGS_spiller_matrix_spiller_types)) {
+    const auto spillerType = toSpillerType(typeName);
+    const bool partitioned = spillerType == Spiller::Type::kHashJoinProbe ||
+        spillerType == Spiller::Type::kAggregateInputPartitioned;
+    for (const auto& path : splitFlag(FLAGS_spiller_matrix_paths)) {
+      for (const auto& kind :
+           splitFlag(FLAGS_spiller_matrix_compression_kinds)) {
+        for (const auto& bufferSize :
+             splitFlag(FLAGS_spiller_matrix_write_buffer_sizes)) {
+          for (const auto& bits :
+               splitFlag(FLAGS_spiller_matrix_partition_bits)) {
+            setFlag("spiller_benchmark_path", path);
+            setFlag("spiller_benchmark_compression_kind", kind);
+            setFlag("spiller_benchmark_write_buffer_size", bufferSize);
+            setFlag("spiller_benchmark_num_partition_bits", bits);
+            std::unique_ptr<test::SpillerBenchmarkBase> test;
+            if (spillerType == Spiller::Type::kHashJoinProbe) {
+              test = std::make_unique<test::JoinSpillInputBenchmarkBase>();
+            } else {
+              test = std::make_unique<test::AggregateSpillBenchmarkBase>(
+                  spillerType);
+            }
+            test->setUp();
+            test->run();
+            test->readSpilledData();
+            std::cout << fmt::format(
+                             "{} path={} compression={} writeBuffer={} "
+                             "partitionBits={}: {}",
+                             typeName,
+                             path.empty() ? "<temp>" : path,
+                             kind,
+                             succinctBytes(std::stoull(bufferSize)),
+                             bits,
+                             test->ioStats())
+                      << std::endl;
+            test->cleanup();
+            // The partition bits only matter to the partitioned spillers.
+            if (!partitioned) {
+              break;
+            }
+          }
+        }
+      }
+    }
+  }
+  return 0;
+}
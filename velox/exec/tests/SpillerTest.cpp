@@ -562,7 +562,9 @@ class SpillerTest : public exec::test::RowContainerTestBase {
         type_ == Spiller::Type::kOrderByOutput) {
       spiller_ = std::make_unique<Spiller>(
           type_, rowContainer_.get(), rowType_, &spillConfig, &spillStats_);
-    } else if (type_ == Spiller::Type::kRowNumber) {
+    } else if (
+        type_ == Spiller::Type::kRowNumber ||
+        type_ == Spiller::Type::kAggregateInputPartitioned) {
       spiller_ = std::make_unique<Spiller>(
           type_,
           rowContainer_.get(),
@@ -744,7 +746,8 @@ class SpillerTest : public exec::test::RowContainerTestBase {
     ASSERT_TRUE(
         type_ == Spiller::Type::kHashJoinBuild ||
         type_ == Spiller::Type::kHashJoinProbe ||
-        type_ == Spiller::Type::kRowNumber);
+        type_ == Spiller::Type::kRowNumber ||
+        type_ == Spiller::Type::kAggregateInputPartitioned);
 
     const int numSpillPartitions = type_ != Spiller::Type::kHashJoinProbe
         ? numPartitions_
@@ -841,7 +844,8 @@ class SpillerTest : public exec::test::RowContainerTestBase {
       ASSERT_GT(stats.spilledPartitions, 0);
       ASSERT_EQ(stats.spillSortTimeUs, 0);
       if (type_ == Spiller::Type::kHashJoinBuild ||
-          type_ == Spiller::Type::kRowNumber) {
+          type_ == Spiller::Type::kRowNumber ||
+          type_ == Spiller::Type::kAggregateInputPartitioned) {
         ASSERT_GT(stats.spillFillTimeUs, 0);
       } else {
         ASSERT_EQ(stats.spillFillTimeUs, 0);
@@ -895,6 +899,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
     ASSERT_TRUE(
         type_ == Spiller::Type::kHashJoinBuild ||
         type_ == Spiller::Type::kRowNumber ||
+        type_ == Spiller::Type::kAggregateInputPartitioned ||
         type_ == Spiller::Type::kHashJoinProbe);
 
     SpillPartitionSet spillPartitionSet;
@@ -967,6 +972,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
     ASSERT_TRUE(
         type_ == Spiller::Type::kHashJoinBuild ||
         type_ == Spiller::Type::kRowNumber ||
+        type_ == Spiller::Type::kAggregateInputPartitioned ||
         type_ == Spiller::Type::kHashJoinProbe);
 
     if (numPartitions_ > 0) {
@@ -1166,6 +1172,7 @@ class NoHashJoin : public SpillerTest,
             {Spiller::Type::kHashJoinProbe,
              Spiller::Type::kHashJoinBuild,
              Spiller::Type::kRowNumber,
+             Spiller::Type::kAggregateInputPartitioned,
              Spiller::Type::kOrderByOutput}}
         .getTestParams();
   }
@@ -1317,6 +1324,7 @@ class AggregationOutputOnly : public SpillerTest,
             {Spiller::Type::kAggregateInput,
              Spiller::Type::kHashJoinBuild,
              Spiller::Type::kRowNumber,
+             Spiller::Type::kAggregateInputPartitioned,
              Spiller::Type::kHashJoinProbe,
              Spiller::Type::kOrderByInput,
              Spiller::Type::kOrderByOutput}}
@@ -1418,6 +1426,7 @@ class OrderByOutputOnly : public SpillerTest,
              Spiller::Type::kHashJoinBuild,
              Spiller::Type::kHashJoinProbe,
              Spiller::Type::kRowNumber,
+             Spiller::Type::kAggregateInputPartitioned,
              Spiller::Type::kOrderByInput}}
         .getTestParams();
   }
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/TableScan.h"
+#include <folly/ScopeGuard.h>
 #include <folly/synchronization/Baton.h>
 #include <folly/synchronization/Latch.h>
 #include <atomic>
@@ -30,6 +31,7 @@
 #include "velox/exec/Exchange.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/SplitResultCache.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/Cursor.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
@@ -291,6 +293,72 @@ TEST_F(TableScanTest, connectorStats) {
   verifyCacheStats(hiveConnector->clearFileHandleCache(), 0, 0, 99);
 }
 
+TEST_F(TableScanTest, splitResultCache) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  constexpr uint64_t kMaxBytes = 64 << 20;
+  constexpr uint64_t kMaxEntryBytes = 16 << 20;
+  SplitResultCache cache(
+      memory::memoryManager()->addRootPool("splitResultCache"),
+      kMaxBytes,
+      kMaxEntryBytes);
+  SplitResultCache::setInstance(&cache);
+  SCOPE_EXIT {
+    SplitResultCache::setInstance(nullptr);
+  };
+
+  auto plan = PlanBuilder()
+                  .tableScan(rowType_, {"c0 > 0"})
+                  .project({"c0", "c1"})
+                  .planNode();
+  const auto scanId = plan->sources()[0]->id();
+  auto runQuery = [&](const std::string& modifiedTime, bool enabled) {
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(
+                core::QueryConfig::kSplitResultCacheEnabled,
+                enabled ? "true" : "false")
+            .split(HiveConnectorSplitBuilder(filePath->getPath())
+                       .infoColumn("$file_modified_time", modifiedTime)
+                       .build())
+            .assertResults("SELECT c0, c1 FROM tmp WHERE c0 > 0");
+    const auto& customStats =
+        toPlanStats(task->taskStats()).at(scanId).customStats;
+    auto it = customStats.find("splitResultCacheHits");
+    return it == customStats.end() ? 0 : it->second.sum;
+  };
+
+  ASSERT_EQ(runQuery("1", true), 0);
+  ASSERT_EQ(cache.stats().numEntries, 1);
+  ASSERT_EQ(runQuery("1", true), 1);
+  ASSERT_EQ(cache.stats().numHits, 1);
+
+  // A modified file is not read from the cache.
+  ASSERT_EQ(runQuery("2", true), 0);
+  ASSERT_EQ(cache.stats().numEntries, 2);
+
+  // Queries without the config do not use the cache.
+  ASSERT_EQ(runQuery("1", false), 0);
+  ASSERT_EQ(cache.stats().numLookups, 3);
+
+  // A scan with a different filter has a different key.
+  plan = PlanBuilder()
+             .tableScan(rowType_, {"c0 > 1"})
+             .project({"c0", "c1"})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kSplitResultCacheEnabled, "true")
+      .split(HiveConnectorSplitBuilder(filePath->getPath())
+                 .infoColumn("$file_modified_time", "1")
+                 .build())
+      .assertResults("SELECT c0, c1 FROM tmp WHERE c0 > 1");
+  ASSERT_EQ(cache.stats().numEntries, 3);
+  ASSERT_EQ(cache.stats().numHits, 1);
+}
+
 TEST_F(TableScanTest, columnAliases) {
   auto vectors = makeVectors(1, 1'000);
   auto filePath = TempFilePath::create();
@@ -1278,6 +1346,26 @@ TEST_F(TableScanTest, batchSize) {
   }
 }
 
+TEST_F(TableScanTest, adaptiveBatchSize) {
+  // Narrow rows of a BIGINT column, so that about 250 rows fit in 2KB.
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  auto vectors = makeVectors(1, 20'000, rowType);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .plan(PlanBuilder().tableScan(rowType).planNode())
+                  .splits(makeHiveConnectorSplits({filePath}))
+                  .config(QueryConfig::kAdaptiveOutputBatchBytes, "2048")
+                  .assertResults("SELECT * FROM tmp");
+  const auto opStats = task->taskStats().pipelineStats[0].operatorStats[0];
+  EXPECT_GE(opStats.outputVectors, 50);
+  const auto& batchRows = opStats.runtimeStats.at("adaptiveOutputBatchRows");
+  EXPECT_GT(batchRows.count, 1);
+  EXPECT_LT(batchRows.max, 1'024);
+}
+
 // Test that adding the same split with the same sequence id does not cause
 // double read and the 2nd split is ignored.
 TEST_F(TableScanTest, sequentialSplitNoDoubleRead) {
@@ -1389,6 +1477,48 @@ TEST_F(TableScanTest, multipleSplits) {
   }
 }
 
+TEST_F(TableScanTest, adaptiveSplitPreload) {
+  constexpr int32_t kNumSplits = 20;
+  constexpr int32_t kMaxPreload = 4;
+  auto filePaths = makeFilePaths(kNumSplits);
+  auto vectors = makeVectors(kNumSplits, 100);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  auto task =
+      AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+          .config(
+              core::QueryConfig::kMaxSplitPreloadPerDriver,
+              std::to_string(kMaxPreload))
+          .config(core::QueryConfig::kAdaptiveSplitPreloadEnabled, "true")
+          .splits(makeHiveConnectorSplits(filePaths))
+          .assertResults("SELECT * FROM tmp");
+  auto stats = getTableScanRuntimeStats(task);
+  ASSERT_EQ(stats.at("splitPreloadDepth").count, kNumSplits);
+  ASSERT_GE(stats.at("splitPreloadDepth").min, 0);
+  ASSERT_LE(stats.at("splitPreloadDepth").max, kMaxPreload);
+  ASSERT_GT(stats.at("preloadedSplits").sum, 0);
+
+  // The scan closes once the limit is reached. The splits it preloaded are
+  // not opened.
+  auto plan = PlanBuilder(pool_.get())
+                  .tableScan(rowType_)
+                  .limit(0, 10, false)
+                  .planNode();
+  auto result =
+      AssertQueryBuilder(plan)
+          .config(
+              core::QueryConfig::kMaxSplitPreloadPerDriver,
+              std::to_string(kMaxPreload))
+          .config(core::QueryConfig::kAdaptiveSplitPreloadEnabled, "true")
+          .splits(makeHiveConnectorSplits(filePaths))
+          .copyResults(pool_.get(), task);
+  ASSERT_EQ(result->size(), 10);
+  ASSERT_LT(getTableScanStats(task).numSplits, kNumSplits);
+}
+
 TEST_F(TableScanTest, preloadingSplitClose) {
   auto filePaths = makeFilePaths(100);
   auto vectors = makeVectors(100, 100);
@@ -1448,6 +1578,50 @@ TEST_F(TableScanTest, waitForSplit) {
       duckDbQueryRunner_);
 }
 
+TEST_F(TableScanTest, elasticDrivers) {
+  const int32_t numSplits = 20;
+  auto filePaths = makeFilePaths(numSplits);
+  auto vectors = makeVectors(numSplits, 100);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+
+  core::PlanNodeId scanNodeId;
+  CursorParameters params;
+  params.planNode = PlanBuilder()
+                        .tableScan(rowType_)
+                        .capturePlanNodeId(scanNodeId)
+                        .project({"c0"})
+                        .planNode();
+  params.maxDrivers = 2;
+  // Without an adjustment interval, the drivers that are never blocked
+  // resume the parked ones whenever they take a split.
+  params.queryConfigs = {
+      {core::QueryConfig::kElasticDriversEnabled, "true"},
+      {core::QueryConfig::kElasticDriversMaxPerPipeline, "4"},
+      {core::QueryConfig::kElasticDriversAdjustIntervalMs, "0"}};
+  auto cursor = TaskCursor::create(params);
+  cursor->start();
+  auto task = cursor->task();
+  for (const auto& filePath : filePaths) {
+    task->addSplit(scanNodeId, makeHiveSplit(filePath->getPath()));
+  }
+  while (task->taskStats().pipelineStats[0].numElasticDriversAdded == 0) {
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  task->noMoreSplits(scanNodeId);
+
+  vector_size_t numRows = 0;
+  while (cursor->moveNext()) {
+    numRows += cursor->current()->size();
+  }
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  ASSERT_EQ(numRows, numSplits * 100);
+  // All the drivers were created at start.
+  ASSERT_EQ(toPlanStats(task->taskStats()).at(scanNodeId).numDrivers, 4);
+}
+
 DEBUG_ONLY_TEST_F(TableScanTest, tableScanSplitsAndWeights) {
   // Create 10 data files for 10 splits.
   const size_t numSplits{10};
@@ -2264,6 +2438,57 @@ TEST_F(TableScanTest, statsBasedSkippingNumerics) {
   EXPECT_EQ(size - 20'000, getTableScanStats(task).rawInputRows);
 }
 
+TEST_F(TableScanTest, statsBasedSkippingBeforeOpen) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  auto rowVector = makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+       makeFlatVector<std::string>(
+           1'000, [](auto row) { return std::to_string(row % 10); })});
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), rowVector);
+  createDuckDbTable({rowVector});
+
+  auto makeStats = [](int64_t min, int64_t max) {
+    return std::make_shared<dwio::common::IntegerColumnStatistics>(
+        100, false, std::nullopt, std::nullopt, min, max, std::nullopt);
+  };
+  // The splits after the first point to files that do not exist. The query
+  // fails if any of them is opened.
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  splits.push_back(HiveConnectorSplitBuilder(filePath->getPath())
+                       .columnStatistics("c0", makeStats(0, 999))
+                       .build());
+  splits.push_back(HiveConnectorSplitBuilder("/path/to/nowhere1.orc")
+                       .columnStatistics("c0", makeStats(5'000, 6'000))
+                       .numRows(100)
+                       .build());
+  splits.push_back(
+      HiveConnectorSplitBuilder("/path/to/nowhere2.orc").numRows(0).build());
+  // A column of only nulls does not pass the filter.
+  splits.push_back(HiveConnectorSplitBuilder("/path/to/nowhere3.orc")
+                       .columnStatistics(
+                           "c0",
+                           std::make_shared<dwio::common::ColumnStatistics>(
+                               0, true, std::nullopt, std::nullopt))
+                       .build());
+
+  auto plan = PlanBuilder().tableScan(rowType, {"c0 >= 500"}).planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .splits(splits)
+                  .assertResults("SELECT * FROM tmp WHERE c0 >= 500");
+  EXPECT_EQ(3, getSkippedSplitsStat(task));
+  EXPECT_EQ(4, getTableScanStats(task).numSplits);
+
+  // Statistics of columns without filters do not skip splits.
+  auto split = HiveConnectorSplitBuilder(filePath->getPath())
+                   .columnStatistics("c1", makeStats(5'000, 6'000))
+                   .build();
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .split(split)
+             .assertResults("SELECT * FROM tmp WHERE c0 >= 500");
+  EXPECT_EQ(0, getSkippedSplitsStat(task));
+}
+
 // Test stats-based skipping for list and map columns that don't have
 // filters themselves. Skipping is driven by a single bigint column.
 TEST_F(TableScanTest, statsBasedSkippingComplexTypes) {
@@ -4258,3 +4483,170 @@ DEBUG_ONLY_TEST_F(
       {filePath},
       "SELECT c5, max(c0), max(c1), max(c2), max(c3), max(c4) FROM tmp group by c5");
 }
+
+TEST_F(TableScanTest, topNDynamicFilter) {
+  // Each file holds a range of c0 above the ranges of the previous files.
+  const auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  auto filePaths = makeFilePaths(10);
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < filePaths.size(); ++i) {
+    vectors.push_back(makeRowVector(
+        {"c0", "c1"},
+        {makeFlatVector<int64_t>(
+             1'000, [i](auto row) { return i * 1'000 + (row * 7) % 1'000; }),
+         makeFlatVector<StringView>(
+             1'000, [](auto /*row*/) { return StringView("x"); })}));
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId topNId;
+  const auto plan = PlanBuilder()
+                        .tableScan(rowType)
+                        .topN({"c0"}, 10, false)
+                        .capturePlanNodeId(topNId)
+                        .planNode();
+
+  // The threshold of the TopN prunes the files after the first one.
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .splits(makeHiveConnectorSplits(filePaths))
+                  .assertResults("SELECT * FROM tmp ORDER BY c0 LIMIT 10");
+  auto runtimeStats = getTableScanRuntimeStats(task);
+  ASSERT_GT(runtimeStats["dynamicFiltersAccepted"].sum, 0);
+  ASSERT_GT(getSkippedSplitsStat(task) + getSkippedStridesStat(task), 0);
+  ASSERT_LT(toPlanStats(task->taskStats()).at(topNId).inputRows, 10'000);
+
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .splits(makeHiveConnectorSplits(filePaths))
+             .config(core::QueryConfig::kTopNDynamicFilterEnabled, false)
+             .assertResults("SELECT * FROM tmp ORDER BY c0 LIMIT 10");
+  ASSERT_EQ(getTableScanRuntimeStats(task).count("dynamicFiltersAccepted"), 0);
+  ASSERT_EQ(toPlanStats(task->taskStats()).at(topNId).inputRows, 10'000);
+
+  // Descending order with nulls first keeps the nulls.
+  vectors[3]->childAt(0)->setNull(5, true);
+  writeToFile(filePaths[3]->getPath(), vectors[3]);
+  createDuckDbTable(vectors);
+  const auto descPlan = PlanBuilder()
+                            .tableScan(rowType)
+                            .topN({"c0 DESC NULLS FIRST"}, 10, false)
+                            .planNode();
+  AssertQueryBuilder(descPlan, duckDbQueryRunner_)
+      .splits(makeHiveConnectorSplits(filePaths))
+      .assertResults("SELECT * FROM tmp ORDER BY c0 DESC NULLS FIRST LIMIT 10");
+}
+
+TEST_F(TableScanTest, aggregatePushdown) {
+  auto filePaths = makeFilePaths(3);
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < filePaths.size(); ++i) {
+    vectors.push_back(makeRowVector(
+        {"c0", "c1"},
+        {makeFlatVector<int64_t>(
+             1'000,
+             [i](auto row) { return i * 1'000 + row - 100; },
+             [](auto row) { return row % 7 == 0; }),
+         makeFlatVector<std::string>(
+             1'000, [](auto row) { return std::to_string(row % 100); })}));
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  const ColumnHandleMap assignments = {
+      {"c0", regularColumn("c0", BIGINT())},
+      {"c1", regularColumn("c1", VARCHAR())}};
+  auto makePlan = [&](std::vector<HiveAggregate> aggregates,
+                      const RowTypePtr& outputType,
+                      const std::vector<std::string>& finalAggregates,
+                      SubfieldFilters filters = {}) {
+    auto tableHandle = std::make_shared<HiveTableHandle>(
+        kHiveConnectorId,
+        "hive_table",
+        true,
+        std::move(filters),
+        nullptr,
+        nullptr,
+        std::unordered_map<std::string, std::string>{},
+        std::move(aggregates));
+    return PlanBuilder()
+        .startTableScan()
+        .outputType(outputType)
+        .tableHandle(tableHandle)
+        .assignments(assignments)
+        .endTableScan()
+        .singleAggregation({}, finalAggregates)
+        .planNode();
+  };
+
+  // The counts and the bounds of integers come from the file statistics.
+  auto plan = makePlan(
+      {{HiveAggregate::Kind::kCount, ""},
+       {HiveAggregate::Kind::kCount, "c0"},
+       {HiveAggregate::Kind::kMin, "c0"},
+       {HiveAggregate::Kind::kMax, "c0"}},
+      ROW({"a0", "a1", "a2", "a3"}, {BIGINT(), BIGINT(), BIGINT(), BIGINT()}),
+      {"sum(a0)", "sum(a1)", "min(a2)", "max(a3)"});
+  auto task = assertQuery(
+      plan, filePaths, "SELECT count(*), count(c0), min(c0), max(c0) FROM tmp");
+  auto runtimeStats = getTableScanRuntimeStats(task);
+  ASSERT_EQ(runtimeStats.at("numSplitsAggregatedFromStatistics").sum, 3);
+  ASSERT_EQ(toPlanStats(task->taskStats()).at("0").outputRows, 3);
+
+  // The bounds of strings are not exact in the statistics, so the rows are
+  // read.
+  plan = makePlan(
+      {{HiveAggregate::Kind::kCount, "c0"},
+       {HiveAggregate::Kind::kMin, "c1"},
+       {HiveAggregate::Kind::kMax, "c1"}},
+      ROW({"a0", "a1", "a2"}, {BIGINT(), VARCHAR(), VARCHAR()}),
+      {"sum(a0)", "min(a1)", "max(a2)"});
+  task = assertQuery(
+      plan, filePaths, "SELECT count(c0), min(c1), max(c1) FROM tmp");
+  ASSERT_EQ(
+      getTableScanRuntimeStats(task)
+          .at("numSplitsAggregatedFromStatistics")
+          .sum,
+      0);
+
+  // Filters apply before the aggregates. The first file has no rows that pass.
+  plan = makePlan(
+      {{HiveAggregate::Kind::kCount, ""},
+       {HiveAggregate::Kind::kMin, "c0"},
+       {HiveAggregate::Kind::kMax, "c1"}},
+      ROW({"a0", "a1", "a2"}, {BIGINT(), BIGINT(), VARCHAR()}),
+      {"sum(a0)", "min(a1)", "max(a2)"},
+      SubfieldFiltersBuilder().add("c0", greaterThan(1'500)).build());
+  task = assertQuery(
+      plan,
+      filePaths,
+      "SELECT count(*), min(c0), max(c1) FROM tmp WHERE c0 > 1500");
+  ASSERT_EQ(
+      getTableScanRuntimeStats(task)
+          .at("numSplitsAggregatedFromStatistics")
+          .sum,
+      0);
+
+  // A split that covers a part of a file is read. The file has one stripe,
+  // which starts in the split.
+  auto split = makeHiveConnectorSplit(filePaths[0]->getPath(), 0, 10);
+  plan = makePlan(
+      {{HiveAggregate::Kind::kCount, ""}},
+      ROW({"a0"}, {BIGINT()}),
+      {"sum(a0)"});
+  auto result =
+      AssertQueryBuilder(plan).split(split).copyResults(pool(), task);
+  ASSERT_EQ(result->childAt(0)->asFlatVector<int64_t>()->valueAt(0), 1'000);
+  ASSERT_EQ(
+      getTableScanRuntimeStats(task)
+          .at("numSplitsAggregatedFromStatistics")
+          .sum,
+      0);
+
+  plan = makePlan(
+      {{HiveAggregate::Kind::kMin, "c0"}},
+      ROW({"a0"}, {VARCHAR()}),
+      {"min(a0)"});
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan).split(split).copyResults(pool()),
+      "Output column a0 of type VARCHAR does not match aggregate min(c0) of type BIGINT");
+}
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/tests/utils/MergeTestBase.h"
 
 using namespace facebook::velox;
@@ -27,6 +28,7 @@ class TreeOfLosersTest : public testing::Test, public MergeTestBase {
   void testBoth(int32_t numValues, int32_t numStreams) {
     TestData testData = makeTestData(numValues, numStreams);
     test<TreeOfLosers<TestingStream>>(testData, true);
+    test<TreeOfLosers<TestingStream>>(testData, true, true);
     test<MergeArray<TestingStream>>(testData, true);
   }
 };
@@ -40,7 +42,12 @@ TEST_F(TreeOfLosersTest, merge) {
   testBoth(500, 1);
 }
 
-TEST_F(TreeOfLosersTest, nextWithEquals) {
+// Parameterized by whether the merge uses normalized keys.
+class TreeOfLosersNextWithEqualsTest
+    : public TreeOfLosersTest,
+      public testing::WithParamInterface<bool> {};
+
+TEST_P(TreeOfLosersNextWithEqualsTest, nextWithEquals) {
   constexpr int32_t kNumStreams = 17;
   std::vector<std::vector<uint32_t>> streams(kNumStreams);
   // Each stream is filled with consecutive integers. The probability of each
@@ -62,7 +69,7 @@ TEST_F(TreeOfLosersTest, nextWithEquals) {
   }
   std::sort(allNumbers.begin(), allNumbers.end());
   const int expectedNumMergeStreams = mergeStreams.size();
-  TreeOfLosers<TestingStream> merge(std::move(mergeStreams));
+  TreeOfLosers<TestingStream> merge(std::move(mergeStreams), GetParam());
   ASSERT_EQ(merge.numStreams(), expectedNumMergeStreams);
   bool expectRepeat = false;
   for (auto i = 0; i < allNumbers.size(); ++i) {
@@ -83,6 +90,11 @@ TEST_F(TreeOfLosersTest, nextWithEquals) {
   }
 }
 
+VELOX_INSTANTIATE_TEST_SUITE_P(
+    TreeOfLosersNextWithEqualsTest,
+    TreeOfLosersNextWithEqualsTest,
+    testing::Values(false, true));
+
 TEST_F(TreeOfLosersTest, singleWithEquals) {
   std::vector<uint32_t> allNumbers = {1, 2, 3, 4};
   // TestingStream produces reverse order.
@@ -424,7 +424,7 @@ TEST_F(UnnestTest, batchSize) {
       makeFlatVector<int64_t>(10'000 * 3, [](auto row) { return 1 + row % 3; }),
   });
 
-  // 17 rows per output allows to unnest 6 input rows at a time.
+  // 17 rows per output splits the elements of some rows across batches.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "17")
@@ -432,10 +432,10 @@ TEST_F(UnnestTest, batchSize) {
     auto stats = exec::toPlanStats(task->taskStats());
 
     ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
-    ASSERT_EQ(1 + 10'000 / 6, stats.at(unnestId).outputVectors);
+    ASSERT_EQ(1 + 30'000 / 17, stats.at(unnestId).outputVectors);
   }
 
-  // 2 rows per output allows to unnest 1 input row at a time.
+  // 2 rows per output splits the elements of each row across batches.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "2")
@@ -443,7 +443,7 @@ TEST_F(UnnestTest, batchSize) {
     auto stats = exec::toPlanStats(task->taskStats());
 
     ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
-    ASSERT_EQ(10'000, stats.at(unnestId).outputVectors);
+    ASSERT_EQ(30'000 / 2, stats.at(unnestId).outputVectors);
   }
 
   // 100K rows per output allows to unnest all at once.
@@ -458,3 +458,48 @@ TEST_F(UnnestTest, batchSize) {
     ASSERT_EQ(1, stats.at(unnestId).outputVectors);
   }
 }
+
+TEST_F(UnnestTest, splitLargeArrays) {
+  // One row has more elements than fit in an output batch. The arrays of a
+  // row have different sizes, so the shorter one is padded with nulls across
+  // batches.
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({0, 1, 2, 3, 4}),
+      makeArrayVector<int32_t>(
+          5,
+          [](auto row) {
+            static const vector_size_t kSizes[] = {3, 1'000, 0, 0, 7};
+            return kSizes[row];
+          },
+          [](auto row, auto index) { return row * 10'000 + index; },
+          nullEvery(3)),
+      makeArrayVector<int64_t>(
+          5,
+          [](auto row) {
+            static const vector_size_t kSizes[] = {1, 5, 10, 2, 0};
+            return kSizes[row];
+          },
+          [](auto row, auto index) { return row + index; }),
+  });
+
+  core::PlanNodeId unnestId;
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .unnest({"c0"}, {"c1", "c2"}, "ordinal")
+                  .capturePlanNodeId(unnestId)
+                  .planNode();
+
+  auto expected =
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kPreferredOutputBatchRows, "10000")
+          .copyResults(pool());
+  ASSERT_EQ(1 + 1'000 + 10 + 2 + 7, expected->size());
+
+  auto task = AssertQueryBuilder(plan)
+                  .config(core::QueryConfig::kPreferredOutputBatchRows, "7")
+                  .assertResults({expected});
+  auto stats = exec::toPlanStats(task->taskStats());
+  ASSERT_EQ(expected->size(), stats.at(unnestId).outputRows);
+  ASSERT_EQ(
+      bits::divRoundUp(expected->size(), 7), stats.at(unnestId).outputVectors);
+}
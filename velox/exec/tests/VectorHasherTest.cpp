@@ -224,6 +224,37 @@ TEST_F(VectorHasherTest, flat) {
   }
 }
 
+TEST_F(VectorHasherTest, flatNoNullsMultipleKeys) {
+  // Not a multiple of the SIMD width.
+  const vector_size_t size = 1'003;
+  std::vector<VectorPtr> keys = {
+      makeFlatVector<int64_t>(size, [](auto row) { return row * 7; }),
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 11; }),
+      makeFlatVector<double>(size, [](auto row) { return row / 3.0; }),
+      makeFlatVector<StringView>(size, [](auto row) {
+        return StringView::makeInline(fmt::format("key {}", row));
+      })};
+
+  SelectivityVector rows(size);
+  raw_vector<uint64_t> hashes(size);
+  for (auto i = 0; i < keys.size(); ++i) {
+    auto hasher = exec::VectorHasher::create(keys[i]->type(), i);
+    hasher->decode(*keys[i], rows);
+    hasher->hash(rows, i > 0, hashes);
+  }
+
+  for (auto row = 0; row < size; ++row) {
+    uint64_t expected = folly::hasher<int64_t>()(row * 7);
+    expected = bits::hashMix(expected, folly::hasher<int32_t>()(row % 11));
+    expected = bits::hashMix(expected, folly::hasher<double>()(row / 3.0));
+    expected = bits::hashMix(
+        expected,
+        folly::hasher<StringView>()(
+            StringView::makeInline(fmt::format("key {}", row))));
+    ASSERT_EQ(hashes[row], expected) << "at " << row;
+  }
+}
+
 TEST_F(VectorHasherTest, nonNullConstant) {
   auto hasher = exec::VectorHasher::create(INTEGER(), 1);
   auto vector = BaseVector::createConstant(INTEGER(), 123, 100, pool());
@@ -79,6 +79,52 @@ TEST_F(WindowTest, spill) {
   ASSERT_GT(stats.spilledPartitions, 0);
 }
 
+TEST_F(WindowTest, rowsStreaming) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          // Partition key. The partitions span several input batches.
+          makeFlatVector<int16_t>(size, [](auto row) { return row / 250; }),
+          // Sorting key. Some peer groups span 2 input batches.
+          makeFlatVector<int32_t>(size, [](auto row) { return row / 3; }),
+      });
+
+  createDuckDbTable({data});
+
+  const std::string overClause = "over (partition by p order by s)";
+  const std::vector<std::string> functions = {
+      "row_number()", "rank()", "dense_rank()"};
+  std::vector<std::string> windowCalls;
+  for (const auto& function : functions) {
+    windowCalls.push_back(fmt::format("{} {}", function, overClause));
+  }
+  const auto sql =
+      fmt::format("SELECT *, {} FROM tmp", folly::join(", ", windowCalls));
+
+  auto plan = PlanBuilder()
+                  .values(split(data, 10))
+                  .streamingWindow(windowCalls)
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+      .assertResults(sql);
+
+  // percent_rank needs the whole partition. The partitions are built before
+  // the functions run.
+  windowCalls.push_back(fmt::format("percent_rank() {}", overClause));
+  plan = PlanBuilder()
+             .values(split(data, 10))
+             .streamingWindow(windowCalls)
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+      .assertResults(
+          fmt::format("SELECT *, {} FROM tmp", folly::join(", ", windowCalls)));
+}
+
 TEST_F(WindowTest, missingFunctionSignature) {
   auto input = {makeRowVector({
       makeFlatVector<int64_t>({1, 2, 3}),
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/WorkStealingExecutor.h"
+
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class WorkStealingExecutorTest : public OperatorTestBase {};
+
+TEST_F(WorkStealingExecutorTest, runAll) {
+  constexpr int32_t kNumFunctions = 10'000;
+  std::atomic<int32_t> numRun{0};
+  {
+    WorkStealingExecutor executor(4);
+    ASSERT_EQ(executor.numWorkers(), 4);
+    ASSERT_EQ(WorkStealingExecutor::currentWorker(), -1);
+    for (auto i = 0; i < kNumFunctions; ++i) {
+      executor.add([&]() { ++numRun; });
+    }
+    // The destructor runs the queued functions.
+  }
+  ASSERT_EQ(numRun, kNumFunctions);
+}
+
+TEST_F(WorkStealingExecutorTest, affinity) {
+  WorkStealingExecutor executor(4);
+  // The functions queued to a busy worker are stolen by the idle ones.
+  folly::Baton<> release;
+  std::atomic<int32_t> busyWorker{-1};
+  executor.add([&]() {
+    busyWorker = WorkStealingExecutor::currentWorker();
+    release.wait();
+  });
+  while (busyWorker < 0) {
+    std::this_thread::yield();
+  }
+  constexpr int32_t kNumFunctions = 100;
+  std::atomic<int32_t> numOnBusyWorker{0};
+  std::atomic<int32_t> numStolen{0};
+  for (auto i = 0; i < kNumFunctions; ++i) {
+    executor.addToWorker(
+        [&]() {
+          if (WorkStealingExecutor::currentWorker() == busyWorker) {
+            ++numOnBusyWorker;
+          } else {
+            ++numStolen;
+          }
+        },
+        busyWorker);
+  }
+  while (numStolen < kNumFunctions) {
+    std::this_thread::yield();
+  }
+  ASSERT_EQ(numOnBusyWorker, 0);
+  release.post();
+
+  // Functions added from a worker are queued to that worker.
+  folly::Baton<> done;
+  std::atomic<int32_t> numRun{0};
+  executor.addToWorker(
+      [&]() {
+        ASSERT_GE(WorkStealingExecutor::currentWorker(), 0);
+        for (auto i = 0; i < kNumFunctions; ++i) {
+          executor.add([&]() {
+            if (++numRun == kNumFunctions) {
+              done.post();
+            }
+          });
+        }
+      },
+      2);
+  ASSERT_TRUE(done.try_wait_for(std::chrono::seconds(10)));
+  const auto stats = executor.stats();
+  ASSERT_EQ(stats.numLocal + stats.numStolen, 2 * kNumFunctions + 2);
+  ASSERT_GE(stats.numStolen, kNumFunctions);
+
+  // An out of range worker is the same as add().
+  folly::Baton<> outOfRange;
+  executor.addToWorker([&]() { outOfRange.post(); }, 10);
+  ASSERT_TRUE(outOfRange.try_wait_for(std::chrono::seconds(10)));
+}
+
+TEST_F(WorkStealingExecutorTest, query) {
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 20; ++i) {
+    data.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return row + i; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7; }),
+    }));
+  }
+  auto plan = PlanBuilder()
+                  .values(data, true)
+                  .project({"c0 % 17 AS k", "c1"})
+                  .partialAggregation({"k"}, {"sum(c1)"})
+                  .localPartition({"k"})
+                  .finalAggregation()
+                  .planNode();
+  auto expected = AssertQueryBuilder(plan).maxDrivers(4).copyResults(pool());
+
+  WorkStealingExecutor executor(4);
+  auto queryCtx = std::make_shared<core::QueryCtx>(&executor);
+  AssertQueryBuilder(plan)
+      .maxDrivers(4)
+      .queryCtx(queryCtx)
+      .assertResults(expected);
+  const auto stats = executor.stats();
+  ASSERT_GT(stats.numLocal + stats.numStolen, 0);
+}
@@ -258,6 +258,18 @@ class HiveConnectorSplitBuilder {
     return *this;
   }
 
+  HiveConnectorSplitBuilder& columnStatistics(
+      std::string name,
+      std::shared_ptr<dwio::common::ColumnStatistics> stats) {
+    columnStatistics_.emplace(std::move(name), std::move(stats));
+    return *this;
+  }
+
+  HiveConnectorSplitBuilder& numRows(uint64_t numRows) {
+    numRows_ = numRows;
+    return *this;
+  }
+
   HiveConnectorSplitBuilder& connectorId(const std::string& connectorId) {
     connectorId_ = connectorId;
     return *this;
@@ -267,7 +279,7 @@ class HiveConnectorSplitBuilder {
     static const std::unordered_map<std::string, std::string> customSplitInfo;
     static const std::shared_ptr<std::string> extraFileInfo;
     static const std::unordered_map<std::string, std::string> serdeParameters;
-    return std::make_shared<connector::hive::HiveConnectorSplit>(
+    auto split = std::make_shared<connector::hive::HiveConnectorSplit>(
         connectorId_,
         filePath_.find("/") == 0 ? "file:" + filePath_ : filePath_,
         fileFormat_,
@@ -280,6 +292,9 @@ class HiveConnectorSplitBuilder {
         serdeParameters,
         splitWeight_,
         infoColumns_);
+    split->columnStatistics = columnStatistics_;
+    split->numRows = numRows_;
+    return split;
   }
 
  private:
@@ -293,6 +308,11 @@ class HiveConnectorSplitBuilder {
   std::shared_ptr<std::string> extraFileInfo_ = {};
   std::unordered_map<std::string, std::string> serdeParameters_ = {};
   std::unordered_map<std::string, std::string> infoColumns_ = {};
+  std::unordered_map<
+      std::string,
+      std::shared_ptr<dwio::common::ColumnStatistics>>
+      columnStatistics_;
+  std::optional<uint64_t> numRows_;
   std::string connectorId_ = kHiveConnectorId;
   int64_t splitWeight_{0};
 };
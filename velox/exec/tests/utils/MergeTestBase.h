@@ -91,6 +91,12 @@ class TestingStream final : public MergeStream {
                                          : 1;
   }
 
+  // Drops the low bits of the value so that distinct values have equal keys
+  // and the merge has to fall back to compare().
+  uint64_t normalizedKey() const final {
+    return current()->value() >> 4;
+  }
+
  private:
   // True if 'current_' is initialized.
   mutable bool currentValid_{false};
@@ -148,17 +154,18 @@ class MergeTestBase {
 
   // Reads the data in 'testData.runs' using the merging class MergeType. Checks
   // that the results match the globally sorted data in 'testData' if check is
-  // true.
+  // true. 'normalizedKeys' applies only to TreeOfLosers.
   template <typename MergeType>
-  static void test(const TestData& testData, bool check) {
+  static void
+  test(const TestData& testData, bool check, bool normalizedKeys = false) {
     std::vector<std::unique_ptr<TestingStream>> sources;
     for (auto& source : testData.sources) {
       sources.push_back(std::make_unique<TestingStream>(*source));
     }
-    MergeType merge(std::move(sources));
+    auto merge = makeMerge<MergeType>(std::move(sources), normalizedKeys);
     if (check) {
       for (auto expected : testData.data) {
-        auto source = merge.next();
+        auto source = merge->next();
         if (!source) {
           FAIL() << "Premature end in merged stream";
         }
@@ -166,15 +173,27 @@ class MergeTestBase {
         ASSERT_EQ(result, expected);
         source->pop();
       }
-      ASSERT_FALSE(merge.next());
+      ASSERT_FALSE(merge->next());
     } else {
       TestingStream* result;
-      while ((result = merge.next())) {
+      while ((result = merge->next())) {
         result->pop();
       }
     }
   }
 
+  template <typename MergeType>
+  static std::unique_ptr<MergeType> makeMerge(
+      std::vector<std::unique_ptr<TestingStream>> sources,
+      bool normalizedKeys) {
+    if constexpr (std::is_same_v<MergeType, TreeOfLosers<TestingStream>>) {
+      return std::make_unique<MergeType>(std::move(sources), normalizedKeys);
+    } else {
+      VELOX_CHECK(!normalizedKeys);
+      return std::make_unique<MergeType>(std::move(sources));
+    }
+  }
+
  protected:
   folly::Random::DefaultGenerator rng_;
 };
@@ -21,6 +21,7 @@
 #include "velox/duckdb/conversion/DuckParser.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/HashPartitionFunction.h"
+#include "velox/exec/RangePartitionFunction.h"
 #include "velox/exec/RoundRobinPartitionFunction.h"
 #include "velox/exec/TableWriter.h"
 #include "velox/exec/WindowFunction.h"
@@ -1209,6 +1210,27 @@ PlanBuilder& PlanBuilder::localPartition(const std::vector<std::string>& keys) {
   return *this;
 }
 
+PlanBuilder& PlanBuilder::localPartitionByRange(
+    const std::vector<std::string>& keys,
+    const RowVectorPtr& sample) {
+  VELOX_CHECK_NOT_NULL(planNode_, "LocalPartition cannot be the source node");
+  const auto& inputType = planNode_->outputType();
+  auto [sortingKeys, sortingOrders] =
+      parseOrderByClauses(keys, inputType, pool_);
+  std::vector<column_index_t> keyChannels;
+  keyChannels.reserve(sortingKeys.size());
+  for (const auto& key : sortingKeys) {
+    keyChannels.push_back(inputType->getChildIdx(key->name()));
+  }
+  planNode_ = std::make_shared<core::LocalPartitionNode>(
+      nextPlanNodeId(),
+      core::LocalPartitionNode::Type::kRepartition,
+      std::make_shared<RangePartitionFunctionSpec>(
+          inputType, std::move(keyChannels), std::move(sortingOrders), sample),
+      std::vector<core::PlanNodePtr>{planNode_});
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::localPartitionByBucket(
     const std::shared_ptr<connector::hive::HiveBucketProperty>&
         bucketProperty) {
@@ -1320,7 +1342,8 @@ PlanBuilder& PlanBuilder::hashJoin(
     const std::string& filter,
     const std::vector<std::string>& outputLayout,
     core::JoinType joinType,
-    bool nullAware) {
+    bool nullAware,
+    bool sharedBuildTable) {
   VELOX_CHECK_NOT_NULL(planNode_, "HashJoin cannot be the source node");
   VELOX_CHECK_EQ(leftKeys.size(), rightKeys.size());
 
@@ -1361,7 +1384,8 @@ PlanBuilder& PlanBuilder::hashJoin(
       std::move(filterExpr),
       std::move(planNode_),
       build,
-      outputType);
+      outputType,
+      sharedBuildTable);
   return *this;
 }
 
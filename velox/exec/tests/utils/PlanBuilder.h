@@ -657,6 +657,9 @@ class PlanBuilder {
   ///
   /// By default, uses ASC NULLS LAST sort order, e.g. column "a" above will use
   /// ASC NULLS LAST and column "b" will use DESC NULLS LAST.
+  ///
+  /// With no keys, concatenates the outputs of the drivers of a single source
+  /// in driver order, e.g. after localPartitionByRange() and orderBy().
   PlanBuilder& localMerge(
       const std::vector<std::string>& keys,
       std::vector<core::PlanNodePtr> sources);
@@ -775,6 +778,20 @@ class PlanBuilder {
   /// current plan node).
   PlanBuilder& localPartition(const std::vector<std::string>& keys);
 
+  /// Adds a LocalPartitionNode to range-partition the input on the specified
+  /// sort keys using exec::RangePartitionFunction. The partition boundaries are
+  /// the quantiles of 'sample' for the number of partitions determined at
+  /// runtime. Sorting each partition and concatenating the partitions in order
+  /// gives the sorted input, e.g. localPartitionByRange({"c0"}, sample)
+  /// .orderBy({"c0"}, true).localMerge({}).
+  ///
+  /// @param keys Sort keys with optional sort orders, e.g. "c0 DESC NULLS
+  /// LAST", in the same format as orderBy().
+  /// @param sample Values of the sort keys, one column per key.
+  PlanBuilder& localPartitionByRange(
+      const std::vector<std::string>& keys,
+      const RowVectorPtr& sample);
+
   /// A convenience method to add a LocalPartitionNode with a single source (the
   /// current plan node) and hive bucket property.
   PlanBuilder& localPartitionByBucket(
@@ -815,6 +832,8 @@ class PlanBuilder {
   /// @param joinType Type of the join: inner, left, right, full, semi, or anti.
   /// @param nullAware Applies to semi and anti joins. Indicates whether the
   /// join follows IN (null-aware) or EXISTS (regular) semantic.
+  /// @param sharedBuildTable Indicates whether the tasks of the query on the
+  /// same node share one hash table built from a broadcast build side.
   PlanBuilder& hashJoin(
       const std::vector<std::string>& leftKeys,
       const std::vector<std::string>& rightKeys,
@@ -822,7 +841,8 @@ class PlanBuilder {
       const std::string& filter,
       const std::vector<std::string>& outputLayout,
       core::JoinType joinType = core::JoinType::kInner,
-      bool nullAware = false);
+      bool nullAware = false,
+      bool sharedBuildTable = false);
 
   /// Add a MergeJoinNode to join two inputs using one or more join keys and an
   /// optional filter. The caller is responsible to ensure that inputs are
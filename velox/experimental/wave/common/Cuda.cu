@@ -22,6 +22,7 @@
 #include "velox/experimental/wave/common/Exception.h"
 
 #include <sstream>
+#include <vector>
 
 namespace facebook::velox::wave {
 
@@ -44,65 +45,140 @@ void cudaCheckFatal(cudaError_t err, const char* file, int line) {
 }
 
 namespace {
+// Makes 'deviceId' the current device of the calling thread for the lifetime
+// of 'this'.
+class DeviceGuard {
+ public:
+  explicit DeviceGuard(int32_t deviceId) {
+    CUDA_CHECK(cudaGetDevice(&previous_));
+    if (previous_ != deviceId) {
+      CUDA_CHECK(cudaSetDevice(deviceId));
+      changed_ = true;
+    }
+  }
+
+  ~DeviceGuard() {
+    if (changed_) {
+      cudaSetDevice(previous_);
+    }
+  }
+
+ private:
+  int32_t previous_;
+  bool changed_{false};
+};
+
 class CudaManagedAllocator : public GpuAllocator {
  public:
+  explicit CudaManagedAllocator(int32_t deviceId) : deviceId_(deviceId) {}
+
   void* allocate(size_t size) override {
+    DeviceGuard guard(deviceId_);
     void* ret;
     CUDA_CHECK(cudaMallocManaged(&ret, size));
     return ret;
   }
 
   void free(void* ptr, size_t /*size*/) override {
+    DeviceGuard guard(deviceId_);
     cudaFree(ptr);
   }
+
+ private:
+  const int32_t deviceId_;
 };
 
 class CudaDeviceAllocator : public GpuAllocator {
  public:
+  explicit CudaDeviceAllocator(int32_t deviceId) : deviceId_(deviceId) {}
+
   void* allocate(size_t size) override {
+    DeviceGuard guard(deviceId_);
     void* ret;
     CUDA_CHECK(cudaMalloc(&ret, size));
     return ret;
   }
 
   void free(void* ptr, size_t /*size*/) override {
+    DeviceGuard guard(deviceId_);
     cudaFree(ptr);
   }
+
+ private:
+  const int32_t deviceId_;
 };
 
 class CudaHostAllocator : public GpuAllocator {
  public:
+  explicit CudaHostAllocator(int32_t deviceId) : deviceId_(deviceId) {}
+
   void* allocate(size_t size) override {
+    DeviceGuard guard(deviceId_);
     void* ret;
     CUDA_CHECK(cudaMallocHost(&ret, size));
     return ret;
   }
 
   void free(void* ptr, size_t /*size*/) override {
+    DeviceGuard guard(deviceId_);
     cudaFreeHost(ptr);
   };
+
+ private:
+  const int32_t deviceId_;
 };
 
+// Returns the allocator of type T for 'device', or for the current device if
+// 'device' is nullptr. There is one allocator of each type per device.
+template <typename T>
+GpuAllocator* allocatorForDevice(Device* device) {
+  static auto* allocators = [] {
+    auto* result = new std::vector<std::unique_ptr<T>>();
+    for (auto i = 0; i < numDevices(); ++i) {
+      result->push_back(std::make_unique<T>(i));
+    }
+    return result;
+  }();
+  auto id = device ? device->deviceId : getDevice()->deviceId;
+  return (*allocators)[id].get();
+}
 } // namespace
 
-GpuAllocator* getAllocator(Device* /*device*/) {
-  static auto* allocator = new CudaManagedAllocator();
-  return allocator;
+GpuAllocator* getAllocator(Device* device) {
+  return allocatorForDevice<CudaManagedAllocator>(device);
 }
 
-GpuAllocator* getDeviceAllocator(Device* /*device*/) {
-  static auto* allocator = new CudaDeviceAllocator();
-  return allocator;
+GpuAllocator* getDeviceAllocator(Device* device) {
+  return allocatorForDevice<CudaDeviceAllocator>(device);
 }
-GpuAllocator* getHostAllocator(Device* /*device*/) {
-  static auto* allocator = new CudaHostAllocator();
-  return allocator;
+
+GpuAllocator* getHostAllocator(Device* device) {
+  return allocatorForDevice<CudaHostAllocator>(device);
+}
+
+int32_t numDevices() {
+  static const int32_t count = [] {
+    int32_t count = 0;
+    CUDA_CHECK(cudaGetDeviceCount(&count));
+    return count;
+  }();
+  return count;
 }
 
-// Always returns device 0.
-Device* getDevice(int32_t /*preferredDevice*/) {
-  static Device device(0);
-  return &device;
+Device* getDevice(int32_t preferredId) {
+  static auto* devices = [] {
+    auto* result = new std::vector<std::unique_ptr<Device>>();
+    for (auto i = 0; i < numDevices(); ++i) {
+      result->push_back(std::make_unique<Device>(i));
+    }
+    return result;
+  }();
+  if (preferredId >= 0 && preferredId < devices->size()) {
+    return (*devices)[preferredId].get();
+  }
+  int32_t id;
+  CUDA_CHECK(cudaGetDevice(&id));
+  return (*devices)[id].get();
 }
 
 void setDevice(Device* device) {
@@ -110,6 +186,7 @@ void setDevice(Device* device) {
 }
 
 Stream::Stream() {
+  CUDA_CHECK(cudaGetDevice(&deviceId_));
   stream_ = std::make_unique<StreamImpl>();
   CUDA_CHECK(cudaStreamCreate(&stream_->stream));
 }
@@ -182,6 +259,7 @@ struct EventImpl {
 };
 
 Event::Event(bool withTime) : hasTiming_(withTime) {
+  CUDA_CHECK(cudaGetDevice(&deviceId_));
   event_ = std::make_unique<EventImpl>();
   CUDA_CHECK(cudaEventCreateWithFlags(
       &event_->event, withTime ? 0 : cudaEventDisableTiming));
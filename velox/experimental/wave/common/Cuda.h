@@ -33,8 +33,12 @@ struct Device {
 
 /// Checks that the machine has the right capability and returns a Device
 /// struct. If 'preferredId' is given tries to return  a Device on that device
-/// id.
+/// id. Otherwise returns the current device of the calling thread.
 Device* getDevice(int32_t preferredId = -1);
+
+/// Returns the number of visible devices.
+int32_t numDevices();
+
 /// Binds subsequent Cuda operations of the calling thread to 'device'.
 void setDevice(Device* device);
 
@@ -48,6 +52,12 @@ class Stream {
   /// Waits  until the stream is completed.
   void wait();
 
+  /// Returns the id of the device the stream was created on. Kernels and
+  /// events on the stream must be on the same device.
+  int32_t deviceId() const {
+    return deviceId_;
+  }
+
   /// Enqueus a prefetch. Prefetches to host if 'device' is nullptr, otherwise
   /// to 'device'.
   void prefetch(Device* device, void* address, size_t size);
@@ -76,6 +86,7 @@ class Stream {
  protected:
   std::unique_ptr<StreamImpl> stream_;
   void* userData_{nullptr};
+  int32_t deviceId_{0};
 
   friend class Event;
 };
@@ -108,8 +119,15 @@ class Event {
   /// must enable timing.
   float elapsedTime(const Event& start) const;
 
+  /// Returns the id of the device the event was created on. The event can be
+  /// recorded only on streams of this device.
+  int32_t deviceId() const {
+    return deviceId_;
+  }
+
  private:
   std::unique_ptr<EventImpl> event_;
+  int32_t deviceId_{0};
   const bool hasTiming_;
   bool recorded_{false};
 };
@@ -123,6 +123,18 @@ struct Hasher<StringView, uint32_t> {
   }
 };
 
+/// 64 bit hash for string keys of hash tables. Both halves are mixed since
+/// the high half selects the tag of a bucket entry.
+template <>
+struct Hasher<StringView, uint64_t> {
+  __device__ __host__ uint64_t operator()(StringView val) const {
+    auto* data = val.data();
+    auto size = val.size();
+    return static_cast<uint64_t>(Murmur3::hashBytes(data, size, 42)) << 32 |
+        Murmur3::hashBytes(data, size, 97);
+  }
+};
+
 template <>
 struct Hasher<int32_t, uint32_t> : IntHasher32<int32_t> {};
 
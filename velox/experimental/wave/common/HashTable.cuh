@@ -98,6 +98,23 @@ struct RowAllocator : public HashPartitionAllocator {
     return nullptr;
   }
 
+  /// Copies the bytes of a non-inline string key to the string space of
+  /// 'this' so that a row does not reference the probe input. Returns false
+  /// if out of space.
+  bool __device__ copyString(StringView& string) {
+    if (string.isInline()) {
+      return true;
+    }
+    auto size = string.size();
+    auto* copy = allocate<char>(size);
+    if (!copy) {
+      return false;
+    }
+    memcpy(copy, string.data(), size);
+    string.init(copy, size);
+    return true;
+  }
+
   template <typename T>
   bool __device__ inRange(T ptr) {
     return reinterpret_cast<uint64_t>(ptr) >= base &&
@@ -69,6 +69,61 @@ class StringView {
     return !(*this == other);
   }
 
+  /// Returns <0, 0 or >0 if 'this' sorts before, with or after 'other' in
+  /// byte order.
+  __device__ __host__ int32_t compare(StringView other) const {
+    int32_t len = size();
+    int32_t otherLen = other.size();
+    if (auto result =
+            memcmp(data(), other.data(), len < otherLen ? len : otherLen)) {
+      return result;
+    }
+    return len - otherLen;
+  }
+
+  __device__ __host__ bool startsWith(StringView prefix) const {
+    auto len = prefix.size();
+    return size() >= len && memcmp(data(), prefix.data(), len) == 0;
+  }
+
+  __device__ __host__ bool endsWith(StringView suffix) const {
+    auto len = suffix.size();
+    return size() >= len &&
+        memcmp(data() + size() - len, suffix.data(), len) == 0;
+  }
+
+  /// Returns the number of UTF-8 characters.
+  __device__ __host__ int32_t numChars() const {
+    auto* chars = data();
+    int32_t numChars = 0;
+    for (auto i = 0; i < size(); ++i) {
+      numChars += isCharStart(chars[i]);
+    }
+    return numChars;
+  }
+
+  /// Returns the 'length' characters from the 1-based character 'start' like
+  /// Presto substr(). A negative 'start' counts from the end. Returns an empty
+  /// string if 'start' is out of range or 'length' is not positive. The result
+  /// references the bytes of 'this' unless it is inline.
+  __device__ __host__ StringView substr(int64_t start, int64_t length) const {
+    StringView result;
+    result.init(nullptr, 0);
+    int64_t numChars = this->numChars();
+    if (start < 0) {
+      start += numChars + 1;
+    }
+    if (start <= 0 || start > numChars || length <= 0) {
+      return result;
+    }
+    if (length > numChars - start + 1) {
+      length = numChars - start + 1;
+    }
+    auto begin = charOffset(start - 1);
+    result.init(data() + begin, charOffset(start - 1 + length) - begin);
+    return result;
+  }
+
   __device__ StringView cas(StringView compare, StringView val);
 
   operator std::string_view() const {
@@ -80,6 +135,24 @@ class StringView {
     return reinterpret_cast<char*>(&data_) + kSizeBits / 8;
   }
 
+  // True if 'c' is not a UTF-8 continuation byte, 10xxxxxx.
+  __device__ __host__ static bool isCharStart(char c) {
+    return (c & 0xc0) != 0x80;
+  }
+
+  // Returns the byte offset of the character after the first 'numChars'
+  // characters.
+  __device__ __host__ int32_t charOffset(int64_t numChars) const {
+    auto* chars = data();
+    int32_t len = size();
+    for (auto i = 0; i < len; ++i) {
+      if (isCharStart(chars[i]) && numChars-- == 0) {
+        return i;
+      }
+    }
+    return len;
+  }
+
   static constexpr int kSizeBits = 16;
   static constexpr uint64_t kMaxSize = (1ull << kSizeBits) - 1;
   static constexpr int kInlineSize = 8 - kSizeBits / 8;
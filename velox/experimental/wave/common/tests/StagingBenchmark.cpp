@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/time/Timer.h"
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/tests/CudaTest.h"
+
+DEFINE_int32(num_splits, 100, "Number of splits to stage and decode");
+DEFINE_int64(split_bytes, 64 << 20, "Bytes of column data in each split");
+DEFINE_int32(repeat, 1, "Number of passes of the decode kernel over a split");
+DEFINE_int32(
+    num_in_flight,
+    2,
+    "Number of splits staged or decoded at the same time");
+
+// Compares staging splits through unified memory, as SplitStaging did, with
+// copies from pinned buffers on a separate stream that overlap the decoding
+// of the previous split. Decoding is simulated by TestStream::addOne on the
+// transferred data. Reports the host to device bandwidth and the fraction of
+// the time between the first and last kernel in which no kernel runs.
+
+using namespace facebook::velox;
+using namespace facebook::velox::wave;
+
+namespace {
+
+struct Result {
+  uint64_t micros{0};
+  float kernelMs{0};
+  float spanMs{0};
+};
+
+// Buffers and events of one split in flight.
+struct Slot {
+  void* pinned{nullptr};
+  void* data{nullptr};
+  Event copyDone;
+  Event kernelStart{true};
+  Event kernelEnd{true};
+  bool busy{false};
+};
+
+class StagingBenchmark {
+ public:
+  StagingBenchmark()
+      : device_(getDevice()),
+        source_(FLAGS_split_bytes / sizeof(int32_t)),
+        slots_(FLAGS_num_in_flight) {
+    setDevice(device_);
+    for (auto i = 0; i < source_.size(); ++i) {
+      source_[i] = i;
+    }
+  }
+
+  // Copies each split into unified memory and prefetches it to the device on
+  // the stream that decodes it.
+  Result runUnified() {
+    auto* allocator = getAllocator(device_);
+    for (auto& slot : slots_) {
+      slot.data = allocator->allocate(FLAGS_split_bytes);
+    }
+    auto result = run([&](Slot& slot) {
+      ::memcpy(slot.data, source_.data(), FLAGS_split_bytes);
+      stream_.prefetch(device_, slot.data, FLAGS_split_bytes);
+    });
+    for (auto& slot : slots_) {
+      allocator->free(slot.data, FLAGS_split_bytes);
+    }
+    return result;
+  }
+
+  // Copies each split into a pinned buffer and from there to device memory on
+  // 'copyStream_'. The decode stream waits for the copy on the GPU, so that
+  // the copy of a split overlaps the decoding of the previous one.
+  Result runPinned() {
+    auto* host = getHostAllocator(device_);
+    auto* allocator = getDeviceAllocator(device_);
+    for (auto& slot : slots_) {
+      slot.pinned = host->allocate(FLAGS_split_bytes);
+      slot.data = allocator->allocate(FLAGS_split_bytes);
+    }
+    auto result = run([&](Slot& slot) {
+      ::memcpy(slot.pinned, source_.data(), FLAGS_split_bytes);
+      copyStream_.hostToDeviceAsync(slot.data, slot.pinned, FLAGS_split_bytes);
+      slot.copyDone.record(copyStream_);
+      slot.copyDone.wait(stream_);
+    });
+    for (auto& slot : slots_) {
+      host->free(slot.pinned, FLAGS_split_bytes);
+      allocator->free(slot.data, FLAGS_split_bytes);
+    }
+    return result;
+  }
+
+ private:
+  // Stages each split with 'stage' and enqueues its decoding. A slot is
+  // reused after the decoding of its previous split is done.
+  template <typename Stage>
+  Result run(Stage stage) {
+    Result result;
+    Event start(true);
+    Event end(true);
+    {
+      MicrosecondTimer timer(&result.micros);
+      start.record(stream_);
+      for (auto split = 0; split < FLAGS_num_splits; ++split) {
+        auto& slot = slots_[split % slots_.size()];
+        retire(slot, result);
+        stage(slot);
+        slot.kernelStart.record(stream_);
+        stream_.addOne(
+            reinterpret_cast<int32_t*>(slot.data),
+            source_.size(),
+            FLAGS_repeat);
+        slot.kernelEnd.record(stream_);
+        slot.busy = true;
+      }
+      end.record(stream_);
+      for (auto& slot : slots_) {
+        retire(slot, result);
+      }
+    }
+    result.spanMs = end.elapsedTime(start);
+    return result;
+  }
+
+  void retire(Slot& slot, Result& result) {
+    if (!slot.busy) {
+      return;
+    }
+    slot.kernelEnd.wait();
+    result.kernelMs += slot.kernelEnd.elapsedTime(slot.kernelStart);
+    slot.busy = false;
+  }
+
+  Device* const device_;
+  std::vector<int32_t> source_;
+  std::vector<Slot> slots_;
+  TestStream stream_;
+  Stream copyStream_;
+};
+
+void print(const char* title, const Result& result) {
+  const double bytes = static_cast<double>(FLAGS_split_bytes) *
+      FLAGS_num_splits;
+  const double idle =
+      result.spanMs > 0 ? 1 - result.kernelMs / result.spanMs : 0;
+  std::cout << title << ": " << bytes / (result.micros * 1000.0)
+            << " GB/s, " << result.micros / 1000 << " ms, kernels idle "
+            << idle * 100 << "%" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  VELOX_CHECK_GT(FLAGS_num_in_flight, 0);
+  StagingBenchmark benchmark;
+  print("unified", benchmark.runUnified());
+  print("pinned", benchmark.runPinned());
+  return 0;
+}
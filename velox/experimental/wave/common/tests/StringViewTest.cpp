@@ -16,6 +16,7 @@
 
 #include <gtest/gtest.h>
 
+#include "velox/experimental/wave/common/Hash.h"
 #include "velox/experimental/wave/common/StringView.h"
 
 namespace facebook::velox::wave {
@@ -65,5 +66,63 @@ TEST(StringViewTest, nonInlined) {
   ASSERT_NE(sv, sv2);
 }
 
+StringView makeView(const char* data) {
+  StringView sv;
+  sv.init(data, strlen(data));
+  return sv;
+}
+
+TEST(StringViewTest, compare) {
+  auto abc = makeView("abc");
+  auto abcd = makeView("abcdefghij");
+  ASSERT_EQ(abc.compare(makeView("abc")), 0);
+  ASSERT_LT(abc.compare(abcd), 0);
+  ASSERT_GT(abcd.compare(abc), 0);
+  ASSERT_LT(makeView("abcdefghij").compare(makeView("abcdefghik")), 0);
+  ASSERT_GT(makeView("\xff").compare(makeView("a")), 0);
+  ASSERT_LT(makeView("").compare(abc), 0);
+
+  ASSERT_TRUE(abcd.startsWith(abc));
+  ASSERT_TRUE(abcd.startsWith(makeView("")));
+  ASSERT_FALSE(abc.startsWith(abcd));
+  ASSERT_TRUE(abcd.endsWith(makeView("ghij")));
+  ASSERT_FALSE(abcd.endsWith(abc));
+  ASSERT_FALSE(abc.endsWith(abcd));
+}
+
+TEST(StringViewTest, substr) {
+  auto sv = makeView("foobarquux");
+  ASSERT_EQ(sv.numChars(), 10);
+  ASSERT_EQ(sv.substr(1, 3), makeView("foo"));
+  ASSERT_EQ(sv.substr(4, 100), makeView("barquux"));
+  ASSERT_EQ(sv.substr(4, 100).data(), sv.data() + 3);
+  ASSERT_EQ(sv.substr(-4, 2), makeView("qu"));
+  ASSERT_EQ(sv.substr(0, 2).size(), 0);
+  ASSERT_EQ(sv.substr(11, 2).size(), 0);
+  ASSERT_EQ(sv.substr(-11, 2).size(), 0);
+  ASSERT_EQ(sv.substr(2, 0).size(), 0);
+
+  // Characters are UTF-8 and may have several bytes.
+  auto utf8 = makeView("\u00e4\u00f6\u00fcabc\u20ac");
+  ASSERT_EQ(utf8.size(), 12);
+  ASSERT_EQ(utf8.numChars(), 7);
+  ASSERT_EQ(utf8.substr(2, 3), makeView("\u00f6\u00fca"));
+  ASSERT_EQ(utf8.substr(-1, 1), makeView("\u20ac"));
+}
+
+TEST(StringViewTest, hash) {
+  Hasher<StringView, uint64_t> hasher;
+  auto inlined = makeView("abc");
+  auto nonInlined = makeView("abcdefghij");
+  ASSERT_EQ(hasher(inlined), hasher(makeView("abc")));
+  ASSERT_EQ(hasher(nonInlined), hasher(makeView("abcdefghij")));
+  ASSERT_NE(hasher(inlined), hasher(nonInlined));
+  // Both halves vary since the high half is the tag in hash tables.
+  ASSERT_NE(hasher(inlined) >> 32, hasher(nonInlined) >> 32);
+  ASSERT_NE(
+      static_cast<uint32_t>(hasher(inlined)),
+      static_cast<uint32_t>(hasher(nonInlined)));
+}
+
 } // namespace
 } // namespace facebook::velox::wave
@@ -15,10 +15,40 @@
  */
 
 #include "velox/experimental/wave/dwio/FormatData.h"
+
+#include <gflags/gflags.h>
+
 #include "velox/experimental/wave/dwio/ColumnReader.h"
 
+DEFINE_bool(
+    velox_wave_pinned_staging,
+    true,
+    "Stage host to device transfers of split data in pinned host memory");
+
+DEFINE_int64(
+    velox_wave_pinned_staging_size,
+    256 << 20,
+    "Size of a slab of the pinned host memory arena for staging transfers");
+
 namespace facebook::velox::wave {
 
+SplitStaging::~SplitStaging() {
+  if (copyDone_) {
+    // 'hostBuffer_' must not be freed while the copy is in progress.
+    copyDone_->wait();
+  }
+  if (copyStream_) {
+    WaveStream::releaseStream(std::move(copyStream_));
+  }
+}
+
+// static
+GpuArena& SplitStaging::pinnedArena() {
+  static auto* arena = new GpuArena(
+      FLAGS_velox_wave_pinned_staging_size, getHostAllocator(getDevice()));
+  return *arena;
+}
+
 BufferId SplitStaging::add(Staging& staging) {
   VELOX_CHECK_NULL(deviceBuffer_);
   staging_.push_back(staging);
@@ -40,11 +70,26 @@ void SplitStaging::transfer(WaveStream& waveStream, Stream& stream) {
   }
   deviceBuffer_ = waveStream.arena().allocate<char>(fill_);
   auto universal = deviceBuffer_->as<char>();
-  for (auto i = 0; i < offsets_.size(); ++i) {
-    memcpy(universal + offsets_[i], staging_[i].hostData, staging_[i].size);
+  if (FLAGS_velox_wave_pinned_staging) {
+    hostBuffer_ = pinnedArena().allocate<char>(fill_);
+    auto pinned = hostBuffer_->as<char>();
+    for (auto i = 0; i < offsets_.size(); ++i) {
+      memcpy(pinned + offsets_[i], staging_[i].hostData, staging_[i].size);
+    }
+    if (!copyStream_) {
+      copyStream_ = WaveStream::streamFromReserve();
+    }
+    copyStream_->hostToDeviceAsync(universal, pinned, fill_);
+    copyDone_ = std::make_unique<Event>();
+    copyDone_->record(*copyStream_);
+    copyDone_->wait(stream);
+  } else {
+    for (auto i = 0; i < offsets_.size(); ++i) {
+      memcpy(universal + offsets_[i], staging_[i].hostData, staging_[i].size);
+    }
+    stream.prefetch(
+        getDevice(), deviceBuffer_->as<char>(), deviceBuffer_->size());
   }
-  stream.prefetch(
-      getDevice(), deviceBuffer_->as<char>(), deviceBuffer_->size());
   for (auto& pair : patch_) {
     *reinterpret_cast<int64_t*>(pair.second) +=
         reinterpret_cast<int64_t>(universal) + offsets_[pair.first];
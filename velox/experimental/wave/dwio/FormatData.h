@@ -48,6 +48,8 @@ struct Staging {
 /// data already on device.
 class SplitStaging {
  public:
+  ~SplitStaging();
+
   /// Adds a transfer described by 'staging'. Returns an id of the
   /// device side buffer. The id will be mapped to an actual buffer
   /// when the transfers are queud. At this time, pointers that
@@ -64,9 +66,17 @@ class SplitStaging {
         id, reinterpret_cast<void**>(reinterpret_cast<uint64_t>(pointer)));
   }
 
-  // Starts the transfers registered with add( on 'stream').
+  /// Starts the transfers registered with add(). Work enqueued on 'stream'
+  /// after this sees the transferred data. With pinned staging, the data is
+  /// copied to pinned host memory and from there to the device on a separate
+  /// copy stream, so that the copy may overlap with kernels already queued on
+  /// 'stream' or on the streams of other splits.
   void transfer(WaveStream& waveStream, Stream& stream);
 
+  /// Returns the process wide arena of pinned host memory for staging
+  /// transfers.
+  static GpuArena& pinnedArena();
+
  private:
   void registerPointerInternal(BufferId id, void** ptr);
 
@@ -74,6 +84,10 @@ class SplitStaging {
   // memory.
   WaveBufferPtr hostBuffer_;
 
+  // Stream for the copy from 'hostBuffer_' and the event recorded after it.
+  std::unique_ptr<Stream> copyStream_;
+  std::unique_ptr<Event> copyDone_;
+
   // Device accessible memory (device or unified) with the data to read.
   WaveBufferPtr deviceBuffer_;
 
@@ -40,6 +40,7 @@ enum class DecodeStep {
   kRle,
   kDictionary,
   kDictionaryOnBitpack,
+  kRleBitpack,
   kVarint,
   kNullable,
   kSentinel,
@@ -119,6 +120,41 @@ struct GpuDecode {
     void* result;
   };
 
+  // Parquet RLE/bit-packed hybrid encoding. Used for dictionary indices and
+  // definition levels. The small members are packed to keep GpuDecode at 64
+  // bytes of data.
+  struct RleBitpack {
+    // Type of the alphabet and result. Ignored if 'levelsToNulls' is set.
+    WaveTypeKind dataType;
+    // Bit width of each value, 0 to 32.
+    uint8_t bitWidth;
+    // If true, values are definition levels. Each result is one byte, kNotNull
+    // for values equal to 'maxLevel' and kNull for others.
+    bool levelsToNulls;
+    uint8_t maxLevel;
+    // Byte size of 'input'.
+    int size;
+    // Begin position for values, scatter and result.
+    int begin;
+    // End position (exclusive) for values, scatter and result.
+    int end;
+    // Start of the encoded runs, after any length prefix.
+    const uint8_t* input;
+    // If not null, values are indices into this dictionary alphabet.
+    const void* alphabet;
+    // If not null, contains the output position relative to result pointer.
+    const int32_t* scatter;
+    // Temporary storage for the run table. Should be preallocated to at least
+    // 3 * min(end, size) large.
+    int32_t* runs;
+    // If not null and 'levelsToNulls' is set, gets the positions of the
+    // non-null results relative to 'begin'. Should be preallocated to at
+    // least end - begin large.
+    int32_t* nonNullIndices;
+    // Starting address of the result.
+    void* result;
+  };
+
   struct Varint {
     // Address of the input data.
     const char* input;
@@ -196,6 +232,7 @@ struct GpuDecode {
     Trivial trivial;
     MainlyConstant mainlyConstant;
     DictionaryOnBitpack dictionaryOnBitpack;
+    RleBitpack rleBitpack;
     Varint varint;
     SparseBool sparseBool;
     RleTotalLength rleTotalLength;
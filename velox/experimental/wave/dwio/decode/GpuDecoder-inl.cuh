@@ -499,6 +499,125 @@ __device__ void decodeRle(GpuDecode& plan) {
   }
 }
 
+// Returns the 'width' bits starting at bit 'bit' of 'data'. Reads only the
+// bytes that contain the bits, so that the last value of a page does not read
+// past the end.
+__device__ inline uint32_t
+loadBits(const uint8_t* data, int64_t bit, int32_t width) {
+  auto* bytes = data + (bit >> 3);
+  auto numBytes = ((bit & 7) + width + 7) >> 3;
+  uint64_t word = 0;
+  for (auto i = 0; i < numBytes; ++i) {
+    word |= static_cast<uint64_t>(bytes[i]) << (i * 8);
+  }
+  return (word >> (bit & 7)) & ((1UL << width) - 1);
+}
+
+// Fills the run table of 'op' with the first value, the kind and the value or
+// bit-packed data offset of each run and returns the number of runs. The run
+// headers are read by one thread since each header gives the position of the
+// next.
+__device__ inline int32_t parseRleBitpackRuns(GpuDecode::RleBitpack& op) {
+  auto maxRuns = min(op.end, op.size);
+  auto* begins = op.runs;
+  auto* isBitpacked = op.runs + maxRuns;
+  auto* payload = op.runs + 2 * maxRuns;
+  auto* input = reinterpret_cast<const char*>(op.input);
+  auto* pos = input;
+  auto* end = input + op.size;
+  int32_t row = 0;
+  int32_t numRuns = 0;
+  while (row < op.end && pos < end && numRuns < maxRuns) {
+    auto header = readVarint32(&pos);
+    begins[numRuns] = row;
+    if (header & 1) {
+      // Groups of 8 bit-packed values.
+      isBitpacked[numRuns] = 1;
+      payload[numRuns] = pos - input;
+      pos += (header >> 1) * op.bitWidth;
+      row += (header >> 1) * 8;
+    } else {
+      isBitpacked[numRuns] = 0;
+      payload[numRuns] = loadBits(
+          reinterpret_cast<const uint8_t*>(pos), 0, (op.bitWidth + 7) / 8 * 8);
+      pos += (op.bitWidth + 7) / 8;
+      row += header >> 1;
+    }
+    ++numRuns;
+  }
+  return numRuns;
+}
+
+__device__ inline uint32_t
+rleBitpackValue(const GpuDecode::RleBitpack& op, int32_t numRuns, int32_t i) {
+  auto maxRuns = min(op.end, op.size);
+  auto run = upperBound(op.runs, numRuns, i) - 1;
+  auto payload = op.runs[2 * maxRuns + run];
+  if (!op.runs[maxRuns + run]) {
+    return payload;
+  }
+  return loadBits(
+      op.input + payload,
+      static_cast<int64_t>(i - op.runs[run]) * op.bitWidth,
+      op.bitWidth);
+}
+
+template <typename T>
+__device__ void decodeRleBitpack(GpuDecode::RleBitpack& op, int32_t numRuns) {
+  auto* dict = reinterpret_cast<const T*>(op.alphabet);
+  auto* result = reinterpret_cast<T*>(op.result);
+  auto scatter = op.scatter;
+  for (auto i = op.begin + threadIdx.x; i < op.end; i += blockDim.x) {
+    auto index = rleBitpackValue(op, numRuns, i);
+    T value = dict ? dict[index] : static_cast<T>(index);
+    result[scatter ? scatter[i] : i] = value;
+  }
+}
+
+template <int kBlockSize>
+__device__ void decodeRleBitpack(GpuDecode& plan) {
+  auto& op = plan.data.rleBitpack;
+  __shared__ int32_t numRuns;
+  if (threadIdx.x == 0) {
+    numRuns = parseRleBitpackRuns(op);
+  }
+  __syncthreads();
+  if (op.levelsToNulls) {
+    auto* result = reinterpret_cast<uint8_t*>(op.result);
+    for (auto i = op.begin + threadIdx.x; i < op.end; i += blockDim.x) {
+      result[i] =
+          rleBitpackValue(op, numRuns, i) == op.maxLevel ? kNotNull : kNull;
+    }
+    if (op.nonNullIndices) {
+      __syncthreads();
+      scatterIndices<kBlockSize, uint8_t>(
+          result, kNotNull, op.begin, op.end, op.nonNullIndices);
+    }
+    return;
+  }
+  switch (op.dataType) {
+    case WaveTypeKind::TINYINT:
+      decodeRleBitpack<uint8_t>(op, numRuns);
+      break;
+    case WaveTypeKind::SMALLINT:
+      decodeRleBitpack<uint16_t>(op, numRuns);
+      break;
+    case WaveTypeKind::INTEGER:
+    case WaveTypeKind::REAL:
+      decodeRleBitpack<uint32_t>(op, numRuns);
+      break;
+    case WaveTypeKind::BIGINT:
+    case WaveTypeKind::DOUBLE:
+      decodeRleBitpack<uint64_t>(op, numRuns);
+      break;
+    default:
+      if (threadIdx.x == 0) {
+        printf("ERROR: Unsupported data type for RleBitpack\n");
+        assert(false);
+      }
+  }
+}
+
 template <int kBlockSize>
 __device__ void makeScatterIndices(GpuDecode::MakeScatterIndices& op) {
   auto indicesCount = scatterIndices<kBlockSize>(
@@ -516,6 +635,9 @@ __device__ void decodeSwitch(GpuDecode& op) {
     case DecodeStep::kDictionaryOnBitpack:
       detail::decodeDictionaryOnBitpack(op);
       break;
+    case DecodeStep::kRleBitpack:
+      detail::decodeRleBitpack<kBlockSize>(op);
+      break;
     case DecodeStep::kSparseBool:
       detail::decodeSparseBool(op.data.sparseBool);
       break;
@@ -562,6 +684,7 @@ int32_t sharedMemorySizeForDecode(DecodeStep step) {
     case DecodeStep::kMainlyConstant:
     case DecodeStep::kRleBool:
     case DecodeStep::kRle:
+    case DecodeStep::kRleBitpack:
     case DecodeStep::kVarint:
     case DecodeStep::kMakeScatterIndices:
     case DecodeStep::kLengthToOffset:
@@ -46,6 +46,9 @@ struct GpuDecodeParams {
        sizeof(int32_t)] = {};
 };
 
+// Kernel parameters are limited to 4KB.
+static_assert(sizeof(GpuDecodeParams) <= 4096);
+
 __global__ void decodeKernel(GpuDecodeParams inlineParams) {
   GpuDecodeParams* params =
       inlineParams.external ? inlineParams.external : &inlineParams;
@@ -55,6 +58,8 @@ __global__ void decodeKernel(GpuDecodeParams inlineParams) {
       reinterpret_cast<GpuDecode*>(&params->ends[0] + roundUp(gridDim.x, 2));
   for (auto i = programStart; i < programEnd; ++i) {
     detail::decodeSwitch<kBlockSize>(ops[i]);
+    // The next step may read results of this one written by other threads.
+    __syncthreads();
   }
 }
 
@@ -128,6 +128,50 @@ void makeBitpackDict(
       reinterpret_cast<T*>(memory), dictBytes + bitBytes + scatterBytes);
 }
 
+// Fills 'values' with 'numValues' values of 'bitWidth' bits and returns
+// their Parquet RLE/bit-packed hybrid encoding. Alternates RLE runs with
+// bit-packed runs of random values. The last bit-packed run may encode values
+// past 'numValues'.
+std::string makeRleBitpack(
+    int32_t bitWidth,
+    int32_t numValues,
+    std::vector<uint32_t>& values) {
+  std::string encoded;
+  char header[5];
+  auto mask = bitWidth == 32 ? ~0U : (1U << bitWidth) - 1;
+  while (values.size() < numValues) {
+    int32_t runLength = 1 + rand() % 50;
+    uint32_t value = rand() & mask;
+    auto* pos = header;
+    writeVarint<uint32_t>(runLength << 1, &pos);
+    encoded.append(header, pos - header);
+    for (auto i = 0; i < (bitWidth + 7) / 8; ++i) {
+      encoded.push_back(static_cast<char>(value >> (i * 8)));
+    }
+    values.insert(values.end(), runLength, value);
+
+    int32_t numGroups = 1 + rand() % 5;
+    pos = header;
+    writeVarint<uint32_t>((numGroups << 1) | 1, &pos);
+    encoded.append(header, pos - header);
+    std::string packed(numGroups * bitWidth, '\0');
+    auto* bytes = reinterpret_cast<uint8_t*>(packed.data());
+    for (auto i = 0; i < numGroups * 8; ++i) {
+      value = rand() & mask;
+      for (auto bit = 0; bit < bitWidth; ++bit) {
+        int64_t position = static_cast<int64_t>(i) * bitWidth + bit;
+        if (value & (1U << bit)) {
+          setBit(bytes, position);
+        }
+      }
+      values.push_back(value);
+    }
+    encoded += packed;
+  }
+  values.resize(numValues);
+  return encoded;
+}
+
 class GpuDecoderTest : public ::testing::Test {
  protected:
   void SetUp() override {
@@ -512,6 +556,91 @@ class GpuDecoderTest : public ::testing::Test {
     }
   }
 
+  template <typename T, int kBlockSize>
+  void testRleBitpackDict(int32_t bitWidth, int numValues, int numBlocks) {
+    std::vector<uint32_t> expected;
+    auto encoded = makeRleBitpack(bitWidth, numValues, expected);
+    auto input = allocate<uint8_t>(encoded.size());
+    ::memcpy(input.get(), encoded.data(), encoded.size());
+    auto dict = allocate<T>(1 << bitWidth);
+    for (auto i = 0; i < 1 << bitWidth; ++i) {
+      dict[i] = i * 3 + 1;
+    }
+    auto result = allocate<T>(numValues);
+    int valuesPerOp = roundUp(numValues / numBlocks + 1, kBlockSize);
+    int numOps = roundUp(numValues, valuesPerOp) / valuesPerOp;
+    int32_t maxRuns = std::min<int32_t>(numValues, encoded.size());
+    auto runs = allocate<int32_t>(3 * maxRuns * numOps);
+    auto ops = allocate<GpuDecode>(numOps);
+    for (auto i = 0; i < numOps; ++i) {
+      ops[i].step = DecodeStep::kRleBitpack;
+      auto& op = ops[i].data.rleBitpack;
+      op.dataType = WaveTypeTrait<T>::typeKind;
+      op.bitWidth = bitWidth;
+      op.levelsToNulls = false;
+      op.size = encoded.size();
+      op.begin = i * valuesPerOp;
+      op.end = std::min<int32_t>(numValues, (i + 1) * valuesPerOp);
+      op.input = input.get();
+      op.alphabet = dict.get();
+      op.scatter = nullptr;
+      op.runs = runs.get() + i * 3 * maxRuns;
+      op.nonNullIndices = nullptr;
+      op.result = result.get();
+    }
+    testCase(
+        fmt::format(
+            "rle bitpack dict {} bitWidth={} numValues={}",
+            sizeof(T) * 8,
+            bitWidth,
+            numValues),
+        [&] { decodeGlobal<kBlockSize>(ops.get(), numOps); },
+        numValues * sizeof(T),
+        3);
+    for (auto i = 0; i < numValues; ++i) {
+      ASSERT_EQ(result[i], dict[expected[i]]) << i;
+    }
+  }
+
+  template <int kBlockSize>
+  void testRleBitpackLevels(int numValues) {
+    std::vector<uint32_t> expected;
+    auto encoded = makeRleBitpack(1, numValues, expected);
+    auto input = allocate<uint8_t>(encoded.size());
+    ::memcpy(input.get(), encoded.data(), encoded.size());
+    auto nulls = allocate<uint8_t>(numValues);
+    auto indices = allocate<int32_t>(numValues);
+    int32_t maxRuns = std::min<int32_t>(numValues, encoded.size());
+    auto runs = allocate<int32_t>(3 * maxRuns);
+    auto ops = allocate<GpuDecode>(1);
+    ops[0].step = DecodeStep::kRleBitpack;
+    auto& op = ops[0].data.rleBitpack;
+    op.bitWidth = 1;
+    op.levelsToNulls = true;
+    op.maxLevel = 1;
+    op.size = encoded.size();
+    op.begin = 0;
+    op.end = numValues;
+    op.input = input.get();
+    op.alphabet = nullptr;
+    op.scatter = nullptr;
+    op.runs = runs.get();
+    op.nonNullIndices = indices.get();
+    op.result = nulls.get();
+    testCase(
+        "",
+        [&] { decodeGlobal<kBlockSize>(ops.get(), 1); },
+        numValues,
+        3);
+    int32_t numNonNull = 0;
+    for (auto i = 0; i < numValues; ++i) {
+      ASSERT_EQ(nulls[i], expected[i] ? kNotNull : kNull) << i;
+      if (expected[i]) {
+        ASSERT_EQ(indices[numNonNull++], i);
+      }
+    }
+  }
+
   void testMakeScatterIndicesStream(int numValues, int numBlocks) {
     auto bits = allocate<uint8_t>((numValues * numBlocks + 7) / 8);
     fillRandomBits(bits.get(), 0.5, numValues * numBlocks);
@@ -568,6 +697,13 @@ TEST_F(GpuDecoderTest, dictionaryOnBitpack) {
   dictTestPlan<int64_t, 256>(11, 40'000'003, 1024, true);
 }
 
+TEST_F(GpuDecoderTest, rleBitpack) {
+  testRleBitpackDict<int32_t, 256>(1, 100'003, 64);
+  testRleBitpackDict<int32_t, 256>(11, 4'000'037, 1024);
+  testRleBitpackDict<int64_t, 256>(17, 4'000'037, 1024);
+  testRleBitpackLevels<256>(40'013);
+}
+
 TEST_F(GpuDecoderTest, sparseBool) {
   testSparseBool<256>(40013, 1024);
 }
@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/dwio/parquet/ParquetFormatData.h"
+
+#include <thrift/protocol/TCompactProtocol.h> // @manual
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/dwio/common/compression/Compression.h"
+#include "velox/dwio/parquet/reader/PageReader.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+#include "velox/experimental/wave/dwio/ColumnReader.h"
+
+namespace facebook::velox::wave {
+
+using parquet::thrift::Encoding;
+using parquet::thrift::PageHeader;
+using parquet::thrift::PageType;
+using parquet::thrift::ThriftTransport;
+
+namespace {
+uint32_t readVarint(const uint8_t*& pos, const uint8_t* end) {
+  uint32_t value = 0;
+  for (auto shift = 0; pos < end && shift < 35; shift += 7) {
+    auto byte = *pos++;
+    value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      break;
+    }
+  }
+  return value;
+}
+
+// Returns the number of non-null values in the first 'numRows' definition
+// levels of a flat column with bit width 1 in 'levels'. The levels are mostly
+// RLE runs, so counting them on the host is cheap and lets the device side
+// steps of the values have static sizes.
+int32_t countNonNull(std::string_view levels, int32_t numRows) {
+  auto* pos = reinterpret_cast<const uint8_t*>(levels.data());
+  auto* end = pos + levels.size();
+  int32_t row = 0;
+  int32_t count = 0;
+  while (row < numRows && pos < end) {
+    auto header = readVarint(pos, end);
+    if (header & 1) {
+      int32_t numBytes = header >> 1;
+      auto numLevels = std::min<int32_t>(numBytes * 8, numRows - row);
+      for (auto i = 0; i < numLevels / 8; ++i) {
+        count += __builtin_popcount(pos[i]);
+      }
+      if (numLevels % 8) {
+        count += __builtin_popcount(
+            pos[numLevels / 8] & bits::lowMask(numLevels % 8));
+      }
+      pos += numBytes;
+      row += numLevels;
+    } else {
+      auto numLevels = std::min<int32_t>(header >> 1, numRows - row);
+      if (pos < end && *pos) {
+        count += numLevels;
+      }
+      ++pos;
+      row += numLevels;
+    }
+  }
+  return count;
+}
+
+int32_t typeSize(WaveTypeKind kind) {
+  switch (kind) {
+    case WaveTypeKind::INTEGER:
+    case WaveTypeKind::REAL:
+      return 4;
+    case WaveTypeKind::BIGINT:
+    case WaveTypeKind::DOUBLE:
+      return 8;
+    default:
+      VELOX_NYI(
+          "Parquet type not decoded on the device: {}",
+          static_cast<int32_t>(kind));
+  }
+}
+} // namespace
+
+ParquetColumnChunk::ParquetColumnChunk(
+    const char* data,
+    int64_t size,
+    common::CompressionKind codec,
+    WaveTypeKind kind,
+    int32_t maxDefine,
+    memory::MemoryPool& pool)
+    : codec_(codec), kind_(kind), maxDefine_(maxDefine), pool_(pool) {
+  VELOX_CHECK_LE(maxDefine_, 1, "Only flat columns are decoded on the device");
+  // Throws for types that are not decoded on the device.
+  typeSize(kind_);
+  int64_t offset = 0;
+  while (offset < size) {
+    std::shared_ptr<ThriftTransport> transport =
+        std::make_shared<parquet::thrift::ThriftBufferedTransport>(
+            data + offset, size - offset);
+    apache::thrift::protocol::TCompactProtocolT<ThriftTransport> protocol(
+        transport);
+    PageHeader header;
+    offset += header.read(&protocol);
+    auto* body = data + offset;
+    offset += header.compressed_page_size;
+    VELOX_CHECK_LE(offset, size, "Page extends past end of column chunk");
+
+    ParquetPage page;
+    switch (header.type) {
+      case PageType::DICTIONARY_PAGE: {
+        VELOX_CHECK(dictionary_.empty(), "Duplicate dictionary page");
+        auto encoding = header.dictionary_page_header.encoding;
+        VELOX_CHECK(
+            encoding == Encoding::PLAIN ||
+            encoding == Encoding::PLAIN_DICTIONARY);
+        dictionary_ = decompress(
+            body, header.compressed_page_size, header.uncompressed_page_size);
+        break;
+      }
+      case PageType::DATA_PAGE: {
+        auto bytes = decompress(
+            body, header.compressed_page_size, header.uncompressed_page_size);
+        page.numRows = header.data_page_header.num_values;
+        if (maxDefine_ > 0) {
+          uint32_t length;
+          VELOX_CHECK_GE(bytes.size(), sizeof(length));
+          ::memcpy(&length, bytes.data(), sizeof(length));
+          page.defineLevels = bytes.substr(sizeof(length), length);
+          bytes.remove_prefix(sizeof(length) + length);
+        }
+        addPage(page, header.data_page_header.encoding, bytes);
+        break;
+      }
+      case PageType::DATA_PAGE_V2: {
+        auto& pageHeader = header.data_page_header_v2;
+        VELOX_CHECK_EQ(pageHeader.repetition_levels_byte_length, 0);
+        auto levelsSize = pageHeader.definition_levels_byte_length;
+        page.numRows = pageHeader.num_values;
+        page.defineLevels = std::string_view(body, levelsSize);
+        std::string_view bytes(
+            body + levelsSize, header.compressed_page_size - levelsSize);
+        if (!pageHeader.__isset.is_compressed || pageHeader.is_compressed) {
+          bytes = decompress(
+              bytes.data(),
+              bytes.size(),
+              header.uncompressed_page_size - levelsSize);
+        }
+        addPage(page, pageHeader.encoding, bytes);
+        break;
+      }
+      default:
+        // Index pages and extensions are not needed for decoding.
+        break;
+    }
+  }
+}
+
+std::string_view ParquetColumnChunk::decompress(
+    const char* data,
+    int32_t compressedSize,
+    int32_t uncompressedSize) {
+  if (codec_ == common::CompressionKind::CompressionKind_NONE) {
+    return std::string_view(data, compressedSize);
+  }
+  auto decompressor = dwio::common::compression::createDecompressor(
+      codec_,
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          data, compressedSize, 0),
+      uncompressedSize,
+      pool_,
+      parquet::getParquetDecompressionOptions(codec_),
+      "Wave Parquet page",
+      nullptr,
+      true,
+      compressedSize);
+  auto buffer = AlignedBuffer::allocate<char>(uncompressedSize, &pool_);
+  decompressor->readFully(buffer->asMutable<char>(), uncompressedSize);
+  buffers_.push_back(buffer);
+  return std::string_view(buffer->as<char>(), uncompressedSize);
+}
+
+void ParquetColumnChunk::addPage(
+    ParquetPage& page,
+    Encoding::type encoding,
+    std::string_view values) {
+  switch (encoding) {
+    case Encoding::PLAIN:
+      break;
+    case Encoding::PLAIN_DICTIONARY:
+    case Encoding::RLE_DICTIONARY:
+      VELOX_CHECK(!dictionary_.empty(), "Dictionary page missing");
+      VELOX_CHECK(!values.empty());
+      page.isDictionary = true;
+      page.bitWidth = static_cast<uint8_t>(values[0]);
+      VELOX_CHECK_LE(page.bitWidth, 32);
+      values.remove_prefix(1);
+      break;
+    default:
+      VELOX_NYI(
+          "Parquet encoding not decoded on the device: {}",
+          static_cast<int32_t>(encoding));
+  }
+  page.values = values;
+  if (maxDefine_ > 0) {
+    VELOX_CHECK(!page.defineLevels.empty(), "Page without definition levels");
+    page.numValues = countNonNull(page.defineLevels, page.numRows);
+  } else {
+    page.numValues = page.numRows;
+  }
+  numRows_ += page.numRows;
+  pages_.push_back(page);
+}
+
+void ParquetFormatData::newBatch(int32_t startRow) {
+  auto& pages = chunk_->pages();
+  int32_t row = 0;
+  currentPage_ = 0;
+  while (currentPage_ < pages.size() && row < startRow) {
+    row += pages[currentPage_++].numRows;
+  }
+  VELOX_CHECK_EQ(row, startRow, "Batch does not start at a page boundary");
+  currentRow_ = startRow;
+  queued_ = false;
+}
+
+void ParquetFormatData::stage(SplitStaging& staging) {
+  auto add = [&](std::string_view data, int64_t& address) {
+    if (data.empty()) {
+      return kNoBufferId;
+    }
+    Staging area;
+    area.hostData = data.data();
+    area.size = data.size();
+    auto id = staging.add(area);
+    staging.registerPointer(id, &address);
+    return id;
+  };
+  auto& pages = chunk_->pages();
+  levelsIds_.resize(pages.size());
+  valuesIds_.resize(pages.size());
+  deviceLevels_.resize(pages.size());
+  deviceValues_.resize(pages.size());
+  dictionaryId_ = add(chunk_->dictionary(), deviceDictionary_);
+  for (auto i = 0; i < pages.size(); ++i) {
+    levelsIds_[i] = add(pages[i].defineLevels, deviceLevels_[i]);
+    valuesIds_[i] = add(pages[i].values, deviceValues_[i]);
+  }
+}
+
+std::vector<std::unique_ptr<GpuDecode>> ParquetFormatData::makeSteps(
+    int32_t pageIndex,
+    int32_t row,
+    WaveVector& vector,
+    int32_t*& temp,
+    SplitStaging& staging) {
+  auto& page = chunk_->pages()[pageIndex];
+  std::vector<std::unique_ptr<GpuDecode>> steps;
+  int32_t* scatter = nullptr;
+  if (!page.defineLevels.empty()) {
+    auto step = std::make_unique<GpuDecode>();
+    step->step = DecodeStep::kRleBitpack;
+    auto& op = step->data.rleBitpack;
+    op.bitWidth = 1;
+    op.levelsToNulls = true;
+    op.maxLevel = 1;
+    op.size = page.defineLevels.size();
+    op.begin = 0;
+    op.end = page.numRows;
+    setDeviceAddress(
+        op.input, levelsIds_[pageIndex], deviceLevels_[pageIndex], staging);
+    op.alphabet = nullptr;
+    op.scatter = nullptr;
+    op.runs = temp;
+    temp += 3 * std::min(op.end, op.size);
+    if (page.numValues < page.numRows) {
+      scatter = temp;
+      temp += page.numRows;
+    }
+    op.nonNullIndices = scatter;
+    op.result = vector.nulls() + row;
+    steps.push_back(std::move(step));
+  }
+  if (page.numValues == 0) {
+    return steps;
+  }
+  auto step = std::make_unique<GpuDecode>();
+  auto* result = vector.values<char>() + row * typeSize(chunk_->kind());
+  if (page.isDictionary) {
+    step->step = DecodeStep::kRleBitpack;
+    auto& op = step->data.rleBitpack;
+    op.dataType = chunk_->kind();
+    op.bitWidth = page.bitWidth;
+    op.levelsToNulls = false;
+    op.maxLevel = 0;
+    op.size = page.values.size();
+    op.begin = 0;
+    op.end = page.numValues;
+    setDeviceAddress(
+        op.input, valuesIds_[pageIndex], deviceValues_[pageIndex], staging);
+    setDeviceAddress(op.alphabet, dictionaryId_, deviceDictionary_, staging);
+    op.scatter = scatter;
+    op.runs = temp;
+    temp += 3 * std::min(op.end, op.size);
+    op.nonNullIndices = nullptr;
+    op.result = result;
+  } else {
+    step->step = DecodeStep::kTrivial;
+    auto& op = step->data.trivial;
+    op.dataType = chunk_->kind();
+    op.begin = 0;
+    op.end = page.numValues;
+    setDeviceAddress(
+        op.input, valuesIds_[pageIndex], deviceValues_[pageIndex], staging);
+    op.scatter = scatter;
+    op.result = result;
+  }
+  steps.push_back(std::move(step));
+  return steps;
+}
+
+void ParquetFormatData::startOp(
+    ColumnOp& op,
+    const ColumnOp* previousFilter,
+    ResultStaging& deviceStaging,
+    ResultStaging& resultStaging,
+    SplitStaging& staging,
+    DecodePrograms& program,
+    ReadStream& stream) {
+  if (queued_) {
+    return;
+  }
+  queued_ = true;
+  stagedNow_ = !staged_;
+  if (!staged_) {
+    staged_ = true;
+    stage(staging);
+  }
+  auto& pages = chunk_->pages();
+  const int32_t numRows = op.rows.back() + 1;
+  op.waveVector->resize(numRows, hasNulls());
+
+  // Temporary device memory for the run tables and non-null positions.
+  int64_t numTemp = 0;
+  auto lastPage = currentPage_;
+  for (int32_t row = 0; row < numRows; ++lastPage) {
+    VELOX_CHECK_LT(lastPage, pages.size());
+    auto& page = pages[lastPage];
+    if (!page.defineLevels.empty()) {
+      numTemp +=
+          3 * std::min<int64_t>(page.numRows, page.defineLevels.size());
+      if (page.numValues < page.numRows) {
+        numTemp += page.numRows;
+      }
+    }
+    if (page.isDictionary) {
+      numTemp += 3 * std::min<int64_t>(page.numValues, page.values.size());
+    }
+    row += page.numRows;
+    VELOX_CHECK_LE(row, numRows, "Batch does not end at a page boundary");
+  }
+  int32_t* temp = nullptr;
+  if (numTemp > 0) {
+    auto buffer = stream.waveStream->arena().allocate<int32_t>(numTemp);
+    temp = buffer->as<int32_t>();
+    stream.deviceData.push_back(std::move(buffer));
+  }
+
+  int32_t row = 0;
+  for (auto i = currentPage_; i < lastPage; ++i) {
+    program.programs.push_back(
+        makeSteps(i, row, *op.waveVector, temp, staging));
+    row += pages[i].numRows;
+  }
+  op.isFinal = true;
+}
+
+std::unique_ptr<FormatData> ParquetFormatParams::toFormatData(
+    const std::shared_ptr<const dwio::common::TypeWithId>& type,
+    const velox::common::ScanSpec& scanSpec,
+    OperandId operand) {
+  auto it = chunks_.find(type->id());
+  VELOX_CHECK(it != chunks_.end(), "No column chunk for column {}", type->id());
+  return std::make_unique<ParquetFormatData>(operand, it->second.get());
+}
+
+} // namespace facebook::velox::wave
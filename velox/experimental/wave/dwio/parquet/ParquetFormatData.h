@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string_view>
+#include <unordered_map>
+
+#include "velox/common/compression/Compression.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/experimental/wave/dwio/FormatData.h"
+
+namespace facebook::velox::wave {
+
+/// Decompressed data page of a flat column chunk.
+struct ParquetPage {
+  // Number of rows, including nulls.
+  int32_t numRows{0};
+
+  // Number of non-null values in 'values'.
+  int32_t numValues{0};
+
+  // True if 'values' are RLE dictionary indices, false if PLAIN.
+  bool isDictionary{false};
+
+  // Bit width of the dictionary indices.
+  int32_t bitWidth{0};
+
+  // Definition levels in the RLE/bit-packed hybrid encoding, without length
+  // prefix. Empty if the column has no nulls.
+  std::string_view defineLevels;
+
+  // Encoded values, after the bit width byte for dictionary indices.
+  std::string_view values;
+};
+
+/// The pages of a column chunk of a flat fixed width column. Page headers are
+/// parsed and page bodies are decompressed on the host. Definition levels and
+/// values are decoded on the device by ParquetFormatData.
+class ParquetColumnChunk {
+ public:
+  /// Reads the pages in the 'size' bytes of a column chunk at 'data'. 'data'
+  /// must stay live for the lifetime of 'this'. 'maxDefine' is 0 for a
+  /// required and 1 for an optional top level column.
+  ParquetColumnChunk(
+      const char* data,
+      int64_t size,
+      common::CompressionKind codec,
+      WaveTypeKind kind,
+      int32_t maxDefine,
+      memory::MemoryPool& pool);
+
+  WaveTypeKind kind() const {
+    return kind_;
+  }
+
+  int32_t maxDefine() const {
+    return maxDefine_;
+  }
+
+  /// PLAIN encoded dictionary values. Empty if no page is dictionary encoded.
+  std::string_view dictionary() const {
+    return dictionary_;
+  }
+
+  const std::vector<ParquetPage>& pages() const {
+    return pages_;
+  }
+
+  int32_t numRows() const {
+    return numRows_;
+  }
+
+ private:
+  // Returns the uncompressed bytes of a page body at 'data'.
+  std::string_view decompress(
+      const char* data,
+      int32_t compressedSize,
+      int32_t uncompressedSize);
+
+  // Sets the encoding and values of 'page' from the page body after the
+  // levels and adds 'page' to 'pages_'.
+  void addPage(
+      ParquetPage& page,
+      parquet::thrift::Encoding::type encoding,
+      std::string_view values);
+
+  const common::CompressionKind codec_;
+  const WaveTypeKind kind_;
+  const int32_t maxDefine_;
+  memory::MemoryPool& pool_;
+
+  std::string_view dictionary_;
+  std::vector<ParquetPage> pages_;
+  int32_t numRows_{0};
+
+  // Decompressed page bodies referenced from 'pages_' and 'dictionary_'.
+  std::vector<BufferPtr> buffers_;
+};
+
+/// FormatData that ships the levels and values of the pages of a
+/// ParquetColumnChunk to the device and decodes them there. Each page is
+/// decoded by its own thread block. A batch must start and end at page
+/// boundaries.
+class ParquetFormatData : public FormatData {
+ public:
+  ParquetFormatData(OperandId operand, const ParquetColumnChunk* chunk)
+      : operand_(operand), chunk_(chunk) {}
+
+  bool hasNulls() const override {
+    return chunk_->maxDefine() > 0;
+  }
+
+  int32_t totalRows() const override {
+    return chunk_->numRows();
+  }
+
+  void newBatch(int32_t startRow) override;
+
+  void startOp(
+      ColumnOp& op,
+      const ColumnOp* previousFilter,
+      ResultStaging& deviceStaging,
+      ResultStaging& resultStaging,
+      SplitStaging& staging,
+      DecodePrograms& program,
+      ReadStream& stream) override;
+
+ private:
+  // Adds the dictionary and the levels and values of all pages to 'staging'.
+  void stage(SplitStaging& staging);
+
+  // Sets 'field' to the device address of the staged area 'id', whose device
+  // address is 'address' once transferred. If the area is staged by the
+  // current startOp(), 'field' is patched when 'staging' is transferred.
+  template <typename T>
+  void setDeviceAddress(
+      T*& field,
+      BufferId id,
+      const int64_t& address,
+      SplitStaging& staging) {
+    if (stagedNow_) {
+      field = nullptr;
+      staging.registerPointer(id, &field);
+    } else {
+      field = reinterpret_cast<T*>(address);
+    }
+  }
+
+  // Returns the steps that decode 'page' into rows starting at 'row' of
+  // 'vector'. 'temp' is device memory for intermediates.
+  std::vector<std::unique_ptr<GpuDecode>> makeSteps(
+      int32_t pageIndex,
+      int32_t row,
+      WaveVector& vector,
+      int32_t*& temp,
+      SplitStaging& staging);
+
+  const OperandId operand_;
+  const ParquetColumnChunk* const chunk_;
+
+  bool staged_{false};
+  bool stagedNow_{false};
+  bool queued_{false};
+  // First row of the current batch.
+  int32_t currentRow_{0};
+  // First page of the current batch.
+  int32_t currentPage_{0};
+
+  // Staging ids and device addresses of the dictionary and of the levels and
+  // values of each page. The addresses are set after the staged transfer.
+  BufferId dictionaryId_{kNoBufferId};
+  int64_t deviceDictionary_{0};
+  std::vector<BufferId> levelsIds_;
+  std::vector<BufferId> valuesIds_;
+  std::vector<int64_t> deviceLevels_;
+  std::vector<int64_t> deviceValues_;
+};
+
+/// Makes ParquetFormatData for the columns of a row group. 'chunks' maps the
+/// id of the TypeWithId of each column to its chunk.
+class ParquetFormatParams : public FormatParams {
+ public:
+  ParquetFormatParams(
+      memory::MemoryPool& pool,
+      dwio::common::ColumnReaderStatistics& stats,
+      const std::unordered_map<uint32_t, std::unique_ptr<ParquetColumnChunk>>&
+          chunks)
+      : FormatParams(pool, stats), chunks_(chunks) {}
+
+  std::unique_ptr<FormatData> toFormatData(
+      const std::shared_ptr<const dwio::common::TypeWithId>& type,
+      const velox::common::ScanSpec& scanSpec,
+      OperandId operand) override;
+
+ private:
+  const std::unordered_map<uint32_t, std::unique_ptr<ParquetColumnChunk>>&
+      chunks_;
+};
+
+} // namespace facebook::velox::wave
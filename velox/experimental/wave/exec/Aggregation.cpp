@@ -59,6 +59,27 @@ int sizeOf() {
 
 } // namespace
 
+// static
+bool Aggregation::canConvert(const core::AggregationNode& node) {
+  if (!node.preGroupedKeys().empty()) {
+    return false;
+  }
+  if (node.step() == core::AggregationNode::Step::kSingle) {
+    return true;
+  }
+  if (node.step() != core::AggregationNode::Step::kPartial) {
+    return false;
+  }
+  for (auto& aggregate : node.aggregates()) {
+    auto& name = aggregate.call->name();
+    if (aggregate.mask || aggregate.distinct ||
+        (name != "count" && name != "sum")) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void Aggregation::toAggregateInfo(
     const TypePtr& inputType,
     const core::AggregationNode::Aggregate& aggregate,
@@ -83,8 +104,7 @@ Aggregation::Aggregation(
     : WaveOperator(state, node.outputType(), node.id()),
       arena_(&state.arena()),
       functionRegistry_(functionRegistry) {
-  VELOX_CHECK(node.step() == core::AggregationNode::Step::kSingle);
-  VELOX_CHECK(node.preGroupedKeys().empty());
+  VELOX_CHECK(canConvert(node));
   auto& inputType = node.sources()[0]->outputType();
   container_ = arena_->allocate<aggregation::GroupsContainer>(
       1, containerHolder_.container);
@@ -32,6 +32,12 @@ class Aggregation : public WaveOperator {
 
   ~Aggregation() override;
 
+  /// Returns true if 'node' can run on the device. Besides single
+  /// aggregations, accepts partial aggregations whose accumulators are their
+  /// results, i.e. count and sum, so that the drivers of a pipeline can run on
+  /// different devices and a final aggregation merges their results.
+  static bool canConvert(const core::AggregationNode& node);
+
   bool isStreaming() const override {
     return false;
   }
@@ -18,6 +18,7 @@
 
 #include "velox/experimental/wave/common/Block.cuh"
 #include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/common/StringView.cuh"
 #include "velox/experimental/wave/exec/WaveCore.cuh"
 
 namespace facebook::velox::wave {
@@ -43,6 +44,58 @@ __device__ inline void binaryOpKernel(
       getOperand<T>(operands, op.right, blockBase, shared));
 }
 
+// Sets the result of 'op' to 'func' of the input string, or to null if an
+// argument is null.
+template <typename T, typename Func>
+__device__ inline void stringKernel(
+    Func func,
+    const IString& op,
+    Operand** operands,
+    int32_t blockBase,
+    char* shared,
+    BlockStatus* status) {
+  if (threadIdx.x >= status->numRows) {
+    return;
+  }
+  if (operandIsNull(operands, op.input, blockBase) ||
+      (op.right != kEmpty && operandIsNull(operands, op.right, blockBase))) {
+    setNullResult(operands, op.result, blockBase);
+    return;
+  }
+  flatResult<T>(operands, op.result, blockBase, shared) =
+      func(getOperand<StringView>(operands, op.input, blockBase, shared));
+}
+
+// Returns the second argument of a string comparison.
+__device__ inline StringView rightString(
+    const IString& op,
+    Operand** operands,
+    int32_t blockBase,
+    char* shared) {
+  return op.right == kEmpty
+      ? op.constants[0]
+      : getOperand<StringView>(operands, op.right, blockBase, shared);
+}
+
+// Binary search of the ascending constants of 'op'.
+__device__ inline bool stringIn(StringView input, const IString& op) {
+  int32_t low = 0;
+  int32_t high = op.numConstants - 1;
+  while (low <= high) {
+    auto middle = (low + high) / 2;
+    auto result = input.compare(op.constants[middle]);
+    if (result == 0) {
+      return true;
+    }
+    if (result < 0) {
+      high = middle - 1;
+    } else {
+      low = middle + 1;
+    }
+  }
+  return false;
+}
+
 __device__ void filterKernel(
     const IFilter& filter,
     Operand** operands,
@@ -124,6 +177,89 @@ __global__ void waveBaseKernel(
         wrapKernel(instruction->_.wrap, operands, blockBase, status->numRows);
         break;
 
+      case OpCode::kStringEquals:
+      case OpCode::kStringNotEquals: {
+        auto& op = instruction->_.string;
+        bool equals = instruction->opCode == OpCode::kStringEquals;
+        stringKernel<uint8_t>(
+            [&](StringView input) {
+              return (input == rightString(op, operands, blockBase, shared)) ==
+                  equals;
+            },
+            op,
+            operands,
+            blockBase,
+            shared,
+            status);
+        break;
+      }
+
+      case OpCode::kStartsWith: {
+        auto& op = instruction->_.string;
+        stringKernel<uint8_t>(
+            [&](StringView input) {
+              return input.startsWith(
+                  rightString(op, operands, blockBase, shared));
+            },
+            op,
+            operands,
+            blockBase,
+            shared,
+            status);
+        break;
+      }
+
+      case OpCode::kEndsWith: {
+        auto& op = instruction->_.string;
+        stringKernel<uint8_t>(
+            [&](StringView input) {
+              return input.endsWith(
+                  rightString(op, operands, blockBase, shared));
+            },
+            op,
+            operands,
+            blockBase,
+            shared,
+            status);
+        break;
+      }
+
+      case OpCode::kStringLength:
+        stringKernel<int64_t>(
+            [](StringView input) -> int64_t { return input.numChars(); },
+            instruction->_.string,
+            operands,
+            blockBase,
+            shared,
+            status);
+        break;
+
+      case OpCode::kSubstr: {
+        auto& op = instruction->_.string;
+        stringKernel<StringView>(
+            [&](StringView input) {
+              return input.substr(op.start, op.length);
+            },
+            op,
+            operands,
+            blockBase,
+            shared,
+            status);
+        break;
+      }
+
+      case OpCode::kStringIn: {
+        auto& op = instruction->_.string;
+        stringKernel<uint8_t>(
+            [&](StringView input) { return stringIn(input, op); },
+            op,
+            operands,
+            blockBase,
+            shared,
+            status);
+        break;
+      }
+
         BINARY_TYPES(OpCode::kPlus, +);
     }
   }
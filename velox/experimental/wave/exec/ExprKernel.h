@@ -18,6 +18,7 @@
 
 #include <cstdint>
 #include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/StringView.h"
 #include "velox/experimental/wave/exec/ErrorCode.h"
 #include "velox/experimental/wave/vector/Operand.h"
 
@@ -48,6 +49,15 @@ enum class OpCode {
   kFilter = 0,
   kWrap,
 
+  // String functions. These take StringView arguments and an IString.
+  kStringEquals,
+  kStringNotEquals,
+  kStartsWith,
+  kEndsWith,
+  kStringLength,
+  kSubstr,
+  kStringIn,
+
   // From here, only OpCodes that have variants for scalar types.
   kPlus,
   kMinus,
@@ -76,6 +86,21 @@ struct IBinary {
   uint8_t invert{0};
 };
 
+/// Operands of string functions. Comparisons are with 'right' or with
+/// 'constants[0]' if 'right' is kEmpty. kStringIn tests 'input' against
+/// 'constants', which are ascending and unique. Boolean results are a byte
+/// per row.
+struct IString {
+  OperandIndex input;
+  OperandIndex right{kEmpty};
+  OperandIndex result;
+  int32_t numConstants{0};
+  StringView* constants{nullptr};
+  // Constant 1-based start and length of substr.
+  int64_t start{0};
+  int64_t length{0};
+};
+
 struct IFilter {
   OperandIndex flags;
   OperandIndex indices;
@@ -115,6 +140,7 @@ struct Instruction {
   OpCode opCode;
   union {
     IBinary binary;
+    IString string;
     IFilter filter;
     IWrap wrap;
   } _;
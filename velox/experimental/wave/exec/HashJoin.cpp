@@ -0,0 +1,444 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/HashJoin.h"
+
+#include "velox/exec/HashTable.h"
+#include "velox/exec/Task.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+#include "velox/experimental/wave/exec/WaveDriver.h"
+
+namespace facebook::velox::wave {
+
+namespace {
+
+// Number of build side rows extracted from the RowContainer at a time.
+constexpr int32_t kExtractBatchSize = 1024;
+
+bool isIntegerKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool isFixedWidthKind(TypeKind kind) {
+  return isIntegerKind(kind) || kind == TypeKind::REAL ||
+      kind == TypeKind::DOUBLE;
+}
+
+template <typename T>
+void copyValues(
+    const BaseVector& vector,
+    int32_t slot,
+    int32_t numRows,
+    int32_t rowSize,
+    char* rows) {
+  auto* flat = vector.asUnchecked<FlatVector<T>>();
+  for (auto i = 0; i < numRows; ++i) {
+    auto* row = reinterpret_cast<join::JoinRow*>(rows + i * rowSize);
+    if (flat->isNullAt(i)) {
+      row->nulls |= 1UL << slot;
+      continue;
+    }
+    int64_t value = 0;
+    if constexpr (std::is_floating_point_v<T>) {
+      memcpy(&value, flat->rawValues() + i, sizeof(T));
+    } else {
+      value = flat->valueAtFast(i);
+    }
+    row->slots()[slot] = value;
+  }
+}
+
+// Copies the values of 'vector' to 'slot' of 'numRows' device rows of
+// 'rowSize' bytes at 'rows'.
+void copyToSlots(
+    const BaseVector& vector,
+    int32_t slot,
+    int32_t numRows,
+    int32_t rowSize,
+    char* rows) {
+  switch (vector.typeKind()) {
+    case TypeKind::TINYINT:
+      return copyValues<int8_t>(vector, slot, numRows, rowSize, rows);
+    case TypeKind::SMALLINT:
+      return copyValues<int16_t>(vector, slot, numRows, rowSize, rows);
+    case TypeKind::INTEGER:
+      return copyValues<int32_t>(vector, slot, numRows, rowSize, rows);
+    case TypeKind::BIGINT:
+      return copyValues<int64_t>(vector, slot, numRows, rowSize, rows);
+    case TypeKind::REAL:
+      return copyValues<float>(vector, slot, numRows, rowSize, rows);
+    case TypeKind::DOUBLE:
+      return copyValues<double>(vector, slot, numRows, rowSize, rows);
+    default:
+      VELOX_UNSUPPORTED("Unsupported hash join column: {}", vector.type());
+  }
+}
+
+// Returns the column in the HashBuild RowContainer for 'channel' of the build
+// side input. The keys come first, followed by the other columns in input
+// order.
+int32_t rowContainerColumn(
+    const std::vector<column_index_t>& keyChannels,
+    column_index_t channel) {
+  auto it = std::find(keyChannels.begin(), keyChannels.end(), channel);
+  if (it != keyChannels.end()) {
+    return it - keyChannels.begin();
+  }
+  int32_t column = keyChannels.size();
+  for (auto i = 0; i < channel; ++i) {
+    if (std::find(keyChannels.begin(), keyChannels.end(), i) ==
+        keyChannels.end()) {
+      ++column;
+    }
+  }
+  return column;
+}
+
+} // namespace
+
+// static
+bool HashJoin::canConvert(const core::HashJoinNode& node) {
+  if (!(node.isInnerJoin() || node.isLeftJoin() ||
+        node.isLeftSemiFilterJoin()) ||
+      node.filter() || node.isNullAware()) {
+    return false;
+  }
+  auto& probeType = node.sources()[0]->outputType();
+  auto& buildType = node.sources()[1]->outputType();
+  std::vector<column_index_t> buildKeyChannels;
+  for (auto i = 0; i < node.leftKeys().size(); ++i) {
+    auto probeChannel =
+        exec::exprToChannel(node.leftKeys()[i].get(), probeType);
+    auto buildChannel =
+        exec::exprToChannel(node.rightKeys()[i].get(), buildType);
+    if (!isIntegerKind(probeType->childAt(probeChannel)->kind()) ||
+        !isIntegerKind(buildType->childAt(buildChannel)->kind()) ||
+        std::find(
+            buildKeyChannels.begin(), buildKeyChannels.end(), buildChannel) !=
+            buildKeyChannels.end()) {
+      return false;
+    }
+    buildKeyChannels.push_back(buildChannel);
+  }
+  int32_t numSlots = buildKeyChannels.size();
+  for (auto& type : node.outputType()->children()) {
+    if (!isFixedWidthKind(type->kind())) {
+      return false;
+    }
+    ++numSlots;
+  }
+  // The nulls of a build side row are a 64 bit mask.
+  return numSlots <= 64;
+}
+
+HashJoin::HashJoin(CompileState& state, const core::HashJoinNode& node)
+    : WaveOperator(state, node.outputType(), node.id()),
+      arena_(&state.arena()),
+      joinBridge_(state.driver().task()->getHashJoinBridge(
+          state.driver().driverCtx()->splitGroupId,
+          node.id())),
+      joinType_(
+          node.isInnerJoin()      ? join::JoinType::kInner
+              : node.isLeftJoin() ? join::JoinType::kLeft
+                                  : join::JoinType::kSemi) {
+  VELOX_CHECK(canConvert(node));
+  auto& probeType = node.sources()[0]->outputType();
+  auto& buildType = node.sources()[1]->outputType();
+  std::vector<column_index_t> buildKeyChannels;
+  for (auto i = 0; i < node.leftKeys().size(); ++i) {
+    probeKeyChannels_.push_back(
+        exec::exprToChannel(node.leftKeys()[i].get(), probeType));
+    buildKeyChannels.push_back(
+        exec::exprToChannel(node.rightKeys()[i].get(), buildType));
+    slotColumns_.push_back(i);
+    slotTypes_.push_back(buildType->childAt(buildKeyChannels.back()));
+  }
+
+  // The result columns in the order of the result operands.
+  const auto numColumns = outputType_->size();
+  resultChannels_.resize(numColumns);
+  for (auto i = 0; i < numColumns; ++i) {
+    resultChannels_[outputIds_.ordinal(defines(Value(subfields_[i]))->id)] = i;
+  }
+  for (auto channel : resultChannels_) {
+    auto& name = outputType_->nameOf(channel);
+    if (auto probeChannel = probeType->getChildIdxIfExists(name)) {
+      probeChannels_.push_back(probeChannel.value());
+      buildSlots_.push_back(-1);
+      continue;
+    }
+    auto buildChannel = buildType->getChildIdx(name);
+    auto key = std::find(
+        buildKeyChannels.begin(), buildKeyChannels.end(), buildChannel);
+    probeChannels_.push_back(kConstantChannel);
+    if (key != buildKeyChannels.end()) {
+      buildSlots_.push_back(key - buildKeyChannels.begin());
+      continue;
+    }
+    buildSlots_.push_back(slotColumns_.size());
+    slotColumns_.push_back(rowContainerColumn(buildKeyChannels, buildChannel));
+    slotTypes_.push_back(buildType->childAt(buildChannel));
+  }
+
+  table_ = arena_->allocate<join::JoinTable>(1, tableHolder_.emplace_back());
+  new (table_) join::JoinTable();
+  table_->numKeys = probeKeyChannels_.size();
+  table_->joinType = joinType_;
+  table_->probeKeyKinds = arena_->allocate<PhysicalType::Kind>(
+      table_->numKeys, tableHolder_.emplace_back());
+  for (auto i = 0; i < table_->numKeys; ++i) {
+    table_->probeKeyKinds[i] =
+        fromCpuType(*probeType->childAt(probeKeyChannels_[i])).kind;
+  }
+  table_->numColumns = numColumns;
+  table_->buildSlots =
+      arena_->allocate<int32_t>(numColumns, tableHolder_.emplace_back());
+  table_->kinds = arena_->allocate<PhysicalType::Kind>(
+      numColumns, tableHolder_.emplace_back());
+  for (auto i = 0; i < numColumns; ++i) {
+    table_->buildSlots[i] = buildSlots_[i];
+    table_->kinds[i] =
+        fromCpuType(*outputType_->childAt(resultChannels_[i])).kind;
+  }
+}
+
+HashJoin::~HashJoin() {
+  if (flushStream_) {
+    WaveStream::releaseStream(std::move(flushStream_));
+  }
+}
+
+exec::BlockingReason HashJoin::isBlocked(ContinueFuture* future) {
+  if (tableBuffer_) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+  auto result = joinBridge_->tableOrFuture(future);
+  if (!result.has_value()) {
+    return exec::BlockingReason::kWaitForJoinBuild;
+  }
+  VELOX_CHECK(
+      result->spillPartitionIds.empty(),
+      "Spilled hash join build side is not supported on Wave");
+  loadTable(*result->table);
+  return exec::BlockingReason::kNotBlocked;
+}
+
+void HashJoin::loadTable(const exec::BaseHashTable& table) {
+  auto containers = table.allRows();
+  int64_t numRows = 0;
+  for (auto* rows : containers) {
+    numRows += rows->numRows();
+  }
+  VELOX_CHECK_LE(numRows, std::numeric_limits<int32_t>::max());
+  const int32_t rowSize =
+      sizeof(join::JoinRow) + slotColumns_.size() * sizeof(int64_t);
+  // GPU cache lines are 128 bytes divided in 4 separately loadable 32 byte
+  // sectors.
+  constexpr int32_t kAlignment = 128;
+  // At most half of the slots are used so that every probe ends at an empty
+  // slot.
+  const int32_t numBuckets = bits::nextPowerOfTwo(numRows / 2 + 1);
+  const int64_t bucketBytes = sizeof(GpuBucketMembers) * numBuckets;
+  auto* data = arena_->allocate<char>(
+      sizeof(GpuHashTableBase) + kAlignment + bucketBytes + numRows * rowSize,
+      tableBuffer_);
+  auto* hashTable = new (data) GpuHashTableBase();
+  data = reinterpret_cast<char*>(
+      bits::roundUp(reinterpret_cast<uint64_t>(hashTable + 1), kAlignment));
+  hashTable->buckets = reinterpret_cast<GpuBucket*>(data);
+  hashTable->sizeMask = numBuckets - 1;
+  // The rows are allocated by the host.
+  hashTable->allocators = nullptr;
+  memset(data, 0, bucketBytes + numRows * rowSize);
+  table_->table = hashTable;
+  table_->rows = data + bucketBytes;
+  table_->numRows = numRows;
+  table_->rowSize = rowSize;
+
+  std::vector<char*> rows(kExtractBatchSize);
+  std::vector<VectorPtr> vectors;
+  for (auto& type : slotTypes_) {
+    vectors.push_back(
+        BaseVector::create(type, kExtractBatchSize, driver_->pool()));
+  }
+  int64_t numCopied = 0;
+  for (auto* container : containers) {
+    exec::RowContainerIterator iter;
+    while (auto numListed =
+               container->listRows(&iter, kExtractBatchSize, rows.data())) {
+      auto* target = table_->rows + numCopied * rowSize;
+      for (auto slot = 0; slot < slotColumns_.size(); ++slot) {
+        container->extractColumn(
+            rows.data(), numListed, slotColumns_[slot], vectors[slot]);
+        copyToSlots(*vectors[slot], slot, numListed, rowSize, target);
+      }
+      numCopied += numListed;
+    }
+  }
+  VELOX_CHECK_EQ(numCopied, numRows);
+
+  auto* probe = arena_->allocate<HashProbe>(1, tableHolder_.emplace_back());
+  new (probe) HashProbe();
+  if (!flushStream_) {
+    flushStream_ = WaveStream::streamFromReserve();
+  }
+  join::build(*flushStream_, table_, probe);
+  flushStream_->wait();
+  VLOG(1) << "Loaded " << numRows << " build side rows";
+}
+
+void HashJoin::startProbe() {
+  if (!flushStream_) {
+    flushStream_ = WaveStream::streamFromReserve();
+  }
+  VLOG(1) << "Probe " << buffered_.size() << " batches";
+  flushStart_.record(*flushStream_);
+  for (auto& input : buffered_) {
+    if (input->size() == 0) {
+      continue;
+    }
+    ProbeHolder holder;
+    auto* probe = arena_->allocate<join::JoinProbe>(1, holder.probe);
+    probe->numRows = input->size();
+    auto* operands = arena_->allocate<Operand>(
+        probeKeyChannels_.size() + probeChannels_.size(), holder.operands);
+    probe->keys = operands;
+    probe->columns = operands + probeKeyChannels_.size();
+    for (auto i = 0; i < probeKeyChannels_.size(); ++i) {
+      input->childAt(probeKeyChannels_[i]).toOperand(&probe->keys[i]);
+    }
+    for (auto i = 0; i < probeChannels_.size(); ++i) {
+      if (buildSlots_[i] < 0) {
+        input->childAt(probeChannels_[i]).toOperand(&probe->columns[i]);
+      }
+    }
+    probe->hits =
+        arena_->allocate<join::JoinRow*>(probe->numRows, holder.hits);
+    join::probe(*flushStream_, table_, probe);
+    holder.input = std::move(input);
+    probing_.push_back(std::move(holder));
+  }
+  buffered_.clear();
+  flushDone_.record(*flushStream_);
+}
+
+void HashJoin::waitProbeDone() {
+  flushDone_.wait();
+  for (auto& holder : probing_) {
+    stats_.probedRowCount += holder.input->size();
+    probed_.push_back(std::move(holder));
+  }
+  probing_.clear();
+  stats_.gpuTimeMs += flushDone_.elapsedTime(flushStart_);
+}
+
+void HashJoin::flush(bool noMoreInput) {
+  if (noMoreInput) {
+    noMoreInput_ = true;
+  } else {
+    VELOX_CHECK(!noMoreInput_);
+  }
+  // Probing starts when the table is loaded and the previous batches are
+  // probed.
+  if (!tableBuffer_ || !probing_.empty() || buffered_.empty()) {
+    return;
+  }
+  startProbe();
+}
+
+int32_t HashJoin::canAdvance() {
+  if (!tableBuffer_) {
+    return 0;
+  }
+  for (;;) {
+    if (!probing_.empty()) {
+      if (!noMoreInput_ && !flushDone_.query()) {
+        return 0;
+      }
+      waitProbeDone();
+    }
+    int32_t numRows = 0;
+    for (auto& holder : probed_) {
+      numRows += holder.probe->as<join::JoinProbe>()->numResultRows;
+    }
+    if (numRows > 0) {
+      return numRows;
+    }
+    probed_.clear();
+    if (buffered_.empty()) {
+      return 0;
+    }
+    startProbe();
+  }
+}
+
+void HashJoin::schedule(WaveStream& waveStream, int32_t maxRows) {
+  VELOX_CHECK(!probed_.empty());
+  const auto numColumns = resultChannels_.size();
+  auto exec = std::make_unique<Executable>();
+  exec->operands =
+      arena_->allocate<Operand>(numColumns, exec->deviceData.emplace_back());
+  auto* result =
+      arena_->allocate<join::JoinResult>(1, exec->deviceData.emplace_back());
+  result->columns = exec->operands;
+  result->numRows = 0;
+  exec->outputOperands = outputIds_;
+  for (auto i = 0; i < numColumns; ++i) {
+    auto column =
+        WaveVector::create(outputType_->childAt(resultChannels_[i]), *arena_);
+    column->resize(maxRows, true);
+    column->toOperand(&exec->operands[i]);
+    exec->output.push_back(std::move(column));
+  }
+  // The probe batches are freed when the executable arrives.
+  std::vector<join::JoinProbe*> probes;
+  int32_t numRows = 0;
+  for (auto& holder : probed_) {
+    probes.push_back(holder.probe->as<join::JoinProbe>());
+    numRows += probes.back()->numResultRows;
+    exec->intermediates.push_back(std::move(holder.input));
+    exec->deviceData.push_back(std::move(holder.probe));
+    exec->deviceData.push_back(std::move(holder.operands));
+    exec->deviceData.push_back(std::move(holder.hits));
+  }
+  probed_.clear();
+  VELOX_CHECK_EQ(numRows, maxRows);
+  waveStream.installExecutables(
+      folly::Range(&exec, 1),
+      [&](Stream* stream, folly::Range<Executable**> exes) {
+        for (auto* probe : probes) {
+          join::expand(*stream, table_, probe, result);
+        }
+        waveStream.markLaunch(*stream, *exes[0]);
+      });
+  outputSizes_[&waveStream] = numRows;
+}
+
+vector_size_t HashJoin::outputSize(WaveStream& stream) const {
+  auto it = outputSizes_.find(&stream);
+  VELOX_CHECK(it != outputSizes_.end());
+  return it->second;
+}
+
+} // namespace facebook::velox::wave
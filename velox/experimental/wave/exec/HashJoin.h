@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/HashJoinBridge.h"
+#include "velox/experimental/wave/exec/HashJoinKernels.h"
+#include "velox/experimental/wave/exec/WaveOperator.h"
+
+namespace facebook::velox::wave {
+
+/// Probe side of a hash join on the device. The build side is built by the
+/// CPU HashBuild operators. When the table arrives, its rows are copied to
+/// device memory and inserted in a GpuHashTable once. The table then stays
+/// resident while probe batches stream through. Supports inner, left and left
+/// semi joins on integer keys without filter and with fixed width columns.
+class HashJoin : public WaveOperator {
+ public:
+  HashJoin(CompileState& state, const core::HashJoinNode& node);
+
+  ~HashJoin() override;
+
+  /// Returns true if 'node' can run on the device.
+  static bool canConvert(const core::HashJoinNode& node);
+
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  void enqueue(WaveVectorPtr input) override {
+    VELOX_CHECK(!noMoreInput_);
+    buffered_.push_back(std::move(input));
+  }
+
+  void flush(bool noMoreInput) override;
+
+  int32_t canAdvance() override;
+
+  void schedule(WaveStream& stream, int32_t maxRows) override;
+
+  bool isFinished() const override {
+    return noMoreInput_ && buffered_.empty() && probing_.empty() &&
+        probed_.empty();
+  }
+
+  vector_size_t outputSize(WaveStream& stream) const override;
+
+  std::string toString() const override {
+    return "HashJoin";
+  }
+
+ private:
+  // A probe batch and the device memory for probing it.
+  struct ProbeHolder {
+    WaveVectorPtr input;
+    WaveBufferPtr probe;
+    WaveBufferPtr operands;
+    WaveBufferPtr hits;
+  };
+
+  // Copies the rows of 'table' to the device and builds the device side hash
+  // table.
+  void loadTable(const exec::BaseHashTable& table);
+
+  // Starts probing the buffered batches on 'flushStream_'.
+  void startProbe();
+
+  void waitProbeDone();
+
+  GpuArena* arena_;
+  std::shared_ptr<exec::HashJoinBridge> joinBridge_;
+
+  join::JoinType joinType_;
+
+  // The probe side channel of each key.
+  std::vector<column_index_t> probeKeyChannels_;
+
+  // For each result column in the order of the result operands, the channel
+  // in 'outputType_', the probe side channel and the build side slot. The
+  // build side slot is -1 for probe side columns.
+  std::vector<column_index_t> resultChannels_;
+  std::vector<column_index_t> probeChannels_;
+  std::vector<int32_t> buildSlots_;
+
+  // For each build side slot, the column in the HashBuild RowContainer and its
+  // type. The keys come first.
+  std::vector<int32_t> slotColumns_;
+  std::vector<TypePtr> slotTypes_;
+
+  // The device resident build side. 'tableBuffer_' is set once the table is
+  // loaded.
+  join::JoinTable* table_;
+  WaveBufferPtr tableBuffer_;
+  std::vector<WaveBufferPtr> tableHolder_;
+
+  std::vector<WaveVectorPtr> buffered_;
+  std::vector<ProbeHolder> probing_;
+  std::vector<ProbeHolder> probed_;
+  std::unique_ptr<Stream> flushStream_;
+  Event flushStart_{true}, flushDone_{true};
+
+  // The number of result rows of each stream given to schedule().
+  folly::F14FastMap<const WaveStream*, int32_t> outputSizes_;
+
+  struct {
+    int64_t probedRowCount;
+    float gpuTimeMs;
+  } stats_{};
+
+  bool noMoreInput_ = false;
+};
+
+} // namespace facebook::velox::wave
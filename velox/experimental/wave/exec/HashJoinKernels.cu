@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/HashJoinKernels.h"
+
+#include "velox/experimental/wave/common/HashTable.cuh"
+
+namespace facebook::velox::wave::join {
+
+namespace {
+
+constexpr uint64_t kHashSeed = 1;
+
+__device__ inline int64_t
+slotValue(const Operand* op, int32_t i, PhysicalType::Kind kind) {
+  auto index = i & op->indexMask;
+  switch (kind) {
+    case PhysicalType::kInt8:
+      return reinterpret_cast<const int8_t*>(op->base)[index];
+    case PhysicalType::kInt16:
+      return reinterpret_cast<const int16_t*>(op->base)[index];
+    case PhysicalType::kInt32:
+      return reinterpret_cast<const int32_t*>(op->base)[index];
+    case PhysicalType::kFloat32:
+      return reinterpret_cast<const uint32_t*>(op->base)[index];
+    case PhysicalType::kInt64:
+    case PhysicalType::kFloat64:
+      return reinterpret_cast<const int64_t*>(op->base)[index];
+    default:
+      assert(false);
+      return 0;
+  }
+}
+
+__device__ inline void
+setSlotValue(Operand* op, int32_t i, PhysicalType::Kind kind, int64_t value) {
+  switch (kind) {
+    case PhysicalType::kInt8:
+      reinterpret_cast<int8_t*>(op->base)[i] = value;
+      break;
+    case PhysicalType::kInt16:
+      reinterpret_cast<int16_t*>(op->base)[i] = value;
+      break;
+    case PhysicalType::kInt32:
+    case PhysicalType::kFloat32:
+      reinterpret_cast<int32_t*>(op->base)[i] = value;
+      break;
+    case PhysicalType::kInt64:
+    case PhysicalType::kFloat64:
+      reinterpret_cast<int64_t*>(op->base)[i] = value;
+      break;
+    default:
+      assert(false);
+  }
+}
+
+__device__ inline bool isNullAt(const Operand* op, int32_t i) {
+  return op->nulls && op->nulls[i & op->indexMask] == kNull;
+}
+
+__device__ inline JoinRow* rowAt(JoinTable* join, int32_t i) {
+  return reinterpret_cast<JoinRow*>(
+      join->rows + static_cast<int64_t>(i) * join->rowSize);
+}
+
+__device__ inline uint64_t hashRow(JoinTable* join, JoinRow* row) {
+  auto h = kHashSeed;
+  for (auto k = 0; k < join->numKeys; ++k) {
+    h = hashMix(h, row->slots()[k]);
+  }
+  return h;
+}
+
+__device__ inline int32_t
+numRowsInBlock(int32_t numRows, int32_t blockBase) {
+  return min(static_cast<int32_t>(blockDim.x), numRows - blockBase);
+}
+
+class BuildOps {
+ public:
+  explicit __device__ BuildOps(JoinTable* join) : join_(join) {}
+
+  int32_t __device__ blockBase(HashProbe* /*probe*/) {
+    return blockIdx.x * blockDim.x;
+  }
+
+  int32_t __device__ numRowsInBlock(HashProbe* probe) {
+    return join::numRowsInBlock(join_->numRows, blockBase(probe));
+  }
+
+  uint64_t __device__ hash(int32_t i, HashProbe* /*probe*/) {
+    return hashRow(join_, rowAt(join_, i));
+  }
+
+  bool __device__ compare(
+      GpuHashTable* /*table*/,
+      JoinRow* row,
+      int32_t i,
+      HashProbe* /*probe*/) {
+    auto* keys = rowAt(join_, i)->slots();
+    for (auto k = 0; k < join_->numKeys; ++k) {
+      if (row->slots()[k] != keys[k]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // The rows are allocated by the host. Sets 'row' only after the tag is in
+  // place so that a retry does not free it.
+  ProbeState __device__ insert(
+      GpuHashTable* /*table*/,
+      int32_t /*partition*/,
+      GpuBucket* bucket,
+      uint32_t misses,
+      uint32_t oldTags,
+      uint32_t tagWord,
+      int32_t i,
+      HashProbe* /*probe*/,
+      JoinRow*& row) {
+    auto missShift = __ffs(misses) - 1;
+    if (!bucket->addNewTag(tagWord, oldTags, missShift)) {
+      return ProbeState::kRetry;
+    }
+    row = rowAt(join_, i);
+    bucket->store(missShift / 8, row);
+    return ProbeState::kDone;
+  }
+
+  JoinRow* __device__ getExclusive(
+      GpuHashTable* /*table*/,
+      GpuBucket* /*bucket*/,
+      JoinRow* row,
+      int32_t /*hitIdx*/,
+      int32_t /*warp*/) {
+    return row;
+  }
+
+  void __device__ writeDone(JoinRow* /*row*/) {}
+
+  // Links row 'i' after the first row with the same keys.
+  ProbeState __device__ update(
+      GpuHashTable* /*table*/,
+      GpuBucket* /*bucket*/,
+      JoinRow* row,
+      int32_t i,
+      HashProbe* /*probe*/) {
+    auto* added = rowAt(join_, i);
+    if (added != row) {
+      added->next = reinterpret_cast<JoinRow*>(atomicExch(
+          reinterpret_cast<unsigned long long*>(&row->next),
+          reinterpret_cast<unsigned long long>(added)));
+    }
+    return ProbeState::kDone;
+  }
+
+ private:
+  JoinTable* const join_;
+};
+
+class ProbeOps {
+ public:
+  __device__ ProbeOps(JoinTable* join, JoinProbe* probe)
+      : join_(join), probe_(probe) {}
+
+  int32_t __device__ blockBase(HashProbe* /*probe*/) {
+    return blockIdx.x * blockDim.x;
+  }
+
+  int32_t __device__ numRowsInBlock(HashProbe* probe) {
+    return join::numRowsInBlock(probe_->numRows, blockBase(probe));
+  }
+
+  uint64_t __device__ hash(int32_t i, HashProbe* /*probe*/) {
+    auto h = kHashSeed;
+    for (auto k = 0; k < join_->numKeys; ++k) {
+      h = hashMix(
+          h, slotValue(&probe_->keys[k], i, join_->probeKeyKinds[k]));
+    }
+    return h;
+  }
+
+  // A null key matches nothing.
+  bool __device__ compare(
+      GpuHashTable* /*table*/,
+      JoinRow* row,
+      int32_t i,
+      HashProbe* /*probe*/) {
+    for (auto k = 0; k < join_->numKeys; ++k) {
+      auto* key = &probe_->keys[k];
+      if (isNullAt(key, i) ||
+          row->slots()[k] != slotValue(key, i, join_->probeKeyKinds[k])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void __device__ hit(int32_t i, HashProbe* /*probe*/, JoinRow* row) {
+    probe_->hits[i] = row;
+    int32_t numMatches = 1;
+    if (join_->joinType != JoinType::kSemi) {
+      for (auto* next = row->next; next; next = next->next) {
+        ++numMatches;
+      }
+    }
+    atomicAdd(&probe_->numResultRows, numMatches);
+  }
+
+  void __device__ miss(int32_t i, HashProbe* /*probe*/) {
+    probe_->hits[i] = nullptr;
+    if (join_->joinType == JoinType::kLeft) {
+      atomicAdd(&probe_->numResultRows, 1);
+    }
+  }
+
+ private:
+  JoinTable* const join_;
+  JoinProbe* const probe_;
+};
+
+// Writes a result row for probe row 'i' and build side row 'row'. 'row' is
+// nullptr for a probe row without match in a left join and for semi joins.
+__device__ void addResultRow(
+    JoinTable* join,
+    JoinProbe* probe,
+    int32_t i,
+    JoinRow* row,
+    JoinResult* result) {
+  auto resultRow = atomicAdd(&result->numRows, 1);
+  for (auto column = 0; column < join->numColumns; ++column) {
+    auto* target = &result->columns[column];
+    auto kind = join->kinds[column];
+    auto slot = join->buildSlots[column];
+    bool isNull;
+    int64_t value = 0;
+    if (slot < 0) {
+      auto* source = &probe->columns[column];
+      isNull = isNullAt(source, i);
+      if (!isNull) {
+        value = slotValue(source, i, kind);
+      }
+    } else {
+      isNull = !row || (row->nulls >> slot & 1);
+      if (!isNull) {
+        value = row->slots()[slot];
+      }
+    }
+    if (target->nulls) {
+      target->nulls[resultRow] = isNull ? kNull : kNotNull;
+    }
+    setSlotValue(target, resultRow, kind, value);
+  }
+}
+
+__global__ void buildKernel(JoinTable* join, HashProbe* probe) {
+  reinterpret_cast<GpuHashTable*>(join->table)
+      ->updatingProbe<JoinRow>(probe, BuildOps(join));
+}
+
+__global__ void probeKernel(JoinTable* join, JoinProbe* probe) {
+  // The ops keep the probe state.
+  reinterpret_cast<GpuHashTable*>(join->table)
+      ->readOnlyProbe<JoinRow>(nullptr, ProbeOps(join, probe));
+}
+
+__global__ void
+expandKernel(JoinTable* join, JoinProbe* probe, JoinResult* result) {
+  auto i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= probe->numRows) {
+    return;
+  }
+  auto* row = probe->hits[i];
+  if (join->joinType == JoinType::kSemi) {
+    if (row) {
+      addResultRow(join, probe, i, nullptr, result);
+    }
+  } else if (!row) {
+    if (join->joinType == JoinType::kLeft) {
+      addResultRow(join, probe, i, nullptr, result);
+    }
+  } else {
+    for (; row; row = row->next) {
+      addResultRow(join, probe, i, row, result);
+    }
+  }
+}
+
+int32_t numBlocks(int32_t numRows) {
+  return (numRows + kBlockSize - 1) / kBlockSize;
+}
+
+} // namespace
+
+void build(Stream& stream, JoinTable* join, HashProbe* probe) {
+  if (join->numRows == 0) {
+    return;
+  }
+  buildKernel<<<
+      numBlocks(join->numRows),
+      kBlockSize,
+      GpuHashTable::updatingProbeSharedSize(),
+      stream.stream()->stream>>>(join, probe);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+void probe(Stream& stream, JoinTable* join, JoinProbe* probe) {
+  probe->numResultRows = 0;
+  if (probe->numRows == 0) {
+    return;
+  }
+  probeKernel<<<
+      numBlocks(probe->numRows),
+      kBlockSize,
+      0,
+      stream.stream()->stream>>>(join, probe);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+void expand(
+    Stream& stream,
+    JoinTable* join,
+    JoinProbe* probe,
+    JoinResult* result) {
+  if (probe->numRows == 0) {
+    return;
+  }
+  expandKernel<<<
+      numBlocks(probe->numRows),
+      kBlockSize,
+      0,
+      stream.stream()->stream>>>(join, probe, result);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace facebook::velox::wave::join
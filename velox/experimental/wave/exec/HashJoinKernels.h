@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/HashTable.h"
+#include "velox/experimental/wave/common/Type.h"
+#include "velox/experimental/wave/vector/Operand.h"
+
+/// Device side structures and kernels of the Wave hash join. The structures
+/// are in unified memory and are filled in by the host.
+namespace facebook::velox::wave::join {
+
+enum class JoinType : int8_t { kInner, kLeft, kSemi };
+
+/// A build side row. Followed by an 8 byte slot for each build side column
+/// that is needed, keys first. Integers are sign extended to 64 bits and
+/// floating point values keep their bits.
+struct JoinRow {
+  // Next row with the same keys.
+  JoinRow* next;
+
+  // Bit 'i' is set if slot 'i' is null.
+  uint64_t nulls;
+
+  __device__ __host__ int64_t* slots() {
+    return reinterpret_cast<int64_t*>(this + 1);
+  }
+};
+
+/// The build side of a join. Stays resident on the device for the lifetime of
+/// the probe.
+struct JoinTable {
+  GpuHashTableBase* table;
+
+  // 'numRows' rows of 'rowSize' bytes each.
+  char* rows;
+  int32_t numRows;
+  int32_t rowSize;
+
+  int32_t numKeys;
+  JoinType joinType;
+
+  // Physical type of each probe side key.
+  PhysicalType::Kind* probeKeyKinds;
+
+  // Number of result columns. The columns are in the order of the result
+  // operands.
+  int32_t numColumns;
+
+  // For each result column, the build side slot or -1 if the column comes from
+  // the probe side.
+  int32_t* buildSlots;
+
+  // Physical type of each result column.
+  PhysicalType::Kind* kinds;
+};
+
+/// A batch of probe side rows and their matches.
+struct JoinProbe {
+  int32_t numRows;
+
+  // One operand for each key.
+  Operand* keys;
+
+  // One operand for each result column. Set for the probe side columns.
+  Operand* columns;
+
+  // The first matching build side row for each probe row, nullptr if none.
+  JoinRow** hits;
+
+  // The number of result rows for the batch. Set by probe().
+  int32_t numResultRows;
+};
+
+struct JoinResult {
+  // One operand for each result column.
+  Operand* columns;
+
+  // The number of rows written so far.
+  int32_t numRows;
+};
+
+/// Inserts the rows of 'join' into its hash table. Rows with equal keys are
+/// linked through JoinRow::next. The rows must not have null keys.
+void build(Stream& stream, JoinTable* join, HashProbe* probe);
+
+/// Looks up the rows of 'probe' in the hash table of 'join' and counts the
+/// result rows.
+void probe(Stream& stream, JoinTable* join, JoinProbe* probe);
+
+/// Appends the result rows of 'probe' to 'result'. 'probe' must have been
+/// passed to probe() on the same stream before.
+void expand(
+    Stream& stream,
+    JoinTable* join,
+    JoinProbe* probe,
+    JoinResult* result);
+
+} // namespace facebook::velox::wave::join
@@ -92,4 +92,23 @@ struct AbstractBinary : public AbstractInstruction {
   bool invert{false};
 };
 
+/// String function. 'right' is the second string argument of a comparison or
+/// nullptr if the argument is the constant in 'constants'. For kStringIn,
+/// 'constants' is the IN-list.
+struct AbstractString : public AbstractInstruction {
+  AbstractString(
+      OpCode opCode,
+      AbstractOperand* input,
+      AbstractOperand* result)
+      : AbstractInstruction(opCode), input(input), result(result) {}
+
+  AbstractOperand* input;
+  AbstractOperand* right{nullptr};
+  AbstractOperand* result;
+  std::vector<std::string> constants;
+  // Constant 1-based start and length for substr.
+  int64_t start{0};
+  int64_t length{0};
+};
+
 } // namespace facebook::velox::wave
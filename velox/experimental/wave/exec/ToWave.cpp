@@ -17,6 +17,7 @@
 #include "velox/experimental/wave/exec/ToWave.h"
 #include "velox/exec/FilterProject.h"
 #include "velox/experimental/wave/exec/Aggregation.h"
+#include "velox/experimental/wave/exec/HashJoin.h"
 #include "velox/experimental/wave/exec/Project.h"
 #include "velox/experimental/wave/exec/TableScan.h"
 #include "velox/experimental/wave/exec/Values.h"
@@ -26,6 +27,12 @@
 
 DEFINE_int64(velox_wave_arena_unit_size, 1 << 30, "Per Driver GPU memory size");
 
+DEFINE_int32(
+    velox_wave_num_devices,
+    0,
+    "Number of GPUs the Wave drivers of a pipeline are spread over. 0 means "
+    "all visible devices");
+
 namespace facebook::velox::wave {
 
 using exec::Expr;
@@ -125,6 +132,227 @@ std::optional<OpCode> binaryOpCode(const Expr& expr) {
   return std::nullopt;
 }
 
+namespace {
+bool isVarchar(const Expr& expr) {
+  return expr.type()->kind() == TypeKind::VARCHAR;
+}
+
+bool isConstant(const Expr& expr) {
+  return dynamic_cast<const exec::ConstantExpr*>(&expr) != nullptr;
+}
+
+// Returns the value of 'expr' if it is a non-null constant of type T.
+template <typename T>
+std::optional<T> constantValue(const Expr& expr) {
+  auto* constant = dynamic_cast<const exec::ConstantExpr*>(&expr);
+  if (!constant || constant->value()->isNullAt(0)) {
+    return std::nullopt;
+  }
+  auto* vector =
+      dynamic_cast<const ConstantVector<T>*>(constant->value().get());
+  if (!vector) {
+    return std::nullopt;
+  }
+  return vector->valueAt(0);
+}
+
+std::optional<std::string> stringConstant(const Expr& expr) {
+  if (!isVarchar(expr)) {
+    return std::nullopt;
+  }
+  auto value = constantValue<velox::StringView>(expr);
+  if (!value.has_value()) {
+    return std::nullopt;
+  }
+  return value->str();
+}
+
+std::optional<int64_t> integerConstant(const Expr& expr) {
+  switch (expr.type()->kind()) {
+    case TypeKind::INTEGER:
+      return constantValue<int32_t>(expr);
+    case TypeKind::BIGINT:
+      return constantValue<int64_t>(expr);
+    default:
+      return std::nullopt;
+  }
+}
+
+// Returns the distinct values of the IN-list of 'expr' in ascending order, or
+// std::nullopt if the list is not constant or has nulls. The list is either a
+// constant array or the arguments after the first.
+std::optional<std::vector<std::string>> inListConstants(const Expr& expr) {
+  std::vector<std::string> values;
+  auto& inputs = expr.inputs();
+  if (inputs.size() == 2 && inputs[1]->type()->kind() == TypeKind::ARRAY) {
+    auto* constant = dynamic_cast<const exec::ConstantExpr*>(inputs[1].get());
+    if (!constant || constant->value()->isNullAt(0)) {
+      return std::nullopt;
+    }
+    auto* array =
+        dynamic_cast<const ArrayVector*>(constant->value()->wrappedVector());
+    auto index = constant->value()->wrappedIndex(0);
+    auto* elements = array
+        ? dynamic_cast<const SimpleVector<velox::StringView>*>(
+              array->elements().get())
+        : nullptr;
+    if (!elements) {
+      return std::nullopt;
+    }
+    auto offset = array->offsetAt(index);
+    for (auto i = offset; i < offset + array->sizeAt(index); ++i) {
+      if (elements->isNullAt(i)) {
+        return std::nullopt;
+      }
+      values.push_back(elements->valueAt(i).str());
+    }
+  } else {
+    for (auto i = 1; i < inputs.size(); ++i) {
+      auto value = stringConstant(*inputs[i]);
+      if (!value.has_value()) {
+        return std::nullopt;
+      }
+      values.push_back(std::move(value.value()));
+    }
+  }
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  return values;
+}
+
+// Translates a LIKE 'pattern' that is a literal with '%' at the start or the
+// end to equality, prefix or suffix comparison with the literal. Returns
+// std::nullopt for other patterns.
+std::optional<OpCode> likeOpCode(std::string& pattern) {
+  if (pattern.empty()) {
+    return OpCode::kStringEquals;
+  }
+  auto numLeading = pattern.find_first_not_of('%');
+  if (numLeading == std::string::npos) {
+    pattern.clear();
+    return OpCode::kStartsWith;
+  }
+  auto numTrailing = pattern.size() - 1 - pattern.find_last_not_of('%');
+  auto literal =
+      pattern.substr(numLeading, pattern.size() - numLeading - numTrailing);
+  if (literal.find_first_of("%_") != std::string::npos ||
+      (numLeading > 0 && numTrailing > 0)) {
+    return std::nullopt;
+  }
+  pattern = literal;
+  if (numLeading > 0) {
+    return OpCode::kEndsWith;
+  }
+  return numTrailing > 0 ? OpCode::kStartsWith : OpCode::kStringEquals;
+}
+
+std::optional<OpCode> stringCompareOpCode(const std::string& name) {
+  if (name == "eq") {
+    return OpCode::kStringEquals;
+  }
+  if (name == "neq") {
+    return OpCode::kStringNotEquals;
+  }
+  if (name == "starts_with") {
+    return OpCode::kStartsWith;
+  }
+  if (name == "ends_with") {
+    return OpCode::kEndsWith;
+  }
+  return std::nullopt;
+}
+} // namespace
+
+AbstractOperand* CompileState::addStringFunction(const Expr& expr) {
+  auto& name = expr.name();
+  auto& inputs = expr.inputs();
+  if (inputs.empty() || !isVarchar(*inputs[0])) {
+    return nullptr;
+  }
+  const Expr* input = inputs[0].get();
+  const Expr* right = nullptr;
+  std::vector<std::string> constants;
+  int64_t start = 0;
+  int64_t length = 0;
+  OpCode opCode;
+  if (auto compareCode = stringCompareOpCode(name)) {
+    if (inputs.size() != 2 || !isVarchar(*inputs[1])) {
+      return nullptr;
+    }
+    opCode = compareCode.value();
+    right = inputs[1].get();
+    bool symmetric = opCode == OpCode::kStringEquals ||
+        opCode == OpCode::kStringNotEquals;
+    auto rightValue = stringConstant(*right);
+    auto leftValue = stringConstant(*input);
+    if (rightValue.has_value()) {
+      constants.push_back(std::move(rightValue.value()));
+      right = nullptr;
+    } else if (leftValue.has_value() && symmetric) {
+      constants.push_back(std::move(leftValue.value()));
+      input = right;
+      right = nullptr;
+    }
+  } else if (name == "like") {
+    auto pattern = inputs.size() == 2 ? stringConstant(*inputs[1])
+                                      : std::nullopt;
+    if (!pattern.has_value()) {
+      return nullptr;
+    }
+    auto likeCode = likeOpCode(pattern.value());
+    if (!likeCode.has_value()) {
+      return nullptr;
+    }
+    opCode = likeCode.value();
+    constants.push_back(std::move(pattern.value()));
+  } else if (name == "length") {
+    opCode = OpCode::kStringLength;
+  } else if (name == "substr") {
+    auto startValue =
+        inputs.size() > 1 ? integerConstant(*inputs[1]) : std::nullopt;
+    auto lengthValue = inputs.size() > 2
+        ? integerConstant(*inputs[2])
+        : std::optional<int64_t>(std::numeric_limits<int64_t>::max());
+    if (!startValue.has_value() || !lengthValue.has_value()) {
+      return nullptr;
+    }
+    opCode = OpCode::kSubstr;
+    start = startValue.value();
+    length = lengthValue.value();
+  } else if (name == "in") {
+    auto values = inListConstants(expr);
+    if (!values.has_value()) {
+      return nullptr;
+    }
+    opCode = OpCode::kStringIn;
+    constants = std::move(values.value());
+  } else {
+    return nullptr;
+  }
+  if (isConstant(*input) || (right && isConstant(*right))) {
+    return nullptr;
+  }
+  auto result = newOperand(expr.type(), "r");
+  auto instruction =
+      std::make_unique<AbstractString>(opCode, addExpr(*input), result);
+  if (right) {
+    instruction->right = addExpr(*right);
+  }
+  instruction->constants = std::move(constants);
+  instruction->start = start;
+  instruction->length = length;
+  std::vector<Program*> sources;
+  for (auto* operand : {instruction->input, instruction->right}) {
+    if (operand) {
+      if (auto program = definedIn_[operand]) {
+        sources.push_back(program);
+      }
+    }
+  }
+  addInstruction(std::move(instruction), result, sources);
+  return result;
+}
+
 Program* CompileState::newProgram() {
   auto program = std::make_shared<Program>();
   allPrograms_.push_back(program);
@@ -179,6 +407,9 @@ AbstractOperand* CompileState::addExpr(const Expr& expr) {
   } else if (dynamic_cast<const exec::SpecialForm*>(&expr)) {
     VELOX_UNSUPPORTED("No special forms");
   }
+  if (auto result = addStringFunction(expr)) {
+    return result;
+  }
   auto opCode = binaryOpCode(expr);
   if (!opCode.has_value()) {
     VELOX_UNSUPPORTED("Expr not supported: {}", expr.toString());
@@ -273,11 +504,24 @@ void CompileState::addFilterProject(
       std::make_unique<Project>(*this, outputType, operands, levels));
 }
 
+Device* CompileState::selectDevice() const {
+  auto count = numDevices();
+  VELOX_CHECK_GT(count, 0, "No CUDA device");
+  if (FLAGS_velox_wave_num_devices > 0) {
+    count = std::min(count, FLAGS_velox_wave_num_devices);
+  }
+  return getDevice(driver_.driverCtx()->driverId % count);
+}
+
 bool CompileState::reserveMemory() {
   if (arena_) {
     return true;
   }
-  auto* allocator = getAllocator(getDevice());
+  device_ = selectDevice();
+  // Allocations and kernels of the pipeline go to 'device_' from here on.
+  // WaveDriver sets the device again on each call.
+  setDevice(device_);
+  auto* allocator = getAllocator(device_);
   arena_ =
       std::make_unique<GpuArena>(FLAGS_velox_wave_arena_unit_size, allocator);
   return true;
@@ -318,12 +562,12 @@ bool CompileState::addOperator(
     outputType = driverFactory_.planNodes[nodeIndex]->outputType();
     addFilterProject(op, outputType, nodeIndex);
   } else if (name == "Aggregation") {
-    if (!reserveMemory()) {
-      return false;
-    }
     auto* node = dynamic_cast<const core::AggregationNode*>(
         driverFactory_.planNodes[nodeIndex].get());
     VELOX_CHECK_NOT_NULL(node);
+    if (!Aggregation::canConvert(*node) || !reserveMemory()) {
+      return false;
+    }
     operators_.push_back(std::make_unique<Aggregation>(
         *this, *node, aggregateFunctionRegistry()));
     outputType = node->outputType();
@@ -338,6 +582,14 @@ bool CompileState::addOperator(
     operators_.push_back(
         std::make_unique<TableScan>(*this, operators_.size(), *scan));
     outputType = scan->outputType();
+  } else if (name == "HashProbe") {
+    auto* node = dynamic_cast<const core::HashJoinNode*>(
+        driverFactory_.planNodes[nodeIndex].get());
+    if (!node || !HashJoin::canConvert(*node) || !reserveMemory()) {
+      return false;
+    }
+    operators_.push_back(std::make_unique<HashJoin>(*this, *node));
+    outputType = node->outputType();
   } else {
     return false;
   }
@@ -397,6 +649,7 @@ bool CompileState::compile() {
       outputType,
       operators[first]->planNodeId(),
       operators[first]->operatorId(),
+      device_,
       std::move(arena_),
       std::move(operators_),
       std::move(resultOrder),
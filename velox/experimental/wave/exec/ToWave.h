@@ -87,8 +87,18 @@ class CompileState {
       RowTypePtr outputType,
       int32_t& nodeIndex);
 
+  // Adds a string function instruction for 'expr'. Returns nullptr if 'expr'
+  // is not a string function that runs on the device. Constant arguments other
+  // than the first are folded into the instruction.
+  AbstractOperand* addStringFunction(const exec::Expr& expr);
+
+  // Picks the device of the Wave pipeline and makes its arena.
   bool reserveMemory();
 
+  // Returns the device for the Wave pipeline of 'driver_'. The drivers of a
+  // pipeline are spread round robin over the devices.
+  Device* selectDevice() const;
+
   // Adds 'instruction' to the suitable program and records the result
   // of the instruction to the right program. The set of programs
   // 'instruction's operands depend is in 'programs'. If 'instruction'
@@ -104,6 +114,7 @@ class CompileState {
   const std::shared_ptr<aggregation::AggregateFunctionRegistry>&
   aggregateFunctionRegistry();
 
+  Device* device_{nullptr};
   std::unique_ptr<GpuArena> arena_;
   // The operator and output operand where the Value is first defined.
   folly::F14FastMap<Value, AbstractOperand*, ValueHasher, ValueComparer>
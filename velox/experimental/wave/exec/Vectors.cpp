@@ -75,6 +75,11 @@ void transferVector(
     std::vector<Operand>& operands,
     GpuArena& arena,
     int64_t totalBytes) {
+  // Velox and Wave StringViews differ. Strings come from device side readers.
+  VELOX_CHECK(
+      source->typeKind() != TypeKind::VARCHAR &&
+          source->typeKind() != TypeKind::VARBINARY,
+      "String vectors are not transferred to the device");
   if (waveVectors.size() <= index) {
     waveVectors.resize(index + 1);
   }
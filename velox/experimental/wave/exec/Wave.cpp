@@ -108,8 +108,8 @@ WaveStream::~WaveStream() {
 }
 
 std::mutex WaveStream::reserveMutex_;
-std::vector<std::unique_ptr<Stream>> WaveStream::streamsForReuse_;
-std::vector<std::unique_ptr<Event>> WaveStream::eventsForReuse_;
+std::vector<std::vector<std::unique_ptr<Stream>>> WaveStream::streamsForReuse_;
+std::vector<std::vector<std::unique_ptr<Event>>> WaveStream::eventsForReuse_;
 bool WaveStream::exitInited_{false};
 
 Stream* WaveStream::newStream() {
@@ -130,8 +130,13 @@ void WaveStream::clearReusable() {
 
 // static
 std::unique_ptr<Stream> WaveStream::streamFromReserve() {
+  auto deviceId = getDevice()->deviceId;
   std::lock_guard<std::mutex> l(reserveMutex_);
-  if (streamsForReuse_.empty()) {
+  if (streamsForReuse_.size() <= deviceId) {
+    streamsForReuse_.resize(deviceId + 1);
+  }
+  auto& streams = streamsForReuse_[deviceId];
+  if (streams.empty()) {
     auto result = std::make_unique<Stream>();
     if (!exitInited_) {
       // Register handler for clearing resources after first call of API.
@@ -141,15 +146,19 @@ std::unique_ptr<Stream> WaveStream::streamFromReserve() {
 
     return result;
   }
-  auto item = std::move(streamsForReuse_.back());
-  streamsForReuse_.pop_back();
+  auto item = std::move(streams.back());
+  streams.pop_back();
   return item;
 }
 
 //  static
 void WaveStream::releaseStream(std::unique_ptr<Stream>&& stream) {
   std::lock_guard<std::mutex> l(reserveMutex_);
-  streamsForReuse_.push_back(std::move(stream));
+  auto deviceId = stream->deviceId();
+  if (streamsForReuse_.size() <= deviceId) {
+    streamsForReuse_.resize(deviceId + 1);
+  }
+  streamsForReuse_[deviceId].push_back(std::move(stream));
 }
 Event* WaveStream::newEvent() {
   auto event = eventFromReserve();
@@ -160,19 +169,26 @@ Event* WaveStream::newEvent() {
 
 // static
 std::unique_ptr<Event> WaveStream::eventFromReserve() {
+  auto deviceId = getDevice()->deviceId;
   std::lock_guard<std::mutex> l(reserveMutex_);
-  if (eventsForReuse_.empty()) {
+  if (eventsForReuse_.size() <= deviceId ||
+      eventsForReuse_[deviceId].empty()) {
     return std::make_unique<Event>();
   }
-  auto item = std::move(eventsForReuse_.back());
-  eventsForReuse_.pop_back();
+  auto& events = eventsForReuse_[deviceId];
+  auto item = std::move(events.back());
+  events.pop_back();
   return item;
 }
 
 //  static
 void WaveStream::releaseEvent(std::unique_ptr<Event>&& event) {
   std::lock_guard<std::mutex> l(reserveMutex_);
-  eventsForReuse_.push_back(std::move(event));
+  auto deviceId = event->deviceId();
+  if (eventsForReuse_.size() <= deviceId) {
+    eventsForReuse_.resize(deviceId + 1);
+  }
+  eventsForReuse_[deviceId].push_back(std::move(event));
 }
 
 namespace {
@@ -456,9 +472,22 @@ ScalarType typeKindCode(TypeKind kind) {
   }
 }
 
+#define STRING_OPCODES         \
+  case OpCode::kStringEquals:    \
+  case OpCode::kStringNotEquals: \
+  case OpCode::kStartsWith:      \
+  case OpCode::kEndsWith:        \
+  case OpCode::kStringLength:    \
+  case OpCode::kSubstr:          \
+  case OpCode::kStringIn
+
 void Program::prepareForDevice(GpuArena& arena) {
   int32_t codeSize = 0;
   int32_t sharedMemorySize = 0;
+  // The StringViews of string constants and their bytes follow the
+  // instructions.
+  int32_t numStringConstants = 0;
+  int64_t stringBytes = 0;
   for (auto& instruction : instructions_)
     switch (instruction->opCode) {
       case OpCode::kPlus: {
@@ -470,6 +499,18 @@ void Program::prepareForDevice(GpuArena& arena) {
         codeSize += sizeof(Instruction);
         break;
       }
+      STRING_OPCODES: {
+        auto& string = instruction->as<AbstractString>();
+        markInput(string.input);
+        markInput(string.right);
+        markResult(string.result);
+        for (auto& constant : string.constants) {
+          stringBytes += constant.size();
+        }
+        numStringConstants += string.constants.size();
+        codeSize += sizeof(Instruction);
+        break;
+      }
       default:
         VELOX_UNSUPPORTED(
             "OpCode {}", static_cast<int32_t>(instruction->opCode));
@@ -478,7 +519,8 @@ void Program::prepareForDevice(GpuArena& arena) {
   arena_ = &arena;
   deviceData_ = arena.allocate<char>(
       codeSize + instructions_.size() * sizeof(void*) +
-      sizeof(ThreadBlockProgram));
+      sizeof(ThreadBlockProgram) + numStringConstants * sizeof(StringView) +
+      stringBytes);
   program_ = deviceData_->as<ThreadBlockProgram>();
   auto instructionArray = addBytes<Instruction**>(program_, sizeof(*program_));
   program_->sharedMemorySize = sharedMemorySize;
@@ -486,6 +528,9 @@ void Program::prepareForDevice(GpuArena& arena) {
   program_->instructions = instructionArray;
   Instruction* space = addBytes<Instruction*>(
       instructionArray, instructions_.size() * sizeof(void*));
+  auto* stringConstants = addBytes<StringView*>(space, codeSize);
+  auto* bytes = addBytes<char*>(
+      stringConstants, numStringConstants * sizeof(StringView));
   for (auto& instruction : instructions_) {
     *instructionArray = space;
     ++instructionArray;
@@ -502,12 +547,37 @@ void Program::prepareForDevice(GpuArena& arena) {
         ++space;
         break;
       }
+      STRING_OPCODES: {
+        auto& string = instruction->as<AbstractString>();
+        space->opCode = instruction->opCode;
+        new (&space->_.string) IString();
+        auto& op = space->_.string;
+        op.input = operandIndex(string.input);
+        if (string.right) {
+          op.right = operandIndex(string.right);
+        }
+        op.result = operandIndex(string.result);
+        op.numConstants = string.constants.size();
+        op.constants = stringConstants;
+        for (auto& constant : string.constants) {
+          memcpy(bytes, constant.data(), constant.size());
+          stringConstants->init(bytes, constant.size());
+          bytes += constant.size();
+          ++stringConstants;
+        }
+        op.start = string.start;
+        op.length = string.length;
+        ++space;
+        break;
+      }
       default:
         VELOX_UNSUPPORTED("Bad OpCode");
     }
   }
 }
 
+#undef STRING_OPCODES
+
 void Program::sortSlots() {
   // Assigns offsets to input and local/output slots so that all
   // input is first and output next and within input and output, the
@@ -399,10 +399,11 @@ class WaveStream {
   static std::unique_ptr<Event> eventFromReserve();
   static void releaseEvent(std::unique_ptr<Event>&& event);
 
-  // Preallocated Streams and Events.
+  // Preallocated Streams and Events, indexed by device id. Streams and events
+  // can only be used on the device they were created on.
   static std::mutex reserveMutex_;
-  static std::vector<std::unique_ptr<Event>> eventsForReuse_;
-  static std::vector<std::unique_ptr<Stream>> streamsForReuse_;
+  static std::vector<std::vector<std::unique_ptr<Event>>> eventsForReuse_;
+  static std::vector<std::vector<std::unique_ptr<Stream>>> streamsForReuse_;
   static bool exitInited_;
 
   static void clearReusable();
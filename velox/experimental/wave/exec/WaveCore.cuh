@@ -31,6 +31,19 @@ __device__ inline bool isNull(Operand* op, int32_t blockBase) {
   return op->nulls == nullptr || !op->nulls[blockBase + threadIdx.x];
 }
 
+// Returns the row of 'op' for the lane after applying the indices of the
+// block.
+__device__ inline int32_t operandRow(Operand* op, int32_t blockBase) {
+  int32_t index = (threadIdx.x + blockBase) & op->indexMask;
+  if (auto indicesInOp = op->indices) {
+    auto indices = indicesInOp[blockBase / kBlockSize];
+    if (indices) {
+      index = indices[index];
+    }
+  }
+  return index;
+}
+
 template <typename T>
 __device__ inline T getOperand(
     Operand** operands,
@@ -42,14 +55,18 @@ __device__ inline T getOperand(
         shared + opIdx - kMinSharedMemIndex)[blockIdx.x];
   }
   auto op = operands[opIdx];
-  int32_t index = (threadIdx.x + blockBase) & op->indexMask;
-  if (auto indicesInOp = op->indices) {
-    auto indices = indicesInOp[blockBase / kBlockSize];
-    if (indices) {
-      index = indices[index];
-    }
+  return reinterpret_cast<const T*>(op->base)[operandRow(op, blockBase)];
+}
+
+/// True if the lane's row of operand 'opIdx' is null. Operands in shared
+/// memory are not nullable.
+__device__ inline bool
+operandIsNull(Operand** operands, OperandIndex opIdx, int32_t blockBase) {
+  if (opIdx >= kMinSharedMemIndex) {
+    return false;
   }
-  return reinterpret_cast<const T*>(op->base)[index];
+  auto op = operands[opIdx];
+  return op->nulls && op->nulls[operandRow(op, blockBase)] == kNull;
 }
 
 template <typename T>
@@ -85,6 +102,13 @@ __device__ inline T& flatResult(
   return reinterpret_cast<T*>(op->base)[blockBase + threadIdx.x];
 }
 
+/// Sets the lane's row of result 'opIdx' to null. The result must be
+/// nullable.
+__device__ inline void
+setNullResult(Operand** operands, OperandIndex opIdx, int32_t blockBase) {
+  operands[opIdx]->nulls[blockBase + threadIdx.x] = kNull;
+}
+
 template <typename T>
 __device__ inline T& flatResult(Operand* op, int32_t blockBase) {
   return flatResult<T>(&op, 0, blockBase, nullptr);
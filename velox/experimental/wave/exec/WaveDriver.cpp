@@ -15,9 +15,19 @@
  */
 
 #include "velox/experimental/wave/exec/WaveDriver.h"
+
+#include <gflags/gflags.h>
+
 #include "velox/experimental/wave/exec/Instruction.h"
 #include "velox/experimental/wave/exec/WaveOperator.h"
 
+DEFINE_int32(
+    velox_wave_max_pipeline_streams,
+    2,
+    "Maximum number of WaveStreams in flight in a pipeline of a WaveDriver. "
+    "More than one lets the transfer of a split overlap the decoding and "
+    "processing of the previous one");
+
 namespace facebook::velox::wave {
 
 WaveDriver::WaveDriver(
@@ -25,6 +35,7 @@ WaveDriver::WaveDriver(
     RowTypePtr outputType,
     core::PlanNodeId planNodeId,
     int32_t operatorId,
+    Device* device,
     std::unique_ptr<GpuArena> arena,
     std::vector<std::unique_ptr<WaveOperator>> waveOperators,
     std::vector<OperandId> resultOrder,
@@ -36,11 +47,13 @@ WaveDriver::WaveDriver(
           operatorId,
           planNodeId,
           "Wave"),
+      device_(device),
       arena_(std::move(arena)),
       resultOrder_(std::move(resultOrder)),
       subfields_(std::move(subfields)),
       operands_(std::move(operands)) {
   VELOX_CHECK(!waveOperators.empty());
+  VELOX_CHECK_NOT_NULL(device_);
   pipelines_.emplace_back();
   for (auto& op : waveOperators) {
     op->setDriver(this);
@@ -53,8 +66,14 @@ WaveDriver::WaveDriver(
 
 RowVectorPtr WaveDriver::getOutput() {
   VLOG(1) << "Getting output";
+  setDevice(device_);
   for (;;) {
     startMore();
+    if (blockingFuture_.valid()) {
+      // The first operator of a pipeline is blocked, e.g. waiting for a join
+      // build side. Retry when unblocked.
+      return nullptr;
+    }
     bool running = false;
     for (int i = pipelines_.size() - 1; i >= 0; --i) {
       if (pipelines_[i].streams.empty()) {
@@ -146,6 +165,10 @@ RowVectorPtr WaveDriver::makeResult(
 void WaveDriver::startMore() {
   for (int i = 0; i < pipelines_.size(); ++i) {
     auto& ops = pipelines_[i].operators;
+    const int32_t numStreams = pipelines_[i].streams.size();
+    if (numStreams >= FLAGS_velox_wave_max_pipeline_streams) {
+      continue;
+    }
     blockingReason_ = ops[0]->isBlocked(&blockingFuture_);
     if (blockingReason_ != exec::BlockingReason::kNotBlocked) {
       return;
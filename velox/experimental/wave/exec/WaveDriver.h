@@ -29,6 +29,7 @@ class WaveDriver : public exec::SourceOperator {
       RowTypePtr outputType,
       core::PlanNodeId planNodeId,
       int32_t operatorId,
+      Device* device,
       std::unique_ptr<GpuArena> arena,
       std::vector<std::unique_ptr<WaveOperator>> waveOperators,
       std::vector<OperandId> resultOrder_,
@@ -57,6 +58,11 @@ class WaveDriver : public exec::SourceOperator {
     return *arena_;
   }
 
+  /// The device on which the arena and kernels of 'this' are.
+  Device* device() const {
+    return device_;
+  }
+
   const std::vector<std::unique_ptr<AbstractOperand>>& operands() {
     return operands_;
   }
@@ -104,6 +110,9 @@ class WaveDriver : public exec::SourceOperator {
   // Enqueus a prefetch from device to host for the buffers of output vectors.
   void prefetchReturn(WaveStream& stream);
 
+  // The device of 'arena_'. Driver threads run Drivers on different devices,
+  // so this is made the current device at each entry from the Driver.
+  Device* const device_;
   std::unique_ptr<GpuArena> arena_;
   std::unique_ptr<GpuArena> deviceArena_;
   std::unique_ptr<GpuArena> hostArena_;
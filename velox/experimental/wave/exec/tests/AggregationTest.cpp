@@ -92,6 +92,31 @@ TEST_F(AggregationTest, singleKeyMultiAggregate) {
   AssertQueryBuilder(plan).assertResults(expected);
 }
 
+TEST_F(AggregationTest, partialAggregationMultipleDrivers) {
+  constexpr int kSize = 10;
+  constexpr int kNumDrivers = 4;
+  auto vector = makeRowVector({
+      makeFlatVector<int64_t>(kSize, [](int i) { return i % 3; }),
+      makeFlatVector<int64_t>(kSize, folly::identity),
+  });
+  // Each driver produces all of 'vector' and may run on its own device. The
+  // final aggregation merges the partial results of all drivers on the host.
+  auto plan = PlanBuilder()
+                  .values({vector}, true)
+                  .partialAggregation({"c0"}, {"count(c1)", "sum(c1)"})
+                  .localPartition({"c0"})
+                  .finalAggregation()
+                  .planNode();
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>({0, 1, 2}),
+      makeFlatVector<int64_t>(
+          {4 * kNumDrivers, 3 * kNumDrivers, 3 * kNumDrivers}),
+      makeFlatVector<int64_t>(
+          {18 * kNumDrivers, 12 * kNumDrivers, 15 * kNumDrivers}),
+  });
+  AssertQueryBuilder(plan).maxDrivers(kNumDrivers).assertResults(expected);
+}
+
 TEST_F(AggregationTest, multiKeySingleAggregate) {
   constexpr int kSize = 10;
   // 0 1 0 1 0 1 0 1 0 1
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_runtime.h> // @manual
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class HashJoinTest : public OperatorTestBase {
+ protected:
+  void SetUp() override {
+    if (int device; cudaGetDevice(&device) != cudaSuccess) {
+      GTEST_SKIP() << "No CUDA detected, skipping all tests";
+    }
+    wave::registerWave();
+    makeInputs();
+  }
+
+  // Probe side keys in [0, 1000) with every tenth key null. Build side keys
+  // are multiples of 3 and every key appears twice.
+  void makeInputs() {
+    for (auto i = 0; i < 10; ++i) {
+      probe_.push_back(makeRowVector(
+          {"t0", "t1"},
+          {makeFlatVector<int64_t>(
+               100,
+               [&](auto row) { return (i * 100 + row) % 1'000; },
+               [](auto row) { return row % 10 == 0; }),
+           makeFlatVector<int32_t>(100, [&](auto row) { return i + row; })}));
+    }
+    build_.push_back(makeRowVector(
+        {"u0", "u1"},
+        {makeFlatVector<int64_t>(1'000, [](auto row) { return row / 2 * 3; }),
+         makeFlatVector<double>(
+             1'000,
+             [](auto row) { return row * 0.5; },
+             [](auto row) { return row % 7 == 0; })}));
+    createDuckDbTable("t", probe_);
+    createDuckDbTable("u", build_);
+  }
+
+  core::PlanNodePtr makePlan(
+      core::JoinType joinType,
+      const std::vector<std::string>& outputLayout) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return PlanBuilder(planNodeIdGenerator)
+        .values(probe_)
+        .hashJoin(
+            {"t0"},
+            {"u0"},
+            PlanBuilder(planNodeIdGenerator).values(build_).planNode(),
+            "",
+            outputLayout,
+            joinType)
+        .planNode();
+  }
+
+  std::vector<RowVectorPtr> probe_;
+  std::vector<RowVectorPtr> build_;
+};
+
+TEST_F(HashJoinTest, inner) {
+  assertQuery(
+      makePlan(core::JoinType::kInner, {"t0", "t1", "u1"}),
+      "SELECT t0, t1, u1 FROM t, u WHERE t0 = u0");
+}
+
+TEST_F(HashJoinTest, left) {
+  assertQuery(
+      makePlan(core::JoinType::kLeft, {"t1", "u0", "u1"}),
+      "SELECT t1, u0, u1 FROM t LEFT JOIN u ON t0 = u0");
+}
+
+TEST_F(HashJoinTest, leftSemiFilter) {
+  assertQuery(
+      makePlan(core::JoinType::kLeftSemiFilter, {"t0", "t1"}),
+      "SELECT t0, t1 FROM t WHERE t0 IN (SELECT u0 FROM u)");
+}
@@ -357,6 +357,17 @@ void CastExpr::applyCastKernel(
         result->set(row, hooks_->castStringToTimestamp(inputRowValue));
         return;
       }
+      if constexpr (
+          FromKind == TypeKind::VARCHAR &&
+          std::is_same_v<TPolicy, util::DefaultCastPolicy> &&
+          (ToKind == TypeKind::TINYINT || ToKind == TypeKind::SMALLINT ||
+           ToKind == TypeKind::INTEGER || ToKind == TypeKind::BIGINT ||
+           ToKind == TypeKind::REAL || ToKind == TypeKind::DOUBLE)) {
+        if (applyFastStringToNumberCast<ToKind>(
+                row, context, inputRowValue, result)) {
+          return;
+        }
+      }
     }
 
     auto output = util::Converter<ToKind, void, TPolicy>::cast(inputRowValue);
@@ -381,6 +392,41 @@ void CastExpr::applyCastKernel(
   }
 }
 
+template <TypeKind ToKind>
+bool CastExpr::applyFastStringToNumberCast(
+    vector_size_t row,
+    EvalCtx& context,
+    const StringView& value,
+    FlatVector<typename TypeTraits<ToKind>::NativeType>* result) {
+  using T = typename TypeTraits<ToKind>::NativeType;
+  constexpr bool kIsFloatingPoint = std::is_floating_point_v<T>;
+  const std::string_view str(value.data(), value.size());
+  std::optional<T> parsed;
+  if constexpr (kIsFloatingPoint) {
+    parsed = util::tryParseFloatingPointFast<T>(str);
+  } else {
+    parsed = util::tryParseIntegerFast<T>(str);
+  }
+  if (parsed.has_value()) {
+    result->set(row, parsed.value());
+    return true;
+  }
+
+  if (setNullInResultAtError()) {
+    if (util::isInvalidNumber<kIsFloatingPoint>(str)) {
+      result->setNull(row, true);
+      return true;
+    }
+    return false;
+  }
+  if (!context.throwOnError() && !context.captureErrorDetails() &&
+      util::isInvalidNumber<kIsFloatingPoint>(str)) {
+    context.setStatus(row, Status::UserError("Invalid number"));
+    return true;
+  }
+  return false;
+}
+
 template <typename TInput, typename TOutput>
 void CastExpr::applyDecimalCastKernel(
     const SelectivityVector& rows,
@@ -500,6 +546,9 @@ void CastExpr::applyVarcharToDecimalCastKernel(
     } else {
       if (setNullInResultAtError()) {
         result->setNull(row, true);
+      } else if (!context.throwOnError() && !context.captureErrorDetails()) {
+        // The error is discarded, so its message need not be made.
+        context.setStatus(row, status);
       } else {
         context.setVeloxExceptionError(
             row, makeBadCastException(toType, input, row, status.message()));
@@ -177,6 +177,18 @@ class CastExpr : public SpecialForm {
       const SimpleVector<typename TypeTraits<FromKind>::NativeType>* input,
       FlatVector<typename TypeTraits<ToKind>::NativeType>* result);
 
+  /// Casts 'value' at 'row' to an integer or floating point ToKind without
+  /// exceptions if it is a plain number. Used with DefaultCastPolicy only.
+  /// Also records the error without exceptions if 'value' can not be a number
+  /// and the error would be discarded, as in TRY_CAST and TRY. Returns false
+  /// if 'value' must be cast the usual way.
+  template <TypeKind ToKind>
+  bool applyFastStringToNumberCast(
+      vector_size_t row,
+      EvalCtx& context,
+      const StringView& value,
+      FlatVector<typename TypeTraits<ToKind>::NativeType>* result);
+
   VectorPtr castFromDate(
       const SelectivityVector& rows,
       const BaseVector& input,
@@ -176,6 +176,15 @@ void ConjunctExpr::evalSpecialForm(
                           ->queryConfig()
                           .adaptiveFilterReorderingEnabled();
     reorderEnabledChecked_ = true;
+    int32_t begin = 0;
+    for (auto i = 0; i <= inputs_.size(); ++i) {
+      if (i == inputs_.size() || !inputs_[i]->isDeterministic()) {
+        if (i - begin > 1) {
+          reorderableRanges_.emplace_back(begin, i);
+        }
+        begin = i + 1;
+      }
+    }
   }
   if (reorderEnabled_) {
     maybeReorderInputs();
@@ -183,23 +192,18 @@ void ConjunctExpr::evalSpecialForm(
 }
 
 void ConjunctExpr::maybeReorderInputs() {
-  bool reorder = false;
-  for (auto i = 1; i < inputs_.size(); ++i) {
-    if (selectivity_[inputOrder_[i - 1]].timeToDropValue() >
-        selectivity_[inputOrder_[i]].timeToDropValue()) {
-      reorder = true;
-      break;
+  auto lessCostly = [this](size_t left, size_t right) {
+    return selectivity_[left].timeToDropValue() <
+        selectivity_[right].timeToDropValue();
+  };
+  for (const auto& [begin, end] : reorderableRanges_) {
+    auto first = inputOrder_.begin() + begin;
+    auto last = inputOrder_.begin() + end;
+    if (!std::is_sorted(first, last, lessCostly)) {
+      std::sort(first, last, lessCostly);
+      ++stats_.numInputReorders;
     }
   }
-  if (reorder) {
-    std::sort(
-        inputOrder_.begin(),
-        inputOrder_.end(),
-        [this](size_t left, size_t right) {
-          return selectivity_[left].timeToDropValue() <
-              selectivity_[right].timeToDropValue();
-        });
-  }
 }
 
 namespace {
@@ -64,6 +64,11 @@ class ConjunctExpr : public SpecialForm {
     return selectivity_[inputOrder_[index]];
   }
 
+  /// Returns the indices of the inputs in the order of evaluation.
+  const std::vector<int32_t>& inputOrder() const {
+    return inputOrder_;
+  }
+
   std::string toSql(
       std::vector<VectorPtr>* complexConstants = nullptr) const override;
 
@@ -99,6 +104,11 @@ class ConjunctExpr : public SpecialForm {
   std::vector<SelectivityInfo> selectivity_;
   std::vector<int32_t> inputOrder_;
 
+  // Ranges [begin, end) of positions in 'inputOrder_' between
+  // non-deterministic inputs. Inputs are reordered only within a range, so
+  // that non-deterministic inputs see the same rows as in plan order.
+  std::vector<std::pair<int32_t, int32_t>> reorderableRanges_;
+
   friend class ConjunctCallToSpecialForm;
 };
 
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/ConstantFoldingCache.h"
+
+#include <map>
+
+#include "velox/common/serialization/BinarySerde.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+ConstantFoldingCache** instancePtr() {
+  static ConstantFoldingCache* cache{nullptr};
+  return &cache;
+}
+
+VectorPtr copyConstant(const VectorPtr& value, memory::MemoryPool* pool) {
+  auto copy = BaseVector::create(value->type(), 1, pool);
+  copy->copy(value.get(), 0, 0, 1);
+  return BaseVector::wrapInConstant(1, 0, copy);
+}
+} // namespace
+
+ConstantFoldingCache::ConstantFoldingCache(
+    std::shared_ptr<memory::MemoryPool> pool,
+    uint64_t maxBytes)
+    : pool_(std::move(pool)), maxBytes_(maxBytes) {
+  VELOX_CHECK_NOT_NULL(pool_);
+}
+
+ConstantFoldingCache::~ConstantFoldingCache() {
+  clear();
+}
+
+// static
+ConstantFoldingCache* ConstantFoldingCache::getInstance() {
+  return *instancePtr();
+}
+
+// static
+void ConstantFoldingCache::setInstance(ConstantFoldingCache* cache) {
+  *instancePtr() = cache;
+}
+
+// static
+std::string ConstantFoldingCache::configKey(const core::QueryConfig& config) {
+  // Any property may be read by a function or cast, so all are in the key.
+  const std::map<std::string, std::string> sorted(
+      config.values().begin(), config.values().end());
+  std::string key;
+  for (const auto& [name, value] : sorted) {
+    key += name;
+    key += '=';
+    key += value;
+    key += '\n';
+  }
+  return key;
+}
+
+// static
+std::optional<std::string> ConstantFoldingCache::makeKey(
+    const std::string& configKey,
+    const core::ITypedExpr& expr) {
+  try {
+    return configKey + serializeBinary(expr.serialize());
+  } catch (const VeloxException&) {
+    return std::nullopt;
+  }
+}
+
+VectorPtr ConstantFoldingCache::find(
+    const std::string& key,
+    memory::MemoryPool* pool) {
+  VectorPtr value;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    ++numLookups_;
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      return nullptr;
+    }
+    ++numHits_;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    value = it->second->value;
+  }
+  // The value is immutable, so it can be copied outside of the lock.
+  return copyConstant(value, pool);
+}
+
+void ConstantFoldingCache::insert(
+    const std::string& key,
+    const VectorPtr& value) {
+  VELOX_CHECK_EQ(value->size(), 1);
+  auto copy = copyConstant(value, pool_.get());
+  const auto bytes = key.size() + copy->retainedSize();
+  if (bytes > maxBytes_) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (entries_.count(key) > 0) {
+    return;
+  }
+  lru_.push_front(Entry{key, std::move(copy), bytes});
+  entries_.emplace(lru_.front().key, lru_.begin());
+  numBytes_ += bytes;
+  evictLocked();
+}
+
+void ConstantFoldingCache::evictLocked() {
+  while (numBytes_ > maxBytes_) {
+    auto& entry = lru_.back();
+    entries_.erase(entry.key);
+    numBytes_ -= entry.bytes;
+    ++numEvictions_;
+    lru_.pop_back();
+  }
+}
+
+void ConstantFoldingCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  numBytes_ = 0;
+}
+
+ConstantFoldingCache::Stats ConstantFoldingCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return Stats{
+      numLookups_, numHits_, numEvictions_, entries_.size(), numBytes_};
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <list>
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/core/ITypedExpr.h"
+#include "velox/core/QueryConfig.h"
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox::exec {
+
+/// Process-wide cache of the results of constant folding during expression
+/// compilation. Many tasks compile the same expressions, e.g. filters with
+/// big IN-lists or casts of literals, and fold the same constant subtrees.
+/// With a cache set by setInstance(), ExprSet folds a subtree that does not
+/// depend on the input once per process and config and reuses the value
+/// instead of compiling and evaluating the subtree again.
+///
+/// A value is keyed by its subtree and by the query config properties, see
+/// configKey(). Calls of time dependent functions, e.g. current_date(), are
+/// not cached. Values are copied into 'pool' on insertion and into the pool of
+/// the ExprSet on lookup, so that they do not outlive the pools of queries.
+/// Entries are evicted in LRU order to stay under 'maxBytes'. Thread-safe.
+class ConstantFoldingCache {
+ public:
+  struct Stats {
+    uint64_t numLookups{0};
+    uint64_t numHits{0};
+    uint64_t numEvictions{0};
+    uint64_t numEntries{0};
+    uint64_t numBytes{0};
+  };
+
+  ConstantFoldingCache(
+      std::shared_ptr<memory::MemoryPool> pool,
+      uint64_t maxBytes);
+
+  ~ConstantFoldingCache();
+
+  /// Returns the cache used by expression compilation, nullptr if none.
+  static ConstantFoldingCache* getInstance();
+
+  /// Sets the cache used by expression compilation. The caller keeps
+  /// ownership. nullptr disables caching.
+  static void setInstance(ConstantFoldingCache* cache);
+
+  /// Returns the part of the key that depends on 'config'. Includes all the
+  /// properties set in 'config'.
+  static std::string configKey(const core::QueryConfig& config);
+
+  /// Returns the key for the value of 'expr' under a config with
+  /// 'configKey', or std::nullopt if 'expr' can not be keyed.
+  static std::optional<std::string> makeKey(
+      const std::string& configKey,
+      const core::ITypedExpr& expr);
+
+  /// Returns a copy in 'pool' of the value for 'key', nullptr if not found.
+  VectorPtr find(const std::string& key, memory::MemoryPool* pool);
+
+  /// Adds 'value', a constant vector of size 1, for 'key'.
+  void insert(const std::string& key, const VectorPtr& value);
+
+  void clear();
+
+  Stats stats() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    VectorPtr value;
+    uint64_t bytes;
+  };
+
+  // Removes least recently used entries until 'numBytes_' is at most
+  // 'maxBytes_'.
+  void evictLocked();
+
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  const uint64_t maxBytes_;
+
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> lru_;
+  folly::F14FastMap<std::string_view, std::list<Entry>::iterator> entries_;
+  uint64_t numBytes_{0};
+  uint64_t numLookups_{0};
+  uint64_t numHits_{0};
+  uint64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox::exec
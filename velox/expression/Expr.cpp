@@ -344,7 +344,7 @@ void mergeOrThrowArgumentErrors(
 }
 
 // Returns true if vector is a LazyVector that hasn't been loaded yet or
-// is not dictionary or constant encoded.
+// is not dictionary, sequence or constant encoded.
 bool isFlat(const BaseVector& vector) {
   auto encoding = vector.encoding();
   if (encoding == VectorEncoding::Simple::LAZY) {
@@ -356,6 +356,7 @@ bool isFlat(const BaseVector& vector) {
   }
   return !(
       encoding == VectorEncoding::Simple::DICTIONARY ||
+      encoding == VectorEncoding::Simple::SEQUENCE ||
       encoding == VectorEncoding::Simple::CONSTANT);
 }
 
@@ -1025,6 +1026,7 @@ Expr::PeelEncodingsResult Expr::peelEncodings(
         *context.finalSelection(), finalRowsHolder);
   }
   auto newRows = peeledEncoding->translateToInnerRows(rows, newRowsHolder);
+  ++stats_.numPeeledVectors;
 
   // Save context and set the peel, peeled fields and final selection (if
   // applicable).
@@ -1229,6 +1231,7 @@ void Expr::evalWithMemo(
     VELOX_DCHECK(cached != nullptr);
     cached->intersect(*cachedDictionaryIndices_);
     if (cached->hasSelections()) {
+      ++stats_.numDictionaryCacheHits;
       context.ensureWritable(rows, type(), result);
       result->copy(dictionaryCache_.get(), *cached, nullptr);
     }
@@ -1366,6 +1369,7 @@ inline bool isPeelable(VectorEncoding::Simple encoding) {
   switch (encoding) {
     case VectorEncoding::Simple::CONSTANT:
     case VectorEncoding::Simple::DICTIONARY:
+    case VectorEncoding::Simple::SEQUENCE:
       return true;
     default:
       return false;
@@ -1987,6 +1991,65 @@ std::string printExprWithStats(const exec::ExprSet& exprSet) {
   return out.str();
 }
 
+namespace {
+// Appends the folded stacks of 'expr' and its inputs under 'stack' to
+// 'stacks'. Returns the CPU time of 'expr' including its inputs. Common
+// sub-expressions are counted under their first parent only.
+uint64_t addFoldedStacks(
+    const exec::Expr& expr,
+    const std::string& stack,
+    std::unordered_set<const exec::Expr*>& uniqueExprs,
+    std::vector<std::pair<std::string, uint64_t>>& stacks) {
+  if (!uniqueExprs.insert(&expr).second) {
+    return 0;
+  }
+
+  auto frame = expr.toString(false);
+  std::replace(frame.begin(), frame.end(), ';', ',');
+  const auto path = stack.empty() ? frame : fmt::format("{};{}", stack, frame);
+
+  uint64_t inputNanos = 0;
+  for (const auto& input : expr.inputs()) {
+    inputNanos += addFoldedStacks(*input, path, uniqueExprs, stacks);
+  }
+
+  // Special forms evaluate their inputs while timed, functions after the
+  // inputs have been evaluated.
+  const auto nanos = expr.stats().timing.cpuNanos;
+  const auto totalNanos =
+      expr.isSpecialForm() ? std::max(nanos, inputNanos) : nanos + inputNanos;
+  if (totalNanos > inputNanos) {
+    stacks.emplace_back(path, totalNanos - inputNanos);
+  }
+  return totalNanos;
+}
+} // namespace
+
+std::vector<std::pair<std::string, uint64_t>> exprStatsToFoldedStacks(
+    const exec::ExprSet& exprSet,
+    const std::vector<std::string>& rootNames) {
+  const auto& exprs = exprSet.exprs();
+  VELOX_CHECK(rootNames.empty() || rootNames.size() == exprs.size());
+  std::unordered_set<const exec::Expr*> uniqueExprs;
+  std::vector<std::pair<std::string, uint64_t>> stacks;
+  for (auto i = 0; i < exprs.size(); ++i) {
+    addFoldedStacks(
+        *exprs[i],
+        rootNames.empty() ? "" : rootNames[i],
+        uniqueExprs,
+        stacks);
+  }
+  return stacks;
+}
+
+std::string printExprStatsAsFoldedStacks(const exec::ExprSet& exprSet) {
+  std::stringstream out;
+  for (const auto& [stack, nanos] : exprStatsToFoldedStacks(exprSet)) {
+    out << stack << " " << nanos << std::endl;
+  }
+  return out.str();
+}
+
 void SimpleExpressionEvaluator::evaluate(
     exec::ExprSet* exprSet,
     const SelectivityVector& rows,
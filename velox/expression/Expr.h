@@ -59,18 +59,39 @@ struct ExprStats {
   /// size.
   uint64_t numProcessedVectors{0};
 
+  /// Number of times AND/OR changed the order of evaluating its inputs based
+  /// on their measured selectivity and cost. Requires
+  /// QueryConfig.adaptiveFilterReorderingEnabled() to be 'true'.
+  uint64_t numInputReorders{0};
+
+  /// Number of vectors evaluated on the base vectors of dictionary or constant
+  /// encoded inputs after peeling off the encodings.
+  uint64_t numPeeledVectors{0};
+
+  /// Number of vectors for which some rows were copied from the results
+  /// memoized for a repeating dictionary base instead of being evaluated.
+  uint64_t numDictionaryCacheHits{0};
+
   void add(const ExprStats& other) {
     timing.add(other.timing);
     numProcessedRows += other.numProcessedRows;
     numProcessedVectors += other.numProcessedVectors;
+    numInputReorders += other.numInputReorders;
+    numPeeledVectors += other.numPeeledVectors;
+    numDictionaryCacheHits += other.numDictionaryCacheHits;
   }
 
   std::string toString() const {
     return fmt::format(
-        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}",
+        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, "
+        "numInputReorders: {}, numPeeledVectors: {}, "
+        "numDictionaryCacheHits: {}",
         timing.toString(),
         numProcessedRows,
-        numProcessedVectors);
+        numProcessedVectors,
+        numInputReorders,
+        numPeeledVectors,
+        numDictionaryCacheHits);
   }
 };
 
@@ -795,6 +816,21 @@ std::unique_ptr<ExprSet> makeExprSetFromFlag(
 /// zeros.
 std::string printExprWithStats(const ExprSet& exprSet);
 
+/// Returns the CPU time spent in each node of the expression trees in
+/// 'exprSet' as folded stacks, the input format of flame graph tools. Each
+/// entry has the names of a node and its ancestors separated by ';' and the CPU
+/// nanoseconds spent in the node itself, excluding the time spent evaluating
+/// its inputs. The root of the i-th expression is prefixed with 'rootNames[i]'
+/// if given. Nodes without CPU time are left out. Requires
+/// QueryConfig.exprTrackCpuUsage() to be 'true'.
+std::vector<std::pair<std::string, uint64_t>> exprStatsToFoldedStacks(
+    const ExprSet& exprSet,
+    const std::vector<std::string>& rootNames = {});
+
+/// Returns the entries of exprStatsToFoldedStacks() as text with one
+/// '<stack> <nanos>' line per entry.
+std::string printExprStatsAsFoldedStacks(const ExprSet& exprSet);
+
 struct ExprSetCompletionEvent {
   /// Aggregated runtime stats keyed on expression name (e.g. built-in
   /// expression like and, or, switch or a function name).
@@ -15,12 +15,17 @@
  */
 
 #include "velox/expression/ExprCompiler.h"
+
+#include <folly/container/F14Set.h>
+
 #include "velox/expression/CastExpr.h"
 #include "velox/expression/CoalesceExpr.h"
 #include "velox/expression/ConjunctExpr.h"
 #include "velox/expression/ConstantExpr.h"
+#include "velox/expression/ConstantFoldingCache.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedArithmeticExpr.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/RowConstructor.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
@@ -85,6 +90,14 @@ struct Scope {
 
   std::vector<TypedExprPtr> rewrittenExpressions;
 
+  // Set for a top level Scope if constant folding results are cached across
+  // ExprSets.
+  ConstantFoldingCache* foldingCache{nullptr};
+  // Config dependent part of the keys of 'foldingCache'.
+  std::string foldingConfigKey;
+  // Subtrees whose folded values are looked up in and added to 'foldingCache'.
+  folly::F14FastSet<const ITypedExpr*> foldingCandidates;
+
   Scope(std::vector<std::string>&& _locals, Scope* _parent, ExprSet* _exprSet)
       : locals(_locals), parent(_parent), exprSet(_exprSet) {}
 
@@ -356,6 +369,112 @@ core::TypedExprPtr rewriteExpression(const core::TypedExprPtr& expr) {
   return expr;
 }
 
+// Adds the calls of the fusable tree rooted at 'expr' to 'nodes' and its
+// leaves to 'leaves'. Returns the operand that refers to 'expr' or
+// std::nullopt if the tree can not be fused. The leaves are fields and
+// constants of 'valueType'. Other subtrees are not fused, so that errors and
+// nulls they produce are handled as usual.
+std::optional<FusedArithmeticExpr::Operand> collectFusedNodes(
+    const TypedExprPtr& expr,
+    const TypePtr& valueType,
+    bool isRoot,
+    std::vector<FusedArithmeticExpr::Node>& nodes,
+    std::vector<TypedExprPtr>& leaves) {
+  if (auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
+    const auto op = getFusableFunction(call->name());
+    if (!op.has_value() || call->inputs().size() != 2) {
+      return std::nullopt;
+    }
+    if (isFusedComparison(op.value())) {
+      if (!isRoot || !expr->type()->isBoolean()) {
+        return std::nullopt;
+      }
+    } else if (*expr->type() != *valueType) {
+      return std::nullopt;
+    }
+    auto left =
+        collectFusedNodes(call->inputs()[0], valueType, false, nodes, leaves);
+    if (!left.has_value()) {
+      return std::nullopt;
+    }
+    auto right =
+        collectFusedNodes(call->inputs()[1], valueType, false, nodes, leaves);
+    if (!right.has_value()) {
+      return std::nullopt;
+    }
+    nodes.push_back({op.value(), call->name(), left.value(), right.value()});
+    return FusedArithmeticExpr::Operand{
+        false, static_cast<int32_t>(nodes.size() - 1)};
+  }
+  if (*expr->type() != *valueType ||
+      !(dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get()) ||
+        dynamic_cast<const core::DereferenceTypedExpr*>(expr.get()) ||
+        dynamic_cast<const core::ConstantTypedExpr*>(expr.get()))) {
+    return std::nullopt;
+  }
+  for (auto i = 0; i < leaves.size(); ++i) {
+    if (*leaves[i] == *expr) {
+      return FusedArithmeticExpr::Operand{true, i};
+    }
+  }
+  leaves.push_back(expr);
+  return FusedArithmeticExpr::Operand{
+      true, static_cast<int32_t>(leaves.size() - 1)};
+}
+
+// Returns a FusedArithmeticExpr for 'expr' if it is a tree of at least two
+// fusable calls on DOUBLE or REAL values, or nullptr.
+ExprPtr tryCompileFused(
+    const TypedExprPtr& expr,
+    Scope* scope,
+    const core::QueryConfig& config,
+    memory::MemoryPool* pool,
+    const std::unordered_set<std::string>& flatteningCandidates,
+    bool enableConstantFolding) {
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->inputs().size() != 2) {
+    return nullptr;
+  }
+  const auto op = getFusableFunction(call->name());
+  if (!op.has_value()) {
+    return nullptr;
+  }
+  const auto& valueType = isFusedComparison(op.value())
+      ? call->inputs()[0]->type()
+      : expr->type();
+  if (*valueType != *DOUBLE() && *valueType != *REAL()) {
+    return nullptr;
+  }
+  std::vector<FusedArithmeticExpr::Node> nodes;
+  std::vector<TypedExprPtr> leaves;
+  if (!collectFusedNodes(expr, valueType, true, nodes, leaves).has_value() ||
+      nodes.size() < 2) {
+    return nullptr;
+  }
+  // Leave trees of constants to constant folding.
+  if (std::all_of(leaves.begin(), leaves.end(), [](const auto& leaf) {
+        return dynamic_cast<const core::ConstantTypedExpr*>(leaf.get());
+      })) {
+    return nullptr;
+  }
+  std::vector<ExprPtr> inputs;
+  inputs.reserve(leaves.size());
+  for (const auto& leaf : leaves) {
+    inputs.push_back(compileExpression(
+        leaf,
+        scope,
+        config,
+        pool,
+        flatteningCandidates,
+        enableConstantFolding));
+  }
+  return std::make_shared<FusedArithmeticExpr>(
+      expr->type(),
+      std::move(inputs),
+      std::move(nodes),
+      config.exprTrackCpuUsage());
+}
+
 ExprPtr compileRewrittenExpression(
     const TypedExprPtr& expr,
     Scope* scope,
@@ -376,6 +495,20 @@ ExprPtr compileRewrittenExpression(
     return alreadyCompiled;
   }
 
+  if (config.exprFusionEnabled()) {
+    if (auto fused = tryCompileFused(
+            expr,
+            scope,
+            config,
+            pool,
+            flatteningCandidates,
+            enableConstantFolding)) {
+      fused->computeMetadata();
+      scope->visited[expr.get()] = fused;
+      return fused;
+    }
+  }
+
   const bool trackCpuUsage = config.exprTrackCpuUsage();
 
   ExprPtr result;
@@ -525,17 +658,92 @@ ExprPtr compileExpression(
     memory::MemoryPool* pool,
     const std::unordered_set<std::string>& flatteningCandidates,
     bool enableConstantFolding) {
+  std::optional<std::string> foldingKey;
+  if (scope->foldingCache != nullptr &&
+      scope->foldingCandidates.count(expr.get()) > 0) {
+    foldingKey = ConstantFoldingCache::makeKey(scope->foldingConfigKey, *expr);
+    if (foldingKey.has_value()) {
+      if (auto value = scope->foldingCache->find(foldingKey.value(), pool)) {
+        auto folded = std::make_shared<ConstantExpr>(std::move(value));
+        folded->computeMetadata();
+        scope->visited[expr.get()] = folded;
+        return folded;
+      }
+    }
+  }
+
   auto rewritten = rewriteExpression(expr);
   if (rewritten.get() != expr.get()) {
     scope->rewrittenExpressions.push_back(rewritten);
   }
-  return compileRewrittenExpression(
+  auto result = compileRewrittenExpression(
       rewritten == nullptr ? expr : rewritten,
       scope,
       config,
       pool,
       flatteningCandidates,
       enableConstantFolding);
+
+  if (foldingKey.has_value()) {
+    if (auto constant = std::dynamic_pointer_cast<ConstantExpr>(result)) {
+      scope->foldingCache->insert(foldingKey.value(), constant->value());
+    }
+  }
+  return result;
+}
+
+// Returns true if the function 'name' is time dependent, e.g. current_date().
+bool isTimeDependentFunction(const std::string& name) {
+  for (const auto& entry :
+       simpleFunctions().getFunctionSignaturesAndMetadata(name)) {
+    if (entry.first.timeDependent) {
+      return true;
+    }
+  }
+  return vectorFunctionFactories().withRLock([&](auto& functionMap) {
+    auto it = functionMap.find(name);
+    return it != functionMap.end() && it->second.metadata.timeDependent;
+  });
+}
+
+// Adds the largest subtrees of 'expr' that do not depend on the input and are
+// not constants to 'candidates'. Returns true if 'expr' does not depend on the
+// input. Lambdas are treated as depending on the input. So are calls of time
+// dependent functions, whose values must not be shared between queries.
+bool collectFoldingCandidates(
+    const TypedExprPtr& expr,
+    folly::F14FastSet<const ITypedExpr*>& candidates) {
+  if (auto access =
+          dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get())) {
+    if (access->isInputColumn()) {
+      return false;
+    }
+  } else if (
+      dynamic_cast<const core::LambdaTypedExpr*>(expr.get()) ||
+      dynamic_cast<const core::InputTypedExpr*>(expr.get())) {
+    return false;
+  }
+
+  std::vector<const ITypedExpr*> constantInputs;
+  bool isConstant = true;
+  if (auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
+    isConstant = !isTimeDependentFunction(call->name());
+  }
+  for (const auto& input : expr->inputs()) {
+    if (collectFoldingCandidates(input, candidates)) {
+      constantInputs.push_back(input.get());
+    } else {
+      isConstant = false;
+    }
+  }
+  if (!isConstant) {
+    for (const auto* input : constantInputs) {
+      if (!dynamic_cast<const core::ConstantTypedExpr*>(input)) {
+        candidates.insert(input);
+      }
+    }
+  }
+  return isConstant;
 }
 
 /// Walk expression tree and collect names of functions used in CallTypedExpr
@@ -585,11 +793,38 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
   std::vector<std::shared_ptr<Expr>> exprs;
   exprs.reserve(sources.size());
 
+  // The rewritten expressions must outlive the compilation since 'scope' refers
+  // to them.
+  std::vector<TypedExprPtr> rewrittenSources;
+  const auto* current = &sources;
+  for (auto& rewrite : expressionSetRewrites()) {
+    auto rewritten = rewrite(*current);
+    if (!rewritten.empty()) {
+      VELOX_CHECK_EQ(rewritten.size(), sources.size());
+      rewrittenSources = std::move(rewritten);
+      current = &rewrittenSources;
+    }
+  }
+
   // Precompute a set of function calls that support flattening. This allows to
   // lock function registry once vs. locking for each function call.
-  auto flatteningCandidates = collectFlatteningCandidates(sources);
+  auto flatteningCandidates = collectFlatteningCandidates(*current);
+
+  if (enableConstantFolding) {
+    scope.foldingCache = ConstantFoldingCache::getInstance();
+  }
+  if (scope.foldingCache != nullptr) {
+    scope.foldingConfigKey = ConstantFoldingCache::configKey(
+        execCtx->queryCtx()->queryConfig());
+    for (auto& source : *current) {
+      if (collectFoldingCandidates(source, scope.foldingCandidates) &&
+          !dynamic_cast<const core::ConstantTypedExpr*>(source.get())) {
+        scope.foldingCandidates.insert(source.get());
+      }
+    }
+  }
 
-  for (auto& source : sources) {
+  for (auto& source : *current) {
     exprs.push_back(compileExpression(
         source,
         &scope,
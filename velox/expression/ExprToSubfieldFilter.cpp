@@ -341,12 +341,20 @@ std::unique_ptr<common::Filter> makeNotEqualFilter(
   }
 }
 
+// Returns the non-null values. Sets 'hasNull' if there are nulls.
 template <typename T>
-std::vector<int64_t>
-toInt64List(const VectorPtr& vector, vector_size_t start, vector_size_t size) {
+std::vector<int64_t> toInt64List(
+    const VectorPtr& vector,
+    vector_size_t start,
+    vector_size_t size,
+    bool& hasNull) {
   auto ints = vector->as<SimpleVector<T>>();
   std::vector<int64_t> values;
   for (auto i = 0; i < size; i++) {
+    if (ints->isNullAt(start + i)) {
+      hasNull = true;
+      continue;
+    }
     values.push_back(ints->valueAt(start + i));
   }
   return values;
@@ -367,40 +375,279 @@ std::unique_ptr<common::Filter> makeInFilter(
   auto size = arrayVector->sizeAt(index);
   auto elements = arrayVector->elements();
 
-  auto elementType = arrayVector->type()->asArray().elementType();
-  switch (elementType->kind()) {
-    case TypeKind::TINYINT: {
-      auto values = toInt64List<int8_t>(elements, offset, size);
-      return negated ? notIn(values) : in(values);
-    }
-    case TypeKind::SMALLINT: {
-      auto values = toInt64List<int16_t>(elements, offset, size);
-      return negated ? notIn(values) : in(values);
+  // A null in the list makes NOT IN null for all values and IN null for the
+  // values not in the list. Neither passes a filter.
+  bool hasNull = false;
+  auto makeFilter = [&](const auto& values) -> std::unique_ptr<common::Filter> {
+    if ((negated && hasNull) || (!negated && values.empty())) {
+      return std::make_unique<common::AlwaysFalse>();
     }
-    case TypeKind::INTEGER: {
-      auto values = toInt64List<int32_t>(elements, offset, size);
-      return negated ? notIn(values) : in(values);
+    if (values.empty()) {
+      return isNotNull();
     }
-    case TypeKind::BIGINT: {
-      auto values = toInt64List<int64_t>(elements, offset, size);
-      return negated ? notIn(values) : in(values);
+    if (negated) {
+      return notIn(values);
     }
+    return in(values);
+  };
+  auto elementType = arrayVector->type()->asArray().elementType();
+  switch (elementType->kind()) {
+    case TypeKind::TINYINT:
+      return makeFilter(toInt64List<int8_t>(elements, offset, size, hasNull));
+    case TypeKind::SMALLINT:
+      return makeFilter(toInt64List<int16_t>(elements, offset, size, hasNull));
+    case TypeKind::INTEGER:
+      return makeFilter(toInt64List<int32_t>(elements, offset, size, hasNull));
+    case TypeKind::BIGINT:
+      return makeFilter(toInt64List<int64_t>(elements, offset, size, hasNull));
     case TypeKind::VARCHAR: {
       auto stringElements = elements->as<SimpleVector<StringView>>();
       std::vector<std::string> values;
       for (auto i = 0; i < size; i++) {
+        if (stringElements->isNullAt(offset + i)) {
+          hasNull = true;
+          continue;
+        }
         values.push_back(stringElements->valueAt(offset + i).str());
       }
-      if (negated) {
-        return notIn(values);
-      }
-      return in(values);
+      return makeFilter(values);
     }
     default:
       return nullptr;
   }
 }
 
+// Returns the smallest string greater than all strings starting with
+// 'prefix', or std::nullopt if there is none, i.e. 'prefix' only has 0xff
+// bytes.
+std::optional<std::string> prefixUpperBound(std::string prefix) {
+  while (!prefix.empty()) {
+    auto& last = reinterpret_cast<unsigned char&>(prefix.back());
+    if (last != 0xff) {
+      ++last;
+      return prefix;
+    }
+    prefix.pop_back();
+  }
+  return std::nullopt;
+}
+
+// Converts LIKE with a constant pattern without wildcards or with only
+// trailing '%' wildcards to an equality or a range of the prefix.
+std::unique_ptr<common::Filter> makeLikeFilter(
+    const core::TypedExprPtr& patternExpr,
+    core::ExpressionEvaluator* evaluator,
+    bool negated) {
+  auto pattern = toConstant(patternExpr, evaluator);
+  if (!pattern || pattern->typeKind() != TypeKind::VARCHAR ||
+      pattern->isNullAt(0)) {
+    return nullptr;
+  }
+  const auto value = singleValue<StringView>(pattern).str();
+  auto prefixEnd = value.find_first_of("%_");
+  if (prefixEnd == std::string::npos) {
+    if (negated) {
+      return notIn(std::vector<std::string>{value});
+    }
+    return equal(value);
+  }
+  if (value.find_first_not_of('%', prefixEnd) != std::string::npos) {
+    return nullptr;
+  }
+  const auto prefix = value.substr(0, prefixEnd);
+  if (prefix.empty()) {
+    return negated ? nullptr : isNotNull();
+  }
+  const auto upper = prefixUpperBound(prefix);
+  if (!upper.has_value()) {
+    return negated ? lessThan(prefix) : greaterThanOrEqual(prefix);
+  }
+  if (negated) {
+    return std::make_unique<common::NegatedBytesRange>(
+        prefix, false, false, upper.value(), false, true, false);
+  }
+  return std::make_unique<common::BytesRange>(
+      prefix, false, false, upper.value(), false, true, false);
+}
+
+// Appends one single-value range per value to 'ranges'.
+void appendBigintValues(
+    const std::vector<int64_t>& values,
+    std::vector<std::unique_ptr<common::BigintRange>>& ranges) {
+  for (auto value : values) {
+    ranges.push_back(
+        std::make_unique<common::BigintRange>(value, value, false));
+  }
+}
+
+// Appends the ranges of 'filter' to 'ranges' if it is a BigintRange,
+// BigintMultiRange or an IN-list of integers. Returns false otherwise.
+bool appendBigintRanges(
+    const common::Filter& filter,
+    std::vector<std::unique_ptr<common::BigintRange>>& ranges) {
+  if (auto* range = dynamic_cast<const common::BigintRange*>(&filter)) {
+    ranges.push_back(asUniquePtr<common::BigintRange>(range->clone()));
+    return true;
+  }
+  if (auto* multi = dynamic_cast<const common::BigintMultiRange*>(&filter)) {
+    for (const auto& range : multi->ranges()) {
+      ranges.push_back(asUniquePtr<common::BigintRange>(range->clone()));
+    }
+    return true;
+  }
+  if (auto* values =
+          dynamic_cast<const common::BigintValuesUsingHashTable*>(&filter)) {
+    appendBigintValues(values->values(), ranges);
+    return true;
+  }
+  if (auto* values =
+          dynamic_cast<const common::BigintValuesUsingBitmask*>(&filter)) {
+    appendBigintValues(values->values(), ranges);
+    return true;
+  }
+  return false;
+}
+
+// Returns true if MultiRange can evaluate 'filter' as one of its
+// disjuncts. MultiRange does not implement testInt64() and testBool(), so
+// filters on integers and booleans are not in this list.
+bool isMultiRangeDisjunct(const common::Filter& filter) {
+  switch (filter.kind()) {
+    case common::FilterKind::kDoubleRange:
+    case common::FilterKind::kFloatRange:
+    case common::FilterKind::kBytesRange:
+    case common::FilterKind::kNegatedBytesRange:
+    case common::FilterKind::kBytesValues:
+    case common::FilterKind::kNegatedBytesValues:
+    case common::FilterKind::kTimestampRange:
+    case common::FilterKind::kMultiRange:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns a filter that passes the values that pass 'a' or 'b'. Unlike
+// makeOrFilter(), the ranges may overlap and may allow nulls.
+std::unique_ptr<common::Filter> makeDisjunction(
+    std::unique_ptr<common::Filter> a,
+    std::unique_ptr<common::Filter> b) {
+  const bool nullAllowed = a->testNull() || b->testNull();
+  if (a->kind() == common::FilterKind::kIsNull) {
+    return b->clone(true);
+  }
+  if (b->kind() == common::FilterKind::kIsNull) {
+    return a->clone(true);
+  }
+  if (a->kind() == common::FilterKind::kIsNotNull ||
+      b->kind() == common::FilterKind::kIsNotNull) {
+    return nullptr;
+  }
+  std::vector<std::unique_ptr<common::BigintRange>> ranges;
+  if (appendBigintRanges(*a, ranges) && appendBigintRanges(*b, ranges)) {
+    std::sort(ranges.begin(), ranges.end(), [](const auto& x, const auto& y) {
+      return x->lower() < y->lower();
+    });
+    // Merges overlapping and adjacent ranges.
+    std::vector<std::unique_ptr<common::BigintRange>> merged;
+    for (auto& range : ranges) {
+      if (!merged.empty() &&
+          (merged.back()->upper() == std::numeric_limits<int64_t>::max() ||
+           range->lower() <= merged.back()->upper() + 1)) {
+        if (range->upper() > merged.back()->upper()) {
+          merged.back() = std::make_unique<common::BigintRange>(
+              merged.back()->lower(), range->upper(), false);
+        }
+        continue;
+      }
+      merged.push_back(std::move(range));
+    }
+    if (merged.size() == 1) {
+      return std::make_unique<common::BigintRange>(
+          merged[0]->lower(), merged[0]->upper(), nullAllowed);
+    }
+    return std::make_unique<common::BigintMultiRange>(
+        std::move(merged), nullAllowed);
+  }
+  if (a->kind() == common::FilterKind::kBoolValue &&
+      b->kind() == common::FilterKind::kBoolValue) {
+    const bool value = a->testBool(true);
+    if (value == b->testBool(true)) {
+      return boolEqual(value, nullAllowed);
+    }
+    // 'b = true OR b = false' passes all values that are not null.
+    return nullAllowed ? nullptr : isNotNull();
+  }
+  if (!isMultiRangeDisjunct(*a) || !isMultiRangeDisjunct(*b)) {
+    return nullptr;
+  }
+  bool nanAllowed = false;
+  if (a->kind() == common::FilterKind::kDoubleRange &&
+      b->kind() == common::FilterKind::kDoubleRange) {
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    nanAllowed = a->testDouble(nan) || b->testDouble(nan);
+  } else if (
+      a->kind() == common::FilterKind::kFloatRange &&
+      b->kind() == common::FilterKind::kFloatRange) {
+    const auto nan = std::numeric_limits<float>::quiet_NaN();
+    nanAllowed = a->testFloat(nan) || b->testFloat(nan);
+  }
+  return orFilter(std::move(a), std::move(b), nullAllowed, nanAllowed);
+}
+
+// Converts 'expr' to a filter on 'subfield' like leafCallToSubfieldFilter()
+// after removing NOTs around it.
+std::unique_ptr<common::Filter> toLeafFilter(
+    const core::TypedExprPtr& expr,
+    common::Subfield& subfield,
+    core::ExpressionEvaluator* evaluator,
+    bool negated) {
+  const auto* call = asCall(expr.get());
+  if (call == nullptr) {
+    return nullptr;
+  }
+  if (call->name() == "not" && call->inputs().size() == 1) {
+    return toLeafFilter(call->inputs()[0], subfield, evaluator, !negated);
+  }
+  return leafCallToSubfieldFilter(*call, subfield, evaluator, negated);
+}
+
+// Converts OR, or NOT of AND, of filters on the same subfield to one filter.
+std::unique_ptr<common::Filter> makeDisjunctionFilter(
+    const core::CallTypedExpr& call,
+    common::Subfield& subfield,
+    core::ExpressionEvaluator* evaluator,
+    bool negated) {
+  if (call.inputs().size() != 2) {
+    return nullptr;
+  }
+  common::Subfield rightSubfield;
+  auto left = toLeafFilter(call.inputs()[0], subfield, evaluator, negated);
+  if (!left) {
+    return nullptr;
+  }
+  auto right =
+      toLeafFilter(call.inputs()[1], rightSubfield, evaluator, negated);
+  if (!right || !(subfield == rightSubfield)) {
+    return nullptr;
+  }
+  return makeDisjunction(std::move(left), std::move(right));
+}
+
+// Returns the date of a constant DATE expression, or std::nullopt.
+std::optional<int32_t> constantDate(
+    const core::TypedExprPtr& expr,
+    core::ExpressionEvaluator* evaluator) {
+  if (!expr->type()->isDate()) {
+    return std::nullopt;
+  }
+  auto vector = toConstant(expr, evaluator);
+  if (!vector || vector->isNullAt(0)) {
+    return std::nullopt;
+  }
+  return singleValue<int32_t>(vector);
+}
+
 std::unique_ptr<common::Filter> makeBetweenFilter(
     const core::TypedExprPtr& lowerExpr,
     const core::TypedExprPtr& upperExpr,
@@ -513,10 +760,89 @@ std::unique_ptr<common::Filter> leafCallToSubfieldFilter(
       }
       return isNull();
     }
+  } else if (call.name() == "like") {
+    if (call.inputs().size() == 2 &&
+        leftSide->type()->kind() == TypeKind::VARCHAR &&
+        toSubfield(leftSide, subfield)) {
+      return makeLikeFilter(call.inputs()[1], evaluator, negated);
+    }
+  } else if (
+      (call.name() == "or" && !negated) || (call.name() == "and" && negated)) {
+    return makeDisjunctionFilter(call, subfield, evaluator, negated);
   }
   return nullptr;
 }
 
+std::unique_ptr<common::Filter> leafCallToImpliedSubfieldFilter(
+    const core::CallTypedExpr& call,
+    common::Subfield& subfield,
+    core::ExpressionEvaluator* evaluator,
+    bool negated) {
+  if (call.inputs().size() < 2) {
+    return nullptr;
+  }
+  const auto* cast =
+      dynamic_cast<const core::CastTypedExpr*>(call.inputs()[0].get());
+  if (cast == nullptr || !cast->type()->isDate() ||
+      cast->inputs().size() != 1 ||
+      cast->inputs()[0]->type()->kind() != TypeKind::TIMESTAMP) {
+    return nullptr;
+  }
+  // The first and last dates of cast(timestamp AS date) for passing rows.
+  std::optional<int32_t> first;
+  std::optional<int32_t> last;
+  auto name = call.name();
+  if (negated) {
+    if (name == "lt") {
+      name = "gte";
+    } else if (name == "lte") {
+      name = "gt";
+    } else if (name == "gt") {
+      name = "lte";
+    } else if (name == "gte") {
+      name = "lt";
+    } else {
+      return nullptr;
+    }
+  }
+  const auto value = constantDate(call.inputs()[1], evaluator);
+  if (!value.has_value()) {
+    return nullptr;
+  }
+  if (name == "eq") {
+    first = last = value;
+  } else if (name == "lt") {
+    last = value.value() - 1;
+  } else if (name == "lte") {
+    last = value;
+  } else if (name == "gt") {
+    first = value.value() + 1;
+  } else if (name == "gte") {
+    first = value;
+  } else if (name == "between" && call.inputs().size() == 3) {
+    first = value;
+    last = constantDate(call.inputs()[2], evaluator);
+    if (!last.has_value()) {
+      return nullptr;
+    }
+  } else {
+    return nullptr;
+  }
+  if (!toSubfield(cast->inputs()[0].get(), subfield)) {
+    return nullptr;
+  }
+  // The cast may shift timestamps by the session time zone offset, which is
+  // less than a day.
+  constexpr int64_t kSecondsPerDay = 86'400;
+  const auto lower = first.has_value()
+      ? Timestamp((first.value() - 1) * kSecondsPerDay, 0)
+      : std::numeric_limits<Timestamp>::min();
+  const auto upper = last.has_value()
+      ? Timestamp((last.value() + 2) * kSecondsPerDay - 1, 999'999'999)
+      : std::numeric_limits<Timestamp>::max();
+  return between(lower, upper);
+}
+
 std::pair<common::Subfield, std::unique_ptr<common::Filter>> toSubfieldFilter(
     const core::TypedExprPtr& expr,
     core::ExpressionEvaluator* evaluator) {
@@ -386,6 +386,18 @@ std::unique_ptr<common::Filter> leafCallToSubfieldFilter(
     core::ExpressionEvaluator*,
     bool negated = false);
 
+/// Returns a filter on 'subfield' that passes all rows for which the leaf
+/// call is true, and possibly more, or nullptr if there is none. Used for
+/// calls that leafCallToSubfieldFilter() cannot convert exactly, so that the
+/// reader can skip rows and row groups before the call is evaluated on the
+/// remaining rows. Supports comparisons and BETWEEN of cast(timestamp AS
+/// date) with constant dates, whose result depends on the session time zone.
+std::unique_ptr<common::Filter> leafCallToImpliedSubfieldFilter(
+    const core::CallTypedExpr&,
+    common::Subfield&,
+    core::ExpressionEvaluator*,
+    bool negated = false);
+
 inline std::unique_ptr<common::TimestampRange> equal(
     const Timestamp& value,
     bool nullAllowed = false) {
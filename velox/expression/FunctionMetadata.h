@@ -40,6 +40,11 @@ struct VectorFunctionMetadata {
   /// In this case, 'rows' in VectorFunction::apply will point only to positions
   /// for which all arguments are not null.
   bool defaultNullBehavior{true};
+
+  /// True if the result depends on the time of the evaluation, e.g.
+  /// current_date(). Such a function is deterministic within a query, but its
+  /// folded value is not shared with other queries.
+  bool timeDependent{false};
 };
 
 class VectorFunctionMetadataBuilder {
@@ -59,6 +64,11 @@ class VectorFunctionMetadataBuilder {
     return *this;
   }
 
+  VectorFunctionMetadataBuilder& timeDependent(bool timeDependent) {
+    metadata_.timeDependent = timeDependent;
+    return *this;
+  }
+
   const VectorFunctionMetadata& build() const {
     return metadata_;
   }
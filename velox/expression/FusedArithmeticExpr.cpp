@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/expression/FusedArithmeticExpr.h"
+
+#include <folly/Synchronized.h>
+
+namespace facebook::velox::exec {
+
+namespace {
+
+folly::Synchronized<std::unordered_map<std::string, FusedOp>>&
+fusableFunctions() {
+  static folly::Synchronized<std::unordered_map<std::string, FusedOp>>
+      functions;
+  return functions;
+}
+
+// Loops over contiguous values without branches, so that they vectorize.
+template <typename T, typename TOp>
+void applyBlock(const T* left, const T* right, T* out, int32_t size, TOp op) {
+  for (auto i = 0; i < size; ++i) {
+    out[i] = op(left[i], right[i]);
+  }
+}
+
+template <typename T>
+void applyArithmetic(
+    FusedOp op,
+    const T* left,
+    const T* right,
+    T* out,
+    int32_t size) {
+  switch (op) {
+    case FusedOp::kPlus:
+      applyBlock(left, right, out, size, std::plus<T>());
+      break;
+    case FusedOp::kMinus:
+      applyBlock(left, right, out, size, std::minus<T>());
+      break;
+    case FusedOp::kMultiply:
+      applyBlock(left, right, out, size, std::multiplies<T>());
+      break;
+    case FusedOp::kDivide:
+      applyBlock(left, right, out, size, std::divides<T>());
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Sets the bits of 'values' that are set in 'rowBits' to the results of
+// comparing 'left' and 'right'. 'rowBits' and 'values' start at the first row
+// of the block, which is a multiple of 64.
+template <typename T, typename TOp>
+void compareBlock(
+    const T* left,
+    const T* right,
+    int32_t size,
+    const uint64_t* rowBits,
+    uint64_t* values,
+    TOp op) {
+  for (auto word = 0; word * 64 < size; ++word) {
+    const auto* wordLeft = left + word * 64;
+    const auto* wordRight = right + word * 64;
+    const int32_t end = std::min<int32_t>(64, size - word * 64);
+    uint64_t bits = 0;
+    for (auto i = 0; i < end; ++i) {
+      bits |= static_cast<uint64_t>(op(wordLeft[i], wordRight[i])) << i;
+    }
+    values[word] = (values[word] & ~rowBits[word]) | (bits & rowBits[word]);
+  }
+}
+
+template <typename T>
+void applyComparison(
+    FusedOp op,
+    const T* left,
+    const T* right,
+    int32_t size,
+    const uint64_t* rowBits,
+    uint64_t* values) {
+  switch (op) {
+    case FusedOp::kEq:
+      compareBlock(left, right, size, rowBits, values, std::equal_to<T>());
+      break;
+    case FusedOp::kNeq:
+      compareBlock(left, right, size, rowBits, values, std::not_equal_to<T>());
+      break;
+    case FusedOp::kLt:
+      compareBlock(left, right, size, rowBits, values, std::less<T>());
+      break;
+    case FusedOp::kLte:
+      compareBlock(left, right, size, rowBits, values, std::less_equal<T>());
+      break;
+    case FusedOp::kGt:
+      compareBlock(left, right, size, rowBits, values, std::greater<T>());
+      break;
+    case FusedOp::kGte:
+      compareBlock(left, right, size, rowBits, values, std::greater_equal<T>());
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+} // namespace
+
+void registerFusableFunction(const std::string& name, FusedOp op) {
+  fusableFunctions().wlock()->insert_or_assign(name, op);
+}
+
+std::optional<FusedOp> getFusableFunction(const std::string& name) {
+  return fusableFunctions().withRLock(
+      [&](const auto& functions) -> std::optional<FusedOp> {
+        auto it = functions.find(name);
+        if (it == functions.end()) {
+          return std::nullopt;
+        }
+        return it->second;
+      });
+}
+
+FusedArithmeticExpr::FusedArithmeticExpr(
+    TypePtr type,
+    std::vector<ExprPtr>&& inputs,
+    std::vector<Node> nodes,
+    bool trackCpuUsage)
+    : SpecialForm(
+          std::move(type),
+          std::move(inputs),
+          "fused",
+          false /* supportsFlatNoNullsFastPath */,
+          trackCpuUsage),
+      nodes_(std::move(nodes)) {
+  VELOX_CHECK(!nodes_.empty());
+  VELOX_CHECK(!inputs_.empty());
+  valueKind_ = inputs_[0]->type()->kind();
+  VELOX_CHECK(
+      valueKind_ == TypeKind::DOUBLE || valueKind_ == TypeKind::REAL,
+      "Fused expressions only support DOUBLE and REAL values");
+  for (const auto& input : inputs_) {
+    VELOX_CHECK_EQ(input->type()->kind(), valueKind_);
+  }
+  for (auto i = 0; i < nodes_.size(); ++i) {
+    const auto& node = nodes_[i];
+    VELOX_CHECK(
+        !isFusedComparison(node.op) || i == nodes_.size() - 1,
+        "Only the root of a fused expression may be a comparison");
+    for (const auto& operand : {node.left, node.right}) {
+      VELOX_CHECK_LT(
+          operand.index, operand.isInput ? inputs_.size() : i, "Bad operand");
+    }
+  }
+  VELOX_CHECK(
+      isFusedComparison(nodes_.back().op) ? type_->isBoolean()
+                                          : type_->kind() == valueKind_);
+}
+
+void FusedArithmeticExpr::computePropagatesNulls() {
+  // The inputs are fields and constants, and a null in any of them makes the
+  // result null.
+  propagatesNulls_ = true;
+}
+
+void FusedArithmeticExpr::evalSpecialForm(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  if (valueKind_ == TypeKind::DOUBLE) {
+    evalTyped<double>(rows, context, result);
+  } else {
+    evalTyped<float>(rows, context, result);
+  }
+}
+
+template <typename T>
+void FusedArithmeticExpr::evalTyped(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  const auto numInputs = inputs_.size();
+  std::vector<VectorPtr> inputValues(numInputs);
+  std::vector<LocalDecodedVector> decoded;
+  decoded.reserve(numInputs);
+  for (auto i = 0; i < numInputs; ++i) {
+    inputs_[i]->eval(rows, context, inputValues[i]);
+    decoded.emplace_back(context, *inputValues[i], rows);
+    if (decoded[i]->isConstantMapping() && decoded[i]->isNullAt(rows.begin())) {
+      setAllNulls(rows, context, result);
+      context.releaseVectors(inputValues);
+      return;
+    }
+  }
+  context.ensureWritable(rows, type(), result);
+
+  // The values of node 'i' for a block are at 'i * kBlockSize' and the values
+  // of input 'i' that is not flat are at '(nodes_.size() + i) * kBlockSize'.
+  scratch_.resize((nodes_.size() + numInputs) * kBlockSize * sizeof(T));
+  auto* scratch = reinterpret_cast<T*>(scratch_.data());
+  auto* inputScratch = scratch + nodes_.size() * kBlockSize;
+  for (auto i = 0; i < numInputs; ++i) {
+    if (decoded[i]->isConstantMapping()) {
+      std::fill_n(
+          inputScratch + i * kBlockSize,
+          kBlockSize,
+          decoded[i]->template valueAt<T>(rows.begin()));
+    }
+  }
+
+  const auto& root = nodes_.back();
+  const bool isComparison = isFusedComparison(root.op);
+  const bool allSelected = rows.isAllSelected();
+  const auto* rowBits = rows.asRange().bits();
+  uint64_t* rawBits = isComparison
+      ? result->asUnchecked<FlatVector<bool>>()->mutableRawValues<uint64_t>()
+      : nullptr;
+  T* rawValues = isComparison
+      ? nullptr
+      : result->asUnchecked<FlatVector<T>>()->mutableRawValues();
+
+  std::vector<const T*> inputData(numInputs);
+  auto operandData = [&](const Operand& operand) -> const T* {
+    return operand.isInput ? inputData[operand.index]
+                           : scratch + operand.index * kBlockSize;
+  };
+
+  // Blocks start at multiples of 64 so that comparisons set whole words.
+  for (vector_size_t blockBegin = rows.begin() / 64 * 64;
+       blockBegin < rows.end();
+       blockBegin += kBlockSize) {
+    const int32_t size =
+        std::min<vector_size_t>(kBlockSize, rows.end() - blockBegin);
+    for (auto i = 0; i < numInputs; ++i) {
+      const auto& input = *decoded[i];
+      if (input.isConstantMapping()) {
+        inputData[i] = inputScratch + i * kBlockSize;
+      } else if (input.isIdentityMapping()) {
+        inputData[i] = input.template data<T>() + blockBegin;
+      } else {
+        // Only the indices of the selected rows are known to be valid.
+        auto* values = inputScratch + i * kBlockSize;
+        bits::forEachSetBit(
+            rowBits, blockBegin, blockBegin + size, [&](auto row) {
+              values[row - blockBegin] = input.template valueAt<T>(row);
+            });
+        inputData[i] = values;
+      }
+    }
+
+    for (auto i = 0; i + 1 < nodes_.size(); ++i) {
+      const auto& node = nodes_[i];
+      applyArithmetic<T>(
+          node.op,
+          operandData(node.left),
+          operandData(node.right),
+          scratch + i * kBlockSize,
+          size);
+    }
+
+    if (isComparison) {
+      applyComparison<T>(
+          root.op,
+          operandData(root.left),
+          operandData(root.right),
+          size,
+          rowBits + blockBegin / 64,
+          rawBits + blockBegin / 64);
+    } else if (allSelected) {
+      applyArithmetic<T>(
+          root.op,
+          operandData(root.left),
+          operandData(root.right),
+          rawValues + blockBegin,
+          size);
+    } else {
+      // Rows that are not selected must keep their values.
+      auto* values = scratch + (nodes_.size() - 1) * kBlockSize;
+      applyArithmetic<T>(
+          root.op,
+          operandData(root.left),
+          operandData(root.right),
+          values,
+          size);
+      bits::forEachSetBit(
+          rowBits, blockBegin, blockBegin + size, [&](auto row) {
+            rawValues[row] = values[row - blockBegin];
+          });
+    }
+  }
+
+  if (result->mayHaveNulls()) {
+    rows.clearNulls(result->mutableRawNulls());
+  }
+  for (auto i = 0; i < numInputs; ++i) {
+    const auto& input = *decoded[i];
+    if (!input.mayHaveNulls()) {
+      continue;
+    }
+    rows.applyToSelected([&](auto row) {
+      if (input.isNullAt(row)) {
+        result->setNull(row, true);
+      }
+    });
+  }
+  context.releaseVectors(inputValues);
+}
+
+std::string FusedArithmeticExpr::nodeToString(
+    int32_t index,
+    bool sql,
+    std::vector<VectorPtr>* complexConstants) const {
+  const auto& node = nodes_[index];
+  auto operandToString = [&](const Operand& operand) {
+    if (!operand.isInput) {
+      return nodeToString(operand.index, sql, complexConstants);
+    }
+    const auto& input = inputs_[operand.index];
+    return sql ? input->toSql(complexConstants) : input->toString();
+  };
+  return fmt::format(
+      sql ? "\"{}\"({}, {})" : "{}({}, {})",
+      node.name,
+      operandToString(node.left),
+      operandToString(node.right));
+}
+
+std::string FusedArithmeticExpr::toString(bool recursive) const {
+  if (!recursive) {
+    return name_;
+  }
+  return fmt::format(
+      "{}({})", name_, nodeToString(nodes_.size() - 1, false, nullptr));
+}
+
+std::string FusedArithmeticExpr::toSql(
+    std::vector<VectorPtr>* complexConstants) const {
+  return nodeToString(nodes_.size() - 1, true, complexConstants);
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "velox/expression/SpecialForm.h"
+
+namespace facebook::velox::exec {
+
+/// Element-wise operations on floating point values that ExprCompiler can
+/// fuse into one loop.
+enum class FusedOp : uint8_t {
+  kPlus,
+  kMinus,
+  kMultiply,
+  kDivide,
+  kEq,
+  kNeq,
+  kLt,
+  kLte,
+  kGt,
+  kGte,
+};
+
+/// Declares that the function 'name' called with two DOUBLE or two REAL
+/// arguments computes 'op' with IEEE 754 semantics, returns null if either
+/// argument is null and never fails. ExprCompiler may then evaluate trees of
+/// such calls with one FusedArithmeticExpr when
+/// QueryConfig::exprFusionEnabled() is true.
+void registerFusableFunction(const std::string& name, FusedOp op);
+
+/// Returns the operation registered for 'name' with registerFusableFunction.
+std::optional<FusedOp> getFusableFunction(const std::string& name);
+
+inline bool isFusedComparison(FusedOp op) {
+  return op >= FusedOp::kEq;
+}
+
+/// Evaluates a tree of fusable calls on DOUBLE or REAL values in one pass over
+/// blocks of rows. The values of the inner calls are kept in small buffers
+/// instead of vectors. The inputs are the leaves of the tree, which are
+/// evaluated the usual way. Only the root may be a comparison.
+class FusedArithmeticExpr : public SpecialForm {
+ public:
+  /// An operand of a node. Refers to inputs_[index] or to nodes[index].
+  struct Operand {
+    bool isInput;
+    int32_t index;
+  };
+
+  /// A fused call. Nodes are in evaluation order, so that the operands of a
+  /// node refer to earlier nodes. The last node is the root.
+  struct Node {
+    FusedOp op;
+    std::string name;
+    Operand left;
+    Operand right;
+  };
+
+  FusedArithmeticExpr(
+      TypePtr type,
+      std::vector<ExprPtr>&& inputs,
+      std::vector<Node> nodes,
+      bool trackCpuUsage);
+
+  void evalSpecialForm(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  const std::vector<Node>& nodes() const {
+    return nodes_;
+  }
+
+  std::string toString(bool recursive = true) const override;
+
+  std::string toSql(
+      std::vector<VectorPtr>* complexConstants = nullptr) const override;
+
+  /// Number of rows processed at a time. The values of each node for a block
+  /// fit in the L1 cache.
+  static constexpr int32_t kBlockSize = 1'024;
+
+ private:
+  void computePropagatesNulls() override;
+
+  template <typename T>
+  void evalTyped(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result);
+
+  std::string nodeToString(
+      int32_t index,
+      bool sql,
+      std::vector<VectorPtr>* complexConstants) const;
+
+  const std::vector<Node> nodes_;
+
+  // Kind of the values of the inputs and of the nodes other than a comparison.
+  TypeKind valueKind_;
+
+  // Values of the nodes and of the inputs that are not flat for one block.
+  std::vector<char> scratch_;
+};
+
+} // namespace facebook::velox::exec
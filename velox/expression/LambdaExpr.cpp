@@ -120,7 +120,11 @@ class ExprCallable : public Callable {
     for (auto index = args.size(); index < capture_->childrenSize(); ++index) {
       auto values = capture_->childAt(index);
       VELOX_DCHECK(!isLazyNotLoaded(*values));
-      if (wrapCapture) {
+      if (values->isConstantEncoding()) {
+        // Every element sees the same value. Keeping the capture constant
+        // lets the body use its constant fast paths.
+        values = BaseVector::wrapInConstant(size, 0, values);
+      } else if (wrapCapture) {
         values = BaseVector::wrapInDictionary(
             BufferPtr(nullptr), wrapCapture, size, values);
       }
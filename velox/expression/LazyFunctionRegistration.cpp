@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/LazyFunctionRegistration.h"
+
+#include <folly/ScopeGuard.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+namespace {
+struct LazyRegistrations {
+  // Set while 'pending' has registrations that have not finished running.
+  // Checked without 'mutex' on every lookup.
+  std::atomic<bool> hasPending{false};
+
+  // Recursive, so that a registration that resolves a function, e.g. to
+  // register a companion function, does not deadlock.
+  std::recursive_mutex mutex;
+
+  // True while the registrations run. Nested calls to
+  // ensureLazyFunctionsRegistered() return right away.
+  bool running{false};
+
+  std::vector<std::function<void()>> pending;
+};
+
+LazyRegistrations& lazyRegistrations() {
+  static LazyRegistrations registrations;
+  return registrations;
+}
+} // namespace
+
+void registerFunctionsLazily(std::function<void()> registration) {
+  auto& registrations = lazyRegistrations();
+  std::lock_guard<std::recursive_mutex> l(registrations.mutex);
+  registrations.pending.push_back(std::move(registration));
+  registrations.hasPending = true;
+}
+
+void ensureLazyFunctionsRegistered() {
+  auto& registrations = lazyRegistrations();
+  if (!registrations.hasPending) {
+    return;
+  }
+  std::lock_guard<std::recursive_mutex> l(registrations.mutex);
+  if (registrations.running) {
+    return;
+  }
+  registrations.running = true;
+  SCOPE_EXIT {
+    registrations.running = false;
+  };
+  // Registrations may add more registrations.
+  while (!registrations.pending.empty()) {
+    auto pending = std::move(registrations.pending);
+    registrations.pending.clear();
+    for (auto& registration : pending) {
+      registration();
+    }
+  }
+  registrations.hasPending = false;
+}
+
+} // namespace facebook::velox::exec
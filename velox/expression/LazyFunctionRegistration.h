@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+
+namespace facebook::velox::exec {
+
+/// Defers 'registration', a callback that registers scalar, aggregate or
+/// window functions, until a function registry is first used to resolve or
+/// list functions. Building the signatures and adapters of thousands of
+/// functions takes a while, so processes that register all functions at
+/// startup but resolve few or none of them, e.g. short-lived tools, save that
+/// time. Registrations run in the order they were added. Since they run
+/// late, they replace functions of the same names that were registered
+/// eagerly in the meantime.
+void registerFunctionsLazily(std::function<void()> registration);
+
+/// Runs the registrations deferred by registerFunctionsLazily that have not
+/// run yet. Function registries call this before lookups and listing, so
+/// callers do not need to. Calls from within a deferred registration return
+/// right away.
+void ensureLazyFunctionsRegistered();
+
+} // namespace facebook::velox::exec
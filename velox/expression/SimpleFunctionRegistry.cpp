@@ -16,6 +16,8 @@
 
 #include "velox/expression/SimpleFunctionRegistry.h"
 
+#include "velox/expression/LazyFunctionRegistration.h"
+
 namespace facebook::velox::exec {
 namespace {
 
@@ -26,6 +28,7 @@ SimpleFunctionRegistry& simpleFunctionsInternal() {
 } // namespace
 
 const SimpleFunctionRegistry& simpleFunctions() {
+  ensureLazyFunctionsRegistered();
   return simpleFunctionsInternal();
 }
 
@@ -102,7 +105,8 @@ SimpleFunctionRegistry::getFunctionSignaturesAndMetadata(
         VectorFunctionMetadata metadata{
             false,
             functions[0]->getMetadata().isDeterministic(),
-            functions[0]->getMetadata().defaultNullBehavior()};
+            functions[0]->getMetadata().defaultNullBehavior(),
+            functions[0]->getMetadata().isTimeDependent()};
         result.emplace_back(
             std::pair<VectorFunctionMetadata, const FunctionSignature*>{
                 metadata, &signature});
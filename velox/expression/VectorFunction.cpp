@@ -17,11 +17,18 @@
 #include <unordered_map>
 #include "folly/Singleton.h"
 #include "folly/Synchronized.h"
+#include "velox/expression/LazyFunctionRegistration.h"
 #include "velox/expression/SignatureBinder.h"
 
 namespace facebook::velox::exec {
 
 namespace {
+// The registry without the functions that are registered lazily.
+VectorFunctionMap& vectorFunctionFactoriesInternal() {
+  static VectorFunctionMap factories;
+  return factories;
+}
+
 template <typename TResult, typename TFunc>
 std::optional<TResult> applyToVectorFunctionEntry(
     const std::string& name,
@@ -58,8 +65,8 @@ std::vector<VectorFunctionArg> toVectorFunctionArgs(
 } // namespace
 
 VectorFunctionMap& vectorFunctionFactories() {
-  static VectorFunctionMap factories;
-  return factories;
+  ensureLazyFunctionsRegistered();
+  return vectorFunctionFactoriesInternal();
 }
 
 std::optional<std::vector<FunctionSignaturePtr>> getVectorFunctionSignatures(
@@ -156,7 +163,7 @@ bool registerStatefulVectorFunction(
   auto sanitizedName = sanitizeName(name);
 
   if (overwrite) {
-    vectorFunctionFactories().withWLock([&](auto& functionMap) {
+    vectorFunctionFactoriesInternal().withWLock([&](auto& functionMap) {
       // Insert/overwrite.
       functionMap[sanitizedName] = {
           std::move(signatures), std::move(factory), std::move(metadata)};
@@ -164,7 +171,7 @@ bool registerStatefulVectorFunction(
     return true;
   }
 
-  return vectorFunctionFactories().withWLock([&](auto& functionMap) {
+  return vectorFunctionFactoriesInternal().withWLock([&](auto& functionMap) {
     auto [iterator, inserted] = functionMap.insert(
         {sanitizedName,
          {std::move(signatures), std::move(factory), std::move(metadata)}});
@@ -197,4 +204,13 @@ void registerExpressionRewrite(ExpressionRewrite rewrite) {
   expressionRewrites().emplace_back(rewrite);
 }
 
+std::vector<ExpressionSetRewrite>& expressionSetRewrites() {
+  static std::vector<ExpressionSetRewrite> rewrites;
+  return rewrites;
+}
+
+void registerExpressionSetRewrite(ExpressionSetRewrite rewrite) {
+  expressionSetRewrites().emplace_back(rewrite);
+}
+
 } // namespace facebook::velox::exec
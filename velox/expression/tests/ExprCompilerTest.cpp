@@ -13,8 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <folly/ScopeGuard.h>
 #include "gtest/gtest.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/expression/ConstantFoldingCache.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
@@ -333,4 +335,93 @@ TEST_F(ExprCompilerTest, lambdaExpr) {
   ASSERT_EQ(distinctFields.size(), 2);
 }
 
+TEST_F(ExprCompilerTest, constantFoldingCache) {
+  ConstantFoldingCache cache(rootPool_->addLeafChild("cache"), 1 << 20);
+  ConstantFoldingCache::setInstance(&cache);
+  SCOPE_EXIT {
+    ConstantFoldingCache::setInstance(nullptr);
+  };
+
+  auto rowType = ROW({"c0"}, {VARCHAR()});
+  auto exprSet =
+      compile(makeTypedExpr("concat(c0, upper('abc'), c0)", rowType));
+  const auto expected = exprSet->toString();
+  ASSERT_EQ(cache.stats().numLookups, 1);
+  ASSERT_EQ(cache.stats().numHits, 0);
+  ASSERT_EQ(cache.stats().numEntries, 1);
+
+  // Another ExprSet with the same expression uses the folded value.
+  exprSet = compile(makeTypedExpr("concat(c0, upper('abc'), c0)", rowType));
+  ASSERT_EQ(exprSet->toString(), expected);
+  ASSERT_EQ(cache.stats().numHits, 1);
+
+  // Only subtrees that do not depend on the input are looked up.
+  compile(makeTypedExpr("concat(c0, 'abc')", rowType));
+  ASSERT_EQ(cache.stats().numLookups, 2);
+
+  // Values depend on the config.
+  queryCtx_->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kSessionTimezone, "America/Los_Angeles"}});
+  exprSet = compile(makeTypedExpr("concat(c0, upper('abc'), c0)", rowType));
+  ASSERT_EQ(exprSet->toString(), expected);
+  ASSERT_EQ(cache.stats().numLookups, 3);
+  ASSERT_EQ(cache.stats().numHits, 1);
+  ASSERT_EQ(cache.stats().numEntries, 2);
+
+  // Entries are evicted to stay under the size limit.
+  ConstantFoldingCache smallCache(rootPool_->addLeafChild("small"), 1);
+  ConstantFoldingCache::setInstance(&smallCache);
+  compile(makeTypedExpr("concat(c0, upper('abc'), c0)", rowType));
+  ASSERT_EQ(smallCache.stats().numEntries, 0);
+}
+
+TEST_F(ExprCompilerTest, constantFoldingCacheTimeDependent) {
+  ConstantFoldingCache cache(rootPool_->addLeafChild("cache"), 1 << 20);
+  ConstantFoldingCache::setInstance(&cache);
+  SCOPE_EXIT {
+    ConstantFoldingCache::setInstance(nullptr);
+  };
+
+  // current_date() is folded per ExprSet but not cached, so that the value
+  // does not go stale.
+  auto rowType = ROW({"c0"}, {DATE()});
+  auto field = makeField(rowType);
+  compile(call("eq", {field("c0"), call("current_date", {})}));
+  compile(call("eq", {field("c0"), call("current_date", {})}));
+  ASSERT_EQ(cache.stats().numLookups, 0);
+  ASSERT_EQ(cache.stats().numEntries, 0);
+
+  // The constant siblings of a call of current_date() are still cached.
+  compile(call(
+      "date_add",
+      {varchar("day"), call("abs", {bigint(-1)}), call("current_date", {})}));
+  ASSERT_EQ(cache.stats().numLookups, 1);
+  ASSERT_EQ(cache.stats().numEntries, 1);
+}
+
+TEST_F(ExprCompilerTest, constantFoldingCacheConfigKey) {
+  // Every property set is part of the key.
+  core::QueryConfig empty({});
+  core::QueryConfig matchStructByName(
+      {{core::QueryConfig::kCastMatchStructByName, "true"}});
+  core::QueryConfig other({{"some_property", "true"}});
+  const auto emptyKey = ConstantFoldingCache::configKey(empty);
+  ASSERT_NE(ConstantFoldingCache::configKey(matchStructByName), emptyKey);
+  ASSERT_NE(ConstantFoldingCache::configKey(other), emptyKey);
+  ASSERT_NE(
+      ConstantFoldingCache::configKey(matchStructByName),
+      ConstantFoldingCache::configKey(other));
+
+  // The key does not depend on the order of the properties.
+  core::QueryConfig both(
+      {{core::QueryConfig::kCastMatchStructByName, "true"},
+       {"some_property", "true"}});
+  core::QueryConfig bothReversed(
+      {{"some_property", "true"},
+       {core::QueryConfig::kCastMatchStructByName, "true"}});
+  ASSERT_EQ(
+      ConstantFoldingCache::configKey(both),
+      ConstantFoldingCache::configKey(bothReversed));
+}
+
 } // namespace facebook::velox::exec::test
@@ -150,6 +150,59 @@ TEST_F(ExprStatsTest, printWithStats) {
   }
 }
 
+TEST_F(ExprStatsTest, foldedStacks) {
+  vector_size_t size = 1'024;
+
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row % 7; }),
+  });
+  auto exprSet = compileExpressions(
+      {"(c0 + 3) * c1", "(c0 + c1) % 2 = 0"}, asRowType(data->type()));
+  evaluate(*exprSet, data);
+
+  // Functions do not time their inputs, so that the time of the nodes adds up
+  // to the time of all stacks.
+  uint64_t totalNanos = 0;
+  for (const auto& [name, stats] : exprSet->stats()) {
+    totalNanos += stats.timing.cpuNanos;
+  }
+  uint64_t stackNanos = 0;
+  for (const auto& [stack, nanos] :
+       exec::exprStatsToFoldedStacks(*exprSet, {"a", "b"})) {
+    ASSERT_GT(nanos, 0);
+    ASSERT_TRUE(stack.find("a;multiply") == 0 || stack.find("b;eq") == 0)
+        << stack;
+    stackNanos += nanos;
+  }
+  ASSERT_EQ(totalNanos, stackNanos);
+
+  ASSERT_THAT(
+      exec::printExprStatsAsFoldedStacks(*exprSet),
+      ::testing::MatchesRegex("((multiply|eq)(;[^ \n]+)* [0-9]+\n)*"));
+}
+
+TEST_F(ExprStatsTest, peelingAndDictionaryCacheHits) {
+  vector_size_t size = 1'024;
+
+  auto indices = makeIndices(size, [](auto row) { return row / 5; });
+  auto data = makeRowVector({wrapInDictionary(
+      indices,
+      size,
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }))});
+  auto exprSet = compileExpressions({"c0 + 3"}, asRowType(data->type()));
+
+  // The first evaluation peels the dictionary. The second one memoizes the
+  // results for the base and the third one reuses them.
+  for (auto i = 0; i < 3; ++i) {
+    evaluate(*exprSet, data);
+  }
+  auto stats = exprSet->stats();
+  ASSERT_EQ(3, stats.at("plus").numPeeledVectors);
+  ASSERT_EQ(1, stats.at("plus").numDictionaryCacheHits);
+  ASSERT_EQ(410, stats.at("plus").numProcessedRows);
+}
+
 struct Event {
   std::string uuid;
   std::unordered_map<std::string, exec::ExprStats> stats;
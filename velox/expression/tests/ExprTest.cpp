@@ -445,6 +445,30 @@ TEST_P(ParameterizedExprTest, moreEncodings) {
   assertEqualVectors(expected, result);
 }
 
+TEST_P(ParameterizedExprTest, sequenceEncoding) {
+  // 20 runs of 1 to 20 rows. Every fifth run is null.
+  std::vector<std::optional<int64_t>> data;
+  for (auto run = 0; run < 20; ++run) {
+    for (auto i = 0; i <= run; ++i) {
+      data.push_back(
+          run % 5 == 4 ? std::nullopt : std::optional<int64_t>(run));
+    }
+  }
+  auto [result, stats] = evaluateWithStats(
+      "c0 * 2 + 1", makeRowVector({vectorMaker_.sequenceVector(data)}));
+
+  // The runs are peeled off, so that each run is evaluated once.
+  ASSERT_EQ(VectorEncoding::Simple::DICTIONARY, result->encoding());
+  EXPECT_EQ(16, stats.at("plus").numProcessedRows);
+
+  std::vector<std::optional<int64_t>> expected;
+  for (const auto& value : data) {
+    expected.push_back(
+        value.has_value() ? std::optional(*value * 2 + 1) : std::nullopt);
+  }
+  assertEqualVectors(makeNullableFlatVector(expected), result);
+}
+
 TEST_P(ParameterizedExprTest, reorder) {
   constexpr int32_t kTestSize = 20'000;
 
@@ -892,6 +916,29 @@ void registerPlusRandomIntegerFunction() {
 }
 } // namespace
 
+TEST_P(ParameterizedExprTest, reorderAroundNonDeterministic) {
+  registerPlusRandomIntegerFunction();
+  constexpr int32_t kTestSize = 20'000;
+
+  auto data = makeRowVector(
+      {makeFlatVector<int32_t>(kTestSize, [](auto row) { return row; })});
+  // The inputs that drop no rows come first. The non-deterministic input in
+  // the middle keeps its place, so inputs only move on their side of it.
+  auto exprSet = compileExpression(
+      "c0 >= -1 and c0 % 10 = 1 and plus_random(c0) is not null "
+      "and c0 >= -2 and c0 % 10 = 2",
+      asRowType(data->type()));
+  evaluate(exprSet.get(), data);
+  evaluate(exprSet.get(), data);
+
+  auto conjunct =
+      std::dynamic_pointer_cast<exec::ConjunctExpr>(exprSet->expr(0));
+  ASSERT_TRUE(conjunct != nullptr);
+  ASSERT_EQ(5, conjunct->inputs().size());
+  EXPECT_EQ((std::vector<int32_t>{1, 0, 2, 4, 3}), conjunct->inputOrder());
+  EXPECT_EQ(2, exprSet->stats().at("and").numInputReorders);
+}
+
 // Test evaluating single-argument non-deterministic vector function on
 // constant vector. The function must be called on each row, not just one.
 TEST_P(ParameterizedExprTest, nonDeterministicVectorFunctionOnConstantInput) {
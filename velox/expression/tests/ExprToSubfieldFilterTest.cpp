@@ -209,11 +209,194 @@ TEST_F(ExprToSubfieldFilterTest, isNotNull) {
   ASSERT_FALSE(filter->testNull());
 }
 
+TEST_F(ExprToSubfieldFilterTest, inWithNull) {
+  auto call = parseCallExpr("a in (40, null)", ROW({{"a", BIGINT()}}));
+  Subfield subfield;
+  auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testInt64(40));
+  ASSERT_FALSE(filter->testInt64(0));
+  ASSERT_FALSE(filter->testNull());
+}
+
+TEST_F(ExprToSubfieldFilterTest, notIn) {
+  auto call = parseCallExpr("a not in (40, 42)", ROW({{"a", BIGINT()}}));
+  auto [subfield, filter] = toSubfieldFilter(call, evaluator());
+  validateSubfield(subfield, {"a"});
+  for (int i = 39; i <= 43; ++i) {
+    ASSERT_EQ(filter->testInt64(i), i != 40 && i != 42);
+  }
+  ASSERT_FALSE(filter->testNull());
+
+  // NOT IN a list with null is never true.
+  call = parseCallExpr("a not in ('x', null)", ROW({{"a", VARCHAR()}}));
+  auto [nullSubfield, nullFilter] = toSubfieldFilter(call, evaluator());
+  ASSERT_EQ(nullFilter->kind(), FilterKind::kAlwaysFalse);
+}
+
 TEST_F(ExprToSubfieldFilterTest, like) {
   auto call = parseCallExpr("a like 'foo%'", ROW({{"a", VARCHAR()}}));
   Subfield subfield;
   auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
-  ASSERT_FALSE(filter);
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"a"});
+  ASSERT_EQ(filter->kind(), FilterKind::kBytesRange);
+  ASSERT_TRUE(filter->testBytes("foo", 3));
+  ASSERT_TRUE(filter->testBytes("foobar", 6));
+  ASSERT_FALSE(filter->testBytes("fo", 2));
+  ASSERT_FALSE(filter->testBytes("fop", 3));
+  ASSERT_FALSE(filter->testNull());
+
+  call = parseCallExpr("a like 'foo'", ROW({{"a", VARCHAR()}}));
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testBytes("foo", 3));
+  ASSERT_FALSE(filter->testBytes("foobar", 6));
+
+  call = parseCallExpr("not (a like 'foo%')", ROW({{"a", VARCHAR()}}));
+  auto [negatedSubfield, negated] = toSubfieldFilter(call, evaluator());
+  ASSERT_FALSE(negated->testBytes("foobar", 6));
+  ASSERT_TRUE(negated->testBytes("fop", 3));
+  ASSERT_TRUE(negated->testBytes("fo", 2));
+
+  // Wildcards other than trailing '%' are not ranges.
+  for (const auto* pattern : {"a like '%foo'", "a like 'f_o%'"}) {
+    call = parseCallExpr(pattern, ROW({{"a", VARCHAR()}}));
+    ASSERT_FALSE(leafCallToSubfieldFilter(*call, subfield, evaluator()));
+  }
+}
+
+TEST_F(ExprToSubfieldFilterTest, orOfRanges) {
+  auto call = parseCallExpr(
+      "a < 10 or a between 5 and 20 or a > 100", ROW({{"a", BIGINT()}}));
+  Subfield subfield;
+  auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"a"});
+  ASSERT_EQ(filter->kind(), FilterKind::kBigintMultiRange);
+  ASSERT_TRUE(filter->testInt64(-5));
+  ASSERT_TRUE(filter->testInt64(20));
+  ASSERT_FALSE(filter->testInt64(21));
+  ASSERT_FALSE(filter->testInt64(100));
+  ASSERT_TRUE(filter->testInt64(101));
+  ASSERT_FALSE(filter->testNull());
+
+  call = parseCallExpr("a = 1.5 or a is null", ROW({{"a", DOUBLE()}}));
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testDouble(1.5));
+  ASSERT_FALSE(filter->testDouble(2));
+  ASSERT_TRUE(filter->testNull());
+
+  call = parseCallExpr("a like 'x%' or a = 'abc'", ROW({{"a", VARCHAR()}}));
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_EQ(filter->kind(), FilterKind::kMultiRange);
+  ASSERT_TRUE(filter->testBytes("xyz", 3));
+  ASSERT_TRUE(filter->testBytes("abc", 3));
+  ASSERT_FALSE(filter->testBytes("abcd", 4));
+
+  // NOT of AND is an OR.
+  call = parseCallExpr("not (a >= 10 and a <= 20)", ROW({{"a", BIGINT()}}));
+  auto [negatedSubfield, negated] = toSubfieldFilter(call, evaluator());
+  ASSERT_TRUE(negated->testInt64(9));
+  ASSERT_FALSE(negated->testInt64(15));
+  ASSERT_TRUE(negated->testInt64(21));
+
+  call = parseCallExpr(
+      "a = 1 or b = 2", ROW({{"a", BIGINT()}, {"b", BIGINT()}}));
+  ASSERT_FALSE(leafCallToSubfieldFilter(*call, subfield, evaluator()));
+}
+
+TEST_F(ExprToSubfieldFilterTest, orOfBigintInListAndRange) {
+  auto call = parseCallExpr(
+      "a in (1, 5, 7) or a > 100", ROW({{"a", BIGINT()}}));
+  Subfield subfield;
+  auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_EQ(filter->kind(), FilterKind::kBigintMultiRange);
+  ASSERT_TRUE(filter->testInt64(1));
+  ASSERT_TRUE(filter->testInt64(5));
+  ASSERT_FALSE(filter->testInt64(6));
+  ASSERT_TRUE(filter->testInt64(7));
+  ASSERT_FALSE(filter->testInt64(100));
+  ASSERT_TRUE(filter->testInt64(101));
+  ASSERT_FALSE(filter->testNull());
+
+  // Adjacent values and ranges are merged.
+  call = parseCallExpr(
+      "a in (1, 2, 3) or a between 4 and 10 or a is null",
+      ROW({{"a", BIGINT()}}));
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_EQ(filter->kind(), FilterKind::kBigintRange);
+  ASSERT_TRUE(filter->testInt64(1));
+  ASSERT_TRUE(filter->testInt64(10));
+  ASSERT_FALSE(filter->testInt64(11));
+  ASSERT_TRUE(filter->testNull());
+
+  // NOT IN and != do not convert to ranges.
+  call = parseCallExpr("a not in (1, 5) or a > 100", ROW({{"a", BIGINT()}}));
+  ASSERT_FALSE(leafCallToSubfieldFilter(*call, subfield, evaluator()));
+}
+
+TEST_F(ExprToSubfieldFilterTest, orOfBooleans) {
+  auto rowType = ROW({{"b", BOOLEAN()}});
+  auto call = parseCallExpr("b = true or b = false", rowType);
+  Subfield subfield;
+  auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_EQ(filter->kind(), FilterKind::kIsNotNull);
+  ASSERT_FALSE(filter->testNull());
+
+  call = parseCallExpr("b = true or b = true", rowType);
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_EQ(filter->kind(), FilterKind::kBoolValue);
+  ASSERT_TRUE(filter->testBool(true));
+  ASSERT_FALSE(filter->testBool(false));
+
+  call = parseCallExpr("b = false or b is null", rowType);
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_EQ(filter->kind(), FilterKind::kBoolValue);
+  ASSERT_FALSE(filter->testBool(true));
+  ASSERT_TRUE(filter->testBool(false));
+  ASSERT_TRUE(filter->testNull());
+}
+
+TEST_F(ExprToSubfieldFilterTest, impliedCastToDate) {
+  auto rowType = ROW({{"t", TIMESTAMP()}});
+  auto call = parseCallExpr(
+      "cast(t as date) between date '2024-01-01' and date '2024-01-31'",
+      rowType);
+  Subfield subfield;
+  ASSERT_FALSE(leafCallToSubfieldFilter(*call, subfield, evaluator()));
+  auto filter = leafCallToImpliedSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"t"});
+  constexpr int64_t kDay = 86'400;
+  // 2024-01-01 is day 19723.
+  const int64_t first = 19'723 * kDay;
+  const int64_t end = (19'723 + 31) * kDay;
+  ASSERT_TRUE(filter->testTimestamp(Timestamp(first, 0)));
+  ASSERT_TRUE(filter->testTimestamp(Timestamp(end - 1, 0)));
+  // Timestamps within a day of the range may be in it in some time zone.
+  ASSERT_TRUE(filter->testTimestamp(Timestamp(first - 3'600 * 14, 0)));
+  ASSERT_TRUE(filter->testTimestamp(Timestamp(end + 3'600 * 14, 0)));
+  ASSERT_FALSE(filter->testTimestamp(Timestamp(first - 2 * kDay, 0)));
+  ASSERT_FALSE(filter->testTimestamp(Timestamp(end + 2 * kDay, 0)));
+  ASSERT_FALSE(filter->testNull());
+
+  call = parseCallExpr("cast(t as date) < date '2024-01-01'", rowType);
+  filter = leafCallToImpliedSubfieldFilter(*call, subfield, evaluator(), true);
+  ASSERT_TRUE(filter);
+  ASSERT_FALSE(filter->testTimestamp(Timestamp(first - 2 * kDay, 0)));
+  ASSERT_TRUE(filter->testTimestamp(Timestamp(first + 100 * kDay, 0)));
+
+  call = parseCallExpr("cast(t as date) = date '2024-01-01'", rowType);
+  ASSERT_FALSE(
+      leafCallToImpliedSubfieldFilter(*call, subfield, evaluator(), true));
 }
 
 TEST_F(ExprToSubfieldFilterTest, nonConstant) {
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/expression/FusedArithmeticExpr.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::test;
+
+namespace {
+
+class FusedArithmeticExprTest : public functions::test::FunctionBaseTest {
+ protected:
+  void setFusionEnabled(bool enabled) {
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kExprFusionEnabled, enabled ? "true" : "false"},
+    });
+  }
+
+  static const exec::FusedArithmeticExpr* asFused(const exec::ExprPtr& expr) {
+    return dynamic_cast<const exec::FusedArithmeticExpr*>(expr.get());
+  }
+
+  // Checks that 'expression' evaluates to the same result with and without
+  // fusion and returns the expression compiled with fusion.
+  std::unique_ptr<exec::ExprSet> testFusion(
+      const std::string& expression,
+      const RowVectorPtr& data,
+      const std::optional<SelectivityVector>& rows = std::nullopt) {
+    const auto rowType = asRowType(data->type());
+    setFusionEnabled(false);
+    auto exprSet = compileExpression(expression, rowType);
+    EXPECT_EQ(asFused(exprSet->exprs()[0]), nullptr);
+    auto expected = evaluate(*exprSet, data, rows);
+
+    setFusionEnabled(true);
+    auto fusedSet = compileExpression(expression, rowType);
+    auto result = evaluate(*fusedSet, data, rows);
+    if (rows.has_value()) {
+      assertEqualVectors(expected, result, rows.value());
+    } else {
+      assertEqualVectors(expected, result);
+    }
+    return fusedSet;
+  }
+
+  static constexpr vector_size_t kSize = 3'000;
+};
+
+TEST_F(FusedArithmeticExprTest, arithmetic) {
+  auto data = makeRowVector({
+      makeFlatVector<double>(kSize, [](auto row) { return row * 0.5; }),
+      makeFlatVector<double>(kSize, [](auto row) { return row % 7 + 1; }),
+      makeFlatVector<double>(kSize, [](auto row) { return -row; }),
+  });
+
+  auto exprSet = testFusion("(c0 * c1 + c2) / c1 - c0", data);
+  auto fused = asFused(exprSet->exprs()[0]);
+  ASSERT_NE(fused, nullptr);
+  ASSERT_EQ(fused->nodes().size(), 4);
+  // Repeated leaves are evaluated once.
+  ASSERT_EQ(fused->inputs().size(), 3);
+  ASSERT_EQ(
+      fused->toString(),
+      "fused(minus(divide(plus(multiply(c0, c1), c2), c1), c0))");
+
+  exprSet = testFusion("c0 * 2.5 + 1.0", data);
+  ASSERT_NE(asFused(exprSet->exprs()[0]), nullptr);
+
+  // A single call is evaluated as usual.
+  exprSet = testFusion("c0 + c1", data);
+  ASSERT_EQ(asFused(exprSet->exprs()[0]), nullptr);
+}
+
+TEST_F(FusedArithmeticExprTest, comparison) {
+  auto data = makeRowVector({
+      makeFlatVector<double>(kSize, [](auto row) { return row % 11; }),
+      makeFlatVector<double>(kSize, [](auto row) { return row % 13; }),
+  });
+
+  for (const auto& expression :
+       {"c0 * c1 > c0 + c1",
+        "c0 - c1 = 0.0",
+        "c0 * 2.0 <> c1",
+        "c0 + c1 < 10.0",
+        "c0 / 3.0 <= c1",
+        "c0 + c1 >= c1 * 2.0"}) {
+    SCOPED_TRACE(expression);
+    auto exprSet = testFusion(expression, data);
+    ASSERT_NE(asFused(exprSet->exprs()[0]), nullptr);
+  }
+
+  // A comparison below the root is not fused.
+  auto exprSet = testFusion("(c0 + c1 > c0 * c1) = (c0 > c1)", data);
+  ASSERT_EQ(asFused(exprSet->exprs()[0]), nullptr);
+}
+
+TEST_F(FusedArithmeticExprTest, real) {
+  auto data = makeRowVector({
+      makeFlatVector<float>(kSize, [](auto row) { return row * 0.25; }),
+      makeFlatVector<float>(kSize, [](auto row) { return row % 5 + 1; }),
+  });
+
+  auto exprSet = testFusion("c0 * c1 - c1", data);
+  ASSERT_NE(asFused(exprSet->exprs()[0]), nullptr);
+  exprSet = testFusion("c0 / c1 > c1 + c1", data);
+  ASSERT_NE(asFused(exprSet->exprs()[0]), nullptr);
+}
+
+TEST_F(FusedArithmeticExprTest, nullsAndEncodings) {
+  auto data = makeRowVector({
+      makeFlatVector<double>(
+          kSize, [](auto row) { return row; }, nullEvery(5)),
+      wrapInDictionary(
+          makeIndicesInReverse(kSize),
+          makeFlatVector<double>(
+              kSize, [](auto row) { return row % 3; }, nullEvery(7))),
+      makeConstant(1.5, kSize),
+      makeNullConstant(TypeKind::DOUBLE, kSize),
+  });
+
+  for (const auto& expression :
+       {"c0 * c1 + c2",
+        "c0 * c1 + c2 > c1",
+        "c2 * c1 - c2",
+        "c0 + c3 * c1",
+        "c0 - c1 < c3"}) {
+    SCOPED_TRACE(expression);
+    auto exprSet = testFusion(expression, data);
+    ASSERT_NE(asFused(exprSet->exprs()[0]), nullptr);
+  }
+}
+
+TEST_F(FusedArithmeticExprTest, selectedRows) {
+  auto data = makeRowVector({
+      makeFlatVector<double>(kSize, [](auto row) { return row; }),
+      wrapInDictionary(
+          makeIndicesInReverse(kSize),
+          makeFlatVector<double>(kSize, [](auto row) { return row % 3; })),
+  });
+
+  SelectivityVector rows(kSize, false);
+  for (auto i = 70; i < kSize - 100; i += 3) {
+    rows.setValid(i, true);
+  }
+  rows.updateBounds();
+
+  testFusion("c0 * c1 + c0", data, rows);
+  testFusion("c0 * c1 + c0 > c1", data, rows);
+}
+
+TEST_F(FusedArithmeticExprTest, fallback) {
+  auto data = makeRowVector({
+      makeFlatVector<double>(kSize, [](auto row) { return row * 0.5; }),
+      makeFlatVector<double>(kSize, [](auto row) { return row % 7; }),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+  });
+
+  // Calls that are not fusable stop fusion of the calls above them.
+  auto exprSet = testFusion("c0 * c1 + ceil(c1)", data);
+  ASSERT_EQ(asFused(exprSet->exprs()[0]), nullptr);
+
+  // Fusable trees below other calls are fused.
+  exprSet = testFusion("abs(c0 * c1 + c1)", data);
+  ASSERT_EQ(asFused(exprSet->exprs()[0]), nullptr);
+  ASSERT_NE(asFused(exprSet->exprs()[0]->inputs()[0]), nullptr);
+
+  // Integer arithmetic checks for overflow and is not fused.
+  exprSet = testFusion("c2 * c2 + c2", data);
+  ASSERT_EQ(asFused(exprSet->exprs()[0]), nullptr);
+}
+
+} // namespace
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/expression/LazyFunctionRegistration.h"
+#include "velox/expression/SimpleFunctionRegistry.h"
+#include "velox/functions/Udf.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+template <typename T>
+struct LazyPlusOneFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  void call(int64_t& result, const int64_t& input) {
+    result = input + 1;
+  }
+};
+
+TEST(LazyFunctionRegistrationTest, resolve) {
+  int32_t numRegistrations = 0;
+  registerFunctionsLazily([&]() {
+    ++numRegistrations;
+    registerFunction<LazyPlusOneFunction, int64_t, int64_t>(
+        {"lazy_plus_one"});
+  });
+  ASSERT_EQ(numRegistrations, 0);
+
+  auto resolved =
+      simpleFunctions().resolveFunction("lazy_plus_one", {BIGINT()});
+  ASSERT_EQ(numRegistrations, 1);
+  ASSERT_TRUE(resolved.has_value());
+  ASSERT_EQ(resolved->type()->toString(), "BIGINT");
+
+  // Registrations run once.
+  ASSERT_EQ(simpleFunctions().getFunctionSignatures("lazy_plus_one").size(), 1);
+  ASSERT_EQ(numRegistrations, 1);
+}
+
+TEST(LazyFunctionRegistrationTest, nested) {
+  std::vector<std::string> order;
+  registerFunctionsLazily([&]() {
+    order.push_back("outer");
+    // Lookups from within a registration see what is registered so far.
+    ASSERT_FALSE(simpleFunctions()
+                     .resolveFunction("lazy_nested_plus_one", {BIGINT()})
+                     .has_value());
+    registerFunctionsLazily([&]() {
+      order.push_back("inner");
+      registerFunction<LazyPlusOneFunction, int64_t, int64_t>(
+          {"lazy_nested_plus_one"});
+    });
+  });
+  registerFunctionsLazily([&]() { order.push_back("second"); });
+
+  ensureLazyFunctionsRegistered();
+  ASSERT_EQ(order, (std::vector<std::string>{"outer", "second", "inner"}));
+  ASSERT_TRUE(simpleFunctions()
+                  .resolveFunction("lazy_nested_plus_one", {BIGINT()})
+                  .has_value());
+}
+
+} // namespace
+} // namespace facebook::velox::exec
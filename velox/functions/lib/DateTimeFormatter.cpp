@@ -952,8 +952,157 @@ int32_t parseFromPattern(
   return 0;
 }
 
+// Writes the 2 digits of 'value', which is in [0, 99], to 'result'.
+inline void writeTwoDigits(int64_t value, char* result) {
+  result[0] = '0' + value / 10;
+  result[1] = '0' + value % 10;
+}
+
+// Returns the value of the 'size' digits at 'input', or -1 if one of these is
+// not a digit.
+inline int32_t readDigits(const char* input, int32_t size) {
+  int32_t value = 0;
+  for (auto i = 0; i < size; ++i) {
+    if (!characterIsDigit(input[i])) {
+      return -1;
+    }
+    value = value * 10 + (input[i] - '0');
+  }
+  return value;
+}
+
 } // namespace
 
+// static
+DateTimeFormatter::FixedLayout DateTimeFormatter::fixedLayoutOf(
+    const std::vector<DateTimeToken>& tokens) {
+  // The tokens at even positions are the fields and the ones at odd positions
+  // are the one character literals between these.
+  static const FormatPattern kFields[] = {
+      {DateTimeFormatSpecifier::YEAR, 4},
+      {DateTimeFormatSpecifier::MONTH_OF_YEAR, 2},
+      {DateTimeFormatSpecifier::DAY_OF_MONTH, 2},
+      {DateTimeFormatSpecifier::HOUR_OF_DAY, 2},
+      {DateTimeFormatSpecifier::MINUTE_OF_HOUR, 2},
+      {DateTimeFormatSpecifier::SECOND_OF_MINUTE, 2},
+      {DateTimeFormatSpecifier::FRACTION_OF_SECOND, 3}};
+  static const char kLiterals[] = {'-', '-', ' ', ':', ':', '.'};
+
+  FixedLayout layout;
+  if (tokens.size() != 5 && tokens.size() != 11 && tokens.size() != 13) {
+    return layout;
+  }
+  for (auto i = 0; i < tokens.size(); ++i) {
+    const auto& token = tokens[i];
+    if (i % 2 == 0) {
+      if (token.type != DateTimeToken::Type::kPattern) {
+        return {};
+      }
+      const auto& field = kFields[i / 2];
+      auto specifier = token.pattern.specifier;
+      if (i == 0 && specifier == DateTimeFormatSpecifier::YEAR_OF_ERA) {
+        // Years of era are formatted like years in [1, 9999].
+        layout.yearOfEra = true;
+        specifier = DateTimeFormatSpecifier::YEAR;
+      }
+      if (specifier != field.specifier ||
+          token.pattern.minRepresentDigits != field.minRepresentDigits) {
+        return {};
+      }
+    } else {
+      if (token.type != DateTimeToken::Type::kLiteral ||
+          token.literal.size() != 1) {
+        return {};
+      }
+      const auto literal = token.literal[0];
+      if (i == 5) {
+        if (literal != ' ' && literal != 'T') {
+          return {};
+        }
+        layout.separator = literal;
+      } else if (literal != kLiterals[i / 2]) {
+        return {};
+      }
+    }
+  }
+  layout.size = tokens.size() == 5 ? 10 : (tokens.size() == 11 ? 19 : 23);
+  return layout;
+}
+
+int32_t DateTimeFormatter::formatFixedLayout(
+    int32_t year,
+    uint32_t month,
+    uint32_t day,
+    int64_t hours,
+    int64_t minutes,
+    int64_t seconds,
+    int64_t millis,
+    char* result) const {
+  writeTwoDigits(year / 100, result);
+  writeTwoDigits(year % 100, result + 2);
+  result[4] = '-';
+  writeTwoDigits(month, result + 5);
+  result[7] = '-';
+  writeTwoDigits(day, result + 8);
+  if (fixedLayout_.size > 10) {
+    result[10] = fixedLayout_.separator;
+    writeTwoDigits(hours, result + 11);
+    result[13] = ':';
+    writeTwoDigits(minutes, result + 14);
+    result[16] = ':';
+    writeTwoDigits(seconds, result + 17);
+    if (fixedLayout_.size > 19) {
+      result[19] = '.';
+      result[20] = '0' + millis / 100;
+      writeTwoDigits(millis % 100, result + 21);
+    }
+  }
+  return fixedLayout_.size;
+}
+
+std::optional<DateTimeResult> DateTimeFormatter::parseFixedLayout(
+    const std::string_view& input) const {
+  const char* data = input.data();
+  const auto year = readDigits(data, 4);
+  const auto month = readDigits(data + 5, 2);
+  const auto day = readDigits(data + 8, 2);
+  if (data[4] != '-' || data[7] != '-' ||
+      year < (fixedLayout_.yearOfEra ? 1 : 0) || month < 1 || month > 12 ||
+      day < 1 || !util::isValidDate(year, month, day)) {
+    return std::nullopt;
+  }
+
+  int32_t hour = 0;
+  int32_t minute = 0;
+  int32_t second = 0;
+  int32_t millis = 0;
+  if (fixedLayout_.size > 10) {
+    hour = readDigits(data + 11, 2);
+    minute = readDigits(data + 14, 2);
+    second = readDigits(data + 17, 2);
+    if (data[10] != fixedLayout_.separator || data[13] != ':' ||
+        data[16] != ':' || hour < 0 || hour > 23 || minute < 0 ||
+        minute > 59 || second < 0 || second > 59) {
+      return std::nullopt;
+    }
+    if (fixedLayout_.size > 19) {
+      millis = readDigits(data + 20, 3);
+      if (data[19] != '.' || millis < 0) {
+        return std::nullopt;
+      }
+    }
+  }
+
+  int64_t daysSinceEpoch;
+  if (!util::daysSinceEpochFromDate(year, month, day, daysSinceEpoch).ok()) {
+    return std::nullopt;
+  }
+  const auto microsSinceMidnight =
+      util::fromTime(hour, minute, second, millis * util::kMicrosPerMsec);
+  return DateTimeResult{
+      util::fromDatetime(daysSinceEpoch, microsSinceMidnight), -1};
+}
+
 uint32_t DateTimeFormatter::maxResultSize(
     const date::time_zone* timezone) const {
   uint32_t size = 0;
@@ -1042,6 +1191,19 @@ int32_t DateTimeFormatter::format(
   const date::year_month_day calDate(daysTimePoint);
   const date::weekday weekday(daysTimePoint);
 
+  const auto year = static_cast<signed>(calDate.year());
+  if (fixedLayout_.size > 0 && year >= 1 && year <= 9999) {
+    return formatFixedLayout(
+        year,
+        static_cast<unsigned>(calDate.month()),
+        static_cast<unsigned>(calDate.day()),
+        durationInTheDay.hours().count(),
+        durationInTheDay.minutes().count() % 60,
+        durationInTheDay.seconds().count() % 60,
+        durationInTheDay.subseconds().count(),
+        result);
+  }
+
   const char* resultStart = result;
   char* maxResultEnd = result + maxResultSize;
   for (auto& token : tokens_) {
@@ -1269,6 +1431,12 @@ int32_t DateTimeFormatter::format(
 std::optional<DateTimeResult> DateTimeFormatter::parse(
     const std::string_view& input,
     const bool failOnError) const {
+  if (fixedLayout_.size > 0 && input.size() == fixedLayout_.size) {
+    if (auto result = parseFixedLayout(input)) {
+      return result;
+    }
+  }
+
   Date date;
   const char* cur = input.data();
   const char* end = cur + input.size();
@@ -159,7 +159,8 @@ class DateTimeFormatter {
       : literalBuf_(std::move(literalBuf)),
         bufSize_(bufSize),
         tokens_(std::move(tokens)),
-        type_(type) {}
+        type_(type),
+        fixedLayout_(fixedLayoutOf(tokens_)) {}
 
   const std::unique_ptr<char[]>& literalBuf() const {
     return literalBuf_;
@@ -197,10 +198,46 @@ class DateTimeFormatter {
       bool allowOverflow = false) const;
 
  private:
+  // Offsets of the fields of the formats 'yyyy-MM-dd', 'yyyy-MM-dd HH:mm:ss'
+  // and 'yyyy-MM-dd HH:mm:ss.SSS', where the space may also be a 'T'. Values
+  // in these formats are formatted and parsed without going through the
+  // tokens.
+  struct FixedLayout {
+    // Size of the formatted value. 0 if the tokens are not in a fixed layout.
+    int32_t size{0};
+
+    // Character between the date and the time of day.
+    char separator{' '};
+
+    // True if the year is a year of era, which can not be 0.
+    bool yearOfEra{false};
+  };
+
+  static FixedLayout fixedLayoutOf(const std::vector<DateTimeToken>& tokens);
+
+  // Writes the fields of 'fixedLayout_' to 'result'. 'year' is in [1, 9999].
+  // Returns the size of the result.
+  int32_t formatFixedLayout(
+      int32_t year,
+      uint32_t month,
+      uint32_t day,
+      int64_t hours,
+      int64_t minutes,
+      int64_t seconds,
+      int64_t millis,
+      char* result) const;
+
+  // Parses 'input' in 'fixedLayout_'. Returns std::nullopt if 'input' does
+  // not have digits in all fields or if a field is out of its range, so that
+  // the caller can report the error as parse() does for other formats.
+  std::optional<DateTimeResult> parseFixedLayout(
+      const std::string_view& input) const;
+
   std::unique_ptr<char[]> literalBuf_;
   size_t bufSize_;
   std::vector<DateTimeToken> tokens_;
   DateTimeFormatterType type_;
+  FixedLayout fixedLayout_;
 };
 
 std::shared_ptr<DateTimeFormatter> buildMysqlDateTimeFormatter(
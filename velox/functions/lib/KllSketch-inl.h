@@ -16,8 +16,8 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
-#include <queue>
 #include <type_traits>
 #include "velox/common/base/Exceptions.h"
 
@@ -429,7 +429,7 @@ template <typename T, typename A, typename C>
 void KllSketch<T, A, C>::compact() {
   finish();
   uint32_t k = 0;
-  std::vector<T> tmp;
+  std::vector<T, A> tmp(allocator_);
   auto beg = levels_[0];
   auto end = levels_[1];
   levels_[0] = 0;
@@ -623,37 +623,56 @@ void KllSketch<T, A, C>::mergeViews(const folly::Range<const View*>& others) {
     std::move(
         items_.data() + levels_[0], items_.data() + levels_[1], workbuf.data());
     worklevels[1] = safeLevelSize(0);
-    // Merge each level, each level in all sketches are already sorted.
+    // Merge each level, each level in all sketches are already sorted. The
+    // sorted runs of a level are merged with a heap of run cursors that is
+    // allocated once for all levels. One or two runs, e.g. when merging one
+    // sketch into another, are copied or merged directly.
+    using Entry = std::pair<const T*, const T*>;
+    using AllocEntry =
+        typename std::allocator_traits<A>::template rebind_alloc<Entry>;
+    auto gt = [](const Entry& x, const Entry& y) {
+      return C()(*y.first, *x.first);
+    };
+    std::vector<Entry, AllocEntry> runs{AllocEntry(allocator_)};
+    runs.reserve(others.size() + 1);
     for (uint8_t lvl = 1; lvl < provisionalNumLevels; ++lvl) {
-      using Entry = std::pair<const T*, const T*>;
-      using AllocEntry =
-          typename std::allocator_traits<A>::template rebind_alloc<Entry>;
-      auto gt = [](const Entry& x, const Entry& y) {
-        return C()(*y.first, *x.first);
-      };
-      std::priority_queue<Entry, std::vector<Entry, AllocEntry>, decltype(gt)>
-          pq(gt, AllocEntry(allocator_));
+      runs.clear();
       if (auto sz = safeLevelSize(lvl); sz > 0) {
-        pq.emplace(
+        runs.emplace_back(
             items_.data() + levels_[lvl], items_.data() + levels_[lvl] + sz);
       }
       for (auto& other : others) {
         if (auto sz = other.safeLevelSize(lvl); sz > 0) {
-          pq.emplace(
+          runs.emplace_back(
               &other.items[other.levels[lvl]],
               &other.items[other.levels[lvl]] + sz);
         }
       }
-      int outIndex = worklevels[lvl];
-      while (!pq.empty()) {
-        auto [s, t] = pq.top();
-        pq.pop();
-        workbuf[outIndex++] = *s++;
-        if (s < t) {
-          pq.emplace(s, t);
+      T* out = workbuf.data() + worklevels[lvl];
+      if (runs.size() == 1) {
+        out = std::copy(runs[0].first, runs[0].second, out);
+      } else if (runs.size() == 2) {
+        out = std::merge(
+            runs[0].first,
+            runs[0].second,
+            runs[1].first,
+            runs[1].second,
+            out,
+            C());
+      } else {
+        std::make_heap(runs.begin(), runs.end(), gt);
+        while (!runs.empty()) {
+          std::pop_heap(runs.begin(), runs.end(), gt);
+          auto& [s, t] = runs.back();
+          *out++ = *s++;
+          if (s < t) {
+            std::push_heap(runs.begin(), runs.end(), gt);
+          } else {
+            runs.pop_back();
+          }
         }
       }
-      worklevels[lvl + 1] = outIndex;
+      worklevels[lvl + 1] = out - workbuf.data();
     }
     auto result = detail::generalCompress<T, C>(
         k_,
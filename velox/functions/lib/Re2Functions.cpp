@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/functions/lib/Re2Functions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/functions/lib/string/StringImpl.h"
 
 #include <re2/re2.h>
@@ -640,9 +641,11 @@ bool matchSuffixPattern(
 bool matchSubstringPattern(
     const StringView& input,
     const std::string& fixedPattern) {
-  return (
-      std::string_view(input).find(std::string_view(fixedPattern)) !=
-      std::string::npos);
+  return simd::simdStrstr(
+             input.data(),
+             input.size(),
+             fixedPattern.data(),
+             fixedPattern.size()) != std::string::npos;
 }
 
 // Return true if the input VARCHAR argument is all-ASCII for the specified
@@ -1926,4 +1929,299 @@ re2ExtractAllSignatures() {
   };
 }
 
+Re2PatternSet::Re2PatternSet(std::vector<std::string> patterns)
+    : patterns_(std::move(patterns)) {
+  VELOX_CHECK(!patterns_.empty());
+  set_ = std::make_unique<RE2::Set>(RE2::Options(RE2::Quiet), RE2::UNANCHORED);
+  for (const auto& pattern : patterns_) {
+    std::string error;
+    if (set_->Add(toStringPiece(pattern), &error) < 0) {
+      VELOX_USER_FAIL("invalid regular expression:{}", error);
+    }
+  }
+  VELOX_USER_CHECK(set_->Compile(), "Regular expressions use too much memory");
+}
+
+void Re2PatternSet::match(std::string_view input, std::vector<int>& matches)
+    const {
+  RE2::Set::ErrorInfo error;
+  if (set_->Match(toStringPiece(input), &matches, &error) ||
+      error.kind == RE2::Set::kNoError) {
+    return;
+  }
+  VELOX_CHECK(
+      error.kind == RE2::Set::kOutOfMemory,
+      "Unexpected RE2::Set error: {}",
+      static_cast<int>(error.kind));
+  // Too many patterns for the DFA of the set. Match them one by one.
+  if (regexes_.empty()) {
+    for (const auto& pattern : patterns_) {
+      regexes_.push_back(
+          std::make_unique<RE2>(toStringPiece(pattern), RE2::Quiet));
+    }
+  }
+  matches.clear();
+  for (auto i = 0; i < regexes_.size(); ++i) {
+    if (RE2::PartialMatch(toStringPiece(input), *regexes_[i])) {
+      matches.push_back(i);
+    }
+  }
+}
+
+void Re2PatternSet::matchRows(
+    const SelectivityVector& rows,
+    const DecodedVector& strings,
+    std::vector<std::vector<uint64_t>>& bitmaps) const {
+  bitmaps.resize(patterns_.size());
+  for (auto& bitmap : bitmaps) {
+    bitmap.assign(bits::nwords(rows.end()), 0);
+  }
+  std::vector<int> matches;
+  rows.applyToSelected([&](vector_size_t row) {
+    if (strings.isNullAt(row)) {
+      return;
+    }
+    match(strings.valueAt<StringView>(row), matches);
+    for (auto pattern : matches) {
+      bits::setBit(bitmaps[pattern].data(), row);
+    }
+  });
+}
+
+namespace {
+
+template <bool matchAll>
+class Re2SearchSet final : public exec::VectorFunction {
+ public:
+  explicit Re2SearchSet(std::vector<std::string> patterns)
+      : patterns_(std::move(patterns)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      exec::EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    exec::LocalDecodedVector strings(context, *args[0], rows);
+    FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
+    patterns_.matchRows(rows, *strings, bitmaps_);
+
+    auto& matches = bitmaps_[0];
+    for (auto i = 1; i < bitmaps_.size(); ++i) {
+      if (matchAll) {
+        bits::andBits(matches.data(), bitmaps_[i].data(), 0, rows.end());
+      } else {
+        bits::orBits(matches.data(), bitmaps_[i].data(), 0, rows.end());
+      }
+    }
+    rows.applyToSelected([&](vector_size_t row) {
+      result.set(row, bits::isBitSet(matches.data(), row));
+    });
+  }
+
+ private:
+  const Re2PatternSet patterns_;
+
+  // Per pattern bitmaps of the rows that match it. Reused between batches.
+  mutable std::vector<std::vector<uint64_t>> bitmaps_;
+};
+
+template <bool matchAll>
+std::shared_ptr<exec::VectorFunction> makeRe2SearchSet(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs) {
+  VELOX_USER_CHECK_GE(inputArgs.size(), 2, "{} requires patterns", name);
+  std::vector<std::string> patterns;
+  for (auto i = 1; i < inputArgs.size(); ++i) {
+    const auto* constant = inputArgs[i].constantValue.get();
+    VELOX_USER_CHECK(
+        constant != nullptr && !constant->isNullAt(0),
+        "{} requires constant, non-null patterns",
+        name);
+    patterns.emplace_back(
+        constant->as<ConstantVector<StringView>>()->valueAt(0));
+  }
+  return std::make_shared<Re2SearchSet<matchAll>>(std::move(patterns));
+}
+
+std::optional<std::string> getConstantString(const core::TypedExprPtr& expr) {
+  auto constant = dynamic_cast<const core::ConstantTypedExpr*>(expr.get());
+  if (constant == nullptr || !constant->type()->isVarchar()) {
+    return std::nullopt;
+  }
+  if (constant->hasValueVector()) {
+    const auto& vector = constant->valueVector();
+    if (vector->isNullAt(0)) {
+      return std::nullopt;
+    }
+    return std::string(vector->as<SimpleVector<StringView>>()->valueAt(0));
+  }
+  if (constant->value().isNull()) {
+    return std::nullopt;
+  }
+  return constant->value().value<TypeKind::VARCHAR>();
+}
+
+// Returns the regular expression to add to a Re2PatternSet for 'call' if it is
+// a LIKE without a fast path or a regexp_like with a valid constant pattern.
+std::optional<std::string> toPatternSetRegex(
+    const std::string& prefix,
+    const core::CallTypedExpr& call) {
+  const auto& inputs = call.inputs();
+  if (inputs.size() < 2 || !inputs[0]->type()->isVarchar()) {
+    return std::nullopt;
+  }
+  const auto pattern = getConstantString(inputs[1]);
+  if (!pattern.has_value()) {
+    return std::nullopt;
+  }
+
+  if (call.name() == prefix + "regexp_like" && inputs.size() == 2) {
+    RE2 re(toStringPiece(pattern.value()), RE2::Quiet);
+    if (!re.ok()) {
+      return std::nullopt;
+    }
+    return pattern;
+  }
+
+  if (call.name() != prefix + "like" || inputs.size() > 3) {
+    return std::nullopt;
+  }
+  std::optional<char> escapeChar;
+  if (inputs.size() == 3) {
+    const auto escape = getConstantString(inputs[2]);
+    if (!escape.has_value() || escape->size() != 1) {
+      return std::nullopt;
+    }
+    escapeChar = escape.value()[0];
+  }
+  try {
+    if (determinePatternKind(pattern.value(), escapeChar).patternKind() !=
+        PatternKind::kGeneric) {
+      return std::nullopt;
+    }
+  } catch (const VeloxUserError&) {
+    return std::nullopt;
+  }
+  bool validPattern;
+  auto regex =
+      likePatternToRe2(StringView(pattern.value()), escapeChar, validPattern);
+  if (!validPattern) {
+    return std::nullopt;
+  }
+  // LIKE wildcards match new lines.
+  return "(?s)" + regex;
+}
+
+void flattenConjunct(
+    const core::TypedExprPtr& expr,
+    const std::string& name,
+    std::vector<core::TypedExprPtr>& inputs) {
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->name() != name) {
+    inputs.push_back(expr);
+    return;
+  }
+  for (const auto& input : call->inputs()) {
+    flattenConjunct(input, name, inputs);
+  }
+}
+
+} // namespace
+
+std::shared_ptr<exec::VectorFunction> makeRe2SearchAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  return makeRe2SearchSet<false>(name, inputArgs);
+}
+
+std::shared_ptr<exec::VectorFunction> makeRe2SearchAll(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  return makeRe2SearchSet<true>(name, inputArgs);
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchSetSignatures() {
+  // varchar, varchar... -> boolean
+  return {exec::FunctionSignatureBuilder()
+              .returnType("boolean")
+              .argumentType("varchar")
+              .constantArgumentType("varchar")
+              .variableArity()
+              .build()};
+}
+
+core::TypedExprPtr rewriteRegexpConjunct(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr) {
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || (call->name() != "or" && call->name() != "and")) {
+    return nullptr;
+  }
+  std::vector<core::TypedExprPtr> inputs;
+  flattenConjunct(expr, call->name(), inputs);
+
+  // The strings that are matched and the regular expressions for each.
+  std::vector<core::TypedExprPtr> strings;
+  std::vector<std::vector<std::string>> regexes;
+  std::vector<int32_t> stringOfInput(inputs.size(), -1);
+  for (auto i = 0; i < inputs.size(); ++i) {
+    auto input = dynamic_cast<const core::CallTypedExpr*>(inputs[i].get());
+    if (input == nullptr) {
+      continue;
+    }
+    auto regex = toPatternSetRegex(prefix, *input);
+    if (!regex.has_value()) {
+      continue;
+    }
+    const auto& string = input->inputs()[0];
+    auto it = std::find_if(strings.begin(), strings.end(), [&](auto& other) {
+      return *other == *string;
+    });
+    stringOfInput[i] = it - strings.begin();
+    if (it == strings.end()) {
+      strings.push_back(string);
+      regexes.emplace_back();
+    }
+    regexes[stringOfInput[i]].push_back(std::move(regex.value()));
+  }
+
+  // Replaces the first call on each string with enough patterns with the
+  // call on the set and drops the others.
+  std::vector<core::TypedExprPtr> newInputs;
+  std::vector<bool> added(strings.size(), false);
+  bool rewritten = false;
+  for (auto i = 0; i < inputs.size(); ++i) {
+    const auto string = stringOfInput[i];
+    if (string < 0 || regexes[string].size() < kMinPatternSetSize) {
+      newInputs.push_back(inputs[i]);
+      continue;
+    }
+    rewritten = true;
+    if (added[string]) {
+      continue;
+    }
+    added[string] = true;
+    std::vector<core::TypedExprPtr> setInputs{strings[string]};
+    for (const auto& regex : regexes[string]) {
+      setInputs.push_back(
+          std::make_shared<core::ConstantTypedExpr>(VARCHAR(), variant(regex)));
+    }
+    newInputs.push_back(std::make_shared<core::CallTypedExpr>(
+        BOOLEAN(),
+        std::move(setInputs),
+        call->name() == "or" ? kRegexpLikeAny : kRegexpLikeAll));
+  }
+  if (!rewritten) {
+    return nullptr;
+  }
+  if (newInputs.size() == 1) {
+    return newInputs[0];
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(), std::move(newInputs), call->name());
+}
+
 } // namespace facebook::velox::functions
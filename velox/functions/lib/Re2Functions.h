@@ -19,6 +19,7 @@
 #include <vector>
 
 #include <re2/re2.h>
+#include <re2/set.h>
 
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/Udf.h"
@@ -173,6 +174,76 @@ std::shared_ptr<exec::VectorFunction> makeRe2Search(
 
 std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchSignatures();
 
+/// Matches strings against many regular expressions in one pass over each
+/// string with RE2::Set, instead of one pass per expression. Matches are
+/// searches like in regexp_like. Patterns that need other options set them
+/// with flags, e.g. (?s).
+class Re2PatternSet {
+ public:
+  /// Throws a user error if any of 'patterns' is invalid.
+  explicit Re2PatternSet(std::vector<std::string> patterns);
+
+  int32_t size() const {
+    return patterns_.size();
+  }
+
+  /// Sets 'matches' to the indices of the patterns that match 'input'.
+  void match(std::string_view input, std::vector<int>& matches) const;
+
+  /// Sets bit 'row' of 'bitmaps[i]' for the selected rows of 'strings' that
+  /// match pattern 'i'. 'bitmaps' has one bitmap of rows.end() bits per
+  /// pattern. Null rows match no pattern.
+  void matchRows(
+      const SelectivityVector& rows,
+      const DecodedVector& strings,
+      std::vector<std::vector<uint64_t>>& bitmaps) const;
+
+ private:
+  const std::vector<std::string> patterns_;
+  std::unique_ptr<RE2::Set> set_;
+
+  // One RE2 per pattern, compiled on first use if the DFA of 'set_' runs out
+  // of memory.
+  mutable std::vector<std::unique_ptr<RE2>> regexes_;
+};
+
+/// $internal$regexp_like_any(string, pattern1, pattern2, ...) → bool
+/// $internal$regexp_like_all(string, pattern1, pattern2, ...) → bool
+///
+/// Returns whether string has substrings that match any, respectively all, of
+/// the constant regular expressions. Evaluated with a Re2PatternSet. Produced
+/// by rewriteRegexpConjunct.
+std::shared_ptr<exec::VectorFunction> makeRe2SearchAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+std::shared_ptr<exec::VectorFunction> makeRe2SearchAll(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchSetSignatures();
+
+/// Names of the functions made by makeRe2SearchAny and makeRe2SearchAll.
+constexpr const char* kRegexpLikeAny = "$internal$regexp_like_any";
+constexpr const char* kRegexpLikeAll = "$internal$regexp_like_all";
+
+/// Minimum number of patterns on the same string that rewriteRegexpConjunct
+/// matches with one Re2PatternSet.
+constexpr int32_t kMinPatternSetSize = 3;
+
+/// Expression rewrite that replaces the calls to '<prefix>regexp_like' and
+/// '<prefix>like' with constant patterns under an OR, respectively AND, with
+/// one call to kRegexpLikeAny, respectively kRegexpLikeAll, per string that
+/// has at least kMinPatternSetSize such calls. LIKE patterns that have a fast
+/// path or that are invalid stay as they are, and so do invalid regular
+/// expressions, so that errors do not change. Returns nullptr if 'expr' is
+/// not rewritten.
+core::TypedExprPtr rewriteRegexpConjunct(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr);
+
 /// re2Extract(string, pattern, group_id) → string
 /// re2Extract(string, pattern) → string
 ///
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Nulls.h"
+#include "velox/common/memory/HashStringAllocator.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::aggregate {
+
+/// Represents a list of values, including nulls, of a fixed width type of
+/// 'kWidth' bytes, e.g. the elements of array_agg(bigint). Unlike ValueList,
+/// which serializes each value into a stream, the values are kept in a chain
+/// of contiguous chunks whose capacity doubles from kMinCapacity values up to
+/// about 1KB. An append allocates only when the last chunk is full and reading
+/// copies each chunk with one memcpy. Booleans are not supported since flat
+/// vectors store them as bits.
+template <int32_t kWidth>
+class FixedWidthValueList {
+ public:
+  static constexpr int32_t kMinCapacity = 4;
+  static constexpr int32_t kMaxCapacity = std::max(1024 / kWidth, kMinCapacity);
+
+  void appendValue(
+      const DecodedVector& decoded,
+      vector_size_t index,
+      HashStringAllocator* allocator) {
+    auto* chunk = prepareAppend(allocator);
+    if (decoded.isNullAt(index)) {
+      bits::clearBit(chunk->nulls(), chunk->size);
+    } else {
+      bits::setBit(chunk->nulls(), chunk->size);
+      memcpy(
+          chunk->value(chunk->size),
+          decoded.data<char>() + decoded.index(index) * kWidth,
+          kWidth);
+    }
+    ++chunk->size;
+    ++size_;
+  }
+
+  /// Appends the values at rows [offset, offset + size) of 'decoded'.
+  void appendRange(
+      const DecodedVector& decoded,
+      vector_size_t offset,
+      vector_size_t size,
+      HashStringAllocator* allocator) {
+    if (!decoded.isIdentityMapping() || decoded.mayHaveNulls()) {
+      for (auto i = offset; i < offset + size; ++i) {
+        appendValue(decoded, i, allocator);
+      }
+      return;
+    }
+    const auto* values = decoded.data<char>();
+    while (size > 0) {
+      auto* chunk = prepareAppend(allocator);
+      const auto numValues = std::min(size, chunk->capacity - chunk->size);
+      bits::fillBits(
+          chunk->nulls(), chunk->size, chunk->size + numValues, bits::kNotNull);
+      memcpy(
+          chunk->value(chunk->size),
+          values + offset * kWidth,
+          numValues * kWidth);
+      chunk->size += numValues;
+      size_ += numValues;
+      offset += numValues;
+      size -= numValues;
+    }
+  }
+
+  int32_t size() const {
+    return size_;
+  }
+
+  /// Copies the values to rows [offset, offset + size()) of 'output', which
+  /// is a flat vector of the value type.
+  void read(BaseVector& output, vector_size_t offset) const {
+    auto* rawValues = output.values()->template asMutable<char>();
+    for (auto* chunk = first_; chunk != nullptr; chunk = chunk->next) {
+      memcpy(
+          rawValues + offset * kWidth, chunk->value(0), chunk->size * kWidth);
+      if (output.rawNulls() != nullptr || hasNulls(chunk)) {
+        bits::copyBits(
+            chunk->nulls(), 0, output.mutableRawNulls(), offset, chunk->size);
+      }
+      offset += chunk->size;
+    }
+  }
+
+  void free(HashStringAllocator* allocator) {
+    auto* chunk = first_;
+    while (chunk != nullptr) {
+      auto* next = chunk->next;
+      allocator->free(HashStringAllocator::headerOf(chunk));
+      chunk = next;
+    }
+    first_ = nullptr;
+    last_ = nullptr;
+    size_ = 0;
+  }
+
+  /// Copies the values to one chunk in 'allocator'. The previous chunks are
+  /// not freed. Used for compacting accumulators into a new
+  /// HashStringAllocator.
+  void relocate(HashStringAllocator* allocator) {
+    if (size_ == 0) {
+      return;
+    }
+    auto* relocated = newChunk(size_, allocator);
+    for (auto* chunk = first_; chunk != nullptr; chunk = chunk->next) {
+      bits::copyBits(
+          chunk->nulls(), 0, relocated->nulls(), relocated->size, chunk->size);
+      memcpy(
+          relocated->value(relocated->size),
+          chunk->value(0),
+          chunk->size * kWidth);
+      relocated->size += chunk->size;
+    }
+    first_ = relocated;
+    last_ = relocated;
+  }
+
+ private:
+  // Header of a chunk, followed by the null flags and the values. A set null
+  // flag means not null, as in vectors.
+  struct Chunk {
+    Chunk* next;
+    int32_t capacity;
+    int32_t size;
+
+    uint64_t* nulls() {
+      return reinterpret_cast<uint64_t*>(this + 1);
+    }
+
+    const uint64_t* nulls() const {
+      return reinterpret_cast<const uint64_t*>(this + 1);
+    }
+
+    char* value(int32_t index) {
+      return reinterpret_cast<char*>(nulls() + bits::nwords(capacity)) +
+          index * kWidth;
+    }
+
+    const char* value(int32_t index) const {
+      return reinterpret_cast<const char*>(nulls() + bits::nwords(capacity)) +
+          index * kWidth;
+    }
+  };
+
+  static bool hasNulls(const Chunk* chunk) {
+    return !bits::isAllSet(chunk->nulls(), 0, chunk->size, bits::kNotNull);
+  }
+
+  static Chunk* newChunk(int32_t capacity, HashStringAllocator* allocator) {
+    auto* header = allocator->allocate(
+        sizeof(Chunk) + bits::nwords(capacity) * sizeof(uint64_t) +
+        capacity * kWidth);
+    auto* chunk = reinterpret_cast<Chunk*>(header->begin());
+    chunk->next = nullptr;
+    chunk->capacity = capacity;
+    chunk->size = 0;
+    return chunk;
+  }
+
+  // Returns the last chunk after adding a chunk if the last one is full.
+  Chunk* prepareAppend(HashStringAllocator* allocator) {
+    if (last_ == nullptr) {
+      first_ = newChunk(kMinCapacity, allocator);
+      last_ = first_;
+    } else if (last_->size == last_->capacity) {
+      auto* chunk = newChunk(
+          std::clamp(last_->capacity * 2, kMinCapacity, kMaxCapacity),
+          allocator);
+      last_->next = chunk;
+      last_ = chunk;
+    }
+    return last_;
+  }
+
+  Chunk* first_{nullptr};
+  Chunk* last_{nullptr};
+
+  // Number of values added, including nulls.
+  int32_t size_{0};
+};
+
+} // namespace facebook::velox::aggregate
@@ -225,7 +225,62 @@ class SimpleNumericAggregate : public exec::Aggregate {
         RowSet(indices, numIndices), &hook);
   }
 
- private:
+  /// Number of independent accumulators of reduceFlat(). Consecutive values go
+  /// to different accumulators, so that the updates of a run of values do not
+  /// depend on each other and can be vectorized.
+  static constexpr int32_t kNumLanes = 4;
+
+  /// Calls update(lane, value) with 0 <= lane < kNumLanes for the non-null
+  /// values of 'vector' at 'rows' and returns their number. Words of 64 rows
+  /// that are all selected and not null are updated without looking at the
+  /// bits. Other words within the vector are updated with 'identity' in place
+  /// of the unselected and null rows instead of branching on each row, so that
+  /// update(lane, identity) must not change the accumulator of 'lane'.
+  template <typename T, typename Update>
+  static vector_size_t reduceFlat(
+      const FlatVector<T>& vector,
+      const SelectivityVector& rows,
+      T identity,
+      Update update) {
+    const auto* values = vector.rawValues();
+    const auto* nulls = vector.rawNulls();
+    const auto* selected = rows.asRange().bits();
+    vector_size_t count = 0;
+    bits::forEachWord(
+        rows.begin(), rows.end(), [&](int32_t index, uint64_t mask) {
+          auto word = selected[index] & mask;
+          if (nulls) {
+            word &= nulls[index];
+          }
+          const auto* run = values + index * 64;
+          if (word == bits::kNotNull64) {
+            for (auto i = 0; i < 64; i += kNumLanes) {
+              for (auto lane = 0; lane < kNumLanes; ++lane) {
+                update(lane, run[i + lane]);
+              }
+            }
+            count += 64;
+            return;
+          }
+          count += __builtin_popcountll(word);
+          if (index * 64 + 64 <= vector.size()) {
+            for (auto i = 0; i < 64; i += kNumLanes) {
+              for (auto lane = 0; lane < kNumLanes; ++lane) {
+                update(
+                    lane,
+                    (word >> (i + lane)) & 1 ? run[i + lane] : identity);
+              }
+            }
+            return;
+          }
+          while (word) {
+            update(0, run[__builtin_ctzll(word)]);
+            word &= word - 1;
+          }
+        });
+    return count;
+  }
+
   // TData is either TAccumulator or TResult, which in most cases are the same,
   // but for sum(real) can differ.
   template <
@@ -83,6 +83,9 @@ class SumAggregateBase
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
+    if (addSingleGroupFlatInput<TInput>(group, rows, args[0])) {
+      return;
+    }
     BaseAggregate::template updateOneGroup<TAccumulator>(
         group,
         rows,
@@ -98,6 +101,9 @@ class SumAggregateBase
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
+    if (addSingleGroupFlatInput<TAccumulator>(group, rows, args[0])) {
+      return;
+    }
     BaseAggregate::template updateOneGroup<TAccumulator, TAccumulator>(
         group,
         rows,
@@ -109,6 +115,67 @@ class SumAggregateBase
   }
 
  protected:
+  // Adds the flat integer values of 'arg' at 'rows' to 'group' with a partial
+  // sum per lane. Returns false without updating if 'arg' is not flat or not
+  // of an integer type, or if a checked sum in row order might overflow. In
+  // the latter case the caller adds in row order to throw like it would
+  // otherwise. Each partial sum in row order differs from the sum in 'group'
+  // by at most the number of values times the largest magnitude of a value.
+  template <typename TValue>
+  bool addSingleGroupFlatInput(
+      char* group,
+      const SelectivityVector& rows,
+      const VectorPtr& arg) {
+    if constexpr (
+        std::is_integral_v<TValue> && !std::is_same_v<TValue, bool> &&
+        std::is_same_v<TAccumulator, int64_t>) {
+      if (!arg->isFlatEncoding()) {
+        return false;
+      }
+      // The sums wrap around on overflow.
+      uint64_t sums[BaseAggregate::kNumLanes] = {};
+      TValue mins[BaseAggregate::kNumLanes] = {};
+      TValue maxs[BaseAggregate::kNumLanes] = {};
+      const auto count = BaseAggregate::template reduceFlat<TValue>(
+          *arg->asUnchecked<FlatVector<TValue>>(),
+          rows,
+          TValue(0),
+          [&](int32_t lane, TValue value) {
+            sums[lane] += static_cast<uint64_t>(static_cast<int64_t>(value));
+            mins[lane] = std::min(mins[lane], value);
+            maxs[lane] = std::max(maxs[lane], value);
+          });
+      if (count == 0) {
+        return true;
+      }
+      uint64_t sum = 0;
+      TValue min = 0;
+      TValue max = 0;
+      for (auto lane = 0; lane < BaseAggregate::kNumLanes; ++lane) {
+        sum += sums[lane];
+        min = std::min(min, mins[lane]);
+        max = std::max(max, maxs[lane]);
+      }
+      if constexpr (!Overflow) {
+        const auto bound = count *
+            std::max(-static_cast<int128_t>(min), static_cast<int128_t>(max));
+        const int128_t current =
+            *exec::Aggregate::value<TAccumulator>(group);
+        if (current + bound > std::numeric_limits<int64_t>::max() ||
+            current - bound < std::numeric_limits<int64_t>::min()) {
+          return false;
+        }
+      }
+      BaseAggregate::template updateNonNullValue<true, TAccumulator>(
+          group,
+          static_cast<TAccumulator>(sum),
+          &updateSingleValue<TAccumulator>);
+      return true;
+    } else {
+      return false;
+    }
+  }
+
   // TData is used to store the updated sum state. It can be either
   // TAccumulator or TResult, which in most cases are the same, but for
   // sum(real) can differ. TValue is used to decode the sum input 'args'.
@@ -102,6 +102,24 @@ void ValueList::appendRange(
   }
 }
 
+void ValueList::relocate(HashStringAllocator* allocator) {
+  if (nullsBegin_) {
+    // Keeps space for another word of null flags, see prepareAppend().
+    const auto positions = allocator->relocate(
+        nullsBegin_,
+        HashStringAllocator::offset(nullsBegin_, nullsCurrent_),
+        sizeof(int64_t));
+    nullsBegin_ = positions.first.header;
+    nullsCurrent_ = positions.second;
+  }
+  if (dataBegin_) {
+    const auto positions = allocator->relocate(
+        dataBegin_, HashStringAllocator::offset(dataBegin_, dataCurrent_), 0);
+    dataBegin_ = positions.first.header;
+    dataCurrent_ = positions.second;
+  }
+}
+
 ValueListReader::ValueListReader(ValueList& values)
     : size_{values.size()},
       lastNullsStart_{size_ % 64 == 0 ? size_ - 64 : size_ - size_ % 64},
@@ -78,6 +78,11 @@ class ValueList {
     }
   }
 
+  // Copies the values to contiguous allocations in 'allocator'. The previous
+  // allocations are not freed. Used for compacting accumulators into a new
+  // HashStringAllocator.
+  void relocate(HashStringAllocator* allocator);
+
  private:
   // An array_agg or related begins with an allocation of 5 words and
   // 4 bytes for header. This is compact for small arrays (up to 5
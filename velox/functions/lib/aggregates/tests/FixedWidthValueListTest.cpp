@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/lib/aggregates/FixedWidthValueList.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::test;
+
+namespace {
+
+class FixedWidthValueListTest : public functions::test::FunctionBaseTest {
+ protected:
+  static constexpr vector_size_t kTestSizes[6] =
+      {1, 10, 64, 1'000, 1'024, 5'000};
+
+  template <int32_t kWidth>
+  VectorPtr read(
+      const aggregate::FixedWidthValueList<kWidth>& values,
+      const TypePtr& type) {
+    // Reads at an offset into a vector with nulls to check that the null
+    // flags of the values are set.
+    auto result = BaseVector::create(type, values.size() + 3, pool());
+    for (auto i = 0; i < result->size(); ++i) {
+      result->setNull(i, true);
+    }
+    values.read(*result, 3);
+    return result->slice(3, values.size());
+  }
+
+  template <int32_t kWidth>
+  void testRoundTrip(const VectorPtr& data) {
+    SCOPED_TRACE(data->toString());
+    const auto size = data->size();
+    DecodedVector decoded(*data);
+
+    aggregate::FixedWidthValueList<kWidth> values;
+    for (auto i = 0; i < size; ++i) {
+      values.appendValue(decoded, i, allocator());
+    }
+    ASSERT_EQ(values.size(), size);
+    assertEqualVectors(data, read(values, data->type()));
+    values.free(allocator());
+
+    // Appends in ranges that do not line up with the chunks.
+    for (vector_size_t offset = 0; offset < size;) {
+      const auto numValues = std::min(size - offset, offset % 13 + 1);
+      values.appendRange(decoded, offset, numValues, allocator());
+      offset += numValues;
+    }
+    ASSERT_EQ(values.size(), size);
+    assertEqualVectors(data, read(values, data->type()));
+
+    // Relocates to a new allocator and keeps appending.
+    auto newAllocator = std::make_unique<HashStringAllocator>(pool_.get());
+    values.relocate(newAllocator.get());
+    allocator_ = std::move(newAllocator);
+    assertEqualVectors(data, read(values, data->type()));
+    values.appendRange(decoded, 0, size, allocator());
+    ASSERT_EQ(values.size(), 2 * size);
+    auto expected = BaseVector::create(data->type(), 2 * size, pool());
+    expected->copy(data.get(), 0, 0, size);
+    expected->copy(data.get(), size, 0, size);
+    assertEqualVectors(expected, read(values, data->type()));
+
+    values.free(allocator());
+    ASSERT_EQ(values.size(), 0);
+    ASSERT_TRUE(allocator()->isEmpty());
+  }
+
+  HashStringAllocator* allocator() {
+    return allocator_.get();
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool()};
+  std::unique_ptr<HashStringAllocator> allocator_{
+      std::make_unique<HashStringAllocator>(pool_.get())};
+};
+
+TEST_F(FixedWidthValueListTest, empty) {
+  aggregate::FixedWidthValueList<8> values;
+  ASSERT_EQ(values.size(), 0);
+  auto result = read(values, BIGINT());
+  ASSERT_EQ(result->size(), 0);
+  values.free(allocator());
+}
+
+TEST_F(FixedWidthValueListTest, integers) {
+  for (auto size : kTestSizes) {
+    testRoundTrip<8>(
+        makeFlatVector<int64_t>(size, [](auto row) { return row * 7; }));
+    testRoundTrip<2>(makeFlatVector<int16_t>(
+        size, [](auto row) { return row % 1000; }, nullEvery(7)));
+    testRoundTrip<1>(makeFlatVector<int8_t>(
+        size, [](auto row) { return row % 100; }, nullEvery(2)));
+    testRoundTrip<16>(makeFlatVector<int128_t>(
+        size, [](auto row) { return HugeInt::build(row, row * 3); }));
+  }
+}
+
+TEST_F(FixedWidthValueListTest, encodings) {
+  for (auto size : kTestSizes) {
+    auto base = makeFlatVector<double>(
+        size, [](auto row) { return row / 3.0; }, nullEvery(5));
+    auto indices = makeIndicesInReverse(size);
+    testRoundTrip<8>(wrapInDictionary(indices, size, base));
+    testRoundTrip<4>(makeConstant<int32_t>(11, size));
+    testRoundTrip<4>(makeNullConstant(TypeKind::INTEGER, size));
+    testRoundTrip<16>(makeFlatVector<Timestamp>(
+        size, [](auto row) { return Timestamp(row, row * 1'000); }));
+  }
+}
+
+} // namespace
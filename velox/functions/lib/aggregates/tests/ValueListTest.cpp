@@ -141,3 +141,32 @@ TEST_F(ValueListTest, arrays) {
     }
   }
 }
+
+TEST_F(ValueListTest, relocate) {
+  for (auto size : kTestSizes) {
+    auto data = makeFlatVector<std::string>(
+        2 * size,
+        [](auto row) { return std::string(row % 37, 'a' + row % 26); },
+        test::VectorMaker::nullEvery(7));
+    DecodedVector decoded(*data);
+    aggregate::ValueList values;
+    for (auto i = 0; i < size; ++i) {
+      values.appendValue(decoded, i, allocator());
+    }
+
+    // Relocates to a new allocator and frees the previous one.
+    auto newAllocator = std::make_unique<HashStringAllocator>(pool_.get());
+    values.relocate(newAllocator.get());
+    allocator_ = std::move(newAllocator);
+    assertEqualVectors(data->slice(0, size), read(values, VARCHAR(), size));
+
+    // Keeps appending after the relocation.
+    for (auto i = size; i < data->size(); ++i) {
+      values.appendValue(decoded, i, allocator());
+    }
+    ASSERT_EQ(values.size(), data->size());
+    assertEqualVectors(data, read(values, VARCHAR(), data->size()));
+    values.free(allocator());
+    ASSERT_TRUE(allocator()->isEmpty());
+  }
+}
@@ -20,6 +20,7 @@
 #include <string_view>
 #include "folly/CPortability.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/external/utf8proc/utf8procImpl.h"
 
 #if (ENABLE_VECTORIZATION > 0) && !defined(_DEBUG) && !defined(DEBUG)
@@ -306,7 +307,14 @@ static inline int64_t findNthInstanceByteIndexFromStart(
     return -1;
   }
 
-  auto byteIndex = string.find(subString, startPosition);
+  auto byteIndex = simd::simdStrstr(
+      string.data() + startPosition,
+      string.size() - startPosition,
+      subString.data(),
+      subString.size());
+  if (byteIndex != std::string_view::npos) {
+    byteIndex += startPosition;
+  }
   // Not found
   if (byteIndex == std::string_view::npos) {
     return -1;
@@ -1404,6 +1404,71 @@ TEST_F(JodaDateTimeFormatterTest, betterErrorMessaging) {
       "Value 429 for dayOfMonth must be in the range [1,365] for year 2057 and month 2.");
 }
 
+// Formats with the fields at fixed offsets are formatted and parsed without
+// going through the tokens if the values fit. Others take the general path.
+TEST_F(JodaDateTimeFormatterTest, fixedLayout) {
+  auto format = [](const std::string& pattern, const Timestamp& timestamp) {
+    auto formatter = buildJodaDateTimeFormatter(pattern);
+    const auto maxSize = formatter->maxResultSize(nullptr);
+    std::string result(maxSize, '\0');
+    result.resize(
+        formatter->format(timestamp, nullptr, maxSize, result.data()));
+    return result;
+  };
+
+  const Timestamp timestamp(1'700'000'000, 123'000'000);
+  EXPECT_EQ(format("yyyy-MM-dd", timestamp), "2023-11-14");
+  EXPECT_EQ(format("YYYY-MM-dd", timestamp), "2023-11-14");
+  EXPECT_EQ(format("yyyy-MM-dd HH:mm:ss", timestamp), "2023-11-14 22:13:20");
+  EXPECT_EQ(
+      format("yyyy-MM-dd'T'HH:mm:ss.SSS", timestamp),
+      "2023-11-14T22:13:20.123");
+  EXPECT_EQ(
+      format("yyyy-MM-dd HH:mm:ss.SSS", Timestamp(0, 7'000'000)),
+      "1970-01-01 00:00:00.007");
+  EXPECT_EQ(
+      formatMysqlDateTime("%Y-%m-%d %H:%i:%s", timestamp, nullptr),
+      "2023-11-14 22:13:20");
+
+  // Years outside of [1, 9999].
+  EXPECT_EQ(format("yyyy-MM-dd", Timestamp(253'402'300'800, 0)), "10000-01-01");
+  EXPECT_EQ(format("yyyy-MM-dd", Timestamp(-62'167'219'200, 0)), "0000-01-01");
+  EXPECT_EQ(format("YYYY-MM-dd", Timestamp(-62'167'219'200, 0)), "0001-01-01");
+
+  EXPECT_EQ(
+      parseJoda("2023-11-14", "yyyy-MM-dd").timestamp,
+      Timestamp(1'699'920'000, 0));
+  EXPECT_EQ(parseJoda("2023-11-14", "yyyy-MM-dd").timezoneId, -1);
+  EXPECT_EQ(
+      parseJoda("2023-11-14 22:13:20", "yyyy-MM-dd HH:mm:ss").timestamp,
+      Timestamp(1'700'000'000, 0));
+  EXPECT_EQ(
+      parseJoda("2023-11-14T22:13:20.123", "yyyy-MM-dd'T'HH:mm:ss.SSS")
+          .timestamp,
+      timestamp);
+  EXPECT_EQ(
+      parseMysql("2023-11-14 22:13:20", "%Y-%m-%d %H:%i:%s"),
+      Timestamp(1'700'000'000, 0));
+
+  // Values that do not fit the layout.
+  EXPECT_EQ(
+      parseJoda("2023-1-5", "yyyy-MM-dd").timestamp,
+      parseJoda("2023-01-05", "yyyy-MM-dd").timestamp);
+  VELOX_ASSERT_THROW(
+      parseJoda("2023-02-30", "yyyy-MM-dd"),
+      "Value 30 for dayOfMonth must be in the range [1,28] for year 2023 and month 2.");
+  auto formatter = buildJodaDateTimeFormatter("yyyy-MM-dd HH:mm:ss");
+  EXPECT_FALSE(formatter->parse("2023-11-14 24:00:00").has_value());
+  EXPECT_FALSE(formatter->parse("2023-11-14T22:13:20").has_value());
+  EXPECT_FALSE(formatter->parse("2023-11-14 22:13:2x").has_value());
+  EXPECT_FALSE(buildJodaDateTimeFormatter("YYYY-MM-dd")
+                   ->parse("0000-01-01")
+                   .has_value());
+  EXPECT_EQ(
+      parseJoda("0000-01-01", "yyyy-MM-dd").timestamp,
+      Timestamp(-62'167'219'200, 0));
+}
+
 class MysqlDateTimeTest : public DateTimeFormatterTest {};
 
 TEST_F(MysqlDateTimeTest, validBuild) {
@@ -208,6 +208,35 @@ TEST_F(KllSketchTest, mergeMultiple) {
   }
 }
 
+TEST_F(KllSketchTest, mergeMany) {
+  using Sketch = KllSketch<double, StlAllocator<double>>;
+  constexpr int N = 1e3;
+  constexpr int M = 1001;
+  constexpr int kSketchCount = 1'000;
+  auto pool = memory::memoryManager()->addLeafPool();
+  HashStringAllocator alloc(pool.get());
+  // Interleaved values, so that the levels of all sketches overlap.
+  std::vector<Sketch> sketches;
+  for (int i = 0; i < kSketchCount; ++i) {
+    Sketch kll(kDefaultK, StlAllocator<double>(&alloc), i);
+    for (int j = 0; j < N; ++j) {
+      kll.insert(i + j * kSketchCount);
+    }
+    kll.compact();
+    sketches.push_back(std::move(kll));
+  }
+  Sketch kll(kDefaultK, StlAllocator<double>(&alloc), 0);
+  kll.merge(folly::Range(sketches.begin(), sketches.end()));
+  EXPECT_EQ(kll.totalCount(), N * kSketchCount);
+  kll.finish();
+  auto q = linspace(M);
+  auto v = kll.estimateQuantiles(folly::Range(q.begin(), q.end()));
+  ASSERT_TRUE(std::is_sorted(std::begin(v), std::end(v)));
+  for (int i = 0; i < M; ++i) {
+    EXPECT_NEAR(q[i], v[i] / (N * kSketchCount), kEpsilon);
+  }
+}
+
 TEST_F(KllSketchTest, mergeEmpty) {
   KllSketch<double> kll, kll2;
   kll.insert(1.0);
@@ -1471,5 +1471,105 @@ TEST_F(Re2FunctionsTest, limit) {
   ASSERT_NO_THROW(evaluate("regexp_like(c0, c2)", data));
 }
 
+TEST_F(Re2FunctionsTest, patternSet) {
+  Re2PatternSet patterns({"a+b", "^x", "(?s)^a.*z$", "[0-9]{3}"});
+  ASSERT_EQ(patterns.size(), 4);
+  std::vector<int> matches;
+  auto sortedMatches = [&](std::string_view input) {
+    patterns.match(input, matches);
+    std::sort(matches.begin(), matches.end());
+    return matches;
+  };
+  ASSERT_EQ(sortedMatches("caab"), std::vector<int>({0}));
+  ASSERT_EQ(sortedMatches("xab\n123z"), std::vector<int>({0, 1, 3}));
+  ASSERT_EQ(sortedMatches("abc\nz"), std::vector<int>({0, 2}));
+  ASSERT_EQ(sortedMatches("none"), std::vector<int>());
+
+  auto strings = makeNullableFlatVector<std::string>(
+      {"caab", std::nullopt, "xab\n123z", "none", "x"});
+  SelectivityVector rows(strings->size());
+  rows.setValid(4, false);
+  rows.updateBounds();
+  DecodedVector decoded(*strings, rows);
+  std::vector<std::vector<uint64_t>> bitmaps;
+  patterns.matchRows(rows, decoded, bitmaps);
+  ASSERT_EQ(bitmaps.size(), 4);
+  const std::vector<std::vector<bool>> expected = {
+      {true, false, true, false},
+      {false, false, true, false},
+      {false, false, false, false},
+      {false, false, true, false},
+  };
+  for (auto i = 0; i < 4; ++i) {
+    for (auto row = 0; row < 4; ++row) {
+      ASSERT_EQ(bits::isBitSet(bitmaps[i].data(), row), expected[i][row])
+          << "pattern " << i << ", row " << row;
+    }
+  }
+
+  VELOX_ASSERT_THROW(
+      Re2PatternSet({"a", "("}), "invalid regular expression");
+}
+
+TEST_F(Re2FunctionsTest, regexpConjunct) {
+  auto data = makeRowVector({makeNullableFlatVector<std::string>(
+      {"aab",
+       "x1y\nz",
+       "123",
+       "hello",
+       "nothing",
+       std::nullopt,
+       "aab 123 x_y z",
+       "hello x_123_aab_z"})});
+  // The last LIKE has a fast path and is evaluated as usual.
+  const std::vector<std::string> predicates = {
+      "regexp_like(c0, 'a+b')",
+      "c0 like '%x_y%z'",
+      "regexp_like(c0, '[0-9]{3}')",
+      "c0 like 'hello%'",
+  };
+  std::vector<VectorPtr> values;
+  for (const auto& predicate : predicates) {
+    values.push_back(evaluate(predicate, data));
+  }
+
+  for (const std::string conjunct : {"or", "and"}) {
+    SCOPED_TRACE(conjunct);
+    const bool isOr = conjunct == "or";
+    std::vector<std::optional<bool>> expected;
+    for (auto row = 0; row < data->size(); ++row) {
+      bool hasNull = false;
+      bool result = !isOr;
+      for (const auto& value : values) {
+        if (value->isNullAt(row)) {
+          hasNull = true;
+        } else if (value->asFlatVector<bool>()->valueAt(row) == isOr) {
+          result = isOr;
+        }
+      }
+      expected.push_back(
+          result == isOr || !hasNull ? std::optional(result) : std::nullopt);
+    }
+
+    const auto expression =
+        folly::join(fmt::format(" {} ", conjunct), predicates);
+    auto exprSet = compileExpression(expression, asRowType(data->type()));
+    ASSERT_NE(
+        exprSet->exprs()[0]->toString().find(
+            isOr ? kRegexpLikeAny : kRegexpLikeAll),
+        std::string::npos)
+        << exprSet->exprs()[0]->toString();
+    assertEqualVectors(
+        makeNullableFlatVector<bool>(expected), evaluate(*exprSet, data));
+  }
+
+  // Fewer than kMinPatternSetSize valid patterns are matched one by one.
+  auto exprSet = compileExpression(
+      "regexp_like(c0, 'a') or regexp_like(c0, '(') or c0 like 'b%'",
+      asRowType(data->type()));
+  ASSERT_EQ(
+      exprSet->exprs()[0]->toString().find(kRegexpLikeAny), std::string::npos);
+}
+
 } // namespace
 } // namespace facebook::velox::functions
@@ -97,9 +97,17 @@ void registerRankInternal(
       exec::FunctionSignatureBuilder().returnType(returnType).build(),
   };
 
+  // percent_rank needs the number of rows in the partition. rank and
+  // dense_rank can process the rows of a partition as they arrive.
+  exec::WindowFunction::Metadata metadata;
+  if constexpr (TRank != RankType::kPercentRank) {
+    metadata.processMode = exec::WindowFunction::ProcessMode::kRows;
+  }
+
   exec::registerWindowFunction(
       name,
       std::move(signatures),
+      metadata,
       [name](
           const std::vector<exec::WindowFunctionArg>& /*args*/,
           const TypePtr& resultType,
@@ -23,6 +23,7 @@
 #include "velox/type/TimestampConversion.h"
 #include "velox/type/Type.h"
 #include "velox/type/tz/TimeZoneMap.h"
+#include "velox/type/tz/TimeZoneOffsetCache.h"
 
 namespace facebook::velox::functions {
 
@@ -1361,7 +1362,7 @@ struct FormatDateTimeFunction {
 
     const auto timestamp = unpackTimestampUtc(timestampWithTimezone);
     const auto timeZoneId = unpackZoneKeyId(timestampWithTimezone);
-    auto* timezonePtr = date::locate_zone(util::getTimeZoneName(timeZoneId));
+    auto* timezonePtr = util::locateZone(timeZoneId);
 
     auto maxResultSize = jodaDateTime_->maxResultSize(timezonePtr);
     result.reserve(maxResultSize);
@@ -1434,6 +1435,8 @@ template <typename T>
 struct CurrentDateFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  static constexpr bool is_time_dependent = true;
+
   const date::time_zone* timeZone_ = nullptr;
 
   FOLLY_ALWAYS_INLINE void initialize(
@@ -24,6 +24,61 @@
 namespace facebook::velox::functions {
 namespace {
 
+// Rescales the arguments of decimal plus and minus to the larger of their
+// scales. The multipliers and whether their products can overflow are set up
+// once for all rows by initialize(), so that the common cases of short
+// decimals and equal scales need no overflow check per row.
+class DecimalRescaler {
+ public:
+  template <typename A, typename B>
+  void initialize(const std::vector<TypePtr>& inputTypes) {
+    const auto aScale = getDecimalPrecisionScale(*inputTypes[0]).second;
+    const auto bScale = getDecimalPrecisionScale(*inputTypes[1]).second;
+    const uint8_t aRescale = std::max(0, bScale - aScale);
+    const uint8_t bRescale = std::max(0, aScale - bScale);
+    aMultiplier_ = DecimalUtil::kPowersOfTen[aRescale];
+    bMultiplier_ = DecimalUtil::kPowersOfTen[bRescale];
+    checkA_ = mayOverflow<A>(aRescale);
+    checkB_ = mayOverflow<B>(bRescale);
+  }
+
+  // Returns false if rescaling 'a' or 'b' overflows.
+  template <typename A, typename B>
+  FOLLY_ALWAYS_INLINE bool
+  rescale(const A& a, const B& b, int128_t& aRescaled, int128_t& bRescaled)
+      const {
+    return !(
+        rescaleOverflows(a, aMultiplier_, checkA_, aRescaled) |
+        rescaleOverflows(b, bMultiplier_, checkB_, bRescaled));
+  }
+
+ private:
+  // Returns true if a decimal of type T multiplied by 10 ^ 'rescale' may not
+  // fit in 128 bits. A short decimal is less than 10 ^ 18 and 10 ^ 38 fits.
+  template <typename T>
+  static bool mayOverflow(uint8_t rescale) {
+    return std::is_same_v<T, int64_t> ? rescale > 20 : rescale > 0;
+  }
+
+  template <typename T>
+  FOLLY_ALWAYS_INLINE static bool rescaleOverflows(
+      const T& value,
+      int128_t multiplier,
+      bool check,
+      int128_t& result) {
+    if (!check) {
+      result = static_cast<int128_t>(value) * multiplier;
+      return false;
+    }
+    return __builtin_mul_overflow(value, multiplier, &result);
+  }
+
+  int128_t aMultiplier_;
+  int128_t bMultiplier_;
+  bool checkA_;
+  bool checkB_;
+};
+
 template <typename TExec>
 struct DecimalPlusFunction {
   VELOX_DEFINE_FUNCTION_TYPES(TExec);
@@ -34,12 +89,7 @@ struct DecimalPlusFunction {
       const core::QueryConfig& /*config*/,
       A* /*a*/,
       B* /*b*/) {
-    auto aType = inputTypes[0];
-    auto bType = inputTypes[1];
-    auto aScale = getDecimalPrecisionScale(*aType).second;
-    auto bScale = getDecimalPrecisionScale(*bType).second;
-    aRescale_ = computeRescaleFactor(aScale, bScale);
-    bRescale_ = computeRescaleFactor(bScale, aScale);
+    rescaler_.initialize<A, B>(inputTypes);
   }
 
   template <typename R, typename A, typename B>
@@ -52,10 +102,7 @@ struct DecimalPlusFunction {
   {
     int128_t aRescaled;
     int128_t bRescaled;
-    if (__builtin_mul_overflow(
-            a, DecimalUtil::kPowersOfTen[aRescale_], &aRescaled) ||
-        __builtin_mul_overflow(
-            b, DecimalUtil::kPowersOfTen[bRescale_], &bRescaled)) {
+    if (UNLIKELY(!rescaler_.rescale(a, b, aRescaled, bRescaled))) {
       VELOX_ARITHMETIC_ERROR("Decimal overflow: {} + {}", a, b);
     }
     out = checkedPlus<R>(R(aRescaled), R(bRescaled));
@@ -63,14 +110,7 @@ struct DecimalPlusFunction {
   }
 
  private:
-  inline static uint8_t computeRescaleFactor(
-      uint8_t fromScale,
-      uint8_t toScale) {
-    return std::max(0, toScale - fromScale);
-  }
-
-  uint8_t aRescale_;
-  uint8_t bRescale_;
+  DecimalRescaler rescaler_;
 };
 
 template <typename TExec>
@@ -83,12 +123,7 @@ struct DecimalMinusFunction {
       const core::QueryConfig& /*config*/,
       A* /*a*/,
       B* /*b*/) {
-    const auto& aType = inputTypes[0];
-    const auto& bType = inputTypes[1];
-    auto aScale = getDecimalPrecisionScale(*aType).second;
-    auto bScale = getDecimalPrecisionScale(*bType).second;
-    aRescale_ = computeRescaleFactor(aScale, bScale);
-    bRescale_ = computeRescaleFactor(bScale, aScale);
+    rescaler_.initialize<A, B>(inputTypes);
   }
 
   template <typename R, typename A, typename B>
@@ -101,10 +136,7 @@ struct DecimalMinusFunction {
   {
     int128_t aRescaled;
     int128_t bRescaled;
-    if (__builtin_mul_overflow(
-            a, DecimalUtil::kPowersOfTen[aRescale_], &aRescaled) ||
-        __builtin_mul_overflow(
-            b, DecimalUtil::kPowersOfTen[bRescale_], &bRescaled)) {
+    if (UNLIKELY(!rescaler_.rescale(a, b, aRescaled, bRescaled))) {
       VELOX_ARITHMETIC_ERROR("Decimal overflow: {} - {}", a, b);
     }
     out = checkedMinus<R>(R(aRescaled), R(bRescaled));
@@ -112,14 +144,7 @@ struct DecimalMinusFunction {
   }
 
  private:
-  inline static uint8_t computeRescaleFactor(
-      uint8_t fromScale,
-      uint8_t toScale) {
-    return std::max(0, toScale - fromScale);
-  }
-
-  uint8_t aRescale_;
-  uint8_t bRescale_;
+  DecimalRescaler rescaler_;
 };
 
 template <typename TExec>
@@ -128,7 +153,7 @@ struct DecimalMultiplyFunction {
 
   template <typename R, typename A, typename B>
   void call(R& out, const A& a, const B& b) {
-    out = checkedMultiply<R>(checkedMultiply<R>(R(a), R(b)), R(1));
+    out = checkedMultiply<R>(R(a), R(b));
     DecimalUtil::valueInRange(out);
   }
 };
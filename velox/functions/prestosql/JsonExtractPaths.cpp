@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/prestosql/JsonExtractPaths.h"
+
+#include "velox/expression/DecodedArgs.h"
+#include "velox/functions/prestosql/SIMDJsonFunctions.h"
+#include "velox/functions/prestosql/types/JsonType.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+class JsonExtractPathsFunction : public exec::VectorFunction {
+ public:
+  explicit JsonExtractPathsFunction(
+      std::vector<std::shared_ptr<SIMDJsonExtractor>> extractors)
+      : extractors_(std::move(extractors)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    const auto& rowType = outputType->asRow();
+    VELOX_CHECK_EQ(rowType.size(), extractors_.size());
+    exec::DecodedArgs decodedArgs(rows, {args[0]}, context);
+    auto* json = decodedArgs.at(0);
+
+    const auto size = rows.end();
+    std::vector<VectorPtr> children(extractors_.size());
+    std::vector<FlatVector<StringView>*> flatChildren(extractors_.size());
+    std::vector<bool> isJson(extractors_.size());
+    for (auto i = 0; i < extractors_.size(); ++i) {
+      children[i] =
+          BaseVector::create(rowType.childAt(i), size, context.pool());
+      flatChildren[i] = children[i]->asFlatVector<StringView>();
+      // The paths that have no value in a row are null.
+      bits::fillBits(
+          flatChildren[i]->mutableRawNulls(), 0, size, bits::kNull);
+      isJson[i] = isJsonType(rowType.childAt(i));
+    }
+
+    std::optional<std::string> scalar;
+    std::string extracted;
+    rows.applyToSelected([&](auto row) {
+      const auto value = json->valueAt<StringView>(row);
+      auto padded = simdjsonPad(value.data(), value.size(), paddedJson_);
+      simdjson::ondemand::document jsonDoc;
+      if (simdjsonParse(padded).get(jsonDoc) != simdjson::SUCCESS) {
+        return;
+      }
+      bool needsParse = false;
+      for (auto i = 0; i < extractors_.size(); ++i) {
+        if (needsParse) {
+          // The document may not be iterated again after an error.
+          if (simdjsonParse(padded).get(jsonDoc) != simdjson::SUCCESS) {
+            return;
+          }
+          needsParse = false;
+        } else if (i > 0) {
+          jsonDoc.rewind();
+        }
+        simdjson::error_code error;
+        if (isJson[i]) {
+          error = extractJson(jsonDoc, *extractors_[i], extracted);
+          if (error == simdjson::SUCCESS) {
+            flatChildren[i]->set(row, StringView(extracted));
+          }
+        } else {
+          error = extractJsonScalar(jsonDoc, *extractors_[i], scalar);
+          if (error == simdjson::SUCCESS && scalar.has_value()) {
+            flatChildren[i]->set(row, StringView(scalar.value()));
+          }
+        }
+        needsParse =
+            error != simdjson::SUCCESS && error != simdjson::NO_SUCH_FIELD;
+      }
+    });
+
+    auto localResult = std::make_shared<RowVector>(
+        context.pool(), outputType, nullptr, size, std::move(children));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+ private:
+  const std::vector<std::shared_ptr<SIMDJsonExtractor>> extractors_;
+  // The copy of the current JSON value with the padding simdjson needs.
+  mutable std::string paddedJson_;
+};
+
+std::optional<std::string> getConstantString(const core::TypedExprPtr& expr) {
+  auto constant = dynamic_cast<const core::ConstantTypedExpr*>(expr.get());
+  if (constant == nullptr || !constant->type()->isVarchar()) {
+    return std::nullopt;
+  }
+  if (constant->hasValueVector()) {
+    const auto& vector = constant->valueVector();
+    if (vector->isNullAt(0)) {
+      return std::nullopt;
+    }
+    return std::string(vector->as<SimpleVector<StringView>>()->valueAt(0));
+  }
+  if (constant->value().isNull()) {
+    return std::nullopt;
+  }
+  return constant->value().value<TypeKind::VARCHAR>();
+}
+
+// Returns the path of 'expr' if it is a json_extract_scalar or json_extract of
+// a column with a valid constant path.
+std::optional<std::string> getExtractedPath(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr) {
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->inputs().size() != 2 ||
+      (call->name() != prefix + "json_extract_scalar" &&
+       call->name() != prefix + "json_extract")) {
+    return std::nullopt;
+  }
+  if (!dynamic_cast<const core::FieldAccessTypedExpr*>(
+          call->inputs()[0].get())) {
+    return std::nullopt;
+  }
+  auto path = getConstantString(call->inputs()[1]);
+  if (!path.has_value()) {
+    return std::nullopt;
+  }
+  try {
+    SIMDJsonExtractor::compile(path.value());
+  } catch (const VeloxUserError&) {
+    return std::nullopt;
+  }
+  return path;
+}
+
+// The paths extracted from one column.
+struct ColumnPaths {
+  core::TypedExprPtr column;
+  // The distinct calls on 'column'. Their results are the fields of 'call'.
+  std::vector<core::TypedExprPtr> extracts;
+  std::vector<std::string> paths;
+  core::TypedExprPtr call;
+};
+
+// Adds the extracts under 'expr' to 'columns'. Looks through function calls
+// and casts only, so that lambdas do not capture the shared call.
+void collectExtracts(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr,
+    std::vector<ColumnPaths>& columns) {
+  if (auto path = getExtractedPath(prefix, expr)) {
+    const auto& column = expr->inputs()[0];
+    auto it = std::find_if(columns.begin(), columns.end(), [&](auto& other) {
+      return *other.column == *column;
+    });
+    if (it == columns.end()) {
+      columns.push_back({column, {}, {}, nullptr});
+      it = columns.end() - 1;
+    }
+    if (std::find_if(it->extracts.begin(), it->extracts.end(), [&](auto& e) {
+          return *e == *expr;
+        }) == it->extracts.end()) {
+      it->extracts.push_back(expr);
+      it->paths.push_back(std::move(path.value()));
+    }
+    return;
+  }
+  if (dynamic_cast<const core::CallTypedExpr*>(expr.get()) ||
+      dynamic_cast<const core::CastTypedExpr*>(expr.get())) {
+    for (const auto& input : expr->inputs()) {
+      collectExtracts(prefix, input, columns);
+    }
+  }
+}
+
+// Returns 'expr' with the extracts of 'columns' replaced by fields of the
+// shared calls, or nullptr if 'expr' has none of these.
+core::TypedExprPtr replaceExtracts(
+    const core::TypedExprPtr& expr,
+    const std::vector<ColumnPaths>& columns) {
+  for (const auto& column : columns) {
+    if (column.call == nullptr) {
+      continue;
+    }
+    for (auto i = 0; i < column.extracts.size(); ++i) {
+      if (*column.extracts[i] == *expr) {
+        return std::make_shared<core::DereferenceTypedExpr>(
+            expr->type(), column.call, i);
+      }
+    }
+  }
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  auto cast = dynamic_cast<const core::CastTypedExpr*>(expr.get());
+  if (call == nullptr && cast == nullptr) {
+    return nullptr;
+  }
+  bool replaced = false;
+  std::vector<core::TypedExprPtr> inputs;
+  for (const auto& input : expr->inputs()) {
+    auto newInput = replaceExtracts(input, columns);
+    replaced |= newInput != nullptr;
+    inputs.push_back(newInput ? newInput : input);
+  }
+  if (!replaced) {
+    return nullptr;
+  }
+  if (call) {
+    return std::make_shared<core::CallTypedExpr>(
+        expr->type(), std::move(inputs), call->name());
+  }
+  return std::make_shared<core::CastTypedExpr>(
+      expr->type(), std::move(inputs), cast->nullOnFailure());
+}
+
+} // namespace
+
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+jsonExtractPathsSignatures() {
+  // json, varchar... -> row(varchar)
+  // varchar, varchar... -> row(varchar)
+  std::vector<std::shared_ptr<exec::FunctionSignature>> signatures;
+  for (const auto& type : {"json", "varchar"}) {
+    signatures.push_back(exec::FunctionSignatureBuilder()
+                             .returnType("row(varchar)")
+                             .argumentType(type)
+                             .constantArgumentType("varchar")
+                             .variableArity()
+                             .build());
+  }
+  return signatures;
+}
+
+std::shared_ptr<exec::VectorFunction> makeJsonExtractPaths(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  VELOX_USER_CHECK_GE(
+      inputArgs.size(), 2, "{} requires at least one path", name);
+  std::vector<std::shared_ptr<SIMDJsonExtractor>> extractors;
+  for (auto i = 1; i < inputArgs.size(); ++i) {
+    const auto& path = inputArgs[i].constantValue;
+    VELOX_USER_CHECK(
+        path != nullptr && !path->isNullAt(0),
+        "{} requires non-null constant paths",
+        name);
+    extractors.push_back(SIMDJsonExtractor::compile(
+        path->as<ConstantVector<StringView>>()->valueAt(0)));
+  }
+  return std::make_shared<JsonExtractPathsFunction>(std::move(extractors));
+}
+
+std::vector<core::TypedExprPtr> rewriteJsonExtractPaths(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  std::vector<ColumnPaths> columns;
+  for (const auto& expr : exprs) {
+    collectExtracts(prefix, expr, columns);
+  }
+
+  bool rewritten = false;
+  for (auto& column : columns) {
+    if (column.extracts.size() < 2) {
+      continue;
+    }
+    rewritten = true;
+    std::vector<std::string> names;
+    std::vector<TypePtr> types;
+    std::vector<core::TypedExprPtr> inputs{column.column};
+    for (auto i = 0; i < column.extracts.size(); ++i) {
+      names.push_back(fmt::format("p{}", i));
+      types.push_back(column.extracts[i]->type());
+      inputs.push_back(std::make_shared<core::ConstantTypedExpr>(
+          VARCHAR(), variant(column.paths[i])));
+    }
+    column.call = std::make_shared<core::CallTypedExpr>(
+        ROW(std::move(names), std::move(types)),
+        std::move(inputs),
+        kJsonExtractPaths);
+  }
+  if (!rewritten) {
+    return {};
+  }
+
+  std::vector<core::TypedExprPtr> result;
+  for (const auto& expr : exprs) {
+    auto newExpr = replaceExtracts(expr, columns);
+    result.push_back(newExpr ? newExpr : expr);
+  }
+  return result;
+}
+
+} // namespace facebook::velox::functions
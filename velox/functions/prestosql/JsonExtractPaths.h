@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/core/Expressions.h"
+#include "velox/expression/VectorFunction.h"
+
+namespace facebook::velox::functions {
+
+/// Name of the function that extracts several constant JSON paths from each
+/// JSON value with one parse. The arguments are the JSON and the paths. The
+/// result is a ROW with one field per path: a VARCHAR field has the result of
+/// json_extract_scalar for its path and a JSON field the result of
+/// json_extract.
+constexpr const char* kJsonExtractPaths = "$internal$json_extract_paths";
+
+/// Signatures of kJsonExtractPaths. These only bind the arguments. The result
+/// type is set by rewriteJsonExtractPaths.
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+jsonExtractPathsSignatures();
+
+std::shared_ptr<exec::VectorFunction> makeJsonExtractPaths(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+/// Expression set rewrite that replaces the calls to
+/// '<prefix>json_extract_scalar' and '<prefix>json_extract' with constant paths
+/// on the same column with fields of one kJsonExtractPaths call per column, so
+/// that each value of the column is parsed once for all of its paths. Columns
+/// with calls with fewer than two different paths are left as they are, and so
+/// are invalid paths, so that errors do not change. Returns an empty vector if
+/// 'exprs' are not rewritten.
+std::vector<core::TypedExprPtr> rewriteJsonExtractPaths(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs);
+
+} // namespace facebook::velox::functions
@@ -13,6 +13,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/functions/prestosql/Reduce.h"
+
+#include "velox/common/base/CheckedArithmetic.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/LambdaFunctionUtil.h"
 
@@ -230,8 +233,199 @@ class ReduceFunction : public exec::VectorFunction {
     context.moveOrCopyResult(localResult, rows, result);
   }
 };
+
+/// Adds up the elements of each array to the initial value. Does the same
+/// additions in the same order as 'reduce' with a (s, x) -> s + x lambda.
+template <typename T>
+class ReducePlusFunction : public exec::VectorFunction {
+ public:
+  explicit ReducePlusFunction(bool stateFirst) : stateFirst_(stateFirst) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    exec::LocalDecodedVector arrayDecoder(context, *args[0], rows);
+    auto& decodedArray = *arrayDecoder.get();
+
+    checkArraySizes(rows, decodedArray, context);
+
+    exec::LocalSelectivityVector remainingRows(context, rows);
+    context.deselectErrors(*remainingRows);
+
+    exec::LocalDecodedVector initDecoder(context, *args[1], *remainingRows);
+    auto& decodedInit = *initDecoder.get();
+
+    const auto* arrayVector = decodedArray.base()->as<ArrayVector>();
+    const auto* rawOffsets = arrayVector->rawOffsets();
+    const auto* rawSizes = arrayVector->rawSizes();
+    const auto& elementsVector = arrayVector->elements();
+    SelectivityVector elementRows(elementsVector->size());
+    exec::LocalDecodedVector elements(context, *elementsVector, elementRows);
+
+    context.ensureWritable(*remainingRows, outputType, result);
+    auto* flatResult = result->asUnchecked<FlatVector<T>>();
+
+    context.applyToSelectedNoThrow(*remainingRows, [&](auto row) {
+      const auto array = decodedArray.index(row);
+      const auto begin = rawOffsets[array];
+      const auto end = begin + rawSizes[array];
+      T sum = decodedInit.valueAt<T>(row);
+      for (auto i = begin; i < end; ++i) {
+        if (elements->isNullAt(i)) {
+          flatResult->setNull(row, true);
+          return;
+        }
+        const auto element = elements->valueAt<T>(i);
+        sum = stateFirst_ ? add(sum, element) : add(element, sum);
+      }
+      flatResult->set(row, sum);
+    });
+  }
+
+ private:
+  static T add(T a, T b) {
+    if constexpr (std::is_integral_v<T>) {
+      return checkedPlus(a, b);
+    } else {
+      return a + b;
+    }
+  }
+
+  // True if the sum so far is the left operand of each addition. Decides the
+  // order of the operands in overflow errors.
+  const bool stateFirst_;
+};
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> reducePlusSignatures() {
+  std::vector<std::shared_ptr<exec::FunctionSignature>> signatures;
+  for (const auto& type :
+       {"tinyint", "smallint", "integer", "bigint", "real", "double"}) {
+    signatures.push_back(
+        exec::FunctionSignatureBuilder()
+            .returnType(type)
+            .argumentType(fmt::format("array({})", type))
+            .argumentType(type)
+            .constantArgumentType("boolean")
+            .build());
+  }
+  return signatures;
+}
+
+std::shared_ptr<exec::VectorFunction> makeReducePlus(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  VELOX_CHECK_EQ(inputArgs.size(), 3);
+  const auto& stateFirst = inputArgs[2].constantValue;
+  VELOX_USER_CHECK(
+      stateFirst != nullptr && !stateFirst->isNullAt(0),
+      "{} requires a non-null constant third argument",
+      name);
+  const bool isStateFirst =
+      stateFirst->as<ConstantVector<bool>>()->valueAt(0);
+  switch (inputArgs[1].type->kind()) {
+    case TypeKind::TINYINT:
+      return std::make_shared<ReducePlusFunction<int8_t>>(isStateFirst);
+    case TypeKind::SMALLINT:
+      return std::make_shared<ReducePlusFunction<int16_t>>(isStateFirst);
+    case TypeKind::INTEGER:
+      return std::make_shared<ReducePlusFunction<int32_t>>(isStateFirst);
+    case TypeKind::BIGINT:
+      return std::make_shared<ReducePlusFunction<int64_t>>(isStateFirst);
+    case TypeKind::REAL:
+      return std::make_shared<ReducePlusFunction<float>>(isStateFirst);
+    case TypeKind::DOUBLE:
+      return std::make_shared<ReducePlusFunction<double>>(isStateFirst);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Returns true if 'expr' is the lambda argument 'name'.
+bool isLambdaArgument(const core::TypedExprPtr& expr, const std::string& name) {
+  auto field = dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+  return field != nullptr && field->isInputColumn() && field->name() == name;
+}
+
+// Returns true if 'type' is a type whose 'plus' is the addition done by
+// ReducePlusFunction. Excludes decimals, dates and intervals.
+bool isSupportedPlusType(const TypePtr& type) {
+  static const std::vector<TypePtr> kSupportedTypes = {
+      TINYINT(), SMALLINT(), INTEGER(), BIGINT(), REAL(), DOUBLE()};
+  for (const auto& supported : kSupportedTypes) {
+    if (type->equivalent(*supported) && supported->equivalent(*type)) {
+      return true;
+    }
+  }
+  return false;
+}
 } // namespace
 
+core::TypedExprPtr rewriteReduceCall(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr) {
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->name() != prefix + "reduce" ||
+      call->inputs().size() != 4) {
+    return nullptr;
+  }
+
+  const auto& type = call->type();
+  const auto& init = call->inputs()[1];
+  if (!isSupportedPlusType(type) || *init->type() != *type ||
+      *call->inputs()[0]->type() != *ARRAY(type)) {
+    return nullptr;
+  }
+
+  auto input =
+      dynamic_cast<const core::LambdaTypedExpr*>(call->inputs()[2].get());
+  auto output =
+      dynamic_cast<const core::LambdaTypedExpr*>(call->inputs()[3].get());
+  if (input == nullptr || output == nullptr ||
+      input->signature()->size() != 2 || output->signature()->size() != 1) {
+    return nullptr;
+  }
+
+  // s -> s
+  if (!isLambdaArgument(output->body(), output->signature()->nameOf(0))) {
+    return nullptr;
+  }
+
+  // (s, x) -> s + x or (s, x) -> x + s
+  auto plus = dynamic_cast<const core::CallTypedExpr*>(input->body().get());
+  if (plus == nullptr || plus->name() != prefix + "plus" ||
+      plus->inputs().size() != 2 || *plus->type() != *type) {
+    return nullptr;
+  }
+  const auto& state = input->signature()->nameOf(0);
+  const auto& element = input->signature()->nameOf(1);
+  if (state == element) {
+    return nullptr;
+  }
+  bool stateFirst;
+  if (isLambdaArgument(plus->inputs()[0], state) &&
+      isLambdaArgument(plus->inputs()[1], element)) {
+    stateFirst = true;
+  } else if (
+      isLambdaArgument(plus->inputs()[0], element) &&
+      isLambdaArgument(plus->inputs()[1], state)) {
+    stateFirst = false;
+  } else {
+    return nullptr;
+  }
+
+  return std::make_shared<core::CallTypedExpr>(
+      type,
+      std::vector<core::TypedExprPtr>{
+          call->inputs()[0],
+          init,
+          std::make_shared<core::ConstantTypedExpr>(BOOLEAN(), stateFirst)},
+      kReducePlus);
+}
+
 /// reduce is null preserving for the array. But since an
 /// expr tree with a lambda depends on all named fields, including
 /// captures, a null in a capture does not automatically make a
@@ -243,4 +437,9 @@ VELOX_DECLARE_VECTOR_FUNCTION_WITH_METADATA(
     exec::VectorFunctionMetadataBuilder().defaultNullBehavior(false).build(),
     std::make_unique<ReduceFunction>());
 
+VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
+    udf_$internal$reduce_plus,
+    reducePlusSignatures(),
+    makeReducePlus);
+
 } // namespace facebook::velox::functions
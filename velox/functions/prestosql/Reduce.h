@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/core/Expressions.h"
+
+namespace facebook::velox::functions {
+
+/// Name of the function that adds up the elements of an array to an initial
+/// value in one loop per array. The arguments are the array, the initial value
+/// and a constant boolean that is true if the value so far is the left operand
+/// of each addition. The result is null if the array has a null element.
+/// Integer overflow is an error.
+constexpr const char* kReducePlus = "$internal$reduce_plus";
+
+/// Rewrites
+///     reduce(a, init, (s, x) -> s + x, s -> s)
+/// and
+///     reduce(a, init, (s, x) -> x + s, s -> s)
+/// into a call to kReducePlus if the elements, 'init' and the result all have
+/// the same integer or floating point type, so that the sum does not evaluate
+/// the lambda once per position of the arrays.
+///
+/// Returns new expression or nullptr if rewrite is not possible.
+core::TypedExprPtr rewriteReduceCall(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr);
+
+} // namespace facebook::velox::functions
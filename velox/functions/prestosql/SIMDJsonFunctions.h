@@ -163,6 +163,121 @@ struct SIMDJsonArrayLengthFunction {
   }
 };
 
+/// Extracts the value at the path of 'extractor' from 'jsonDoc' as a string,
+/// with the semantics of json_extract_scalar(). Sets 'result' to std::nullopt
+/// if the value is not a scalar or if the path matches several values.
+inline simdjson::error_code extractJsonScalar(
+    simdjson::ondemand::document& jsonDoc,
+    SIMDJsonExtractor& extractor,
+    std::optional<std::string>& result) {
+  bool resultPopulated = false;
+  result.reset();
+  auto consumer = [&result, &resultPopulated](auto& v) {
+    if (resultPopulated) {
+      // We should just get a single value, if we see multiple, it's an error
+      // and we should return null.
+      result = std::nullopt;
+      return simdjson::SUCCESS;
+    }
+
+    resultPopulated = true;
+
+    SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
+    switch (vtype) {
+      case simdjson::ondemand::json_type::boolean: {
+        SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
+        result = vbool ? "true" : "false";
+        break;
+      }
+      case simdjson::ondemand::json_type::string: {
+        SIMDJSON_ASSIGN_OR_RAISE(result, v.get_string());
+        break;
+      }
+      case simdjson::ondemand::json_type::object:
+      case simdjson::ondemand::json_type::array:
+      case simdjson::ondemand::json_type::null:
+        // Do nothing.
+        break;
+      default: {
+        SIMDJSON_ASSIGN_OR_RAISE(result, simdjson::to_json_string(v));
+      }
+    }
+    return simdjson::SUCCESS;
+  };
+
+  return simdJsonExtract(jsonDoc, extractor, consumer);
+}
+
+/// Extracts the values at the path of 'extractor' from 'jsonDoc' as JSON,
+/// with the semantics of json_extract(). Returns simdjson::NO_SUCH_FIELD if
+/// the result is null.
+inline simdjson::error_code extractJson(
+    simdjson::ondemand::document& jsonDoc,
+    SIMDJsonExtractor& extractor,
+    std::string& result) {
+  static constexpr std::string_view kNullString{"null"};
+  std::string results;
+  size_t resultSize = 0;
+  auto consumer = [&results, &resultSize](auto& v) {
+    // Add the separator for the JSON array.
+    if (resultSize++ > 0) {
+      results += ",";
+    }
+    // We could just convert v to a string using to_json_string directly, but
+    // in that case the JSON wouldn't be parsed (it would just return the
+    // contents directly) and we might miss invalid JSON.
+    SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
+    switch (vtype) {
+      case simdjson::ondemand::json_type::object: {
+        SIMDJSON_ASSIGN_OR_RAISE(
+            auto jsonStr, simdjson::to_json_string(v.get_object()));
+        results += jsonStr;
+        break;
+      }
+      case simdjson::ondemand::json_type::array: {
+        SIMDJSON_ASSIGN_OR_RAISE(
+            auto jsonStr, simdjson::to_json_string(v.get_array()));
+        results += jsonStr;
+        break;
+      }
+      case simdjson::ondemand::json_type::string:
+      case simdjson::ondemand::json_type::number:
+      case simdjson::ondemand::json_type::boolean: {
+        SIMDJSON_ASSIGN_OR_RAISE(auto jsonStr, simdjson::to_json_string(v));
+        results += jsonStr;
+        break;
+      }
+      case simdjson::ondemand::json_type::null:
+        results += kNullString;
+        break;
+    }
+    return simdjson::SUCCESS;
+  };
+
+  SIMDJSON_TRY(simdJsonExtract(jsonDoc, extractor, consumer));
+
+  if (resultSize == 0) {
+    if (extractor.isDefinitePath()) {
+      // If the path didn't map to anything in the JSON object, return null.
+      return simdjson::NO_SUCH_FIELD;
+    }
+
+    result = "[]";
+  } else if (resultSize == 1 && extractor.isDefinitePath()) {
+    // If there was only one value mapped to by the path, don't wrap it in an
+    // array.
+    result = std::move(results);
+  } else {
+    // Add the square brackets to make it a valid JSON array.
+    result.clear();
+    result.reserve(2 + results.size());
+    result.append("[");
+    result.append(results);
+    result.append("]");
+  }
+  return simdjson::SUCCESS;
+}
+
 // jsonExtractScalar(json, json_path) -> varchar
 // Like jsonExtract(), but returns the result value as a string (as opposed
 // to being encoded as JSON). The value referenced by json_path must be a scalar
@@ -171,149 +286,88 @@ template <typename T>
 struct SIMDJsonExtractScalarFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
-  FOLLY_ALWAYS_INLINE bool call(
-      out_type<Varchar>& result,
-      const arg_type<Json>& json,
-      const arg_type<Varchar>& jsonPath) {
-    return callImpl(result, json, jsonPath) == simdjson::SUCCESS;
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /*inputTypes*/,
+      const core::QueryConfig& /*config*/,
+      const arg_type<Varchar>* /*json*/,
+      const arg_type<Varchar>* jsonPath) {
+    if (jsonPath != nullptr) {
+      extractor_ = SIMDJsonExtractor::compile(*jsonPath);
+    }
   }
 
- private:
-  FOLLY_ALWAYS_INLINE bool callImpl(
+  FOLLY_ALWAYS_INLINE bool call(
       out_type<Varchar>& result,
       const arg_type<Json>& json,
       const arg_type<Varchar>& jsonPath) {
-    bool resultPopulated = false;
-    std::optional<std::string> resultStr;
-    auto consumer = [&resultStr, &resultPopulated](auto& v) {
-      if (resultPopulated) {
-        // We should just get a single value, if we see multiple, it's an error
-        // and we should return null.
-        resultStr = std::nullopt;
-        return simdjson::SUCCESS;
-      }
-
-      resultPopulated = true;
-
-      SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
-      switch (vtype) {
-        case simdjson::ondemand::json_type::boolean: {
-          SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
-          resultStr = vbool ? "true" : "false";
-          break;
-        }
-        case simdjson::ondemand::json_type::string: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
-          break;
-        }
-        case simdjson::ondemand::json_type::object:
-        case simdjson::ondemand::json_type::array:
-        case simdjson::ondemand::json_type::null:
-          // Do nothing.
-          break;
-        default: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
-        }
-      }
-      return simdjson::SUCCESS;
-    };
-
-    auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
-    SIMDJSON_TRY(simdJsonExtract(json, extractor, consumer));
-
-    if (resultStr.has_value()) {
-      result.copy_from(*resultStr);
-      return simdjson::SUCCESS;
-    } else {
-      return simdjson::NO_SUCH_FIELD;
+    auto& extractor =
+        extractor_ ? *extractor_ : SIMDJsonExtractor::getInstance(jsonPath);
+    auto error = withJsonDocument(json, [&](auto& jsonDoc) {
+      return extractJsonScalar(jsonDoc, extractor, resultStr_);
+    });
+    if (error != simdjson::SUCCESS || !resultStr_.has_value()) {
+      return false;
     }
+    result.copy_from(*resultStr_);
+    return true;
   }
+
+ private:
+  // Set in initialize() if the path is constant.
+  std::shared_ptr<SIMDJsonExtractor> extractor_;
+  std::optional<std::string> resultStr_;
 };
 
 template <typename T>
 struct SIMDJsonExtractFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
-  bool call(
-      out_type<Json>& result,
-      const arg_type<Json>& json,
-      const arg_type<Varchar>& jsonPath) {
-    return callImpl(result, json, jsonPath) == simdjson::SUCCESS;
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /*inputTypes*/,
+      const core::QueryConfig& /*config*/,
+      const arg_type<Varchar>* /*json*/,
+      const arg_type<Varchar>* jsonPath) {
+    if (jsonPath != nullptr) {
+      extractor_ = SIMDJsonExtractor::compile(*jsonPath);
+    }
   }
 
- private:
-  simdjson::error_code callImpl(
+  bool call(
       out_type<Json>& result,
       const arg_type<Json>& json,
       const arg_type<Varchar>& jsonPath) {
-    static constexpr std::string_view kNullString{"null"};
-    std::string results;
-    size_t resultSize = 0;
-    auto consumer = [&results, &resultSize](auto& v) {
-      // Add the separator for the JSON array.
-      if (resultSize++ > 0) {
-        results += ",";
-      }
-      // We could just convert v to a string using to_json_string directly, but
-      // in that case the JSON wouldn't be parsed (it would just return the
-      // contents directly) and we might miss invalid JSON.
-      SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
-      switch (vtype) {
-        case simdjson::ondemand::json_type::object: {
-          SIMDJSON_ASSIGN_OR_RAISE(
-              auto jsonStr, simdjson::to_json_string(v.get_object()));
-          results += jsonStr;
-          break;
-        }
-        case simdjson::ondemand::json_type::array: {
-          SIMDJSON_ASSIGN_OR_RAISE(
-              auto jsonStr, simdjson::to_json_string(v.get_array()));
-          results += jsonStr;
-          break;
-        }
-        case simdjson::ondemand::json_type::string:
-        case simdjson::ondemand::json_type::number:
-        case simdjson::ondemand::json_type::boolean: {
-          SIMDJSON_ASSIGN_OR_RAISE(auto jsonStr, simdjson::to_json_string(v));
-          results += jsonStr;
-          break;
-        }
-        case simdjson::ondemand::json_type::null:
-          results += kNullString;
-          break;
-      }
-      return simdjson::SUCCESS;
-    };
-
-    auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
-    SIMDJSON_TRY(simdJsonExtract(json, extractor, consumer));
-
-    if (resultSize == 0) {
-      if (extractor.isDefinitePath()) {
-        // If the path didn't map to anything in the JSON object, return null.
-        return simdjson::NO_SUCH_FIELD;
-      }
-
-      result.copy_from("[]");
-    } else if (resultSize == 1 && extractor.isDefinitePath()) {
-      // If there was only one value mapped to by the path, don't wrap it in an
-      // array.
-      result.copy_from(results);
-    } else {
-      // Add the square brackets to make it a valid JSON array.
-      result.reserve(2 + results.size());
-      result.append("[");
-      result.append(results);
-      result.append("]");
+    auto& extractor =
+        extractor_ ? *extractor_ : SIMDJsonExtractor::getInstance(jsonPath);
+    auto error = withJsonDocument(json, [&](auto& jsonDoc) {
+      return extractJson(jsonDoc, extractor, resultStr_);
+    });
+    if (error != simdjson::SUCCESS) {
+      return false;
     }
-    return simdjson::SUCCESS;
+    result.copy_from(resultStr_);
+    return true;
   }
+
+ private:
+  // Set in initialize() if the path is constant.
+  std::shared_ptr<SIMDJsonExtractor> extractor_;
+  std::string resultStr_;
 };
 
 template <typename T>
 struct SIMDJsonSizeFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /*inputTypes*/,
+      const core::QueryConfig& /*config*/,
+      const arg_type<Varchar>* /*json*/,
+      const arg_type<Varchar>* jsonPath) {
+    if (jsonPath != nullptr) {
+      extractor_ = SIMDJsonExtractor::compile(*jsonPath);
+    }
+  }
+
   FOLLY_ALWAYS_INLINE bool call(
       int64_t& result,
       const arg_type<Json>& json,
@@ -356,7 +410,8 @@ struct SIMDJsonSizeFunction {
       return simdjson::SUCCESS;
     };
 
-    auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
+    auto& extractor =
+        extractor_ ? *extractor_ : SIMDJsonExtractor::getInstance(jsonPath);
     SIMDJSON_TRY(simdJsonExtract(json, extractor, consumer));
 
     if (resultCount == 0) {
@@ -368,6 +423,9 @@ struct SIMDJsonSizeFunction {
 
     return simdjson::SUCCESS;
   }
+
+  // Set in initialize() if the path is constant.
+  std::shared_ptr<SIMDJsonExtractor> extractor_;
 };
 
 } // namespace facebook::velox::functions
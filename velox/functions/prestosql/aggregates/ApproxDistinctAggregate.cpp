@@ -54,6 +54,18 @@ struct HllAccumulator {
     }
   }
 
+  void append(const uint64_t* hashes, int32_t numHashes) {
+    int32_t numSparse = 0;
+    if (isSparse_) {
+      numSparse = sparseHll_.insertHashes(hashes, numHashes);
+      if (!sparseHll_.overLimit()) {
+        return;
+      }
+      toDense();
+    }
+    denseHll_.insertHashes(hashes + numSparse, numHashes - numSparse);
+  }
+
   int64_t cardinality() const {
     return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
   }
@@ -218,20 +230,33 @@ class ApproxDistinctAggregate : public exec::Aggregate {
     } else {
       decodeArguments(rows, args);
 
+      // Appends the hashes of consecutive rows of the same group together.
+      char* runGroup = nullptr;
+      hashes_.clear();
+      auto appendRun = [&]() {
+        if (hashes_.empty()) {
+          return;
+        }
+        auto tracker = trackRowSize(runGroup);
+        auto accumulator = value<HllAccumulator>(runGroup);
+        clearNull(runGroup);
+        accumulator->setIndexBitLength(indexBitLength_);
+        accumulator->append(hashes_.data(), hashes_.size());
+        hashes_.clear();
+      };
+
       rows.applyToSelected([&](auto row) {
         if (decodedValue_.isNullAt(row)) {
           return;
         }
 
-        auto group = groups[row];
-        auto tracker = trackRowSize(group);
-        auto accumulator = value<HllAccumulator>(group);
-        clearNull(group);
-        accumulator->setIndexBitLength(indexBitLength_);
-
-        auto hash = hashOne(decodedValue_.valueAt<T>(row));
-        accumulator->append(hash);
+        if (groups[row] != runGroup) {
+          appendRun();
+          runGroup = groups[row];
+        }
+        hashes_.push_back(hashOne(decodedValue_.valueAt<T>(row)));
       });
+      appendRun();
     }
   }
 
@@ -269,18 +294,20 @@ class ApproxDistinctAggregate : public exec::Aggregate {
     } else {
       decodeArguments(rows, args);
 
+      hashes_.clear();
       rows.applyToSelected([&](auto row) {
-        if (decodedValue_.isNullAt(row)) {
-          return;
+        if (!decodedValue_.isNullAt(row)) {
+          hashes_.push_back(hashOne(decodedValue_.valueAt<T>(row)));
         }
-
-        auto accumulator = value<HllAccumulator>(group);
-        clearNull(group);
-        accumulator->setIndexBitLength(indexBitLength_);
-
-        auto hash = hashOne(decodedValue_.valueAt<T>(row));
-        accumulator->append(hash);
       });
+      if (hashes_.empty()) {
+        return;
+      }
+
+      auto accumulator = value<HllAccumulator>(group);
+      clearNull(group);
+      accumulator->setIndexBitLength(indexBitLength_);
+      accumulator->append(hashes_.data(), hashes_.size());
     }
   }
 
@@ -423,6 +450,9 @@ class ApproxDistinctAggregate : public exec::Aggregate {
   DecodedVector decodedValue_;
   DecodedVector decodedMaxStandardError_;
   DecodedVector decodedHll_;
+
+  // Hashes of the input values appended to one accumulator at a time.
+  std::vector<uint64_t> hashes_;
 };
 
 template <TypeKind kind>
@@ -705,8 +705,12 @@ class ApproxPercentileAggregate : public exec::Aggregate {
 
     KllSketchAccumulator<T>* accumulator = nullptr;
     std::vector<typename KllSketch<T>::View> views;
+    // The sketches of each group, merged at once below.
+    std::vector<std::pair<char*, typename KllSketch<T>::View>> groupViews;
     if constexpr (kSingleGroup) {
       views.reserve(rows.end());
+    } else {
+      groupViews.reserve(rows.countSelected());
     }
     rows.applyToSelected([&](auto row) {
       if (decoded.isNullAt(row)) {
@@ -767,8 +771,7 @@ class ApproxPercentileAggregate : public exec::Aggregate {
       if constexpr (kSingleGroup) {
         views.push_back(v);
       } else {
-        auto tracker = trackRowSize(group[row]);
-        accumulator->append(v);
+        groupViews.emplace_back(group[row], v);
       }
     });
     if constexpr (kSingleGroup) {
@@ -776,6 +779,24 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         auto tracker = trackRowSize(group);
         accumulator->append(views);
       }
+    } else {
+      // A k-way merge of all the sketches of a group allocates and compacts
+      // once instead of once per sketch.
+      std::stable_sort(
+          groupViews.begin(),
+          groupViews.end(),
+          [](const auto& left, const auto& right) {
+            return left.first < right.first;
+          });
+      for (auto i = 0; i < groupViews.size();) {
+        auto* runGroup = groupViews[i].first;
+        views.clear();
+        for (; i < groupViews.size() && groupViews[i].first == runGroup; ++i) {
+          views.push_back(groupViews[i].second);
+        }
+        auto tracker = trackRowSize(runGroup);
+        value<KllSketchAccumulator<T>>(runGroup)->append(views);
+      }
     }
   }
 };
@@ -15,23 +15,32 @@
  */
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/expression/FunctionSignature.h"
+#include "velox/functions/lib/aggregates/FixedWidthValueList.h"
 #include "velox/functions/lib/aggregates/ValueList.h"
 #include "velox/functions/prestosql/aggregates/AggregateNames.h"
 
 namespace facebook::velox::aggregate::prestosql {
 namespace {
 
+/// 'Elements' is ValueList or, for fixed width element types,
+/// FixedWidthValueList.
+template <typename Elements>
 struct ArrayAccumulator {
-  ValueList elements;
+  Elements elements;
 };
 
+template <typename Elements>
 class ArrayAggAggregate : public exec::Aggregate {
+  using Accumulator = ArrayAccumulator<Elements>;
+
+  static constexpr bool kFixedWidth = !std::is_same_v<Elements, ValueList>;
+
  public:
   explicit ArrayAggAggregate(TypePtr resultType, bool ignoreNulls)
       : Aggregate(resultType), ignoreNulls_(ignoreNulls) {}
 
   int32_t accumulatorFixedWidthSize() const override {
-    return sizeof(ArrayAccumulator);
+    return sizeof(Accumulator);
   }
 
   bool isFixedSize() const override {
@@ -42,6 +51,19 @@ class ArrayAggAggregate : public exec::Aggregate {
     return true;
   }
 
+  bool supportsRelocation() const override {
+    return true;
+  }
+
+  void relocate(folly::Range<char**> groups, HashStringAllocator* allocator)
+      override {
+    for (auto group : groups) {
+      if (isInitialized(group)) {
+        value<Accumulator>(group)->elements.relocate(allocator);
+      }
+    }
+  }
+
   void toIntermediate(
       const SelectivityVector& rows,
       std::vector<VectorPtr>& args,
@@ -103,14 +125,18 @@ class ArrayAggAggregate : public exec::Aggregate {
     uint64_t* rawNulls = getRawNulls(vector);
     vector_size_t offset = 0;
     for (int32_t i = 0; i < numGroups; ++i) {
-      auto& values = value<ArrayAccumulator>(groups[i])->elements;
+      auto& values = value<Accumulator>(groups[i])->elements;
       auto arraySize = values.size();
       if (arraySize) {
         clearNull(rawNulls, i);
 
-        ValueListReader reader(values);
-        for (auto index = 0; index < arraySize; ++index) {
-          reader.next(*elements, offset + index);
+        if constexpr (kFixedWidth) {
+          values.read(*elements, offset);
+        } else {
+          ValueListReader reader(values);
+          for (auto index = 0; index < arraySize; ++index) {
+            reader.next(*elements, offset + index);
+          }
         }
         vector->setOffsetAndSize(i, offset, arraySize);
         offset += arraySize;
@@ -137,7 +163,7 @@ class ArrayAggAggregate : public exec::Aggregate {
       }
       auto group = groups[row];
       auto tracker = trackRowSize(group);
-      value<ArrayAccumulator>(group)->elements.appendValue(
+      value<Accumulator>(group)->elements.appendValue(
           decodedElements_, row, allocator_);
     });
   }
@@ -151,16 +177,17 @@ class ArrayAggAggregate : public exec::Aggregate {
 
     auto arrayVector = decodedIntermediate_.base()->as<ArrayVector>();
     auto& elements = arrayVector->elements();
+    decodeIntermediateElements(*elements);
     rows.applyToSelected([&](vector_size_t row) {
       auto group = groups[row];
       auto decodedRow = decodedIntermediate_.index(row);
       auto tracker = trackRowSize(group);
       if (!decodedIntermediate_.isNullAt(row)) {
-        value<ArrayAccumulator>(group)->elements.appendRange(
+        appendRange(
+            value<Accumulator>(group)->elements,
             elements,
             arrayVector->offsetAt(decodedRow),
-            arrayVector->sizeAt(decodedRow),
-            allocator_);
+            arrayVector->sizeAt(decodedRow));
       }
     });
   }
@@ -170,7 +197,7 @@ class ArrayAggAggregate : public exec::Aggregate {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool /* mayPushdown */) override {
-    auto& values = value<ArrayAccumulator>(group)->elements;
+    auto& values = value<Accumulator>(group)->elements;
 
     decodedElements_.decode(*args[0], rows);
     auto tracker = trackRowSize(group);
@@ -190,16 +217,17 @@ class ArrayAggAggregate : public exec::Aggregate {
     decodedIntermediate_.decode(*args[0], rows);
     auto arrayVector = decodedIntermediate_.base()->as<ArrayVector>();
 
-    auto& values = value<ArrayAccumulator>(group)->elements;
+    auto& values = value<Accumulator>(group)->elements;
     auto elements = arrayVector->elements();
+    decodeIntermediateElements(*elements);
     rows.applyToSelected([&](vector_size_t row) {
       if (!decodedIntermediate_.isNullAt(row)) {
         auto decodedRow = decodedIntermediate_.index(row);
-        values.appendRange(
+        appendRange(
+            values,
             elements,
             arrayVector->offsetAt(decodedRow),
-            arrayVector->sizeAt(decodedRow),
-            allocator_);
+            arrayVector->sizeAt(decodedRow));
       }
     });
   }
@@ -209,14 +237,14 @@ class ArrayAggAggregate : public exec::Aggregate {
       char** groups,
       folly::Range<const vector_size_t*> indices) override {
     for (auto index : indices) {
-      new (groups[index] + offset_) ArrayAccumulator();
+      new (groups[index] + offset_) Accumulator();
     }
   }
 
   void destroyInternal(folly::Range<char**> groups) override {
     for (auto group : groups) {
       if (isInitialized(group)) {
-        value<ArrayAccumulator>(group)->elements.free(allocator_);
+        value<Accumulator>(group)->elements.free(allocator_);
       }
     }
   }
@@ -225,11 +253,31 @@ class ArrayAggAggregate : public exec::Aggregate {
   vector_size_t countElements(char** groups, int32_t numGroups) const {
     vector_size_t size = 0;
     for (int32_t i = 0; i < numGroups; ++i) {
-      size += value<ArrayAccumulator>(groups[i])->elements.size();
+      size += value<Accumulator>(groups[i])->elements.size();
     }
     return size;
   }
 
+  // FixedWidthValueList copies ranges of intermediate elements from a decoded
+  // vector, which is made once per batch.
+  void decodeIntermediateElements(const BaseVector& elements) {
+    if constexpr (kFixedWidth) {
+      decodedElements_.decode(elements);
+    }
+  }
+
+  void appendRange(
+      Elements& values,
+      const VectorPtr& elements,
+      vector_size_t offset,
+      vector_size_t size) {
+    if constexpr (kFixedWidth) {
+      values.appendRange(decodedElements_, offset, size, allocator_);
+    } else {
+      values.appendRange(elements, offset, size, allocator_);
+    }
+  }
+
   // A boolean representing whether to ignore nulls when aggregating inputs.
   const bool ignoreNulls_;
   // Reusable instance of DecodedVector for decoding input vectors.
@@ -237,6 +285,36 @@ class ArrayAggAggregate : public exec::Aggregate {
   DecodedVector decodedIntermediate_;
 };
 
+std::unique_ptr<exec::Aggregate> createArrayAggAggregate(
+    const TypePtr& resultType,
+    bool ignoreNulls) {
+  const auto& elementType = resultType->childAt(0);
+  if (elementType->isPrimitiveType() && elementType->isFixedWidth() &&
+      !elementType->isBoolean() && !elementType->isUnKnown()) {
+    switch (elementType->cppSizeInBytes()) {
+      case 1:
+        return std::make_unique<ArrayAggAggregate<FixedWidthValueList<1>>>(
+            resultType, ignoreNulls);
+      case 2:
+        return std::make_unique<ArrayAggAggregate<FixedWidthValueList<2>>>(
+            resultType, ignoreNulls);
+      case 4:
+        return std::make_unique<ArrayAggAggregate<FixedWidthValueList<4>>>(
+            resultType, ignoreNulls);
+      case 8:
+        return std::make_unique<ArrayAggAggregate<FixedWidthValueList<8>>>(
+            resultType, ignoreNulls);
+      case 16:
+        return std::make_unique<ArrayAggAggregate<FixedWidthValueList<16>>>(
+            resultType, ignoreNulls);
+      default:
+        break;
+    }
+  }
+  return std::make_unique<ArrayAggAggregate<ValueList>>(
+      resultType, ignoreNulls);
+}
+
 } // namespace
 
 void registerArrayAggAggregate(
@@ -262,7 +340,7 @@ void registerArrayAggAggregate(
           const core::QueryConfig& config) -> std::unique_ptr<exec::Aggregate> {
         VELOX_CHECK_EQ(
             argTypes.size(), 1, "{} takes at most one argument", name);
-        return std::make_unique<ArrayAggAggregate>(
+        return createArrayAggAggregate(
             resultType, config.prestoArrayAggIgnoreNulls());
       },
       withCompanionFunctions,
@@ -90,6 +90,11 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
       return;
     }
 
+    if (args[0]->isFlatEncoding()) {
+      addToGroup(group, countNonNulls(rows, args[0]->rawNulls()));
+      return;
+    }
+
     DecodedVector decoded(*args[0], rows);
     if (decoded.isConstantMapping()) {
       if (!decoded.isNullAt(0)) {
@@ -146,6 +151,23 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
     *value<int64_t>(group) += count;
   }
 
+  // Returns the number of rows that are selected in 'rows' and not null in
+  // 'nulls', counting 64 rows at a time.
+  static int64_t countNonNulls(
+      const SelectivityVector& rows,
+      const uint64_t* nulls) {
+    if (nulls == nullptr) {
+      return rows.countSelected();
+    }
+    const auto* selected = rows.asRange().bits();
+    int64_t count = 0;
+    bits::forEachWord(
+        rows.begin(), rows.end(), [&](int32_t index, uint64_t mask) {
+          count += __builtin_popcountll(selected[index] & nulls[index] & mask);
+        });
+    return count;
+  }
+
   DecodedVector decodedIntermediate_;
 };
 
@@ -73,6 +73,49 @@ class MinMaxAggregate : public SimpleNumericAggregate<T, T, T> {
           return *BaseAggregate::Aggregate::template value<T>(group);
         });
   }
+
+ protected:
+  // Updates 'group' with the flat integer values of 'arg' at 'rows', keeping
+  // a partial result per lane. 'replace(result, value)' returns true if
+  // 'value' replaces 'result'. Returns false without updating if 'arg' is not
+  // flat or T is not an integer type. Floating point values keep the row
+  // order, which decides between NaNs and zeros of different sign.
+  template <typename Replace>
+  bool addSingleGroupFlatInput(
+      char* group,
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      T initialValue,
+      Replace replace) {
+    if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+      if (!arg->isFlatEncoding()) {
+        return false;
+      }
+      T lanes[BaseAggregate::kNumLanes];
+      std::fill(std::begin(lanes), std::end(lanes), initialValue);
+      const auto count = BaseAggregate::template reduceFlat<T>(
+          *arg->asUnchecked<FlatVector<T>>(),
+          rows,
+          initialValue,
+          [&](int32_t lane, T value) {
+            lanes[lane] = replace(lanes[lane], value) ? value : lanes[lane];
+          });
+      if (count > 0) {
+        for (auto lane = 1; lane < BaseAggregate::kNumLanes; ++lane) {
+          lanes[0] = replace(lanes[0], lanes[lane]) ? lanes[lane] : lanes[0];
+        }
+        BaseAggregate::template updateNonNullValue<true, T>(
+            group, lanes[0], [&](T& result, T value) {
+              if (replace(result, value)) {
+                result = value;
+              }
+            });
+      }
+      return true;
+    } else {
+      return false;
+    }
+  }
 };
 
 /// Override 'accumulatorAlignmentSize' for UnscaledLongDecimal values as it
@@ -143,6 +186,12 @@ class MaxAggregate : public MinMaxAggregate<T> {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
+    if (this->addSingleGroupFlatInput(
+            group, rows, args[0], kInitialValue_, [](T result, T value) {
+              return result < value;
+            })) {
+      return;
+    }
     BaseAggregate::updateOneGroup(
         group,
         rows,
@@ -229,6 +278,12 @@ class MinAggregate : public MinMaxAggregate<T> {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
+    if (this->addSingleGroupFlatInput(
+            group, rows, args[0], kInitialValue_, [](T result, T value) {
+              return result > value;
+            })) {
+      return;
+    }
     BaseAggregate::updateOneGroup(
         group,
         rows,
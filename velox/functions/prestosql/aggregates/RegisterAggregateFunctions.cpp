@@ -15,6 +15,7 @@
  */
 #include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
 #include "velox/exec/Aggregate.h"
+#include "velox/expression/LazyFunctionRegistration.h"
 
 namespace facebook::velox::aggregate::prestosql {
 
@@ -184,6 +185,17 @@ void registerAllAggregateFunctions(
   registerVarianceAggregates(prefix, withCompanionFunctions, overwrite);
 }
 
+void registerAllAggregateFunctionsLazily(
+    const std::string& prefix,
+    bool withCompanionFunctions,
+    bool onlyPrestoSignatures,
+    bool overwrite) {
+  exec::registerFunctionsLazily([=]() {
+    registerAllAggregateFunctions(
+        prefix, withCompanionFunctions, onlyPrestoSignatures, overwrite);
+  });
+}
+
 extern void registerCountDistinctAggregate(const std::string& prefix);
 
 void registerInternalAggregateFunctions(const std::string& prefix) {
@@ -30,6 +30,14 @@ void registerAllAggregateFunctions(
     bool onlyPrestoSignatures = false,
     bool overwrite = true);
 
+/// Like registerAllAggregateFunctions, but defers the registration until the
+/// function registries are first used. See exec::registerFunctionsLazily.
+void registerAllAggregateFunctionsLazily(
+    const std::string& prefix = "",
+    bool withCompanionFunctions = true,
+    bool onlyPrestoSignatures = false,
+    bool overwrite = true);
+
 /// Register internal aggregation functions only for testing.
 /// \param prefix : Prefix for the aggregate functions.
 void registerInternalAggregateFunctions(const std::string& prefix);
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+// Measures the final aggregation of approx_percentile over many partial
+// sketches per group, as received from many upstream workers.
+class ApproxPercentileBenchmark : public OperatorTestBase {
+ public:
+  ApproxPercentileBenchmark() {
+    OperatorTestBase::SetUp();
+    for (auto numGroups : {100, 10'000}) {
+      intermediates_[numGroups] = makeIntermediates(numGroups);
+    }
+  }
+
+  ~ApproxPercentileBenchmark() override {
+    intermediates_.clear();
+    OperatorTestBase::TearDown();
+  }
+
+  void TestBody() override {}
+
+  void run(int32_t numGroups) {
+    folly::BenchmarkSuspender suspender;
+    auto plan =
+        PlanBuilder()
+            .values(intermediates_.at(numGroups))
+            .finalAggregation(
+                {"k"}, {"approx_percentile(a0)"}, {{DOUBLE(), DOUBLE()}})
+            .planNode();
+    suspender.dismiss();
+
+    auto result = AssertQueryBuilder(plan).copyResults(pool());
+    folly::doNotOptimizeAway(result->size());
+  }
+
+ private:
+  static constexpr int32_t kNumPartials = 200;
+  static constexpr int32_t kRowsPerPartial = 10'000;
+  // Number of partial results in one input batch of the final aggregation.
+  static constexpr int32_t kPartialsPerBatch = 10;
+
+  // Returns the partial sketches of 'kNumPartials' inputs of 'numGroups'
+  // groups each, in batches of 'kPartialsPerBatch' partial results.
+  std::vector<RowVectorPtr> makeIntermediates(int32_t numGroups) {
+    std::vector<RowVectorPtr> batches;
+    for (auto i = 0; i < kNumPartials; ++i) {
+      auto input = makeRowVector(
+          {"k", "v"},
+          {makeFlatVector<int64_t>(
+               kRowsPerPartial, [&](auto row) { return row % numGroups; }),
+           makeFlatVector<double>(kRowsPerPartial, [&](auto row) {
+             return (row * 7'919 + i * 104'729) % 1'000'003;
+           })});
+      auto plan = PlanBuilder()
+                      .values({input})
+                      .partialAggregation({"k"}, {"approx_percentile(v, 0.5)"})
+                      .planNode();
+      auto partial = AssertQueryBuilder(plan).copyResults(pool());
+      if (i % kPartialsPerBatch == 0) {
+        batches.push_back(partial);
+      } else {
+        batches.back()->append(partial.get());
+      }
+    }
+    return batches;
+  }
+
+  std::unordered_map<int32_t, std::vector<RowVectorPtr>> intermediates_;
+};
+
+std::unique_ptr<ApproxPercentileBenchmark> benchmark;
+
+BENCHMARK(final100Groups) {
+  benchmark->run(100);
+}
+
+BENCHMARK(final10KGroups) {
+  benchmark->run(10'000);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+
+  OperatorTestBase::SetUpTestCase();
+  benchmark = std::make_unique<ApproxPercentileBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  OperatorTestBase::TearDownTestCase();
+  return 0;
+}
@@ -434,6 +434,59 @@ TEST_F(SumTest, integerAggregateOverflow) {
   testAggregateOverflow<int64_t, int64_t>(true);
 }
 
+TEST_F(SumTest, globalFlatInput) {
+  // Covers words of 64 rows that are all set, partially set and past the end
+  // of the input, with nulls and masks.
+  vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * 1'000'003 - 500'000'000; }),
+      makeFlatVector<int32_t>(
+          size, [](auto row) { return row % 101 - 50; }, nullEvery(7)),
+      makeFlatVector<bool>(size, [](auto row) { return row % 3 != 0; }),
+  });
+  createDuckDbTable({data});
+
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .singleAggregation(
+                      {},
+                      {"sum(c0)", "sum(c1)", "min(c0)", "max(c1)", "count(c1)"})
+                  .planNode();
+  assertQuery(
+      plan, "SELECT sum(c0), sum(c1), min(c0), max(c1), count(c1) FROM tmp");
+
+  plan = PlanBuilder()
+             .values({data})
+             .singleAggregation(
+                 {},
+                 {"sum(c0)", "sum(c1)", "min(c0)", "max(c1)", "count(c1)"},
+                 {"c2", "c2", "c2", "c2", "c2"})
+             .planNode();
+  assertQuery(
+      plan,
+      "SELECT sum(c0) filter (where c2), sum(c1) filter (where c2), "
+      "min(c0) filter (where c2), max(c1) filter (where c2), "
+      "count(c1) filter (where c2) FROM tmp");
+
+  // The sum of the first two values overflows, the sum of all does not.
+  constexpr auto kMax = std::numeric_limits<int64_t>::max();
+  constexpr auto kMin = std::numeric_limits<int64_t>::min();
+  plan = PlanBuilder()
+             .values({makeRowVector({makeFlatVector<int64_t>({kMax, 1, -1})})})
+             .singleAggregation({}, {"sum(c0)"})
+             .planNode();
+  VELOX_ASSERT_THROW(readSingleValue(plan), "overflow");
+
+  // No sum in row order overflows.
+  plan = PlanBuilder()
+             .values({makeRowVector(
+                 {makeFlatVector<int64_t>({kMax - 10, 5, -3, 7, kMin})})})
+             .singleAggregation({}, {"sum(c0)"})
+             .planNode();
+  ASSERT_EQ(readSingleValue(plan).value<int64_t>(), -2);
+}
+
 TEST_F(SumTest, floatAggregateOverflow) {
   testAggregateOverflow<float, float, double>();
   testAggregateOverflow<double, double>();
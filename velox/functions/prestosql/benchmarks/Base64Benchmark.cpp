@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/encode/Base64.h"
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+class Base64Benchmark : public functions::test::FunctionBenchmarkBase {
+ public:
+  Base64Benchmark() : FunctionBenchmarkBase() {
+    functions::prestosql::registerBinaryFunctions();
+  }
+
+  // Runs 'expression' 100 times on 1000 values of 'size' random bytes and
+  // their base64 encodings.
+  void run(const std::string& expression, int32_t size) {
+    folly::BenchmarkSuspender suspender;
+    constexpr vector_size_t kNumRows = 1'000;
+    std::vector<std::string> bytes(kNumRows);
+    std::vector<std::string> encoded(kNumRows);
+    std::vector<std::string> encodedUrl(kNumRows);
+    for (auto row = 0; row < kNumRows; ++row) {
+      bytes[row].resize(size);
+      for (auto i = 0; i < size; ++i) {
+        bytes[row][i] = folly::Random::rand32();
+      }
+      encoded[row] = encoding::Base64::encode(bytes[row]);
+      encodedUrl[row].resize(
+          encoding::Base64::calculateEncodedSize(bytes[row].size()));
+      encoding::Base64::encodeUrl(
+          bytes[row].data(), bytes[row].size(), encodedUrl[row].data());
+    }
+    auto data = vectorMaker_.rowVector({
+        vectorMaker_.flatVector<std::string>(bytes, VARBINARY()),
+        vectorMaker_.flatVector<std::string>(encoded),
+        vectorMaker_.flatVector<std::string>(encodedUrl),
+    });
+    auto exprSet = compileExpression(expression, asRowType(data->type()));
+    suspender.dismiss();
+
+    int32_t count = 0;
+    for (auto i = 0; i < 100; ++i) {
+      count += evaluate(exprSet, data)->size();
+    }
+    folly::doNotOptimizeAway(count);
+  }
+};
+
+BENCHMARK(toBase64Short) {
+  Base64Benchmark().run("to_base64(c0)", 20);
+}
+
+BENCHMARK(toBase64Long) {
+  Base64Benchmark().run("to_base64(c0)", 1'000);
+}
+
+BENCHMARK(toBase64UrlLong) {
+  Base64Benchmark().run("to_base64url(c0)", 1'000);
+}
+
+BENCHMARK(fromBase64Short) {
+  Base64Benchmark().run("from_base64(c1)", 20);
+}
+
+BENCHMARK(fromBase64Long) {
+  Base64Benchmark().run("from_base64(c1)", 1'000);
+}
+
+BENCHMARK(fromBase64UrlLong) {
+  Base64Benchmark().run("from_base64url(c2)", 1'000);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  folly::runBenchmarks();
+  return 0;
+}
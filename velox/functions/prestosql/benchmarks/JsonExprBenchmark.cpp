@@ -23,6 +23,7 @@
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
 #include "velox/functions/prestosql/SIMDJsonFunctions.h"
 #include "velox/functions/prestosql/json/JsonExtractor.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
 namespace facebook::velox::functions::prestosql {
@@ -201,6 +202,8 @@ class JsonBenchmark : public velox::functions::test::FunctionBenchmarkBase {
         {"folly_json_size"});
     registerFunction<SIMDJsonSizeFunction, int64_t, Json, Varchar>(
         {"simd_json_size"});
+    // Several paths on the same column share one parse with this prefix.
+    registerJsonFunctions("shared_");
   }
 
   std::string prepareData(int jsonSize) {
@@ -256,6 +259,37 @@ class JsonBenchmark : public velox::functions::test::FunctionBenchmarkBase {
     doRun(iter, exprSet, rowVector);
   }
 
+  // Evaluates 'fnName' with each of 'paths' on the same column in one ExprSet.
+  void runWithJsonExtractPaths(
+      int iter,
+      int vectorSize,
+      const std::string& fnName,
+      const std::string& json,
+      const std::vector<std::string>& paths) {
+    folly::BenchmarkSuspender suspender;
+
+    auto jsonVector = makeJsonData(json, vectorSize);
+    auto rowVector = vectorMaker_.rowVector({jsonVector});
+    std::vector<core::TypedExprPtr> exprs;
+    for (const auto& path : paths) {
+      auto untyped =
+          parse::parseExpr(fmt::format("{}(c0, '{}')", fnName, path), options_);
+      exprs.push_back(core::Expressions::inferTypes(
+          untyped, rowVector->type(), execCtx_.pool()));
+    }
+    exec::ExprSet exprSet(std::move(exprs), &execCtx_);
+    suspender.dismiss();
+
+    uint32_t cnt = 0;
+    for (auto i = 0; i < iter; i++) {
+      exec::EvalCtx evalCtx(&execCtx_, &exprSet, rowVector.get());
+      std::vector<VectorPtr> results(paths.size());
+      exprSet.eval(SelectivityVector(vectorSize), evalCtx, results);
+      cnt += results[0]->size();
+    }
+    folly::doNotOptimizeAway(cnt);
+  }
+
   void runWithJsonContains(
       int iter,
       int vectorSize,
@@ -389,6 +423,35 @@ void SIMDJsonSize(int iter, int vectorSize, int jsonSize) {
       iter, vectorSize, "simd_json_size", json, "$.key");
 }
 
+void SIMDJsonExtractPaths(
+    const std::string& fnName,
+    int iter,
+    int vectorSize,
+    int jsonSize) {
+  folly::BenchmarkSuspender suspender;
+  JsonBenchmark benchmark;
+  auto json = benchmark.prepareData(jsonSize);
+  suspender.dismiss();
+  benchmark.runWithJsonExtractPaths(
+      iter,
+      vectorSize,
+      fnName,
+      json,
+      {"$.key[0].k1", "$.key[3].k1", "$.key[7].k1", "$.key[9].k1"});
+}
+
+void SIMDJsonExtractScalarSeparatePaths(
+    int iter,
+    int vectorSize,
+    int jsonSize) {
+  SIMDJsonExtractPaths("simd_json_extract_scalar", iter, vectorSize, jsonSize);
+}
+
+void SIMDJsonExtractScalarSharedPaths(int iter, int vectorSize, int jsonSize) {
+  SIMDJsonExtractPaths(
+      "shared_json_extract_scalar", iter, vectorSize, jsonSize);
+}
+
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK_NAMED_PARAM(FollyIsJsonScalar, 100_iters_10bytes_size, 100, 10);
@@ -612,6 +675,31 @@ BENCHMARK_RELATIVE_NAMED_PARAM(
     10000);
 BENCHMARK_DRAW_LINE();
 
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(
+    SIMDJsonExtractScalarSeparatePaths,
+    100_iters_100bytes_size,
+    100,
+    100);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    SIMDJsonExtractScalarSharedPaths,
+    100_iters_100bytes_size,
+    100,
+    100);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(
+    SIMDJsonExtractScalarSeparatePaths,
+    100_iters_1000bytes_size,
+    100,
+    1000);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    SIMDJsonExtractScalarSharedPaths,
+    100_iters_1000bytes_size,
+    100,
+    1000);
+BENCHMARK_DRAW_LINE();
+
 } // namespace
 } // namespace facebook::velox::functions::prestosql
 
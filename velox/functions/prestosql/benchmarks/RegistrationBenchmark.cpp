@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/expression/LazyFunctionRegistration.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+
+using namespace facebook::velox;
+
+// Measures the registration done at process startup. Each iteration registers
+// all Presto functions again, which replaces the functions of the previous
+// iteration. The lazy registration only records the callbacks; they run
+// outside of the measurement, like they would on the first resolution.
+
+BENCHMARK(eagerRegistration) {
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  window::prestosql::registerAllWindowFunctions();
+}
+
+BENCHMARK_RELATIVE(lazyRegistration) {
+  functions::prestosql::registerAllScalarFunctionsLazily();
+  aggregate::prestosql::registerAllAggregateFunctionsLazily();
+  window::prestosql::registerAllWindowFunctionsLazily();
+
+  folly::BenchmarkSuspender suspender;
+  exec::ensureLazyFunctionsRegistered();
+}
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  folly::runBenchmarks();
+  return 0;
+}
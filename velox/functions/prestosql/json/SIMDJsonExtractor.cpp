@@ -46,6 +46,12 @@ using JsonVector = std::vector<simdjson::ondemand::value>;
   return *it.first->second;
 }
 
+/* static */ std::shared_ptr<SIMDJsonExtractor> SIMDJsonExtractor::compile(
+    folly::StringPiece path) {
+  return std::shared_ptr<SIMDJsonExtractor>(
+      new SIMDJsonExtractor(folly::trimWhitespace(path).str()));
+}
+
 bool SIMDJsonExtractor::tokenize(const std::string& path) {
   thread_local static JsonPathTokenizer tokenizer;
 
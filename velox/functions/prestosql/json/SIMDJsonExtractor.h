@@ -57,6 +57,12 @@ class SIMDJsonExtractor {
   /// the callers of simdJsonExtract.
   static SIMDJsonExtractor& getInstance(folly::StringPiece path);
 
+  /// Returns a new extractor for 'path' that is owned by the caller. Used for
+  /// paths that are constant for an expression, so that they are tokenized
+  /// once and not looked up in the cache for each row. Throws if 'path' is
+  /// invalid.
+  static std::shared_ptr<SIMDJsonExtractor> compile(folly::StringPiece path);
+
  private:
   // Shouldn't instantiate directly - use getInstance().
   explicit SIMDJsonExtractor(const std::string& path) {
@@ -129,7 +135,8 @@ simdjson::error_code SIMDJsonExtractor::extract(
 
 /**
  * Extract element(s) from a JSON object using the given path.
- * @param json: A JSON object
+ * @param jsonDoc: A JSON document that has not been iterated yet. Call
+ *                 rewind() on it to extract another path from the same parse.
  * @param path: Path to locate a JSON object. Following operators are supported.
  *              "$"      Root member of a JSON structure no matter if it's an
  *                       object, an array, or a scalar.
@@ -147,12 +154,9 @@ simdjson::error_code SIMDJsonExtractor::extract(
  */
 template <typename TConsumer>
 simdjson::error_code simdJsonExtract(
-    const velox::StringView& json,
+    simdjson::ondemand::document& jsonDoc,
     SIMDJsonExtractor& extractor,
     TConsumer&& consumer) {
-  simdjson::padded_string paddedJson(json.data(), json.size());
-  SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
-
   if (extractor.isRootOnlyPath()) {
     // If the path is just to return the original object, call consumer on the
     // document.  Note, we cannot convert this to a value as this is not
@@ -163,4 +167,29 @@ simdjson::error_code simdJsonExtract(
   return extractor.extract(value, std::forward<TConsumer>(consumer));
 }
 
+/// Parses 'json' and calls 'func' with the document. The copy of 'json' that
+/// simdjson needs is made in a thread local buffer that is reused across calls.
+template <typename TFunc>
+simdjson::error_code withJsonDocument(
+    const velox::StringView& json,
+    TFunc&& func) {
+  thread_local std::string paddedJson;
+  SIMDJSON_ASSIGN_OR_RAISE(
+      auto jsonDoc,
+      simdjsonParse(simdjsonPad(json.data(), json.size(), paddedJson)));
+  return func(jsonDoc);
+}
+
+/// Same as above for 'json' that is not parsed yet.
+template <typename TConsumer>
+simdjson::error_code simdJsonExtract(
+    const velox::StringView& json,
+    SIMDJsonExtractor& extractor,
+    TConsumer&& consumer) {
+  return withJsonDocument(json, [&](auto& jsonDoc) {
+    return simdJsonExtract(
+        jsonDoc, extractor, std::forward<TConsumer>(consumer));
+  });
+}
+
 } // namespace facebook::velox::functions
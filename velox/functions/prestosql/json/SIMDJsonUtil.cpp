@@ -16,6 +16,8 @@
 
 #include "velox/functions/prestosql/json/SIMDJsonUtil.h"
 
+#include <cstring>
+
 #include "velox/common/base/VeloxException.h"
 
 namespace facebook::velox {
@@ -34,4 +36,15 @@ simdjson::simdjson_result<simdjson::ondemand::document> simdjsonParse(
   return parser.iterate(json);
 }
 
+simdjson::padded_string_view
+simdjsonPad(const char* data, size_t size, std::string& buffer) {
+  if (buffer.size() < size + simdjson::SIMDJSON_PADDING) {
+    buffer.resize(size + simdjson::SIMDJSON_PADDING);
+  }
+  if (size > 0) {
+    ::memcpy(buffer.data(), data, size);
+  }
+  return simdjson::padded_string_view(buffer.data(), size, buffer.size());
+}
+
 } // namespace facebook::velox
@@ -47,4 +47,10 @@ void simdjsonErrorsToExceptions(
 simdjson::simdjson_result<simdjson::ondemand::document> simdjsonParse(
     const simdjson::padded_string_view& json);
 
+/// Copies 'size' bytes at 'data' to 'buffer' followed by the padding that
+/// simdjson may read past the end of its input, and returns a view of the
+/// copy. 'buffer' is reused across values to avoid an allocation per value.
+simdjson::padded_string_view
+simdjsonPad(const char* data, size_t size, std::string& buffer);
+
 } // namespace facebook::velox
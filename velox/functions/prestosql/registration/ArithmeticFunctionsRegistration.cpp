@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/expression/FusedArithmeticExpr.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/RegistrationHelpers.h"
 #include "velox/functions/prestosql/Arithmetic.h"
@@ -195,6 +196,12 @@ void registerSimpleFunctions(const std::string& prefix) {
 
 void registerArithmeticFunctions(const std::string& prefix = "") {
   registerSimpleFunctions(prefix);
+  // Floating point plus, minus, multiply and divide do not check for overflow
+  // or division by zero.
+  exec::registerFusableFunction(prefix + "plus", exec::FusedOp::kPlus);
+  exec::registerFusableFunction(prefix + "minus", exec::FusedOp::kMinus);
+  exec::registerFusableFunction(prefix + "multiply", exec::FusedOp::kMultiply);
+  exec::registerFusableFunction(prefix + "divide", exec::FusedOp::kDivide);
   VELOX_REGISTER_VECTOR_FUNCTION(udf_not, prefix + "not");
 
   registerDecimalPlus(prefix);
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/expression/FusedArithmeticExpr.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/RegistrationHelpers.h"
 #include "velox/functions/prestosql/Comparisons.h"
@@ -108,6 +109,13 @@ void registerComparisonFunctions(const std::string& prefix) {
       ShortDecimal<P1, S1>,
       ShortDecimal<P1, S1>,
       ShortDecimal<P1, S1>>({prefix + "between"});
+
+  exec::registerFusableFunction(prefix + "eq", exec::FusedOp::kEq);
+  exec::registerFusableFunction(prefix + "neq", exec::FusedOp::kNeq);
+  exec::registerFusableFunction(prefix + "lt", exec::FusedOp::kLt);
+  exec::registerFusableFunction(prefix + "lte", exec::FusedOp::kLte);
+  exec::registerFusableFunction(prefix + "gt", exec::FusedOp::kGt);
+  exec::registerFusableFunction(prefix + "gte", exec::FusedOp::kGte);
 }
 
 } // namespace facebook::velox::functions
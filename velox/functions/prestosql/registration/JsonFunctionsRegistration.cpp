@@ -15,6 +15,7 @@
  */
 
 #include "velox/functions/Registerer.h"
+#include "velox/functions/prestosql/JsonExtractPaths.h"
 #include "velox/functions/prestosql/SIMDJsonFunctions.h"
 
 namespace facebook::velox::functions {
@@ -36,6 +37,12 @@ void registerJsonFunctions(const std::string& prefix) {
   registerFunction<SIMDJsonExtractFunction, Json, Varchar, Varchar>(
       {prefix + "json_extract"});
 
+  exec::registerStatefulVectorFunction(
+      kJsonExtractPaths, jsonExtractPathsSignatures(), makeJsonExtractPaths);
+  exec::registerExpressionSetRewrite([prefix](const auto& exprs) {
+    return rewriteJsonExtractPaths(prefix, exprs);
+  });
+
   registerFunction<SIMDJsonArrayLengthFunction, int64_t, Json>(
       {prefix + "json_array_length"});
   registerFunction<SIMDJsonArrayLengthFunction, int64_t, Varchar>(
@@ -15,6 +15,8 @@
  */
 #include <string>
 
+#include "velox/expression/LazyFunctionRegistration.h"
+
 namespace facebook::velox::functions {
 
 extern void registerArithmeticFunctions(const std::string& prefix);
@@ -104,6 +106,11 @@ void registerAllScalarFunctions(const std::string& prefix) {
   registerBitwiseFunctions(prefix);
 }
 
+void registerAllScalarFunctionsLazily(const std::string& prefix) {
+  exec::registerFunctionsLazily(
+      [prefix]() { registerAllScalarFunctions(prefix); });
+}
+
 void registerMapAllowingDuplicates(
     const std::string& name,
     const std::string& prefix) {
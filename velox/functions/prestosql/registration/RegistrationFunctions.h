@@ -47,6 +47,10 @@ void registerBitwiseFunctions(const std::string& prefix = "");
 
 void registerAllScalarFunctions(const std::string& prefix = "");
 
+/// Like registerAllScalarFunctions, but defers the registration until the
+/// function registries are first used. See exec::registerFunctionsLazily.
+void registerAllScalarFunctionsLazily(const std::string& prefix = "");
+
 void registerMapAllowingDuplicates(
     const std::string& name,
     const std::string& prefix = "");
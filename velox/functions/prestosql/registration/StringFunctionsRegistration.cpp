@@ -119,6 +119,13 @@ void registerStringFunctions(const std::string& prefix) {
       makeRe2ExtractAll);
   exec::registerStatefulVectorFunction(
       prefix + "regexp_like", re2SearchSignatures(), makeRe2Search);
+  exec::registerStatefulVectorFunction(
+      kRegexpLikeAny, re2SearchSetSignatures(), makeRe2SearchAny);
+  exec::registerStatefulVectorFunction(
+      kRegexpLikeAll, re2SearchSetSignatures(), makeRe2SearchAll);
+  exec::registerExpressionRewrite([prefix](const auto& expr) {
+    return rewriteRegexpConjunct(prefix, expr);
+  });
 
   registerFunction<StrLPosFunction, int64_t, Varchar, Varchar>(
       {prefix + "strpos"});
@@ -462,6 +462,62 @@ TEST_F(BinaryFunctionsTest, fromBase64Url) {
   EXPECT_THROW(fromBase64Url("YQ=/"), VeloxUserError);
 }
 
+TEST_F(BinaryFunctionsTest, base64LongInputs) {
+  // Long enough for the SIMD loops with all lengths of the scalar tail.
+  std::vector<std::string> inputs;
+  for (auto size = 0; size < 200; ++size) {
+    std::string input(size, '\0');
+    for (auto i = 0; i < size; ++i) {
+      input[i] = static_cast<char>(i * 37 + size);
+    }
+    inputs.push_back(std::move(input));
+  }
+  auto data = makeRowVector({makeFlatVector<std::string>(inputs, VARBINARY())});
+  for (const auto& suffix : {"", "url"}) {
+    SCOPED_TRACE(suffix);
+    auto result = evaluate(
+        fmt::format("from_base64{0}(to_base64{0}(c0))", suffix), data);
+    assertEqualVectors(data->childAt(0), result);
+  }
+
+  // 0xFB 0xFF 0xBF encodes to the last 2 characters of the alphabet.
+  std::string bytes;
+  std::string encoded;
+  std::string encodedUrl;
+  for (auto i = 0; i < 30; ++i) {
+    bytes += "\xFB\xFF\xBF";
+    encoded += "+/+/";
+    encodedUrl += "-_-_";
+  }
+  EXPECT_EQ(
+      evaluateOnce<std::string>(
+          "to_base64(c0)", {std::optional(bytes)}, {VARBINARY()}),
+      encoded);
+  EXPECT_EQ(
+      evaluateOnce<std::string>(
+          "to_base64url(c0)", {std::optional(bytes)}, {VARBINARY()}),
+      encodedUrl);
+  const auto fromBase64 = [&](const std::string& value) {
+    return evaluateOnce<std::string>("from_base64(c0)", std::optional(value));
+  };
+  const auto fromBase64Url = [&](const std::string& value) {
+    return evaluateOnce<std::string>(
+        "from_base64url(c0)", std::optional(value));
+  };
+  EXPECT_EQ(fromBase64(encoded), bytes);
+  EXPECT_EQ(fromBase64Url(encodedUrl), bytes);
+  EXPECT_EQ(fromBase64Url(encoded), bytes);
+  EXPECT_THROW(fromBase64(encodedUrl), VeloxUserError);
+
+  // An invalid character anywhere in a long input is an error.
+  for (auto i = 0; i < encoded.size(); ++i) {
+    auto invalid = encoded;
+    invalid[i] = i % 2 == 0 ? '=' : '*';
+    EXPECT_THROW(fromBase64(invalid), VeloxUserError) << i;
+    EXPECT_THROW(fromBase64Url(invalid), VeloxUserError) << i;
+  }
+}
+
 TEST_F(BinaryFunctionsTest, fromBigEndian32) {
   const auto fromBigEndian32 = [&](const std::optional<std::string>& arg) {
     return evaluateOnce<int32_t, std::string>(
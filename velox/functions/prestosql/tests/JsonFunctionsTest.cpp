@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/JsonExtractPaths.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
@@ -637,6 +638,53 @@ TEST_F(JsonFunctionsTest, jsonExtract) {
   VELOX_ASSERT_THROW(jsonExtract(kJson, "$.store.keys()"), "Invalid JSON path");
 }
 
+TEST_F(JsonFunctionsTest, extractPaths) {
+  auto data = makeRowVector({makeNullableFlatVector<std::string>(
+      {R"({"a": 1, "b": {"c": "x"}, "d": [1, 2]})",
+       std::nullopt,
+       "INVALID_JSON",
+       R"({"a": true, "d": []})",
+       R"({"d": [3], "a": "y", "b": 2} trailing)",
+       R"({"a": {"e": 1}, "b": [})"},
+      JSON())});
+  const std::vector<std::string> expressions = {
+      "json_extract_scalar(c0, '$.a')",
+      "json_extract_scalar(c0, '$.b.c')",
+      "json_extract(c0, '$.d')",
+      "json_extract(c0, '$.d[*]')",
+      "concat(json_extract_scalar(c0, '$.a'), '!')",
+      "json_extract_scalar(c0, '$.b')",
+  };
+
+  auto exprSet = compileExpressions(expressions, asRowType(data->type()));
+  ASSERT_NE(exprSet->toString().find(kJsonExtractPaths), std::string::npos);
+  // The fields of the shared call refer to the same expression.
+  const auto& exprs = exprSet->exprs();
+  ASSERT_EQ(exprs[0]->inputs()[0], exprs[1]->inputs()[0]);
+  ASSERT_EQ(exprs[0]->inputs()[0], exprs[2]->inputs()[0]);
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  std::vector<VectorPtr> results(expressions.size());
+  exprSet->eval(SelectivityVector(data->size()), context, results);
+
+  // Each expression evaluated by itself has one path that is not shared.
+  for (auto i = 0; i < expressions.size(); ++i) {
+    SCOPED_TRACE(expressions[i]);
+    assertEqualVectors(evaluate(expressions[i], data), results[i]);
+  }
+
+  // Paths on different columns and invalid paths are not rewritten.
+  auto twoColumns = makeRowVector({data->childAt(0), data->childAt(0)});
+  exprSet = compileExpressions(
+      {"json_extract_scalar(c0, '$.a')", "json_extract_scalar(c1, '$.b')"},
+      asRowType(twoColumns->type()));
+  ASSERT_EQ(exprSet->toString().find(kJsonExtractPaths), std::string::npos);
+  exprSet = compileExpressions(
+      {"json_extract_scalar(c0, '$.a')", "json_extract_scalar(c0, '$[]')"},
+      asRowType(data->type()));
+  ASSERT_EQ(exprSet->toString().find(kJsonExtractPaths), std::string::npos);
+}
+
 } // namespace
 
 } // namespace facebook::velox::functions::prestosql
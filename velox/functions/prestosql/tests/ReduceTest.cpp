@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/Reduce.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 
 using namespace facebook::velox;
@@ -269,3 +270,66 @@ TEST_F(ReduceTest, limit) {
       {123 * 1'000, 123 * 9'000, std::nullopt, 123 * 10, std::nullopt});
   assertEqualVectors(expected, result);
 }
+
+// Verify that sums are rewritten into a loop over the elements and that the
+// results and errors are the same as those of the lambda.
+TEST_F(ReduceTest, sum) {
+  auto data = makeRowVector({
+      makeArrayVectorFromJson<int64_t>(
+          {"[1, 2, 3]", "[]", "null", "[4, null, 5]", "[6]", "[7, 8]"}),
+      makeNullableFlatVector<int64_t>({10, 20, 30, 40, std::nullopt, 50}),
+      makeArrayVectorFromJson<double>(
+          {"[0.1, 0.2]",
+           "null",
+           "[]",
+           "[0.3, null]",
+           "[1e100, 1, -1e100]",
+           "[2.5]"}),
+  });
+
+  auto isRewritten = [&](const std::string& expression) {
+    auto exprSet = compileExpression(expression, asRowType(data->type()));
+    return exprSet->toString().find(functions::kReducePlus) !=
+        std::string::npos;
+  };
+
+  ASSERT_TRUE(isRewritten("reduce(c0, c1, (s, x) -> s + x, s -> s)"));
+  ASSERT_TRUE(isRewritten("reduce(c0, c1, (s, x) -> x + s, s -> s)"));
+  ASSERT_TRUE(isRewritten("reduce(c2, 0.0, (s, x) -> s + x, s -> s)"));
+  ASSERT_FALSE(isRewritten("reduce(c0, c1, (s, x) -> s + x, s -> s + 1)"));
+  ASSERT_FALSE(isRewritten("reduce(c0, c1, (s, x) -> s + x * 2, s -> s)"));
+  ASSERT_FALSE(isRewritten("reduce(c0, c1, (s, x) -> s + s, s -> s)"));
+  ASSERT_FALSE(isRewritten("reduce(c0, c1, (s, x) -> s - x, s -> s)"));
+  ASSERT_FALSE(isRewritten(
+      "reduce(c0, 0.0, (s, x) -> s + cast(x as double), s -> s)"));
+
+  auto expected = makeNullableFlatVector<int64_t>(
+      {16, 20, std::nullopt, std::nullopt, std::nullopt, 65});
+  assertEqualVectors(
+      expected, evaluate("reduce(c0, c1, (s, x) -> s + x, s -> s)", data));
+  assertEqualVectors(
+      expected, evaluate("reduce(c0, c1, (s, x) -> x + s, s -> s)", data));
+  assertEqualVectors(
+      evaluate("reduce(c0, c1, (s, x) -> s + x, s -> s + 0)", data),
+      evaluate("reduce(c0, c1, (s, x) -> s + x, s -> s)", data));
+
+  // Floating point additions are done in the same order as the lambda does.
+  assertEqualVectors(
+      evaluate("reduce(c2, 0.0, (s, x) -> s + x, s -> s + 0.0)", data),
+      evaluate("reduce(c2, 0.0, (s, x) -> s + x, s -> s)", data));
+
+  // Overflow errors have the operands in the order of the lambda.
+  data = makeRowVector({
+      makeArrayVectorFromJson<int64_t>(
+          {"[1, 2]", "[9223372036854775807, 1]", "[null, 1]"}),
+  });
+  VELOX_ASSERT_THROW(
+      evaluate("reduce(c0, 0, (s, x) -> s + x, s -> s)", data),
+      "integer overflow: 9223372036854775807 + 1");
+  VELOX_ASSERT_THROW(
+      evaluate("reduce(c0, 0, (s, x) -> x + s, s -> s)", data),
+      "integer overflow: 1 + 9223372036854775807");
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>({3, std::nullopt, std::nullopt}),
+      evaluate("try(reduce(c0, 0, (s, x) -> s + x, s -> s))", data));
+}
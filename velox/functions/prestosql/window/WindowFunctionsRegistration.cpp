@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+#include "velox/expression/LazyFunctionRegistration.h"
 #include "velox/functions/lib/window/RegistrationFunctions.h"
 
 namespace facebook::velox::window {
@@ -41,6 +42,11 @@ void registerAllWindowFunctions(const std::string& prefix) {
   registerLead(prefix + "lead");
 }
 
+void registerAllWindowFunctionsLazily(const std::string& prefix) {
+  exec::registerFunctionsLazily(
+      [prefix]() { registerAllWindowFunctions(prefix); });
+}
+
 } // namespace prestosql
 
 } // namespace facebook::velox::window
@@ -19,4 +19,8 @@ namespace facebook::velox::window::prestosql {
 
 void registerAllWindowFunctions(const std::string& prefix = "");
 
+/// Like registerAllWindowFunctions, but defers the registration until the
+/// function registries are first used. See exec::registerFunctionsLazily.
+void registerAllWindowFunctionsLazily(const std::string& prefix = "");
+
 } // namespace facebook::velox::window::prestosql
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/functions/lib/window/tests/WindowTestBase.h"
 #include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
 
@@ -210,6 +212,41 @@ TEST_F(AggregateWindowTest, nonNullEmptyResult) {
       {input}, "count(c1)", overClause, frameClause, expected);
 }
 
+// Tests sliding frames large enough to be evaluated over the segment tree.
+TEST_F(AggregateWindowTest, segmentTree) {
+  const std::vector<RowVectorPtr> input = {
+      makeSinglePartitionVector(1'000), makeSinglePartitionVector(500)};
+  const std::vector<std::string> frameClauses = {
+      "rows between 100 preceding and 50 following",
+      "rows between 300 preceding and current row",
+      "rows between current row and 400 following",
+      "rows between 17 preceding and unbounded following",
+  };
+  createDuckDbTable(input);
+  for (const auto& function : kAggregateFunctions) {
+    WindowTestBase::testWindowFunction(
+        input, function, kOverClauses, frameClauses, false);
+  }
+
+  // The results with and without the segment tree match.
+  const auto plan =
+      PlanBuilder()
+          .values(input)
+          .window(
+              {"sum(c2) over (partition by c0 order by c1, c2, c3 "
+               "rows between 200 preceding and 150 following)"})
+          .planNode();
+  const auto expected =
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kWindowSegmentTreeEnabled, "false")
+          .copyResults(pool());
+  const auto actual =
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kWindowSegmentTreeEnabled, "true")
+          .copyResults(pool());
+  assertEqualResults({expected}, {actual});
+}
+
 TEST_F(AggregateWindowTest, testDecimal) {
   auto size = 30;
   auto testAggregate = [&](const TypePtr& type) {
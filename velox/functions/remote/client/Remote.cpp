@@ -16,6 +16,7 @@
 
 #include "velox/functions/remote/client/Remote.h"
 
+#include <folly/futures/Future.h>
 #include <folly/io/async/EventBase.h>
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
@@ -41,9 +42,14 @@ class RemoteFunction : public exec::VectorFunction {
       const RemoteVectorFunctionMetadata& metadata)
       : functionName_(functionName),
         location_(metadata.location),
-        thriftClient_(getThriftClient(location_, &eventBase_)),
+        maxRowsPerRequest_(metadata.maxRowsPerRequest),
         serdeFormat_(metadata.serdeFormat),
         serde_(getSerde(serdeFormat_)) {
+    VELOX_CHECK_GE(maxRowsPerRequest_, 0);
+    VELOX_CHECK_GT(metadata.numConnections, 0);
+    for (auto i = 0; i < metadata.numConnections; ++i) {
+      thriftClients_.push_back(getThriftClient(location_, &eventBase_));
+    }
     std::vector<TypePtr> types;
     types.reserve(inputArgs.size());
     serializedInputTypes_.reserve(inputArgs.size());
@@ -85,8 +91,65 @@ class RemoteFunction : public exec::VectorFunction {
         rows.end(),
         std::move(args));
 
-    // Send to remote server.
-    remote::RemoteFunctionResponse remoteResponse;
+    const vector_size_t numRows = rows.end();
+    const vector_size_t rowsPerRequest = maxRowsPerRequest_ > 0
+        ? std::min(maxRowsPerRequest_, numRows)
+        : numRows;
+
+    // Send all requests before waiting for any response, so that the round
+    // trips overlap.
+    std::vector<folly::SemiFuture<remote::RemoteFunctionResponse>> responses;
+    std::vector<folly::Try<remote::RemoteFunctionResponse>> remoteResponses;
+    try {
+      for (vector_size_t offset = 0; offset < numRows;
+           offset += rowsPerRequest) {
+        const auto size = std::min(rowsPerRequest, numRows - offset);
+        auto input = size == numRows
+            ? remoteRowVector
+            : std::static_pointer_cast<RowVector>(
+                  remoteRowVector->slice(offset, size));
+        auto& client = thriftClients_[responses.size() % thriftClients_.size()];
+        responses.push_back(client->semifuture_invokeFunction(
+            makeRequest(input, outputType, context)));
+      }
+      remoteResponses = folly::collectAll(std::move(responses))
+                            .via(&eventBase_)
+                            .getVia(&eventBase_);
+    } catch (const std::exception& e) {
+      failRemote(e.what());
+    }
+
+    std::vector<VectorPtr> outputs;
+    for (auto& remoteResponse : remoteResponses) {
+      if (remoteResponse.hasException()) {
+        failRemote(remoteResponse.exception().what().toStdString());
+      }
+      auto outputRowVector = IOBufToRowVector(
+          remoteResponse->get_result().get_payload(),
+          ROW({outputType}),
+          *context.pool(),
+          serde_.get());
+      outputs.push_back(outputRowVector->childAt(0));
+    }
+    if (outputs.size() == 1) {
+      result = outputs[0];
+      return;
+    }
+
+    result = BaseVector::create(outputType, numRows, context.pool());
+    vector_size_t offset = 0;
+    for (const auto& output : outputs) {
+      result->copy(output.get(), offset, 0, output->size());
+      offset += output->size();
+    }
+    VELOX_CHECK_EQ(offset, numRows);
+  }
+
+  // Returns the request to evaluate the function on all rows of 'input'.
+  remote::RemoteFunctionRequest makeRequest(
+      const RowVectorPtr& input,
+      const TypePtr& outputType,
+      exec::EvalCtx& context) const {
     remote::RemoteFunctionRequest request;
     request.throwOnError_ref() = context.throwOnError();
 
@@ -96,36 +159,33 @@ class RemoteFunction : public exec::VectorFunction {
     functionHandle->argumentTypes_ref() = serializedInputTypes_;
 
     auto requestInputs = request.inputs_ref();
-    requestInputs->rowCount_ref() = remoteRowVector->size();
+    requestInputs->rowCount_ref() = input->size();
     requestInputs->pageFormat_ref() = serdeFormat_;
 
     // TODO: serialize only active rows.
-    requestInputs->payload_ref() = rowVectorToIOBuf(
-        remoteRowVector, rows.end(), *context.pool(), serde_.get());
-
-    try {
-      thriftClient_->sync_invokeFunction(remoteResponse, request);
-    } catch (const std::exception& e) {
-      VELOX_FAIL(
-          "Error while executing remote function '{}' at '{}': {}",
-          functionName_,
-          location_.describe(),
-          e.what());
-    }
+    requestInputs->payload_ref() =
+        rowVectorToIOBuf(input, input->size(), *context.pool(), serde_.get());
+    return request;
+  }
 
-    auto outputRowVector = IOBufToRowVector(
-        remoteResponse.get_result().get_payload(),
-        ROW({outputType}),
-        *context.pool(),
-        serde_.get());
-    result = outputRowVector->childAt(0);
+  [[noreturn]] void failRemote(const std::string& error) const {
+    VELOX_FAIL(
+        "Error while executing remote function '{}' at '{}': {}",
+        functionName_,
+        location_.describe(),
+        error);
   }
 
   const std::string functionName_;
   folly::SocketAddress location_;
 
-  folly::EventBase eventBase_;
-  std::unique_ptr<RemoteFunctionClient> thriftClient_;
+  const vector_size_t maxRowsPerRequest_;
+
+  // Drives the requests of the clients in the thread that evaluates the
+  // function.
+  mutable folly::EventBase eventBase_;
+  // One client per connection.
+  std::vector<std::unique_ptr<RemoteFunctionClient>> thriftClients_;
   remote::PageFormat serdeFormat_;
   std::unique_ptr<VectorSerde> serde_;
 
@@ -30,6 +30,15 @@ struct RemoteVectorFunctionMetadata : public exec::VectorFunctionMetadata {
 
   /// The serialization format to be used
   remote::PageFormat serdeFormat{remote::PageFormat::PRESTO_PAGE};
+
+  /// Maximum number of rows to send in one request. Larger batches are split
+  /// into requests of at most this many rows that are in flight together. 0
+  /// sends each batch in one request.
+  vector_size_t maxRowsPerRequest{0};
+
+  /// Number of connections to the server that each instance of the function
+  /// opens. The requests for one batch are spread over these round robin.
+  int32_t numConnections{1};
 };
 
 /// Registers a new remote function. It will use the meatadata defined in
@@ -80,6 +80,14 @@ class RemoteFunctionTest
                                  .build()};
     registerRemoteFunction("remote_substr", substrSignatures, metadata);
 
+    // Splits batches into concurrent requests over several connections.
+    RemoteVectorFunctionMetadata splitMetadata = metadata;
+    splitMetadata.maxRowsPerRequest = 3;
+    splitMetadata.numConnections = 2;
+    registerRemoteFunction("remote_split_plus", plusSignatures, splitMetadata);
+    registerRemoteFunction(
+        "remote_split_substr", substrSignatures, splitMetadata);
+
     // Registers the actual function under a different prefix. This is only
     // needed for tests since the thrift service runs in the same process.
     registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
@@ -88,6 +96,10 @@ class RemoteFunctionTest
         {remotePrefix_ + ".remote_divide"});
     registerFunction<SubstrFunction, Varchar, Varchar, int32_t>(
         {remotePrefix_ + ".remote_substr"});
+    registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
+        {remotePrefix_ + ".remote_split_plus"});
+    registerFunction<SubstrFunction, Varchar, Varchar, int32_t>(
+        {remotePrefix_ + ".remote_split_substr"});
   }
 
   void initializeServer() {
@@ -151,6 +163,31 @@ TEST_P(RemoteFunctionTest, string) {
   assertEqualVectors(expected, results);
 }
 
+TEST_P(RemoteFunctionTest, splitRequests) {
+  // 1 request, 3 full requests and 3 requests with the last one short.
+  for (auto size : {3, 9, 8}) {
+    auto inputVector =
+        makeFlatVector<int64_t>(size, [](auto row) { return row; });
+    auto results = evaluate<SimpleVector<int64_t>>(
+        "remote_split_plus(c0, c0)", makeRowVector({inputVector}));
+
+    auto expected =
+        makeFlatVector<int64_t>(size, [](auto row) { return row * 2; });
+    assertEqualVectors(expected, results);
+  }
+
+  auto inputVector = makeFlatVector<StringView>(
+      {"hello", "my", "remote", "world", "of", "split", "requests"});
+  auto inputVector1 = makeFlatVector<int32_t>({2, 1, 3, 5, 2, 4, 1});
+  auto results = evaluate<SimpleVector<StringView>>(
+      "remote_split_substr(c0, c1)",
+      makeRowVector({inputVector, inputVector1}));
+
+  auto expected = makeFlatVector<StringView>(
+      {"ello", "my", "mote", "d", "f", "it", "requests"});
+  assertEqualVectors(expected, results);
+}
+
 TEST_P(RemoteFunctionTest, connectionError) {
   auto inputVector = makeFlatVector<int64_t>({1, 2, 3, 4, 5});
   auto func = [&]() {
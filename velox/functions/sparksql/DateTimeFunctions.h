@@ -138,6 +138,8 @@ struct UnixDateFunction {
 
 template <typename T>
 struct UnixTimestampFunction {
+  static constexpr bool is_time_dependent = true;
+
   // unix_timestamp();
   // If no parameters, return the current unix timestamp without adjusting
   // timezones.
@@ -234,6 +234,12 @@ class DecimalBaseFunction : public exec::VectorFunction {
       exec::EvalCtx& context,
       VectorPtr& result) const override {
     auto rawResults = prepareResults(rows, resultType, context, result);
+    if constexpr (Operation::kHasBatchKernel) {
+      if (rPrecision_ < LongDecimalType::kMaxPrecision &&
+          rows.isAllSelected() && applyBatch(rows, args, rawResults, result)) {
+        return;
+      }
+    }
     if (args[0]->isConstantEncoding() && args[1]->isFlatEncoding()) {
       // Fast path for (const, flat).
       auto constant = args[0]->asUnchecked<SimpleVector<A>>()->valueAt(0);
@@ -344,6 +350,74 @@ class DecimalBaseFunction : public exec::VectorFunction {
   }
 
  private:
+  // Applies the batch kernel of 'Operation' to consecutive 'rows' of flat or
+  // constant 'args'. Returns false if 'args' have other encodings. The kernel
+  // can not overflow below the max precision and the results are checked
+  // against the result precision without branches, so that the loop is
+  // vectorized for short decimals. The rows out of range are set to null in a
+  // second pass.
+  bool applyBatch(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      R* rawResults,
+      VectorPtr& result) const {
+    const auto aConstant = args[0]->isConstantEncoding();
+    const auto bConstant = args[1]->isConstantEncoding();
+    if ((!aConstant && !args[0]->isFlatEncoding()) ||
+        (!bConstant && !args[1]->isFlatEncoding())) {
+      return false;
+    }
+    const A aValue = aConstant
+        ? args[0]->asUnchecked<SimpleVector<A>>()->valueAt(0)
+        : A(0);
+    const B bValue = bConstant
+        ? args[1]->asUnchecked<SimpleVector<B>>()->valueAt(0)
+        : B(0);
+    const A* rawA = aConstant
+        ? &aValue
+        : args[0]->asUnchecked<FlatVector<A>>()->rawValues();
+    const B* rawB = bConstant
+        ? &bValue
+        : args[1]->asUnchecked<FlatVector<B>>()->rawValues();
+
+    const R aMultiplier = R(velox::DecimalUtil::kPowersOfTen[aRescale_]);
+    const R bMultiplier = R(velox::DecimalUtil::kPowersOfTen[bRescale_]);
+    const R bound = R(velox::DecimalUtil::kPowersOfTen[rPrecision_]);
+    bool outOfRange = false;
+    auto run = [&](auto aStep, auto bStep) {
+      for (auto row = rows.begin(); row < rows.end(); ++row) {
+        const R value = Operation::template applyBatch<R>(
+            R(rawA[row * aStep]),
+            R(rawB[row * bStep]),
+            aMultiplier,
+            bMultiplier);
+        rawResults[row] = value;
+        outOfRange |= (value >= bound) | (value <= -bound);
+      }
+    };
+    // The steps are compile time constants so that the loop of each case is
+    // specialized.
+    if (aConstant) {
+      run(std::integral_constant<int32_t, 0>(),
+          std::integral_constant<int32_t, 1>());
+    } else if (bConstant) {
+      run(std::integral_constant<int32_t, 1>(),
+          std::integral_constant<int32_t, 0>());
+    } else {
+      run(std::integral_constant<int32_t, 1>(),
+          std::integral_constant<int32_t, 1>());
+    }
+    if (FOLLY_UNLIKELY(outOfRange)) {
+      rows.applyToSelected([&](auto row) {
+        if (!velox::DecimalUtil::valueInPrecisionRange(
+                rawResults[row], rPrecision_)) {
+          result->setNull(row, true);
+        }
+      });
+    }
+    return true;
+  }
+
   R* prepareResults(
       const SelectivityVector& rows,
       const TypePtr& resultType,
@@ -366,6 +440,16 @@ class DecimalBaseFunction : public exec::VectorFunction {
 
 class Addition {
  public:
+  static constexpr bool kHasBatchKernel = true;
+
+  // Returns the result of apply() for a result precision below the max
+  // precision, in which case the result can not overflow.
+  template <typename R>
+  FOLLY_ALWAYS_INLINE static R
+  applyBatch(R a, R b, R aMultiplier, R bMultiplier) {
+    return a * aMultiplier + b * bMultiplier;
+  }
+
   template <typename TResult, typename A, typename B>
   inline static void apply(
       TResult& r,
@@ -426,6 +510,14 @@ class Addition {
 
 class Subtraction {
  public:
+  static constexpr bool kHasBatchKernel = true;
+
+  template <typename R>
+  FOLLY_ALWAYS_INLINE static R
+  applyBatch(R a, R b, R aMultiplier, R bMultiplier) {
+    return a * aMultiplier - b * bMultiplier;
+  }
+
   template <typename TResult, typename A, typename B>
   inline static void apply(
       TResult& r,
@@ -472,6 +564,15 @@ class Subtraction {
 
 class Multiply {
  public:
+  static constexpr bool kHasBatchKernel = true;
+
+  // The rescale factors of multiply are 0.
+  template <typename R>
+  FOLLY_ALWAYS_INLINE static R
+  applyBatch(R a, R b, R /*aMultiplier*/, R /*bMultiplier*/) {
+    return a * b;
+  }
+
   // Derive from Arrow.
   // https://github.com/apache/arrow/blob/release-12.0.1-rc1/cpp/src/gandiva/precompiled/decimal_ops.cc#L331
   template <typename R, typename A, typename B>
@@ -590,6 +691,8 @@ class Multiply {
 
 class Divide {
  public:
+  static constexpr bool kHasBatchKernel = false;
+
   template <typename R, typename A, typename B>
   inline static void apply(
       R& r,
@@ -16,6 +16,7 @@
 #include "velox/functions/sparksql/Hash.h"
 
 #include <folly/CPortability.h>
+#include <xsimd/xsimd.hpp>
 
 #include "velox/common/base/BitUtil.h"
 #include "velox/expression/DecodedArgs.h"
@@ -54,6 +55,22 @@ void applyWithType(
           decoded->nulls(&rows), rows.begin(), rows.end());
       selected = selectedMinusNulls.get();
     }
+    // Flat columns without nulls are hashed a SIMD batch of rows at a time,
+    // chaining the hashes of the previous columns as seeds.
+    if (selected == &rows && rows.isAllSelected() &&
+        decoded->isIdentityMapping()) {
+      auto* rawResults = result.mutableRawValues();
+      if (args[i]->type()->kind() == TypeKind::INTEGER) {
+        hash.hashInt32s(
+            decoded->data<int32_t>(), rows.begin(), rows.end(), rawResults);
+        continue;
+      }
+      if (args[i]->type()->kind() == TypeKind::BIGINT) {
+        hash.hashInt64s(
+            decoded->data<int64_t>(), rows.begin(), rows.end(), rawResults);
+        continue;
+      }
+    }
     switch (args[i]->type()->kind()) {
 // Derived from InterpretedHashFunction.hash:
 // https://github.com/apache/spark/blob/382b66e/sql/catalyst/src/main/scala/org/apache/spark/sql/catalyst/expressions/hash.scala#L532
@@ -96,7 +113,7 @@ void applyWithType(
 class Murmur3Hash final {
  public:
   uint32_t hashInt32(int32_t input, uint32_t seed) {
-    uint32_t k1 = mixK1(input);
+    uint32_t k1 = mixK1(static_cast<uint32_t>(input));
     uint32_t h1 = mixH1(seed, k1);
     return fmix(h1, 4);
   }
@@ -114,6 +131,56 @@ class Murmur3Hash final {
     return fmix(h1, 8);
   }
 
+  // Replaces 'hashes[row]' with hashInt32(values[row], hashes[row]) for rows
+  // in [begin, end).
+  void hashInt32s(
+      const int32_t* values,
+      vector_size_t begin,
+      vector_size_t end,
+      int32_t* hashes) {
+    using Batch = xsimd::batch<uint32_t>;
+    constexpr int32_t kWidth = Batch::size;
+    const auto* rawValues = reinterpret_cast<const uint32_t*>(values);
+    auto* rawHashes = reinterpret_cast<uint32_t*>(hashes);
+    auto row = begin;
+    for (; row + kWidth <= end; row += kWidth) {
+      const auto k1 = mixK1(Batch::load_unaligned(rawValues + row));
+      const auto h1 = mixH1(Batch::load_unaligned(rawHashes + row), k1);
+      fmix(h1, 4).store_unaligned(rawHashes + row);
+    }
+    for (; row < end; ++row) {
+      hashes[row] = hashInt32(values[row], hashes[row]);
+    }
+  }
+
+  // Same as hashInt32s() for hashInt64().
+  void hashInt64s(
+      const int64_t* values,
+      vector_size_t begin,
+      vector_size_t end,
+      int32_t* hashes) {
+    using Batch = xsimd::batch<uint32_t>;
+    constexpr int32_t kWidth = Batch::size;
+    alignas(xsimd::default_arch::alignment()) uint32_t low[kWidth];
+    alignas(xsimd::default_arch::alignment()) uint32_t high[kWidth];
+    auto* rawHashes = reinterpret_cast<uint32_t*>(hashes);
+    auto row = begin;
+    for (; row + kWidth <= end; row += kWidth) {
+      for (auto i = 0; i < kWidth; ++i) {
+        low[i] = values[row + i];
+        high[i] = static_cast<uint64_t>(values[row + i]) >> 32;
+      }
+      auto h1 = mixH1(
+          Batch::load_unaligned(rawHashes + row),
+          mixK1(Batch::load_aligned(low)));
+      h1 = mixH1(h1, mixK1(Batch::load_aligned(high)));
+      fmix(h1, 8).store_unaligned(rawHashes + row);
+    }
+    for (; row < end; ++row) {
+      hashes[row] = hashInt64(values[row], hashes[row]);
+    }
+  }
+
   // Floating point numbers are hashed as if they are integers, with
   // -0f defined to have the same output as +0f.
   uint32_t hashFloat(float input, uint32_t seed) {
@@ -136,7 +203,7 @@ class Murmur3Hash final {
       h1 = mixH1(h1, mixK1(*reinterpret_cast<const uint32_t*>(i)));
     }
     for (; i != end; ++i) {
-      h1 = mixH1(h1, mixK1(*i));
+      h1 = mixH1(h1, mixK1(static_cast<uint32_t>(*i)));
     }
     return fmix(h1, input.size());
   }
@@ -152,27 +219,37 @@ class Murmur3Hash final {
   }
 
  private:
-  uint32_t mixK1(uint32_t k1) {
-    k1 *= 0xcc9e2d51;
-    k1 = bits::rotateLeft(k1, 15);
-    k1 *= 0x1b873593;
+  // The mixing steps take either uint32_t or xsimd::batch<uint32_t>, so that
+  // the batch kernels compute the same hashes as the scalar functions.
+  template <typename V>
+  static V rotateLeft(V value, int32_t shift) {
+    return (value << shift) | (value >> (32 - shift));
+  }
+
+  template <typename V>
+  static V mixK1(V k1) {
+    k1 *= V(0xcc9e2d51);
+    k1 = rotateLeft(k1, 15);
+    k1 *= V(0x1b873593);
     return k1;
   }
 
-  uint32_t mixH1(uint32_t h1, uint32_t k1) {
+  template <typename V>
+  static V mixH1(V h1, V k1) {
     h1 ^= k1;
-    h1 = bits::rotateLeft(h1, 13);
-    h1 = h1 * 5 + 0xe6546b64;
+    h1 = rotateLeft(h1, 13);
+    h1 = h1 * V(5) + V(0xe6546b64);
     return h1;
   }
 
   // Finalization mix - force all bits of a hash block to avalanche
-  uint32_t fmix(uint32_t h1, uint32_t length) {
-    h1 ^= length;
+  template <typename V>
+  static V fmix(V h1, uint32_t length) {
+    h1 ^= V(length);
     h1 ^= h1 >> 16;
-    h1 *= 0x85ebca6b;
+    h1 *= V(0x85ebca6b);
     h1 ^= h1 >> 13;
-    h1 *= 0xc2b2ae35;
+    h1 *= V(0xc2b2ae35);
     h1 ^= h1 >> 16;
     return h1;
   }
@@ -219,6 +296,55 @@ class XxHash64 final {
     return fmix(hash);
   }
 
+  // Replaces 'hashes[row]' with hashInt32(values[row], hashes[row]) for rows
+  // in [begin, end).
+  void hashInt32s(
+      const int32_t* values,
+      vector_size_t begin,
+      vector_size_t end,
+      int64_t* hashes) {
+    using Batch = xsimd::batch<uint64_t>;
+    constexpr int32_t kWidth = Batch::size;
+    alignas(xsimd::default_arch::alignment()) uint64_t inputs[kWidth];
+    auto* rawHashes = reinterpret_cast<uint64_t*>(hashes);
+    auto row = begin;
+    for (; row + kWidth <= end; row += kWidth) {
+      for (auto i = 0; i < kWidth; ++i) {
+        inputs[i] = static_cast<uint32_t>(values[row + i]);
+      }
+      auto hash = Batch::load_unaligned(rawHashes + row) + Batch(PRIME64_5 + 4);
+      hash ^= Batch::load_aligned(inputs) * Batch(PRIME64_1);
+      hash = rotateLeft(hash, 23) * Batch(PRIME64_2) + Batch(PRIME64_3);
+      fmixBatch(hash).store_unaligned(rawHashes + row);
+    }
+    for (; row < end; ++row) {
+      hashes[row] = hashInt32(values[row], hashes[row]);
+    }
+  }
+
+  // Same as hashInt32s() for hashInt64().
+  void hashInt64s(
+      const int64_t* values,
+      vector_size_t begin,
+      vector_size_t end,
+      int64_t* hashes) {
+    using Batch = xsimd::batch<uint64_t>;
+    constexpr int32_t kWidth = Batch::size;
+    const auto* rawValues = reinterpret_cast<const uint64_t*>(values);
+    auto* rawHashes = reinterpret_cast<uint64_t*>(hashes);
+    auto row = begin;
+    for (; row + kWidth <= end; row += kWidth) {
+      const auto input = Batch::load_unaligned(rawValues + row);
+      auto hash = Batch::load_unaligned(rawHashes + row) + Batch(PRIME64_5 + 8);
+      hash ^= rotateLeft(input * Batch(PRIME64_2), 31) * Batch(PRIME64_1);
+      hash = rotateLeft(hash, 27) * Batch(PRIME64_1) + Batch(PRIME64_4);
+      fmixBatch(hash).store_unaligned(rawHashes + row);
+    }
+    for (; row < end; ++row) {
+      hashes[row] = hashInt64(values[row], hashes[row]);
+    }
+  }
+
   // Floating point numbers are hashed as if they are integers, with
   // -0f defined to have the same output as +0f.
   int64_t hashFloat(float input, uint64_t seed) {
@@ -273,6 +399,23 @@ class XxHash64 final {
     return hash;
   }
 
+  static xsimd::batch<uint64_t> rotateLeft(
+      xsimd::batch<uint64_t> value,
+      int32_t shift) {
+    return (value << shift) | (value >> (64 - shift));
+  }
+
+  // Same as fmix() over a batch of hashes.
+  xsimd::batch<uint64_t> fmixBatch(xsimd::batch<uint64_t> hash) {
+    using Batch = xsimd::batch<uint64_t>;
+    hash ^= hash >> 33;
+    hash *= Batch(PRIME64_2);
+    hash ^= hash >> 29;
+    hash *= Batch(PRIME64_3);
+    hash ^= hash >> 32;
+    return hash;
+  }
+
   uint64_t hashBytesByWords(const StringView& input, uint64_t seed) {
     const char* i = input.data();
     const char* const end = input.data() + input.size();
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/sparksql/MightContain.h"
+
+#include <folly/hash/Hash.h>
+
+#include "velox/common/base/BloomFilter.h"
+#include "velox/expression/DecodedArgs.h"
+
+namespace facebook::velox::functions::sparksql {
+namespace {
+
+class BloomFilterMightContainFunction final : public exec::VectorFunction {
+ public:
+  explicit BloomFilterMightContainFunction(const char* serialized) {
+    if (serialized != nullptr) {
+      bloomFilter_.merge(serialized);
+    }
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /*outputType*/,
+      exec::EvalCtx& context,
+      VectorPtr& result) const final {
+    context.ensureWritable(rows, BOOLEAN(), result);
+    result->clearNulls(rows);
+    auto* flatResult = result->asUnchecked<FlatVector<bool>>();
+    if (!bloomFilter_.isSet()) {
+      rows.applyToSelected([&](auto row) { flatResult->set(row, false); });
+      return;
+    }
+
+    exec::DecodedArgs decodedArgs(rows, args, context);
+    auto* decoded = decodedArgs.at(1);
+    if (!decoded->isIdentityMapping()) {
+      rows.applyToSelected([&](auto row) {
+        flatResult->set(
+            row,
+            bloomFilter_.mayContain(
+                folly::hasher<int64_t>()(decoded->valueAt<int64_t>(row))));
+      });
+      return;
+    }
+
+    // Probes the filter 64 rows at a time and merges the result bits of the
+    // selected rows into the result words. The values of unselected and null
+    // rows are hashed too since they are readable and this keeps the probe
+    // branch free.
+    const auto* values = decoded->data<int64_t>();
+    const auto* selectedBits = rows.asRange().bits();
+    auto* rawResult = flatResult->mutableRawValues<uint64_t>();
+    uint64_t hashes[64];
+    for (auto word = rows.begin() / 64; word * 64 < rows.end(); ++word) {
+      const auto begin = word * 64;
+      const auto numValues = std::min<int32_t>(64, rows.end() - begin);
+      const auto selected = numValues == 64
+          ? selectedBits[word]
+          : selectedBits[word] & bits::lowMask(numValues);
+      if (selected == 0) {
+        continue;
+      }
+      for (auto i = 0; i < numValues; ++i) {
+        hashes[i] = folly::hasher<int64_t>()(values[begin + i]);
+      }
+      uint64_t mayContain;
+      bloomFilter_.mayContain(hashes, numValues, &mayContain);
+      rawResult[word] = (rawResult[word] & ~selected) | (mayContain & selected);
+    }
+  }
+
+ private:
+  BloomFilter<> bloomFilter_;
+};
+
+} // namespace
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> mightContainSignatures() {
+  return {exec::FunctionSignatureBuilder()
+              .returnType("boolean")
+              .argumentType("varbinary")
+              .argumentType("bigint")
+              .build()};
+}
+
+std::shared_ptr<exec::VectorFunction> makeMightContain(
+    const std::string& /*name*/,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  const auto& constantFilter = inputArgs[0].constantValue;
+  if (constantFilter == nullptr || constantFilter->isNullAt(0)) {
+    return std::make_shared<BloomFilterMightContainFunction>(nullptr);
+  }
+  return std::make_shared<BloomFilterMightContainFunction>(
+      constantFilter->as<ConstantVector<StringView>>()->valueAt(0).data());
+}
+
+} // namespace facebook::velox::functions::sparksql
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/sparksql/Register.h"
+
+using namespace facebook;
+
+using namespace facebook::velox;
+
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+  functions::sparksql::registerFunctions("");
+  functions::prestosql::registerArithmeticFunctions("presto_");
+
+  ExpressionBenchmarkBuilder benchmarkBuilder;
+  for (const auto& [name, type] :
+       std::vector<std::pair<std::string, TypePtr>>{
+           {"short", ROW({"c0", "c1"}, {DECIMAL(10, 2), DECIMAL(12, 4)})},
+           {"long", ROW({"c0", "c1"}, {DECIMAL(30, 2), DECIMAL(32, 4)})},
+           {"max_precision",
+            ROW({"c0", "c1"}, {DECIMAL(38, 2), DECIMAL(38, 4)})}}) {
+    auto& benchmarkSet =
+        benchmarkBuilder.addBenchmarkSet(name, type)
+            .withFuzzerOptions({.vectorSize = 1000, .nullRatio = 0})
+            .addExpression("spark_add", "add(c0, c1)")
+            .addExpression("spark_subtract", "subtract(c0, c1)")
+            .addExpression("spark_multiply", "multiply(c0, c1)")
+            .addExpression("spark_divide", "divide(c0, c1)")
+            .addExpression(
+                "spark_add_constant", "add(c0, cast(1.5 as decimal(2, 1)))")
+            .withIterations(100)
+            .disableTesting();
+    // Presto throws on overflow, which only random values of the max
+    // precision may have.
+    if (name != "max_precision") {
+      benchmarkSet.addExpression("presto_plus", "presto_plus(c0, c1)")
+          .addExpression("presto_minus", "presto_minus(c0, c1)");
+    }
+  }
+
+  benchmarkBuilder.registerBenchmarks();
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/hash/Hash.h>
+#include <folly/init/Init.h>
+
+#include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
+#include "velox/common/base/BloomFilter.h"
+#include "velox/functions/sparksql/Register.h"
+
+using namespace facebook;
+
+using namespace facebook::velox;
+
+namespace {
+
+constexpr int32_t kNumHashes = 10'000;
+
+// A filter of 100K values probed with hashes of which about 1 in 10 is in
+// the filter.
+struct BloomFilterProbe {
+  BloomFilterProbe() {
+    folly::Random::DefaultGenerator rng(1);
+    filter.reset(100'000);
+    for (auto i = 0; i < 100'000; ++i) {
+      filter.insert(folly::hasher<int64_t>()(i));
+    }
+    for (auto i = 0; i < kNumHashes; ++i) {
+      hashes.push_back(
+          folly::hasher<int64_t>()(folly::Random::rand32(1'000'000, rng)));
+    }
+  }
+
+  BloomFilter<> filter;
+  std::vector<uint64_t> hashes;
+  std::vector<uint64_t> result =
+      std::vector<uint64_t>(bits::nwords(kNumHashes));
+};
+
+BloomFilterProbe& probe() {
+  static BloomFilterProbe kProbe;
+  return kProbe;
+}
+
+BENCHMARK(mightContainRowByRow) {
+  auto& state = probe();
+  for (auto i = 0; i < kNumHashes; ++i) {
+    bits::setBit(
+        state.result.data(), i, state.filter.mayContain(state.hashes[i]));
+  }
+  folly::doNotOptimizeAway(state.result);
+}
+
+BENCHMARK_RELATIVE(mightContainBatch) {
+  auto& state = probe();
+  state.filter.mayContain(
+      state.hashes.data(), state.hashes.size(), state.result.data());
+  folly::doNotOptimizeAway(state.result);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+  functions::sparksql::registerFunctions("");
+
+  // Integer and bigint columns without nulls take the batch kernels, the ones
+  // with nulls are hashed row by row.
+  ExpressionBenchmarkBuilder benchmarkBuilder;
+  for (const auto& [name, nullRatio] :
+       {std::pair<std::string, double>{"no_nulls", 0},
+        std::pair<std::string, double>{"nulls", 0.1}}) {
+    benchmarkBuilder
+        .addBenchmarkSet(
+            fmt::format("hash_{}", name),
+            ROW({"c0", "c1", "c2"}, {INTEGER(), BIGINT(), BIGINT()}))
+        .withFuzzerOptions({.vectorSize = 1000, .nullRatio = nullRatio})
+        .addExpression("murmur3_int", "hash(c0)")
+        .addExpression("murmur3_bigint", "hash(c1)")
+        .addExpression("murmur3_3_columns", "hash(c0, c1, c2)")
+        .addExpression("xxhash64_int", "xxhash64(c0)")
+        .addExpression("xxhash64_bigint", "xxhash64(c1)")
+        .addExpression("xxhash64_3_columns", "xxhash64(c0, c1, c2)")
+        .withIterations(100);
+  }
+
+  benchmarkBuilder.registerBenchmarks();
+  folly::runBenchmarks();
+  return 0;
+}
@@ -416,6 +416,61 @@ TEST_F(DecimalArithmeticTest, multiply) {
           DECIMAL(38, 0))});
 }
 
+TEST_F(DecimalArithmeticTest, flatBatch) {
+  // Flat and constant inputs without nulls are computed in one batch.
+  constexpr vector_size_t kSize = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          kSize, [](auto row) { return row * 101; }, nullptr, DECIMAL(10, 2)),
+      makeFlatVector<int64_t>(
+          kSize, [](auto row) { return -row * 7; }, nullptr, DECIMAL(12, 4)),
+      makeFlatVector<int128_t>(
+          kSize,
+          [](auto row) { return HugeInt::build(row, 1) * (row % 2 ? 1 : -1); },
+          nullptr,
+          DECIMAL(30, 2)),
+  });
+
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) { return row * 10'100 - row * 7; },
+          nullptr,
+          DECIMAL(13, 4)),
+      evaluate("add(c0, c1)", data));
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) { return row * 10'100 + row * 7; },
+          nullptr,
+          DECIMAL(13, 4)),
+      evaluate("subtract(c0, c1)", data));
+  assertEqualVectors(
+      makeFlatVector<int128_t>(
+          kSize,
+          [](auto row) { return int128_t(row * 101) * (-row * 7); },
+          nullptr,
+          DECIMAL(23, 6)),
+      evaluate("multiply(c0, c1)", data));
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) { return row * 10'100 + 12'345; },
+          nullptr,
+          DECIMAL(13, 4)),
+      evaluate("add(c0, cast(1.2345 as decimal(5, 4)))", data));
+  assertEqualVectors(
+      makeFlatVector<int128_t>(
+          kSize,
+          [](auto row) {
+            return HugeInt::build(row, 1) * (row % 2 ? 1 : -1) * 100 -
+                row * 7;
+          },
+          nullptr,
+          DECIMAL(33, 4)),
+      evaluate("add(c2, c1)", data));
+}
+
 TEST_F(DecimalArithmeticTest, decimalDivTest) {
   auto shortFlat = makeFlatVector<int64_t>({1000, 2000}, DECIMAL(17, 3));
   // Divide short and short, returning long.
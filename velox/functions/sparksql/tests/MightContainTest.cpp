@@ -15,6 +15,9 @@
  */
 
 #include "velox/functions/sparksql/MightContain.h"
+
+#include <folly/hash/Hash.h>
+
 #include "velox/common/base/BloomFilter.h"
 #include "velox/functions/sparksql/tests/SparkFunctionBaseTest.h"
 
@@ -84,6 +87,27 @@ TEST_F(MightContainTest, basic) {
   testMightContain(serialized, values, expected);
 }
 
+TEST_F(MightContainTest, manyRows) {
+  constexpr int32_t kSize = 1'000;
+  auto serialized = getSerializedBloomFilter(kSize);
+  BloomFilter bloomFilter;
+  bloomFilter.merge(serialized.data());
+  // Covers full and partial words of rows with values in and out of the
+  // filter.
+  auto values = makeFlatVector<int64_t>(
+      kSize + 37, [](vector_size_t row) { return row * 3; });
+  auto expected = makeFlatVector<bool>(kSize + 37, [&](vector_size_t row) {
+    return bloomFilter.mayContain(folly::hasher<int64_t>()(row * 3));
+  });
+  testMightContain(serialized, values, expected);
+
+  auto nullableValues = makeFlatVector<int64_t>(
+      kSize, [](vector_size_t row) { return row; }, nullEvery(7));
+  auto expectedNullable = makeFlatVector<bool>(
+      kSize, [](vector_size_t /*row*/) { return true; }, nullEvery(7));
+  testMightContain(serialized, nullableValues, expectedNullable);
+}
+
 TEST_F(MightContainTest, nullBloomFilter) {
   auto value = makeFlatVector<int64_t>({2, 4});
   auto expected = makeNullConstant(TypeKind::BOOLEAN, value->size());
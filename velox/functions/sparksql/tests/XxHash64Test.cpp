@@ -177,5 +177,25 @@ TEST_F(XxHash64Test, hashSeedVarcharArgs) {
   EXPECT_EQ(xxhash64WithSeed(0L, "", "hello"), 1992633642622160295);
 }
 
+// Flat columns without nulls are hashed a batch of rows at a time. Checks that
+// they hash like the same columns wrapped in identity dictionaries, which are
+// hashed row by row.
+TEST_F(XxHash64Test, flatColumns) {
+  constexpr vector_size_t kSize = 1'037;
+  auto ints = makeFlatVector<int32_t>(
+      kSize, [](auto row) { return row * 0x9E3779B1; });
+  auto longs = makeFlatVector<int64_t>(
+      kSize, [](auto row) { return row * 0x9E3779B97F4A7C15L; });
+  auto indices = makeIndices(kSize, [](auto row) { return row; });
+  auto flat = makeRowVector({ints, longs});
+  auto dictionary = makeRowVector(
+      {wrapInDictionary(indices, ints), wrapInDictionary(indices, longs)});
+  for (const auto& expression :
+       {"xxhash64(c0, c1)", "xxhash64(c1, c0)", "xxhash64(c0)"}) {
+    velox::test::assertEqualVectors(
+        evaluate(expression, dictionary), evaluate(expression, flat));
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::functions::sparksql::test
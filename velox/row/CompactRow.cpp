@@ -479,6 +479,172 @@ int32_t CompactRow::serializeVariableWidth(vector_size_t index, char* buffer) {
 
 namespace {
 
+// Writes non-null values of a fixed-width field at 'valueOffsets' within the
+// serialized rows. Sets null bits for null values. Advances 'valueOffsets' for
+// all rows since null fixed-width values still take space.
+template <TypeKind Kind>
+void serializeFixedWidthValues(
+    const DecodedVector& decoded,
+    column_index_t column,
+    vector_size_t size,
+    const vector_size_t* indices,
+    char* buffer,
+    const size_t* bufferOffsets,
+    int64_t* valueOffsets) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  constexpr int32_t kValueBytes =
+      std::is_same_v<T, Timestamp> ? sizeof(int64_t) : sizeof(T);
+  for (auto row = 0; row < size; ++row) {
+    char* rowBuffer = buffer + bufferOffsets[row];
+    if (decoded.isNullAt(indices[row])) {
+      bits::setBit(reinterpret_cast<uint8_t*>(rowBuffer), column, true);
+    } else if constexpr (std::is_same_v<T, Timestamp>) {
+      const auto micros = decoded.valueAt<Timestamp>(indices[row]).toMicros();
+      memcpy(rowBuffer + valueOffsets[row], &micros, sizeof(int64_t));
+    } else {
+      const T value = decoded.valueAt<T>(indices[row]);
+      memcpy(rowBuffer + valueOffsets[row], &value, sizeof(T));
+    }
+    valueOffsets[row] += kValueBytes;
+  }
+}
+} // namespace
+
+void CompactRow::rowSizes(
+    vector_size_t offset,
+    vector_size_t size,
+    int32_t* sizes) {
+  int32_t fixedSize = rowNullBytes_;
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      fixedSize += children_[i].valueBytes_;
+    }
+  }
+  std::fill(sizes, sizes + size, fixedSize);
+
+  std::vector<vector_size_t> childIndices;
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    if (childIndices.empty()) {
+      childIndices.resize(size);
+      for (auto row = 0; row < size; ++row) {
+        childIndices[row] = decoded_.index(offset + row);
+      }
+    }
+
+    auto& child = children_[i];
+    if (child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY) {
+      for (auto row = 0; row < size; ++row) {
+        if (!child.isNullAt(childIndices[row])) {
+          sizes[row] += kSizeBytes +
+              child.decoded_.valueAt<StringView>(childIndices[row]).size();
+        }
+      }
+    } else {
+      for (auto row = 0; row < size; ++row) {
+        if (!child.isNullAt(childIndices[row])) {
+          sizes[row] += child.variableWidthRowSize(childIndices[row]);
+        }
+      }
+    }
+  }
+}
+
+void CompactRow::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    char* buffer,
+    const size_t* bufferOffsets) {
+  std::vector<vector_size_t> childIndices(size);
+  for (auto row = 0; row < size; ++row) {
+    childIndices[row] = decoded_.index(offset + row);
+  }
+
+  std::vector<int64_t> valueOffsets(size, rowNullBytes_);
+  for (auto i = 0; i < children_.size(); ++i) {
+    serializeColumn(
+        i,
+        size,
+        childIndices.data(),
+        buffer,
+        bufferOffsets,
+        valueOffsets.data());
+  }
+}
+
+void CompactRow::serializeColumn(
+    column_index_t column,
+    vector_size_t size,
+    const vector_size_t* childIndices,
+    char* buffer,
+    const size_t* bufferOffsets,
+    int64_t* valueOffsets) {
+  auto& child = children_[column];
+
+  switch (child.typeKind_) {
+    case TypeKind::VARCHAR:
+      [[fallthrough]];
+    case TypeKind::VARBINARY:
+      for (auto row = 0; row < size; ++row) {
+        char* rowBuffer = buffer + bufferOffsets[row];
+        if (child.isNullAt(childIndices[row])) {
+          bits::setBit(reinterpret_cast<uint8_t*>(rowBuffer), column, true);
+          continue;
+        }
+        const auto value =
+            child.decoded_.valueAt<StringView>(childIndices[row]);
+        char* valueBuffer = rowBuffer + valueOffsets[row];
+        writeInt32(valueBuffer, value.size());
+        if (!value.empty()) {
+          memcpy(valueBuffer + kSizeBytes, value.data(), value.size());
+        }
+        valueOffsets[row] += kSizeBytes + value.size();
+      }
+      return;
+    case TypeKind::UNKNOWN:
+      // UNKNOWN values are always null and do not take up space.
+      for (auto row = 0; row < size; ++row) {
+        bits::setBit(
+            reinterpret_cast<uint8_t*>(buffer + bufferOffsets[row]),
+            column,
+            true);
+      }
+      return;
+    default:
+      break;
+  }
+
+  if (child.fixedWidthTypeKind_) {
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        serializeFixedWidthValues,
+        child.typeKind_,
+        child.decoded_,
+        column,
+        size,
+        childIndices,
+        buffer,
+        bufferOffsets,
+        valueOffsets);
+    return;
+  }
+
+  // Complex types are serialized one row at a time.
+  for (auto row = 0; row < size; ++row) {
+    char* rowBuffer = buffer + bufferOffsets[row];
+    if (child.isNullAt(childIndices[row])) {
+      bits::setBit(reinterpret_cast<uint8_t*>(rowBuffer), column, true);
+    } else {
+      valueOffsets[row] += child.serializeVariableWidth(
+          childIndices[row], rowBuffer + valueOffsets[row]);
+    }
+  }
+}
+
+namespace {
+
 // Reads single fixed-width value from buffer into flatVector[index].
 template <typename T>
 void readFixedWidthValue(
@@ -599,13 +765,37 @@ VectorPtr deserializeFixedWidthArrays(
   return flatVector;
 }
 
+// Returns the number of bytes of the string at 'buffer' that go to the string
+// buffer of the result vector, i.e. 0 if the string fits inline.
+int32_t nonInlineSize(const char* buffer) {
+  const int32_t size = readInt32(buffer);
+  return StringView::isInline(size) ? 0 : size;
+}
+
+// Allocates 'totalSize' bytes for the non-inline strings of 'flatVector' in a
+// single string buffer. Returns nullptr if 'totalSize' is 0.
+char* allocateStrings(FlatVector<StringView>* flatVector, size_t totalSize) {
+  if (totalSize == 0) {
+    return nullptr;
+  }
+  return flatVector->getRawStringBufferWithSpace(totalSize, true);
+}
+
+// Reads the string at 'buffer' into flatVector[index]. A string that does not
+// fit inline is copied to 'stringBuffer', which is then advanced past it.
 int32_t readString(
     const char* buffer,
     FlatVector<StringView>* flatVector,
-    vector_size_t index) {
-  int32_t size = readInt32(buffer);
-  StringView value(buffer + kSizeBytes, size);
-  flatVector->set(index, value);
+    vector_size_t index,
+    char*& stringBuffer) {
+  const int32_t size = readInt32(buffer);
+  if (StringView::isInline(size)) {
+    flatVector->setNoCopy(index, StringView(buffer + kSizeBytes, size));
+  } else {
+    memcpy(stringBuffer, buffer + kSizeBytes, size);
+    flatVector->setNoCopy(index, StringView(stringBuffer, size));
+    stringBuffer += size;
+  }
   return kSizeBytes + size;
 }
 
@@ -621,6 +811,8 @@ VectorPtr deserializeUnknowns(
 // Deserializes one string from each 'row' in 'data'.
 // Each strings starts at data[row].data() + offsets[row].
 // string size | <string bytes>
+// Sizes all strings first, so that the ones that are not inlined are copied
+// into a single string buffer.
 // Advances the offsets past the strings.
 VectorPtr deserializeStrings(
     const TypePtr& type,
@@ -634,12 +826,20 @@ VectorPtr deserializeStrings(
 
   auto* rawNulls = nulls->as<uint64_t>();
 
+  size_t stringBytes = 0;
+  for (auto i = 0; i < numRows; ++i) {
+    if (!bits::isBitNull(rawNulls, i)) {
+      stringBytes += nonInlineSize(data[i].data() + offsets[i]);
+    }
+  }
+  char* rawStrings = allocateStrings(flatVector.get(), stringBytes);
+
   for (auto i = 0; i < numRows; ++i) {
     if (bits::isBitNull(rawNulls, i)) {
       flatVector->setNull(i, true);
     } else {
-      offsets[i] +=
-          readString(data[i].data() + offsets[i], flatVector.get(), i);
+      offsets[i] += readString(
+          data[i].data() + offsets[i], flatVector.get(), i, rawStrings);
     }
   }
 
@@ -664,6 +864,8 @@ VectorPtr deserializeUnknownArrays(
 // null flags followed by the strings. The number of strings is provided in
 // sizes[row].
 // nulls | size-of-s1 | <s1> | size-of-s2 | <s2> |...
+// Like deserializeStrings, copies the strings that are not inlined into a
+// single string buffer.
 // Advances offsets past the last string.
 VectorPtr deserializeStringArrays(
     const TypePtr& type,
@@ -679,6 +881,23 @@ VectorPtr deserializeStringArrays(
   auto flatVector =
       BaseVector::create<FlatVector<StringView>>(type, total, pool);
 
+  size_t stringBytes = 0;
+  for (auto i = 0; i < numRows; ++i) {
+    const auto size = rawSizes[i];
+    if (size > 0) {
+      auto* buffer = data[i].data() + offsets[i];
+      auto* rawElementNulls = readNulls(buffer);
+      buffer += bits::nbytes(size);
+      for (auto j = 0; j < size; ++j) {
+        if (!bits::isBitSet(rawElementNulls, j)) {
+          stringBytes += nonInlineSize(buffer);
+          buffer += kSizeBytes + readInt32(buffer);
+        }
+      }
+    }
+  }
+  char* rawStrings = allocateStrings(flatVector.get(), stringBytes);
+
   vector_size_t index = 0;
   for (auto i = 0; i < numRows; ++i) {
     const auto size = rawSizes[i];
@@ -693,8 +912,8 @@ VectorPtr deserializeStringArrays(
         if (bits::isBitSet(rawElementNulls, j)) {
           flatVector->setNull(index++, true);
         } else {
-          offsets[i] +=
-              readString(data[i].data() + offsets[i], flatVector.get(), index);
+          offsets[i] += readString(
+              data[i].data() + offsets[i], flatVector.get(), index, rawStrings);
           ++index;
         }
       }
@@ -930,17 +1149,25 @@ RowVectorPtr deserializeRows(
 
   auto* rawNulls = nulls != nullptr ? nulls->as<uint64_t>() : nullptr;
 
+  // Scans the null flags of all fields in one pass over the rows. Fields of
+  // null structs are null.
   std::vector<BufferPtr> fieldNulls;
+  std::vector<uint64_t*> rawFieldNulls;
   fieldNulls.reserve(numFields);
+  rawFieldNulls.reserve(numFields);
   for (auto i = 0; i < numFields; ++i) {
-    fieldNulls.emplace_back(allocateNulls(numRows, pool));
-    auto* rawFieldNulls = fieldNulls.back()->asMutable<uint8_t>();
-    for (auto row = 0; row < numRows; ++row) {
-      auto* serializedNulls = readNulls(data[row].data() + offsets[row]);
-      const auto isNull =
-          (rawNulls != nullptr && bits::isBitNull(rawNulls, row)) ||
-          bits::isBitSet(serializedNulls, i);
-      bits::setBit(rawFieldNulls, row, !isNull);
+    fieldNulls.emplace_back(allocateNulls(numRows, pool, bits::kNull));
+    rawFieldNulls.push_back(fieldNulls.back()->asMutable<uint64_t>());
+  }
+  for (auto row = 0; row < numRows; ++row) {
+    if (rawNulls != nullptr && bits::isBitNull(rawNulls, row)) {
+      continue;
+    }
+    auto* serializedNulls = readNulls(data[row].data() + offsets[row]);
+    for (auto i = 0; i < numFields; ++i) {
+      if (!bits::isBitSet(serializedNulls, i)) {
+        bits::clearNull(rawFieldNulls[i], row);
+      }
     }
   }
 
@@ -36,8 +36,24 @@ class CompactRow {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Writes serialized sizes of 'size' rows starting at 'offset' into
+  /// 'sizes'. Equivalent to calling 'rowSize' for each row, but processes one
+  /// column at a time.
+  void rowSizes(vector_size_t offset, vector_size_t size, int32_t* sizes);
+
+  /// Serializes 'size' rows starting at 'offset' one column at a time. Row
+  /// 'offset + i' is written to 'buffer + bufferOffsets[i]'. Produces the same
+  /// bytes as calling 'serialize' for each row. 'buffer' must have sufficient
+  /// capacity for the sizes returned by 'rowSizes' and set to all zeros.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      char* buffer,
+      const size_t* bufferOffsets);
+
   /// Deserializes multiple rows into a RowVector of specified type. The type
-  /// must match the contents of the serialized rows.
+  /// must match the contents of the serialized rows. Reads one column at a
+  /// time.
   static RowVectorPtr deserialize(
       const std::vector<std::string_view>& data,
       const RowTypePtr& rowType,
@@ -108,6 +124,18 @@ class CompactRow {
   /// Serializes struct value to buffer. Value must not be null.
   int32_t serializeRow(vector_size_t index, char* buffer);
 
+  /// ROW type only. Writes values of field 'column' for 'size' rows into the
+  /// serialized rows at 'buffer + bufferOffsets[i] + valueOffsets[i]' and
+  /// advances 'valueOffsets' past the written values. 'childIndices' are the
+  /// row numbers in the field.
+  void serializeColumn(
+      column_index_t column,
+      vector_size_t size,
+      const vector_size_t* childIndices,
+      char* buffer,
+      const size_t* bufferOffsets,
+      int64_t* valueOffsets);
+
   const TypeKind typeKind_;
   DecodedVector decoded_;
 
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/row/UnsafeRowFast.h"
+#include "velox/row/UnsafeRowDeserializers.h"
+#include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::row {
 
@@ -408,4 +410,288 @@ int32_t UnsafeRowFast::serializeRow(vector_size_t index, char* buffer) {
 
   return variableWidthOffset;
 }
+
+namespace {
+
+// Writes non-null values of fixed-width field 'column' into the 8-byte slots
+// of the serialized rows. Sets null bits for null values.
+template <TypeKind Kind>
+void serializeFixedWidthValues(
+    const DecodedVector& decoded,
+    column_index_t column,
+    vector_size_t size,
+    const vector_size_t* indices,
+    size_t nullBytes,
+    char* buffer,
+    const size_t* bufferOffsets) {
+  using T = typename TypeTraits<Kind>::NativeType;
+
+  const size_t valueOffset = nullBytes + column * kFieldWidth;
+  for (auto row = 0; row < size; ++row) {
+    char* rowBuffer = buffer + bufferOffsets[row];
+    if (decoded.isNullAt(indices[row])) {
+      bits::setBit(rowBuffer, column, true);
+      continue;
+    }
+    if constexpr (std::is_same_v<T, Timestamp>) {
+      const auto micros = decoded.valueAt<Timestamp>(indices[row]).toMicros();
+      memcpy(rowBuffer + valueOffset, &micros, sizeof(int64_t));
+    } else {
+      const T value = decoded.valueAt<T>(indices[row]);
+      memcpy(rowBuffer + valueOffset, &value, sizeof(T));
+    }
+  }
+}
+} // namespace
+
+void UnsafeRowFast::rowSizes(
+    vector_size_t offset,
+    vector_size_t size,
+    int32_t* sizes) {
+  const int32_t fixedSize = rowNullBytes_ + children_.size() * kFieldWidth;
+  std::fill(sizes, sizes + size, fixedSize);
+
+  std::vector<vector_size_t> childIndices;
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    if (childIndices.empty()) {
+      childIndices.resize(size);
+      for (auto row = 0; row < size; ++row) {
+        childIndices[row] = decoded_.index(offset + row);
+      }
+    }
+
+    auto& child = children_[i];
+    if (child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY) {
+      for (auto row = 0; row < size; ++row) {
+        if (!child.isNullAt(childIndices[row])) {
+          sizes[row] += alignBytes(
+              child.decoded_.valueAt<StringView>(childIndices[row]).size());
+        }
+      }
+    } else {
+      for (auto row = 0; row < size; ++row) {
+        if (!child.isNullAt(childIndices[row])) {
+          sizes[row] +=
+              alignBytes(child.variableWidthRowSize(childIndices[row]));
+        }
+      }
+    }
+  }
+}
+
+void UnsafeRowFast::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    char* buffer,
+    const size_t* bufferOffsets) {
+  std::vector<vector_size_t> childIndices(size);
+  for (auto row = 0; row < size; ++row) {
+    childIndices[row] = decoded_.index(offset + row);
+  }
+
+  std::vector<int64_t> variableWidthOffsets(
+      size, rowNullBytes_ + kFieldWidth * children_.size());
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      serializeFixedWidthColumn(
+          i, size, childIndices.data(), buffer, bufferOffsets);
+    } else {
+      serializeVariableWidthColumn(
+          i,
+          size,
+          childIndices.data(),
+          buffer,
+          bufferOffsets,
+          variableWidthOffsets.data());
+    }
+  }
+}
+
+void UnsafeRowFast::serializeFixedWidthColumn(
+    column_index_t column,
+    vector_size_t size,
+    const vector_size_t* childIndices,
+    char* buffer,
+    const size_t* bufferOffsets) {
+  auto& child = children_[column];
+  if (child.typeKind_ != TypeKind::UNKNOWN) {
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        serializeFixedWidthValues,
+        child.typeKind_,
+        child.decoded_,
+        column,
+        size,
+        childIndices,
+        rowNullBytes_,
+        buffer,
+        bufferOffsets);
+    return;
+  }
+
+  // UNKNOWN values are always null.
+  for (auto row = 0; row < size; ++row) {
+    bits::setBit(buffer + bufferOffsets[row], column, true);
+  }
+}
+
+void UnsafeRowFast::serializeVariableWidthColumn(
+    column_index_t column,
+    vector_size_t size,
+    const vector_size_t* childIndices,
+    char* buffer,
+    const size_t* bufferOffsets,
+    int64_t* variableWidthOffsets) {
+  auto& child = children_[column];
+  const bool isString = child.typeKind_ == TypeKind::VARCHAR ||
+      child.typeKind_ == TypeKind::VARBINARY;
+  for (auto row = 0; row < size; ++row) {
+    char* rowBuffer = buffer + bufferOffsets[row];
+    if (child.isNullAt(childIndices[row])) {
+      bits::setBit(rowBuffer, column, true);
+      continue;
+    }
+
+    int32_t valueSize;
+    if (isString) {
+      const auto value = child.decoded_.valueAt<StringView>(childIndices[row]);
+      memcpy(rowBuffer + variableWidthOffsets[row], value.data(), value.size());
+      valueSize = value.size();
+    } else {
+      valueSize = child.serializeVariableWidth(
+          childIndices[row], rowBuffer + variableWidthOffsets[row]);
+    }
+
+    // Write size and offset.
+    const uint64_t sizeAndOffset = variableWidthOffsets[row] << 32 | valueSize;
+    reinterpret_cast<uint64_t*>(rowBuffer + rowNullBytes_)[column] =
+        sizeAndOffset;
+    variableWidthOffsets[row] += alignBytes(valueSize);
+  }
+}
+
+namespace {
+
+// Reads fixed-width field 'column' from the 8-byte slots of the serialized
+// rows in 'data'.
+template <TypeKind Kind>
+VectorPtr deserializeFixedWidthColumn(
+    const TypePtr& type,
+    const std::vector<std::string_view>& data,
+    column_index_t column,
+    size_t nullBytes,
+    memory::MemoryPool* pool) {
+  using T = typename TypeTraits<Kind>::NativeType;
+
+  const auto numRows = data.size();
+  auto flatVector = BaseVector::create<FlatVector<T>>(type, numRows, pool);
+  const size_t valueOffset = nullBytes + column * kFieldWidth;
+  for (auto row = 0; row < numRows; ++row) {
+    const char* rowData = data[row].data();
+    if (bits::isBitSet(rowData, column)) {
+      flatVector->setNull(row, true);
+    } else if constexpr (std::is_same_v<T, Timestamp>) {
+      int64_t micros;
+      memcpy(&micros, rowData + valueOffset, sizeof(int64_t));
+      flatVector->set(row, Timestamp::fromMicros(micros));
+    } else {
+      T value;
+      memcpy(&value, rowData + valueOffset, sizeof(T));
+      flatVector->set(row, value);
+    }
+  }
+  return flatVector;
+}
+
+// Returns the serialized variable-width field 'column' of each row in 'data'
+// or std::nullopt for null values.
+std::vector<std::optional<std::string_view>> variableWidthColumnData(
+    const std::vector<std::string_view>& data,
+    column_index_t column,
+    size_t nullBytes) {
+  std::vector<std::optional<std::string_view>> columnData(data.size());
+  for (auto row = 0; row < data.size(); ++row) {
+    const char* rowData = data[row].data();
+    if (bits::isBitSet(rowData, column)) {
+      continue;
+    }
+    uint64_t sizeAndOffset;
+    memcpy(
+        &sizeAndOffset,
+        rowData + nullBytes + column * kFieldWidth,
+        sizeof(uint64_t));
+    columnData[row] = std::string_view(
+        rowData + (sizeAndOffset >> 32), sizeAndOffset & 0xffffffff);
+  }
+  return columnData;
+}
+
+// Reads string field 'column' of the serialized rows in 'data'.
+VectorPtr deserializeStringColumn(
+    const TypePtr& type,
+    const std::vector<std::string_view>& data,
+    column_index_t column,
+    size_t nullBytes,
+    memory::MemoryPool* pool) {
+  const auto numRows = data.size();
+  auto flatVector =
+      BaseVector::create<FlatVector<StringView>>(type, numRows, pool);
+  const auto columnData = variableWidthColumnData(data, column, nullBytes);
+  for (auto row = 0; row < numRows; ++row) {
+    if (!columnData[row].has_value()) {
+      flatVector->setNull(row, true);
+    } else {
+      flatVector->set(
+          row, StringView(columnData[row]->data(), columnData[row]->size()));
+    }
+  }
+  return flatVector;
+}
+} // namespace
+
+// static
+RowVectorPtr UnsafeRowFast::deserialize(
+    const std::vector<std::string_view>& data,
+    const RowTypePtr& rowType,
+    memory::MemoryPool* pool) {
+  const auto numRows = data.size();
+  const auto numFields = rowType->size();
+  const size_t nullBytes = alignBits(numFields);
+
+  std::vector<VectorPtr> fields;
+  fields.reserve(numFields);
+  for (auto i = 0; i < numFields; ++i) {
+    const auto& type = rowType->childAt(i);
+    if (type->isVarchar() || type->isVarbinary()) {
+      fields.push_back(
+          deserializeStringColumn(type, data, i, nullBytes, pool));
+    } else if (isFixedWidth(type) && type->kind() != TypeKind::UNKNOWN) {
+      fields.push_back(VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          deserializeFixedWidthColumn,
+          type->kind(),
+          type,
+          data,
+          i,
+          nullBytes,
+          pool));
+    } else {
+      // Complex types, long decimals and UNKNOWN go through the generic
+      // deserializer.
+      std::vector<std::optional<std::string_view>> columnData;
+      if (isFixedWidth(type)) {
+        columnData.resize(numRows);
+      } else {
+        columnData = variableWidthColumnData(data, i, nullBytes);
+      }
+      fields.push_back(
+          UnsafeRowDeserializer::deserialize(columnData, type, pool));
+    }
+  }
+
+  return std::make_shared<RowVector>(
+      pool, rowType, nullptr, numRows, std::move(fields));
+}
 } // namespace facebook::velox::row
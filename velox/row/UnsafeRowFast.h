@@ -36,6 +36,29 @@ class UnsafeRowFast {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Writes serialized sizes of 'size' rows starting at 'offset' into
+  /// 'sizes'. Equivalent to calling 'rowSize' for each row, but processes one
+  /// column at a time.
+  void rowSizes(vector_size_t offset, vector_size_t size, int32_t* sizes);
+
+  /// Serializes 'size' rows starting at 'offset' one column at a time. Row
+  /// 'offset + i' is written to 'buffer + bufferOffsets[i]'. Produces the same
+  /// bytes as calling 'serialize' for each row. 'buffer' must have sufficient
+  /// capacity for the sizes returned by 'rowSizes' and set to all zeros.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      char* buffer,
+      const size_t* bufferOffsets);
+
+  /// Deserializes multiple rows into a RowVector of specified type. The type
+  /// must match the contents of the serialized rows. Top-level fixed-width and
+  /// string fields are read one column at a time.
+  static RowVectorPtr deserialize(
+      const std::vector<std::string_view>& data,
+      const RowTypePtr& rowType,
+      memory::MemoryPool* pool);
+
  protected:
   explicit UnsafeRowFast(const VectorPtr& vector);
 
@@ -101,6 +124,27 @@ class UnsafeRowFast {
   /// Serializes struct value to buffer. Value must not be null.
   int32_t serializeRow(vector_size_t index, char* buffer);
 
+  /// ROW type only. Writes values of fixed-width field 'column' for 'size'
+  /// rows into the serialized rows at 'buffer + bufferOffsets[i]'.
+  /// 'childIndices' are the row numbers in the field.
+  void serializeFixedWidthColumn(
+      column_index_t column,
+      vector_size_t size,
+      const vector_size_t* childIndices,
+      char* buffer,
+      const size_t* bufferOffsets);
+
+  /// ROW type only. Same as 'serializeFixedWidthColumn' for variable-width
+  /// field 'column'. Values are written at 'variableWidthOffsets' within each
+  /// row, which are advanced past the written values.
+  void serializeVariableWidthColumn(
+      column_index_t column,
+      vector_size_t size,
+      const vector_size_t* childIndices,
+      char* buffer,
+      const size_t* bufferOffsets,
+      int64_t* variableWidthOffsets);
+
   const TypeKind typeKind_;
   DecodedVector decoded_;
 
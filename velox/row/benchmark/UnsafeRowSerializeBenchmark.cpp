@@ -40,6 +40,17 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(serialized.size(), data->size());
   }
 
+  void serializeUnsafeBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    UnsafeRowFast fast(data);
+    BufferPtr buffer;
+    auto serialized = serializeBatch(fast, data->size(), buffer);
+    VELOX_CHECK_EQ(serialized.size(), data->size());
+  }
+
   void deserializeUnsafe(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -53,6 +64,18 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(copy->size(), data->size());
   }
 
+  void deserializeUnsafeBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    UnsafeRowFast fast(data);
+    BufferPtr buffer;
+    auto serialized = serializeBatch(fast, data->size(), buffer);
+    suspender.dismiss();
+
+    auto copy = UnsafeRowFast::deserialize(serialized, rowType, pool());
+    VELOX_CHECK_EQ(copy->size(), data->size());
+  }
+
   void serializeCompact(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -65,6 +88,17 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(serialized.size(), data->size());
   }
 
+  void serializeCompactBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    CompactRow compact(data);
+    BufferPtr buffer;
+    auto serialized = serializeBatch(compact, data->size(), buffer);
+    VELOX_CHECK_EQ(serialized.size(), data->size());
+  }
+
   void deserializeCompact(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -184,6 +218,34 @@ class SerializeBenchmark {
     return serialized;
   }
 
+  // Serializes all rows using the batch API of UnsafeRowFast or CompactRow.
+  // Allocates 'buffer' to hold the serialized rows.
+  template <typename TRow>
+  std::vector<std::string_view>
+  serializeBatch(TRow& row, vector_size_t numRows, BufferPtr& buffer) {
+    std::vector<int32_t> rowSizes(numRows);
+    row.rowSizes(0, numRows, rowSizes.data());
+
+    std::vector<size_t> rowOffsets(numRows);
+    size_t totalSize = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      rowOffsets[i] = totalSize;
+      totalSize += rowSizes[i];
+    }
+
+    buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    auto rawBuffer = buffer->asMutable<char>();
+    row.serialize(0, numRows, rawBuffer, rowOffsets.data());
+
+    std::vector<std::string_view> serialized;
+    serialized.reserve(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      serialized.push_back(
+          std::string_view(rawBuffer + rowOffsets[i], rowSizes[i]));
+    }
+    return serialized;
+  }
+
   HashStringAllocator::Position serialize(
       const RowVectorPtr& data,
       HashStringAllocator& allocator) {
@@ -205,35 +267,50 @@ class SerializeBenchmark {
       memory::memoryManager()->addLeafPool()};
 };
 
-#define SERDE_BENCHMARKS(name, rowType)      \
-  BENCHMARK(unsafe_serialize_##name) {       \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeUnsafe(rowType);      \
-  }                                          \
-                                             \
-  BENCHMARK(compact_serialize_##name) {      \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeCompact(rowType);     \
-  }                                          \
-                                             \
-  BENCHMARK(container_serialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeContainer(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(unsafe_deserialize_##name) {     \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeUnsafe(rowType);    \
-  }                                          \
-                                             \
-  BENCHMARK(compact_deserialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeCompact(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(container_deserialize_##name) {  \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeContainer(rowType); \
+#define SERDE_BENCHMARKS(name, rowType)                 \
+  BENCHMARK(unsafe_serialize_##name) {                  \
+    SerializeBenchmark benchmark;                       \
+    benchmark.serializeUnsafe(rowType);                 \
+  }                                                     \
+                                                        \
+  BENCHMARK_RELATIVE(unsafe_serialize_batch_##name) {   \
+    SerializeBenchmark benchmark;                       \
+    benchmark.serializeUnsafeBatch(rowType);            \
+  }                                                     \
+                                                        \
+  BENCHMARK(compact_serialize_##name) {                 \
+    SerializeBenchmark benchmark;                       \
+    benchmark.serializeCompact(rowType);                \
+  }                                                     \
+                                                        \
+  BENCHMARK_RELATIVE(compact_serialize_batch_##name) {  \
+    SerializeBenchmark benchmark;                       \
+    benchmark.serializeCompactBatch(rowType);           \
+  }                                                     \
+                                                        \
+  BENCHMARK(container_serialize_##name) {               \
+    SerializeBenchmark benchmark;                       \
+    benchmark.serializeContainer(rowType);              \
+  }                                                     \
+                                                        \
+  BENCHMARK(unsafe_deserialize_##name) {                \
+    SerializeBenchmark benchmark;                       \
+    benchmark.deserializeUnsafe(rowType);               \
+  }                                                     \
+                                                        \
+  BENCHMARK_RELATIVE(unsafe_deserialize_batch_##name) { \
+    SerializeBenchmark benchmark;                       \
+    benchmark.deserializeUnsafeBatch(rowType);          \
+  }                                                     \
+                                                        \
+  BENCHMARK(compact_deserialize_##name) {               \
+    SerializeBenchmark benchmark;                       \
+    benchmark.deserializeCompact(rowType);              \
+  }                                                     \
+                                                        \
+  BENCHMARK(container_deserialize_##name) {             \
+    SerializeBenchmark benchmark;                       \
+    benchmark.deserializeContainer(rowType);            \
   }
 
 SERDE_BENCHMARKS(
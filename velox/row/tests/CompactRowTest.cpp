@@ -76,6 +76,26 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
 
     VELOX_CHECK_EQ(offset, totalSize);
 
+    // Batch serialization must produce the same bytes as serializing one row
+    // at a time.
+    std::vector<int32_t> rowSizes(numRows);
+    row.rowSizes(0, numRows, rowSizes.data());
+    std::vector<size_t> rowOffsets(numRows);
+    offset = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      VELOX_CHECK_EQ(rowSizes[i], serialized[i].size(), "Row {}", i);
+      rowOffsets[i] = offset;
+      offset += rowSizes[i];
+    }
+
+    BufferPtr batchBuffer =
+        AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    row.serialize(
+        0, numRows, batchBuffer->asMutable<char>(), rowOffsets.data());
+    ASSERT_EQ(
+        std::string_view(rawBuffer, totalSize),
+        std::string_view(batchBuffer->as<char>(), totalSize));
+
     auto copy = CompactRow::deserialize(serialized, rowType, pool());
     assertEqualVectors(data, copy);
   }
@@ -314,6 +334,50 @@ TEST_F(CompactRowTest, string) {
   testRoundTrip(data);
 }
 
+TEST_F(CompactRowTest, stringBuffer) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {"a", std::nullopt, "Longer test string", "Another long string"}),
+      makeArrayVector<std::string>({
+          {"b", "Abc 12345 ...test"},
+          {},
+          {"Yet another long string"},
+          {"c"},
+      }),
+  });
+
+  CompactRow row(data);
+  std::vector<int32_t> rowSizes(data->size());
+  row.rowSizes(0, data->size(), rowSizes.data());
+  std::vector<size_t> rowOffsets(data->size());
+  size_t totalSize = 0;
+  for (auto i = 0; i < data->size(); ++i) {
+    rowOffsets[i] = totalSize;
+    totalSize += rowSizes[i];
+  }
+  std::string buffer(totalSize, '\0');
+  row.serialize(0, data->size(), buffer.data(), rowOffsets.data());
+  std::vector<std::string_view> serialized;
+  for (auto i = 0; i < data->size(); ++i) {
+    serialized.emplace_back(buffer.data() + rowOffsets[i], rowSizes[i]);
+  }
+
+  auto copy =
+      CompactRow::deserialize(serialized, asRowType(data->type()), pool());
+
+  // The strings that are not inlined are copied to one buffer per vector, so
+  // the result does not reference the serialized rows.
+  std::fill(buffer.begin(), buffer.end(), 'x');
+  assertEqualVectors(data, copy);
+  auto* strings = copy->childAt(0)->asFlatVector<StringView>();
+  ASSERT_EQ(strings->stringBuffers().size(), 1);
+  auto* elements = copy->childAt(1)
+                       ->as<ArrayVector>()
+                       ->elements()
+                       ->asFlatVector<StringView>();
+  ASSERT_EQ(elements->stringBuffers().size(), 1);
+}
+
 TEST_F(CompactRowTest, unknown) {
   auto data = makeRowVector({
       makeAllNullFlatVector<UnknownValue>(10),
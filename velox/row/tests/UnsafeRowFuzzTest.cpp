@@ -88,6 +88,72 @@ class UnsafeRowFuzzTests : public ::testing::Test {
     }
   }
 
+  static RowTypePtr fuzzRowType() {
+    return ROW({
+        BOOLEAN(),
+        TINYINT(),
+        SMALLINT(),
+        INTEGER(),
+        VARCHAR(),
+        BIGINT(),
+        REAL(),
+        DOUBLE(),
+        VARCHAR(),
+        VARBINARY(),
+        UNKNOWN(),
+        DECIMAL(20, 2),
+        DECIMAL(12, 4),
+        // Arrays.
+        ARRAY(BOOLEAN()),
+        ARRAY(TINYINT()),
+        ARRAY(SMALLINT()),
+        ARRAY(INTEGER()),
+        ARRAY(BIGINT()),
+        ARRAY(REAL()),
+        ARRAY(DOUBLE()),
+        ARRAY(VARCHAR()),
+        ARRAY(VARBINARY()),
+        ARRAY(UNKNOWN()),
+        ARRAY(DECIMAL(20, 2)),
+        ARRAY(DECIMAL(12, 4)),
+        // Nested arrays.
+        ARRAY(ARRAY(INTEGER())),
+        ARRAY(ARRAY(BIGINT())),
+        ARRAY(ARRAY(VARCHAR())),
+        ARRAY(ARRAY(UNKNOWN())),
+        // Maps.
+        MAP(BIGINT(), REAL()),
+        MAP(BIGINT(), BIGINT()),
+        MAP(BIGINT(), VARCHAR()),
+        MAP(BIGINT(), DECIMAL(20, 2)),
+        MAP(BIGINT(), DECIMAL(12, 4)),
+        MAP(INTEGER(), MAP(BIGINT(), DOUBLE())),
+        MAP(VARCHAR(), BOOLEAN()),
+        MAP(INTEGER(), MAP(BIGINT(), ARRAY(REAL()))),
+        // Timestamp and date types.
+        TIMESTAMP(),
+        DATE(),
+        ARRAY(TIMESTAMP()),
+        ARRAY(DATE()),
+        MAP(DATE(), ARRAY(TIMESTAMP())),
+        // Structs.
+        ROW(
+            {BOOLEAN(),
+             INTEGER(),
+             TIMESTAMP(),
+             DECIMAL(20, 2),
+             VARCHAR(),
+             ARRAY(BIGINT())}),
+        ROW(
+            {BOOLEAN(),
+             ROW({INTEGER(), TIMESTAMP()}),
+             VARCHAR(),
+             ARRAY(BIGINT())}),
+        ARRAY({ROW({BIGINT(), VARCHAR()})}),
+        MAP(BIGINT(), ROW({BOOLEAN(), TINYINT(), REAL()})),
+    });
+  }
+
   static constexpr uint64_t kBufferSize = 70 << 10; // 70kb
   static constexpr uint64_t kNumBuffers = 100;
 
@@ -98,69 +164,7 @@ class UnsafeRowFuzzTests : public ::testing::Test {
 };
 
 TEST_F(UnsafeRowFuzzTests, fast) {
-  auto rowType = ROW({
-      BOOLEAN(),
-      TINYINT(),
-      SMALLINT(),
-      INTEGER(),
-      VARCHAR(),
-      BIGINT(),
-      REAL(),
-      DOUBLE(),
-      VARCHAR(),
-      VARBINARY(),
-      UNKNOWN(),
-      DECIMAL(20, 2),
-      DECIMAL(12, 4),
-      // Arrays.
-      ARRAY(BOOLEAN()),
-      ARRAY(TINYINT()),
-      ARRAY(SMALLINT()),
-      ARRAY(INTEGER()),
-      ARRAY(BIGINT()),
-      ARRAY(REAL()),
-      ARRAY(DOUBLE()),
-      ARRAY(VARCHAR()),
-      ARRAY(VARBINARY()),
-      ARRAY(UNKNOWN()),
-      ARRAY(DECIMAL(20, 2)),
-      ARRAY(DECIMAL(12, 4)),
-      // Nested arrays.
-      ARRAY(ARRAY(INTEGER())),
-      ARRAY(ARRAY(BIGINT())),
-      ARRAY(ARRAY(VARCHAR())),
-      ARRAY(ARRAY(UNKNOWN())),
-      // Maps.
-      MAP(BIGINT(), REAL()),
-      MAP(BIGINT(), BIGINT()),
-      MAP(BIGINT(), VARCHAR()),
-      MAP(BIGINT(), DECIMAL(20, 2)),
-      MAP(BIGINT(), DECIMAL(12, 4)),
-      MAP(INTEGER(), MAP(BIGINT(), DOUBLE())),
-      MAP(VARCHAR(), BOOLEAN()),
-      MAP(INTEGER(), MAP(BIGINT(), ARRAY(REAL()))),
-      // Timestamp and date types.
-      TIMESTAMP(),
-      DATE(),
-      ARRAY(TIMESTAMP()),
-      ARRAY(DATE()),
-      MAP(DATE(), ARRAY(TIMESTAMP())),
-      // Structs.
-      ROW(
-          {BOOLEAN(),
-           INTEGER(),
-           TIMESTAMP(),
-           DECIMAL(20, 2),
-           VARCHAR(),
-           ARRAY(BIGINT())}),
-      ROW(
-          {BOOLEAN(),
-           ROW({INTEGER(), TIMESTAMP()}),
-           VARCHAR(),
-           ARRAY(BIGINT())}),
-      ARRAY({ROW({BIGINT(), VARCHAR()})}),
-      MAP(BIGINT(), ROW({BOOLEAN(), TINYINT(), REAL()})),
-  });
+  auto rowType = fuzzRowType();
 
   doTest(rowType, [&](const RowVectorPtr& data) {
     std::vector<std::optional<std::string_view>> serialized;
@@ -179,5 +183,43 @@ TEST_F(UnsafeRowFuzzTests, fast) {
   });
 }
 
+TEST_F(UnsafeRowFuzzTests, batch) {
+  auto rowType = fuzzRowType();
+
+  doTest(rowType, [&](const RowVectorPtr& data) {
+    const auto numRows = data->size();
+    UnsafeRowFast fast(data);
+
+    std::vector<int32_t> rowSizes(numRows);
+    fast.rowSizes(0, numRows, rowSizes.data());
+
+    // Serialize row 'i' into buffers_[i].
+    std::vector<size_t> bufferOffsets(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      VELOX_CHECK_LE(rowSizes[i], kBufferSize);
+      bufferOffsets[i] = i * kBufferSize;
+    }
+    fast.serialize(0, numRows, buffers_[0], bufferOffsets.data());
+
+    std::vector<std::string_view> rows;
+    std::vector<std::optional<std::string_view>> serialized;
+    for (auto i = 0; i < numRows; ++i) {
+      EXPECT_EQ(rowSizes[i], fast.rowSize(i)) << i << ", " << data->toString(i);
+
+      // Batch serialization must produce the same bytes as serializing one
+      // row at a time.
+      std::string expected(rowSizes[i], '\0');
+      EXPECT_EQ(rowSizes[i], fast.serialize(i, expected.data()));
+      rows.push_back(std::string_view(buffers_[i], rowSizes[i]));
+      EXPECT_EQ(expected, rows.back()) << i << ", " << data->toString(i);
+      serialized.push_back(rows.back());
+    }
+
+    assertEqualVectors(
+        data, UnsafeRowFast::deserialize(rows, rowType, pool_.get()));
+    return serialized;
+  });
+}
+
 } // namespace
 } // namespace facebook::velox::row
@@ -15,6 +15,7 @@
  */
 #include "velox/serializers/CompactRowSerializer.h"
 #include <folly/lang/Bits.h>
+#include <deque>
 #include "velox/row/CompactRow.h"
 
 namespace facebook::velox::serializer {
@@ -39,20 +40,19 @@ class CompactRowVectorSerializer : public IterativeVectorSerializer {
       const RowVectorPtr& vector,
       const folly::Range<const IndexRange*>& ranges,
       Scratch& scratch) override {
-    size_t totalSize = 0;
     row::CompactRow row(vector);
-    if (auto fixedRowSize =
-            row::CompactRow::fixedRowSize(asRowType(vector->type()))) {
-      for (const auto& range : ranges) {
-        totalSize += (fixedRowSize.value() + sizeof(TRowSize)) * range.size;
-      }
-
-    } else {
-      for (const auto& range : ranges) {
-        for (auto i = range.begin; i < range.begin + range.size; ++i) {
-          totalSize += row.rowSize(i) + sizeof(TRowSize);
-        }
-      }
+
+    // Serialized sizes of the rows in all ranges, back to back.
+    std::vector<int32_t> rowSizes;
+    for (const auto& range : ranges) {
+      const auto numRows = rowSizes.size();
+      rowSizes.resize(numRows + range.size);
+      row.rowSizes(range.begin, range.size, rowSizes.data() + numRows);
+    }
+
+    size_t totalSize = 0;
+    for (auto size : rowSizes) {
+      totalSize += size + sizeof(TRowSize);
     }
 
     if (totalSize == 0) {
@@ -63,16 +63,22 @@ class CompactRowVectorSerializer : public IterativeVectorSerializer {
     auto rawBuffer = buffer->asMutable<char>();
     buffers_.push_back(std::move(buffer));
 
+    // Write raw sizes. Needs to be in big endian order. Then write row data
+    // one range at a time.
+    std::vector<size_t> rowOffsets(rowSizes.size());
     size_t offset = 0;
-    for (auto& range : ranges) {
-      for (auto i = range.begin; i < range.begin + range.size; ++i) {
-        // Write row data.
-        TRowSize size = row.serialize(i, rawBuffer + offset + sizeof(TRowSize));
-
-        // Write raw size. Needs to be in big endian order.
-        *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(size);
-        offset += sizeof(TRowSize) + size;
-      }
+    for (auto i = 0; i < rowSizes.size(); ++i) {
+      *(TRowSize*)(rawBuffer + offset) =
+          folly::Endian::big(static_cast<TRowSize>(rowSizes[i]));
+      rowOffsets[i] = offset + sizeof(TRowSize);
+      offset = rowOffsets[i] + rowSizes[i];
+    }
+
+    size_t rowIndex = 0;
+    for (const auto& range : ranges) {
+      row.serialize(
+          range.begin, range.size, rawBuffer, rowOffsets.data() + rowIndex);
+      rowIndex += range.size;
     }
   }
 
@@ -136,7 +142,9 @@ void CompactRowVectorSerde::deserialize(
     RowVectorPtr* result,
     const Options* /* options */) {
   std::vector<std::string_view> serializedRows;
-  std::vector<std::string> concatenatedRows;
+  // 'serializedRows' may point into these, so they must not move when more are
+  // added. A std::vector would move short strings held inline on growth.
+  std::deque<std::string> concatenatedRows;
 
   while (!source->atEnd()) {
     // First read row size in big endian order.
@@ -22,10 +22,12 @@
 #include "velox/common/base/Crc.h"
 #include "velox/common/base/RawVector.h"
 #include "velox/common/memory/ByteStream.h"
+#include "velox/common/process/ProcessBase.h"
 #include "velox/vector/BiasVector.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/DictionaryVector.h"
 #include "velox/vector/FlatVector.h"
+#include "velox/vector/LazyVector.h"
 #include "velox/vector/VectorTypeUtils.h"
 
 namespace facebook::velox::serializer::presto {
@@ -187,6 +189,14 @@ FOLLY_ALWAYS_INLINE bool needCompression(const folly::io::Codec& codec) {
   return codec.type() != folly::io::CodecType::NO_COMPRESSION;
 }
 
+std::unique_ptr<folly::io::Codec> makeCodec(const SerdeOpts& opts) {
+  if (opts.zstdDictionary != nullptr &&
+      opts.compressionKind == common::CompressionKind_ZSTD) {
+    return opts.zstdDictionary->makeCodec();
+  }
+  return common::compressionKindToCodec(opts.compressionKind);
+}
+
 using StructNullsMap =
     folly::F14FastMap<int64_t, std::pair<raw_vector<uint64_t>, int32_t>>;
 
@@ -1590,6 +1600,11 @@ class VectorStream {
     return isDictionaryStream_;
   }
 
+  // Returns the number of rows appended to the stream.
+  int32_t size() const {
+    return nullCount_ + nonNullCount_;
+  }
+
   bool isConstantStream() const {
     return isConstantStream_;
   }
@@ -1942,6 +1957,15 @@ void serializeColumn(
     VectorStream* stream,
     Scratch& scratch);
 
+// Appends 'rows' of 'vector' to a dictionary stream. A dictionary or constant
+// vector adds the base rows it references to the dictionary values. Other
+// vectors add all 'rows' to the values.
+void serializeToDictionaryStream(
+    const VectorPtr& vector,
+    const folly::Range<const vector_size_t*>& rows,
+    VectorStream* stream,
+    Scratch& scratch);
+
 void serializeWrapped(
     const VectorPtr& vector,
     const folly::Range<const IndexRange*>& ranges,
@@ -2869,6 +2893,10 @@ void serializeColumn(
     const folly::Range<const vector_size_t*>& rows,
     VectorStream* stream,
     Scratch& scratch) {
+  if (stream->isDictionaryStream()) {
+    serializeToDictionaryStream(vector, rows, stream, scratch);
+    return;
+  }
   switch (vector->encoding()) {
     case VectorEncoding::Simple::FLAT:
       VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH_ALL(
@@ -2908,6 +2936,69 @@ void serializeColumn(
   }
 }
 
+void serializeToDictionaryStream(
+    const VectorPtr& vector,
+    const folly::Range<const vector_size_t*>& rows,
+    VectorStream* stream,
+    Scratch& scratch) {
+  auto* values = stream->childAt(0);
+  const int32_t firstIndex = values->size();
+  const auto numRows = rows.size();
+  stream->appendNonNull(numRows);
+
+  if (vector->encoding() == VectorEncoding::Simple::CONSTANT) {
+    const vector_size_t firstRow = 0;
+    serializeColumn(
+        vector,
+        folly::Range<const vector_size_t*>(&firstRow, 1),
+        values,
+        scratch);
+    for (auto i = 0; i < numRows; ++i) {
+      stream->appendOne(firstIndex);
+    }
+    return;
+  }
+
+  if (vector->encoding() != VectorEncoding::Simple::DICTIONARY ||
+      vector->mayHaveNulls()) {
+    // The rows become new dictionary values.
+    serializeColumn(vector, rows, values, scratch);
+    for (auto i = 0; i < numRows; ++i) {
+      stream->appendOne<int32_t>(firstIndex + i);
+    }
+    return;
+  }
+
+  // Adds the distinct base rows referenced by 'rows' to the dictionary
+  // values.
+  const auto& base = vector->valueVector();
+  const auto* indices = vector->wrapInfo()->as<vector_size_t>();
+  ScratchPtr<uint64_t, 64> usedHolder(scratch);
+  auto* used = usedHolder.get(bits::nwords(base->size()));
+  simd::memset(used, 0, usedHolder.size() * sizeof(uint64_t));
+  for (auto row : rows) {
+    bits::setBit(used, indices[row]);
+  }
+  ScratchPtr<vector_size_t, 64> usedRowsHolder(scratch);
+  auto* usedRows = usedRowsHolder.get(base->size());
+  const auto numUsed =
+      simd::indicesOfSetBits(used, 0, base->size(), usedRows);
+  serializeColumn(
+      base,
+      folly::Range<const vector_size_t*>(usedRows, numUsed),
+      values,
+      scratch);
+
+  ScratchPtr<int32_t, 64> newIndicesHolder(scratch);
+  auto* newIndices = newIndicesHolder.get(base->size());
+  for (auto i = 0; i < numUsed; ++i) {
+    newIndices[usedRows[i]] = firstIndex + i;
+  }
+  for (auto row : rows) {
+    stream->appendOne(newIndices[indices[row]]);
+  }
+}
+
 void expandRepeatedRanges(
     const BaseVector* vector,
     const vector_size_t* rawOffsets,
@@ -3535,6 +3626,8 @@ namespace {
 struct FlushSizes {
   int64_t uncompressedSize;
   int64_t compressedSize;
+  // Thread CPU time spent in the codec.
+  uint64_t compressionCpuNanos{0};
 };
 } // namespace
 
@@ -3607,7 +3700,10 @@ FlushSizes flushCompressed(
       codec.maxUncompressedLength(),
       "UncompressedSize exceeds limit");
   auto iobuf = out.getIOBuf();
+  const auto cpuNanosStart = process::threadCpuNanos();
   const auto compressedBuffer = codec.compress(iobuf.get());
+  const uint64_t compressionCpuNanos =
+      process::threadCpuNanos() - cpuNanosStart;
   const int32_t compressedSize = compressedBuffer->length();
   if (compressedSize > uncompressedSize * minCompressionRatio) {
     flushSerialization(
@@ -3618,7 +3714,7 @@ FlushSizes flushCompressed(
         iobuf,
         output,
         listener);
-    return {uncompressedSize, uncompressedSize};
+    return {uncompressedSize, uncompressedSize, compressionCpuNanos};
   }
   flushSerialization(
       numRows,
@@ -3628,7 +3724,7 @@ FlushSizes flushCompressed(
       compressedBuffer,
       output,
       listener);
-  return {uncompressedSize, compressedSize};
+  return {uncompressedSize, compressedSize, compressionCpuNanos};
 }
 
 FlushSizes flushStreams(
@@ -3741,9 +3837,7 @@ void estimateDictionarySerializedSize(
 class PrestoBatchVectorSerializer : public BatchVectorSerializer {
  public:
   PrestoBatchVectorSerializer(memory::MemoryPool* pool, const SerdeOpts& opts)
-      : pool_(pool),
-        codec_(common::compressionKindToCodec(opts.compressionKind)),
-        opts_(opts) {}
+      : pool_(pool), codec_(makeCodec(opts)), opts_(opts) {}
 
   void serialize(
       const RowVectorPtr& vector,
@@ -3926,15 +4020,10 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       const SerdeOpts& opts)
       : opts_(opts),
         streamArena_(streamArena),
-        codec_(common::compressionKindToCodec(opts.compressionKind)) {
-    const auto types = rowType->children();
-    const auto numTypes = types.size();
-    streams_.resize(numTypes);
-
-    for (int i = 0; i < numTypes; ++i) {
-      streams_[i] = std::make_unique<VectorStream>(
-          types[i], std::nullopt, std::nullopt, streamArena, numRows, opts);
-    }
+        codec_(makeCodec(opts)),
+        types_(rowType->children()),
+        initialNumRows_(numRows) {
+    createStreams();
   }
 
   void append(
@@ -3945,6 +4034,19 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     if (numNewRows == 0) {
       return;
     }
+    if (opts_.preserveEncodings) {
+      // Dictionary streams are appended to by row numbers.
+      ScratchPtr<vector_size_t, 64> rowsHolder(scratch);
+      auto* rows = rowsHolder.get(numNewRows);
+      vector_size_t numRows = 0;
+      for (const auto& range : ranges) {
+        std::iota(rows + numRows, rows + numRows + range.size, range.begin);
+        numRows += range.size;
+      }
+      append(
+          vector, folly::Range<const vector_size_t*>(rows, numRows), scratch);
+      return;
+    }
     numRows_ += numNewRows;
     for (int32_t i = 0; i < vector->childrenSize(); ++i) {
       serializeColumn(vector->childAt(i), ranges, streams_[i].get(), scratch);
@@ -3959,6 +4061,9 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     if (numNewRows == 0) {
       return;
     }
+    if (numRows_ == 0 && opts_.preserveEncodings) {
+      createEncodedStreams(vector, numNewRows);
+    }
     numRows_ += numNewRows;
     for (int32_t i = 0; i < vector->childrenSize(); ++i) {
       serializeColumn(vector->childAt(i), rows, streams_[i].get(), scratch);
@@ -3994,24 +4099,31 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       if (numCompressionToSkip_ > 0) {
         const auto noCompressionCodec = common::compressionKindToCodec(
             common::CompressionKind::CompressionKind_NONE);
-        auto [size, ignore] = flushStreams(
+        const auto sizes = flushStreams(
             streams_, numRows_, *streamArena_, *noCompressionCodec, 1, out);
-        stats_.compressionSkippedBytes += size;
+        stats_.compressionSkippedBytes += sizes.uncompressedSize;
         --numCompressionToSkip_;
         ++stats_.numCompressionSkipped;
       } else {
-        auto [size, compressedSize] = flushStreams(
+        const auto sizes = flushStreams(
             streams_,
             numRows_,
             *streamArena_,
             *codec_,
             opts_.minCompressionRatio,
             out);
-        stats_.compressionInputBytes += size;
-        stats_.compressedBytes += compressedSize;
-        if (compressedSize > size * opts_.minCompressionRatio) {
-          numCompressionToSkip_ = std::min<int64_t>(
-              kMaxCompressionAttemptsToSkip, 1 + stats_.numCompressionSkipped);
+        stats_.compressionInputBytes += sizes.uncompressedSize;
+        stats_.compressedBytes += sizes.compressedSize;
+        stats_.compressionCpuNanos += sizes.compressionCpuNanos;
+        if (isCompressionMiss(sizes)) {
+          // Retries after a number of pages that grows with the consecutive
+          // misses, so that incompressible data is compressed rarely but a
+          // change in the data is still noticed.
+          ++numCompressionMisses_;
+          numCompressionToSkip_ = std::min<int32_t>(
+              kMaxCompressionAttemptsToSkip, numCompressionMisses_);
+        } else {
+          numCompressionMisses_ = 0;
         }
       }
     }
@@ -4027,18 +4139,86 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
               stats_.compressionInputBytes, RuntimeCounter::Unit::kBytes)},
          {"compressionSkippedBytes",
           RuntimeCounter(
-              stats_.compressionSkippedBytes, RuntimeCounter::Unit::kBytes)}});
+              stats_.compressionSkippedBytes, RuntimeCounter::Unit::kBytes)},
+         {"compressionSavedBytes",
+          RuntimeCounter(
+              stats_.compressionInputBytes - stats_.compressedBytes,
+              RuntimeCounter::Unit::kBytes)},
+         {"compressionCpuNanos",
+          RuntimeCounter(
+              stats_.compressionCpuNanos, RuntimeCounter::Unit::kNanos)}});
     return map;
   }
 
   void clear() override {
     numRows_ = 0;
+    if (hasEncodedStreams_) {
+      // The next batch may have different encodings.
+      createStreams();
+      return;
+    }
     for (auto& stream : streams_) {
       stream->clear();
     }
   }
 
  private:
+  // Returns true if compressing the page did not pay off, either because the
+  // ratio is below 'minCompressionRatio' or because the CPU time per saved
+  // byte is above 'maxCompressionNanosPerSavedByte'.
+  bool isCompressionMiss(const FlushSizes& sizes) const {
+    if (sizes.compressedSize >
+        sizes.uncompressedSize * opts_.minCompressionRatio) {
+      return true;
+    }
+    if (opts_.maxCompressionNanosPerSavedByte <= 0) {
+      return false;
+    }
+    const auto savedBytes = sizes.uncompressedSize - sizes.compressedSize;
+    return savedBytes <= 0 ||
+        sizes.compressionCpuNanos >
+        savedBytes * opts_.maxCompressionNanosPerSavedByte;
+  }
+
+  void createStreams() {
+    streams_.resize(types_.size());
+    for (int i = 0; i < types_.size(); ++i) {
+      streams_[i] = std::make_unique<VectorStream>(
+          types_[i],
+          std::nullopt,
+          std::nullopt,
+          streamArena_,
+          initialNumRows_,
+          opts_);
+    }
+    hasEncodedStreams_ = false;
+  }
+
+  // Replaces the streams of the dictionary and constant encoded columns of
+  // 'vector' with dictionary streams. Called on the first append after
+  // construction or clear().
+  void createEncodedStreams(const RowVectorPtr& vector, int32_t numRows) {
+    for (int i = 0; i < types_.size(); ++i) {
+      const auto& column = vector->childAt(i);
+      if (column->encoding() != VectorEncoding::Simple::DICTIONARY &&
+          column->encoding() != VectorEncoding::Simple::CONSTANT) {
+        continue;
+      }
+      auto stream = std::make_unique<VectorStream>(
+          types_[i],
+          VectorEncoding::Simple::DICTIONARY,
+          column,
+          streamArena_,
+          std::max(numRows, initialNumRows_),
+          opts_);
+      // Small fixed width types are not dictionary encoded.
+      if (stream->isDictionaryStream()) {
+        streams_[i] = std::move(stream);
+        hasEncodedStreams_ = true;
+      }
+    }
+  }
+
   struct CompressionStats {
     // Number of times compression was not attempted.
     int32_t numCompressionSkipped{0};
@@ -4052,17 +4232,29 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     // Bytes for which compression was not attempted because of past
     // non-performance.
     int64_t compressionSkippedBytes{0};
+
+    // Thread CPU time spent compressing.
+    uint64_t compressionCpuNanos{0};
   };
 
   const SerdeOpts opts_;
   StreamArena* const streamArena_;
   const std::unique_ptr<folly::io::Codec> codec_;
+  const std::vector<TypePtr> types_;
+  const int32_t initialNumRows_;
+
+  // True if 'streams_' has dictionary streams created by
+  // createEncodedStreams().
+  bool hasEncodedStreams_{false};
 
   int32_t numRows_{0};
   std::vector<std::unique_ptr<VectorStream>> streams_;
 
   // Count of forthcoming compressions to skip.
   int32_t numCompressionToSkip_{0};
+
+  // Number of consecutive compressed pages that missed the target.
+  int32_t numCompressionMisses_{0};
   CompressionStats stats_;
 };
 } // namespace
@@ -4168,6 +4360,18 @@ void readTopColumns(
   readColumns(
       &source, childTypes, resultOffset, nullptr, 0, pool, opts, children);
 }
+
+// Deserializes the page that follows 'header' in 'source' into lazy vectors.
+// Defined after PrestoVectorLexer, which is used to locate the columns.
+void deserializeLazyColumns(
+    ByteInputStream* source,
+    const PrestoHeader& header,
+    folly::io::Codec* codec,
+    velox::memory::MemoryPool* pool,
+    const RowTypePtr& type,
+    RowVectorPtr* result,
+    vector_size_t resultOffset,
+    const SerdeOpts& opts);
 } // namespace
 
 void PrestoVectorSerde::deserialize(
@@ -4178,8 +4382,7 @@ void PrestoVectorSerde::deserialize(
     vector_size_t resultOffset,
     const Options* options) {
   const auto prestoOptions = toPrestoOptions(options);
-  const auto codec =
-      common::compressionKindToCodec(prestoOptions.compressionKind);
+  const auto codec = makeCodec(prestoOptions);
   auto const header = PrestoHeader::read(source);
 
   int64_t actualCheckSum = 0;
@@ -4195,6 +4398,20 @@ void PrestoVectorSerde::deserialize(
   VELOX_CHECK_EQ(
       header.checksum, actualCheckSum, "Received corrupted serialized page.");
 
+  if (prestoOptions.lazyColumns && !prestoOptions.useLosslessTimestamp &&
+      !prestoOptions.nullsFirst) {
+    deserializeLazyColumns(
+        source,
+        header,
+        codec.get(),
+        pool,
+        type,
+        result,
+        resultOffset,
+        prestoOptions);
+    return;
+  }
+
   if (resultOffset > 0) {
     VELOX_CHECK_NOT_NULL(*result);
     VELOX_CHECK(result->unique());
@@ -4283,6 +4500,21 @@ class PrestoVectorLexer {
   explicit PrestoVectorLexer(std::string_view source)
       : source_(source), committedPtr_(source.begin()) {}
 
+  /// Splits 'source', which starts at the number of columns after the page
+  /// header, into the serialized top level columns.
+  Status lexColumns(std::vector<std::string_view>& columns) && {
+    int32_t numColumns;
+    VELOX_RETURN_NOT_OK(lexInt(TokenType::NUM_COLUMNS, &numColumns));
+
+    columns.clear();
+    for (int32_t col = 0; col < numColumns; ++col) {
+      const auto* begin = source_.data();
+      VELOX_RETURN_NOT_OK(lexColumn());
+      columns.emplace_back(begin, source_.data() - begin);
+    }
+    return Status::OK();
+  }
+
   Status lex(std::vector<Token>& out) && {
     VELOX_RETURN_NOT_OK(lexHeader());
 
@@ -4567,6 +4799,179 @@ class PrestoVectorLexer {
   std::vector<uint64_t> nullsBuffer_;
   std::vector<Token> tokens_;
 };
+
+// A serialized top level column of a page.
+struct ColumnSegment {
+  // Uncompressed bytes of the page. Shared by the columns of the page.
+  BufferPtr page;
+  std::string_view data;
+  vector_size_t numRows;
+};
+
+// Deserializes a top level column of one or more pages when its lazy vector
+// is loaded. The segments are appended in order.
+class PrestoColumnLoader : public VectorLoader {
+ public:
+  PrestoColumnLoader(
+      TypePtr type,
+      std::vector<ColumnSegment> segments,
+      const SerdeOpts& opts,
+      memory::MemoryPool* pool)
+      : type_(std::move(type)),
+        segments_(std::move(segments)),
+        opts_(opts),
+        pool_(pool) {}
+
+  const std::vector<ColumnSegment>& segments() const {
+    return segments_;
+  }
+
+  void loadInternal(
+      RowSet /*rows*/,
+      ValueHook* hook,
+      vector_size_t resultSize,
+      VectorPtr* result) override {
+    VELOX_CHECK(!hook, "PrestoColumnLoader doesn't support ValueHook");
+    auto rowType = ROW({"c0"}, {type_});
+    auto row = std::make_shared<RowVector>(
+        pool_,
+        rowType,
+        BufferPtr(nullptr),
+        0,
+        std::vector<VectorPtr>{BaseVector::create(type_, 0, pool_)});
+    vector_size_t offset = 0;
+    for (const auto& segment : segments_) {
+      ByteRange range{
+          reinterpret_cast<uint8_t*>(const_cast<char*>(segment.data.data())),
+          static_cast<int32_t>(segment.data.size()),
+          0};
+      ByteInputStream source({range});
+      row->resize(offset + segment.numRows);
+      readTopColumns(source, rowType, pool_, row, offset, opts_, true);
+      offset += segment.numRows;
+    }
+    VELOX_CHECK_GE(offset, resultSize);
+    *result = row->childAt(0);
+    // The pages are freed once all columns that share them are loaded.
+    segments_.clear();
+  }
+
+ private:
+  const TypePtr type_;
+  std::vector<ColumnSegment> segments_;
+  const SerdeOpts opts_;
+  memory::MemoryPool* const pool_;
+};
+
+// Returns the loader of 'vector' if it is a lazy vector from a previous call
+// to deserializeLazyColumns() that is not loaded yet.
+const PrestoColumnLoader* unloadedColumnLoader(const VectorPtr& vector) {
+  if (vector == nullptr || !isLazyNotLoaded(*vector)) {
+    return nullptr;
+  }
+  return dynamic_cast<const PrestoColumnLoader*>(
+      vector->asUnchecked<LazyVector>()->loader());
+}
+
+// Returns the uncompressed bytes of the page that follows 'header' in
+// 'source', starting at the number of columns.
+BufferPtr readPage(
+    ByteInputStream* source,
+    const PrestoHeader& header,
+    folly::io::Codec* codec,
+    velox::memory::MemoryPool* pool) {
+  auto page = AlignedBuffer::allocate<char>(header.uncompressedSize, pool);
+  if (!isCompressedBitSet(header.pageCodecMarker)) {
+    source->readBytes(page->asMutable<uint8_t>(), header.uncompressedSize);
+    return page;
+  }
+
+  auto compressBuf = folly::IOBuf::create(header.compressedSize);
+  source->readBytes(compressBuf->writableData(), header.compressedSize);
+  compressBuf->append(header.compressedSize);
+  auto uncompress =
+      codec->uncompress(compressBuf.get(), header.uncompressedSize);
+  VELOX_CHECK_EQ(uncompress->computeChainDataLength(), header.uncompressedSize);
+  auto* rawPage = page->asMutable<uint8_t>();
+  for (const auto& range : *uncompress) {
+    memcpy(rawPage, range.data(), range.size());
+    rawPage += range.size();
+  }
+  return page;
+}
+
+void deserializeLazyColumns(
+    ByteInputStream* source,
+    const PrestoHeader& header,
+    folly::io::Codec* codec,
+    velox::memory::MemoryPool* pool,
+    const RowTypePtr& type,
+    RowVectorPtr* result,
+    vector_size_t resultOffset,
+    const SerdeOpts& opts) {
+  auto page = readPage(source, header, codec, pool);
+  const std::string_view pageData(page->as<char>(), page->size());
+
+  std::vector<std::string_view> columns;
+  const auto status = PrestoVectorLexer(pageData).lexColumns(columns);
+  VELOX_CHECK(status.ok(), "Failed to locate columns: {}", status.message());
+  // Bug for bug compatibility with readTopColumns(): Extra columns at the end
+  // are allowed for non-compressed data.
+  if (opts.compressionKind == common::CompressionKind_NONE) {
+    VELOX_USER_CHECK_GE(
+        columns.size(),
+        type->size(),
+        "Number of columns in serialized data doesn't match "
+        "number of columns requested for deserialization");
+  } else {
+    VELOX_USER_CHECK_EQ(
+        columns.size(),
+        type->size(),
+        "Number of columns in serialized data doesn't match "
+        "number of columns requested for deserialization");
+  }
+
+  const auto numColumns = type->size();
+  std::vector<const PrestoColumnLoader*> previousLoaders(numColumns, nullptr);
+  if (resultOffset > 0) {
+    VELOX_CHECK_NOT_NULL(*result);
+    VELOX_CHECK(result->unique());
+    for (auto i = 0; i < numColumns; ++i) {
+      previousLoaders[i] = unloadedColumnLoader((*result)->childAt(i));
+      if (previousLoaders[i] == nullptr) {
+        // Appends to a result that is not all lazy. Loads the result and
+        // reads the page eagerly.
+        (*result)->loadedVector();
+        (*result)->resize(resultOffset + header.numRows);
+        ByteRange range{
+            page->asMutable<uint8_t>(), static_cast<int32_t>(page->size()), 0};
+        ByteInputStream pageSource({range});
+        readTopColumns(pageSource, type, pool, *result, resultOffset, opts);
+        return;
+      }
+    }
+  }
+
+  // Appends this page to the segments of the lazy vectors of the previous
+  // pages, if any.
+  const auto numRows = resultOffset + header.numRows;
+  std::vector<VectorPtr> children(numColumns);
+  for (auto i = 0; i < numColumns; ++i) {
+    std::vector<ColumnSegment> segments;
+    if (previousLoaders[i] != nullptr) {
+      segments = previousLoaders[i]->segments();
+    }
+    segments.push_back({page, columns[i], header.numRows});
+    children[i] = std::make_shared<LazyVector>(
+        pool,
+        type->childAt(i),
+        numRows,
+        std::make_unique<PrestoColumnLoader>(
+            type->childAt(i), std::move(segments), opts, pool));
+  }
+  *result = std::make_shared<RowVector>(
+      pool, type, BufferPtr(nullptr), numRows, std::move(children));
+}
 } // namespace
 
 /* static */ Status PrestoVectorSerde::lex(
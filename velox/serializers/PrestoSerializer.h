@@ -19,6 +19,7 @@
 
 #include "velox/common/base/Crc.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/common/compression/ZstdDictionary.h"
 #include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::serializer::presto {
@@ -70,8 +71,38 @@ class PrestoVectorSerde : public VectorSerde {
 
     /// Minimum achieved compression if compression is enabled. Compressing less
     /// than this causes subsequent compression attempts to be skipped. The more
-    /// times compression misses the target the less frequently it is tried.
+    /// times compression misses the target the less frequently it is tried. A
+    /// page that meets the target resets the backoff.
     float minCompressionRatio{0.8};
+
+    /// Maximum CPU time in nanoseconds per byte saved by compressing a page.
+    /// A page that takes longer to compress counts as a miss for the backoff
+    /// described in 'minCompressionRatio'. 0 means no limit.
+    float maxCompressionNanosPerSavedByte{0};
+
+    /// Keeps the dictionary and constant encodings of the top level columns
+    /// in the iterative serializer. The columns that are dictionary or
+    /// constant encoded in the first appended batch are serialized as Presto
+    /// DICTIONARY blocks. Each append adds the distinct values it references
+    /// to the dictionary values. A dictionary with nulls, a constant with a
+    /// value vector or a flat vector appended later adds all its rows to the
+    /// dictionary values. This keeps the wire size of dictionary heavy
+    /// batches, e.g. after a join or unnest, close to their in-memory size.
+    /// The batch serializer always keeps the encodings.
+    bool preserveEncodings{false};
+
+    /// Makes deserialize() return the top level columns as lazy vectors that
+    /// are deserialized on first access. Deserialize only locates the columns
+    /// in the page and keeps a copy of the page bytes for the loaders.
+    /// Appending a page to a lazy result adds the page to the lazy vectors.
+    /// Not used with lossless timestamps or nulls first since the columns
+    /// cannot be located without reading them.
+    bool lazyColumns{false};
+
+    /// Compresses pages with this dictionary if 'compressionKind' is ZSTD.
+    /// The dictionary is not in the serialized data, so the pages must be
+    /// deserialized with the same dictionary. Used for spilling.
+    std::shared_ptr<const common::ZstdDictionary> zstdDictionary;
   };
 
   /// Adds the serialized sizes of the rows of 'vector' in 'ranges[i]' to
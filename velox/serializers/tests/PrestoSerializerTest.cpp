@@ -1197,6 +1197,92 @@ TEST_P(PrestoSerializerTest, lazy) {
   testRoundTrip(lazyVector);
 }
 
+TEST_P(PrestoSerializerTest, lazyColumns) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          300, [](auto row) { return row; }, nullEvery(7)),
+      makeFlatVector<std::string>(
+          300,
+          [](auto row) { return std::string(row % 23, 'x'); },
+          nullEvery(5)),
+      makeArrayVector<int32_t>(
+          300,
+          [](auto row) { return row % 4; },
+          [](auto row) { return row; },
+          nullEvery(11)),
+      makeMapVector<int32_t, double>(
+          300,
+          [](auto row) { return row % 3; },
+          [](auto row) { return row; },
+          [](auto row) { return row * 0.5; }),
+      makeRowVector(
+          {makeFlatVector<int32_t>(300, [](auto row) { return row; }),
+           makeFlatVector<std::string>(
+               300, [](auto row) { return std::to_string(row); })},
+          nullEvery(13)),
+  });
+  auto rowType = asRowType(data->type());
+
+  std::vector<std::string> pages;
+  for (const auto& split : split(data, 3)) {
+    std::ostringstream out;
+    serialize(split, &out, nullptr);
+    pages.push_back(out.str());
+  }
+
+  auto options = getParamSerdeOptions(nullptr);
+  options.lazyColumns = true;
+  auto deserializePage = [&](const std::string& page,
+                             RowVectorPtr& result,
+                             vector_size_t offset) {
+    auto byteStream = toByteStream(page);
+    serde_->deserialize(
+        &byteStream, pool_.get(), rowType, &result, offset, &options);
+    ASSERT_TRUE(byteStream.atEnd());
+  };
+
+  auto assertLazy = [&](const RowVectorPtr& result) {
+    for (const auto& child : result->children()) {
+      ASSERT_TRUE(isLazyNotLoaded(*child));
+    }
+  };
+
+  // A single page. Columns are loaded one by one.
+  RowVectorPtr result;
+  deserializePage(pages[0], result, 0);
+  assertLazy(result);
+  auto expected = split(data, 3)[0];
+  for (auto i = 0; i < rowType->size(); ++i) {
+    assertEqualVectors(expected->childAt(i), result->childAt(i));
+    if (i + 1 < rowType->size()) {
+      ASSERT_TRUE(isLazyNotLoaded(*result->childAt(i + 1)));
+    }
+  }
+
+  // Pages appended to a lazy result stay lazy and are read in order on load.
+  result.reset();
+  vector_size_t offset = 0;
+  for (const auto& page : pages) {
+    deserializePage(page, result, offset);
+    assertLazy(result);
+    offset = result->size();
+  }
+  ASSERT_EQ(data->size(), result->size());
+  assertEqualVectors(data, result);
+
+  // Appending to a partially loaded result loads the rest and appends
+  // eagerly.
+  result.reset();
+  deserializePage(pages[0], result, 0);
+  result->childAt(1)->loadedVector();
+  deserializePage(pages[1], result, result->size());
+  for (const auto& child : result->children()) {
+    ASSERT_FALSE(child->isLazy());
+  }
+  deserializePage(pages[2], result, result->size());
+  assertEqualVectors(data, result);
+}
+
 TEST_P(PrestoSerializerTest, ioBufRoundTrip) {
   VectorFuzzer::Options opts;
   opts.timestampPrecision =
@@ -1340,6 +1426,79 @@ TEST_P(PrestoSerializerTest, encodedConcatenation2) {
   }
 }
 
+TEST_P(PrestoSerializerTest, preserveEncodingsIterativeSerializer) {
+  const auto rowType =
+      ROW({"c0", "c1", "c2"}, {BIGINT(), VARCHAR(), BIGINT()});
+  const std::vector<std::string> names = {"apple", "banana", "cherry"};
+  auto makeBatch = [&](vector_size_t size, int32_t offset) {
+    auto indices = makeIndices(size, [](auto row) { return row % 3; });
+    return makeRowVector(
+        {wrapInDictionary(
+             indices,
+             size,
+             makeFlatVector<int64_t>(
+                 3, [&](auto row) { return row + offset; })),
+         wrapInDictionary(
+             indices,
+             size,
+             makeFlatVector<std::string>(
+                 3, [&](auto row) { return names[(row + offset) % 3]; })),
+         makeConstant<int64_t>(offset, size)});
+  };
+  // Two batches with different dictionaries and constants.
+  const std::vector<RowVectorPtr> batches = {
+      makeBatch(100, 0), makeBatch(50, 10)};
+
+  auto serializeBatches = [&](bool preserveEncodings) {
+    auto paramOptions = getParamSerdeOptions(nullptr);
+    paramOptions.preserveEncodings = preserveEncodings;
+    StreamArena arena(pool_.get());
+    auto serializer =
+        serde_->createIterativeSerializer(rowType, 150, &arena, &paramOptions);
+    Scratch scratch;
+    for (const auto& batch : batches) {
+      // Appends every other row.
+      std::vector<vector_size_t> rows;
+      for (auto i = 0; i < batch->size(); i += 2) {
+        rows.push_back(i);
+      }
+      serializer->append(
+          batch, folly::Range(rows.data(), rows.size()), scratch);
+    }
+    std::ostringstream out;
+    facebook::velox::serializer::presto::PrestoOutputStreamListener listener;
+    OStreamOutputStream output(&out, &listener);
+    serializer->flush(&output);
+    return out.str();
+  };
+
+  // The first 50 rows come from the first batch, the last 25 from the second.
+  auto index = [](auto row) {
+    return row < 50 ? row * 2 % 3 : (row - 50) * 2 % 3;
+  };
+  auto offset = [](auto row) { return row < 50 ? 0 : 10; };
+  const auto expected = makeRowVector({
+      makeFlatVector<int64_t>(
+          75, [&](auto row) { return index(row) + offset(row); }),
+      makeFlatVector<std::string>(
+          75,
+          [&](auto row) { return names[(index(row) + offset(row)) % 3]; }),
+      makeFlatVector<int64_t>(75, offset),
+  });
+
+  const auto flat = serializeBatches(false);
+  const auto encoded = serializeBatches(true);
+  assertEqualVectors(expected, deserialize(rowType, flat, nullptr));
+  const auto result = deserialize(rowType, encoded, nullptr);
+  assertEqualVectors(expected, result);
+  for (const auto& child : result->children()) {
+    ASSERT_EQ(child->encoding(), VectorEncoding::Simple::DICTIONARY);
+  }
+  if (GetParam() == common::CompressionKind::CompressionKind_NONE) {
+    ASSERT_LT(encoded.size(), flat.size());
+  }
+}
+
 TEST_P(PrestoSerializerTest, emptyArrayOfRowVector) {
   // The value of nullCount_ + nonNullCount_ of the inner RowVector is 0.
   auto arrayOfRow = makeArrayOfRowVector(ROW({UNKNOWN()}), {{}});
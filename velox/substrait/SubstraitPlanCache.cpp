@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/substrait/SubstraitPlanCache.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+namespace facebook::velox::substrait {
+
+namespace {
+// Calls 'func' on the ReadRels under 'rel' in depth-first order.
+template <typename Func>
+void forEachRead(::substrait::Rel& rel, Func& func) {
+  ::substrait::Rel* input = nullptr;
+  switch (rel.rel_type_case()) {
+    case ::substrait::Rel::RelTypeCase::kRead:
+      func(*rel.mutable_read());
+      return;
+    case ::substrait::Rel::RelTypeCase::kAggregate:
+      input = rel.mutable_aggregate()->mutable_input();
+      break;
+    case ::substrait::Rel::RelTypeCase::kProject:
+      input = rel.mutable_project()->mutable_input();
+      break;
+    case ::substrait::Rel::RelTypeCase::kFilter:
+      input = rel.mutable_filter()->mutable_input();
+      break;
+    case ::substrait::Rel::RelTypeCase::kFetch:
+      input = rel.mutable_fetch()->mutable_input();
+      break;
+    case ::substrait::Rel::RelTypeCase::kSort:
+      input = rel.mutable_sort()->mutable_input();
+      break;
+    default:
+      // Not supported by SubstraitVeloxPlanConverter.
+      return;
+  }
+  forEachRead(*input, func);
+}
+
+// Adds the ids of the leaves of 'node' to 'ids' in depth-first order.
+void collectLeafIds(
+    const core::PlanNodePtr& node,
+    std::vector<core::PlanNodeId>& ids) {
+  if (node->sources().empty()) {
+    ids.push_back(node->id());
+    return;
+  }
+  for (const auto& source : node->sources()) {
+    collectLeafIds(source, ids);
+  }
+}
+
+// Serializes 'plan' with map entries in a fixed order, so that equal plans
+// have equal bytes.
+std::string serializeDeterministic(const ::substrait::Plan& plan) {
+  std::string bytes;
+  {
+    google::protobuf::io::StringOutputStream stream(&bytes);
+    google::protobuf::io::CodedOutputStream output(&stream);
+    output.SetSerializationDeterministic(true);
+    VELOX_CHECK(plan.SerializeToCodedStream(&output));
+  }
+  return bytes;
+}
+} // namespace
+
+SubstraitPlanCache::SubstraitPlanCache(
+    memory::MemoryPool* pool,
+    size_t maxEntries)
+    : pool_(pool), cache_(maxEntries) {
+  VELOX_CHECK_NOT_NULL(pool_);
+}
+
+SubstraitPlanCache::ConvertedPlan SubstraitPlanCache::toVeloxPlan(
+    const ::substrait::Plan& substraitPlan) {
+  // The plan without the files to read is the key. The files become the split
+  // infos of the returned plan.
+  ::substrait::Plan key = substraitPlan;
+  std::vector<std::shared_ptr<SplitInfo>> splitInfos;
+  auto removeFiles = [&](::substrait::ReadRel& readRel) {
+    auto splitInfo = std::make_shared<SplitInfo>();
+    SubstraitVeloxPlanConverter::toSplitInfo(readRel, *splitInfo);
+    splitInfos.push_back(std::move(splitInfo));
+    readRel.clear_local_files();
+  };
+  for (auto& relation : *key.mutable_relations()) {
+    if (relation.has_root()) {
+      forEachRead(*relation.mutable_root()->mutable_input(), removeFiles);
+    } else if (relation.has_rel()) {
+      forEachRead(*relation.mutable_rel(), removeFiles);
+    }
+  }
+  const auto fingerprint = serializeDeterministic(key);
+
+  std::shared_ptr<const CacheEntry> entry;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    entry = cache_.get(fingerprint).value_or(nullptr);
+  }
+  if (entry == nullptr) {
+    SubstraitVeloxPlanConverter converter(pool_);
+    auto plan = converter.toVeloxPlan(substraitPlan);
+    std::vector<core::PlanNodeId> readNodeIds;
+    collectLeafIds(plan, readNodeIds);
+    VELOX_CHECK_EQ(readNodeIds.size(), splitInfos.size());
+    entry = std::make_shared<const CacheEntry>(
+        CacheEntry{std::move(plan), std::move(readNodeIds)});
+    std::lock_guard<std::mutex> l(mutex_);
+    cache_.add(fingerprint, entry);
+  }
+
+  ConvertedPlan result{entry->plan, {}};
+  for (auto i = 0; i < splitInfos.size(); ++i) {
+    result.splitInfos[entry->readNodeIds[i]] = std::move(splitInfos[i]);
+  }
+  return result;
+}
+
+} // namespace facebook::velox::substrait
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/substrait/SubstraitToVeloxPlan.h"
+
+namespace facebook::velox::substrait {
+
+/// Converts Substrait plans into Velox plans and remembers the result for
+/// plans of the same shape. Clients like Gluten send the same plan for every
+/// task of a stage, with only the files to read in the ReadRels changing. The
+/// cache keys a plan by its bytes without these files, so that such plans are
+/// parsed, have their functions resolved and their PlanNode trees built once.
+/// The files of each plan are returned as split infos for the scans of the
+/// shared plan.
+///
+/// Thread-safe. Plans are converted outside of the lock, so concurrent misses
+/// on the same plan may convert it more than once.
+class SubstraitPlanCache {
+ public:
+  using SplitInfo = SubstraitVeloxPlanConverter::SplitInfo;
+
+  struct ConvertedPlan {
+    core::PlanNodePtr plan;
+
+    /// Files to read for each leaf plan node that comes from a ReadRel.
+    std::unordered_map<core::PlanNodeId, std::shared_ptr<SplitInfo>>
+        splitInfos;
+  };
+
+  /// 'pool' is used for the constants in the cached plans and must outlive
+  /// the cache and the plans it returns. Keeps up to 'maxEntries' plans.
+  SubstraitPlanCache(memory::MemoryPool* pool, size_t maxEntries);
+
+  /// Returns the Velox plan for 'substraitPlan'. The returned plan node tree
+  /// is shared by all plans that differ only in local files.
+  ConvertedPlan toVeloxPlan(const ::substrait::Plan& substraitPlan);
+
+  SimpleLRUCacheStats stats() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return cache_.getStats();
+  }
+
+ private:
+  // A converted plan with the ids of the plan nodes that come from the
+  // ReadRels of the Substrait plan in depth-first order.
+  struct CacheEntry {
+    core::PlanNodePtr plan;
+    std::vector<core::PlanNodeId> readNodeIds;
+  };
+
+  memory::MemoryPool* const pool_;
+
+  mutable std::mutex mutex_;
+  SimpleLRUCache<std::string, std::shared_ptr<const CacheEntry>> cache_;
+};
+
+} // namespace facebook::velox::substrait
@@ -63,6 +63,12 @@ class SubstraitVeloxPlanConverter {
       const ::substrait::ReadRel& readRel,
       std::shared_ptr<SplitInfo>& splitInfo);
 
+  /// Fills 'splitInfo' with the local files of 'readRel'. Leaves 'splitInfo'
+  /// unchanged if 'readRel' has no local files.
+  static void toSplitInfo(
+      const ::substrait::ReadRel& readRel,
+      SplitInfo& splitInfo);
+
   /// Convert Substrait FetchRel into Velox LimitNode or TopNNode according the
   /// different input of fetchRel.
   core::PlanNodePtr toVeloxPlan(const ::substrait::FetchRel& fetchRel);
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/substrait/SubstraitPlanCache.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/dwio/common/tests/utils/DataFiles.h"
+#include "velox/substrait/tests/JsonToProtoConverter.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::substrait;
+
+namespace {
+
+class SubstraitPlanCacheTest : public testing::Test,
+                               public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  ::substrait::Plan readPlan() {
+    ::substrait::Plan plan;
+    JsonToProtoConverter::readFromFile(
+        test::getDataFilePath(
+            "velox/substrait/tests", "data/q6_first_stage.json"),
+        plan);
+    return plan;
+  }
+
+  // Returns the local file of the only ReadRel of 'plan'.
+  static ::substrait::ReadRel_LocalFiles_FileOrFiles* file(
+      ::substrait::Plan& plan) {
+    auto* rel = plan.mutable_relations(0)->mutable_root()->mutable_input();
+    while (!rel->has_read()) {
+      rel = rel->has_aggregate() ? rel->mutable_aggregate()->mutable_input()
+                                 : rel->mutable_project()->mutable_input();
+    }
+    return rel->mutable_read()->mutable_local_files()->mutable_items(0);
+  }
+};
+
+TEST_F(SubstraitPlanCacheTest, sameShape) {
+  SubstraitPlanCache cache(pool(), 10);
+
+  auto plan = readPlan();
+  auto first = cache.toVeloxPlan(plan);
+
+  // The plan is the same as without the cache.
+  SubstraitVeloxPlanConverter converter(pool());
+  ASSERT_EQ(
+      first.plan->toString(true, true),
+      converter.toVeloxPlan(plan)->toString(true, true));
+  ASSERT_EQ(first.splitInfos.size(), 1);
+  const auto scanId = *first.plan->leafPlanNodeIds().begin();
+  ASSERT_EQ(first.splitInfos.at(scanId)->paths[0], "/mock_lineitem.orc");
+
+  // Another split of the same plan reuses the plan and has its own files.
+  file(plan)->set_uri_file("/other.orc");
+  file(plan)->set_start(100);
+  file(plan)->set_partition_index(3);
+  auto second = cache.toVeloxPlan(plan);
+  ASSERT_EQ(second.plan, first.plan);
+  const auto& splitInfo = second.splitInfos.at(scanId);
+  ASSERT_EQ(splitInfo->paths, std::vector<std::string>{"/other.orc"});
+  ASSERT_EQ(splitInfo->starts, std::vector<uint64_t>{100});
+  ASSERT_EQ(splitInfo->lengths, std::vector<uint64_t>{3719});
+  ASSERT_EQ(splitInfo->partitionIndex, 3);
+  ASSERT_EQ(splitInfo->format, dwio::common::FileFormat::DWRF);
+  ASSERT_EQ(first.splitInfos.at(scanId)->paths[0], "/mock_lineitem.orc");
+
+  // A change outside of the files is another plan.
+  plan.mutable_relations(0)->mutable_root()->add_names("revenue");
+  auto third = cache.toVeloxPlan(plan);
+  ASSERT_NE(third.plan, first.plan);
+  ASSERT_EQ(
+      third.plan->toString(true, true), first.plan->toString(true, true));
+
+  const auto stats = cache.stats();
+  ASSERT_EQ(stats.numLookups, 3);
+  ASSERT_EQ(stats.numHits, 1);
+  ASSERT_EQ(stats.curSize, 2);
+}
+
+TEST_F(SubstraitPlanCacheTest, eviction) {
+  SubstraitPlanCache cache(pool(), 1);
+  auto plan = readPlan();
+  auto first = cache.toVeloxPlan(plan);
+
+  auto other = plan;
+  other.mutable_relations(0)->mutable_root()->add_names("revenue");
+  cache.toVeloxPlan(other);
+  ASSERT_EQ(cache.stats().curSize, 1);
+
+  // The first plan was evicted. Plans returned before stay valid.
+  auto again = cache.toVeloxPlan(plan);
+  ASSERT_NE(again.plan, first.plan);
+  ASSERT_EQ(
+      again.plan->toString(true, true), first.plan->toString(true, true));
+  ASSERT_EQ(cache.stats().numHits, 0);
+}
+
+} // namespace
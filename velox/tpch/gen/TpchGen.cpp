@@ -63,19 +63,67 @@ size_t getVectorSize(size_t rowCount, size_t maxRows, size_t offset) {
   return std::min(rowCount - offset, maxRows);
 }
 
+// Allocates the vectors of the columns of 'type' in 'columns', or of all
+// columns if 'columns' is empty. The vectors of the other columns are null, so
+// that their values are not copied out of the records made by dbgen.
 std::vector<VectorPtr> allocateVectors(
     const RowTypePtr& type,
     size_t vectorSize,
+    const std::vector<column_index_t>& columns,
     memory::MemoryPool* pool) {
-  std::vector<VectorPtr> vectors;
-  vectors.reserve(type->size());
-
-  for (const auto& childType : type->children()) {
-    vectors.emplace_back(BaseVector::create(childType, vectorSize, pool));
+  std::vector<VectorPtr> vectors(type->size());
+  if (columns.empty()) {
+    for (auto i = 0; i < type->size(); ++i) {
+      vectors[i] = BaseVector::create(type->childAt(i), vectorSize, pool);
+    }
+    return vectors;
+  }
+  for (auto column : columns) {
+    VELOX_CHECK_LT(column, type->size());
+    if (!vectors[column]) {
+      vectors[column] =
+          BaseVector::create(type->childAt(column), vectorSize, pool);
+    }
   }
   return vectors;
 }
 
+template <typename T>
+FlatVector<T>* asFlatVector(const VectorPtr& vector) {
+  return vector ? vector->asFlatVector<T>() : nullptr;
+}
+
+// Returns the columns of 'type' in 'columns', or all columns if 'columns' is
+// empty.
+RowVectorPtr makeRowVector(
+    const RowTypePtr& type,
+    size_t size,
+    std::vector<VectorPtr> children,
+    const std::vector<column_index_t>& columns,
+    memory::MemoryPool* pool) {
+  if (columns.empty()) {
+    return std::make_shared<RowVector>(
+        pool, type, BufferPtr(nullptr), size, std::move(children));
+  }
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  std::vector<VectorPtr> projected;
+  names.reserve(columns.size());
+  types.reserve(columns.size());
+  projected.reserve(columns.size());
+  for (auto column : columns) {
+    names.push_back(type->nameOf(column));
+    types.push_back(type->childAt(column));
+    projected.push_back(children[column]);
+  }
+  return std::make_shared<RowVector>(
+      pool,
+      ROW(std::move(names), std::move(types)),
+      BufferPtr(nullptr),
+      size,
+      std::move(projected));
+}
+
 double decimalToDouble(int64_t value) {
   return (double)value * 0.01;
 }
@@ -357,22 +405,23 @@ RowVectorPtr genTpchOrders(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    const std::vector<column_index_t>& columns) {
   // Create schema and allocate vectors.
   auto ordersRowType = getTableSchema(Table::TBL_ORDERS);
   size_t vectorSize = getVectorSize(
       getRowCount(Table::TBL_ORDERS, scaleFactor), maxRows, offset);
-  auto children = allocateVectors(ordersRowType, vectorSize, pool);
-
-  auto orderKeyVector = children[0]->asFlatVector<int64_t>();
-  auto custKeyVector = children[1]->asFlatVector<int64_t>();
-  auto orderStatusVector = children[2]->asFlatVector<StringView>();
-  auto totalPriceVector = children[3]->asFlatVector<double>();
-  auto orderDateVector = children[4]->asFlatVector<int32_t>();
-  auto orderPriorityVector = children[5]->asFlatVector<StringView>();
-  auto clerkVector = children[6]->asFlatVector<StringView>();
-  auto shipPriorityVector = children[7]->asFlatVector<int32_t>();
-  auto commentVector = children[8]->asFlatVector<StringView>();
+  auto children = allocateVectors(ordersRowType, vectorSize, columns, pool);
+
+  auto* orderKeyVector = asFlatVector<int64_t>(children[0]);
+  auto* custKeyVector = asFlatVector<int64_t>(children[1]);
+  auto* orderStatusVector = asFlatVector<StringView>(children[2]);
+  auto* totalPriceVector = asFlatVector<double>(children[3]);
+  auto* orderDateVector = asFlatVector<int32_t>(children[4]);
+  auto* orderPriorityVector = asFlatVector<StringView>(children[5]);
+  auto* clerkVector = asFlatVector<StringView>(children[6]);
+  auto* shipPriorityVector = asFlatVector<int32_t>(children[7]);
+  auto* commentVector = asFlatVector<StringView>(children[8]);
 
   DBGenIterator dbgenIt(scaleFactor);
   dbgenIt.initOrder(offset);
@@ -383,26 +432,45 @@ RowVectorPtr genTpchOrders(
   for (size_t i = 0; i < vectorSize; ++i) {
     dbgenIt.genOrder(i + offset + 1, order);
 
-    orderKeyVector->set(i, order.okey);
-    custKeyVector->set(i, order.custkey);
-    orderStatusVector->set(i, StringView(&order.orderstatus, 1));
-    totalPriceVector->set(i, decimalToDouble(order.totalprice));
-    orderDateVector->set(i, toDate(order.odate));
-    orderPriorityVector->set(
-        i, StringView(order.opriority, strlen(order.opriority)));
-    clerkVector->set(i, StringView(order.clerk, strlen(order.clerk)));
-    shipPriorityVector->set(i, order.spriority);
-    commentVector->set(i, StringView(order.comment, order.clen));
+    if (orderKeyVector) {
+      orderKeyVector->set(i, order.okey);
+    }
+    if (custKeyVector) {
+      custKeyVector->set(i, order.custkey);
+    }
+    if (orderStatusVector) {
+      orderStatusVector->set(i, StringView(&order.orderstatus, 1));
+    }
+    if (totalPriceVector) {
+      totalPriceVector->set(i, decimalToDouble(order.totalprice));
+    }
+    if (orderDateVector) {
+      orderDateVector->set(i, toDate(order.odate));
+    }
+    if (orderPriorityVector) {
+      orderPriorityVector->set(
+          i, StringView(order.opriority, strlen(order.opriority)));
+    }
+    if (clerkVector) {
+      clerkVector->set(i, StringView(order.clerk, strlen(order.clerk)));
+    }
+    if (shipPriorityVector) {
+      shipPriorityVector->set(i, order.spriority);
+    }
+    if (commentVector) {
+      commentVector->set(i, StringView(order.comment, order.clen));
+    }
   }
-  return std::make_shared<RowVector>(
-      pool, ordersRowType, BufferPtr(nullptr), vectorSize, std::move(children));
+  return makeRowVector(
+      ordersRowType, vectorSize, std::move(children), columns, pool);
 }
 
 RowVectorPtr genTpchLineItem(
     memory::MemoryPool* pool,
     size_t maxOrderRows,
     size_t ordersOffset,
-    double scaleFactor) {
+    double scaleFactor,
+    const std::vector<column_index_t>& columns) {
   // We control the buffer size based on the orders table, then allocate the
   // underlying buffer using the worst case (orderVectorSize * 7).
   size_t orderVectorSize = getVectorSize(
@@ -411,26 +479,27 @@ RowVectorPtr genTpchLineItem(
 
   // Create schema and allocate vectors.
   auto lineItemRowType = getTableSchema(Table::TBL_LINEITEM);
-  auto children = allocateVectors(lineItemRowType, lineItemUpperBound, pool);
-
-  auto orderKeyVector = children[0]->asFlatVector<int64_t>();
-  auto partKeyVector = children[1]->asFlatVector<int64_t>();
-  auto suppKeyVector = children[2]->asFlatVector<int64_t>();
-  auto lineNumberVector = children[3]->asFlatVector<int32_t>();
-
-  auto quantityVector = children[4]->asFlatVector<double>();
-  auto extendedPriceVector = children[5]->asFlatVector<double>();
-  auto discountVector = children[6]->asFlatVector<double>();
-  auto taxVector = children[7]->asFlatVector<double>();
-
-  auto returnFlagVector = children[8]->asFlatVector<StringView>();
-  auto lineStatusVector = children[9]->asFlatVector<StringView>();
-  auto shipDateVector = children[10]->asFlatVector<int32_t>();
-  auto commitDateVector = children[11]->asFlatVector<int32_t>();
-  auto receiptDateVector = children[12]->asFlatVector<int32_t>();
-  auto shipInstructVector = children[13]->asFlatVector<StringView>();
-  auto shipModeVector = children[14]->asFlatVector<StringView>();
-  auto commentVector = children[15]->asFlatVector<StringView>();
+  auto children =
+      allocateVectors(lineItemRowType, lineItemUpperBound, columns, pool);
+
+  auto* orderKeyVector = asFlatVector<int64_t>(children[0]);
+  auto* partKeyVector = asFlatVector<int64_t>(children[1]);
+  auto* suppKeyVector = asFlatVector<int64_t>(children[2]);
+  auto* lineNumberVector = asFlatVector<int32_t>(children[3]);
+
+  auto* quantityVector = asFlatVector<double>(children[4]);
+  auto* extendedPriceVector = asFlatVector<double>(children[5]);
+  auto* discountVector = asFlatVector<double>(children[6]);
+  auto* taxVector = asFlatVector<double>(children[7]);
+
+  auto* returnFlagVector = asFlatVector<StringView>(children[8]);
+  auto* lineStatusVector = asFlatVector<StringView>(children[9]);
+  auto* shipDateVector = asFlatVector<int32_t>(children[10]);
+  auto* commitDateVector = asFlatVector<int32_t>(children[11]);
+  auto* receiptDateVector = asFlatVector<int32_t>(children[12]);
+  auto* shipInstructVector = asFlatVector<StringView>(children[13]);
+  auto* shipModeVector = asFlatVector<StringView>(children[14]);
+  auto* commentVector = asFlatVector<StringView>(children[15]);
 
   DBGenIterator dbgenIt(scaleFactor);
   dbgenIt.initOrder(ordersOffset);
@@ -447,67 +516,92 @@ RowVectorPtr genTpchLineItem(
 
     for (size_t l = 0; l < order.lines; ++l) {
       const auto& line = order.l[l];
-      orderKeyVector->set(lineItemCount + l, line.okey);
-      partKeyVector->set(lineItemCount + l, line.partkey);
-      suppKeyVector->set(lineItemCount + l, line.suppkey);
-
-      lineNumberVector->set(lineItemCount + l, line.lcnt);
-
-      quantityVector->set(lineItemCount + l, decimalToDouble(line.quantity));
-      extendedPriceVector->set(lineItemCount + l, decimalToDouble(line.eprice));
-      discountVector->set(lineItemCount + l, decimalToDouble(line.discount));
-      taxVector->set(lineItemCount + l, decimalToDouble(line.tax));
-
-      returnFlagVector->set(lineItemCount + l, StringView(line.rflag, 1));
-      lineStatusVector->set(lineItemCount + l, StringView(line.lstatus, 1));
-
-      shipDateVector->set(lineItemCount + l, toDate(line.sdate));
-      commitDateVector->set(lineItemCount + l, toDate(line.cdate));
-      receiptDateVector->set(lineItemCount + l, toDate(line.rdate));
-
-      shipInstructVector->set(
-          lineItemCount + l,
-          StringView(line.shipinstruct, strlen(line.shipinstruct)));
-      shipModeVector->set(
-          lineItemCount + l, StringView(line.shipmode, strlen(line.shipmode)));
-      commentVector->set(
-          lineItemCount + l, StringView(line.comment, strlen(line.comment)));
+      const auto row = lineItemCount + l;
+      if (orderKeyVector) {
+        orderKeyVector->set(row, line.okey);
+      }
+      if (partKeyVector) {
+        partKeyVector->set(row, line.partkey);
+      }
+      if (suppKeyVector) {
+        suppKeyVector->set(row, line.suppkey);
+      }
+      if (lineNumberVector) {
+        lineNumberVector->set(row, line.lcnt);
+      }
+      if (quantityVector) {
+        quantityVector->set(row, decimalToDouble(line.quantity));
+      }
+      if (extendedPriceVector) {
+        extendedPriceVector->set(row, decimalToDouble(line.eprice));
+      }
+      if (discountVector) {
+        discountVector->set(row, decimalToDouble(line.discount));
+      }
+      if (taxVector) {
+        taxVector->set(row, decimalToDouble(line.tax));
+      }
+      if (returnFlagVector) {
+        returnFlagVector->set(row, StringView(line.rflag, 1));
+      }
+      if (lineStatusVector) {
+        lineStatusVector->set(row, StringView(line.lstatus, 1));
+      }
+      if (shipDateVector) {
+        shipDateVector->set(row, toDate(line.sdate));
+      }
+      if (commitDateVector) {
+        commitDateVector->set(row, toDate(line.cdate));
+      }
+      if (receiptDateVector) {
+        receiptDateVector->set(row, toDate(line.rdate));
+      }
+      if (shipInstructVector) {
+        shipInstructVector->set(
+            row, StringView(line.shipinstruct, strlen(line.shipinstruct)));
+      }
+      if (shipModeVector) {
+        shipModeVector->set(
+            row, StringView(line.shipmode, strlen(line.shipmode)));
+      }
+      if (commentVector) {
+        commentVector->set(row, StringView(line.comment, strlen(line.comment)));
+      }
     }
     lineItemCount += order.lines;
   }
 
   // Resize to shrink the buffers - since we allocated based on the upper bound.
   for (auto& child : children) {
-    child->resize(lineItemCount);
+    if (child) {
+      child->resize(lineItemCount);
+    }
   }
-  return std::make_shared<RowVector>(
-      pool,
-      lineItemRowType,
-      BufferPtr(nullptr),
-      lineItemCount,
-      std::move(children));
+  return makeRowVector(
+      lineItemRowType, lineItemCount, std::move(children), columns, pool);
 }
 
 RowVectorPtr genTpchPart(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    const std::vector<column_index_t>& columns) {
   // Create schema and allocate vectors.
   auto partRowType = getTableSchema(Table::TBL_PART);
   size_t vectorSize =
       getVectorSize(getRowCount(Table::TBL_PART, scaleFactor), maxRows, offset);
-  auto children = allocateVectors(partRowType, vectorSize, pool);
-
-  auto partKeyVector = children[0]->asFlatVector<int64_t>();
-  auto nameVector = children[1]->asFlatVector<StringView>();
-  auto mfgrVector = children[2]->asFlatVector<StringView>();
-  auto brandVector = children[3]->asFlatVector<StringView>();
-  auto typeVector = children[4]->asFlatVector<StringView>();
-  auto sizeVector = children[5]->asFlatVector<int32_t>();
-  auto containerVector = children[6]->asFlatVector<StringView>();
-  auto retailPriceVector = children[7]->asFlatVector<double>();
-  auto commentVector = children[8]->asFlatVector<StringView>();
+  auto children = allocateVectors(partRowType, vectorSize, columns, pool);
+
+  auto* partKeyVector = asFlatVector<int64_t>(children[0]);
+  auto* nameVector = asFlatVector<StringView>(children[1]);
+  auto* mfgrVector = asFlatVector<StringView>(children[2]);
+  auto* brandVector = asFlatVector<StringView>(children[3]);
+  auto* typeVector = asFlatVector<StringView>(children[4]);
+  auto* sizeVector = asFlatVector<int32_t>(children[5]);
+  auto* containerVector = asFlatVector<StringView>(children[6]);
+  auto* retailPriceVector = asFlatVector<double>(children[7]);
+  auto* commentVector = asFlatVector<StringView>(children[8]);
 
   DBGenIterator dbgenIt(scaleFactor);
   dbgenIt.initPart(offset);
@@ -518,38 +612,58 @@ RowVectorPtr genTpchPart(
   for (size_t i = 0; i < vectorSize; ++i) {
     dbgenIt.genPart(i + offset + 1, part);
 
-    partKeyVector->set(i, part.partkey);
-    nameVector->set(i, StringView(part.name, strlen(part.name)));
-    mfgrVector->set(i, StringView(part.mfgr, strlen(part.mfgr)));
-    brandVector->set(i, StringView(part.brand, strlen(part.brand)));
-    typeVector->set(i, StringView(part.type, part.tlen));
-    sizeVector->set(i, part.size);
-    containerVector->set(i, StringView(part.container, strlen(part.container)));
-    retailPriceVector->set(i, decimalToDouble(part.retailprice));
-    commentVector->set(i, StringView(part.comment, part.clen));
+    if (partKeyVector) {
+      partKeyVector->set(i, part.partkey);
+    }
+    if (nameVector) {
+      nameVector->set(i, StringView(part.name, strlen(part.name)));
+    }
+    if (mfgrVector) {
+      mfgrVector->set(i, StringView(part.mfgr, strlen(part.mfgr)));
+    }
+    if (brandVector) {
+      brandVector->set(i, StringView(part.brand, strlen(part.brand)));
+    }
+    if (typeVector) {
+      typeVector->set(i, StringView(part.type, part.tlen));
+    }
+    if (sizeVector) {
+      sizeVector->set(i, part.size);
+    }
+    if (containerVector) {
+      containerVector->set(
+          i, StringView(part.container, strlen(part.container)));
+    }
+    if (retailPriceVector) {
+      retailPriceVector->set(i, decimalToDouble(part.retailprice));
+    }
+    if (commentVector) {
+      commentVector->set(i, StringView(part.comment, part.clen));
+    }
   }
-  return std::make_shared<RowVector>(
-      pool, partRowType, BufferPtr(nullptr), vectorSize, std::move(children));
+  return makeRowVector(
+      partRowType, vectorSize, std::move(children), columns, pool);
 }
 
 RowVectorPtr genTpchSupplier(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    const std::vector<column_index_t>& columns) {
   // Create schema and allocate vectors.
   auto supplierRowType = getTableSchema(Table::TBL_SUPPLIER);
   size_t vectorSize = getVectorSize(
       getRowCount(Table::TBL_SUPPLIER, scaleFactor), maxRows, offset);
-  auto children = allocateVectors(supplierRowType, vectorSize, pool);
+  auto children = allocateVectors(supplierRowType, vectorSize, columns, pool);
 
-  auto suppKeyVector = children[0]->asFlatVector<int64_t>();
-  auto nameVector = children[1]->asFlatVector<StringView>();
-  auto addressVector = children[2]->asFlatVector<StringView>();
-  auto nationKeyVector = children[3]->asFlatVector<int64_t>();
-  auto phoneVector = children[4]->asFlatVector<StringView>();
-  auto acctbalVector = children[5]->asFlatVector<double>();
-  auto commentVector = children[6]->asFlatVector<StringView>();
+  auto* suppKeyVector = asFlatVector<int64_t>(children[0]);
+  auto* nameVector = asFlatVector<StringView>(children[1]);
+  auto* addressVector = asFlatVector<StringView>(children[2]);
+  auto* nationKeyVector = asFlatVector<int64_t>(children[3]);
+  auto* phoneVector = asFlatVector<StringView>(children[4]);
+  auto* acctbalVector = asFlatVector<double>(children[5]);
+  auto* commentVector = asFlatVector<StringView>(children[6]);
 
   DBGenIterator dbgenIt(scaleFactor);
   dbgenIt.initSupplier(offset);
@@ -560,38 +674,49 @@ RowVectorPtr genTpchSupplier(
   for (size_t i = 0; i < vectorSize; ++i) {
     dbgenIt.genSupplier(i + offset + 1, supp);
 
-    suppKeyVector->set(i, supp.suppkey);
-    nameVector->set(i, StringView(supp.name, strlen(supp.name)));
-    addressVector->set(i, StringView(supp.address, supp.alen));
-    nationKeyVector->set(i, supp.nation_code);
-    phoneVector->set(i, StringView(supp.phone, strlen(supp.phone)));
-    acctbalVector->set(i, decimalToDouble(supp.acctbal));
-    commentVector->set(i, StringView(supp.comment, supp.clen));
+    if (suppKeyVector) {
+      suppKeyVector->set(i, supp.suppkey);
+    }
+    if (nameVector) {
+      nameVector->set(i, StringView(supp.name, strlen(supp.name)));
+    }
+    if (addressVector) {
+      addressVector->set(i, StringView(supp.address, supp.alen));
+    }
+    if (nationKeyVector) {
+      nationKeyVector->set(i, supp.nation_code);
+    }
+    if (phoneVector) {
+      phoneVector->set(i, StringView(supp.phone, strlen(supp.phone)));
+    }
+    if (acctbalVector) {
+      acctbalVector->set(i, decimalToDouble(supp.acctbal));
+    }
+    if (commentVector) {
+      commentVector->set(i, StringView(supp.comment, supp.clen));
+    }
   }
-  return std::make_shared<RowVector>(
-      pool,
-      supplierRowType,
-      BufferPtr(nullptr),
-      vectorSize,
-      std::move(children));
+  return makeRowVector(
+      supplierRowType, vectorSize, std::move(children), columns, pool);
 }
 
 RowVectorPtr genTpchPartSupp(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    const std::vector<column_index_t>& columns) {
   // Create schema and allocate vectors.
   auto partSuppRowType = getTableSchema(Table::TBL_PARTSUPP);
   size_t vectorSize = getVectorSize(
       getRowCount(Table::TBL_PARTSUPP, scaleFactor), maxRows, offset);
-  auto children = allocateVectors(partSuppRowType, vectorSize, pool);
+  auto children = allocateVectors(partSuppRowType, vectorSize, columns, pool);
 
-  auto partKeyVector = children[0]->asFlatVector<int64_t>();
-  auto suppKeyVector = children[1]->asFlatVector<int64_t>();
-  auto availQtyVector = children[2]->asFlatVector<int32_t>();
-  auto supplyCostVector = children[3]->asFlatVector<double>();
-  auto commentVector = children[4]->asFlatVector<StringView>();
+  auto* partKeyVector = asFlatVector<int64_t>(children[0]);
+  auto* suppKeyVector = asFlatVector<int64_t>(children[1]);
+  auto* availQtyVector = asFlatVector<int32_t>(children[2]);
+  auto* supplyCostVector = asFlatVector<double>(children[3]);
+  auto* commentVector = asFlatVector<StringView>(children[4]);
 
   DBGenIterator dbgenIt(scaleFactor);
   part_t part;
@@ -612,12 +737,22 @@ RowVectorPtr genTpchPartSupp(
     while ((partSuppIdx < SUPP_PER_PART) && (partSuppCount < vectorSize)) {
       const auto& partSupp = part.s[partSuppIdx];
 
-      partKeyVector->set(partSuppCount, partSupp.partkey);
-      suppKeyVector->set(partSuppCount, partSupp.suppkey);
-      availQtyVector->set(partSuppCount, partSupp.qty);
-      supplyCostVector->set(partSuppCount, decimalToDouble(partSupp.scost));
-      commentVector->set(
-          partSuppCount, StringView(partSupp.comment, partSupp.clen));
+      if (partKeyVector) {
+        partKeyVector->set(partSuppCount, partSupp.partkey);
+      }
+      if (suppKeyVector) {
+        suppKeyVector->set(partSuppCount, partSupp.suppkey);
+      }
+      if (availQtyVector) {
+        availQtyVector->set(partSuppCount, partSupp.qty);
+      }
+      if (supplyCostVector) {
+        supplyCostVector->set(partSuppCount, decimalToDouble(partSupp.scost));
+      }
+      if (commentVector) {
+        commentVector->set(
+            partSuppCount, StringView(partSupp.comment, partSupp.clen));
+      }
 
       ++partSuppIdx;
       ++partSuppCount;
@@ -628,33 +763,30 @@ RowVectorPtr genTpchPartSupp(
   } while (partSuppCount < vectorSize);
 
   VELOX_CHECK_EQ(partSuppCount, vectorSize);
-  return std::make_shared<RowVector>(
-      pool,
-      partSuppRowType,
-      BufferPtr(nullptr),
-      vectorSize,
-      std::move(children));
+  return makeRowVector(
+      partSuppRowType, vectorSize, std::move(children), columns, pool);
 }
 
 RowVectorPtr genTpchCustomer(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    const std::vector<column_index_t>& columns) {
   // Create schema and allocate vectors.
   auto customerRowType = getTableSchema(Table::TBL_CUSTOMER);
   size_t vectorSize = getVectorSize(
       getRowCount(Table::TBL_CUSTOMER, scaleFactor), maxRows, offset);
-  auto children = allocateVectors(customerRowType, vectorSize, pool);
+  auto children = allocateVectors(customerRowType, vectorSize, columns, pool);
 
-  auto custKeyVector = children[0]->asFlatVector<int64_t>();
-  auto nameVector = children[1]->asFlatVector<StringView>();
-  auto addressVector = children[2]->asFlatVector<StringView>();
-  auto nationKeyVector = children[3]->asFlatVector<int64_t>();
-  auto phoneVector = children[4]->asFlatVector<StringView>();
-  auto acctBalVector = children[5]->asFlatVector<double>();
-  auto mktSegmentVector = children[6]->asFlatVector<StringView>();
-  auto commentVector = children[7]->asFlatVector<StringView>();
+  auto* custKeyVector = asFlatVector<int64_t>(children[0]);
+  auto* nameVector = asFlatVector<StringView>(children[1]);
+  auto* addressVector = asFlatVector<StringView>(children[2]);
+  auto* nationKeyVector = asFlatVector<int64_t>(children[3]);
+  auto* phoneVector = asFlatVector<StringView>(children[4]);
+  auto* acctBalVector = asFlatVector<double>(children[5]);
+  auto* mktSegmentVector = asFlatVector<StringView>(children[6]);
+  auto* commentVector = asFlatVector<StringView>(children[7]);
 
   DBGenIterator dbgenIt(scaleFactor);
   dbgenIt.initCustomer(offset);
@@ -665,39 +797,52 @@ RowVectorPtr genTpchCustomer(
   for (size_t i = 0; i < vectorSize; ++i) {
     dbgenIt.genCustomer(i + offset + 1, cust);
 
-    custKeyVector->set(i, cust.custkey);
-    nameVector->set(i, StringView(cust.name, strlen(cust.name)));
-    addressVector->set(i, StringView(cust.address, cust.alen));
-    nationKeyVector->set(i, cust.nation_code);
-    phoneVector->set(i, StringView(cust.phone, strlen(cust.phone)));
-    acctBalVector->set(i, decimalToDouble(cust.acctbal));
-    mktSegmentVector->set(
-        i, StringView(cust.mktsegment, strlen(cust.mktsegment)));
-    commentVector->set(i, StringView(cust.comment, cust.clen));
+    if (custKeyVector) {
+      custKeyVector->set(i, cust.custkey);
+    }
+    if (nameVector) {
+      nameVector->set(i, StringView(cust.name, strlen(cust.name)));
+    }
+    if (addressVector) {
+      addressVector->set(i, StringView(cust.address, cust.alen));
+    }
+    if (nationKeyVector) {
+      nationKeyVector->set(i, cust.nation_code);
+    }
+    if (phoneVector) {
+      phoneVector->set(i, StringView(cust.phone, strlen(cust.phone)));
+    }
+    if (acctBalVector) {
+      acctBalVector->set(i, decimalToDouble(cust.acctbal));
+    }
+    if (mktSegmentVector) {
+      mktSegmentVector->set(
+          i, StringView(cust.mktsegment, strlen(cust.mktsegment)));
+    }
+    if (commentVector) {
+      commentVector->set(i, StringView(cust.comment, cust.clen));
+    }
   }
-  return std::make_shared<RowVector>(
-      pool,
-      customerRowType,
-      BufferPtr(nullptr),
-      vectorSize,
-      std::move(children));
+  return makeRowVector(
+      customerRowType, vectorSize, std::move(children), columns, pool);
 }
 
 RowVectorPtr genTpchNation(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    const std::vector<column_index_t>& columns) {
   // Create schema and allocate vectors.
   auto nationRowType = getTableSchema(Table::TBL_NATION);
   size_t vectorSize = getVectorSize(
       getRowCount(Table::TBL_NATION, scaleFactor), maxRows, offset);
-  auto children = allocateVectors(nationRowType, vectorSize, pool);
+  auto children = allocateVectors(nationRowType, vectorSize, columns, pool);
 
-  auto nationKeyVector = children[0]->asFlatVector<int64_t>();
-  auto nameVector = children[1]->asFlatVector<StringView>();
-  auto regionKeyVector = children[2]->asFlatVector<int64_t>();
-  auto commentVector = children[3]->asFlatVector<StringView>();
+  auto* nationKeyVector = asFlatVector<int64_t>(children[0]);
+  auto* nameVector = asFlatVector<StringView>(children[1]);
+  auto* regionKeyVector = asFlatVector<int64_t>(children[2]);
+  auto* commentVector = asFlatVector<StringView>(children[3]);
 
   DBGenIterator dbgenIt(scaleFactor);
   dbgenIt.initNation(offset);
@@ -708,29 +853,38 @@ RowVectorPtr genTpchNation(
   for (size_t i = 0; i < vectorSize; ++i) {
     dbgenIt.genNation(i + offset + 1, code);
 
-    nationKeyVector->set(i, code.code);
-    nameVector->set(i, StringView(code.text, strlen(code.text)));
-    regionKeyVector->set(i, code.join);
-    commentVector->set(i, StringView(code.comment, code.clen));
+    if (nationKeyVector) {
+      nationKeyVector->set(i, code.code);
+    }
+    if (nameVector) {
+      nameVector->set(i, StringView(code.text, strlen(code.text)));
+    }
+    if (regionKeyVector) {
+      regionKeyVector->set(i, code.join);
+    }
+    if (commentVector) {
+      commentVector->set(i, StringView(code.comment, code.clen));
+    }
   }
-  return std::make_shared<RowVector>(
-      pool, nationRowType, BufferPtr(nullptr), vectorSize, std::move(children));
+  return makeRowVector(
+      nationRowType, vectorSize, std::move(children), columns, pool);
 }
 
 RowVectorPtr genTpchRegion(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    const std::vector<column_index_t>& columns) {
   // Create schema and allocate vectors.
   auto regionRowType = getTableSchema(Table::TBL_REGION);
   size_t vectorSize = getVectorSize(
       getRowCount(Table::TBL_REGION, scaleFactor), maxRows, offset);
-  auto children = allocateVectors(regionRowType, vectorSize, pool);
+  auto children = allocateVectors(regionRowType, vectorSize, columns, pool);
 
-  auto regionKeyVector = children[0]->asFlatVector<int64_t>();
-  auto nameVector = children[1]->asFlatVector<StringView>();
-  auto commentVector = children[2]->asFlatVector<StringView>();
+  auto* regionKeyVector = asFlatVector<int64_t>(children[0]);
+  auto* nameVector = asFlatVector<StringView>(children[1]);
+  auto* commentVector = asFlatVector<StringView>(children[2]);
 
   DBGenIterator dbgenIt(scaleFactor);
   dbgenIt.initRegion(offset);
@@ -741,12 +895,18 @@ RowVectorPtr genTpchRegion(
   for (size_t i = 0; i < vectorSize; ++i) {
     dbgenIt.genRegion(i + offset + 1, code);
 
-    regionKeyVector->set(i, code.code);
-    nameVector->set(i, StringView(code.text, strlen(code.text)));
-    commentVector->set(i, StringView(code.comment, code.clen));
+    if (regionKeyVector) {
+      regionKeyVector->set(i, code.code);
+    }
+    if (nameVector) {
+      nameVector->set(i, StringView(code.text, strlen(code.text)));
+    }
+    if (commentVector) {
+      commentVector->set(i, StringView(code.comment, code.clen));
+    }
   }
-  return std::make_shared<RowVector>(
-      pool, regionRowType, BufferPtr(nullptr), vectorSize, std::move(children));
+  return makeRowVector(
+      regionRowType, vectorSize, std::move(children), columns, pool);
 }
 
 std::string getQuery(int query) {
@@ -33,7 +33,11 @@ namespace facebook::velox::tpch {
 /// If not enough records are available given a particular scale factor and
 /// offset, less than maxRows records might be returned.
 ///
-/// Data is always returned in a RowVector.
+/// Data is always returned in a RowVector. The generation functions take an
+/// optional list of `columns`, the indices in the table schema of the columns
+/// to return, in that order. Dbgen still makes whole records, but only the
+/// values of these columns are copied into vectors. All columns are returned
+/// if `columns` is empty.
 
 enum class Table : uint8_t {
   TBL_PART,
@@ -93,7 +97,8 @@ RowVectorPtr genTpchOrders(
     memory::MemoryPool* pool,
     size_t maxRows = 10000,
     size_t offset = 0,
-    double scaleFactor = 1);
+    double scaleFactor = 1,
+    const std::vector<column_index_t>& columns = {});
 
 /// NOTE: This function's parameters have different semantic from the function
 /// above. Dbgen does not provide deterministic random access to lineitem
@@ -131,7 +136,8 @@ RowVectorPtr genTpchLineItem(
     memory::MemoryPool* pool,
     size_t maxOrdersRows = 10000,
     size_t ordersOffset = 0,
-    double scaleFactor = 1);
+    double scaleFactor = 1,
+    const std::vector<column_index_t>& columns = {});
 
 /// Returns a row vector containing at most `maxRows` rows of the "part"
 /// table, starting at `offset`, and given the scale factor. The row vector
@@ -151,7 +157,8 @@ RowVectorPtr genTpchPart(
     memory::MemoryPool* pool,
     size_t maxRows = 10000,
     size_t offset = 0,
-    double scaleFactor = 1);
+    double scaleFactor = 1,
+    const std::vector<column_index_t>& columns = {});
 
 /// Returns a row vector containing at most `maxRows` rows of the "supplier"
 /// table, starting at `offset`, and given the scale factor. The row vector
@@ -169,7 +176,8 @@ RowVectorPtr genTpchSupplier(
     memory::MemoryPool* pool,
     size_t maxRows = 10000,
     size_t offset = 0,
-    double scaleFactor = 1);
+    double scaleFactor = 1,
+    const std::vector<column_index_t>& columns = {});
 
 /// Returns a row vector containing at most `maxRows` rows of the "partsupp"
 /// table, starting at `offset`, and given the scale factor. The row vector
@@ -185,7 +193,8 @@ RowVectorPtr genTpchPartSupp(
     memory::MemoryPool* pool,
     size_t maxRows = 10000,
     size_t offset = 0,
-    double scaleFactor = 1);
+    double scaleFactor = 1,
+    const std::vector<column_index_t>& columns = {});
 
 /// Returns a row vector containing at most `maxRows` rows of the "customer"
 /// table, starting at `offset`, and given the scale factor. The row vector
@@ -204,7 +213,8 @@ RowVectorPtr genTpchCustomer(
     memory::MemoryPool* pool,
     size_t maxRows = 10000,
     size_t offset = 0,
-    double scaleFactor = 1);
+    double scaleFactor = 1,
+    const std::vector<column_index_t>& columns = {});
 
 /// Returns a row vector containing at most `maxRows` rows of the "nation"
 /// table, starting at `offset`, and given the scale factor. The row vector
@@ -219,7 +229,8 @@ RowVectorPtr genTpchNation(
     memory::MemoryPool* pool,
     size_t maxRows = 10000,
     size_t offset = 0,
-    double scaleFactor = 1);
+    double scaleFactor = 1,
+    const std::vector<column_index_t>& columns = {});
 
 /// Returns a row vector containing at most `maxRows` rows of the "region"
 /// table, starting at `offset`, and given the scale factor. The row vector
@@ -233,7 +244,8 @@ RowVectorPtr genTpchRegion(
     memory::MemoryPool* pool,
     size_t maxRows = 10000,
     size_t offset = 0,
-    double scaleFactor = 1);
+    double scaleFactor = 1,
+    const std::vector<column_index_t>& columns = {});
 
 /// Gets the specified TPC-H query number as a string.
 std::string getQuery(int query);
@@ -424,6 +424,24 @@ TEST_F(TpchGenTestLineItemTest, reproducible) {
   }
 }
 
+TEST_F(TpchGenTestLineItemTest, columns) {
+  auto all = genTpchLineItem(pool_.get(), 100, 200);
+  // l_shipdate, l_orderkey and l_comment, in this order.
+  auto some = genTpchLineItem(pool_.get(), 100, 200, 1, {10, 0, 15});
+
+  ASSERT_EQ(3, some->childrenSize());
+  ASSERT_EQ(all->size(), some->size());
+  const auto& type = some->type()->asRow();
+  EXPECT_EQ("l_shipdate", type.nameOf(0));
+  EXPECT_EQ("l_orderkey", type.nameOf(1));
+  EXPECT_EQ("l_comment", type.nameOf(2));
+  for (auto i = 0; i < all->size(); ++i) {
+    ASSERT_TRUE(some->childAt(0)->equalValueAt(all->childAt(10).get(), i, i));
+    ASSERT_TRUE(some->childAt(1)->equalValueAt(all->childAt(0).get(), i, i));
+    ASSERT_TRUE(some->childAt(2)->equalValueAt(all->childAt(15).get(), i, i));
+  }
+}
+
 // Supplier.
 class TpchGenTestSupplierTest : public testing::Test {
  protected:
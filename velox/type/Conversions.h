@@ -17,8 +17,13 @@
 #pragma once
 
 #include <folly/Conv.h>
+#include <folly/lang/Bits.h>
 #include <cctype>
+#include <cstring>
+#include <limits>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include "velox/common/base/Exceptions.h"
 #include "velox/type/TimestampConversion.h"
@@ -48,6 +53,189 @@ struct TruncateLegacyCastPolicy {
   static constexpr bool legacyCast = true;
 };
 
+namespace detail {
+// Returns true if the 8 bytes at 'data' are ASCII digits. Checks all bytes at
+// once in a 64 bit word.
+inline bool isEightDigits(const char* data) {
+  uint64_t word;
+  std::memcpy(&word, data, sizeof(word));
+  return ((word & 0xF0F0F0F0F0F0F0F0ULL) |
+          (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+      0x3333333333333333ULL;
+}
+
+// Returns the value of the 8 ASCII digits at 'data'. Combines pairs, then
+// quads of digits with multiplications instead of one digit at a time.
+inline uint32_t parseEightDigits(const char* data) {
+  constexpr uint64_t kMask = 0x000000FF000000FFULL;
+  constexpr uint64_t kMul1 = 100 + (1000000ULL << 32);
+  constexpr uint64_t kMul2 = 1 + (10000ULL << 32);
+  uint64_t word;
+  std::memcpy(&word, data, sizeof(word));
+  if constexpr (folly::kIsBigEndian) {
+    word = folly::Endian::swap(word);
+  }
+  word -= 0x3030303030303030ULL;
+  word = (word * 10) + (word >> 8);
+  word = (((word & kMask) * kMul1) + (((word >> 16) & kMask) * kMul2)) >> 32;
+  return static_cast<uint32_t>(word);
+}
+
+// Adds the digits at the start of [begin, end) to 'value', up to 'maxDigits'
+// digits in total. Returns the position after the last digit added.
+inline const char* parseDigits(
+    const char* begin,
+    const char* end,
+    uint64_t& value,
+    int32_t& numDigits,
+    int32_t maxDigits) {
+  while (end - begin >= 8 && numDigits + 8 <= maxDigits &&
+         isEightDigits(begin)) {
+    value = value * 100'000'000 + parseEightDigits(begin);
+    begin += 8;
+    numDigits += 8;
+  }
+  while (begin < end && numDigits < maxDigits && *begin >= '0' &&
+         *begin <= '9') {
+    value = value * 10 + (*begin - '0');
+    ++begin;
+    ++numDigits;
+  }
+  return begin;
+}
+
+inline bool isSpace(char c) {
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+} // namespace detail
+
+/// Parses 'str' into an integer of type T without exceptions if it is an
+/// optional '-' followed by at most 18 digits. Returns std::nullopt for any
+/// other string, including valid ones, which the caller then converts the
+/// usual way.
+template <typename T>
+std::optional<T> tryParseIntegerFast(std::string_view str) {
+  static_assert(std::is_integral_v<T> && sizeof(T) <= sizeof(int64_t));
+  const char* begin = str.data();
+  const char* end = begin + str.size();
+  const bool negative = begin < end && *begin == '-';
+  if (negative) {
+    ++begin;
+  }
+  uint64_t value = 0;
+  int32_t numDigits = 0;
+  if (detail::parseDigits(begin, end, value, numDigits, 18) != end ||
+      numDigits == 0) {
+    return std::nullopt;
+  }
+  const int64_t signedValue = negative ? -static_cast<int64_t>(value)
+                                       : static_cast<int64_t>(value);
+  if (signedValue < std::numeric_limits<T>::min() ||
+      signedValue > std::numeric_limits<T>::max()) {
+    return std::nullopt;
+  }
+  return static_cast<T>(signedValue);
+}
+
+/// Parses 'str' into a float or double without exceptions if it is an optional
+/// '-', digits, optionally a '.' followed by digits and optionally an exponent,
+/// and if the digits and the exponent are small enough that the value is
+/// exactly one multiplication or division of two exactly representable
+/// numbers, which rounds correctly. Returns std::nullopt for any other string,
+/// including valid ones, which the caller then converts the usual way.
+template <typename T>
+std::optional<T> tryParseFloatingPointFast(std::string_view str) {
+  static_assert(std::is_floating_point_v<T>);
+  // Powers of ten and integers up to these are exact in T.
+  constexpr int32_t kMaxExponent = std::is_same_v<T, float> ? 10 : 22;
+  constexpr uint64_t kMaxMantissa = 1ULL << std::numeric_limits<T>::digits;
+  static constexpr double kPowersOfTen[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+  const char* begin = str.data();
+  const char* end = begin + str.size();
+  const bool negative = begin < end && *begin == '-';
+  if (negative) {
+    ++begin;
+  }
+  uint64_t mantissa = 0;
+  int32_t numDigits = 0;
+  begin = detail::parseDigits(begin, end, mantissa, numDigits, 19);
+  if (numDigits == 0) {
+    return std::nullopt;
+  }
+  int32_t exponent = 0;
+  if (begin < end && *begin == '.') {
+    const auto numIntegerDigits = numDigits;
+    begin = detail::parseDigits(begin + 1, end, mantissa, numDigits, 19);
+    if (numDigits == numIntegerDigits) {
+      return std::nullopt;
+    }
+    exponent = numIntegerDigits - numDigits;
+  }
+  if (begin < end && (*begin == 'e' || *begin == 'E')) {
+    ++begin;
+    const bool negativeExponent = begin < end && *begin == '-';
+    if (negativeExponent || (begin < end && *begin == '+')) {
+      ++begin;
+    }
+    uint64_t explicitExponent = 0;
+    int32_t numExponentDigits = 0;
+    begin = detail::parseDigits(
+        begin, end, explicitExponent, numExponentDigits, 4);
+    if (numExponentDigits == 0) {
+      return std::nullopt;
+    }
+    exponent += negativeExponent ? -static_cast<int32_t>(explicitExponent)
+                                 : static_cast<int32_t>(explicitExponent);
+  }
+  if (begin != end || mantissa > kMaxMantissa || exponent < -kMaxExponent ||
+      exponent > kMaxExponent) {
+    return std::nullopt;
+  }
+  T value = static_cast<T>(mantissa);
+  const auto power = static_cast<T>(kPowersOfTen[std::abs(exponent)]);
+  value = exponent < 0 ? value / power : value * power;
+  return negative ? -value : value;
+}
+
+/// Returns true if 'str' has a character that no string that converts to an
+/// integer, or to a floating point number if 'isFloatingPoint', may have. Lets
+/// callers report errors without converting 'str' the usual way.
+template <bool isFloatingPoint>
+bool isInvalidNumber(std::string_view str) {
+  bool hasLetter = false;
+  for (const auto c : str) {
+    if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' ||
+        detail::isSpace(c)) {
+      continue;
+    }
+    if (!isFloatingPoint) {
+      return true;
+    }
+    if (c == 'e' || c == 'E') {
+      continue;
+    }
+    if (!std::isalpha(static_cast<unsigned char>(c))) {
+      return true;
+    }
+    hasLetter = true;
+  }
+  if (!hasLetter) {
+    return false;
+  }
+  // Letters other than the exponent are valid only in the names of infinity
+  // and NaN.
+  std::string name;
+  for (const auto c : str) {
+    if (!detail::isSpace(c) && c != '-' && c != '+') {
+      name += std::tolower(static_cast<unsigned char>(c));
+    }
+  }
+  return name != "inf" && name != "infinity" && name != "nan";
+}
+
 template <TypeKind KIND, typename = void, typename TPolicy = DefaultCastPolicy>
 struct Converter {
   template <typename T>
@@ -21,6 +21,7 @@
 #include <string>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/encode/Base64.h"
 #include "velox/type/Filter.h"
 
 namespace facebook::velox::common {
@@ -94,6 +95,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBloomFilter:
+      strKind = "BloomFilter";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +135,7 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBloomFilter, "kBloomFilter"},
   };
 }
 
@@ -199,6 +204,7 @@ void Filter::registerSerDe() {
   registry.Register("NegatedBytesValues", NegatedBytesValues::create);
   registry.Register("MultiRange", MultiRange::create);
   registry.Register("TimestampRange", TimestampRange::create);
+  registry.Register("BloomFilterValues", BloomFilterValues::create);
 }
 
 folly::dynamic Filter::serializeBase(std::string_view name) const {
@@ -710,6 +716,59 @@ bool NegatedBytesValues::testingEquals(const Filter& other) const {
       nonNegated_->testingEquals((*(otherNegatedBytesValues->nonNegated_)));
 }
 
+folly::dynamic BloomFilterValues::serialize() const {
+  auto obj = Filter::serializeBase("BloomFilterValues");
+  std::string bits(bloomFilter_->serializedSize(), '\0');
+  bloomFilter_->serialize(bits.data());
+  obj["bloomFilter"] = encoding::Base64::encode(bits.data(), bits.size());
+  obj["min"] = min_;
+  obj["max"] = max_;
+  if (conjunct_) {
+    obj["conjunct"] = conjunct_->serialize();
+  }
+  return obj;
+}
+
+FilterPtr BloomFilterValues::create(const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  const auto bits = encoding::Base64::decode(obj["bloomFilter"].asString());
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->merge(bits.data());
+  std::unique_ptr<Filter> conjunct;
+  if (obj.count("conjunct")) {
+    conjunct = ISerializable::deserialize<Filter>(obj["conjunct"])->clone();
+  }
+  return std::make_unique<BloomFilterValues>(
+      std::move(bloomFilter),
+      nullAllowed,
+      obj["min"].asInt(),
+      obj["max"].asInt(),
+      std::move(conjunct));
+}
+
+bool BloomFilterValues::testingEquals(const Filter& other) const {
+  auto otherBloomFilter = dynamic_cast<const BloomFilterValues*>(&other);
+  if (otherBloomFilter == nullptr || !Filter::testingBaseEquals(other) ||
+      min_ != otherBloomFilter->min_ || max_ != otherBloomFilter->max_) {
+    return false;
+  }
+  if ((conjunct_ == nullptr) != (otherBloomFilter->conjunct_ == nullptr)) {
+    return false;
+  }
+  if (conjunct_ && !conjunct_->testingEquals(*otherBloomFilter->conjunct_)) {
+    return false;
+  }
+  const auto size = bloomFilter_->serializedSize();
+  if (size != otherBloomFilter->bloomFilter_->serializedSize()) {
+    return false;
+  }
+  std::string bits(size, '\0');
+  std::string otherBits(size, '\0');
+  bloomFilter_->serialize(bits.data());
+  otherBloomFilter->bloomFilter_->serialize(otherBits.data());
+  return bits == otherBits;
+}
+
 folly::dynamic MultiRange::serialize() const {
   auto obj = Filter::serializeBase("MultiRange");
   obj["nanAllowed"] = nanAllowed_;
@@ -1275,6 +1334,66 @@ bool BytesRange::testBytesRange(
   // clang-format on
 }
 
+BytesValues::BytesValues(
+    const std::vector<std::string>& values,
+    bool nullAllowed)
+    : Filter(true, nullAllowed, FilterKind::kBytesValues) {
+  VELOX_CHECK(!values.empty(), "values must not be empty");
+
+  for (const auto& value : values) {
+    lengths_.insert(value.size());
+    values_.insert(value);
+  }
+
+  lower_ = *std::min_element(values_.begin(), values_.end());
+  upper_ = *std::max_element(values_.begin(), values_.end());
+
+  for (auto length : lengths_) {
+    if (length < 64) {
+      bits::setBit(&lengthMask_, length);
+    }
+  }
+
+  const auto size = bits::nextPowerOfTwo(values_.size() * 2);
+  hashTable_.resize(size, Slot{kEmptyLength, 0, 0});
+  sizeMask_ = size - 1;
+  for (const auto& value : values_) {
+    const Slot slot{
+        static_cast<uint32_t>(value.size()),
+        static_cast<uint32_t>(bytes_.size()),
+        loadPrefix(value.data(), value.size())};
+    bytes_.append(value);
+    auto index = bits::hashBytes(0, value.data(), value.size()) & sizeMask_;
+    while (hashTable_[index].length != kEmptyLength) {
+      index = (index + 1) & sizeMask_;
+    }
+    hashTable_[index] = slot;
+  }
+}
+
+bool BytesValues::testBytes(const char* value, int32_t length) const {
+  if (!testLength(length)) {
+    return false;
+  }
+  const auto prefix = loadPrefix(value, length);
+  for (auto index = bits::hashBytes(0, value, length) & sizeMask_;;
+       index = (index + 1) & sizeMask_) {
+    const auto& slot = hashTable_[index];
+    if (slot.length == kEmptyLength) {
+      return false;
+    }
+    if (slot.length == static_cast<uint32_t>(length) &&
+        slot.prefix == prefix &&
+        (length <= kPrefixSize ||
+         std::memcmp(
+             bytes_.data() + slot.offset + kPrefixSize,
+             value + kPrefixSize,
+             length - kPrefixSize) == 0)) {
+      return true;
+    }
+  }
+}
+
 bool BytesValues::testBytesRange(
     std::optional<std::string_view> min,
     std::optional<std::string_view> max,
@@ -1541,6 +1660,7 @@ std::unique_ptr<Filter> MultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
     case FilterKind::kNegatedBytesRange:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
@@ -1623,6 +1743,94 @@ std::unique_ptr<Filter> MultiRange::mergeWith(const Filter* other) const {
   }
 }
 
+bool BloomFilterValues::testInt64(int64_t value) const {
+  if (value < min_ || value > max_ ||
+      !bloomFilter_->mayContain(hashInt64(value))) {
+    return recordRowTest(false);
+  }
+  return recordRowTest(!conjunct_ || conjunct_->testInt64(value));
+}
+
+bool BloomFilterValues::testBytes(const char* value, int32_t length) const {
+  if (!bloomFilter_->mayContain(hashBytes(value, length))) {
+    return recordRowTest(false);
+  }
+  return recordRowTest(!conjunct_ || conjunct_->testBytes(value, length));
+}
+
+bool BloomFilterValues::testInt64Range(int64_t min, int64_t max, bool hasNull)
+    const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+  bool passed = min <= max_ && max >= min_;
+  // A range of a single value can be decided by the Bloom filter.
+  if (passed && min == max) {
+    passed = bloomFilter_->mayContain(hashInt64(min));
+  }
+  if (passed && conjunct_) {
+    passed = conjunct_->testInt64Range(min, max, hasNull);
+  }
+  return recordRangeTest(passed);
+}
+
+bool BloomFilterValues::testBytesRange(
+    std::optional<std::string_view> min,
+    std::optional<std::string_view> max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+  bool passed = true;
+  if (min.has_value() && max.has_value() && min.value() == max.value()) {
+    passed = bloomFilter_->mayContain(
+        hashBytes(min.value().data(), min.value().size()));
+  }
+  if (passed && conjunct_) {
+    passed = conjunct_->testBytesRange(min, max, hasNull);
+  }
+  return recordRangeTest(passed);
+}
+
+std::unique_ptr<Filter> BloomFilterValues::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return this->clone(false);
+    case FilterKind::kBigintRange: {
+      // Narrow the range instead of adding a conjunct.
+      auto otherRange = static_cast<const BigintRange*>(other);
+      const bool bothNullAllowed = nullAllowed_ && other->testNull();
+      const auto min = std::max(min_, otherRange->lower());
+      const auto max = std::min(max_, otherRange->upper());
+      if (min > max) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BloomFilterValues>(
+          bloomFilter_,
+          bothNullAllowed,
+          min,
+          max,
+          conjunct_ ? conjunct_->clone() : nullptr,
+          stats_);
+    }
+    default: {
+      const bool bothNullAllowed = nullAllowed_ && other->testNull();
+      return std::make_unique<BloomFilterValues>(
+          bloomFilter_,
+          bothNullAllowed,
+          min_,
+          max_,
+          conjunct_ ? conjunct_->mergeWith(other) : other->clone(),
+          stats_);
+    }
+  }
+}
+
 std::unique_ptr<Filter> IsNull::mergeWith(const Filter* other) const {
   VELOX_CHECK(other->isDeterministic());
 
@@ -1651,6 +1859,7 @@ std::unique_ptr<Filter> BoolValue::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BoolValue>(value_, false);
@@ -1820,6 +2029,7 @@ std::unique_ptr<Filter> BigintRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintRange>(lower_, upper_, false);
@@ -1887,6 +2097,7 @@ std::unique_ptr<Filter> TimestampRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -1914,6 +2125,7 @@ std::unique_ptr<Filter> NegatedBigintRange::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2007,6 +2219,7 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintValuesUsingHashTable>(*this, false);
@@ -2098,6 +2311,7 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintValuesUsingBitmask>(*this, false);
@@ -2181,6 +2395,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<NegatedBigintValuesUsingHashTable>(*this, false);
@@ -2220,6 +2435,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<NegatedBigintValuesUsingBitmask>(*this, false);
@@ -2255,6 +2471,7 @@ std::unique_ptr<Filter> BigintMultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull: {
       std::vector<std::unique_ptr<BigintRange>> ranges;
@@ -2336,6 +2553,7 @@ std::unique_ptr<Filter> BytesRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2415,6 +2633,7 @@ std::unique_ptr<Filter> NegatedBytesRange::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2437,6 +2656,7 @@ std::unique_ptr<Filter> BytesValues::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
     case FilterKind::kMultiRange:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
@@ -2549,6 +2769,7 @@ std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
     case FilterKind::kBytesValues:
     case FilterKind::kNegatedBytesRange:
     case FilterKind::kMultiRange:
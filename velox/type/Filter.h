@@ -16,7 +16,10 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -25,6 +28,7 @@
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -56,6 +60,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBloomFilter,
 };
 
 class Filter;
@@ -1847,25 +1852,18 @@ class BytesValues final : public Filter {
   /// @param values List of values that pass the filter. Must contain at least
   /// one entry.
   /// @param nullAllowed Null values are passing the filter if true.
-  BytesValues(const std::vector<std::string>& values, bool nullAllowed)
-      : Filter(true, nullAllowed, FilterKind::kBytesValues) {
-    VELOX_CHECK(!values.empty(), "values must not be empty");
-
-    for (const auto& value : values) {
-      lengths_.insert(value.size());
-      values_.insert(value);
-    }
-
-    lower_ = *std::min_element(values_.begin(), values_.end());
-    upper_ = *std::max_element(values_.begin(), values_.end());
-  }
+  BytesValues(const std::vector<std::string>& values, bool nullAllowed);
 
   BytesValues(const BytesValues& other, bool nullAllowed)
       : Filter(true, nullAllowed, FilterKind::kBytesValues),
         lower_(other.lower_),
         upper_(other.upper_),
         values_(other.values_),
-        lengths_(other.lengths_) {}
+        lengths_(other.lengths_),
+        lengthMask_(other.lengthMask_),
+        bytes_(other.bytes_),
+        hashTable_(other.hashTable_),
+        sizeMask_(other.sizeMask_) {}
 
   folly::dynamic serialize() const override;
 
@@ -1881,13 +1879,13 @@ class BytesValues final : public Filter {
   }
 
   bool testLength(int32_t length) const final {
+    if (length < 64) {
+      return bits::isBitSet(&lengthMask_, length);
+    }
     return lengths_.contains(length);
   }
 
-  bool testBytes(const char* value, int32_t length) const final {
-    return lengths_.contains(length) &&
-        values_.contains(std::string(value, length));
-  }
+  bool testBytes(const char* value, int32_t length) const final;
 
   bool testBytesRange(
       std::optional<std::string_view> min,
@@ -1903,10 +1901,41 @@ class BytesValues final : public Filter {
   bool testingEquals(const Filter& other) const final;
 
  private:
+  // Slot of 'hashTable_'. 'prefix' has the first 8 bytes of the value, padded
+  // with zeros if the value is shorter, so that values of up to 8 bytes are
+  // compared with two integer comparisons.
+  struct Slot {
+    uint32_t length;
+    // Offset of the value in 'bytes_'.
+    uint32_t offset;
+    uint64_t prefix;
+  };
+
+  static constexpr uint32_t kEmptyLength = std::numeric_limits<uint32_t>::max();
+  static constexpr int32_t kPrefixSize = sizeof(uint64_t);
+
+  static uint64_t loadPrefix(const char* value, int32_t length) {
+    uint64_t prefix = 0;
+    std::memcpy(&prefix, value, std::min(length, kPrefixSize));
+    return prefix;
+  }
+
   std::string lower_;
   std::string upper_;
   folly::F14FastSet<std::string> values_;
   folly::F14FastSet<uint32_t> lengths_;
+
+  // Bit 'i' is set if there is a value of length 'i' for lengths below 64.
+  uint64_t lengthMask_{0};
+
+  // The values back to back.
+  std::string bytes_;
+
+  // Open addressing hash table of the values with linear probing. At least
+  // half of the slots are empty, so that a value that does not pass mostly
+  // hits an empty slot on the first probe.
+  std::vector<Slot> hashTable_;
+  uint32_t sizeMask_;
 };
 
 /// Represents a combination of two of more range filters on integral types with
@@ -2071,6 +2100,175 @@ class MultiRange final : public Filter {
   const bool nanAllowed_;
 };
 
+/// IN-list filter backed by a Bloom filter of value hashes. Used for values
+/// that are too many to enumerate, e.g. the keys of a large hash join build
+/// side pushed down into the probe side scan. Has false positives but never
+/// rejects a value that was inserted. Supports integral types, which are
+/// also checked against [min, max] so that row groups and stripes can be
+/// pruned, and strings. Merging with a filter of another kind keeps the other
+/// filter as a conjunct that is tested after the Bloom filter.
+class BloomFilterValues final : public Filter {
+ public:
+  /// Counts of tested and rejected values and ranges. Shared between the
+  /// copies of a filter made by clone() and mergeWith(). Row counts are
+  /// accumulated locally and published every kStatsFlushInterval tests and on
+  /// destruction, so the published values may lag behind.
+  struct Stats {
+    std::atomic<uint64_t> numRowsTested{0};
+    std::atomic<uint64_t> numRowsRejected{0};
+    std::atomic<uint64_t> numRangesTested{0};
+    std::atomic<uint64_t> numRangesRejected{0};
+  };
+
+  /// @param bloomFilter Bloom filter populated with hashInt64() or
+  /// hashBytes() of the values that pass.
+  /// @param nullAllowed Null values are passing the filter if true.
+  /// @param min Minimum integral value. Ignored for strings.
+  /// @param max Maximum integral value. Ignored for strings.
+  BloomFilterValues(
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed,
+      int64_t min = std::numeric_limits<int64_t>::min(),
+      int64_t max = std::numeric_limits<int64_t>::max(),
+      std::unique_ptr<Filter> conjunct = nullptr,
+      std::shared_ptr<Stats> stats = nullptr)
+      : Filter(true, nullAllowed, FilterKind::kBloomFilter),
+        bloomFilter_(std::move(bloomFilter)),
+        min_(min),
+        max_(max),
+        conjunct_(std::move(conjunct)),
+        stats_(stats ? std::move(stats) : std::make_shared<Stats>()) {
+    VELOX_CHECK_NOT_NULL(bloomFilter_);
+    VELOX_CHECK_LE(min_, max_);
+  }
+
+  BloomFilterValues(const BloomFilterValues& other, bool nullAllowed)
+      : BloomFilterValues(
+            other.bloomFilter_,
+            nullAllowed,
+            other.min_,
+            other.max_,
+            other.conjunct_ ? other.conjunct_->clone() : nullptr,
+            other.stats_) {}
+
+  BloomFilterValues(const BloomFilterValues& other)
+      : BloomFilterValues(other, other.nullAllowed_) {}
+
+  ~BloomFilterValues() override {
+    flushStats();
+  }
+
+  /// Hash functions to use for populating the Bloom filter.
+  static uint64_t hashInt64(int64_t value) {
+    return bits::hashMix(kHashSeed, value);
+  }
+
+  static uint64_t hashBytes(const char* value, int32_t length) {
+    return bits::hashBytes(kHashSeed, value, length);
+  }
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    if (nullAllowed) {
+      return std::make_unique<BloomFilterValues>(*this, nullAllowed.value());
+    } else {
+      return std::make_unique<BloomFilterValues>(*this);
+    }
+  }
+
+  bool testInt64(int64_t value) const final;
+
+  bool testBytes(const char* value, int32_t length) const final;
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  bool testBytesRange(
+      std::optional<std::string_view> min,
+      std::optional<std::string_view> max,
+      bool hasNull) const final;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  const std::shared_ptr<const BloomFilter<>>& bloomFilter() const {
+    return bloomFilter_;
+  }
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  const std::shared_ptr<Stats>& stats() const {
+    return stats_;
+  }
+
+  std::string toString() const final {
+    return fmt::format(
+        "BloomFilterValues: [{}, {}] {}{}",
+        min_,
+        max_,
+        nullAllowed_ ? "with nulls" : "no nulls",
+        conjunct_ ? fmt::format(" AND {}", conjunct_->toString()) : "");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  static constexpr uint64_t kHashSeed = 0x9e3779b97f4a7c15ULL;
+  static constexpr int32_t kStatsFlushInterval = 1024;
+
+  // Records the outcome of a single value test and returns 'passed'.
+  bool recordRowTest(bool passed) const {
+    ++pendingRowsTested_;
+    if (!passed) {
+      ++pendingRowsRejected_;
+    }
+    if (pendingRowsTested_ >= kStatsFlushInterval) {
+      flushStats();
+    }
+    return passed;
+  }
+
+  bool recordRangeTest(bool passed) const {
+    stats_->numRangesTested.fetch_add(1, std::memory_order_relaxed);
+    if (!passed) {
+      stats_->numRangesRejected.fetch_add(1, std::memory_order_relaxed);
+    }
+    return passed;
+  }
+
+  void flushStats() const {
+    if (pendingRowsTested_ == 0) {
+      return;
+    }
+    stats_->numRowsTested.fetch_add(
+        pendingRowsTested_, std::memory_order_relaxed);
+    stats_->numRowsRejected.fetch_add(
+        pendingRowsRejected_, std::memory_order_relaxed);
+    pendingRowsTested_ = 0;
+    pendingRowsRejected_ = 0;
+  }
+
+  const std::shared_ptr<const BloomFilter<>> bloomFilter_;
+  const int64_t min_;
+  const int64_t max_;
+  // Filter ANDed with the Bloom filter test. Set when merging with a filter
+  // that is not a Bloom filter.
+  const std::unique_ptr<Filter> conjunct_;
+  const std::shared_ptr<Stats> stats_;
+  // Row test counts not yet added to 'stats_'. A copy of the filter is used
+  // by a single reader at a time, so these are not atomic.
+  mutable uint32_t pendingRowsTested_{0};
+  mutable uint32_t pendingRowsRejected_{0};
+};
+
 // Helper for applying filters to different types
 template <typename TFilter, typename T>
 static inline bool applyFilter(TFilter& filter, T value) {
@@ -19,6 +19,7 @@
 #include "velox/common/base/CountBits.h"
 #include "velox/external/date/tz.h"
 #include "velox/type/tz/TimeZoneMap.h"
+#include "velox/type/tz/TimeZoneOffsetCache.h"
 
 namespace facebook::velox {
 namespace {
@@ -58,6 +59,12 @@ void Timestamp::toGMT(const date::time_zone& zone) {
       kMaxSeconds,
       "Timestamp seconds out of range for time zone adjustment");
 
+  if (auto utcSeconds =
+          util::TimeZoneOffsetCache::get(zone).tryToUtc(seconds_)) {
+    seconds_ = *utcSeconds;
+    return;
+  }
+
   date::local_time<std::chrono::seconds> localTime{
       std::chrono::seconds(seconds_)};
   std::chrono::time_point<std::chrono::system_clock, std::chrono::seconds>
@@ -82,7 +89,7 @@ void Timestamp::toGMT(int16_t tzID) {
     seconds_ -= getPrestoTZOffsetInSeconds(tzID);
   } else {
     // Other ids go this path.
-    toGMT(*date::locate_zone(util::getTimeZoneName(tzID)));
+    toGMT(*util::locateZone(tzID));
   }
 }
 
@@ -119,10 +126,10 @@ Timestamp::toTimePoint(bool allowOverflow) const {
 }
 
 void Timestamp::toTimezone(const date::time_zone& zone) {
-  auto tp = toTimePoint();
-  auto epoch = zone.to_local(tp).time_since_epoch();
-  // NOTE: Round down to get the seconds of the current time point.
-  seconds_ = std::chrono::floor<std::chrono::seconds>(epoch).count();
+  // Checks that the time point is in range. The offset is in whole seconds, so
+  // that rounding down the local time point adds the offset to 'seconds_'.
+  toTimePoint();
+  seconds_ += util::TimeZoneOffsetCache::get(zone).offsetAt(seconds_);
 }
 
 void Timestamp::toTimezone(int16_t tzID) {
@@ -132,7 +139,7 @@ void Timestamp::toTimezone(int16_t tzID) {
     seconds_ += getPrestoTZOffsetInSeconds(tzID);
   } else {
     // Other ids go this path.
-    toTimezone(*date::locate_zone(util::getTimeZoneName(tzID)));
+    toTimezone(*util::locateZone(tzID));
   }
 }
 
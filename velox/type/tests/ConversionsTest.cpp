@@ -1047,5 +1047,84 @@ TEST_F(ConversionsTest, toTimestamp) {
         {123456.78}, {}, false, false, /*expectError*/ true);
   }
 }
+
+TEST_F(ConversionsTest, fastStringToNumber) {
+  // Plain numbers parse to the same values as with folly.
+  for (const std::string str :
+       {"0",
+        "-0",
+        "7",
+        "-128",
+        "127",
+        "0012345678",
+        "123456789012345678",
+        "-123456789012345678"}) {
+    SCOPED_TRACE(str);
+    ASSERT_EQ(tryParseIntegerFast<int64_t>(str), folly::to<int64_t>(str));
+    ASSERT_EQ(tryParseFloatingPointFast<double>(str), folly::to<double>(str));
+  }
+  ASSERT_EQ(tryParseIntegerFast<int8_t>("-128"), -128);
+  ASSERT_EQ(tryParseIntegerFast<int32_t>("-2147483648"), -2147483648LL);
+
+  // Other strings are left to folly, whether they are valid or not.
+  for (const std::string str :
+       {"",
+        "-",
+        "+1",
+        " 1",
+        "1 ",
+        "1.5",
+        "1234567890123456789",
+        "12a",
+        "0x10"}) {
+    SCOPED_TRACE(str);
+    ASSERT_EQ(tryParseIntegerFast<int64_t>(str), std::nullopt);
+  }
+  ASSERT_EQ(tryParseIntegerFast<int8_t>("128"), std::nullopt);
+  ASSERT_EQ(tryParseIntegerFast<int16_t>("-32769"), std::nullopt);
+
+  for (const std::string str :
+       {"1.5",
+        "-0.25",
+        "3.14159265358979",
+        "123456.789e-3",
+        "1e22",
+        "1E-22",
+        "9007199254740992",
+        "0.1",
+        "2.5e+3"}) {
+    SCOPED_TRACE(str);
+    ASSERT_EQ(tryParseFloatingPointFast<double>(str), folly::to<double>(str));
+    const auto real = tryParseFloatingPointFast<float>(str);
+    if (real.has_value()) {
+      ASSERT_EQ(real.value(), folly::to<float>(str));
+    }
+  }
+  ASSERT_EQ(tryParseFloatingPointFast<float>("0.1"), 0.1f);
+  for (const std::string str :
+       {"",
+        ".5",
+        "1.",
+        "1e",
+        "1e400",
+        "9007199254740993",
+        "12345678901234567890",
+        "nan",
+        "Infinity",
+        "1.5f"}) {
+    SCOPED_TRACE(str);
+    ASSERT_EQ(tryParseFloatingPointFast<double>(str), std::nullopt);
+  }
+
+  ASSERT_TRUE(isInvalidNumber<false>("12a"));
+  ASSERT_TRUE(isInvalidNumber<false>("1e5"));
+  ASSERT_FALSE(isInvalidNumber<false>(" -12 "));
+  ASSERT_FALSE(isInvalidNumber<false>("1.5"));
+  ASSERT_TRUE(isInvalidNumber<true>("$"));
+  ASSERT_TRUE(isInvalidNumber<true>("1.5f"));
+  ASSERT_FALSE(isInvalidNumber<true>("1.5e-3"));
+  ASSERT_FALSE(isInvalidNumber<true>("-Infinity"));
+  ASSERT_FALSE(isInvalidNumber<true>("NaN"));
+}
 } // namespace
 } // namespace facebook::velox::util
@@ -163,3 +163,22 @@ TEST_F(FilterSerDeTest, timestampFilter) {
   testSerde(TimestampRange(lo, hi, true));
   testSerde(TimestampRange(lo, hi, false));
 }
+
+TEST_F(FilterSerDeTest, bloomFilter) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(100);
+  for (int64_t i = 0; i < 100; ++i) {
+    bloomFilter->insert(BloomFilterValues::hashInt64(i * 7));
+  }
+
+  for (auto nullAllowed : {false, true}) {
+    testSerde(BloomFilterValues(bloomFilter, nullAllowed, 0, 693));
+    testSerde(BloomFilterValues(
+        bloomFilter,
+        nullAllowed,
+        0,
+        693,
+        std::make_unique<BigintValuesUsingBitmask>(
+            7, 21, std::vector<int64_t>{7, 14, 21}, false)));
+  }
+}
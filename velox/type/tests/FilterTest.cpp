@@ -950,6 +950,31 @@ TEST(FilterTest, bytesValues) {
   EXPECT_FALSE(filter->testBytesRange(std::nullopt, "Banana", false));
 }
 
+TEST(FilterTest, bytesValuesMany) {
+  // Thousands of values of lengths from 0 to 100, some differing only after
+  // the first 8 bytes.
+  std::vector<std::string> values;
+  for (auto i = 0; i < 3'000; ++i) {
+    values.push_back(std::string(i % 101, 'x') + std::to_string(i * 2));
+  }
+  values.push_back("");
+  auto filter = in(values);
+  auto copy = filter->clone(true);
+  for (const auto* tested : {filter.get(), copy.get()}) {
+    for (auto i = 0; i < 3'000; ++i) {
+      const auto passing = std::string(i % 101, 'x') + std::to_string(i * 2);
+      ASSERT_TRUE(tested->testBytes(passing.data(), passing.size()));
+      const auto failing =
+          std::string(i % 101, 'x') + std::to_string(i * 2 + 1);
+      ASSERT_FALSE(tested->testBytes(failing.data(), failing.size()));
+    }
+    ASSERT_TRUE(tested->testBytes("", 0));
+    ASSERT_TRUE(tested->testLength(0));
+    ASSERT_TRUE(tested->testLength(104));
+    ASSERT_FALSE(tested->testLength(106));
+  }
+}
+
 TEST(FilterTest, negatedBytesValues) {
   // create a filter
   std::vector<std::string> values(
@@ -1878,3 +1903,88 @@ TEST(FilterTest, timestampRange) {
   EXPECT_TRUE(filter->testTimestampRange(
       Timestamp(5, 123000000), Timestamp(30, 123000000), true));
 }
+
+TEST(FilterTest, bloomFilterValues) {
+  constexpr int32_t kNumValues = 1'000;
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(kNumValues);
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    bloomFilter->insert(BloomFilterValues::hashInt64(i * 10));
+    const auto str = std::to_string(i * 10);
+    bloomFilter->insert(BloomFilterValues::hashBytes(str.data(), str.size()));
+  }
+
+  BloomFilterValues filter(bloomFilter, false, 0, (kNumValues - 1) * 10);
+  EXPECT_EQ(filter.kind(), FilterKind::kBloomFilter);
+  EXPECT_FALSE(filter.testNull());
+
+  // No false negatives.
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    EXPECT_TRUE(filter.testInt64(i * 10));
+    const auto str = std::to_string(i * 10);
+    EXPECT_TRUE(filter.testBytes(str.data(), str.size()));
+  }
+
+  // Values outside of [min, max] are always rejected and most of the values
+  // inside the range that were not inserted are rejected.
+  EXPECT_FALSE(filter.testInt64(-1));
+  EXPECT_FALSE(filter.testInt64(kNumValues * 10));
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    numFalsePositives += filter.testInt64(i * 10 + 5);
+    const auto str = std::to_string(i * 10 + 5);
+    numFalsePositives += filter.testBytes(str.data(), str.size());
+  }
+  EXPECT_LT(numFalsePositives, kNumValues / 10);
+
+  EXPECT_TRUE(filter.testInt64Range(-100, 5, false));
+  EXPECT_FALSE(filter.testInt64Range(-100, -1, false));
+  EXPECT_FALSE(filter.testInt64Range(kNumValues * 10, kNumValues * 20, false));
+  EXPECT_TRUE(filter.testInt64Range(20, 20, false));
+  EXPECT_TRUE(filter.testBytesRange("20", "20", false));
+  EXPECT_TRUE(filter.testBytesRange("20", "21", false));
+
+  // All copies report to the same stats.
+  auto copy = filter.clone(true);
+  EXPECT_TRUE(copy->testNull());
+  EXPECT_TRUE(copy->testInt64(10));
+  copy.reset();
+  const auto& stats = filter.stats();
+  EXPECT_EQ(stats->numRangesTested, 6);
+  EXPECT_EQ(stats->numRangesRejected, 2);
+  EXPECT_GE(stats->numRowsTested, 1);
+}
+
+TEST(FilterTest, mergeWithBloomFilterValues) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(100);
+  for (int64_t i = 0; i < 100; ++i) {
+    bloomFilter->insert(BloomFilterValues::hashInt64(i));
+  }
+  BloomFilterValues filter(bloomFilter, false, 0, 99);
+
+  // A range narrows [min, max].
+  auto range = between(50, 200);
+  auto merged = range->mergeWith(&filter);
+  ASSERT_EQ(merged->kind(), FilterKind::kBloomFilter);
+  EXPECT_EQ(static_cast<BloomFilterValues*>(merged.get())->min(), 50);
+  EXPECT_EQ(static_cast<BloomFilterValues*>(merged.get())->max(), 99);
+  EXPECT_FALSE(merged->testInt64(10));
+  EXPECT_TRUE(merged->testInt64(60));
+
+  EXPECT_EQ(
+      between(200, 300)->mergeWith(&filter)->kind(), FilterKind::kAlwaysFalse);
+
+  // Other filters are ANDed with the Bloom filter.
+  auto values = in({10, 20, 30, 500});
+  merged = values->mergeWith(&filter);
+  ASSERT_EQ(merged->kind(), FilterKind::kBloomFilter);
+  EXPECT_TRUE(merged->testInt64(10));
+  EXPECT_TRUE(merged->testInt64(30));
+  EXPECT_FALSE(merged->testInt64(40));
+  EXPECT_FALSE(merged->testInt64(500));
+
+  EXPECT_EQ(
+      isNotNull()->mergeWith(&filter)->kind(), FilterKind::kBloomFilter);
+  EXPECT_EQ(isNull()->mergeWith(&filter)->kind(), FilterKind::kAlwaysFalse);
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/type/tz/TimeZoneOffsetCache.h"
+
+#include <algorithm>
+#include <memory>
+
+#include <folly/container/F14Map.h>
+#include "velox/external/date/tz.h"
+#include "velox/type/tz/TimeZoneMap.h"
+
+namespace facebook::velox::util {
+
+namespace {
+// Offsets of time zones from UTC are less than a day.
+constexpr int64_t kSecondsInDay = 86'400;
+} // namespace
+
+// static
+TimeZoneOffsetCache& TimeZoneOffsetCache::get(const date::time_zone& zone) {
+  thread_local folly::F14FastMap<
+      const date::time_zone*,
+      std::unique_ptr<TimeZoneOffsetCache>>
+      caches;
+  auto& cache = caches[&zone];
+  if (cache == nullptr) {
+    cache = std::make_unique<TimeZoneOffsetCache>(zone);
+  }
+  return *cache;
+}
+
+TimeZoneOffsetCache::Interval TimeZoneOffsetCache::intervalAt(
+    int64_t utcSeconds) {
+  if (last_ < intervals_.size() && intervals_[last_].begin <= utcSeconds &&
+      utcSeconds < intervals_[last_].end) {
+    return intervals_[last_];
+  }
+
+  auto it = std::upper_bound(
+      intervals_.begin(),
+      intervals_.end(),
+      utcSeconds,
+      [](int64_t seconds, const Interval& interval) {
+        return seconds < interval.begin;
+      });
+  if (it != intervals_.begin() && utcSeconds < std::prev(it)->end) {
+    last_ = std::prev(it) - intervals_.begin();
+    return intervals_[last_];
+  }
+
+  const auto info =
+      zone_.get_info(date::sys_seconds(std::chrono::seconds(utcSeconds)));
+  const Interval interval{
+      info.begin.time_since_epoch().count(),
+      info.end.time_since_epoch().count(),
+      info.offset.count()};
+  if (intervals_.size() >= kMaxIntervals) {
+    intervals_.clear();
+    it = intervals_.end();
+  }
+  last_ = intervals_.insert(it, interval) - intervals_.begin();
+  return interval;
+}
+
+int64_t TimeZoneOffsetCache::offsetAt(int64_t utcSeconds) {
+  return intervalAt(utcSeconds).offset;
+}
+
+std::optional<int64_t> TimeZoneOffsetCache::tryToUtc(int64_t localSeconds) {
+  // Local times and UTC times that are a day apart are in the same or in
+  // adjacent intervals, so that the offset at 'localSeconds' taken as UTC is
+  // a first guess.
+  auto interval = intervalAt(localSeconds);
+  auto utcSeconds = localSeconds - interval.offset;
+  if (utcSeconds < interval.begin || utcSeconds >= interval.end) {
+    interval = intervalAt(utcSeconds);
+    utcSeconds = localSeconds - interval.offset;
+  }
+  // A local time that is more than a day away from the ends of its interval
+  // can not be a local time in another interval.
+  if (utcSeconds - kSecondsInDay < interval.begin ||
+      utcSeconds + kSecondsInDay >= interval.end) {
+    return std::nullopt;
+  }
+  return utcSeconds;
+}
+
+const date::time_zone* locateZone(int64_t timeZoneID) {
+  thread_local folly::F14FastMap<int64_t, const date::time_zone*> zones;
+  auto& zone = zones[timeZoneID];
+  if (zone == nullptr) {
+    zone = date::locate_zone(getTimeZoneName(timeZoneID));
+  }
+  return zone;
+}
+
+} // namespace facebook::velox::util
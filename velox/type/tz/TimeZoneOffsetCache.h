@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace date {
+class time_zone;
+} // namespace date
+
+namespace facebook::velox::util {
+
+/// Cache of the intervals in which the offset of a time zone from UTC does not
+/// change. The timestamps of a batch mostly fall in the same interval, so that
+/// most conversions check one range and the others do a binary search over the
+/// intervals seen so far. The time zone database is asked only about times in
+/// intervals that are not in the cache. Not thread safe.
+class TimeZoneOffsetCache {
+ public:
+  explicit TimeZoneOffsetCache(const date::time_zone& zone) : zone_(zone) {}
+
+  /// Returns the cache of 'zone' of the calling thread.
+  static TimeZoneOffsetCache& get(const date::time_zone& zone);
+
+  /// Returns the offset of the local time in the zone from UTC in seconds at
+  /// 'utcSeconds' since the epoch.
+  int64_t offsetAt(int64_t utcSeconds);
+
+  /// Returns the seconds since the epoch in UTC of 'localSeconds' since the
+  /// epoch in the zone. Returns std::nullopt if 'localSeconds' is less than a
+  /// day away from a change of offset, where a local time may be ambiguous or
+  /// may not exist. The caller converts these with the time zone.
+  std::optional<int64_t> tryToUtc(int64_t localSeconds);
+
+ private:
+  // Times in [begin, end) in seconds since the epoch in UTC have 'offset'.
+  struct Interval {
+    int64_t begin;
+    int64_t end;
+    int64_t offset;
+  };
+
+  // The cache is cleared when it gets to this many intervals.
+  static constexpr size_t kMaxIntervals = 256;
+
+  Interval intervalAt(int64_t utcSeconds);
+
+  const date::time_zone& zone_;
+
+  // Sorted on 'begin'. The intervals do not overlap.
+  std::vector<Interval> intervals_;
+
+  // Index in 'intervals_' of the last interval found.
+  size_t last_{0};
+};
+
+/// Returns the time zone of 'timeZoneID'. The zones are cached for each
+/// thread, so that repeated lookups do not search the time zone database by
+/// name.
+const date::time_zone* locateZone(int64_t timeZoneID);
+
+} // namespace facebook::velox::util
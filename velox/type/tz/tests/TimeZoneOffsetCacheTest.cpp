@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/external/date/tz.h"
+#include "velox/type/tz/TimeZoneOffsetCache.h"
+
+namespace facebook::velox::util {
+namespace {
+
+// Compares with the time zone database every 15 minutes over 2 years that
+// cross the changes to and from daylight saving time.
+TEST(TimeZoneOffsetCacheTest, offsetAt) {
+  for (const auto* name : {"America/Los_Angeles", "Asia/Kolkata", "UTC"}) {
+    SCOPED_TRACE(name);
+    const auto* zone = date::locate_zone(name);
+    TimeZoneOffsetCache cache(*zone);
+    // 2023-01-01 to 2025-01-01 UTC.
+    for (int64_t seconds = 1'672'531'200; seconds < 1'735'689'600;
+         seconds += 900) {
+      const auto info =
+          zone->get_info(date::sys_seconds(std::chrono::seconds(seconds)));
+      ASSERT_EQ(cache.offsetAt(seconds), info.offset.count()) << seconds;
+    }
+  }
+}
+
+TEST(TimeZoneOffsetCacheTest, tryToUtc) {
+  const auto* zone = date::locate_zone("America/Los_Angeles");
+  TimeZoneOffsetCache cache(*zone);
+
+  // 2024-01-15 12:00:00 local is 20:00:00 UTC.
+  EXPECT_EQ(cache.tryToUtc(1'705'320'000).value(), 1'705'348'800);
+  // 2024-07-15 12:00:00 local is 19:00:00 UTC.
+  EXPECT_EQ(cache.tryToUtc(1'721'044'800).value(), 1'721'070'000);
+
+  // 2024-03-10 02:30:00 local does not exist.
+  EXPECT_FALSE(cache.tryToUtc(1'710'037'800).has_value());
+  // 2024-11-03 01:30:00 local is ambiguous.
+  EXPECT_FALSE(cache.tryToUtc(1'730'597'400).has_value());
+  // Times less than a day away from a change are left to the caller.
+  EXPECT_FALSE(cache.tryToUtc(1'710'037'800 - 43'200).has_value());
+
+  // Agrees with the time zone database everywhere else.
+  for (int64_t local = 1'704'067'200; local < 1'735'689'600; local += 900) {
+    if (auto utc = cache.tryToUtc(local)) {
+      const auto expected =
+          zone->to_sys(date::local_seconds(std::chrono::seconds(local)));
+      ASSERT_EQ(*utc, expected.time_since_epoch().count()) << local;
+    }
+  }
+}
+
+TEST(TimeZoneOffsetCacheTest, locateZone) {
+  EXPECT_EQ(locateZone(1825), date::locate_zone("America/Los_Angeles"));
+  EXPECT_EQ(locateZone(1825), locateZone(1825));
+  EXPECT_EQ(locateZone(2079), date::locate_zone("Europe/Moscow"));
+}
+
+} // namespace
+} // namespace facebook::velox::util
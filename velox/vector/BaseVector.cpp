@@ -875,6 +875,51 @@ void BaseVector::flattenVector(VectorPtr& vector) {
   }
 }
 
+// static
+VectorPtr BaseVector::compactStringBuffers(
+    const VectorPtr& vector,
+    double minLiveRatio) {
+  const auto& loaded = BaseVector::loadedVectorShared(vector);
+  switch (loaded->encoding()) {
+    case VectorEncoding::Simple::FLAT: {
+      if (!loaded->type()->isVarchar() && !loaded->type()->isVarbinary()) {
+        return vector;
+      }
+      auto compacted =
+          loaded->asUnchecked<FlatVector<StringView>>()->compactStringBuffers(
+              minLiveRatio);
+      return compacted ? compacted : vector;
+    }
+    case VectorEncoding::Simple::ROW: {
+      auto* rowVector = loaded->asUnchecked<RowVector>();
+      std::vector<VectorPtr> children;
+      for (auto i = 0; i < rowVector->childrenSize(); ++i) {
+        const auto& child = rowVector->childAt(i);
+        auto compacted =
+            child ? compactStringBuffers(child, minLiveRatio) : nullptr;
+        if (compacted != child && children.empty()) {
+          children = rowVector->children();
+        }
+        if (!children.empty()) {
+          children[i] = std::move(compacted);
+        }
+      }
+      if (children.empty()) {
+        return vector;
+      }
+      return std::make_shared<RowVector>(
+          rowVector->pool(),
+          rowVector->type(),
+          rowVector->nulls(),
+          rowVector->size(),
+          std::move(children),
+          rowVector->getNullCount());
+    }
+    default:
+      return vector;
+  }
+}
+
 void BaseVector::prepareForReuse(VectorPtr& vector, vector_size_t size) {
   if (!vector.unique() || !isReusableEncoding(vector->encoding())) {
     vector = BaseVector::create(vector->type(), size, vector->pool());
@@ -599,6 +599,16 @@ class BaseVector {
   /// Flattens the input vector and all of its children.
   static void flattenVector(VectorPtr& vector);
 
+  /// Returns 'vector' with its flat VARCHAR and VARBINARY vectors, at the top
+  /// or in the children of rows, replaced by copies with tight string buffers
+  /// if their strings take less than 'minLiveRatio' of the capacity of their
+  /// string buffers. See FlatVector<StringView>::compactStringBuffers().
+  /// Returns 'vector' itself if no vector is compacted. Other encodings are
+  /// not looked into.
+  static VectorPtr compactStringBuffers(
+      const VectorPtr& vector,
+      double minLiveRatio);
+
   template <typename T>
   static inline uint64_t byteSize(vector_size_t count) {
     return sizeof(T) * count;
@@ -586,18 +586,38 @@ void ArrayVectorBase::copyRangesImpl(
           }
         });
     outRanges.reserve(totalCount);
+    // The nulls of a flat source are copied a range at a time and its rows
+    // are read without virtual calls.
+    const bool isFlatSource = source == leafSource;
+    const uint64_t* flatSourceNulls =
+        isFlatSource ? source->rawNulls() : nullptr;
+    if (isFlatSource && setNotNulls) {
+      if (flatSourceNulls) {
+        BaseVector::copyNulls(mutableRawNulls(), flatSourceNulls, ranges);
+      } else {
+        BaseVector::setNulls(mutableRawNulls(), ranges, false);
+      }
+    }
+    const auto* sourceOffsets = sourceArray->rawOffsets();
+    const auto* sourceSizes = sourceArray->rawSizes();
     applyToEachRow(ranges, [&](auto targetIndex, auto sourceIndex) {
-      if (source->isNullAt(sourceIndex)) {
-        setNull(targetIndex, true);
+      bool isNull;
+      if (isFlatSource) {
+        isNull =
+            flatSourceNulls && bits::isBitNull(flatSourceNulls, sourceIndex);
       } else {
-        if (setNotNulls) {
-          setNull(targetIndex, false);
+        isNull = source->isNullAt(sourceIndex);
+        if (isNull || setNotNulls) {
+          setNull(targetIndex, isNull);
         }
-        auto wrappedIndex = source->wrappedIndex(sourceIndex);
-        auto copySize = sourceArray->sizeAt(wrappedIndex);
+      }
+      if (!isNull) {
+        auto wrappedIndex =
+            isFlatSource ? sourceIndex : source->wrappedIndex(sourceIndex);
+        auto copySize = sourceSizes[wrappedIndex];
 
         if (copySize > 0) {
-          auto copyOffset = sourceArray->offsetAt(wrappedIndex);
+          auto copyOffset = sourceOffsets[wrappedIndex];
 
           // If we're copying two adjacent ranges, merge them.  This only
           // works if they're consecutive.
@@ -16,6 +16,7 @@
 #include "velox/vector/DecodedVector.h"
 #include "velox/buffer/Buffer.h"
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/vector/BaseVector.h"
 #include "velox/vector/LazyVector.h"
 
@@ -31,6 +32,33 @@ std::vector<vector_size_t> makeConsecutiveIndices(size_t size) {
   }
   return consecutiveIndices;
 }
+
+// Indices are combined and null flags gathered with SIMD loads that may read
+// up to a batch of indices past the end.
+constexpr int32_t kIndexPadding = xsimd::batch<vector_size_t>::size;
+
+// Returns true if 'rows' cover all the rows, so that the rows can be
+// processed a word of bits at a time.
+bool allRowsSelected(const SelectivityVector* rows) {
+  return rows == nullptr || rows->isAllSelected();
+}
+
+// Sets the first 'size' 'indices' to the run of each row of the sequence
+// vector 'sequence', so that the sequence can be decoded like a dictionary
+// over its run values.
+void expandRuns(
+    const BaseVector& sequence,
+    vector_size_t size,
+    vector_size_t* indices) {
+  const auto* lengths = sequence.wrapInfo()->as<vector_size_t>();
+  const auto numRuns = sequence.valueVector()->size();
+  vector_size_t row = 0;
+  for (vector_size_t run = 0; run < numRuns && row < size; ++run) {
+    const auto end = std::min(row + lengths[run], size);
+    std::fill(indices + row, indices + end, run);
+    row = end;
+  }
+}
 } // namespace
 
 const std::vector<vector_size_t>& DecodedVector::consecutiveIndices() {
@@ -147,6 +175,12 @@ void DecodedVector::combineWrappers(
       hasExtraNulls_ = true;
       mayHaveNulls_ = true;
     }
+  } else if (topEncoding == VectorEncoding::Simple::SEQUENCE) {
+    // Runs do not add nulls, only the run values may be null.
+    copiedIndices_.resize(size_ + kIndexPadding);
+    expandRuns(*vector, size_, copiedIndices_.data());
+    indices_ = copiedIndices_.data();
+    values = vector->valueVector().get();
   } else {
     VELOX_FAIL(
         "Unsupported wrapper encoding: {}",
@@ -181,6 +215,11 @@ void DecodedVector::combineWrappers(
         values = values->valueVector().get();
         break;
       }
+      case VectorEncoding::Simple::SEQUENCE: {
+        applySequenceWrapper(*values, rows);
+        values = values->valueVector().get();
+        break;
+      }
       default:
         VELOX_CHECK(false, "Unsupported vector encoding");
     }
@@ -194,9 +233,28 @@ void DecodedVector::applyDictionaryWrapper(
     // No further processing is needed.
     return;
   }
+  applyWrapperIndices(
+      dictionaryVector.wrapInfo()->as<vector_size_t>(),
+      dictionaryVector.rawNulls(),
+      rows);
+}
+
+void DecodedVector::applySequenceWrapper(
+    const BaseVector& sequenceVector,
+    const SelectivityVector* rows) {
+  if (size_ == 0 || (rows && !rows->hasSelections())) {
+    // No further processing is needed.
+    return;
+  }
+  std::vector<vector_size_t> runs(sequenceVector.size() + kIndexPadding);
+  expandRuns(sequenceVector, sequenceVector.size(), runs.data());
+  applyWrapperIndices(runs.data(), nullptr, rows);
+}
 
-  auto newIndices = dictionaryVector.wrapInfo()->as<vector_size_t>();
-  auto newNulls = dictionaryVector.rawNulls();
+void DecodedVector::applyWrapperIndices(
+    const vector_size_t* newIndices,
+    const uint64_t* newNulls,
+    const SelectivityVector* rows) {
   if (newNulls) {
     hasExtraNulls_ = true;
     mayHaveNulls_ = true;
@@ -210,10 +268,15 @@ void DecodedVector::applyDictionaryWrapper(
   auto copiedNulls = copiedNulls_.data();
   auto currentIndices = indices_;
   if (indicesNotCopied()) {
-    copiedIndices_.resize(size_);
+    copiedIndices_.resize(size_ + kIndexPadding);
     indices_ = copiedIndices_.data();
   }
 
+  if (allRowsSelected(rows)) {
+    combineIndices(end(rows), currentIndices, newIndices, newNulls);
+    return;
+  }
+
   applyToRows(rows, [&](vector_size_t row) {
     if (!nulls_ || !bits::isBitNull(nulls_, row)) {
       auto wrappedIndex = currentIndices[row];
@@ -226,6 +289,44 @@ void DecodedVector::applyDictionaryWrapper(
   });
 }
 
+void DecodedVector::combineIndices(
+    vector_size_t numRows,
+    const vector_size_t* currentIndices,
+    const vector_size_t* newIndices,
+    const uint64_t* newNulls) {
+  auto* copiedNulls = copiedNulls_.data();
+  for (vector_size_t begin = 0; begin < numRows; begin += 64) {
+    const auto end = std::min<vector_size_t>(begin + 64, numRows);
+    if (nulls_ && !bits::isAllSet(nulls_, begin, end)) {
+      // The indices of null rows may be out of range.
+      for (auto row = begin; row < end; ++row) {
+        if (!bits::isBitNull(nulls_, row)) {
+          auto wrappedIndex = currentIndices[row];
+          if (newNulls && bits::isBitNull(newNulls, wrappedIndex)) {
+            bits::setNull(copiedNulls, row);
+          } else {
+            copiedIndices_[row] = newIndices[wrappedIndex];
+          }
+        }
+      }
+      continue;
+    }
+    folly::Range<const vector_size_t*> wrappedIndices(
+        currentIndices + begin, end - begin);
+    if (newNulls) {
+      // No row of the word is null, so the word becomes the null flags of
+      // the wrapped rows.
+      uint64_t notNulls;
+      simd::gatherBits(newNulls, wrappedIndices, &notNulls);
+      if (end - begin < 64) {
+        notNulls |= ~bits::lowMask(end - begin);
+      }
+      copiedNulls[begin / 64] &= notNulls;
+    }
+    simd::transpose(newIndices, wrappedIndices, copiedIndices_.data() + begin);
+  }
+}
+
 void DecodedVector::fillInIndices() {
   if (isConstantMapping_) {
     if (size_ > zeroIndices().size() || constantIndex_ != 0) {
@@ -271,6 +372,12 @@ void DecodedVector::setFlatNulls(
     }
     auto leafNulls = vector.rawNulls();
     auto copiedNulls = &copiedNulls_[0];
+    if (leafNulls && allRowsSelected(rows) &&
+        vector.encoding() != VectorEncoding::Simple::CONSTANT) {
+      combineLeafNulls(end(rows), leafNulls);
+      nulls_ = &copiedNulls_[0];
+      return;
+    }
     applyToRows(rows, [&](vector_size_t row) {
       if (!bits::isBitNull(nulls_, row) &&
           (leafNulls && bits::isBitNull(leafNulls, indices_[row]))) {
@@ -284,6 +391,38 @@ void DecodedVector::setFlatNulls(
   }
 }
 
+void DecodedVector::combineLeafNulls(
+    vector_size_t numRows,
+    const uint64_t* leafNulls) {
+  auto* copiedNulls = copiedNulls_.data();
+  for (vector_size_t begin = 0; begin < numRows; begin += 64) {
+    const auto end = std::min<vector_size_t>(begin + 64, numRows);
+    const auto word = begin / 64;
+    if (copiedNulls[word] == 0) {
+      continue;
+    }
+    if (!bits::isAllSet(copiedNulls, begin, end)) {
+      // The indices of null rows may be out of range.
+      for (auto row = begin; row < end; ++row) {
+        if (!bits::isBitNull(copiedNulls, row) &&
+            bits::isBitNull(leafNulls, indices_[row])) {
+          bits::setNull(copiedNulls, row);
+        }
+      }
+      continue;
+    }
+    uint64_t notNulls;
+    simd::gatherBits(
+        leafNulls,
+        folly::Range<const vector_size_t*>(indices_ + begin, end - begin),
+        &notNulls);
+    if (end - begin < 64) {
+      notNulls |= ~bits::lowMask(end - begin);
+    }
+    copiedNulls[word] &= notNulls;
+  }
+}
+
 void DecodedVector::setBaseData(
     const BaseVector& vector,
     const SelectivityVector* rows) {
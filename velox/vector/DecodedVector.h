@@ -339,6 +339,32 @@ class DecodedVector {
       const BaseVector& dictionaryVector,
       const SelectivityVector* rows);
 
+  // Applies the runs of a SequenceVector like the indices of a dictionary
+  // that maps each row to its run.
+  void applySequenceWrapper(
+      const BaseVector& sequenceVector,
+      const SelectivityVector* rows);
+
+  // Maps the current indices through 'newIndices' and sets the rows that map
+  // to 'newNulls' to null.
+  void applyWrapperIndices(
+      const vector_size_t* newIndices,
+      const uint64_t* newNulls,
+      const SelectivityVector* rows);
+
+  // Sets the indices of the first 'numRows' rows to 'newIndices' at
+  // 'currentIndices' and the rows that map to 'newNulls' to null, a word of 64
+  // rows at a time. Words that have null rows are processed row by row.
+  void combineIndices(
+      vector_size_t numRows,
+      const vector_size_t* currentIndices,
+      const vector_size_t* newIndices,
+      const uint64_t* newNulls);
+
+  // Sets the rows of the first 'numRows' that map to 'leafNulls' to null, a
+  // word of 64 rows at a time.
+  void combineLeafNulls(vector_size_t numRows, const uint64_t* leafNulls);
+
   void copyNulls(vector_size_t size);
 
   void fillInIndices();
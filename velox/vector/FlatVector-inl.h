@@ -301,13 +301,31 @@ void FlatVector<T>::copyRanges(
     auto leaf =
         source->wrappedVector()->asUnchecked<SimpleVector<StringView>>();
     if (BaseVector::pool_ != leaf->pool()) {
+      // Appends the strings that are not inlined to one string buffer sized
+      // for all of them.
+      size_t totalBytes = 0;
+      applyToEachRow(ranges, [&](auto /*targetIndex*/, auto sourceIndex) {
+        if (!source->isNullAt(sourceIndex)) {
+          auto value = leaf->valueAt(source->wrappedIndex(sourceIndex));
+          if (!value.isInline()) {
+            totalBytes += value.size();
+          }
+        }
+      });
+      char* buffer =
+          totalBytes > 0 ? getRawStringBufferWithSpace(totalBytes) : nullptr;
       applyToEachRow(ranges, [&](auto targetIndex, auto sourceIndex) {
         if (source->isNullAt(sourceIndex)) {
           this->setNull(targetIndex, true);
-        } else {
-          this->set(
-              targetIndex, leaf->valueAt(source->wrappedIndex(sourceIndex)));
+          return;
+        }
+        auto value = leaf->valueAt(source->wrappedIndex(sourceIndex));
+        if (!value.isInline()) {
+          memcpy(buffer, value.data(), value.size());
+          value = StringView(buffer, value.size());
+          buffer += value.size();
         }
+        this->setNoCopy(targetIndex, value);
       });
       return;
     }
@@ -101,6 +101,60 @@ void FlatVector<StringView>::prepareForReuse() {
   }
 }
 
+template <>
+VectorPtr FlatVector<StringView>::compactStringBuffers(
+    double minLiveRatio) const {
+  if (stringBuffers_.empty() || rawValues_ == nullptr) {
+    return nullptr;
+  }
+  uint64_t heldBytes = 0;
+  for (const auto& buffer : stringBuffers_) {
+    heldBytes += buffer->capacity();
+  }
+  uint64_t liveBytes = 0;
+  for (auto i = 0; i < BaseVector::length_; ++i) {
+    if (!isNullAt(i) && !rawValues_[i].isInline()) {
+      liveBytes += rawValues_[i].size();
+    }
+  }
+  if (liveBytes >= minLiveRatio * heldBytes) {
+    return nullptr;
+  }
+
+  // The values are copied, since they may be shared with other vectors that
+  // keep the old string buffers.
+  auto values = AlignedBuffer::allocate<StringView>(BaseVector::length_, pool_);
+  auto* rawValues = values->asMutable<StringView>();
+  std::vector<BufferPtr> stringBuffers;
+  char* rawBuffer = nullptr;
+  if (liveBytes > 0) {
+    stringBuffers.push_back(AlignedBuffer::allocate<char>(liveBytes, pool_));
+    rawBuffer = stringBuffers.back()->asMutable<char>();
+  }
+  for (auto i = 0; i < BaseVector::length_; ++i) {
+    if (isNullAt(i)) {
+      rawValues[i] = StringView();
+    } else if (rawValues_[i].isInline()) {
+      rawValues[i] = rawValues_[i];
+    } else {
+      const auto size = rawValues_[i].size();
+      memcpy(rawBuffer, rawValues_[i].data(), size);
+      rawValues[i] = StringView(rawBuffer, size);
+      rawBuffer += size;
+    }
+  }
+  return std::make_shared<FlatVector<StringView>>(
+      pool_,
+      BaseVector::type(),
+      BaseVector::nulls(),
+      BaseVector::length_,
+      std::move(values),
+      std::move(stringBuffers),
+      SimpleVectorStats<StringView>{},
+      std::nullopt,
+      BaseVector::getNullCount());
+}
+
 template <>
 void FlatVector<StringView>::set(vector_size_t idx, StringView value) {
   VELOX_DCHECK_LT(idx, BaseVector::length_);
@@ -490,6 +490,17 @@ class FlatVector final : public SimpleVector<T> {
     return nullptr;
   }
 
+  /// This API is available only for string vectors (T = StringView).
+  ///
+  /// Returns a copy of this vector with the strings that are not inlined in
+  /// one string buffer of their total size, if these strings take less than
+  /// 'minLiveRatio' of the capacity of 'stringBuffers', e.g. after a
+  /// selective filter or a slice kept a few strings of a batch. Returns
+  /// nullptr otherwise. The copy shares the nulls of this vector.
+  VectorPtr compactStringBuffers(double /*minLiveRatio*/) const {
+    return nullptr;
+  }
+
   void ensureWritable(const SelectivityVector& rows) override;
 
   bool isWritable() const override {
@@ -617,6 +628,10 @@ char* FlatVector<StringView>::getRawStringBufferWithSpace(
 template <>
 void FlatVector<StringView>::prepareForReuse();
 
+template <>
+VectorPtr FlatVector<StringView>::compactStringBuffers(
+    double minLiveRatio) const;
+
 template <typename T>
 using FlatVectorPtr = std::shared_ptr<FlatVector<T>>;
 
@@ -154,6 +154,12 @@ class LazyVector : public BaseVector {
     return allLoaded_;
   }
 
+  /// Returns the loader that produces the values. Lets the producer of a lazy
+  /// vector recognize its own loaders.
+  VectorLoader* loader() const {
+    return loader_.get();
+  }
+
   // Loads the positions in 'rows' into loadedVector_. If 'hook' is
   // non-nullptr, the hook is instead called on the values and
   // loadedVector is not updated. This method is const because call
@@ -51,8 +51,13 @@ FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
 
 VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
   auto cacheIndex = toCacheIndex(type);
-  if (cacheIndex >= 0 && size <= kMaxRecycleSize) {
-    return vectors_[cacheIndex].pop(type, size, *pool_);
+  if (size <= kMaxRecycleSize) {
+    if (cacheIndex >= 0) {
+      return vectors_[cacheIndex].pop(type, size, *pool_);
+    }
+    if (auto* typePool = complexTypePool(type, false)) {
+      return typePool->pop(type, size, *pool_);
+    }
   }
   return BaseVector::create(type, size, pool_);
 }
@@ -67,11 +72,35 @@ bool VectorPool::release(VectorPtr& vector) {
 
   auto cacheIndex = toCacheIndex(vector->type());
   if (cacheIndex < 0) {
-    return false;
+    auto* typePool = complexTypePool(vector->type(), true);
+    return typePool != nullptr && typePool->maybePushBack(vector);
   }
   return vectors_[cacheIndex].maybePushBack(vector);
 }
 
+VectorPool::TypePool* VectorPool::complexTypePool(
+    const TypePtr& type,
+    bool add) {
+  switch (type->kind()) {
+    case TypeKind::ROW:
+    case TypeKind::ARRAY:
+    case TypeKind::MAP:
+      break;
+    default:
+      return nullptr;
+  }
+  for (auto& [cachedType, typePool] : complexVectors_) {
+    if (cachedType == type || *cachedType == *type) {
+      return &typePool;
+    }
+  }
+  if (!add || complexVectors_.size() >= kNumComplexTypes) {
+    return nullptr;
+  }
+  complexVectors_.emplace_back(type, TypePool{});
+  return &complexVectors_.back().second;
+}
+
 size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
   size_t numReleased = 0;
   for (auto& vector : vectors) {
@@ -86,10 +115,25 @@ size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
 
 bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
   // Check that this is a Flat Vector with an initialized, unique, and mutable
-  // values Buffer and an uninitialized or unique and mutable nulls Buffer.
-  if (!vector->isWritable() || !vector->isFlatEncoding() || !vector->values()) {
+  // values Buffer and an uninitialized or unique and mutable nulls Buffer or a
+  // row, array or map vector with recursively unique and mutable buffers and
+  // children.
+  if (!vector->isWritable()) {
     return false;
   }
+  switch (vector->encoding()) {
+    case VectorEncoding::Simple::FLAT:
+      if (!vector->values()) {
+        return false;
+      }
+      break;
+    case VectorEncoding::Simple::ROW:
+    case VectorEncoding::Simple::ARRAY:
+    case VectorEncoding::Simple::MAP:
+      break;
+    default:
+      return false;
+  }
   if (size >= kNumPerType) {
     return false;
   }
@@ -120,7 +164,13 @@ VectorPtr VectorPool::TypePool::pop(
           0,
           std::min<int32_t>(vectorSize, result->size()) * sizeof(StringView));
     }
-    if (result->size() != vectorSize) {
+    if (result->encoding() != VectorEncoding::Simple::FLAT) {
+      // prepareForReuse() left the children, elements, keys and values empty.
+      // Shrinking to 0 first makes resize() grow them back to 'vectorSize'.
+      // The offsets and sizes of arrays and maps are zeroed out.
+      result->resize(0);
+      result->resize(vectorSize);
+    } else if (result->size() != vectorSize) {
       result->resize(vectorSize);
     }
     return result;
@@ -20,24 +20,26 @@
 
 namespace facebook::velox {
 
-/// A thread-level cache of pre-allocated flat vectors of different types.
+/// A thread-level cache of pre-allocated vectors of different types.
 /// Keeps up to 10 recyclable vectors of each type. A vector is
-/// recyclable if it is flat and recursively singly-referenced.
-/// Only singleton built-in types are supported. Decimal types, fixed-size array
-/// type, complex and custom types are not supported. Calling 'get' for an
-/// unsupported type already returns a newly allocated vector. Calling 'release'
+/// recyclable if it is flat, row, array or map encoded and recursively
+/// singly-referenced and mutable. Singleton built-in types are cached by type
+/// kind. ROW, ARRAY and MAP types are cached by type for up to 8 distinct
+/// types, e.g. the output types of an operator. Decimal and other parametric
+/// scalar types and custom types are not supported. Calling 'get' for an
+/// unsupported type always returns a newly allocated vector. Calling 'release'
 /// for an unsupported type is a no-op.
 class VectorPool {
  public:
   explicit VectorPool(memory::MemoryPool* pool) : pool_{pool} {}
 
   /// Gets a possibly recycled vector of 'type and 'size'. Allocates from
-  /// 'pool_' if no pre-allocated vector or type is a complex type.
+  /// 'pool_' if no pre-allocated vector or type is not supported.
   VectorPtr get(const TypePtr& type, vector_size_t size);
 
-  /// Moves vector into 'this' if it is flat, recursively singly referenced and
-  /// there is space. The function returns true if 'vector' is not null and has
-  /// been returned back to this pool, otherwise returns false.
+  /// Moves vector into 'this' if it is recyclable and there is space. The
+  /// function returns true if 'vector' is not null and has been returned back
+  /// to this pool, otherwise returns false.
   bool release(VectorPtr& vector);
 
   size_t release(std::vector<VectorPtr>& vectors);
@@ -47,6 +49,8 @@ class VectorPool {
   /// the batch the less the win from recycling.
   static constexpr vector_size_t kMaxRecycleSize = 64 * 1024;
   static constexpr int32_t kNumPerType = 10;
+  /// Max number of distinct complex types to cache vectors for.
+  static constexpr int32_t kNumComplexTypes = 8;
 
   struct TypePool {
     int32_t size{0};
@@ -67,6 +71,15 @@ class VectorPool {
 
   /// Caches of pre-allocated vectors indexed by typeKind.
   std::array<TypePool, kNumCachedVectorTypes> vectors_;
+
+  /// Returns the cache for complex type 'type' or nullptr if 'type' is not a
+  /// ROW, ARRAY or MAP type. Adds a cache for 'type' if 'add' is true and
+  /// there are fewer than kNumComplexTypes caches.
+  TypePool* complexTypePool(const TypePtr& type, bool add);
+
+  /// Caches of pre-allocated vectors of complex types. Looked up by linear
+  /// search on type equality.
+  std::vector<std::pair<TypePtr, TypePool>> complexVectors_;
 };
 
 /// A simple vector ptr wrapper with an associated vector pool. It releases
@@ -16,6 +16,8 @@
 
 #include "velox/vector/arrow/Bridge.h"
 
+#include <algorithm>
+
 #include "velox/buffer/Buffer.h"
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/CheckedArithmetic.h"
@@ -31,17 +33,34 @@ namespace facebook::velox {
 namespace {
 
 // The supported conversions use one buffer for nulls (0), one for values (1),
-// and one for offsets (2).
+// and one for offsets (2). String views use a variable number of buffers.
 static constexpr size_t kMaxBuffers{3};
 
+// Layout of an element of Arrow's Utf8View and BinaryView arrays. Strings of
+// up to 12 bytes are inlined after the size like in StringView. Longer ones
+// have a 4 byte prefix followed by the index of the data buffer and the offset
+// of the string in it instead of a pointer.
+struct ArrowStringView {
+  int32_t size;
+  char prefix[4];
+  int32_t bufferIndex;
+  int32_t offset;
+};
+
+static_assert(sizeof(ArrowStringView) == sizeof(StringView));
+
 // Structure that will hold the buffers needed by ArrowArray. This is opaquely
 // carried by ArrowArray.private_data
 class VeloxToArrowBridgeHolder {
  public:
-  VeloxToArrowBridgeHolder() {
-    for (size_t i = 0; i < kMaxBuffers; ++i) {
-      buffers_[i] = nullptr;
-    }
+  VeloxToArrowBridgeHolder()
+      : buffers_(kMaxBuffers, nullptr), bufferPtrs_(kMaxBuffers) {}
+
+  // Makes room for 'numBuffers' buffers. Invalidates the result of
+  // getArrowBuffers().
+  void resizeBuffers(size_t numBuffers) {
+    buffers_.resize(numBuffers, nullptr);
+    bufferPtrs_.resize(numBuffers);
   }
 
   // Acquires a buffer at index `idx`.
@@ -58,7 +77,7 @@ class VeloxToArrowBridgeHolder {
   }
 
   const void** getArrowBuffers() {
-    return buffers_;
+    return buffers_.data();
   }
 
   // Allocates space for `numChildren` ArrowArray pointers.
@@ -89,11 +108,11 @@ class VeloxToArrowBridgeHolder {
 
  private:
   // Holds the pointers to the arrow buffers.
-  const void* buffers_[kMaxBuffers];
+  std::vector<const void*> buffers_;
 
   // Holds ownership over the Buffers being referenced by the buffers vector
   // above.
-  BufferPtr bufferPtrs_[kMaxBuffers];
+  std::vector<BufferPtr> bufferPtrs_;
 
   // Auxiliary buffers to hold ownership over ArrowArray children structures.
   std::vector<std::unique_ptr<ArrowArray>> childrenPtrs_;
@@ -249,9 +268,9 @@ const char* exportArrowFormatStr(
     // We always map VARCHAR and VARBINARY to the "small" version (lower case
     // format string), which uses 32 bit offsets.
     case TypeKind::VARCHAR:
-      return "u"; // utf-8 string
+      return options.exportToStringView ? "vu" : "u"; // utf-8 string
     case TypeKind::VARBINARY:
-      return "z"; // binary
+      return options.exportToStringView ? "vz" : "z"; // binary
     case TypeKind::UNKNOWN:
       return "n"; // NullType
     case TypeKind::TIMESTAMP:
@@ -548,6 +567,87 @@ VectorPtr createStringFlatVector(
       optionalNullCount(nullCount));
 }
 
+// Makes a vector of strings from an Arrow Utf8View or BinaryView array. The
+// strings are not copied. The views are copied only if some strings are not
+// inlined, to replace the buffer indices and offsets with pointers.
+VectorPtr createStringFlatVectorFromViews(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowArray& arrowArray,
+    WrapInBufferViewFunc wrapInBufferView) {
+  VELOX_USER_CHECK_GE(
+      arrowArray.n_buffers,
+      3,
+      "Expecting at least three buffers as input for string view types.");
+  const auto length = arrowArray.length;
+  const auto numDataBuffers = arrowArray.n_buffers - 3;
+  const auto* views =
+      static_cast<const ArrowStringView*>(arrowArray.buffers[1]);
+  const auto* dataBufferSizes =
+      static_cast<const int64_t*>(arrowArray.buffers[arrowArray.n_buffers - 1]);
+
+  // The null rows are checked too, since Velox may read their views.
+  const bool allInline = std::all_of(
+      views, views + length, [](const ArrowStringView& view) {
+        return view.size <= StringView::kInlineSize;
+      });
+  if (allInline) {
+    return std::make_shared<FlatVector<StringView>>(
+        pool,
+        type,
+        nulls,
+        length,
+        wrapInBufferView(views, length * sizeof(StringView)),
+        std::vector<BufferPtr>(),
+        SimpleVectorStats<StringView>{},
+        std::nullopt,
+        optionalNullCount(arrowArray.null_count));
+  }
+
+  std::vector<BufferPtr> stringViewBuffers;
+  stringViewBuffers.reserve(numDataBuffers);
+  for (auto i = 0; i < numDataBuffers; ++i) {
+    stringViewBuffers.push_back(
+        wrapInBufferView(arrowArray.buffers[2 + i], dataBufferSizes[i]));
+  }
+  BufferPtr stringViews = AlignedBuffer::allocate<StringView>(length, pool);
+  auto* rawStringViews = stringViews->asMutable<StringView>();
+  const auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+  for (auto i = 0; i < length; ++i) {
+    const auto& view = views[i];
+    if (view.size <= StringView::kInlineSize) {
+      memcpy(&rawStringViews[i], &view, sizeof(StringView));
+    } else if (rawNulls && bits::isBitNull(rawNulls, i)) {
+      rawStringViews[i] = StringView();
+    } else {
+      VELOX_USER_CHECK(
+          view.bufferIndex >= 0 && view.bufferIndex < numDataBuffers,
+          "String view buffer out of range");
+      VELOX_USER_CHECK_GE(view.offset, 0, "Negative string view offset");
+      VELOX_USER_CHECK_LE(
+          view.offset + static_cast<int64_t>(view.size),
+          dataBufferSizes[view.bufferIndex],
+          "String view out of its buffer");
+      rawStringViews[i] = StringView(
+          static_cast<const char*>(arrowArray.buffers[2 + view.bufferIndex]) +
+              view.offset,
+          view.size);
+    }
+  }
+
+  return std::make_shared<FlatVector<StringView>>(
+      pool,
+      type,
+      nulls,
+      length,
+      stringViews,
+      std::move(stringViewBuffers),
+      SimpleVectorStats<StringView>{},
+      std::nullopt,
+      optionalNullCount(arrowArray.null_count));
+}
+
 // This functions does two things: (a) sets the value of null_count, and (b)
 // the validity buffer (if there is at least one null row).
 void exportValidityBitmap(
@@ -664,6 +764,100 @@ void exportStrings(
   VELOX_DCHECK_EQ(bufSize, *rawOffsets);
 }
 
+// Exports the strings as an Arrow Utf8View or BinaryView array, whose data
+// buffers are the string buffers of 'vec'. Strings that are not in a string
+// buffer of 'vec' are copied to one more data buffer. The views are shared
+// with 'vec' if all of them are inlined.
+void exportStringViews(
+    const FlatVector<StringView>& vec,
+    const Selection& rows,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    VeloxToArrowBridgeHolder& holder) {
+  const auto* rawViews = vec.rawValues();
+  const auto& stringBuffers = vec.stringBuffers();
+  if (!rows.changed() &&
+      std::all_of(rawViews, rawViews + vec.size(), [](StringView view) {
+        return view.isInline();
+      })) {
+    holder.resizeBuffers(3);
+    out.buffers = holder.getArrowBuffers();
+    out.n_buffers = 3;
+    holder.setBuffer(1, vec.values());
+    holder.setBuffer(2, AlignedBuffer::allocate<int64_t>(0, pool));
+    return;
+  }
+
+  // Start addresses of the string buffers with their indices, in ascending
+  // order of address.
+  std::vector<std::pair<const char*, int32_t>> bufferStarts;
+  bufferStarts.reserve(stringBuffers.size());
+  for (auto i = 0; i < stringBuffers.size(); ++i) {
+    bufferStarts.emplace_back(stringBuffers[i]->as<char>(), i);
+  }
+  std::sort(bufferStarts.begin(), bufferStarts.end());
+
+  auto views = AlignedBuffer::allocate<StringView>(out.length, pool);
+  auto* rawArrowViews = views->asMutable<ArrowStringView>();
+  // Rows of the views whose strings are not in 'stringBuffers'.
+  std::vector<std::pair<vector_size_t, StringView>> copies;
+  size_t copiedBytes = 0;
+  vector_size_t j = 0;
+  rows.apply([&](vector_size_t i) {
+    auto& arrowView = rawArrowViews[j];
+    if (vec.isNullAt(i)) {
+      memset(&arrowView, 0, sizeof(ArrowStringView));
+    } else if (rawViews[i].isInline()) {
+      memcpy(&arrowView, &rawViews[i], sizeof(StringView));
+    } else {
+      const auto* data = rawViews[i].data();
+      auto it = std::upper_bound(
+          bufferStarts.begin(),
+          bufferStarts.end(),
+          std::make_pair(data, std::numeric_limits<int32_t>::max()));
+      memcpy(&arrowView, &rawViews[i], offsetof(ArrowStringView, bufferIndex));
+      if (it != bufferStarts.begin() &&
+          data + rawViews[i].size() <=
+              (it - 1)->first + stringBuffers[(it - 1)->second]->size()) {
+        --it;
+        arrowView.bufferIndex = it->second;
+        arrowView.offset = data - it->first;
+      } else {
+        arrowView.bufferIndex = stringBuffers.size();
+        arrowView.offset = copiedBytes;
+        copies.emplace_back(j, rawViews[i]);
+        copiedBytes += rawViews[i].size();
+        VELOX_CHECK_LE(copiedBytes, std::numeric_limits<int32_t>::max());
+      }
+    }
+    ++j;
+  });
+
+  const auto numDataBuffers = stringBuffers.size() + (copies.empty() ? 0 : 1);
+  holder.resizeBuffers(3 + numDataBuffers);
+  out.buffers = holder.getArrowBuffers();
+  out.n_buffers = 3 + numDataBuffers;
+  holder.setBuffer(1, views);
+  for (auto i = 0; i < stringBuffers.size(); ++i) {
+    holder.setBuffer(2 + i, stringBuffers[i]);
+  }
+  if (!copies.empty()) {
+    auto copied = AlignedBuffer::allocate<char>(copiedBytes, pool);
+    auto* rawCopied = copied->asMutable<char>();
+    for (const auto& [row, view] : copies) {
+      memcpy(rawCopied + rawArrowViews[row].offset, view.data(), view.size());
+    }
+    holder.setBuffer(2 + stringBuffers.size(), copied);
+  }
+  auto sizes = AlignedBuffer::allocate<int64_t>(numDataBuffers, pool);
+  auto* rawSizes = sizes->asMutable<int64_t>();
+  for (auto i = 0; i < numDataBuffers; ++i) {
+    rawSizes[i] =
+        i < stringBuffers.size() ? stringBuffers[i]->size() : copiedBytes;
+  }
+  holder.setBuffer(2 + numDataBuffers, sizes);
+}
+
 void exportFlat(
     const BaseVector& vec,
     const Selection& rows,
@@ -688,8 +882,21 @@ void exportFlat(
       break;
     case TypeKind::VARCHAR:
     case TypeKind::VARBINARY:
-      exportStrings(
-          *vec.asUnchecked<FlatVector<StringView>>(), rows, out, pool, holder);
+      if (options.exportToStringView) {
+        exportStringViews(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      } else {
+        exportStrings(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      }
       break;
     default:
       VELOX_NYI(
@@ -1082,6 +1289,16 @@ TypePtr importFromArrowImpl(
     case 'Z':
       return VARBINARY();
 
+    // Utf8View and BinaryView.
+    case 'v':
+      if (format[1] == 'u') {
+        return VARCHAR();
+      }
+      if (format[1] == 'z') {
+        return VARBINARY();
+      }
+      break;
+
     case 't': // temporal types.
       if (format[1] == 's') {
         return TIMESTAMP();
@@ -1712,6 +1929,11 @@ VectorPtr importFromArrowImpl(
   }
 
   // String data types (VARCHAR and VARBINARY).
+  if ((type->isVarchar() || type->isVarbinary()) &&
+      arrowSchema.format[0] == 'v') {
+    return createStringFlatVectorFromViews(
+        pool, type, nulls, arrowArray, wrapInBufferView);
+  }
   if (type->isVarchar() || type->isVarbinary()) {
     VELOX_USER_CHECK_EQ(
         arrowArray.n_buffers,
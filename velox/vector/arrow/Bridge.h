@@ -36,6 +36,11 @@ struct ArrowOptions {
   bool flattenDictionary{false};
   bool flattenConstant{false};
   TimestampUnit timestampUnit = TimestampUnit::kNano;
+  /// If true, VARCHAR and VARBINARY are exported as Arrow Utf8View and
+  /// BinaryView, which reference the string buffers of the vector without
+  /// copying the strings. Otherwise they are exported as Utf8 and Binary with
+  /// 32 bit offsets, for consumers that do not support view types.
+  bool exportToStringView{false};
 };
 
 namespace facebook::velox {
@@ -1310,6 +1310,74 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
         });
   }
 
+  void testImportStringView() {
+    ArrowOptions options;
+    options.exportToStringView = true;
+    // Exports 'vector' as string views and imports it back. Returns the
+    // imported vector.
+    auto roundTrip = [&](const VectorPtr& vector, ArrowArray& data) {
+      ArrowSchema schema;
+      velox::exportToArrow(vector, schema, options);
+      velox::exportToArrow(vector, data, pool_.get(), options);
+      EXPECT_STREQ(schema.format, vector->type()->isVarchar() ? "vu" : "vz");
+      auto result = importFromArrow(schema, data, pool_.get());
+      test::assertEqualVectors(vector, result);
+      if (isViewer()) {
+        schema.release(&schema);
+      }
+      return result;
+    };
+
+    auto strings = vectorMaker_.flatVectorNullable<std::string>({
+        "short",
+        "a string which is too long to be inlined",
+        std::nullopt,
+        "",
+        "another string which is too long to be inlined",
+    });
+    ArrowArray data;
+    auto result = roundTrip(strings, data);
+    // The strings are neither copied on export nor on import.
+    ASSERT_EQ(data.n_buffers, 3 + strings->stringBuffers().size());
+    ASSERT_EQ(data.buffers[2], strings->stringBuffers()[0]->as<void>());
+    auto* imported = result->asFlatVector<StringView>();
+    ASSERT_EQ(imported->valueAt(1).data(), strings->valueAt(1).data());
+    ASSERT_EQ(imported->valueAt(4).data(), strings->valueAt(4).data());
+    result.reset();
+    if (isViewer()) {
+      data.release(&data);
+    }
+
+    // The views of inlined strings are not copied either.
+    auto binaries = vectorMaker_.flatVectorNullable<std::string>(
+        {"a", std::nullopt, "twelve bytes", ""}, VARBINARY());
+    result = roundTrip(binaries, data);
+    ASSERT_EQ(data.n_buffers, 3);
+    ASSERT_EQ(data.buffers[1], binaries->values()->as<void>());
+    result.reset();
+    if (isViewer()) {
+      data.release(&data);
+    }
+
+    // Strings outside of the string buffers are copied to one more buffer.
+    auto constant = BaseVector::createConstant(
+        VARCHAR(),
+        variant("a constant which is not in a string buffer"),
+        3,
+        pool_.get());
+    ArrowSchema schema;
+    velox::exportToArrow(constant, schema, options);
+    velox::exportToArrow(constant, data, pool_.get(), options);
+    ASSERT_EQ(data.children[1]->n_buffers, 4);
+    result = importFromArrow(schema, data, pool_.get());
+    test::assertEqualVectors(constant, result);
+    result.reset();
+    if (isViewer()) {
+      schema.release(&schema);
+      data.release(&data);
+    }
+  }
+
  private:
   // Creates short decimals from int128 and asserts the content of actual vector
   // with the expected values.
@@ -1752,6 +1820,10 @@ TEST_F(ArrowBridgeArrayImportAsViewerTest, string) {
   testImportString();
 }
 
+TEST_F(ArrowBridgeArrayImportAsViewerTest, stringView) {
+  testImportStringView();
+}
+
 TEST_F(ArrowBridgeArrayImportAsViewerTest, row) {
   testImportRow();
 }
@@ -1805,6 +1877,10 @@ TEST_F(ArrowBridgeArrayImportAsOwnerTest, string) {
   testImportString();
 }
 
+TEST_F(ArrowBridgeArrayImportAsOwnerTest, stringView) {
+  testImportStringView();
+}
+
 TEST_F(ArrowBridgeArrayImportAsOwnerTest, row) {
   testImportRow();
 }
@@ -1323,6 +1323,91 @@ TEST_F(DecodedVectorTest, dictionaryOverFlatNulls) {
   decodeAndCheckNulls(dict);
 }
 
+TEST_F(DecodedVectorTest, multiLevelDictionary) {
+  // Large enough for whole words of rows with and without nulls.
+  constexpr vector_size_t kSize = 1'000;
+  auto flat = makeFlatVector<int64_t>(
+      kSize, [](auto row) { return row * 3; }, nullEvery(11));
+  auto shuffle = [&](int32_t step) {
+    return makeIndices(kSize, [step](auto row) {
+      return (row * step + 1) % kSize;
+    });
+  };
+  auto innerNulls = makeNulls(kSize, [](auto row) { return row % 7 == 0; });
+  // Nulls only in rows 200 to 299, so that only some words have null rows.
+  auto outerNulls =
+      makeNulls(kSize, [](auto row) { return row >= 200 && row < 300; });
+
+  auto base = BaseVector::wrapInDictionary(innerNulls, shuffle(7), kSize, flat);
+  std::vector<VectorPtr> dictionaries = {
+      wrapInDictionary(shuffle(13), kSize, wrapInDictionary(shuffle(3), base)),
+      BaseVector::wrapInDictionary(
+          outerNulls, shuffle(13), kSize, wrapInDictionary(shuffle(3), base)),
+      BaseVector::wrapInDictionary(
+          outerNulls,
+          shuffle(17),
+          kSize,
+          BaseVector::wrapInDictionary(outerNulls, shuffle(3), kSize, base)),
+  };
+
+  SelectivityVector allRows(kSize);
+  SelectivityVector someRows(kSize);
+  someRows.setValid(10, false);
+  someRows.updateBounds();
+  DecodedVector decoded;
+  for (const auto& dictionary : dictionaries) {
+    auto* expected = dictionary->as<SimpleVector<int64_t>>();
+    for (const auto* rows : {&allRows, &someRows}) {
+      decoded.decode(*dictionary, *rows);
+      rows->applyToSelected([&](auto row) {
+        ASSERT_EQ(decoded.isNullAt(row), expected->isNullAt(row)) << row;
+        if (!expected->isNullAt(row)) {
+          ASSERT_EQ(decoded.valueAt<int64_t>(row), expected->valueAt(row));
+        }
+      });
+    }
+  }
+}
+
+TEST_F(DecodedVectorTest, sequence) {
+  // Runs of 1 to 30 rows. Every seventh run is null.
+  std::vector<std::optional<int64_t>> data;
+  for (auto run = 0; run < 30; ++run) {
+    for (auto i = 0; i <= run; ++i) {
+      data.push_back(
+          run % 7 == 6 ? std::nullopt : std::optional<int64_t>(run * 3));
+    }
+  }
+  const vector_size_t size = data.size();
+  auto sequence = vectorMaker_.sequenceVector(data);
+  auto nulls = makeNulls(size, [](auto row) { return row % 11 == 0; });
+  std::vector<VectorPtr> vectors = {
+      sequence,
+      wrapInDictionary(makeIndicesInReverse(size), sequence),
+      BaseVector::wrapInDictionary(
+          nulls, makeIndicesInReverse(size), size, sequence),
+  };
+
+  SelectivityVector allRows(size);
+  SelectivityVector someRows(size);
+  someRows.setValid(10, false);
+  someRows.updateBounds();
+  DecodedVector decoded;
+  for (const auto& vector : vectors) {
+    auto* expected = vector->as<SimpleVector<int64_t>>();
+    for (const auto* rows : {&allRows, &someRows}) {
+      decoded.decode(*vector, *rows);
+      ASSERT_EQ(decoded.base(), sequence->valueVector().get());
+      rows->applyToSelected([&](auto row) {
+        ASSERT_EQ(decoded.isNullAt(row), expected->isNullAt(row)) << row;
+        if (!expected->isNullAt(row)) {
+          ASSERT_EQ(decoded.valueAt<int64_t>(row), expected->valueAt(row));
+        }
+      });
+    }
+  }
+}
+
 TEST_F(DecodedVectorTest, dictionaryWrapping) {
   constexpr vector_size_t baseVectorSize{100};
   constexpr vector_size_t innerDictSize{30};
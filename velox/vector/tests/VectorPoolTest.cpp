@@ -136,6 +136,61 @@ TEST_F(VectorPoolTest, vectorRecycler) {
   }
 }
 
+TEST_F(VectorPoolTest, complexTypes) {
+  VectorPool vectorPool(pool());
+
+  const auto rowType = ROW(
+      {"a", "b", "c"}, {BIGINT(), ARRAY(VARCHAR()), MAP(INTEGER(), REAL())});
+  auto maps = makeMapVector<int32_t, float>(
+      {{{1, 1.0f}}, {{2, 2.0f}, {3, 3.0f}}, {}});
+  VectorPtr vector = makeRowVector(
+      {"a", "b", "c"},
+      {makeNullableFlatVector<int64_t>({1, std::nullopt, 3}),
+       makeArrayVector<std::string>({{"x", "y"}, {}, {"z"}}),
+       std::move(maps)});
+  vector->setNull(1, true);
+  auto* rawVector = vector.get();
+  ASSERT_TRUE(vectorPool.release(vector));
+  ASSERT_EQ(vector, nullptr);
+
+  // A recycled row vector has all children resized, not null and empty
+  // arrays and maps.
+  auto recycled = vectorPool.get(rowType, 5);
+  ASSERT_EQ(rawVector, recycled.get());
+  ASSERT_EQ(5, recycled->size());
+  auto* row = recycled->asUnchecked<RowVector>();
+  for (auto i = 0; i < row->childrenSize(); ++i) {
+    ASSERT_EQ(5, row->childAt(i)->size());
+  }
+  auto* arrays = row->childAt(1)->asUnchecked<ArrayVector>();
+  auto* recycledMaps = row->childAt(2)->asUnchecked<MapVector>();
+  for (auto i = 0; i < 5; ++i) {
+    ASSERT_FALSE(recycled->isNullAt(i));
+    ASSERT_FALSE(row->childAt(0)->isNullAt(i));
+    ASSERT_EQ(0, arrays->sizeAt(i));
+    ASSERT_EQ(0, recycledMaps->sizeAt(i));
+  }
+  ASSERT_EQ(0, arrays->elements()->size());
+  ASSERT_EQ(0, recycledMaps->mapKeys()->size());
+
+  // Other types get their own cache.
+  auto array = vectorPool.get(ARRAY(BIGINT()), 10);
+  ASSERT_NE(array.get(), rawVector);
+  ASSERT_EQ(10, array->size());
+
+  // A vector with a shared child is not recyclable.
+  auto child = row->childAt(0);
+  ASSERT_FALSE(vectorPool.release(recycled));
+  child.reset();
+  ASSERT_TRUE(vectorPool.release(recycled));
+
+  // Dictionary encoded vectors are not recyclable.
+  VectorPtr dictionary = BaseVector::wrapInDictionary(
+      nullptr, makeIndices(5, [](auto row) { return row; }), 5, array);
+  array.reset();
+  ASSERT_FALSE(vectorPool.release(dictionary));
+}
+
 TEST_F(VectorPoolTest, customTypes) {
   VectorPool vectorPool(pool());
 
@@ -2817,6 +2817,84 @@ TEST_F(VectorTest, flattenVector) {
   EXPECT_EQ(nullVector, nullptr);
 }
 
+TEST_F(VectorTest, compactStringBuffers) {
+  auto strings = makeFlatVector<std::string>(
+      1'000,
+      [](auto row) {
+        return fmt::format("a string that is not inlined {}", row);
+      },
+      nullEvery(7));
+  auto ints = makeFlatVector<int64_t>(1'000, [](auto row) { return row; });
+  auto input = makeRowVector({ints, strings});
+
+  // A slice of 10 rows keeps all the string buffers.
+  auto slice = std::static_pointer_cast<RowVector>(input->slice(100, 10));
+  auto* sliceStrings = slice->childAt(1)->asFlatVector<StringView>();
+  ASSERT_EQ(sliceStrings->stringBuffers(), strings->stringBuffers());
+
+  auto compacted = BaseVector::compactStringBuffers(slice, 0.5);
+  ASSERT_NE(compacted, slice);
+  test::assertEqualVectors(slice, compacted);
+  auto* compactedRow = compacted->asUnchecked<RowVector>();
+  // Vectors without strings are not copied.
+  ASSERT_EQ(compactedRow->childAt(0), slice->childAt(0));
+  auto* compactedStrings = compactedRow->childAt(1)->asFlatVector<StringView>();
+  ASSERT_EQ(compactedStrings->stringBuffers().size(), 1);
+  ASSERT_LT(
+      compactedStrings->retainedSize(), sliceStrings->retainedSize() / 10);
+
+  // Vectors that use most of their string buffers are not copied.
+  ASSERT_EQ(BaseVector::compactStringBuffers(input, 0.5), input);
+  ASSERT_EQ(BaseVector::compactStringBuffers(compacted, 0.5), compacted);
+
+  // Inlined strings need no string buffer.
+  auto shortStrings = makeFlatVector<std::string>(
+      1'000, [](auto row) { return std::to_string(row); });
+  shortStrings->addStringBuffer(strings->stringBuffers()[0]);
+  auto compactedShort = BaseVector::compactStringBuffers(shortStrings, 0.5);
+  test::assertEqualVectors(shortStrings, compactedShort);
+  ASSERT_TRUE(
+      compactedShort->asFlatVector<StringView>()->stringBuffers().empty());
+}
+
+TEST_F(VectorTest, copyRangesGather) {
+  auto strings = makeFlatVector<std::string>(
+      1'000,
+      [](auto row) {
+        return row % 3 == 0 ? std::to_string(row)
+                            : fmt::format("not an inlined string {}", row);
+      },
+      nullEvery(11));
+  std::vector<vector_size_t> offsets;
+  for (auto i = 0; i < 100; ++i) {
+    offsets.push_back(i * 10 - i % 2);
+  }
+  auto arrays = makeArrayVector(offsets, strings, {7, 13});
+  auto source = makeRowVector({strings->slice(0, arrays->size()), arrays});
+
+  // Copies every other row, a row at a time, to a vector of the same pool and
+  // to one of another pool, which copies the strings.
+  std::vector<BaseVector::CopyRange> ranges;
+  for (vector_size_t i = 0; i < source->size() / 2; ++i) {
+    ranges.push_back({2 * i + 1, i, 1});
+  }
+  auto otherPool = memory::memoryManager()->addLeafPool();
+  for (auto* pool : {pool(), otherPool.get()}) {
+    auto target = BaseVector::create(source->type(), ranges.size(), pool);
+    target->copyRanges(source.get(), ranges);
+    for (const auto& range : ranges) {
+      ASSERT_TRUE(target->equalValueAt(
+          source.get(), range.targetIndex, range.sourceIndex));
+    }
+    auto* targetStrings = target->asUnchecked<RowVector>()
+                              ->childAt(0)
+                              ->asFlatVector<StringView>();
+    ASSERT_EQ(
+        targetStrings->stringBuffers() == strings->stringBuffers(),
+        pool == this->pool());
+  }
+}
+
 TEST_F(VectorTest, findDuplicateValue) {
   const CompareFlags flags;
   auto data = makeFlatVector<int64_t>({1, 3, 2, 4, 3, 5, 4, 6});